@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <kernel_internal.h>
+
+struct stackframe {
+	uintptr_t fp;
+	uintptr_t ra;
+};
+
+size_t arch_interrupted_stack_trace(uintptr_t *buf, size_t size)
+{
+	const z_arch_esf_t *esf;
+	size_t n = 0;
+
+	/* Only the outermost interrupt saves the interrupted stack pointer */
+	if (size == 0 || _current_cpu->nested != 1U) {
+		return 0;
+	}
+
+	/*
+	 * isr.S saves the interrupted registers as an esf on the interrupted
+	 * stack, then switches to the interrupt stack and pushes the interrupted
+	 * stack pointer with an offset of -16.
+	 */
+	esf = *(const z_arch_esf_t **)((uintptr_t)_current_cpu->irq_stack - 16);
+	buf[n++] = esf->mepc;
+
+#if defined(CONFIG_FRAME_POINTER) && defined(CONFIG_THREAD_STACK_INFO)
+	uintptr_t start = _current->stack_info.start;
+	uintptr_t end = start + _current->stack_info.size;
+	uintptr_t fp = esf->s0;
+	struct stackframe *frame;
+
+	while ((n < size) && (fp > start + sizeof(*frame)) && (fp <= end)) {
+		frame = (struct stackframe *)fp - 1;
+		buf[n++] = frame->ra;
+
+		/* Frames only ever get older up the stack */
+		if (frame->fp <= fp) {
+			break;
+		}
+
+		fp = frame->fp;
+	}
+#endif
+
+	return n;
+}
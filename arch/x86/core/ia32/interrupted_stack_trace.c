@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <kernel_internal.h>
+
+size_t arch_interrupted_stack_trace(uintptr_t *buf, size_t size)
+{
+	uintptr_t *isp;
+	size_t n = 0;
+
+	/* Only the outermost interrupt saves the interrupted stack pointer */
+	if (size == 0 || _current_cpu->nested != 1U) {
+		return 0;
+	}
+
+	/*
+	 * _interrupt_enter pushes the interrupted stack pointer at the base of
+	 * the interrupt stack. It points to the saved EDI, ECX, EDX and EAX,
+	 * followed by the EIP pushed by the CPU.
+	 */
+	isp = *(uintptr_t **)((uintptr_t)_current_cpu->irq_stack - sizeof(uintptr_t));
+	buf[n++] = isp[4];
+
+#if defined(CONFIG_FRAME_POINTER) && defined(CONFIG_THREAD_STACK_INFO)
+	uintptr_t irq_end = (uintptr_t)_current_cpu->irq_stack;
+	uintptr_t irq_start = irq_end - CONFIG_ISR_STACK_SIZE;
+	uintptr_t start = _current->stack_info.start;
+	uintptr_t end = start + _current->stack_info.size;
+	uintptr_t *fp = __builtin_frame_address(0);
+
+	/*
+	 * _interrupt_enter leaves EBP alone, so the first frame of the chain
+	 * which is not on the interrupt stack is the interrupted one.
+	 */
+	while (((uintptr_t)fp >= irq_start) && ((uintptr_t)fp < irq_end)) {
+		fp = (uintptr_t *)fp[0];
+	}
+
+	while ((n < size) && ((uintptr_t)fp >= start) &&
+	       ((uintptr_t)fp + 2 * sizeof(uintptr_t) <= end)) {
+		buf[n++] = fp[1];
+
+		/* Frames only ever get older up the stack */
+		if (fp[0] <= (uintptr_t)fp) {
+			break;
+		}
+
+		fp = (uintptr_t *)fp[0];
+	}
+#endif
+
+	return n;
+}
@@ -96,6 +96,10 @@ if(CONFIG_NET_SOCKETS)
 endif()
 
 
+if(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+  zephyr_iterable_section(NAME tcp_ca_ops KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN CONFIG_LINKER_ITERABLE_SUBALIGN)
+endif()
+
 if(CONFIG_NET_L2_PPP)
   zephyr_iterable_section(NAME ppp_protocol_handler KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN CONFIG_LINKER_ITERABLE_SUBALIGN)
 endif()
@@ -223,6 +227,7 @@ endif()
 
 if(CONFIG_INPUT)
   zephyr_iterable_section(NAME input_callback KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN CONFIG_LINKER_ITERABLE_SUBALIGN)
+  zephyr_iterable_section(NAME input_group_callback KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN CONFIG_LINKER_ITERABLE_SUBALIGN)
 endif()
 
 if(CONFIG_USBD_MSC_CLASS)
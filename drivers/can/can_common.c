@@ -9,6 +9,7 @@
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/logging/log.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(can_common, CONFIG_CAN_LOG_LEVEL);
 
@@ -126,6 +127,254 @@ int z_impl_can_add_rx_filter_msgq(const struct device *dev, struct k_msgq *msgq,
 	return api->add_rx_filter(dev, can_msgq_put, msgq, filter);
 }
 
+#ifdef CONFIG_CAN_RX_RING
+static void can_rx_ring_work_handler(struct k_work *work)
+{
+	struct can_rx_ring *ring = CONTAINER_OF(work, struct can_rx_ring, work);
+	k_spinlock_key_t key;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t count;
+
+	for (;;) {
+		key = k_spin_lock(&ring->lock);
+		head = ring->head;
+		tail = ring->tail;
+		k_spin_unlock(&ring->lock, key);
+
+		if (head == tail) {
+			break;
+		}
+
+		/* Frames up to the end of the buffer, the rest comes next round */
+		count = MIN(head - tail, ring->size - (tail % ring->size));
+
+		ring->callback(ring->dev, &ring->frames[tail % ring->size], count,
+			       ring->user_data);
+
+		key = k_spin_lock(&ring->lock);
+		ring->tail = tail + count;
+		k_spin_unlock(&ring->lock, key);
+	}
+}
+
+void can_rx_ring_init(struct can_rx_ring *ring, struct can_frame *frames, size_t size,
+		      can_rx_batch_callback_t callback, void *user_data)
+{
+	__ASSERT_NO_MSG(size > 0U);
+
+	k_work_init(&ring->work, can_rx_ring_work_handler);
+	ring->dev = NULL;
+	ring->frames = frames;
+	ring->size = size;
+	ring->head = 0U;
+	ring->tail = 0U;
+	ring->dropped = 0U;
+	ring->callback = callback;
+	ring->user_data = user_data;
+}
+
+void can_rx_ring_put(const struct device *dev, struct can_frame *frame, void *user_data)
+{
+	struct can_rx_ring *ring = user_data;
+	k_spinlock_key_t key;
+	bool was_empty;
+
+	__ASSERT_NO_MSG(ring);
+
+	key = k_spin_lock(&ring->lock);
+
+	if (ring->head - ring->tail == ring->size) {
+		ring->dropped++;
+		k_spin_unlock(&ring->lock, key);
+		return;
+	}
+
+	was_empty = ring->head == ring->tail;
+	ring->dev = dev;
+	ring->frames[ring->head % ring->size] = *frame;
+	ring->head++;
+
+	k_spin_unlock(&ring->lock, key);
+
+	/* The handler keeps draining as long as frames come in, so it only
+	 * needs a kick for the first frame of a batch.
+	 */
+	if (was_empty) {
+		k_work_submit(&ring->work);
+	}
+}
+#endif /* CONFIG_CAN_RX_RING */
+
+#ifdef CONFIG_CAN_RX_FILTER_SET
+static void can_rx_filter_set_cb(const struct device *dev, struct can_frame *frame,
+				 void *user_data)
+{
+	struct can_rx_filter_set *set = user_data;
+
+	for (size_t i = 0; i < set->count; i++) {
+		if (can_frame_matches_filter(frame, &set->filters[i])) {
+			set->callback(dev, frame, set->user_data);
+			return;
+		}
+	}
+}
+
+/* Smallest filter accepting everything a and b accept */
+static void can_filter_merge(const struct can_filter *a, const struct can_filter *b,
+			     struct can_filter *out)
+{
+	out->mask = a->mask & b->mask & ~(a->id ^ b->id);
+	out->id = a->id & out->mask;
+	out->flags = a->flags;
+}
+
+/* True if the merge of a and b accepts exactly the frames a or b accept: one
+ * contains the other, or they have the same mask and differ in one ID bit.
+ */
+static bool can_filter_merge_is_exact(const struct can_filter *a, const struct can_filter *b)
+{
+	uint32_t diff = (a->id ^ b->id) & a->mask & b->mask;
+
+	if ((a->mask & ~b->mask) == 0U && (diff & a->mask) == 0U) {
+		return true;
+	}
+
+	if ((b->mask & ~a->mask) == 0U && (diff & b->mask) == 0U) {
+		return true;
+	}
+
+	return a->mask == b->mask && IS_POWER_OF_TWO(diff);
+}
+
+static size_t can_filter_remove(struct can_filter *filters, size_t count, size_t index)
+{
+	filters[index] = filters[count - 1];
+
+	return count - 1;
+}
+
+/* Merge filters until at most target remain. Exact merges are always done,
+ * after that the pair whose merge keeps the most ID bits significant goes.
+ */
+static size_t can_filters_reduce(struct can_filter *filters, size_t count, size_t target)
+{
+	bool merged;
+
+	do {
+		merged = false;
+
+		for (size_t i = 0; i < count && !merged; i++) {
+			for (size_t j = i + 1; j < count && !merged; j++) {
+				if (filters[i].flags == filters[j].flags &&
+				    can_filter_merge_is_exact(&filters[i], &filters[j])) {
+					can_filter_merge(&filters[i], &filters[j], &filters[i]);
+					count = can_filter_remove(filters, count, j);
+					merged = true;
+				}
+			}
+		}
+	} while (merged);
+
+	while (count > target) {
+		int best = -1;
+		size_t best_i = 0;
+		size_t best_j = 0;
+		struct can_filter out;
+
+		for (size_t i = 0; i < count; i++) {
+			for (size_t j = i + 1; j < count; j++) {
+				int bits;
+
+				if (filters[i].flags != filters[j].flags) {
+					continue;
+				}
+
+				can_filter_merge(&filters[i], &filters[j], &out);
+				bits = __builtin_popcount(out.mask);
+				if (bits > best) {
+					best = bits;
+					best_i = i;
+					best_j = j;
+				}
+			}
+		}
+
+		if (best < 0) {
+			/* Only filters of different types are left */
+			break;
+		}
+
+		can_filter_merge(&filters[best_i], &filters[best_j], &filters[best_i]);
+		count = can_filter_remove(filters, count, best_j);
+	}
+
+	return count;
+}
+
+void can_remove_rx_filter_set(const struct device *dev, struct can_rx_filter_set *set)
+{
+	for (uint8_t i = 0; i < set->hw_count; i++) {
+		can_remove_rx_filter(dev, set->filter_ids[i]);
+	}
+
+	set->hw_count = 0U;
+}
+
+int can_add_rx_filter_set(const struct device *dev, can_rx_callback_t callback,
+			  void *user_data, struct can_rx_filter_set *set)
+{
+	struct can_filter filters[CONFIG_CAN_RX_FILTER_SET_MAX_FILTERS];
+	size_t count;
+	int err;
+
+	CHECKIF(callback == NULL || set == NULL || set->filters == NULL || set->count == 0U ||
+		set->count > ARRAY_SIZE(filters)) {
+		return -EINVAL;
+	}
+
+	memcpy(filters, set->filters, set->count * sizeof(filters[0]));
+	count = can_filters_reduce(filters, set->count, set->count);
+
+	set->callback = callback;
+	set->user_data = user_data;
+	set->hw_count = 0U;
+
+	/* Use fewer hardware filters each time the controller runs out */
+	for (size_t target = MIN(count, CONFIG_CAN_RX_FILTER_SET_MAX_HW); target > 0U;
+	     target--) {
+		count = can_filters_reduce(filters, count, target);
+		if (count > target) {
+			return -ENOSPC;
+		}
+
+		err = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			err = can_add_rx_filter(dev, can_rx_filter_set_cb, set, &filters[i]);
+			if (err < 0) {
+				break;
+			}
+
+			set->filter_ids[set->hw_count++] = err;
+		}
+
+		if (err >= 0) {
+			LOG_DBG("%zu filters merged into %u", set->count, set->hw_count);
+			return set->hw_count;
+		}
+
+		can_remove_rx_filter_set(dev, set);
+
+		if (err != -ENOSPC) {
+			return err;
+		}
+	}
+
+	return -ENOSPC;
+}
+#endif /* CONFIG_CAN_RX_FILTER_SET */
+
 /**
  * @brief Update the timing given a total number of time quanta and a sample point.
  *
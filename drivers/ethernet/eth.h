@@ -7,8 +7,11 @@
 #ifndef ZEPHYR_DRIVERS_ETHERNET_ETH_H_
 #define ZEPHYR_DRIVERS_ETHERNET_ETH_H_
 
+#include <errno.h>
 #include <zephyr/types.h>
+#include <zephyr/cache.h>
 #include <zephyr/random/random.h>
+#include <zephyr/net/net_pkt.h>
 
 /* helper macro to return mac address octet from local_mac_address prop */
 #define NODE_MAC_ADDR_OCTET(node, n) DT_PROP_BY_IDX(node, local_mac_address, n)
@@ -42,4 +45,74 @@ static inline void gen_random_mac(uint8_t *mac_addr, uint8_t b0, uint8_t b1, uin
 	sys_rand_get(&mac_addr[3], 3U);
 }
 
+/* Zero-copy RX helpers: the RX DMA descriptors point straight into data
+ * buffers of the net_pkt RX pool, so a received frame is attached to its
+ * packet as is and the descriptor is re-armed with a fresh buffer.
+ */
+
+static inline struct net_buf *eth_rx_buf_alloc(size_t size, k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = net_pkt_get_reserve_rx_data(size, timeout);
+	if (buf != NULL) {
+		/* Do not let dirty lines be evicted over the DMA data */
+		sys_cache_data_invd_range(buf->data, buf->size);
+	}
+
+	return buf;
+}
+
+/* Release the buffers held by an RX descriptor ring */
+static inline void eth_rx_bufs_free(struct net_buf **bufs, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (bufs[i] != NULL) {
+			net_buf_unref(bufs[i]);
+			bufs[i] = NULL;
+		}
+	}
+}
+
+/* Give every empty slot of an RX descriptor ring a buffer of at least size
+ * bytes. On failure everything is released again and -ENOBUFS returned.
+ */
+static inline int eth_rx_bufs_fill(struct net_buf **bufs, size_t count, size_t size,
+				   k_timeout_t timeout)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (bufs[i] != NULL) {
+			continue;
+		}
+
+		bufs[i] = eth_rx_buf_alloc(size, timeout);
+		if (bufs[i] == NULL) {
+			eth_rx_bufs_free(bufs, count);
+			return -ENOBUFS;
+		}
+	}
+
+	return 0;
+}
+
+/* Take the buffer a frame fragment was received into out of its ring slot
+ * and put a fresh one in its place. If the pool is empty the slot keeps its
+ * buffer and NULL is returned: the caller drops the frame and re-arms the
+ * descriptor with the same buffer, so the ring never runs dry.
+ */
+static inline struct net_buf *eth_rx_buf_swap(struct net_buf **slot, k_timeout_t timeout)
+{
+	struct net_buf *buf = *slot;
+	struct net_buf *fresh;
+
+	fresh = eth_rx_buf_alloc(buf->size, timeout);
+	if (fresh == NULL) {
+		return NULL;
+	}
+
+	*slot = fresh;
+
+	return buf;
+}
+
 #endif /* ZEPHYR_DRIVERS_ETHERNET_ETH_H_ */
@@ -300,9 +300,19 @@ static void dwmac_receive(struct dwmac_priv *p)
 			continue;
 		}
 
-		/* retrieve current fragment */
-		frag = p->rx_frags[d_idx];
-		p->rx_frags[d_idx] = NULL;
+		/*
+		 * Retrieve current fragment and leave a fresh one in its slot.
+		 * If the pool is dry, drop the packet and let the refill thread
+		 * reuse the fragment rather than stalling the ring.
+		 */
+		frag = eth_rx_buf_swap(&p->rx_frags[d_idx], K_NO_WAIT);
+		if (!frag) {
+			LOG_ERR("d[%d] no fresh RX fragment: dropping pkt", d_idx);
+			eth_stats_update_errors_rx(p->iface);
+			net_pkt_unref(p->rx_pkt);
+			p->rx_pkt = NULL;
+			continue;
+		}
 		bytes_so_far = FIELD_GET(RDES3_PL, des3_val);
 		frag->len = bytes_so_far - p->rx_bytes;
 		p->rx_bytes = bytes_so_far;
@@ -358,17 +368,16 @@ static void dwmac_rx_refill_thread(void *arg1, void *unused1, void *unused2)
 
 		frag = p->rx_frags[d_idx];
 
-		/* get a new fragment if the previous one was consumed */
+		/* get a new fragment if the slot was never filled */
 		if (!frag) {
-			frag = net_pkt_get_reserve_rx_data(RX_FRAG_SIZE, K_FOREVER);
+			frag = eth_rx_buf_alloc(RX_FRAG_SIZE, K_FOREVER);
 			if (!frag) {
-				LOG_ERR("net_pkt_get_reserve_rx_data() returned NULL");
+				LOG_ERR("eth_rx_buf_alloc() returned NULL");
 				k_sem_give(&p->free_rx_descs);
 				break;
 			}
 			LOG_DBG("new frag[%d] at %p", d_idx, frag->data);
 			__ASSERT(frag->size == RX_FRAG_SIZE, "");
-			sys_cache_data_invd_range(frag->data, frag->size);
 			p->rx_frags[d_idx] = frag;
 		} else {
 			LOG_DBG("reusing frag[%d] at %p", d_idx, frag->data);
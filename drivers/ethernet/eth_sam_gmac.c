@@ -438,19 +438,6 @@ static void ring_buf_put(struct ring_buf *rb, uint32_t val)
 }
 #endif
 
-/*
- * Free pre-reserved RX buffers
- */
-static void free_rx_bufs(struct net_buf **rx_frag_list, uint16_t len)
-{
-	for (int i = 0; i < len; i++) {
-		if (rx_frag_list[i]) {
-			net_buf_unref(rx_frag_list[i]);
-			rx_frag_list[i] = NULL;
-		}
-	}
-}
-
 /*
  * Set MAC Address for frame filtering logic
  */
@@ -481,17 +468,14 @@ static int rx_descriptors_init(Gmac *gmac, struct gmac_queue *queue)
 
 	rx_desc_list->tail = 0U;
 
-	for (int i = 0; i < rx_desc_list->len; i++) {
-		rx_buf = net_pkt_get_reserve_rx_data(CONFIG_NET_BUF_DATA_SIZE,
-						     K_NO_WAIT);
-		if (rx_buf == NULL) {
-			free_rx_bufs(rx_frag_list, rx_desc_list->len);
-			LOG_ERR("Failed to reserve data net buffers");
-			return -ENOBUFS;
-		}
-
-		rx_frag_list[i] = rx_buf;
+	if (eth_rx_bufs_fill(rx_frag_list, rx_desc_list->len,
+			     CONFIG_NET_BUF_DATA_SIZE, K_NO_WAIT) < 0) {
+		LOG_ERR("Failed to reserve data net buffers");
+		return -ENOBUFS;
+	}
 
+	for (int i = 0; i < rx_desc_list->len; i++) {
+		rx_buf = rx_frag_list[i];
 		rx_buf_addr = rx_buf->data;
 		__ASSERT(!((uint32_t)rx_buf_addr & ~GMAC_RXW0_ADDR),
 			 "Misaligned RX buffer address");
@@ -1225,7 +1209,6 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 	struct net_pkt *rx_frame;
 	bool frame_is_complete;
 	struct net_buf *frag;
-	struct net_buf *new_frag;
 	struct net_buf *last_frag = NULL;
 	uint8_t *frag_data;
 	uint32_t frag_len;
@@ -1290,9 +1273,10 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 			/* Assure cache coherency after DMA write operation */
 			dcache_invalidate((uint32_t)frag_data, frag->size);
 
-			/* Get a new data net buffer from the buffer pool */
-			new_frag = net_pkt_get_frag(rx_frame, CONFIG_NET_BUF_DATA_SIZE, K_NO_WAIT);
-			if (new_frag == NULL) {
+			/* Hand the buffer over to the frame and re-arm the
+			 * descriptor with a new one from the RX pool
+			 */
+			if (eth_rx_buf_swap(&rx_frag_list[tail], K_NO_WAIT) == NULL) {
 				queue->err_rx_frames_dropped++;
 				net_pkt_unref(rx_frame);
 				rx_frame = NULL;
@@ -1304,8 +1288,7 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 					net_buf_frag_insert(last_frag, frag);
 				}
 				last_frag = frag;
-				frag = new_frag;
-				rx_frag_list[tail] = frag;
+				frag = rx_frag_list[tail];
 			}
 		}
 
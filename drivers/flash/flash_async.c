@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/drivers/flash/flash_async.h>
+
+static K_THREAD_STACK_DEFINE(flash_async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q flash_async_workq;
+
+static void flash_async_handler(struct k_work *work)
+{
+	struct flash_async_req *req = CONTAINER_OF(work, struct flash_async_req, work);
+	int rc;
+
+	switch (req->op) {
+	case FLASH_ASYNC_READ:
+		rc = flash_read(req->dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_WRITE:
+		rc = flash_write(req->dev, req->offset, req->data, req->len);
+		break;
+	case FLASH_ASYNC_ERASE:
+		rc = flash_erase(req->dev, req->offset, req->len);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	atomic_clear(&req->busy);
+	req->cb(req, rc);
+}
+
+static int flash_async_submit(const struct device *dev, struct flash_async_req *req,
+			      enum flash_async_op op, off_t offset, void *data, size_t len,
+			      flash_async_cb_t cb)
+{
+	if (!atomic_cas(&req->busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	/* Not again for requests chained from their callback, which still
+	 * run as work items.
+	 */
+	if (req->work.handler != flash_async_handler) {
+		k_work_init(&req->work, flash_async_handler);
+	}
+
+	req->dev = dev;
+	req->op = op;
+	req->offset = offset;
+	req->data = data;
+	req->len = len;
+	req->cb = cb;
+
+	k_work_submit_to_queue(&flash_async_workq, &req->work);
+
+	return 0;
+}
+
+int flash_async_read(const struct device *dev, struct flash_async_req *req, off_t offset,
+		     void *data, size_t len, flash_async_cb_t cb)
+{
+	return flash_async_submit(dev, req, FLASH_ASYNC_READ, offset, data, len, cb);
+}
+
+int flash_async_write(const struct device *dev, struct flash_async_req *req, off_t offset,
+		      const void *data, size_t len, flash_async_cb_t cb)
+{
+	return flash_async_submit(dev, req, FLASH_ASYNC_WRITE, offset, (void *)data, len, cb);
+}
+
+int flash_async_erase(const struct device *dev, struct flash_async_req *req, off_t offset,
+		      size_t size, flash_async_cb_t cb)
+{
+	return flash_async_submit(dev, req, FLASH_ASYNC_ERASE, offset, NULL, size, cb);
+}
+
+static int flash_async_init(void)
+{
+	k_work_queue_start(&flash_async_workq, flash_async_stack,
+			   K_THREAD_STACK_SIZEOF(flash_async_stack),
+			   CONFIG_FLASH_ASYNC_PRIORITY, NULL);
+	k_thread_name_set(&flash_async_workq.thread, "flash_async");
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
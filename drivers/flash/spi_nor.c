@@ -2,6 +2,7 @@
  * Copyright (c) 2018 Savoir-Faire Linux.
  * Copyright (c) 2020 Peter Bigot Consulting, LLC
  * Copyright (c) 2023 Intercreate, Inc.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * This driver is heavily inspired from the spi_flash_w25qxxdv.c SPI NOR driver.
  *
@@ -184,6 +185,16 @@ struct spi_nor_data {
 	 */
 	bool flag_access_32bit: 1;
 
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	/* Flash address of each cache line, negative if the line is invalid */
+	off_t cache_addr[CONFIG_SPI_NOR_READ_CACHE_LINES];
+	/* Flash address following the lines filled latest */
+	off_t cache_next_addr;
+	/* Line filled next, lines being replaced in turn */
+	uint8_t cache_next;
+	uint8_t cache[CONFIG_SPI_NOR_READ_CACHE_LINES][CONFIG_SPI_NOR_READ_CACHE_LINE_SIZE];
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
 	/* Minimal SFDP stores no dynamic configuration.  Runtime and
 	 * devicetree store page size and erase_types; runtime also
 	 * stores flash size and layout.
@@ -349,6 +360,11 @@ static inline void delay_until_exit_dpd_ok(const struct device *const dev)
  */
 #define NOR_ACCESS_32BIT_ADDR BIT(2)
 
+/* Indicates that addressed access has a dummy byte after the address,
+ * as used by fast read commands.
+ */
+#define NOR_ACCESS_DUMMY_BYTE BIT(3)
+
 /* Indicates that an access command is performing a write.  If not
  * provided access is a read.
  */
@@ -374,7 +390,7 @@ static int spi_nor_access(const struct device *const dev,
 	struct spi_nor_data *const driver_data = dev->data;
 	bool is_addressed = (access & NOR_ACCESS_ADDRESSED) != 0U;
 	bool is_write = (access & NOR_ACCESS_WRITE) != 0U;
-	uint8_t buf[5] = { 0 };
+	uint8_t buf[6] = { 0 };
 	struct spi_buf spi_buf[2] = {
 		{
 			.buf = buf,
@@ -407,6 +423,10 @@ static int spi_nor_access(const struct device *const dev,
 			memcpy(&buf[1], &addr32.u8[1], 3);
 			spi_buf[0].len += 3;
 		}
+
+		if ((access & NOR_ACCESS_DUMMY_BYTE) != 0U) {
+			spi_buf[0].len += 1;
+		}
 	};
 
 	const struct spi_buf_set tx_set = {
@@ -770,6 +790,151 @@ static int mxicy_configure(const struct device *dev, const uint8_t *jedec_id)
 
 #endif /* ANY_INST_HAS_MXICY_MX25R_POWER_MODE */
 
+/* @note The device must be externally acquired before invoking this
+ * function.
+ */
+static int spi_nor_read_data(const struct device *dev, off_t addr, void *dest,
+			     size_t size)
+{
+	if (IS_ENABLED(CONFIG_SPI_NOR_FAST_READ)) {
+		return spi_nor_access(dev, SPI_NOR_CMD_READ_FAST,
+				      NOR_ACCESS_ADDRESSED | NOR_ACCESS_DUMMY_BYTE,
+				      addr, dest, size);
+	}
+
+	return spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+}
+
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+
+#define CACHE_LINE_SIZE CONFIG_SPI_NOR_READ_CACHE_LINE_SIZE
+#define CACHE_LINES CONFIG_SPI_NOR_READ_CACHE_LINES
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CACHE_LINE_SIZE) && (CACHE_LINE_SIZE <= SPI_NOR_SECTOR_SIZE),
+	     "SPI_NOR_READ_CACHE_LINE_SIZE must be a power of two of at most 4096");
+
+/* Drop the cache lines overlapping a range written or erased.
+ *
+ * @note The device must be externally acquired before invoking this
+ * function.
+ */
+static void spi_nor_cache_invalidate(const struct device *dev, off_t addr, size_t size)
+{
+	struct spi_nor_data *const data = dev->data;
+
+	for (size_t i = 0; i < CACHE_LINES; i++) {
+		off_t line = data->cache_addr[i];
+
+		if ((line >= 0) && (line < (addr + (off_t)size))
+		    && ((line + CACHE_LINE_SIZE) > addr)) {
+			data->cache_addr[i] = -1;
+		}
+	}
+
+	data->cache_next_addr = -1;
+}
+
+static void spi_nor_cache_init(const struct device *dev)
+{
+	struct spi_nor_data *const data = dev->data;
+
+	for (size_t i = 0; i < CACHE_LINES; i++) {
+		data->cache_addr[i] = -1;
+	}
+
+	data->cache_next_addr = -1;
+	data->cache_next = 0;
+}
+
+/* Get the cache line holding a flash line, reading it if missing.
+ *
+ * Lines are filled in turn, so that a line missed right after the last
+ * ones filled is read along with the following ones, in a single
+ * continuous read.
+ *
+ * @note The device must be externally acquired before invoking this
+ * function.
+ */
+static int spi_nor_cache_get(const struct device *dev, off_t line, uint8_t **buf)
+{
+	struct spi_nor_data *const data = dev->data;
+	const size_t flash_size = dev_flash_size(dev);
+	size_t first = data->cache_next;
+	size_t count = 1;
+	int ret;
+
+	for (size_t i = 0; i < CACHE_LINES; i++) {
+		if (data->cache_addr[i] == line) {
+			*buf = data->cache[i];
+			return 0;
+		}
+	}
+
+	if (line == data->cache_next_addr) {
+		count = CONFIG_SPI_NOR_READ_CACHE_READ_AHEAD;
+	}
+
+	/* Lines read at once must be contiguous, in the cache and flash */
+	count = MIN(count, CACHE_LINES - first);
+	count = MIN(count, (flash_size - line) / CACHE_LINE_SIZE);
+
+	/* Drop any line read ahead meanwhile by a non-sequential access */
+	spi_nor_cache_invalidate(dev, line, count * CACHE_LINE_SIZE);
+	for (size_t i = first; i < (first + count); i++) {
+		data->cache_addr[i] = -1;
+	}
+
+	ret = spi_nor_read_data(dev, line, data->cache[first], count * CACHE_LINE_SIZE);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		data->cache_addr[first + i] = line + (i * CACHE_LINE_SIZE);
+	}
+
+	data->cache_next = (first + count) % CACHE_LINES;
+	data->cache_next_addr = line + (count * CACHE_LINE_SIZE);
+	*buf = data->cache[first];
+
+	return 0;
+}
+
+/* @note The device must be externally acquired before invoking this
+ * function.
+ */
+static int spi_nor_cache_read(const struct device *dev, off_t addr, void *dest,
+			      size_t size)
+{
+	uint8_t *buf;
+	int ret;
+
+	/* Larger reads take a single transaction anyway */
+	if (size > CACHE_LINE_SIZE) {
+		return spi_nor_read_data(dev, addr, dest, size);
+	}
+
+	while (size > 0) {
+		off_t line = ROUND_DOWN(addr, CACHE_LINE_SIZE);
+		size_t offset = addr - line;
+		size_t len = MIN(size, CACHE_LINE_SIZE - offset);
+
+		ret = spi_nor_cache_get(dev, line, &buf);
+		if (ret != 0) {
+			return ret;
+		}
+
+		memcpy(dest, &buf[offset], len);
+		dest = (uint8_t *)dest + len;
+		addr += len;
+		size -= len;
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
 static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 			size_t size)
 {
@@ -783,7 +948,11 @@ static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 
 	acquire_device(dev);
 
-	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	ret = spi_nor_cache_read(dev, addr, dest, size);
+#else
+	ret = spi_nor_read_data(dev, addr, dest, size);
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 
 	release_device(dev);
 	return ret;
@@ -806,6 +975,10 @@ static int flash_spi_nor_ex_op(const struct device *dev, uint16_t code,
 		if (ret == 0) {
 			ret = spi_nor_cmd_write(dev, SPI_NOR_CMD_RESET_MEM);
 		}
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+		/* Reset may abort a write or erase in progress */
+		spi_nor_cache_invalidate(dev, 0, dev_flash_size(dev));
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 		break;
 	default:
 		ret = -ENOTSUP;
@@ -831,6 +1004,9 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 	}
 
 	acquire_device(dev);
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	spi_nor_cache_invalidate(dev, addr, size);
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 	ret = spi_nor_write_protection_set(dev, false);
 	if (ret == 0) {
 		while (size > 0) {
@@ -896,6 +1072,9 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 	}
 
 	acquire_device(dev);
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	spi_nor_cache_invalidate(dev, addr, size);
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
 	ret = spi_nor_write_protection_set(dev, false);
 
 	while ((size > 0) && (ret == 0)) {
@@ -1482,6 +1661,10 @@ static int spi_nor_init(const struct device *dev)
 		k_sem_init(&driver_data->sem, 1, K_SEM_MAX_LIMIT);
 	}
 
+#ifdef CONFIG_SPI_NOR_READ_CACHE
+	spi_nor_cache_init(dev);
+#endif /* CONFIG_SPI_NOR_READ_CACHE */
+
 #if ANY_INST_HAS_WP_GPIOS
 	if (DEV_CFG(dev)->wp_gpios_exist) {
 		if (!device_is_ready(DEV_CFG(dev)->wp.port)) {
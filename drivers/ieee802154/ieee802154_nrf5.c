@@ -392,14 +392,15 @@ static int nrf5_set_txpower(const struct device *dev, int16_t dbm)
 	return 0;
 }
 
-static int handle_ack(struct nrf5_802154_data *nrf5_radio)
+static int handle_ack(struct nrf5_802154_data *nrf5_radio,
+		      struct nrf5_802154_rx_frame *ack_frame)
 {
 	uint8_t ack_len;
 	struct net_pkt *ack_pkt;
 	int err = 0;
 
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
-	if (nrf5_radio->ack_frame.time == NRF_802154_NO_TIMESTAMP) {
+	if (ack_frame->time == NRF_802154_NO_TIMESTAMP) {
 		/* Ack timestamp is invalid and cannot be used by the upper layer.
 		 * Report the transmission as failed as if the Ack was not received at all.
 		 */
@@ -410,9 +411,9 @@ static int handle_ack(struct nrf5_802154_data *nrf5_radio)
 #endif
 
 	if (IS_ENABLED(CONFIG_IEEE802154_NRF5_FCS_IN_LENGTH)) {
-		ack_len = nrf5_radio->ack_frame.psdu[0];
+		ack_len = ack_frame->psdu[0];
 	} else {
-		ack_len = nrf5_radio->ack_frame.psdu[0] - IEEE802154_FCS_LENGTH;
+		ack_len = ack_frame->psdu[0] - IEEE802154_FCS_LENGTH;
 	}
 
 	ack_pkt = net_pkt_rx_alloc_with_buffer(nrf5_radio->iface, ack_len,
@@ -426,18 +427,18 @@ static int handle_ack(struct nrf5_802154_data *nrf5_radio)
 	/* Upper layers expect the frame to start at the MAC header, skip the
 	 * PHY header (1 byte).
 	 */
-	if (net_pkt_write(ack_pkt, nrf5_radio->ack_frame.psdu + 1,
+	if (net_pkt_write(ack_pkt, ack_frame->psdu + 1,
 			  ack_len) < 0) {
 		LOG_ERR("Failed to write to a packet.");
 		err = -ENOMEM;
 		goto free_net_ack;
 	}
 
-	net_pkt_set_ieee802154_lqi(ack_pkt, nrf5_radio->ack_frame.lqi);
-	net_pkt_set_ieee802154_rssi_dbm(ack_pkt, nrf5_radio->ack_frame.rssi);
+	net_pkt_set_ieee802154_lqi(ack_pkt, ack_frame->lqi);
+	net_pkt_set_ieee802154_rssi_dbm(ack_pkt, ack_frame->rssi);
 
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
-	net_pkt_set_timestamp_ns(ack_pkt, nrf5_radio->ack_frame.time * NSEC_PER_USEC);
+	net_pkt_set_timestamp_ns(ack_pkt, ack_frame->time * NSEC_PER_USEC);
 #endif
 
 	net_pkt_cursor_init(ack_pkt);
@@ -450,8 +451,8 @@ free_net_ack:
 	net_pkt_unref(ack_pkt);
 
 free_nrf_ack:
-	nrf_802154_buffer_free_raw(nrf5_radio->ack_frame.psdu);
-	nrf5_radio->ack_frame.psdu = NULL;
+	nrf_802154_buffer_free_raw(ack_frame->psdu);
+	ack_frame->psdu = NULL;
 
 	return err;
 }
@@ -556,6 +557,57 @@ static bool nrf5_tx_at(struct nrf5_802154_data *nrf5_radio, struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+/* Reports the outcome of a transmission the radio driver called back for. */
+static int nrf5_tx_complete(struct nrf5_802154_data *nrf5_radio,
+			    struct net_pkt *pkt,
+			    struct net_buf *frag,
+			    const uint8_t *psdu,
+			    struct nrf5_802154_tx_status *status)
+{
+	LOG_DBG("Result: %d", status->result);
+
+#if defined(CONFIG_NRF_802154_ENCRYPTION)
+	/*
+	 * When frame encryption by the radio driver is enabled, the frame stored in
+	 * the TX buffer is:
+	 * 1) authenticated and encrypted in place which causes that after an unsuccessful
+	 *    TX attempt, this frame must be propagated back to the upper layer for retransmission.
+	 *    The upper layer must ensure that the exact same secured frame is used for
+	 *    retransmission
+	 * 2) frame counters are updated in place and for keeping the link frame counter up to date,
+	 *    this information must be propagated back to the upper layer
+	 */
+	memcpy(frag->data, psdu + 1, frag->len);
+#else
+	ARG_UNUSED(frag);
+	ARG_UNUSED(psdu);
+#endif
+	net_pkt_set_ieee802154_frame_secured(pkt, status->is_secured);
+	net_pkt_set_ieee802154_mac_hdr_rdy(pkt, status->mac_hdr_rdy);
+
+	switch (status->result) {
+	case NRF_802154_TX_ERROR_NONE:
+		if (status->ack_frame.psdu == NULL) {
+			/* No ACK was requested. */
+			return 0;
+		}
+		/* Handle ACK packet. */
+		return handle_ack(nrf5_radio, &status->ack_frame);
+	case NRF_802154_TX_ERROR_NO_MEM:
+		return -ENOBUFS;
+	case NRF_802154_TX_ERROR_BUSY_CHANNEL:
+		return -EBUSY;
+	case NRF_802154_TX_ERROR_INVALID_ACK:
+	case NRF_802154_TX_ERROR_NO_ACK:
+		return -ENOMSG;
+	case NRF_802154_TX_ERROR_ABORTED:
+	case NRF_802154_TX_ERROR_TIMESLOT_DENIED:
+	case NRF_802154_TX_ERROR_TIMESLOT_ENDED:
+	default:
+		return -EIO;
+	}
+}
+
 static int nrf5_tx(const struct device *dev,
 		   enum ieee802154_tx_mode mode,
 		   struct net_pkt *pkt,
@@ -618,47 +670,229 @@ static int nrf5_tx(const struct device *dev,
 	/* Wait for the callback from the radio driver. */
 	k_sem_take(&nrf5_radio->tx_wait, K_FOREVER);
 
-	LOG_DBG("Result: %d", nrf5_data.tx_result);
+	return nrf5_tx_complete(nrf5_radio, pkt, frag, nrf5_radio->tx_psdu,
+				&nrf5_radio->tx_status);
+}
 
-#if defined(CONFIG_NRF_802154_ENCRYPTION)
-	/*
-	 * When frame encryption by the radio driver is enabled, the frame stored in
-	 * the tx_psdu buffer is:
-	 * 1) authenticated and encrypted in place which causes that after an unsuccessful
-	 *    TX attempt, this frame must be propagated back to the upper layer for retransmission.
-	 *    The upper layer must ensure that the exact same secured frame is used for
-	 *    retransmission
-	 * 2) frame counters are updated in place and for keeping the link frame counter up to date,
-	 *    this information must be propagated back to the upper layer
-	 */
-	memcpy(payload, nrf5_radio->tx_psdu + 1, payload_len);
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+/* Only frames that are sent right away can be chained from the transmit
+ * callback.
+ */
+static bool nrf5_tx_queue_mode_supported(enum ieee802154_tx_mode mode)
+{
+	switch (mode) {
+	case IEEE802154_TX_MODE_DIRECT:
+	case IEEE802154_TX_MODE_CCA:
+#if NRF_802154_CSMA_CA_ENABLED
+	case IEEE802154_TX_MODE_CSMA_CA:
 #endif
-	net_pkt_set_ieee802154_frame_secured(pkt, nrf5_radio->tx_frame_is_secured);
-	net_pkt_set_ieee802154_mac_hdr_rdy(pkt, nrf5_radio->tx_frame_mac_hdr_rdy);
+		return true;
+	default:
+		return false;
+	}
+}
 
-	switch (nrf5_radio->tx_result) {
-	case NRF_802154_TX_ERROR_NONE:
-		if (nrf5_radio->ack_frame.psdu == NULL) {
-			/* No ACK was requested. */
-			return 0;
+/* Must be called with tx_queue_lock held, is also called from the transmit
+ * callbacks.
+ */
+static void nrf5_tx_queue_start(struct nrf5_802154_tx_slot *slot)
+{
+	struct ieee802154_tx_frame *frame = slot->frame;
+	bool ret;
+
+#if NRF_802154_CSMA_CA_ENABLED
+	if (frame->mode == IEEE802154_TX_MODE_CSMA_CA) {
+		ret = nrf5_tx_csma_ca(frame->pkt, slot->psdu);
+	} else
+#endif
+	{
+		ret = nrf5_tx_immediate(frame->pkt, slot->psdu,
+					frame->mode == IEEE802154_TX_MODE_CCA);
+	}
+
+	if (ret) {
+		slot->state = NRF5_TX_SLOT_ON_AIR;
+	} else {
+		LOG_ERR("Cannot send frame");
+		slot->status.result = NRF_802154_TX_ERROR_ABORTED;
+		slot->status.ack_frame.psdu = NULL;
+		slot->state = NRF5_TX_SLOT_DONE;
+	}
+}
+
+/* Queues a prepared frame behind the previous one, or starts it if there is
+ * none. Returns false if the previous frame failed.
+ */
+static bool nrf5_tx_queue_submit(struct nrf5_802154_data *nrf5_radio,
+				 struct nrf5_802154_tx_slot *slot,
+				 struct nrf5_802154_tx_slot *prev)
+{
+	k_spinlock_key_t key;
+	bool ret = true;
+
+	key = k_spin_lock(&nrf5_radio->tx_queue_lock);
+
+	switch (prev->state) {
+	case NRF5_TX_SLOT_ON_AIR:
+		slot->state = NRF5_TX_SLOT_ARMED;
+		break;
+	case NRF5_TX_SLOT_DONE:
+		if (prev->status.result != NRF_802154_TX_ERROR_NONE) {
+			ret = false;
+			break;
 		}
-		/* Handle ACK packet. */
-		return handle_ack(nrf5_radio);
-	case NRF_802154_TX_ERROR_NO_MEM:
-		return -ENOBUFS;
-	case NRF_802154_TX_ERROR_BUSY_CHANNEL:
-		return -EBUSY;
-	case NRF_802154_TX_ERROR_INVALID_ACK:
-	case NRF_802154_TX_ERROR_NO_ACK:
-		return -ENOMSG;
-	case NRF_802154_TX_ERROR_ABORTED:
-	case NRF_802154_TX_ERROR_TIMESLOT_DENIED:
-	case NRF_802154_TX_ERROR_TIMESLOT_ENDED:
+		__fallthrough;
 	default:
-		return -EIO;
+		nrf5_tx_queue_start(slot);
+		break;
+	}
+
+	k_spin_unlock(&nrf5_radio->tx_queue_lock, key);
+
+	return ret;
+}
+
+static void nrf5_tx_queue_wait(struct nrf5_802154_data *nrf5_radio,
+			       struct nrf5_802154_tx_slot *slot)
+{
+	while (slot->state != NRF5_TX_SLOT_DONE) {
+		k_sem_take(&nrf5_radio->tx_wait, K_FOREVER);
 	}
 }
 
+static int nrf5_tx_queue_complete(const struct device *dev,
+				  struct nrf5_802154_tx_slot *slot)
+{
+	struct nrf5_802154_data *nrf5_radio = NRF5_802154_DATA(dev);
+	struct ieee802154_tx_frame *frame = slot->frame;
+
+	frame->status = nrf5_tx_complete(nrf5_radio, frame->pkt, frame->frag, slot->psdu,
+					 &slot->status);
+	slot->state = NRF5_TX_SLOT_FREE;
+
+	if (nrf5_data.event_handler) {
+		nrf5_data.event_handler(dev, IEEE802154_EVENT_TX_DONE, (void *)frame);
+	}
+
+	return frame->status;
+}
+
+/* Keeps up to two frames in the TX queue: frame N+1 is copied into the
+ * second TX buffer while frame N is on air and started from the transmit
+ * callback of frame N. The completion of frame N, including its ACK, is
+ * handled by the calling thread while frame N+1 is on air.
+ */
+static int nrf5_tx_batch_queued(const struct device *dev,
+				struct ieee802154_tx_frame *frames,
+				size_t count)
+{
+	struct nrf5_802154_data *nrf5_radio = NRF5_802154_DATA(dev);
+	struct nrf5_802154_tx_slot *slot;
+	size_t prepared = 0;
+	size_t done = 0;
+	int ret = 0;
+
+	k_sem_reset(&nrf5_radio->tx_wait);
+
+	ARRAY_FOR_EACH_PTR(nrf5_radio->tx_slots, s) {
+		s->state = NRF5_TX_SLOT_FREE;
+	}
+
+	nrf5_radio->tx_queue_active = true;
+
+	while (done < count) {
+		while (prepared < count && prepared < done + ARRAY_SIZE(nrf5_radio->tx_slots)) {
+			struct ieee802154_tx_frame *frame = &frames[prepared];
+
+			slot = &nrf5_radio->tx_slots[prepared % 2];
+			slot->frame = frame;
+			slot->psdu[0] = frame->frag->len + IEEE802154_FCS_LENGTH;
+			memcpy(slot->psdu + 1, frame->frag->data, frame->frag->len);
+
+			if (!nrf5_tx_queue_submit(nrf5_radio, slot,
+						  &nrf5_radio->tx_slots[(prepared + 1) % 2])) {
+				break;
+			}
+
+			nrf5_tx_started(dev, frame->pkt, frame->frag);
+			prepared++;
+		}
+
+		slot = &nrf5_radio->tx_slots[done % 2];
+		nrf5_tx_queue_wait(nrf5_radio, slot);
+
+		ret = nrf5_tx_queue_complete(dev, slot);
+		if (ret != 0) {
+			break;
+		}
+
+		done++;
+	}
+
+	/* A frame that was chained before the ACK handling of its predecessor
+	 * failed is already on air, it does not count as transmitted.
+	 */
+	if (ret != 0 && prepared > done + 1) {
+		slot = &nrf5_radio->tx_slots[(done + 1) % 2];
+		if (slot->state != NRF5_TX_SLOT_ARMED) {
+			nrf5_tx_queue_wait(nrf5_radio, slot);
+			(void)nrf5_tx_queue_complete(dev, slot);
+		}
+	}
+
+	nrf5_radio->tx_queue_active = false;
+
+	return done;
+}
+#endif /* CONFIG_IEEE802154_NRF5_TX_QUEUE */
+
+static int nrf5_tx_batch(const struct device *dev,
+			 struct ieee802154_tx_frame *frames,
+			 size_t count)
+{
+	size_t i;
+
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+	bool queued = true;
+
+	for (i = 0; i < count; i++) {
+		if (!nrf5_tx_queue_mode_supported(frames[i].mode) ||
+		    frames[i].frag->len > IEEE802154_MTU) {
+			queued = false;
+			break;
+		}
+	}
+
+	if (queued) {
+		return nrf5_tx_batch_queued(dev, frames, count);
+	}
+#endif
+
+	for (i = 0; i < count; i++) {
+		struct ieee802154_tx_frame *frame = &frames[i];
+
+#if defined(CONFIG_NET_PKT_TXTIME)
+		if (frame->mode == IEEE802154_TX_MODE_TXTIME ||
+		    frame->mode == IEEE802154_TX_MODE_TXTIME_CCA) {
+			net_pkt_set_timestamp_ns(frame->pkt, frame->txtime);
+		}
+#endif
+
+		frame->status = nrf5_tx(dev, frame->mode, frame->pkt, frame->frag);
+
+		if (nrf5_data.event_handler) {
+			nrf5_data.event_handler(dev, IEEE802154_EVENT_TX_DONE,
+						(void *)frame);
+		}
+
+		if (frame->status != 0) {
+			break;
+		}
+	}
+
+	return i;
+}
+
 static net_time_t nrf5_get_time(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -1136,31 +1370,93 @@ void nrf_802154_tx_ack_started(const uint8_t *data)
 	nrf5_data.last_frame_ack_seb = data[SECURITY_ENABLED_OFFSET] & SECURITY_ENABLED_BIT;
 }
 
-void nrf_802154_transmitted_raw(uint8_t *frame,
-				const nrf_802154_transmit_done_metadata_t *metadata)
+static void nrf5_tx_status_set(struct nrf5_802154_tx_status *status,
+			       nrf_802154_tx_error_t error,
+			       const nrf_802154_transmit_done_metadata_t *metadata)
 {
-	ARG_UNUSED(frame);
+	status->result = error;
+	status->is_secured = metadata->frame_props.is_secured;
+	status->mac_hdr_rdy = metadata->frame_props.dynamic_data_is_set;
+	status->ack_frame.psdu = NULL;
 
-	nrf5_data.tx_result = NRF_802154_TX_ERROR_NONE;
-	nrf5_data.tx_frame_is_secured = metadata->frame_props.is_secured;
-	nrf5_data.tx_frame_mac_hdr_rdy = metadata->frame_props.dynamic_data_is_set;
-	nrf5_data.ack_frame.psdu = metadata->data.transmitted.p_ack;
+	if (error != NRF_802154_TX_ERROR_NONE) {
+		return;
+	}
+
+	status->ack_frame.psdu = metadata->data.transmitted.p_ack;
 
-	if (nrf5_data.ack_frame.psdu) {
-		nrf5_data.ack_frame.rssi = metadata->data.transmitted.power;
-		nrf5_data.ack_frame.lqi = metadata->data.transmitted.lqi;
+	if (status->ack_frame.psdu) {
+		status->ack_frame.rssi = metadata->data.transmitted.power;
+		status->ack_frame.lqi = metadata->data.transmitted.lqi;
 
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 		if (metadata->data.transmitted.time == NRF_802154_NO_TIMESTAMP) {
 			/* Ack timestamp is invalid. Keep this value to detect it when handling Ack
 			 */
-			nrf5_data.ack_frame.time = NRF_802154_NO_TIMESTAMP;
+			status->ack_frame.time = NRF_802154_NO_TIMESTAMP;
 		} else {
-			nrf5_data.ack_frame.time = nrf_802154_timestamp_end_to_phr_convert(
-				metadata->data.transmitted.time, nrf5_data.ack_frame.psdu[0]);
+			status->ack_frame.time = nrf_802154_timestamp_end_to_phr_convert(
+				metadata->data.transmitted.time, status->ack_frame.psdu[0]);
 		}
 #endif
 	}
+}
+
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+/* Completes a frame of the TX queue and starts the next one if it is
+ * already prepared. Returns false if the frame is not from the TX queue.
+ */
+static bool nrf5_tx_queue_done(uint8_t *frame, nrf_802154_tx_error_t error,
+			       const nrf_802154_transmit_done_metadata_t *metadata)
+{
+	struct nrf5_802154_tx_slot *slot, *next;
+	k_spinlock_key_t key;
+
+	if (!nrf5_data.tx_queue_active) {
+		return false;
+	}
+
+	if (frame == nrf5_data.tx_slots[0].psdu) {
+		slot = &nrf5_data.tx_slots[0];
+		next = &nrf5_data.tx_slots[1];
+	} else if (frame == nrf5_data.tx_slots[1].psdu) {
+		slot = &nrf5_data.tx_slots[1];
+		next = &nrf5_data.tx_slots[0];
+	} else {
+		return false;
+	}
+
+	nrf5_tx_status_set(&slot->status, error, metadata);
+
+	key = k_spin_lock(&nrf5_data.tx_queue_lock);
+
+	slot->state = NRF5_TX_SLOT_DONE;
+
+	/* Chain the next frame without waiting for the TX thread. */
+	if (error == NRF_802154_TX_ERROR_NONE && next->state == NRF5_TX_SLOT_ARMED) {
+		nrf5_tx_queue_start(next);
+	}
+
+	k_spin_unlock(&nrf5_data.tx_queue_lock, key);
+
+	k_sem_give(&nrf5_data.tx_wait);
+
+	return true;
+}
+#endif /* CONFIG_IEEE802154_NRF5_TX_QUEUE */
+
+void nrf_802154_transmitted_raw(uint8_t *frame,
+				const nrf_802154_transmit_done_metadata_t *metadata)
+{
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+	if (nrf5_tx_queue_done(frame, NRF_802154_TX_ERROR_NONE, metadata)) {
+		return;
+	}
+#else
+	ARG_UNUSED(frame);
+#endif
+
+	nrf5_tx_status_set(&nrf5_data.tx_status, NRF_802154_TX_ERROR_NONE, metadata);
 
 	k_sem_give(&nrf5_data.tx_wait);
 }
@@ -1169,11 +1465,15 @@ void nrf_802154_transmit_failed(uint8_t *frame,
 				nrf_802154_tx_error_t error,
 				const nrf_802154_transmit_done_metadata_t *metadata)
 {
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+	if (nrf5_tx_queue_done(frame, error, metadata)) {
+		return;
+	}
+#else
 	ARG_UNUSED(frame);
+#endif
 
-	nrf5_data.tx_result = error;
-	nrf5_data.tx_frame_is_secured = metadata->frame_props.is_secured;
-	nrf5_data.tx_frame_mac_hdr_rdy = metadata->frame_props.dynamic_data_is_set;
+	nrf5_tx_status_set(&nrf5_data.tx_status, error, metadata);
 
 	k_sem_give(&nrf5_data.tx_wait);
 }
@@ -1240,6 +1540,7 @@ static const struct ieee802154_radio_api nrf5_radio_api = {
 	.continuous_carrier = nrf5_continuous_carrier,
 #endif
 	.tx = nrf5_tx,
+	.tx_batch = nrf5_tx_batch,
 	.ed_scan = nrf5_energy_scan_start,
 	.get_time = nrf5_get_time,
 	.get_sch_acc = nrf5_get_acc,
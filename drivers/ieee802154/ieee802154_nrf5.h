@@ -22,6 +22,49 @@ struct nrf5_802154_rx_frame {
 	bool ack_seb; /* SEB value in ACK sent for the received frame. */
 };
 
+/* Outcome of a transmission, updated in radio transmit callbacks. */
+struct nrf5_802154_tx_status {
+	/* TX result. */
+	uint8_t result;
+
+	/* Indicates if the transmitted frame is secured. */
+	bool is_secured;
+
+	/* Indicates if the transmitted frame has dynamic data updated. */
+	bool mac_hdr_rdy;
+
+	/* A buffer for the received ACK frame. psdu pointer be NULL if no
+	 * ACK was requested/received.
+	 */
+	struct nrf5_802154_rx_frame ack_frame;
+};
+
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+enum nrf5_802154_tx_slot_state {
+	NRF5_TX_SLOT_FREE,
+	/* Prepared, to be started as soon as the radio is done. */
+	NRF5_TX_SLOT_ARMED,
+	NRF5_TX_SLOT_ON_AIR,
+	/* Completed, status is valid. */
+	NRF5_TX_SLOT_DONE,
+};
+
+/* Slot of the TX queue used by tx_batch(). */
+struct nrf5_802154_tx_slot {
+	/* TX buffer. First byte is PHR (length), remaining bytes are
+	 * MPDU data.
+	 */
+	uint8_t psdu[NRF5_PHR_LENGTH + IEEE802154_MAX_PHY_PACKET_SIZE];
+
+	/* Frame descriptor of the batch. */
+	struct ieee802154_tx_frame *frame;
+
+	struct nrf5_802154_tx_status status;
+
+	enum nrf5_802154_tx_slot_state state;
+};
+#endif /* CONFIG_IEEE802154_NRF5_TX_QUEUE */
+
 struct nrf5_802154_data {
 	/* Pointer to the network interface. */
 	struct net_if *iface;
@@ -65,13 +108,22 @@ struct nrf5_802154_data {
 	 */
 	uint8_t tx_psdu[NRF5_PHR_LENGTH + IEEE802154_MAX_PHY_PACKET_SIZE];
 
-	/* TX result, updated in radio transmit callbacks. */
-	uint8_t tx_result;
+	/* Outcome of the transmission of tx_psdu. */
+	struct nrf5_802154_tx_status tx_status;
 
-	/* A buffer for the received ACK frame. psdu pointer be NULL if no
-	 * ACK was requested/received.
+#if defined(CONFIG_IEEE802154_NRF5_TX_QUEUE)
+	/* Double buffered TX queue: while the frame of one slot is on air the
+	 * next frame is prepared in the other slot, so that the transmit
+	 * callback can start it right away.
 	 */
-	struct nrf5_802154_rx_frame ack_frame;
+	struct nrf5_802154_tx_slot tx_slots[2];
+
+	/* Protects the slot states against the transmit callbacks. */
+	struct k_spinlock tx_queue_lock;
+
+	/* Indicates if transmit callbacks refer to the TX queue. */
+	bool tx_queue_active;
+#endif
 
 	/* Callback handler of the currently ongoing energy scan.
 	 * It shall be NULL if energy scan is not in progress.
@@ -86,12 +138,6 @@ struct nrf5_802154_data {
 	/* Capabilities of the network interface. */
 	enum ieee802154_hw_caps capabilities;
 
-	/* Indicates if currently processed TX frame is secured. */
-	bool tx_frame_is_secured;
-
-	/* Indicates if currently processed TX frame has dynamic data updated. */
-	bool tx_frame_mac_hdr_rdy;
-
 #if defined(CONFIG_IEEE802154_NRF5_MULTIPLE_CCA)
 	/* The maximum number of extra CCA attempts to be performed before transmission. */
 	uint8_t max_extra_cca_attempts;
@@ -263,19 +263,24 @@ void sensor_processing_with_callback(struct rtio *ctx, sensor_processing_callbac
 	/* Wait for a CQE */
 	struct rtio_cqe *cqe = rtio_cqe_consume_block(ctx);
 
-	/* Cache the data from the CQE */
-	rc = cqe->result;
-	userdata = cqe->userdata;
-	rtio_cqe_get_mempool_buffer(ctx, cqe, &buf, &buf_len);
+	for (int i = 0; i < CONFIG_SENSOR_PROCESSING_BATCH_SIZE && cqe != NULL; i++) {
+		/* Cache the data from the CQE */
+		rc = cqe->result;
+		userdata = cqe->userdata;
+		rtio_cqe_get_mempool_buffer(ctx, cqe, &buf, &buf_len);
 
-	/* Release the CQE */
-	rtio_cqe_release(ctx, cqe);
+		/* Release the CQE */
+		rtio_cqe_release(ctx, cqe);
 
-	/* Call the callback */
-	cb(rc, buf, buf_len, userdata);
+		/* Call the callback */
+		cb(rc, buf, buf_len, userdata);
 
-	/* Release the memory */
-	rtio_release_buffer(ctx, buf, buf_len);
+		/* Release the memory */
+		rtio_release_buffer(ctx, buf, buf_len);
+
+		/* Process the CQEs which completed in the meantime without waiting */
+		cqe = i + 1 < CONFIG_SENSOR_PROCESSING_BATCH_SIZE ? rtio_cqe_consume(ctx) : NULL;
+	}
 }
 
 /**
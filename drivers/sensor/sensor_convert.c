@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor_convert.h>
+#include <zephyr/sys/byteorder.h>
+
+#if defined(CONFIG_SENSOR_CONVERT_CMSIS_DSP)
+#include <arm_math.h>
+#endif
+
+/* 2^exp without pulling in libm, shifts are small */
+static float pow2f(int exp)
+{
+	float value = 1.0f;
+
+	for (; exp > 0; --exp) {
+		value *= 2.0f;
+	}
+	for (; exp < 0; ++exp) {
+		value *= 0.5f;
+	}
+
+	return value;
+}
+
+/* Sign extend a packed 24-bit sample into the top of a Q31 value */
+static inline q31_t i24le_to_q31(const uint8_t *src)
+{
+	return (q31_t)(sys_get_le24(src) << 8);
+}
+
+#if defined(CONFIG_SENSOR_CONVERT_CMSIS_DSP)
+
+void sensor_convert_i16_to_q31(const int16_t *src, q31_t scale, int8_t shift, q31_t *dst,
+			       size_t count)
+{
+	arm_q15_to_q31(src, dst, count);
+	arm_scale_q31(dst, scale, shift, dst, count);
+}
+
+void sensor_convert_i24le_to_q31(const uint8_t *src, q31_t scale, int8_t shift, q31_t *dst,
+				 size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = i24le_to_q31(&src[i * 3]);
+	}
+
+	arm_scale_q31(dst, scale, shift, dst, count);
+}
+
+void sensor_convert_q31_to_float(const q31_t *src, int8_t shift, float *dst, size_t count)
+{
+	arm_q31_to_float(src, dst, count);
+	if (shift != 0) {
+		arm_scale_f32(dst, pow2f(shift), dst, count);
+	}
+}
+
+#else
+
+/* Same rounding and saturation as arm_scale_q31() so both backends agree */
+static inline q31_t scale_q31(q31_t value, q31_t scale, int8_t shift)
+{
+	int32_t k_shift = shift + 1;
+	int32_t out = (int32_t)(((int64_t)value * scale) >> 32);
+
+	if (k_shift < 0) {
+		return out >> -k_shift;
+	}
+
+	if (k_shift >= 31 || out != (int32_t)((uint32_t)out << k_shift) >> k_shift) {
+		return out < 0 ? INT32_MIN : INT32_MAX;
+	}
+
+	return (int32_t)((uint32_t)out << k_shift);
+}
+
+void sensor_convert_i16_to_q31(const int16_t *src, q31_t scale, int8_t shift, q31_t *dst,
+			       size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = scale_q31((q31_t)((uint32_t)src[i] << 16), scale, shift);
+	}
+}
+
+void sensor_convert_i24le_to_q31(const uint8_t *src, q31_t scale, int8_t shift, q31_t *dst,
+				 size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = scale_q31(i24le_to_q31(&src[i * 3]), scale, shift);
+	}
+}
+
+void sensor_convert_q31_to_float(const q31_t *src, int8_t shift, float *dst, size_t count)
+{
+	const float scale = pow2f(shift - 31);
+
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = (float)src[i] * scale;
+	}
+}
+
+#endif /* CONFIG_SENSOR_CONVERT_CMSIS_DSP */
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/sensor_fifo_stream.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(sensor_fifo_stream, CONFIG_SENSOR_LOG_LEVEL);
+
+void sensor_fifo_stream_init(struct sensor_fifo_stream *stream, const struct device *dev,
+			     const struct sensor_fifo_stream_config *cfg, struct rtio *r,
+			     struct rtio_iodev *iodev, uint16_t frame_size)
+{
+	__ASSERT_NO_MSG(frame_size > 0);
+
+	memset(stream, 0, sizeof(*stream));
+	stream->cfg = cfg;
+	stream->dev = dev;
+	stream->r = r;
+	stream->iodev = iodev;
+	stream->frame_size = frame_size;
+}
+
+void sensor_fifo_stream_submit(struct sensor_fifo_stream *stream,
+			       struct rtio_iodev_sqe *iodev_sqe)
+{
+	stream->streaming_sqe = iodev_sqe;
+}
+
+static const struct sensor_stream_trigger *
+read_config_trigger(const struct sensor_read_config *read_cfg, enum sensor_trigger_type trig)
+{
+	for (int i = 0; i < read_cfg->count; ++i) {
+		if (read_cfg->triggers[i].trigger == trig) {
+			return &read_cfg->triggers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Complete the streaming submission and rearm the interrupt */
+static void stream_complete(struct sensor_fifo_stream *stream, struct rtio_iodev_sqe *iodev_sqe,
+			    int result)
+{
+	if (result < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, result);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, result);
+	}
+
+	stream->cfg->int_enable(stream->dev);
+}
+
+/* Queue the read of a register into buf, followed by cb if given */
+static int prep_reg_read(struct sensor_fifo_stream *stream, uint8_t reg, uint8_t *buf,
+			 uint32_t len, rtio_callback_t cb)
+{
+	struct rtio *r = stream->r;
+	struct rtio_sqe *write_addr = rtio_sqe_acquire(r);
+	struct rtio_sqe *read_data = rtio_sqe_acquire(r);
+	struct rtio_sqe *callback = cb != NULL ? rtio_sqe_acquire(r) : NULL;
+	uint8_t addr = reg | stream->cfg->read_flag;
+
+	if (write_addr == NULL || read_data == NULL || (cb != NULL && callback == NULL)) {
+		rtio_sqe_drop_all(r);
+		return -ENOMEM;
+	}
+
+	rtio_sqe_prep_tiny_write(write_addr, stream->iodev, RTIO_PRIO_NORM, &addr, 1, NULL);
+	write_addr->flags = RTIO_SQE_TRANSACTION | RTIO_SQE_NO_RESPONSE;
+	rtio_sqe_prep_read(read_data, stream->iodev, RTIO_PRIO_NORM, buf, len, NULL);
+	read_data->flags = RTIO_SQE_NO_RESPONSE;
+	read_data->iodev_flags = stream->cfg->read_iodev_flags;
+
+	if (callback != NULL) {
+		read_data->flags |= RTIO_SQE_CHAINED;
+		rtio_sqe_prep_callback(callback, cb, stream, NULL);
+		callback->flags = RTIO_SQE_NO_RESPONSE;
+	}
+
+	return 0;
+}
+
+static void fifo_data_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+	struct rtio_iodev_sqe *iodev_sqe = stream->streaming_sqe;
+
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+
+	stream->streaming_sqe = NULL;
+	stream_complete(stream, iodev_sqe, 0);
+}
+
+static void fifo_count_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+	const struct sensor_fifo_stream_config *cfg = stream->cfg;
+	struct rtio_iodev_sqe *iodev_sqe = stream->streaming_sqe;
+	uint16_t fifo_count = cfg->fifo_count_big_endian ? sys_get_be16(stream->fifo_count)
+							  : sys_get_le16(stream->fifo_count);
+	uint32_t frames = fifo_count / stream->frame_size;
+	uint32_t min_read_size = cfg->header_size + stream->frame_size;
+	uint32_t ideal_read_size = cfg->header_size + frames * stream->frame_size;
+	struct sensor_fifo_stream_event event;
+	uint8_t *buf;
+	uint32_t buf_len;
+	uint32_t read_len;
+	int rc;
+
+	ARG_UNUSED(sqe);
+
+	/* Frames left behind by the previous read were sampled before it */
+	if (stream->prev_timestamp_ns != 0 && frames > stream->backlog) {
+		stream->period_ns = sensor_fifo_stream_period_update(
+			stream->period_ns, stream->timestamp_ns - stream->prev_timestamp_ns,
+			frames - stream->backlog);
+	}
+	stream->prev_timestamp_ns = stream->timestamp_ns;
+
+	rc = rtio_sqe_rx_buf(iodev_sqe, MIN(min_read_size, ideal_read_size), ideal_read_size, &buf,
+			     &buf_len);
+	if (rc != 0) {
+		LOG_ERR("Failed to get buffer");
+		stream->backlog = frames;
+		stream->streaming_sqe = NULL;
+		stream_complete(stream, iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	read_len = MIN(frames, (buf_len - cfg->header_size) / stream->frame_size);
+	stream->backlog = frames - read_len;
+	read_len *= stream->frame_size;
+
+	event = (struct sensor_fifo_stream_event){
+		.timestamp_ns = stream->timestamp_ns,
+		.period_ns = stream->period_ns,
+		.fifo_len = read_len,
+		.int_status = stream->int_status,
+	};
+	cfg->header_fill(stream->dev, buf, &event);
+
+	if (read_len == 0) {
+		stream->streaming_sqe = NULL;
+		stream_complete(stream, iodev_sqe, 0);
+		return;
+	}
+
+	/* Burst read the whole FIFO straight into the submission's buffer */
+	rc = prep_reg_read(stream, cfg->fifo_data_reg, buf + cfg->header_size, read_len,
+			   fifo_data_cb);
+	if (rc != 0) {
+		stream->streaming_sqe = NULL;
+		stream_complete(stream, iodev_sqe, rc);
+		return;
+	}
+
+	rtio_submit(r, 0);
+}
+
+static void int_status_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+	const struct sensor_fifo_stream_config *cfg = stream->cfg;
+	struct rtio_iodev_sqe *iodev_sqe = stream->streaming_sqe;
+	const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+	const struct sensor_stream_trigger *watermark_trig =
+		read_config_trigger(read_cfg, SENSOR_TRIG_FIFO_WATERMARK);
+	const struct sensor_stream_trigger *full_trig =
+		read_config_trigger(read_cfg, SENSOR_TRIG_FIFO_FULL);
+	bool has_watermark = watermark_trig != NULL && (stream->int_status & cfg->watermark_mask);
+	bool has_full = full_trig != NULL && (stream->int_status & cfg->full_mask);
+	enum sensor_stream_data_opt data_opt;
+	int rc;
+
+	ARG_UNUSED(sqe);
+
+	if (!has_watermark && !has_full) {
+		cfg->int_enable(stream->dev);
+		return;
+	}
+
+	if (has_watermark && has_full) {
+		data_opt = MIN(watermark_trig->opt, full_trig->opt);
+	} else {
+		data_opt = has_watermark ? watermark_trig->opt : full_trig->opt;
+	}
+
+	if (data_opt == SENSOR_STREAM_DATA_NOP || data_opt == SENSOR_STREAM_DATA_DROP) {
+		struct sensor_fifo_stream_event event = {
+			.timestamp_ns = stream->timestamp_ns,
+			.period_ns = stream->period_ns,
+			.int_status = stream->int_status,
+		};
+		uint8_t *buf;
+		uint32_t buf_len;
+
+		stream->streaming_sqe = NULL;
+
+		/* The fill level isn't read, so the next read can't measure the period */
+		stream->prev_timestamp_ns = 0;
+		stream->backlog = 0;
+
+		if (data_opt == SENSOR_STREAM_DATA_DROP) {
+			struct rtio_sqe *flush = rtio_sqe_acquire(r);
+
+			if (flush != NULL) {
+				uint8_t write_buf[] = {cfg->flush_reg, cfg->flush_val};
+
+				rtio_sqe_prep_tiny_write(flush, stream->iodev, RTIO_PRIO_NORM,
+							 write_buf, sizeof(write_buf), NULL);
+				flush->flags = RTIO_SQE_NO_RESPONSE;
+				rtio_submit(r, 0);
+			}
+		}
+
+		rc = rtio_sqe_rx_buf(iodev_sqe, cfg->header_size, cfg->header_size, &buf,
+				     &buf_len);
+		if (rc != 0) {
+			stream_complete(stream, iodev_sqe, -ENOMEM);
+			return;
+		}
+
+		memset(buf, 0, buf_len);
+		cfg->header_fill(stream->dev, buf, &event);
+		stream_complete(stream, iodev_sqe, 0);
+		return;
+	}
+
+	rc = prep_reg_read(stream, cfg->fifo_count_reg, stream->fifo_count,
+			   sizeof(stream->fifo_count), fifo_count_cb);
+	if (rc != 0) {
+		stream->streaming_sqe = NULL;
+		stream_complete(stream, iodev_sqe, rc);
+		return;
+	}
+
+	rtio_submit(r, 0);
+}
+
+void sensor_fifo_stream_event(struct sensor_fifo_stream *stream)
+{
+	struct rtio_iodev_sqe *iodev_sqe = stream->streaming_sqe;
+	int rc;
+
+	if (iodev_sqe == NULL) {
+		/* Not inherently an overrun, a buffer may be there next time */
+		LOG_DBG("No pending SQE");
+		stream->cfg->int_enable(stream->dev);
+		return;
+	}
+
+	stream->timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	/*
+	 * Chain of operations with inline calls to make decisions:
+	 * 1. read the interrupt status
+	 * 2. check it against the triggers of the pending submission
+	 * 3. read the FIFO fill level
+	 * 4. get a buffer for all available frames
+	 * 5. burst read the FIFO into it
+	 * 6. complete the submission
+	 */
+	rc = prep_reg_read(stream, stream->cfg->int_status_reg, &stream->int_status, 1,
+			   int_status_cb);
+	if (rc != 0) {
+		stream->streaming_sqe = NULL;
+		stream_complete(stream, iodev_sqe, rc);
+		return;
+	}
+
+	rtio_submit(stream->r, 0);
+}
@@ -263,6 +263,10 @@ int icm42688_init(const struct device *dev)
 		return -EIO;
 	}
 
+#ifdef CONFIG_ICM42688_STREAM
+	icm42688_stream_init(dev);
+#endif
+
 #ifdef CONFIG_ICM42688_TRIGGER
 	res = icm42688_trigger_init(dev);
 	if (res != 0) {
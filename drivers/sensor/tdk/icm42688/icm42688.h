@@ -9,6 +9,7 @@
 
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/drivers/sensor_fifo_stream.h>
 #include <zephyr/drivers/spi.h>
 #include <zephyr/sys/byteorder.h>
 #include <stdlib.h>
@@ -409,13 +410,9 @@ struct icm42688_dev_data {
 	struct k_work work;
 #endif
 #ifdef CONFIG_ICM42688_STREAM
-	struct rtio_iodev_sqe *streaming_sqe;
+	struct sensor_fifo_stream fifo_stream;
 	struct rtio *r;
 	struct rtio_iodev *spi_iodev;
-	uint8_t int_status;
-	uint16_t fifo_count;
-	uint64_t timestamp;
-	atomic_t reading_fifo;
 #endif /* CONFIG_ICM42688_STREAM */
 	const struct device *dev;
 	struct gpio_callback gpio_cb;
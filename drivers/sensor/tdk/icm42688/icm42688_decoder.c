@@ -8,6 +8,7 @@
 #include "icm42688_reg.h"
 #include "icm42688.h"
 #include <errno.h>
+#include <zephyr/drivers/sensor_fifo_stream.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ICM42688_DECODER, CONFIG_SENSOR_LOG_LEVEL);
@@ -345,13 +346,69 @@ static uint32_t gyro_period_ns[] = {
 	[ICM42688_GYRO_ODR_32000] = UINT32_C(1000000) / 32,
 };
 
+static inline const uint8_t *icm42688_fifo_frame_end(const uint8_t *frame)
+{
+	if (FIELD_GET(FIFO_HEADER_20, frame[0]) == 1) {
+		return frame + 20;
+	}
+	if (FIELD_GET(FIFO_HEADER_ACCEL, frame[0]) == 1 &&
+	    FIELD_GET(FIFO_HEADER_GYRO, frame[0]) == 1) {
+		return frame + 16;
+	}
+	return frame + 8;
+}
+
+/*
+ * Time between two frames carrying the decoded channel, and the number of such
+ * frames in the buffer. The measured frame period is preferred over the ODR
+ * table since the sensor clock may deviate from its nominal rate.
+ */
+static void icm42688_fifo_timing(const struct icm42688_fifo_data *edata, const uint8_t *buffer,
+				 const uint8_t *buffer_end, enum sensor_channel chan,
+				 uint32_t *period_ns, uint32_t *frame_count)
+{
+	uint32_t accel_count = 0;
+	uint32_t gyro_count = 0;
+	uint32_t total_count = 0;
+	uint32_t count;
+	uint32_t nominal;
+
+	for (; buffer < buffer_end; buffer = icm42688_fifo_frame_end(buffer)) {
+		accel_count += FIELD_GET(FIFO_HEADER_ACCEL, buffer[0]);
+		gyro_count += FIELD_GET(FIFO_HEADER_GYRO, buffer[0]);
+		total_count++;
+	}
+
+	if (IS_ACCEL(chan)) {
+		count = accel_count;
+		nominal = accel_period_ns[edata->accel_odr];
+	} else if (IS_GYRO(chan)) {
+		count = gyro_count;
+		nominal = gyro_period_ns[edata->gyro_odr];
+	} else {
+		count = total_count;
+		nominal = accel_count > 0 ? accel_period_ns[edata->accel_odr]
+					  : gyro_period_ns[edata->gyro_odr];
+	}
+
+	*frame_count = count;
+	if (edata->period_ns != 0 && count != 0) {
+		*period_ns = (uint32_t)(((uint64_t)edata->period_ns * total_count) / count);
+	} else {
+		*period_ns = nominal;
+	}
+}
+
 static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
 				uint32_t *fit, uint16_t max_count, void *data_out)
 {
 	const struct icm42688_fifo_data *edata = (const struct icm42688_fifo_data *)buffer;
 	const uint8_t *buffer_end = buffer + sizeof(struct icm42688_fifo_data) + edata->fifo_count;
+	uint32_t frame_count;
+	uint32_t period_ns;
 	int accel_frame_count = 0;
 	int gyro_frame_count = 0;
+	int total_frame_count = 0;
 	int count = 0;
 	int rc;
 
@@ -359,28 +416,29 @@ static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec c
 		return 0;
 	}
 
-	((struct sensor_data_header *)data_out)->base_timestamp_ns = edata->header.timestamp;
-
 	buffer += sizeof(struct icm42688_fifo_data);
+
+	/*
+	 * The header timestamp is taken at the FIFO interrupt, around which the
+	 * last frame was sampled. Interpolate the first frame back from there.
+	 */
+	icm42688_fifo_timing(edata, buffer, buffer_end, chan_spec.chan_type, &period_ns,
+			     &frame_count);
+	((struct sensor_data_header *)data_out)->base_timestamp_ns =
+		sensor_fifo_stream_base_timestamp(edata->header.timestamp, period_ns, frame_count);
+
 	while (count < max_count && buffer < buffer_end) {
-		const bool is_20b = FIELD_GET(FIFO_HEADER_20, buffer[0]) == 1;
 		const bool has_accel = FIELD_GET(FIFO_HEADER_ACCEL, buffer[0]) == 1;
 		const bool has_gyro = FIELD_GET(FIFO_HEADER_GYRO, buffer[0]) == 1;
-		const uint8_t *frame_end = buffer;
+		const uint8_t *frame_end = icm42688_fifo_frame_end(buffer);
 
-		if (is_20b) {
-			frame_end += 20;
-		} else if (has_accel && has_gyro) {
-			frame_end += 16;
-		} else {
-			frame_end += 8;
-		}
 		if (has_accel) {
 			accel_frame_count++;
 		}
 		if (has_gyro) {
 			gyro_frame_count++;
 		}
+		total_frame_count++;
 
 		if ((uintptr_t)buffer < *fit) {
 			/* This frame was already decoded, move on to the next frame */
@@ -391,25 +449,20 @@ static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec c
 			struct sensor_q31_data *data = (struct sensor_q31_data *)data_out;
 
 			data->shift = 9;
-			if (has_accel) {
-				data->readings[count].timestamp_delta =
-					accel_period_ns[edata->accel_odr] * (accel_frame_count - 1);
-			} else {
-				data->readings[count].timestamp_delta =
-					gyro_period_ns[edata->gyro_odr] * (gyro_frame_count - 1);
-			}
+			data->readings[count].timestamp_delta =
+				period_ns * (uint32_t)(total_frame_count - 1);
 			data->readings[count].temperature =
 				icm42688_read_temperature_from_packet(buffer);
 		} else if (IS_ACCEL(chan_spec.chan_type) && has_accel) {
 			/* Decode accel */
 			struct sensor_three_axis_data *data =
 				(struct sensor_three_axis_data *)data_out;
-			uint64_t period_ns = accel_period_ns[edata->accel_odr];
 
 			icm42688_get_shift(SENSOR_CHAN_ACCEL_XYZ, edata->header.accel_fs,
 					   edata->header.gyro_fs, &data->shift);
 
-			data->readings[count].timestamp_delta = (accel_frame_count - 1) * period_ns;
+			data->readings[count].timestamp_delta =
+				(uint32_t)(accel_frame_count - 1) * period_ns;
 			rc = icm42688_read_imu_from_packet(buffer, true, edata->header.accel_fs, 0,
 							   &data->readings[count].x);
 			rc |= icm42688_read_imu_from_packet(buffer, true, edata->header.accel_fs, 1,
@@ -417,7 +470,6 @@ static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec c
 			rc |= icm42688_read_imu_from_packet(buffer, true, edata->header.accel_fs, 2,
 							    &data->readings[count].z);
 			if (rc != 0) {
-				accel_frame_count--;
 				buffer = frame_end;
 				continue;
 			}
@@ -425,12 +477,12 @@ static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec c
 			/* Decode gyro */
 			struct sensor_three_axis_data *data =
 				(struct sensor_three_axis_data *)data_out;
-			uint64_t period_ns = accel_period_ns[edata->gyro_odr];
 
 			icm42688_get_shift(SENSOR_CHAN_GYRO_XYZ, edata->header.accel_fs,
 					   edata->header.gyro_fs, &data->shift);
 
-			data->readings[count].timestamp_delta = (gyro_frame_count - 1) * period_ns;
+			data->readings[count].timestamp_delta =
+				(uint32_t)(gyro_frame_count - 1) * period_ns;
 			rc = icm42688_read_imu_from_packet(buffer, false, edata->header.gyro_fs, 0,
 							   &data->readings[count].x);
 			rc |= icm42688_read_imu_from_packet(buffer, false, edata->header.gyro_fs, 1,
@@ -438,7 +490,6 @@ static int icm42688_fifo_decode(const uint8_t *buffer, struct sensor_chan_spec c
 			rc |= icm42688_read_imu_from_packet(buffer, false, edata->header.gyro_fs, 2,
 							    &data->readings[count].z);
 			if (rc != 0) {
-				gyro_frame_count--;
 				buffer = frame_end;
 				continue;
 			}
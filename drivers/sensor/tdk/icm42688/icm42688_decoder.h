@@ -25,6 +25,8 @@ struct icm42688_fifo_data {
 	uint16_t accel_odr: 4;
 	uint16_t fifo_count: 11;
 	uint16_t reserved: 5;
+	/* Measured frame period, 0 to use the nominal ODR */
+	uint32_t period_ns;
 } __attribute__((__packed__));
 
 struct icm42688_encoded_data {
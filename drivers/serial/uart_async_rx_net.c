@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_async_rx_net.h>
+
+static int drv_buf_find(struct uart_async_rx_net *rx_data, uint8_t *buffer)
+{
+	for (int i = 0; i < ARRAY_SIZE(rx_data->drv_buf); i++) {
+		if (rx_data->drv_buf[i] != NULL && rx_data->drv_buf[i]->data == buffer) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void uart_async_rx_net_chunk_destroy(struct net_buf *buf)
+{
+	struct net_buf *parent = *(struct net_buf **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	net_buf_unref(parent);
+}
+
+uint8_t *uart_async_rx_net_buf_req(struct uart_async_rx_net *rx_data, size_t *length)
+{
+	struct net_buf *buf;
+	int idx;
+
+	for (idx = 0; idx < ARRAY_SIZE(rx_data->drv_buf); idx++) {
+		if (rx_data->drv_buf[idx] == NULL) {
+			break;
+		}
+	}
+
+	if (idx == ARRAY_SIZE(rx_data->drv_buf)) {
+		return NULL;
+	}
+
+	buf = net_buf_alloc(rx_data->config->buf_pool, K_NO_WAIT);
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	rx_data->drv_buf[idx] = buf;
+	*length = net_buf_tailroom(buf);
+
+	return buf->data;
+}
+
+void uart_async_rx_net_on_rdy(struct uart_async_rx_net *rx_data, uint8_t *buffer,
+			      size_t offset, size_t length)
+{
+	struct net_buf *chunk;
+	int idx = drv_buf_find(rx_data, buffer);
+
+	__ASSERT_NO_MSG(idx >= 0);
+
+	/* The driver only writes past this point, the chunk can be read while
+	 * reception into the same buffer continues.
+	 */
+	chunk = net_buf_alloc_with_data(rx_data->config->chunk_pool, buffer + offset, length,
+					K_NO_WAIT);
+	if (chunk == NULL) {
+		atomic_add(&rx_data->dropped, length);
+		return;
+	}
+
+	__ASSERT_NO_MSG(chunk->user_data_size >= sizeof(struct net_buf *));
+	*(struct net_buf **)net_buf_user_data(chunk) = net_buf_ref(rx_data->drv_buf[idx]);
+
+	rx_data->config->cb(rx_data, chunk, rx_data->config->user_data);
+}
+
+void uart_async_rx_net_on_buf_rel(struct uart_async_rx_net *rx_data, uint8_t *buffer)
+{
+	int idx = drv_buf_find(rx_data, buffer);
+
+	if (idx < 0) {
+		return;
+	}
+
+	net_buf_unref(rx_data->drv_buf[idx]);
+	rx_data->drv_buf[idx] = NULL;
+}
+
+void uart_async_rx_net_on_event(struct uart_async_rx_net *rx_data, const struct device *dev,
+				const struct uart_event *evt)
+{
+	uint8_t *buf;
+	size_t len;
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		uart_async_rx_net_on_rdy(rx_data, evt->data.rx.buf, evt->data.rx.offset,
+					 evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		buf = uart_async_rx_net_buf_req(rx_data, &len);
+		if (buf != NULL && uart_rx_buf_rsp(dev, buf, len) != 0) {
+			uart_async_rx_net_on_buf_rel(rx_data, buf);
+		}
+		break;
+	case UART_RX_BUF_RELEASED:
+		uart_async_rx_net_on_buf_rel(rx_data, evt->data.rx_buf.buf);
+		break;
+	default:
+		break;
+	}
+}
+
+int uart_async_rx_net_enable(struct uart_async_rx_net *rx_data, const struct device *dev,
+			     int32_t timeout)
+{
+	uint8_t *buf;
+	size_t len;
+	int err;
+
+	buf = uart_async_rx_net_buf_req(rx_data, &len);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	err = uart_rx_enable(dev, buf, len, timeout);
+	if (err != 0) {
+		uart_async_rx_net_on_buf_rel(rx_data, buf);
+	}
+
+	return err;
+}
+
+void uart_async_rx_net_reset(struct uart_async_rx_net *rx_data)
+{
+	for (int i = 0; i < ARRAY_SIZE(rx_data->drv_buf); i++) {
+		if (rx_data->drv_buf[i] != NULL) {
+			net_buf_unref(rx_data->drv_buf[i]);
+			rx_data->drv_buf[i] = NULL;
+		}
+	}
+
+	atomic_clear(&rx_data->dropped);
+}
+
+int uart_async_rx_net_init(struct uart_async_rx_net *rx_data,
+			   const struct uart_async_rx_net_config *config)
+{
+	memset(rx_data, 0, sizeof(*rx_data));
+	rx_data->config = config;
+
+	return 0;
+}
@@ -17,6 +17,9 @@
 #include <nrfx_spim.h>
 #include <string.h>
 #include <zephyr/linker/devicetree_regions.h>
+#ifdef CONFIG_SPI_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #include <zephyr/logging/log.h>
 #include <zephyr/irq.h>
@@ -50,6 +53,14 @@ struct spi_nrfx_data {
 	uint8_t ppi_ch;
 	uint8_t gpiote_ch;
 #endif
+#ifdef CONFIG_SPI_RTIO
+	struct k_spinlock lock;
+	struct rtio_mpsc iodev_sq;
+	struct rtio_iodev_sqe *txn_head;
+	struct rtio_iodev_sqe *txn_curr;
+	/* Bytes of the current submission already transferred */
+	size_t txn_pos;
+#endif
 };
 
 struct spi_nrfx_config {
@@ -300,48 +311,87 @@ static void finish_transaction(const struct device *dev, int error)
 	dev_data->busy = false;
 }
 
-static void transfer_next_chunk(const struct device *dev)
+static size_t dma_buffers_setup(const struct device *dev,
+				const uint8_t **tx_buf, uint8_t **rx_buf,
+				size_t chunk_len)
 {
-	struct spi_nrfx_data *dev_data = dev->data;
 	const struct spi_nrfx_config *dev_config = dev->config;
-	struct spi_context *ctx = &dev_data->ctx;
-	int error = 0;
 
-	size_t chunk_len = spi_context_max_continuous_chunk(ctx);
+	if (chunk_len > dev_config->max_chunk_len) {
+		chunk_len = dev_config->max_chunk_len;
+	}
 
-	if (chunk_len > 0) {
-		nrfx_spim_xfer_desc_t xfer;
-		nrfx_err_t result;
-		const uint8_t *tx_buf = ctx->tx_buf;
-		uint8_t *rx_buf = ctx->rx_buf;
+#ifdef SPI_BUFFER_IN_RAM
+	struct spi_nrfx_data *dev_data = dev->data;
 
-		if (chunk_len > dev_config->max_chunk_len) {
-			chunk_len = dev_config->max_chunk_len;
+	if (*tx_buf != NULL &&
+	    !nrf_dma_accessible_check(&dev_config->spim.p_reg, *tx_buf)) {
+
+		if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
+			chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
 		}
 
-#ifdef SPI_BUFFER_IN_RAM
-		if (spi_context_tx_buf_on(ctx) &&
-		    !nrf_dma_accessible_check(&dev_config->spim.p_reg, tx_buf)) {
+		memcpy(dev_data->tx_buffer, *tx_buf, chunk_len);
+		*tx_buf = dev_data->tx_buffer;
+	}
 
-			if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
-				chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
-			}
+	if (*rx_buf != NULL &&
+	    !nrf_dma_accessible_check(&dev_config->spim.p_reg, *rx_buf)) {
 
-			memcpy(dev_data->tx_buffer, tx_buf, chunk_len);
-			tx_buf = dev_data->tx_buffer;
+		if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
+			chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
 		}
 
-		if (spi_context_rx_buf_on(ctx) &&
-		    !nrf_dma_accessible_check(&dev_config->spim.p_reg, rx_buf)) {
+		*rx_buf = dev_data->rx_buffer;
+	}
+#endif
+
+	return chunk_len;
+}
 
-			if (chunk_len > CONFIG_SPI_NRFX_RAM_BUFFER_SIZE) {
-				chunk_len = CONFIG_SPI_NRFX_RAM_BUFFER_SIZE;
-			}
+static int start_xfer(const struct device *dev, const nrfx_spim_xfer_desc_t *xfer)
+{
+	const struct spi_nrfx_config *dev_config = dev->config;
+	nrfx_err_t result;
 
-			rx_buf = dev_data->rx_buffer;
+#ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
+	if (xfer->rx_length == 1 && xfer->tx_length <= 1) {
+		if (dev_config->anomaly_58_workaround) {
+			anomaly_58_workaround_setup(dev);
+		} else {
+			LOG_WRN("Transaction aborted since it would trigger "
+				"nRF52832 PAN 58");
+			return -EIO;
 		}
+	}
 #endif
 
+	result = nrfx_spim_xfer(&dev_config->spim, xfer, 0);
+	if (result != NRFX_SUCCESS) {
+#ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
+		anomaly_58_workaround_clear(dev->data);
+#endif
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void transfer_next_chunk(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct spi_context *ctx = &dev_data->ctx;
+	int error = 0;
+
+	size_t chunk_len = spi_context_max_continuous_chunk(ctx);
+
+	if (chunk_len > 0) {
+		nrfx_spim_xfer_desc_t xfer;
+		const uint8_t *tx_buf = spi_context_tx_buf_on(ctx) ? ctx->tx_buf : NULL;
+		uint8_t *rx_buf = spi_context_rx_buf_on(ctx) ? ctx->rx_buf : NULL;
+
+		chunk_len = dma_buffers_setup(dev, &tx_buf, &rx_buf, chunk_len);
+
 		dev_data->chunk_len = chunk_len;
 
 		xfer.p_tx_buffer = tx_buf;
@@ -349,32 +399,204 @@ static void transfer_next_chunk(const struct device *dev)
 		xfer.p_rx_buffer = rx_buf;
 		xfer.rx_length   = spi_context_rx_buf_on(ctx) ? chunk_len : 0;
 
-#ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
-		if (xfer.rx_length == 1 && xfer.tx_length <= 1) {
-			if (dev_config->anomaly_58_workaround) {
-				anomaly_58_workaround_setup(dev);
-			} else {
-				LOG_WRN("Transaction aborted since it would trigger "
-					"nRF52832 PAN 58");
-				error = -EIO;
-			}
-		}
-#endif
+		error = start_xfer(dev, &xfer);
 		if (error == 0) {
-			result = nrfx_spim_xfer(&dev_config->spim, &xfer, 0);
-			if (result == NRFX_SUCCESS) {
-				return;
-			}
-			error = -EIO;
-#ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
-			anomaly_58_workaround_clear(dev_data);
-#endif
+			return;
 		}
 	}
 
 	finish_transaction(dev, error);
 }
 
+#ifdef CONFIG_SPI_RTIO
+static void spi_nrfx_iodev_next(const struct device *dev, bool completion);
+static void spi_nrfx_iodev_complete(const struct device *dev, int status);
+
+static int spi_nrfx_iodev_bufs(const struct rtio_sqe *sqe, const uint8_t **tx_buf,
+			       uint8_t **rx_buf, size_t *len)
+{
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		*tx_buf = NULL;
+		*rx_buf = sqe->buf;
+		*len = sqe->buf_len;
+		break;
+	case RTIO_OP_TX:
+		*tx_buf = sqe->buf;
+		*rx_buf = NULL;
+		*len = sqe->buf_len;
+		break;
+	case RTIO_OP_TINY_TX:
+		*tx_buf = sqe->tiny_buf;
+		*rx_buf = NULL;
+		*len = sqe->tiny_buf_len;
+		break;
+	case RTIO_OP_TXRX:
+		*tx_buf = sqe->tx_buf;
+		*rx_buf = sqe->rx_buf;
+		*len = sqe->txrx_buf_len;
+		break;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Start the next EasyDMA chunk of the current submission. Called from the
+ * SPIM interrupt once the previous chunk is done, so that the steps of a
+ * transaction follow each other without going through a thread.
+ */
+static void spi_nrfx_iodev_start(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	const uint8_t *tx_buf;
+	uint8_t *rx_buf;
+	size_t len;
+	nrfx_spim_xfer_desc_t xfer;
+	size_t chunk_len;
+	int error;
+
+	error = spi_nrfx_iodev_bufs(&dev_data->txn_curr->sqe, &tx_buf, &rx_buf, &len);
+	if (error < 0) {
+		spi_nrfx_iodev_complete(dev, error);
+		return;
+	}
+
+	if (dev_data->txn_pos >= len) {
+		spi_nrfx_iodev_complete(dev, 0);
+		return;
+	}
+
+	if (tx_buf != NULL) {
+		tx_buf += dev_data->txn_pos;
+	}
+	if (rx_buf != NULL) {
+		rx_buf += dev_data->txn_pos;
+	}
+
+	chunk_len = dma_buffers_setup(dev, &tx_buf, &rx_buf, len - dev_data->txn_pos);
+
+	dev_data->chunk_len = chunk_len;
+
+	xfer.p_tx_buffer = tx_buf;
+	xfer.tx_length   = tx_buf != NULL ? chunk_len : 0;
+	xfer.p_rx_buffer = rx_buf;
+	xfer.rx_length   = rx_buf != NULL ? chunk_len : 0;
+
+	error = start_xfer(dev, &xfer);
+	if (error < 0) {
+		spi_nrfx_iodev_complete(dev, error);
+	}
+}
+
+static void spi_nrfx_iodev_chunk_done(const struct device *dev,
+				      const nrfx_spim_xfer_desc_t *xfer)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+
+#ifdef SPI_BUFFER_IN_RAM
+	if (xfer->p_rx_buffer != NULL && xfer->p_rx_buffer == dev_data->rx_buffer) {
+		const uint8_t *tx_buf;
+		uint8_t *rx_buf;
+		size_t len;
+
+		(void)spi_nrfx_iodev_bufs(&dev_data->txn_curr->sqe, &tx_buf, &rx_buf, &len);
+		(void)memcpy(rx_buf + dev_data->txn_pos, dev_data->rx_buffer,
+			     dev_data->chunk_len);
+	}
+#else
+	ARG_UNUSED(xfer);
+#endif
+
+	dev_data->txn_pos += dev_data->chunk_len;
+
+	spi_nrfx_iodev_start(dev);
+}
+
+static void spi_nrfx_iodev_next(const struct device *dev, bool completion)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	const struct spi_nrfx_config *dev_config = dev->config;
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	if (!completion && dev_data->txn_curr != NULL) {
+		k_spin_unlock(&dev_data->lock, key);
+		return;
+	}
+
+	struct rtio_mpsc_node *next = rtio_mpsc_pop(&dev_data->iodev_sq);
+
+	if (next != NULL) {
+		struct rtio_iodev_sqe *next_sqe = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+
+		dev_data->txn_head = next_sqe;
+		dev_data->txn_curr = next_sqe;
+		dev_data->busy = true;
+	} else {
+		dev_data->txn_head = NULL;
+		dev_data->txn_curr = NULL;
+		dev_data->busy = false;
+	}
+	dev_data->txn_pos = 0;
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	if (dev_data->txn_curr != NULL) {
+		struct spi_dt_spec *spi_dt_spec = dev_data->txn_curr->sqe.iodev->data;
+		struct rtio_iodev_sqe *txn_head = dev_data->txn_head;
+		int error;
+
+		error = configure(dev, &spi_dt_spec->config);
+		if (error < 0) {
+			spi_nrfx_iodev_next(dev, true);
+			rtio_iodev_sqe_err(txn_head, error);
+			return;
+		}
+
+		if (dev_config->wake_pin != WAKE_PIN_NOT_USED &&
+		    spi_nrfx_wake_request(&dev_config->wake_gpiote,
+					  dev_config->wake_pin) == -ETIMEDOUT) {
+			LOG_WRN("Waiting for WAKE acknowledgment timed out");
+		}
+
+		spi_context_cs_control(&dev_data->ctx, true);
+		spi_nrfx_iodev_start(dev);
+	}
+}
+
+static void spi_nrfx_iodev_complete(const struct device *dev, int status)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+
+	if (status == 0 && (dev_data->txn_curr->sqe.flags & RTIO_SQE_TRANSACTION)) {
+		dev_data->txn_curr = rtio_txn_next(dev_data->txn_curr);
+		dev_data->txn_pos = 0;
+		spi_nrfx_iodev_start(dev);
+	} else {
+		struct rtio_iodev_sqe *txn_head = dev_data->txn_head;
+
+		spi_context_cs_control(&dev_data->ctx, false);
+		spi_nrfx_iodev_next(dev, true);
+		if (status < 0) {
+			rtio_iodev_sqe_err(txn_head, status);
+		} else {
+			rtio_iodev_sqe_ok(txn_head, status);
+		}
+	}
+}
+
+static void spi_nrfx_iodev_submit(const struct device *dev,
+				  struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+
+	rtio_mpsc_push(&dev_data->iodev_sq, &iodev_sqe->q);
+	spi_nrfx_iodev_next(dev, false);
+}
+#endif /* CONFIG_SPI_RTIO */
+
 static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
 {
 	struct spi_nrfx_data *dev_data = p_context;
@@ -391,6 +613,12 @@ static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
 		anomaly_58_workaround_clear(dev_data);
 #endif
+#ifdef CONFIG_SPI_RTIO
+		if (dev_data->txn_head != NULL) {
+			spi_nrfx_iodev_chunk_done(dev_data->dev, &p_event->xfer_desc);
+			return;
+		}
+#endif
 #ifdef SPI_BUFFER_IN_RAM
 		if (spi_context_rx_buf_on(&dev_data->ctx) &&
 		    p_event->xfer_desc.p_rx_buffer != NULL &&
@@ -519,6 +747,9 @@ static const struct spi_driver_api spi_nrfx_driver_api = {
 	.transceive = spi_nrfx_transceive,
 #ifdef CONFIG_SPI_ASYNC
 	.transceive_async = spi_nrfx_transceive_async,
+#endif
+#ifdef CONFIG_SPI_RTIO
+	.iodev_submit = spi_nrfx_iodev_submit,
 #endif
 	.release = spi_nrfx_release,
 };
@@ -597,6 +828,10 @@ static int spi_nrfx_init(const struct device *dev)
 
 	spi_context_unlock_unconditionally(&dev_data->ctx);
 
+#ifdef CONFIG_SPI_RTIO
+	rtio_mpsc_init(&dev_data->iodev_sq);
+#endif
+
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
 	return anomaly_58_workaround_init(dev);
 #else
@@ -495,6 +495,16 @@ static inline uint32_t arch_proc_id(void);
  */
 void arch_sched_ipi(void);
 
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs given in @p cpu_bitmap,
+ * except the current one. Requires CONFIG_ARCH_HAS_DIRECTED_IPIS.
+ *
+ * @param cpu_bitmap Bitmap of the CPUs to interrupt, bit 0 being CPU 0
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+
 
 int arch_smp_init(void);
 
@@ -929,6 +939,33 @@ static inline void arch_cohere_stacks(struct k_thread *old_thread,
 
 /** @} */
 
+/**
+ * @defgroup arch-profiling Architecture-specific profiling APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_ARCH_HAS_INTERRUPTED_STACK_TRACE
+/**
+ * @brief Get the call stack of the code interrupted by the current interrupt
+ *
+ * Stores the program counter of the interrupted code into @p buf, then the
+ * return addresses of its callers, as far as they can be found by walking
+ * frame pointers with CONFIG_FRAME_POINTER.
+ *
+ * This may only be called from an interrupt handler. Nothing is stored if
+ * the interrupt is nested, i.e. did not interrupt a thread.
+ *
+ * @param buf Buffer receiving the addresses, innermost first
+ * @param size Number of addresses @p buf can hold
+ *
+ * @return Number of addresses stored into @p buf
+ */
+size_t arch_interrupted_stack_trace(uintptr_t *buf, size_t size);
+#endif /* CONFIG_ARCH_HAS_INTERRUPTED_STACK_TRACE */
+
+/** @} */
+
 /**
  * @defgroup arch-gdbstub Architecture-specific gdbstub APIs
  * @ingroup arch-interface
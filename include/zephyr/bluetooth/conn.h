@@ -407,6 +407,16 @@ struct bt_conn_info {
 	enum bt_conn_state state;
 	/** Security specific info. */
 	struct bt_security_info security;
+	/** Number of buffers queued for transmission.
+	 *
+	 *  @note Only valid if @kconfig{CONFIG_BT_CONN_TX_SCHED} is enabled.
+	 */
+	uint16_t tx_queued;
+	/** Number of controller buffers sent and not yet completed.
+	 *
+	 *  @note Only valid if @kconfig{CONFIG_BT_CONN_TX_SCHED} is enabled.
+	 */
+	uint16_t tx_in_flight;
 };
 
 /** LE Connection Remote Info Structure */
@@ -537,6 +547,23 @@ enum bt_conn_auth_keypress {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** @brief Set the transmit weight of a connection.
+ *
+ *  Connections sending data share the controller buffers in proportion to
+ *  their weights, so that a busy connection cannot hold all of them while
+ *  others have data to send. New connections get
+ *  @kconfig{CONFIG_BT_CONN_TX_SCHED_WEIGHT}.
+ *
+ *  @note Requires @kconfig{CONFIG_BT_CONN_TX_SCHED}.
+ *
+ *  @param conn Connection object.
+ *  @param weight Weight of the connection, at least 1.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ *  @return -EINVAL if @p weight is 0 or @p conn is not an ACL connection.
+ */
+int bt_conn_set_tx_weight(struct bt_conn *conn, uint8_t weight);
+
 /** @brief Get connection info for the remote device.
  *
  *  @param conn Connection object.
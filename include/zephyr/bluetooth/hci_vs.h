@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2017-2018 Nordic Semiconductor ASA
  * Copyright (c) 2015-2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -213,6 +214,40 @@ struct bt_hci_cp_vs_set_min_num_used_chans {
 	uint8_t  min_used_chans;
 } __packed;
 
+#define BT_HCI_VS_SCAN_REPORT_FILTER_ADDR      0x01
+#define BT_HCI_VS_SCAN_REPORT_FILTER_AD_TYPE   0x02
+#define BT_HCI_VS_SCAN_REPORT_FILTER_RSSI      0x04
+
+#define BT_HCI_OP_VS_SET_SCAN_REPORT_FILTER    BT_OP(BT_OGF_VS, 0x0013)
+
+struct bt_hci_cp_vs_set_scan_report_filter {
+	uint8_t      filter;
+	bt_addr_le_t addr;
+	uint8_t      ad_type;
+	int8_t       rssi_min;
+} __packed;
+
+#define BT_HCI_VS_LATENCY_PROFILE_MAYFLY       0x00
+#define BT_HCI_VS_LATENCY_PROFILE_PREPARE      0x01
+
+#define BT_HCI_VS_LATENCY_BUCKETS              8
+
+#define BT_HCI_OP_VS_READ_LATENCY_PROFILE      BT_OP(BT_OGF_VS, 0x0014)
+
+struct bt_hci_cp_vs_read_latency_profile {
+	uint8_t  type;
+	uint8_t  caller_id;
+	uint8_t  callee_id;
+	uint8_t  reset;
+} __packed;
+
+struct bt_hci_rp_vs_read_latency_profile {
+	uint8_t  status;
+	uint32_t hist[BT_HCI_VS_LATENCY_BUCKETS];
+	uint32_t late;
+	uint32_t collisions;
+} __packed;
+
 /* Events */
 
 struct bt_hci_evt_vs {
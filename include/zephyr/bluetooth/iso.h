@@ -5,6 +5,7 @@
 /*
  * Copyright (c) 2020 Intel Corporation
  * Copyright (c) 2021 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -172,6 +173,14 @@ struct bt_iso_chan {
 	 */
 	bt_security_t			required_sec_level;
 #endif /* CONFIG_BT_SMP && CONFIG_BT_ISO_UNICAST */
+#if defined(CONFIG_BT_ISO_TX_SCHED) || defined(__DOXYGEN__)
+	/** @brief TX scheduler of the channel, if started
+	 *
+	 * Set by bt_iso_tx_sched_start(), only available when
+	 * @kconfig{CONFIG_BT_ISO_TX_SCHED} is enabled.
+	 */
+	struct bt_iso_tx_sched		*tx_sched;
+#endif /* CONFIG_BT_ISO_TX_SCHED */
 	/** Node used internally by the stack */
 	sys_snode_t node;
 };
@@ -1034,6 +1043,109 @@ int bt_iso_chan_get_info(const struct bt_iso_chan *chan,
  */
 int bt_iso_chan_get_tx_sync(const struct bt_iso_chan *chan, struct bt_iso_tx_info *info);
 
+/** @brief ISO TX scheduler statistics */
+struct bt_iso_tx_sched_stats {
+	/** Number of SDUs passed to the controller */
+	uint32_t sent;
+	/** Number of times the controller was left without any SDU */
+	uint32_t underruns;
+	/** Number of SDUs dropped because the jitter buffer was full */
+	uint32_t overruns;
+};
+
+/** @brief ISO TX scheduler
+ *
+ *  Paces the SDUs of a channel, so that only a few are pending in the
+ *  controller at any time, and stamps them once aligned to the sync
+ *  reference of the controller. All members are internal.
+ */
+struct bt_iso_tx_sched {
+	/** @cond INTERNAL_HIDDEN */
+	struct bt_iso_chan *chan;
+	struct k_mutex lock;
+	/* Jitter buffer of SDUs not yet passed to the controller */
+	sys_slist_t queue;
+	uint8_t queued;
+	uint8_t in_flight;
+	uint8_t depth;
+	bool synced;
+	uint16_t seq_num;
+	uint16_t sync_seq_num;
+	uint32_t sync_ts;
+	uint32_t sdu_interval;
+	struct bt_iso_tx_sched_stats stats;
+	/** @endcond */
+};
+
+/** @brief Start scheduling the SDUs of an ISO channel
+ *
+ *  SDUs are then sent with bt_iso_tx_sched_send() instead of
+ *  bt_iso_chan_send(), and the scheduler assigns their sequence numbers.
+ *  At most @p depth SDUs are pending in the controller, further ones wait
+ *  in a jitter buffer of @kconfig{CONFIG_BT_ISO_TX_SCHED_QUEUE_SIZE} SDUs.
+ *
+ *  Only available when @kconfig{CONFIG_BT_ISO_TX_SCHED} is enabled.
+ *
+ *  @param sched        Scheduler object, kept by the application until
+ *                      stopped and all its SDUs are sent.
+ *  @param chan         Connected channel to schedule the SDUs of.
+ *  @param sdu_interval SDU interval in microseconds.
+ *  @param depth        Maximum number of SDUs pending in the controller.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ *  @retval -EALREADY The channel already has a scheduler.
+ */
+int bt_iso_tx_sched_start(struct bt_iso_tx_sched *sched, struct bt_iso_chan *chan,
+			  uint32_t sdu_interval, uint8_t depth);
+
+/** @brief Stop scheduling SDUs
+ *
+ *  SDUs still in the jitter buffer are dropped.
+ *
+ *  @param sched Scheduler object.
+ */
+void bt_iso_tx_sched_stop(struct bt_iso_tx_sched *sched);
+
+/** @brief Align the scheduled SDUs to the sync reference of the controller
+ *
+ *  Reads the timing of the last SDU sent with bt_iso_chan_get_tx_sync().
+ *  SDUs sent from then on are timestamped from it at the SDU interval.
+ *  Alignment is lost on underruns, as the SDU intervals skipped are not
+ *  known, until this is called again.
+ *
+ *  @note This sends a HCI command and must not be called from the channel
+ *        sent callback.
+ *
+ *  @param sched Scheduler object.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_iso_tx_sched_sync(struct bt_iso_tx_sched *sched);
+
+/** @brief Send an SDU through the scheduler
+ *
+ *  The SDU is passed to the controller right away if less than the
+ *  scheduler depth are pending there, or put into the jitter buffer. When
+ *  the jitter buffer is full, its oldest SDU is dropped to keep the latency
+ *  bounded.
+ *
+ *  @param sched Scheduler object.
+ *  @param buf   Buffer containing the SDU, with room reserved as for
+ *               bt_iso_chan_send_ts().
+ *
+ *  @return Zero on success or (negative) error code on failure, in which
+ *          case the buffer is still owned by the caller.
+ */
+int bt_iso_tx_sched_send(struct bt_iso_tx_sched *sched, struct net_buf *buf);
+
+/** @brief Get the statistics of a scheduler
+ *
+ *  @param sched Scheduler object.
+ *  @param stats Statistics, copied from the scheduler.
+ */
+void bt_iso_tx_sched_stats_get(struct bt_iso_tx_sched *sched,
+			       struct bt_iso_tx_sched_stats *stats);
+
 /** @brief Creates a BIG as a broadcaster
  *
  *  @param[in] padv      Pointer to the periodic advertising object the BIGInfo shall be sent on.
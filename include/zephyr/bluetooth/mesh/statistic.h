@@ -47,6 +47,12 @@ struct bt_mesh_statistic {
 	uint32_t tx_friend_planned;
 	/** Counter of frames that succeeded to send over friend bearer. */
 	uint32_t tx_friend_succeeded;
+	/** Received frames dropped as already in the network message cache. */
+	uint32_t rx_msg_cache_hit;
+	/** Received frames rejected by the replay protection list as replayed. */
+	uint32_t rx_rpl_replay;
+	/** Received frames rejected because the replay protection list is full. */
+	uint32_t rx_rpl_full;
 };
 
 /** @brief Get mesh frame handling statistic.
@@ -23,6 +23,7 @@
 
 #include <zephyr/drivers/can.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/net/buf.h>
 
 /*
@@ -436,8 +437,7 @@ struct isotp_send_ctx {
 	};
 	struct isotp_fc_opts opts;
 	uint8_t state;
-	uint8_t tx_backlog;
-	struct k_sem tx_sem;
+	atomic_t tx_backlog;
 	struct isotp_msg_id rx_addr;
 	struct isotp_msg_id tx_addr;
 	uint8_t wft;
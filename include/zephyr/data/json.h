@@ -673,6 +673,89 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief Callback for the objects of an array parsed with
+ * json_arr_stream_feed()
+ *
+ * @param val Struct holding the decoded values. Strings point into the
+ * buffer of the parser and are only valid until the callback returns.
+ * @param decoded_fields Bitmap of decoded fields, as returned by
+ * json_obj_parse()
+ * @param user_data User data given to json_arr_stream_init()
+ *
+ * @return 0 to continue parsing, a negative value to stop it. The value
+ * is returned by json_arr_stream_feed().
+ */
+typedef int (*json_arr_stream_cb_t)(void *val, int64_t decoded_fields,
+				    void *user_data);
+
+/**
+ * @brief State of an array of objects parsed in chunks
+ *
+ * Initialize with json_arr_stream_init(), the fields are private.
+ */
+struct json_arr_stream {
+	char *buf;
+	size_t buf_size;
+	size_t len;
+	const struct json_obj_descr *descr;
+	size_t descr_len;
+	void *val;
+	json_arr_stream_cb_t cb;
+	void *user_data;
+	uint16_t depth;
+	uint8_t state;
+	bool in_string : 1;
+	bool escaped : 1;
+};
+
+/**
+ * @brief Initialize the parsing of an array of objects in chunks
+ *
+ * Parses a JSON array of objects, as for json_arr_separate_parse_object(),
+ * from chunks fed with json_arr_stream_feed(), e.g. as they are read from
+ * a socket. Only one object at a time is kept, in @a buf, so the memory
+ * needed does not grow with the length of the array.
+ *
+ * @param stream Parser state
+ * @param buf Buffer for the object being received, must hold the largest
+ * object of the array
+ * @param buf_size Size of @a buf
+ * @param descr Pointer to the descriptor array of the objects
+ * @param descr_len Number of elements in the descriptor array, see
+ * json_obj_parse()
+ * @param val Pointer to the struct to hold the decoded values of an object
+ * @param cb Called for each object once it has been decoded
+ * @param user_data Passed to @a cb
+ */
+void json_arr_stream_init(struct json_arr_stream *stream, char *buf, size_t buf_size,
+			  const struct json_obj_descr *descr, size_t descr_len,
+			  void *val, json_arr_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Feed the next chunk of an array of objects
+ *
+ * @param stream Parser state
+ * @param data Next bytes of the JSON-encoded array
+ * @param len Number of bytes in @a data
+ *
+ * @return 0 if the chunk has been parsed, -ENOMEM if an object does not fit
+ * into the buffer of the parser, -EINVAL if the data is not an array of
+ * objects or an object could not be decoded, or the value returned by the
+ * callback if it stopped parsing. The parser must be initialized again
+ * after an error.
+ */
+int json_arr_stream_feed(struct json_arr_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Check that an array parsed in chunks is complete
+ *
+ * @param stream Parser state
+ *
+ * @return 0 if the end of the array has been parsed, -EINVAL otherwise
+ */
+int json_arr_stream_finish(struct json_arr_stream *stream);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -756,6 +839,12 @@ int json_arr_encode_buf(const struct json_obj_descr *descr, const void *val,
 /**
  * @brief Encodes an object using an arbitrary writer function
  *
+ * The output is handed to @a append_bytes in small pieces as it is
+ * produced, so it can be written to a socket or another bounded sink
+ * without holding the whole document in memory. The writer may block
+ * until there is room for the bytes, and a negative value it returns
+ * stops the encoding.
+ *
  * @param descr Pointer to the descriptor array
  * @param descr_len Number of elements in the descriptor array
  * @param val Struct holding the values
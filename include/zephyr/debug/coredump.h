@@ -149,6 +149,9 @@ struct coredump_cmd_copy_arg {
 #define	COREDUMP_MEM_HDR_ID		'M'
 #define COREDUMP_MEM_HDR_VER		1
 
+/* Memory block whose byte stream is run-length encoded */
+#define COREDUMP_MEM_HDR_VER_RLE	2
+
 /* Target code */
 enum coredump_tgt_code {
 	COREDUMP_TGT_UNKNOWN = 0,
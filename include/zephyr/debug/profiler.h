@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @defgroup profiler Sampling profiler
+ * @ingroup os_services
+ *
+ * @brief Statistical profiler sampling the interrupted code from a timer
+ *
+ * Every period, the code interrupted by the system timer is sampled. Samples
+ * are counted per function, or per program counter without CONFIG_SYMTAB,
+ * into a histogram. With CONFIG_PROFILER_STACK_SAMPLES, the call stacks of
+ * the latest samples are kept as well.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Histogram callback
+ *
+ * @param addr Start address of the function, or program counter without
+ *             CONFIG_SYMTAB
+ * @param count Number of samples taken in it
+ * @param user_data User data given to profiler_hist_foreach()
+ */
+typedef void (*profiler_hist_cb_t)(uintptr_t addr, uint32_t count, void *user_data);
+
+/**
+ * @brief Stack sample callback
+ *
+ * @param frames Sampled program counter, followed by the return addresses
+ *               of its callers
+ * @param depth Number of entries in @p frames
+ * @param user_data User data given to profiler_stacks_foreach()
+ */
+typedef void (*profiler_stack_cb_t)(const uintptr_t *frames, size_t depth, void *user_data);
+
+/**
+ * @brief Start sampling
+ *
+ * Samples are added to the ones taken so far, see profiler_reset().
+ *
+ * @param period Sampling period, rounded to system ticks
+ *
+ * @retval 0 Sampling started
+ * @retval -EALREADY The profiler is already sampling
+ */
+int profiler_start(k_timeout_t period);
+
+/**
+ * @brief Stop sampling
+ */
+void profiler_stop(void);
+
+/**
+ * @brief Drop all samples taken
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Get the number of samples taken
+ *
+ * @param dropped Set to the number of samples not counted because the
+ *                histogram was full, if not NULL
+ *
+ * @return Number of samples counted into the histogram
+ */
+uint32_t profiler_samples_get(uint32_t *dropped);
+
+/**
+ * @brief Walk the histogram
+ *
+ * Entries are visited in no particular order. The callback is called with
+ * the profiler unlocked, so sampling can go on meanwhile.
+ *
+ * @param cb Callback called for each entry
+ * @param user_data User data passed to @p cb
+ */
+void profiler_hist_foreach(profiler_hist_cb_t cb, void *user_data);
+
+/**
+ * @brief Walk the stack samples, oldest first
+ *
+ * @param cb Callback called for each stack sample
+ * @param user_data User data passed to @p cb
+ */
+void profiler_stacks_foreach(profiler_stack_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
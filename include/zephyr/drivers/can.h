@@ -1409,6 +1409,151 @@ int can_add_rx_filter(const struct device *dev, can_rx_callback_t callback,
 __syscall int can_add_rx_filter_msgq(const struct device *dev, struct k_msgq *msgq,
 				     const struct can_filter *filter);
 
+#if defined(CONFIG_CAN_RX_RING) || defined(__DOXYGEN__)
+/**
+ * @typedef can_rx_batch_callback_t
+ * @brief Defines the batched receive callback handler function signature
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param frames    Received frames, contiguous in the ring buffer.
+ * @param count     Number of frames.
+ * @param user_data User data provided when the ring was initialized.
+ */
+typedef void (*can_rx_batch_callback_t)(const struct device *dev, struct can_frame *frames,
+					size_t count, void *user_data);
+
+/**
+ * @brief CAN RX ring
+ *
+ * Ring of received frames, filled from the driver RX interrupt and drained
+ * in batches by a callback run from the system work queue.
+ */
+struct can_rx_ring {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	struct k_spinlock lock;
+	const struct device *dev;
+	struct can_frame *frames;
+	uint32_t size;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t dropped;
+	can_rx_batch_callback_t callback;
+	void *user_data;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a CAN RX ring
+ *
+ * @param ring      Pointer to the ring.
+ * @param frames    Buffer for the queued frames.
+ * @param size      Number of frames the buffer holds.
+ * @param callback  Called with each batch of received frames.
+ * @param user_data User data to pass to the callback.
+ */
+void can_rx_ring_init(struct can_rx_ring *ring, struct can_frame *frames, size_t size,
+		      can_rx_batch_callback_t callback, void *user_data);
+
+/**
+ * @brief Queue a received frame in a CAN RX ring
+ *
+ * Matches @a can_rx_callback_t, so it can be passed to @a can_add_rx_filter() or
+ * @a can_add_rx_filter_set() with the ring as user data. A ring is meant to
+ * receive from a single CAN controller.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param frame     Received frame.
+ * @param user_data Pointer to the @a can_rx_ring.
+ */
+void can_rx_ring_put(const struct device *dev, struct can_frame *frame, void *user_data);
+
+/**
+ * @brief Add a CAN RX ring for a given filter
+ *
+ * Wrapper function for @a can_add_rx_filter() which queues received CAN frames
+ * matching the filter in a ring and hands them to the ring callback in batches.
+ *
+ * @param dev    Pointer to the device structure for the driver instance.
+ * @param ring   Pointer to the initialized @a can_rx_ring.
+ * @param filter Pointer to a @a can_filter structure defining the filter.
+ *
+ * @retval filter_id on success.
+ * @retval -ENOSPC if there are no free filters.
+ * @retval -EINVAL if the requested filter type is invalid.
+ * @retval -ENOTSUP if the requested filter type is not supported.
+ */
+static inline int can_add_rx_filter_ring(const struct device *dev, struct can_rx_ring *ring,
+					 const struct can_filter *filter)
+{
+	return can_add_rx_filter(dev, can_rx_ring_put, ring, filter);
+}
+
+/**
+ * @brief Get the number of frames dropped because a CAN RX ring was full
+ *
+ * @param ring Pointer to the ring.
+ *
+ * @return Number of dropped frames.
+ */
+static inline uint32_t can_rx_ring_get_dropped(const struct can_rx_ring *ring)
+{
+	return ring->dropped;
+}
+#endif /* CONFIG_CAN_RX_RING */
+
+#if defined(CONFIG_CAN_RX_FILTER_SET) || defined(__DOXYGEN__)
+/**
+ * @brief CAN RX filter set
+ *
+ * Software filters sharing one callback, installed in as few hardware filters
+ * as the controller has room for.
+ */
+struct can_rx_filter_set {
+	/** Filters of the set, must stay valid while the set is added. */
+	const struct can_filter *filters;
+	/** Number of filters. */
+	size_t count;
+	/** @cond INTERNAL_HIDDEN */
+	can_rx_callback_t callback;
+	void *user_data;
+	int filter_ids[CONFIG_CAN_RX_FILTER_SET_MAX_HW];
+	uint8_t hw_count;
+	/** @endcond */
+};
+
+/**
+ * @brief Add a callback function for a set of CAN filters
+ *
+ * Filters that accept exactly the same frames together are merged first.
+ * If more hardware filters than are available would still be needed, the
+ * filters closest to each other are merged into ones that accept a superset
+ * of frames, until they fit. The callback is called in interrupt context for
+ * frames matching any filter of the set; frames only accepted because of the
+ * merging are dropped in software.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param callback  This function is called for every received matching frame.
+ * @param user_data User data to pass to callback function.
+ * @param set       Pointer to the filter set, with @a filters and @a count set.
+ *
+ * @retval Number of hardware filters used on success.
+ * @retval -ENOSPC if there are no free filters.
+ * @retval -EINVAL if the set or one of its filters is invalid.
+ * @retval -ENOTSUP if a requested filter type is not supported.
+ */
+int can_add_rx_filter_set(const struct device *dev, can_rx_callback_t callback,
+			  void *user_data, struct can_rx_filter_set *set);
+
+/**
+ * @brief Remove a CAN RX filter set
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param set Pointer to a filter set added with @a can_add_rx_filter_set().
+ */
+void can_remove_rx_filter_set(const struct device *dev, struct can_rx_filter_set *set);
+#endif /* CONFIG_CAN_RX_FILTER_SET */
+
 /**
  * @brief Remove a CAN RX filter
  *
@@ -77,6 +77,10 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_ACCESS_CACHE) || defined(__DOXYGEN__)
+	/** Internally used by the block cache, sector count of a cached disk */
+	uint32_t cache_sector_count;
+#endif
 };
 
 /**
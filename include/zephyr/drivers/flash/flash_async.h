@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Queued flash operations completed through callbacks
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_FLASH_FLASH_ASYNC_H_
+#define ZEPHYR_INCLUDE_DRIVERS_FLASH_FLASH_ASYNC_H_
+
+#include <sys/types.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Asynchronous flash operations
+ * @defgroup flash_async Asynchronous flash operations
+ * @ingroup flash_interface
+ * @{
+ */
+
+struct flash_async_req;
+
+/**
+ * @brief Completion callback of a flash request
+ *
+ * Called from the flash work queue. The request can be submitted again from
+ * the callback.
+ *
+ * @param req Completed request
+ * @param result 0 on success, the negative errno code of the flash
+ * operation otherwise
+ */
+typedef void (*flash_async_cb_t)(struct flash_async_req *req, int result);
+
+/** @cond INTERNAL_HIDDEN */
+enum flash_async_op {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+/** @endcond */
+
+/**
+ * @brief Flash request
+ *
+ * Owned by the flash work queue from submission until its callback is
+ * called, the members are private.
+ */
+struct flash_async_req {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	const struct device *dev;
+	enum flash_async_op op;
+	off_t offset;
+	void *data;
+	size_t len;
+	flash_async_cb_t cb;
+	atomic_t busy;
+	/** @endcond */
+
+	/** For the requester to retrieve its context from the callback */
+	void *user_data;
+};
+
+/**
+ * @brief Queue a read from flash
+ *
+ * Requests are carried out one at a time in the order they are submitted,
+ * by a work queue calling the blocking flash API, so that the submitting
+ * thread can go on meanwhile.
+ *
+ * @param dev Flash device
+ * @param req Request, not in use by another operation
+ * @param offset Offset (byte aligned) to read
+ * @param data Buffer to store the data read, until completion
+ * @param len Number of bytes to read
+ * @param cb Callback called on completion
+ *
+ * @retval 0 if the request was queued.
+ * @retval -EBUSY if the request is still in use.
+ */
+int flash_async_read(const struct device *dev, struct flash_async_req *req, off_t offset,
+		     void *data, size_t len, flash_async_cb_t cb);
+
+/**
+ * @brief Queue a write to flash
+ *
+ * See flash_async_read() and flash_write() for the constraints.
+ *
+ * @param dev Flash device
+ * @param req Request, not in use by another operation
+ * @param offset Starting offset for the write
+ * @param data Data to write, until completion
+ * @param len Number of bytes to write
+ * @param cb Callback called on completion
+ *
+ * @retval 0 if the request was queued.
+ * @retval -EBUSY if the request is still in use.
+ */
+int flash_async_write(const struct device *dev, struct flash_async_req *req, off_t offset,
+		      const void *data, size_t len, flash_async_cb_t cb);
+
+/**
+ * @brief Queue an erase of flash
+ *
+ * See flash_async_read() and flash_erase() for the constraints.
+ *
+ * @param dev Flash device
+ * @param req Request, not in use by another operation
+ * @param offset Erase area starting offset
+ * @param size Size of the area to erase
+ * @param cb Callback called on completion
+ *
+ * @retval 0 if the request was queued.
+ * @retval -EBUSY if the request is still in use.
+ */
+int flash_async_erase(const struct device *dev, struct flash_async_req *req, off_t offset,
+		      size_t size, flash_async_cb_t cb);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_FLASH_FLASH_ASYNC_H_ */
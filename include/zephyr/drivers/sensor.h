@@ -1124,6 +1124,9 @@ typedef void (*sensor_processing_callback_t)(int result, uint8_t *buf, uint32_t
  * will decode the userdata and call the @p cb. Once the @p cb returns, the buffer will be released
  * back into @p ctx's mempool if available.
  *
+ * Up to CONFIG_SENSOR_PROCESSING_BATCH_SIZE completions are processed per call, the ones after
+ * the first only if they are available without waiting.
+ *
  * @param[in] ctx The RTIO context to wait on
  * @param[in] cb Callback to call when data is ready for processing
  */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Batch conversion of raw sensor samples
+ *
+ * Vector kernels for the conversions decoders apply to every sample of a
+ * FIFO frame batch. They are backed by CMSIS-DSP when it is enabled, which
+ * uses Helium or NEON where the CPU has it, and by portable loops otherwise.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_SENSOR_CONVERT_H_
+#define ZEPHYR_INCLUDE_DRIVERS_SENSOR_CONVERT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/dsp/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sensor batch conversion
+ * @defgroup sensor_convert Sensor batch conversion
+ * @ingroup sensor_interface
+ * @{
+ */
+
+/**
+ * @brief Convert signed 16-bit samples to scaled Q31 values
+ *
+ * Each sample is taken as a Q15 fraction and multiplied by
+ * @p scale * 2^@p shift, saturating the result:
+ * <pre>
+ *     dst[n] = src[n] / 2^15 * scale / 2^31 * 2^shift
+ * </pre>
+ * A decoder reporting values with a Q31 shift of @c s for a full scale of
+ * @c fs passes the Q31 representation of @c fs / 2^s as @p scale and 0 as
+ * @p shift.
+ *
+ * @param src Samples, e.g. the axes of 3-axis IMU frames in sequence
+ * @param scale Q31 scale factor
+ * @param shift Additional power of two applied to the scale
+ * @param dst Converted values, may not overlap @p src
+ * @param count Number of samples
+ */
+void sensor_convert_i16_to_q31(const int16_t *src, q31_t scale, int8_t shift, q31_t *dst,
+			       size_t count);
+
+/**
+ * @brief Convert packed signed 24-bit little-endian samples to scaled Q31 values
+ *
+ * Same as sensor_convert_i16_to_q31() for samples taken as Q23 fractions,
+ * e.g. the pressure or temperature readings of barometers.
+ *
+ * @param src Packed samples, 3 bytes each
+ * @param scale Q31 scale factor
+ * @param shift Additional power of two applied to the scale
+ * @param dst Converted values
+ * @param count Number of samples
+ */
+void sensor_convert_i24le_to_q31(const uint8_t *src, q31_t scale, int8_t shift, q31_t *dst,
+				 size_t count);
+
+/**
+ * @brief Convert Q31 values with a shift to floats
+ *
+ * <pre>
+ *     dst[n] = src[n] / 2^31 * 2^shift
+ * </pre>
+ *
+ * @param src Q31 values, e.g. the readings of a decoded batch
+ * @param shift Shift of the values as reported by the decoder
+ * @param dst Converted values, may not overlap @p src
+ * @param count Number of values
+ */
+void sensor_convert_q31_to_float(const q31_t *src, int8_t shift, float *dst, size_t count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_SENSOR_CONVERT_H_ */
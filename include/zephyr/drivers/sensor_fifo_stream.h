@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Generic FIFO streaming for sensor drivers
+ *
+ * Ties the FIFO watermark/full interrupt of a register-based sensor to a
+ * single RTIO burst read of the whole FIFO into the buffer of the pending
+ * streaming submission.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_SENSOR_FIFO_STREAM_H_
+#define ZEPHYR_INCLUDE_DRIVERS_SENSOR_FIFO_STREAM_H_
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sensor FIFO streaming
+ * @defgroup sensor_fifo_stream Sensor FIFO streaming
+ * @ingroup sensor_interface
+ * @{
+ */
+
+/**
+ * @brief Description of one FIFO read, passed to the driver to build its header
+ */
+struct sensor_fifo_stream_event {
+	/** Time of the FIFO interrupt, around which the last frame was sampled */
+	uint64_t timestamp_ns;
+	/** Frame period measured between interrupts, 0 until known */
+	uint32_t period_ns;
+	/** Bytes of FIFO data following the driver header */
+	uint16_t fifo_len;
+	/** Interrupt status read when handling the interrupt */
+	uint8_t int_status;
+};
+
+/**
+ * @brief Register layout and driver hooks of a FIFO streaming sensor
+ *
+ * Registers are read by writing their address ORed with the read flag
+ * followed by a read in the same transaction.
+ */
+struct sensor_fifo_stream_config {
+	/** Interrupt status register */
+	uint8_t int_status_reg;
+	/** Interrupt status bits of the FIFO watermark interrupt */
+	uint8_t watermark_mask;
+	/** Interrupt status bits of the FIFO full interrupt */
+	uint8_t full_mask;
+	/** Register of the two byte FIFO fill level in bytes */
+	uint8_t fifo_count_reg;
+	/** FIFO fill level is stored most significant byte first */
+	bool fifo_count_big_endian;
+	/** Register the FIFO is burst read from */
+	uint8_t fifo_data_reg;
+	/** Register and value written to flush the FIFO */
+	uint8_t flush_reg;
+	uint8_t flush_val;
+	/** Flag ORed with register addresses to read them, e.g. the SPI read bit */
+	uint8_t read_flag;
+	/** RTIO iodev flags of the reads, e.g. I2C restart and stop */
+	uint16_t read_iodev_flags;
+	/** Size of the driver header in front of the FIFO data */
+	uint16_t header_size;
+	/** Fill the driver header of a buffer, may be called from an ISR */
+	void (*header_fill)(const struct device *dev, uint8_t *header,
+			    const struct sensor_fifo_stream_event *event);
+	/** Re-enable the FIFO interrupt once it has been handled */
+	void (*int_enable)(const struct device *dev);
+};
+
+/**
+ * @brief FIFO streaming state of a sensor instance
+ */
+struct sensor_fifo_stream {
+	const struct sensor_fifo_stream_config *cfg;
+	const struct device *dev;
+	/** RTIO context used for the bus transfers */
+	struct rtio *r;
+	/** Bus iodev of the sensor */
+	struct rtio_iodev *iodev;
+	/** Pending streaming submission */
+	struct rtio_iodev_sqe *streaming_sqe;
+	/** Size of a FIFO frame in bytes, reads are rounded down to whole frames */
+	uint16_t frame_size;
+	/* State of the interrupt being handled */
+	uint64_t timestamp_ns;
+	uint64_t prev_timestamp_ns;
+	uint32_t period_ns;
+	uint16_t backlog;
+	uint8_t int_status;
+	uint8_t fifo_count[2];
+};
+
+/**
+ * @brief Initialize the FIFO streaming state of a sensor
+ *
+ * @param stream Streaming state
+ * @param dev Sensor device
+ * @param cfg Register layout and hooks
+ * @param r RTIO context for the bus transfers, at least 3 SQEs
+ * @param iodev Bus iodev of the sensor
+ * @param frame_size Size of a FIFO frame in bytes
+ */
+void sensor_fifo_stream_init(struct sensor_fifo_stream *stream, const struct device *dev,
+			     const struct sensor_fifo_stream_config *cfg, struct rtio *r,
+			     struct rtio_iodev *iodev, uint16_t frame_size);
+
+/**
+ * @brief Queue a streaming submission
+ *
+ * The submission is completed at the next FIFO interrupt. The driver is
+ * expected to have configured the interrupts the submission asks for.
+ *
+ * @param stream Streaming state
+ * @param iodev_sqe Streaming submission
+ */
+void sensor_fifo_stream_submit(struct sensor_fifo_stream *stream,
+			       struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Handle a FIFO interrupt
+ *
+ * To be called from the interrupt handler of the sensor. Drivers may keep
+ * the interrupt disabled until the int_enable hook is called, which happens
+ * once the interrupt has been handled.
+ *
+ * @param stream Streaming state
+ */
+void sensor_fifo_stream_event(struct sensor_fifo_stream *stream);
+
+/**
+ * @brief Timestamp of the first of a number of evenly sampled frames
+ *
+ * The frames read at a FIFO interrupt end around the time of the interrupt,
+ * the earlier ones are interpolated back from there.
+ *
+ * @param timestamp_ns Time of the FIFO interrupt
+ * @param period_ns Time between two frames
+ * @param frame_count Number of frames
+ *
+ * @return Timestamp of the first frame
+ */
+static inline uint64_t sensor_fifo_stream_base_timestamp(uint64_t timestamp_ns,
+							 uint32_t period_ns,
+							 uint32_t frame_count)
+{
+	uint64_t span = frame_count > 1 ? (uint64_t)period_ns * (frame_count - 1) : 0;
+
+	return span < timestamp_ns ? timestamp_ns - span : 0;
+}
+
+/**
+ * @brief Update the measured frame period
+ *
+ * @param period_ns Current estimate, 0 if unknown
+ * @param elapsed_ns Time since the previous FIFO interrupt
+ * @param frame_count Frames which entered the FIFO in that time
+ *
+ * @return New estimate, smoothed over a few interrupts
+ */
+static inline uint32_t sensor_fifo_stream_period_update(uint32_t period_ns, uint64_t elapsed_ns,
+							 uint32_t frame_count)
+{
+	uint64_t measured;
+
+	if (frame_count == 0) {
+		return period_ns;
+	}
+
+	measured = elapsed_ns / frame_count;
+	if (measured > UINT32_MAX) {
+		return period_ns;
+	}
+
+	if (period_ns == 0) {
+		return (uint32_t)measured;
+	}
+
+	return (uint32_t)((int64_t)period_ns + ((int64_t)measured - (int64_t)period_ns) / 4);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_SENSOR_FIFO_STREAM_H_ */
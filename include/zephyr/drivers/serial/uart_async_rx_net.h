@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Helper module for receiving into net_buf chunks using UART Asynchronous API.
+ */
+
+#ifndef ZEPHYR_DRIVERS_SERIAL_UART_ASYNC_RX_NET_H_
+#define ZEPHYR_DRIVERS_SERIAL_UART_ASYNC_RX_NET_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/net/buf.h>
+
+struct uart_async_rx_net;
+
+/** @brief Received data callback.
+ *
+ * Called from the UART driver event context for every @ref UART_RX_RDY event.
+ * @p buf references the bytes in place in the buffer the driver received them
+ * into. The callee takes over the reference and must call net_buf_unref() once
+ * the data is processed, after which the memory can be reused for reception.
+ *
+ * @param async_rx  Pointer to the helper instance.
+ * @param buf       Received data.
+ * @param user_data User data from the configuration.
+ */
+typedef void (*uart_async_rx_net_cb_t)(struct uart_async_rx_net *async_rx,
+				       struct net_buf *buf, void *user_data);
+
+/** @brief UART asynchronous net_buf RX helper configuration structure. */
+struct uart_async_rx_net_config {
+	/* Pool of the buffers passed to the UART driver. */
+	struct net_buf_pool *buf_pool;
+
+	/* Pool without data for the chunks handed to the callback. Its destroy
+	 * callback must be @ref uart_async_rx_net_chunk_destroy.
+	 */
+	struct net_buf_pool *chunk_pool;
+
+	/* Received data callback. */
+	uart_async_rx_net_cb_t cb;
+
+	/* User data passed to the callback. */
+	void *user_data;
+};
+
+/** @brief UART asynchronous net_buf RX helper structure. */
+struct uart_async_rx_net {
+	/* Pointer to the configuration structure. Structure must be persistent. */
+	const struct uart_async_rx_net_config *config;
+
+	/* Buffers owned by the driver, the one being filled first. */
+	struct net_buf *drv_buf[2];
+
+	/* Bytes dropped because no chunk was left in the pool. */
+	atomic_t dropped;
+};
+
+/** @brief Destroy callback of the chunk pool.
+ *
+ * Releases the reference the chunk holds on the reception buffer.
+ *
+ * @param buf Chunk being freed.
+ */
+void uart_async_rx_net_chunk_destroy(struct net_buf *buf);
+
+/** @brief Statically define and initialize a helper instance with its pools.
+ *
+ * @param _name      Name of the helper instance.
+ * @param _buf_cnt   Number of reception buffers, at least 2 for double buffering.
+ * @param _buf_size  Size of a reception buffer.
+ * @param _chunk_cnt Number of chunks that can be held by consumers at a time.
+ * @param _cb        Received data callback.
+ * @param _user_data User data passed to the callback.
+ */
+#define UART_ASYNC_RX_NET_DEFINE(_name, _buf_cnt, _buf_size, _chunk_cnt, _cb, _user_data) \
+	NET_BUF_POOL_DEFINE(_name##_buf_pool, _buf_cnt, _buf_size, 0, NULL);              \
+	NET_BUF_POOL_DEFINE(_name##_chunk_pool, _chunk_cnt, 0, sizeof(struct net_buf *),  \
+			    uart_async_rx_net_chunk_destroy);                             \
+	static const struct uart_async_rx_net_config _name##_config = {                  \
+		.buf_pool = &_name##_buf_pool,                                            \
+		.chunk_pool = &_name##_chunk_pool,                                        \
+		.cb = _cb,                                                                \
+		.user_data = _user_data,                                                  \
+	};                                                                                \
+	static struct uart_async_rx_net _name = {                                         \
+		.config = &_name##_config,                                                \
+	}
+
+/** @brief Initialize the helper instance.
+ *
+ * Not needed for instances defined with @ref UART_ASYNC_RX_NET_DEFINE.
+ *
+ * @param async_rx Pointer to the helper instance.
+ * @param config   Configuration. Must be persistent.
+ *
+ * @retval 0 on successful initialization.
+ */
+int uart_async_rx_net_init(struct uart_async_rx_net *async_rx,
+			   const struct uart_async_rx_net_config *config);
+
+/** @brief Release the buffers held for the driver.
+ *
+ * Can be used after RX abort to bring the helper to its initial state. Chunks
+ * still held by consumers stay valid.
+ *
+ * @param async_rx Pointer to the helper instance.
+ */
+void uart_async_rx_net_reset(struct uart_async_rx_net *async_rx);
+
+/** @brief Get next RX buffer.
+ *
+ * Returned pointer shall be provided to @ref uart_rx_buf_rsp or @ref uart_rx_enable.
+ * If null is returned, all buffers are either used by the driver or still
+ * referenced by chunks that have not been released.
+ *
+ * @param async_rx Pointer to the helper instance.
+ * @param length   Location where the buffer length is written.
+ *
+ * @return Pointer to the next RX buffer or null if no buffer available.
+ */
+uint8_t *uart_async_rx_net_buf_req(struct uart_async_rx_net *async_rx, size_t *length);
+
+/** @brief Indicate received data.
+ *
+ * Function shall be called from @ref UART_RX_RDY context. The data is passed
+ * to the callback without being copied.
+ *
+ * @param async_rx Pointer to the helper instance.
+ * @param buffer Buffer received in the UART driver event.
+ * @param offset Offset received in the UART driver event.
+ * @param length Length received in the UART driver event.
+ */
+void uart_async_rx_net_on_rdy(struct uart_async_rx_net *async_rx, uint8_t *buffer,
+			      size_t offset, size_t length);
+
+/** @brief Indicate that buffer is no longer used by the UART driver.
+ *
+ * Function shall be called on @ref UART_RX_BUF_RELEASED event. The buffer
+ * returns to its pool once all chunks referencing it are released.
+ *
+ * @param async_rx Pointer to the helper instance.
+ * @param buffer Buffer pointer received in the UART driver event.
+ */
+void uart_async_rx_net_on_buf_rel(struct uart_async_rx_net *async_rx, uint8_t *buffer);
+
+/** @brief Handle the reception events of the UART driver.
+ *
+ * Convenience function for the UART callback that handles @ref UART_RX_RDY,
+ * @ref UART_RX_BUF_REQUEST and @ref UART_RX_BUF_RELEASED, rotating the
+ * buffers without further action from the user. Other events are ignored.
+ *
+ * @param async_rx Pointer to the helper instance.
+ * @param dev UART device.
+ * @param evt UART driver event.
+ */
+void uart_async_rx_net_on_event(struct uart_async_rx_net *async_rx, const struct device *dev,
+				const struct uart_event *evt);
+
+/** @brief Start reception with the first buffer of the helper.
+ *
+ * @param async_rx Pointer to the helper instance.
+ * @param dev UART device.
+ * @param timeout Inactivity period in microseconds, see @ref uart_rx_enable.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if no buffer is available.
+ * @retval -errno error returned by @ref uart_rx_enable.
+ */
+int uart_async_rx_net_enable(struct uart_async_rx_net *async_rx, const struct device *dev,
+			     int32_t timeout);
+
+/** @brief Get the number of bytes dropped for lack of chunks.
+ *
+ * @param async_rx Pointer to the helper instance.
+ *
+ * @return Number of dropped bytes.
+ */
+static inline uint32_t uart_async_rx_net_get_dropped(struct uart_async_rx_net *async_rx)
+{
+	return (uint32_t)atomic_get(&async_rx->dropped);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_DRIVERS_SERIAL_UART_ASYNC_RX_NET_H_ */
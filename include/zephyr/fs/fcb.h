@@ -141,6 +141,26 @@ struct fcb {
 	const uint8_t f_flags;
 	/**< Flags for configuring the FCB. */
 #endif
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	struct k_work f_erase_work;
+	/**< Background erase of rotated sectors, internal state */
+
+	struct k_condvar f_erase_cond;
+	/**< Signalled when a background erase completes, internal state */
+
+	atomic_t f_erase_stalls;
+	/**< Number of operations which had to wait for an erase */
+
+	uint8_t f_erase_pending;
+	/**< Number of sectors preceding the oldest one which have been
+	 * rotated but not erased yet, internal state
+	 */
+
+	bool f_erasing;
+	/**< Flag indicating that the first pending sector is being erased,
+	 * internal state
+	 */
+#endif
 };
 
 /**
@@ -177,7 +197,9 @@ int fcb_init(int f_area_id, struct fcb *fcb);
  *            payload.
  * @param[out] loc entry location information
  *
- * @return 0 on success, non-zero on failure.
+ * @return 0 on success, non-zero on failure. -EAGAIN when the entry needs a
+ *         sector which could not be erased within the
+ *         CONFIG_FCB_BACKGROUND_ERASE_BUDGET_MS budget.
  */
 int fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *loc);
 
@@ -250,6 +272,11 @@ int fcb_getnext(struct fcb *fcb, struct fcb_entry *loc);
  * Function erases the data from oldest sector. Upon that the next sector
  * becomes the oldest. Active sector is also switched if needed.
  *
+ * With CONFIG_FCB_BACKGROUND_ERASE the sector is only dropped, it is erased
+ * later from a low priority work queue or, at the latest, when it is needed
+ * again for appending. If the device resets before that, the next fcb_init()
+ * finds the sector with its data again, as if it had not been rotated.
+ *
  * @param[in] fcb FCB instance structure.
  */
 int fcb_rotate(struct fcb *fcb);
@@ -305,6 +332,21 @@ int fcb_offset_last_n(struct fcb *fcb, uint8_t entries,
  */
 int fcb_clear(struct fcb *fcb);
 
+#if defined(CONFIG_FCB_BACKGROUND_ERASE) || defined(__DOXYGEN__)
+/**
+ * Get the number of operations stalled by sector erases.
+ *
+ * Counts the appends and rotations which had to erase a rotated sector
+ * themselves, wait for its background erase or gave up because of the
+ * CONFIG_FCB_BACKGROUND_ERASE_BUDGET_MS budget.
+ *
+ * @param[in] fcb FCB instance structure.
+ *
+ * @return Number of stalls since fcb_init().
+ */
+uint32_t fcb_erase_stall_count(struct fcb *fcb);
+#endif
+
 /**
  * @}
  */
@@ -37,6 +37,12 @@ struct fs_littlefs {
 	struct lfs lfs;
 	void *backend;
 	struct k_mutex mutex;
+
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	/* Free blocks erased in the background, not written since */
+	ATOMIC_DEFINE(erased, CONFIG_FS_LITTLEFS_ERASE_AHEAD_MAX_BLOCKS);
+	struct k_work_delayable erase_work;
+#endif
 };
 
 /** @brief Define a littlefs configuration with customized size
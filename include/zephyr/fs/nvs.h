@@ -62,6 +62,30 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_INDEX
+	/** Address of the most recent ATE of every indexed ID */
+	uint32_t index_addr[CONFIG_NVS_INDEX_SIZE];
+	/** ID of every index entry */
+	uint16_t index_id[CONFIG_NVS_INDEX_SIZE];
+	/** Flag indicating that IDs were left out of the full index */
+	bool index_overflow;
+#endif
+#if CONFIG_NVS_BACKGROUND_GC
+	/** Background garbage collection work */
+	struct k_work gc_work;
+	/** Signalled when a background sector erase completes */
+	struct k_condvar gc_cond;
+	/** Number of writes which had to wait for garbage collection */
+	atomic_t gc_stalls;
+	/** Free space left in the write sector by the last garbage collection */
+	uint16_t gc_free;
+	/** Number of garbage collections run for writers since the last write */
+	uint16_t gc_forced;
+	/** Flag indicating that a writer needs garbage collection */
+	bool gc_request;
+	/** Flag indicating that the sector after the write sector is being erased */
+	bool gc_erasing;
+#endif
 };
 
 /**
@@ -109,6 +133,9 @@ int nvs_clear(struct nvs_fs *fs);
  * @return Number of bytes written. On success, it will be equal to the number of bytes requested
  * to be written. When a rewrite of the same data already stored is attempted, nothing is written
  * to flash, thus 0 is returned. On error, returns negative value of errno.h defined error codes.
+ * With a CONFIG_NVS_BACKGROUND_GC_WRITE_BUDGET_MS write latency budget, -EAGAIN is returned when
+ * the write would have to wait for garbage collection for longer, the write has to be retried
+ * once the background garbage collection has made room.
  */
 ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len);
 
@@ -164,6 +191,20 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+#if defined(CONFIG_NVS_BACKGROUND_GC) || defined(__DOXYGEN__)
+/**
+ * @brief Get the number of writes stalled by garbage collection.
+ *
+ * A write stalls when the write sector is full and it has to run garbage collection itself, wait
+ * for a background erase to complete or give up because of the write latency budget.
+ *
+ * @param fs Pointer to file system
+ *
+ * @return Number of stalled writes since the file system was mounted.
+ */
+uint32_t nvs_gc_stall_count(struct nvs_fs *fs);
+#endif
+
 /**
  * @}
  */
@@ -1,5 +1,6 @@
 /*
  * Copyright 2023 Google LLC
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -16,6 +17,7 @@
  * @{
  */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <zephyr/device.h>
 #include <zephyr/dt-bindings/input/input-event-codes.h>
@@ -144,6 +146,43 @@ struct input_callback {
 		.callback = _callback,                                         \
 	}
 
+/**
+ * @brief Input group callback structure.
+ */
+struct input_group_callback {
+	/** @ref device pointer or NULL. */
+	const struct device *dev;
+	/** The callback function. */
+	void (*callback)(const struct input_event *evts, size_t count);
+};
+
+/**
+ * @brief Register a callback structure for groups of input events.
+ *
+ * With @kconfig{CONFIG_INPUT_EVENT_GROUPS}, the events reported by a device
+ * are gathered in the input thread up to the one with the sync flag set, and
+ * passed to the callback as one array. The last event of a group has the
+ * sync flag set, unless the group is delivered before the sync event because
+ * it is full or because another device reported an event meanwhile.
+ *
+ * With @kconfig{CONFIG_INPUT_EVENT_GROUP_COALESCE}, a group may hold the
+ * events of several consecutive syncs while the input queue is backed up,
+ * with only the latest value of each absolute axis.
+ *
+ * The @p _dev field can be used to only invoke callback for events generated
+ * by a specific device. Setting dev to NULL causes callback to be invoked for
+ * the groups of every device.
+ *
+ * @param _dev @ref device pointer or NULL.
+ * @param _callback The callback function.
+ */
+#define INPUT_GROUP_CALLBACK_DEFINE(_dev, _callback)                           \
+	static const STRUCT_SECTION_ITERABLE(input_group_callback,             \
+					     _input_group_callback__##_callback) = { \
+		.dev = _dev,                                                   \
+		.callback = _callback,                                         \
+	}
+
 #ifdef __cplusplus
 }
 #endif
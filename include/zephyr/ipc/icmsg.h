@@ -54,6 +54,10 @@ struct icmsg_data_t {
 	struct k_work_delayable notify_work;
 	struct k_work mbox_work;
 	atomic_t state;
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	/* RX interrupt disabled while polling. */
+	bool rx_polling;
+#endif
 };
 
 /** @brief Open an icmsg instance
@@ -201,6 +201,18 @@ int pbuf_write(struct pbuf *pb, const char *buf, uint16_t len);
  */
 int pbuf_read(struct pbuf *pb, char *buf, uint16_t len);
 
+/**
+ * @brief Get the read index of the packet buffer.
+ *
+ * Meant for the writer to find out how far the reader got, e.g. whether it
+ * had read all packets written before the last one, by comparing the read
+ * index with the write index from before that packet.
+ *
+ * @param pb	A buffer written to.
+ * @retval uint32_t	Read index shared by the reader.
+ */
+uint32_t pbuf_rd_idx_get(struct pbuf *pb);
+
 /**
  * @}
  */
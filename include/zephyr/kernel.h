@@ -1573,6 +1573,27 @@ void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     k_timeout_t duration, k_timeout_t period);
 
+/**
+ * @brief Set the expiry tolerance of a timer.
+ *
+ * This routine allows the kernel to expire the timer later than requested,
+ * by less than @a slack, so that it can be serviced together with other
+ * timeouts expiring around the same time. The expiry is deferred to a
+ * multiple of the largest power of two ticks not above @a slack, timers
+ * with similar slack thus share timer interrupts and wakeups from low power
+ * states. A periodic timer keeps its phase if its period is a multiple of
+ * that granularity.
+ *
+ * The slack applies from the next time the timer is started, K_NO_WAIT
+ * restores the exact expiry.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param timer     Address of timer.
+ * @param slack     Tolerated expiry delay.
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
 /**
  * @brief Stop a timer.
  *
@@ -2894,6 +2915,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3469,6 +3491,38 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+/** @brief Add a worker thread to a work queue.
+ *
+ * The new thread takes items from the same pending list as the thread
+ * started by k_work_queue_start(), so that independent work items submitted
+ * to @p queue can run in parallel.  A work item that is running is never
+ * handed to a second thread, even if it is resubmitted meanwhile.
+ *
+ * The queue must have been started with k_work_queue_start().  Workers
+ * cannot be removed again.
+ *
+ * @param queue pointer to the started queue structure.
+ *
+ * @param worker pointer to the worker structure, which must persist as long
+ *        as the queue is used.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cfg optional additional configuration parameters.  Only the name
+ * and the essential flag are used, yielding is controlled by the
+ * configuration the queue was started with.
+ */
+void k_work_queue_worker_start(struct k_work_q *queue,
+			       struct k_work_q_worker *worker,
+			       k_thread_stack_t *stack, size_t stack_size,
+			       int prio, const struct k_work_queue_config *cfg);
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3952,6 +4006,12 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* The work item being flushed, which may be running on another
+	 * worker of the queue when the flusher is reached.
+	 */
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4043,8 +4103,30 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* Additional threads taking work from the pending list. */
+	sys_slist_t workers;
+
+	/* Number of threads currently running a work item. */
+	uint16_t busy;
+#endif
 };
 
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+/** @brief An additional thread serving a work queue.
+ *
+ * See k_work_queue_worker_start().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* Node in the workers list of the queue. */
+	sys_snode_t node;
+};
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -4438,6 +4520,23 @@ struct k_msgq {
 	/** Number of used messages */
 	uint32_t used_msgs;
 
+#if defined(CONFIG_MSGQ_LOCKFREE) || defined(__DOXYGEN__)
+	/** Wait queue of writers blocked on a full queue */
+	_wait_q_t put_wait_q;
+	/** Next slot index to be claimed by a writer */
+	atomic_t wr_head;
+	/** Slot index up to which messages are visible to readers */
+	atomic_t wr_tail;
+	/** Next slot index to be claimed by a reader */
+	atomic_t rd_head;
+	/** Slot index up to which slots are free again for writers */
+	atomic_t rd_tail;
+	/** Wrap-around point of the slot indexes */
+	uint32_t wrap;
+	/** Number of threads in the blocking path */
+	atomic_t waiters;
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	Z_DECL_POLL_EVENT
 
 	/** Message queue */
@@ -4454,6 +4553,20 @@ struct k_msgq {
  */
 
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/* Slot indexes run over a multiple of the queue length close to 2^30, so
+ * that a stale index can't alias a live one within any realistic window.
+ */
+#define Z_MSGQ_WRAP(q_max_msgs) \
+	(((q_max_msgs) == 0U) ? 0U : ((BIT(30) / (q_max_msgs)) * (q_max_msgs)))
+
+#define Z_MSGQ_LOCKFREE_INIT(obj, q_max_msgs) \
+	.put_wait_q = Z_WAIT_Q_INIT(&obj.put_wait_q), \
+	.wrap = Z_MSGQ_WRAP(q_max_msgs),
+#else
+#define Z_MSGQ_LOCKFREE_INIT(obj, q_max_msgs)
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -4464,6 +4577,7 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	Z_MSGQ_LOCKFREE_INIT(obj, q_max_msgs) \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
@@ -4676,9 +4790,27 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+/* Messages published but not yet claimed by a reader.  Only a snapshot
+ * when other contexts use the queue concurrently.
+ */
+static inline uint32_t z_msgq_lockfree_used(struct k_msgq *msgq)
+{
+	uint32_t r = (uint32_t)atomic_get(&msgq->rd_head);
+	uint32_t w = (uint32_t)atomic_get(&msgq->wr_tail);
+	uint32_t used = (w >= r) ? (w - r) : (w + msgq->wrap - r);
+
+	return MIN(used, msgq->max_msgs);
+}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_LOCKFREE
+	return msgq->max_msgs - z_msgq_lockfree_used(msgq);
+#else
 	return msgq->max_msgs - msgq->used_msgs;
+#endif /* CONFIG_MSGQ_LOCKFREE */
 }
 
 /**
@@ -4694,7 +4826,11 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_LOCKFREE
+	return z_msgq_lockfree_used(msgq);
+#else
 	return msgq->used_msgs;
+#endif /* CONFIG_MSGQ_LOCKFREE */
 }
 
 /** @} */
@@ -4868,6 +5004,10 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+#if defined(CONFIG_PIPE_CLAIM) || defined(__DOXYGEN__)
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
+#endif
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -5038,6 +5178,77 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+#if defined(CONFIG_PIPE_CLAIM) || defined(__DOXYGEN__)
+/**
+ * @brief Claim free space in the buffer of @a pipe for writing in place.
+ *
+ * The claimed area is contiguous, so less than @a size bytes are returned
+ * when the free space wraps around the end of the buffer. Calling this
+ * again extends the claim with the following area, which allows filling
+ * the pipe with scatter-gather operations such as DMA transfers. The data
+ * only becomes visible to readers once committed with k_pipe_put_commit().
+ *
+ * While space is claimed, @a pipe must not be written with k_pipe_put().
+ * This routine never blocks and may be called from an ISR, but not from
+ * user mode.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of a pointer set to the claimed area.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, which may be zero.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Commit data written to the areas claimed with k_pipe_put_claim().
+ *
+ * The first @a size claimed bytes are added to the pipe, and waiting readers
+ * are served from them. The rest of the claim is released.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the claimed space.
+ */
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in the buffer of @a pipe for reading in place.
+ *
+ * Works like k_pipe_put_claim() on the other end: the claimed area is
+ * contiguous, repeated calls extend the claim, and the data stays in the
+ * pipe until it is released with k_pipe_get_commit().
+ *
+ * While data is claimed, @a pipe must not be read with k_pipe_get() or
+ * flushed. This routine never blocks and may be called from an ISR, but not
+ * from user mode.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of a pointer set to the claimed data.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, which may be zero.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Release data read from the areas claimed with k_pipe_get_claim().
+ *
+ * The first @a size claimed bytes are removed from the pipe, and the freed
+ * space is refilled from waiting writers. The rest of the claim stays in
+ * the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the claimed data.
+ */
+int k_pipe_get_commit(struct k_pipe *pipe, size_t size);
+#endif /* CONFIG_PIPE_CLAIM */
+
 /**
  * @brief Flush the pipe of write data
  *
@@ -5076,7 +5287,23 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CACHE
+	/* Blocks counted in num_used that sit in a per-CPU cache */
+	uint32_t num_cached;
+#endif
+};
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+struct k_mem_slab_magazine {
+	struct k_spinlock lock;
+	uint32_t count;
+	void *rounds[CONFIG_MEM_SLAB_CACHE_SIZE];
+};
+
+struct k_mem_slab_cache {
+	struct k_mem_slab_magazine mag[CONFIG_MP_MAX_NUM_CPUS];
 };
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
 struct k_mem_slab {
 	_wait_q_t wait_q;
@@ -5084,6 +5311,9 @@ struct k_mem_slab {
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_CACHE
+	struct k_mem_slab_cache *cache;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5226,6 +5456,49 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+#if defined(CONFIG_MEM_SLAB_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Statically define a per-CPU cache for a memory slab.
+ *
+ * The cache is attached to a memory slab with k_mem_slab_cache_attach().
+ *
+ * @param name Name of the memory slab cache.
+ */
+#define K_MEM_SLAB_CACHE_DEFINE(name) \
+	struct k_mem_slab_cache name
+
+/**
+ * @brief Attach a per-CPU cache to a memory slab.
+ *
+ * Once attached, k_mem_slab_alloc() and k_mem_slab_free() first try a
+ * magazine of up to CONFIG_MEM_SLAB_CACHE_SIZE blocks owned by the calling
+ * CPU, and only take the slab lock to exchange half a magazine of blocks with
+ * the slab. This avoids contending on the slab lock for slabs that see
+ * frequent allocations on several CPUs, like network packet slabs.
+ *
+ * Blocks held by the caches of other CPUs are returned to the slab before an
+ * allocation fails or waits, and freed blocks bypass the caches while threads
+ * are waiting on the slab. They are not reported as used by
+ * k_mem_slab_num_used_get() and the stats functions, but do count as used
+ * for k_mem_slab_max_used_get().
+ *
+ * The cache must be attached before the first allocation from the slab and
+ * cannot be detached.
+ *
+ * @param slab Address of the memory slab.
+ * @param cache Address of the memory slab cache.
+ *
+ * @retval 0 on success
+ * @retval -EBUSY The slab already has a cache or blocks are allocated.
+ */
+int k_mem_slab_cache_attach(struct k_mem_slab *slab,
+			    struct k_mem_slab_cache *cache);
+
+/** @cond INTERNAL_HIDDEN */
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+/** @endcond */
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5238,7 +5511,14 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CACHE
+	uint32_t num_used = slab->info.num_used;
+	uint32_t num_cached = z_mem_slab_num_cached(slab);
+
+	return (num_used > num_cached) ? (num_used - num_cached) : 0U;
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5273,7 +5553,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5888,6 +6168,79 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+#if defined(CONFIG_POLL_SET) || defined(__DOXYGEN__)
+/**
+ * @brief Poll set
+ *
+ * A set of poll events that stay registered to their objects across waits,
+ * so that waiting costs depend on the number of ready events rather than on
+ * the number of events in the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t returned;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init(), is registered to its
+ * object until it is removed again with k_poll_set_remove(). It must not be
+ * passed to k_poll() or be part of another set in the meantime.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ */
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set the event was added to.
+ * @param event The event to remove.
+ */
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Like k_poll(), but only the ready events are returned, with their state
+ * field set. The events returned by a call are checked again on the next
+ * call, so the associated object should have been consumed by then, or
+ * the event is returned again. Poll signals have to be reset for the same
+ * reason. The other events of the set are not touched by the call.
+ *
+ * Only available from supervisor mode.
+ *
+ * @param set The poll set.
+ * @param ready Array to fill with the ready events.
+ * @param max_events Size of the @a ready array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready, or one of the errors below.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, k_timeout_t timeout);
+#endif /* CONFIG_POLL_SET */
+
 /** @} */
 
 /**
@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include <inttypes.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/slist.h>
 
 /**
  * Paging Statistics.
@@ -57,9 +58,31 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+#if defined(CONFIG_DEMAND_PAGING_PREFETCH) || defined(__DOXYGEN__)
+	struct {
+		/** Number of pages paged in ahead of a page fault */
+		unsigned long			pages;
+	} prefetch;
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
+/**
+ * Virtual memory region with its own paging statistics.
+ *
+ * Page faults and prefetches are accounted to the region containing the
+ * paged in address, evictions to the region the evicted page was mapped in.
+ */
+struct k_mem_paging_region {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t			node;
+	uintptr_t			start;
+	size_t				size;
+	struct k_mem_paging_stats_t	stats;
+	/** @endcond */
+};
+
 /**
  * Paging Statistics Histograms.
  */
@@ -170,6 +193,40 @@ __syscall
 void k_mem_paging_thread_stats_get(struct k_thread *thread,
 				   struct k_mem_paging_stats_t *stats);
 
+/**
+ * Start gathering paging statistics for a virtual memory region
+ *
+ * The region structure is accessed while servicing page faults, so it
+ * must reside in pinned memory. Regions must not overlap.
+ *
+ * @param region Region structure to fill, owned by the caller
+ * @param addr Base virtual address of the region
+ * @param size Size of the region in bytes
+ */
+void k_mem_paging_region_stats_register(struct k_mem_paging_region *region,
+					void *addr, size_t size);
+
+/**
+ * Stop gathering paging statistics for a virtual memory region
+ *
+ * @param region Region previously passed to
+ *        k_mem_paging_region_stats_register()
+ */
+void k_mem_paging_region_stats_unregister(struct k_mem_paging_region *region);
+
+/**
+ * Get the paging statistics of a virtual memory region
+ *
+ * This populates the paging statistics struct being passed in
+ * as argument with the statistics gathered since the region was
+ * registered.
+ *
+ * @param[in] region Registered region
+ * @param[in,out] stats Paging statistics struct to be filled.
+ */
+void k_mem_paging_region_stats_get(struct k_mem_paging_region *region,
+				   struct k_mem_paging_stats_t *stats);
+
 /**
  * Get the eviction timing histogram
  *
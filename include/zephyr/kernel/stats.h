@@ -27,6 +27,20 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_LATENCY is selected.
+	 *
+	 * Only maintained for threads, they stay zero for CPUs.
+	 * @{
+	 */
+	uint32_t  ready;        /**< cycle stamp of becoming ready, 0 when not waiting */
+	uint32_t  preemptions;  /**< \# of times switched out while still runnable */
+	uint32_t  latency_max;  /**< longest ready to running latency in cycles */
+	/** log2 histogram of the ready to running latency */
+	uint32_t  latency[CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS];
+	/** @} */
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
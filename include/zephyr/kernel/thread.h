@@ -61,6 +61,9 @@ struct _thread_base {
 	union {
 		sys_dnode_t qnode_dlist;
 		struct rbnode qnode_rb;
+#ifdef CONFIG_SCHED_PAIRING_HEAP
+		struct pheap_node qnode_pheap;
+#endif
 	};
 
 	/* wait queue on which the thread is pended (needed only for
@@ -237,6 +240,20 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	/*
+	 * Scheduling latency of a thread: the number of times it was
+	 * switched out while still runnable, the longest time it waited
+	 * between becoming ready and running, and a histogram of those
+	 * waits (see CONFIG_SCHED_THREAD_USAGE_LATENCY_SHIFT for the bucket
+	 * bounds). Always zero for CPU stats.
+	 */
+
+	uint32_t preemptions;
+	uint32_t latency_max;
+	uint32_t latency[CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS];
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
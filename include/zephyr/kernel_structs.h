@@ -30,6 +30,7 @@
 #include <zephyr/kernel/stats.h>
 #include <zephyr/kernel/obj_core.h>
 #include <zephyr/sys/rb.h>
+#include <zephyr/sys/pheap.h>
 #endif
 
 #define K_NUM_THREAD_PRIO (CONFIG_NUM_PREEMPT_PRIORITIES + CONFIG_NUM_COOP_PRIORITIES + 1)
@@ -111,6 +112,14 @@ struct _priq_rb {
 	int next_order_key;
 };
 
+/* Pairing heap, whose root is the best thread.  Same O(logN) scaling
+ * as the tree, but adding a thread and finding the best one are O(1).
+ */
+struct _priq_pheap {
+	struct pheap heap;
+	uint32_t next_order_key;
+};
+
 
 /* Traditional/textbook "multi-queue" structure.  Separate lists for a
  * small number (max 32 here) of fixed priorities.  This corresponds
@@ -134,6 +143,8 @@ struct _ready_q {
 	sys_dlist_t runq;
 #elif defined(CONFIG_SCHED_SCALABLE)
 	struct _priq_rb runq;
+#elif defined(CONFIG_SCHED_PAIRING_HEAP)
+	struct _priq_pheap runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
@@ -154,7 +165,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -210,7 +221,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -240,8 +251,8 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Bitmask of CPUs to signal an IPI at the next scheduling point */
+	atomic_t pending_ipi;
 #endif
 };
 
@@ -302,6 +313,10 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Tolerated expiry delay in ticks, see k_timer_slack_set() */
+	uint32_t slack;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
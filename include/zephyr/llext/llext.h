@@ -129,6 +129,20 @@ struct llext_load_param {
 	 * the memory buffer, where the object is loaded
 	 */
 	bool pre_located;
+#if defined(CONFIG_LLEXT_IMAGE) || defined(__DOXYGEN__)
+	/**
+	 * Buffer to write a pre-linked image of the extension to while it is
+	 * loaded, or NULL. The image can be stored (e.g. in flash) and later
+	 * loaded with llext_load_image().
+	 */
+	void *image;
+	/**
+	 * Size of the image buffer. Set to the length of the written image on
+	 * a successful load, or to 0 if the buffer was too small or the
+	 * extension uses relocations an image cannot record.
+	 */
+	size_t image_size;
+#endif /* CONFIG_LLEXT_IMAGE */
 };
 
 #define LLEXT_LOAD_PARAM_DEFAULT {.relocate_local = true,}
@@ -153,6 +167,28 @@ struct llext_load_param {
 int llext_load(struct llext_loader *loader, const char *name, struct llext **ext,
 	       struct llext_load_param *ldr_parm);
 
+/**
+ * @brief Load an extension from a pre-linked image
+ *
+ * Loads an image written while loading the extension from its ELF file with
+ * llext_load_param::image set. The sections are copied and the recorded
+ * relocations applied without parsing the ELF file or looking up symbols.
+ *
+ * Requires CONFIG_LLEXT_IMAGE.
+ *
+ * @param[in] loader A loader providing the image data
+ * @param[in] name A string identifier for the extension
+ * @param[out] ext This will hold the pointer to the llext struct
+ *
+ * @retval 0 Success
+ * @retval > 0 extension use count
+ * @retval -ENOMEM Not enough memory
+ * @retval -EINVAL Invalid image
+ * @retval -ESTALE Image was created for a different base image, the
+ *	   extension has to be loaded from its ELF file again
+ */
+int llext_load_image(struct llext_loader *loader, const char *name, struct llext **ext);
+
 /**
  * @brief Unload an extension
  *
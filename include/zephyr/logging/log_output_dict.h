@@ -23,6 +23,7 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	MSG_NORMAL_COMPACT = 2,
 };
 
 /**
@@ -38,6 +39,16 @@ struct log_dict_output_normal_msg_hdr_t {
 	log_timestamp_t timestamp;
 } __packed;
 
+/*
+ * Compact output of one dictionary based log message, used with
+ * CONFIG_LOG_DICTIONARY_COMPACT. It starts with the type byte and a byte
+ * holding the domain (bits 0-2) and the level (bits 3-5). The source ID,
+ * the timestamp, the package length and the data length follow as
+ * unsigned LEB128 varints. The 32 bit words of the package up to the end
+ * of its arguments are then written as varints, and the rest of the
+ * package and the hexdump data as is.
+ */
+
 /**
  * Output for one dictionary based log message about
  * dropped messages.
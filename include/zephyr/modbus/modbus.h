@@ -383,6 +383,27 @@ struct modbus_user_callbacks {
 
 	/** Floating Point Holding Register write callback */
 	int (*holding_reg_wr_fp)(uint16_t addr, float reg);
+
+	/**
+	 * Input Registers range read callback, used instead of
+	 * input_reg_rd when set and no floating-point register is
+	 * part of the request
+	 */
+	int (*input_regs_rd)(uint16_t addr, uint16_t *regs, uint16_t num);
+
+	/**
+	 * Holding Registers range read callback, used instead of
+	 * holding_reg_rd when set and no floating-point register is
+	 * part of the request
+	 */
+	int (*holding_regs_rd)(uint16_t addr, uint16_t *regs, uint16_t num);
+
+	/**
+	 * Holding Registers range write callback, used instead of
+	 * holding_reg_wr when set for Write Multiple Registers requests
+	 * without floating-point registers
+	 */
+	int (*holding_regs_wr)(uint16_t addr, const uint16_t *regs, uint16_t num);
 };
 
 /**
@@ -564,10 +585,16 @@ int modbus_disable(const uint8_t iface);
 /**
  * @brief Submit raw ADU
  *
+ * With CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE, several ADUs can be submitted
+ * before the previous ones are answered, e.g. to pipeline Modbus TCP
+ * requests. They are processed in order, and the responses passed to the
+ * raw ADU callback carry the transaction identifier of their request.
+ *
  * @param iface      Modbus RTU interface index
  * @param adu        Pointer to the RAW ADU struct that is received
  *
  * @retval           0 If transfer was successful
+ * @retval           -ENOBUFS If the ADU queue is full
  */
 int modbus_raw_submit_rx(const int iface, const struct modbus_adu *adu);
 
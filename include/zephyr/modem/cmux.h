@@ -155,8 +155,11 @@ struct modem_cmux {
 
 	/* Received frame */
 	struct modem_cmux_frame frame;
-	uint8_t frame_header[5];
-	uint16_t frame_header_len;
+	uint8_t receive_fcs;
+
+	/* Start of the transmit buffer claimed through a DLCI pipe */
+	uint8_t *transmit_claim;
+	uint16_t transmit_claim_size;
 
 	/* Work */
 	struct k_work_delayable receive_work;
@@ -54,11 +54,24 @@ typedef int (*modem_pipe_api_receive)(void *data, uint8_t *buf, size_t size);
 
 typedef int (*modem_pipe_api_close)(void *data);
 
+typedef int (*modem_pipe_api_transmit_claim)(void *data, uint8_t **buf, size_t size);
+
+typedef int (*modem_pipe_api_transmit_commit)(void *data, size_t size);
+
+typedef int (*modem_pipe_api_receive_claim)(void *data, uint8_t **buf, size_t size);
+
+typedef int (*modem_pipe_api_receive_finish)(void *data, size_t size);
+
 struct modem_pipe_api {
 	modem_pipe_api_open open;
 	modem_pipe_api_transmit transmit;
 	modem_pipe_api_receive receive;
 	modem_pipe_api_close close;
+	/* Optional zero-copy access to the pipe buffers */
+	modem_pipe_api_transmit_claim transmit_claim;
+	modem_pipe_api_transmit_commit transmit_commit;
+	modem_pipe_api_receive_claim receive_claim;
+	modem_pipe_api_receive_finish receive_finish;
 };
 
 enum modem_pipe_state {
@@ -160,6 +173,72 @@ int modem_pipe_transmit(struct modem_pipe *pipe, const uint8_t *buf, size_t size
  */
 int modem_pipe_receive(struct modem_pipe *pipe, uint8_t *buf, size_t size);
 
+/**
+ * @brief Claim pipe buffer space to transmit data without copying it
+ *
+ * The caller writes up to the returned number of bytes to @p buf and hands
+ * them to the pipe with @ref modem_pipe_transmit_commit. The pipe is locked
+ * for other transmitters in between, so the commit must follow from the same
+ * thread without blocking.
+ *
+ * @param pipe Pipe to transmit through
+ * @param buf Set to the claimed buffer
+ * @param size Number of bytes requested
+ *
+ * @retval Number of bytes claimed, may be less than requested
+ * @retval -EPERM if pipe is closed
+ * @retval -ENOTSUP if pipe does not support claiming buffers
+ * @retval -ENOMEM if no contiguous space is free; use @ref modem_pipe_transmit
+ * or retry after MODEM_PIPE_EVENT_TRANSMIT_IDLE
+ * @retval -errno code on error
+ *
+ * @warning This call must be non-blocking
+ */
+int modem_pipe_transmit_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size);
+
+/**
+ * @brief Transmit data written to a claimed pipe buffer
+ *
+ * @param pipe Pipe to transmit through
+ * @param size Number of bytes written, at most the number claimed. 0 aborts
+ * the claim.
+ *
+ * @retval Number of bytes placed in pipe
+ * @retval -errno code on error
+ */
+int modem_pipe_transmit_commit(struct modem_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim received data in place
+ *
+ * Received data is accessed in the pipe's own buffer and released with
+ * @ref modem_pipe_receive_finish once processed. Data may be split in several
+ * claims if it wraps around the buffer.
+ *
+ * @param pipe Pipe to receive from
+ * @param buf Set to the received data
+ * @param size Maximum number of bytes to claim
+ *
+ * @retval Number of bytes claimed
+ * @retval -EPERM if pipe is closed
+ * @retval -ENOTSUP if pipe does not support claiming buffers
+ * @retval -errno code on error
+ *
+ * @warning This call must be non-blocking
+ */
+int modem_pipe_receive_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size);
+
+/**
+ * @brief Release claimed received data
+ *
+ * @param pipe Pipe to receive from
+ * @param size Number of bytes processed, at most the number claimed
+ *
+ * @retval 0 on success
+ * @retval -errno code on error
+ */
+int modem_pipe_receive_finish(struct modem_pipe *pipe, size_t size);
+
 /**
  * @brief Clear callback
  *
@@ -177,6 +177,253 @@ static inline int net_capture_disable(const struct device *dev)
 #endif
 }
 
+/**
+ * @name Capture filter instruction encoding
+ *
+ * The encoding is the same as in classic BPF, so programs generated for
+ * example by "tcpdump -dd <expression>" can be used as is.
+ * @{
+ */
+
+/* Instruction classes */
+#define NET_CAPTURE_FILTER_LD   0x00 /**< Load into the accumulator */
+#define NET_CAPTURE_FILTER_LDX  0x01 /**< Load into the index register */
+#define NET_CAPTURE_FILTER_ST   0x02 /**< Store the accumulator */
+#define NET_CAPTURE_FILTER_STX  0x03 /**< Store the index register */
+#define NET_CAPTURE_FILTER_ALU  0x04 /**< Arithmetic on the accumulator */
+#define NET_CAPTURE_FILTER_JMP  0x05 /**< Jump */
+#define NET_CAPTURE_FILTER_RET  0x06 /**< Return the number of bytes to capture */
+#define NET_CAPTURE_FILTER_MISC 0x07 /**< Register transfer */
+
+/* Load sizes */
+#define NET_CAPTURE_FILTER_W 0x00 /**< 32-bit word */
+#define NET_CAPTURE_FILTER_H 0x08 /**< 16-bit half word */
+#define NET_CAPTURE_FILTER_B 0x10 /**< Byte */
+
+/* Load modes */
+#define NET_CAPTURE_FILTER_IMM 0x00 /**< Constant */
+#define NET_CAPTURE_FILTER_ABS 0x20 /**< Packet data at a fixed offset */
+#define NET_CAPTURE_FILTER_IND 0x40 /**< Packet data at an offset relative to X */
+#define NET_CAPTURE_FILTER_MEM 0x60 /**< Scratch memory word */
+#define NET_CAPTURE_FILTER_LEN 0x80 /**< Packet length */
+#define NET_CAPTURE_FILTER_MSH 0xa0 /**< IPv4 header length */
+
+/* ALU operations */
+#define NET_CAPTURE_FILTER_ADD 0x00 /**< Addition */
+#define NET_CAPTURE_FILTER_SUB 0x10 /**< Subtraction */
+#define NET_CAPTURE_FILTER_MUL 0x20 /**< Multiplication */
+#define NET_CAPTURE_FILTER_DIV 0x30 /**< Division */
+#define NET_CAPTURE_FILTER_OR  0x40 /**< Bitwise or */
+#define NET_CAPTURE_FILTER_AND 0x50 /**< Bitwise and */
+#define NET_CAPTURE_FILTER_LSH 0x60 /**< Left shift */
+#define NET_CAPTURE_FILTER_RSH 0x70 /**< Right shift */
+#define NET_CAPTURE_FILTER_NEG 0x80 /**< Negation */
+#define NET_CAPTURE_FILTER_MOD 0x90 /**< Modulo */
+#define NET_CAPTURE_FILTER_XOR 0xa0 /**< Bitwise exclusive or */
+
+/* Jump conditions */
+#define NET_CAPTURE_FILTER_JA   0x00 /**< Always */
+#define NET_CAPTURE_FILTER_JEQ  0x10 /**< Equal */
+#define NET_CAPTURE_FILTER_JGT  0x20 /**< Greater than */
+#define NET_CAPTURE_FILTER_JGE  0x30 /**< Greater than or equal */
+#define NET_CAPTURE_FILTER_JSET 0x40 /**< Any of the bits set */
+
+/* Operand sources */
+#define NET_CAPTURE_FILTER_K 0x00 /**< The constant of the instruction */
+#define NET_CAPTURE_FILTER_X 0x08 /**< The index register */
+#define NET_CAPTURE_FILTER_A 0x10 /**< The accumulator, for returns only */
+
+/* Register transfers */
+#define NET_CAPTURE_FILTER_TAX 0x00 /**< Copy the accumulator to X */
+#define NET_CAPTURE_FILTER_TXA 0x80 /**< Copy X to the accumulator */
+
+/** Filter instruction without a jump */
+#define NET_CAPTURE_FILTER_STMT(_code, _k) \
+	{ .code = (_code), .jt = 0, .jf = 0, .k = (_k) }
+
+/** Conditional jump filter instruction */
+#define NET_CAPTURE_FILTER_JUMP(_code, _k, _jt, _jf) \
+	{ .code = (_code), .jt = (_jt), .jf = (_jf), .k = (_k) }
+
+/** @} */
+
+/**
+ * @brief Capture filter instruction.
+ *
+ * The filter is run on the packet as it is captured, starting from its
+ * link layer header. It returns the number of bytes to capture from the
+ * packet, zero meaning that the packet is not captured at all.
+ */
+struct net_capture_filter_insn {
+	uint16_t code; /**< Operation code */
+	uint8_t jt;    /**< Instructions to skip if the jump condition is true */
+	uint8_t jf;    /**< Instructions to skip if the jump condition is false */
+	uint32_t k;    /**< Generic constant */
+};
+
+/**
+ * @brief Set the filter of a network packet capture device.
+ *
+ * @details The filter is evaluated for every packet of the captured
+ * network interface before the packet is copied, so packets that are not
+ * of interest cost very little.
+ *
+ * @param dev Network capture device
+ * @param prog Filter program, copied by the function. NULL removes the
+ *        filter so that all the packets are captured.
+ * @param count Number of instructions in the program.
+ *
+ * @return 0 if ok, -EINVAL if the program is invalid, -E2BIG if it has more
+ *         than CONFIG_NET_CAPTURE_FILTER_MAX_INSNS instructions.
+ */
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+int net_capture_filter_set(const struct device *dev,
+			   const struct net_capture_filter_insn *prog,
+			   size_t count);
+#else
+static inline int net_capture_filter_set(const struct device *dev,
+					 const struct net_capture_filter_insn *prog,
+					 size_t count)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(prog);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Set the snap length of a network packet capture device.
+ *
+ * @details Only the first bytes of each captured packet are copied,
+ * which is usually enough to see the protocol headers.
+ *
+ * @param dev Network capture device
+ * @param snaplen Maximum number of bytes captured from a packet, 0 to
+ *        capture whole packets.
+ *
+ * @return 0 if ok, <0 if the snap length cannot be set
+ */
+#if defined(CONFIG_NET_CAPTURE)
+int net_capture_snaplen_set(const struct device *dev, uint32_t snaplen);
+#else
+static inline int net_capture_snaplen_set(const struct device *dev, uint32_t snaplen)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(snaplen);
+
+	return -ENOTSUP;
+}
+#endif
+
+/** Header of a packet stored in the capture ring */
+struct net_capture_record_hdr {
+	/** Capture time, in microseconds since boot */
+	uint64_t timestamp;
+	/** Number of packet bytes stored in the ring */
+	uint32_t caplen;
+	/** Original length of the packet */
+	uint32_t len;
+	/** Index of the network interface the packet was captured from */
+	int iface;
+};
+
+/** Capture ring usage */
+struct net_capture_ring_stats {
+	/** Number of packets stored in the ring */
+	uint32_t stored;
+	/** Number of packets dropped because the ring was full */
+	uint32_t dropped;
+	/** Number of bytes in use */
+	size_t used;
+	/** Size of the ring in bytes */
+	size_t size;
+};
+
+/**
+ * @brief Setup network packet capturing into the capture ring.
+ *
+ * @details Instead of being tunneled to a remote host, the packets
+ * captured by this device are stored in a ring buffer of
+ * CONFIG_NET_CAPTURE_RING_SIZE bytes. Storing a packet does not allocate
+ * any network buffers. The stored packets can be read with
+ * net_capture_ring_get() or sent by a tunnel capture device with
+ * net_capture_ring_flush(). When the ring is full, new packets are dropped.
+ *
+ * @param dev Network capture device. This is returned to the caller.
+ *
+ * @return 0 if ok, <0 if network packet capture setup failed
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_setup(const struct device **dev);
+#else
+static inline int net_capture_ring_setup(const struct device **dev)
+{
+	ARG_UNUSED(dev);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Take the oldest packet from the capture ring.
+ *
+ * @param hdr Header of the packet is returned here.
+ * @param data Buffer where the packet data is copied.
+ * @param len Length of the buffer. If the packet does not fit, the rest of
+ *        it is discarded.
+ *
+ * @return Number of bytes copied, -EAGAIN if the ring is empty.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_get(struct net_capture_record_hdr *hdr, uint8_t *data,
+			 size_t len);
+#else
+static inline int net_capture_ring_get(struct net_capture_record_hdr *hdr,
+				       uint8_t *data, size_t len)
+{
+	ARG_UNUSED(hdr);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Send the packets of the capture ring to the tunnel peer.
+ *
+ * @param dev Network capture device created by net_capture_setup(). It
+ *        must be enabled so that its tunnel interface is up.
+ *
+ * @return Number of packets sent, <0 if the ring could not be flushed.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_flush(const struct device *dev);
+#else
+static inline int net_capture_ring_flush(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the capture ring usage.
+ *
+ * @param stats Usage information is returned here.
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats);
+#else
+static inline void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	*stats = (struct net_capture_ring_stats){ 0 };
+}
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
 /**
@@ -245,6 +492,29 @@ static inline int net_capture_pkt_with_status(struct net_if *iface, struct net_p
 }
 #endif
 
+/**
+ * @brief Check that a capture filter program is valid.
+ *
+ * @param prog Filter program
+ * @param count Number of instructions in the program
+ *
+ * @return 0 if ok, -EINVAL if the program is invalid
+ */
+int net_capture_filter_check(const struct net_capture_filter_insn *prog,
+			     size_t count);
+
+/**
+ * @brief Run a checked capture filter program on a network packet.
+ *
+ * @param prog Filter program
+ * @param count Number of instructions in the program
+ * @param pkt Network packet, its cursor is not modified.
+ *
+ * @return Number of bytes to capture, 0 if the packet is not captured.
+ */
+uint32_t net_capture_filter_run(const struct net_capture_filter_insn *prog,
+				size_t count, struct net_pkt *pkt);
+
 /** @endcond */
 
 /** The type and direction of the captured data. */
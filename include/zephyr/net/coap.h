@@ -56,10 +56,12 @@ enum coap_option_num {
 	COAP_OPTION_MAX_AGE = 14,        /**< Max-Age */
 	COAP_OPTION_URI_QUERY = 15,      /**< Uri-Query */
 	COAP_OPTION_ACCEPT = 17,         /**< Accept */
+	COAP_OPTION_Q_BLOCK1 = 19,       /**< Q-Block1 (RFC 9177) */
 	COAP_OPTION_LOCATION_QUERY = 20, /**< Location-Query */
 	COAP_OPTION_BLOCK2 = 23,         /**< Block2 (RFC 7959) */
 	COAP_OPTION_BLOCK1 = 27,         /**< Block1 (RFC 7959) */
 	COAP_OPTION_SIZE2 = 28,          /**< Size2 (RFC 7959) */
+	COAP_OPTION_Q_BLOCK2 = 31,       /**< Q-Block2 (RFC 9177) */
 	COAP_OPTION_PROXY_URI = 35,      /**< Proxy-Uri */
 	COAP_OPTION_PROXY_SCHEME = 39,   /**< Proxy-Scheme */
 	COAP_OPTION_SIZE1 = 60,          /**< Size1 */
@@ -903,6 +905,22 @@ int coap_get_block1_option(const struct coap_packet *cpkt, bool *has_more, uint8
  */
 int coap_get_block2_option(const struct coap_packet *cpkt, uint8_t *block_number);
 
+/**
+ * @brief Append a Q-Block2 option to a request (RFC 9177).
+ *
+ * A request may carry several Q-Block2 options to ask for missing blocks
+ * of a representation at once.
+ *
+ * @param cpkt Request to append the option to
+ * @param block_number Number of the block requested
+ * @param more Request the following blocks of the payload set as well
+ * @param block_size Size of the blocks
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_append_q_block2_option(struct coap_packet *cpkt, uint32_t block_number, bool more,
+				enum coap_block_size block_size);
+
 /**
  * @brief Retrieves BLOCK{1,2} and SIZE{1,2} from @a cpkt and updates
  * @a ctx accordingly.
@@ -33,7 +33,8 @@
  * This callback is called for responses to CoAP client requests.
  * It is used to indicate errors, response codes from server or to deliver payload.
  * Blockwise transfers cause this callback to be called sequentially with increasing payload offset
- * and only partial content in buffer pointed by payload parameter.
+ * and only partial content in buffer pointed by payload parameter. With Q-Block2 transfers the
+ * blocks are passed on as they arrive, so the offset may jump back to fill in a recovered block.
  *
  * @param result_code Result code of the response. Negative if there was a failure in send.
  *                    @ref coap_response_code for positive.
@@ -61,6 +62,12 @@ struct coap_client_request {
 	struct coap_client_option *options; /**< Extra options to be added to request */
 	uint8_t num_options;                /**< Number of extra options */
 	void *user_data;	            /**< User provided context */
+	/**
+	 * Receive the response with Q-Block2 (RFC 9177) if it spans several blocks. Needs
+	 * @kconfig{CONFIG_COAP_CLIENT_Q_BLOCK}, otherwise ignored. A server without support
+	 * answers with @ref COAP_RESPONSE_CODE_BAD_OPTION.
+	 */
+	bool q_block2;
 };
 
 /**
@@ -100,6 +107,14 @@ struct coap_client_internal_request {
 	/* For GETs with observe option set */
 	bool is_observe;
 	int last_response_id;
+
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+	/* Q-Block2 payload set being received */
+	uint32_t q_block_base;
+	uint32_t q_block_received;
+	int32_t q_block_last;
+	uint8_t q_block_retries;
+#endif
 };
 
 struct coap_client {
@@ -257,6 +257,13 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+#if defined(CONFIG_DNS_RESOLVER_QUERY_ALL_SERVERS)
+		/** Number of servers the query was sent to that have not
+		 * answered yet.
+		 */
+		uint8_t pending_servers;
+#endif
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -199,6 +199,20 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. The driver cuts the payload
+	 * of a TCP packet with a non-zero net_pkt_tso_mss() in segments of
+	 * that size, replicating and adjusting the IP and TCP headers, and
+	 * computes the checksums of each segment.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
+
+	/** Several RX DMA rings. The driver sets net_pkt_set_rx_hash() on
+	 * received packets to the ring index or to the flow hash computed by
+	 * the hardware, and reports the number of rings with
+	 * ETHERNET_CONFIG_TYPE_RX_QUEUES_NUM.
+	 */
+	ETHERNET_HW_RX_QUEUES		= BIT(22),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -218,6 +232,7 @@ enum ethernet_config_type {
 	ETHERNET_CONFIG_TYPE_PORTS_NUM,
 	ETHERNET_CONFIG_TYPE_T1S_PARAM,
 	ETHERNET_CONFIG_TYPE_TXINJECTION_MODE,
+	ETHERNET_CONFIG_TYPE_RX_QUEUES_NUM,
 };
 
 enum ethernet_qav_param_type {
@@ -370,6 +385,28 @@ struct ethernet_qbv_param {
 
 /** @cond INTERNAL_HIDDEN */
 
+#if defined(CONFIG_NET_ETHERNET_QBV_SW)
+/* One row of the software gate control list */
+struct ethernet_qbv_sw_entry {
+	/* Length of the row in nanoseconds */
+	uint32_t interval;
+	/* Open gates, one bit per traffic class */
+	uint8_t gates;
+};
+
+/* Software Qbv gate state of an interface whose MAC has no Qbv offload */
+struct ethernet_qbv_sw_context {
+	struct k_spinlock lock;
+	struct ethernet_qbv_sw_entry gcl[CONFIG_NET_ETHERNET_QBV_SW_MAX_GCL_LEN];
+	/* Schedule times in nanoseconds of the PTP clock */
+	uint64_t base_time;
+	uint64_t cycle_time;
+	uint32_t extension_time;
+	uint16_t gcl_len;
+	bool enabled;
+};
+#endif /* CONFIG_NET_ETHERNET_QBV_SW */
+
 enum ethernet_qbu_param_type {
 	ETHERNET_QBU_PARAM_TYPE_STATUS,
 	ETHERNET_QBU_PARAM_TYPE_RELEASE_ADVANCE,
@@ -490,6 +527,7 @@ struct ethernet_config {
 
 		int priority_queues_num;
 		int ports_num;
+		int rx_queues_num;
 
 		struct ethernet_filter filter;
 	};
@@ -626,6 +664,11 @@ struct ethernet_context {
 	struct eth_bridge_iface_context bridge;
 #endif
 
+#if defined(CONFIG_NET_ETHERNET_QBV_SW)
+	/** Software Qbv gate, used when the MAC does not support Qbv. */
+	struct ethernet_qbv_sw_context qbv;
+#endif
+
 	/** Carrier ON/OFF handler worker. This is used to create
 	 * network interface UP/DOWN event when ethernet L2 driver
 	 * notices carrier ON/OFF situation. We must not create another
@@ -8,6 +8,7 @@
 
 /*
  * Copyright (c) 2021 BayLibre SAS
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -29,12 +30,44 @@ extern "C" {
  * @{
  */
 
+struct net_if;
+
+/** Forwarding database entry */
+struct eth_bridge_fdb_entry {
+	/** Interface the address is reached through */
+	struct net_if *iface;
+	/** Uptime in milliseconds the address was last seen at */
+	uint32_t last_seen;
+	/** VLAN identifier, NET_VLAN_TAG_UNSPEC if untagged */
+	uint16_t vlan_tag;
+	/** MAC address */
+	uint8_t addr[6];
+	/** Entry in use */
+	bool used : 1;
+	/** Static entry, never aged nor moved by learning */
+	bool is_static : 1;
+};
+
+/** Forwarding database statistics */
+struct eth_bridge_fdb_stats {
+	/** Unicast frames forwarded to the single port known for them */
+	uint32_t hits;
+	/** Unicast frames flooded because their address was unknown */
+	uint32_t misses;
+	/** Addresses learned */
+	uint32_t learned;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 struct eth_bridge {
 	struct k_mutex lock;
 	sys_slist_t interfaces;
 	sys_slist_t listeners;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	struct eth_bridge_fdb_entry fdb[CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE];
+	struct eth_bridge_fdb_stats fdb_stats;
+#endif
 	bool initialized;
 };
 
@@ -184,6 +217,63 @@ typedef void (*eth_bridge_cb_t)(struct eth_bridge *br, void *user_data);
  */
 void net_eth_bridge_foreach(eth_bridge_cb_t cb, void *user_data);
 
+/**
+ * @brief Add a static entry to the forwarding database of a bridge
+ *
+ * Unicast frames to @p addr on VLAN @p vlan_tag are then only forwarded
+ * through @p iface. Static entries replace learned ones, and are neither
+ * aged nor moved by learning.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param addr MAC address
+ * @param vlan_tag VLAN identifier, NET_VLAN_TAG_UNSPEC if untagged
+ * @param iface Interface of the bridge to forward the frames to
+ *
+ * @return 0 if OK, -EINVAL if @p iface is not part of the bridge,
+ *         -ENOMEM if the database has no room left, -ENOTSUP if
+ *         CONFIG_NET_ETHERNET_BRIDGE_FDB is disabled.
+ */
+int eth_bridge_fdb_add(struct eth_bridge *br, const uint8_t *addr,
+		       uint16_t vlan_tag, struct net_if *iface);
+
+/**
+ * @brief Remove an entry from the forwarding database of a bridge
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param addr MAC address
+ * @param vlan_tag VLAN identifier, NET_VLAN_TAG_UNSPEC if untagged
+ *
+ * @return 0 if OK, -ENOENT if there is no such entry, -ENOTSUP if
+ *         CONFIG_NET_ETHERNET_BRIDGE_FDB is disabled.
+ */
+int eth_bridge_fdb_del(struct eth_bridge *br, const uint8_t *addr,
+		       uint16_t vlan_tag);
+
+/**
+ * @typedef eth_bridge_fdb_cb_t
+ * @brief Callback used while iterating over forwarding database entries
+ *
+ * @param br Pointer to bridge instance
+ * @param entry Forwarding database entry
+ * @param user_data User supplied data
+ */
+typedef void (*eth_bridge_fdb_cb_t)(struct eth_bridge *br,
+				    const struct eth_bridge_fdb_entry *entry,
+				    void *user_data);
+
+/**
+ * @brief Go through the entries of the forwarding database of a bridge
+ *
+ * Aged entries are skipped. The bridge is locked during the iteration, so
+ * the callback must not call other bridge functions.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param cb Callback to call for each entry
+ * @param user_data User supplied data
+ */
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data);
+
 /**
  * @}
  */
@@ -339,6 +339,60 @@ void gptp_clk_src_time_invoke(struct gptp_clk_src_time_invoke_params *arg);
  */
 struct gptp_hdr *gptp_get_hdr(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_GPTP_RX_DIRECT) || defined(__DOXYGEN__)
+/**
+ * @brief Pass a received PTP frame directly to gPTP.
+ *
+ * @details Meant for Ethernet drivers that recognize PTP frames in their RX
+ *          path. The frame skips the RX traffic class queues and the L2
+ *          dispatch. It must be untagged and still start with its Ethernet
+ *          header, with the receive time stamp already set. Must be called
+ *          from thread context.
+ *
+ * @param iface Network interface the frame was received on
+ * @param pkt Received frame, consumed if 0 is returned
+ *
+ * @return 0 if the frame was consumed, -ENETDOWN if the interface is down,
+ *         -EINVAL if it is not an untagged PTP frame.
+ */
+int gptp_recv_direct(struct net_if *iface, struct net_pkt *pkt);
+#endif /* CONFIG_NET_GPTP_RX_DIRECT */
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI) || defined(__DOXYGEN__)
+/**
+ * @brief Statistics of the local clock PI servo.
+ */
+struct gptp_servo_stats {
+	/** Last measured offset from the grandmaster in nanoseconds */
+	int64_t offset_ns;
+	/** Largest absolute offset seen while locked, in nanoseconds */
+	int64_t offset_max_ns;
+	/** Running average of the absolute offset while locked, in nanoseconds */
+	int64_t offset_avg_ns;
+	/** Frequency correction applied on top of the neighbor rate ratio, in ppb */
+	int32_t freq_ppb;
+	/** Number of offset samples the servo has run on */
+	uint32_t samples;
+	/** Number of times the clock was stepped instead */
+	uint32_t steps;
+};
+
+/**
+ * @brief Set the gains of the local clock PI servo.
+ *
+ * @param kp Proportional gain in thousandths
+ * @param ki Integral gain in thousandths
+ */
+void gptp_servo_set_gains(uint32_t kp, uint32_t ki);
+
+/**
+ * @brief Get the statistics of the local clock PI servo.
+ *
+ * @param stats Filled with the current statistics
+ */
+void gptp_servo_get_stats(struct gptp_servo_stats *stats);
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
 #ifdef __cplusplus
 }
 #endif
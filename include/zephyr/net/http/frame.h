@@ -57,6 +57,9 @@ enum http_frame_type {
 #define HTTP_SERVER_FRAME_FLAGS_OFFSET     4
 #define HTTP_SERVER_FRAME_STREAM_ID_OFFSET 5
 
+#define HTTP_SERVER_PRIORITY_PAYLOAD_SIZE  5
+#define HTTP_SERVER_PRIORITY_WEIGHT_OFFSET 4
+
 /** @endcond */
 
 /** HTTP2 settings field */
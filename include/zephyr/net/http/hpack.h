@@ -98,8 +98,61 @@ enum http_hpack_static_key {
 
 #if defined(CONFIG_HTTP_SERVER)
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE CONFIG_HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
 #else
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE 0
+#endif
+
+/** Size accounted for a dynamic table entry on top of its name and value. */
+#define HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD 32
+
+/** Initial dynamic table size of the peer, before SETTINGS_HEADER_TABLE_SIZE. */
+#define HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+/** HPACK dynamic table entry, the name is directly followed by the value. */
+struct http_hpack_dynamic_entry {
+	/** Offset of the entry in the table data. */
+	uint16_t offset;
+
+	/** Length of the header field name. */
+	uint16_t name_len;
+
+	/** Length of the header field value. */
+	uint16_t value_len;
+
+	/** Hash of the header field name, for faster lookup. */
+	uint16_t hash;
+};
+
+/** HPACK dynamic table (RFC 7541, ch. 2.3.2). */
+struct http_hpack_dynamic_table {
+	/** Table entries, oldest first. */
+	struct http_hpack_dynamic_entry entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE /
+						HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD];
+
+	/** Names and values of the entries, oldest first. */
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+
+	/** Number of entries. */
+	uint16_t count;
+
+	/** Length of the data used by the entries. */
+	uint16_t data_len;
+
+	/** Size of the entries as defined by RFC 7541. */
+	uint32_t size;
+
+	/** Maximum size in effect for the table. */
+	uint32_t max_size;
+
+	/** Upper bound of the maximum size, set by the decoder side. */
+	uint32_t limit;
+
+	/** Maximum size change to signal in the next header block. */
+	bool size_update;
+};
 #endif
 
 /** @endcond */
@@ -123,6 +176,14 @@ struct http_hpack_header_buf {
 
 	/** Length of the data in the decoding buffer. */
 	size_t datalen;
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	/** Dynamic table of the decoded header blocks. */
+	struct http_hpack_dynamic_table decoder_table;
+
+	/** Dynamic table of the encoded header blocks. */
+	struct http_hpack_dynamic_table encoder_table;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -131,6 +192,9 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen);
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 			      uint8_t *buf, size_t buflen);
+void http_hpack_init_dynamic_tables(struct http_hpack_header_buf *header);
+void http_hpack_set_peer_table_size(struct http_hpack_header_buf *header,
+				    uint32_t size);
 int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header);
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
@@ -266,6 +266,8 @@ enum http1_parser_state {
 };
 
 #define HTTP_SERVER_INITIAL_WINDOW_SIZE 65536
+#define HTTP_SERVER_PEER_INITIAL_WINDOW_SIZE 65535
+#define HTTP_SERVER_DEFAULT_STREAM_WEIGHT 15
 #define HTTP_SERVER_WS_MAX_SEC_KEY_LEN 32
 
 /** @endcond */
@@ -275,6 +277,13 @@ struct http_stream_ctx {
 	int stream_id; /**< Stream identifier. */
 	enum http_stream_state stream_state; /**< Stream state. */
 	int window_size; /**< Stream-level window size. */
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	const char *tx_data; /**< Response body left to send, NULL if none. */
+	size_t tx_len; /**< Length of the response body left to send. */
+	int tx_window; /**< Stream-level window granted by the client. */
+	int tx_credit; /**< Weighted round robin scheduler credit. */
+	uint8_t weight; /**< Priority weight minus one, as sent by the client. */
+#endif
 };
 
 /** @brief HTTP/2 frame representation. */
@@ -305,6 +314,14 @@ struct http_client_ctx {
 	/** Connection-level window size. */
 	int window_size;
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	/** Connection-level window granted by the client. */
+	int tx_window;
+
+	/** Initial stream-level window granted by the client. */
+	int tx_initial_window;
+#endif
+
 	/** Server state for the associated client. */
 	enum http_server_state server_state;
 
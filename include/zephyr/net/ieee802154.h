@@ -194,6 +194,9 @@ struct ieee802154_security_ctx {
 	/** @cond INTERNAL_HIDDEN */
 	struct cipher_ctx enc;
 	struct cipher_ctx dec;
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	atomic_t pending_ops;
+#endif
 	/** INTERNAL_HIDDEN @endcond */
 
 	/**
@@ -248,6 +251,38 @@ enum ieee802154_device_role {
 	IEEE802154_DEVICE_ROLE_PAN_COORDINATOR, /**< PAN coordinator */
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+/* FCF and sequence number, destination PAN ID and extended address, extended
+ * source address and auxiliary security header in implicit key mode.
+ */
+#define IEEE802154_HDR_TEMPLATE_MAX_LEN (3 + 2 + 2 * IEEE802154_EXT_ADDR_LENGTH + 5)
+
+/* Serialized MAC header of the data frames sent to a given destination. */
+struct ieee802154_hdr_template {
+	uint8_t dst_addr[IEEE802154_MAX_ADDR_LENGTH]; /* in big endian */
+	uint8_t dst_len; /* zero for broadcast */
+	uint8_t src_len;
+	uint8_t hdr[IEEE802154_HDR_TEMPLATE_MAX_LEN];
+	uint8_t hdr_len;
+	uint8_t frame_counter; /* offset of the frame counter, zero if unsecured */
+	bool in_use;
+};
+
+struct ieee802154_arbiter;
+
+/* Membership of an interface in a radio arbiter, see
+ * ieee802154_arbiter_attach().
+ */
+struct ieee802154_arbiter_member {
+	sys_snode_t node;
+	struct ieee802154_arbiter *arbiter;
+	struct net_if *iface;
+	uint32_t latency_budget_ms;
+};
+
+/** INTERNAL_HIDDEN @endcond */
+
 /** IEEE 802.15.4 L2 context. */
 struct ieee802154_context {
 	/**
@@ -313,6 +348,18 @@ struct ieee802154_context {
 	 */
 	struct k_sem scan_ctx_lock;
 
+	/**
+	 * Given on received beacons, finished energy detections and scan
+	 * cancellation to end the current channel dwell early.
+	 */
+	struct k_sem scan_event;
+
+	/** Result of the last energy detection in dBm, guarded by scan_event */
+	int16_t scan_max_ed;
+
+	/** Whether the ongoing scan is an energy scan, guarded by scan_ctx_lock */
+	bool scan_ed;
+
 	/**
 	 * @brief Coordinator extended address
 	 *
@@ -386,6 +433,23 @@ struct ieee802154_context {
 	/** ACK lock, guards ack_* fields */
 	struct k_sem ack_lock;
 
+#if CONFIG_NET_L2_IEEE802154_HEADER_TEMPLATES > 0
+	/** @cond INTERNAL_HIDDEN */
+	/* Data frame header templates, see ieee802154_hdr_templates_flush() */
+	struct ieee802154_hdr_template hdr_templates[CONFIG_NET_L2_IEEE802154_HEADER_TEMPLATES];
+
+	/* Next header template to be replaced */
+	uint8_t hdr_template_next;
+	/** INTERNAL_HIDDEN @endcond */
+#endif
+
+#ifdef CONFIG_NET_L2_IEEE802154_ARBITER
+	/** @cond INTERNAL_HIDDEN */
+	/* Radio arbiter membership, guarded by the arbiter's lock */
+	struct ieee802154_arbiter_member arbiter_member;
+	/** INTERNAL_HIDDEN @endcond */
+#endif
+
 	/**
 	 * @brief Context lock
 	 *
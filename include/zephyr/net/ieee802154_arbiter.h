@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 radio arbiter
+ *
+ * Some transceivers can serve several IEEE 802.15.4 interfaces, each with
+ * its own PAN, channel and addresses, but only one of them at a time. The
+ * driver of such a transceiver exposes one device per interface and
+ * attaches all of their interfaces to a common arbiter. The native L2 then
+ * obtains the radio from the arbiter before it transmits, scans or changes
+ * the radio settings of an interface, and restores the settings of the
+ * interface whenever it takes the radio over from another one.
+ *
+ * Interfaces waiting for the radio are served earliest deadline first, the
+ * deadline of a request being the time it was made plus the latency budget
+ * of its interface.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_IEEE802154_ARBITER_H_
+#define ZEPHYR_INCLUDE_NET_IEEE802154_ARBITER_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ieee802154_arbiter IEEE 802.15.4 radio arbiter
+ * @since 3.7
+ * @version 0.1.0
+ * @ingroup ieee802154
+ * @{
+ */
+
+/**
+ * @brief Radio arbiter
+ *
+ * One arbiter per shared transceiver. Arbiters must be zero-initialized,
+ * e.g. by being statically allocated, before the first interface is
+ * attached.
+ */
+struct ieee802154_arbiter {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_spinlock lock;
+	sys_slist_t members;
+	sys_dlist_t waiters;
+	struct net_if *owner;
+	struct net_if *configured;
+	struct k_work_delayable rx_slot;
+	uint8_t depth;
+	bool initialized;
+	/** INTERNAL_HIDDEN @endcond */
+};
+
+/**
+ * @brief Attach an interface to a radio arbiter.
+ *
+ * To be called by drivers from their interface initialization, after
+ * ieee802154_init().
+ *
+ * @param arbiter Arbiter of the transceiver of the interface
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param latency_budget_ms Time within which the interface should get the
+ *        radio once it asked for it
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if the interface already is attached to an arbiter
+ */
+int ieee802154_arbiter_attach(struct ieee802154_arbiter *arbiter, struct net_if *iface,
+			      uint32_t latency_budget_ms);
+
+/**
+ * @brief Detach an interface from its radio arbiter.
+ *
+ * The interface must not be using the radio.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ */
+void ieee802154_arbiter_detach(struct net_if *iface);
+
+/**
+ * @brief Get the interface the radio is currently configured for.
+ *
+ * Drivers deliver received frames to this interface, as the transceiver
+ * listens with its channel and address filters. May be called from ISRs.
+ *
+ * @param arbiter Arbiter of the transceiver
+ *
+ * @return the interface that used the radio last, or the first attached
+ *         interface if none did yet, NULL if no interface is attached
+ */
+struct net_if *ieee802154_arbiter_rx_iface(struct ieee802154_arbiter *arbiter);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_IEEE802154_ARBITER_H_ */
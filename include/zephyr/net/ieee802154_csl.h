@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 CSL (Coordinated Sampled Listening)
+ *
+ * A CSL receiver keeps its radio off most of the time and only samples
+ * the channel once per CSL period. It advertises the time to its next
+ * channel sample (the CSL phase) and the CSL period in CSL IEs. A CSL
+ * transmitter that learned both from a frame or an enhanced ACK of the
+ * receiver sends its unicast frames right into the receiver's channel
+ * samples.
+ *
+ * CSL periods and phases are given in units of 10 symbol periods.
+ *
+ * All references to the standard in this file cite IEEE 802.15.4-2020.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_IEEE802154_CSL_H_
+#define ZEPHYR_INCLUDE_NET_IEEE802154_CSL_H_
+
+#include <zephyr/net/net_if.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ieee802154_csl IEEE 802.15.4 CSL
+ * @since 3.7
+ * @version 0.1.0
+ * @ingroup ieee802154
+ * @{
+ */
+
+/**
+ * @brief Start sampling the channel as CSL receiver, see section 6.12.2.
+ *
+ * The CSL IE of outgoing enhanced ACKs and the channel samples are
+ * offloaded to the driver with @ref IEEE802154_CONFIG_ENH_ACK_HEADER_IE,
+ * @ref IEEE802154_CONFIG_EXPECTED_RX_TIME, @ref
+ * IEEE802154_CONFIG_CSL_PERIOD and @ref IEEE802154_CONFIG_RX_SLOT. The
+ * radio is off in between channel samples.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param period CSL period (macCslPeriod) in units of 10 symbol periods
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the period is zero
+ * @retval -ENOTSUP if the driver lacks timed RX or CSL support
+ * @retval -EALREADY if the CSL receiver is already running
+ * @retval -EBUSY if another interface runs the CSL receiver
+ */
+int ieee802154_csl_receiver_start(struct net_if *iface, uint16_t period);
+
+/**
+ * @brief Stop sampling the channel and return to continuous reception.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if the CSL receiver is not running on this interface
+ */
+int ieee802154_csl_receiver_stop(struct net_if *iface);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_IEEE802154_CSL_H_ */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 indirect transmission
+ *
+ * A coordinator cannot send frames directly to children that switch their
+ * receiver off when idle (macRxOnWhenIdle FALSE). Frames to such sleepy
+ * children are kept by the coordinator until the child polls for them
+ * with a Data Request command. The coordinator signals pending frames
+ * with the Frame Pending field of the ACK to the Data Request command.
+ *
+ * All references to the standard in this file cite IEEE 802.15.4-2020.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_IEEE802154_INDIRECT_H_
+#define ZEPHYR_INCLUDE_NET_IEEE802154_INDIRECT_H_
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_linkaddr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ieee802154_indirect IEEE 802.15.4 indirect transmission
+ * @since 3.7
+ * @version 0.1.0
+ * @ingroup ieee802154
+ * @{
+ */
+
+/**
+ * @brief Register a sleepy child, see section 6.7.3.
+ *
+ * Subsequent frames to @p addr are queued until the child polls for
+ * them or the transaction persistence time expires. A child that uses
+ * both, a short and an extended address, must be registered with the
+ * address that frames to it and its Data Request commands carry.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param addr Short or extended address of the child, in big endian
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the address is neither short nor extended
+ * @retval -EALREADY if the child is already registered
+ * @retval -ENOMEM if the table of sleepy children is full
+ */
+int ieee802154_indirect_child_add(struct net_if *iface, const struct net_linkaddr *addr);
+
+/**
+ * @brief Unregister a sleepy child and drop the frames queued for it.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param addr Short or extended address of the child, in big endian
+ *
+ * @retval 0 on success
+ * @retval -ENOENT if the child is not registered
+ */
+int ieee802154_indirect_child_remove(struct net_if *iface, const struct net_linkaddr *addr);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_IEEE802154_INDIRECT_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 link quality estimation
+ *
+ * The native IEEE 802.15.4 L2 keeps statistics of the clear channel
+ * assessments (CCA) of its CSMA-CA channel access per channel, and an
+ * expected transmission count (ETX) per neighbor. The ETX is estimated
+ * from the transmission attempts of frames requesting an ACK, so it
+ * only exists for neighbors that unicast frames were sent to.
+ *
+ * Both estimates are exponentially weighted moving averages, so they
+ * follow changes of the channel load and of the links within a few
+ * dozen frames.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_IEEE802154_LINK_QUALITY_H_
+#define ZEPHYR_INCLUDE_NET_IEEE802154_LINK_QUALITY_H_
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_linkaddr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ieee802154_link_quality IEEE 802.15.4 link quality estimation
+ * @since 3.7
+ * @version 0.1.0
+ * @ingroup ieee802154
+ * @{
+ */
+
+/** ETX values are given in units of 1/IEEE802154_ETX_DIVISOR transmissions. */
+#define IEEE802154_ETX_DIVISOR 128U
+
+/** Busy ratios are given in units of 1/IEEE802154_BUSY_DIVISOR. */
+#define IEEE802154_BUSY_DIVISOR 256U
+
+/** Link quality estimate of a neighbor */
+struct ieee802154_neighbor_quality {
+	/** Short or extended address of the neighbor, in big endian */
+	uint8_t addr[IEEE802154_MAX_ADDR_LENGTH];
+	/** Length of @ref addr */
+	uint8_t addr_len;
+	/** Expected transmission count, see @ref IEEE802154_ETX_DIVISOR */
+	uint16_t etx;
+	/** Frames sent to the neighbor with an ACK requested */
+	uint32_t tx;
+	/** Frames not acknowledged after all retransmissions */
+	uint32_t tx_failed;
+};
+
+/** Clear channel assessment statistics of a channel */
+struct ieee802154_channel_quality {
+	/** Channel number */
+	uint16_t channel;
+	/** Share of busy clear channel assessments, see @ref IEEE802154_BUSY_DIVISOR */
+	uint16_t busy;
+	/** Clear channel assessments */
+	uint32_t cca;
+	/** Clear channel assessments that found the channel busy */
+	uint32_t cca_busy;
+	/** Channel access failures after macMaxCSMABackoffs backoffs */
+	uint32_t access_failed;
+};
+
+/**
+ * @brief Callback for @ref ieee802154_neighbor_quality_foreach.
+ *
+ * @param quality Link quality estimate of a neighbor
+ * @param user_data User data given to @ref ieee802154_neighbor_quality_foreach
+ */
+typedef void (*ieee802154_neighbor_quality_cb_t)(
+	const struct ieee802154_neighbor_quality *quality, void *user_data);
+
+/**
+ * @brief Callback for @ref ieee802154_channel_quality_foreach.
+ *
+ * @param quality Clear channel assessment statistics of a channel
+ * @param user_data User data given to @ref ieee802154_channel_quality_foreach
+ */
+typedef void (*ieee802154_channel_quality_cb_t)(
+	const struct ieee802154_channel_quality *quality, void *user_data);
+
+/**
+ * @brief Get the link quality estimate of a neighbor.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param addr Short or extended address of the neighbor, in big endian
+ * @param quality Filled with the link quality estimate
+ *
+ * @retval 0 on success
+ * @retval -ENOENT if no frame requesting an ACK was sent to the neighbor
+ *         or the neighbor has been forgotten
+ */
+int ieee802154_neighbor_quality_get(struct net_if *iface, const struct net_linkaddr *addr,
+				    struct ieee802154_neighbor_quality *quality);
+
+/**
+ * @brief Call a callback for the link quality estimate of each neighbor.
+ *
+ * The callback is given a copy of the estimate and may call into the L2.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param cb Callback
+ * @param user_data User data passed to @p cb
+ */
+void ieee802154_neighbor_quality_foreach(struct net_if *iface,
+					 ieee802154_neighbor_quality_cb_t cb, void *user_data);
+
+/**
+ * @brief Call a callback for the statistics of each channel.
+ *
+ * The callback is given a copy of the statistics and may call into the
+ * L2.
+ *
+ * @param iface A valid pointer on an IEEE 802.15.4 network interface
+ * @param cb Callback
+ * @param user_data User data passed to @p cb
+ */
+void ieee802154_channel_quality_foreach(struct net_if *iface,
+					ieee802154_channel_quality_cb_t cb, void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_IEEE802154_LINK_QUALITY_H_ */
@@ -72,6 +72,7 @@ enum net_request_ieee802154_cmd {
 	NET_REQUEST_IEEE802154_CMD_SET_TX_POWER,
 	NET_REQUEST_IEEE802154_CMD_SET_SECURITY_SETTINGS,
 	NET_REQUEST_IEEE802154_CMD_GET_SECURITY_SETTINGS,
+	NET_REQUEST_IEEE802154_CMD_ENERGY_SCAN,
 };
 
 /**
@@ -138,6 +139,17 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_IEEE802154_PASSIVE_SCAN);
 
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_IEEE802154_ACTIVE_SCAN);
 
+/**
+ * MLME-SCAN(ED, ...) request
+ *
+ * Requires a driver with the @ref IEEE802154_HW_ENERGY_SCAN capability. See
+ * @ref ieee802154_req_params for associated command parameters.
+ */
+#define NET_REQUEST_IEEE802154_ENERGY_SCAN                                                         \
+	(_NET_IEEE802154_BASE | NET_REQUEST_IEEE802154_CMD_ENERGY_SCAN)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_IEEE802154_ENERGY_SCAN);
+
 /** Cancels an ongoing MLME-SCAN(...) command (non-standard). */
 #define NET_REQUEST_IEEE802154_CANCEL_SCAN                                                         \
 	(_NET_IEEE802154_BASE | NET_REQUEST_IEEE802154_CMD_CANCEL_SCAN)
@@ -276,8 +288,13 @@ enum net_event_ieee802154_cmd {
  */
 
 /**
- * Signals the result of the @ref NET_REQUEST_IEEE802154_ACTIVE_SCAN or @ref
- * NET_REQUEST_IEEE802154_PASSIVE_SCAN net management commands.
+ * Signals the result of the @ref NET_REQUEST_IEEE802154_ACTIVE_SCAN, @ref
+ * NET_REQUEST_IEEE802154_PASSIVE_SCAN or @ref
+ * NET_REQUEST_IEEE802154_ENERGY_SCAN net management commands.
+ *
+ * Results are signaled while the scan is running: once per received beacon
+ * for active and passive scans and once per scanned channel for energy
+ * scans.
  *
  * See @ref ieee802154_req_params for associated event parameters.
  */
@@ -330,6 +347,9 @@ struct ieee802154_req_params {
 	uint8_t len;
 	/** Link quality information, between 0 and 255 */
 	uint8_t lqi;
+
+	/** Maximum energy detected on the channel in dBm, energy scans only */
+	int16_t energy_level;
 };
 
 /**
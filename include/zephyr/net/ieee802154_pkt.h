@@ -58,6 +58,21 @@ struct net_pkt_cb_ieee802154 {
 			 * value is not available for this packet.
 			 */
 			uint8_t rssi;
+
+			/* Offsets into the frame of the MAC header fields and
+			 * the payload, as parsed by the L2 (see
+			 * ieee802154_parse_frame()). Zero if a field is absent.
+			 * Only valid as long as mpdu_parsed is set.
+			 */
+			struct {
+				uint8_t dst_addr;
+				uint8_t src_addr;
+				uint8_t aux_sec;
+				uint8_t header_ie;
+				uint8_t header_ie_length;
+				uint8_t payload;
+				uint8_t payload_length;
+			} mpdu;
 		};
 	};
 
@@ -72,6 +87,13 @@ struct net_pkt_cb_ieee802154 {
 				    * it requires further modifications,
 				    * e.g. Frame Counter injection.
 				    */
+	uint8_t rx_l2_done : 1;	   /* RX frame has been unsecured and
+				    * processed by the L2 outside of
+				    * the RX path already.
+				    */
+	uint8_t mpdu_parsed : 1;   /* RX frame's MPDU offsets are valid
+				    * and match the packet's data.
+				    */
 #if defined(CONFIG_NET_L2_OPENTHREAD)
 	uint8_t ack_seb : 1; /* Security Enabled Bit was set in the ACK */
 #endif
@@ -199,6 +221,26 @@ static inline void net_pkt_set_ieee802154_frame_secured(struct net_pkt *pkt, boo
 	net_pkt_cb_ieee802154(pkt)->frame_secured = secured;
 }
 
+static inline bool net_pkt_ieee802154_rx_l2_done(struct net_pkt *pkt)
+{
+	return net_pkt_cb_ieee802154(pkt)->rx_l2_done;
+}
+
+static inline void net_pkt_set_ieee802154_rx_l2_done(struct net_pkt *pkt, bool done)
+{
+	net_pkt_cb_ieee802154(pkt)->rx_l2_done = done;
+}
+
+static inline bool net_pkt_ieee802154_mpdu_parsed(struct net_pkt *pkt)
+{
+	return net_pkt_cb_ieee802154(pkt)->mpdu_parsed;
+}
+
+static inline void net_pkt_set_ieee802154_mpdu_parsed(struct net_pkt *pkt, bool parsed)
+{
+	net_pkt_cb_ieee802154(pkt)->mpdu_parsed = parsed;
+}
+
 static inline bool net_pkt_ieee802154_mac_hdr_rdy(struct net_pkt *pkt)
 {
 	return net_pkt_cb_ieee802154(pkt)->mac_hdr_rdy;
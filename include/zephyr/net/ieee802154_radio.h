@@ -554,6 +554,13 @@ enum ieee802154_event {
 	 * being configured.
 	 */
 	IEEE802154_EVENT_RX_OFF,
+	/**
+	 * A frame of a batch submitted through @ref
+	 * ieee802154_radio_api::tx_batch has completed. The event parameter
+	 * points to the corresponding @ref ieee802154_tx_frame whose status
+	 * has already been set.
+	 */
+	IEEE802154_EVENT_TX_DONE,
 };
 
 /** RX failed event reasons, see @ref IEEE802154_EVENT_RX_FAILED */
@@ -645,6 +652,31 @@ enum ieee802154_tx_mode {
 	IEEE802154_TX_MODE_PRIV_START = IEEE802154_TX_MODE_COMMON_COUNT,
 };
 
+/** Frame descriptor, see @ref ieee802154_radio_api::tx_batch */
+struct ieee802154_tx_frame {
+	/** Network packet the frame belongs to, MAY be shared by several frames. */
+	struct net_pkt *pkt;
+
+	/** Network buffer containing a single fragment with the frame data. */
+	struct net_buf *frag;
+
+	/**
+	 * Transmission time of the frame, see @ref net_time_t. Only used by
+	 * the timed TX modes, overrides the timestamp of the packet.
+	 */
+	net_time_t txtime;
+
+	/** The transmission mode of the frame. */
+	enum ieee802154_tx_mode mode;
+
+	/**
+	 * Result of the transmission, set by the driver once the frame has
+	 * completed. Takes the same values as returned by @ref
+	 * ieee802154_radio_api::tx.
+	 */
+	int status;
+};
+
 /** IEEE 802.15.4 Frame Pending Bit table address matching mode. */
 enum ieee802154_fpb_mode {
 	/** The pending bit shall be set only for addresses found in the list. */
@@ -1884,6 +1916,35 @@ struct ieee802154_radio_api {
 	int (*attr_get)(const struct device *dev,
 			enum ieee802154_attr attr,
 			struct ieee802154_attr_value *value);
+
+	/**
+	 * @brief Transmit a batch of frames.
+	 *
+	 * @details Optional. Drivers that can queue frames SHALL transmit the
+	 * given frames in order, preparing the next frame while the previous
+	 * one is still on air. Each frame is processed as if it had been
+	 * passed to `tx()` with its own mode and timing and the result is
+	 * stored in its status field. The driver SHALL report the completion
+	 * of each frame through @ref IEEE802154_EVENT_TX_DONE if an event
+	 * handler has been configured. Transmission stops at the first frame
+	 * that fails, the remaining frames are left untouched.
+	 *
+	 * The same ownership rules as for `tx()` apply to all packets and
+	 * buffers of the batch.
+	 *
+	 * @note Implementations MAY **sleep** and will usually NOT be
+	 * **isr-ok**. SHALL return `-ENETDOWN` unless the interface is "UP".
+	 *
+	 * @param dev pointer to IEEE 802.15.4 driver device
+	 * @param frames array of frame descriptors
+	 * @param count number of frames in the array
+	 *
+	 * @return the number of frames transmitted successfully, which is
+	 * less than @p count if a frame failed, or a negative errno code if
+	 * the batch could not be started at all.
+	 */
+	int (*tx_batch)(const struct device *dev, struct ieee802154_tx_frame *frames,
+			size_t count);
 };
 
 /* Make sure that the network interface API is properly setup inside
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 TSCH (Time-Slotted Channel Hopping) MAC
+ *
+ * The TSCH MAC replaces contention based channel access by a schedule
+ * that is shared by all devices of the network. Time is divided into
+ * timeslots which are counted by the Absolute Slot Number (ASN) and
+ * grouped into repeating slotframes. Links assign a timeslot and a
+ * channel offset within a slotframe to a neighbor. The channel used in
+ * a given timeslot is derived from the ASN, the channel offset and the
+ * hopping sequence.
+ *
+ * All references to the standard in this file cite IEEE 802.15.4-2020.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_IEEE802154_TSCH_H_
+#define ZEPHYR_INCLUDE_NET_IEEE802154_TSCH_H_
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ieee802154_tsch IEEE 802.15.4 TSCH MAC
+ * @since 3.7
+ * @version 0.1.0
+ * @ingroup ieee802154
+ * @{
+ */
+
+/** Link options, see section 7.4.4.3, table 7-51. */
+enum ieee802154_tsch_link_option {
+	/** The link may be used to transmit frames. */
+	IEEE802154_TSCH_LINK_OPTION_TX = BIT(0),
+	/** The link is used to receive frames. */
+	IEEE802154_TSCH_LINK_OPTION_RX = BIT(1),
+	/** The link is shared, transmissions use the TSCH CSMA-CA backoff. */
+	IEEE802154_TSCH_LINK_OPTION_SHARED = BIT(2),
+	/** Frames received on this link are used for time synchronization. */
+	IEEE802154_TSCH_LINK_OPTION_TIMEKEEPING = BIT(3),
+};
+
+/** Link types, see section 8.4.3.3.3, table 8-96, macLinkType. */
+enum ieee802154_tsch_link_type {
+	/** Link used for data and command frames */
+	IEEE802154_TSCH_LINK_NORMAL,
+	/** Link additionally used to send Enhanced Beacons */
+	IEEE802154_TSCH_LINK_ADVERTISING,
+};
+
+/** TSCH link, see section 8.4.3.3.3, table 8-96. */
+struct ieee802154_tsch_link {
+	/** Link handle, unique on the interface (macLinkHandle) */
+	uint16_t handle;
+
+	/** Timeslot of the link within its slotframe (macTimeslot) */
+	uint16_t timeslot;
+
+	/** Channel offset of the link (macChannelOffset) */
+	uint16_t channel_offset;
+
+	/** Handle of the slotframe the link belongs to (slotframeHandle) */
+	uint8_t slotframe_handle;
+
+	/** Combination of @ref ieee802154_tsch_link_option (macLinkOptions) */
+	uint8_t options;
+
+	/** One of @ref ieee802154_tsch_link_type (macLinkType) */
+	uint8_t type;
+
+	/**
+	 * Length of the neighbor address (macNodeAddress): zero for a link
+	 * shared with all neighbors, two for a short address or eight for an
+	 * extended address.
+	 */
+	uint8_t node_addr_len;
+
+	/** Neighbor address, in big endian */
+	uint8_t node_addr[IEEE802154_MAX_ADDR_LENGTH];
+};
+
+/**
+ * @brief Add a slotframe, see section 8.2.19.3, MLME-SET-SLOTFRAME.request.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ * @param handle Slotframe handle, also defines the priority of the
+ *        slotframe: links of lower handles take precedence.
+ * @param size Number of timeslots in the slotframe
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @p size is zero
+ * @retval -EEXIST if a slotframe with the same handle exists
+ * @retval -ENOMEM if the slotframe table is full
+ */
+int ieee802154_tsch_slotframe_add(struct net_if *iface, uint8_t handle, uint16_t size);
+
+/**
+ * @brief Remove a slotframe and all of its links.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ * @param handle Slotframe handle
+ *
+ * @retval 0 on success
+ * @retval -ENOENT if there is no such slotframe
+ */
+int ieee802154_tsch_slotframe_remove(struct net_if *iface, uint8_t handle);
+
+/**
+ * @brief Add a link, see section 8.2.19.4, MLME-SET-LINK.request.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ * @param link Link to be added, copied into the link table
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the link parameters are invalid
+ * @retval -ENOENT if the slotframe of the link does not exist
+ * @retval -EEXIST if a link with the same handle exists
+ * @retval -ENOMEM if the link table is full
+ */
+int ieee802154_tsch_link_add(struct net_if *iface, const struct ieee802154_tsch_link *link);
+
+/**
+ * @brief Remove a link.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ * @param handle Link handle
+ *
+ * @retval 0 on success
+ * @retval -ENOENT if there is no such link
+ */
+int ieee802154_tsch_link_remove(struct net_if *iface, uint16_t handle);
+
+/**
+ * @brief Set the hopping sequence, see section 8.4.3.4, table 8-100,
+ * macHoppingSequenceList.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ * @param channels Channel list, the channels must be valid for the
+ *        current channel page.
+ * @param len Number of channels in the list
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the list is empty or too long
+ * @retval -EBUSY if TSCH mode is active
+ */
+int ieee802154_tsch_set_hopping_sequence(struct net_if *iface, const uint16_t *channels,
+					 uint8_t len);
+
+/**
+ * @brief Enter TSCH mode, see section 8.2.19.5, MLME-TSCH-MODE.request.
+ *
+ * A PAN coordinator starts the network at ASN zero and sends Enhanced
+ * Beacons on its advertising links. Any other device listens for an
+ * Enhanced Beacon to synchronize to, installs the links advertised in it
+ * and then follows the schedule.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ * @param coordinator true to start the network as PAN coordinator
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if the driver lacks the timed TX/RX and ACK offloading
+ *         capabilities required by TSCH
+ * @retval -EALREADY if TSCH mode is already active
+ */
+int ieee802154_tsch_start(struct net_if *iface, bool coordinator);
+
+/**
+ * @brief Leave TSCH mode.
+ *
+ * Pending transmissions fail with -ENETDOWN. The schedule is kept.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if TSCH mode is not active
+ */
+int ieee802154_tsch_stop(struct net_if *iface);
+
+/**
+ * @brief Check whether the interface is synchronized to a TSCH network.
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ *
+ * @return true if TSCH mode is active and synchronized
+ */
+bool ieee802154_tsch_is_synchronized(struct net_if *iface);
+
+/**
+ * @brief Get the current Absolute Slot Number (macAsn).
+ *
+ * @param iface A valid pointer on a TSCH network interface
+ *
+ * @return the ASN of the current or last timeslot, zero if not
+ *         synchronized
+ */
+uint64_t ieee802154_tsch_get_asn(struct net_if *iface);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_IEEE802154_TSCH_H_ */
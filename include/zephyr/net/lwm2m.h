@@ -171,6 +171,9 @@ struct lwm2m_ctx {
 	sys_slist_t queued_messages;
 #endif
 	sys_slist_t observer;
+	/* Observers with a pending notify event, min-heap on event time */
+	struct observe_node *notify_heap[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
+	uint16_t notify_heap_len;
 	/** @endcond */
 
 	/** A pointer to currently processed request, for internal LwM2M engine
@@ -485,6 +485,16 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	/** Internal. Length of the packets waiting in the batch buffer. */
+	uint32_t tx_batch_len;
+
+	/** Internal. Wall clock value (in milliseconds) when the first
+	 *  packet of the batch was queued.
+	 */
+	uint32_t tx_batch_start;
+#endif
 };
 
 /**
@@ -541,6 +551,16 @@ struct mqtt_client {
 	/** Size of transmit buffer. */
 	uint32_t tx_buf_size;
 
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	/** Buffer collecting QoS 0 publish messages sent in one transport
+	 *  write. NULL disables batching for the client.
+	 */
+	uint8_t *tx_batch_buf;
+
+	/** Size of the batch buffer. */
+	uint32_t tx_batch_buf_size;
+#endif
+
 	/** Keepalive interval for this client in seconds.
 	 *  Default is CONFIG_MQTT_KEEPALIVE.
 	 */
@@ -758,6 +778,21 @@ int mqtt_abort(struct mqtt_client *client);
  */
 int mqtt_live(struct mqtt_client *client);
 
+/**
+ * @brief API to send the publish messages batched on the client right away.
+ *
+ * QoS 0 publish messages are collected in the client's batch buffer when
+ * CONFIG_MQTT_LIB_TX_BATCH is enabled. They are sent along with the next
+ * other packet, by @ref mqtt_live once CONFIG_MQTT_LIB_TX_BATCH_LATENCY
+ * has passed, or by this function.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_flush(struct mqtt_client *client);
+
 /**
  * @brief Helper function to determine when next keep alive message should be
  *        sent. Can be used for instance as a source for `poll` timeout.
@@ -765,8 +800,9 @@ int mqtt_live(struct mqtt_client *client);
  * @param[in] client Client instance for which the procedure is requested.
  *
  * @return Time in milliseconds until next keep alive message is expected to
- *         be sent. Function will return -1 if keep alive messages are
- *         not enabled.
+ *         be sent, or until batched publish messages are due if that comes
+ *         first. Function will return -1 if keep alive messages are
+ *         not enabled and no publish message is batched.
  */
 int mqtt_keepalive_time_left(const struct mqtt_client *client);
 
@@ -7,6 +7,7 @@
 /*
  * Copyright (c) 2016 Intel Corporation
  * Copyright (c) 2021 Nordic Semiconductor
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -286,6 +287,31 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+	/** Packets whose buffers are lent out by zero-copy receives */
+	struct net_pkt *lent[CONFIG_NET_SOCKETS_ZEROCOPY_RX_MAX];
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_RX */
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Epoll registration notified of incoming data */
+	void *epoll_item;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	/** Receive ring of a packet socket, frames is NULL if unset */
+	struct {
+		struct k_mutex lock;
+		struct k_poll_signal signal;
+		uint8_t *frames;
+		uint32_t frame_size;
+		uint32_t frame_nr;
+		/** Next slot to fill */
+		uint32_t head;
+		/** Frames were dropped since the last one delivered */
+		bool losing;
+	} rx_ring;
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1147,6 +1173,31 @@ int net_context_send(struct net_context *context,
 		     k_timeout_t timeout,
 		     void *user_data);
 
+/**
+ * @brief Send network buffers to a TCP peer without copying them.
+ *
+ * @details The buffer chain is linked into the send queue of the
+ * connection, its data is not copied. The reference to @p buf is passed
+ * to the stack, which releases the buffers once the peer has
+ * acknowledged them. The caller-supplied callback is then called with
+ * the number of bytes sent, or with a negative errno if the connection
+ * is closed before. The callback runs in the TCP work queue or RX
+ * thread with the connection locked and must not block.
+ * Requires CONFIG_NET_TCP_ZEROCOPY_SEND.
+ *
+ * @param context The network context to use.
+ * @param buf The buffer chain to send
+ * @param cb Caller-supplied callback function.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return 0 if ok, -EAGAIN if the send window or the queue of pending
+ * buffers is full, < 0 if error
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 net_context_send_cb_t cb,
+			 void *user_data);
+
 /**
  * @brief Send data to a peer specified by address.
  *
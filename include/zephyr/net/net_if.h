@@ -257,6 +257,9 @@ enum net_if_flag {
 	/** Mutex locking on TX data path disabled on the interface. */
 	NET_IF_NO_TX_LOCK,
 
+	/** Received TCP segments are merged by generic receive offload. */
+	NET_IF_GRO,
+
 /** @cond INTERNAL_HIDDEN */
 	/* Total number of flags - must be at the end of the enum */
 	NET_IF_NUM_FLAGS
@@ -334,6 +337,9 @@ struct net_if_ipv6 {
 
 	/** IPv6 multicast hop limit */
 	uint8_t mcast_hop_limit;
+
+	/** Index of the unicast address found by the last lookup */
+	uint8_t unicast_last;
 };
 
 #if defined(CONFIG_NET_DHCPV6) && defined(CONFIG_NET_NATIVE_IPV6)
@@ -2786,6 +2792,92 @@ static inline bool net_if_is_carrier_ok(struct net_if *iface)
 	return net_if_flag_is_set(iface, NET_IF_LOWER_UP);
 }
 
+#if defined(CONFIG_NET_NAPI) || defined(__DOXYGEN__)
+
+struct net_napi;
+
+/**
+ * @typedef net_napi_poll_t
+ * @brief Driver callback that drains received frames in polled mode.
+ *
+ * @details The callback is run from the NAPI work queue. It should hand at
+ *          most @p budget frames to net_napi_receive() and return how many
+ *          it processed. If the receive ring was emptied, the driver calls
+ *          net_napi_complete() and re-enables its RX interrupt before
+ *          returning.
+ *
+ * @param napi NAPI context being polled
+ * @param budget Maximum number of frames to process in this run
+ *
+ * @return Number of frames processed.
+ */
+typedef int (*net_napi_poll_t)(struct net_napi *napi, int budget);
+
+/**
+ * @brief NAPI style polled receive context of a network driver.
+ *
+ * A driver embeds one of these per RX queue. On an RX interrupt it masks
+ * the interrupt and calls net_napi_schedule(); the poll callback then runs
+ * in thread context and the collected frames are passed to the stack as
+ * one batch, until the driver finds the ring empty and completes.
+ */
+struct net_napi {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	sys_slist_t batch;
+	net_napi_poll_t poll;
+	atomic_t flags;
+	uint16_t budget;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a NAPI context.
+ *
+ * @param napi NAPI context to initialize
+ * @param poll Driver poll callback
+ * @param budget Frames per poll run, 0 selects CONFIG_NET_NAPI_BUDGET
+ */
+void net_napi_init(struct net_napi *napi, net_napi_poll_t poll, uint16_t budget);
+
+/**
+ * @brief Schedule polling of a NAPI context.
+ *
+ * @details Can be called from an ISR. Scheduling an already scheduled
+ *          context has no effect, so the driver can call this on every RX
+ *          interrupt it takes before masking it.
+ *
+ * @param napi NAPI context to poll
+ *
+ * @return true if polling was scheduled, false if it already was.
+ */
+bool net_napi_schedule(struct net_napi *napi);
+
+/**
+ * @brief Queue a received frame from the poll callback.
+ *
+ * @details The frame is handed to net_recv_data() with the rest of the
+ *          batch once the poll callback returns. Can only be called from
+ *          the poll callback.
+ *
+ * @param napi NAPI context being polled
+ * @param pkt Received frame, the interface is taken from net_pkt_iface()
+ */
+void net_napi_receive(struct net_napi *napi, struct net_pkt *pkt);
+
+/**
+ * @brief Leave polled mode.
+ *
+ * @details Called by the driver once its receive ring is empty, before it
+ *          re-enables the RX interrupt. A later net_napi_schedule() starts
+ *          a new polling cycle.
+ *
+ * @param napi NAPI context being polled
+ */
+void net_napi_complete(struct net_napi *napi);
+
+#endif /* CONFIG_NET_NAPI */
+
 /**
  * @brief Mark interface as dormant. Dormant state indicates that the interface
  *        is not ready to pass packets yet, but is waiting for some event
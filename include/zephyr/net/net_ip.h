@@ -254,6 +254,12 @@ struct msghdr {
 	int           msg_flags;      /**< Flags on received message */
 };
 
+/** Message header of a batch of datagrams */
+struct mmsghdr {
+	struct msghdr msg_hdr;  /**< Message */
+	unsigned int  msg_len;  /**< Number of bytes sent or received */
+};
+
 /** Control message ancillary data */
 struct cmsghdr {
 	socklen_t cmsg_len;    /**< Number of bytes, including header */
@@ -164,7 +164,8 @@ struct net_mgmt_event_callback {
 	/** A mask of network events on which the above handler should be
 	 * called in case those events come. Such mask can be modified
 	 * whenever necessary by the owner, and thus will affect the handler
-	 * being called or not.
+	 * being called or not. If the layer or layer code of the mask are
+	 * changed, the callback must be added again.
 	 */
 	union {
 		/** A mask of network events on which the above handler should
@@ -262,6 +263,27 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb);
 #define net_mgmt_add_event_callback(...)
 #endif
 
+/**
+ * @brief Add a user callback called as soon as an event is notified
+ *
+ * The handler is called from the context notifying the event, instead of
+ * being called later from the network event thread. This is meant for
+ * lightweight handlers, for example updating a counter or waking up a
+ * thread, which then do not have to wait for the event queue. The handler
+ * must not block and must not call into the network stack, as it can be
+ * called with network stack locks held. The information attached to the
+ * event, if any, is only valid during the call.
+ *
+ * Such callbacks are deleted with net_mgmt_del_event_callback().
+ *
+ * @param cb A valid pointer on user's callback to add.
+ */
+#ifdef CONFIG_NET_MGMT_EVENT
+void net_mgmt_add_event_callback_direct(struct net_mgmt_event_callback *cb);
+#else
+#define net_mgmt_add_event_callback_direct(...)
+#endif
+
 /**
  * @brief Delete a user callback
  * @param cb A valid pointer on user's callback to delete.
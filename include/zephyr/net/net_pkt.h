@@ -95,6 +95,15 @@ struct net_pkt {
 	/** Allow placing the packet into sys_slist_t */
 	sys_snode_t next;
 #endif
+
+#if defined(CONFIG_NET_TC_TX_FQ)
+	/** Uptime in milliseconds when the packet was put into a TX flow queue */
+	uint32_t fq_time;
+#endif
+#if defined(CONFIG_NET_TC_RX_STEERING)
+	/** Flow hash used to select the RX queue of the packet */
+	uint32_t rx_hash;
+#endif
 #if defined(CONFIG_NET_ROUTING) || defined(CONFIG_NET_ETHERNET_BRIDGE)
 	struct net_if *orig_iface; /* Original network interface */
 #endif
@@ -197,6 +206,9 @@ struct net_pkt {
 				  */
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
+#endif
+#if defined(CONFIG_NET_TC_RX_STEERING)
+	uint8_t rx_hash_set : 1; /* The rx_hash has been set */
 #endif
 	/* bitfield byte alignment boundary */
 
@@ -270,6 +282,14 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TCP_TSO)
+	/* For an outgoing TCP super-segment, the segment size the driver
+	 * (or the software fallback in the L2) has to cut its payload in.
+	 * Zero for packets that are sent as they are.
+	 */
+	uint16_t tso_mss;
+#endif /* CONFIG_NET_TCP_TSO */
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 	/* TODO: Evolve this into a union of orthogonal
 	 *       control block declarations if further L2
@@ -983,6 +1003,31 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, uint16_t tci)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_TSO)
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	return pkt->tso_mss;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	pkt->tso_mss = mss;
+}
+#else
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(mss);
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP) || defined(CONFIG_NET_PKT_TXTIME)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
@@ -1034,6 +1079,51 @@ static inline void net_pkt_set_timestamp_ns(struct net_pkt *pkt, net_time_t time
 }
 #endif /* CONFIG_NET_PKT_TIMESTAMP || CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+static inline uint32_t net_pkt_fq_time(struct net_pkt *pkt)
+{
+	return pkt->fq_time;
+}
+
+static inline void net_pkt_set_fq_time(struct net_pkt *pkt, uint32_t fq_time)
+{
+	pkt->fq_time = fq_time;
+}
+#endif /* CONFIG_NET_TC_TX_FQ */
+
+#if defined(CONFIG_NET_TC_RX_STEERING)
+static inline bool net_pkt_rx_hash_set(struct net_pkt *pkt)
+{
+	return !!(pkt->rx_hash_set);
+}
+
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+#endif
+
+/**
+ * @brief Set the flow hash of a received packet.
+ *
+ * Drivers with several RX DMA rings or a hardware flow hash call this
+ * before net_recv_data(). Packets with the same hash are processed by
+ * the same RX thread, so the ring index can be used as well.
+ *
+ * @param pkt Network packet
+ * @param hash Flow hash
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+#if defined(CONFIG_NET_TC_RX_STEERING)
+	pkt->rx_hash = hash;
+	pkt->rx_hash_set = 1U;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+#endif
+}
+
 #if defined(CONFIG_NET_PKT_RXTIME_STATS) || defined(CONFIG_NET_PKT_TXTIME_STATS)
 static inline uint32_t net_pkt_create_time(struct net_pkt *pkt)
 {
@@ -163,6 +163,16 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of received TCP segments merged into a preceding one by
+	 * generic receive offload.
+	 */
+	net_stats_t gro_merged;
+
+	/** Number of packets made of merged TCP segments passed on by
+	 * generic receive offload.
+	 */
+	net_stats_t gro_flushed;
 };
 
 /**
@@ -196,6 +206,23 @@ struct net_stats_ipv6_nd {
 	net_stats_t sent;
 };
 
+/**
+ * @brief IPv6 Path MTU Discovery statistics
+ */
+struct net_stats_ipv6_pmtu {
+	/** Number of dropped IPv6 Packet Too Big messages. */
+	net_stats_t drop;
+
+	/** Number of received IPv6 Packet Too Big messages. */
+	net_stats_t recv;
+
+	/** Number of TCP connections whose MSS was lowered to the path MTU. */
+	net_stats_t mss_clamped;
+
+	/** Number of packets fragmented to fit the path MTU. */
+	net_stats_t fragmented;
+};
+
 /**
  * @brief IPv6 multicast listener daemon statistics
  */
@@ -302,6 +329,20 @@ struct net_stats_tc {
 };
 
 
+/**
+ * @brief TX fair queuing statistics
+ */
+struct net_stats_fq {
+	/** Number of times a flow queue became active */
+	net_stats_t new_flows;
+
+	/** Number of packets dropped by CoDel because of their queue delay */
+	net_stats_t aqm_drop;
+
+	/** Number of packets dropped because a traffic class byte limit was hit */
+	net_stats_t overlimit_drop;
+};
+
 /**
  * @brief Power management statistics
  */
@@ -363,6 +404,11 @@ struct net_stats {
 	struct net_stats_ipv6_nd ipv6_nd;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU)
+	/** IPv6 Path MTU Discovery statistics */
+	struct net_stats_ipv6_pmtu ipv6_pmtu;
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	/** IPv6 MLD statistics */
 	struct net_stats_ipv6_mld ipv6_mld;
@@ -378,6 +424,11 @@ struct net_stats {
 	struct net_stats_tc tc;
 #endif
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+	/** TX fair queuing statistics */
+	struct net_stats_fq fq;
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
@@ -648,6 +699,7 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_PPP,
 	NET_REQUEST_STATS_CMD_GET_PM,
 	NET_REQUEST_STATS_CMD_GET_WIFI,
+	NET_REQUEST_STATS_CMD_GET_IPV6_PMTU,
 };
 
 /** @endcond */
@@ -707,6 +759,16 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_ND);
 /** @endcond */
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU)
+/** Request IPv6 Path MTU Discovery statistics */
+#define NET_REQUEST_STATS_GET_IPV6_PMTU				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_IPV6_PMTU)
+
+/** @cond INTERNAL_HIDDEN */
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_PMTU);
+/** @endcond */
+#endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
+
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 /** Request ICMPv4 and ICMPv6 statistics */
 #define NET_REQUEST_STATS_GET_ICMP				\
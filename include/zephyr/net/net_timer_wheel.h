@@ -0,0 +1,164 @@
+/** @file
+ * @brief Network timer wheel
+ *
+ * Timeouts of many objects sharing a single delayable work item.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_NET_TIMER_WHEEL_H_
+#define ZEPHYR_INCLUDE_NET_NET_TIMER_WHEEL_H_
+
+/**
+ * @brief Network timer wheel
+ * @defgroup net_timer_wheel Network timer wheel
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdbool.h>
+#include <zephyr/types.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct net_timer_wheel_entry;
+
+/**
+ * @typedef net_timer_wheel_cb_t
+ * @brief Timer wheel entry expiry callback.
+ *
+ * @details Called from the system work queue, the entry may be added back
+ * to the wheel from the callback.
+ *
+ * @param entry The entry which timeout expired.
+ */
+typedef void (*net_timer_wheel_cb_t)(struct net_timer_wheel_entry *entry);
+
+/** Timeout in a timer wheel.
+ *
+ * Embed it in the object needing the timeout and use CONTAINER_OF() in
+ * the callback. All access must go through the defined API.
+ */
+struct net_timer_wheel_entry {
+	/** Link in the wheel slot, or in the list of expired entries */
+	sys_dnode_t node;
+
+	/** Wheel tick at which the timeout expires. */
+	uint32_t expiry;
+
+	/** Callback called on expiry. */
+	net_timer_wheel_cb_t cb;
+};
+
+/** Timer wheel.
+ *
+ * The entries are hashed in @kconfig{CONFIG_NET_TIMER_WHEEL_SLOTS} slots
+ * by their expiry tick, and a single delayable work item is scheduled at
+ * the first tick with a non empty slot. All the entries expired by then
+ * are handled in one work item run, and adding an entry only reschedules
+ * the work item if it expires before the tick already scheduled.
+ *
+ * Timeouts are rounded up to whole ticks. Timeouts longer than the wheel
+ * span, that is the tick times the number of slots, share the slots with
+ * the shorter ones and are skipped until their rotation.
+ */
+struct net_timer_wheel {
+	/** Work item handling the expired entries. */
+	struct k_work_delayable work;
+
+	/** Protects the slots and the counters. */
+	struct k_spinlock lock;
+
+	/** Entries, by expiry tick modulo the number of slots. */
+	sys_dlist_t slots[CONFIG_NET_TIMER_WHEEL_SLOTS];
+
+	/** First tick not yet handled. */
+	uint32_t tick;
+
+	/** Tick the work item is scheduled at, if scheduled. */
+	uint32_t next;
+
+	/** Whether the work item is scheduled. */
+	bool scheduled;
+
+	/** Tick duration in milliseconds. */
+	uint32_t tick_ms;
+
+	/** Number of entries in the slots. */
+	uint32_t count;
+};
+
+/** @brief Initialize a timer wheel.
+ *
+ * @param wheel a pointer to the timer wheel.
+ *
+ * @param tick_ms the tick duration in milliseconds, the granularity of the
+ * timeouts.
+ */
+void net_timer_wheel_init(struct net_timer_wheel *wheel, uint32_t tick_ms);
+
+/** @brief Initialize a timer wheel entry.
+ *
+ * @param entry a pointer to the entry.
+ *
+ * @param cb the callback called on expiry.
+ */
+void net_timer_wheel_entry_init(struct net_timer_wheel_entry *entry,
+				net_timer_wheel_cb_t cb);
+
+/** @brief Start, or restart, the timeout of an entry.
+ *
+ * For timeouts longer than NET_TIMEOUT_MAX_VALUE, use the delay returned
+ * by net_timeout_evaluate() and add the entry again from its callback until
+ * the net_timeout completes.
+ *
+ * @param wheel a pointer to the timer wheel.
+ *
+ * @param entry a pointer to the entry, pending in @p wheel or not pending.
+ *
+ * @param delay_ms the timeout in milliseconds, at most NET_TIMEOUT_MAX_VALUE.
+ */
+void net_timer_wheel_add(struct net_timer_wheel *wheel,
+			 struct net_timer_wheel_entry *entry,
+			 uint32_t delay_ms);
+
+/** @brief Cancel the timeout of an entry.
+ *
+ * The callback may still be called if the entry expired already and is
+ * being handled.
+ *
+ * @param wheel a pointer to the timer wheel.
+ *
+ * @param entry a pointer to the entry, pending in @p wheel or not pending.
+ */
+void net_timer_wheel_remove(struct net_timer_wheel *wheel,
+			    struct net_timer_wheel_entry *entry);
+
+/** @brief Check if the timeout of an entry is pending.
+ *
+ * @param entry a pointer to the entry.
+ *
+ * @return true if the entry is in a wheel, false otherwise.
+ */
+static inline bool net_timer_wheel_is_pending(const struct net_timer_wheel_entry *entry)
+{
+	return sys_dnode_is_linked(&entry->node);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_NET_TIMER_WHEEL_H_ */
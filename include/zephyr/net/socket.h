@@ -8,6 +8,7 @@
 /*
  * Copyright (c) 2017-2018 Linaro Limited
  * Copyright (c) 2021 Nordic Semiconductor
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -74,6 +75,12 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only block until the first datagram is received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
+/** zsock_recvmsg: lend the received network buffers instead of copying,
+ *  see @ref zsock_recv_release
+ */
+#define ZSOCK_MSG_ZEROCOPY 0x4000000
 /** @} */
 
 /**
@@ -522,6 +529,85 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send a batch of datagrams
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for a description. The datagrams are sent as with zsock_sendmsg(), but
+ * the socket is looked up and locked only once for the whole batch. If a
+ * datagram cannot be sent, the number of datagrams sent before it is
+ * returned and the error is only reported if it was the first one.
+ * @endrst
+ *
+ * @param sock Socket to send the datagrams to
+ * @param msgvec Datagrams to send, the number of bytes sent is stored in
+ *               the @p msg_len of each datagram sent
+ * @param vlen Number of datagrams in @p msgvec
+ * @param flags Flags, as with zsock_sendmsg()
+ *
+ * @return Number of datagrams sent, -1 with errno set otherwise
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive a batch of datagrams
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for a description. The datagrams are received as with zsock_recvmsg(),
+ * but the socket is looked up and locked only once for the whole batch.
+ * With ``ZSOCK_MSG_WAITFORONE``, only the first datagram is waited for and
+ * the ones already queued are returned with it. Unlike Linux, there is no
+ * timeout argument, the receive timeout of the socket applies to each
+ * datagram.
+ * @endrst
+ *
+ * @param sock Socket to receive the datagrams from
+ * @param msgvec Buffers for the datagrams, the number of bytes received is
+ *               stored in the @p msg_len of each datagram received
+ * @param vlen Number of datagrams in @p msgvec
+ * @param flags Flags, as with zsock_recvmsg(), and ``ZSOCK_MSG_WAITFORONE``
+ *
+ * @return Number of datagrams received, -1 with errno set otherwise
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Release buffers lent by a zero-copy receive
+ *
+ * @details
+ * With :kconfig:option:`CONFIG_NET_SOCKETS_ZEROCOPY_RX`, a
+ * @ref zsock_recvmsg call on a TCP or UDP socket with the
+ * @ref ZSOCK_MSG_ZEROCOPY flag does not copy any data.  Instead it
+ * sets the @p iov_base and @p iov_len of the first @p msg_iovlen
+ * entries of @p msg_iov to the received data in place, in the network
+ * buffers, and updates @p msg_iovlen to the number of entries used.
+ * The data of one datagram, or of one received TCP segment, is lent
+ * per call.  Datagrams that need more entries than provided are
+ * truncated as with a short buffer, while the rest of a TCP segment
+ * is returned by the next receive.  @ref ZSOCK_MSG_PEEK cannot be
+ * combined with @ref ZSOCK_MSG_ZEROCOPY.
+ *
+ * The buffers stay valid until they are handed back with this
+ * function, passing the same message, or until the socket is closed.
+ * @ref zsock_poll and other receive calls can be used as usual in the
+ * meantime.  Zero-copy receive is only available to supervisor
+ * threads.
+ *
+ * @param sock Socket the data was received from
+ * @param msg Message filled in by the zero-copy receive
+ *
+ * @return 0 on success, -1 with errno set otherwise
+ */
+int zsock_recv_release(int sock, const struct msghdr *msg);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -1058,6 +1144,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1194,6 +1282,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Name of the congestion control algorithm ("reno", "cubic", "bbr") */
+#define TCP_CONGESTION 5
 
 /** @} */
 
@@ -1317,6 +1407,56 @@ struct in6_pktinfo {
 #define IPV6_TCLASS 67
 /** @} */
 
+/**
+ * @name Packet socket level options (SOL_PACKET)
+ * @{
+ */
+/** Packet socket level option */
+#define SOL_PACKET 263
+
+/* Socket options for SOL_PACKET level */
+
+/** Deliver received frames into a ring of frame slots, see packet_rx_ring */
+#define PACKET_RX_RING 5
+
+/** Slot is owned by the stack and can be filled */
+#define TP_STATUS_KERNEL 0
+/** Slot holds a received frame, owned by the application until it sets
+ *  the status back to TP_STATUS_KERNEL
+ */
+#define TP_STATUS_USER   BIT(0)
+/** Frame was truncated to the slot size, snaplen is smaller than len */
+#define TP_STATUS_COPY   BIT(1)
+/** Frames were dropped because the ring was full */
+#define TP_STATUS_LOSING BIT(2)
+
+/**
+ * @brief Receive ring of a packet socket, set with PACKET_RX_RING.
+ *
+ * There is no mmap(), so the application provides the memory of the ring.
+ * It holds @a frame_nr slots of @a frame_size bytes, filled in order. Each
+ * slot starts with a struct packet_rx_frame followed by the frame data.
+ * Frames delivered to the ring are not returned by recv(). Setting
+ * @a frames to NULL releases the ring.
+ */
+struct packet_rx_ring {
+	void *frames;            /**< Memory of the slots, 4 byte aligned */
+	unsigned int frame_size; /**< Slot size, a multiple of 4 bytes */
+	unsigned int frame_nr;   /**< Number of slots */
+};
+
+/** @brief Header of a slot of a packet socket receive ring. */
+struct packet_rx_frame {
+	uint32_t status;  /**< TP_STATUS_* flags */
+	uint32_t len;     /**< Length of the received frame */
+	uint32_t snaplen; /**< Length of the data copied into the slot */
+	int ifindex;      /**< Receiving interface index */
+};
+
+/** Data of a receive ring slot */
+#define PACKET_RX_FRAME_DATA(frame) ((uint8_t *)(frame) + sizeof(struct packet_rx_frame))
+/** @} */
+
 /**
  * @name Backlog size for listen()
  * @{
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file socket_epoll.h
+ *
+ * @brief BSD epoll-like socket readiness API.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/toolchain.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Options for zsock_epoll_ctl()
+ * @{
+ */
+/** Register the file descriptor */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Unregister the file descriptor */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events of a registered file descriptor */
+#define ZSOCK_EPOLL_CTL_MOD 3
+/** @} */
+
+/**
+ * @name Event flags of struct zsock_epoll_event
+ * @{
+ */
+/** Data available for reading, same value as @ref ZSOCK_POLLIN */
+#define ZSOCK_EPOLLIN 0x001
+/** Priority data available, same value as @ref ZSOCK_POLLPRI */
+#define ZSOCK_EPOLLPRI 0x002
+/** Writing is possible, same value as @ref ZSOCK_POLLOUT */
+#define ZSOCK_EPOLLOUT 0x004
+/** Error condition (output value only), same value as @ref ZSOCK_POLLERR */
+#define ZSOCK_EPOLLERR 0x008
+/** Connection closed (output value only), same value as @ref ZSOCK_POLLHUP */
+#define ZSOCK_EPOLLHUP 0x010
+/** Disable the registration once it has been reported */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** Edge-triggered notification */
+#define ZSOCK_EPOLLET BIT(31)
+/** @} */
+
+/** User data returned with an event */
+typedef union zsock_epoll_data {
+	void *ptr;     /**< Pointer */
+	int fd;        /**< File descriptor */
+	uint32_t u32;  /**< 32-bit value */
+	uint64_t u64;  /**< 64-bit value */
+} zsock_epoll_data_t;
+
+/** Registered or reported event */
+struct zsock_epoll_event {
+	uint32_t events;         /**< Event flags */
+	zsock_epoll_data_t data; /**< User data */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_create.2.html>`__
+ * for a description. Unlike zsock_poll(), the file descriptors of interest
+ * are registered once with zsock_epoll_ctl(). Sockets of the native network
+ * stack, including TLS sockets on top of them, are reported readable from
+ * a ready list filled when data or connections arrive, so that waiting is
+ * independent of the number of registered sockets. Other file descriptors,
+ * and registrations including ``ZSOCK_EPOLLOUT``, are polled on every wait
+ * and are limited to :kconfig:option:`CONFIG_NET_SOCKETS_POLL_MAX` minus one.
+ * Offloaded sockets are not supported. The returned file descriptor can be
+ * closed with zsock_close() and polled for ``ZSOCK_POLLIN``.
+ * @endrst
+ *
+ * @param flags Must be 0.
+ *
+ * @return A file descriptor on success, -1 with errno set otherwise.
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Control the registrations of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for a description. A socket can only be served from the ready list of a
+ * single epoll instance at a time, further registrations of it are polled.
+ * ``ZSOCK_EPOLLET`` only applies to registrations served from the ready
+ * list, the others are level-triggered. Closing a registered file
+ * descriptor removes its registration.
+ * @endrst
+ *
+ * @param epfd Epoll file descriptor.
+ * @param op One of ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or
+ *           ZSOCK_EPOLL_CTL_DEL.
+ * @param fd File descriptor to register.
+ * @param event Events of interest and user data, ignored for
+ *              ZSOCK_EPOLL_CTL_DEL.
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for a description.
+ * @endrst
+ *
+ * @param epfd Epoll file descriptor.
+ * @param events Array the ready events are stored in.
+ * @param maxevents Size of the @p events array.
+ * @param timeout Timeout in milliseconds, -1 to wait forever.
+ *
+ * @return Number of events stored, 0 on timeout, -1 with errno set on error.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -6,6 +6,7 @@
 
 /*
  * Copyright (c) 2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -18,6 +19,9 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/net/net_core.h>
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+#include <zephyr/net/net_timer_wheel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,7 +66,11 @@ struct net_trickle {
 
 	bool double_to;         /**< Flag telling if the internval is doubled */
 
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+	struct net_timer_wheel_entry timer; /**< Internal timer struct */
+#else
 	struct k_work_delayable timer; /**< Internal timer struct */
+#endif
 	net_trickle_cb_t cb;	/**< Callback to be called when timer expires */
 	void *user_data;        /**< User specific opaque data */
 };
@@ -50,6 +50,8 @@ enum pm_device_flag {
 	PM_DEVICE_FLAG_RUNTIME_AUTO,
 	/** Indicates that device runtime PM supports suspending and resuming from any context. */
 	PM_DEVICE_FLAG_ISR_SAFE,
+	/** Indicates that an asynchronous resume has not completed yet */
+	PM_DEVICE_FLAG_RESUMING,
 };
 
 /** @endcond */
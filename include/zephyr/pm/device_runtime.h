@@ -96,6 +96,47 @@ int pm_device_runtime_disable(const struct device *dev);
  */
 int pm_device_runtime_get(const struct device *dev);
 
+/**
+ * @brief Resume a set of devices concurrently.
+ *
+ * Equivalent to calling pm_device_runtime_get() on each device, but the
+ * power domains of all devices are resumed first and concurrently, and
+ * devices whose action callback completes the resume asynchronously (see
+ * pm_device_runtime_resume_complete()) are all started before waiting for
+ * any of them. The wakeup latency of independent devices thus overlaps
+ * instead of adding up.
+ *
+ * On failure, the devices resumed by the call are put again.
+ *
+ * @param devs Device instances, at most 32.
+ * @param count Number of devices.
+ *
+ * @retval 0 If all devices were resumed.
+ * @retval -EINVAL If more than 32 devices are given.
+ * @retval -errno Other negative errno, result of the first failing resume.
+ */
+int pm_device_runtime_get_many(const struct device *const *devs, size_t count);
+
+/**
+ * @brief Complete an asynchronous resume.
+ *
+ * A device action callback may start resuming the device and return
+ * -EINPROGRESS for #PM_DEVICE_ACTION_RESUME instead of waiting for the
+ * device to become ready. The driver must then call this function once the
+ * device is ready, or resuming it failed. Callers of pm_device_runtime_get()
+ * block until then, pm_device_runtime_get_many() waits for all devices at
+ * once.
+ *
+ * Asynchronous resume is not supported for devices using
+ * #PM_DEVICE_ISR_SAFE, nor when resumed in pre-kernel or ISR context.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dev Device instance.
+ * @param status 0 if the device is active, negative errno otherwise.
+ */
+void pm_device_runtime_resume_complete(const struct device *dev, int status);
+
 /**
  * @brief Suspend a device based on usage count.
  *
@@ -195,6 +236,21 @@ static inline int pm_device_runtime_get(const struct device *dev)
 	return 0;
 }
 
+static inline int pm_device_runtime_get_many(const struct device *const *devs,
+					     size_t count)
+{
+	ARG_UNUSED(devs);
+	ARG_UNUSED(count);
+	return 0;
+}
+
+static inline void pm_device_runtime_resume_complete(const struct device *dev,
+						     int status)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(status);
+}
+
 static inline int pm_device_runtime_put(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -342,9 +342,22 @@ struct rtio {
 	struct k_sem *consume_sem;
 #endif
 
+#ifdef CONFIG_RTIO_BATCH_SEM
+	/* A wait semaphore which may suspend the calling thread
+	 * until a batch of completions is ready to be consumed
+	 */
+	struct k_sem *batch_sem;
+
+	/* Number of ready completions the batch waiter waits for, 0 if none */
+	atomic_t batch_count;
+#endif
+
 	/* Total number of completions */
 	atomic_t cq_count;
 
+	/* Number of completions produced and not yet consumed */
+	atomic_t cq_ready;
+
 	/* Number of completions that were unable to be submitted with results
 	 * due to the cq spsc being full
 	 */
@@ -788,11 +801,16 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 		   (static K_SEM_DEFINE(CONCAT(_submit_sem_, name), 0, K_SEM_MAX_LIMIT)))          \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,                                                        \
 		   (static K_SEM_DEFINE(CONCAT(_consume_sem_, name), 0, K_SEM_MAX_LIMIT)))         \
+	IF_ENABLED(CONFIG_RTIO_BATCH_SEM,                                                          \
+		   (static K_SEM_DEFINE(CONCAT(_batch_sem_, name), 0, 1)))                         \
 	STRUCT_SECTION_ITERABLE(rtio, name) = {                                                    \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_sem = &CONCAT(_submit_sem_, name),))   \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_count = 0,))                           \
 		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.consume_sem = &CONCAT(_consume_sem_, name),))\
+		IF_ENABLED(CONFIG_RTIO_BATCH_SEM, (.batch_sem = &CONCAT(_batch_sem_, name),))      \
+		IF_ENABLED(CONFIG_RTIO_BATCH_SEM, (.batch_count = ATOMIC_INIT(0),))                \
 		.cq_count = ATOMIC_INIT(0),                                                        \
+		.cq_ready = ATOMIC_INIT(0),                                                        \
 		.xcqcnt = ATOMIC_INIT(0),                                                          \
 		.sqe_pool = _sqe_pool,                                                             \
 		.cqe_pool = _cqe_pool,                                                             \
@@ -983,6 +1001,7 @@ static inline struct rtio_cqe *rtio_cqe_consume(struct rtio *r)
 		return NULL;
 	}
 	cqe = CONTAINER_OF(node, struct rtio_cqe, q);
+	atomic_dec(&r->cq_ready);
 
 	return cqe;
 }
@@ -1011,10 +1030,27 @@ static inline struct rtio_cqe *rtio_cqe_consume_block(struct rtio *r)
 		node = rtio_mpsc_pop(&r->cq);
 	}
 	cqe = CONTAINER_OF(node, struct rtio_cqe, q);
+	atomic_dec(&r->cq_ready);
 
 	return cqe;
 }
 
+/**
+ * @brief Count of completion queue events ready to be consumed
+ *
+ * @param r RTIO context
+ *
+ * @return Number of completion queue events that rtio_cqe_consume() would
+ *         currently return without waiting
+ */
+static inline uint32_t rtio_cqe_consumable(struct rtio *r)
+{
+	atomic_val_t ready = atomic_get(&r->cq_ready);
+
+	/* A consumer may pop a completion before its producer counted it */
+	return ready > 0 ? (uint32_t)ready : 0;
+}
+
 /**
  * @brief Release consumed completion queue event
  *
@@ -1168,6 +1204,18 @@ static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata, u
 		cqe->userdata = userdata;
 		cqe->flags = flags;
 		rtio_cqe_produce(r, cqe);
+
+		atomic_val_t ready = atomic_inc(&r->cq_ready) + 1;
+
+#ifdef CONFIG_RTIO_BATCH_SEM
+		atomic_val_t batch = atomic_get(&r->batch_count);
+
+		if (batch > 0 && ready >= batch && atomic_cas(&r->batch_count, batch, 0)) {
+			k_sem_give(r->batch_sem);
+		}
+#else
+		ARG_UNUSED(ready);
+#endif
 	}
 
 	atomic_inc(&r->cq_count);
@@ -1283,6 +1331,10 @@ static inline void rtio_access_grant(struct rtio *r, struct k_thread *t)
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_object_access_grant(r->consume_sem, t);
 #endif
+
+#ifdef CONFIG_RTIO_BATCH_SEM
+	k_object_access_grant(r->batch_sem, t);
+#endif
 }
 
 /**
@@ -1418,6 +1470,82 @@ static inline int z_impl_rtio_cqe_copy_out(struct rtio *r,
 	return copied;
 }
 
+/**
+ * @brief Wait for a batch of CQEs and copy them from the queue
+ *
+ * Waits until at least @p min_count completion queue events are ready or
+ * the timeout expires, then copies out as many of the ready events as fit
+ * in @p cqes without waiting any further. Consumers of high rate streams,
+ * such as multishot reads, can use this to be woken once per batch rather
+ * than once per completion.
+ *
+ * With CONFIG_RTIO_BATCH_SEM the calling thread sleeps until the batch is
+ * complete and only one thread may wait for a batch on a context at a time.
+ * Otherwise the completion queue is polled with a k_yield() in between
+ * iterations.
+ *
+ * @param r RTIO context
+ * @param cqes Pointer to an array of CQEs
+ * @param min_count Count of CQEs to wait for
+ * @param max_count Count of CQEs in array
+ * @param timeout Timeout to wait for the batch to be complete
+ *
+ * @retval copy_count Count of copied CQEs (0 to max_count), which is less
+ *         than min_count if the timeout expired
+ */
+__syscall int rtio_cqe_copy_out_batch(struct rtio *r,
+				      struct rtio_cqe *cqes,
+				      size_t min_count,
+				      size_t max_count,
+				      k_timeout_t timeout);
+static inline int z_impl_rtio_cqe_copy_out_batch(struct rtio *r,
+						 struct rtio_cqe *cqes,
+						 size_t min_count,
+						 size_t max_count,
+						 k_timeout_t timeout)
+{
+	size_t copied = 0;
+	struct rtio_cqe *cqe;
+
+	__ASSERT_NO_MSG(min_count <= max_count);
+
+	if (rtio_cqe_consumable(r) < min_count && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+#ifdef CONFIG_RTIO_BATCH_SEM
+		k_sem_reset(r->batch_sem);
+		atomic_set(&r->batch_count, (atomic_val_t)min_count);
+
+		/* Completions produced before the count was set did not wake us */
+		if (rtio_cqe_consumable(r) < min_count) {
+			(void)k_sem_take(r->batch_sem, timeout);
+		}
+		atomic_set(&r->batch_count, 0);
+#else
+		k_timepoint_t end = sys_timepoint_calc(timeout);
+
+		while (rtio_cqe_consumable(r) < min_count && !sys_timepoint_expired(end)) {
+#ifdef CONFIG_BOARD_NATIVE_POSIX
+			/* Native posix fakes the clock and only moves it forward when sleeping. */
+			k_sleep(K_TICKS(1));
+#else
+			Z_SPIN_DELAY(1);
+			k_yield();
+#endif
+		}
+#endif
+	}
+
+	while (copied < max_count) {
+		cqe = rtio_cqe_consume(r);
+		if (cqe == NULL) {
+			break;
+		}
+		cqes[copied++] = *cqe;
+		rtio_cqe_release(r, cqe);
+	}
+
+	return copied;
+}
+
 /**
  * @brief Submit I/O requests to the underlying executor
  *
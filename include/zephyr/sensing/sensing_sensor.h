@@ -88,8 +88,13 @@ struct sensing_connection {
 	/** Sensitivity of the connection. */
 	int sensitivity[CONFIG_SENSING_MAX_SENSITIVITY_COUNT];
 	void *data;                 /**< Pointer to sensor sample data of the connection. */
-	/** Next consume time of the connection. Unit is micro seconds. */
-	uint64_t next_consume_time;
+	/**
+	 * Report one out of this many samples of the source, derived from the
+	 * connection and source intervals when the source is configured.
+	 */
+	uint32_t decimation;
+	/** Samples of the source seen since the last report. */
+	uint32_t decimation_count;
 	struct sensing_callback_list *callback_list; /**< Callback list of the connection. */
 };
 
@@ -338,6 +338,57 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+/**
+ * Start a batch of saves.
+ *
+ * Until the batch is committed or aborted, the values the calling thread
+ * saves through settings_save_one(), settings_delete(), settings_save() or
+ * settings_batch_stage() are staged in RAM rather than written to persisted
+ * storage. A value staged twice is stored once, with the last value. Other
+ * threads block in the settings API while the batch is open.
+ *
+ * Available when @kconfig{CONFIG_SETTINGS_BATCH} is enabled.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if there is no storage back-end.
+ * @retval -EALREADY if the calling thread already has a batch open.
+ */
+int settings_batch_begin(void);
+
+/**
+ * Stage a single serialized value in the batch of the calling thread.
+ *
+ * @param name Name/key of the settings item.
+ * @param value Pointer to the value of the settings item, copied into the
+ * batch.
+ * @param val_len Length of the value, 0 to delete the item.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the calling thread has no batch open.
+ * @retval -ENOMEM if the batch is full. The values staged so far are kept,
+ * the batch can still be committed.
+ */
+int settings_batch_stage(const char *name, const void *value, size_t val_len);
+
+/**
+ * Write the values staged in the batch of the calling thread and close it.
+ *
+ * The values are handed to the back-end in one call, see
+ * @ref settings_store_itf::csi_save_batch for what the in-tree back-ends
+ * guarantee when power is lost during the commit.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the calling thread has no batch open.
+ * @return other negative values on storage errors. The batch is closed in
+ * any case, part of it may have been written.
+ */
+int settings_batch_commit(void);
+
+/**
+ * Drop the values staged in the batch of the calling thread and close it.
+ */
+void settings_batch_abort(void);
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
@@ -409,6 +460,18 @@ struct settings_load_arg {
 	void *param;
 };
 
+/**
+ * Key-value pair of a batch of saves, see settings_batch_begin().
+ */
+struct settings_batch_entry {
+	/** Key in string format */
+	const char *name;
+	/** Binary value, NULL for a delete */
+	const char *value;
+	/** Length of value in bytes */
+	size_t val_len;
+};
+
 /**
  * Backend handler functions.
  * Sources are registered using a call to @ref settings_src_register.
@@ -455,6 +518,24 @@ struct settings_store_itf {
 	 *  - cs - Corresponding backend handler node
 	 */
 
+	int (*csi_save_batch)(struct settings_store *cs,
+			      const struct settings_batch_entry *entries,
+			      size_t count);
+	/**< Save several key-value pairs to storage, optional.
+	 *
+	 * If not provided, csi_save is called for each pair. Keys are unique
+	 * within a batch. The NVS back-end only makes the keys created by the
+	 * batch visible once all its pairs are written. The file back-end
+	 * appends the pairs with a single open and close, which commits them
+	 * atomically on file systems that only persist writes on close, such
+	 * as littlefs.
+	 *
+	 * Parameters:
+	 *  - cs - Corresponding backend handler node
+	 *  - entries - Key-value pairs to save
+	 *  - count - Number of pairs
+	 */
+
 	/**< Get pointer to the storage instance used by the backend.
 	 *
 	 * Parameters:
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018 Intel Corporation.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -35,6 +36,22 @@ struct z_spinlock_key {
 	int key;
 };
 
+/**
+ * @brief Spinlock usage statistics
+ *
+ * Gathered with CONFIG_SPIN_LOCK_STATS, see k_spin_stats_get().
+ */
+struct k_spinlock_stats {
+	/** Number of times the lock was taken */
+	uint32_t acquired;
+	/** Number of times the lock was found held by another CPU */
+	uint32_t contended;
+	/** Longest time the lock was held, in cycles */
+	uint32_t max_hold_cycles;
+	/** Total time the lock was held, in cycles */
+	uint64_t total_hold_cycles;
+};
+
 /**
  * @brief Kernel Spin Lock
  *
@@ -78,6 +95,12 @@ struct k_spinlock {
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+	struct k_spinlock_stats stats;
+	/* Time (in cycles) the lock was taken */
+	uint32_t stats_lock_time;
+#endif /* CONFIG_SPIN_LOCK_STATS */
+
 #if defined(CONFIG_CPP) && !defined(CONFIG_SMP) && \
 	!defined(CONFIG_SPIN_VALIDATE)
 	/* If CONFIG_SMP and CONFIG_SPIN_VALIDATE are both not defined
@@ -151,6 +174,31 @@ static ALWAYS_INLINE void z_spinlock_validate_post(struct k_spinlock *l)
 #endif /* CONFIG_SPIN_VALIDATE */
 }
 
+static ALWAYS_INLINE void z_spinlock_stats_post(struct k_spinlock *l, bool contended)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(contended);
+#ifdef CONFIG_SPIN_LOCK_STATS
+	/* The lock is held, so no other CPU updates them meanwhile */
+	l->stats.acquired++;
+	l->stats.contended += contended ? 1U : 0U;
+	l->stats_lock_time = sys_clock_cycle_get_32();
+#endif /* CONFIG_SPIN_LOCK_STATS */
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_release(struct k_spinlock *l)
+{
+	ARG_UNUSED(l);
+#ifdef CONFIG_SPIN_LOCK_STATS
+	uint32_t held = sys_clock_cycle_get_32() - l->stats_lock_time;
+
+	l->stats.total_hold_cycles += held;
+	if (held > l->stats.max_hold_cycles) {
+		l->stats.max_hold_cycles = held;
+	}
+#endif /* CONFIG_SPIN_LOCK_STATS */
+}
+
 /**
  * @brief Lock a spinlock
  *
@@ -188,6 +236,8 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	 * implementation.  The "irq_lock()" API in SMP context is
 	 * actually a wrapper for a global spinlock!
 	 */
+	__maybe_unused bool contended = false;
+
 	k.key = arch_irq_lock();
 
 	z_spinlock_validate_pre(l);
@@ -200,15 +250,18 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	atomic_val_t ticket = atomic_inc(&l->tail);
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
+		contended = true;
 		arch_spin_relax();
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
+		contended = true;
 		arch_spin_relax();
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, contended);
 
 	return k;
 }
@@ -264,6 +317,7 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, false);
 
 	k->key = key;
 
@@ -312,6 +366,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 		 l, delta, CONFIG_SPIN_LOCK_TIME_LIMIT);
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
+	z_spinlock_stats_release(l);
 
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
@@ -331,6 +386,42 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 	arch_irq_unlock(key.key);
 }
 
+#if defined(CONFIG_SPIN_LOCK_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the usage statistics of a spinlock
+ *
+ * The lock is taken while reading them, which is counted as well.
+ *
+ * @note Requires CONFIG_SPIN_LOCK_STATS.
+ *
+ * @param l A pointer to the spinlock
+ * @param stats Filled with the statistics gathered since the lock was
+ *        initialized or since the last k_spin_stats_reset()
+ */
+static inline void k_spin_stats_get(struct k_spinlock *l, struct k_spinlock_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	*stats = l->stats;
+	k_spin_unlock(l, key);
+}
+
+/**
+ * @brief Reset the usage statistics of a spinlock
+ *
+ * @note Requires CONFIG_SPIN_LOCK_STATS.
+ *
+ * @param l A pointer to the spinlock
+ */
+static inline void k_spin_stats_reset(struct k_spinlock *l)
+{
+	k_spinlock_key_t key = k_spin_lock(l);
+
+	l->stats = (struct k_spinlock_stats){0};
+	k_spin_unlock(l, key);
+}
+#endif /* CONFIG_SPIN_LOCK_STATS */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -362,6 +453,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
+	z_spinlock_stats_release(l);
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	atomic_inc(&l->owner);
@@ -30,6 +30,11 @@ extern "C" {
  */
 #define CRC8_CCITT_INITIAL_VALUE 0xFF
 
+/* Initial value expected to be used at the beginning of the crc8_rohc
+ * computation.
+ */
+#define CRC8_ROHC_INITIAL_VALUE 0xFF
+
 /* Initial value expected to be used at the beginning of the OpenPGP CRC-24 computation. */
 #define CRC24_PGP_INITIAL_VALUE 0x00B704CEU
 /*
@@ -60,6 +65,7 @@ enum crc_type {
 	CRC7_BE,     /**< Use @ref crc7_be */
 	CRC8,	     /**< Use @ref crc8 */
 	CRC8_CCITT,  /**< Use @ref crc8_ccitt */
+	CRC8_ROHC,   /**< Use @ref crc8_rohc */
 	CRC16,	     /**< Use @ref crc16 */
 	CRC16_ANSI,  /**< Use @ref crc16_ansi */
 	CRC16_CCITT, /**< Use @ref crc16_ccitt */
@@ -274,6 +280,20 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
  */
 uint8_t crc8_ccitt(uint8_t initial_value, const void *buf, size_t len);
 
+/**
+ * @brief Compute ROHC variant of CRC 8
+ *
+ * ROHC (Robust Header Compression) variant of CRC 8 is using the reflected
+ * polynomial 0xE0. It is also the FCS of 3GPP TS 27.010 (CMUX).
+ *
+ * @param initial_value Initial value for the CRC computation
+ * @param buf Input bytes for the computation
+ * @param len Length of the input in bytes
+ *
+ * @return The computed CRC8 value
+ */
+uint8_t crc8_rohc(uint8_t initial_value, const void *buf, size_t len);
+
 /**
  * @brief Compute the CRC-7 checksum of a buffer.
  *
@@ -384,6 +404,8 @@ static inline uint32_t crc_by_type(enum crc_type type, const uint8_t *src, size_
 		return crc8(src, len, poly, seed, reflect);
 	case CRC8_CCITT:
 		return crc8_ccitt(seed, src, len);
+	case CRC8_ROHC:
+		return crc8_rohc(seed, src, len);
 	case CRC16:
 		if (reflect) {
 			return crc16_reflect(poly, seed, src, len);
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_DMA_MEMCPY_H_
+#define ZEPHYR_INCLUDE_SYS_DMA_MEMCPY_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA memcpy offload API
+ * @defgroup dma_memcpy DMA memcpy offload API
+ * @ingroup os_services
+ *
+ * Copies of at least CONFIG_DMA_MEMCPY_THRESHOLD bytes are done by the DMA
+ * controller chosen with the @c zephyr,dma-memcpy devicetree property, on a
+ * pool of channels requested at boot, freeing the CPU meanwhile. The data
+ * cache is written back and invalidated around the transfers.
+ *
+ * Smaller copies, copies which the controller cannot do or fails to start,
+ * and copies requested while all the channels are busy are done with
+ * memcpy() instead. The source and destination must not overlap, and must
+ * not be accessed by the CPU until the copy is completed.
+ *
+ * @{
+ */
+
+/**
+ * @brief Completion callback
+ *
+ * @param result 0 if the copy is completed, a negative errno if the DMA
+ *               controller reported an error
+ * @param user_data User data given to dma_memcpy_async()
+ */
+typedef void (*dma_memcpy_cb_t)(int result, void *user_data);
+
+/**
+ * @brief Copy memory asynchronously
+ *
+ * @p cb is called once the copy is completed, from the DMA controller
+ * callback, typically an interrupt. If the copy is done with memcpy(),
+ * @p cb is called before returning.
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param len Number of bytes to copy
+ * @param cb Completion callback
+ * @param user_data User data passed to @p cb
+ *
+ * @retval 0 The copy is started, or already completed
+ * @retval -EINVAL @p cb is NULL
+ */
+int dma_memcpy_async(void *dst, const void *src, size_t len, dma_memcpy_cb_t cb,
+		     void *user_data);
+
+/**
+ * @brief Copy memory, waiting for the copy to complete
+ *
+ * The calling thread sleeps while the DMA controller copies. From an
+ * interrupt, the copy is always done with memcpy().
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param len Number of bytes to copy
+ *
+ * @retval 0 The copy is completed
+ * @retval -errno The DMA controller reported an error
+ */
+int dma_memcpy(void *dst, const void *src, size_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_DMA_MEMCPY_H_ */
@@ -91,6 +91,14 @@ struct sys_mem_blocks_info {
 #endif
 };
 
+#if CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE > 0
+struct sys_mem_blocks_cpu_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	void *blocks[CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE];
+};
+#endif
+
 struct sys_mem_blocks {
 	struct sys_mem_blocks_info  info;
 
@@ -107,6 +115,10 @@ struct sys_mem_blocks {
 #ifdef CONFIG_OBJ_CORE_SYS_MEM_BLOCKS
 	struct k_obj_core obj_core;
 #endif
+#if CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE > 0
+	/* Freed blocks kept per CPU, still set in the bitmap */
+	struct sys_mem_blocks_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 struct sys_multi_mem_blocks {
@@ -261,6 +273,9 @@ int sys_mem_blocks_get(sys_mem_blocks_t *mem_block, void *in_block, size_t count
 /**
  * @brief check if the region is free
  *
+ * With CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE, blocks cached by the CPUs
+ * are given back to the allocator first if the region is found taken.
+ *
  * @param[in]  mem_block  Pointer to memory block object.
  * @param[in]  in_block   Address of the first block to check
  * @param[in]  count      Number of blocks to check.
@@ -276,6 +291,10 @@ int sys_mem_blocks_is_region_free(sys_mem_blocks_t *mem_block, void *in_block, s
  * Free multiple memory blocks according to the array of memory
  * block pointers.
  *
+ * With CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE, freed blocks are kept in
+ * the cache of the current CPU while it has room, and handed out first
+ * by sys_mem_blocks_alloc() on this CPU.
+ *
  * @param[in] mem_block Pointer to memory block object.
  * @param[in] count     Number of blocks to free.
  * @param[in] in_blocks Input array of pointers to the memory blocks.
@@ -11,9 +11,10 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked and unlocked
  * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI. The kernel mutex, and with it priority
+ * inheritance, only comes into play once another thread has to wait.
  */
 
 #ifdef __cplusplus
@@ -24,11 +25,17 @@ extern "C" {
 #include <zephyr/sys/atomic.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <zephyr/kernel.h>
+#endif
+
+/* Value of sys_mutex::val while the kernel mutex holds the lock state */
+#define Z_SYS_MUTEX_KERNEL_OWNED 1
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST, the thread that locked the mutex without
+	 * a syscall, Z_SYS_MUTEX_KERNEL_OWNED while the lock state is kept by
+	 * the kernel mutex, or 0 if the mutex is free. Unused otherwise.
 	 */
 	atomic_t val;
 };
@@ -101,7 +108,22 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_val_t self = (atomic_val_t)k_current_get();
+	atomic_val_t owner;
+
+	if (atomic_cas(&mutex->val, 0, self)) {
+		return 0;
+	}
+
+	/* Recursive locking and waiting are left to the kernel mutex */
+	owner = atomic_get(&mutex->val);
+	if (owner != 0 && owner != self && owner != Z_SYS_MUTEX_KERNEL_OWNED &&
+	    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+#endif
+
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -124,7 +146,12 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (atomic_cas(&mutex->val, (atomic_val_t)k_current_get(), 0)) {
+		return 0;
+	}
+#endif
+
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
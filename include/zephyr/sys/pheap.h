@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @defgroup pheap_apis Pairing Heap
+ * @ingroup datastructure_apis
+ *
+ * @brief Pairing heap implementation
+ *
+ * This implements an intrusive pairing heap, a self-adjusting
+ * priority queue with O(1) insertion and lookup of the minimum and
+ * amortized O(log2(N)) removal, c.f.:
+ *
+ * https://en.wikipedia.org/wiki/Pairing_heap
+ *
+ * Unlike with a balanced tree, the minimum is always the root of the
+ * heap, so looking it up touches a single node, and insertion touches
+ * at most two nodes regardless of the size of the heap. This makes it
+ * a good fit for priority queues which mostly need the minimum, such
+ * as scheduler ready queues. Nodes are not kept in order though, and
+ * there is no ordered iteration.
+ *
+ * The @ref pheap_node handle is intended to be placed in a separate
+ * struct, in the same way as with other such structures (e.g. Zephyr's
+ * @ref rbtree_apis). It holds three pointers.
+ *
+ * @{
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_PHEAP_H_
+#define ZEPHYR_INCLUDE_SYS_PHEAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pairing heap node structure
+ */
+struct pheap_node {
+	/** @cond INTERNAL_HIDDEN */
+	struct pheap_node *child;
+	struct pheap_node *next;
+	/* Left sibling, or parent for the first child */
+	struct pheap_node *prev;
+	/** @endcond */
+};
+
+/**
+ * @typedef pheap_lessthan_t
+ * @brief Pairing heap comparison predicate
+ *
+ * Compares the two nodes and returns true if node A is strictly less
+ * than B according to the heap's sorting criteria, false otherwise.
+ * Which of two nodes comparing as equal is the minimum is unspecified.
+ */
+typedef bool (*pheap_lessthan_t)(struct pheap_node *a, struct pheap_node *b);
+
+/**
+ * @brief Pairing heap structure
+ */
+struct pheap {
+	/** Root node of the heap, its minimum */
+	struct pheap_node *root;
+	/** Comparison function for nodes in the heap */
+	pheap_lessthan_t lessthan_fn;
+};
+
+/**
+ * @brief Insert node into heap
+ */
+void pheap_insert(struct pheap *heap, struct pheap_node *node);
+
+/**
+ * @brief Remove node from heap
+ */
+void pheap_remove(struct pheap *heap, struct pheap_node *node);
+
+/**
+ * @brief Returns the lowest-sorted member of the heap
+ */
+static inline struct pheap_node *pheap_get_min(struct pheap *heap)
+{
+	return heap->root;
+}
+
+/**
+ * @brief Returns true if the heap holds no node
+ */
+static inline bool pheap_is_empty(struct pheap *heap)
+{
+	return heap->root == NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_SYS_PHEAP_H_ */
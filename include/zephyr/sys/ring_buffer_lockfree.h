@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RING_BUFFER_LOCKFREE_H_
+#define ZEPHYR_INCLUDE_SYS_RING_BUFFER_LOCKFREE_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @defgroup ring_buffer_lockfree_apis Lock-free Ring Buffer APIs
+ * @ingroup datastructure_apis
+ *
+ * @brief Ring buffers safe for concurrent use without locking.
+ *
+ * Variants of the @ref ring_buffer_apis with the same claim and finish
+ * semantics, for one producer and one consumer (SPSC) or for many producers
+ * and one consumer (MPSC). Producers and consumer may run in any context,
+ * including ISRs on other CPUs, without disabling interrupts or taking a
+ * lock.
+ *
+ * Indexes written by the producers and by the consumer are kept apart by
+ * @kconfig{CONFIG_RING_BUFFER_LOCKFREE_ALIGN} bytes, so that producers and
+ * consumer on different CPUs do not write to the same cache line.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+#define RING_BUF_LOCKFREE_ALIGN __aligned(CONFIG_RING_BUFFER_LOCKFREE_ALIGN)
+
+#define RING_BUFFER_LOCKFREE_SIZE_ASSERT_MSG \
+	"Size must be a power of two"
+
+/* Limit of the record sizes held by MPSC record headers */
+#define RING_BUFFER_MPSC_MAX_SIZE BIT(28)
+/** @endcond */
+
+/**
+ * @brief A ring buffer for a single producer and a single consumer
+ */
+struct ring_buf_spsc {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t *buffer;
+	uint32_t mask;
+	struct {
+		atomic_t tail;
+		uint32_t head;
+	} put RING_BUF_LOCKFREE_ALIGN;
+	struct {
+		atomic_t tail;
+		uint32_t head;
+	} get RING_BUF_LOCKFREE_ALIGN;
+	/** @endcond */
+};
+
+/**
+ * @brief Define and initialize a single producer, single consumer ring buffer.
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), must be a power of two.
+ */
+#define RING_BUF_SPSC_DECLARE(name, size8) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(size8) && (size8) < RING_BUFFER_MAX_SIZE, \
+		     RING_BUFFER_LOCKFREE_SIZE_ASSERT_MSG); \
+	static uint8_t __noinit _ring_buffer_spsc_data_##name[size8]; \
+	struct ring_buf_spsc name = { \
+		.buffer = _ring_buffer_spsc_data_##name, \
+		.mask = (size8) - 1 \
+	}
+
+/**
+ * @brief Initialize a single producer, single consumer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_SPSC_DECLARE.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size (in bytes), must be a power of two.
+ * @param data Ring buffer data area (uint8_t data[size]).
+ */
+static inline void ring_buf_spsc_init(struct ring_buf_spsc *buf, uint32_t size, uint8_t *data)
+{
+	__ASSERT(IS_POWER_OF_TWO(size) && size < RING_BUFFER_MAX_SIZE,
+		 RING_BUFFER_LOCKFREE_SIZE_ASSERT_MSG);
+
+	buf->buffer = data;
+	buf->mask = size - 1;
+	buf->put.head = 0;
+	buf->get.head = 0;
+	atomic_set(&buf->put.tail, 0);
+	atomic_set(&buf->get.tail, 0);
+}
+
+/**
+ * @brief Return ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes).
+ */
+static inline uint32_t ring_buf_spsc_capacity_get(struct ring_buf_spsc *buf)
+{
+	return buf->mask + 1;
+}
+
+/**
+ * @brief Determine used space in a ring buffer.
+ *
+ * The value may be outdated as soon as it is returned if the producer or
+ * the consumer is running concurrently.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer space used (in bytes).
+ */
+static inline uint32_t ring_buf_spsc_size_get(struct ring_buf_spsc *buf)
+{
+	uint32_t get_tail = (uint32_t)atomic_get(&buf->get.tail);
+
+	return (uint32_t)atomic_get(&buf->put.tail) - get_tail;
+}
+
+/**
+ * @brief Determine free space in a ring buffer.
+ *
+ * The value may be outdated as soon as it is returned if the producer or
+ * the consumer is running concurrently.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline uint32_t ring_buf_spsc_space_get(struct ring_buf_spsc *buf)
+{
+	return ring_buf_spsc_capacity_get(buf) - ring_buf_spsc_size_get(buf);
+}
+
+/**
+ * @brief Determine if a ring buffer is empty.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+static inline bool ring_buf_spsc_is_empty(struct ring_buf_spsc *buf)
+{
+	return ring_buf_spsc_size_get(buf) == 0;
+}
+
+/**
+ * @brief Allocate buffer for writing data to a ring buffer.
+ *
+ * Same as @ref ring_buf_put_claim. Must only be called by the producer.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps.
+ */
+uint32_t ring_buf_spsc_put_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Indicate number of bytes written to allocated buffers.
+ *
+ * Same as @ref ring_buf_put_finish. Must only be called by the producer.
+ * The written bytes become visible to the consumer at once.
+ *
+ * @param  buf  Address of ring buffer.
+ * @param  size Number of valid bytes in the allocated buffers.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the allocated buffers.
+ */
+int ring_buf_spsc_put_finish(struct ring_buf_spsc *buf, uint32_t size);
+
+/**
+ * @brief Write (copy) data to a ring buffer.
+ *
+ * Must only be called by the producer.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+uint32_t ring_buf_spsc_put(struct ring_buf_spsc *buf, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Get address of a valid data in a ring buffer.
+ *
+ * Same as @ref ring_buf_get_claim. Must only be called by the consumer.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough data or buffer wraps.
+ */
+uint32_t ring_buf_spsc_get_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer.
+ *
+ * Same as @ref ring_buf_get_finish. Must only be called by the consumer.
+ * The freed bytes become available to the producer at once.
+ *
+ * @param  buf  Address of ring buffer.
+ * @param  size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed bytes.
+ */
+int ring_buf_spsc_get_finish(struct ring_buf_spsc *buf, uint32_t size);
+
+/**
+ * @brief Read data from a ring buffer.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written to the output buffer.
+ */
+uint32_t ring_buf_spsc_get(struct ring_buf_spsc *buf, uint8_t *data, uint32_t size);
+
+/**
+ * @brief A bounded ring buffer for multiple producers and a single consumer
+ *
+ * Data is stored as records, each claimed by a producer in one piece.
+ * Records are read in the order in which they were claimed, and a record
+ * claimed but not yet finished holds back the records claimed after it.
+ */
+struct ring_buf_mpsc {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t *buffer;
+	uint32_t mask;
+	atomic_t head RING_BUF_LOCKFREE_ALIGN;
+	struct {
+		atomic_t tail;
+		uint32_t claimed;
+	} get RING_BUF_LOCKFREE_ALIGN;
+	/** @endcond */
+};
+
+/**
+ * @brief Compute the ring buffer space taken by a record
+ *
+ * @param size Record size (in bytes).
+ */
+#define RING_BUF_MPSC_RECORD_SIZE(size) (sizeof(atomic_t) + ROUND_UP(size, sizeof(atomic_t)))
+
+/**
+ * @brief Define and initialize a multiple producer, single consumer ring buffer.
+ *
+ * @param name  Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), must be a power of two, a
+ *		multiple of sizeof(atomic_t) and at most 256 MiB.
+ */
+#define RING_BUF_MPSC_DECLARE(name, size8) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(size8) && (size8) >= sizeof(atomic_t) && \
+		     (size8) <= RING_BUFFER_MPSC_MAX_SIZE, \
+		     RING_BUFFER_LOCKFREE_SIZE_ASSERT_MSG); \
+	static atomic_t _ring_buffer_mpsc_data_##name[(size8) / sizeof(atomic_t)]; \
+	struct ring_buf_mpsc name = { \
+		.buffer = (uint8_t *)_ring_buffer_mpsc_data_##name, \
+		.mask = (size8) - 1 \
+	}
+
+/**
+ * @brief Initialize a multiple producer, single consumer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_MPSC_DECLARE.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size (in bytes), must be a power of two, a
+ *	       multiple of sizeof(atomic_t) and at most 256 MiB.
+ * @param data Ring buffer data area, aligned to sizeof(atomic_t).
+ */
+void ring_buf_mpsc_init(struct ring_buf_mpsc *buf, uint32_t size, void *data);
+
+/**
+ * @brief Allocate a record for writing data to a ring buffer.
+ *
+ * The record is allocated in one piece. It is handed to the consumer by
+ * @ref ring_buf_mpsc_put_finish, which must be called even if the producer
+ * decides not to write it after all. May be called from any context.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer, aligned to sizeof(atomic_t).
+ * @param[in]  size Record size (in bytes).
+ *
+ * @retval 0 Successful operation.
+ * @retval -ENOMEM Ring buffer has insufficient free space.
+ * @retval -EMSGSIZE Record does not fit into the ring buffer, even empty.
+ */
+int ring_buf_mpsc_put_claim(struct ring_buf_mpsc *buf, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Hand a record over to the consumer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Record as returned by @ref ring_buf_mpsc_put_claim.
+ * @param size Number of valid bytes in the record, at most as many as were
+ *	       claimed. May be 0 to drop the record.
+ */
+void ring_buf_mpsc_put_finish(struct ring_buf_mpsc *buf, uint8_t *data, uint32_t size);
+
+/**
+ * @brief Write (copy) a record to a ring buffer.
+ *
+ * May be called from any context.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval 0 Record was written.
+ * @retval -ENOMEM Ring buffer has insufficient free space.
+ * @retval -EMSGSIZE Record does not fit into the ring buffer, even empty.
+ */
+int ring_buf_mpsc_put(struct ring_buf_mpsc *buf, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Get the next record of a ring buffer.
+ *
+ * The record remains in the ring buffer until freed with
+ * @ref ring_buf_mpsc_get_finish. Calling this again before that returns
+ * the same record. Must only be called by the consumer.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ *
+ * @retval 0 No record is available. Records claimed but not finished yet are
+ *	     not available.
+ * @retval >0 Size of the record (in bytes).
+ */
+uint32_t ring_buf_mpsc_get_claim(struct ring_buf_mpsc *buf, uint8_t **data);
+
+/**
+ * @brief Free the record returned by @ref ring_buf_mpsc_get_claim.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL No record was claimed.
+ */
+int ring_buf_mpsc_get_finish(struct ring_buf_mpsc *buf);
+
+/**
+ * @brief Read (copy) a record from a ring buffer.
+ *
+ * Must only be called by the consumer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard the record.
+ * @param size Output buffer size (in bytes).
+ *
+ * @retval >=0 Size of the record (in bytes).
+ * @retval -EAGAIN No record is available.
+ * @retval -EMSGSIZE Output buffer is too small, the record is left in the
+ *	   ring buffer.
+ */
+int ring_buf_mpsc_get(struct ring_buf_mpsc *buf, uint8_t *data, uint32_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RING_BUFFER_LOCKFREE_H_ */
@@ -53,10 +53,30 @@ extern "C" {
  * put the two values somewhere else, though it would make
  * SYS_HEAP_DEFINE a little hairy to write.
  */
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Size classes of the allocation cache: 16, 32, 64 and 128 bytes */
+#define SYS_HEAP_CACHE_CLASSES 4
+#define SYS_HEAP_CACHE_MIN_BYTES 16U
+#define SYS_HEAP_CACHE_MAX_BYTES (SYS_HEAP_CACHE_MIN_BYTES << (SYS_HEAP_CACHE_CLASSES - 1))
+
+/* Per-CPU free lists of cached blocks, linked through their first word */
+struct z_heap_cache {
+	void *head[SYS_HEAP_CACHE_CLASSES];
+	uint8_t count[SYS_HEAP_CACHE_CLASSES];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	uint32_t hits;
+	uint32_t misses;
+#endif
+};
+#endif
+
 struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct z_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 struct z_heap_stress_result {
@@ -64,6 +84,10 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint64_t accumulated_alloc_cycles;
+	uint64_t accumulated_free_cycles;
+	uint32_t max_alloc_cycles;
+	uint32_t max_free_cycles;
 };
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
@@ -89,6 +113,32 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/** @brief Allocation cache statistics of a sys_heap */
+struct sys_heap_cache_stats {
+	/** Allocations served from a cache */
+	uint32_t hits;
+	/** Cacheable allocations that had to go to the heap */
+	uint32_t misses;
+	/** Bytes currently held in the caches of all CPUs */
+	size_t cached_bytes;
+};
+
+/**
+ * @brief Get the allocation cache statistics of a sys_heap
+ *
+ * The hit rate of the cache is hits / (hits + misses).
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache_stats *stats);
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 #endif
 
 /** @brief Initialize sys_heap
@@ -150,6 +200,71 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *heap, void *mem);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/** @brief Allocate a small block from the current CPU's cache
+ *
+ * Returns a block of at least sys_heap_cache_bytes(@a bytes) bytes that
+ * was previously handed to sys_heap_cache_free() on this CPU, or NULL
+ * if there is none.  This neither reads nor modifies the heap itself,
+ * so unlike the other sys_heap functions it needs no external locking
+ * and is safe to call concurrently with them.  Callers fall back to
+ * sys_heap_alloc() with a size of sys_heap_cache_bytes(@a bytes) on a
+ * miss, so that the block can be cached once it is freed.
+ *
+ * @param heap Heap from which to allocate
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t bytes);
+
+/** @brief Cache a block instead of freeing it
+ *
+ * Puts a block allocated from @a heap on the current CPU's cache if its
+ * size matches one of the cache size classes and that class is not
+ * full.  Cached blocks still count as allocated in the heap.  Like
+ * sys_heap_cache_alloc(), this needs no external locking.
+ *
+ * @param heap Heap to which the memory belongs
+ * @param mem A pointer previously returned from sys_heap_alloc()
+ * @return true if the block was cached, false if the caller must
+ *         free it with sys_heap_free()
+ */
+bool sys_heap_cache_free(struct sys_heap *heap, void *mem);
+
+/** @brief Return the current CPU's cached blocks to the heap
+ *
+ * Must be called with the same external locking as sys_heap_free(),
+ * and in a context that cannot migrate to another CPU.
+ *
+ * @param heap Heap whose cache to flush
+ * @return true if any block was returned to the heap
+ */
+bool sys_heap_cache_flush(struct sys_heap *heap);
+
+/** @brief Round a request up to its cache size class
+ *
+ * @param bytes Number of bytes requested
+ * @return The size class for @a bytes, or @a bytes itself if it is too
+ *         big to be cached
+ */
+static inline size_t sys_heap_cache_bytes(size_t bytes)
+{
+	size_t class_bytes = SYS_HEAP_CACHE_MIN_BYTES;
+
+	if ((bytes == 0U) || (bytes > SYS_HEAP_CACHE_MAX_BYTES)) {
+		return bytes;
+	}
+
+	while (class_bytes < bytes) {
+		class_bytes <<= 1;
+	}
+
+	return class_bytes;
+}
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
@@ -214,7 +329,10 @@ bool sys_heap_validate(struct sys_heap *heap);
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations and the cycles spent in the callbacks, are returned via
+ * the @a result struct.  Running the rig from several threads at
+ * once against one synchronized heap measures allocation latency
+ * under contention.
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
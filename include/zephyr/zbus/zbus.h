@@ -11,10 +11,16 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#if defined(CONFIG_ZBUS_ZERO_COPY)
+#include <zephyr/net/buf.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+struct net_buf;
+
 /**
  * @brief Zbus API
  * @defgroup zbus_apis Zbus APIs
@@ -56,6 +62,13 @@ struct zbus_channel_data {
 	 */
 	sys_slist_t observers;
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS */
+
+#if defined(CONFIG_ZBUS_SEQLOCK) || defined(__DOXYGEN__)
+	/** Sequence count of a sequence locked channel. It is odd while a publisher updates the
+	 * message copy not in use, and bit 1 selects the current copy.
+	 */
+	atomic_t seq;
+#endif /* CONFIG_ZBUS_SEQLOCK */
 };
 
 /**
@@ -90,6 +103,20 @@ struct zbus_channel {
 
 	/** Mutable channel data struct. */
 	struct zbus_channel_data *const data;
+
+#if defined(CONFIG_ZBUS_SEQLOCK) || defined(__DOXYGEN__)
+	/** Sequence locked channel flag. The message points to two copies of the message type,
+	 * and readers do not take the channel lock.
+	 */
+	const bool seqlock;
+#endif /* CONFIG_ZBUS_SEQLOCK */
+
+#if defined(CONFIG_ZBUS_ZERO_COPY) || defined(__DOXYGEN__)
+	/** Buffer pool of a zero-copy channel. The message of such a channel is a reference to
+	 * the last published net_buf from this pool. NULL for channels copying their messages.
+	 */
+	struct net_buf_pool *const buf_pool;
+#endif /* CONFIG_ZBUS_ZERO_COPY */
 };
 
 /**
@@ -354,6 +381,116 @@ struct zbus_channel_observation {
 	FOR_EACH_FIXED_ARG_NONEMPTY_TERM(_ZBUS_CHAN_OBSERVATION, (;), _name, _observers)
 /* clang-format on */
 
+#if defined(CONFIG_ZBUS_SEQLOCK) || defined(__DOXYGEN__)
+
+/* clang-format off */
+/**
+ * @brief Zbus sequence locked channel definition.
+ *
+ * This macro defines a channel for read-mostly messages with a single publisher. The channel keeps
+ * two copies of the message. Publishing updates the copy not in use and then switches the copies,
+ * so zbus_chan_read() copies the current message without taking the channel lock and never
+ * blocks, also not while a publication is in progress. Publishers still exclude each other and
+ * runtime observer changes with the channel lock, but do not boost their priority. Claimed
+ * channels are still locked for publishing, but their message must not be changed.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list. The sequence indicates the priority of the observer. The
+ * first the highest priority.
+ * @param _init_val The message initialization.
+ */
+#define ZBUS_SEQLOCK_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val) \
+	static _type _CONCAT(_zbus_message_, _name)[2] = {_init_val, _init_val};           \
+	static struct zbus_channel_data _CONCAT(_zbus_chan_data_, _name) = {              \
+		.observers_start_idx = -1,                                                \
+		.observers_end_idx = -1,                                                  \
+		IF_ENABLED(CONFIG_ZBUS_PRIORITY_BOOST, (                                  \
+			.highest_observer_priority = ZBUS_MIN_THREAD_PRIORITY,            \
+		))                                                                        \
+	};                                                                                \
+	_ZBUS_CPP_EXTERN const STRUCT_SECTION_ITERABLE(zbus_channel, _name) = {           \
+		ZBUS_CHANNEL_NAME_INIT(_name) /* Maybe removed */                         \
+		.message = &_CONCAT(_zbus_message_, _name),                               \
+		.message_size = sizeof(_type),                                            \
+		.user_data = _user_data,                                                  \
+		.validator = _validator,                                                  \
+		.data = &_CONCAT(_zbus_chan_data_, _name),                                \
+		.seqlock = true,                                                          \
+	};                                                                                \
+	/* Extern declaration of observers */                                             \
+	ZBUS_OBS_DECLARE(_observers);                                                     \
+	/* Create all channel observations from observers list */                         \
+	FOR_EACH_FIXED_ARG_NONEMPTY_TERM(_ZBUS_CHAN_OBSERVATION, (;), _name, _observers)
+/* clang-format on */
+
+#endif /* CONFIG_ZBUS_SEQLOCK */
+
+#if defined(CONFIG_ZBUS_ZERO_COPY) || defined(__DOXYGEN__)
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct net_buf_data_cb _zbus_zc_data_cb;
+/** @endcond */
+
+/* clang-format off */
+/**
+ * @brief Zbus zero-copy channel definition.
+ *
+ * This macro defines a channel whose messages are net_bufs allocated from a pool owned by the
+ * channel. Publishers allocate a buffer with zbus_chan_buf_alloc(), fill it in place and publish
+ * it with zbus_chan_pub_buf(). Observers get references to the published data instead of copies,
+ * see zbus_chan_read_buf() and zbus_sub_wait_buf(). The data is reference counted and returned to
+ * the pool once the channel holds a newer message and all references are released.
+ *
+ * @param _name The channel's name.
+ * @param _buf_count Number of buffers in the pool. Every message held by the channel or an
+ * observer takes one.
+ * @param _data_size Total amount of memory available for message data.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list. The sequence indicates the priority of the observer. The
+ * first the highest priority.
+ */
+#define ZBUS_ZC_CHAN_DEFINE(_name, _buf_count, _data_size, _validator, _user_data, _observers) \
+	_NET_BUF_ARRAY_DEFINE(_zbus_zc_pool_##_name, _buf_count,                            \
+			      sizeof(struct zbus_channel *));                               \
+	K_HEAP_DEFINE(_zbus_zc_heap_##_name, _data_size);                                   \
+	static const struct net_buf_data_alloc _zbus_zc_alloc_##_name = {                   \
+		.cb = &_zbus_zc_data_cb,                                                    \
+		.alloc_data = &_zbus_zc_heap_##_name,                                       \
+		.max_alloc_size = 0,                                                        \
+	};                                                                                  \
+	static STRUCT_SECTION_ITERABLE(net_buf_pool, _zbus_zc_pool_##_name) =               \
+		NET_BUF_POOL_INITIALIZER(_zbus_zc_pool_##_name, &_zbus_zc_alloc_##_name,    \
+					 _net_buf__zbus_zc_pool_##_name, _buf_count,        \
+					 sizeof(struct zbus_channel *), NULL);              \
+	static struct net_buf *_CONCAT(_zbus_message_, _name);                              \
+	static struct zbus_channel_data _CONCAT(_zbus_chan_data_, _name) = {                \
+		.observers_start_idx = -1,                                                  \
+		.observers_end_idx = -1,                                                    \
+		IF_ENABLED(CONFIG_ZBUS_PRIORITY_BOOST, (                                    \
+			.highest_observer_priority = ZBUS_MIN_THREAD_PRIORITY,              \
+		))                                                                          \
+	};                                                                                  \
+	_ZBUS_CPP_EXTERN const STRUCT_SECTION_ITERABLE(zbus_channel, _name) = {             \
+		ZBUS_CHANNEL_NAME_INIT(_name) /* Maybe removed */                           \
+		.message = &_CONCAT(_zbus_message_, _name),                                 \
+		.message_size = sizeof(struct net_buf *),                                   \
+		.user_data = _user_data,                                                    \
+		.validator = _validator,                                                    \
+		.data = &_CONCAT(_zbus_chan_data_, _name),                                  \
+		.buf_pool = &_zbus_zc_pool_##_name,                                         \
+	};                                                                                  \
+	/* Extern declaration of observers */                                               \
+	ZBUS_OBS_DECLARE(_observers);                                                       \
+	/* Create all channel observations from observers list */                           \
+	FOR_EACH_FIXED_ARG_NONEMPTY_TERM(_ZBUS_CHAN_OBSERVATION, (;), _name, _observers)
+/* clang-format on */
+
+#endif /* CONFIG_ZBUS_ZERO_COPY */
+
 /**
  * @brief Initialize a message.
  *
@@ -592,6 +729,113 @@ int zbus_chan_finish(const struct zbus_channel *chan);
  */
 int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout);
 
+/**
+ * @brief Check if a channel is a zero-copy channel.
+ *
+ * @param chan The channel's reference.
+ *
+ * @retval true The channel was defined with ZBUS_ZC_CHAN_DEFINE().
+ * @retval false The channel copies its messages.
+ */
+static inline bool zbus_chan_is_zero_copy(const struct zbus_channel *chan)
+{
+	__ASSERT(chan != NULL, "chan is required");
+
+#if defined(CONFIG_ZBUS_ZERO_COPY)
+	return chan->buf_pool != NULL;
+#else
+	return false;
+#endif /* CONFIG_ZBUS_ZERO_COPY */
+}
+
+/**
+ * @brief Check if a channel is a sequence locked channel.
+ *
+ * @param chan The channel's reference.
+ *
+ * @retval true The channel was defined with ZBUS_SEQLOCK_CHAN_DEFINE().
+ * @retval false The channel's readers take the channel lock.
+ */
+static inline bool zbus_chan_is_seqlock(const struct zbus_channel *chan)
+{
+	__ASSERT(chan != NULL, "chan is required");
+
+#if defined(CONFIG_ZBUS_SEQLOCK)
+	return chan->seqlock;
+#else
+	return false;
+#endif /* CONFIG_ZBUS_SEQLOCK */
+}
+
+#if defined(CONFIG_ZBUS_ZERO_COPY) || defined(__DOXYGEN__)
+
+/**
+ * @brief Allocate a message buffer for a zero-copy channel
+ *
+ * This routine allocates a buffer from the channel's pool. The publisher fills the message in
+ * place and publishes it with zbus_chan_pub_buf(), or releases it with net_buf_unref().
+ *
+ * @param[in] chan The zero-copy channel's reference.
+ * @param[in] size The message size.
+ * @param[out] buf The allocated buffer.
+ * @param[in] timeout Waiting period to allocate the buffer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Buffer allocated.
+ * @retval -ENOMEM No buffer available within the waiting period.
+ * @retval -EFAULT A parameter is incorrect, or the channel is not a zero-copy channel. The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_buf_alloc(const struct zbus_channel *chan, size_t size, struct net_buf **buf,
+			k_timeout_t timeout);
+
+/**
+ * @brief Publish a buffer to a zero-copy channel
+ *
+ * This routine makes @a buf the channel's message and notifies the observers. Listeners can
+ * access the buffer with zbus_chan_const_msg(), message subscribers receive a reference to its
+ * data. The channel takes over the caller's reference, also when the publication fails, and the
+ * buffer must not be changed anymore.
+ *
+ * @param chan The zero-copy channel's reference.
+ * @param buf The buffer, allocated with zbus_chan_buf_alloc().
+ * @param timeout Waiting period to publish the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel published.
+ * @retval -ENOMSG The message is invalid based on the validator function.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -ENOMEM A message subscriber could not get a reference.
+ * @retval -EFAULT A parameter is incorrect, or the channel is not a zero-copy channel. The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_pub_buf(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout);
+
+/**
+ * @brief Get a reference to the message of a zero-copy channel
+ *
+ * This routine returns a new reference to the data of the channel's last published message. The
+ * data must not be changed and the reference must be released with net_buf_unref().
+ *
+ * @param[in] chan The zero-copy channel's reference.
+ * @param[out] buf The message reference.
+ * @param[in] timeout Waiting period to read the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel read.
+ * @retval -ENODATA Nothing was published to the channel yet.
+ * @retval -ENOMEM No buffer available for the reference.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the channel is not a zero-copy channel. The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_read_buf(const struct zbus_channel *chan, struct net_buf **buf,
+		       k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_ZERO_COPY */
+
 #if defined(CONFIG_ZBUS_CHANNEL_NAME) || defined(__DOXYGEN__)
 
 /**
@@ -628,6 +872,14 @@ static inline void *zbus_chan_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_SEQLOCK)
+	if (chan->seqlock) {
+		atomic_val_t seq = atomic_get(&chan->data->seq);
+
+		return (uint8_t *)chan->message + ((seq >> 1) & 1) * chan->message_size;
+	}
+#endif /* CONFIG_ZBUS_SEQLOCK */
+
 	return chan->message;
 }
 
@@ -649,7 +901,7 @@ static inline const void *zbus_chan_const_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
-	return chan->message;
+	return zbus_chan_msg(chan);
 }
 
 /**
@@ -893,6 +1145,28 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout);
 
+/**
+ * @brief Wait for a channel message buffer.
+ *
+ * This routine makes the subscriber wait for the new message in case of channel publication, and
+ * hands over the buffer holding it instead of copying the message. For zero-copy channels the
+ * buffer references the published data, which must not be changed. The buffer must be released
+ * with net_buf_unref().
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The buffer holding the published message.
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Could not retrieve the net_buf from the subscriber FIFO.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+		      struct net_buf **buf, k_timeout_t timeout);
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 /**
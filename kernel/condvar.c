@@ -8,6 +8,7 @@
 #include <zephyr/kernel_structs.h>
 #include <zephyr/toolchain.h>
 #include <ksched.h>
+#include <kernel_internal.h>
 #include <wait_q.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/init.h>
@@ -83,6 +84,22 @@ int z_impl_k_condvar_broadcast(struct k_condvar *condvar)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_condvar, broadcast, condvar);
 
+	/* Only the first waiter can get the mutex right away. Rather than
+	 * waking up the others just to have them block on the mutex, move
+	 * them over to the mutex wait queue.
+	 */
+	pending_thread = z_unpend_first_thread(&condvar->wait_q);
+	if (pending_thread != NULL) {
+		woken++;
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+
+		if (pending_thread->base.swap_data != NULL) {
+			woken += z_mutex_requeue(pending_thread->base.swap_data,
+						 &condvar->wait_q);
+		}
+	}
+
 	/* wake up any threads that are waiting to write */
 	for (pending_thread = z_unpend_first_thread(&condvar->wait_q); pending_thread != NULL;
 		 pending_thread = z_unpend_first_thread(&condvar->wait_q)) {
@@ -115,10 +132,19 @@ int z_impl_k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_condvar, wait, condvar);
 
 	key = k_spin_lock(&lock);
+
+	/* Tell k_condvar_broadcast() which mutex to requeue this thread on,
+	 * unless it keeps holding a recursively locked mutex.
+	 */
+	_current->base.swap_data = (mutex->lock_count > 1U) ? NULL : mutex;
 	k_mutex_unlock(mutex);
 
 	ret = z_pend_curr(&lock, key, &condvar->wait_q, timeout);
-	k_mutex_lock(mutex, K_FOREVER);
+
+	/* A requeued thread is handed the mutex by its owner. */
+	if ((_current->base.swap_data == NULL) || (mutex->owner != _current)) {
+		k_mutex_lock(mutex, K_FOREVER);
+	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_condvar, wait, condvar, ret);
 
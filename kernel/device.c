@@ -1,11 +1,13 @@
 /*
  * Copyright (c) 2015-2016 Intel Corporation.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <string.h>
 #include <zephyr/device.h>
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/kobject.h>
@@ -25,6 +27,102 @@ void z_device_state_init(void)
 	}
 }
 
+#ifdef CONFIG_DEVICE_NAME_INDEX
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_DEVICE_NAME_INDEX_SIZE),
+	     "Device name index size must be a power of two");
+
+#define NAME_INDEX_MASK (CONFIG_DEVICE_NAME_INDEX_SIZE - 1)
+
+/*
+ * Open addressing hash table of the static device handles, linearly
+ * probed and keyed by device name. Devices sharing a name are met in
+ * section order along a probe sequence. Built on first use, as device
+ * names never change.
+ */
+static device_handle_t name_index[CONFIG_DEVICE_NAME_INDEX_SIZE];
+static atomic_t name_index_state;
+static struct k_spinlock name_index_lock;
+
+enum {
+	NAME_INDEX_EMPTY,
+	NAME_INDEX_READY,
+	/* More devices than slots, search linearly */
+	NAME_INDEX_TOO_SMALL,
+};
+
+/* FNV-1a */
+static uint32_t name_hash(const char *name)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash = (hash ^ (uint8_t)*name++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void name_index_build(void)
+{
+	size_t count;
+
+	STRUCT_SECTION_COUNT(device, &count);
+	if (count >= CONFIG_DEVICE_NAME_INDEX_SIZE) {
+		atomic_set(&name_index_state, NAME_INDEX_TOO_SMALL);
+		return;
+	}
+
+	STRUCT_SECTION_FOREACH(device, dev) {
+		uint32_t i = name_hash(dev->name) & NAME_INDEX_MASK;
+
+		while (name_index[i] != 0) {
+			i = (i + 1U) & NAME_INDEX_MASK;
+		}
+
+		name_index[i] = device_handle_get(dev);
+	}
+
+	atomic_set(&name_index_state, NAME_INDEX_READY);
+}
+
+static bool name_index_get(const char *name, const struct device **found)
+{
+	uint32_t home;
+
+	if (atomic_get(&name_index_state) == NAME_INDEX_EMPTY) {
+		K_SPINLOCK(&name_index_lock) {
+			if (atomic_get(&name_index_state) == NAME_INDEX_EMPTY) {
+				name_index_build();
+			}
+		}
+	}
+
+	if (atomic_get(&name_index_state) != NAME_INDEX_READY) {
+		return false;
+	}
+
+	/* Same precedence as the linear search: pointers first */
+	home = name_hash(name) & NAME_INDEX_MASK;
+	for (int pass = 0; pass < 2; pass++) {
+		for (uint32_t i = home; name_index[i] != 0; i = (i + 1U) & NAME_INDEX_MASK) {
+			const struct device *dev = device_from_handle(name_index[i]);
+
+			if (!z_device_is_ready(dev)) {
+				continue;
+			}
+
+			if ((pass == 0) ? (dev->name == name) : (strcmp(name, dev->name) == 0)) {
+				*found = dev;
+				return true;
+			}
+		}
+	}
+
+	*found = NULL;
+	return true;
+}
+#endif /* CONFIG_DEVICE_NAME_INDEX */
+
 const struct device *z_impl_device_get_binding(const char *name)
 {
 	/* A null string identifies no device.  So does an empty
@@ -34,6 +132,14 @@ const struct device *z_impl_device_get_binding(const char *name)
 		return NULL;
 	}
 
+#ifdef CONFIG_DEVICE_NAME_INDEX
+	const struct device *found;
+
+	if (name_index_get(name, &found)) {
+		return found;
+	}
+#endif /* CONFIG_DEVICE_NAME_INDEX */
+
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
@@ -1,11 +1,13 @@
 /*
  * Copyright (c) 2022, Meta
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include "kernel_internal.h"
 
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <ksched.h>
 #include <zephyr/kernel/thread_stack.h>
@@ -31,6 +33,21 @@ static K_THREAD_STACK_ARRAY_DEFINE(dynamic_stack, CONFIG_DYNAMIC_THREAD_POOL_SIZ
 				   CONFIG_DYNAMIC_THREAD_STACK_SIZE);
 SYS_BITARRAY_DEFINE_STATIC(dynamic_ba, BA_SIZE);
 
+#if defined(CONFIG_INIT_STACKS_LAZY) && (CONFIG_DYNAMIC_THREAD_POOL_SIZE > 0)
+/* Paint the pool stacks once, thread creation then only repaints what was used */
+static int dynamic_stack_paint(void)
+{
+	for (size_t i = 0; i < CONFIG_DYNAMIC_THREAD_POOL_SIZE; i++) {
+		(void)memset(K_THREAD_STACK_BUFFER(dynamic_stack[i]), 0xaa,
+			     K_THREAD_STACK_SIZEOF(dynamic_stack[i]));
+	}
+
+	return 0;
+}
+
+SYS_INIT(dynamic_stack_paint, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_INIT_STACKS_LAZY && CONFIG_DYNAMIC_THREAD_POOL_SIZE > 0 */
+
 static k_thread_stack_t *z_thread_stack_alloc_dyn(size_t align, size_t size)
 {
 	return z_thread_aligned_alloc(align, size);
@@ -222,6 +222,11 @@ void z_mem_manage_boot_finish(void);
 
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state);
 
+/* Move the threads waiting on @wait_q for @mutex over to the mutex wait
+ * queue, if the mutex is locked. Returns the number of threads moved.
+ */
+int z_mutex_requeue(struct k_mutex *mutex, _wait_q_t *wait_q);
+
 #ifdef CONFIG_PM
 
 /* When the kernel is about to go idle, it calls this function to notify the
@@ -245,6 +250,18 @@ bool pm_system_suspend(int32_t ticks);
 
 #endif /* CONFIG_PM */
 
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+/**
+ * Find the registered paging statistics region containing an address.
+ *
+ * Must be called with interrupts locked.
+ *
+ * @param addr Virtual address
+ * @return Statistics of the region, NULL if the address is in none
+ */
+struct k_mem_paging_stats_t *z_paging_region_stats_find(void *addr);
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 /**
  * Initialize the timing histograms for demand paging.
@@ -50,6 +50,11 @@ void z_pend_thread(struct k_thread *thread, _wait_q_t *wait_q,
 void z_reschedule(struct k_spinlock *lock, k_spinlock_key_t key);
 void z_reschedule_irqlock(uint32_t key);
 struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q);
+/* Move the first thread pending on @from over to @to without waking it,
+ * if its swap_data matches. Returns the thread moved or NULL.
+ */
+struct k_thread *z_requeue_first_thread(_wait_q_t *from, _wait_q_t *to,
+					void *swap_data);
 void z_unpend_thread(struct k_thread *thread);
 int z_unpend_all(_wait_q_t *wait_q);
 bool z_thread_prio_set(struct k_thread *thread, int prio);
@@ -284,6 +289,21 @@ void z_sched_usage_stop(void);
 
 void z_sched_usage_start(struct k_thread *thread);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+/**
+ * @brief Stamp a thread that just became ready to run
+ *
+ * Called with the scheduler lock held whenever a thread is added to
+ * the run queue, the wait is accounted once the thread is switched in.
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+
+/**
+ * @brief Account a thread switched out while still runnable
+ */
+void z_sched_usage_preempted(struct k_thread *thread);
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 /**
  * @brief Retrieves CPU cycle usage data for specified core
  */
@@ -298,6 +318,11 @@ void z_sched_thread_usage(struct k_thread *thread,
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	if ((thread != _current) && z_is_thread_ready(_current)) {
+		z_sched_usage_preempted(_current);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
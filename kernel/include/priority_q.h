@@ -9,11 +9,13 @@
 
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/dlist.h>
+#include <zephyr/sys/pheap.h>
 
 extern int32_t z_sched_prio_cmp(struct k_thread *thread_1,
 	struct k_thread *thread_2);
 
 bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
+bool z_priq_pheap_lessthan(struct pheap_node *a, struct pheap_node *b);
 
 /* Dumb Scheduling */
 #if defined(CONFIG_SCHED_DUMB)
@@ -29,6 +31,11 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 #define _priq_run_add		z_priq_rb_add
 #define _priq_run_remove	z_priq_rb_remove
 #define _priq_run_best		z_priq_rb_best
+/* Pairing Heap Scheduling */
+#elif defined(CONFIG_SCHED_PAIRING_HEAP)
+#define _priq_run_add		z_priq_pheap_add
+#define _priq_run_remove	z_priq_pheap_remove
+#define _priq_run_best		z_priq_pheap_best
  /* Multi Queue Scheduling */
 #elif defined(CONFIG_SCHED_MULTIQ)
 
@@ -116,6 +123,59 @@ static ALWAYS_INLINE struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
+#ifdef CONFIG_SCHED_PAIRING_HEAP
+static ALWAYS_INLINE void z_priq_pheap_add(struct _priq_pheap *pq, struct k_thread *thread)
+{
+	struct pheap_node *n, *renumber = NULL, **tail = &renumber;
+
+	thread->base.order_key = pq->next_order_key++;
+
+	/* Renumber at wraparound, as with the rbtree.  The heap has no
+	 * ordered iteration, so the threads are taken out in order and
+	 * put back with their new keys, which is O(NlogN) but in
+	 * practice will almost never be hit on real systems.
+	 */
+	if (!pq->next_order_key) {
+		while ((n = pheap_get_min(&pq->heap)) != NULL) {
+			pheap_remove(&pq->heap, n);
+			n->next = NULL;
+			*tail = n;
+			tail = &n->next;
+		}
+
+		while (renumber != NULL) {
+			n = renumber;
+			renumber = n->next;
+			CONTAINER_OF(n, struct k_thread, base.qnode_pheap)->base.order_key =
+				pq->next_order_key++;
+			pheap_insert(&pq->heap, n);
+		}
+	}
+
+	pheap_insert(&pq->heap, &thread->base.qnode_pheap);
+}
+
+static ALWAYS_INLINE void z_priq_pheap_remove(struct _priq_pheap *pq, struct k_thread *thread)
+{
+	pheap_remove(&pq->heap, &thread->base.qnode_pheap);
+
+	if (pheap_is_empty(&pq->heap)) {
+		pq->next_order_key = 0;
+	}
+}
+
+static ALWAYS_INLINE struct k_thread *z_priq_pheap_best(struct _priq_pheap *pq)
+{
+	struct k_thread *thread = NULL;
+	struct pheap_node *n = pheap_get_min(&pq->heap);
+
+	if (n != NULL) {
+		thread = CONTAINER_OF(n, struct k_thread, base.qnode_pheap);
+	}
+	return thread;
+}
+#endif /* CONFIG_SCHED_PAIRING_HEAP */
+
 static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 {
 	struct k_thread *thread = NULL;
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2010-2014 Wind River Systems, Inc.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -307,6 +308,9 @@ static int do_device_init(const struct init_entry *entry)
 {
 	const struct device *dev = entry->dev;
 	int rc = 0;
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	uint32_t start = k_cycle_get_32();
+#endif /* CONFIG_DEVICE_INIT_PROFILE */
 
 	if (entry->init_fn.dev != NULL) {
 		rc = entry->init_fn.dev(dev);
@@ -326,6 +330,11 @@ static int do_device_init(const struct init_entry *entry)
 
 	dev->state->initialized = true;
 
+#ifdef CONFIG_DEVICE_INIT_PROFILE
+	LOG_INF("%s: init took %u us (%d)", dev->name,
+		k_cyc_to_us_floor32(k_cycle_get_32() - start), -rc);
+#endif /* CONFIG_DEVICE_INIT_PROFILE */
+
 	if (rc == 0) {
 		/* Run automatic device runtime enablement */
 		(void)pm_device_runtime_auto_enable(dev);
@@ -334,6 +343,120 @@ static int do_device_init(const struct init_entry *entry)
 	return rc;
 }
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/*
+ * Device entries are handed to the init threads in the order of the
+ * level, each one as soon as the devices it requires and that come
+ * before it in the level have been initialized. Other entries wait for
+ * every device handed out before them to be done, and run in the
+ * calling thread.
+ */
+#define INIT_THREADS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, INIT_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[INIT_THREADS];
+static K_MSGQ_DEFINE(init_queue, sizeof(const struct init_entry *), INIT_THREADS,
+	      sizeof(void *));
+static K_SEM_DEFINE(init_done, 0, K_SEM_MAX_LIMIT);
+static atomic_t init_pending;
+
+/* Entries of the level handed out so far */
+struct init_run {
+	const struct init_entry *start;
+	const struct init_entry *end;
+};
+
+static void init_thread_main(void *unused1, void *unused2, void *unused3)
+{
+	const struct init_entry *entry;
+
+	ARG_UNUSED(unused1);
+	ARG_UNUSED(unused2);
+	ARG_UNUSED(unused3);
+
+	while (true) {
+		(void)k_msgq_get(&init_queue, &entry, K_FOREVER);
+		if (entry == NULL) {
+			z_thread_essential_clear(_current);
+			return;
+		}
+
+		(void)do_device_init(entry);
+
+		atomic_dec(&init_pending);
+		k_sem_give(&init_done);
+	}
+}
+
+static int init_dep_pending(const struct device *dev, void *context)
+{
+	const struct init_run *run = context;
+
+	/* Required devices not handed out yet are left to their own level */
+	for (const struct init_entry *entry = run->start; entry < run->end; entry++) {
+		if (entry->dev == dev) {
+			return dev->state->initialized ? 0 : -EBUSY;
+		}
+	}
+
+	return 0;
+}
+
+static void init_wait_all(void)
+{
+	while (atomic_get(&init_pending) != 0) {
+		(void)k_sem_take(&init_done, K_FOREVER);
+	}
+}
+
+static void z_sys_init_run_level_parallel(enum init_level level,
+					  const struct init_entry *start,
+					  const struct init_entry *end)
+{
+	struct init_run run = { .start = start, .end = start };
+	const struct init_entry *stop = NULL;
+
+	if (level == INIT_LEVEL_POST_KERNEL) {
+		for (int i = 0; i < INIT_THREADS; i++) {
+			k_thread_create(&init_threads[i], init_stacks[i],
+					K_THREAD_STACK_SIZEOF(init_stacks[i]),
+					init_thread_main, NULL, NULL, NULL,
+					CONFIG_MAIN_THREAD_PRIORITY, K_ESSENTIAL, K_NO_WAIT);
+			k_thread_name_set(&init_threads[i], "dev_init");
+		}
+	}
+
+	for (const struct init_entry *entry = start; entry < end; entry++) {
+		if (entry->dev == NULL) {
+			init_wait_all();
+			(void)entry->init_fn.sys();
+			continue;
+		}
+
+		run.end = entry;
+		while (device_required_foreach(entry->dev, init_dep_pending, &run) < 0) {
+			(void)k_sem_take(&init_done, K_FOREVER);
+		}
+
+		atomic_inc(&init_pending);
+		(void)k_msgq_put(&init_queue, &entry, K_FOREVER);
+	}
+
+	init_wait_all();
+
+	if (level == INIT_LEVEL_APPLICATION) {
+		for (int i = 0; i < INIT_THREADS; i++) {
+			(void)k_msgq_put(&init_queue, &stop, K_FOREVER);
+		}
+
+		for (int i = 0; i < INIT_THREADS; i++) {
+			(void)k_thread_join(&init_threads[i], K_FOREVER);
+		}
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -361,6 +484,13 @@ static void z_sys_init_run_level(enum init_level level)
 	};
 	const struct init_entry *entry;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if ((level == INIT_LEVEL_POST_KERNEL) || (level == INIT_LEVEL_APPLICATION)) {
+		z_sys_init_run_level_parallel(level, levels[level], levels[level+1]);
+		return;
+	}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
 		const struct device *dev = entry->dev;
 
@@ -1,5 +1,6 @@
 /**
  * Copyright (c) 2024 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -13,15 +14,52 @@ extern void z_trace_sched_ipi(void);
 #endif
 
 
-void flag_ipi(void)
+void flag_ipi(uint32_t ipi_mask)
 {
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		_kernel.pending_ipi = true;
+		atomic_or(&_kernel.pending_ipi, (atomic_val_t)ipi_mask);
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
 }
 
+/* Create a bitmask of CPUs that need an IPI. Note: sched_spinlock is held. */
+uint32_t ipi_mask_create(struct k_thread *thread)
+{
+	if (!IS_ENABLED(CONFIG_IPI_OPTIMIZE)) {
+		return IPI_ALL_CPUS_MASK;
+	}
+
+	uint32_t ipi_mask = 0;
+	uint32_t num_cpus = (uint32_t)arch_num_cpus();
+	uint32_t id = _current_cpu->id;
+	struct k_thread *cpu_thread;
+	bool executable_on_cpu = true;
+
+	for (uint32_t i = 0; i < num_cpus; i++) {
+		if (id == i) {
+			continue;
+		}
+
+		/*
+		 * An IPI only helps a CPU running a thread of lower priority
+		 * than the one readied, which is allowed to run there.
+		 */
+		cpu_thread = _kernel.cpus[i].current;
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		executable_on_cpu = ((thread->base.cpu_mask & BIT(i)) != 0);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+		if ((cpu_thread != NULL) && executable_on_cpu &&
+		    (z_sched_prio_cmp(thread, cpu_thread) > 0)) {
+			ipi_mask |= BIT(i);
+		}
+	}
+
+	return ipi_mask;
+}
+
 
 void signal_pending_ipi(void)
 {
@@ -34,9 +72,15 @@ void signal_pending_ipi(void)
 	 */
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
+		uint32_t cpu_bitmap;
+
+		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+		if (cpu_bitmap != 0) {
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+			arch_sched_directed_ipi(cpu_bitmap);
+#else
 			arch_sched_ipi();
+#endif /* CONFIG_ARCH_HAS_DIRECTED_IPIS */
 		}
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
@@ -68,6 +68,20 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (align <= sizeof(void *)) {
+		ret = sys_heap_cache_alloc(&heap->heap, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+			return ret;
+		}
+
+		/* Allocate a whole size class so the block can be cached */
+		bytes = sys_heap_cache_bytes(bytes);
+	}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -79,6 +93,13 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+		/* Memory held in this CPU's cache may be enough */
+		if ((ret == NULL) && sys_heap_cache_flush(&heap->heap)) {
+			continue;
+		}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -148,6 +169,18 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Threads waiting for memory need a real free to wake them up.
+	 * The unlocked check can miss a waiter that is just about to
+	 * pend, which then waits for the next free or its timeout.
+	 */
+	if ((!IS_ENABLED(CONFIG_MULTITHREADING) || (z_waitq_head(&heap->wait_q) == NULL)) &&
+	    sys_heap_cache_free(&heap->heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
@@ -33,6 +33,9 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_CACHE
+	((struct k_mem_slab_info *)stats)->num_cached = z_mem_slab_num_cached(slab);
+#endif /* CONFIG_MEM_SLAB_CACHE */
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +51,8 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -179,6 +181,9 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->buffer = buffer;
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MEM_SLAB_CACHE
+	slab->cache = NULL;
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
@@ -205,13 +210,193 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+static void slab_free(struct k_mem_slab *slab, void *mem)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0, mem);
+			z_ready_thread(pending_thread);
+			z_reschedule(&slab->lock, key);
+			return;
+		}
+	}
+	*(char **) mem = slab->free_list;
+	slab->free_list = (char *) mem;
+	slab->info.num_used--;
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+static inline struct k_mem_slab_magazine *cpu_magazine(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_SMP
+	return &slab->cache->mag[arch_curr_cpu()->id];
+#else
+	return &slab->cache->mag[0];
+#endif /* CONFIG_SMP */
+}
+
+/* Move up to half a magazine of blocks from the slab's free list to @a mag,
+ * which must be locked by the caller.
+ */
+static void cache_refill(struct k_mem_slab *slab, struct k_mem_slab_magazine *mag)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	while ((mag->count < (CONFIG_MEM_SLAB_CACHE_SIZE / 2)) &&
+	       (slab->free_list != NULL)) {
+		mag->rounds[mag->count++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->info.num_used++;
+	}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = MAX(slab->info.num_used, slab->info.max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct k_mem_slab_magazine *mag = cpu_magazine(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool ret = false;
+
+	if (mag->count == 0U) {
+		cache_refill(slab, mag);
+	}
+
+	if (mag->count > 0U) {
+		*mem = mag->rounds[--mag->count];
+		ret = true;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	void *spill[CONFIG_MEM_SLAB_CACHE_SIZE / 2];
+	struct k_mem_slab_magazine *mag;
+	k_spinlock_key_t key;
+	uint32_t num_spill = 0U;
+
+	/* Let the slab hand the block to a waiting thread. A thread that
+	 * starts waiting concurrently is served by the next free.
+	 */
+	if (z_waitq_head(&slab->wait_q) != NULL) {
+		return false;
+	}
+
+	mag = cpu_magazine(slab);
+	key = k_spin_lock(&mag->lock);
+
+	if (mag->count == CONFIG_MEM_SLAB_CACHE_SIZE) {
+		num_spill = ARRAY_SIZE(spill);
+		mag->count -= num_spill;
+		memcpy(spill, &mag->rounds[mag->count], sizeof(spill));
+	}
+	mag->rounds[mag->count++] = mem;
+
+	k_spin_unlock(&mag->lock, key);
+
+	for (uint32_t i = 0U; i < num_spill; i++) {
+		slab_free(slab, spill[i]);
+	}
+
+	return true;
+}
+
+/* Return the blocks cached by all CPUs to the slab */
+static void cache_drain(struct k_mem_slab *slab)
+{
+	void *blocks[CONFIG_MEM_SLAB_CACHE_SIZE];
+
+	for (unsigned int cpu = 0U; cpu < ARRAY_SIZE(slab->cache->mag); cpu++) {
+		struct k_mem_slab_magazine *mag = &slab->cache->mag[cpu];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+		uint32_t count = mag->count;
+
+		memcpy(blocks, mag->rounds, count * sizeof(void *));
+		mag->count = 0U;
+
+		k_spin_unlock(&mag->lock, key);
+
+		for (uint32_t i = 0U; i < count; i++) {
+			slab_free(slab, blocks[i]);
+		}
+	}
+}
+
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t num_cached = 0U;
+
+	if (slab->cache == NULL) {
+		return 0U;
+	}
+
+	/* Unlocked snapshot, only meant for statistics */
+	for (unsigned int cpu = 0U; cpu < ARRAY_SIZE(slab->cache->mag); cpu++) {
+		num_cached += *(volatile uint32_t *)&slab->cache->mag[cpu].count;
+	}
+
+	return num_cached;
+}
+
+int k_mem_slab_cache_attach(struct k_mem_slab *slab,
+			    struct k_mem_slab_cache *cache)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	int ret = 0;
+
+	if ((slab->cache != NULL) || (slab->info.num_used != 0U)) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	for (unsigned int cpu = 0U; cpu < ARRAY_SIZE(cache->mag); cpu++) {
+		cache->mag[cpu].lock = (struct k_spinlock) {};
+		cache->mag[cpu].count = 0U;
+	}
+	slab->cache = cache;
+
+out:
+	k_spin_unlock(&slab->lock, key);
+
+	return ret;
+}
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if (slab->cache != NULL) {
+		if (cache_alloc(slab, mem)) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+			return 0;
+		}
+
+		/* The slab ran empty, take back what other CPUs hold */
+		cache_drain(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -252,8 +437,6 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-
 	__ASSERT(((char *)mem >= slab->buffer) &&
 		 ((((char *)mem - slab->buffer) % slab->info.block_size) == 0) &&
 		 ((char *)mem <= (slab->buffer + (slab->info.block_size *
@@ -261,25 +444,17 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		 "Invalid memory pointer provided");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
-	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
-		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
-
-		if (pending_thread != NULL) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
-			z_thread_return_value_set_with_data(pending_thread, 0, mem);
-			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
-		}
+#ifdef CONFIG_MEM_SLAB_CACHE
+	if ((slab->cache != NULL) && cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
 	}
-	*(char **) mem = slab->free_list;
-	slab->free_list = (char *) mem;
-	slab->info.num_used--;
+#endif /* CONFIG_MEM_SLAB_CACHE */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
-	k_spin_unlock(&slab->lock, key);
+	slab_free(slab, mem);
 }
 
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
@@ -290,9 +465,9 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) *
+				 slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -1332,7 +1332,7 @@ out:
 }
 
 static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
-					   int key)
+					   void *addr, int key)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
 	bool is_irq_unlocked = arch_irq_unlocked(key);
@@ -1345,6 +1345,22 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 		paging_stats.pagefaults.irq_locked++;
 	}
 
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+	struct k_mem_paging_stats_t *region_stats = z_paging_region_stats_find(addr);
+
+	if (region_stats != NULL) {
+		region_stats->pagefaults.cnt++;
+
+		if (is_irq_unlocked) {
+			region_stats->pagefaults.irq_unlocked++;
+		} else {
+			region_stats->pagefaults.irq_locked++;
+		}
+	}
+#else
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
+
 #ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
 	faulting_thread->paging_stats.pagefaults.cnt++;
 
@@ -1364,13 +1380,19 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
 		faulting_thread->paging_stats.pagefaults.in_isr++;
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+		if (region_stats != NULL) {
+			region_stats->pagefaults.in_isr++;
+		}
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
 	}
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
-					     bool dirty)
+					     void *evicted, bool dirty)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
 	if (dirty) {
@@ -1387,9 +1409,47 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #else
 	ARG_UNUSED(faulting_thread);
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+	struct k_mem_paging_stats_t *region_stats = z_paging_region_stats_find(evicted);
+
+	if (region_stats != NULL) {
+		if (dirty) {
+			region_stats->eviction.dirty++;
+		} else {
+			region_stats->eviction.clean++;
+		}
+	}
+#else
+	ARG_UNUSED(evicted);
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_prefetch_inc(struct k_thread *faulting_thread,
+					     void *addr)
+{
+#if defined(CONFIG_DEMAND_PAGING_STATS) && defined(CONFIG_DEMAND_PAGING_PREFETCH)
+	paging_stats.prefetch.pages++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.prefetch.pages++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+	struct k_mem_paging_stats_t *region_stats = z_paging_region_stats_find(addr);
+
+	if (region_stats != NULL) {
+		region_stats->prefetch.pages++;
+	}
+#else
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_STATS && CONFIG_DEMAND_PAGING_PREFETCH */
+}
+
 static inline struct z_page_frame *do_eviction_select(bool *dirty)
 {
 	struct z_page_frame *pf;
@@ -1424,16 +1484,118 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+/* Load a paged out data page into a free or evicted page frame. Called
+ * and returns with interrupts locked, but may unlock them in between if
+ * CONFIG_DEMAND_PAGING_ALLOW_IRQ is enabled.
+ */
+static struct z_page_frame *page_in_locked(void *addr, uintptr_t page_in_location,
+					   int *key, struct k_thread *faulting_thread)
 {
 	struct z_page_frame *pf;
-	int key, ret;
-	uintptr_t page_in_location, page_out_location;
+	uintptr_t page_out_location;
+	bool dirty = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx",
+			z_page_frame_to_virt(pf),
+			z_page_frame_to_phys(pf));
+
+		paging_stats_eviction_inc(faulting_thread,
+					  z_page_frame_to_virt(pf), dirty);
+	}
+	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(*key);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key = irq_lock();
+	z_page_frame_clear(pf, Z_PAGE_FRAME_BUSY);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	z_page_frame_clear(pf, Z_PAGE_FRAME_MAPPED);
+	frame_mapped_set(pf, addr);
+
+	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+
+	return pf;
+}
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+/* Page in the paged out data pages following a faulting one, stopping at
+ * the first page that isn't mapped.
+ */
+static void prefetch_locked(void *addr, struct z_page_frame *pf, int *key,
+			    struct k_thread *faulting_thread)
+{
+	struct z_page_frame *batch[CONFIG_DEMAND_PAGING_PREFETCH_PAGES + 1];
+	uint8_t *next = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr),
+						   CONFIG_MMU_PAGE_SIZE));
+	enum arch_page_location status;
+	uintptr_t location;
+	size_t count = 0;
+
+	/* Mark the loaded page frames busy so that the eviction algorithm
+	 * does not pick them to make room for the rest of the batch.
+	 */
+	z_page_frame_set(pf, Z_PAGE_FRAME_BUSY);
+	batch[count++] = pf;
+
+	for (size_t i = 0; i < CONFIG_DEMAND_PAGING_PREFETCH_PAGES; i++) {
+		next += CONFIG_MMU_PAGE_SIZE;
+		if ((next < Z_VIRT_RAM_START) || (next >= Z_VIRT_RAM_END)) {
+			break;
+		}
+
+		status = arch_page_location_get(next, &location);
+		if (status == ARCH_PAGE_LOCATION_BAD) {
+			break;
+		}
+		if (status == ARCH_PAGE_LOCATION_PAGED_IN) {
+			continue;
+		}
+
+		LOG_DBG("prefetching %p", next);
+
+		pf = page_in_locked(next, location, key, faulting_thread);
+		z_page_frame_set(pf, Z_PAGE_FRAME_BUSY);
+		batch[count++] = pf;
+
+		paging_stats_prefetch_inc(faulting_thread, next);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		z_page_frame_clear(batch[i], Z_PAGE_FRAME_BUSY);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
+static bool do_page_fault(void *addr, bool pin, bool prefetch)
+{
+	struct z_page_frame *pf;
+	int key;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
 
+	ARG_UNUSED(prefetch);
+
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
 
@@ -1503,46 +1665,18 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	paging_stats_faults_inc(faulting_thread, key);
-
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx",
-			z_page_frame_to_virt(pf),
-			z_page_frame_to_phys(pf));
-
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	irq_unlock(key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
+	paging_stats_faults_inc(faulting_thread, addr, key);
 
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = irq_lock();
-	z_page_frame_clear(pf, Z_PAGE_FRAME_BUSY);
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	z_page_frame_clear(pf, Z_PAGE_FRAME_MAPPED);
-	frame_mapped_set(pf, addr);
+	pf = page_in_locked(addr, page_in_location, &key, faulting_thread);
 	if (pin) {
 		z_page_frame_set(pf, Z_PAGE_FRAME_PINNED);
 	}
 
-	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	if (prefetch) {
+		prefetch_locked(addr, pf, &key, faulting_thread);
+	}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -1556,7 +1690,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1573,7 +1707,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1588,7 +1722,7 @@ void k_mem_pin(void *addr, size_t size)
 
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	return do_page_fault(addr, false, true);
 }
 
 static void do_mem_unpin(void *addr)
@@ -29,12 +29,12 @@
 static struct k_obj_type obj_type_msgq;
 #endif /* CONFIG_OBJ_CORE_MSGQ */
 
-#ifdef CONFIG_POLL
+#if defined(CONFIG_POLL) && !defined(CONFIG_MSGQ_LOCKFREE)
 static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 {
 	z_handle_obj_poll_events(&msgq->poll_events, state);
 }
-#endif /* CONFIG_POLL */
+#endif /* CONFIG_POLL && !CONFIG_MSGQ_LOCKFREE */
 
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
@@ -48,6 +48,15 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+#ifdef CONFIG_MSGQ_LOCKFREE
+	z_waitq_init(&msgq->put_wait_q);
+	atomic_set(&msgq->wr_head, 0);
+	atomic_set(&msgq->wr_tail, 0);
+	atomic_set(&msgq->rd_head, 0);
+	atomic_set(&msgq->rd_tail, 0);
+	atomic_set(&msgq->waiters, 0);
+	msgq->wrap = Z_MSGQ_WRAP(max_msgs);
+#endif /* CONFIG_MSGQ_LOCKFREE */
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
@@ -104,6 +113,14 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, cleanup, msgq);
 
+#ifdef CONFIG_MSGQ_LOCKFREE
+	CHECKIF(z_waitq_head(&msgq->put_wait_q) != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
+
+		return -EBUSY;
+	}
+#endif /* CONFIG_MSGQ_LOCKFREE */
+
 	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
 
@@ -121,6 +138,7 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+#ifndef CONFIG_MSGQ_LOCKFREE
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -183,6 +201,8 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	return result;
 }
 
+#endif /* !CONFIG_MSGQ_LOCKFREE */
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_put(struct k_msgq *msgq, const void *data,
 				    k_timeout_t timeout)
@@ -199,7 +219,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -213,6 +233,7 @@ static inline void z_vrfy_k_msgq_get_attrs(struct k_msgq *msgq,
 #include <zephyr/syscalls/k_msgq_get_attrs_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifndef CONFIG_MSGQ_LOCKFREE
 int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -281,6 +302,8 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	return result;
 }
 
+#endif /* !CONFIG_MSGQ_LOCKFREE */
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 				    k_timeout_t timeout)
@@ -293,6 +316,7 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifndef CONFIG_MSGQ_LOCKFREE
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -316,6 +340,8 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	return result;
 }
 
+#endif /* !CONFIG_MSGQ_LOCKFREE */
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
@@ -327,6 +353,7 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *msgq, void *data)
 #include <zephyr/syscalls/k_msgq_peek_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifndef CONFIG_MSGQ_LOCKFREE
 int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 {
 	k_spinlock_key_t key;
@@ -362,6 +389,8 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	return result;
 }
 
+#endif /* !CONFIG_MSGQ_LOCKFREE */
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 {
@@ -373,6 +402,7 @@ static inline int z_vrfy_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_
 #include <zephyr/syscalls/k_msgq_peek_at_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifndef CONFIG_MSGQ_LOCKFREE
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -395,6 +425,8 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	z_reschedule(&msgq->lock, key);
 }
 
+#endif /* !CONFIG_MSGQ_LOCKFREE */
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_msgq_purge(struct k_msgq *msgq)
 {
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Message queues, lock-free ring buffer variant.
+ *
+ * The ring is driven by four slot indexes.  Writers claim a slot by
+ * advancing wr_head with a CAS, copy their message in, and publish it
+ * by advancing wr_tail in claim order.  Readers do the same with
+ * rd_head and rd_tail.  A slot may be claimed by a writer once readers
+ * have released it through rd_tail, and by a reader once writers have
+ * published it through wr_tail.  None of this touches the message
+ * queue spinlock.
+ *
+ * The spinlock and the two wait queues are only used by threads that
+ * have to block and by the contexts that wake them up.  Blocked
+ * threads are not handed messages directly: a waker just readies the
+ * first waiter, which then retries the ring itself.  The waiters
+ * counter tells the fast path whether that is needed at all.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+
+#include <string.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <zephyr/sys/atomic.h>
+#include <kernel_internal.h>
+
+#ifdef CONFIG_POLL
+static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
+{
+	z_handle_obj_poll_events(&msgq->poll_events, state);
+}
+#endif /* CONFIG_POLL */
+
+static inline uint32_t ring_add(const struct k_msgq *msgq, uint32_t idx, uint32_t n)
+{
+	idx += n;
+
+	return (idx >= msgq->wrap) ? (idx - msgq->wrap) : idx;
+}
+
+/* Number of slots from @p tail up to @p head */
+static inline uint32_t ring_dist(const struct k_msgq *msgq, uint32_t head, uint32_t tail)
+{
+	return (head >= tail) ? (head - tail) : (head + msgq->wrap - tail);
+}
+
+static inline char *ring_slot(const struct k_msgq *msgq, uint32_t idx)
+{
+	return msgq->buffer_start + ((idx % msgq->max_msgs) * msgq->msg_size);
+}
+
+/* Claims are published in the order they were made, so wait for any
+ * earlier claimant that is still copying on another CPU.  Claimants
+ * copy with interrupts masked, which bounds the wait to one message
+ * copy.
+ */
+static inline void ring_publish(const struct k_msgq *msgq, atomic_t *tail,
+				uint32_t idx, uint32_t n)
+{
+	while ((uint32_t)atomic_get(tail) != idx) {
+		arch_spin_relax();
+	}
+	(void)atomic_set(tail, ring_add(msgq, idx, n));
+}
+
+static bool ring_put(struct k_msgq *msgq, const void *data)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t w;
+
+	while (true) {
+		w = atomic_get(&msgq->wr_head);
+
+		if (ring_dist(msgq, w, atomic_get(&msgq->rd_tail)) < msgq->max_msgs) {
+			if (atomic_cas(&msgq->wr_head, w, ring_add(msgq, w, 1))) {
+				break;
+			}
+		} else if ((uint32_t)atomic_get(&msgq->wr_head) == w) {
+			/* Full, and not just a stale snapshot of wr_head */
+			arch_irq_unlock(key);
+			return false;
+		}
+	}
+
+	(void)memcpy(ring_slot(msgq, w), data, msgq->msg_size);
+	ring_publish(msgq, &msgq->wr_tail, w, 1);
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+static bool ring_get(struct k_msgq *msgq, void *data)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t r;
+
+	while (true) {
+		r = atomic_get(&msgq->rd_head);
+
+		if (ring_dist(msgq, atomic_get(&msgq->wr_tail), r) > 0U) {
+			if (atomic_cas(&msgq->rd_head, r, ring_add(msgq, r, 1))) {
+				break;
+			}
+		} else if ((uint32_t)atomic_get(&msgq->rd_head) == r) {
+			/* Empty, and not just a stale snapshot of rd_head */
+			arch_irq_unlock(key);
+			return false;
+		}
+	}
+
+	(void)memcpy(data, ring_slot(msgq, r), msgq->msg_size);
+	ring_publish(msgq, &msgq->rd_tail, r, 1);
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+/* Ready the first thread blocked on @p wait_q, if any, so that it
+ * retries the ring.  Only needed when the waiters counter says so.
+ */
+static void wake_waiter(struct k_msgq *msgq, _wait_q_t *wait_q)
+{
+	if (atomic_get(&msgq->waiters) == 0) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	struct k_thread *thread = z_unpend_first_thread(wait_q);
+
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Blocking path shared by put and get.  The thread announces itself
+ * in the waiters counter before the final retry under the lock, so a
+ * concurrent fast path operation either lets that retry succeed or
+ * sees the counter and wakes the thread up again.
+ */
+static int ring_wait(struct k_msgq *msgq, void *data, k_timeout_t timeout, bool put)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	_wait_q_t *wait_q = put ? &msgq->put_wait_q : &msgq->wait_q;
+	bool waited = false;
+	int result;
+
+	(void)atomic_inc(&msgq->waiters);
+
+	while (true) {
+		if (put ? ring_put(msgq, data) : ring_get(msgq, data)) {
+			result = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = waited ? -EAGAIN : -ENOMSG;
+			break;
+		}
+
+		result = z_pend_curr(&msgq->lock, key, wait_q, timeout);
+		key = k_spin_lock(&msgq->lock);
+
+		if (result == -ENOMSG) {
+			/* Purged while waiting to write */
+			break;
+		}
+
+		/* Woken up or timed out: in both cases retry once more,
+		 * which on timeout happens with K_NO_WAIT.
+		 */
+		waited = true;
+		timeout = sys_timepoint_timeout(end);
+	}
+
+	(void)atomic_dec(&msgq->waiters);
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int result = 0;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	/* Leave the ring to blocked writers while there are any */
+	if ((atomic_get(&msgq->waiters) != 0) || !ring_put(msgq, data)) {
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+		}
+		result = ring_wait(msgq, (void *)data, timeout, true);
+	}
+
+	if (result == 0) {
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+		wake_waiter(msgq, &msgq->wait_q);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	return result;
+}
+
+int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	int result = 0;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	if ((atomic_get(&msgq->waiters) != 0) || !ring_get(msgq, data)) {
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+		}
+		result = ring_wait(msgq, data, timeout, false);
+	}
+
+	if (result == 0) {
+		wake_waiter(msgq, &msgq->put_wait_q);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	return result;
+}
+
+int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	uint32_t r = atomic_get(&msgq->rd_head);
+
+	if (ring_dist(msgq, atomic_get(&msgq->wr_tail), r) > idx) {
+		(void)memcpy(data, ring_slot(msgq, ring_add(msgq, r, idx)),
+			     msgq->msg_size);
+		result = 0;
+	} else {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
+{
+	return z_impl_k_msgq_peek_at(msgq, data, 0);
+}
+
+void z_impl_k_msgq_purge(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+	struct k_thread *pending_thread;
+	unsigned int irq_key;
+	uint32_t r, n;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
+
+	/* wake up any threads that are waiting to write */
+	for (pending_thread = z_unpend_first_thread(&msgq->put_wait_q); pending_thread != NULL;
+	     pending_thread = z_unpend_first_thread(&msgq->put_wait_q)) {
+		arch_thread_return_value_set(pending_thread, -ENOMSG);
+		z_ready_thread(pending_thread);
+	}
+
+	/* Claim everything published so far as one reader would */
+	irq_key = arch_irq_lock();
+	do {
+		r = atomic_get(&msgq->rd_head);
+		n = ring_dist(msgq, atomic_get(&msgq->wr_tail), r);
+	} while ((n > 0U) && !atomic_cas(&msgq->rd_head, r, ring_add(msgq, r, n)));
+
+	if (n > 0U) {
+		ring_publish(msgq, &msgq->rd_tail, r, n);
+	}
+	arch_irq_unlock(irq_key);
+
+	z_reschedule(&msgq->lock, key);
+}
@@ -31,6 +31,7 @@
 #include <zephyr/toolchain.h>
 #include <ksched.h>
 #include <kthread.h>
+#include <kernel_internal.h>
 #include <wait_q.h>
 #include <errno.h>
 #include <zephyr/init.h>
@@ -283,6 +284,37 @@ k_mutex_unlock_return:
 	return 0;
 }
 
+int z_mutex_requeue(struct k_mutex *mutex, _wait_q_t *wait_q)
+{
+	struct k_thread *thread;
+	int new_prio;
+	int requeued = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* The owner hands the mutex over to the requeued threads one by one
+	 * when unlocking it, as if they had called k_mutex_lock().
+	 */
+	if (mutex->owner != NULL) {
+		for (thread = z_requeue_first_thread(wait_q, &mutex->wait_q, mutex);
+		     thread != NULL;
+		     thread = z_requeue_first_thread(wait_q, &mutex->wait_q, mutex)) {
+			arch_thread_return_value_set(thread, 0);
+
+			new_prio = new_prio_for_inheritance(thread->base.prio,
+							    mutex->owner->base.prio);
+			if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
+				(void)adjust_owner_prio(mutex, new_prio);
+			}
+
+			requeued++;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return requeued;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 {
@@ -134,6 +134,64 @@ void z_vrfy_k_mem_paging_thread_stats_get(struct k_thread *thread,
 
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
 
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+static sys_slist_t paging_regions = SYS_SLIST_STATIC_INIT(&paging_regions);
+
+void k_mem_paging_region_stats_register(struct k_mem_paging_region *region,
+					void *addr, size_t size)
+{
+	unsigned int key;
+
+	__ASSERT_NO_MSG(region != NULL);
+
+	region->start = POINTER_TO_UINT(addr);
+	region->size = size;
+	memset(&region->stats, 0, sizeof(region->stats));
+
+	key = irq_lock();
+	sys_slist_append(&paging_regions, &region->node);
+	irq_unlock(key);
+}
+
+void k_mem_paging_region_stats_unregister(struct k_mem_paging_region *region)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	(void)sys_slist_find_and_remove(&paging_regions, &region->node);
+	irq_unlock(key);
+}
+
+void k_mem_paging_region_stats_get(struct k_mem_paging_region *region,
+				   struct k_mem_paging_stats_t *stats)
+{
+	unsigned int key;
+
+	if ((region == NULL) || (stats == NULL)) {
+		return;
+	}
+
+	/* Copy statistics */
+	key = irq_lock();
+	memcpy(stats, &region->stats, sizeof(region->stats));
+	irq_unlock(key);
+}
+
+struct k_mem_paging_stats_t *z_paging_region_stats_find(void *addr)
+{
+	uintptr_t virt = POINTER_TO_UINT(addr);
+	struct k_mem_paging_region *region;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&paging_regions, region, node) {
+		if ((virt - region->start) < region->size) {
+			return &region->stats;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 void z_paging_histogram_init(void)
 {
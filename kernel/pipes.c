@@ -43,6 +43,10 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0U;
 	pipe->read_index = 0U;
 	pipe->write_index = 0U;
+#ifdef CONFIG_PIPE_CLAIM
+	pipe->put_claimed = 0U;
+	pipe->get_claimed = 0U;
+#endif /* CONFIG_PIPE_CLAIM */
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -377,6 +381,34 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
+/**
+ * @brief Refill the pipe buffer from the waiting writer(s), if not full
+ */
+static void pipe_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc pipe_desc[2];
+	sys_dlist_t       src_list;
+	sys_dlist_t       pipe_list;
+
+	if (pipe->bytes_used == pipe->size) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+}
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 		      size_t bytes_to_write, size_t *bytes_written,
 		      size_t min_xfer, k_timeout_t timeout)
@@ -625,29 +657,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
-
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -736,6 +746,178 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <zephyr/syscalls/k_pipe_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_PIPE_CLAIM
+/**
+ * @brief Hand data committed to the pipe buffer to the waiting reader(s)
+ */
+static void pipe_drain_to_readers(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc  pipe_desc[2];
+	struct _pipe_desc *src;
+	struct _pipe_desc *dest;
+	sys_dlist_t        src_list;
+	sys_dlist_t        dest_list;
+	size_t             bytes_copied;
+
+	if (pipe->bytes_used == 0U) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	(void) pipe_waiter_list_populate(&dest_list, &pipe->wait_q.readers,
+					 pipe->bytes_used);
+	(void) pipe_buffer_list_populate(&src_list, pipe_desc, pipe->buffer,
+					 pipe->size, pipe->read_index,
+					 pipe->write_index);
+
+	src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+	dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+
+	while ((src != NULL) && (dest != NULL)) {
+		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
+					 src->buffer, src->bytes_to_xfer);
+
+		dest->buffer        += bytes_copied;
+		dest->bytes_to_xfer -= bytes_copied;
+
+		src->buffer         += bytes_copied;
+		src->bytes_to_xfer  -= bytes_copied;
+
+		pipe->bytes_used -= bytes_copied;
+		pipe->read_index += bytes_copied;
+		if (pipe->read_index >= pipe->size) {
+			pipe->read_index -= pipe->size;
+		}
+
+		if (dest->bytes_to_xfer == 0U) {
+
+			/* The thread's read request has been satisfied. */
+
+			z_unpend_thread(dest->thread);
+			z_ready_thread(dest->thread);
+
+			*reschedule = true;
+			dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+		}
+
+		if (src->bytes_to_xfer == 0U) {
+			src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+		}
+	}
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	size_t start;
+	size_t len;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	start = pipe->write_index + pipe->put_claimed;
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	len = MIN(size, pipe->size - pipe->bytes_used - pipe->put_claimed);
+	len = MIN(len, pipe->size - start);
+
+	*data = &pipe->buffer[start];
+	pipe->put_claimed += len;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return len;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	bool reschedule_needed = false;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0U;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	/* Readers only wait while the buffer is empty, so they come first */
+	pipe_drain_to_readers(pipe, &reschedule_needed);
+
+	if ((pipe->bytes_used != 0U) && (size != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	size_t start;
+	size_t len;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	start = pipe->read_index + pipe->get_claimed;
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	len = MIN(size, pipe->bytes_used - pipe->get_claimed);
+	len = MIN(len, pipe->size - start);
+
+	*data = &pipe->buffer[start];
+	pipe->get_claimed += len;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return len;
+}
+
+int k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	bool reschedule_needed = false;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0U;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	pipe_refill(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_PIPE_CLAIM */
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
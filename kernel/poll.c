@@ -35,10 +35,13 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+#ifdef CONFIG_POLL_SET
+static int signal_set(struct k_poll_event *event, uint32_t state);
+#endif
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -82,7 +85,7 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_impl_k_msgq_num_used_get(event->msgq) > 0) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
@@ -109,22 +112,30 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Poll sets have no thread of their own, and queue behind all threads */
+static inline bool poller_is_set(struct z_poller *p)
+{
+	return IS_ENABLED(CONFIG_POLL_SET) && (p->mode == MODE_SET);
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || poller_is_set(poller) ||
+		(!poller_is_set(pending->poller) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+							   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_is_set(pending->poller) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+					poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -448,6 +459,10 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
+#ifdef CONFIG_POLL_SET
+		} else if (poller->mode == MODE_SET) {
+			retcode = signal_set(event, state);
+#endif
 		} else {
 			/* Poller is not poll or triggered mode. No action needed.*/
 			;
@@ -813,3 +828,130 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+#ifdef CONFIG_POLL_SET
+/* must be called with interrupts locked */
+static int signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set,
+					      poller);
+
+	ARG_UNUSED(state);
+
+	/* The object dropped the event from its list before signaling it */
+	sys_dlist_append(&set->ready, &event->_node);
+	(void)z_sched_wake(&set->wait_q, 0, NULL);
+
+	return 0;
+}
+
+/* Arm an event of a set: report it right away if its condition is met,
+ * otherwise have its object signal it.
+ *
+ * must be called with interrupts locked
+ */
+static void set_arm_event(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		set_event_ready(event, state);
+		sys_dlist_append(&set->ready, &event->_node);
+	} else {
+		register_event(event, &set->poller);
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+	z_waitq_init(&set->wait_q);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	__ASSERT(event->mode == K_POLL_MODE_NOTIFY_ONLY,
+		 "only NOTIFY_ONLY mode is supported\n");
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	set_arm_event(set, event);
+
+	if (!sys_dlist_is_empty(&set->ready)) {
+		(void)z_sched_wake(&set->wait_q, 0, NULL);
+	}
+
+	z_reschedule(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	ARG_UNUSED(set);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Wherever the event is, registered to its object, ready or
+	 * returned, it is linked through its node.
+	 */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	sys_dnode_t *node;
+	int num_ready = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+	__ASSERT(max_events > 0, "<1 events\n");
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Only the events returned by the previous call need to be armed
+	 * again, all others are still registered to their objects.
+	 */
+	while ((node = sys_dlist_get(&set->returned)) != NULL) {
+		set_arm_event(set, CONTAINER_OF(node, struct k_poll_event,
+						_node));
+	}
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		int swap_rc = z_pend_curr(&lock, key, &set->wait_q, timeout);
+
+		if (swap_rc != 0) {
+			return swap_rc;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	while (num_ready < max_events &&
+	       (node = sys_dlist_get(&set->ready)) != NULL) {
+		ready[num_ready++] = CONTAINER_OF(node, struct k_poll_event,
+						  _node);
+		sys_dlist_append(&set->returned, node);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_ready;
+}
+#endif /* CONFIG_POLL_SET */
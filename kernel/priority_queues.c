@@ -28,3 +28,22 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b)
 			? 1 : 0;
 	}
 }
+
+#ifdef CONFIG_SCHED_PAIRING_HEAP
+bool z_priq_pheap_lessthan(struct pheap_node *a, struct pheap_node *b)
+{
+	struct k_thread *thread_a, *thread_b;
+	int32_t cmp;
+
+	thread_a = CONTAINER_OF(a, struct k_thread, base.qnode_pheap);
+	thread_b = CONTAINER_OF(b, struct k_thread, base.qnode_pheap);
+
+	cmp = z_sched_prio_cmp(thread_a, thread_b);
+
+	if (cmp != 0) {
+		return cmp > 0;
+	}
+
+	return thread_a->base.order_key < thread_b->base.order_key;
+}
+#endif /* CONFIG_SCHED_PAIRING_HEAP */
@@ -101,6 +101,15 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_WORK_STEALING)
+	/* Queue on the CPU the thread last ran on, which is the one
+	 * most likely to still have its working set in cache.  Other
+	 * CPUs steal it from there when needed, see runq_best().
+	 * Note that base.cpu is only ever rewritten once the thread
+	 * has been taken out of the run queue to become _current, so
+	 * this is stable between runq_add() and runq_remove().
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -109,11 +118,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
@@ -132,7 +141,31 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	struct k_thread *thread = _priq_run_best(curr_cpu_runq());
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int curr = _current_cpu->id;
+
+	/* Look at the head of every other CPU's queue, starting with
+	 * our neighbour so that concurrent stealers don't all go for
+	 * the same victim first, and take whatever outranks the local
+	 * best.  Ties stay local.  This is what keeps the scheduling
+	 * order identical to that of a single global queue.
+	 */
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		unsigned int cpu = (curr + i) % num_cpus;
+		struct k_thread *t = _priq_run_best(&_kernel.cpus[cpu].ready_q.runq);
+
+		if ((t != NULL) &&
+		    ((thread == NULL) || (z_sched_prio_cmp(t, thread) > 0))) {
+			thread = t;
+		}
+	}
+
+	return thread;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_WORK_STEALING */
 }
 
 /* _current is never in the run queue until context switch on
@@ -382,9 +415,12 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+		z_sched_usage_ready(thread);
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		flag_ipi(ipi_mask_create(thread));
 	}
 }
 
@@ -470,7 +506,11 @@ static void z_thread_halt(struct k_thread *thread, k_spinlock_key_t key,
 		thread->base.thread_state |= (terminate ? _THREAD_ABORTING
 					      : _THREAD_SUSPENDING);
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+		arch_sched_directed_ipi(IPI_CPU_MASK(thread->base.cpu));
+#else
 		arch_sched_ipi();
+#endif /* CONFIG_ARCH_HAS_DIRECTED_IPIS */
 #endif
 		if (arch_is_in_isr()) {
 			thread_halt_spin(thread, key);
@@ -719,6 +759,27 @@ struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
 	return thread;
 }
 
+struct k_thread *z_requeue_first_thread(_wait_q_t *from, _wait_q_t *to,
+					void *swap_data)
+{
+	struct k_thread *thread = NULL;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		thread = _priq_wait_best(&from->waitq);
+
+		if ((thread != NULL) && (thread->base.swap_data == swap_data)) {
+			/* Keeps the timeout running, the thread stays pended */
+			_priq_wait_remove(&from->waitq, thread);
+			thread->base.pended_on = to;
+			_priq_wait_add(&to->waitq, thread);
+		} else {
+			thread = NULL;
+		}
+	}
+
+	return thread;
+}
+
 void z_unpend_thread(struct k_thread *thread)
 {
 	z_unpend_thread_no_timeout(thread);
@@ -975,8 +1036,14 @@ void init_ready_q(struct _ready_q *ready_q)
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
 	};
+#elif defined(CONFIG_SCHED_PAIRING_HEAP)
+	ready_q->runq = (struct _priq_pheap) {
+		.heap = {
+			.lessthan_fn = z_priq_pheap_lessthan,
+		}
+	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -986,13 +1053,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1006,7 +1073,7 @@ void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
 
 	bool need_sched = z_thread_prio_set((struct k_thread *)thread, prio);
 
-	flag_ipi();
+	flag_ipi(IPI_ALL_CPUS_MASK);
 	if (need_sched && (_current->base.sched_locked == 0U)) {
 		z_reschedule_unlocked();
 	}
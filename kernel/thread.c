@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2010-2014 Wind River Systems, Inc.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -389,6 +390,40 @@ static size_t random_offset(size_t stack_size)
 #endif /* CONFIG_STACK_GROWS_UP */
 #endif /* CONFIG_STACK_POINTER_RANDOM */
 
+#ifdef CONFIG_INIT_STACKS_LAZY
+/*
+ * Threads only dirty their stack from the top down to their deepest use, so
+ * everything below the lowest byte that lost the pattern is still painted.
+ */
+static void stack_paint(uint8_t *start, size_t size)
+{
+	const uintptr_t pattern = (uintptr_t)-1 / 0xffU * 0xaaU;
+	uint8_t *end = start + size;
+	uint8_t *p = start;
+
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		/* The sentinel is written over the pattern again anyway */
+		p += MIN(size, sizeof(uint32_t));
+	}
+
+	while ((p < end) && !IS_PTR_ALIGNED(p, uintptr_t) && (*p == 0xaaU)) {
+		p++;
+	}
+
+	if (IS_PTR_ALIGNED(p, uintptr_t)) {
+		while (((size_t)(end - p) >= sizeof(uintptr_t)) && (*(uintptr_t *)p == pattern)) {
+			p += sizeof(uintptr_t);
+		}
+	}
+
+	while ((p < end) && (*p == 0xaaU)) {
+		p++;
+	}
+
+	(void)memset(p, 0xaa, end - p);
+}
+#endif /* CONFIG_INIT_STACKS_LAZY */
+
 static char *setup_thread_stack(struct k_thread *new_thread,
 				k_thread_stack_t *stack, size_t stack_size)
 {
@@ -465,7 +500,9 @@ static char *setup_thread_stack(struct k_thread *new_thread,
 		stack, new_thread, stack_obj_size, (void *)stack_buf_start,
 		stack_buf_size, (void *)stack_ptr);
 
-#ifdef CONFIG_INIT_STACKS
+#if defined(CONFIG_INIT_STACKS_LAZY)
+	stack_paint((uint8_t *)stack_buf_start, stack_buf_size);
+#elif defined(CONFIG_INIT_STACKS)
 	memset(stack_buf_start, 0xaa, stack_buf_size);
 #endif /* CONFIG_INIT_STACKS */
 #ifdef CONFIG_STACK_SENTINEL
@@ -758,6 +795,9 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+
+	/* Also selects the initial run queue with SCHED_WORK_STEALING */
+	thread_base->cpu = 0;
 #endif /* CONFIG_SMP */
 
 #ifdef CONFIG_TIMESLICE_PER_THREAD
@@ -931,6 +971,12 @@ void z_thread_mark_switched_in(void)
 
 void z_thread_mark_switched_out(void)
 {
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) && !defined(CONFIG_USE_SWITCH) && \
+	!defined(CONFIG_SMP)
+	if ((_current != _kernel.ready_q.cache) && z_is_thread_ready(_current)) {
+		z_sched_usage_preempted(_current);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY && !CONFIG_USE_SWITCH && !CONFIG_SMP */
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_stop();
 #endif /*CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
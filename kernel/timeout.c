@@ -14,8 +14,6 @@
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +34,13 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
+/*
+ * Sorted list backend: every timeout stores its expiry relative to the
+ * one before it, with the head relative to curr_tick.
+ */
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,7 +55,7 @@ static struct _timeout *next(struct _timeout *t)
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static void tq_remove(struct _timeout *t)
 {
 	if (next(t) != NULL) {
 		next(t)->dticks += t->dticks;
@@ -59,6 +64,350 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Queues @p to to expire @p ticks after curr_tick, returns true if it
+ * became the earliest timeout.
+ */
+static bool tq_add(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+/* Ticks from curr_tick until the queue needs servicing */
+static bool tq_next(k_ticks_t *ticks)
+{
+	struct _timeout *to = first();
+
+	if (to == NULL) {
+		return false;
+	}
+
+	*ticks = to->dticks;
+	return true;
+}
+
+/* Ticks from curr_tick until @p timeout expires */
+static k_ticks_t tq_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+/* Removes and returns the first timeout expiring within @p limit ticks
+ * of curr_tick, with its distance from curr_tick in @p dt.
+ */
+static struct _timeout *tq_pop_due(k_ticks_t limit, k_ticks_t *dt)
+{
+	struct _timeout *t = first();
+
+	if ((t == NULL) || (t->dticks > limit)) {
+		return NULL;
+	}
+
+	*dt = t->dticks;
+	t->dticks = 0;
+	tq_remove(t);
+
+	return t;
+}
+
+/* curr_tick is about to move @p ticks ahead with nothing due before */
+static void tq_advance(k_ticks_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+static void tq_rebase(uint64_t old_tick)
+{
+	/* Relative expiries don't depend on curr_tick */
+	ARG_UNUSED(old_tick);
+}
+
+#else /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+/*
+ * Hierarchical timing wheel backend.  dticks holds the absolute expiry
+ * tick.  Level L has 64 slots, each covering 64^L ticks; a timeout sits
+ * in the level of the highest base-64 digit in which its expiry differs
+ * from wheel_now, in the slot given by that digit of the expiry.  Level
+ * 0 slots thus hold timeouts expiring on exactly one tick, and a higher
+ * level slot is cascaded, i.e. redistributed to the lower levels, when
+ * wheel_now reaches the start of its range.  Timeouts too far out for
+ * the top level wait in an overflow list that is cascaded each time the
+ * top level wraps around.  A bitmap per level finds the next slot to
+ * service without scanning.
+ *
+ * wheel_now equals curr_tick except transiently inside
+ * tq_pop_due(), which may cascade ahead of curr_tick.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_QUEUE_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS (WHEEL_BITS * WHEEL_LEVELS)
+
+#ifdef CONFIG_TIMEOUT_64BIT
+typedef uint64_t wheel_tick_t;
+typedef int64_t wheel_delta_t;
+#else
+typedef uint32_t wheel_tick_t;
+typedef int32_t wheel_delta_t;
+#endif /* CONFIG_TIMEOUT_64BIT */
+
+BUILD_ASSERT(WHEEL_SPAN_BITS < (8 * sizeof(wheel_tick_t)),
+	     "Timing wheel spans the whole tick range");
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_map[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+static wheel_tick_t wheel_now;
+
+static inline wheel_tick_t expiry(const struct _timeout *t)
+{
+	return (wheel_tick_t)t->dticks;
+}
+
+static inline wheel_delta_t wheel_delta(wheel_tick_t a, wheel_tick_t b)
+{
+	return (wheel_delta_t)(a - b);
+}
+
+static inline unsigned int wheel_level(wheel_tick_t exp)
+{
+	wheel_tick_t diff = exp ^ wheel_now;
+
+	if (diff == 0U) {
+		return 0;
+	}
+
+#ifdef CONFIG_TIMEOUT_64BIT
+	return (63U - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+#else
+	return (31U - u32_count_leading_zeros(diff)) / WHEEL_BITS;
+#endif /* CONFIG_TIMEOUT_64BIT */
+}
+
+static inline unsigned int wheel_slot(wheel_tick_t exp, unsigned int level)
+{
+	return (exp >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1U);
+}
+
+/* The list @p t is (or would be) queued on, given the current wheel_now */
+static sys_dlist_t *wheel_list(const struct _timeout *t, unsigned int *level,
+			       unsigned int *slot)
+{
+	*level = wheel_level(expiry(t));
+
+	if (*level >= WHEEL_LEVELS) {
+		*slot = 0U;
+		return &wheel_overflow;
+	}
+
+	*slot = wheel_slot(expiry(t), *level);
+	return &wheel[*level][*slot];
+}
+
+static void wheel_insert(struct _timeout *t)
+{
+	unsigned int level, slot;
+	sys_dlist_t *list = wheel_list(t, &level, &slot);
+
+	/* Slot lists are only valid while their bitmap bit is set */
+	if ((level < WHEEL_LEVELS) && ((wheel_map[level] & BIT64(slot)) == 0U)) {
+		sys_dlist_init(list);
+		wheel_map[level] |= BIT64(slot);
+	}
+	sys_dlist_append(list, &t->node);
+}
+
+static void tq_remove(struct _timeout *t)
+{
+	unsigned int level, slot;
+	sys_dlist_t *list = wheel_list(t, &level, &slot);
+
+	sys_dlist_remove(&t->node);
+	if ((level < WHEEL_LEVELS) && sys_dlist_is_empty(list)) {
+		wheel_map[level] &= ~BIT64(slot);
+	}
+}
+
+/* Finds the next tick at which the wheel needs servicing: either the
+ * expiry of the first populated level 0 slot, or the start of the
+ * first populated higher level slot, or the top level wrap-around when
+ * only the overflow list is populated.  Returns the list to service.
+ */
+static sys_dlist_t *wheel_next(wheel_tick_t *when, unsigned int *level)
+{
+	for (unsigned int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel_map[l] != 0U) {
+			unsigned int shift = l * WHEEL_BITS;
+			unsigned int slot = u64_count_trailing_zeros(wheel_map[l]);
+			wheel_tick_t mask = ((wheel_tick_t)WHEEL_SLOTS << shift) - 1U;
+
+			*when = (wheel_now & ~mask) | ((wheel_tick_t)slot << shift);
+			*level = l;
+			return &wheel[l][slot];
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		wheel_tick_t mask = ((wheel_tick_t)1 << WHEEL_SPAN_BITS) - 1U;
+
+		*when = (wheel_now | mask) + 1U;
+		*level = WHEEL_LEVELS;
+		return &wheel_overflow;
+	}
+
+	return NULL;
+}
+
+/* Redistribute @p list relative to @p when */
+static void wheel_cascade(sys_dlist_t *list, unsigned int level, wheel_tick_t when)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+
+	sys_dlist_init(&pending);
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+	if (level < WHEEL_LEVELS) {
+		wheel_map[level] &= ~BIT64(wheel_slot(when, level));
+	}
+
+	wheel_now = when;
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+static bool tq_add(struct _timeout *to, k_ticks_t ticks)
+{
+	wheel_tick_t when;
+	unsigned int level;
+	bool earliest;
+
+	to->dticks = (wheel_tick_t)(curr_tick + ticks);
+	earliest = (wheel_next(&when, &level) == NULL) ||
+		   (wheel_delta(expiry(to), when) < 0);
+	wheel_insert(to);
+
+	return earliest;
+}
+
+static bool tq_next(k_ticks_t *ticks)
+{
+	wheel_tick_t when;
+	unsigned int level;
+
+	if (wheel_next(&when, &level) == NULL) {
+		return false;
+	}
+
+	*ticks = wheel_delta(when, (wheel_tick_t)curr_tick);
+	return true;
+}
+
+static k_ticks_t tq_rem(const struct _timeout *timeout)
+{
+	return wheel_delta(expiry(timeout), (wheel_tick_t)curr_tick);
+}
+
+/* Bounded work per call: at most one cascade per level plus one of
+ * the overflow list before the next due timeout is found.
+ */
+static struct _timeout *tq_pop_due(k_ticks_t limit, k_ticks_t *dt)
+{
+	sys_dlist_t *list;
+	wheel_tick_t when;
+	unsigned int level;
+
+	while ((list = wheel_next(&when, &level)) != NULL) {
+		k_ticks_t delta = wheel_delta(when, (wheel_tick_t)curr_tick);
+
+		if (delta > limit) {
+			break;
+		}
+
+		if (level == 0U) {
+			struct _timeout *t = SYS_DLIST_PEEK_HEAD_CONTAINER(list, t, node);
+
+			wheel_now = when;
+			tq_remove(t);
+			*dt = delta;
+			return t;
+		}
+
+		wheel_cascade(list, level, when);
+	}
+
+	return NULL;
+}
+
+static void tq_advance(k_ticks_t ticks)
+{
+	wheel_now = (wheel_tick_t)(curr_tick + ticks);
+}
+
+/* curr_tick was forcibly moved from @p old_tick: keep every timeout the
+ * same distance away, like the relative list backend does.
+ */
+static void tq_rebase(uint64_t old_tick)
+{
+	sys_dlist_t all;
+	sys_dnode_t *node;
+
+	sys_dlist_init(&all);
+	for (unsigned int l = 0; l < WHEEL_LEVELS; l++) {
+		while (wheel_map[l] != 0U) {
+			unsigned int s = u64_count_trailing_zeros(wheel_map[l]);
+
+			while ((node = sys_dlist_get(&wheel[l][s])) != NULL) {
+				sys_dlist_append(&all, node);
+			}
+			wheel_map[l] &= ~BIT64(s);
+		}
+	}
+	while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+		sys_dlist_append(&all, node);
+	}
+
+	wheel_now = (wheel_tick_t)curr_tick;
+	while ((node = sys_dlist_get(&all)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks = (wheel_tick_t)(curr_tick + (expiry(t) - (wheel_tick_t)old_tick));
+		wheel_insert(t);
+	}
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -82,20 +431,41 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t ticks;
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if (!tq_next(&ticks) ||
+	    ((int64_t)(ticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, ticks - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/*
+ * Defers an expiry @p ticks after curr_tick to the next multiple of the
+ * largest power of two not above the slack, so that timeouts with similar
+ * slack expiring close together are serviced on the same tick.
+ */
+static k_ticks_t slack_align(k_ticks_t ticks, uint32_t slack)
+{
+	uint64_t gran, expiry;
+
+	if (slack < 2U) {
+		return ticks;
+	}
+
+	gran = BIT64(find_msb_set(slack) - 1);
+	expiry = curr_tick + ticks;
+
+	return ticks + (k_ticks_t)(ROUND_UP(expiry, gran) - expiry);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
@@ -111,31 +481,20 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+#ifdef CONFIG_TIMEOUT_SLACK
+		ticks = slack_align(ticks, to->slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
 
-		if (to == first() && announce_remaining == 0) {
+		if (tq_add(to, ticks) && announce_remaining == 0) {
 			sys_clock_set_timeout(next_timeout(), false);
 		}
 	}
@@ -147,7 +506,7 @@ int z_abort_timeout(struct _timeout *to)
 
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
+			tq_remove(to);
 			ret = 0;
 		}
 	}
@@ -155,28 +514,13 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
 
 	K_SPINLOCK(&timeout_lock) {
 		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
+			ticks = tq_rem(timeout) - elapsed();
 		}
 	}
 
@@ -190,7 +534,7 @@ k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 	K_SPINLOCK(&timeout_lock) {
 		ticks = curr_tick;
 		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
+			ticks += tq_rem(timeout);
 		}
 	}
 
@@ -226,15 +570,10 @@ void sys_clock_announce(int32_t ticks)
 	announce_remaining = ticks;
 
 	struct _timeout *t;
+	k_ticks_t dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
+	while ((t = tq_pop_due(announce_remaining, &dt)) != NULL) {
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -242,9 +581,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
+	tq_advance(announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -330,7 +667,12 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	K_SPINLOCK(&timeout_lock) {
+		uint64_t old_tick = curr_tick;
+
+		curr_tick = tick;
+		tq_rebase(old_tick);
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -191,6 +191,34 @@ static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 #include <zephyr/syscalls/k_timer_start_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+void z_impl_k_timer_slack_set(struct k_timer *timer, k_timeout_t slack)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (K_TIMEOUT_EQ(slack, K_FOREVER) || ((uint64_t)slack.ticks > UINT32_MAX)) {
+		timer->timeout.slack = UINT32_MAX;
+	} else {
+		timer->timeout.slack = (uint32_t)slack.ticks;
+	}
+
+	k_spin_unlock(&lock, key);
+#else
+	ARG_UNUSED(timer);
+	ARG_UNUSED(slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <zephyr/syscalls/k_timer_slack_set_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 void z_impl_k_timer_stop(struct k_timer *timer)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_timer, stop, timer);
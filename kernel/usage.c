@@ -71,19 +71,72 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+static void sched_thread_update_latency(struct k_thread *thread, uint32_t now)
+{
+	uint32_t cycles = now - thread->base.usage.ready;
+	unsigned int bucket;
+
+	bucket = find_msb_set(cycles >> CONFIG_SCHED_THREAD_USAGE_LATENCY_SHIFT);
+	bucket = MIN(bucket, CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS - 1);
+
+	thread->base.usage.latency[bucket]++;
+
+	if (thread->base.usage.latency_max < cycles) {
+		thread->base.usage.latency_max = cycles;
+	}
+}
+
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	/* Only written under the scheduler lock while the thread is not
+	 * queued, so it cannot race with the thread being switched in.
+	 */
+	thread->base.usage.ready = usage_now();
+}
+
+void z_sched_usage_preempted(struct k_thread *thread)
+{
+	k_spinlock_key_t  key;
+
+	key = k_spin_lock(&usage_lock);
+
+	if (thread->base.usage.track_usage) {
+		thread->base.usage.preemptions++;
+	}
+
+	thread->base.usage.ready = usage_now();
+
+	k_spin_unlock(&usage_lock, key);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 void z_sched_usage_start(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+#if defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) || defined(CONFIG_SCHED_THREAD_USAGE_LATENCY)
 	k_spinlock_key_t  key;
+	uint32_t now;
 
 	key = k_spin_lock(&usage_lock);
 
-	_current_cpu->usage0 = usage_now();   /* Always update */
+	now = usage_now();
+	_current_cpu->usage0 = now;   /* Always update */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	if (thread->base.usage.track_usage) {
 		thread->base.usage.num_windows++;
 		thread->base.usage.current = 0;
 	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	if (thread->base.usage.ready != 0) {
+		if (thread->base.usage.track_usage) {
+			sched_thread_update_latency(thread, now);
+		}
+		thread->base.usage.ready = 0;
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 
 	k_spin_unlock(&usage_lock, key);
 #else
@@ -93,7 +146,7 @@ void z_sched_usage_start(struct k_thread *thread)
 	 */
 
 	_current_cpu->usage0 = usage_now();
-#endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS || CONFIG_SCHED_THREAD_USAGE_LATENCY */
 }
 
 void z_sched_usage_stop(void)
@@ -166,6 +219,12 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	stats->preemptions = 0;
+	stats->latency_max = 0;
+	memset(stats->latency, 0, sizeof(stats->latency));
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 	k_spin_unlock(&usage_lock, key);
 }
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -217,6 +276,12 @@ void z_sched_thread_usage(struct k_thread *thread,
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	stats->preemptions = thread->base.usage.preemptions;
+	stats->latency_max = thread->base.usage.latency_max;
+	memcpy(stats->latency, thread->base.usage.latency, sizeof(stats->latency));
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -382,6 +447,11 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	stats->preemptions = 0U;
+	stats->latency_max = 0U;
+	memset(stats->latency, 0, sizeof(stats->latency));
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
 
 	if (thread != _current_cpu->current) {
 
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2017 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -168,6 +169,9 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 struct dyn_obj {
 	struct k_object kobj;
 	sys_dnode_t dobj_list;
+#if CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0
+	sys_dnode_t dobj_hash;
+#endif
 
 	/* The object itself */
 	void *data;
@@ -183,9 +187,30 @@ extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
+#if CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0
 /*
- * TODO: Write some hash table code that will replace obj_list.
+ * Allocated kernel objects hashed by address, so that looking one up does
+ * not depend on how many are allocated.
  */
+static sys_dlist_t obj_hash[CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+static bool obj_hash_ready;
+
+/* Called with lists_lock held */
+static sys_dlist_t *obj_hash_bucket(const void *obj)
+{
+	/* Objects are at least pointer aligned, the low bits are always 0 */
+	uintptr_t key = (uintptr_t)obj / sizeof(void *);
+
+	if (!obj_hash_ready) {
+		for (size_t i = 0; i < ARRAY_SIZE(obj_hash); i++) {
+			sys_dlist_init(&obj_hash[i]);
+		}
+		obj_hash_ready = true;
+	}
+
+	return &obj_hash[key % CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0 */
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -233,11 +258,21 @@ static struct dyn_obj *dyn_object_find(const void *obj)
 	 */
 	key = k_spin_lock(&lists_lock);
 
+#if CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0
+	sys_dlist_t *bucket = obj_hash_bucket(obj);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(bucket, node, dobj_hash) {
+		if (node->kobj.name == obj) {
+			goto end;
+		}
+	}
+#else
 	SYS_DLIST_FOR_EACH_CONTAINER(&obj_list, node, dobj_list) {
 		if (node->kobj.name == obj) {
 			goto end;
 		}
 	}
+#endif /* CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0 */
 
 	/* No object found */
 	node = NULL;
@@ -248,6 +283,17 @@ static struct dyn_obj *dyn_object_find(const void *obj)
 	return node;
 }
 
+static void dyn_object_unlink(struct dyn_obj *dyn)
+{
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+
+	sys_dlist_remove(&dyn->dobj_list);
+#if CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0
+	sys_dlist_remove(&dyn->dobj_hash);
+#endif
+	k_spin_unlock(&lists_lock, key);
+}
+
 /**
  * @internal
  *
@@ -376,6 +422,9 @@ static struct k_object *dynamic_object_create(enum k_objects otype, size_t align
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
 	sys_dlist_append(&obj_list, &dyn->dobj_list);
+#if CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS > 0
+	sys_dlist_append(obj_hash_bucket(dyn->kobj.name), &dyn->dobj_hash);
+#endif
 	k_spin_unlock(&lists_lock, key);
 
 	return &dyn->kobj;
@@ -469,7 +518,7 @@ void k_object_free(void *obj)
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		sys_dlist_remove(&dyn->dobj_list);
+		dyn_object_unlink(dyn);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -579,7 +628,7 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 		break;
 	}
 
-	sys_dlist_remove(&dyn->dobj_list);
+	dyn_object_unlink(dyn);
 	k_free(dyn->data);
 	k_free(dyn);
 out:
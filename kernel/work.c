@@ -76,6 +76,13 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 /* List of pending cancellations. */
 static sys_slist_t pending_cancels;
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+/* List of flushers that were reached while their work item was still
+ * running on another worker, or queued behind it again.
+ */
+static sys_slist_t pending_flushes;
+#endif
+
 /* Initialize a canceler record and add it to the list of pending
  * cancels.
  *
@@ -200,6 +207,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	}
 
 	init_flusher(flusher);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	flusher->target = work;
+#endif
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -245,6 +255,26 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+/* Check whether the current thread is one of the threads of a queue. */
+static inline bool queue_thread_is_current(struct k_work_q *queue)
+{
+	if (_current == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (_current == &worker->thread) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -272,7 +302,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_thread_is_current(queue) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -609,6 +639,114 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+/* Take the next work item that can be run from a queue.
+ *
+ * With a single thread this is the head of the pending list.  When several
+ * workers share the queue, items that are still running on another worker
+ * are left in place to prevent handler re-entrancy, and flushers whose item
+ * hasn't completed yet are set aside until it does.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to take work from
+ *
+ * @return the node of the work item, or NULL if nothing can be run
+ */
+static sys_snode_t *queue_get_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_snode_t *node, *next;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_NODE_SAFE(&queue->pending, node, next) {
+		struct k_work *work = CONTAINER_OF(node, struct k_work, node);
+
+		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+			struct z_work_flusher *flusher
+				= CONTAINER_OF(work, struct z_work_flusher, work);
+
+			if ((flags_get(&flusher->target->flags)
+			     & (K_WORK_QUEUED | K_WORK_RUNNING)) != 0U) {
+				sys_slist_remove(&queue->pending, prev, node);
+				sys_slist_append(&pending_flushes, node);
+				continue;
+			}
+		} else if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+			prev = node;
+			continue;
+		}
+
+		sys_slist_remove(&queue->pending, prev, node);
+		return node;
+	}
+
+	return NULL;
+#else
+	return sys_slist_get(&queue->pending);
+#endif
+}
+
+/* Release the flushers that were set aside for a work item that completed.
+ *
+ * Flushers for an item that has been resubmitted in the meantime go back to
+ * the queue behind it, the others are completed.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue that ran the work item
+ * @param work the work item that completed
+ */
+static void release_flushers_locked(struct k_work_q *queue,
+				    struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	struct z_work_flusher *flusher, *tmp;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_flushes, flusher, tmp,
+					  work.node) {
+		if (flusher->target != work) {
+			prev = &flusher->work.node;
+			continue;
+		}
+
+		sys_slist_remove(&pending_flushes, prev, &flusher->work.node);
+		if (flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+			sys_slist_insert(&queue->pending, &work->node,
+					 &flusher->work.node);
+		} else {
+			finalize_flush_locked(&flusher->work);
+		}
+	}
+#else
+	ARG_UNUSED(queue);
+	ARG_UNUSED(work);
+#endif
+}
+
+/* Account for a thread of a queue starting or finishing a work item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_locked(struct k_work_q *queue, bool busy)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	if (busy) {
+		queue->busy++;
+	} else {
+		queue->busy--;
+	}
+
+	busy = queue->busy != 0U;
+#endif
+
+	if (busy) {
+		flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	} else {
+		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	}
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -628,12 +766,12 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = queue_get_locked(queue);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			queue_busy_locked(queue, true);
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -651,7 +789,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT) &&
+			   sys_slist_is_empty(&queue->pending) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -701,8 +841,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
 			finalize_cancel_locked(work);
 		}
+		release_flushers_locked(queue, work);
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue_busy_locked(queue, false);
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -742,6 +883,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_slist_init(&queue->workers);
+	queue->busy = 0U;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -770,6 +915,41 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+void k_work_queue_worker_start(struct k_work_q *queue,
+			       struct k_work_q_worker *worker,
+			       k_thread_stack_t *stack,
+			       size_t stack_size,
+			       int prio,
+			       const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, NULL, NULL,
+			      prio, 0, K_FOREVER);
+
+	if ((cfg != NULL) && (cfg->name != NULL)) {
+		k_thread_name_set(&worker->thread, cfg->name);
+	}
+
+	if ((cfg != NULL) && (cfg->essential)) {
+		worker->thread.base.user_options |= K_ESSENTIAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &worker->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC32_INTERNAL_H_
+#define ZEPHYR_LIB_CRC_CRC32_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(CONFIG_CRC32_ARCH_INSTRUCTIONS) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32_ARM_CRC32 1
+#endif
+
+#if defined(CONFIG_CRC32_ARCH_INSTRUCTIONS) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CRC32C_X86_SSE42 1
+#endif
+
+extern const uint32_t crc32_ieee_slice8_table[8][256];
+extern const uint32_t crc32c_slice8_table[8][256];
+
+/* Update a reflected CRC-32 without pre or post inversion */
+uint32_t crc32_slice8(const uint32_t table[8][256], uint32_t crc, const uint8_t *data, size_t len);
+
+#ifdef CRC32_ARM_CRC32
+/* Bytes up to a word boundary first, the instructions take whole words */
+#define CRC32_ARM_UPDATE(crc, data, len, insn_b, insn_w)      \
+	do {                                                  \
+		uint32_t word;                                \
+		while ((len) > 0 && ((uintptr_t)(data) & 3)) { \
+			crc = insn_b(crc, *(data)++);         \
+			(len)--;                              \
+		}                                             \
+		for (; (len) >= 4; (len) -= 4, (data) += 4) { \
+			memcpy(&word, data, sizeof(word));    \
+			crc = insn_w(crc, word);              \
+		}                                             \
+		for (; (len) > 0; (len)--) {                  \
+			crc = insn_b(crc, *(data)++);         \
+		}                                             \
+	} while (false)
+
+static inline uint32_t crc32_ieee_arm(uint32_t crc, const uint8_t *data, size_t len)
+{
+	CRC32_ARM_UPDATE(crc, data, len, __crc32b, __crc32w);
+
+	return crc;
+}
+
+static inline uint32_t crc32c_arm(uint32_t crc, const uint8_t *data, size_t len)
+{
+	CRC32_ARM_UPDATE(crc, data, len, __crc32cb, __crc32cw);
+
+	return crc;
+}
+#endif /* CRC32_ARM_CRC32 */
+
+#ifdef CRC32C_X86_SSE42
+static inline uint32_t crc32c_x86(uint32_t crc, const uint8_t *data, size_t len)
+{
+	uint32_t word;
+
+	for (; len >= 4; len -= 4, data += 4) {
+		memcpy(&word, data, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+	}
+
+	for (; len > 0; len--) {
+		crc = _mm_crc32_u8(crc, *data++);
+	}
+
+	return crc;
+}
+#endif /* CRC32C_X86_SSE42 */
+
+#endif /* ZEPHYR_LIB_CRC_CRC32_INTERNAL_H_ */
@@ -6,6 +6,8 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc32_internal.h"
+
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
@@ -13,6 +15,11 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#if defined(CRC32_ARM_CRC32)
+	return ~crc32_ieee_arm(~crc, data, len);
+#elif defined(CONFIG_CRC32_SLICE_BY_8)
+	return ~crc32_slice8(crc32_ieee_slice8_table, ~crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU,
@@ -31,4 +38,5 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 	}
 
 	return (~crc);
+#endif
 }
@@ -6,13 +6,7 @@
 
 #include <zephyr/sys/crc.h>
 
-/* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
-static const uint32_t crc32c_table[16] = {
-	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
-	0x417B1DBCUL, 0x5125DAD3UL, 0x61C69362UL, 0x7198540DUL,
-	0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
-	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
-};
+#include "crc32_internal.h"
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -31,10 +25,26 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		crc = CRC32C_INIT;
 	}
 
+#if defined(CRC32_ARM_CRC32)
+	crc = crc32c_arm(crc, data, len);
+#elif defined(CRC32C_X86_SSE42)
+	crc = crc32c_x86(crc, data, len);
+#elif defined(CONFIG_CRC32_SLICE_BY_8)
+	crc = crc32_slice8(crc32c_slice8_table, crc, data, len);
+#else
+	/* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
+	static const uint32_t crc32c_table[16] = {
+		0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
+		0x417B1DBCUL, 0x5125DAD3UL, 0x61C69362UL, 0x7198540DUL,
+		0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
+		0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
+	};
+
 	for (size_t i = 0; i < len; i++) {
 		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
 		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
@@ -24,6 +24,7 @@ static const char *const crc_types[] = {
 	[CRC7_BE] = "7_be",
 	[CRC8] = "8",
 	[CRC8_CCITT] = "8_ccitt",
+	[CRC8_ROHC] = "8_rohc",
 	[CRC16] = "16",
 	[CRC16_ANSI] = "16_ansi",
 	[CRC16_CCITT] = "16_ccitt",
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Each bucket has a control byte, kept apart from the entries: either
+ * EMPTY, DELETED, or the low 7 bits of the hash of the key in the bucket.
+ * Buckets are probed a group of GROUP_SIZE control bytes at a time, with
+ * one 64-bit word per group and bitwise arithmetic finding the candidate
+ * buckets of a group at once (SWAR). Keys are only compared for buckets
+ * whose control byte matches, and a lookup ends at the first group with
+ * an EMPTY bucket.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+
+#define GROUP_SIZE 8
+
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xfe
+
+#define LSB_BYTES 0x0101010101010101ULL
+#define MSB_BYTES 0x8080808080808080ULL
+
+struct swiss_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static inline uint64_t group_load(const uint8_t *ctrl, size_t group)
+{
+	return sys_get_le64(&ctrl[group * GROUP_SIZE]);
+}
+
+/* Bitmask with the most significant bit set for each control byte equal
+ * to @p h2. May have false positives, which the key comparison rejects.
+ */
+static inline uint64_t group_match(uint64_t ctrl, uint8_t h2)
+{
+	uint64_t x = ctrl ^ (LSB_BYTES * h2);
+
+	return (x - LSB_BYTES) & ~x & MSB_BYTES;
+}
+
+static inline uint64_t group_match_empty(uint64_t ctrl)
+{
+	/* Only EMPTY has the most significant bit set and bit 1 clear. */
+	return ctrl & ~(ctrl << 6) & MSB_BYTES;
+}
+
+static inline uint64_t group_match_free(uint64_t ctrl)
+{
+	return ctrl & MSB_BYTES;
+}
+
+static inline size_t mask_first(uint64_t mask)
+{
+	return u64_count_trailing_zeros(mask) / 8;
+}
+
+static inline uint32_t swiss_hash(const struct sys_hashmap *map, uint64_t key)
+{
+	return map->hash_func(&key, sizeof(key));
+}
+
+/* Triangular probing visits every group once when the number of groups
+ * is a power of two.
+ */
+#define FOR_EACH_PROBED_GROUP(_data, _hash, _group, _i)                                           \
+	for (size_t _i = 0, _group = ((_hash) >> 7) & ((_data)->n_buckets / GROUP_SIZE - 1);       \
+	     _i < (_data)->n_buckets / GROUP_SIZE;                                                 \
+	     ++_i, _group = (_group + _i) & ((_data)->n_buckets / GROUP_SIZE - 1))
+
+static struct swiss_entry *sys_hashmap_swiss_find(const struct sys_hashmap *map, uint64_t key,
+						  size_t *index)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *const buckets = data->buckets;
+	uint32_t hash;
+
+	if (data->n_buckets == 0) {
+		return NULL;
+	}
+
+	hash = swiss_hash(map, key);
+
+	FOR_EACH_PROBED_GROUP(data, hash, group, i) {
+		uint64_t ctrl = group_load(data->ctrl, group);
+
+		for (uint64_t m = group_match(ctrl, hash & 0x7f); m != 0; m &= m - 1) {
+			size_t j = group * GROUP_SIZE + mask_first(m);
+
+			if (buckets[j].key == key) {
+				*index = j;
+				return &buckets[j];
+			}
+		}
+
+		if (group_match_empty(ctrl) != 0) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/* Stores an entry known not to be in the table in the first free bucket
+ * of its probe sequence.
+ */
+static void sys_hashmap_swiss_store(struct sys_hashmap *map, uint64_t key, uint64_t value)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *const buckets = data->buckets;
+	uint32_t hash = swiss_hash(map, key);
+
+	FOR_EACH_PROBED_GROUP(data, hash, group, i) {
+		uint64_t m = group_match_free(group_load(data->ctrl, group));
+		size_t j;
+
+		if (m == 0) {
+			continue;
+		}
+
+		j = group * GROUP_SIZE + mask_first(m);
+
+		if (data->ctrl[j] == CTRL_DELETED) {
+			--data->n_tombstones;
+		}
+
+		data->ctrl[j] = hash & 0x7f;
+		buckets[j].key = key;
+		buckets[j].value = value;
+		++data->size;
+
+		return;
+	}
+
+	__ASSERT(false, "No free bucket. Memory has been corrupted");
+}
+
+/* Smallest table holding @p n entries within the load factor */
+static size_t sys_hashmap_swiss_n_buckets(const struct sys_hashmap *map, size_t n)
+{
+	size_t load_factor = MIN(map->config->load_factor, 100);
+	size_t n_buckets = GROUP_SIZE;
+
+	while (n * 100 > n_buckets * load_factor) {
+		n_buckets <<= 1;
+	}
+
+	return n_buckets;
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, size_t new_n_buckets)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *old_buckets = data->buckets;
+	uint8_t *old_ctrl = data->ctrl;
+	size_t old_n_buckets = data->n_buckets;
+	size_t old_size = data->size;
+	struct swiss_entry *new_buckets = NULL;
+
+	if (new_n_buckets != 0) {
+		/* entries first, so that they are suitably aligned */
+		new_buckets = map->alloc_func(NULL, new_n_buckets * (sizeof(*new_buckets) + 1));
+		if (new_buckets == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	data->buckets = new_buckets;
+	data->ctrl = NULL;
+	data->n_buckets = new_n_buckets;
+	data->size = 0;
+	data->n_tombstones = 0;
+
+	if (new_buckets != NULL) {
+		data->ctrl = (uint8_t *)&new_buckets[new_n_buckets];
+		memset(data->ctrl, CTRL_EMPTY, new_n_buckets);
+	}
+
+	for (size_t i = 0, j = 0; i < old_n_buckets && j < old_size; ++i) {
+		if ((old_ctrl[i] & CTRL_EMPTY) == 0) {
+			sys_hashmap_swiss_store(map, old_buckets[i].key, old_buckets[i].value);
+			++j;
+		}
+	}
+
+	if (old_buckets != NULL) {
+		map->alloc_func(old_buckets, 0);
+	}
+
+	return 0;
+}
+
+int sys_hashmap_swiss_reserve(struct sys_hashmap *map, size_t n)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	size_t n_buckets;
+	int ret;
+
+	if (n > map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	__ASSERT_NO_MSG(n < SIZE_MAX / 100);
+
+	n_buckets = n > 0 ? sys_hashmap_swiss_n_buckets(map, MAX(n, data->size)) : 0;
+	if (n_buckets > data->n_buckets) {
+		ret = sys_hashmap_swiss_rehash(map, n_buckets);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	data->reserved = n;
+
+	return 0;
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *buckets = data->buckets;
+
+	__ASSERT(it->size == data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = buckets;
+	}
+
+	i = (struct swiss_entry *)it->state - buckets;
+	__ASSERT(i < data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < data->n_buckets; ++i) {
+		if ((data->ctrl[i] & CTRL_EMPTY) == 0) {
+			it->state = &buckets[i + 1];
+			it->key = buckets[i].key;
+			it->value = buckets[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *buckets = data->buckets;
+
+	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
+		if ((data->ctrl[i] & CTRL_EMPTY) == 0) {
+			cb(buckets[i].key, buckets[i].value, cookie);
+			++j;
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->ctrl = NULL;
+	data->n_buckets = 0;
+	data->size = 0;
+	data->n_tombstones = 0;
+	data->reserved = 0;
+}
+
+static int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *entry;
+	size_t n_buckets;
+	size_t index;
+	int ret;
+
+	entry = sys_hashmap_swiss_find(map, key, &index);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+
+		return 0;
+	}
+
+	if (data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	__ASSERT_NO_MSG(data->size < SIZE_MAX / 100);
+
+	n_buckets = sys_hashmap_swiss_n_buckets(map, data->size + 1);
+	if (n_buckets > data->n_buckets) {
+		ret = sys_hashmap_swiss_rehash(map, n_buckets);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	sys_hashmap_swiss_store(map, key, value);
+
+	return 1;
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *entry;
+	size_t index;
+
+	entry = sys_hashmap_swiss_find(map, key, &index);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	/* Lookups stop at the first group with an EMPTY bucket, so a bucket
+	 * may only become EMPTY again if its group already has one: no probe
+	 * sequence continues past that group.
+	 */
+	if (group_match_empty(group_load(data->ctrl, index / GROUP_SIZE)) != 0) {
+		data->ctrl[index] = CTRL_EMPTY;
+	} else {
+		data->ctrl[index] = CTRL_DELETED;
+		++data->n_tombstones;
+	}
+
+	--data->size;
+
+	/* The table is only given back once empty, unless room was reserved.
+	 * Ignore a possible -ENOMEM since the table will remain intact.
+	 */
+	if (data->size == 0 && data->reserved == 0) {
+		(void)sys_hashmap_swiss_rehash(map, 0);
+	}
+
+	return true;
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct swiss_entry *entry;
+	size_t index;
+
+	entry = sys_hashmap_swiss_find(map, key, &index);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include "heap.h"
+
+/* Per-CPU front-end caches for small allocations.
+ *
+ * Each CPU keeps a short LIFO list of free blocks per size class.
+ * The blocks stay allocated as far as the heap is concerned, so
+ * taking one off a list or putting one back never touches the heap
+ * metadata: no bucket search, no split_chunks()/merge_chunks(), and
+ * no need for the heap's lock.  A CPU only ever touches its own lists,
+ * with local interrupts masked, which is all the synchronization they
+ * need.
+ */
+
+static inline struct z_heap_cache *cpu_cache(struct sys_heap *heap)
+{
+#ifdef CONFIG_SMP
+	return &heap->cache[arch_curr_cpu()->id];
+#else
+	return &heap->cache[0];
+#endif
+}
+
+static inline int class_idx(size_t bytes)
+{
+	return u32_count_trailing_zeros(sys_heap_cache_bytes(bytes) /
+					SYS_HEAP_CACHE_MIN_BYTES);
+}
+
+/* Usable size of a block allocated for size class @p cls */
+static inline size_t class_usable_bytes(struct z_heap *h, int cls)
+{
+	return chunksz_to_bytes(h, bytes_to_chunksz(h, SYS_HEAP_CACHE_MIN_BYTES << cls));
+}
+
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t bytes)
+{
+	struct z_heap_cache *cache;
+	unsigned int key;
+	void *mem;
+	int cls;
+
+	if ((bytes == 0U) || (bytes > SYS_HEAP_CACHE_MAX_BYTES)) {
+		return NULL;
+	}
+
+	cls = class_idx(bytes);
+	key = arch_irq_lock();
+	cache = cpu_cache(heap);
+
+	mem = cache->head[cls];
+	if (mem != NULL) {
+		cache->head[cls] = *(void **)mem;
+		cache->count[cls]--;
+	}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	if (mem != NULL) {
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+#endif
+
+	arch_irq_unlock(key);
+
+	return mem;
+}
+
+bool sys_heap_cache_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap_cache *cache;
+	unsigned int key;
+	size_t usable;
+	int cls;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	/* The block is ours until freed, so its size is stable */
+	usable = sys_heap_usable_size(heap, mem);
+	if (usable < SYS_HEAP_CACHE_MIN_BYTES) {
+		return false;
+	}
+
+	cls = class_idx(MIN(usable, SYS_HEAP_CACHE_MAX_BYTES));
+	if ((cls > 0) && (class_usable_bytes(heap->heap, cls) > usable)) {
+		cls--;
+	}
+	if (class_usable_bytes(heap->heap, cls) != usable) {
+		/* Not allocated at a class size, let the heap reclaim it */
+		return false;
+	}
+
+	key = arch_irq_lock();
+	cache = cpu_cache(heap);
+
+	if (cache->count[cls] >= CONFIG_SYS_HEAP_CACHE_BLOCKS) {
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	*(void **)mem = cache->head[cls];
+	cache->head[cls] = mem;
+	cache->count[cls]++;
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+bool sys_heap_cache_flush(struct sys_heap *heap)
+{
+	struct z_heap_cache *cache = cpu_cache(heap);
+	bool flushed = false;
+
+	for (int cls = 0; cls < SYS_HEAP_CACHE_CLASSES; cls++) {
+		while (cache->head[cls] != NULL) {
+			void *mem = cache->head[cls];
+
+			cache->head[cls] = *(void **)mem;
+			sys_heap_free(heap, mem);
+			flushed = true;
+		}
+		cache->count[cls] = 0;
+	}
+
+	return flushed;
+}
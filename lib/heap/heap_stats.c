@@ -32,3 +32,34 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 
 	return 0;
 }
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	*stats = (struct sys_heap_cache_stats) {0};
+
+	/* Other CPUs may be updating their counters, so this is only a
+	 * snapshot
+	 */
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		struct z_heap_cache *cache = &heap->cache[cpu];
+
+		stats->hits += cache->hits;
+		stats->misses += cache->misses;
+
+		for (int cls = 0; cls < SYS_HEAP_CACHE_CLASSES; cls++) {
+			size_t bytes = SYS_HEAP_CACHE_MIN_BYTES << cls;
+
+			stats->cached_bytes += cache->count[cls] *
+				chunksz_to_bytes(heap->heap, bytes_to_chunksz(heap->heap, bytes));
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
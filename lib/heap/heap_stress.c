@@ -96,6 +96,14 @@ static size_t rand_free_choice(struct z_heap_stress_rec *sr)
 	return rand32() % sr->blocks_alloced;
 }
 
+static void record_latency(uint64_t *accumulated, uint32_t *max, uint32_t start)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	*accumulated += cycles;
+	*max = MAX(*max, cycles);
+}
+
 /* General purpose heap stress test.  Takes function pointers to allow
  * for testing multiple heap APIs with the same rig.  The alloc and
  * free functions are passed back the argument as a context pointer.
@@ -127,8 +135,11 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	for (uint32_t i = 0; i < op_count; i++) {
 		if (rand_alloc_choice(&sr)) {
 			size_t sz = rand_alloc_size(&sr);
+			uint32_t start = k_cycle_get_32();
 			void *p = sr.alloc_fn(sr.arg, sz);
 
+			record_latency(&result->accumulated_alloc_cycles,
+				       &result->max_alloc_cycles, start);
 			result->total_allocs++;
 			if (p != NULL) {
 				result->successful_allocs++;
@@ -146,7 +157,12 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
 			sr.blocks_alloced--;
 			sr.bytes_alloced -= sz;
+
+			uint32_t start = k_cycle_get_32();
+
 			sr.free_fn(sr.arg, p);
+			record_latency(&result->accumulated_free_cycles,
+				       &result->max_free_cycles, start);
 		}
 		result->accumulated_in_use_bytes += sr.bytes_alloced;
 	}
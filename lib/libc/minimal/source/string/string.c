@@ -226,6 +226,38 @@ int memcmp(const void *m1, const void *m2, size_t n)
 		return 0;
 	}
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & mask) == 0) {
+		while ((((uintptr_t)c1) & mask) && (n > 0) && (*c1 == *c2)) {
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/* compare words until the first one that differs */
+
+		if ((((uintptr_t)c1) & mask) == 0) {
+			const mem_word_t *w1 = (const mem_word_t *)c1;
+			const mem_word_t *w2 = (const mem_word_t *)c2;
+
+			while ((n >= sizeof(mem_word_t)) && (*w1 == *w2)) {
+				w1++;
+				w2++;
+				n -= sizeof(mem_word_t);
+			}
+
+			c1 = (const char *)w1;
+			c2 = (const char *)w2;
+		}
+
+		if (n == 0) {
+			return 0;
+		}
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -269,6 +301,49 @@ void *memmove(void *d, const void *s, size_t n)
 	return d;
 }
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+/*
+ * Word-sized copying for buffers which are not aligned the same: the
+ * destination is aligned and every word is merged from two aligned source
+ * words. A source word is only loaded when it holds bytes to be copied.
+ *
+ * Returns the number of bytes left to copy.
+ */
+static size_t memcpy_shifted(unsigned char **d_byte, const unsigned char **s_byte, size_t n)
+{
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+	unsigned char *d = *d_byte;
+	const unsigned char *s = *s_byte;
+
+	while (((uintptr_t)d) & mask) {
+		*(d++) = *(s++);
+		n--;
+	}
+
+	const unsigned int shift = (((uintptr_t)s) & mask) * 8U;
+	const mem_word_t *s_word = (const mem_word_t *)((uintptr_t)s & ~mask);
+	mem_word_t *d_word = (mem_word_t *)d;
+	mem_word_t lo = *(s_word++);
+
+	while (n >= 2 * sizeof(mem_word_t)) {
+		mem_word_t hi = *(s_word++);
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		*(d_word++) = (lo >> shift) | (hi << (Z_MEM_WORD_T_WIDTH - shift));
+#else
+		*(d_word++) = (lo << shift) | (hi >> (Z_MEM_WORD_T_WIDTH - shift));
+#endif
+		lo = hi;
+		n -= sizeof(mem_word_t);
+	}
+
+	*d_byte = (unsigned char *)d_word;
+	*s_byte = (const unsigned char *)(s_word - 1) + (shift / 8U);
+
+	return n;
+}
+#endif
+
 /**
  *
  * @brief Copy bytes in memory
@@ -303,6 +378,23 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+		while (n >= 4 * sizeof(mem_word_t)) {
+			mem_word_t w0 = s_word[0];
+			mem_word_t w1 = s_word[1];
+			mem_word_t w2 = s_word[2];
+			mem_word_t w3 = s_word[3];
+
+			d_word[0] = w0;
+			d_word[1] = w1;
+			d_word[2] = w2;
+			d_word[3] = w3;
+			d_word += 4;
+			s_word += 4;
+			n -= 4 * sizeof(mem_word_t);
+		}
+#endif
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -311,6 +403,11 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 		d_byte = (unsigned char *)d_word;
 		s_byte = (unsigned char *)s_word;
 	}
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+	else if (n >= 3 * sizeof(mem_word_t)) {
+		n = memcpy_shifted(&d_byte, &s_byte, n);
+	}
+#endif
 #endif
 
 	/* do byte-sized copying until finished */
@@ -357,6 +454,17 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SPEED)
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+#endif
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -86,6 +87,162 @@ out:
 	return ret;
 }
 
+#if CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE > 0
+/*
+ * Per-CPU caches of single blocks.
+ *
+ * A freed block put into the cache of the current CPU stays set in the
+ * bitmap, so handing it out again needs neither a bitmap search nor a
+ * bitmap update. Only the runtime statistics count it as free. Caches are
+ * drained back into the bitmap whenever the bitmap alone cannot satisfy
+ * a request.
+ */
+
+static inline void blocks_used_add(sys_mem_blocks_t *mem_block, int32_t num_blocks)
+{
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	k_spinlock_key_t key = k_spin_lock(&mem_block->lock);
+
+	mem_block->info.used_blocks += num_blocks;
+
+	if (mem_block->info.max_used_blocks < mem_block->info.used_blocks) {
+		mem_block->info.max_used_blocks = mem_block->info.used_blocks;
+	}
+
+	k_spin_unlock(&mem_block->lock, key);
+#else
+	ARG_UNUSED(mem_block);
+	ARG_UNUSED(num_blocks);
+#endif
+}
+
+static void *cache_get(sys_mem_blocks_t *mem_block)
+{
+	struct sys_mem_blocks_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	void *blk = NULL;
+
+	/* Stay on this CPU while picking its cache */
+	irq_key = arch_irq_lock();
+	cache = &mem_block->cpu_cache[arch_curr_cpu()->id];
+	key = k_spin_lock(&cache->lock);
+
+	if (cache->count > 0U) {
+		blk = cache->blocks[--cache->count];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	if (blk != NULL) {
+		blocks_used_add(mem_block, 1);
+	}
+
+	return blk;
+}
+
+/* Returns -ENOSPC if the block is to be given back to the bitmap instead */
+static int cache_put(sys_mem_blocks_t *mem_block, void *ptr)
+{
+	struct sys_mem_blocks_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	uint8_t *blk = ptr;
+	size_t offset;
+	int ret = -ENOSPC;
+	int val;
+
+	/* Leave invalid frees to free_blocks() to report */
+	if ((blk < mem_block->buffer) ||
+	    ((blk - mem_block->buffer) & (BIT(mem_block->info.blk_sz_shift) - 1)) != 0) {
+		return -ENOSPC;
+	}
+
+	offset = (blk - mem_block->buffer) >> mem_block->info.blk_sz_shift;
+	if ((offset >= mem_block->info.num_blocks) ||
+	    (sys_bitarray_test_bit(mem_block->bitmap, offset, &val) != 0) || (val == 0)) {
+		return -ENOSPC;
+	}
+
+	irq_key = arch_irq_lock();
+	cache = &mem_block->cpu_cache[arch_curr_cpu()->id];
+	key = k_spin_lock(&cache->lock);
+
+	/* Catch blocks freed twice on the same CPU */
+	for (uint32_t i = 0; i < cache->count; i++) {
+		if (cache->blocks[i] == ptr) {
+			ret = -EFAULT;
+			break;
+		}
+	}
+
+	if ((ret == -ENOSPC) && (cache->count < CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE)) {
+		cache->blocks[cache->count++] = ptr;
+		ret = 0;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	if (ret == 0) {
+		blocks_used_add(mem_block, -1);
+	}
+
+	return ret;
+}
+
+/* Give the blocks cached by all CPUs back to the bitmap */
+static bool cache_drain(sys_mem_blocks_t *mem_block)
+{
+	void *blocks[CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE];
+	bool drained = false;
+
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		struct sys_mem_blocks_cpu_cache *cache = &mem_block->cpu_cache[cpu];
+		uint32_t count = 0;
+
+		K_SPINLOCK(&cache->lock) {
+			count = cache->count;
+			memcpy(blocks, cache->blocks, count * sizeof(blocks[0]));
+			cache->count = 0U;
+		}
+
+		for (uint32_t i = 0; i < count; i++) {
+			size_t offset = ((uint8_t *)blocks[i] - mem_block->buffer) >>
+					mem_block->info.blk_sz_shift;
+
+			(void)sys_bitarray_free(mem_block->bitmap, 1, offset);
+			drained = true;
+		}
+	}
+
+	return drained;
+}
+#else
+static inline void *cache_get(sys_mem_blocks_t *mem_block)
+{
+	ARG_UNUSED(mem_block);
+
+	return NULL;
+}
+
+static inline int cache_put(sys_mem_blocks_t *mem_block, void *ptr)
+{
+	ARG_UNUSED(mem_block);
+	ARG_UNUSED(ptr);
+
+	return -ENOSPC;
+}
+
+static inline bool cache_drain(sys_mem_blocks_t *mem_block)
+{
+	ARG_UNUSED(mem_block);
+
+	return false;
+}
+#endif /* CONFIG_SYS_MEM_BLOCKS_CPU_CACHE_SIZE > 0 */
+
 int sys_mem_blocks_alloc_contiguous(sys_mem_blocks_t *mem_block, size_t count,
 				    void **out_block)
 {
@@ -108,6 +265,10 @@ int sys_mem_blocks_alloc_contiguous(sys_mem_blocks_t *mem_block, size_t count,
 
 	void *ptr = alloc_blocks(mem_block, count);
 
+	if ((ptr == NULL) && cache_drain(mem_block)) {
+		ptr = alloc_blocks(mem_block, count);
+	}
+
 	if (ptr == NULL) {
 		ret = -ENOMEM;
 		goto out;
@@ -146,7 +307,15 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 	}
 
 	for (i = 0; i < count; i++) {
-		void *ptr = alloc_blocks(mem_block, 1);
+		void *ptr = cache_get(mem_block);
+
+		if (ptr == NULL) {
+			ptr = alloc_blocks(mem_block, 1);
+		}
+
+		if ((ptr == NULL) && cache_drain(mem_block)) {
+			ptr = alloc_blocks(mem_block, 1);
+		}
 
 		if (ptr == NULL) {
 			break;
@@ -188,6 +357,11 @@ int sys_mem_blocks_is_region_free(sys_mem_blocks_t *mem_block, void *in_block,
 
 	result = sys_bitarray_is_region_cleared(mem_block->bitmap, count,
 						offset);
+	if (!result && cache_drain(mem_block)) {
+		result = sys_bitarray_is_region_cleared(mem_block->bitmap, count,
+							offset);
+	}
+
 	return result;
 }
 
@@ -221,6 +395,11 @@ int sys_mem_blocks_get(sys_mem_blocks_t *mem_block, void *in_block, size_t count
 	ret = sys_bitarray_test_and_set_region(mem_block->bitmap, count,
 					       offset, true);
 
+	if ((ret != 0) && cache_drain(mem_block)) {
+		ret = sys_bitarray_test_and_set_region(mem_block->bitmap, count,
+						       offset, true);
+	}
+
 	if (ret != 0) {
 #ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
 		k_spin_unlock(&mem_block->lock, key);
@@ -273,7 +452,11 @@ int sys_mem_blocks_free(sys_mem_blocks_t *mem_block, size_t count,
 	for (i = 0; i < count; i++) {
 		void *ptr = in_blocks[i];
 
-		int r = free_blocks(mem_block, ptr, 1);
+		int r = cache_put(mem_block, ptr);
+
+		if (r == -ENOSPC) {
+			r = free_blocks(mem_block, ptr, 1);
+		}
 
 		if (r != 0) {
 			ret = r;
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/cache.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/dma_memcpy.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(dma_memcpy, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define NUM_CHANNELS CONFIG_DMA_MEMCPY_CHANNELS
+#define BLOCK_SIZE   CONFIG_DMA_MEMCPY_BLOCK_SIZE
+
+/* Blocks must keep the data width of the whole copy */
+BUILD_ASSERT((BLOCK_SIZE % sizeof(uint32_t)) == 0,
+	     "DMA memcpy block size must be a multiple of 4");
+
+struct dma_memcpy_chan {
+	uint32_t channel;
+	struct dma_config cfg;
+	struct dma_block_config blocks[CONFIG_DMA_MEMCPY_BLOCKS];
+	/* Copy in progress */
+	void *dst;
+	size_t len;
+	dma_memcpy_cb_t cb;
+	void *user_data;
+};
+
+static const struct device *const dma_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_dma_memcpy));
+
+static struct dma_memcpy_chan chans[NUM_CHANNELS];
+/* Bit mask of the channels free for a copy */
+static atomic_t free_chans;
+static uint32_t max_blocks = CONFIG_DMA_MEMCPY_BLOCKS;
+static uint32_t addr_align = 1U;
+
+struct dma_memcpy_sync {
+	struct k_sem sem;
+	int result;
+};
+
+static struct dma_memcpy_chan *chan_get(void)
+{
+	atomic_val_t free;
+
+	do {
+		free = atomic_get(&free_chans);
+		if (free == 0) {
+			return NULL;
+		}
+	} while (!atomic_cas(&free_chans, free, free & (free - 1)));
+
+	return &chans[u32_count_trailing_zeros((uint32_t)free)];
+}
+
+static void chan_put(struct dma_memcpy_chan *chan)
+{
+	(void)atomic_or(&free_chans, BIT(chan - chans));
+}
+
+static bool addr_fits(uintptr_t addr)
+{
+	/* Block addresses are 32 bits wide without CONFIG_DMA_64BIT */
+	return !IS_ENABLED(CONFIG_64BIT) || IS_ENABLED(CONFIG_DMA_64BIT) ||
+	       (uint64_t)addr <= UINT32_MAX;
+}
+
+static bool can_offload(void *dst, const void *src, size_t len)
+{
+	uintptr_t d = (uintptr_t)dst;
+	uintptr_t s = (uintptr_t)src;
+
+	return len >= CONFIG_DMA_MEMCPY_THRESHOLD &&
+	       DIV_ROUND_UP(len, BLOCK_SIZE) <= max_blocks &&
+	       (d % addr_align) == 0U && (s % addr_align) == 0U &&
+	       addr_fits(d + len) && addr_fits(s + len);
+}
+
+/* Widest transfer unit dividing both addresses and the length */
+static uint32_t data_width(uintptr_t dst, uintptr_t src, size_t len)
+{
+	uintptr_t bits = dst | src | len;
+
+	if ((bits & 0x3) == 0U) {
+		return 4U;
+	}
+
+	return (bits & 0x1) == 0U ? 2U : 1U;
+}
+
+static void dma_memcpy_done(const struct device *dev, void *user_data, uint32_t channel,
+			    int status)
+{
+	struct dma_memcpy_chan *chan = user_data;
+	dma_memcpy_cb_t cb = chan->cb;
+	void *cb_data = chan->user_data;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(channel);
+
+	/* Drop the destination lines the CPU may have fetched meanwhile */
+	(void)sys_cache_data_invd_range(chan->dst, chan->len);
+
+	chan_put(chan);
+
+	cb(status < 0 ? status : 0, cb_data);
+}
+
+static int chan_start(struct dma_memcpy_chan *chan, void *dst, const void *src, size_t len)
+{
+	uintptr_t d = (uintptr_t)dst;
+	uintptr_t s = (uintptr_t)src;
+	uint32_t width = data_width(d, s, len);
+	size_t num_blocks = DIV_ROUND_UP(len, BLOCK_SIZE);
+	int ret;
+
+	chan->cfg = (struct dma_config){
+		.channel_direction = MEMORY_TO_MEMORY,
+		.source_data_size = width,
+		.dest_data_size = width,
+		.source_burst_length = width,
+		.dest_burst_length = width,
+		.block_count = num_blocks,
+		.head_block = &chan->blocks[0],
+		.user_data = chan,
+		.dma_callback = dma_memcpy_done,
+	};
+
+	for (size_t i = 0; i < num_blocks; i++) {
+		size_t offset = i * BLOCK_SIZE;
+
+		chan->blocks[i] = (struct dma_block_config){
+			.source_address = s + offset,
+			.dest_address = d + offset,
+			.block_size = MIN(BLOCK_SIZE, len - offset),
+			.next_block = (i + 1 < num_blocks) ? &chan->blocks[i + 1] : NULL,
+		};
+	}
+
+	/*
+	 * Write the source back for the controller to read it, and the
+	 * destination too, not to lose the data sharing its first and last
+	 * cache lines when they are invalidated on completion.
+	 */
+	(void)sys_cache_data_flush_range((void *)src, len);
+	(void)sys_cache_data_flush_and_invd_range(dst, len);
+
+	ret = dma_config(dma_dev, chan->channel, &chan->cfg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return dma_start(dma_dev, chan->channel);
+}
+
+int dma_memcpy_async(void *dst, const void *src, size_t len, dma_memcpy_cb_t cb,
+		     void *user_data)
+{
+	struct dma_memcpy_chan *chan = NULL;
+	int ret;
+
+	if (cb == NULL) {
+		return -EINVAL;
+	}
+
+	if (can_offload(dst, src, len)) {
+		chan = chan_get();
+	}
+
+	if (chan != NULL) {
+		chan->dst = dst;
+		chan->len = len;
+		chan->cb = cb;
+		chan->user_data = user_data;
+
+		ret = chan_start(chan, dst, src, len);
+		if (ret == 0) {
+			return 0;
+		}
+
+		LOG_DBG("Failed to start DMA channel %u: %d", chan->channel, ret);
+		chan_put(chan);
+	}
+
+	memcpy(dst, src, len);
+	cb(0, user_data);
+
+	return 0;
+}
+
+static void dma_memcpy_sync_done(int result, void *user_data)
+{
+	struct dma_memcpy_sync *sync = user_data;
+
+	sync->result = result;
+	k_sem_give(&sync->sem);
+}
+
+int dma_memcpy(void *dst, const void *src, size_t len)
+{
+	struct dma_memcpy_sync sync;
+
+	if (k_is_in_isr() || !can_offload(dst, src, len)) {
+		memcpy(dst, src, len);
+		return 0;
+	}
+
+	k_sem_init(&sync.sem, 0, 1);
+
+	(void)dma_memcpy_async(dst, src, len, dma_memcpy_sync_done, &sync);
+	(void)k_sem_take(&sync.sem, K_FOREVER);
+
+	return sync.result;
+}
+
+static int dma_memcpy_init(void)
+{
+	uint32_t value;
+	int ret;
+
+	if (!device_is_ready(dma_dev)) {
+		LOG_ERR("DMA controller %s not ready", dma_dev->name);
+		return -ENODEV;
+	}
+
+	if (dma_get_attribute(dma_dev, DMA_ATTR_MAX_BLOCK_COUNT, &value) == 0 && value > 0U) {
+		max_blocks = MIN(max_blocks, value);
+	}
+
+	if (dma_get_attribute(dma_dev, DMA_ATTR_BUFFER_ADDRESS_ALIGNMENT, &value) == 0 &&
+	    value > 1U) {
+		addr_align = value;
+	}
+
+	for (size_t i = 0; i < NUM_CHANNELS; i++) {
+		ret = dma_request_channel(dma_dev, NULL);
+		if (ret < 0) {
+			LOG_WRN("Got %zu DMA channels out of %d", i, NUM_CHANNELS);
+			break;
+		}
+
+		chans[i].channel = ret;
+		(void)atomic_or(&free_chans, BIT(i));
+	}
+
+	return 0;
+}
+
+SYS_INIT(dma_memcpy_init, POST_KERNEL, CONFIG_DMA_MEMCPY_INIT_PRIORITY);
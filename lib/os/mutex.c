@@ -30,6 +30,84 @@ static bool check_sys_mutex_addr(struct sys_mutex *addr)
 	return K_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* Protects moving the lock state of a sys_mutex between its user word and
+ * its kernel mutex.
+ */
+static struct k_spinlock lock;
+
+/* Number of threads that handed a mutex to the kernel and haven't returned
+ * from k_mutex_lock() yet. No mutex goes back to its user word while there
+ * are any, as they may be about to take the kernel mutex.
+ */
+static unsigned int kernel_lockers;
+
+static struct k_thread *get_thread(atomic_val_t val)
+{
+	struct k_object *obj;
+
+	/* The owner comes from user memory, so it must be checked */
+	obj = k_object_find((void *)val);
+	if (obj == NULL || obj->type != K_OBJ_THREAD ||
+	    (obj->flags & K_OBJ_FLAG_INITIALIZED) == 0U) {
+		return NULL;
+	}
+
+	return (struct k_thread *)val;
+}
+
+/* Give the lock state back to the user word once nobody is using the kernel
+ * mutex any more, so the next lock is syscall-free again.
+ */
+static void release_locked(struct sys_mutex *mutex, struct k_mutex *kernel_mutex)
+{
+	if (kernel_lockers == 0U && kernel_mutex->owner == NULL) {
+		(void)atomic_cas(&mutex->val, Z_SYS_MUTEX_KERNEL_OWNED, 0);
+	}
+}
+
+/* Make the kernel mutex hold the lock state of a mutex, moving the thread
+ * that locked it without a syscall into the kernel mutex owner.
+ *
+ * @retval 1 if the mutex was free and got locked by the current thread
+ * @retval 0 if the kernel mutex holds the lock state
+ * @retval -EINVAL if the user word doesn't reference a thread
+ */
+static int kernel_own_locked(struct sys_mutex *mutex,
+			     struct k_mutex *kernel_mutex)
+{
+	struct k_thread *owner;
+	atomic_val_t val;
+
+	do {
+		val = atomic_get(&mutex->val);
+		if (val == Z_SYS_MUTEX_KERNEL_OWNED) {
+			return 0;
+		}
+
+		if (val == 0) {
+			if (atomic_cas(&mutex->val, 0, (atomic_val_t)_current)) {
+				return 1;
+			}
+
+			continue;
+		}
+
+		owner = get_thread(val);
+		if (owner == NULL) {
+			return -EINVAL;
+		}
+	} while (!atomic_cas(&mutex->val, val, Z_SYS_MUTEX_KERNEL_OWNED));
+
+	/* The kernel mutex is unused while the user word holds the lock */
+	kernel_mutex->owner = owner;
+	kernel_mutex->lock_count = 1U;
+	kernel_mutex->owner_orig_prio = owner->base.prio;
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
@@ -38,7 +116,29 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret = kernel_own_locked(mutex, kernel_mutex);
+
+	if (ret != 0) {
+		k_spin_unlock(&lock, key);
+		return ret > 0 ? 0 : ret;
+	}
+
+	kernel_lockers++;
+	k_spin_unlock(&lock, key);
+
+	ret = k_mutex_lock(kernel_mutex, timeout);
+
+	key = k_spin_lock(&lock);
+	kernel_lockers--;
+	release_locked(mutex, kernel_mutex);
+	k_spin_unlock(&lock, key);
+
+	return ret;
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +156,46 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
-	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
+	if (kernel_mutex == NULL) {
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	atomic_val_t val = atomic_get(&mutex->val);
+	int ret;
+
+	if (val != Z_SYS_MUTEX_KERNEL_OWNED) {
+		if (val == 0) {
+			ret = -EINVAL;
+		} else if (atomic_cas(&mutex->val, (atomic_val_t)_current, 0)) {
+			ret = 0;
+		} else {
+			ret = -EPERM;
+		}
+
+		k_spin_unlock(&lock, key);
+		return ret;
+	}
+
+	k_spin_unlock(&lock, key);
+#endif
+
+	if (kernel_mutex->lock_count == 0) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+	ret = k_mutex_unlock(kernel_mutex);
+
+	key = k_spin_lock(&lock);
+	release_locked(mutex, kernel_mutex);
+	k_spin_unlock(&lock, key);
+
+	return ret;
+#else
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
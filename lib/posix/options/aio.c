@@ -1,5 +1,6 @@
 /*
  * Copyright 2024 Tenstorrent AI ULC
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,76 +8,474 @@
 #include <errno.h>
 #include <signal.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/posix/aio.h>
+#include <zephyr/posix/unistd.h>
+#include <zephyr/rtio/rtio.h>
+
+/*
+ * Requests are submitted to an RTIO context as reads (RTIO_OP_RX), writes
+ * (RTIO_OP_TX) or syncs (RTIO_OP_NOP) on the AIO iodev. It queues them for
+ * the AIO thread, which carries them out with the regular file descriptor
+ * functions, so they work the same for files, sockets and others.
+ */
+
+struct posix_aio_list {
+	/* Requests in progress, plus one while lio_listio() submits them */
+	atomic_t pending;
+	struct sigevent sigevent;
+};
+
+struct posix_aio_req {
+	/* NULL if the request slot is free */
+	struct aiocb *aiocbp;
+	struct posix_aio_list *list;
+	struct sigevent sigevent;
+	int fildes;
+	bool running;
+	bool canceled;
+};
+
+static struct posix_aio_req posix_aio_reqs[CONFIG_POSIX_AIO_MAX];
+K_MEM_SLAB_DEFINE_STATIC(posix_aio_list_slab, sizeof(struct posix_aio_list),
+			 CONFIG_POSIX_AIO_MAX, sizeof(void *));
+
+/* Guards the requests, their aiocb outcome and the RTIO context */
+static K_MUTEX_DEFINE(posix_aio_lock);
+/* Broadcast whenever requests complete or are canceled */
+static K_CONDVAR_DEFINE(posix_aio_done);
+/* Counts the requests queued for the AIO thread */
+static K_SEM_DEFINE(posix_aio_sem, 0, K_SEM_MAX_LIMIT);
+
+/* Requests generate no completion queue event, see aio_submit() */
+RTIO_DEFINE(posix_aio_rtio, CONFIG_POSIX_AIO_MAX, 1);
+
+static void posix_aio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe);
+
+static const struct rtio_iodev_api posix_aio_iodev_api = {
+	.submit = posix_aio_iodev_submit,
+};
+
+RTIO_IODEV_DEFINE(posix_aio_iodev, &posix_aio_iodev_api, NULL);
+
+static void posix_aio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	rtio_mpsc_push(&posix_aio_iodev.iodev_sq, &iodev_sqe->q);
+	k_sem_give(&posix_aio_sem);
+}
+
+static bool sigevent_is_valid(const struct sigevent *sigevent)
+{
+	switch (sigevent->sigev_notify) {
+	case SIGEV_NONE:
+		return true;
+	case SIGEV_THREAD:
+		return sigevent->sigev_notify_function != NULL;
+	default:
+		/* Signals are not delivered */
+		return false;
+	}
+}
+
+static void aio_notify(const struct sigevent *sigevent)
+{
+	if (sigevent->sigev_notify == SIGEV_THREAD) {
+		sigevent->sigev_notify_function(sigevent->sigev_value);
+	}
+}
+
+static void aio_list_put(struct posix_aio_list *list)
+{
+	if (atomic_dec(&list->pending) == 1) {
+		aio_notify(&list->sigevent);
+		k_mem_slab_free(&posix_aio_list_slab, list);
+	}
+}
+
+static bool errno_is_unseekable(int err)
+{
+	return (err == ESPIPE) || (err == ENOTSUP) || (err == EOPNOTSUPP);
+}
+
+static ssize_t aio_execute(const struct rtio_sqe *sqe, int fildes, off_t offset)
+{
+	/* The offset is meaningless for sockets and the like */
+	if ((sqe->op != RTIO_OP_NOP) && (lseek(fildes, offset, SEEK_SET) < 0) &&
+	    !errno_is_unseekable(errno)) {
+		return -1;
+	}
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		return read(fildes, sqe->buf, sqe->buf_len);
+	case RTIO_OP_TX:
+		return write(fildes, sqe->buf, sqe->buf_len);
+	default:
+#ifdef CONFIG_POSIX_FSYNC
+		return fsync(fildes);
+#else
+		errno = ENOSYS;
+		return -1;
+#endif
+	}
+}
+
+static void posix_aio_thread(void *p1, void *p2, void *p3)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	struct rtio_mpsc_node *node;
+	struct posix_aio_list *list;
+	struct posix_aio_req *req;
+	struct sigevent sigevent;
+	bool running;
+	ssize_t ret;
+	int err;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&posix_aio_sem, K_FOREVER);
+
+		/* The request may not be linked in yet if its push was preempted */
+		while ((node = rtio_mpsc_pop(&posix_aio_iodev.iodev_sq)) == NULL) {
+			k_yield();
+		}
+
+		iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+		req = iodev_sqe->sqe.userdata;
+
+		(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+		running = !req->canceled;
+		req->running = running;
+		k_mutex_unlock(&posix_aio_lock);
+
+		ret = -1;
+		err = ECANCELED;
+		if (running) {
+			ret = aio_execute(&iodev_sqe->sqe, req->fildes, req->aiocbp->aio_offset);
+			err = (ret < 0) ? errno : 0;
+		}
+
+		(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+
+		/* The sqe pool is not thread safe, release the sqe under the lock too */
+		if (err == 0) {
+			rtio_iodev_sqe_ok(iodev_sqe, 0);
+		} else {
+			rtio_iodev_sqe_err(iodev_sqe, -err);
+		}
+
+		if (running) {
+			req->aiocbp->_aio_return = ret;
+			req->aiocbp->_aio_error = err;
+		}
+		sigevent = req->sigevent;
+		list = req->list;
+		*req = (struct posix_aio_req){0};
+		k_condvar_broadcast(&posix_aio_done);
+		k_mutex_unlock(&posix_aio_lock);
+
+		aio_notify(&sigevent);
+		if (list != NULL) {
+			aio_list_put(list);
+		}
+	}
+}
+
+K_THREAD_DEFINE(posix_aio_tid, CONFIG_POSIX_AIO_STACK_SIZE, posix_aio_thread, NULL, NULL, NULL,
+		CONFIG_POSIX_AIO_THREAD_PRIORITY, 0, 0);
+
+static int aio_submit(struct aiocb *aiocbp, uint8_t op, struct posix_aio_list *list)
+{
+	struct posix_aio_req *req = NULL;
+	struct rtio_sqe *sqe;
+
+	if ((aiocbp == NULL) || !sigevent_is_valid(&aiocbp->aio_sigevent) ||
+	    ((uint64_t)aiocbp->aio_nbytes > UINT32_MAX)) {
+		return EINVAL;
+	}
+
+	(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(posix_aio_reqs); i++) {
+		if (posix_aio_reqs[i].aiocbp == NULL) {
+			req = &posix_aio_reqs[i];
+			break;
+		}
+	}
+
+	sqe = (req != NULL) ? rtio_sqe_acquire(&posix_aio_rtio) : NULL;
+	if (sqe == NULL) {
+		k_mutex_unlock(&posix_aio_lock);
+		return EAGAIN;
+	}
+
+	switch (op) {
+	case RTIO_OP_RX:
+		rtio_sqe_prep_read(sqe, &posix_aio_iodev, RTIO_PRIO_NORM,
+				   (uint8_t *)aiocbp->aio_buf, aiocbp->aio_nbytes, req);
+		break;
+	case RTIO_OP_TX:
+		rtio_sqe_prep_write(sqe, &posix_aio_iodev, RTIO_PRIO_NORM,
+				    (uint8_t *)aiocbp->aio_buf, aiocbp->aio_nbytes, req);
+		break;
+	default:
+		rtio_sqe_prep_nop(sqe, &posix_aio_iodev, req);
+		break;
+	}
+
+	/* Outcomes are reported through the aiocb rather than the completion queue */
+	sqe->flags |= RTIO_SQE_NO_RESPONSE;
+
+	req->aiocbp = aiocbp;
+	req->list = list;
+	req->sigevent = aiocbp->aio_sigevent;
+	req->fildes = aiocbp->aio_fildes;
+
+	aiocbp->_aio_error = EINPROGRESS;
+	aiocbp->_aio_return = 0;
+
+	if (list != NULL) {
+		atomic_inc(&list->pending);
+	}
+
+	(void)rtio_submit(&posix_aio_rtio, 0);
+
+	k_mutex_unlock(&posix_aio_lock);
+
+	return 0;
+}
+
+static int aio_submit_errno(struct aiocb *aiocbp, uint8_t op)
+{
+	int err = aio_submit(aiocbp, op, NULL);
+
+	if (err != 0) {
+		errno = err;
+		return -1;
+	}
+
+	return 0;
+}
 
 int aio_cancel(int fildes, struct aiocb *aiocbp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(aiocbp);
+	struct posix_aio_req *req;
+	int canceled = 0;
+	int notcanceled = 0;
+
+	(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(posix_aio_reqs); i++) {
+		req = &posix_aio_reqs[i];
+
+		if ((req->aiocbp == NULL) || req->canceled || (req->fildes != fildes) ||
+		    ((aiocbp != NULL) && (req->aiocbp != aiocbp))) {
+			continue;
+		}
+
+		if (req->running) {
+			notcanceled++;
+			continue;
+		}
+
+		/* The AIO thread completes it without touching the aiocb again */
+		req->canceled = true;
+		req->aiocbp->_aio_return = -1;
+		req->aiocbp->_aio_error = ECANCELED;
+		canceled++;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	if (canceled > 0) {
+		k_condvar_broadcast(&posix_aio_done);
+	}
+
+	k_mutex_unlock(&posix_aio_lock);
+
+	if (notcanceled > 0) {
+		return AIO_NOTCANCELED;
+	}
+
+	return (canceled > 0) ? AIO_CANCELED : AIO_ALLDONE;
 }
 
 int aio_error(const struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	int err;
 
-	errno = ENOSYS;
-	return -1;
+	if (aiocbp == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+	err = aiocbp->_aio_error;
+	k_mutex_unlock(&posix_aio_lock);
+
+	return err;
 }
 
-int aio_fsync(int fildes, struct aiocb *aiocbp)
+int aio_fsync(int op, struct aiocb *aiocbp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(aiocbp);
+	/* O_SYNC and O_DSYNC both come down to fsync() */
+	ARG_UNUSED(op);
 
-	errno = ENOSYS;
-	return -1;
+	return aio_submit_errno(aiocbp, RTIO_OP_NOP);
 }
 
 int aio_read(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
-
-	errno = ENOSYS;
-	return -1;
+	return aio_submit_errno(aiocbp, RTIO_OP_RX);
 }
 
 ssize_t aio_return(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	ssize_t ret;
 
-	errno = ENOSYS;
-	return -1;
+	if (aiocbp == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+
+	if (aiocbp->_aio_error == EINPROGRESS) {
+		k_mutex_unlock(&posix_aio_lock);
+		errno = EINVAL;
+		return -1;
+	}
+
+	ret = aiocbp->_aio_return;
+
+	k_mutex_unlock(&posix_aio_lock);
+
+	return ret;
 }
 
 int aio_suspend(const struct aiocb *const list[], int nent, const struct timespec *timeout)
 {
-	ARG_UNUSED(list);
-	ARG_UNUSED(nent);
-	ARG_UNUSED(timeout);
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+
+	if (timeout != NULL) {
+		if ((timeout->tv_sec < 0) || (timeout->tv_nsec < 0) ||
+		    (timeout->tv_nsec >= NSEC_PER_SEC)) {
+			errno = EINVAL;
+			return -1;
+		}
 
-	errno = ENOSYS;
-	return -1;
+		end = sys_timepoint_calc(K_NSEC((int64_t)timeout->tv_sec * NSEC_PER_SEC +
+						timeout->tv_nsec));
+	}
+
+	(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+
+	while (true) {
+		for (int i = 0; i < nent; i++) {
+			if ((list[i] != NULL) && (list[i]->_aio_error != EINPROGRESS)) {
+				k_mutex_unlock(&posix_aio_lock);
+				return 0;
+			}
+		}
+
+		if (k_condvar_wait(&posix_aio_done, &posix_aio_lock,
+				   sys_timepoint_timeout(end)) == -EAGAIN) {
+			k_mutex_unlock(&posix_aio_lock);
+			errno = EAGAIN;
+			return -1;
+		}
+	}
 }
 
 int aio_write(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
-
-	errno = ENOSYS;
-	return -1;
+	return aio_submit_errno(aiocbp, RTIO_OP_TX);
 }
 
 int lio_listio(int mode, struct aiocb *const ZRESTRICT list[], int nent,
 	       struct sigevent *ZRESTRICT sig)
 {
-	ARG_UNUSED(mode);
-	ARG_UNUSED(list);
-	ARG_UNUSED(nent);
-	ARG_UNUSED(sig);
+	struct posix_aio_list *lio = NULL;
+	bool failed = false;
+	bool again = false;
+	uint8_t op;
+	int err;
+
+	if (((mode != LIO_WAIT) && (mode != LIO_NOWAIT)) || (nent < 0) ||
+	    (nent > AIO_LISTIO_MAX)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((mode == LIO_NOWAIT) && (sig != NULL) && (sig->sigev_notify != SIGEV_NONE)) {
+		if (!sigevent_is_valid(sig)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		if (k_mem_slab_alloc(&posix_aio_list_slab, (void **)&lio, K_NO_WAIT) != 0) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		lio->sigevent = *sig;
+		atomic_set(&lio->pending, 1);
+	}
+
+	for (int i = 0; i < nent; i++) {
+		if ((list[i] == NULL) || (list[i]->aio_lio_opcode == LIO_NOP)) {
+			continue;
+		}
+
+		switch (list[i]->aio_lio_opcode) {
+		case LIO_READ:
+			op = RTIO_OP_RX;
+			break;
+		case LIO_WRITE:
+			op = RTIO_OP_TX;
+			break;
+		default:
+			op = RTIO_OP_NOP;
+			break;
+		}
+
+		err = (op == RTIO_OP_NOP) ? EINVAL : aio_submit(list[i], op, lio);
+		if (err != 0) {
+			list[i]->_aio_return = -1;
+			list[i]->_aio_error = err;
+			again = again || (err == EAGAIN);
+			failed = true;
+		}
+	}
+
+	/* Notifies right away if no request is in progress anymore */
+	if (lio != NULL) {
+		aio_list_put(lio);
+	}
+
+	if (mode == LIO_WAIT) {
+		(void)k_mutex_lock(&posix_aio_lock, K_FOREVER);
+
+		for (int i = 0; i < nent; i++) {
+			if ((list[i] == NULL) || (list[i]->aio_lio_opcode == LIO_NOP)) {
+				continue;
+			}
+
+			while (list[i]->_aio_error == EINPROGRESS) {
+				(void)k_condvar_wait(&posix_aio_done, &posix_aio_lock, K_FOREVER);
+			}
+
+			failed = failed || (list[i]->_aio_error != 0);
+		}
+
+		k_mutex_unlock(&posix_aio_lock);
+	}
+
+	if (failed) {
+		errno = again ? EAGAIN : EIO;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	return 0;
 }
@@ -15,6 +15,8 @@
 
 LOG_MODULE_REGISTER(pthread_cond, CONFIG_PTHREAD_COND_LOG_LEVEL);
 
+static struct k_spinlock pthread_cond_spinlock;
+
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
 static struct k_condvar posix_cond_pool[CONFIG_MAX_PTHREAD_COND_COUNT];
@@ -68,13 +70,23 @@ static struct k_condvar *to_posix_cond(pthread_cond_t *cvar)
 {
 	size_t bit;
 	struct k_condvar *cv;
+	k_spinlock_key_t key;
 
 	if (*cvar != PTHREAD_COND_INITIALIZER) {
 		return get_posix_cond(*cvar);
 	}
 
+	key = k_spin_lock(&pthread_cond_spinlock);
+
+	/* Another thread may have associated a posix_cond in the meantime */
+	if (*cvar != PTHREAD_COND_INITIALIZER) {
+		k_spin_unlock(&pthread_cond_spinlock, key);
+		return get_posix_cond(*cvar);
+	}
+
 	/* Try and automatically associate a posix_cond */
 	if (sys_bitarray_alloc(&posix_cond_bitarray, 1, &bit) < 0) {
+		k_spin_unlock(&pthread_cond_spinlock, key);
 		/* No conds left to allocate */
 		LOG_DBG("Unable to allocate pthread_cond_t");
 		return NULL;
@@ -84,6 +96,8 @@ static struct k_condvar *to_posix_cond(pthread_cond_t *cvar)
 	*cvar = mark_pthread_obj_initialized(bit);
 	cv = &posix_cond_pool[bit];
 
+	k_spin_unlock(&pthread_cond_spinlock, key);
+
 	return cv;
 }
 
@@ -81,26 +81,38 @@ struct k_mutex *to_posix_mutex(pthread_mutex_t *mu)
 	int err;
 	size_t bit;
 	struct k_mutex *m;
+	k_spinlock_key_t key;
 
 	if (*mu != PTHREAD_MUTEX_INITIALIZER) {
 		return get_posix_mutex(*mu);
 	}
 
+	key = k_spin_lock(&pthread_mutex_spinlock);
+
+	/* Another thread may have associated a posix_mutex in the meantime */
+	if (*mu != PTHREAD_MUTEX_INITIALIZER) {
+		k_spin_unlock(&pthread_mutex_spinlock, key);
+		return get_posix_mutex(*mu);
+	}
+
 	/* Try and automatically associate a posix_mutex */
 	if (sys_bitarray_alloc(&posix_mutex_bitarray, 1, &bit) < 0) {
+		k_spin_unlock(&pthread_mutex_spinlock, key);
 		LOG_DBG("Unable to allocate pthread_mutex_t");
 		return NULL;
 	}
 
-	/* Record the associated posix_mutex in mu and mark as initialized */
-	*mu = mark_pthread_obj_initialized(bit);
-
 	/* Initialize the posix_mutex */
 	m = &posix_mutex_pool[bit];
 
 	err = k_mutex_init(m);
 	__ASSERT_NO_MSG(err == 0);
 
+	/* Record the associated posix_mutex in mu and mark as initialized */
+	*mu = mark_pthread_obj_initialized(bit);
+
+	k_spin_unlock(&pthread_mutex_spinlock, key);
+
 	return m;
 }
 
@@ -110,13 +122,15 @@ static int acquire_mutex(pthread_mutex_t *mu, k_timeout_t timeout)
 	size_t bit;
 	int ret = 0;
 	struct k_mutex *m;
-	k_spinlock_key_t key;
-
-	key = k_spin_lock(&pthread_mutex_spinlock);
 
+	/*
+	 * Only associating a PTHREAD_MUTEX_INITIALIZER with a posix_mutex needs
+	 * the spinlock. Only this thread can make itself the owner, so can
+	 * check ownership without it. Locking an uncontended mutex then boils
+	 * down to the k_mutex_lock() fast path.
+	 */
 	m = to_posix_mutex(mu);
 	if (m == NULL) {
-		k_spin_unlock(&pthread_mutex_spinlock, key);
 		return EINVAL;
 	}
 
@@ -129,12 +143,10 @@ static int acquire_mutex(pthread_mutex_t *mu, k_timeout_t timeout)
 		switch (type) {
 		case PTHREAD_MUTEX_NORMAL:
 			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-				k_spin_unlock(&pthread_mutex_spinlock, key);
 				LOG_DBG("Timeout locking mutex %p", m);
 				return EBUSY;
 			}
 			/* On most POSIX systems, this usually results in an infinite loop */
-			k_spin_unlock(&pthread_mutex_spinlock, key);
 			LOG_DBG("Attempt to relock non-recursive mutex %p", m);
 			do {
 				(void)k_sleep(K_FOREVER);
@@ -157,7 +169,6 @@ static int acquire_mutex(pthread_mutex_t *mu, k_timeout_t timeout)
 			break;
 		}
 	}
-	k_spin_unlock(&pthread_mutex_spinlock, key);
 
 	if (ret == 0) {
 		ret = k_mutex_lock(m, timeout);
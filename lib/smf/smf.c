@@ -1,5 +1,6 @@
 /*
  * Copyright 2021 The Chromium OS Authors
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -22,17 +23,6 @@ struct internal_ctx {
 };
 
 #ifdef CONFIG_SMF_ANCESTOR_SUPPORT
-static bool share_paren(const struct smf_state *test_state, const struct smf_state *target_state)
-{
-	for (const struct smf_state *state = test_state; state != NULL; state = state->parent) {
-		if (target_state == state) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
 static const struct smf_state *get_child_of(const struct smf_state *states,
 					    const struct smf_state *parent)
 {
@@ -54,26 +44,103 @@ static const struct smf_state *get_last_of(const struct smf_state *states)
 	return get_child_of(states, NULL);
 }
 
+static unsigned int get_depth_of(const struct smf_state *state)
+{
+	unsigned int depth = 0;
+
+	for (; state->parent != NULL; state = state->parent) {
+		depth++;
+	}
+
+	return depth;
+}
+
 /**
- * @brief Find the Least Common Ancestor (LCA) of two states
+ * @brief Find the topmost state of a transition, which is neither exited nor entered
+ *
+ * This is the destination if it contains the source, the source if it
+ * contains the destination, or else their Least Common Ancestor (LCA).
+ * Both states are brought to the same depth, then walked up together, so
+ * the cost is linear in the depth of the hierarchy.
  *
  * @param source transition source
  * @param dest transition destination
- * @return LCA state, or NULL if states have no LCA.
+ * @return topmost state, or NULL if states have no LCA.
  */
-static const struct smf_state *get_lca_of(const struct smf_state *source,
-					  const struct smf_state *dest)
+static const struct smf_state *get_topmost_of(const struct smf_state *source,
+					      const struct smf_state *dest)
 {
-	for (const struct smf_state *ancestor = source->parent; ancestor != NULL;
-	     ancestor = ancestor->parent) {
-		if (ancestor == dest) {
-			return ancestor->parent;
-		} else if (share_paren(dest, ancestor)) {
-			return ancestor;
+	unsigned int source_depth = get_depth_of(source);
+	unsigned int dest_depth = get_depth_of(dest);
+	const struct smf_state *s = source;
+	const struct smf_state *d = dest;
+
+	for (; source_depth > dest_depth; source_depth--) {
+		s = s->parent;
+	}
+
+	if (s == dest) {
+		/* new state is a parent of where we are now */
+		return dest;
+	}
+
+	for (; dest_depth > source_depth; dest_depth--) {
+		d = d->parent;
+	}
+
+	if (d == source) {
+		/* we are a parent of the new state */
+		return source;
+	}
+
+	/* not directly related, find LCA */
+	while (s != d) {
+		s = s->parent;
+		d = d->parent;
+	}
+
+	return s;
+}
+
+/**
+ * @brief Executes the entry actions of the ancestors of a state, outermost first
+ *
+ * @param ctx State machine context
+ * @param state State whose ancestors are entered. Its own entry action is not executed
+ * @param topmost Ancestor of state we are entering from. Neither it nor its
+ *        ancestors are entered
+ * @return true if the state machine should terminate, else false
+ */
+static bool smf_execute_ancestor_entry_actions(struct smf_ctx *const ctx,
+					       const struct smf_state *state,
+					       const struct smf_state *topmost)
+{
+	struct internal_ctx *const internal = (void *)&ctx->internal;
+	const struct smf_state *parent = state->parent;
+
+	if (parent == topmost || parent == NULL) {
+		return false;
+	}
+
+	/* The recursion is bounded by the depth of the hierarchy */
+	if (smf_execute_ancestor_entry_actions(ctx, parent, topmost)) {
+		return true;
+	}
+
+	if (parent->entry) {
+		/* Keep track of the executing entry action in case it calls
+		 * smf_set_State()
+		 */
+		ctx->executing = parent;
+		parent->entry(ctx);
+
+		/* No need to continue if terminate was set */
+		if (internal->terminate) {
+			return true;
 		}
 	}
 
-	return NULL;
+	return false;
 }
 
 /**
@@ -95,22 +162,9 @@ static bool smf_execute_all_entry_actions(struct smf_ctx *const ctx,
 		return false;
 	}
 
-	for (const struct smf_state *to_execute = get_child_of(new_state, topmost);
-	     to_execute != NULL && to_execute != new_state;
-	     to_execute = get_child_of(new_state, to_execute)) {
-		/* Execute every entry action EXCEPT that of the topmost state */
-		if (to_execute->entry) {
-			/* Keep track of the executing entry action in case it calls
-			 * smf_set_State()
-			 */
-			ctx->executing = to_execute;
-			to_execute->entry(ctx);
-
-			/* No need to continue if terminate was set */
-			if (internal->terminate) {
-				return true;
-			}
-		}
+	/* Execute every entry action EXCEPT that of the topmost state */
+	if (smf_execute_ancestor_entry_actions(ctx, new_state, topmost)) {
+		return true;
 	}
 
 	/* and execute the new state entry action */
@@ -280,18 +334,7 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *new_state)
 	}
 
 #ifdef CONFIG_SMF_ANCESTOR_SUPPORT
-	const struct smf_state *topmost;
-
-	if (share_paren(ctx->executing, new_state)) {
-		/* new state is a parent of where we are now*/
-		topmost = new_state;
-	} else if (share_paren(new_state, ctx->executing)) {
-		/* we are a parent of the new state */
-		topmost = ctx->executing;
-	} else {
-		/* not directly related, find LCA */
-		topmost = get_lca_of(ctx->executing, new_state);
-	}
+	const struct smf_state *topmost = get_topmost_of(ctx->executing, new_state);
 
 	internal->is_exit = true;
 	internal->new_state = true;
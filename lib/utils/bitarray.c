@@ -157,6 +157,26 @@ mismatch:
 	return false;
 }
 
+/*
+ * Update the summary bits of bundles sidx to eidx after changing them.
+ */
+static void update_summary(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	for (size_t idx = sidx; idx <= eidx; idx++) {
+		if (~bitarray->bundles[idx] == 0U) {
+			bitarray->summary[idx / 32] |= BIT(idx % 32);
+		} else {
+			bitarray->summary[idx / 32] &= ~BIT(idx % 32);
+		}
+	}
+#else
+	ARG_UNUSED(bitarray);
+	ARG_UNUSED(sidx);
+	ARG_UNUSED(eidx);
+#endif
+}
+
 /*
  * Set or clear a region of bits.
  *
@@ -208,6 +228,93 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			}
 		}
 	}
+
+	update_summary(bitarray, bd->sidx, bd->eidx);
+}
+
+/*
+ * Find the first bundle at or after idx with at least one bit cleared.
+ *
+ * @return Index of the bundle, or the number of bundles if there is none.
+ */
+static size_t find_free_bundle(sys_bitarray_t *bitarray, size_t idx)
+{
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	size_t word = idx / 32;
+	size_t num_words = DIV_ROUND_UP(bitarray->num_bundles, 32);
+	uint32_t free;
+
+	if (idx >= bitarray->num_bundles) {
+		return bitarray->num_bundles;
+	}
+
+	/* The summary tells about 32 bundles at once. */
+	free = ~bitarray->summary[word] & ~(BIT(idx % 32) - 1);
+	while (free == 0U) {
+		if (++word >= num_words) {
+			return bitarray->num_bundles;
+		}
+		free = ~bitarray->summary[word];
+	}
+
+	return MIN(word * 32 + find_lsb_set(free) - 1, bitarray->num_bundles);
+#else
+	while ((idx < bitarray->num_bundles) && (~bitarray->bundles[idx] == 0U)) {
+		idx++;
+	}
+
+	return idx;
+#endif
+}
+
+/*
+ * Find the first cleared bit at or after offset.
+ *
+ * @return Offset of the bit, or the number of bits if there is none.
+ */
+static size_t find_clear_bit(sys_bitarray_t *bitarray, size_t offset)
+{
+	size_t idx = offset / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	bundle = ~bitarray->bundles[idx] &
+		 ~(BIT(offset % bundle_bitness(bitarray)) - 1);
+
+	while (bundle == 0U) {
+		idx = find_free_bundle(bitarray, idx + 1);
+		if (idx >= bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+
+		bundle = ~bitarray->bundles[idx];
+	}
+
+	return MIN(idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1,
+		   bitarray->num_bits);
+}
+
+/*
+ * Find the first set bit in the region [offset, end).
+ *
+ * @return Offset of the bit, or end if all bits are cleared.
+ */
+static size_t find_set_bit(sys_bitarray_t *bitarray, size_t offset, size_t end)
+{
+	size_t idx = offset / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	bundle = bitarray->bundles[idx] &
+		 ~(BIT(offset % bundle_bitness(bitarray)) - 1);
+
+	while (bundle == 0U) {
+		if (++idx * bundle_bitness(bitarray) >= end) {
+			return end;
+		}
+
+		bundle = bitarray->bundles[idx];
+	}
+
+	return MIN(idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1, end);
 }
 
 int sys_bitarray_popcount_region(sys_bitarray_t *bitarray, size_t num_bits, size_t offset,
@@ -308,6 +415,8 @@ int sys_bitarray_xor(sys_bitarray_t *dst, sys_bitarray_t *other, size_t num_bits
 		}
 	}
 
+	update_summary(dst, bd.sidx, bd.eidx);
+
 	ret = 0;
 
 out:
@@ -336,6 +445,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -364,6 +474,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -374,39 +485,30 @@ out:
 
 int sys_bitarray_test_bit(sys_bitarray_t *bitarray, size_t bit, int *val)
 {
-	k_spinlock_key_t key;
-	int ret;
 	size_t idx, off;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
 	__ASSERT_NO_MSG(bitarray->num_bits > 0);
 
-	key = k_spin_lock(&bitarray->lock);
-
 	CHECKIF(val == NULL) {
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
 
 	if (bit >= bitarray->num_bits) {
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
 
 	idx = bit / bundle_bitness(bitarray);
 	off = bit % bundle_bitness(bitarray);
 
-	if ((bitarray->bundles[idx] & BIT(off)) != 0) {
+	/* Reading a single bundle is atomic, no need for the lock. */
+	if ((*(volatile uint32_t *)&bitarray->bundles[idx] & BIT(off)) != 0) {
 		*val = 1;
 	} else {
 		*val = 0;
 	}
 
-	ret = 0;
-
-out:
-	k_spin_unlock(&bitarray->lock, key);
-	return ret;
+	return 0;
 }
 
 int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *prev_val)
@@ -440,6 +542,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -479,6 +582,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -491,10 +595,9 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
+	size_t bit_idx;
 	int ret;
-	struct bundle_data bd;
-	size_t off_start, off_end;
+	size_t off_end;
 	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
@@ -512,46 +615,22 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
-
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
-	 */
-	for (size_t idx = 0; idx < bitarray->num_bundles; idx++) {
-		if (~bitarray->bundles[idx] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
-
-		if (bitarray->bundles[idx] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[idx]) - 1;
-			bit_idx += off_start;
-		}
-
-		break;
-	}
-
+	/* Skip from one run of cleared bits to the next, a bundle at a time. */
 	off_end = bitarray->num_bits - num_bits;
 	ret = -ENOSPC;
+	bit_idx = find_clear_bit(bitarray, 0);
 	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
+		mismatch = find_set_bit(bitarray, bit_idx, bit_idx + num_bits);
+		if (mismatch == bit_idx + num_bits) {
+			set_region(bitarray, bit_idx, num_bits, true, NULL);
 
 			*offset = bit_idx;
 			ret = 0;
 			break;
 		}
 
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
-		 */
-		bit_idx = mismatch + 1;
+		/* Fast-forward past the allocated bits. */
+		bit_idx = find_clear_bit(bitarray, mismatch);
 	}
 
 out:
@@ -94,7 +94,15 @@ static void *lexer_string(struct json_lexer *lex)
 	ignore(lex);
 
 	while (true) {
-		int chr = next(lex);
+		int chr;
+
+		/* Skip the characters without special meaning in one go. */
+		while (lex->pos < lex->end && *lex->pos != '"' && *lex->pos != '\\' &&
+		       *lex->pos != '\0') {
+			lex->pos++;
+		}
+
+		chr = next(lex);
 
 		if (chr == '\0') {
 			emit(lex, JSON_TOK_ERROR);
@@ -666,7 +674,8 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
-	size_t i;
+	size_t next_field = 0;
+	size_t i, n;
 	int ret;
 
 	while (!obj_next(obj, &kv)) {
@@ -674,8 +683,18 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
+		/* Fields mostly come in descriptor order, so the search starts
+		 * after the last decoded field and wraps around.
+		 */
+		for (n = 0; n < descr_len; n++) {
+			void *decode_field;
+
+			i = next_field + n;
+			if (i >= descr_len) {
+				i -= descr_len;
+			}
+
+			decode_field = (char *)val + descr[i].offset;
 
 			/* Field has been decoded already, skip */
 			if (decoded_fields & ((int64_t)1 << i)) {
@@ -700,11 +719,12 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			}
 
 			decoded_fields |= (int64_t)1<<i;
+			next_field = i + 1;
 			break;
 		}
 
 		/* Skip field, if no descriptor was found */
-		if (i >= descr_len) {
+		if (n >= descr_len) {
 			ret = skip_field(obj, &kv);
 			if (ret < 0) {
 				return ret;
@@ -779,6 +799,170 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+enum json_arr_stream_state {
+	JSON_ARR_STREAM_START,
+	JSON_ARR_STREAM_FIRST,
+	JSON_ARR_STREAM_ELEMENT,
+	JSON_ARR_STREAM_OBJECT,
+	JSON_ARR_STREAM_NEXT,
+	JSON_ARR_STREAM_END,
+};
+
+void json_arr_stream_init(struct json_arr_stream *stream, char *buf, size_t buf_size,
+			  const struct json_obj_descr *descr, size_t descr_len,
+			  void *val, json_arr_stream_cb_t cb, void *user_data)
+{
+	*stream = (struct json_arr_stream) {
+		.buf = buf,
+		.buf_size = buf_size,
+		.descr = descr,
+		.descr_len = descr_len,
+		.val = val,
+		.cb = cb,
+		.user_data = user_data,
+		.state = JSON_ARR_STREAM_START,
+	};
+}
+
+static bool is_json_ws(char chr)
+{
+	return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r';
+}
+
+/* Collects the characters of an object until its closing brace, then
+ * decodes it with json_obj_parse().
+ */
+static int arr_stream_object(struct json_arr_stream *stream, char chr)
+{
+	int64_t ret;
+
+	if (stream->len >= stream->buf_size) {
+		return -ENOMEM;
+	}
+
+	stream->buf[stream->len++] = chr;
+
+	if (stream->in_string) {
+		if (stream->escaped) {
+			stream->escaped = false;
+		} else if (chr == '\\') {
+			stream->escaped = true;
+		} else if (chr == '"') {
+			stream->in_string = false;
+		}
+
+		return 0;
+	}
+
+	switch (chr) {
+	case '"':
+		stream->in_string = true;
+		return 0;
+	case '{':
+	case '[':
+		if (stream->depth == UINT16_MAX) {
+			return -EINVAL;
+		}
+
+		stream->depth++;
+		return 0;
+	case '}':
+	case ']':
+		if (--stream->depth > 0) {
+			return 0;
+		}
+
+		break;
+	default:
+		return 0;
+	}
+
+	ret = json_obj_parse(stream->buf, stream->len, stream->descr,
+			     stream->descr_len, stream->val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream->len = 0;
+	stream->state = JSON_ARR_STREAM_NEXT;
+
+	return stream->cb(stream->val, ret, stream->user_data);
+}
+
+int json_arr_stream_feed(struct json_arr_stream *stream, const char *data, size_t len)
+{
+	int ret;
+
+	for (; len > 0; data++, len--) {
+		char chr = *data;
+
+		if (stream->state == JSON_ARR_STREAM_OBJECT) {
+			ret = arr_stream_object(stream, chr);
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
+		}
+
+		if (is_json_ws(chr)) {
+			continue;
+		}
+
+		switch (stream->state) {
+		case JSON_ARR_STREAM_START:
+			if (chr != '[') {
+				return -EINVAL;
+			}
+
+			stream->state = JSON_ARR_STREAM_FIRST;
+			break;
+		case JSON_ARR_STREAM_FIRST:
+		case JSON_ARR_STREAM_ELEMENT:
+			if (chr == ']' && stream->state == JSON_ARR_STREAM_FIRST) {
+				stream->state = JSON_ARR_STREAM_END;
+				break;
+			}
+
+			if (chr != '{') {
+				return -EINVAL;
+			}
+
+			stream->state = JSON_ARR_STREAM_OBJECT;
+			stream->depth = 0;
+			stream->in_string = false;
+			stream->escaped = false;
+
+			ret = arr_stream_object(stream, chr);
+			if (ret < 0) {
+				return ret;
+			}
+
+			break;
+		case JSON_ARR_STREAM_NEXT:
+			if (chr == ',') {
+				stream->state = JSON_ARR_STREAM_ELEMENT;
+			} else if (chr == ']') {
+				stream->state = JSON_ARR_STREAM_END;
+			} else {
+				return -EINVAL;
+			}
+
+			break;
+		default:
+			/* Nothing but whitespace may follow the array. */
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+int json_arr_stream_finish(struct json_arr_stream *stream)
+{
+	return stream->state == JSON_ARR_STREAM_END ? 0 : -EINVAL;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
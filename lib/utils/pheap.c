@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Two-pass pairing heap, c.f. Fredman, Sedgewick, Sleator, Tarjan:
+ * "The pairing heap: A new form of self-adjusting heap", 1986.
+ */
+
+#include <zephyr/sys/pheap.h>
+
+/* Links two heaps and returns the new root.  Both must be roots,
+ * i.e. have no siblings.
+ */
+static struct pheap_node *meld(struct pheap *heap, struct pheap_node *a,
+			       struct pheap_node *b)
+{
+	struct pheap_node *tmp;
+
+	if (heap->lessthan_fn(b, a)) {
+		tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	b->prev = a;
+	b->next = a->child;
+	if (a->child != NULL) {
+		a->child->prev = b;
+	}
+	a->child = b;
+
+	return a;
+}
+
+/* Melds the siblings starting at @p first into one heap: pairwise
+ * from left to right first, then the pairs from right to left.  The
+ * pairs are stacked through their next pointers in between.
+ */
+static struct pheap_node *merge_pairs(struct pheap *heap, struct pheap_node *first)
+{
+	struct pheap_node *pairs = NULL, *root = NULL;
+	struct pheap_node *a, *b;
+
+	while (first != NULL) {
+		a = first;
+		b = a->next;
+		first = b != NULL ? b->next : NULL;
+
+		a->next = NULL;
+		a->prev = NULL;
+		if (b != NULL) {
+			b->next = NULL;
+			b->prev = NULL;
+			a = meld(heap, a, b);
+		}
+
+		a->next = pairs;
+		pairs = a;
+	}
+
+	while (pairs != NULL) {
+		a = pairs;
+		pairs = a->next;
+		a->next = NULL;
+
+		root = root != NULL ? meld(heap, root, a) : a;
+	}
+
+	return root;
+}
+
+void pheap_insert(struct pheap *heap, struct pheap_node *node)
+{
+	node->child = NULL;
+	node->next = NULL;
+	node->prev = NULL;
+
+	heap->root = heap->root != NULL ? meld(heap, heap->root, node) : node;
+}
+
+void pheap_remove(struct pheap *heap, struct pheap_node *node)
+{
+	struct pheap_node *sub = merge_pairs(heap, node->child);
+
+	if (node == heap->root) {
+		heap->root = sub;
+		return;
+	}
+
+	if (node->prev->child == node) {
+		node->prev->child = node->next;
+	} else {
+		node->prev->next = node->next;
+	}
+
+	if (node->next != NULL) {
+		node->next->prev = node->prev;
+	}
+
+	if (sub != NULL) {
+		heap->root = meld(heap, heap->root, sub);
+	}
+}
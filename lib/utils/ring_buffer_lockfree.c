@@ -0,0 +1,308 @@
+/* ring_buffer_lockfree.c: Lock-free ring buffer API */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/ring_buffer_lockfree.h>
+#include <string.h>
+
+/*
+ * Indexes run freely and are reduced modulo the buffer size, a power of two,
+ * when accessing the buffer. Each index is written by one side only, which
+ * publishes it with atomic_set() once the data it covers has been written
+ * (producer) or is no longer used (consumer).
+ */
+
+uint32_t ring_buf_spsc_put_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t head = buf->put.head;
+	uint32_t offset = head & buf->mask;
+	uint32_t free_space;
+
+	free_space = ring_buf_spsc_capacity_get(buf) - (head - (uint32_t)atomic_get(&buf->get.tail));
+	size = MIN(size, free_space);
+	size = MIN(size, ring_buf_spsc_capacity_get(buf) - offset);
+
+	*data = &buf->buffer[offset];
+	buf->put.head = head + size;
+
+	return size;
+}
+
+int ring_buf_spsc_put_finish(struct ring_buf_spsc *buf, uint32_t size)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->put.tail);
+
+	if (unlikely(size > buf->put.head - tail)) {
+		return -EINVAL;
+	}
+
+	tail += size;
+	buf->put.head = tail;
+	atomic_set(&buf->put.tail, (atomic_val_t)tail);
+
+	return 0;
+}
+
+uint32_t ring_buf_spsc_put(struct ring_buf_spsc *buf, const uint8_t *data, uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_spsc_put_claim(buf, &dst, size);
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	err = ring_buf_spsc_put_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return total_size;
+}
+
+uint32_t ring_buf_spsc_get_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t head = buf->get.head;
+	uint32_t offset = head & buf->mask;
+	uint32_t available_size;
+
+	available_size = (uint32_t)atomic_get(&buf->put.tail) - head;
+	size = MIN(size, available_size);
+	size = MIN(size, ring_buf_spsc_capacity_get(buf) - offset);
+
+	*data = &buf->buffer[offset];
+	buf->get.head = head + size;
+
+	return size;
+}
+
+int ring_buf_spsc_get_finish(struct ring_buf_spsc *buf, uint32_t size)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->get.tail);
+
+	if (unlikely(size > buf->get.head - tail)) {
+		return -EINVAL;
+	}
+
+	tail += size;
+	buf->get.head = tail;
+	atomic_set(&buf->get.tail, (atomic_val_t)tail);
+
+	return 0;
+}
+
+uint32_t ring_buf_spsc_get(struct ring_buf_spsc *buf, uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_spsc_get_claim(buf, &src, size);
+		if (data) {
+			memcpy(data, src, partial_size);
+			data += partial_size;
+		}
+		total_size += partial_size;
+		size -= partial_size;
+	} while (size && partial_size);
+
+	err = ring_buf_spsc_get_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return total_size;
+}
+
+/*
+ * Each MPSC record starts with a header word holding its size. Producers
+ * reserve records by moving the head with atomic_cas() and set the COMMITTED
+ * flag of the header once the record is written. A record that would wrap
+ * is preceded by a PAD record filling the rest of the buffer.
+ *
+ * The consumer clears every byte it frees, so that the header of a record
+ * reserved but not yet committed always reads as not committed.
+ */
+#define MPSC_HDR_COMMITTED BIT(30)
+#define MPSC_HDR_PAD	   BIT(29)
+#define MPSC_HDR_SIZE_MASK (MPSC_HDR_PAD - 1)
+
+static inline atomic_t *mpsc_hdr(struct ring_buf_mpsc *buf, uint32_t idx)
+{
+	return (atomic_t *)&buf->buffer[idx & buf->mask];
+}
+
+void ring_buf_mpsc_init(struct ring_buf_mpsc *buf, uint32_t size, void *data)
+{
+	__ASSERT(IS_POWER_OF_TWO(size) && size >= sizeof(atomic_t) &&
+		 size <= RING_BUFFER_MPSC_MAX_SIZE,
+		 RING_BUFFER_LOCKFREE_SIZE_ASSERT_MSG);
+	__ASSERT_NO_MSG(IS_PTR_ALIGNED(data, atomic_t));
+
+	memset(data, 0, size);
+
+	buf->buffer = data;
+	buf->mask = size - 1;
+	buf->get.claimed = 0;
+	atomic_set(&buf->get.tail, 0);
+	atomic_set(&buf->head, 0);
+}
+
+int ring_buf_mpsc_put_claim(struct ring_buf_mpsc *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t capacity = buf->mask + 1;
+	uint32_t record_size = RING_BUF_MPSC_RECORD_SIZE(size);
+	uint32_t head, offset, pad;
+
+	if (unlikely(size > capacity || record_size > capacity)) {
+		return -EMSGSIZE;
+	}
+
+	do {
+		head = (uint32_t)atomic_get(&buf->head);
+		offset = head & buf->mask;
+		pad = offset + record_size > capacity ? capacity - offset : 0;
+
+		if (head + pad + record_size - (uint32_t)atomic_get(&buf->get.tail) > capacity) {
+			return -ENOMEM;
+		}
+	} while (!atomic_cas(&buf->head, (atomic_val_t)head,
+			     (atomic_val_t)(head + pad + record_size)));
+
+	if (pad) {
+		atomic_set(mpsc_hdr(buf, head), MPSC_HDR_COMMITTED | MPSC_HDR_PAD | pad);
+		head += pad;
+	}
+
+	/* Not committed yet, remember the claimed size for finishing. */
+	atomic_set(mpsc_hdr(buf, head), size);
+	*data = (uint8_t *)(mpsc_hdr(buf, head) + 1);
+
+	return 0;
+}
+
+void ring_buf_mpsc_put_finish(struct ring_buf_mpsc *buf, uint8_t *data, uint32_t size)
+{
+	atomic_t *hdr = (atomic_t *)data - 1;
+	uint32_t claimed = RING_BUF_MPSC_RECORD_SIZE(atomic_get(hdr));
+	uint32_t used = RING_BUF_MPSC_RECORD_SIZE(size);
+
+	__ASSERT_NO_MSG((atomic_get(hdr) & MPSC_HDR_COMMITTED) == 0);
+	__ASSERT(used <= claimed, "Record size exceeds the claimed size");
+
+	if (size == 0) {
+		/* Drop the record altogether. */
+		atomic_set(hdr, MPSC_HDR_COMMITTED | MPSC_HDR_PAD | claimed);
+		return;
+	}
+
+	if (used < claimed) {
+		/* Give back what was not used as a PAD record. */
+		atomic_set((atomic_t *)((uint8_t *)hdr + used),
+			   MPSC_HDR_COMMITTED | MPSC_HDR_PAD | (claimed - used));
+	}
+
+	atomic_set(hdr, MPSC_HDR_COMMITTED | size);
+}
+
+int ring_buf_mpsc_put(struct ring_buf_mpsc *buf, const uint8_t *data, uint32_t size)
+{
+	uint8_t *dst;
+	int err;
+
+	err = ring_buf_mpsc_put_claim(buf, &dst, size);
+	if (err) {
+		return err;
+	}
+
+	memcpy(dst, data, size);
+	ring_buf_mpsc_put_finish(buf, dst, size);
+
+	return 0;
+}
+
+/* Frees @p size bytes at the tail, see the comment on the MPSC records. */
+static void mpsc_free(struct ring_buf_mpsc *buf, uint32_t tail, uint32_t size)
+{
+	memset(mpsc_hdr(buf, tail), 0, size);
+	atomic_set(&buf->get.tail, (atomic_val_t)(tail + size));
+}
+
+uint32_t ring_buf_mpsc_get_claim(struct ring_buf_mpsc *buf, uint8_t **data)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->get.tail);
+	atomic_val_t hdr;
+
+	while (tail != (uint32_t)atomic_get(&buf->head)) {
+		hdr = atomic_get(mpsc_hdr(buf, tail));
+
+		if ((hdr & MPSC_HDR_COMMITTED) == 0) {
+			break;
+		}
+
+		if (hdr & MPSC_HDR_PAD) {
+			mpsc_free(buf, tail, hdr & MPSC_HDR_SIZE_MASK);
+			tail += hdr & MPSC_HDR_SIZE_MASK;
+			continue;
+		}
+
+		buf->get.claimed = hdr & MPSC_HDR_SIZE_MASK;
+		*data = (uint8_t *)(mpsc_hdr(buf, tail) + 1);
+
+		return buf->get.claimed;
+	}
+
+	buf->get.claimed = 0;
+
+	return 0;
+}
+
+int ring_buf_mpsc_get_finish(struct ring_buf_mpsc *buf)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->get.tail);
+
+	if (unlikely(buf->get.claimed == 0)) {
+		return -EINVAL;
+	}
+
+	mpsc_free(buf, tail, RING_BUF_MPSC_RECORD_SIZE(buf->get.claimed));
+	buf->get.claimed = 0;
+
+	return 0;
+}
+
+int ring_buf_mpsc_get(struct ring_buf_mpsc *buf, uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t record_size;
+	int err;
+
+	record_size = ring_buf_mpsc_get_claim(buf, &src);
+	if (record_size == 0) {
+		return -EAGAIN;
+	}
+
+	if (data) {
+		if (record_size > size) {
+			return -EMSGSIZE;
+		}
+
+		memcpy(data, src, record_size);
+	}
+
+	err = ring_buf_mpsc_get_finish(buf);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return record_size;
+}
@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_OPENTHREAD_L2_LOG_LEVEL);
 #include <zephyr/net/ieee802154_radio.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_time.h>
+#include <zephyr/net/openthread.h>
 #include <zephyr/sys/__assert.h>
 
 #include <openthread/ip6.h>
@@ -541,8 +542,40 @@ exit:
 	net_pkt_unref(pkt);
 }
 
+#if defined(CONFIG_OPENTHREAD_RADIO_RX_DIRECT)
+/* Frames are only handed over directly if this does not overtake queued
+ * frames and does not re-enter OpenThread from one of its own calls.
+ * Queued frames are only consumed with the API lock held, so checking the
+ * queue under the lock is enough to keep the frames in order.
+ */
+static bool handle_received_frame_direct(struct net_pkt *pkt)
+{
+	struct openthread_context *ot_context = openthread_get_default_context();
+	bool handled = false;
+
+	if (k_is_in_isr() || !ot_context || openthread_api_mutex_try_lock(ot_context)) {
+		return false;
+	}
+
+	if (ot_context->api_lock.lock_count == 1U && k_fifo_is_empty(&rx_pkt_fifo)) {
+		openthread_handle_received_frame(ot_context->instance, pkt);
+		handled = true;
+	}
+
+	openthread_api_mutex_unlock(ot_context);
+
+	return handled;
+}
+#endif /* CONFIG_OPENTHREAD_RADIO_RX_DIRECT */
+
 int notify_new_rx_frame(struct net_pkt *pkt)
 {
+#if defined(CONFIG_OPENTHREAD_RADIO_RX_DIRECT)
+	if (handle_received_frame_direct(pkt)) {
+		return 0;
+	}
+#endif
+
 	k_fifo_put(&rx_pkt_fifo, pkt);
 	set_pending_event(PENDING_EVENT_FRAME_RECEIVED);
 
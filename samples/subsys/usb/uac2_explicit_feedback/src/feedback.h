@@ -16,7 +16,7 @@
 
 struct feedback_ctx *feedback_init(void);
 void feedback_reset_ctx(struct feedback_ctx *ctx);
-void feedback_process(struct feedback_ctx *ctx);
+void feedback_process(struct feedback_ctx *ctx, int i2s_blocks_used);
 void feedback_start(struct feedback_ctx *ctx, int i2s_blocks_queued);
 uint32_t feedback_value(struct feedback_ctx *ctx);
 
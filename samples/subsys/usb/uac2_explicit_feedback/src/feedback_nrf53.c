@@ -316,12 +316,15 @@ static int32_t pi_update(struct feedback_ctx *ctx)
 	return (error + (ctx->integrator / 2048)) / 128;
 }
 
-void feedback_process(struct feedback_ctx *ctx)
+void feedback_process(struct feedback_ctx *ctx, int i2s_blocks_used)
 {
 	uint32_t sof_cc;
 	uint32_t framestart_cc;
 	uint32_t fb;
 
+	/* Timing is captured by hardware, buffer level is not needed */
+	ARG_UNUSED(i2s_blocks_used);
+
 	sof_cc = nrfx_timer_capture_get(&feedback_timer_instance,
 		FEEDBACK_TIMER_USBD_SOF_CAPTURE);
 	framestart_cc = nrfx_timer_capture_get(&feedback_timer_instance,
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include "feedback.h"
+
+/* Target independent feedback, estimated from the number of I2S buffers in
+ * use at every SOF. If the host sends more samples than I2S consumes, buffers
+ * pile up and the feedback has to be lowered; if I2S consumes faster, buffers
+ * drain and the feedback has to be raised. Unlike I2S LRCLK edge counting,
+ * the level only moves in whole blocks, so it is averaged over a number of
+ * SOFs and fed to a slow PI controller.
+ */
+
+#define FEEDBACK_K		14
+
+/* Fill level is averaged and regulated in 1/256 block units */
+#define LEVEL_SHIFT		8
+/* Exponential moving average over about 32 SOFs */
+#define AVERAGE_SHIFT		5
+/* Proportional gain: 1/4 sample per block per SOF in Q10.14 units */
+#define KP_SHIFT		2
+/* Integral gain */
+#define KI_SHIFT		10
+
+/* Keep the level half a block below the one seen when I2S is started */
+#define SETPOINT_SLACK		BIT(LEVEL_SHIFT - 1)
+
+struct feedback_ctx {
+	uint32_t fb_value;
+	int32_t average;
+	int32_t setpoint;
+	int32_t integrator;
+	bool started;
+};
+
+static struct feedback_ctx fb_ctx;
+
+struct feedback_ctx *feedback_init(void)
+{
+	feedback_reset_ctx(&fb_ctx);
+
+	return &fb_ctx;
+}
+
+void feedback_process(struct feedback_ctx *ctx, int i2s_blocks_used)
+{
+	int32_t level = i2s_blocks_used << LEVEL_SHIFT;
+	int32_t error;
+
+	if (!ctx->started) {
+		ctx->average = level;
+		ctx->setpoint = level - SETPOINT_SLACK;
+		ctx->started = true;
+	}
+
+	ctx->average += (level - ctx->average) >> AVERAGE_SHIFT;
+
+	/* Positive error means buffers are draining, ask for more samples */
+	error = ctx->setpoint - ctx->average;
+	ctx->integrator += error;
+
+	ctx->fb_value = (SAMPLES_PER_SOF << FEEDBACK_K) +
+			(error << KP_SHIFT) + (ctx->integrator >> KI_SHIFT);
+}
+
+void feedback_reset_ctx(struct feedback_ctx *ctx)
+{
+	/* Reset feedback to nominal value */
+	ctx->fb_value = SAMPLES_PER_SOF << FEEDBACK_K;
+	ctx->integrator = 0;
+	ctx->started = false;
+}
+
+void feedback_start(struct feedback_ctx *ctx, int i2s_blocks_queued)
+{
+	ARG_UNUSED(i2s_blocks_queued);
+
+	/* The setpoint is taken at the first SOF after I2S is started */
+	ctx->started = false;
+}
+
+uint32_t feedback_value(struct feedback_ctx *ctx)
+{
+	return ctx->fb_value;
+}
@@ -209,7 +209,8 @@ static void uac2_sof(const struct device *dev, void *user_data)
 	struct usb_i2s_ctx *ctx = user_data;
 
 	if (ctx->i2s_started) {
-		feedback_process(ctx->fb);
+		feedback_process(ctx->fb,
+				 k_mem_slab_num_used_get(&i2s_tx_slab));
 	}
 
 	/* We want to maintain 3 SOFs delay, i.e. samples received during SOF n
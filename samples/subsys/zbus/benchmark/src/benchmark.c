@@ -25,6 +25,16 @@ LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
 #define CONSUMER_STACK_SIZE (CONFIG_IDLE_STACK_SIZE + CONFIG_BM_MESSAGE_SIZE)
 #define PRODUCER_STACK_SIZE (CONFIG_MAIN_STACK_SIZE + CONFIG_BM_MESSAGE_SIZE)
 
+#if defined(CONFIG_BM_SEQLOCK)
+ZBUS_SEQLOCK_CHAN_DEFINE(bm_channel,    /* Name */
+			 struct bm_msg, /* Message type */
+
+			 NULL,                 /* Validator */
+			 NULL,                 /* User data */
+			 ZBUS_OBSERVERS_EMPTY, /* observers */
+			 ZBUS_MSG_INIT(0)      /* Initial value {0} */
+);
+#else
 ZBUS_CHAN_DEFINE(bm_channel,    /* Name */
 		 struct bm_msg, /* Message type */
 
@@ -33,6 +43,7 @@ ZBUS_CHAN_DEFINE(bm_channel,    /* Name */
 		 ZBUS_OBSERVERS_EMPTY, /* observers */
 		 ZBUS_MSG_INIT(0)      /* Initial value {0} */
 );
+#endif /* CONFIG_BM_SEQLOCK */
 
 #define BYTES_TO_BE_SENT (256LLU * 1024LLU)
 atomic_t count;
@@ -45,6 +56,7 @@ static void producer_thread(void)
 			? "LISTENERS"
 			: (IS_ENABLED(CONFIG_BM_SUBSCRIBERS) ? "SUBSCRIBERS" : "MSG_SUBSCRIBERS"),
 		CONFIG_BM_MESSAGE_SIZE);
+	LOG_INF("Channel mode: %s", IS_ENABLED(CONFIG_BM_SEQLOCK) ? "SEQLOCK" : "MUTEX");
 
 	struct bm_msg msg = {{0}};
 
@@ -39,6 +39,17 @@ static int sub_thread(void *sub_ref, void *ptr2, void *ptr3)
 
 	while (1) {
 		if (zbus_sub_wait(sub, &chan, K_FOREVER) == 0) {
+			if (IS_ENABLED(CONFIG_BM_SEQLOCK)) {
+				struct bm_msg message;
+
+				/* Lock-free read, does not hold back the producer */
+				zbus_chan_read(chan, &message, K_NO_WAIT);
+
+				atomic_add(&count, *((uint16_t *)message.bytes));
+
+				continue;
+			}
+
 			if (zbus_chan_claim(chan, K_FOREVER) != 0) {
 				k_oops();
 			}
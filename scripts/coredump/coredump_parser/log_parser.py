@@ -20,6 +20,7 @@ LOG_ARCH_HDR_SIZE = struct.calcsize(LOG_ARCH_HDR_STRUCT)
 
 COREDUMP_MEM_HDR_ID = b'M'
 COREDUMP_MEM_HDR_VER = 1
+COREDUMP_MEM_HDR_VER_RLE = 2
 LOG_MEM_HDR_STRUCT = "<cH"
 LOG_MEM_HDR_SIZE = struct.calcsize(LOG_MEM_HDR_STRUCT)
 
@@ -85,7 +86,7 @@ class CoredumpLogFile:
         hdr = self.fd.read(LOG_MEM_HDR_SIZE)
         _, hdr_ver = struct.unpack(LOG_MEM_HDR_STRUCT, hdr)
 
-        if hdr_ver != COREDUMP_MEM_HDR_VER:
+        if hdr_ver not in (COREDUMP_MEM_HDR_VER, COREDUMP_MEM_HDR_VER_RLE):
             logger.error(f"Memory block version: {hdr_ver}, expected {COREDUMP_MEM_HDR_VER}!")
             return False
 
@@ -103,7 +104,17 @@ class CoredumpLogFile:
 
         size = eaddr - saddr
 
-        data = self.fd.read(size)
+        if hdr_ver == COREDUMP_MEM_HDR_VER_RLE:
+            data = self.read_rle(size)
+        else:
+            data = self.fd.read(size)
+
+        if len(data) < size:
+            # The backend ran out of space in this block
+            logger.warning("Memory: 0x%x to 0x%x truncated to %d bytes" %
+                           (saddr, eaddr, len(data)))
+            size = len(data)
+            eaddr = saddr + size
 
         mem = {"start": saddr, "end": eaddr, "data": data}
         self.memory_regions.append(mem)
@@ -113,6 +124,26 @@ class CoredumpLogFile:
 
         return True
 
+    def read_rle(self, size):
+        # Keep sync with rle_output() in coredump_core.c
+        data = bytearray()
+
+        while len(data) < size:
+            ctrl = self.fd.read(1)
+            if not ctrl:
+                break
+
+            ctrl = ctrl[0]
+            if ctrl < 0x80:
+                data += self.fd.read(ctrl + 1)
+            else:
+                value = self.fd.read(1)
+                if not value:
+                    break
+                data += value * (ctrl - 0x80 + 3)
+
+        return bytes(data[:size])
+
     def parse(self):
         if self.fd is None:
             self.open()
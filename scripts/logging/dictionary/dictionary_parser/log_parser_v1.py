@@ -14,6 +14,7 @@ version 1 databases.
 import logging
 import math
 import struct
+import sys
 import colorama
 from colorama import Fore
 
@@ -50,6 +51,7 @@ FMT_MSG_HDR_64 = "IQ"
 # Message type
 # 0: normal message
 # 1: number of dropped messages
+# 2: normal message in compact encoding
 FMT_MSG_TYPE = "B"
 
 # Depends on CONFIG_LOG_TIMESTAMP_64BIT
@@ -59,6 +61,7 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_NORMAL_COMPACT = 2
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
@@ -67,6 +70,29 @@ FMT_DROPPED_CNT = "H"
 logger = logging.getLogger("parser")
 
 
+class IncompleteMessage(Exception):
+    """Raised when the log data ends within a message"""
+
+
+def decode_varint(logdata, offset):
+    """Decode one unsigned LEB128 value, return it with the next offset"""
+    value = 0
+    shift = 0
+
+    while True:
+        if offset >= len(logdata):
+            raise IncompleteMessage()
+
+        byte = logdata[offset]
+        offset += 1
+
+        value |= (byte & 0x7f) << shift
+        if byte & 0x80 == 0:
+            return value, offset
+
+        shift += 7
+
+
 def get_log_level_str_color(lvl):
     """Convert numeric log level to string"""
     if lvl < 0 or lvl >= len(LOG_LEVELS):
@@ -190,6 +216,8 @@ class LogParserV1(LogParser):
         else:
             self.fmt_msg_timestamp = endian + FMT_MSG_TIMESTAMP_32
 
+        self.fmt_pkg_word = endian + "I"
+
         self.data_types = DataTypes(self.database)
 
 
@@ -445,32 +473,139 @@ class LogParserV1(LogParser):
         return next_msg_offset
 
 
-    def parse_log_data(self, logdata, debug=False):
-        """Parse binary log data and print the encoded log messages"""
+    def expand_compact_msg(self, logdata, offset):
+        """Expand a message in compact encoding to the layout of a normal
+        message, return it with the offset of the next message"""
+        if offset >= len(logdata):
+            raise IncompleteMessage()
+
+        domain_id = logdata[offset] & 0x07
+        level = (logdata[offset] >> 3) & 0x07
+        offset += 1
+
+        source_id, offset = decode_varint(logdata, offset)
+        timestamp, offset = decode_varint(logdata, offset)
+        pkg_len, offset = decode_varint(logdata, offset)
+        data_len, offset = decode_varint(logdata, offset)
+
+        # Package words up to the end of the arguments are varints,
+        # the first byte of the package is their number.
+        pkg = b''
+        if pkg_len > 0:
+            word, offset = decode_varint(logdata, offset)
+            pkg = struct.pack(self.fmt_pkg_word, word)
+
+            for _ in range(pkg[0] - 1):
+                word, offset = decode_varint(logdata, offset)
+                pkg += struct.pack(self.fmt_pkg_word, word)
+
+        pkg = pkg[:pkg_len]
+        raw_len = pkg_len - len(pkg) + data_len
+        if offset + raw_len > len(logdata):
+            raise IncompleteMessage()
+
+        log_desc = domain_id | (level << 3) | (pkg_len << 6) | (data_len << 16)
+
+        msg = struct.pack(self.fmt_msg_hdr, log_desc, source_id)
+        msg += struct.pack(self.fmt_msg_timestamp, timestamp)
+        msg += pkg + logdata[offset:(offset + raw_len)]
+
+        return msg, offset + raw_len
+
+
+    def normal_msg_complete(self, logdata, offset):
+        """Check that a normal message is fully available in logdata"""
+        hdr_len = struct.calcsize(self.fmt_msg_hdr) + struct.calcsize(self.fmt_msg_timestamp)
+        if offset + hdr_len > len(logdata):
+            return False
+
+        log_desc = struct.unpack_from(self.fmt_msg_hdr, logdata, offset)[0]
+        pkg_len = (log_desc >> 6) & int(math.pow(2, 10) - 1)
+        data_len = (log_desc >> 16) & int(math.pow(2, 12) - 1)
+
+        return offset + hdr_len + pkg_len + data_len <= len(logdata)
+
+
+    def parse_msgs(self, logdata, partial=False):
+        """Parse and print the messages in logdata. With partial, stop
+        before a message which is not fully available. Return the offset
+        where parsing stopped, or None on error."""
         offset = 0
 
         while offset < len(logdata):
+            msg_offset = offset
+
             # Get message type
             msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
             offset += struct.calcsize(self.fmt_msg_type)
 
             if msg_type == MSG_TYPE_DROPPED:
+                if partial and offset + struct.calcsize(self.fmt_dropped_cnt) > len(logdata):
+                    return msg_offset
+
                 num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)
                 offset += struct.calcsize(self.fmt_dropped_cnt)
 
                 print(f"--- {num_dropped} messages dropped ---")
 
             elif msg_type == MSG_TYPE_NORMAL:
+                if partial and not self.normal_msg_complete(logdata, offset):
+                    return msg_offset
+
                 ret = self.parse_one_normal_msg(logdata, offset)
                 if ret is None:
-                    return False
+                    return None
 
                 offset = ret
 
+            elif msg_type == MSG_TYPE_NORMAL_COMPACT:
+                try:
+                    msg, offset = self.expand_compact_msg(logdata, offset)
+                except IncompleteMessage:
+                    if partial:
+                        return msg_offset
+
+                    logger.error("------ Truncated message")
+                    return None
+
+                if self.parse_one_normal_msg(msg, 0) is None:
+                    return None
+
             else:
                 logger.error("------ Unknown message type: %s", msg_type)
+                return None
+
+        return offset
+
+
+    def parse_log_data(self, logdata, debug=False):
+        """Parse binary log data and print the encoded log messages"""
+        return self.parse_msgs(logdata) is not None
+
+
+    def parse_log_stream(self, stream, debug=False):
+        """Parse binary log data read from a stream as it arrives and print
+        the encoded log messages"""
+        pending = b''
+
+        while True:
+            data = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+            if not data:
+                break
+
+            pending += data
+
+            offset = self.parse_msgs(pending, partial=True)
+            if offset is None:
                 return False
 
+            pending = pending[offset:]
+            sys.stdout.flush()
+
+        if pending:
+            logger.error("------ Log data ends within a message")
+            return False
+
         return True
 
 colorama.init()
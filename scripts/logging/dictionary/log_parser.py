@@ -31,11 +31,14 @@ def parse_args():
     argparser = argparse.ArgumentParser(allow_abbrev=False)
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", help="Log Data file, - for standard input")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--stream", action="store_true",
+                           help="Decode binary log data as it arrives, "
+                                "for example from a serial port or a pipe")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
@@ -118,11 +121,17 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
-    logdata = read_log_file(args)
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
+    if args.stream and args.hex:
+        logger.error("ERROR: --stream only supports binary log data, exiting...")
         sys.exit(1)
 
+    logdata = None
+    if not args.stream:
+        logdata = read_log_file(args)
+        if logdata is None:
+            logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
+            sys.exit(1)
+
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
         logger.debug("# Build ID: %s", database.get_build_id())
@@ -132,7 +141,14 @@ def main():
         else:
             logger.debug("# Endianness: Big")
 
-        ret = log_parser.parse_log_data(logdata, debug=args.debug)
+        if args.stream:
+            if args.logfile == "-":
+                ret = log_parser.parse_log_stream(sys.stdin.buffer, debug=args.debug)
+            else:
+                with open(args.logfile, "rb", buffering=0) as logfile:
+                    ret = log_parser.parse_log_stream(logfile, debug=args.debug)
+        else:
+            ret = log_parser.parse_log_data(logdata, debug=args.debug)
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2016-2018 Nordic Semiconductor ASA
  * Copyright (c) 2016 Vinayak Kariappa Chettimada
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -27,6 +28,7 @@
 #include "util/memq.h"
 #include "util/mem.h"
 #include "util/dbuf.h"
+#include "util/mayfly.h"
 
 #include "hal/ecb.h"
 #include "hal/ccm.h"
@@ -137,6 +139,16 @@ static struct dup_entry {
 	/* Mask to accumulate advertising PDU type as bitmask */
 	uint8_t      mask;
 
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+	/* Next entry in the same hash bucket */
+	uint16_t     hash_next;
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0 */
+
+#if CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0
+	/* Uptime in milliseconds when the entry was (re)started */
+	uint32_t     time;
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0 */
+
 #if defined(CONFIG_BT_CTLR_ADV_EXT)
 	struct dup_ext_adv_mode {
 		uint16_t set_count:5;
@@ -157,6 +169,25 @@ static int32_t dup_count;
 /* Duplicate filtering current free entry, overwrites entries after rollover */
 static uint32_t dup_curr;
 
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+/* End of a hash bucket chain */
+#define DUP_HASH_NULL UINT16_MAX
+
+/* First entry of each hash bucket, chained through dup_entry::hash_next */
+static uint16_t dup_hash[CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE];
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0 */
+
+/* Reset all entries of the duplicate filter */
+static void dup_filter_reset(void)
+{
+	dup_count = 0;
+	dup_curr = 0U;
+
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+	(void)memset(dup_hash, 0xFF, sizeof(dup_hash));
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0 */
+}
+
 #if defined(CONFIG_BT_CTLR_SYNC_PERIODIC_ADI_SUPPORT)
 /* Helper function to reset non-periodic advertising entries in filter table */
 static void dup_ext_adv_reset(void);
@@ -170,6 +201,11 @@ static const bool dup_scan = true;
 #endif /* !CONFIG_BT_CTLR_SYNC_PERIODIC_ADI_SUPPORT */
 #endif /* CONFIG_BT_CTLR_DUP_FILTER_LEN > 0 */
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+/* Advertising report filter set by the Host, no filtering if zero */
+static struct bt_hci_cp_vs_set_scan_report_filter report_filter;
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 struct scan_filter {
 	uint8_t count;
@@ -440,6 +476,10 @@ static void reset(struct net_buf *buf, struct net_buf **evt)
 	sf_curr = 0xFF;
 #endif
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	(void)memset(&report_filter, 0, sizeof(report_filter));
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
 	dup_count = DUP_FILTER_DISABLED;
 #if defined(CONFIG_BT_CTLR_SYNC_PERIODIC_ADI_SUPPORT)
@@ -1772,8 +1812,7 @@ static void le_set_scan_enable(struct net_buf *buf, struct net_buf **evt)
 			dup_scan = true;
 
 			/* All entries reset */
-			dup_count = 0;
-			dup_curr = 0U;
+			dup_filter_reset();
 		} else if (!dup_scan) {
 			dup_scan = true;
 			dup_ext_adv_reset();
@@ -1781,8 +1820,7 @@ static void le_set_scan_enable(struct net_buf *buf, struct net_buf **evt)
 
 		} else {
 			/* All entries reset */
-			dup_count = 0;
-			dup_curr = 0U;
+			dup_filter_reset();
 		}
 	} else {
 #if defined(CONFIG_BT_CTLR_SYNC_PERIODIC_ADI_SUPPORT)
@@ -3842,8 +3880,7 @@ static void le_set_ext_scan_enable(struct net_buf *buf, struct net_buf **evt)
 			dup_scan = true;
 
 			/* All entries reset */
-			dup_count = 0;
-			dup_curr = 0U;
+			dup_filter_reset();
 		} else if (!dup_scan) {
 			dup_scan = true;
 			dup_ext_adv_reset();
@@ -3851,8 +3888,7 @@ static void le_set_ext_scan_enable(struct net_buf *buf, struct net_buf **evt)
 
 		} else {
 			/* All entries reset */
-			dup_count = 0;
-			dup_curr = 0U;
+			dup_filter_reset();
 		}
 	} else {
 #if defined(CONFIG_BT_CTLR_SYNC_PERIODIC_ADI_SUPPORT)
@@ -3917,8 +3953,7 @@ static void le_per_adv_create_sync(struct net_buf *buf, struct net_buf **evt)
 	/* Initialize duplicate filtering */
 	if (cmd->options & BT_HCI_LE_PER_ADV_CREATE_SYNC_FP_FILTER_DUPLICATE) {
 		if (!dup_scan || (dup_count == DUP_FILTER_DISABLED)) {
-			dup_count = 0;
-			dup_curr = 0U;
+			dup_filter_reset();
 		} else {
 			/* NOTE: Invalidate dup_ext_adv_mode array entries is
 			 *       done when sync is established.
@@ -4001,8 +4036,7 @@ static void le_per_adv_recv_enable(struct net_buf *buf, struct net_buf **evt)
 		if (cmd->enable &
 		    BT_HCI_LE_SET_PER_ADV_RECV_ENABLE_FILTER_DUPLICATE) {
 			if (!dup_scan || (dup_count == DUP_FILTER_DISABLED)) {
-				dup_count = 0;
-				dup_curr = 0U;
+				dup_filter_reset();
 			} else {
 				/* NOTE: Invalidate dup_ext_adv_mode array
 				 *       entries is done when sync is
@@ -4835,6 +4869,14 @@ static void vs_read_supported_commands(struct net_buf *buf,
 	/* Set USB Transport Mode */
 	rp->commands[2] |= BIT(0);
 #endif /* USB_DEVICE_BLUETOOTH_VS_H4 */
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	/* Set Scan Report Filter */
+	rp->commands[2] |= BIT(2);
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+	/* Read Latency Profile */
+	rp->commands[2] |= BIT(3);
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
 }
 
 static void vs_read_supported_features(struct net_buf *buf,
@@ -4943,6 +4985,63 @@ static void vs_set_scan_req_reports(struct net_buf *buf, struct net_buf **evt)
 }
 #endif /* CONFIG_BT_CTLR_VS_SCAN_REQ_RX */
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+static void vs_set_scan_report_filter(struct net_buf *buf, struct net_buf **evt)
+{
+	struct bt_hci_cp_vs_set_scan_report_filter *cmd = (void *)buf->data;
+
+	if (cmd->filter & ~(BT_HCI_VS_SCAN_REPORT_FILTER_ADDR |
+			    BT_HCI_VS_SCAN_REPORT_FILTER_AD_TYPE |
+			    BT_HCI_VS_SCAN_REPORT_FILTER_RSSI)) {
+		*evt = cmd_complete_status(BT_HCI_ERR_INVALID_PARAM);
+		return;
+	}
+
+	(void)memcpy(&report_filter, cmd, sizeof(report_filter));
+
+	*evt = cmd_complete_status(0x00);
+}
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+static void vs_read_latency_profile(struct net_buf *buf, struct net_buf **evt)
+{
+	struct bt_hci_cp_vs_read_latency_profile *cmd = (void *)buf->data;
+	struct bt_hci_rp_vs_read_latency_profile *rp;
+	uint32_t hist[UTIL_LATENCY_BUCKETS];
+	uint32_t late;
+
+	BUILD_ASSERT(BT_HCI_VS_LATENCY_BUCKETS == UTIL_LATENCY_BUCKETS);
+
+	if (cmd->type == BT_HCI_VS_LATENCY_PROFILE_MAYFLY) {
+		if ((cmd->caller_id >= MAYFLY_CALLER_COUNT) ||
+		    (cmd->callee_id >= MAYFLY_CALLEE_COUNT)) {
+			*evt = cmd_complete_status(BT_HCI_ERR_INVALID_PARAM);
+			return;
+		}
+
+		mayfly_latency_get(cmd->caller_id, cmd->callee_id, hist,
+				   cmd->reset);
+		late = 0U;
+	} else if (cmd->type == BT_HCI_VS_LATENCY_PROFILE_PREPARE) {
+		lll_prof_prepare_latency_get(hist, &late, cmd->reset);
+	} else {
+		*evt = cmd_complete_status(BT_HCI_ERR_INVALID_PARAM);
+		return;
+	}
+
+	rp = hci_cmd_complete(evt, sizeof(*rp));
+	rp->status = 0x00;
+
+	for (uint8_t i = 0U; i < UTIL_LATENCY_BUCKETS; i++) {
+		rp->hist[i] = sys_cpu_to_le32(hist[i]);
+	}
+
+	rp->late = sys_cpu_to_le32(late);
+	rp->collisions = sys_cpu_to_le32(ticker_slot_collisions_get(cmd->reset));
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 #if defined(CONFIG_BT_CTLR_TX_PWR_DYNAMIC_CONTROL)
 static void vs_write_tx_power_level(struct net_buf *buf, struct net_buf **evt)
 {
@@ -5508,6 +5607,18 @@ int hci_vendor_cmd_handle_common(uint16_t ocf, struct net_buf *cmd,
 		break;
 #endif /* CONFIG_BT_CTLR_VS_SCAN_REQ_RX */
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	case BT_OCF(BT_HCI_OP_VS_SET_SCAN_REPORT_FILTER):
+		vs_set_scan_report_filter(cmd, evt);
+		break;
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+	case BT_OCF(BT_HCI_OP_VS_READ_LATENCY_PROFILE):
+		vs_read_latency_profile(cmd, evt);
+		break;
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 #if defined(CONFIG_BT_CTLR_TX_PWR_DYNAMIC_CONTROL)
 	case BT_OCF(BT_HCI_OP_VS_WRITE_TX_POWER_LEVEL):
 		vs_write_tx_power_level(cmd, evt);
@@ -6202,6 +6313,76 @@ static inline bool is_dup_or_update(struct dup_entry *dup, uint8_t adv_type,
 	return true;
 }
 
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+static uint16_t dup_hash_get(uint8_t addr_type, const uint8_t *addr)
+{
+	uint32_t hash = addr_type;
+
+	for (uint8_t i = 0U; i < BDADDR_SIZE; i++) {
+		hash = (hash * 31U) + addr[i];
+	}
+
+	return hash % CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE;
+}
+
+static void dup_hash_unlink(uint16_t idx)
+{
+	struct dup_entry *dup = &dup_filter[idx];
+	uint16_t *next;
+
+	next = &dup_hash[dup_hash_get(dup->addr.type, dup->addr.a.val)];
+	while (*next != idx) {
+		LL_ASSERT(*next != DUP_HASH_NULL);
+
+		next = &dup_filter[*next].hash_next;
+	}
+
+	*next = dup->hash_next;
+}
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0 */
+
+static struct dup_entry *dup_lookup(uint8_t addr_type, const uint8_t *addr)
+{
+	struct dup_entry *dup;
+
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+	for (uint16_t i = dup_hash[dup_hash_get(addr_type, addr)];
+	     i != DUP_HASH_NULL; i = dup->hash_next) {
+		dup = &dup_filter[i];
+#else /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE == 0 */
+	for (int32_t i = 0; i < dup_count; i++) {
+		dup = &dup_filter[i];
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE == 0 */
+		if (!memcmp(addr, &dup->addr.a.val[0], sizeof(bt_addr_t)) &&
+		    (addr_type == dup->addr.type)) {
+			return dup;
+		}
+	}
+
+	return NULL;
+}
+
+/* Start filtering for a new or aged entry */
+static void dup_entry_start(struct dup_entry *dup, uint8_t adv_type,
+			    uint8_t adv_mode, const struct pdu_adv_adi *adi,
+			    uint8_t data_status)
+{
+	dup->mask = BIT(adv_type);
+
+#if defined(CONFIG_BT_CTLR_ADV_EXT)
+	dup_ext_adv_mode_reset(dup->adv_mode);
+	dup_ext_adv_adi_store(&dup->adv_mode[adv_mode], adi, data_status);
+#else /* !CONFIG_BT_CTLR_ADV_EXT */
+	ARG_UNUSED(adv_mode);
+	ARG_UNUSED(adi);
+	ARG_UNUSED(data_status);
+#endif /* !CONFIG_BT_CTLR_ADV_EXT */
+
+#if CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0
+	dup->time = k_uptime_get_32();
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0 */
+}
+
 static bool dup_found(uint8_t adv_type, uint8_t addr_type, const uint8_t *addr,
 		      uint8_t adv_mode, const struct pdu_adv_adi *adi,
 		      uint8_t data_status)
@@ -6216,13 +6397,19 @@ static bool dup_found(uint8_t adv_type, uint8_t addr_type, const uint8_t *addr,
 #endif /* CONFIG_BT_CTLR_ADV_EXT */
 
 		/* find for existing entry and update if changed */
-		for (int32_t i = 0; i < dup_count; i++) {
-			dup = &dup_filter[i];
-			if (memcmp(addr, &dup->addr.a.val[0],
-				   sizeof(bt_addr_t)) ||
-			    (addr_type != dup->addr.type)) {
-				continue;
+		dup = dup_lookup(addr_type, addr);
+		if (dup) {
+#if CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0
+			if ((k_uptime_get_32() - dup->time) >=
+			    (CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT *
+			     MSEC_PER_SEC)) {
+				/* entry aged, report as if new */
+				dup_entry_start(dup, adv_type, adv_mode, adi,
+						data_status);
+
+				return false;
 			}
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_TIMEOUT > 0 */
 
 			/* still duplicate or update entry with change */
 			return is_dup_or_update(dup, adv_type, adv_mode, adi,
@@ -6231,15 +6418,24 @@ static bool dup_found(uint8_t adv_type, uint8_t addr_type, const uint8_t *addr,
 
 		/* insert into the duplicate filter */
 		dup = &dup_filter[dup_curr];
+
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+		if ((int32_t)dup_curr < dup_count) {
+			/* overwriting the oldest entry */
+			dup_hash_unlink(dup_curr);
+		}
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0 */
+
 		(void)memcpy(&dup->addr.a.val[0], addr, sizeof(bt_addr_t));
 		dup->addr.type = addr_type;
-		dup->mask = BIT(adv_type);
+		dup_entry_start(dup, adv_type, adv_mode, adi, data_status);
 
-#if defined(CONFIG_BT_CTLR_ADV_EXT)
-		dup_ext_adv_mode_reset(dup->adv_mode);
-		dup_ext_adv_adi_store(&dup->adv_mode[adv_mode], adi,
-				      data_status);
-#endif /* CONFIG_BT_CTLR_ADV_EXT */
+#if CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0
+		uint16_t *head = &dup_hash[dup_hash_get(addr_type, addr)];
+
+		dup->hash_next = *head;
+		*head = dup_curr;
+#endif /* CONFIG_BT_CTLR_DUP_FILTER_HASH_SIZE > 0 */
 
 		if (dup_count < CONFIG_BT_CTLR_DUP_FILTER_LEN) {
 			dup_count++;
@@ -6257,6 +6453,42 @@ static bool dup_found(uint8_t adv_type, uint8_t addr_type, const uint8_t *addr,
 }
 #endif /* CONFIG_BT_CTLR_DUP_FILTER_LEN > 0 */
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+static bool report_filtered(uint8_t addr_type, const uint8_t *addr, int8_t rssi,
+			    const uint8_t *data, uint8_t data_len)
+{
+	uint8_t filter = report_filter.filter;
+
+	if ((filter & BT_HCI_VS_SCAN_REPORT_FILTER_ADDR) &&
+	    (!addr || (addr_type != report_filter.addr.type) ||
+	     memcmp(addr, report_filter.addr.a.val, sizeof(bt_addr_t)))) {
+		return true;
+	}
+
+	if ((filter & BT_HCI_VS_SCAN_REPORT_FILTER_RSSI) &&
+	    (rssi < report_filter.rssi_min)) {
+		return true;
+	}
+
+	if (filter & BT_HCI_VS_SCAN_REPORT_FILTER_AD_TYPE) {
+		/* Walk the AD structures, each being length, type and data */
+		for (uint16_t i = 0U; (i + 1U) < data_len; i += data[i] + 1U) {
+			if (data[i] == 0U) {
+				break;
+			}
+
+			if (data[i + 1U] == report_filter.ad_type) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	return false;
+}
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if defined(CONFIG_BT_CTLR_EXT_SCAN_FP)
 static inline void le_dir_adv_report(struct pdu_adv *adv, struct net_buf *buf,
 				     int8_t rssi, uint8_t rl_idx)
@@ -6271,6 +6503,12 @@ static inline void le_dir_adv_report(struct pdu_adv *adv, struct net_buf *buf,
 
 	LL_ASSERT(adv->type == PDU_ADV_TYPE_DIRECT_IND);
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	if (report_filtered(adv->tx_addr, adv->adv_ind.addr, rssi, NULL, 0U)) {
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
 	if (dup_scan &&
 	    dup_found(adv->type, adv->tx_addr, adv->adv_ind.addr, 0, NULL, 0)) {
@@ -6425,18 +6663,25 @@ static void le_advertising_report(struct pdu_data *pdu_data,
 		return;
 	}
 
+	if (adv->type != PDU_ADV_TYPE_DIRECT_IND) {
+		data_len = (adv->len - BDADDR_SIZE);
+	} else {
+		data_len = 0U;
+	}
+
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	if (report_filtered(adv->tx_addr, adv->adv_ind.addr, rssi,
+			    adv->adv_ind.data, data_len)) {
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
 	if (dup_scan &&
 	    dup_found(adv->type, adv->tx_addr, adv->adv_ind.addr, 0, NULL, 0)) {
 		return;
 	}
 #endif /* CONFIG_BT_CTLR_DUP_FILTER_LEN > 0 */
-
-	if (adv->type != PDU_ADV_TYPE_DIRECT_IND) {
-		data_len = (adv->len - BDADDR_SIZE);
-	} else {
-		data_len = 0U;
-	}
 	info_len = sizeof(struct bt_hci_evt_le_advertising_info) + data_len +
 		   sizeof(*prssi);
 	sep = meta_evt(buf, BT_HCI_EVT_LE_ADVERTISING_REPORT,
@@ -6529,6 +6774,19 @@ static void le_ext_adv_legacy_report(struct pdu_data *pdu_data,
 	}
 #endif /* CONFIG_BT_CTLR_PRIVACY */
 
+	if (adv->type != PDU_ADV_TYPE_DIRECT_IND) {
+		data_len = (adv->len - BDADDR_SIZE);
+	} else {
+		data_len = 0U;
+	}
+
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	if (report_filtered(adv->tx_addr, adv->adv_ind.addr, rssi,
+			    adv->adv_ind.data, data_len)) {
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
 	if (dup_scan &&
 	    dup_found(adv->type, adv->tx_addr, adv->adv_ind.addr, 0, NULL, 0)) {
@@ -6536,12 +6794,6 @@ static void le_ext_adv_legacy_report(struct pdu_data *pdu_data,
 	}
 #endif /* CONFIG_BT_CTLR_DUP_FILTER_LEN > 0 */
 
-	if (adv->type != PDU_ADV_TYPE_DIRECT_IND) {
-		data_len = (adv->len - BDADDR_SIZE);
-	} else {
-		data_len = 0U;
-	}
-
 	info_len = sizeof(struct bt_hci_evt_le_ext_advertising_info) +
 		   data_len;
 	sep = meta_evt(buf, BT_HCI_EVT_LE_EXT_ADVERTISING_REPORT,
@@ -7267,6 +7519,13 @@ no_ext_hdr:
 		return;
 	}
 
+#if defined(CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER)
+	if (report_filtered(adv_addr_type, adv_addr, rssi, data, data_len)) {
+		node_rx_extra_list_release(node_rx->rx_ftr.extra);
+		return;
+	}
+#endif /* CONFIG_BT_CTLR_VS_SCAN_REPORT_FILTER */
+
 #if CONFIG_BT_CTLR_DUP_FILTER_LEN > 0
 	if (adv_addr) {
 		if (dup_scan &&
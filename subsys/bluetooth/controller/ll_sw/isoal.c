@@ -1821,6 +1821,29 @@ static isoal_status_t isoal_tx_try_emit_pdu(struct isoal_source *source,
 	return err;
 }
 
+/**
+ * @brief Check if SDU data is already at the write point of the PDU in
+ *        production
+ * @param[in]  pp          PDU production state
+ * @param[in]  sdu_payload SDU data to be written
+ * @return     True if the data needs no copy
+ */
+static inline bool isoal_tx_payload_in_place(const struct isoal_pdu_production *pp,
+					     const uint8_t *sdu_payload)
+{
+#if defined(CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET)
+	const struct isoal_pdu_buffer *contents = &pp->pdu.contents;
+
+	return (contents->pdu != NULL) &&
+	       (sdu_payload == &contents->pdu->payload[pp->pdu_written]);
+#else /* !CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET */
+	ARG_UNUSED(pp);
+	ARG_UNUSED(sdu_payload);
+
+	return false;
+#endif /* !CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET */
+}
+
 /**
  * @brief Get the next unframed payload number for transmission based on the
  *        input meta data in the TX SDU and the current production information.
@@ -2053,8 +2076,11 @@ static isoal_status_t isoal_tx_unframed_produce(isoal_source_handle_t source_hdl
 		 * Relies on initialization value being 0.
 		 */
 
-		/* Reset PDU fragmentation count for this SDU */
-		pp->pdu_cnt = 0;
+		/* Reset PDU fragmentation count for this SDU. A PDU handed out
+		 * by isoal_tx_unframed_payload_get() already belongs to it.
+		 */
+		pp->pdu_cnt = ((pp->pdu_available > 0U) &&
+			       (pp->pdu_written == 0U)) ? 1U : 0U;
 
 		/* The start of an unframed SDU will always be in a new PDU.
 		 * There cannot be any other fragments packed.
@@ -2108,10 +2134,15 @@ static isoal_status_t isoal_tx_unframed_produce(isoal_source_handle_t source_hdl
 					zero_length_sdu);
 
 		if (consume_len > 0) {
-			err |= session->pdu_write(&pdu->contents,
-						  pp->pdu_written,
-						  sdu_payload,
-						  consume_len);
+			/* Data written in place by the vendor data path needs
+			 * no copy
+			 */
+			if (!isoal_tx_payload_in_place(pp, sdu_payload)) {
+				err |= session->pdu_write(&pdu->contents,
+							  pp->pdu_written,
+							  sdu_payload,
+							  consume_len);
+			}
 			sdu_payload       += consume_len;
 			pp->pdu_written   += consume_len;
 			pp->pdu_available -= consume_len;
@@ -2857,6 +2888,70 @@ isoal_status_t isoal_tx_sdu_fragment(isoal_source_handle_t source_hdl,
 	return err;
 }
 
+#if defined(CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET)
+/**
+ * @brief  Get the payload of the next unframed PDU to write an SDU into
+ *
+ * Lets a vendor data path produce an SDU straight into PDU memory. The SDU,
+ * or its first fragment, is then passed to isoal_tx_sdu_fragment() with dbuf
+ * set to the returned payload and is not copied again. The PDU stays in
+ * production until then; calling again without producing returns the same
+ * payload.
+ *
+ * @param  source_hdl[in]  Source handle
+ * @param  payload[out]    Start of the PDU payload
+ * @param  size[out]       Number of bytes that fit in the PDU
+ * @return                 ISOAL_STATUS_ERR_UNSPECIFIED if the source is framed
+ *                         or a PDU is partially written, otherwise the status
+ *                         of the PDU allocation
+ */
+isoal_status_t isoal_tx_unframed_payload_get(isoal_source_handle_t source_hdl,
+					     uint8_t **payload,
+					     isoal_pdu_len_t *size)
+{
+	struct isoal_source_session *session;
+	struct isoal_pdu_production *pp;
+	struct isoal_pdu_produced *pdu;
+	struct isoal_source *source;
+	isoal_status_t err;
+
+	source = &isoal_global.source_state[source_hdl];
+	session = &source->session;
+	pp = &source->pdu_production;
+	pdu = &pp->pdu;
+
+	/* Framed PDUs carry segmentation headers, and an unframed SDU always
+	 * starts a new PDU
+	 */
+	if (session->framed || (pp->pdu_written > 0U)) {
+		return ISOAL_STATUS_ERR_UNSPECIFIED;
+	}
+
+	if (pp->pdu_available == 0U) {
+		err = session->pdu_alloc(&pdu->contents);
+		if (err) {
+			pdu->contents.handle = NULL;
+			pdu->contents.pdu    = NULL;
+			pdu->contents.size   = 0;
+
+			return err;
+		}
+
+		/* Counted towards the SDU when it is produced */
+		pp->pdu_written   = 0;
+		pp->pdu_available = MIN(session->max_pdu_size,
+					pdu->contents.size);
+		pp->pdu_allocated = 1U;
+		LL_ASSERT(pp->pdu_available > 0);
+	}
+
+	*payload = pdu->contents.pdu->payload;
+	*size = pp->pdu_available;
+
+	return ISOAL_STATUS_OK;
+}
+#endif /* CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET */
+
 void isoal_tx_pdu_release(isoal_source_handle_t source_hdl,
 			  struct node_tx_iso *node_tx)
 {
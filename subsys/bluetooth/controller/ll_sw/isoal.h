@@ -488,6 +488,12 @@ uint16_t isoal_tx_unframed_get_next_payload_number(isoal_source_handle_t source_
 void isoal_tx_pdu_release(isoal_source_handle_t source_hdl,
 			  struct node_tx_iso *node_tx);
 
+#if defined(CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET)
+isoal_status_t isoal_tx_unframed_payload_get(isoal_source_handle_t source_hdl,
+					     uint8_t **payload,
+					     isoal_pdu_len_t *size);
+#endif /* CONFIG_BT_CTLR_ISOAL_TX_PAYLOAD_GET */
+
 isoal_status_t isoal_tx_get_sync_info(isoal_source_handle_t source_hdl,
 				      uint16_t *seq,
 				      uint32_t *timestamp,
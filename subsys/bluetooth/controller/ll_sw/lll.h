@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018-2021 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -611,6 +612,11 @@ int lll_prepare(lll_is_abort_cb_t is_abort_cb,
 		lll_prepare_cb_t prepare_cb, int8_t event_prio,
 		struct lll_prepare_param *prepare_param);
 int lll_resume_enqueue(lll_prepare_cb_t resume_cb, int resume_prio);
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+void lll_prof_prepare_latency(uint32_t us, uint8_t late);
+void lll_prof_prepare_latency_get(uint32_t *hist, uint32_t *late,
+				  uint8_t reset);
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
 int lll_prepare_resolve(lll_is_abort_cb_t is_abort_cb, lll_abort_cb_t abort_cb,
 			lll_prepare_cb_t prepare_cb,
 			struct lll_prepare_param *prepare_param,
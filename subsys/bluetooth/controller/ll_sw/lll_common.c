@@ -1,13 +1,16 @@
 /*
  * Copyright (c) 2021 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <errno.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <zephyr/device.h>
 
+#include "util/util.h"
 #include "util/mem.h"
 #include "util/memq.h"
 
@@ -15,6 +18,13 @@
 
 #include "hal/debug.h"
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+/* Histogram of the delay from the ticker expiry till the event prepare */
+static uint32_t prepare_hist[UTIL_LATENCY_BUCKETS];
+/* Prepares too late to start the event in its slot */
+static uint32_t prepare_late;
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 /**
  * @brief Common entry point for LLL event prepare invocations from ULL.
  *
@@ -95,3 +105,39 @@ void lll_done_score(void *param, uint8_t result)
 	}
 }
 #endif /* CONFIG_BT_CTLR_JIT_SCHEDULING */
+
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+/**
+ * @brief Record the latency of an event prepare.
+ *
+ * @param us   Delay from the ticker expiry till the prepare, in microseconds
+ * @param late Non-zero if the event could not start in its slot
+ */
+void lll_prof_prepare_latency(uint32_t us, uint8_t late)
+{
+	prepare_hist[util_latency_bucket(us)]++;
+
+	if (late) {
+		prepare_late++;
+	}
+}
+
+/**
+ * @brief Get the event prepare latencies recorded.
+ *
+ * @param hist  Histogram of UTIL_LATENCY_BUCKETS buckets
+ * @param late  Number of prepares too late to start the event in its slot
+ * @param reset Non-zero to reset the histogram and count
+ */
+void lll_prof_prepare_latency_get(uint32_t *hist, uint32_t *late,
+				  uint8_t reset)
+{
+	(void)memcpy(hist, prepare_hist, sizeof(prepare_hist));
+	*late = prepare_late;
+
+	if (reset) {
+		(void)memset(prepare_hist, 0, sizeof(prepare_hist));
+		prepare_late = 0U;
+	}
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
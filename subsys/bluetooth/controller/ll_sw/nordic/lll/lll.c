@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018-2020 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -545,10 +546,20 @@ uint32_t lll_preempt_calc(struct ull_hdr *ull, uint8_t ticker_id,
 	ticks_now = ticker_ticks_now_get();
 	diff = ticker_ticks_diff_get(ticks_now, ticks_at_event);
 	if (diff & BIT(HAL_TICKER_CNTR_MSBIT)) {
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+		lll_prof_prepare_latency(0U, 0U);
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 		return 0;
 	}
 
 	diff += HAL_TICKER_CNTR_CMP_OFFSET_MIN;
+
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+	lll_prof_prepare_latency(HAL_TICKER_TICKS_TO_US(diff),
+				 diff > HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US));
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 	if (diff > HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US)) {
 		/* TODO: for Low Latency Feature with Advanced XTAL feature.
 		 * 1. Release retained HF clock.
@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2018-2019 Nordic Semiconductor ASA
  * Copyright 2019 NXP
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -406,10 +407,20 @@ uint32_t lll_preempt_calc(struct ull_hdr *ull, uint8_t ticker_id,
 	ticks_now = ticker_ticks_now_get();
 	diff = ticks_now - ticks_at_event;
 	if (diff & BIT(HAL_TICKER_CNTR_MSBIT)) {
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+		lll_prof_prepare_latency(0U, 0U);
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 		return 0;
 	}
 
 	diff += HAL_TICKER_CNTR_CMP_OFFSET_MIN;
+
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+	lll_prof_prepare_latency(HAL_TICKER_TICKS_TO_US(diff),
+				 diff > HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US));
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 	if (diff > HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US)) {
 		/* TODO: for Low Latency Feature with Advanced XTAL feature.
 		 * 1. Release retained HF clock.
@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2016-2018 Nordic Semiconductor ASA
  * Copyright (c) 2016 Vinayak Kariappa Chettimada
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -299,6 +300,14 @@ struct ticker_instance {
 	uint8_t  ticker_id_head;	/* Index of first ticker node (next to
 					 * expire)
 					 */
+#if defined(CONFIG_BT_TICKER_ENQUEUE_HINT)
+	uint8_t  ticker_id_hint;	/* Index of last enqueued ticker node,
+					 * while still in the list
+					 */
+	uint32_t ticks_hint;		/* Absolute ticks at which the hint
+					 * node expires
+					 */
+#endif /* CONFIG_BT_TICKER_ENQUEUE_HINT */
 	uint8_t  job_guard;		/* Flag preventing ticker_worker from
 					 * running if ticker_job is active
 					 */
@@ -347,6 +356,11 @@ BUILD_ASSERT(sizeof(struct ticker_user_op) == TICKER_USER_OP_T_SIZE);
 #define TICKER_INSTANCE_MAX 1
 static struct ticker_instance _instance[TICKER_INSTANCE_MAX];
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+/* Expiries skipped as their slot collided with another reservation */
+static uint32_t slot_collisions;
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 /*****************************************************************************
  * Static Functions
  ****************************************************************************/
@@ -541,6 +555,34 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 }
 #endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET */
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_HINT)
+/**
+ * @brief Forget the enqueue hint
+ *
+ * @details Called when the hint node leaves or moves in the list, or when
+ * ticks_current is re-based.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id no longer valid as hint, or TICKER_NULL to
+ *                 forget any
+ * @internal
+ */
+static inline void ticker_hint_clear(struct ticker_instance *instance,
+				     uint8_t id)
+{
+	if ((id == TICKER_NULL) || (id == instance->ticker_id_hint)) {
+		instance->ticker_id_hint = TICKER_NULL;
+	}
+}
+#else /* !CONFIG_BT_TICKER_ENQUEUE_HINT */
+static inline void ticker_hint_clear(struct ticker_instance *instance,
+				     uint8_t id)
+{
+	ARG_UNUSED(instance);
+	ARG_UNUSED(id);
+}
+#endif /* !CONFIG_BT_TICKER_ENQUEUE_HINT */
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Enqueue ticker node
@@ -574,6 +616,26 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	 */
 	previous = TICKER_NULL;
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_HINT)
+	uint32_t ticks_total = ticks_to_expire;
+
+	/* Start after the last enqueued node if expiring later than it. The
+	 * absolute expiry of a queued node does not change while the deltas
+	 * around it do.
+	 */
+	if (instance->ticker_id_hint != TICKER_NULL) {
+		uint32_t ticks_to_hint;
+
+		ticks_to_hint = ticker_ticks_diff_get(instance->ticks_hint,
+						      instance->ticks_current);
+		if (ticks_to_expire > ticks_to_hint) {
+			ticks_to_expire -= ticks_to_hint;
+			previous = instance->ticker_id_hint;
+			current = node[previous].next;
+		}
+	}
+#endif /* CONFIG_BT_TICKER_ENQUEUE_HINT */
+
 	while ((current != TICKER_NULL) && (ticks_to_expire >=
 		(ticks_to_expire_current =
 		(ticker_current = &node[current])->ticks_to_expire))) {
@@ -608,6 +670,12 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		node[current].ticks_to_expire -= ticks_to_expire;
 	}
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_HINT)
+	instance->ticker_id_hint = id;
+	instance->ticks_hint = (instance->ticks_current + ticks_total) &
+			       HAL_TICKER_CNTR_MASK;
+#endif /* CONFIG_BT_TICKER_ENQUEUE_HINT */
+
 	return id;
 }
 #else /* CONFIG_BT_TICKER_LOW_LAT */
@@ -757,6 +825,8 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 		return 0;
 	}
 
+	ticker_hint_clear(instance, id);
+
 	if (previous == current) {
 		/* Ticker is the first in the list */
 		instance->ticker_id_head = ticker_current->next;
@@ -1345,6 +1415,10 @@ void ticker_worker(void *param)
 			 */
 			ticker->lazy_current++;
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+			slot_collisions++;
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 			if ((ticker->must_expire == 0U) ||
 			    (ticker->lazy_periodic >= ticker->lazy_current) ||
 			    TICKER_RESCHEDULE_PENDING(ticker)) {
@@ -2106,6 +2180,7 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 #endif /* CONFIG_BT_TICKER_EXT_EXPIRE_INFO */
 
 		/* remove the expired ticker from head */
+		ticker_hint_clear(instance, id_expired);
 		instance->ticker_id_head = ticker->next;
 
 		/* Ticker will be restarted if periodic or to be re-scheduled */
@@ -2593,6 +2668,9 @@ static uint8_t ticker_job_reschedule_in_window(struct ticker_instance *instance,
 			ticker_id_next = ticker_next->next;
 		}
 
+		/* Node expires at a different tick now */
+		ticker_hint_clear(instance, ticker_id_resched);
+
 		/* If the node moved in the list, insert it */
 		if (ticker_id_prev != TICKER_NULL) {
 			/* Remove node from its current position in list */
@@ -3023,6 +3101,7 @@ ticker_job_compare_update(struct ticker_instance *instance,
 #endif /* !CONFIG_BT_TICKER_SLOT_AGNOSTIC */
 
 			instance->ticks_current = cntr_cnt_get();
+			ticker_hint_clear(instance, TICKER_NULL);
 		}
 
 		return 0U;
@@ -3036,6 +3115,7 @@ ticker_job_compare_update(struct ticker_instance *instance,
 
 		if (cntr_start() == 0) {
 			instance->ticks_current = ticks_current;
+			ticker_hint_clear(instance, TICKER_NULL);
 		}
 	}
 
@@ -3317,6 +3397,9 @@ uint8_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->trigger_set_cb = trigger_set_cb;
 
 	instance->ticker_id_head = TICKER_NULL;
+#if defined(CONFIG_BT_TICKER_ENQUEUE_HINT)
+	instance->ticker_id_hint = TICKER_NULL;
+#endif /* CONFIG_BT_TICKER_ENQUEUE_HINT */
 	instance->ticks_current = cntr_cnt_get();
 	instance->ticks_elapsed_first = 0U;
 	instance->ticks_elapsed_last = 0U;
@@ -4094,3 +4177,23 @@ uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old)
 {
 	return ((ticks_now - ticks_old) & HAL_TICKER_CNTR_MASK);
 }
+
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+/**
+ * @brief Get the number of expiries skipped due to slot collisions
+ *
+ * @param reset Non-zero to reset the count
+ * @return Number of ticker expiries skipped as their slot reservation
+ *	   collided with another one, since the last reset
+ */
+uint32_t ticker_slot_collisions_get(uint8_t reset)
+{
+	uint32_t count = slot_collisions;
+
+	if (reset) {
+		slot_collisions = 0U;
+	}
+
+	return count;
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
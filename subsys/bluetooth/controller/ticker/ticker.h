@@ -202,6 +202,9 @@ uint8_t ticker_job_idle_get(uint8_t instance_index, uint8_t user_id,
 void ticker_job_sched(uint8_t instance_index, uint8_t user_id);
 uint32_t ticker_ticks_now_get(void);
 uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old);
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+uint32_t ticker_slot_collisions_get(uint8_t reset);
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
 
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
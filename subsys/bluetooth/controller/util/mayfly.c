@@ -1,18 +1,22 @@
 /*
  * Copyright (c) 2016-2017 Nordic Semiconductor ASA
  * Copyright (c) 2016 Vinayak Kariappa Chettimada
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include <soc.h>
+#include <zephyr/kernel.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/printk.h>
 
 #include "hal/cpu.h"
 
+#include "util.h"
 #include "memq.h"
 #include "mayfly.h"
 
@@ -28,6 +32,12 @@ static struct {
 static memq_link_t mfl[MAYFLY_CALLEE_COUNT][MAYFLY_CALLER_COUNT];
 static uint8_t mfp[MAYFLY_CALLEE_COUNT];
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+/* Histograms of the delay from enqueue till run, of queued mayflies */
+static uint32_t mfh[MAYFLY_CALLEE_COUNT][MAYFLY_CALLER_COUNT]
+		   [UTIL_LATENCY_BUCKETS];
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 #if defined(MAYFLY_UT)
 static uint8_t _state;
 #endif /* MAYFLY_UT */
@@ -91,6 +101,10 @@ uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
 	if (state != 0U) {
 		if (chain) {
 			if (state != 1U) {
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+				m->_ts = k_cycle_get_32();
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 				/* mark as ready in queue */
 				m->_req = ack + 1;
 
@@ -113,6 +127,10 @@ uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
 		return 0;
 	}
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+	m->_ts = k_cycle_get_32();
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 	/* new, add as ready in the queue */
 	m->_req = ack + 1;
 	memq_enqueue(m->_link, m, &mft[callee_id][caller_id].tail);
@@ -213,6 +231,12 @@ void mayfly_run(uint8_t callee_id)
 				/* mark mayfly as ran */
 				m->_ack--;
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+				uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - m->_ts);
+
+				mfh[callee_id][caller_id][util_latency_bucket(us)]++;
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 				/* call the mayfly function */
 				m->fp(m->param);
 			}
@@ -279,6 +303,20 @@ void mayfly_run(uint8_t callee_id)
 	}
 }
 
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+void mayfly_latency_get(uint8_t caller_id, uint8_t callee_id, uint32_t *hist,
+			uint8_t reset)
+{
+	(void)memcpy(hist, mfh[callee_id][caller_id],
+		     sizeof(mfh[callee_id][caller_id]));
+
+	if (reset) {
+		(void)memset(mfh[callee_id][caller_id], 0,
+			     sizeof(mfh[callee_id][caller_id]));
+	}
+}
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
+
 #if defined(MAYFLY_UT)
 #define MAYFLY_CALL_ID_CALLER MAYFLY_CALL_ID_0
 #define MAYFLY_CALL_ID_CALLEE MAYFLY_CALL_ID_2
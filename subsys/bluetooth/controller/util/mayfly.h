@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2016-2017 Nordic Semiconductor ASA
  * Copyright (c) 2016 Vinayak Kariappa Chettimada
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -18,6 +19,9 @@ struct mayfly {
 	memq_link_t *_link;
 	void *param;
 	void (*fp)(void *);
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+	uint32_t _ts;
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
 };
 
 void mayfly_init(void);
@@ -25,6 +29,10 @@ void mayfly_enable(uint8_t caller_id, uint8_t callee_id, uint8_t enable);
 uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
 		     struct mayfly *m);
 void mayfly_run(uint8_t callee_id);
+#if defined(CONFIG_BT_CTLR_PROFILE_LATENCY)
+void mayfly_latency_get(uint8_t caller_id, uint8_t callee_id, uint32_t *hist,
+			uint8_t reset);
+#endif /* CONFIG_BT_CTLR_PROFILE_LATENCY */
 
 extern void mayfly_enable_cb(uint8_t caller_id, uint8_t callee_id, uint8_t enable);
 extern uint32_t mayfly_is_enabled(uint8_t caller_id, uint8_t callee_id);
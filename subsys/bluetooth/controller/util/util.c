@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2016 Nordic Semiconductor ASA
  * Copyright (c) 2016 Vinayak Kariappa Chettimada
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -366,3 +367,25 @@ void util_set_bits(uint8_t *data, uint8_t bit_offs, uint8_t num_bits,
 		byteIdx++;
 	}
 }
+
+/**
+ * @brief Get the latency histogram bucket of a latency
+ *
+ * Bucket 0 counts latencies below 32 us, each following bucket doubles the
+ * upper bound and the last one counts all latencies of 2048 us and more.
+ *
+ * @param us Latency in microseconds
+ * @return Bucket index, below UTIL_LATENCY_BUCKETS
+ */
+uint8_t util_latency_bucket(uint32_t us)
+{
+	uint8_t bucket = 0U;
+
+	us >>= 5;
+	while (us && (bucket < (UTIL_LATENCY_BUCKETS - 1U))) {
+		us >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+}
@@ -277,6 +277,9 @@ struct bt_conn *bt_conn_new(struct bt_conn *conns, size_t size)
 #if defined(CONFIG_BT_CONN_TX)
 	k_work_init(&conn->tx_complete_work, tx_complete_work);
 #endif /* CONFIG_BT_CONN_TX */
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	conn->tx_weight = CONFIG_BT_CONN_TX_SCHED_WEIGHT;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 
 	return conn;
 }
@@ -526,6 +529,9 @@ int bt_conn_send_cb(struct bt_conn *conn, struct net_buf *buf,
 
 	tx_data(buf)->is_cont = false;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	atomic_inc(&conn->tx_queued);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 	net_buf_put(&conn->tx_queue, buf);
 	return 0;
 }
@@ -619,6 +625,63 @@ static inline uint16_t conn_mtu(struct bt_conn *conn)
 #endif /* CONFIG_BT_CONN */
 }
 
+static struct k_poll_signal conn_change =
+		K_POLL_SIGNAL_INITIALIZER(conn_change);
+
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+/* Whether the connection holds its share of the controller buffers, which is
+ * split between the connections that send through the same buffers by weight.
+ */
+static bool conn_tx_throttle(struct bt_conn *conn)
+{
+	struct k_sem *pkts = bt_conn_get_pkts(conn);
+	uint32_t weights = 0U;
+	uint32_t share;
+
+	if (conn->type == BT_CONN_TYPE_ISO || !pkts) {
+		return false;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(acl_conns); i++) {
+		struct bt_conn *c = &acl_conns[i];
+
+		if (c->state != BT_CONN_CONNECTED || bt_conn_get_pkts(c) != pkts) {
+			continue;
+		}
+
+		if (c == conn || atomic_get(&c->tx_queued) || atomic_get(&c->tx_in_flight)) {
+			weights += c->tx_weight;
+		}
+	}
+
+	share = MAX(1U, (pkts->limit * conn->tx_weight) / weights);
+	if (atomic_get(&conn->tx_in_flight) < share) {
+		return false;
+	}
+
+	atomic_set_bit(conn->flags, BT_CONN_TX_THROTTLED);
+	return true;
+}
+#else
+static inline bool conn_tx_throttle(struct bt_conn *conn)
+{
+	return false;
+}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
+void bt_conn_give_pkt(struct bt_conn *conn)
+{
+	k_sem_give(bt_conn_get_pkts(conn));
+
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	atomic_dec(&conn->tx_in_flight);
+
+	if (atomic_test_and_clear_bit(conn->flags, BT_CONN_TX_THROTTLED)) {
+		k_poll_signal_raise(&conn_change, 0);
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+}
+
 static int do_send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags)
 {
 	struct bt_conn_tx *tx = tx_data(buf)->tx;
@@ -681,7 +744,7 @@ fail:
 	/* If we get here, something has seriously gone wrong:
 	 * We also need to destroy the `parent` buf.
 	 */
-	k_sem_give(bt_conn_get_pkts(conn));
+	bt_conn_give_pkt(conn);
 	if (tx) {
 		/* `buf` might not get destroyed, and its `tx` pointer will still be reachable.
 		 * Make sure that we don't try to use the destroyed context later.
@@ -697,12 +760,22 @@ static int send_frag(struct bt_conn *conn,
 		     struct net_buf *buf, struct net_buf *frag,
 		     uint8_t flags)
 {
+	/* Leave the controller buffers beyond its share to other connections */
+	if (conn_tx_throttle(conn)) {
+		LOG_DBG("conn %p over its share of ctlr bufs", conn);
+		return -ENOBUFS;
+	}
+
 	/* Check if the controller can accept ACL packets */
 	if (k_sem_take(bt_conn_get_pkts(conn), K_NO_WAIT)) {
 		LOG_DBG("no controller bufs");
 		return -ENOBUFS;
 	}
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	atomic_inc(&conn->tx_in_flight);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Check for disconnection. It can't be done higher up (ie `send_buf`)
 	 * as `create_frag` blocks with K_FOREVER and the connection could
 	 * change state after waiting.
@@ -725,6 +798,9 @@ static int send_frag(struct bt_conn *conn,
 		 */
 		buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
 		frag = buf;
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+		atomic_dec(&conn->tx_queued);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 	}
 
 	return do_send_frag(conn, frag, flags);
@@ -825,9 +901,6 @@ static int send_buf(struct bt_conn *conn, struct net_buf *buf)
 	return send_frag(conn, buf, NULL, FRAG_END);
 }
 
-static struct k_poll_signal conn_change =
-		K_POLL_SIGNAL_INITIALIZER(conn_change);
-
 static void conn_cleanup(struct bt_conn *conn)
 {
 	struct net_buf *buf;
@@ -847,6 +920,10 @@ static void conn_cleanup(struct bt_conn *conn)
 		}
 	}
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	atomic_clear(&conn->tx_queued);
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	__ASSERT(sys_slist_is_empty(&conn->tx_pending), "Pending TX packets");
 	__ASSERT_NO_MSG(conn->pending_no_cb == 0);
 
@@ -903,6 +980,12 @@ static int conn_prepare_events(struct bt_conn *conn,
 	bool buffers_available = k_sem_count_get(conn_pkts) > 0;
 	bool packets_waiting = !k_fifo_is_empty(&conn->tx_queue);
 
+	if (packets_waiting && buffers_available && conn_tx_throttle(conn)) {
+		/* Resumed by bt_conn_give_pkt() once one of its buffers completes */
+		LOG_DBG("wait on own ctlr buffers");
+		return -EAGAIN;
+	}
+
 	if (packets_waiting && !buffers_available) {
 		/* Only resume sending when the controller has buffer space
 		 * available for this connection.
@@ -1024,7 +1107,7 @@ static void process_unack_tx(struct bt_conn *conn)
 		if (conn->pending_no_cb) {
 			conn->pending_no_cb--;
 			irq_unlock(key);
-			k_sem_give(bt_conn_get_pkts(conn));
+			bt_conn_give_pkt(conn);
 			continue;
 		}
 
@@ -1044,7 +1127,7 @@ static void process_unack_tx(struct bt_conn *conn)
 
 		conn_tx_destroy(conn, tx);
 
-		k_sem_give(bt_conn_get_pkts(conn));
+		bt_conn_give_pkt(conn);
 	}
 }
 
@@ -2642,6 +2725,13 @@ int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
 #else
 	info->security.enc_key_size = 0;
 #endif /* CONFIG_BT_SMP || CONFIG_BT_CLASSIC */
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	info->tx_queued = atomic_get(&conn->tx_queued);
+	info->tx_in_flight = atomic_get(&conn->tx_in_flight);
+#else
+	info->tx_queued = 0;
+	info->tx_in_flight = 0;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
 
 	switch (conn->type) {
 	case BT_CONN_TYPE_LE:
@@ -2694,6 +2784,22 @@ int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+int bt_conn_set_tx_weight(struct bt_conn *conn, uint8_t weight)
+{
+	if (weight == 0U || conn->type == BT_CONN_TYPE_ISO || conn->type == BT_CONN_TYPE_SCO) {
+		return -EINVAL;
+	}
+
+	conn->tx_weight = weight;
+
+	/* Shares may have grown, let throttled connections check again */
+	k_poll_signal_raise(&conn_change, 0);
+
+	return 0;
+}
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 int bt_conn_get_remote_info(struct bt_conn *conn,
 			    struct bt_conn_remote_info *remote_info)
 {
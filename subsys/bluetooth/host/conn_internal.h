@@ -80,6 +80,8 @@ enum {
 	BT_CONN_CTE_REQ_ENABLED,              /* CTE request procedure is enabled */
 	BT_CONN_CTE_RSP_ENABLED,              /* CTE response procedure is enabled */
 
+	BT_CONN_TX_THROTTLED,                 /* TX waits for its buffers to complete */
+
 	/* Total number of flags - must be at the end of the enum */
 	BT_CONN_NUM_FLAGS,
 };
@@ -241,6 +243,15 @@ struct bt_conn {
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED)
+	/* Buffers in tx_queue */
+	atomic_t		tx_queued;
+	/* Controller buffers taken and not yet completed */
+	atomic_t		tx_in_flight;
+	/* Share of the controller buffers relative to other connections */
+	uint8_t			tx_weight;
+#endif /* CONFIG_BT_CONN_TX_SCHED */
+
 	/* Active L2CAP channels */
 	sys_slist_t		channels;
 
@@ -477,6 +488,9 @@ void bt_conn_cleanup_all(void);
 /* Selects based on connection type right semaphore for ACL packets */
 struct k_sem *bt_conn_get_pkts(struct bt_conn *conn);
 
+/* Return a controller buffer taken for the connection */
+void bt_conn_give_pkt(struct bt_conn *conn);
+
 /* k_poll related helpers for the TX thread */
 int bt_conn_prepare_events(struct k_poll_event events[]);
 void bt_conn_process_tx(struct bt_conn *conn);
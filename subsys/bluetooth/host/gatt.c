@@ -95,6 +95,42 @@ enum gatt_global_flags {
 
 static ATOMIC_DEFINE(gatt_flags, GATT_NUM_FLAGS);
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Local attributes by handle - 1 */
+static const struct bt_gatt_attr *attr_index[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+/* UUID keys of the indexed attributes, see attr_index_uuid_key() */
+static uint16_t attr_index_keys[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+
+/* Bits 96-111 of the 128-bit form of the UUID, which bt_uuid_cmp() compares
+ * in, so that equal UUIDs of any type have equal keys.
+ */
+static uint16_t attr_index_uuid_key(const struct bt_uuid *uuid)
+{
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		return BT_UUID_16(uuid)->val;
+	case BT_UUID_TYPE_32:
+		return (uint16_t)BT_UUID_32(uuid)->val;
+	default:
+		return sys_get_le16(&BT_UUID_128(uuid)->val[12]);
+	}
+}
+
+static void attr_index_set(uint16_t handle, const struct bt_gatt_attr *attr)
+{
+	if (handle == 0U || handle > ARRAY_SIZE(attr_index)) {
+		return;
+	}
+
+	attr_index[handle - 1] = attr;
+	attr_index_keys[handle - 1] = attr ? attr_index_uuid_key(attr->uuid) : 0U;
+}
+#else
+static inline void attr_index_set(uint16_t handle, const struct bt_gatt_attr *attr)
+{
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, uint16_t len, uint16_t offset)
 {
@@ -1233,6 +1269,10 @@ populate:
 			bt_uuid_str(attrs->uuid), attrs->perm);
 	}
 
+	for (uint16_t i = 0; i < svc->attr_count; i++) {
+		attr_index_set(svc->attrs[i].handle, &svc->attrs[i]);
+	}
+
 	gatt_insert(svc, last_handle);
 
 	return 0;
@@ -1454,6 +1494,10 @@ static void bt_gatt_service_init(void)
 	}
 
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			attr_index_set(last_static_handle + 1 + i, &svc->attrs[i]);
+		}
+
 		last_static_handle += svc->attr_count;
 	}
 }
@@ -1634,6 +1678,8 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
+		attr_index_set(attr->handle, NULL);
+
 		if (is_host_managed_ccc(attr)) {
 			gatt_unregister_ccc(attr->user_data);
 		}
@@ -1991,6 +2037,42 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Iterate over the indexed handles, returns false if the range goes on past
+ * them, with start_handle moved to the first handle not indexed.
+ */
+static bool foreach_attr_type_index(uint16_t *start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t *num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	uint32_t last = MIN(end_handle, ARRAY_SIZE(attr_index));
+	uint16_t key = uuid ? attr_index_uuid_key(uuid) : 0U;
+
+	for (uint32_t handle = MAX(*start_handle, 1U); handle <= last; handle++) {
+		const struct bt_gatt_attr *attr = attr_index[handle - 1];
+
+		if (!attr || (uuid && attr_index_keys[handle - 1] != key)) {
+			continue;
+		}
+
+		if (gatt_foreach_iter(attr, handle, *start_handle, end_handle,
+				      uuid, attr_data, num_matches,
+				      func, user_data) == BT_GATT_ITER_STOP) {
+			return true;
+		}
+	}
+
+	if (end_handle <= ARRAY_SIZE(attr_index)) {
+		return true;
+	}
+
+	*start_handle = ARRAY_SIZE(attr_index) + 1;
+
+	return false;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -2002,6 +2084,15 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (atomic_test_bit(gatt_flags, GATT_SERVICE_INITIALIZED) &&
+	    start_handle <= ARRAY_SIZE(attr_index) &&
+	    foreach_attr_type_index(&start_handle, end_handle, uuid, attr_data,
+				    &num_matches, func, user_data)) {
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -2357,15 +2448,29 @@ static void gatt_add_nfy_to_buf(struct net_buf *buf,
 }
 
 #if (CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0)
+/* Room left in a batch, which has to fit the ATT_MTU of whichever bearer sends it */
+static size_t gatt_notify_mult_room(struct bt_conn *conn, struct net_buf *buf)
+{
+	uint16_t mtu = bt_att_get_min_mtu(conn);
+
+	if (buf->len >= mtu) {
+		return 0;
+	}
+
+	return MIN(net_buf_tailroom(buf), mtu - buf->len);
+}
+
 static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 			    struct bt_gatt_notify_params *params)
 {
 	struct net_buf **buf = &nfy_mult[bt_conn_index(conn)];
+	k_timeout_t flush = K_MSEC(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS);
 
 	/* Check if we can fit more data into it, in case it doesn't fit send
 	 * the existing buffer and proceed to create a new one
 	 */
-	if (*buf && ((net_buf_tailroom(*buf) < sizeof(struct bt_att_notify_mult) + params->len) ||
+	if (*buf && ((gatt_notify_mult_room(conn, *buf) <
+		      sizeof(struct bt_att_notify_mult) + params->len) ||
 	    !bt_att_tx_meta_data_match(*buf, params->func, params->user_data,
 				       BT_ATT_CHAN_OPT(params)))) {
 		int ret;
@@ -2396,11 +2501,21 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	LOG_DBG("handle 0x%04x len %u", handle, params->len);
 	gatt_add_nfy_to_buf(*buf, handle, params);
 
+	/* Send right away once not even an empty value fits anymore */
+	if (gatt_notify_mult_room(conn, *buf) <= sizeof(struct bt_att_notify_mult)) {
+		return gatt_notify_flush(conn);
+	}
+
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_CONN_INTERVAL)
+	if (conn->type == BT_CONN_TYPE_LE) {
+		flush = K_USEC(BT_CONN_INTERVAL_TO_US(conn->le.interval));
+	}
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_CONN_INTERVAL */
+
 	/* Use `k_work_schedule` to keep the original deadline, instead of
 	 * re-setting the timeout whenever a new notification is appended.
 	 */
-	k_work_schedule(&nfy_mult_work,
-			K_MSEC(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS));
+	k_work_schedule(&nfy_mult_work, flush);
 
 	return 0;
 }
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2017-2021 Nordic Semiconductor ASA
  * Copyright (c) 2015-2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -72,6 +73,12 @@ static K_WORK_DEFINE(rx_work, rx_work_handler);
 static struct k_work_q bt_workq;
 static K_KERNEL_STACK_DEFINE(rx_thread_stack, CONFIG_BT_RX_STACK_SIZE);
 #endif /* CONFIG_BT_RECV_WORKQ_BT */
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+/* Set while a buffer taken from rx_queue, or ACL data delivered directly
+ * from bt_recv(), is processed. Keeps processing in order.
+ */
+static atomic_t rx_busy;
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
 static struct k_thread tx_thread_data;
 static K_KERNEL_STACK_DEFINE(tx_thread_stack, CONFIG_BT_HCI_TX_STACK_SIZE);
 
@@ -492,7 +499,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			if (conn->pending_no_cb) {
 				conn->pending_no_cb--;
 				irq_unlock(key);
-				k_sem_give(bt_conn_get_pkts(conn));
+				bt_conn_give_pkt(conn);
 				continue;
 			}
 
@@ -513,7 +520,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			irq_unlock(key);
 
 			k_work_submit(&conn->tx_complete_work);
-			k_sem_give(bt_conn_get_pkts(conn));
+			bt_conn_give_pkt(conn);
 		}
 
 		bt_conn_unref(conn);
@@ -3932,10 +3939,8 @@ void hci_event_prio(struct net_buf *buf)
 	}
 }
 
-static void rx_queue_put(struct net_buf *buf)
+static void rx_work_submit(void)
 {
-	net_buf_slist_put(&bt_dev.rx_queue, buf);
-
 #if defined(CONFIG_BT_RECV_WORKQ_SYS)
 	const int err = k_work_submit(&rx_work);
 #elif defined(CONFIG_BT_RECV_WORKQ_BT)
@@ -3946,6 +3951,50 @@ static void rx_queue_put(struct net_buf *buf)
 	}
 }
 
+static void rx_queue_put(struct net_buf *buf)
+{
+	net_buf_slist_put(&bt_dev.rx_queue, buf);
+	rx_work_submit();
+}
+
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+static void rx_busy_clear(void)
+{
+	atomic_clear(&rx_busy);
+
+	/* The work handler backs off while busy, so pick up what it left */
+	if (!sys_slist_is_empty(&bt_dev.rx_queue)) {
+		rx_work_submit();
+	}
+}
+
+/* Delivers ACL data right away in the calling thread, unless it has to
+ * wait behind buffers already queued for, or being processed by, the work
+ * handler. Reassembly and the connection state are so never touched from
+ * two contexts at once.
+ */
+static bool acl_recv_direct(struct net_buf *buf)
+{
+	if (k_is_in_isr() || !atomic_cas(&rx_busy, 0, 1)) {
+		return false;
+	}
+
+	if (!sys_slist_is_empty(&bt_dev.rx_queue)) {
+		rx_busy_clear();
+		return false;
+	}
+
+	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
+
+	LOG_DBG("buf %p len %u", buf, buf->len);
+
+	hci_acl(buf);
+	rx_busy_clear();
+
+	return true;
+}
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
 static int bt_recv_unsafe(struct net_buf *buf)
 {
 	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
@@ -3989,6 +4038,15 @@ int bt_recv(struct net_buf *buf)
 {
 	int err;
 
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+	/* Outside of the scheduler lock, as L2CAP and the application's
+	 * callbacks run from here.
+	 */
+	if (bt_buf_get_type(buf) == BT_BUF_ACL_IN && acl_recv_direct(buf)) {
+		return 0;
+	}
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
 	k_sched_lock();
 	err = bt_recv_unsafe(buf);
 	k_sched_unlock();
@@ -4075,13 +4133,21 @@ static void init_work(struct k_work *work)
 
 static void rx_work_handler(struct k_work *work)
 {
-	int err;
-
 	struct net_buf *buf;
 
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+	if (!atomic_cas(&rx_busy, 0, 1)) {
+		/* Resubmitted once the direct delivery is done */
+		return;
+	}
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
 	LOG_DBG("Getting net_buf from queue");
 	buf = net_buf_slist_get(&bt_dev.rx_queue);
 	if (!buf) {
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+		atomic_clear(&rx_busy);
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
 		return;
 	}
 
@@ -4107,21 +4173,17 @@ static void rx_work_handler(struct k_work *work)
 		break;
 	}
 
+#if defined(CONFIG_BT_RECV_ACL_DIRECT)
+	atomic_clear(&rx_busy);
+#endif /* CONFIG_BT_RECV_ACL_DIRECT */
+
 	/* Schedule the work handler to be executed again if there are
 	 * additional items in the queue. This allows for other users of the
 	 * work queue to get a chance at running, which wouldn't be possible if
 	 * we used a while() loop with a k_yield() statement.
 	 */
 	if (!sys_slist_is_empty(&bt_dev.rx_queue)) {
-
-#if defined(CONFIG_BT_RECV_WORKQ_SYS)
-		err = k_work_submit(&rx_work);
-#elif defined(CONFIG_BT_RECV_WORKQ_BT)
-		err = k_work_submit_to_queue(&bt_workq, &rx_work);
-#endif
-		if (err < 0) {
-			LOG_ERR("Could not submit rx_work: %d", err);
-		}
+		rx_work_submit();
 	}
 }
 
@@ -3,6 +3,7 @@
 /*
  * Copyright (c) 2020 Intel Corporation
  * Copyright (c) 2021 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -81,6 +82,10 @@ static struct bt_iso_big *lookup_big_by_handle(uint8_t big_handle);
 #endif /* CONFIG_BT_ISO_BROADCAST */
 
 #if defined(CONFIG_BT_ISO_TX)
+#if defined(CONFIG_BT_ISO_TX_SCHED)
+static void iso_tx_sched_sent(struct bt_iso_tx_sched *sched);
+#endif /* CONFIG_BT_ISO_TX_SCHED */
+
 static void bt_iso_send_cb(struct bt_conn *iso, void *user_data, int err)
 {
 	struct bt_iso_chan *chan = iso->iso.chan;
@@ -88,6 +93,12 @@ static void bt_iso_send_cb(struct bt_conn *iso, void *user_data, int err)
 
 	__ASSERT(chan != NULL, "NULL chan for iso %p", iso);
 
+#if defined(CONFIG_BT_ISO_TX_SCHED)
+	if (chan->tx_sched != NULL) {
+		iso_tx_sched_sent(chan->tx_sched);
+	}
+#endif /* CONFIG_BT_ISO_TX_SCHED */
+
 	ops = chan->ops;
 
 	if (!err && ops != NULL && ops->sent != NULL) {
@@ -416,6 +427,12 @@ static void bt_iso_chan_disconnected(struct bt_iso_chan *chan, uint8_t reason)
 
 	__ASSERT(chan->iso != NULL, "NULL conn for iso chan %p", chan);
 
+#if defined(CONFIG_BT_ISO_TX_SCHED)
+	if (chan->tx_sched != NULL) {
+		bt_iso_tx_sched_stop(chan->tx_sched);
+	}
+#endif /* CONFIG_BT_ISO_TX_SCHED */
+
 	bt_iso_chan_set_state(chan, BT_ISO_STATE_DISCONNECTED);
 
 	/* The peripheral does not have the concept of a CIG, so once a CIS
@@ -955,6 +972,231 @@ int bt_iso_chan_get_tx_sync(const struct bt_iso_chan *chan, struct bt_iso_tx_inf
 
 	return 0;
 }
+
+#if defined(CONFIG_BT_ISO_TX_SCHED)
+/* Must be called with the scheduler lock held */
+static int iso_tx_sched_submit(struct bt_iso_tx_sched *sched, struct net_buf *buf)
+{
+	int err;
+
+	if (sched->synced) {
+		uint16_t sdus = sched->seq_num - sched->sync_seq_num;
+		uint32_t ts = sched->sync_ts + sdus * sched->sdu_interval;
+
+		err = bt_iso_chan_send_ts(sched->chan, buf, sched->seq_num, ts);
+	} else {
+		err = bt_iso_chan_send(sched->chan, buf, sched->seq_num);
+	}
+
+	if (err == 0) {
+		sched->seq_num++;
+		sched->in_flight++;
+		sched->stats.sent++;
+	}
+
+	return err;
+}
+
+static void iso_tx_sched_sent(struct bt_iso_tx_sched *sched)
+{
+	struct net_buf *buf;
+	int err;
+
+	k_mutex_lock(&sched->lock, K_FOREVER);
+
+	if (sched->chan == NULL) {
+		k_mutex_unlock(&sched->lock);
+		return;
+	}
+
+	/* SDUs may also have been sent before starting the scheduler */
+	if (sched->in_flight > 0U) {
+		sched->in_flight--;
+	}
+
+	while (sched->in_flight < sched->depth) {
+		buf = net_buf_slist_get(&sched->queue);
+		if (buf == NULL) {
+			break;
+		}
+
+		sched->queued--;
+
+		err = iso_tx_sched_submit(sched, buf);
+		if (err != 0) {
+			LOG_WRN("Dropping SDU of chan %p: %d", sched->chan, err);
+			net_buf_unref(buf);
+		}
+	}
+
+	if (sched->in_flight == 0U) {
+		BT_ISO_DATA_DBG("chan %p underrun", sched->chan);
+		sched->stats.underruns++;
+		/* The SDU intervals skipped are unknown */
+		sched->synced = false;
+	}
+
+	k_mutex_unlock(&sched->lock);
+}
+
+/* Must be called with the scheduler lock held */
+static int iso_tx_sched_put(struct bt_iso_tx_sched *sched, struct net_buf *buf)
+{
+	if (sched->in_flight < sched->depth && sched->queued == 0U) {
+		return iso_tx_sched_submit(sched, buf);
+	}
+
+	if (sched->queued == CONFIG_BT_ISO_TX_SCHED_QUEUE_SIZE) {
+		BT_ISO_DATA_DBG("chan %p overrun", sched->chan);
+		net_buf_unref(net_buf_slist_get(&sched->queue));
+		sched->queued--;
+		sched->stats.overruns++;
+	}
+
+	net_buf_slist_put(&sched->queue, buf);
+	sched->queued++;
+
+	return 0;
+}
+
+int bt_iso_tx_sched_start(struct bt_iso_tx_sched *sched, struct bt_iso_chan *chan,
+			  uint32_t sdu_interval, uint8_t depth)
+{
+	CHECKIF(sched == NULL || chan == NULL) {
+		LOG_DBG("Invalid parameters: sched %p chan %p", sched, chan);
+		return -EINVAL;
+	}
+
+	CHECKIF(sdu_interval == 0U || depth == 0U) {
+		LOG_DBG("Invalid sdu_interval %u or depth %u", sdu_interval, depth);
+		return -EINVAL;
+	}
+
+	if (chan->state != BT_ISO_STATE_CONNECTED) {
+		LOG_DBG("Channel %p not connected", chan);
+		return -ENOTCONN;
+	}
+
+	if (chan->tx_sched != NULL) {
+		return -EALREADY;
+	}
+
+	(void)memset(sched, 0, sizeof(*sched));
+	k_mutex_init(&sched->lock);
+	sys_slist_init(&sched->queue);
+	sched->sdu_interval = sdu_interval;
+	sched->depth = depth;
+	sched->chan = chan;
+
+	chan->tx_sched = sched;
+
+	return 0;
+}
+
+void bt_iso_tx_sched_stop(struct bt_iso_tx_sched *sched)
+{
+	struct net_buf *buf;
+
+	CHECKIF(sched == NULL) {
+		LOG_DBG("sched is NULL");
+		return;
+	}
+
+	k_mutex_lock(&sched->lock, K_FOREVER);
+
+	if (sched->chan != NULL) {
+		sched->chan->tx_sched = NULL;
+		sched->chan = NULL;
+	}
+
+	while ((buf = net_buf_slist_get(&sched->queue)) != NULL) {
+		net_buf_unref(buf);
+	}
+
+	sched->queued = 0U;
+
+	k_mutex_unlock(&sched->lock);
+}
+
+int bt_iso_tx_sched_sync(struct bt_iso_tx_sched *sched)
+{
+	struct bt_iso_tx_info info;
+	struct bt_iso_chan *chan;
+	int err;
+
+	CHECKIF(sched == NULL) {
+		LOG_DBG("sched is NULL");
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sched->lock, K_FOREVER);
+	chan = sched->chan;
+	k_mutex_unlock(&sched->lock);
+
+	if (chan == NULL) {
+		return -ENOTCONN;
+	}
+
+	/* Not holding the lock while waiting for the controller, which may
+	 * need the context calling the sent callback to respond.
+	 */
+	err = bt_iso_chan_get_tx_sync(chan, &info);
+	if (err != 0) {
+		return err;
+	}
+
+	k_mutex_lock(&sched->lock, K_FOREVER);
+
+	if (sched->chan == chan) {
+		sched->sync_ts = info.ts;
+		sched->sync_seq_num = info.seq_num;
+		sched->synced = true;
+	}
+
+	k_mutex_unlock(&sched->lock);
+
+	return 0;
+}
+
+int bt_iso_tx_sched_send(struct bt_iso_tx_sched *sched, struct net_buf *buf)
+{
+	int err;
+
+	CHECKIF(sched == NULL || buf == NULL) {
+		LOG_DBG("Invalid parameters: sched %p buf %p", sched, buf);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sched->lock, K_FOREVER);
+
+	if (sched->chan == NULL) {
+		err = -ENOTCONN;
+	} else {
+		/* Queued SDUs are sent with a timestamp once synced */
+		err = validate_send(sched->chan, buf, BT_HCI_ISO_SDU_TS_HDR_SIZE);
+		if (err == 0) {
+			err = iso_tx_sched_put(sched, buf);
+		}
+	}
+
+	k_mutex_unlock(&sched->lock);
+
+	return err;
+}
+
+void bt_iso_tx_sched_stats_get(struct bt_iso_tx_sched *sched,
+			       struct bt_iso_tx_sched_stats *stats)
+{
+	CHECKIF(sched == NULL || stats == NULL) {
+		LOG_DBG("Invalid parameters: sched %p stats %p", sched, stats);
+		return;
+	}
+
+	k_mutex_lock(&sched->lock, K_FOREVER);
+	*stats = sched->stats;
+	k_mutex_unlock(&sched->lock);
+}
+#endif /* CONFIG_BT_ISO_TX_SCHED */
 #endif /* CONFIG_BT_ISO_TX */
 
 #if defined(CONFIG_BT_ISO_UNICAST)
@@ -77,6 +77,114 @@ static void l2cap_tx_buf_destroy(struct bt_conn *conn, struct net_buf *buf, int
 {
 	net_buf_unref(buf);
 }
+
+#if defined(CONFIG_BT_L2CAP_SEG_IN_PLACE)
+/* Segments sent in place, referencing the data of the SDU buffer */
+struct l2cap_seg_view {
+	/* Channel sending the segment, NULL once destroyed */
+	struct bt_l2cap_le_chan *chan;
+	/* SDU buffer the segment data belongs to */
+	struct net_buf *sdu;
+};
+
+static struct l2cap_seg_view seg_views[CONFIG_BT_L2CAP_SEG_IN_PLACE_COUNT];
+
+static void seg_view_destroy(struct net_buf *buf)
+{
+	struct l2cap_seg_view *view = &seg_views[net_buf_id(buf)];
+	struct bt_l2cap_le_chan *chan;
+	struct net_buf *sdu;
+	unsigned int key;
+
+	key = irq_lock();
+	chan = view->chan;
+	sdu = view->sdu;
+	view->chan = NULL;
+	view->sdu = NULL;
+	irq_unlock(key);
+
+	net_buf_destroy(buf);
+
+	/* The bytes in front of the remaining data are free for headers again */
+	net_buf_unref(sdu);
+	if (chan) {
+		k_work_reschedule(&chan->tx_work, K_NO_WAIT);
+	}
+}
+
+NET_BUF_POOL_DEFINE(seg_view_pool, CONFIG_BT_L2CAP_SEG_IN_PLACE_COUNT, 0,
+		    CONFIG_BT_CONN_TX_USER_DATA_SIZE, seg_view_destroy);
+
+static bool l2cap_seg_view_pending(struct bt_l2cap_le_chan *chan)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(seg_views); i++) {
+		if (seg_views[i].chan == chan && seg_views[i].sdu) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void l2cap_seg_view_detach(struct bt_l2cap_le_chan *chan)
+{
+	unsigned int key = irq_lock();
+
+	for (size_t i = 0; i < ARRAY_SIZE(seg_views); i++) {
+		if (seg_views[i].chan == chan) {
+			seg_views[i].chan = NULL;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+/* Take the next segment of `buf` without copying it. The L2CAP and lower layer
+ * headers go over the bytes in front of it, which are either the headroom of
+ * the SDU or the tail of the previous segment that has been released already.
+ */
+static struct net_buf *l2cap_seg_view_alloc(struct bt_l2cap_le_chan *chan, struct net_buf *buf,
+					    uint16_t len)
+{
+	struct net_buf *seg;
+
+	/* Keep the last segment in the SDU buffer itself */
+	if (buf->len <= len || net_buf_headroom(buf) < BT_L2CAP_BUF_SIZE(0)) {
+		return NULL;
+	}
+
+	seg = net_buf_alloc_with_data(&seg_view_pool, buf->data - BT_L2CAP_BUF_SIZE(0),
+				      BT_L2CAP_BUF_SIZE(0) + len, K_NO_WAIT);
+	if (!seg) {
+		return NULL;
+	}
+
+	/* Headroom for the L2CAP header and the lower layers */
+	net_buf_pull(seg, BT_L2CAP_BUF_SIZE(0));
+
+	seg_views[net_buf_id(seg)].chan = chan;
+	seg_views[net_buf_id(seg)].sdu = net_buf_ref(buf);
+
+	net_buf_pull(buf, len);
+
+	return seg;
+}
+#else
+static inline bool l2cap_seg_view_pending(struct bt_l2cap_le_chan *chan)
+{
+	return false;
+}
+
+static inline void l2cap_seg_view_detach(struct bt_l2cap_le_chan *chan)
+{
+}
+
+static inline struct net_buf *l2cap_seg_view_alloc(struct bt_l2cap_le_chan *chan,
+						   struct net_buf *buf, uint16_t len)
+{
+	return NULL;
+}
+#endif /* CONFIG_BT_L2CAP_SEG_IN_PLACE */
 #endif /* CONFIG_BT_L2CAP_DYNAMIC_CHANNEL */
 
 /* L2CAP signalling channel specific context */
@@ -1002,6 +1110,9 @@ static void l2cap_chan_destroy(struct bt_l2cap_chan *chan)
 		k_work_cancel_delayable(&le_chan->rtx_work);
 	}
 
+	/* Segments still in flight keep their SDU until they are released */
+	l2cap_seg_view_detach(le_chan);
+
 	if (le_chan->tx_buf) {
 		l2cap_tx_buf_destroy(chan->conn, le_chan->tx_buf, -ESHUTDOWN);
 		le_chan->tx_buf = NULL;
@@ -1934,6 +2045,12 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 	int len, err;
 	bt_conn_tx_cb_t cb;
 
+	/* The headers of the next segment go over the one sent in place */
+	if (l2cap_seg_view_pending(ch)) {
+		LOG_DBG("waiting for segment of %p to be released", buf);
+		return -EAGAIN;
+	}
+
 	if (!test_and_dec(&ch->tx.credits)) {
 		LOG_DBG("No credits to transmit packet");
 		return -EAGAIN;
@@ -1948,6 +2065,10 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 		/* move `buf` to `seg`. `buf` now borrows `seg`. */
 		seg = buf;
 
+		len = seg->len;
+	} else if ((seg = l2cap_seg_view_alloc(ch, buf, ch->tx.mps)) != NULL) {
+		LOG_DBG("sending segment of %p in place", buf);
+
 		len = seg->len;
 	} else {
 		LOG_DBG("allocating segment for %p (%u bytes left)", buf, buf->len);
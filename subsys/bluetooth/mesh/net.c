@@ -78,6 +78,14 @@ static struct {
 } msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+/* Hash buckets over msg_cache. Entries are chained by index + 1, so that
+ * zero ends a chain and the zero initialized arrays are empty.
+ */
+static uint16_t msg_cache_hash[CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE];
+static uint16_t msg_cache_chain[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+#endif
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -137,10 +145,54 @@ static bool check_dup(struct net_buf_simple *data)
 	return false;
 }
 
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+static uint16_t *msg_cache_bucket(uint16_t src, uint32_t seq)
+{
+	uint32_t hash = ((uint32_t)src * 31U) + seq;
+
+	return &msg_cache_hash[hash % ARRAY_SIZE(msg_cache_hash)];
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+	uint16_t *next = msg_cache_bucket(msg_cache[idx].src,
+					  msg_cache[idx].seq);
+
+	while (*next && *next != idx + 1U) {
+		next = &msg_cache_chain[*next - 1U];
+	}
+
+	if (*next) {
+		*next = msg_cache_chain[idx];
+	}
+}
+
+static void msg_cache_link(uint16_t idx)
+{
+	uint16_t *head = msg_cache_bucket(msg_cache[idx].src,
+					  msg_cache[idx].seq);
+
+	msg_cache_chain[idx] = *head;
+	*head = idx + 1U;
+}
+#endif
+
 static bool msg_cache_match(struct net_buf_simple *pdu)
 {
 	uint16_t i;
 
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
+
+	for (i = *msg_cache_bucket(src & BIT_MASK(15), seq); i;
+	     i = msg_cache_chain[i - 1U]) {
+		if (msg_cache[i - 1U].src == src &&
+		    msg_cache[i - 1U].seq == seq) {
+			return true;
+		}
+	}
+#else
 	for (i = msg_cache_next; i > 0U;) {
 		if (msg_cache[--i].src == SRC(pdu->data) &&
 		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
@@ -154,6 +206,7 @@ static bool msg_cache_match(struct net_buf_simple *pdu)
 			return true;
 		}
 	}
+#endif
 
 	return false;
 }
@@ -161,11 +214,34 @@ static bool msg_cache_match(struct net_buf_simple *pdu)
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+	/* Evict the oldest entry */
+	msg_cache_unlink(msg_cache_next);
+#endif
+
 	msg_cache[msg_cache_next].src = rx->ctx.addr;
 	msg_cache[msg_cache_next].seq = rx->seq;
+
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+	msg_cache_link(msg_cache_next);
+#endif
+
 	msg_cache_next++;
 }
 
+static void msg_cache_remove_last(void)
+{
+	/* Rewind the next index now that we're not using this entry */
+	msg_cache_next--;
+
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+	msg_cache_unlink(msg_cache_next);
+#endif
+
+	msg_cache[msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
+}
+
 static void store_iv(bool only_duration)
 {
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_IV_PENDING);
@@ -209,6 +285,9 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const struct bt_mesh_key *ke
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
 	msg_cache_next = 0U;
+#if CONFIG_BT_MESH_MSG_CACHE_HASH_SIZE > 0
+	(void)memset(msg_cache_hash, 0, sizeof(msg_cache_hash));
+#endif
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -647,6 +726,11 @@ static bool net_decrypt(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 
 	if (rx->net_if == BT_MESH_NET_IF_ADV && msg_cache_match(out)) {
 		LOG_DBG("Duplicate found in Network Message Cache");
+
+		if (IS_ENABLED(CONFIG_BT_MESH_STATISTIC)) {
+			bt_mesh_stat_msg_cache_hit();
+		}
+
 		return false;
 	}
 
@@ -681,15 +765,25 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 	struct bt_mesh_adv *adv;
 	uint8_t transmit;
 
+	bool to_proxy;
+	bool to_adv;
+
 	if (rx->ctx.recv_ttl <= 1U) {
 		return;
 	}
 
-	if (rx->net_if == BT_MESH_NET_IF_ADV &&
-	    !rx->friend_cred &&
-	    bt_mesh_relay_get() != BT_MESH_RELAY_ENABLED &&
-	    bt_mesh_gatt_proxy_get() != BT_MESH_GATT_PROXY_ENABLED &&
-	    bt_mesh_priv_gatt_proxy_get() != BT_MESH_PRIV_GATT_PROXY_ENABLED) {
+	/* When the Friend node relays message for lpn, the message will be
+	 * retransmitted using the managed flooding security credentials and
+	 * the Network PDU shall be retransmitted to all network interfaces.
+	 */
+	to_proxy = IS_ENABLED(CONFIG_BT_MESH_GATT_PROXY) &&
+		   (rx->friend_cred ||
+		    bt_mesh_gatt_proxy_get() == BT_MESH_GATT_PROXY_ENABLED ||
+		    bt_mesh_priv_gatt_proxy_get() == BT_MESH_PRIV_GATT_PROXY_ENABLED);
+	to_adv = relay_to_adv(rx->net_if) || rx->friend_cred;
+
+	/* Don't re-encrypt a packet that goes nowhere */
+	if (!to_proxy && !to_adv) {
 		return;
 	}
 
@@ -712,12 +806,12 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		return;
 	}
 
-	/* Leave CTL bit intact */
-	sbuf->data[1] &= 0x80;
-	sbuf->data[1] |= rx->ctx.recv_ttl - 1U;
-
 	net_buf_simple_add_mem(&adv->b, sbuf->data, sbuf->len);
 
+	/* Leave CTL bit intact */
+	adv->b.data[1] &= 0x80;
+	adv->b.data[1] |= rx->ctx.recv_ttl - 1U;
+
 	cred = &rx->sub->keys[SUBNET_KEY_TX_IDX(rx->sub)].msg;
 
 	LOG_DBG("Relaying packet. TTL is now %u", TTL(adv->b.data));
@@ -737,18 +831,11 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		goto done;
 	}
 
-	/* When the Friend node relays message for lpn, the message will be
-	 * retransmitted using the managed flooding security credentials and
-	 * the Network PDU shall be retransmitted to all network interfaces.
-	 */
-	if (IS_ENABLED(CONFIG_BT_MESH_GATT_PROXY) &&
-	    (rx->friend_cred ||
-	     bt_mesh_gatt_proxy_get() == BT_MESH_GATT_PROXY_ENABLED ||
-	     bt_mesh_priv_gatt_proxy_get() == BT_MESH_PRIV_GATT_PROXY_ENABLED)) {
+	if (to_proxy) {
 		bt_mesh_proxy_relay(adv, rx->ctx.recv_dst);
 	}
 
-	if (relay_to_adv(rx->net_if) || rx->friend_cred) {
+	if (to_adv) {
 		bt_mesh_adv_send(adv, NULL, NULL);
 	}
 
@@ -832,6 +919,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_NET_MAX_PDU_LEN);
 	struct bt_mesh_net_rx rx = { .ctx.recv_rssi = rssi };
 	struct net_buf_simple_state state;
+	bool relayed;
 	int err;
 
 	LOG_DBG("rssi %d net_if %u", rssi, net_if);
@@ -866,6 +954,20 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 		}
 	}
 
+	/* The transport layer has no say in relaying an access message for
+	 * neither a local element nor an LPN we're Friends for, so relay it
+	 * before local processing.
+	 */
+	relayed = (!rx.ctl && BT_MESH_ADDR_IS_UNICAST(rx.ctx.recv_dst) &&
+		   !rx.local_match &&
+		   !(IS_ENABLED(CONFIG_BT_MESH_FRIEND) &&
+		     bt_mesh_friend_match(rx.sub->net_idx, rx.ctx.recv_dst)) &&
+		   !(IS_ENABLED(CONFIG_BT_MESH_LOW_POWER) &&
+		     bt_mesh_lpn_established()));
+	if (relayed) {
+		bt_mesh_net_relay(&buf, &rx);
+	}
+
 	err = bt_mesh_trans_recv(&buf, &rx);
 	if (err == -EAGAIN) {
 		/* The transport layer has indicated that it has rejected the message,
@@ -876,8 +978,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 		 * it again in the future.
 		 */
 		LOG_WRN("Removing rejected message from Network Message Cache");
-		/* Rewind the next index now that we're not using this entry */
-		msg_cache[--msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
+		msg_cache_remove_last();
 		dup_cache[--dup_cache_next] = 0;
 		return;
 	} else if (err == -EBADMSG) {
@@ -888,8 +989,8 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	/* Relay if this was a group/virtual address, or if the destination
 	 * was neither a local element nor an LPN we're Friends for.
 	 */
-	if (!BT_MESH_ADDR_IS_UNICAST(rx.ctx.recv_dst) ||
-	    (!rx.local_match && !rx.friend_match)) {
+	if (!relayed && (!BT_MESH_ADDR_IS_UNICAST(rx.ctx.recv_dst) ||
+			 (!rx.local_match && !rx.friend_match))) {
 		net_buf_simple_restore(&buf, &state);
 		bt_mesh_net_relay(&buf, &rx);
 	}
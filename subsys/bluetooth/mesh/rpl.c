@@ -23,6 +23,7 @@
 #include "net.h"
 #include "rpl.h"
 #include "settings.h"
+#include "statistic.h"
 
 #define LOG_LEVEL CONFIG_BT_MESH_RPL_LOG_LEVEL
 #include <zephyr/logging/log.h>
@@ -49,6 +50,110 @@ static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 	return rpl - &replay_list[0];
 }
 
+#if CONFIG_BT_MESH_RPL_HASH_SIZE > 0
+/* Hash buckets over replay_list, indexed by source address. Entries are
+ * chained by index + 1 so that zero ends a chain. Entries moved or removed
+ * in bulk only mark the index stale, and it is rebuilt on the next lookup.
+ */
+static uint16_t rpl_hash[CONFIG_BT_MESH_RPL_HASH_SIZE];
+static uint16_t rpl_chain[CONFIG_BT_MESH_CRPL];
+/* Index below which there is no empty slot */
+static uint16_t rpl_free;
+static bool rpl_hash_stale = true;
+
+static uint16_t *rpl_bucket(uint16_t src)
+{
+	return &rpl_hash[src % ARRAY_SIZE(rpl_hash)];
+}
+
+static void rpl_hash_link(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *head = rpl_bucket(rpl->src);
+
+	rpl_chain[rpl_idx(rpl)] = *head;
+	*head = rpl_idx(rpl) + 1U;
+}
+
+static void rpl_hash_unlink(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *next = rpl_bucket(rpl->src);
+
+	while (*next && *next != rpl_idx(rpl) + 1U) {
+		next = &rpl_chain[*next - 1U];
+	}
+
+	if (*next) {
+		*next = rpl_chain[rpl_idx(rpl)];
+	}
+}
+
+static void rpl_hash_rebuild(void)
+{
+	(void)memset(rpl_hash, 0, sizeof(rpl_hash));
+	rpl_free = ARRAY_SIZE(replay_list);
+
+	for (int i = ARRAY_SIZE(replay_list) - 1; i >= 0; i--) {
+		if (replay_list[i].src) {
+			rpl_hash_link(&replay_list[i]);
+		} else {
+			rpl_free = i;
+		}
+	}
+
+	rpl_hash_stale = false;
+}
+
+static struct bt_mesh_rpl *rpl_hash_find(uint16_t src)
+{
+	if (rpl_hash_stale) {
+		rpl_hash_rebuild();
+	}
+
+	for (uint16_t i = *rpl_bucket(src); i; i = rpl_chain[i - 1U]) {
+		if (replay_list[i - 1U].src == src) {
+			return &replay_list[i - 1U];
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_hash_empty_get(void)
+{
+	for (; rpl_free < ARRAY_SIZE(replay_list); rpl_free++) {
+		if (!replay_list[rpl_free].src) {
+			return &replay_list[rpl_free];
+		}
+	}
+
+	return NULL;
+}
+
+static void rpl_hash_src_set(struct bt_mesh_rpl *rpl, uint16_t src)
+{
+	if (rpl->src == src) {
+		return;
+	}
+
+	if (rpl->src) {
+		rpl_hash_unlink(rpl);
+	}
+
+	rpl->src = src;
+
+	if (!rpl_hash_stale) {
+		rpl_hash_link(rpl);
+	}
+}
+#endif
+
+static inline void rpl_hash_invalidate(void)
+{
+#if CONFIG_BT_MESH_RPL_HASH_SIZE > 0
+	rpl_hash_stale = true;
+#endif
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -92,7 +197,11 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
+#if CONFIG_BT_MESH_RPL_HASH_SIZE > 0
+	rpl_hash_src_set(rpl, rx->ctx.addr);
+#else
 	rpl->src = rx->ctx.addr;
+#endif
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -107,10 +216,32 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
  * by upper logic (access, transport commands) and for receiving the segmented messages.
  * If a NULL match is given the RPL is immediately updated (used for proxy configuration).
  */
+/* Check an existing RPL entry for the source of a received message. Returns
+ * true if the message is a replay.
+ */
+static bool rpl_entry_check(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
+{
+	if (!rpl->old_iv &&
+	    atomic_test_bit(rpl_flags, PENDING_RESET) &&
+	    !atomic_test_bit(store, rpl_idx(rpl))) {
+		/* Until rpl reset is finished, entry with old_iv == false and
+		 * without "store" bit set will be removed, therefore it can be
+		 * reused. If such entry is reused, "store" bit will be set and
+		 * the entry won't be removed.
+		 */
+		return false;
+	}
+
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
+
+	return !((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq);
+}
+
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
 	struct bt_mesh_rpl *rpl;
-	int i;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -122,7 +253,22 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+#if CONFIG_BT_MESH_RPL_HASH_SIZE > 0
+	rpl = rpl_hash_find(rx->ctx.addr);
+	if (!rpl) {
+		rpl = rpl_hash_empty_get();
+	}
+
+	if (rpl) {
+		/* Existing slot for given address */
+		if (rpl->src && rpl_entry_check(rpl, rx)) {
+			goto replay;
+		}
+
+		goto match;
+	}
+#else
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		rpl = &replay_list[i];
 
 		/* Empty slot */
@@ -132,31 +278,28 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 
 		/* Existing slot for given address */
 		if (rpl->src == rx->ctx.addr) {
-			if (!rpl->old_iv &&
-			    atomic_test_bit(rpl_flags, PENDING_RESET) &&
-			    !atomic_test_bit(store, i)) {
-				/* Until rpl reset is finished, entry with old_iv == false and
-				 * without "store" bit set will be removed, therefore it can be
-				 * reused. If such entry is reused, "store" bit will be set and
-				 * the entry won't be removed.
-				 */
-				goto match;
+			if (rpl_entry_check(rpl, rx)) {
+				goto replay;
 			}
 
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				goto match;
-			} else {
-				return true;
-			}
+			goto match;
 		}
 	}
+#endif
 
 	LOG_ERR("RPL is full!");
+
+	if (IS_ENABLED(CONFIG_BT_MESH_STATISTIC)) {
+		bt_mesh_stat_rpl_full();
+	}
+
+	return true;
+
+replay:
+	if (IS_ENABLED(CONFIG_BT_MESH_STATISTIC)) {
+		bt_mesh_stat_rpl_replay();
+	}
+
 	return true;
 
 match:
@@ -175,6 +318,7 @@ void bt_mesh_rpl_clear(void)
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		rpl_hash_invalidate();
 		return;
 	}
 
@@ -185,6 +329,9 @@ void bt_mesh_rpl_clear(void)
 
 static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 {
+#if CONFIG_BT_MESH_RPL_HASH_SIZE > 0
+	return rpl_hash_find(src);
+#else
 	int i;
 
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
@@ -194,6 +341,7 @@ static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 	}
 
 	return NULL;
+#endif
 }
 
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
@@ -202,7 +350,11 @@ static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (!replay_list[i].src) {
+#if CONFIG_BT_MESH_RPL_HASH_SIZE > 0
+			rpl_hash_src_set(&replay_list[i], src);
+#else
 			replay_list[i].src = src;
+#endif
 			return &replay_list[i];
 		}
 	}
@@ -261,6 +413,7 @@ void bt_mesh_rpl_reset(void)
 		}
 
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+		rpl_hash_invalidate();
 	}
 }
 
@@ -284,6 +437,7 @@ static int rpl_set(const char *name, size_t len_rd,
 		LOG_DBG("val (null)");
 		if (entry) {
 			(void)memset(entry, 0, sizeof(*entry));
+			rpl_hash_invalidate();
 		} else {
 			LOG_WRN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -403,4 +557,6 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 	if (addr == BT_MESH_ADDR_ALL_NODES) {
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
 	}
+
+	rpl_hash_invalidate();
 }
@@ -61,3 +61,18 @@ void bt_mesh_stat_rx(enum bt_mesh_net_if net_if)
 		break;
 	}
 }
+
+void bt_mesh_stat_msg_cache_hit(void)
+{
+	stat.rx_msg_cache_hit++;
+}
+
+void bt_mesh_stat_rpl_replay(void)
+{
+	stat.rx_rpl_replay++;
+}
+
+void bt_mesh_stat_rpl_full(void)
+{
+	stat.rx_rpl_full++;
+}
@@ -10,5 +10,8 @@
 void bt_mesh_stat_planned_count(struct bt_mesh_adv_ctx *ctx);
 void bt_mesh_stat_succeeded_count(struct bt_mesh_adv_ctx *ctx);
 void bt_mesh_stat_rx(enum bt_mesh_net_if net_if);
+void bt_mesh_stat_msg_cache_hit(void);
+void bt_mesh_stat_rpl_replay(void);
+void bt_mesh_stat_rpl_full(void);
 
 #endif /* ZEPHYR_SUBSYS_BLUETOOTH_MESH_STATISTIC_H_ */
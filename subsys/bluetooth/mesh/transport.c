@@ -117,6 +117,32 @@ static struct seg_rx {
 
 K_MEM_SLAB_DEFINE(segs, BT_MESH_APP_SEG_SDU_MAX, CONFIG_BT_MESH_SEG_BUFS, 4);
 
+/* Number of segment buffers that are not yet allocated, but still owed to the
+ * incoming messages in progress. Every accepted RX context gets enough buffers
+ * to complete, so parallel transfers can't starve each other halfway through.
+ */
+static uint16_t seg_rx_reserved(void)
+{
+	uint16_t reserved = 0U;
+
+	for (int i = 0; i < ARRAY_SIZE(seg_rx); i++) {
+		const struct seg_rx *rx = &seg_rx[i];
+
+		if (rx->in_use) {
+			reserved += rx->seg_n + 1 - POPCOUNT(rx->block);
+		}
+	}
+
+	return reserved;
+}
+
+static bool seg_bufs_available(uint8_t count)
+{
+	uint32_t free = k_mem_slab_num_free_get(&segs);
+
+	return free >= seg_rx_reserved() + count;
+}
+
 static int send_unseg(struct bt_mesh_net_tx *tx, struct net_buf_simple *sdu,
 		      const struct bt_mesh_send_cb *cb, void *cb_data,
 		      const uint8_t *ctl_op)
@@ -551,6 +577,12 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 		return -ENOBUFS;
 	}
 
+	if (!seg_bufs_available(tx->seg_n + 1)) {
+		LOG_ERR("Out of segment buffers");
+		seg_tx_reset(tx);
+		return -ENOBUFS;
+	}
+
 	for (seg_o = 0U; sdu->len; seg_o++) {
 		void *buf;
 		uint16_t len;
@@ -1301,7 +1333,7 @@ static struct seg_rx *seg_rx_alloc(struct bt_mesh_net_rx *net_rx,
 	/* No race condition on this check, as this function only executes in
 	 * the collaborative Bluetooth rx thread:
 	 */
-	if (k_mem_slab_num_free_get(&segs) < 1) {
+	if (!seg_bufs_available(seg_n + 1)) {
 		LOG_WRN("Not enough segments for incoming message");
 		return NULL;
 	}
@@ -7,6 +7,7 @@
 /*
  * Copyright (c) 2017 Intel Corporation
  * Copyright (c) 2018 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -4767,6 +4768,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bt_cmds,
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 	SHELL_CMD(mesh_adv, NULL, HELP_ONOFF, cmd_mesh_adv),
 #endif /* CONFIG_BT_HCI_MESH_EXT */
+#if defined(CONFIG_BT_HCI_VS)
+	SHELL_CMD_ARG(latency, NULL,
+		      "<mayfly <caller> <callee>|prepare> [reset]",
+		      cmd_latency, 2, 3),
+#endif /* CONFIG_BT_HCI_VS */
 
 #if defined(CONFIG_BT_LL_SW_SPLIT)
 	SHELL_CMD(ll-addr, NULL, "<random|public>", cmd_ll_addr_read),
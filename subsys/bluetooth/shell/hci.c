@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2017-2018 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -78,3 +79,72 @@ int cmd_mesh_adv(const struct shell *sh, size_t argc, char *argv[])
 	return err;
 }
 #endif /* CONFIG_BT_HCI_MESH_EXT */
+
+#if defined(CONFIG_BT_HCI_VS)
+int cmd_latency(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct bt_hci_cp_vs_read_latency_profile *cp;
+	struct bt_hci_rp_vs_read_latency_profile *rp;
+	struct net_buf *buf, *rsp;
+	uint8_t type, caller_id = 0U, callee_id = 0U;
+	int reset_arg;
+	int err;
+
+	if (!strcmp(argv[1], "mayfly")) {
+		if (argc < 4) {
+			return -EINVAL;
+		}
+
+		type = BT_HCI_VS_LATENCY_PROFILE_MAYFLY;
+		caller_id = strtoul(argv[2], NULL, 0);
+		callee_id = strtoul(argv[3], NULL, 0);
+		reset_arg = 4;
+	} else if (!strcmp(argv[1], "prepare")) {
+		type = BT_HCI_VS_LATENCY_PROFILE_PREPARE;
+		reset_arg = 2;
+	} else {
+		return -EINVAL;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_VS_READ_LATENCY_PROFILE, sizeof(*cp));
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->type = type;
+	cp->caller_id = caller_id;
+	cp->callee_id = callee_id;
+	cp->reset = (argc > reset_arg) && !strcmp(argv[reset_arg], "reset");
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_READ_LATENCY_PROFILE, buf,
+				   &rsp);
+	if (err) {
+		shell_error(sh, "Read latency profile failed (err %d)", err);
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+
+	/* Bucket i counts latencies below 32 << i us, the last one the rest */
+	for (uint8_t i = 0U; i < BT_HCI_VS_LATENCY_BUCKETS; i++) {
+		if (i < BT_HCI_VS_LATENCY_BUCKETS - 1) {
+			shell_print(sh, "  < %5u us: %u", 32U << i,
+				    sys_le32_to_cpu(rp->hist[i]));
+		} else {
+			shell_print(sh, " >= %5u us: %u", 32U << (i - 1),
+				    sys_le32_to_cpu(rp->hist[i]));
+		}
+	}
+
+	if (type == BT_HCI_VS_LATENCY_PROFILE_PREPARE) {
+		shell_print(sh, "late: %u", sys_le32_to_cpu(rp->late));
+	}
+
+	shell_print(sh, "slot collisions: %u", sys_le32_to_cpu(rp->collisions));
+
+	net_buf_unref(rsp);
+
+	return 0;
+}
+#endif /* CONFIG_BT_HCI_VS */
@@ -1,7 +1,9 @@
 /*
  * Copyright (c) 2017 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 int cmd_mesh_adv(const struct shell *sh, size_t argc, char *argv[]);
+int cmd_latency(const struct shell *sh, size_t argc, char *argv[]);
@@ -39,6 +39,33 @@ NET_BUF_POOL_VAR_DEFINE(isotp_tx_pool, CONFIG_ISOTP_TX_BUF_COUNT,
 			CONFIG_ISOTP_BUF_TX_DATA_POOL_SIZE, 0, NULL);
 #endif
 
+#ifdef CONFIG_ISOTP_WORKQUEUE
+K_KERNEL_STACK_DEFINE(isotp_workq_stack, CONFIG_ISOTP_WORKQUEUE_STACK_SIZE);
+static struct k_work_q isotp_workq;
+
+static int isotp_workq_init(void)
+{
+	k_work_queue_start(&isotp_workq, isotp_workq_stack,
+			   K_KERNEL_STACK_SIZEOF(isotp_workq_stack),
+			   CONFIG_ISOTP_WORKQUEUE_PRIORITY, NULL);
+	k_thread_name_set(&isotp_workq.thread, "isotp_workq");
+
+	return 0;
+}
+
+SYS_INIT(isotp_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static inline void isotp_work_submit(struct k_work *work)
+{
+	k_work_submit_to_queue(&isotp_workq, work);
+}
+#else
+static inline void isotp_work_submit(struct k_work *work)
+{
+	k_work_submit(work);
+}
+#endif /* CONFIG_ISOTP_WORKQUEUE */
+
 static void receive_state_machine(struct isotp_recv_ctx *rctx);
 
 static inline void prepare_frame(struct can_frame *frame, struct isotp_msg_id *addr)
@@ -69,7 +96,7 @@ static void receive_pool_free(struct net_buf *buf)
 
 	SYS_SLIST_FOR_EACH_NODE(&global_ctx.alloc_list, rctx_node) {
 		rctx = CONTAINER_OF(rctx_node, struct isotp_recv_ctx, alloc_node);
-		k_work_submit(&rctx->work);
+		isotp_work_submit(&rctx->work);
 	}
 }
 
@@ -82,7 +109,7 @@ static void receive_ff_sf_pool_free(struct net_buf *buf)
 
 	SYS_SLIST_FOR_EACH_NODE(&global_ctx.ff_sf_alloc_list, rctx_node) {
 		rctx = CONTAINER_OF(rctx_node, struct isotp_recv_ctx, alloc_node);
-		k_work_submit(&rctx->work);
+		isotp_work_submit(&rctx->work);
 	}
 }
 
@@ -101,7 +128,7 @@ static void receive_can_tx(const struct device *dev, int error, void *arg)
 	if (error != 0) {
 		LOG_ERR("Error sending FC frame (%d)", error);
 		receive_report_error(rctx, ISOTP_N_ERROR);
-		k_work_submit(&rctx->work);
+		isotp_work_submit(&rctx->work);
 	}
 }
 
@@ -217,7 +244,7 @@ static void receive_timeout_handler(struct k_timer *timer)
 		break;
 	}
 
-	k_work_submit(&rctx->work);
+	isotp_work_submit(&rctx->work);
 }
 
 static int receive_alloc_buffer(struct isotp_recv_ctx *rctx)
@@ -498,7 +525,7 @@ static void process_cf(struct isotp_recv_ctx *rctx, struct can_frame *frame)
 		LOG_DBG("Waiting for CF but got something else (%d)",
 			frame->data[index] >> ISOTP_PCI_TYPE_POS);
 		receive_report_error(rctx, ISOTP_N_UNEXP_PDU);
-		k_work_submit(&rctx->work);
+		isotp_work_submit(&rctx->work);
 		return;
 	}
 
@@ -507,7 +534,7 @@ static void process_cf(struct isotp_recv_ctx *rctx, struct can_frame *frame)
 	if ((frame->data[index++] & ISOTP_PCI_SN_MASK) != rctx->sn_expected++) {
 		LOG_ERR("Sequence number mismatch");
 		receive_report_error(rctx, ISOTP_N_WRONG_SN);
-		k_work_submit(&rctx->work);
+		isotp_work_submit(&rctx->work);
 		return;
 	}
 
@@ -585,7 +612,7 @@ static void receive_can_rx(const struct device *dev, struct can_frame *frame, vo
 		LOG_INF("Got a frame in a state where it is unexpected.");
 	}
 
-	k_work_submit(&rctx->work);
+	isotp_work_submit(&rctx->work);
 }
 
 static inline int add_ff_sf_filter(struct isotp_recv_ctx *rctx)
@@ -762,18 +789,16 @@ static void send_can_tx_cb(const struct device *dev, int error, void *arg)
 
 	ARG_UNUSED(dev);
 
-	sctx->tx_backlog--;
-	k_sem_give(&sctx->tx_sem);
-
-	if (sctx->state == ISOTP_TX_WAIT_BACKLOG) {
-		if (sctx->tx_backlog > 0) {
-			return;
-		}
-
-		sctx->state = ISOTP_TX_WAIT_FIN;
+	if (error != 0) {
+		LOG_ERR("Error sending frame (%d)", error);
+		send_report_error(sctx, ISOTP_N_ERROR);
 	}
 
-	k_work_submit(&sctx->work);
+	/* The state machine picks up from here: the next consecutive frame of
+	 * the window, the STmin timer or the end of the transfer.
+	 */
+	atomic_dec(&sctx->tx_backlog);
+	isotp_work_submit(&sctx->work);
 }
 
 static void send_timeout_handler(struct k_timer *timer)
@@ -785,7 +810,7 @@ static void send_timeout_handler(struct k_timer *timer)
 		LOG_ERR("Reception of next FC has timed out");
 	}
 
-	k_work_submit(&sctx->work);
+	isotp_work_submit(&sctx->work);
 }
 
 static void send_process_fc(struct isotp_send_ctx *sctx, struct can_frame *frame)
@@ -817,8 +842,6 @@ static void send_process_fc(struct isotp_send_ctx *sctx, struct can_frame *frame
 	case ISOTP_PCI_FS_CTS:
 		sctx->state = ISOTP_TX_SEND_CF;
 		sctx->wft = 0;
-		sctx->tx_backlog = 0;
-		k_sem_reset(&sctx->tx_sem);
 		sctx->opts.bs = *data++;
 		sctx->opts.stmin = *data++;
 		sctx->bs = sctx->opts.bs;
@@ -865,7 +888,7 @@ static void send_can_rx_cb(const struct device *dev, struct can_frame *frame, vo
 		send_report_error(sctx, ISOTP_N_UNEXP_PDU);
 	}
 
-	k_work_submit(&sctx->work);
+	isotp_work_submit(&sctx->work);
 }
 
 static size_t get_send_ctx_data_len(struct isotp_send_ctx *sctx)
@@ -873,38 +896,66 @@ static size_t get_send_ctx_data_len(struct isotp_send_ctx *sctx)
 	return sctx->is_net_buf ? net_buf_frags_len(sctx->buf) : sctx->len;
 }
 
-static const uint8_t *get_send_ctx_data(struct isotp_send_ctx *sctx)
+/*
+ * Copy the next len bytes into the frame. A net_buf is read in place,
+ * fragment by fragment, so chains are sent without linearizing them first.
+ */
+static void peek_send_ctx_data(struct isotp_send_ctx *sctx, uint8_t *dst, size_t len)
 {
 	if (sctx->is_net_buf) {
-		return sctx->buf->data;
+		net_buf_linearize(dst, len, sctx->buf, 0, len);
 	} else {
-		return sctx->data;
+		memcpy(dst, sctx->data, len);
 	}
 }
 
+/*
+ * Fragments are released as soon as they are sent
+ */
 static void pull_send_ctx_data(struct isotp_send_ctx *sctx, size_t len)
 {
+	size_t frag_len;
+
 	if (sctx->is_net_buf) {
-		net_buf_pull_mem(sctx->buf, len);
+		while (sctx->buf != NULL && len > 0) {
+			frag_len = MIN(len, sctx->buf->len);
+			net_buf_pull_mem(sctx->buf, frag_len);
+			len -= frag_len;
+
+			if (sctx->buf->len == 0U) {
+				sctx->buf = net_buf_frag_del(NULL, sctx->buf);
+			}
+		}
 	} else {
 		sctx->data += len;
 		sctx->len -= len;
 	}
 }
 
+static int send_frame(struct isotp_send_ctx *sctx, const struct can_frame *frame)
+{
+	int ret;
+
+	/* Count the frame before the driver can complete it */
+	atomic_inc(&sctx->tx_backlog);
+
+	ret = can_send(sctx->can_dev, frame, K_MSEC(ISOTP_A_TIMEOUT_MS), send_can_tx_cb, sctx);
+	if (ret != 0) {
+		atomic_dec(&sctx->tx_backlog);
+	}
+
+	return ret;
+}
+
 static inline int send_sf(struct isotp_send_ctx *sctx)
 {
 	struct can_frame frame;
 	size_t len = get_send_ctx_data_len(sctx);
 	int index = 0;
 	int ret;
-	const uint8_t *data;
 
 	prepare_frame(&frame, &sctx->tx_addr);
 
-	data = get_send_ctx_data(sctx);
-	pull_send_ctx_data(sctx, len);
-
 	if ((sctx->tx_addr.flags & ISOTP_MSG_EXT_ADDR) != 0) {
 		frame.data[index++] = sctx->tx_addr.ext_addr;
 	}
@@ -922,7 +973,8 @@ static inline int send_sf(struct isotp_send_ctx *sctx)
 		return -ENOSPC;
 	}
 
-	memcpy(&frame.data[index], data, len);
+	peek_send_ctx_data(sctx, &frame.data[index], len);
+	pull_send_ctx_data(sctx, len);
 
 	if (IS_ENABLED(CONFIG_ISOTP_ENABLE_TX_PADDING) ||
 	    (IS_ENABLED(CONFIG_CAN_FD_MODE) && (sctx->tx_addr.flags & ISOTP_MSG_FDF) != 0 &&
@@ -939,7 +991,7 @@ static inline int send_sf(struct isotp_send_ctx *sctx)
 	}
 
 	sctx->state = ISOTP_TX_SEND_SF;
-	ret = can_send(sctx->can_dev, &frame, K_MSEC(ISOTP_A_TIMEOUT_MS), send_can_tx_cb, sctx);
+	ret = send_frame(sctx, &frame);
 	return ret;
 }
 
@@ -949,7 +1001,6 @@ static inline int send_ff(struct isotp_send_ctx *sctx)
 	int index = 0;
 	size_t len = get_send_ctx_data_len(sctx);
 	int ret;
-	const uint8_t *data;
 
 	prepare_frame(&frame, &sctx->tx_addr);
 
@@ -975,11 +1026,10 @@ static inline int send_ff(struct isotp_send_ctx *sctx)
 	 * although it's not part of the FF frame
 	 */
 	sctx->sn = 1;
-	data = get_send_ctx_data(sctx);
+	peek_send_ctx_data(sctx, &frame.data[index], sctx->tx_addr.dl - index);
 	pull_send_ctx_data(sctx, sctx->tx_addr.dl - index);
-	memcpy(&frame.data[index], data, sctx->tx_addr.dl - index);
 
-	ret = can_send(sctx->can_dev, &frame, K_MSEC(ISOTP_A_TIMEOUT_MS), send_can_tx_cb, sctx);
+	ret = send_frame(sctx, &frame);
 	return ret;
 }
 
@@ -990,7 +1040,6 @@ static inline int send_cf(struct isotp_send_ctx *sctx)
 	int ret;
 	int len;
 	int rem_len;
-	const uint8_t *data;
 
 	prepare_frame(&frame, &sctx->tx_addr);
 
@@ -1004,8 +1053,7 @@ static inline int send_cf(struct isotp_send_ctx *sctx)
 	rem_len = get_send_ctx_data_len(sctx);
 	len = MIN(rem_len, sctx->tx_addr.dl - index);
 	rem_len -= len;
-	data = get_send_ctx_data(sctx);
-	memcpy(&frame.data[index], data, len);
+	peek_send_ctx_data(sctx, &frame.data[index], len);
 
 	if (IS_ENABLED(CONFIG_ISOTP_ENABLE_TX_PADDING) ||
 	    (IS_ENABLED(CONFIG_CAN_FD_MODE) && (sctx->tx_addr.flags & ISOTP_MSG_FDF) != 0 &&
@@ -1021,12 +1069,11 @@ static inline int send_cf(struct isotp_send_ctx *sctx)
 		frame.dlc = can_bytes_to_dlc(len + index);
 	}
 
-	ret = can_send(sctx->can_dev, &frame, K_MSEC(ISOTP_A_TIMEOUT_MS), send_can_tx_cb, sctx);
+	ret = send_frame(sctx, &frame);
 	if (ret == 0) {
 		sctx->sn++;
 		pull_send_ctx_data(sctx, len);
 		sctx->bs--;
-		sctx->tx_backlog++;
 	}
 
 	ret = ret ? ret : rem_len;
@@ -1036,7 +1083,7 @@ static inline int send_cf(struct isotp_send_ctx *sctx)
 #ifdef CONFIG_ISOTP_ENABLE_CONTEXT_BUFFERS
 static inline void free_send_ctx(struct isotp_send_ctx **sctx)
 {
-	if ((*sctx)->is_net_buf) {
+	if ((*sctx)->is_net_buf && (*sctx)->buf != NULL) {
 		net_buf_unref((*sctx)->buf);
 		(*sctx)->buf = NULL;
 	}
@@ -1095,6 +1142,11 @@ static void send_state_machine(struct isotp_send_ctx *sctx)
 		LOG_DBG("SM send CF");
 		k_timer_stop(&sctx->timer);
 		do {
+			/* Resumed from the TX complete callback */
+			if (atomic_get(&sctx->tx_backlog) >= CONFIG_ISOTP_TX_CF_WINDOW) {
+				break;
+			}
+
 			ret = send_cf(sctx);
 			if (!ret) {
 				sctx->state = ISOTP_TX_WAIT_BACKLOG;
@@ -1106,6 +1158,7 @@ static void send_state_machine(struct isotp_send_ctx *sctx)
 				send_report_error(sctx, ret == -EAGAIN ?
 						ISOTP_N_TIMEOUT_A :
 						ISOTP_N_ERROR);
+				isotp_work_submit(&sctx->work);
 				break;
 			}
 
@@ -1118,14 +1171,16 @@ static void send_state_machine(struct isotp_send_ctx *sctx)
 				sctx->state = ISOTP_TX_WAIT_ST;
 				break;
 			}
-
-			/* Ensure FIFO style transmission of CF */
-			k_sem_take(&sctx->tx_sem, K_FOREVER);
 		} while (ret > 0);
 
 		break;
 
 	case ISOTP_TX_WAIT_ST:
+		/* STmin starts when the previous CF has left the controller */
+		if (atomic_get(&sctx->tx_backlog) > 0) {
+			break;
+		}
+
 		k_timer_start(&sctx->timer, stmin_to_timeout(sctx->opts.stmin), K_NO_WAIT);
 		sctx->state = ISOTP_TX_SEND_CF;
 		LOG_DBG("SM wait ST");
@@ -1136,13 +1191,24 @@ static void send_state_machine(struct isotp_send_ctx *sctx)
 		__fallthrough;
 	case ISOTP_TX_SEND_SF:
 		__fallthrough;
+	case ISOTP_TX_WAIT_BACKLOG:
+		__fallthrough;
 	case ISOTP_TX_WAIT_FIN:
+		/* The last TX complete callback resumes here, the context
+		 * must not be released with frames still queued.
+		 */
+		if (atomic_get(&sctx->tx_backlog) > 0) {
+			break;
+		}
+
 		if (sctx->filter_id >= 0) {
 			can_remove_rx_filter(sctx->can_dev, sctx->filter_id);
 		}
 
 		LOG_DBG("SM finish");
 		k_timer_stop(&sctx->timer);
+		/* Drop a run queued by a late TX complete callback */
+		k_work_cancel(&sctx->work);
 
 		if (sctx->has_callback) {
 			sctx->fin_cb.cb(sctx->error_nr, sctx->fin_cb.arg);
@@ -1219,7 +1285,7 @@ static int send(struct isotp_send_ctx *sctx, const struct device *can_dev,
 		sctx->has_callback = 0;
 	}
 
-	k_sem_init(&sctx->tx_sem, 0, 1);
+	atomic_clear(&sctx->tx_backlog);
 	sctx->can_dev = can_dev;
 	sctx->tx_addr = *tx_addr;
 	sctx->rx_addr = *rx_addr;
@@ -1270,7 +1336,7 @@ static int send(struct isotp_send_ctx *sctx, const struct device *can_dev,
 
 		LOG_DBG("Starting work to send FF");
 		sctx->state = ISOTP_TX_SEND_FF;
-		k_work_submit(&sctx->work);
+		isotp_work_submit(&sctx->work);
 	} else {
 		LOG_DBG("Sending single frame");
 		sctx->filter_id = -1;
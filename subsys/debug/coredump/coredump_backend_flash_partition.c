@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2020 Intel Corporation.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -48,6 +49,9 @@ LOG_MODULE_REGISTER(coredump, CONFIG_KERNEL_LOG_LEVEL);
 
 #define HDR_VER			1
 
+/* Set in the header flags when the dump did not fit in the partition */
+#define HDR_FLAG_TRUNCATED	BIT(0)
+
 #define FLASH_BACKEND_SEM_TIMEOUT (k_is_in_isr() ? K_NO_WAIT : K_FOREVER)
 
 typedef int (*data_read_cb_t)(void *arg, uint8_t *buf, size_t len);
@@ -64,6 +68,9 @@ static struct {
 
 	/* Error encountered */
 	int				error;
+
+	/* Dump cut short for lack of space */
+	bool				truncated;
 } backend_ctx;
 
 /* Buffer used in stream flash context */
@@ -405,13 +412,21 @@ static void coredump_flash_backend_start(void)
 	ret = partition_open();
 
 	if (ret == 0) {
-		/* Erase whole flash partition */
-		ret = flash_area_erase(backend_ctx.flash_area, 0,
-				       backend_ctx.flash_area->fa_size);
+		if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
+			/* Pages are erased as the dump is written */
+			ret = flash_area_erase(backend_ctx.flash_area, 0,
+					       ROUND_UP(sizeof(struct flash_hdr_t),
+							FLASH_ERASE_SIZE));
+		} else {
+			/* Erase whole flash partition */
+			ret = flash_area_erase(backend_ctx.flash_area, 0,
+					       backend_ctx.flash_area->fa_size);
+		}
 	}
 
 	if (ret == 0) {
 		backend_ctx.checksum = 0;
+		backend_ctx.truncated = false;
 
 		flash_dev = flash_area_get_device(backend_ctx.flash_area);
 
@@ -467,7 +482,7 @@ static void coredump_flash_backend_end(void)
 	hdr.size = stream_flash_bytes_written(&backend_ctx.stream_ctx);
 	hdr.checksum = backend_ctx.checksum;
 	hdr.error = backend_ctx.error;
-	hdr.flags = 0;
+	hdr.flags = backend_ctx.truncated ? HDR_FLAG_TRUNCATED : 0;
 
 	ret = flash_area_write(backend_ctx.flash_area, 0, (void *)&hdr, sizeof(hdr));
 	if (ret != 0) {
@@ -480,6 +495,10 @@ static void coredump_flash_backend_end(void)
 			backend_ctx.error);
 	}
 
+	if (backend_ctx.truncated) {
+		LOG_WRN("Coredump truncated, partition too small");
+	}
+
 	partition_close();
 }
 
@@ -501,7 +520,8 @@ static void coredump_flash_backend_buffer_output(uint8_t *buf, size_t buflen)
 	uint8_t *ptr = buf;
 	uint8_t tmp_buf[FLASH_BUF_SIZE];
 
-	if ((backend_ctx.error != 0) || (backend_ctx.flash_area == NULL)) {
+	if ((backend_ctx.error != 0) || (backend_ctx.flash_area == NULL) ||
+	    backend_ctx.truncated) {
 		return;
 	}
 
@@ -517,6 +537,21 @@ static void coredump_flash_backend_buffer_output(uint8_t *buf, size_t buflen)
 			copy_sz = remaining;
 		}
 
+		if (IS_ENABLED(CONFIG_DEBUG_COREDUMP_BACKEND_FLASH_PARTITION_TRUNCATE)) {
+			struct stream_flash_ctx *ctx = &backend_ctx.stream_ctx;
+			size_t space = ctx->available - ctx->bytes_written - ctx->buf_bytes;
+
+			if (copy_sz > space) {
+				/* Keep what fits, drop everything after */
+				copy_sz = space;
+				remaining = space;
+				backend_ctx.truncated = true;
+				if (copy_sz == 0) {
+					break;
+				}
+			}
+		}
+
 		(void)memcpy(tmp_buf, ptr, copy_sz);
 
 		for (i = 0; i < copy_sz; i++) {
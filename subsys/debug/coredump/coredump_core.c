@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2020 Intel Corporation.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -60,7 +61,8 @@ static void dump_header(unsigned int reason)
 
 static void dump_thread(struct k_thread *thread)
 {
-#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN
+#if defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN) || \
+	defined(CONFIG_DEBUG_COREDUMP_THREAD_FIRST)
 	uintptr_t end_addr;
 
 	/*
@@ -157,6 +159,62 @@ void coredump_buffer_output(uint8_t *buf, size_t buflen)
 	backend_api->buffer_output(buf, buflen);
 }
 
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_RLE
+/*
+ * Memory byte streams are made of packets starting with a control byte:
+ * below 0x80, it is followed by that many plus one literal bytes, otherwise
+ * by a single byte repeated the control byte minus 0x80 plus 3 times.
+ */
+#define RLE_LITERALS_MAX	128
+#define RLE_RUN_MIN		3
+#define RLE_RUN_MAX		(0x7f + RLE_RUN_MIN)
+
+static uint8_t rle_buf[1 + RLE_LITERALS_MAX];
+
+static void rle_literals_flush(size_t count)
+{
+	if (count > 0) {
+		rle_buf[0] = count - 1;
+		backend_api->buffer_output(rle_buf, 1 + count);
+	}
+}
+
+static void rle_output(const uint8_t *buf, size_t len)
+{
+	size_t literals = 0;
+	size_t i = 0;
+
+	while (i < len) {
+		uint8_t value = buf[i];
+		size_t run = 1;
+
+		while ((i + run < len) && (run < RLE_RUN_MAX) && (buf[i + run] == value)) {
+			run++;
+		}
+
+		if (run >= RLE_RUN_MIN) {
+			uint8_t packet[2] = {0x80 + run - RLE_RUN_MIN, value};
+
+			rle_literals_flush(literals);
+			literals = 0;
+			backend_api->buffer_output(packet, sizeof(packet));
+			i += run;
+			continue;
+		}
+
+		rle_buf[1 + literals] = value;
+		literals++;
+		if (literals == RLE_LITERALS_MAX) {
+			rle_literals_flush(literals);
+			literals = 0;
+		}
+		i++;
+	}
+
+	rle_literals_flush(literals);
+}
+#endif /* CONFIG_DEBUG_COREDUMP_MEMORY_RLE */
+
 void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 {
 	struct coredump_mem_hdr_t m;
@@ -174,7 +232,11 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 	len = end_addr - start_addr;
 
 	m.id = COREDUMP_MEM_HDR_ID;
-	m.hdr_version = COREDUMP_MEM_HDR_VER;
+	if (IS_ENABLED(CONFIG_DEBUG_COREDUMP_MEMORY_RLE)) {
+		m.hdr_version = COREDUMP_MEM_HDR_VER_RLE;
+	} else {
+		m.hdr_version = COREDUMP_MEM_HDR_VER;
+	}
 
 	if (sizeof(uintptr_t) == 8) {
 		m.start	= sys_cpu_to_le64(start_addr);
@@ -186,7 +248,11 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 
 	coredump_buffer_output((uint8_t *)&m, sizeof(m));
 
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_RLE
+	rle_output((const uint8_t *)start_addr, len);
+#else
 	coredump_buffer_output((uint8_t *)start_addr, len);
+#endif
 }
 
 int coredump_query(enum coredump_query_id query_id, void *arg)
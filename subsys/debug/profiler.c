@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/debug/profiler.h>
+#include <zephyr/debug/symtab.h>
+
+#define HIST_SIZE   CONFIG_PROFILER_HISTOGRAM_SIZE
+#define STACK_DEPTH CONFIG_PROFILER_STACK_DEPTH
+
+struct profiler_bin {
+	uintptr_t addr;
+	/* 0 if the bin is unused */
+	uint32_t count;
+};
+
+struct profiler_stack {
+	uintptr_t frames[STACK_DEPTH];
+	size_t depth;
+};
+
+static struct k_spinlock lock;
+static struct k_timer profiler_timer;
+static bool running;
+
+/* Open addressing hash table, linearly probed, keyed by address */
+static struct profiler_bin hist[HIST_SIZE];
+static uint32_t samples;
+static uint32_t dropped;
+
+#if CONFIG_PROFILER_STACK_SAMPLES > 0
+/* Ring of the latest stack samples */
+static struct profiler_stack stacks[CONFIG_PROFILER_STACK_SAMPLES];
+static uint32_t stacks_taken;
+#endif
+
+static uintptr_t profiler_key(uintptr_t pc)
+{
+#ifdef CONFIG_SYMTAB
+	uint32_t offset = 0;
+
+	(void)symtab_find_symbol_name(pc, &offset);
+
+	/* Count per function rather than per instruction */
+	return pc - offset;
+#else
+	return pc;
+#endif
+}
+
+static void profiler_hist_add(uintptr_t addr)
+{
+	size_t i = (addr >> 1) % HIST_SIZE;
+
+	for (size_t n = 0; n < HIST_SIZE; n++) {
+		struct profiler_bin *bin = &hist[i];
+
+		if (bin->count == 0U) {
+			bin->addr = addr;
+		}
+
+		if (bin->addr == addr) {
+			bin->count++;
+			samples++;
+			return;
+		}
+
+		i = (i + 1) % HIST_SIZE;
+	}
+
+	dropped++;
+}
+
+static void profiler_sample(struct k_timer *timer)
+{
+	struct profiler_stack sample;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(timer);
+
+	/* Expiry functions run from the system timer interrupt */
+	sample.depth = arch_interrupted_stack_trace(sample.frames,
+						    CONFIG_PROFILER_STACK_SAMPLES > 0 ? STACK_DEPTH : 1);
+	if (sample.depth == 0) {
+		/* Interrupted another interrupt */
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	profiler_hist_add(profiler_key(sample.frames[0]));
+
+#if CONFIG_PROFILER_STACK_SAMPLES > 0
+	stacks[stacks_taken % CONFIG_PROFILER_STACK_SAMPLES] = sample;
+	stacks_taken++;
+#endif
+
+	k_spin_unlock(&lock, key);
+}
+
+int profiler_start(k_timeout_t period)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (running) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	running = true;
+	k_spin_unlock(&lock, key);
+
+	k_timer_init(&profiler_timer, profiler_sample, NULL);
+	k_timer_start(&profiler_timer, period, period);
+
+	return 0;
+}
+
+void profiler_stop(void)
+{
+	bool was_running = false;
+
+	K_SPINLOCK(&lock) {
+		was_running = running;
+		running = false;
+	}
+
+	if (was_running) {
+		k_timer_stop(&profiler_timer);
+	}
+}
+
+void profiler_reset(void)
+{
+	K_SPINLOCK(&lock) {
+		memset(hist, 0, sizeof(hist));
+		samples = 0;
+		dropped = 0;
+#if CONFIG_PROFILER_STACK_SAMPLES > 0
+		stacks_taken = 0;
+#endif
+	}
+}
+
+uint32_t profiler_samples_get(uint32_t *dropped_samples)
+{
+	uint32_t ret = 0;
+
+	K_SPINLOCK(&lock) {
+		ret = samples;
+		if (dropped_samples != NULL) {
+			*dropped_samples = dropped;
+		}
+	}
+
+	return ret;
+}
+
+void profiler_hist_foreach(profiler_hist_cb_t cb, void *user_data)
+{
+	struct profiler_bin bin;
+
+	for (size_t i = 0; i < HIST_SIZE; i++) {
+		K_SPINLOCK(&lock) {
+			bin = hist[i];
+		}
+
+		if (bin.count != 0U) {
+			cb(bin.addr, bin.count, user_data);
+		}
+	}
+}
+
+void profiler_stacks_foreach(profiler_stack_cb_t cb, void *user_data)
+{
+#if CONFIG_PROFILER_STACK_SAMPLES > 0
+	struct profiler_stack sample;
+	uint32_t first = 0;
+	uint32_t last = 0;
+
+	K_SPINLOCK(&lock) {
+		last = stacks_taken;
+	}
+
+	if (last > CONFIG_PROFILER_STACK_SAMPLES) {
+		first = last - CONFIG_PROFILER_STACK_SAMPLES;
+	}
+
+	for (uint32_t i = first; i < last; i++) {
+		bool valid = false;
+
+		K_SPINLOCK(&lock) {
+			/* Skip the samples overwritten or reset meanwhile */
+			valid = (i < stacks_taken) &&
+				(stacks_taken - i <= CONFIG_PROFILER_STACK_SAMPLES);
+			sample = stacks[i % CONFIG_PROFILER_STACK_SAMPLES];
+		}
+
+		if (valid) {
+			cb(sample.frames, sample.depth, user_data);
+		}
+	}
+#else
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+#endif
+}
+
+#ifdef CONFIG_PROFILER_SHELL
+#include <stdlib.h>
+#include <zephyr/shell/shell.h>
+
+#ifdef CONFIG_SYMTAB
+#define PR_SYMBOL(sh, fmt, addr, ...)                                                              \
+	do {                                                                                       \
+		uint32_t offset;                                                                   \
+		const char *name = symtab_find_symbol_name(addr, &offset);                         \
+												   \
+		shell_print(sh, fmt "0x%08lx %s+0x%x", ##__VA_ARGS__, (unsigned long)(addr), name, \
+			    offset);                                                               \
+	} while (false)
+#else
+#define PR_SYMBOL(sh, fmt, addr, ...)                                                              \
+	shell_print(sh, fmt "0x%08lx", ##__VA_ARGS__, (unsigned long)(addr))
+#endif
+
+static int cmd_profiler_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t period_ms = 1;
+
+	if (argc > 1) {
+		period_ms = strtoul(argv[1], NULL, 0);
+		if (period_ms == 0U) {
+			shell_error(sh, "Invalid period: %s", argv[1]);
+			return -EINVAL;
+		}
+	}
+
+	if (profiler_start(K_MSEC(period_ms)) != 0) {
+		shell_error(sh, "Profiler already started");
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int cmd_profiler_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stop();
+
+	return 0;
+}
+
+static int cmd_profiler_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_reset();
+
+	return 0;
+}
+
+struct hist_print_ctx {
+	const struct shell *sh;
+	uint32_t total;
+};
+
+static void hist_print(uintptr_t addr, uint32_t count, void *user_data)
+{
+	struct hist_print_ctx *ctx = user_data;
+	uint32_t percent = (uint32_t)((uint64_t)count * 100U / ctx->total);
+
+	PR_SYMBOL(ctx->sh, "%8u %3u%% ", addr, count, percent);
+}
+
+static int cmd_profiler_hist(const struct shell *sh, size_t argc, char **argv)
+{
+	struct hist_print_ctx ctx = {.sh = sh};
+	uint32_t dropped_samples;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ctx.total = profiler_samples_get(&dropped_samples);
+	shell_print(sh, "%u samples, %u dropped", ctx.total, dropped_samples);
+
+	if (ctx.total != 0U) {
+		profiler_hist_foreach(hist_print, &ctx);
+	}
+
+	return 0;
+}
+
+static void stack_print(const uintptr_t *frames, size_t depth, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "--");
+	for (size_t i = 0; i < depth; i++) {
+		PR_SYMBOL(sh, "  ", frames[i]);
+	}
+}
+
+static int cmd_profiler_stacks(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stacks_foreach(stack_print, (void *)sh);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [period in ms, default 1]",
+		      cmd_profiler_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling", cmd_profiler_stop),
+	SHELL_CMD(reset, NULL, "Drop all samples", cmd_profiler_reset),
+	SHELL_CMD(hist, NULL, "Print the sample histogram", cmd_profiler_hist),
+	SHELL_CMD(stacks, NULL, "Print the latest stack samples", cmd_profiler_stacks),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands", NULL);
+
+#endif /* CONFIG_PROFILER_SHELL */
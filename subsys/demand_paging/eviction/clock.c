@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* The clock hand sweeps over the page frames in physical order. A page
+ * frame whose accessed bit is set gets a second chance: the bit is cleared
+ * and the hand moves on. The first evictable page frame found with the
+ * accessed bit clear is evicted. This approximates LRU without a periodic
+ * timer, the accessed bits are only looked at (and cleared) on eviction.
+ *
+ * Clean pages are preferred: a dirty, not recently accessed page is only
+ * selected if a whole sweep didn't turn up a clean one.
+ */
+static uintptr_t clock_hand;
+
+static struct z_page_frame *clock_next(void)
+{
+	struct z_page_frame *pf = &z_page_frames[clock_hand];
+
+	clock_hand = (clock_hand + 1U) % Z_NUM_PAGE_FRAMES;
+
+	return pf;
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *dirty_pf = NULL;
+	struct z_page_frame *pf;
+	uintptr_t flags;
+
+	/* With every accessed bit set the first sweep clears them all and
+	 * the second one is guaranteed to find a candidate.
+	 */
+	for (size_t i = 0; i < 2U * Z_NUM_PAGE_FRAMES; i++) {
+		pf = clock_next();
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Read and clear the accessed bit in the page tables */
+		flags = arch_page_info_get(z_page_frame_to_virt(pf), NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			continue;
+		}
+
+		if ((flags & ARCH_DATA_PAGE_DIRTY) == 0UL) {
+			*dirty_ptr = false;
+			return pf;
+		}
+
+		if (dirty_pf == NULL) {
+			dirty_pf = pf;
+		} else if (dirty_pf == pf) {
+			/* A full sweep since the first dirty candidate */
+			break;
+		}
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(dirty_pf != NULL, "no page to evict");
+
+	*dirty_ptr = true;
+
+	return dirty_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/drivers/disk.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define CACHE_SECTOR_SIZE	CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE
+#define CACHE_ENTRIES		CONFIG_DISK_ACCESS_CACHE_ENTRIES
+#define CACHE_MAX_SECTORS	CONFIG_DISK_ACCESS_CACHE_MAX_SECTORS
+#define CACHE_READ_AHEAD	CONFIG_DISK_ACCESS_CACHE_READ_AHEAD
+
+/* Sectors read at once on a miss, or written at once when flushing */
+#define SCRATCH_SECTORS		(CACHE_MAX_SECTORS + CACHE_READ_AHEAD)
+
+struct disk_cache_entry {
+	/* Node in the LRU list, most recently used first */
+	sys_dnode_t node;
+	/* Disk the sector belongs to, NULL if the entry is free */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+};
+
+static struct disk_cache_entry entries[CACHE_ENTRIES];
+static uint8_t entry_data[CACHE_ENTRIES][CACHE_SECTOR_SIZE] __aligned(4);
+static uint8_t scratch[SCRATCH_SECTORS * CACHE_SECTOR_SIZE] __aligned(4);
+
+static sys_dlist_t lru = SYS_DLIST_STATIC_INIT(&lru);
+static bool lru_initialized;
+
+/* protects the entries, disk I/O of cached disks is done while holding it */
+static K_MUTEX_DEFINE(cache_lock);
+
+static inline uint8_t *entry_buf(struct disk_cache_entry *e)
+{
+	return entry_data[e - entries];
+}
+
+static inline bool is_cached(struct disk_info *disk)
+{
+	return disk->cache_sector_count != 0;
+}
+
+static struct disk_cache_entry *lookup(struct disk_info *disk, uint32_t sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].disk == disk && entries[i].sector == sector) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void touch(struct disk_cache_entry *e)
+{
+	sys_dlist_remove(&e->node);
+	sys_dlist_prepend(&lru, &e->node);
+}
+
+static void drop(struct disk_cache_entry *e)
+{
+	e->disk = NULL;
+	e->dirty = false;
+	sys_dlist_remove(&e->node);
+	sys_dlist_append(&lru, &e->node);
+}
+
+/* Take the least recently used entry for a sector, its data is left to the caller */
+static int alloc_entry(struct disk_info *disk, uint32_t sector, struct disk_cache_entry **out)
+{
+	struct disk_cache_entry *e = SYS_DLIST_PEEK_TAIL_CONTAINER(&lru, e, node);
+	int rc;
+
+	if (e->dirty) {
+		rc = e->disk->ops->write(e->disk, entry_buf(e), e->sector, 1);
+		if (rc != 0) {
+			LOG_ERR("write back of sector %u failed (%d)", e->sector, rc);
+			return rc;
+		}
+	}
+
+	e->disk = disk;
+	e->sector = sector;
+	e->dirty = false;
+	touch(e);
+	*out = e;
+
+	return 0;
+}
+
+static struct disk_cache_entry *lowest_dirty(struct disk_info *disk)
+{
+	struct disk_cache_entry *lowest = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].disk == disk && entries[i].dirty &&
+		    (lowest == NULL || entries[i].sector < lowest->sector)) {
+			lowest = &entries[i];
+		}
+	}
+
+	return lowest;
+}
+
+/* Write back all dirty sectors in ascending order, adjacent ones in a single write */
+static int flush_locked(struct disk_info *disk)
+{
+	struct disk_cache_entry *run[SCRATCH_SECTORS];
+	struct disk_cache_entry *e;
+	size_t n;
+	int rc;
+
+	while ((e = lowest_dirty(disk)) != NULL) {
+		run[0] = e;
+		for (n = 1; n < ARRAY_SIZE(run); n++) {
+			e = lookup(disk, run[0]->sector + n);
+			if (e == NULL || !e->dirty) {
+				break;
+			}
+			run[n] = e;
+		}
+
+		if (n == 1) {
+			rc = disk->ops->write(disk, entry_buf(run[0]), run[0]->sector, 1);
+		} else {
+			for (size_t i = 0; i < n; i++) {
+				memcpy(&scratch[i * CACHE_SECTOR_SIZE], entry_buf(run[i]),
+				       CACHE_SECTOR_SIZE);
+			}
+			rc = disk->ops->write(disk, scratch, run[0]->sector, n);
+		}
+
+		if (rc != 0) {
+			LOG_ERR("write back of sectors %u-%u failed (%d)", run[0]->sector,
+				run[0]->sector + n - 1, rc);
+			return rc;
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			run[i]->dirty = false;
+		}
+	}
+
+	return 0;
+}
+
+void disk_cache_attach(struct disk_info *disk)
+{
+	uint32_t sector_size = 0;
+	uint32_t sector_count = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!lru_initialized) {
+		for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+			sys_dlist_append(&lru, &entries[i].node);
+		}
+		lru_initialized = true;
+	}
+
+	if (is_cached(disk)) {
+		/* initialized again, e.g. after a media change, don't trust the cache */
+		(void)flush_locked(disk);
+		for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+			if (entries[i].disk == disk) {
+				drop(&entries[i]);
+			}
+		}
+		disk->cache_sector_count = 0;
+	}
+
+	if (disk->ops->ioctl != NULL && disk->ops->write != NULL &&
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size) == 0 &&
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT, &sector_count) == 0 &&
+	    sector_size == CACHE_SECTOR_SIZE) {
+		disk->cache_sector_count = sector_count;
+	} else {
+		LOG_DBG("disk(%s) with sector size %u not cached", disk->name, sector_size);
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+int disk_cache_detach(struct disk_info *disk)
+{
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (is_cached(disk)) {
+		rc = flush_locked(disk);
+		for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+			if (entries[i].disk == disk) {
+				drop(&entries[i]);
+			}
+		}
+		disk->cache_sector_count = 0;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+static int read_cached(struct disk_info *disk, uint8_t *data_buf,
+		       uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_entry *e;
+	uint32_t n, ahead;
+	int rc;
+
+	for (uint32_t i = 0; i < num_sector; i += n) {
+		uint32_t sector = start_sector + i;
+
+		e = lookup(disk, sector);
+		if (e != NULL) {
+			memcpy(&data_buf[i * CACHE_SECTOR_SIZE], entry_buf(e), CACHE_SECTOR_SIZE);
+			touch(e);
+			n = 1;
+			continue;
+		}
+
+		n = 1;
+		while (i + n < num_sector && lookup(disk, sector + n) == NULL) {
+			n++;
+		}
+
+		/* a miss up to the end of the request looks sequential, read ahead */
+		ahead = 0;
+		if (i + n == num_sector) {
+			while (ahead < CACHE_READ_AHEAD &&
+			       sector + n + ahead < disk->cache_sector_count &&
+			       lookup(disk, sector + n + ahead) == NULL) {
+				ahead++;
+			}
+		}
+
+		rc = disk->ops->read(disk, scratch, sector, n + ahead);
+		if (rc != 0) {
+			return rc;
+		}
+
+		memcpy(&data_buf[i * CACHE_SECTOR_SIZE], scratch, n * CACHE_SECTOR_SIZE);
+
+		for (uint32_t j = 0; j < n + ahead; j++) {
+			rc = alloc_entry(disk, sector + j, &e);
+			if (rc != 0) {
+				return rc;
+			}
+			memcpy(entry_buf(e), &scratch[j * CACHE_SECTOR_SIZE], CACHE_SECTOR_SIZE);
+		}
+	}
+
+	return 0;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!is_cached(disk)) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+	} else if (num_sector <= CACHE_MAX_SECTORS) {
+		rc = read_cached(disk, data_buf, start_sector, num_sector);
+	} else {
+		/* bulk data bypasses the cache, but must see sectors not written back yet */
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		for (size_t i = 0; rc == 0 && i < ARRAY_SIZE(entries); i++) {
+			struct disk_cache_entry *e = &entries[i];
+
+			if (e->disk == disk && e->dirty && e->sector >= start_sector &&
+			    e->sector - start_sector < num_sector) {
+				memcpy(&data_buf[(e->sector - start_sector) * CACHE_SECTOR_SIZE],
+				       entry_buf(e), CACHE_SECTOR_SIZE);
+			}
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+static int write_cached(struct disk_info *disk, const uint8_t *data_buf,
+			uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_entry *e;
+	int rc;
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		e = lookup(disk, start_sector + i);
+		if (e == NULL) {
+			rc = alloc_entry(disk, start_sector + i, &e);
+			if (rc != 0) {
+				return rc;
+			}
+		} else {
+			touch(e);
+		}
+
+		memcpy(entry_buf(e), &data_buf[i * CACHE_SECTOR_SIZE], CACHE_SECTOR_SIZE);
+
+		/* rewriting a dirty sector replaces the pending write */
+		e->dirty = IS_ENABLED(CONFIG_DISK_ACCESS_CACHE_WRITE_BACK);
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE_WRITE_BACK)) {
+		return 0;
+	}
+
+	rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+	if (rc != 0) {
+		for (uint32_t i = 0; i < num_sector; i++) {
+			e = lookup(disk, start_sector + i);
+			if (e != NULL) {
+				drop(e);
+			}
+		}
+	}
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!is_cached(disk)) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+	} else if (num_sector <= CACHE_MAX_SECTORS) {
+		rc = write_cached(disk, data_buf, start_sector, num_sector);
+	} else {
+		/* bulk data bypasses the cache, cached copies are now up to date on disk */
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		for (size_t i = 0; rc == 0 && i < ARRAY_SIZE(entries); i++) {
+			struct disk_cache_entry *e = &entries[i];
+
+			if (e->disk == disk && e->sector >= start_sector &&
+			    e->sector - start_sector < num_sector) {
+				memcpy(entry_buf(e),
+				       &data_buf[(e->sector - start_sector) * CACHE_SECTOR_SIZE],
+				       CACHE_SECTOR_SIZE);
+				e->dirty = false;
+			}
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_flush(struct disk_info *disk)
+{
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (is_cached(disk)) {
+		rc = flush_locked(disk);
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
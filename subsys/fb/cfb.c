@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018 PHYTEC Messtechnik GmbH
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -23,6 +24,14 @@ static inline uint8_t byte_reverse(uint8_t b)
 	return b;
 }
 
+/** Rectangle in pixels, end coordinates excluded, empty if x0 >= x1 */
+struct cfb_rect {
+	uint16_t x0;
+	uint16_t y0;
+	uint16_t x1;
+	uint16_t y1;
+};
+
 struct char_framebuffer {
 	/** Pointer to a buffer in RAM */
 	uint8_t *buf;
@@ -59,10 +68,70 @@ struct char_framebuffer {
 
 	/** Inverted */
 	bool inverted;
+
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	/** Area changed since the last cfb_framebuffer_finalize() */
+	struct cfb_rect dirty;
+
+	/** Area drawn into since the last cfb_framebuffer_clear() */
+	struct cfb_rect drawn;
+#endif
 };
 
 static struct char_framebuffer char_fb;
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+static inline bool rect_is_empty(const struct cfb_rect *r)
+{
+	return r->x0 >= r->x1 || r->y0 >= r->y1;
+}
+
+static void rect_add(struct cfb_rect *r, const struct cfb_rect *area)
+{
+	if (rect_is_empty(r)) {
+		*r = *area;
+		return;
+	}
+
+	r->x0 = MIN(r->x0, area->x0);
+	r->y0 = MIN(r->y0, area->y0);
+	r->x1 = MAX(r->x1, area->x1);
+	r->y1 = MAX(r->y1, area->y1);
+}
+#endif
+
+/* Record that the pixels of the given area may have changed */
+static void mark_dirty(struct char_framebuffer *fb, int32_t x, int32_t y,
+		       int32_t width, int32_t height)
+{
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	struct cfb_rect area = {
+		.x0 = CLAMP(x, 0, fb->x_res),
+		.y0 = CLAMP(y, 0, fb->y_res),
+		.x1 = CLAMP(x + width, 0, fb->x_res),
+		.y1 = CLAMP(y + height, 0, fb->y_res),
+	};
+
+	if (rect_is_empty(&area)) {
+		return;
+	}
+
+	rect_add(&fb->dirty, &area);
+	rect_add(&fb->drawn, &area);
+#else
+	ARG_UNUSED(fb);
+	ARG_UNUSED(x);
+	ARG_UNUSED(y);
+	ARG_UNUSED(width);
+	ARG_UNUSED(height);
+#endif
+}
+
+static inline void mark_all_dirty(struct char_framebuffer *fb)
+{
+	mark_dirty(fb, 0, 0, fb->x_res, fb->y_res);
+}
+
 static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 {
 	return (uint8_t *)fptr->data +
@@ -202,6 +271,7 @@ static inline void draw_point(struct char_framebuffer *fb, int16_t x, int16_t y)
 	}
 
 	fb->buf[index + x] |= m;
+	mark_dirty(fb, x, y, 1, 1);
 }
 
 static void draw_line(struct char_framebuffer *fb, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
@@ -237,7 +307,7 @@ static void draw_line(struct char_framebuffer *fb, int16_t x0, int16_t y0, int16
 static int draw_text(const struct device *dev, const char *const str, int16_t x, int16_t y,
 		     bool wrap)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const struct cfb_font *fptr;
 
 	if (!fb->fonts || !fb->buf) {
@@ -257,6 +327,7 @@ static int draw_text(const struct device *dev, const char *const str, int16_t x,
 				x = 0U;
 				y += fptr->height;
 			}
+			mark_dirty(fb, x, y, fptr->width, fptr->height);
 			x += fb->kerning + draw_char_vtmono(fb, str[i], x, y, wrap);
 		}
 		return 0;
@@ -311,7 +382,7 @@ int cfb_print(const struct device *dev, const char *const str, uint16_t x, uint1
 int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 		    uint16_t width, uint16_t height)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const bool need_reverse = ((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0);
 
 	if (x >= fb->x_res || y >= fb->y_res) {
@@ -337,6 +408,8 @@ int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 			height = fb->y_res - y;
 		}
 
+		mark_dirty(fb, x, y, width, height);
+
 		for (size_t i = x; i < x + width; i++) {
 			for (size_t j = y; j < (y + height); j++) {
 				/*
@@ -406,7 +479,7 @@ static int cfb_invert(const struct char_framebuffer *fb)
 
 int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 
 	if (!fb || !fb->buf) {
 		return -ENODEV;
@@ -414,6 +487,12 @@ int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 
 	memset(fb->buf, 0, fb->size);
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	/* Only pixels drawn into since the last clear can have changed */
+	rect_add(&fb->dirty, &fb->drawn);
+	fb->drawn = (struct cfb_rect){0};
+#endif
+
 	if (clear_display) {
 		cfb_framebuffer_finalize(dev);
 	}
@@ -430,6 +509,7 @@ int cfb_framebuffer_invert(const struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	mark_all_dirty(fb);
 
 	return 0;
 }
@@ -437,8 +517,11 @@ int cfb_framebuffer_invert(const struct device *dev)
 int cfb_framebuffer_finalize(const struct device *dev)
 {
 	const struct display_driver_api *api = dev->api;
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
+	uint16_t x = 0;
+	uint16_t y = 0;
+	uint8_t *buf;
 	int err;
 
 	if (!fb || !fb->buf) {
@@ -449,15 +532,50 @@ int cfb_framebuffer_finalize(const struct device *dev)
 	desc.width = fb->x_res;
 	desc.height = fb->y_res;
 	desc.pitch = fb->x_res;
+	buf = fb->buf;
+
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	if (rect_is_empty(&fb->dirty)) {
+		return 0;
+	}
+
+	/*
+	 * Write the tile rows covering the dirty area, which are contiguous
+	 * in the buffer. Within a single tile row, the dirty columns are
+	 * contiguous as well, so only those are written.
+	 */
+	const uint16_t row0 = fb->dirty.y0 / fb->ppt;
+	const uint16_t row1 = DIV_ROUND_UP(fb->dirty.y1, fb->ppt);
+
+	y = row0 * fb->ppt;
+	desc.height = (row1 - row0) * fb->ppt;
+	buf += row0 * fb->x_res;
+
+	if (row1 - row0 == 1U) {
+		x = fb->dirty.x0;
+		desc.width = fb->dirty.x1 - fb->dirty.x0;
+		desc.pitch = desc.width;
+		buf += x;
+	}
+
+	desc.buf_size = desc.width * (row1 - row0);
+#endif
 
 	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
 		cfb_invert(fb);
-		err = api->write(dev, 0, 0, &desc, fb->buf);
+		err = api->write(dev, x, y, &desc, buf);
 		cfb_invert(fb);
-		return err;
+	} else {
+		err = api->write(dev, x, y, &desc, buf);
 	}
 
-	return api->write(dev, 0, 0, &desc, fb->buf);
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	if (err == 0) {
+		fb->dirty = (struct cfb_rect){0};
+	}
+#endif
+
+	return err;
 }
 
 int cfb_get_display_parameter(const struct device *dev,
@@ -565,5 +683,11 @@ int cfb_framebuffer_init(const struct device *dev)
 
 	memset(fb->buf, 0, fb->size);
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_PARTIAL_UPDATE
+	/* The display content is unknown until the first full write */
+	fb->dirty = (struct cfb_rect){0, 0, fb->x_res, fb->y_res};
+	fb->drawn = (struct cfb_rect){0};
+#endif
+
 	return 0;
 }
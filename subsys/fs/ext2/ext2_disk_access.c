@@ -33,12 +33,22 @@ static int64_t disk_access_write_size(struct ext2_data *fs)
 	return disk->sector_size;
 }
 
+/* With the block cache a sync writes back all cached sectors, so only sync on fs sync */
+static int sync_before_access(const char *disk)
+{
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+		return 0;
+	}
+
+	return disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
+}
+
 static int disk_read(const char *disk, uint8_t *buf, uint32_t start, uint32_t num)
 {
 	int rc, loop = 0;
 
 	do {
-		rc = disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
+		rc = sync_before_access(disk);
 		if (rc == 0) {
 			rc = disk_access_read(disk, buf, start, num);
 			LOG_DBG("disk read: (start:%d, num:%d) (ret: %d)", start, num, rc);
@@ -52,7 +62,7 @@ static int disk_write(const char *disk, const uint8_t *buf, uint32_t start, uint
 	int rc, loop = 0;
 
 	do {
-		rc = disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
+		rc = sync_before_access(disk);
 		if (rc == 0) {
 			rc = disk_access_write(disk, buf, start, num);
 			LOG_DBG("disk write: (start:%d, num:%d) (ret: %d)", start, num, rc);
@@ -114,6 +124,36 @@ static int disk_access_write_block(struct ext2_data *fs, const void *buf, uint32
 	return disk_write(disk->name, buf, sector_start, sector_count);
 }
 
+static int disk_access_read_blocks(struct ext2_data *fs, void *buf, uint32_t block,
+				   uint32_t count)
+{
+	int rc;
+	struct disk_data *disk = fs->backend;
+	uint32_t sector_start, sector_count;
+
+	rc = disk_prepare_range(disk, block * fs->block_size, count * fs->block_size,
+			&sector_start, &sector_count);
+	if (rc < 0) {
+		return rc;
+	}
+	return disk_read(disk->name, buf, sector_start, sector_count);
+}
+
+static int disk_access_write_blocks(struct ext2_data *fs, const void *buf, uint32_t block,
+				    uint32_t count)
+{
+	int rc;
+	struct disk_data *disk = fs->backend;
+	uint32_t sector_start, sector_count;
+
+	rc = disk_prepare_range(disk, block * fs->block_size, count * fs->block_size,
+			&sector_start, &sector_count);
+	if (rc < 0) {
+		return rc;
+	}
+	return disk_write(disk->name, buf, sector_start, sector_count);
+}
+
 static int disk_access_read_superblock(struct ext2_data *fs, struct ext2_disk_superblock *sb)
 {
 	int rc;
@@ -141,6 +181,8 @@ static const struct ext2_backend_ops disk_access_ops = {
 	.get_write_size = disk_access_write_size,
 	.read_block = disk_access_read_block,
 	.write_block = disk_access_write_block,
+	.read_blocks = disk_access_read_blocks,
+	.write_blocks = disk_access_write_blocks,
 	.read_superblock = disk_access_read_superblock,
 	.sync = disk_access_sync,
 };
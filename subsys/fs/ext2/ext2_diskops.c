@@ -406,7 +406,8 @@ static int fetch_level_blocks(struct ext2_inode *inode, uint32_t offsets[4], int
 		bool try_current)
 {
 	uint32_t block;
-	bool already_fetched = try_current && (offsets[lvl] == inode->offsets[lvl]);
+	bool already_fetched = try_current && (offsets[lvl] == inode->offsets[lvl]) &&
+			       inode->blocks[lvl] != NULL;
 
 	/* all needed blocks fetched */
 	if (lvl > max_lvl) {
@@ -456,7 +457,7 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	struct ext2_data *fs = inode->i_fs;
 	int max_lvl, ret;
 	uint32_t offsets[MAX_OFFSETS_SIZE];
-	bool try_current = inode->flags & INODE_FETCHED_BLOCK;
+	bool try_current = inode->flags & (INODE_FETCHED_BLOCK | INODE_FETCHED_LEVELS);
 
 	max_lvl = get_level_offsets(fs, block, offsets);
 
@@ -470,12 +471,77 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	inode->block_lvl = max_lvl;
 	inode->block_num = block;
 	inode->flags |= INODE_FETCHED_BLOCK;
+	inode->flags &= ~INODE_FETCHED_LEVELS;
 
 	LOG_DBG("[ino:%d fetch]\t Lvl:%d {%d, %d, %d, %d}", inode->i_id, inode->block_lvl,
 			inode->offsets[0], inode->offsets[1], inode->offsets[2], inode->offsets[3]);
 	return 0;
 }
 
+int ext2_inode_block_map(struct ext2_inode *inode, uint32_t block, uint32_t *phys)
+{
+	struct ext2_data *fs = inode->i_fs;
+	uint32_t offsets[MAX_OFFSETS_SIZE];
+	bool try_current = inode->flags & (INODE_FETCHED_BLOCK | INODE_FETCHED_LEVELS);
+	bool levels_match = try_current;
+	int max_lvl, ret;
+
+	if (inode->flags & INODE_FETCHED_BLOCK && inode->block_num == block) {
+		*phys = inode_current_block(inode)->num;
+		return 0;
+	}
+
+	max_lvl = get_level_offsets(fs, block, offsets);
+	if (max_lvl == 0) {
+		*phys = inode->i_block[offsets[0]];
+		return 0;
+	}
+
+	for (int lvl = 0; lvl < max_lvl; lvl++) {
+		levels_match = levels_match && offsets[lvl] == inode->offsets[lvl] &&
+			       inode->blocks[lvl] != NULL;
+	}
+
+	ret = fetch_level_blocks(inode, offsets, 0, max_lvl - 1, try_current);
+	if (ret < 0) {
+		ext2_inode_drop_blocks(inode);
+		return ret;
+	}
+
+	*phys = sys_le32_to_cpu(((uint32_t *)inode->blocks[max_lvl - 1]->data)[offsets[max_lvl]]);
+
+	if (!levels_match) {
+		/* The fetched data block hangs off other indirect blocks now, drop it. */
+		ext2_drop_block(inode->blocks[max_lvl]);
+		inode->blocks[max_lvl] = NULL;
+		memcpy(inode->offsets, offsets, MAX_OFFSETS_SIZE * sizeof(uint32_t));
+		inode->block_lvl = max_lvl;
+		inode->block_num = block;
+		inode->flags &= ~INODE_FETCHED_BLOCK;
+		inode->flags |= INODE_FETCHED_LEVELS;
+	}
+
+	return 0;
+}
+
+int ext2_inode_block_alloc(struct ext2_inode *inode, uint32_t block, uint32_t *phys)
+{
+	int ret;
+
+	ret = ext2_fetch_inode_block(inode, block);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = alloc_level_blocks(inode);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*phys = inode_current_block(inode)->num;
+	return 0;
+}
+
 static bool all_zero(const uint32_t *offsets, int lvl)
 {
 	for (int i = 0; i < lvl; ++i) {
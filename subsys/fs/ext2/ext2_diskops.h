@@ -41,6 +41,35 @@ int ext2_fetch_inode(struct ext2_data *fs, uint32_t ino, struct ext2_inode *inod
  */
 int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block);
 
+/**
+ * @brief Get the disk block number of an inode block without reading it.
+ *
+ * Only the indirect blocks leading to the block are fetched.
+ *
+ * @param inode Inode structure
+ * @param block Number of inode block (0 - first block in that inode)
+ * @param phys Disk block number, 0 if the block is not allocated
+ *
+ * @retval 0 on success
+ * @retval <0 error
+ */
+int ext2_inode_block_map(struct ext2_inode *inode, uint32_t block, uint32_t *phys);
+
+/**
+ * @brief Allocate a disk block for an inode block if it has none.
+ *
+ * The block becomes the fetched block of the inode, unallocated blocks are
+ * fetched as zeroed blocks without reading the disk.
+ *
+ * @param inode Inode structure
+ * @param block Number of inode block (0 - first block in that inode)
+ * @param phys Disk block number
+ *
+ * @retval 0 on success
+ * @retval <0 error
+ */
+int ext2_inode_block_alloc(struct ext2_inode *inode, uint32_t block, uint32_t *phys);
+
 /**
  * @brief Fetch block group into buffer in fs structure.
  *
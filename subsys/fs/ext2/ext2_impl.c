@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2023 Antmicro <www.antmicro.com>
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -16,6 +17,7 @@
 #include "ext2_struct.h"
 #include "ext2_diskops.h"
 #include "ext2_bitmap.h"
+#include "../fs_dentry_cache.h"
 
 LOG_MODULE_REGISTER(ext2, CONFIG_EXT2_LOG_LEVEL);
 
@@ -133,6 +135,40 @@ int ext2_write_block(struct ext2_data *fs, struct ext2_block *b)
 	return 0;
 }
 
+static int read_blocks(struct ext2_data *fs, uint8_t *buf, uint32_t num, uint32_t count)
+{
+	int ret;
+
+	if (fs->backend_ops->read_blocks != NULL) {
+		return fs->backend_ops->read_blocks(fs, buf, num, count);
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		ret = fs->backend_ops->read_block(fs, buf + i * fs->block_size, num + i);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+	return 0;
+}
+
+static int write_blocks(struct ext2_data *fs, const uint8_t *buf, uint32_t num, uint32_t count)
+{
+	int ret;
+
+	if (fs->backend_ops->write_blocks != NULL) {
+		return fs->backend_ops->write_blocks(fs, buf, num, count);
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		ret = fs->backend_ops->write_block(fs, buf + i * fs->block_size, num + i);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+	return 0;
+}
+
 void ext2_drop_block(struct ext2_block *b)
 {
 	if (b == NULL) {
@@ -392,6 +428,7 @@ int ext2_close_fs(struct ext2_data *fs)
 
 int ext2_close_struct(struct ext2_data *fs)
 {
+	fs_dentry_cache_invalidate(fs);
 	memset(fs, 0, sizeof(struct ext2_data));
 	initialized = false;
 	return 0;
@@ -410,16 +447,10 @@ int ext2_lookup_inode(struct ext2_data *fs, struct ext2_lookup_args *args)
 	LOG_DBG("Looking for file %s", args->path);
 
 	int rc, ret = 0;
+	uint32_t cur_ino = EXT2_ROOT_INODE;
 	struct ext2_inode *cur_dir = NULL, *next = NULL;
 	static char name_buf[EXT2_MAX_FILE_NAME + 1];
 
-	/* Start looking from root directory of file system */
-	rc = ext2_inode_get(fs, EXT2_ROOT_INODE, &cur_dir);
-	if (rc < 0) {
-		ret = rc;
-		goto out;
-	}
-
 	/* There may be slash at the beginning of path */
 	const char *path = args->path;
 
@@ -427,11 +458,20 @@ int ext2_lookup_inode(struct ext2_data *fs, struct ext2_lookup_args *args)
 
 	/* If path is empty then return root directory */
 	if (path[0] == '\0') {
+		rc = ext2_inode_get(fs, EXT2_ROOT_INODE, &cur_dir);
+		if (rc < 0) {
+			ret = rc;
+			goto out;
+		}
+
 		args->inode = cur_dir;
 		cur_dir = NULL;
 		goto out;
 	}
 
+	/* Current directory (cur_ino) is fetched only when it has to be searched or
+	 * returned, so that a cached path takes a single inode read.
+	 */
 	for (;;) {
 		/* Get path component */
 		char *end = strchrnul(path, '/');
@@ -448,7 +488,24 @@ int ext2_lookup_inode(struct ext2_data *fs, struct ext2_lookup_args *args)
 		/* Search in current directory */
 		uint32_t dir_off = 0;
 		/* using 64 bit value to don't lose any information on error */
-		int64_t ino = find_dir_entry(cur_dir, name_buf, len, &dir_off);
+		int64_t ino;
+		struct fs_dentry dentry = {0};
+		bool cached = fs_dentry_cache_lookup(fs, cur_ino, name_buf, len, &dentry);
+
+		if (cached) {
+			ino = dentry.loc;
+			dir_off = dentry.offset;
+		} else {
+			if (cur_dir == NULL) {
+				rc = ext2_inode_get(fs, cur_ino, &cur_dir);
+				if (rc < 0) {
+					ret = rc;
+					goto out;
+				}
+			}
+
+			ino = find_dir_entry(cur_dir, name_buf, len, &dir_off);
+		}
 
 		const char *next_path = skip_slash(end);
 		bool last_entry = next_path[0] == '\0';
@@ -462,17 +519,27 @@ int ext2_lookup_inode(struct ext2_data *fs, struct ext2_lookup_args *args)
 				goto out;
 			}
 
-			rc = ext2_inode_get(fs, ino, &next);
-			if (rc < 0) {
-				/* error while fetching next entry */
-				ret = rc;
-				goto out;
-			}
-
-			if (!(next->i_mode & EXT2_S_IFDIR)) {
-				/* path component should be directory */
-				ret = -ENOTDIR;
-				goto out;
+			/* Known directory does not have to be fetched to go through it */
+			if (!cached || dentry.type != FS_DIR_ENTRY_DIR) {
+				rc = ext2_inode_get(fs, ino, &next);
+				if (rc < 0) {
+					/* error while fetching next entry */
+					ret = rc;
+					goto out;
+				}
+
+				if (!(next->i_mode & EXT2_S_IFDIR)) {
+					/* path component should be directory */
+					ret = -ENOTDIR;
+					goto out;
+				}
+
+				dentry = (struct fs_dentry){
+					.loc = ino,
+					.offset = dir_off,
+					.type = FS_DIR_ENTRY_DIR,
+				};
+				fs_dentry_cache_add(fs, cur_ino, name_buf, len, &dentry);
 			}
 
 			/* Go to the next path component */
@@ -481,6 +548,7 @@ int ext2_lookup_inode(struct ext2_data *fs, struct ext2_lookup_args *args)
 			/* Move to next directory */
 			ext2_inode_drop(cur_dir);
 			cur_dir = next;
+			cur_ino = ino;
 
 			next = NULL;
 			continue;
@@ -500,10 +568,28 @@ int ext2_lookup_inode(struct ext2_data *fs, struct ext2_lookup_args *args)
 				ret = rc;
 				goto out;
 			}
+
+			if (!cached) {
+				dentry = (struct fs_dentry){
+					.loc = ino,
+					.offset = dir_off,
+					.type = IS_DIR(next->i_mode) ? FS_DIR_ENTRY_DIR
+								     : FS_DIR_ENTRY_FILE,
+				};
+				fs_dentry_cache_add(fs, cur_ino, name_buf, len, &dentry);
+			}
 		}
 
 		/* Store parent directory and offset in parent directory */
 		if (args->flags & (LOOKUP_ARG_CREATE | LOOKUP_ARG_STAT | LOOKUP_ARG_UNLINK)) {
+			if (cur_dir == NULL) {
+				rc = ext2_inode_get(fs, cur_ino, &cur_dir);
+				if (rc < 0) {
+					ret = rc;
+					goto out;
+				}
+			}
+
 			/* In create it will be valid only if we have found existing file */
 			args->offset = dir_off;
 			args->parent = cur_dir;
@@ -606,6 +692,99 @@ success:
 
 /* Inode operations --------------------------------------------------------- */
 
+/* Read whole inode blocks which are consecutive on disk with a single request.
+ *
+ * @return number of blocks read (at least 1) or negative error
+ */
+static int64_t inode_read_blocks(struct ext2_inode *inode, uint8_t *buf, uint32_t first,
+				 uint32_t count)
+{
+	struct ext2_data *fs = inode->i_fs;
+	uint32_t phys, next;
+	uint32_t run = 1;
+	int rc;
+
+	rc = ext2_inode_block_map(inode, first, &phys);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (phys == 0) {
+		/* Hole in a sparse file */
+		memset(buf, 0, fs->block_size);
+		return 1;
+	}
+
+	while (run < count) {
+		rc = ext2_inode_block_map(inode, first + run, &next);
+		if (rc < 0) {
+			return rc;
+		}
+		if (next != phys + run) {
+			break;
+		}
+		run++;
+	}
+
+	LOG_DBG("inode:%d read blocks %d-%d from %d", inode->i_id, first, first + run - 1, phys);
+
+	rc = read_blocks(fs, buf, phys, run);
+	if (rc < 0) {
+		return rc;
+	}
+	return run;
+}
+
+/* Write whole inode blocks, allocating them when needed, and write the ones which are
+ * consecutive on disk with a single request.
+ *
+ * @return number of blocks written (at least 1) or negative error
+ */
+static int64_t inode_write_blocks(struct ext2_inode *inode, const uint8_t *buf, uint32_t first,
+				  uint32_t count)
+{
+	struct ext2_data *fs = inode->i_fs;
+	uint32_t phys, next;
+	uint32_t run = 0;
+	int rc;
+
+	while (run < count) {
+		rc = ext2_inode_block_map(inode, first + run, &next);
+		if (rc == 0 && next == 0) {
+			rc = ext2_inode_block_alloc(inode, first + run, &next);
+		}
+		if (rc < 0) {
+			if (run > 0) {
+				/* write what is mapped, the error shows up in the next call */
+				break;
+			}
+			return rc;
+		}
+		if (run == 0) {
+			phys = next;
+		} else if (next != phys + run) {
+			break;
+		}
+		run++;
+	}
+
+	LOG_DBG("inode:%d write blocks %d-%d to %d", inode->i_id, first, first + run - 1, phys);
+
+	rc = write_blocks(fs, buf, phys, run);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* Keep the fetched block coherent with what has just been written */
+	if (inode->flags & INODE_FETCHED_BLOCK && inode->block_num >= first &&
+	    inode->block_num < first + run) {
+		memcpy(inode_current_block_mem(inode),
+		       buf + (inode->block_num - first) * fs->block_size, fs->block_size);
+	}
+
+	return run;
+}
+
 ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, size_t nbytes)
 {
 	int rc = 0;
@@ -616,16 +795,30 @@ ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, si
 
 		uint32_t block = offset / block_size;
 		uint32_t block_off = offset % block_size;
+		uint32_t left_on_blk = block_size - block_off;
+		uint32_t left_in_file = inode->i_size - offset;
+		size_t to_read = MIN(nbytes - read, MIN(left_on_blk, left_in_file));
+
+		if (to_read == block_size) {
+			int64_t blocks = inode_read_blocks(inode, (uint8_t *)buf + read, block,
+							   MIN(nbytes - read, left_in_file) /
+							   block_size);
+
+			if (blocks < 0) {
+				rc = (int)blocks;
+				break;
+			}
+
+			read += blocks * block_size;
+			offset += blocks * block_size;
+			continue;
+		}
 
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
 			break;
 		}
 
-		uint32_t left_on_blk = block_size - block_off;
-		uint32_t left_in_file = inode->i_size - offset;
-		size_t to_read = MIN(nbytes, MIN(left_on_blk, left_in_file));
-
 		memcpy((uint8_t *)buf + read, inode_current_block_mem(inode) + block_off, to_read);
 
 		read += to_read;
@@ -645,19 +838,31 @@ ssize_t ext2_inode_write(struct ext2_inode *inode, const void *buf, uint32_t off
 	uint32_t block_size = inode->i_fs->block_size;
 
 	while (written < nbytes) {
-		uint32_t block = offset / block_size;
-		uint32_t block_off = offset % block_size;
+		uint32_t block = (offset + written) / block_size;
+		uint32_t block_off = (offset + written) % block_size;
+		size_t to_write = MIN(nbytes - written, block_size - block_off);
 
 		LOG_DBG("inode:%d Write to block %d (offset: %d-%zd/%d)",
 				inode->i_id, block, offset, offset + nbytes, inode->i_size);
 
+		if (to_write == block_size) {
+			int64_t blocks = inode_write_blocks(inode, (const uint8_t *)buf + written,
+							    block, (nbytes - written) / block_size);
+
+			if (blocks < 0) {
+				rc = (int)blocks;
+				break;
+			}
+
+			written += blocks * block_size;
+			continue;
+		}
+
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
 			break;
 		}
 
-		size_t to_write = MIN(nbytes, block_size - block_off);
-
 		memcpy(inode_current_block_mem(inode) + block_off, (uint8_t *)buf + written,
 				to_write);
 		LOG_DBG("Written %zd bytes at offset %d in block i%d", to_write, block_off, block);
@@ -1143,6 +1348,9 @@ static int ext2_del_direntry(struct ext2_inode *parent, uint32_t offset)
 	uint32_t blk = offset / block_size;
 	uint32_t blk_off = offset % block_size;
 
+	/* Removal may move the other entries of the directory */
+	fs_dentry_cache_invalidate_dir(parent->i_fs, parent->i_id);
+
 	rc = ext2_fetch_inode_block(parent, blk);
 	if (rc < 0) {
 		return rc;
@@ -1292,6 +1500,11 @@ int ext2_inode_unlink(struct ext2_inode *parent, struct ext2_inode *inode, uint3
 	if ((IS_REG_FILE(inode->i_mode) && inode->i_links_count == 1) ||
 			(IS_DIR(inode->i_mode) && inode->i_links_count == 2)) {
 
+		/* The inode number may be reused by a new directory */
+		if (IS_DIR(inode->i_mode)) {
+			fs_dentry_cache_invalidate_dir(inode->i_fs, inode->i_id);
+		}
+
 		/* Only set the flag. Inode may still be open. Inode will be
 		 * removed after dropping all references to it.
 		 */
@@ -1319,6 +1532,9 @@ int ext2_replace_file(struct ext2_lookup_args *args_from, struct ext2_lookup_arg
 	uint32_t from_blk = from_offset / block_size;
 	uint32_t from_blk_off = from_offset % block_size;
 
+	fs_dentry_cache_invalidate_dir(args_from->parent->i_fs, args_from->parent->i_id);
+	fs_dentry_cache_invalidate_dir(args_to->parent->i_fs, args_to->parent->i_id);
+
 	rc = ext2_fetch_inode_block(args_from->parent, from_blk);
 	if (rc < 0) {
 		return rc;
@@ -1375,6 +1591,8 @@ int ext2_move_file(struct ext2_lookup_args *args_from, struct ext2_lookup_args *
 	uint32_t blk = offset / block_size;
 	uint32_t blk_off = offset % block_size;
 
+	fs_dentry_cache_invalidate_dir(fparent->i_fs, fparent->i_id);
+
 	/* Check if we could just modify existing entry */
 	if (fparent->i_id == tparent->i_id) {
 		rc = ext2_fetch_inode_block(fparent, blk);
@@ -1540,6 +1758,7 @@ void ext2_inode_drop_blocks(struct ext2_inode *inode)
 {
 	for (int i = 0; i < 4; ++i) {
 		ext2_drop_block(inode->blocks[i]);
+		inode->blocks[i] = NULL;
 	}
-	inode->flags &= ~INODE_FETCHED_BLOCK;
+	inode->flags &= ~(INODE_FETCHED_BLOCK | INODE_FETCHED_LEVELS);
 }
@@ -163,6 +163,8 @@ struct ext2_bgroup {
 /* Flags for inode */
 #define INODE_FETCHED_BLOCK BIT(0)
 #define INODE_REMOVE BIT(1)
+/* Only the indirect blocks on the path to block_num are fetched */
+#define INODE_FETCHED_LEVELS BIT(2)
 
 struct ext2_inode {
 	struct ext2_data *i_fs;      /* pointer to file system data */
@@ -220,6 +222,9 @@ struct ext2_backend_ops {
 	int64_t (*get_write_size)(struct ext2_data *fs);
 	int (*read_block)(struct ext2_data *fs, void *buf, uint32_t num);
 	int (*write_block)(struct ext2_data *fs, const void *buf, uint32_t num);
+	/* Optional, transfer count consecutive blocks in a single request */
+	int (*read_blocks)(struct ext2_data *fs, void *buf, uint32_t num, uint32_t count);
+	int (*write_blocks)(struct ext2_data *fs, const void *buf, uint32_t num, uint32_t count);
 	int (*read_superblock)(struct ext2_data *fs, struct ext2_disk_superblock *sb);
 	int (*sync)(struct ext2_data *fs);
 };
@@ -14,6 +14,7 @@
 #include <zephyr/fs/fs_sys.h>
 #include <zephyr/sys/__assert.h>
 #include <ff.h>
+#include <diskio.h>
 
 #define FATFS_MAX_FILE_NAME 12 /* Uses 8.3 SFN */
 
@@ -464,6 +465,11 @@ static int fatfs_unmount(struct fs_mount_t *mountp)
 {
 	FRESULT res;
 
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+		/* FatFs only syncs the disk on file sync, write back what is left */
+		(void)disk_ioctl(((FATFS *)mountp->fs_data)->pdrv, CTRL_SYNC, NULL);
+	}
+
 	res = f_mount(NULL, translate_path(mountp->mnt_point), 0);
 
 	return translate_error(res);
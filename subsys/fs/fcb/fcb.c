@@ -14,6 +14,7 @@
 #include <errno.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/init.h>
 
 uint8_t
 fcb_get_align(const struct fcb *fcb)
@@ -91,6 +92,135 @@ fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector)
 	return 0;
 }
 
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+
+#if CONFIG_FCB_BACKGROUND_ERASE_BUDGET_MS > 0
+#define FCB_ERASE_TIMEOUT K_MSEC(CONFIG_FCB_BACKGROUND_ERASE_BUDGET_MS)
+#else
+#define FCB_ERASE_TIMEOUT K_FOREVER
+#endif
+
+static K_THREAD_STACK_DEFINE(fcb_erase_stack, CONFIG_FCB_BACKGROUND_ERASE_STACK_SIZE);
+static struct k_work_q fcb_erase_workq;
+
+/*
+ * Rotated sectors are taken into use again in the order they were rotated,
+ * hence the first pending one is the one to erase first.
+ */
+static struct flash_sector *
+fcb_first_pending_sector(struct fcb *fcb)
+{
+	int idx = fcb->f_oldest - fcb->f_sectors;
+
+	idx = (idx + fcb->f_sector_cnt - fcb->f_erase_pending) % fcb->f_sector_cnt;
+	return &fcb->f_sectors[idx];
+}
+
+static void
+fcb_erase_work_handler(struct k_work *work)
+{
+	struct fcb *fcb = CONTAINER_OF(work, struct fcb, f_erase_work);
+	struct flash_sector *sector;
+	int rc;
+
+	k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (fcb->f_erase_pending == 0U || fcb->f_erasing) {
+		k_mutex_unlock(&fcb->f_mtx);
+		return;
+	}
+	sector = fcb_first_pending_sector(fcb);
+	fcb->f_erasing = true;
+	k_mutex_unlock(&fcb->f_mtx);
+
+	/* Appends to the active sector carry on while erasing */
+	rc = fcb_erase_sector(fcb, sector);
+
+	k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	fcb->f_erasing = false;
+	if (rc == 0) {
+		fcb->f_erase_pending--;
+	}
+	k_condvar_broadcast(&fcb->f_erase_cond);
+	if (rc == 0 && fcb->f_erase_pending > 0U) {
+		(void)k_work_submit_to_queue(&fcb_erase_workq, &fcb->f_erase_work);
+	}
+	k_mutex_unlock(&fcb->f_mtx);
+}
+
+/**
+ * Drop the sector preceding the oldest one, it gets erased in the background.
+ * Called with the fcb lock held.
+ */
+void
+fcb_sector_drop(struct fcb *fcb)
+{
+	fcb->f_erase_pending++;
+	(void)k_work_submit_to_queue(&fcb_erase_workq, &fcb->f_erase_work);
+}
+
+/**
+ * Make sure that a sector about to be taken into use is erased.
+ * Called with the fcb lock held.
+ */
+int
+fcb_sector_prepare(struct fcb *fcb, struct flash_sector *sector)
+{
+	bool stalled = false;
+	int rc;
+
+	while (fcb->f_erase_pending > 0U && sector == fcb_first_pending_sector(fcb)) {
+		if (!stalled) {
+			atomic_inc(&fcb->f_erase_stalls);
+			stalled = true;
+		}
+
+		if (fcb->f_erasing) {
+			if (k_condvar_wait(&fcb->f_erase_cond, &fcb->f_mtx, FCB_ERASE_TIMEOUT)) {
+				return -EAGAIN;
+			}
+			continue;
+		}
+
+		if (CONFIG_FCB_BACKGROUND_ERASE_BUDGET_MS > 0) {
+			/* An erase does not fit in the budget */
+			(void)k_work_submit_to_queue(&fcb_erase_workq, &fcb->f_erase_work);
+			return -EAGAIN;
+		}
+
+		rc = fcb_erase_sector(fcb, sector);
+		if (rc) {
+			return rc;
+		}
+		fcb->f_erase_pending--;
+	}
+
+	return 0;
+}
+
+uint32_t
+fcb_erase_stall_count(struct fcb *fcb)
+{
+	return (uint32_t)atomic_get(&fcb->f_erase_stalls);
+}
+
+static int
+fcb_erase_workq_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "fcb_erase",
+	};
+
+	k_work_queue_start(&fcb_erase_workq, fcb_erase_stack,
+			   K_THREAD_STACK_SIZEOF(fcb_erase_stack),
+			   CONFIG_FCB_BACKGROUND_ERASE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(fcb_erase_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_FCB_BACKGROUND_ERASE */
+
 int
 fcb_init(int f_area_id, struct fcb *fcb)
 {
@@ -107,6 +237,18 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	struct k_work_sync sync;
+
+	/* Rotated sectors left over from a previous init are seen as data again */
+	(void)k_work_cancel_sync(&fcb->f_erase_work, &sync);
+	k_work_init(&fcb->f_erase_work, fcb_erase_work_handler);
+	k_condvar_init(&fcb->f_erase_cond);
+	atomic_clear(&fcb->f_erase_stalls);
+	fcb->f_erase_pending = 0U;
+	fcb->f_erasing = false;
+#endif
+
 	rc = flash_area_open(f_area_id, &fcb->fap);
 	if (rc != 0) {
 		return -EINVAL;
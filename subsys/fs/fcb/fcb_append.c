@@ -46,6 +46,12 @@ fcb_append_to_scratch(struct fcb *fcb)
 	if (!sector) {
 		return -ENOSPC;
 	}
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	rc = fcb_sector_prepare(fcb, sector);
+	if (rc) {
+		return rc;
+	}
+#endif
 	rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 	if (rc) {
 		return rc;
@@ -89,6 +95,12 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 			rc = -ENOSPC;
 			goto err;
 		}
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+		rc = fcb_sector_prepare(fcb, sector);
+		if (rc) {
+			goto err;
+		}
+#endif
 		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 		if (rc) {
 			goto err;
@@ -76,6 +76,11 @@ int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t i
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
 
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+void fcb_sector_drop(struct fcb *fcb);
+int fcb_sector_prepare(struct fcb *fcb, struct flash_sector *sector);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
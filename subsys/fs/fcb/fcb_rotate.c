@@ -19,17 +19,25 @@ fcb_rotate(struct fcb *fcb)
 		return -EINVAL;
 	}
 
+#ifndef CONFIG_FCB_BACKGROUND_ERASE
 	rc = fcb_erase_sector(fcb, fcb->f_oldest);
 	if (rc) {
 		rc = -EIO;
 		goto out;
 	}
+#endif
 	if (fcb->f_oldest == fcb->f_active.fe_sector) {
 		/*
 		 * Need to create a new active area, as we're wiping
 		 * the current.
 		 */
 		sector = fcb_getnext_sector(fcb, fcb->f_oldest);
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+		rc = fcb_sector_prepare(fcb, sector);
+		if (rc) {
+			goto out;
+		}
+#endif
 		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
 		if (rc) {
 			goto out;
@@ -39,6 +47,9 @@ fcb_rotate(struct fcb *fcb)
 		fcb->f_active_id++;
 	}
 	fcb->f_oldest = fcb_getnext_sector(fcb, fcb->f_oldest);
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	fcb_sector_drop(fcb);
+#endif
 out:
 	k_mutex_unlock(&fcb->f_mtx);
 	return rc;
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+#include "fs_dentry_cache.h"
+
+#define CACHE_SIZE   CONFIG_FILE_SYSTEM_DENTRY_CACHE_SIZE
+#define NAME_LEN     CONFIG_FILE_SYSTEM_DENTRY_CACHE_NAME_LEN
+#define NUM_BUCKETS  CACHE_SIZE
+
+struct dentry_cache_entry {
+	sys_dnode_t lru_node;
+	sys_dnode_t hash_node;
+	const void *fs; /* NULL if entry is unused */
+	uint32_t parent;
+	struct fs_dentry dentry;
+	uint8_t name_len;
+	char name[NAME_LEN];
+};
+
+static struct dentry_cache_entry entries[CACHE_SIZE];
+static sys_dlist_t buckets[NUM_BUCKETS];
+/* Most recently used entries first, unused ones last */
+static sys_dlist_t lru;
+static bool initialized;
+static struct k_spinlock lock;
+
+static uint32_t dentry_hash(const void *fs, uint32_t parent, const char *name, size_t len)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U ^ (uint32_t)(uintptr_t)fs;
+
+	hash = (hash ^ parent) * 16777619U;
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ (uint8_t)name[i]) * 16777619U;
+	}
+
+	return hash % NUM_BUCKETS;
+}
+
+static void dentry_cache_init(void)
+{
+	sys_dlist_init(&lru);
+	for (size_t i = 0; i < NUM_BUCKETS; i++) {
+		sys_dlist_init(&buckets[i]);
+	}
+
+	for (size_t i = 0; i < CACHE_SIZE; i++) {
+		sys_dnode_init(&entries[i].hash_node);
+		sys_dlist_append(&lru, &entries[i].lru_node);
+	}
+
+	initialized = true;
+}
+
+static struct dentry_cache_entry *dentry_find(const void *fs, uint32_t parent, const char *name,
+					      size_t len)
+{
+	struct dentry_cache_entry *entry;
+	sys_dlist_t *bucket = &buckets[dentry_hash(fs, parent, name, len)];
+
+	SYS_DLIST_FOR_EACH_CONTAINER(bucket, entry, hash_node) {
+		if (entry->fs == fs && entry->parent == parent && entry->name_len == len &&
+		    memcmp(entry->name, name, len) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void dentry_release(struct dentry_cache_entry *entry)
+{
+	entry->fs = NULL;
+	if (sys_dnode_is_linked(&entry->hash_node)) {
+		sys_dlist_remove(&entry->hash_node);
+	}
+	sys_dlist_remove(&entry->lru_node);
+	sys_dlist_append(&lru, &entry->lru_node);
+}
+
+bool fs_dentry_cache_lookup(const void *fs, uint32_t parent, const char *name,
+			    size_t len, struct fs_dentry *dentry)
+{
+	struct dentry_cache_entry *entry = NULL;
+	k_spinlock_key_t key;
+
+	if (len > NAME_LEN) {
+		return false;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (initialized) {
+		entry = dentry_find(fs, parent, name, len);
+	}
+
+	if (entry != NULL) {
+		*dentry = entry->dentry;
+		sys_dlist_remove(&entry->lru_node);
+		sys_dlist_prepend(&lru, &entry->lru_node);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return entry != NULL;
+}
+
+void fs_dentry_cache_add(const void *fs, uint32_t parent, const char *name,
+			 size_t len, const struct fs_dentry *dentry)
+{
+	struct dentry_cache_entry *entry;
+	k_spinlock_key_t key;
+
+	if (len > NAME_LEN) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (!initialized) {
+		dentry_cache_init();
+	}
+
+	entry = dentry_find(fs, parent, name, len);
+	if (entry == NULL) {
+		/* Reuse the least recently used entry */
+		entry = CONTAINER_OF(sys_dlist_peek_tail(&lru), struct dentry_cache_entry,
+				     lru_node);
+		if (sys_dnode_is_linked(&entry->hash_node)) {
+			sys_dlist_remove(&entry->hash_node);
+		}
+
+		entry->fs = fs;
+		entry->parent = parent;
+		entry->name_len = len;
+		memcpy(entry->name, name, len);
+		sys_dlist_append(&buckets[dentry_hash(fs, parent, name, len)], &entry->hash_node);
+	}
+
+	entry->dentry = *dentry;
+	sys_dlist_remove(&entry->lru_node);
+	sys_dlist_prepend(&lru, &entry->lru_node);
+
+	k_spin_unlock(&lock, key);
+}
+
+void fs_dentry_cache_invalidate_dir(const void *fs, uint32_t parent)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; initialized && i < CACHE_SIZE; i++) {
+		if (entries[i].fs == fs && entries[i].parent == parent) {
+			dentry_release(&entries[i]);
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void fs_dentry_cache_invalidate(const void *fs)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; initialized && i < CACHE_SIZE; i++) {
+		if (entries[i].fs == fs) {
+			dentry_release(&entries[i]);
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Directory entry cache shared by filesystem implementations. */
+
+#ifndef ZEPHYR_SUBSYS_FS_FS_DENTRY_CACHE_H_
+#define ZEPHYR_SUBSYS_FS_FS_DENTRY_CACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/fs/fs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Location of a directory entry on the storage.
+ *
+ * The meaning of @c loc and @c offset is up to the filesystem, e.g. the
+ * inode number of the entry and its offset in the parent directory.
+ */
+struct fs_dentry {
+	uint32_t loc;
+	uint32_t offset;
+	enum fs_dir_entry_type type;
+};
+
+#if defined(CONFIG_FILE_SYSTEM_DENTRY_CACHE)
+
+/**
+ * @brief Look up a path component.
+ *
+ * @param fs filesystem instance owning the entry
+ * @param parent location of the parent directory
+ * @param name name of the entry, not necessarily NUL terminated
+ * @param len length of @p name
+ * @param dentry the cached entry is written here when found
+ *
+ * @return true if the entry is cached, false otherwise.
+ */
+bool fs_dentry_cache_lookup(const void *fs, uint32_t parent, const char *name,
+			    size_t len, struct fs_dentry *dentry);
+
+/**
+ * @brief Add a path component, replacing the least recently used entry
+ * when the cache is full.
+ *
+ * Names longer than CONFIG_FILE_SYSTEM_DENTRY_CACHE_NAME_LEN are not cached.
+ */
+void fs_dentry_cache_add(const void *fs, uint32_t parent, const char *name,
+			 size_t len, const struct fs_dentry *dentry);
+
+/**
+ * @brief Drop all the cached entries of a directory.
+ *
+ * To be called whenever entries are removed, renamed or moved in @p parent.
+ */
+void fs_dentry_cache_invalidate_dir(const void *fs, uint32_t parent);
+
+/**
+ * @brief Drop all the cached entries of a filesystem instance.
+ *
+ * To be called when the filesystem is unmounted.
+ */
+void fs_dentry_cache_invalidate(const void *fs);
+
+#else
+
+static inline bool fs_dentry_cache_lookup(const void *fs, uint32_t parent, const char *name,
+					  size_t len, struct fs_dentry *dentry)
+{
+	return false;
+}
+
+static inline void fs_dentry_cache_add(const void *fs, uint32_t parent, const char *name,
+				       size_t len, const struct fs_dentry *dentry)
+{
+}
+
+static inline void fs_dentry_cache_invalidate_dir(const void *fs, uint32_t parent)
+{
+}
+
+static inline void fs_dentry_cache_invalidate(const void *fs)
+{
+}
+
+#endif /* CONFIG_FILE_SYSTEM_DENTRY_CACHE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SUBSYS_FS_FS_DENTRY_CACHE_H_ */
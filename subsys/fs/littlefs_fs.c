@@ -185,16 +185,108 @@ static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	struct fs_littlefs *fs = CONTAINER_OF(c, struct fs_littlefs, cfg);
+
+	if (block < CONFIG_FS_LITTLEFS_ERASE_AHEAD_MAX_BLOCKS) {
+		atomic_clear_bit(fs->erased, block);
+	}
+#endif
+
 	int rc = flash_area_write(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
 }
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+static K_THREAD_STACK_DEFINE(erase_ahead_stack, CONFIG_FS_LITTLEFS_ERASE_AHEAD_STACK_SIZE);
+static struct k_work_q erase_ahead_workq;
+
+/* Blocks in use found by the last traversal, only used by the work queue */
+static ATOMIC_DEFINE(erase_ahead_used, CONFIG_FS_LITTLEFS_ERASE_AHEAD_MAX_BLOCKS);
+
+static void erase_ahead_schedule(struct fs_littlefs *fs)
+{
+	k_work_schedule_for_queue(&erase_ahead_workq, &fs->erase_work,
+				  K_MSEC(CONFIG_FS_LITTLEFS_ERASE_AHEAD_DELAY_MS));
+}
+
+static int erase_ahead_mark_used(void *data, lfs_block_t block)
+{
+	if (block < CONFIG_FS_LITTLEFS_ERASE_AHEAD_MAX_BLOCKS) {
+		atomic_set_bit(erase_ahead_used, block);
+	}
+
+	return 0;
+}
+
+/* Erase one free block per run, so that file operations are not held off
+ * for longer than a single erase.
+ */
+static void erase_ahead_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct fs_littlefs *fs = CONTAINER_OF(dwork, struct fs_littlefs, erase_work);
+	lfs_block_t count;
+	lfs_block_t block;
+	int rc;
+
+	fs_lock(fs);
+
+	if (fs->backend == NULL) {
+		fs_unlock(fs);
+		return;
+	}
+
+	count = MIN(fs->cfg.block_count, CONFIG_FS_LITTLEFS_ERASE_AHEAD_MAX_BLOCKS);
+	block = count;
+
+	memset(erase_ahead_used, 0, sizeof(erase_ahead_used));
+	rc = lfs_fs_traverse(&fs->lfs, erase_ahead_mark_used, NULL);
+	if (rc >= 0) {
+		for (block = 0; block < count; block++) {
+			if (!atomic_test_bit(erase_ahead_used, block) &&
+			    !atomic_test_bit(fs->erased, block)) {
+				break;
+			}
+		}
+	}
+
+	if (block < count) {
+		rc = flash_area_erase(fs->backend, block * fs->cfg.block_size,
+				      fs->cfg.block_size);
+		if (rc == 0) {
+			atomic_set_bit(fs->erased, block);
+		} else {
+			LOG_WRN("erase ahead of block %u failed: %d", block, rc);
+		}
+	}
+
+	fs_unlock(fs);
+
+	if (block < count && rc == 0) {
+		k_work_schedule_for_queue(&erase_ahead_workq, dwork, K_NO_WAIT);
+	}
+}
+#endif /* CONFIG_FS_LITTLEFS_ERASE_AHEAD */
+
 static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 {
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size;
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	struct fs_littlefs *fs = CONTAINER_OF(c, struct fs_littlefs, cfg);
+
+	/* Replace the block taken by littlefs */
+	erase_ahead_schedule(fs);
+
+	if (block < CONFIG_FS_LITTLEFS_ERASE_AHEAD_MAX_BLOCKS &&
+	    atomic_test_and_clear_bit(fs->erased, block)) {
+		return LFS_ERR_OK;
+	}
+#endif
+
 	int rc = flash_area_erase(fa, offset, c->block_size);
 
 	return errno_to_lfs(rc);
@@ -347,6 +439,12 @@ static int littlefs_unlink(struct fs_mount_t *mountp, const char *path)
 
 	int ret = lfs_remove(&fs->lfs, path);
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	if (ret == 0 && !littlefs_on_blkdev(mountp->flags)) {
+		erase_ahead_schedule(fs);
+	}
+#endif
+
 	fs_unlock(fs);
 	return lfs_to_errno(ret);
 }
@@ -432,6 +530,12 @@ static int littlefs_truncate(struct fs_file_t *fp, off_t length)
 
 	int ret = lfs_file_truncate(&fs->lfs, LFS_FILEP(fp), length);
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	if (ret == 0 && !littlefs_on_blkdev(fp->mp->flags)) {
+		erase_ahead_schedule(fs);
+	}
+#endif
+
 	fs_unlock(fs);
 	return lfs_to_errno(ret);
 }
@@ -889,6 +993,11 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 	k_mutex_init(&fs->mutex);
 	fs_lock(fs);
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	k_work_init_delayable(&fs->erase_work, erase_ahead_handler);
+	memset(fs->erased, 0, sizeof(fs->erased));
+#endif
+
 	ret = littlefs_init_fs(fs, mountp->storage_dev, mountp->flags);
 	if (ret < 0) {
 		goto out;
@@ -925,6 +1034,12 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 
 	LOG_INF("%s mounted", mountp->mnt_point);
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	if (!littlefs_on_blkdev(mountp->flags)) {
+		erase_ahead_schedule(fs);
+	}
+#endif
+
 out:
 	if (ret < 0) {
 		fs->backend = NULL;
@@ -954,6 +1069,12 @@ static int littlefs_mkfs(uintptr_t dev_id, void *cfg, int flags)
 	k_mutex_init(&fs->mutex);
 	fs_lock(fs);
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	/* Erases of the format queue work that finds nothing mounted */
+	k_work_init_delayable(&fs->erase_work, erase_ahead_handler);
+	memset(fs->erased, 0, sizeof(fs->erased));
+#endif
+
 	ret = littlefs_init_fs(fs, UINT_TO_POINTER(dev_id), flags);
 	if (ret < 0) {
 		goto out;
@@ -977,6 +1098,13 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 {
 	struct fs_littlefs *fs = mountp->fs_data;
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	struct k_work_sync sync;
+
+	/* The work takes the lock itself */
+	k_work_cancel_delayable_sync(&fs->erase_work, &sync);
+#endif
+
 	fs_lock(fs);
 
 	lfs_unmount(&fs->lfs);
@@ -1045,6 +1173,7 @@ static struct fs_littlefs fs_data_##inst = { \
 		.prog_size = DT_INST_PROP(inst, prog_size), \
 		.cache_size = DT_INST_PROP(inst, cache_size), \
 		.lookahead_size = DT_INST_PROP(inst, lookahead_size), \
+		.block_cycles = DT_INST_PROP(inst, block_cycles), \
 		.read_buffer = read_buffer_##inst, \
 		.prog_buffer = prog_buffer_##inst, \
 		.lookahead_buffer = lookahead_buffer_##inst, \
@@ -1085,6 +1214,13 @@ static int littlefs_init(void)
 		DT_INST_FOREACH_STATUS_OKAY(REFERENCE_MOUNT)
 	};
 
+#ifdef CONFIG_FS_LITTLEFS_ERASE_AHEAD
+	k_work_queue_start(&erase_ahead_workq, erase_ahead_stack,
+			   K_THREAD_STACK_SIZEOF(erase_ahead_stack),
+			   CONFIG_FS_LITTLEFS_ERASE_AHEAD_PRIORITY, NULL);
+	k_thread_name_set(&erase_ahead_workq.thread, "lfs_erase");
+#endif
+
 	int rc = fs_register(FS_LITTLEFS, &littlefs_fs);
 
 	if (rc == 0) {
@@ -11,6 +11,7 @@
 #include <inttypes.h>
 #include <zephyr/fs/nvs.h>
 #include <zephyr/sys/crc.h>
+#include <zephyr/init.h>
 #include "nvs_priv.h"
 
 #include <zephyr/logging/log.h>
@@ -19,9 +20,7 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_id_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +32,14 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -84,6 +90,149 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_INDEX
+
+/* The index is an open addressing hash table with linear probing which maps
+ * every stored ID to the address of its most recent valid ATE.
+ */
+
+static inline size_t nvs_index_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_INDEX_SIZE;
+}
+
+static inline size_t nvs_index_dist(size_t from, size_t to)
+{
+	return (to + CONFIG_NVS_INDEX_SIZE - from) % CONFIG_NVS_INDEX_SIZE;
+}
+
+/* Returns the slot holding id, the free slot where it belongs, or
+ * CONFIG_NVS_INDEX_SIZE when it is neither stored nor fits.
+ */
+static size_t nvs_index_slot(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_index_pos(id);
+
+	for (size_t i = 0; i < CONFIG_NVS_INDEX_SIZE; i++) {
+		if (fs->index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR ||
+		    fs->index_id[pos] == id) {
+			return pos;
+		}
+		pos = (pos + 1) % CONFIG_NVS_INDEX_SIZE;
+	}
+
+	return CONFIG_NVS_INDEX_SIZE;
+}
+
+static void nvs_index_clear(struct nvs_fs *fs)
+{
+	memset(fs->index_addr, 0xff, sizeof(fs->index_addr));
+	fs->index_overflow = false;
+}
+
+static void nvs_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr, bool overwrite)
+{
+	size_t pos = nvs_index_slot(fs, id);
+
+	if (pos == CONFIG_NVS_INDEX_SIZE) {
+		/* From now on IDs missing from the index have to be searched for */
+		if (!fs->index_overflow) {
+			LOG_WRN("NVS index full, increase CONFIG_NVS_INDEX_SIZE");
+		}
+		fs->index_overflow = true;
+		return;
+	}
+
+	if (overwrite || fs->index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR) {
+		fs->index_addr[pos] = addr;
+		fs->index_id[pos] = id;
+	}
+}
+
+/* Returns the address to start searching for id from, NVS_LOOKUP_CACHE_NO_ADDR
+ * when id is not stored.
+ */
+static uint32_t nvs_index_lookup(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_index_slot(fs, id);
+
+	if (pos < CONFIG_NVS_INDEX_SIZE && fs->index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR) {
+		return fs->index_addr[pos];
+	}
+
+	return fs->index_overflow ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+/* Free a slot, moving back the entries which probed past it */
+static void nvs_index_remove(struct nvs_fs *fs, size_t hole)
+{
+	size_t pos = hole;
+
+	for (size_t i = 1; i < CONFIG_NVS_INDEX_SIZE; i++) {
+		pos = (pos + 1) % CONFIG_NVS_INDEX_SIZE;
+		if (fs->index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR) {
+			break;
+		}
+
+		if (nvs_index_dist(nvs_index_pos(fs->index_id[pos]), pos) >=
+		    nvs_index_dist(hole, pos)) {
+			fs->index_addr[hole] = fs->index_addr[pos];
+			fs->index_id[hole] = fs->index_id[pos];
+			hole = pos;
+		}
+	}
+
+	fs->index_addr[hole] = NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static int nvs_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	nvs_index_clear(fs);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		/* Newest ATEs come first, keep the indexed ones */
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate)) {
+			nvs_index_set(fs, ate.id, ate_addr, false);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t pos = 0;
+
+	while (pos < CONFIG_NVS_INDEX_SIZE) {
+		if (fs->index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->index_addr[pos] >> ADDR_SECT_SHIFT) == sector) {
+			/* The slot gets refilled, check it again */
+			nvs_index_remove(fs, pos);
+			continue;
+		}
+		pos++;
+	}
+}
+
+#endif /* CONFIG_NVS_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -168,6 +317,10 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#elif defined(CONFIG_NVS_INDEX)
+	if (!rc && entry->id != 0xFFFF) {
+		nvs_index_set(fs, entry->id, fs->ate_wra, true);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -292,22 +445,17 @@ static int nvs_flash_block_move(struct nvs_fs *fs, uint32_t addr, size_t len)
 /* erase a sector and verify erase was OK.
  * return 0 if OK, errorcode on error.
  */
-static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
+static int nvs_flash_erase_verify(struct nvs_fs *fs, uint32_t addr)
 {
 	int rc;
 	off_t offset;
 
-	addr &= ADDR_SECT_MASK;
-
 	offset = fs->offset;
 	offset += fs->sector_size * (addr >> ADDR_SECT_SHIFT);
 
 	LOG_DBG("Erasing flash at %lx, len %d", (long int) offset,
 		fs->sector_size);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
-#endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
 	if (rc) {
@@ -322,6 +470,24 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	return rc;
 }
 
+static void nvs_sector_invalidate(struct nvs_fs *fs, uint32_t addr)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#elif defined(CONFIG_NVS_INDEX)
+	nvs_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+}
+
+static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
+{
+	addr &= ADDR_SECT_MASK;
+
+	nvs_sector_invalidate(fs, addr);
+
+	return nvs_flash_erase_verify(fs, addr);
+}
+
 /* crc update on allocation entry */
 static void nvs_ate_crc8_update(struct nvs_ate *entry)
 {
@@ -581,9 +747,12 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
- * sector.
+ * sector. The data which is still needed is moved to the new sector, the gc'ed
+ * sector is returned in sec_addr for the caller to erase. done_ate is set when
+ * the gc done ate could be written, meaning that the erase may be completed
+ * later without losing the data written meanwhile after a restart.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_compact(struct nvs_fs *fs, uint32_t *gc_sec_addr, bool *done_ate)
 {
 	int rc;
 	struct nvs_ate close_ate, gc_ate, wlk_ate;
@@ -597,6 +766,9 @@ static int nvs_gc(struct nvs_fs *fs)
 	nvs_sector_advance(fs, &sec_addr);
 	gc_addr = sec_addr + fs->sector_size - ate_size;
 
+	*gc_sec_addr = sec_addr;
+	*done_ate = false;
+
 	/* if the sector is not closed don't do gc */
 	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
 	if (rc < 0) {
@@ -635,6 +807,12 @@ static int nvs_gc(struct nvs_fs *fs)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
 
+		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+			wlk_addr = fs->ate_wra;
+		}
+#elif defined(CONFIG_NVS_INDEX)
+		wlk_addr = nvs_index_lookup(fs, gc_ate.id);
+
 		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_addr = fs->ate_wra;
 		}
@@ -696,6 +874,24 @@ gc_done:
 		if (rc) {
 			return rc;
 		}
+		*done_ate = true;
+	}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	fs->gc_free = (uint16_t)(fs->ate_wra - fs->data_wra);
+#endif
+	return 0;
+}
+
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t sec_addr;
+	bool done_ate;
+
+	rc = nvs_gc_compact(fs, &sec_addr, &done_ate);
+	if (rc) {
+		return rc;
 	}
 
 	/* Erase the gc'ed sector */
@@ -706,6 +902,122 @@ gc_done:
 	return 0;
 }
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+
+#if CONFIG_NVS_BACKGROUND_GC_WRITE_BUDGET_MS > 0
+#define NVS_WRITE_TIMEOUT K_MSEC(CONFIG_NVS_BACKGROUND_GC_WRITE_BUDGET_MS)
+#else
+#define NVS_WRITE_TIMEOUT K_FOREVER
+#endif
+
+static K_THREAD_STACK_DEFINE(nvs_gc_stack, CONFIG_NVS_BACKGROUND_GC_STACK_SIZE);
+static struct k_work_q nvs_gc_workq;
+
+/* Is the write sector running out of space while the last gc left enough of
+ * it? If it did not, the file system is nearly full and moving on to the next
+ * sector early would only wear the flash.
+ */
+static bool nvs_gc_wanted(struct nvs_fs *fs)
+{
+	uint32_t threshold = fs->sector_size * CONFIG_NVS_BACKGROUND_GC_THRESHOLD / 100U;
+
+	return !fs->gc_erasing && (fs->ate_wra - fs->data_wra) < threshold &&
+	       fs->gc_free >= threshold;
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	uint32_t sec_addr;
+	bool done_ate = false;
+	int rc = 0;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->ready || fs->gc_erasing || (!fs->gc_request && !nvs_gc_wanted(fs))) {
+		goto end;
+	}
+
+	if (fs->gc_request) {
+		fs->gc_forced++;
+		fs->gc_request = false;
+	}
+
+	LOG_DBG("Background gc of the sector after %d", fs->ate_wra >> ADDR_SECT_SHIFT);
+
+	rc = nvs_sector_close(fs);
+	if (rc == 0) {
+		rc = nvs_gc_compact(fs, &sec_addr, &done_ate);
+	}
+	if (rc) {
+		LOG_ERR("Background gc failed: %d", rc);
+		goto end;
+	}
+
+	nvs_sector_invalidate(fs, sec_addr);
+
+	if (!done_ate) {
+		/* Without the gc done ate a restart would redo the gc and drop
+		 * the data written in the meantime, so finish it right away.
+		 */
+		rc = nvs_flash_erase_verify(fs, sec_addr);
+		goto end;
+	}
+
+	/* Writers may keep using the write sector while the old one is erased,
+	 * those which need the next sector wait for the erase to complete.
+	 */
+	fs->gc_erasing = true;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	rc = nvs_flash_erase_verify(fs, sec_addr);
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	fs->gc_erasing = false;
+	k_condvar_broadcast(&fs->gc_cond);
+
+end:
+	if (rc) {
+		LOG_ERR("Background erase failed: %d", rc);
+	}
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+/* Wait for a background erase of the sector after the write sector, to be called
+ * with the lock held.
+ */
+static int nvs_gc_wait_erase(struct nvs_fs *fs, k_timeout_t timeout)
+{
+	while (fs->gc_erasing) {
+		if (k_condvar_wait(&fs->gc_cond, &fs->nvs_lock, timeout)) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+uint32_t nvs_gc_stall_count(struct nvs_fs *fs)
+{
+	return (uint32_t)atomic_get(&fs->gc_stalls);
+}
+
+static int nvs_gc_workq_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nvs_gc",
+	};
+
+	k_work_queue_start(&nvs_gc_workq, nvs_gc_stack, K_THREAD_STACK_SIZEOF(nvs_gc_stack),
+			   CONFIG_NVS_BACKGROUND_GC_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -721,6 +1033,14 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_INDEX
+	/* Until it is rebuilt the index only holds what gets written during
+	 * startup, everything else has to be searched for.
+	 */
+	nvs_index_clear(fs);
+	fs->index_overflow = true;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -914,6 +1234,10 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#elif defined(CONFIG_NVS_INDEX)
+	if (!rc) {
+		rc = nvs_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -991,6 +1315,16 @@ int nvs_mount(struct nvs_fs *fs)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	k_condvar_init(&fs->gc_cond);
+	atomic_clear(&fs->gc_stalls);
+	fs->gc_free = fs->sector_size;
+	fs->gc_forced = 0U;
+	fs->gc_request = false;
+	fs->gc_erasing = false;
+#endif
+
 	rc = nvs_startup(fs);
 	if (rc) {
 		return rc;
@@ -1040,6 +1374,12 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#elif defined(CONFIG_NVS_INDEX)
+	wlk_addr = nvs_index_lookup(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
 	}
@@ -1063,7 +1403,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_INDEX)
 no_cached_entry:
 #endif
 
@@ -1101,7 +1441,15 @@ no_cached_entry:
 		required_space = data_size + ate_size;
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (k_mutex_lock(&fs->nvs_lock, NVS_WRITE_TIMEOUT)) {
+		/* Most likely held by a background gc */
+		atomic_inc(&fs->gc_stalls);
+		return -EAGAIN;
+	}
+#else
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+#endif
 
 	gc_count = 0;
 	while (1) {
@@ -1122,6 +1470,31 @@ no_cached_entry:
 			break;
 		}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		if (gc_count == 0) {
+			atomic_inc(&fs->gc_stalls);
+		}
+
+		rc = nvs_gc_wait_erase(fs, NVS_WRITE_TIMEOUT);
+		if (rc) {
+			goto end;
+		}
+
+		if (CONFIG_NVS_BACKGROUND_GC_WRITE_BUDGET_MS > 0) {
+			/* A gc does not fit in the budget, leave it to the
+			 * background and let the writer retry.
+			 */
+			if (fs->gc_forced >= fs->sector_count) {
+				rc = -ENOSPC;
+				goto end;
+			}
+			fs->gc_request = true;
+			(void)k_work_submit_to_queue(&nvs_gc_workq, &fs->gc_work);
+			rc = -EAGAIN;
+			goto end;
+		}
+#endif
+
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
@@ -1134,6 +1507,12 @@ no_cached_entry:
 		}
 		gc_count++;
 	}
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	fs->gc_forced = 0U;
+	if (nvs_gc_wanted(fs)) {
+		(void)k_work_submit_to_queue(&nvs_gc_workq, &fs->gc_work);
+	}
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -1170,6 +1549,13 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#elif defined(CONFIG_NVS_INDEX)
+	wlk_addr = nvs_index_lookup(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
 		goto err;
@@ -1226,6 +1612,9 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	struct nvs_ate step_ate, wlk_ate;
 	uint32_t step_addr, wlk_addr;
 	size_t ate_size, free_space;
+#ifdef CONFIG_NVS_INDEX
+	uint32_t step_ate_addr;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1242,11 +1631,29 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	step_addr = fs->ate_wra;
 
 	while (1) {
+#ifdef CONFIG_NVS_INDEX
+		step_ate_addr = step_addr;
+#endif
 		rc = nvs_prev_ate(fs, &step_addr, &step_ate);
 		if (rc) {
 			return rc;
 		}
 
+#ifdef CONFIG_NVS_INDEX
+		if (!fs->index_overflow) {
+			/* The index tells whether this is the most recent ATE of its ID */
+			if (step_ate.id != 0xFFFF && step_ate.len && nvs_ate_valid(fs, &step_ate) &&
+			    nvs_index_lookup(fs, step_ate.id) == step_ate_addr) {
+				free_space -= nvs_al_size(fs, step_ate.len);
+				free_space -= ate_size;
+			}
+
+			if (step_addr == fs->ate_wra) {
+				break;
+			}
+			continue;
+		}
+#endif
 		wlk_addr = fs->ate_wra;
 
 		while (1) {
@@ -1,5 +1,6 @@
 /*
  * Copyright 2023 Google LLC
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -59,6 +60,105 @@ int input_report(const struct device *dev,
 
 #ifdef CONFIG_INPUT_MODE_THREAD
 
+#ifdef CONFIG_INPUT_EVENT_GROUPS
+
+/* Events gathered so far, all reported by the same device */
+static struct input_event group[CONFIG_INPUT_EVENT_GROUP_MAX_EVENTS];
+static size_t group_len;
+/* Set once the group has got its sync event */
+static bool group_synced;
+
+static void input_group_flush(void)
+{
+	if (group_len == 0) {
+		return;
+	}
+
+	group[group_len - 1].sync = group_synced;
+
+	STRUCT_SECTION_FOREACH(input_group_callback, callback) {
+		if (callback->dev == NULL || callback->dev == group[0].dev) {
+			callback->callback(group, group_len);
+		}
+	}
+
+	group_len = 0;
+	group_synced = false;
+}
+
+/* Whether the group listeners fall behind the devices */
+static bool input_group_behind(void)
+{
+	uint32_t used = k_msgq_num_used_get(&input_msgq);
+
+	return IS_ENABLED(CONFIG_INPUT_EVENT_GROUP_COALESCE) &&
+	       used > 0 && used >= CONFIG_INPUT_QUEUE_MAX_MSGS / 2;
+}
+
+/* Replace the value of an absolute axis event already in the group */
+static bool input_group_coalesce(const struct input_event *evt)
+{
+	struct input_event *match = NULL;
+
+	if (evt->type != INPUT_EV_ABS) {
+		return false;
+	}
+
+	for (size_t i = 0; i < group_len; i++) {
+		if (group[i].type != INPUT_EV_ABS) {
+			continue;
+		}
+
+		/* Axis values only make sense along with their slot */
+		if (group[i].code == INPUT_ABS_MT_SLOT) {
+			return false;
+		}
+
+		if (group[i].code == evt->code) {
+			match = &group[i];
+		}
+	}
+
+	if (match == NULL) {
+		return false;
+	}
+
+	match->value = evt->value;
+
+	return true;
+}
+
+static void input_group_add(const struct input_event *evt)
+{
+	bool behind = input_group_behind();
+
+	if (group_len > 0 && (group[0].dev != evt->dev || (group_synced && !behind))) {
+		input_group_flush();
+	}
+
+	/* Merged with the next group otherwise */
+	group_synced = false;
+
+	if (!behind || evt->code == INPUT_ABS_MT_SLOT || !input_group_coalesce(evt)) {
+		if (group_len == ARRAY_SIZE(group)) {
+			input_group_flush();
+		}
+
+		group[group_len] = *evt;
+		group[group_len].sync = 0;
+		group_len++;
+	}
+
+	if (evt->sync) {
+		group_synced = true;
+		if (!behind) {
+			input_group_flush();
+		}
+	}
+}
+
+#endif /* CONFIG_INPUT_EVENT_GROUPS */
+
 static void input_thread(void)
 {
 	struct input_event evt;
@@ -72,6 +172,10 @@ static void input_thread(void)
 		}
 
 		input_process(&evt);
+
+#ifdef CONFIG_INPUT_EVENT_GROUPS
+		input_group_add(&evt);
+#endif
 	}
 }
 
@@ -122,6 +122,35 @@ static void submit_work_if_buffer_free_and_data_available(
 	submit_mbox_work(dev_data);
 }
 
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+static bool poll_data_available(struct icmsg_data_t *dev_data)
+{
+	const uint32_t start = k_cycle_get_32();
+	const uint32_t poll_cyc = k_us_to_cyc_ceil32(CONFIG_IPC_SERVICE_ICMSG_RX_POLL_TIME_US);
+
+	do {
+		if (data_available(dev_data)) {
+			return true;
+		}
+	} while (k_cycle_get_32() - start < poll_cyc);
+
+	return false;
+}
+
+static void rx_poll_set(struct icmsg_data_t *dev_data, bool polling)
+{
+	if (dev_data->rx_polling == polling) {
+		return;
+	}
+
+	/* Not all mbox drivers can disable the RX interrupt, then it just fires
+	 * and resubmits the work meanwhile.
+	 */
+	(void)mbox_set_enabled_dt(&dev_data->cfg->mbox_rx, !polling);
+	dev_data->rx_polling = polling;
+}
+#endif
+
 static void mbox_callback_process(struct k_work *item)
 {
 	struct icmsg_data_t *dev_data = CONTAINER_OF(item, struct icmsg_data_t, mbox_work);
@@ -132,6 +161,10 @@ static void mbox_callback_process(struct k_work *item)
 
 	if (len == 0) {
 		/* Unlikely, no data in buffer. */
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+		rx_poll_set(dev_data, false);
+		submit_work_if_buffer_free_and_data_available(dev_data);
+#endif
 		return;
 	}
 
@@ -163,6 +196,22 @@ static void mbox_callback_process(struct k_work *item)
 		atomic_set(&dev_data->state, ICMSG_STATE_READY);
 	}
 
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	if (poll_data_available(dev_data)) {
+		/* Messages are coming in quick succession, poll for the next ones
+		 * rather than taking an interrupt for each of them.
+		 */
+		rx_poll_set(dev_data, true);
+		submit_mbox_work(dev_data);
+		return;
+	}
+
+	/* Traffic stopped, wait for the interrupt again. Messages received before
+	 * it is enabled are caught below.
+	 */
+	rx_poll_set(dev_data, false);
+#endif
+
 	submit_work_if_buffer_free_and_data_available(dev_data);
 }
 
@@ -180,6 +229,9 @@ static int mbox_init(const struct icmsg_config_t *conf,
 
 	k_work_init(&dev_data->mbox_work, mbox_callback_process);
 	k_work_init_delayable(&dev_data->notify_work, notify_process);
+#ifdef CONFIG_IPC_SERVICE_ICMSG_RX_POLL
+	dev_data->rx_polling = false;
+#endif
 
 	err = mbox_register_callback_dt(&conf->mbox_rx, mbox_callback, dev_data);
 	if (err != 0) {
@@ -265,6 +317,8 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	int write_ret;
 	int release_ret;
 	int sent_bytes;
+	uint32_t prev_wr_idx;
+	bool notify = true;
 
 	if (!is_endpoint_ready(dev_data)) {
 		return -EBUSY;
@@ -280,7 +334,14 @@ int icmsg_send(const struct icmsg_config_t *conf,
 		return -ENOBUFS;
 	}
 
+	prev_wr_idx = dev_data->tx_pb->data.wr_idx;
 	write_ret = pbuf_write(dev_data->tx_pb, msg, len);
+	if (IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_NOTIFY_BATCH) && write_ret > 0) {
+		/* The remote reads until its queue is empty, so it only has to be
+		 * signalled when it has read everything written before this message.
+		 */
+		notify = pbuf_rd_idx_get(dev_data->tx_pb) == prev_wr_idx;
+	}
 	release_ret = release_tx_buffer(dev_data);
 	__ASSERT_NO_MSG(!release_ret);
 
@@ -293,9 +354,11 @@ int icmsg_send(const struct icmsg_config_t *conf,
 
 	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
 
-	ret = mbox_send_dt(&conf->mbox_tx, NULL);
-	if (ret) {
-		return ret;
+	if (notify) {
+		ret = mbox_send_dt(&conf->mbox_tx, NULL);
+		if (ret) {
+			return ret;
+		}
 	}
 
 	return sent_bytes;
@@ -221,3 +221,13 @@ int pbuf_read(struct pbuf *pb, char *buf, uint16_t len)
 
 	return len;
 }
+
+uint32_t pbuf_rd_idx_get(struct pbuf *pb)
+{
+	/* Order the read of rd_idx after the update of wr_idx by the caller. */
+	__sync_synchronize();
+	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
+	__sync_synchronize();
+
+	return *(pb->cfg->rd_idx_loc);
+}
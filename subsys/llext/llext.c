@@ -17,6 +17,8 @@ LOG_MODULE_REGISTER(llext, CONFIG_LLEXT_LOG_LEVEL);
 
 #include <string.h>
 
+#include "llext_priv.h"
+
 #ifdef CONFIG_MMU_PAGE_SIZE
 #define LLEXT_PAGE_SIZE CONFIG_MMU_PAGE_SIZE
 #else
@@ -118,11 +120,7 @@ const void *llext_find_sym(const struct llext_symtable *sym_table, const char *s
 {
 	if (sym_table == NULL) {
 		/* Built-in symbol table */
-		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
-			if (strcmp(sym->name, sym_name) == 0) {
-				return sym->addr;
-			}
-		}
+		return llext_find_builtin_sym(sym_name);
 	} else {
 		/* find symbols in module */
 		for (size_t i = 0; i < sym_table->sym_cnt; i++) {
@@ -332,38 +330,19 @@ static void llext_init_mem_part(struct llext *ext, enum llext_mem mem_idx,
 #endif
 }
 
-static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
-			      enum llext_mem mem_idx)
+static int llext_alloc_section(struct llext *ext, enum llext_mem mem_idx, size_t size)
 {
-	int ret;
-
-	if (!ldr->sects[mem_idx].sh_size) {
-		return 0;
-	}
-	ext->mem_size[mem_idx] = ldr->sects[mem_idx].sh_size;
-
-	if (ldr->sects[mem_idx].sh_type != SHT_NOBITS &&
-	    IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE)) {
-		ext->mem[mem_idx] = llext_peek(ldr, ldr->sects[mem_idx].sh_offset);
-		if (ext->mem[mem_idx]) {
-			llext_init_mem_part(ext, mem_idx, (uintptr_t)ext->mem[mem_idx],
-				ldr->sects[mem_idx].sh_size);
-			ext->mem_on_heap[mem_idx] = false;
-			return 0;
-		}
-	}
-
 	/* On ARM with an MPU a pow(2, N)*32 sized and aligned region is needed,
 	 * otherwise its typically an mmu page (sized and aligned memory region)
 	 * we are after that we can assign memory permission bits on.
 	 */
 #ifndef CONFIG_ARM_MPU
-	const uintptr_t sect_alloc = ROUND_UP(ldr->sects[mem_idx].sh_size, LLEXT_PAGE_SIZE);
+	const uintptr_t sect_alloc = ROUND_UP(size, LLEXT_PAGE_SIZE);
 	const uintptr_t sect_align = LLEXT_PAGE_SIZE;
 #else
 	uintptr_t sect_alloc = LLEXT_PAGE_SIZE;
 
-	while (sect_alloc < ldr->sects[mem_idx].sh_size) {
+	while (sect_alloc < size) {
 		sect_alloc *= 2;
 	}
 	uintptr_t sect_align = sect_alloc;
@@ -382,6 +361,35 @@ static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
 	llext_init_mem_part(ext, mem_idx, (uintptr_t)ext->mem[mem_idx],
 		sect_alloc);
 
+	return 0;
+}
+
+static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
+			      enum llext_mem mem_idx)
+{
+	int ret;
+
+	if (!ldr->sects[mem_idx].sh_size) {
+		return 0;
+	}
+	ext->mem_size[mem_idx] = ldr->sects[mem_idx].sh_size;
+
+	if (ldr->sects[mem_idx].sh_type != SHT_NOBITS &&
+	    IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE)) {
+		ext->mem[mem_idx] = llext_peek(ldr, ldr->sects[mem_idx].sh_offset);
+		if (ext->mem[mem_idx]) {
+			llext_init_mem_part(ext, mem_idx, (uintptr_t)ext->mem[mem_idx],
+				ldr->sects[mem_idx].sh_size);
+			ext->mem_on_heap[mem_idx] = false;
+			return 0;
+		}
+	}
+
+	ret = llext_alloc_section(ext, mem_idx, ldr->sects[mem_idx].sh_size);
+	if (ret != 0) {
+		return ret;
+	}
+
 	if (ldr->sects[mem_idx].sh_type == SHT_NOBITS) {
 		memset(ext->mem[mem_idx], 0, ldr->sects[mem_idx].sh_size);
 	} else {
@@ -434,6 +442,278 @@ static int llext_copy_sections(struct llext_loader *ldr, struct llext *ext)
 	return 0;
 }
 
+/* How a relocation recorded in a pre-linked image is applied */
+enum llext_image_fixup_kind {
+	/* Relocation applied with arch_elf_relocate() */
+	LLEXT_IMAGE_FIXUP_ARCH,
+	/* Target address stored at the location, e.g. a GOT entry */
+	LLEXT_IMAGE_FIXUP_PTR,
+};
+
+#ifdef CONFIG_LLEXT_IMAGE
+/*
+ * A pre-linked image holds the contents of the allocated sections as they
+ * were before linking, followed by every relocation applied while linking
+ * with its target already resolved, and the exported symbols. Targets within
+ * the extension are stored relative to their section, targets in the base
+ * image as absolute addresses, which the fingerprint validates.
+ */
+#define LLEXT_IMAGE_MAGIC	0x4c4c5849 /* "LLXI" */
+#define LLEXT_IMAGE_VERSION	1
+
+struct llext_image_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t hdr_size;
+	uint32_t fingerprint;
+	uint32_t image_size;
+	uint32_t mem_size[LLEXT_MEM_PARTITIONS];
+	/* Bytes stored in the image, the rest of the section is zeroed */
+	uint32_t file_size[LLEXT_MEM_PARTITIONS];
+	uint32_t fixup_cnt;
+	uint32_t export_cnt;
+	uint32_t export_strings_size;
+};
+
+struct llext_image_fixup {
+	elf_rela_t rel;
+	/* Offset within tgt_mem, or an absolute address */
+	uintptr_t target;
+	/* Offset of the location within loc_mem */
+	uint32_t offset;
+	uint8_t loc_mem;
+	/* LLEXT_MEM_COUNT for absolute targets */
+	uint8_t tgt_mem;
+	uint8_t kind;
+};
+
+/* Followed by name_len bytes of the NUL terminated symbol name */
+struct llext_image_export {
+	uintptr_t target;
+	uint16_t name_len;
+	uint8_t tgt_mem;
+};
+
+struct llext_image_writer {
+	uint8_t *buf;
+	size_t size;
+	size_t pos;
+	struct llext_image_hdr hdr;
+	bool failed;
+};
+
+static void llext_image_fail(struct llext_image_writer *img)
+{
+	if (img && !img->failed) {
+		LOG_WRN("Cannot create a pre-linked image of the extension");
+		img->failed = true;
+	}
+}
+
+static void *llext_image_reserve(struct llext_image_writer *img, size_t len)
+{
+	void *p;
+
+	if (img->failed || img->size - img->pos < len) {
+		llext_image_fail(img);
+		return NULL;
+	}
+
+	p = img->buf + img->pos;
+	img->pos += len;
+
+	return p;
+}
+
+static struct llext_image_writer *llext_image_init(struct llext_image_writer *img,
+						   struct llext_load_param *ldr_parm)
+{
+	memset(img, 0, sizeof(*img));
+	img->buf = ldr_parm->image;
+	img->size = ldr_parm->image_size;
+
+	/* The header is written last, once all counts are known */
+	(void)llext_image_reserve(img, sizeof(img->hdr));
+
+	if (ldr_parm->pre_located) {
+		/* Symbols don't point into the loaded sections */
+		llext_image_fail(img);
+	}
+
+	return img;
+}
+
+/*
+ * Find the allocated section containing an address. A section end address
+ * is only matched if no section starts there, sections referenced in place
+ * in the ELF buffer can be adjacent.
+ */
+static bool llext_image_locate(struct llext *ext, uintptr_t addr,
+			       uint8_t *mem_idx, uintptr_t *offset)
+{
+	for (int pass = 0; pass < 2; pass++) {
+		for (enum llext_mem i = 0; i < LLEXT_MEM_PARTITIONS; i++) {
+			uintptr_t base = (uintptr_t)ext->mem[i];
+
+			if (base == 0 || addr < base || addr - base > ext->mem_size[i] ||
+			    (pass == 0 && addr - base == ext->mem_size[i])) {
+				continue;
+			}
+
+			*mem_idx = i;
+			*offset = addr - base;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void llext_image_add_sections(struct llext_image_writer *img,
+				     struct llext_loader *ldr, struct llext *ext)
+{
+	if (img == NULL) {
+		return;
+	}
+
+	for (enum llext_mem mem_idx = 0; mem_idx < LLEXT_MEM_PARTITIONS; mem_idx++) {
+		size_t len = ldr->sects[mem_idx].sh_type == SHT_NOBITS ?
+			0 : ext->mem_size[mem_idx];
+		void *p = llext_image_reserve(img, len);
+
+		if (p == NULL) {
+			return;
+		}
+
+		if (len) {
+			memcpy(p, ext->mem[mem_idx], len);
+		}
+		img->hdr.mem_size[mem_idx] = ext->mem_size[mem_idx];
+		img->hdr.file_size[mem_idx] = len;
+	}
+}
+
+static void llext_image_add_fixup(struct llext_image_writer *img, struct llext *ext,
+				  const elf_rela_t *rel, enum llext_image_fixup_kind kind,
+				  uintptr_t loc, uintptr_t target, bool absolute)
+{
+	struct llext_image_fixup fixup = {
+		.rel = *rel,
+		.kind = kind,
+	};
+	uintptr_t offset;
+	void *p;
+
+	if (img == NULL || img->failed) {
+		return;
+	}
+
+	if (ext->mem[LLEXT_MEM_EXPORT] &&
+	    loc - (uintptr_t)ext->mem[LLEXT_MEM_EXPORT] < ext->mem_size[LLEXT_MEM_EXPORT]) {
+		/* The export table is stored separately */
+		return;
+	}
+
+	if (!llext_image_locate(ext, loc, &fixup.loc_mem, &offset)) {
+		llext_image_fail(img);
+		return;
+	}
+	fixup.offset = offset;
+
+	if (absolute) {
+		fixup.tgt_mem = LLEXT_MEM_COUNT;
+		fixup.target = target;
+	} else if (!llext_image_locate(ext, target, &fixup.tgt_mem, &fixup.target)) {
+		llext_image_fail(img);
+		return;
+	}
+
+	p = llext_image_reserve(img, sizeof(fixup));
+	if (p != NULL) {
+		memcpy(p, &fixup, sizeof(fixup));
+		img->hdr.fixup_cnt++;
+	}
+}
+
+static void llext_image_add_exports(struct llext_image_writer *img, struct llext *ext)
+{
+	if (img == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < ext->exp_tab.sym_cnt && !img->failed; i++) {
+		const struct llext_symbol *sym = ext->exp_tab.syms + i;
+		struct llext_image_export entry = {
+			.name_len = strlen(sym->name) + 1,
+		};
+		uint8_t *p;
+
+		if (!llext_image_locate(ext, (uintptr_t)sym->addr, &entry.tgt_mem,
+					&entry.target)) {
+			llext_image_fail(img);
+			return;
+		}
+
+		p = llext_image_reserve(img, sizeof(entry) + entry.name_len);
+		if (p != NULL) {
+			memcpy(p, &entry, sizeof(entry));
+			memcpy(p + sizeof(entry), sym->name, entry.name_len);
+			img->hdr.export_cnt++;
+			img->hdr.export_strings_size += entry.name_len;
+		}
+	}
+}
+
+static void llext_image_finish(struct llext_image_writer *img,
+			       struct llext_load_param *ldr_parm, bool loaded)
+{
+	if (img == NULL) {
+		return;
+	}
+
+	if (!loaded || img->failed) {
+		ldr_parm->image_size = 0;
+		return;
+	}
+
+	img->hdr.magic = LLEXT_IMAGE_MAGIC;
+	img->hdr.version = LLEXT_IMAGE_VERSION;
+	img->hdr.hdr_size = sizeof(img->hdr);
+	img->hdr.fingerprint = llext_builtin_sym_fingerprint();
+	img->hdr.image_size = img->pos;
+	memcpy(img->buf, &img->hdr, sizeof(img->hdr));
+
+	ldr_parm->image_size = img->pos;
+	LOG_DBG("pre-linked image of %zu bytes, %u fixups", img->pos, img->hdr.fixup_cnt);
+}
+#else
+struct llext_image_writer;
+
+static inline void llext_image_fail(struct llext_image_writer *img)
+{
+}
+
+static inline void llext_image_add_sections(struct llext_image_writer *img,
+					    struct llext_loader *ldr, struct llext *ext)
+{
+}
+
+static inline void llext_image_add_fixup(struct llext_image_writer *img, struct llext *ext,
+					 const elf_rela_t *rel, enum llext_image_fixup_kind kind,
+					 uintptr_t loc, uintptr_t target, bool absolute)
+{
+}
+
+static inline void llext_image_add_exports(struct llext_image_writer *img, struct llext *ext)
+{
+}
+
+static inline void llext_image_finish(struct llext_image_writer *img,
+				      struct llext_load_param *ldr_parm, bool loaded)
+{
+}
+#endif /* CONFIG_LLEXT_IMAGE */
+
 static int llext_count_export_syms(struct llext_loader *ldr, struct llext *ext)
 {
 	size_t ent_size = ldr->sects[LLEXT_MEM_SYMTAB].sh_entsize;
@@ -647,7 +927,8 @@ __weak void arch_elf_relocate_local(struct llext_loader *ldr, struct llext *ext,
 }
 
 static void llext_link_plt(struct llext_loader *ldr, struct llext *ext,
-			   elf_shdr_t *shdr, bool do_local, elf_shdr_t *tgt)
+			   elf_shdr_t *shdr, bool do_local, elf_shdr_t *tgt,
+			   struct llext_image_writer *img)
 {
 	unsigned int sh_cnt = shdr->sh_size / shdr->sh_entsize;
 	/*
@@ -726,9 +1007,12 @@ static void llext_link_plt(struct llext_loader *ldr, struct llext *ext,
 		uint32_t stb = ELF_ST_BIND(sym_tbl.st_info);
 		const void *link_addr;
 
+		bool builtin;
+
 		switch (stb) {
 		case STB_GLOBAL:
 			link_addr = llext_find_sym(NULL, name);
+			builtin = link_addr != NULL;
 
 			if (!link_addr)
 				link_addr = llext_find_sym(&ext->sym_tab, name);
@@ -740,10 +1024,15 @@ static void llext_link_plt(struct llext_loader *ldr, struct llext *ext,
 
 			/* Resolve the symbol */
 			*(const void **)(text + got_offset) = link_addr;
+			llext_image_add_fixup(img, ext, &rela, LLEXT_IMAGE_FIXUP_PTR,
+					      (uintptr_t)(text + got_offset),
+					      (uintptr_t)link_addr, builtin);
 			break;
 		case STB_LOCAL:
 			if (do_local) {
 				arch_elf_relocate_local(ldr, ext, &rela, &sym_tbl, got_offset);
+				/* Not recorded, the architecture applies it directly */
+				llext_image_fail(img);
 			}
 		}
 
@@ -759,7 +1048,21 @@ __weak int arch_elf_relocate(elf_rela_t *rel, uintptr_t loc,
 	return -EOPNOTSUPP;
 }
 
-static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local)
+static void llext_flush_caches(struct llext *ext)
+{
+#ifdef CONFIG_CACHE_MANAGEMENT
+	/* Make sure changes to ext sections are flushed to RAM */
+	for (int i = 0; i < LLEXT_MEM_COUNT; ++i) {
+		if (ext->mem[i]) {
+			sys_cache_data_flush_range(ext->mem[i], ext->mem_size[i]);
+			sys_cache_instr_invd_range(ext->mem[i], ext->mem_size[i]);
+		}
+	}
+#endif
+}
+
+static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local,
+		      struct llext_image_writer *img)
 {
 	uintptr_t loc = 0;
 	elf_shdr_t shdr;
@@ -806,13 +1109,13 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 			loc = (uintptr_t)ext->mem[LLEXT_MEM_EXPORT];
 		} else if (strcmp(name, ".rela.plt") == 0 ||
 			   strcmp(name, ".rela.dyn") == 0) {
-			llext_link_plt(ldr, ext, &shdr, do_local, NULL);
+			llext_link_plt(ldr, ext, &shdr, do_local, NULL, img);
 			continue;
 		} else if (strncmp(name, ".rela", 5) == 0 && strlen(name) > 5) {
 			elf_shdr_t *tgt = llext_section_by_name(ldr, name + 5);
 
 			if (tgt)
-				llext_link_plt(ldr, ext, &shdr, do_local, tgt);
+				llext_link_plt(ldr, ext, &shdr, do_local, tgt, img);
 			continue;
 		} else if (strcmp(name, ".rel.dyn") == 0) {
 			/* we assume that first load segment starts at MEM_TEXT */
@@ -899,18 +1202,14 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 			if (ret != 0) {
 				return ret;
 			}
-		}
-	}
 
-#ifdef CONFIG_CACHE_MANAGEMENT
-	/* Make sure changes to ext sections are flushed to RAM */
-	for (i = 0; i < LLEXT_MEM_COUNT; ++i) {
-		if (ext->mem[i]) {
-			sys_cache_data_flush_range(ext->mem[i], ext->mem_size[i]);
-			sys_cache_instr_invd_range(ext->mem[i], ext->mem_size[i]);
+			llext_image_add_fixup(img, ext, &rel, LLEXT_IMAGE_FIXUP_ARCH, op_loc,
+					      link_addr, sym.st_shndx == SHN_UNDEF ||
+					      ELF_R_SYM(rel.r_info) == 0);
 		}
 	}
-#endif
+
+	llext_flush_caches(ext);
 
 	return 0;
 }
@@ -921,8 +1220,17 @@ static int llext_link(struct llext_loader *ldr, struct llext *ext, bool do_local
 static int do_llext_load(struct llext_loader *ldr, struct llext *ext,
 			 struct llext_load_param *ldr_parm)
 {
+	struct llext_image_writer *img = NULL;
 	int ret = 0;
 
+#ifdef CONFIG_LLEXT_IMAGE
+	struct llext_image_writer image;
+
+	if (ldr_parm && ldr_parm->image) {
+		img = llext_image_init(&image, ldr_parm);
+	}
+#endif
+
 	memset(ldr->sects, 0, sizeof(ldr->sects));
 	ldr->sect_cnt = 0;
 	ext->sym_tab.sym_cnt = 0;
@@ -976,6 +1284,9 @@ static int do_llext_load(struct llext_loader *ldr, struct llext *ext,
 		goto out;
 	}
 
+	/* Sections are recorded before linking modifies them */
+	llext_image_add_sections(img, ldr, ext);
+
 	LOG_DBG("Counting exported symbols...");
 	ret = llext_count_export_syms(ldr, ext);
 	if (ret != 0) {
@@ -998,7 +1309,7 @@ static int do_llext_load(struct llext_loader *ldr, struct llext *ext,
 	}
 
 	LOG_DBG("Linking ELF...");
-	ret = llext_link(ldr, ext, ldr_parm ? ldr_parm->relocate_local : true);
+	ret = llext_link(ldr, ext, ldr_parm ? ldr_parm->relocate_local : true, img);
 	if (ret != 0) {
 		LOG_ERR("Failed to link, ret %d", ret);
 		goto out;
@@ -1010,7 +1321,10 @@ static int do_llext_load(struct llext_loader *ldr, struct llext *ext,
 		goto out;
 	}
 
+	llext_image_add_exports(img, ext);
+
 out:
+	llext_image_finish(img, ldr_parm, ret == 0);
 	k_heap_free(&llext_heap, ldr->sect_map);
 
 	if (ret != 0) {
@@ -1106,6 +1420,281 @@ out:
 	return ret;
 }
 
+#ifdef CONFIG_LLEXT_IMAGE
+static int llext_image_target(struct llext *ext, uint8_t tgt_mem, uintptr_t target,
+			      uintptr_t *addr)
+{
+	if (tgt_mem == LLEXT_MEM_COUNT) {
+		*addr = target;
+		return 0;
+	}
+
+	if (tgt_mem >= LLEXT_MEM_PARTITIONS || !ext->mem[tgt_mem] ||
+	    target > ext->mem_size[tgt_mem]) {
+		return -EINVAL;
+	}
+
+	*addr = (uintptr_t)ext->mem[tgt_mem] + target;
+
+	return 0;
+}
+
+static int llext_image_copy_sections(struct llext_loader *ldr, struct llext *ext,
+				     const struct llext_image_hdr *hdr, size_t *pos)
+{
+	int ret;
+
+	for (enum llext_mem mem_idx = 0; mem_idx < LLEXT_MEM_PARTITIONS; mem_idx++) {
+		size_t mem_size = hdr->mem_size[mem_idx];
+		size_t file_size = hdr->file_size[mem_idx];
+
+		if (file_size > mem_size) {
+			return -EINVAL;
+		}
+
+		if (!mem_size) {
+			continue;
+		}
+
+		ret = llext_alloc_section(ext, mem_idx, mem_size);
+		if (ret != 0) {
+			return ret;
+		}
+		ext->mem_on_heap[mem_idx] = true;
+		ext->mem_size[mem_idx] = mem_size;
+
+		if (file_size) {
+			ret = llext_seek(ldr, *pos);
+			if (ret == 0) {
+				ret = llext_read(ldr, ext->mem[mem_idx], file_size);
+			}
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		memset((uint8_t *)ext->mem[mem_idx] + file_size, 0, mem_size - file_size);
+		*pos += file_size;
+	}
+
+	return 0;
+}
+
+static int llext_image_apply_fixups(struct llext_loader *ldr, struct llext *ext,
+				    const struct llext_image_hdr *hdr, size_t *pos)
+{
+	struct llext_image_fixup fixup;
+	uintptr_t loc, target;
+	int ret;
+
+	ret = llext_seek(ldr, *pos);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (uint32_t i = 0; i < hdr->fixup_cnt; i++) {
+		ret = llext_read(ldr, &fixup, sizeof(fixup));
+		if (ret != 0) {
+			return ret;
+		}
+
+		if (fixup.loc_mem >= LLEXT_MEM_PARTITIONS ||
+		    fixup.offset >= ext->mem_size[fixup.loc_mem] ||
+		    llext_image_target(ext, fixup.tgt_mem, fixup.target, &target) != 0) {
+			LOG_ERR("Invalid fixup %u", i);
+			return -EINVAL;
+		}
+		loc = (uintptr_t)ext->mem[fixup.loc_mem] + fixup.offset;
+
+		if (fixup.kind == LLEXT_IMAGE_FIXUP_PTR) {
+			*(uintptr_t *)loc = target;
+			continue;
+		}
+
+		ret = arch_elf_relocate(&fixup.rel, loc, target, "",
+					(uintptr_t)ext->mem[LLEXT_MEM_TEXT]);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	*pos += hdr->fixup_cnt * sizeof(fixup);
+
+	return 0;
+}
+
+static int llext_image_copy_exports(struct llext_loader *ldr, struct llext *ext,
+				    const struct llext_image_hdr *hdr, size_t pos)
+{
+	struct llext_symtable *exp_tab = &ext->exp_tab;
+	struct llext_image_export entry;
+	size_t strings_pos = 0;
+	char *strings;
+	int ret;
+
+	if (!hdr->export_cnt) {
+		return 0;
+	}
+
+	/* Symbols and their names share one allocation */
+	exp_tab->syms = k_heap_alloc(&llext_heap,
+				     hdr->export_cnt * sizeof(struct llext_symbol) +
+				     hdr->export_strings_size, K_NO_WAIT);
+	if (!exp_tab->syms) {
+		return -ENOMEM;
+	}
+	strings = (char *)(exp_tab->syms + hdr->export_cnt);
+
+	ret = llext_seek(ldr, pos);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (uint32_t i = 0; i < hdr->export_cnt; i++) {
+		uintptr_t addr;
+
+		ret = llext_read(ldr, &entry, sizeof(entry));
+		if (ret != 0) {
+			return ret;
+		}
+
+		if (!entry.name_len || entry.name_len > hdr->export_strings_size - strings_pos ||
+		    llext_image_target(ext, entry.tgt_mem, entry.target, &addr) != 0 ||
+		    entry.tgt_mem == LLEXT_MEM_COUNT) {
+			LOG_ERR("Invalid exported symbol %u", i);
+			return -EINVAL;
+		}
+
+		ret = llext_read(ldr, strings + strings_pos, entry.name_len);
+		if (ret != 0) {
+			return ret;
+		}
+		strings[strings_pos + entry.name_len - 1] = '\0';
+
+		exp_tab->syms[i].name = strings + strings_pos;
+		exp_tab->syms[i].addr = (void *)addr;
+		exp_tab->sym_cnt++;
+		strings_pos += entry.name_len;
+
+		LOG_DBG("sym %p name %s", exp_tab->syms[i].addr, exp_tab->syms[i].name);
+	}
+
+	return 0;
+}
+
+static int do_llext_load_image(struct llext_loader *ldr, struct llext *ext,
+			       const struct llext_image_hdr *hdr)
+{
+	size_t pos = sizeof(*hdr);
+	int ret = 0;
+
+#ifdef CONFIG_USERSPACE
+	ret = k_mem_domain_init(&ext->mem_domain, 0, NULL);
+	if (ret != 0) {
+		LOG_ERR("Failed to initialize extenion memory domain %d", ret);
+		goto out;
+	}
+#endif
+
+	ret = llext_image_copy_sections(ldr, ext, hdr, &pos);
+	if (ret != 0) {
+		LOG_ERR("Failed to copy image sections, ret %d", ret);
+		goto out;
+	}
+
+	ret = llext_image_apply_fixups(ldr, ext, hdr, &pos);
+	if (ret != 0) {
+		LOG_ERR("Failed to apply image fixups, ret %d", ret);
+		goto out;
+	}
+
+	llext_flush_caches(ext);
+
+	ret = llext_image_copy_exports(ldr, ext, hdr, pos);
+	if (ret != 0) {
+		LOG_ERR("Failed to copy exported symbols, ret %d", ret);
+		goto out;
+	}
+
+out:
+	if (ret != 0) {
+		LOG_DBG("Failed to load image, freeing memory...");
+		for (enum llext_mem mem_idx = 0; mem_idx < LLEXT_MEM_COUNT; mem_idx++) {
+			if (ext->mem_on_heap[mem_idx]) {
+				k_heap_free(&llext_heap, ext->mem[mem_idx]);
+			}
+		}
+		k_heap_free(&llext_heap, ext->exp_tab.syms);
+	}
+
+	return ret;
+}
+
+int llext_load_image(struct llext_loader *ldr, const char *name, struct llext **ext)
+{
+	struct llext_image_hdr hdr;
+	int ret;
+
+	*ext = llext_by_name(name);
+
+	k_mutex_lock(&llext_lock, K_FOREVER);
+
+	if (*ext) {
+		/* The use count is at least 1 */
+		ret = (*ext)->use_count++;
+		goto out;
+	}
+
+	ret = llext_seek(ldr, 0);
+	if (ret == 0) {
+		ret = llext_read(ldr, &hdr, sizeof(hdr));
+	}
+	if (ret != 0) {
+		LOG_ERR("Failed to read image header");
+		goto out;
+	}
+
+	if (hdr.magic != LLEXT_IMAGE_MAGIC || hdr.version != LLEXT_IMAGE_VERSION ||
+	    hdr.hdr_size != sizeof(hdr)) {
+		LOG_ERR("Invalid pre-linked image");
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if (hdr.fingerprint != llext_builtin_sym_fingerprint()) {
+		LOG_ERR("Image was created for a different base image");
+		ret = -ESTALE;
+		goto out;
+	}
+
+	*ext = k_heap_alloc(&llext_heap, sizeof(struct llext), K_NO_WAIT);
+	if (*ext == NULL) {
+		LOG_ERR("Not enough memory for extension metadata");
+		ret = -ENOMEM;
+		goto out;
+	}
+	memset(*ext, 0, sizeof(struct llext));
+
+	ret = do_llext_load_image(ldr, *ext, &hdr);
+	if (ret < 0) {
+		k_heap_free(&llext_heap, *ext);
+		*ext = NULL;
+		goto out;
+	}
+
+	strncpy((*ext)->name, name, sizeof((*ext)->name));
+	(*ext)->name[sizeof((*ext)->name) - 1] = '\0';
+	(*ext)->use_count++;
+
+	sys_slist_append(&_llext_list, &(*ext)->_llext_list);
+	LOG_INF("Loaded extension %s from image", (*ext)->name);
+
+out:
+	k_mutex_unlock(&llext_lock);
+	return ret;
+}
+#endif /* CONFIG_LLEXT_IMAGE */
+
 int llext_unload(struct llext **ext)
 {
 	__ASSERT(*ext, "Expected non-null extension");
@@ -5,7 +5,11 @@
  */
 
 #include <string.h>
+#include <zephyr/kernel.h>
 #include <zephyr/llext/symbol.h>
+#include <zephyr/sys/hash_function.h>
+
+#include "llext_priv.h"
 
 EXPORT_SYMBOL(strcpy);
 EXPORT_SYMBOL(strncpy);
@@ -17,3 +21,117 @@ EXPORT_SYMBOL(memcpy);
 EXPORT_SYMBOL(memset);
 
 #include <zephyr/syscall_export_llext.c>
+
+#if defined(CONFIG_LLEXT_SYMBOL_HASH) || defined(CONFIG_LLEXT_IMAGE)
+static uint32_t builtin_sym_hash(const char *sym_name)
+{
+	return sys_hash32(sym_name, strlen(sym_name));
+}
+#endif /* CONFIG_LLEXT_SYMBOL_HASH || CONFIG_LLEXT_IMAGE */
+
+#ifdef CONFIG_LLEXT_SYMBOL_HASH
+#define SYM_HASH_SLOTS	CONFIG_LLEXT_SYMBOL_HASH_SLOTS
+#define SYM_HASH_EMPTY	UINT16_MAX
+
+BUILD_ASSERT(IS_POWER_OF_TWO(SYM_HASH_SLOTS), "hash slots must be a power of two");
+
+/*
+ * Open addressing table of indexes into the built-in symbol section, built
+ * on first use. Only the index is stored, a probe compares the symbol name.
+ */
+static uint16_t sym_hash_table[SYM_HASH_SLOTS];
+static bool sym_hash_ready;
+static bool sym_hash_usable;
+static struct k_spinlock sym_hash_lock;
+
+static void sym_hash_build(void)
+{
+	int sym_cnt;
+
+	STRUCT_SECTION_COUNT(llext_const_symbol, &sym_cnt);
+
+	/* Keep the load factor below 3/4 for short probe sequences */
+	if (sym_cnt > SYM_HASH_SLOTS / 4 * 3) {
+		return;
+	}
+
+	memset(sym_hash_table, 0xff, sizeof(sym_hash_table));
+
+	for (int i = 0; i < sym_cnt; i++) {
+		struct llext_const_symbol *sym;
+		uint32_t slot;
+
+		STRUCT_SECTION_GET(llext_const_symbol, i, &sym);
+		slot = builtin_sym_hash(sym->name) & (SYM_HASH_SLOTS - 1);
+
+		while (sym_hash_table[slot] != SYM_HASH_EMPTY) {
+			slot = (slot + 1) & (SYM_HASH_SLOTS - 1);
+		}
+
+		sym_hash_table[slot] = i;
+	}
+
+	sym_hash_usable = true;
+}
+
+const void *llext_find_builtin_sym(const char *sym_name)
+{
+	K_SPINLOCK(&sym_hash_lock) {
+		if (!sym_hash_ready) {
+			sym_hash_build();
+			sym_hash_ready = true;
+		}
+	}
+
+	if (sym_hash_usable) {
+		uint32_t slot = builtin_sym_hash(sym_name) & (SYM_HASH_SLOTS - 1);
+
+		while (sym_hash_table[slot] != SYM_HASH_EMPTY) {
+			struct llext_const_symbol *sym;
+
+			STRUCT_SECTION_GET(llext_const_symbol, sym_hash_table[slot], &sym);
+			if (strcmp(sym->name, sym_name) == 0) {
+				return sym->addr;
+			}
+
+			slot = (slot + 1) & (SYM_HASH_SLOTS - 1);
+		}
+
+		return NULL;
+	}
+
+	/* Too many symbols for the table, fall back to a linear search */
+	STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
+		if (strcmp(sym->name, sym_name) == 0) {
+			return sym->addr;
+		}
+	}
+
+	return NULL;
+}
+#else
+const void *llext_find_builtin_sym(const char *sym_name)
+{
+	STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
+		if (strcmp(sym->name, sym_name) == 0) {
+			return sym->addr;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_LLEXT_SYMBOL_HASH */
+
+#ifdef CONFIG_LLEXT_IMAGE
+uint32_t llext_builtin_sym_fingerprint(void)
+{
+	uint32_t fingerprint = 0;
+
+	STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
+		fingerprint = fingerprint * 31U + builtin_sym_hash(sym->name);
+		fingerprint = fingerprint * 31U + (uint32_t)POINTER_TO_UINT(sym->addr);
+	}
+
+	return fingerprint;
+}
+#endif /* CONFIG_LLEXT_IMAGE */
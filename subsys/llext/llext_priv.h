@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_LLEXT_PRIV_H_
+#define ZEPHYR_SUBSYS_LLEXT_PRIV_H_
+
+#include <stdint.h>
+
+/*
+ * Lookup of symbols exported by the base image with EXPORT_SYMBOL()
+ */
+const void *llext_find_builtin_sym(const char *sym_name);
+
+/*
+ * Fingerprint of the names and addresses of the symbols exported by the base
+ * image, pre-linked extension images are only valid for a matching base image
+ */
+uint32_t llext_builtin_sym_fingerprint(void);
+
+#endif /* ZEPHYR_SUBSYS_LLEXT_PRIV_H_ */
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -42,18 +43,19 @@ static struct log_backend_net_ctx {
 	.sock = -1,
 };
 
-static int line_out(uint8_t *data, size_t length, void *output_ctx)
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+static uint8_t batch_buf[CONFIG_LOG_BACKEND_NET_BATCH_SIZE];
+static size_t batch_len;
+static int64_t batch_start;
+#endif
+
+static void msg_send(struct log_backend_net_ctx *ctx, uint8_t *data, size_t length)
 {
-	struct log_backend_net_ctx *ctx = (struct log_backend_net_ctx *)output_ctx;
 	int ret = -ENOMEM;
 	struct msghdr msg = { 0 };
 	struct iovec io_vector[2];
 	int pos = 0;
 
-	if (ctx == NULL) {
-		return length;
-	}
-
 #if defined(CONFIG_NET_TCP)
 	char len[sizeof("123456789")];
 
@@ -65,7 +67,7 @@ static int line_out(uint8_t *data, size_t length, void *output_ctx)
 	}
 #else
 	if (ctx->is_tcp) {
-		return -ENOTSUP;
+		return;
 	}
 #endif
 
@@ -78,11 +80,76 @@ static int line_out(uint8_t *data, size_t length, void *output_ctx)
 
 	ret = zsock_sendmsg(ctx->sock, &msg, ctx->is_tcp ? 0 : ZSOCK_MSG_DONTWAIT);
 	if (ret < 0) {
-		goto fail;
+		return;
 	}
 
 	DBG(data);
-fail:
+}
+
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+static void batch_flush(struct log_backend_net_ctx *ctx)
+{
+	if (batch_len == 0 || ctx->sock < 0) {
+		batch_len = 0;
+		return;
+	}
+
+	(void)zsock_send(ctx->sock, batch_buf, batch_len,
+			 ctx->is_tcp ? 0 : ZSOCK_MSG_DONTWAIT);
+	batch_len = 0;
+}
+
+static void batch_add(struct log_backend_net_ctx *ctx, uint8_t *data, size_t length)
+{
+	char prefix[sizeof("123456789 ")];
+	size_t prefix_len = 0;
+
+	if (ctx->is_tcp) {
+		prefix_len = snprintk(prefix, sizeof(prefix), "%zu ", length);
+	}
+
+	if (batch_len + prefix_len + length + (ctx->is_tcp ? 0 : 1) > sizeof(batch_buf)) {
+		batch_flush(ctx);
+	}
+
+	if (prefix_len + length > sizeof(batch_buf)) {
+		msg_send(ctx, data, length);
+		return;
+	}
+
+	if (!ctx->is_tcp && batch_len > 0) {
+		prefix[0] = '\n';
+		prefix_len = 1;
+	}
+
+	if (batch_len == 0) {
+		batch_start = k_uptime_get();
+	}
+
+	memcpy(&batch_buf[batch_len], prefix, prefix_len);
+	memcpy(&batch_buf[batch_len + prefix_len], data, length);
+	batch_len += prefix_len + length;
+
+	if (k_uptime_get() - batch_start >= CONFIG_LOG_BACKEND_NET_BATCH_TIMEOUT_MS) {
+		batch_flush(ctx);
+	}
+}
+#endif /* CONFIG_LOG_BACKEND_NET_BATCH */
+
+static int line_out(uint8_t *data, size_t length, void *output_ctx)
+{
+	struct log_backend_net_ctx *ctx = (struct log_backend_net_ctx *)output_ctx;
+
+	if (ctx == NULL) {
+		return length;
+	}
+
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+	batch_add(ctx, data, length);
+#else
+	msg_send(ctx, data, length);
+#endif
+
 	return length;
 }
 
@@ -233,6 +300,10 @@ static bool check_net_init_done(void)
 		struct log_backend_net_ctx *ctx = log_output_net.control_block->ctx;
 		int released;
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+		batch_flush(ctx);
+#endif
+
 		released = zsock_close(ctx->sock);
 		if (released < 0) {
 			LOG_ERR("Cannot release socket (%d)", ret);
@@ -337,8 +408,25 @@ static void panic(struct log_backend const *const backend)
 	panic_mode = true;
 }
 
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+static void notify(const struct log_backend *const backend,
+		   enum log_backend_evt event, union log_backend_evt_arg *arg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(arg);
+
+	/* Called from the logging thread, like process() */
+	if (event == LOG_BACKEND_EVT_PROCESS_THREAD_DONE && net_init_done) {
+		batch_flush(&ctx);
+	}
+}
+#endif
+
 const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
+#ifdef CONFIG_LOG_BACKEND_NET_BATCH
+	.notify = notify,
+#endif
 	.init = init_net,
 	.process = process,
 	.format_set = format_set,
@@ -53,6 +53,12 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_BUFFER_NUM CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOG_BUFFER_NUM 1
+#endif
+
 #ifdef CONFIG_LOG_PROCESS_THREAD_CUSTOM_PRIORITY
 #define LOG_PROCESS_THREAD_PRIORITY CONFIG_LOG_PROCESS_THREAD_PRIORITY
 #else
@@ -115,20 +121,29 @@ static log_timestamp_t prev_timestamp;
 static atomic_t unordered_cnt;
 static uint64_t last_failure_report;
 
-static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
-static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
+/* With CONFIG_LOG_PER_CPU_BUFFERS, each CPU allocates messages from its own
+ * part of the buffer and the processing merges them like the buffers of
+ * links, see z_log_msg_claim_oldest().
+ */
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_msg_ptr, LOG_BUFFER_NUM);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer,
+					       LOG_BUFFER_NUM);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
 	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
 
+/* Size of the buffer of each CPU, keeping the message alignment. */
+#define LOG_BUFFER_CPU_WLEN \
+	ROUND_DOWN(ARRAY_SIZE(buf32) / LOG_BUFFER_NUM, Z_LOG_MSG_ALIGNMENT / sizeof(int))
+
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
 	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.size = LOG_BUFFER_CPU_WLEN,
 	.notify_drop = z_log_notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -631,8 +646,36 @@ bool z_log_dropped_pending(void)
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
-	curr_log_buffer = &log_buffer;
+	for (int i = 0; i < LOG_BUFFER_NUM; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = &buf32[i * LOG_BUFFER_CPU_WLEN];
+		mpsc_pbuf_init(&log_buffer[i], &config);
+	}
+	curr_log_buffer = &log_buffer[0];
+#endif
+}
+
+/* Buffer of the CPU a message is allocated on. A thread may migrate to
+ * another CPU afterwards, the buffer of a message is found from its address.
+ */
+static struct mpsc_pbuf_buffer *cpu_log_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return &log_buffer[arch_curr_cpu()->id];
+#else
+	return &log_buffer[0];
+#endif
+}
+
+static struct mpsc_pbuf_buffer *msg_log_buffer(const struct log_msg *msg)
+{
+#if defined(CONFIG_LOG_PER_CPU_BUFFERS) && defined(CONFIG_MPSC_PBUF)
+	return &log_buffer[((const uint32_t *)msg - buf32) / LOG_BUFFER_CPU_WLEN];
+#else
+	ARG_UNUSED(msg);
+
+	return &log_buffer[0];
 #endif
 }
 
@@ -651,7 +694,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(cpu_log_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -673,13 +716,13 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_log_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
+	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer[0]);
 #else
 	return NULL;
 #endif
@@ -760,7 +803,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -795,8 +839,9 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
-		return msg_pending(&log_buffer);
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
+		return msg_pending(&log_buffer[0]);
 	}
 
 	STRUCT_SECTION_FOREACH(log_msg_ptr, msg_ptr) {
@@ -822,7 +867,7 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 {
 	struct log_msg *log_msg = (struct log_msg *)data;
 	size_t wlen = DIV_ROUND_UP(ROUND_UP(len, Z_LOG_MSG_ALIGNMENT), sizeof(int));
-	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : &log_buffer;
+	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : cpu_log_buffer();
 	struct log_msg *local_msg = msg_alloc(mpsc_pbuffer, wlen);
 
 	if (!local_msg) {
@@ -875,7 +920,17 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (int i = 0; i < LOG_BUFFER_NUM; i++) {
+		uint32_t size;
+		uint32_t used;
+
+		mpsc_pbuf_get_utilization(&log_buffer[i], &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
 
 	return 0;
 }
@@ -888,7 +943,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	*max = 0;
+
+	/* Sum of the peaks of each CPU, they may not have happened together. */
+	for (int i = 0; i < LOG_BUFFER_NUM; i++) {
+		uint32_t buf_max;
+		int err = mpsc_pbuf_get_max_utilization(&log_buffer[i], &buf_max);
+
+		if (err < 0) {
+			return err;
+		}
+
+		*max += buf_max;
+	}
+
+	return 0;
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -45,6 +46,9 @@ static uint8_t sname_cache_buffer[SCACHE_BUF_SIZE] __aligned(sizeof(uint32_t));
 static struct log_cache dname_cache;
 static struct log_cache sname_cache;
 
+/* Serializes runtime filter updates, readers never take it */
+static struct k_spinlock filter_lock;
+
 struct log_source_id {
 	uint8_t domain_id;
 	uint16_t source_id;
@@ -395,17 +399,27 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 	uint32_t prev_max;
 	uint32_t new_max;
 	uint32_t *filters = get_dynamic_filter(domain_id, source_id);
+	uint32_t new_filters;
+	k_spinlock_key_t key = k_spin_lock(&filter_lock);
 
-	prev_max = LOG_FILTER_SLOT_GET(filters, LOG_FILTER_AGGR_SLOT_IDX);
+	new_filters = *filters;
+	prev_max = LOG_FILTER_SLOT_GET(&new_filters, LOG_FILTER_AGGR_SLOT_IDX);
 
-	LOG_FILTER_SLOT_SET(filters, backend_id, level);
+	LOG_FILTER_SLOT_SET(&new_filters, backend_id, level);
 
 	/* Once current backend filter is updated recalculate
 	 * aggregated maximal level
 	 */
-	new_max = max_filter_get(*filters);
+	new_max = max_filter_get(new_filters);
+
+	LOG_FILTER_SLOT_SET(&new_filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
+
+	/* Publish all slots with a single store, so that messages being
+	 * filtered meanwhile never see a transient level.
+	 */
+	*(volatile uint32_t *)filters = new_filters;
 
-	LOG_FILTER_SLOT_SET(filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
+	k_spin_unlock(&filter_lock, key);
 
 	if (!z_log_is_local_domain(domain_id) && (new_max != prev_max)) {
 		(void)z_log_link_set_runtime_level(domain_id, source_id, level);
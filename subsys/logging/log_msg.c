@@ -344,18 +344,36 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint8_t level, const void *data, size_t dlen,
 				uint32_t package_flags, const char *fmt, va_list ap)
 {
-	int plen;
+	int plen = 0;
+	bool packaged = false;
+#if CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE > 0
+	/* The package is built at the same offset from the alignment as in
+	 * the message so that it can be copied as is.
+	 */
+	uint8_t __aligned(Z_LOG_MSG_ALIGNMENT) pkg_buf[CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE +
+						      Z_LOG_MSG_ALIGNMENT];
+	uint8_t *stack_pkg = &pkg_buf[Z_LOG_MSG_ALIGN_OFFSET % Z_LOG_MSG_ALIGNMENT];
 
 	if (fmt) {
 		va_list ap2;
 
+		/* Parse the format string only once if the package fits. */
+		va_copy(ap2, ap);
+		plen = cbvprintf_package(stack_pkg, CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE,
+					 package_flags, fmt, ap2);
+		va_end(ap2);
+		packaged = plen >= 0;
+	}
+#endif
+
+	if (fmt && !packaged) {
+		va_list ap2;
+
 		va_copy(ap2, ap);
 		plen = cbvprintf_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
 					 package_flags, fmt, ap2);
 		__ASSERT_NO_MSG(plen >= 0);
 		va_end(ap2);
-	} else {
-		plen = 0;
 	}
 
 	size_t msg_wlen = Z_LOG_MSG_ALIGNED_WLEN(plen, dlen);
@@ -377,8 +395,15 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 	}
 
 	if (pkg && fmt) {
-		plen = cbvprintf_package(pkg, (size_t)plen, package_flags, fmt, ap);
-		__ASSERT_NO_MSG(plen >= 0);
+#if CONFIG_LOG_RUNTIME_PACKAGE_BUF_SIZE > 0
+		if (packaged) {
+			memcpy(pkg, stack_pkg, plen);
+		} else
+#endif
+		{
+			plen = cbvprintf_package(pkg, (size_t)plen, package_flags, fmt, ap);
+			__ASSERT_NO_MSG(plen >= 0);
+		}
 	}
 
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND) && frontend_runtime_filtering(source, desc.level)) {
@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,11 +25,103 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+static uintptr_t msg_source_id(struct log_msg *msg)
+{
+	void *source = (void *)log_msg_get_source(msg);
+
+	if (source == NULL) {
+		return 0U;
+	}
+
+	return IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+		log_dynamic_source_id(source) : log_const_source_id(source);
+}
+
+/* Longest LEB128 encoding of a 64 bit value */
+#define VARINT_MAX_LEN 10
+
+static size_t varint_encode(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	do {
+		buf[len] = value & 0x7F;
+		value >>= 7;
+		if (value != 0U) {
+			buf[len] |= 0x80;
+		}
+		len++;
+	} while (value != 0U);
+
+	return len;
+}
+
+/* Header and argument words of the package are written as varints, most
+ * arguments are small integers or addresses. The string indexes and the
+ * appended strings which follow are written as is.
+ */
+static void log_dict_output_compact_msg_process(const struct log_output *output,
+						struct log_msg *msg)
+{
+	void *ctx = (void *)output->control_block->ctx;
+	uint8_t buf[2 + 4 * VARINT_MAX_LEN];
+	size_t pkg_len;
+	size_t data_len;
+	uint8_t *pkg = log_msg_get_package(msg, &pkg_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
+	size_t args_len = 0;
+	size_t len = 0;
+
+	buf[len++] = MSG_NORMAL_COMPACT;
+	buf[len++] = msg->hdr.desc.domain | (msg->hdr.desc.level << 3);
+	len += varint_encode(&buf[len], msg_source_id(msg));
+	len += varint_encode(&buf[len], msg->hdr.timestamp);
+	len += varint_encode(&buf[len], pkg_len);
+	len += varint_encode(&buf[len], data_len);
+	buffer_write(output->func, buf, len, ctx);
+
+	if (pkg_len > 0U) {
+		args_len = MIN(pkg_len,
+			       ((union cbprintf_package_hdr *)pkg)->desc.len * sizeof(uint32_t));
+	}
+
+	len = 0;
+	for (size_t i = 0; i < args_len; i += sizeof(uint32_t)) {
+		uint32_t word;
+
+		memcpy(&word, &pkg[i], sizeof(word));
+		len += varint_encode(&buf[len], word);
+
+		if (len > sizeof(buf) - VARINT_MAX_LEN) {
+			buffer_write(output->func, buf, len, ctx);
+			len = 0;
+		}
+	}
+
+	if (len > 0U) {
+		buffer_write(output->func, buf, len, ctx);
+	}
+
+	if (pkg_len > args_len) {
+		buffer_write(output->func, &pkg[args_len], pkg_len - args_len, ctx);
+	}
+
+	if (data_len > 0U) {
+		buffer_write(output->func, data, data_len, ctx);
+	}
+
+	log_output_flush(output);
+}
+
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
 {
 	struct log_dict_output_normal_msg_hdr_t output_hdr;
-	void *source = (void *)log_msg_get_source(msg);
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_COMPACT)) {
+		log_dict_output_compact_msg_process(output, msg);
+		return;
+	}
 
 	/* Keep sync with header in struct log_msg */
 	output_hdr.type = MSG_NORMAL;
@@ -38,11 +131,7 @@ void log_dict_output_msg_process(const struct log_output *output,
 	output_hdr.data_len = msg->hdr.desc.data_len;
 	output_hdr.timestamp = msg->hdr.timestamp;
 
-	output_hdr.source = (source != NULL) ?
-				(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
-					log_dynamic_source_id(source) :
-					log_const_source_id(source)) :
-				0U;
+	output_hdr.source = msg_source_id(msg);
 
 	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
 		     (void *)output->control_block->ctx);
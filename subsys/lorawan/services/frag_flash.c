@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2022-2024 Libre Solar Technologies GmbH
  * Copyright (c) 2022-2024 tado GmbH
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -30,6 +31,95 @@ static bool use_cache;
 
 static const struct flash_area *fa;
 
+#if CONFIG_LORAWAN_FRAG_TRANSPORT_WRITE_BUFFER_SIZE > 0
+/*
+ * Consecutive fragments are collected and written to flash at once. The buffer only ever holds
+ * one contiguous run starting at a fragment boundary, so flash sees the same data at the same
+ * alignment as with one write per fragment, just in fewer and larger operations.
+ */
+static uint8_t write_buf[CONFIG_LORAWAN_FRAG_TRANSPORT_WRITE_BUFFER_SIZE];
+static uint32_t write_buf_addr;
+static uint32_t write_buf_len;
+
+static int write_buf_flush(void)
+{
+	int err;
+
+	if (write_buf_len == 0) {
+		return 0;
+	}
+
+	LOG_DBG("Writing %u bytes to addr 0x%X", write_buf_len, write_buf_addr);
+
+	err = flash_area_write(fa, write_buf_addr, write_buf, write_buf_len);
+	write_buf_len = 0;
+
+	return err;
+}
+
+static int buffered_write(uint32_t addr, uint8_t *data, uint32_t size)
+{
+	int err;
+
+	if (write_buf_len > 0 && (addr != write_buf_addr + write_buf_len ||
+				  write_buf_len + size > sizeof(write_buf))) {
+		err = write_buf_flush();
+		if (err) {
+			return err;
+		}
+	}
+
+	if (size > sizeof(write_buf)) {
+		LOG_DBG("Writing %u bytes to addr 0x%X", size, addr);
+		return flash_area_write(fa, addr, data, size);
+	}
+
+	if (write_buf_len == 0) {
+		write_buf_addr = addr;
+	}
+
+	memcpy(write_buf + write_buf_len, data, size);
+	write_buf_len += size;
+
+	return 0;
+}
+
+static int buffered_read(uint32_t addr, uint8_t *data, uint32_t size)
+{
+	if (write_buf_len > 0 && addr < write_buf_addr + write_buf_len &&
+	    addr + size > write_buf_addr) {
+		if (addr >= write_buf_addr && addr + size <= write_buf_addr + write_buf_len) {
+			memcpy(data, write_buf + (addr - write_buf_addr), size);
+			return 0;
+		}
+
+		/* partially buffered, read everything back from flash */
+		if (write_buf_flush()) {
+			return -EIO;
+		}
+	}
+
+	return flash_area_read(fa, addr, data, size);
+}
+#else
+static inline int write_buf_flush(void)
+{
+	return 0;
+}
+
+static inline int buffered_write(uint32_t addr, uint8_t *data, uint32_t size)
+{
+	LOG_DBG("Writing %u bytes to addr 0x%X", size, addr);
+
+	return flash_area_write(fa, addr, data, size);
+}
+
+static inline int buffered_read(uint32_t addr, uint8_t *data, uint32_t size)
+{
+	return flash_area_read(fa, addr, data, size);
+}
+#endif /* CONFIG_LORAWAN_FRAG_TRANSPORT_WRITE_BUFFER_SIZE > 0 */
+
 int frag_flash_init(uint32_t fragment_size)
 {
 	int err;
@@ -41,6 +131,9 @@ int frag_flash_init(uint32_t fragment_size)
 	frag_size = fragment_size;
 	cached_frags = 0;
 	use_cache = false;
+#if CONFIG_LORAWAN_FRAG_TRANSPORT_WRITE_BUFFER_SIZE > 0
+	write_buf_len = 0;
+#endif
 
 	err = flash_area_open(TARGET_IMAGE_AREA, &fa);
 	if (err) {
@@ -61,9 +154,7 @@ int8_t frag_flash_write(uint32_t addr, uint8_t *data, uint32_t size)
 	int8_t err = 0;
 
 	if (!use_cache) {
-		LOG_DBG("Writing %u bytes to addr 0x%X", size, addr);
-
-		err = flash_area_write(fa, addr, data, size);
+		err = buffered_write(addr, data, size);
 	} else {
 		LOG_DBG("Caching %u bytes for addr 0x%X", size, addr);
 
@@ -103,11 +194,15 @@ int8_t frag_flash_read(uint32_t addr, uint8_t *data, uint32_t size)
 		}
 	}
 
-	return flash_area_read(fa, addr, data, size) == 0 ? 0 : -1;
+	return buffered_read(addr, data, size) == 0 ? 0 : -1;
 }
 
 void frag_flash_use_cache(void)
 {
+	if (!use_cache && write_buf_flush()) {
+		LOG_ERR("Failed to write buffered fragments");
+	}
+
 	use_cache = true;
 }
 
@@ -115,6 +210,10 @@ void frag_flash_finish(void)
 {
 	int err;
 
+	if (write_buf_flush()) {
+		LOG_ERR("Failed to write buffered fragments");
+	}
+
 	for (int i = 0; i < cached_frags; i++) {
 		LOG_DBG("Writing %u bytes to addr 0x%x", frag_size, frag_cache[i].addr);
 		flash_area_write(fa, frag_cache[i].addr, frag_cache[i].data, frag_size);
@@ -302,6 +302,79 @@ img_mgmt_find_by_hash(uint8_t *find, struct image_version *ver)
 	return -1;
 }
 
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+/* Chunks received ahead of the upload offset, a length of 0 marks a free slot */
+static struct {
+	size_t off;
+	size_t len;
+	uint8_t data[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNK_SIZE];
+} img_mgmt_window[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW];
+
+static void img_mgmt_window_clear(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_window); i++) {
+		img_mgmt_window[i].len = 0;
+	}
+}
+
+/* Whether a chunk of the ongoing upload can be kept until its offset is reached */
+static bool img_mgmt_window_fits(const struct img_mgmt_upload_req *req)
+{
+	bool has_free = false;
+
+	if (g_img_mgmt_state.area_id == -1 || req->off == SIZE_MAX ||
+	    req->off <= g_img_mgmt_state.off || req->img_data.len == 0 ||
+	    req->img_data.len > CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNK_SIZE ||
+	    req->off + req->img_data.len > g_img_mgmt_state.size ||
+	    req->off - g_img_mgmt_state.off >= CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW *
+					       CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNK_SIZE) {
+		return false;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_window); i++) {
+		if (img_mgmt_window[i].len == 0) {
+			has_free = true;
+		} else if (img_mgmt_window[i].off == req->off) {
+			/* Retransmission of a chunk already kept */
+			return false;
+		}
+	}
+
+	return has_free;
+}
+
+static void img_mgmt_window_put(const struct img_mgmt_upload_req *req)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_window); i++) {
+		if (img_mgmt_window[i].len == 0) {
+			img_mgmt_window[i].off = req->off;
+			img_mgmt_window[i].len = req->img_data.len;
+			memcpy(img_mgmt_window[i].data, req->img_data.value, req->img_data.len);
+			return;
+		}
+	}
+}
+
+/*
+ * Takes the kept chunk at the upload offset, if any. Its data stays valid until the next
+ * chunk is kept, which cannot happen while the lock is held.
+ */
+static bool img_mgmt_window_next(const uint8_t **data, size_t *len)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_window); i++) {
+		if (img_mgmt_window[i].len != 0 &&
+		    img_mgmt_window[i].off == g_img_mgmt_state.off) {
+			*data = img_mgmt_window[i].data;
+			*len = img_mgmt_window[i].len;
+			img_mgmt_window[i].len = 0;
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0 */
+
 /*
  * Resets upload status to defaults (no upload in progress)
  */
@@ -314,6 +387,9 @@ static void img_mgmt_reset_upload(void)
 	img_mgmt_take_lock();
 	memset(&g_img_mgmt_state, 0, sizeof(g_img_mgmt_state));
 	g_img_mgmt_state.area_id = -1;
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+	img_mgmt_window_clear();
+#endif
 	img_mgmt_release_lock();
 }
 
@@ -456,6 +532,9 @@ img_mgmt_upload(struct smp_streamer *ctxt)
 	struct img_mgmt_upload_action action;
 	bool last = false;
 	bool reset = false;
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+	bool keep = false;
+#endif
 
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
 	bool data_match = false;
@@ -521,12 +600,19 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 	}
 
 	if (!action.proceed) {
-		/* Request specifies incorrect offset.  Respond with a success code and
-		 * the correct offset.
-		 */
-		rc = img_mgmt_upload_good_rsp(ctxt);
-		img_mgmt_release_lock();
-		return rc;
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+		/* A chunk ahead of the upload offset is kept, after the upload check */
+		keep = img_mgmt_window_fits(&req);
+		if (!keep)
+#endif
+		{
+			/* Request specifies incorrect offset.  Respond with a success code
+			 * and the correct offset.
+			 */
+			rc = img_mgmt_upload_good_rsp(ctxt);
+			img_mgmt_release_lock();
+			return rc;
+		}
 	}
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_CHECK_HOOK)
@@ -551,6 +637,18 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 	}
 #endif
 
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+	if (keep) {
+		/* Respond with the offset still expected, for the client to know
+		 * what has been written.
+		 */
+		img_mgmt_window_put(&req);
+		rc = img_mgmt_upload_good_rsp(ctxt);
+		img_mgmt_release_lock();
+		return rc;
+	}
+#endif
+
 	/* Remember flash area ID and image size for subsequent upload requests. */
 	g_img_mgmt_state.area_id = action.area_id;
 	g_img_mgmt_state.size = action.size;
@@ -565,6 +663,9 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 
 		g_img_mgmt_state.off = 0;
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+		img_mgmt_window_clear();
+#endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
 		(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_STARTED, NULL, 0, &err_rc,
@@ -633,32 +734,43 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 
 	/* Write the image data to flash. */
 	if (req.img_data.len != 0) {
-		/* If this is the last chunk */
-		if (g_img_mgmt_state.off + req.img_data.len == g_img_mgmt_state.size) {
-			last = true;
-		}
+		const uint8_t *data = req.img_data.value;
+		size_t write_bytes = action.write_bytes;
+		bool more = false;
 
-		rc = img_mgmt_write_image_data(req.off, req.img_data.value, action.write_bytes,
-						    last);
-		if (rc == 0) {
-			g_img_mgmt_state.off += action.write_bytes;
-		} else {
-			/* Write failed, currently not able to recover from this */
+		do {
+			/* If this is the last chunk */
+			if (g_img_mgmt_state.off + write_bytes == g_img_mgmt_state.size) {
+				last = true;
+			}
+
+			rc = img_mgmt_write_image_data(g_img_mgmt_state.off, data, write_bytes,
+						       last);
+			if (rc == 0) {
+				g_img_mgmt_state.off += write_bytes;
+
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+				/* Go on with the chunks kept for the offsets that follow */
+				more = !last && img_mgmt_window_next(&data, &write_bytes);
+#endif
+			} else {
+				/* Write failed, currently not able to recover from this */
 #if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
-			cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
+				cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
 #endif
 
-			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
-				img_mgmt_err_str_flash_write_failed);
-			reset = true;
-			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
-				img_mgmt_err_str_flash_write_failed);
+				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
+					img_mgmt_err_str_flash_write_failed);
+				reset = true;
+				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
+					img_mgmt_err_str_flash_write_failed);
 
-			LOG_ERR("Irrecoverable error: flash write failed: %d", rc);
+				LOG_ERR("Irrecoverable error: flash write failed: %d", rc);
 
-			ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_IMAGE, rc);
-			goto end;
-		}
+				ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_IMAGE, rc);
+				goto end;
+			}
+		} while (more);
 
 		if (g_img_mgmt_state.off == g_img_mgmt_state.size) {
 			/* Done */
@@ -184,40 +184,63 @@ out:
 	return rc;
 }
 
-static int image_upload_res_fn(struct net_buf *nb, void *user_data)
+static int image_upload_res_decode(struct net_buf *nb)
 {
 	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
 	size_t decoded;
+	size_t offset = SIZE_MAX;
 	int rc;
 	int32_t res_rc = MGMT_ERR_EOK;
 
 	struct zcbor_map_decode_key_val upload_res_decode[] = {
-		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_size_decode,
-					     &image_upload_buf->image_upload_offset),
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_size_decode, &offset),
 		ZCBOR_MAP_DECODE_KEY_DECODER("rc", zcbor_int32_decode, &res_rc)};
 
 	if (!nb) {
-		image_upload_buf->status = MGMT_ERR_ETIMEOUT;
-		goto end;
+		return MGMT_ERR_ETIMEOUT;
 	}
 
 	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), nb->data, nb->len, 1, NULL, 0);
 
 	rc = zcbor_map_decode_bulk(zsd, upload_res_decode, ARRAY_SIZE(upload_res_decode), &decoded);
-	if (rc || image_upload_buf->image_upload_offset == SIZE_MAX) {
-		image_upload_buf->status = MGMT_ERR_EINVAL;
-		goto end;
+	if (rc || offset == SIZE_MAX) {
+		return MGMT_ERR_EINVAL;
 	}
-	image_upload_buf->status = res_rc;
 
-	active_client->upload.offset = image_upload_buf->image_upload_offset;
-end:
+	image_upload_buf->image_upload_offset = offset;
+	active_client->upload.offset = offset;
+
+	return res_rc;
+}
+
+static int image_upload_res_fn(struct net_buf *nb, void *user_data)
+{
+	int rc;
+
 	/* Set status for Upload request handler */
-	rc = image_upload_buf->status;
+	rc = image_upload_res_decode(nb);
+	image_upload_buf->status = rc;
 	k_sem_give(user_data);
 	return rc;
 }
 
+#if CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1
+static K_SEM_DEFINE(mcumgr_img_client_window_sem, 0, CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW);
+
+/* Keeps the first failure of the requests in flight */
+static int image_upload_window_res_fn(struct net_buf *nb, void *user_data)
+{
+	int rc;
+
+	rc = image_upload_res_decode(nb);
+	if (!image_upload_buf->status) {
+		image_upload_buf->status = rc;
+	}
+	k_sem_give(user_data);
+	return rc;
+}
+#endif
+
 static int erase_res_fn(struct net_buf *nb, void *user_data)
 {
 	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
@@ -328,16 +351,143 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 	return rc;
 }
 
+static struct net_buf *upload_chunk_encode(size_t offset, const uint8_t *data, size_t length)
+{
+	struct net_buf *nb;
+	uint32_t map_count;
+	bool ok;
+	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
+
+	nb = smp_client_buf_allocation(active_client->smp_client, MGMT_GROUP_ID_IMAGE,
+				       IMG_MGMT_ID_UPLOAD, MGMT_OP_WRITE, SMP_MCUMGR_VERSION_1);
+	if (!nb) {
+		return NULL;
+	}
+
+	zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len, net_buf_tailroom(nb), 0);
+	if (offset) {
+		map_count = 6;
+	} else if (active_client->upload.hash_initialized) {
+		map_count = 12;
+	} else {
+		map_count = 10;
+	}
+
+	/* Init map start and write image info, data and offset */
+	ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
+	     zcbor_uint32_put(zse, active_client->upload.image_num) &&
+	     zcbor_tstr_put_lit(zse, "data") && zcbor_bstr_encode_ptr(zse, data, length) &&
+	     zcbor_tstr_put_lit(zse, "off") && zcbor_size_put(zse, offset);
+	/* Write Len and configured hash when offset is zero */
+	if (ok && !offset) {
+		ok = zcbor_tstr_put_lit(zse, "len") &&
+		     zcbor_size_put(zse, active_client->upload.image_size);
+		if (ok && active_client->upload.hash_initialized) {
+			ok = zcbor_tstr_put_lit(zse, "sha") &&
+			     zcbor_bstr_encode_ptr(zse, active_client->upload.sha256,
+						   IMG_MGMT_DATA_SHA_LEN);
+		}
+	}
+
+	if (ok) {
+		ok = zcbor_map_end_encode(zse, map_count);
+	}
+
+	if (!ok) {
+		LOG_ERR("Failed to encode Image Upload packet");
+		smp_packet_free(nb);
+		return NULL;
+	}
+
+	nb->len = zse->payload - nb->data;
+
+	return nb;
+}
+
+#if CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1
+/*
+ * Keeps up to CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW requests in flight. The responses
+ * report the offset the server has written up to, sending goes on from there once all the
+ * requests are answered, which also covers servers dropping the chunks ahead of it.
+ */
+static void upload_window(const uint8_t *data, size_t length, size_t max_data_length)
+{
+	struct net_buf *nb;
+	size_t base = active_client->upload.offset;
+	size_t sent = 0;
+	size_t write_length;
+	int in_flight = 0;
+	bool ahead = false;
+	int rc;
+
+	k_sem_reset(&mcumgr_img_client_window_sem);
+	image_upload_buf->status = MGMT_ERR_EOK;
+	image_upload_buf->image_upload_offset = base;
+
+	while (true) {
+		while (!image_upload_buf->status && !ahead && sent < length &&
+		       in_flight < CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW) {
+			/* The server only sets up the upload with the first chunk */
+			if (base + sent != 0 && active_client->upload.offset == 0) {
+				break;
+			}
+
+			write_length = MIN(length - sent, max_data_length);
+			nb = upload_chunk_encode(base + sent, data + sent, write_length);
+			if (!nb) {
+				image_upload_buf->status = MGMT_ERR_ENOMEM;
+				break;
+			}
+
+			rc = smp_client_send_cmd(active_client->smp_client, nb,
+						 image_upload_window_res_fn,
+						 &mcumgr_img_client_window_sem,
+						 CONFIG_MCUMGR_GRP_IMG_FLASH_OPERATION_TIMEOUT);
+			if (rc) {
+				LOG_ERR("Failed to send SMP Upload packet, err: %d", rc);
+				smp_packet_free(nb);
+				image_upload_buf->status = rc;
+				break;
+			}
+
+			in_flight++;
+			sent += write_length;
+		}
+
+		if (in_flight == 0) {
+			break;
+		}
+
+		k_sem_take(&mcumgr_img_client_window_sem, K_FOREVER);
+		in_flight--;
+
+		if (image_upload_buf->status) {
+			continue;
+		}
+
+		if (active_client->upload.offset < base) {
+			image_upload_buf->status = MGMT_ERR_EINVAL;
+		} else if (active_client->upload.offset > base + sent) {
+			/* Offset further than expected which indicate upload session resume */
+			ahead = true;
+		} else if (in_flight == 0) {
+			sent = active_client->upload.offset - base;
+		}
+	}
+
+	if (image_upload_buf->status) {
+		LOG_ERR("Upload Fail: %d", image_upload_buf->status);
+	}
+}
+#endif
+
 int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data, size_t length,
 			   struct mcumgr_image_upload *res_buf)
 {
 	struct net_buf *nb;
 	const uint8_t *write_ptr;
 	int rc;
-	uint32_t map_count;
-	bool ok;
 	size_t write_length, max_data_length, offset_before_send, request_length, wrote_length;
-	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
 
 	k_mutex_lock(&mcumgr_img_client_grp_mutex, K_FOREVER);
 	active_client = client;
@@ -356,6 +506,11 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			(max_data_length % CONFIG_MCUMGR_GRP_IMG_UPLOAD_DATA_ALIGNMENT_SIZE);
 	}
 
+#if CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW > 1
+	upload_window(data, length, max_data_length);
+	goto end;
+#endif
+
 	while (request_length != wrote_length) {
 		write_ptr = data + wrote_length;
 		write_length = request_length - wrote_length;
@@ -363,55 +518,13 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			write_length = max_data_length;
 		}
 
-		nb = smp_client_buf_allocation(active_client->smp_client, MGMT_GROUP_ID_IMAGE,
-					       IMG_MGMT_ID_UPLOAD, MGMT_OP_WRITE,
-					       SMP_MCUMGR_VERSION_1);
+		nb = upload_chunk_encode(active_client->upload.offset, write_ptr, write_length);
 		if (!nb) {
 			image_upload_buf->status = MGMT_ERR_ENOMEM;
 			goto end;
 		}
 
-		zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len,
-				       net_buf_tailroom(nb), 0);
-		if (active_client->upload.offset) {
-			map_count = 6;
-		} else if (active_client->upload.hash_initialized) {
-			map_count = 12;
-		} else {
-			map_count = 10;
-		}
-
-		/* Init map start and write image info, data and offset */
-		ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
-		     zcbor_uint32_put(zse, active_client->upload.image_num) &&
-		     zcbor_tstr_put_lit(zse, "data") &&
-		     zcbor_bstr_encode_ptr(zse, write_ptr, write_length) &&
-		     zcbor_tstr_put_lit(zse, "off") &&
-		     zcbor_size_put(zse, active_client->upload.offset);
-		/* Write Len and configured hash when offset is zero */
-		if (ok && !active_client->upload.offset) {
-			ok = zcbor_tstr_put_lit(zse, "len") &&
-			     zcbor_size_put(zse, active_client->upload.image_size);
-			if (ok && active_client->upload.hash_initialized) {
-				ok = zcbor_tstr_put_lit(zse, "sha") &&
-				     zcbor_bstr_encode_ptr(zse, active_client->upload.sha256,
-							   IMG_MGMT_DATA_SHA_LEN);
-			}
-		}
-
-		if (ok) {
-			ok = zcbor_map_end_encode(zse, map_count);
-		}
-
-		if (!ok) {
-			LOG_ERR("Failed to encode Image Upload packet");
-			smp_packet_free(nb);
-			image_upload_buf->status = MGMT_ERR_ENOMEM;
-			goto end;
-		}
-
 		offset_before_send = active_client->upload.offset;
-		nb->len = zse->payload - nb->data;
 		k_sem_reset(&mcumgr_img_client_grp_sem);
 
 		image_upload_buf->status = MGMT_ERR_EINVAL;
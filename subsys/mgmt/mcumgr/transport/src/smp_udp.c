@@ -47,6 +47,8 @@ BUILD_ASSERT(sizeof(struct sockaddr) <= CONFIG_MCUMGR_TRANSPORT_NETBUF_USER_DATA
 				     _THREAD_SUSPENDED |		\
 				     _THREAD_QUEUED) ? true : false)
 
+#define SMP_UDP_ALLOC_RETRY_MS 10
+
 enum proto_type {
 	PROTOCOL_IPV4 = 0,
 	PROTOCOL_IPV6,
@@ -57,7 +59,9 @@ struct config {
 	enum proto_type proto;
 	struct k_sem network_ready_sem;
 	struct smp_transport smp_transport;
+#ifndef CONFIG_MCUMGR_TRANSPORT_UDP_ZERO_COPY
 	char recv_buffer[CONFIG_MCUMGR_TRANSPORT_UDP_MTU];
+#endif
 	struct k_thread thread;
 	K_KERNEL_STACK_MEMBER(stack, CONFIG_MCUMGR_TRANSPORT_UDP_STACK_SIZE);
 };
@@ -239,6 +243,43 @@ static void smp_udp_receive_thread(void *p1, void *p2, void *p3)
 	__ASSERT(rc >= 0, "Socket is invalid");
 	LOG_INF("Started (%s)", smp_udp_proto_to_name(conf->proto));
 
+#ifdef CONFIG_MCUMGR_TRANSPORT_UDP_ZERO_COPY
+	struct net_buf *nb = NULL;
+
+	while (1) {
+		struct sockaddr addr;
+		socklen_t addr_len = sizeof(addr);
+		struct sockaddr *ud;
+		int len;
+
+		if (nb == NULL) {
+			nb = smp_packet_alloc();
+			if (nb == NULL) {
+				/* Datagrams stay queued in the socket until a buffer is freed */
+				k_sleep(K_MSEC(SMP_UDP_ALLOC_RETRY_MS));
+				continue;
+			}
+		}
+
+		/* Receive straight into the buffer that will be handed to SMP */
+		len = zsock_recvfrom(conf->sock, nb->data,
+				     MIN(net_buf_tailroom(nb), CONFIG_MCUMGR_TRANSPORT_UDP_MTU), 0,
+				     &addr, &addr_len);
+
+		if (len > 0) {
+			net_buf_add(nb, len);
+			/* Store sender address in user data for reply */
+			ud = net_buf_user_data(nb);
+			net_ipaddr_copy(ud, &addr);
+
+			smp_rx_req(&conf->smp_transport, nb);
+			nb = NULL;
+		} else if (len < 0) {
+			LOG_ERR("recvfrom error (%s): %i, %d", smp_udp_proto_to_name(conf->proto),
+				errno, len);
+		}
+	}
+#else
 	while (1) {
 		struct sockaddr addr;
 		socklen_t addr_len = sizeof(addr);
@@ -267,6 +308,7 @@ static void smp_udp_receive_thread(void *p1, void *p2, void *p3)
 				errno, len);
 		}
 	}
+#endif
 }
 
 static void smp_udp_open_iface(struct net_if *iface, void *user_data)
@@ -51,10 +51,23 @@ static struct modbus_serial_config modbus_serial_cfg[] = {
 		.cfg = &modbus_serial_cfg[inst],		\
 	},
 
+#if CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE > 0
+#define DEFINE_MODBUS_RAW_ADU_QUEUE(x, _)			\
+	K_MSGQ_DEFINE(modbus_raw_rx_queue_##x, sizeof(struct modbus_adu),	\
+		      CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE, 4)
+
+LISTIFY(CONFIG_MODBUS_NUMOF_RAW_ADU, DEFINE_MODBUS_RAW_ADU_QUEUE, (;), _);
+
+#define MODBUS_RAW_ADU_QUEUE(x) .rx_queue = &modbus_raw_rx_queue_##x,
+#else
+#define MODBUS_RAW_ADU_QUEUE(x)
+#endif
+
 #define DEFINE_MODBUS_RAW_ADU(x, _) {				\
 		.iface_name = "RAW_"#x,				\
 		.rawcb.raw_tx_cb = NULL,				\
 		.mode = MODBUS_MODE_RAW,			\
+		MODBUS_RAW_ADU_QUEUE(x)				\
 	}
 
 
@@ -390,6 +403,9 @@ int modbus_disable(const uint8_t iface)
 		}
 		break;
 	case MODBUS_MODE_RAW:
+		if (IS_ENABLED(CONFIG_MODBUS_RAW_ADU)) {
+			modbus_raw_disable(ctx);
+		}
 		break;
 	default:
 		LOG_ERR("Unknown MODBUS mode");
@@ -123,6 +123,11 @@ struct modbus_context {
 	/* Records error from frame reception, e.g. CRC error */
 	int rx_adu_err;
 
+#if CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE > 0
+	/* Raw ADUs waiting to be processed */
+	struct k_msgq *rx_queue;
+#endif
+
 #ifdef CONFIG_MODBUS_FC08_DIAGNOSTIC
 	uint16_t mbs_msg_ctr;
 	uint16_t mbs_crc_err_ctr;
@@ -251,5 +256,6 @@ int modbus_raw_rx_adu(struct modbus_context *ctx);
 int modbus_raw_tx_adu(struct modbus_context *ctx);
 int modbus_raw_init(struct modbus_context *ctx,
 		    struct modbus_iface_param param);
+void modbus_raw_disable(struct modbus_context *ctx);
 
 #endif /* ZEPHYR_INCLUDE_MODBUS_INTERNAL_H_ */
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -17,6 +18,17 @@ LOG_MODULE_REGISTER(modbus_raw, CONFIG_MODBUS_LOG_LEVEL);
 
 int modbus_raw_rx_adu(struct modbus_context *ctx)
 {
+#if CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE > 0
+	if (k_msgq_get(ctx->rx_queue, &ctx->rx_adu, K_NO_WAIT) != 0) {
+		return -ENODATA;
+	}
+
+	if (k_msgq_num_used_get(ctx->rx_queue) > 0) {
+		/* Handle the next ADU once this one is done */
+		k_work_submit(&ctx->server_work);
+	}
+#endif
+
 	if (ctx->rx_adu.length < MODBUS_RAW_MIN_MSG_SIZE ||
 	    ctx->rx_adu.length > MODBUS_RAW_BUFFER_SIZE) {
 		LOG_WRN("Frame length error");
@@ -64,6 +76,12 @@ int modbus_raw_submit_rx(const int iface, const struct modbus_adu *adu)
 		return -ENOTSUP;
 	}
 
+#if CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE > 0
+	if (k_msgq_put(ctx->rx_queue, adu, K_NO_WAIT) != 0) {
+		LOG_WRN("Raw ADU queue full");
+		return -ENOBUFS;
+	}
+#else
 	ctx->rx_adu.trans_id = adu->trans_id;
 	ctx->rx_adu.proto_id = adu->proto_id;
 	ctx->rx_adu.length = adu->length;
@@ -71,6 +89,7 @@ int modbus_raw_submit_rx(const int iface, const struct modbus_adu *adu)
 	ctx->rx_adu.fc = adu->fc;
 	memcpy(ctx->rx_adu.data, adu->data,
 	       MIN(adu->length, sizeof(ctx->rx_adu.data)));
+#endif
 	k_work_submit(&ctx->server_work);
 
 	return 0;
@@ -180,4 +199,9 @@ int modbus_raw_init(struct modbus_context *ctx,
 
 void modbus_raw_disable(struct modbus_context *ctx)
 {
+#if CONFIG_MODBUS_RAW_ADU_QUEUE_SIZE > 0
+	k_msgq_purge(ctx->rx_queue);
+#else
+	ARG_UNUSED(ctx);
+#endif
 }
@@ -19,6 +19,7 @@
  *      Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <stddef.h>
 #include <string.h>
 #include <zephyr/sys/byteorder.h>
 #include <modbus_internal.h>
@@ -291,6 +292,51 @@ static bool mbs_fc02_di_read(struct modbus_context *ctx)
 	return true;
 }
 
+/*
+ * Integer registers handled by a range callback are exchanged in host order
+ * through the ADU buffers, so the data member has to be 16-bit aligned.
+ */
+BUILD_ASSERT(offsetof(struct modbus_adu, data) % sizeof(uint16_t) == 0);
+
+static bool mbs_int_regs_only(uint16_t reg_addr, uint16_t reg_qty)
+{
+	return !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS) ||
+	       (uint32_t)reg_addr + reg_qty <= MODBUS_FP_EXTENSIONS_ADDR;
+}
+
+/*
+ * Read a range of integer registers into the response payload, starting
+ * after the byte count. The callback fills the registers one byte past
+ * their place to have them aligned, then they are converted to big endian
+ * while moved down, each one before the next is touched.
+ */
+static int mbs_regs_rd(struct modbus_context *ctx,
+		       int (*regs_rd)(uint16_t addr, uint16_t *regs, uint16_t num),
+		       uint16_t reg_addr, uint16_t reg_qty)
+{
+	uint16_t *regs = (uint16_t *)&ctx->tx_adu.data[2];
+	uint8_t *presp = &ctx->tx_adu.data[1];
+	int err;
+
+	if (sizeof(uint16_t) + reg_qty * sizeof(uint16_t) > sizeof(ctx->tx_adu.data)) {
+		return -ENOMEM;
+	}
+
+	err = regs_rd(reg_addr, regs, reg_qty);
+	if (err != 0) {
+		return err;
+	}
+
+	for (uint16_t i = 0; i < reg_qty; i++) {
+		uint16_t reg = regs[i];
+
+		sys_put_be16(reg, presp);
+		presp += sizeof(uint16_t);
+	}
+
+	return 0;
+}
+
 /*
  * 03 (0x03) Read Holding Registers
  *
@@ -325,7 +371,8 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
-		if (ctx->mbs_user_cb->holding_reg_rd == NULL) {
+		if (ctx->mbs_user_cb->holding_reg_rd == NULL &&
+		    ctx->mbs_user_cb->holding_regs_rd == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
 		}
@@ -360,6 +407,18 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 	/* Set number of data bytes in response message. */
 	ctx->tx_adu.data[0] = (uint8_t)num_bytes;
 
+	if (ctx->mbs_user_cb->holding_regs_rd != NULL &&
+	    mbs_int_regs_only(reg_addr, reg_qty)) {
+		/* Read the whole range at once */
+		if (mbs_regs_rd(ctx, ctx->mbs_user_cb->holding_regs_rd,
+				reg_addr, reg_qty) != 0) {
+			LOG_INF("Holding register address not supported");
+			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		}
+
+		return true;
+	}
+
 	/* Reset the pointer to the start of the response payload */
 	presp = &ctx->tx_adu.data[1];
 	/* Loop through each register requested. */
@@ -368,7 +427,11 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 			uint16_t reg;
 
 			/* Read integer register */
-			err = ctx->mbs_user_cb->holding_reg_rd(reg_addr, &reg);
+			if (ctx->mbs_user_cb->holding_reg_rd == NULL) {
+				err = -ENOTSUP;
+			} else {
+				err = ctx->mbs_user_cb->holding_reg_rd(reg_addr, &reg);
+			}
 			if (err == 0) {
 				sys_put_be16(reg, presp);
 				presp += sizeof(uint16_t);
@@ -435,7 +498,8 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
-		if (ctx->mbs_user_cb->input_reg_rd == NULL) {
+		if (ctx->mbs_user_cb->input_reg_rd == NULL &&
+		    ctx->mbs_user_cb->input_regs_rd == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
 		}
@@ -470,6 +534,18 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 	/* Set number of data bytes in response message. */
 	ctx->tx_adu.data[0] = (uint8_t)num_bytes;
 
+	if (ctx->mbs_user_cb->input_regs_rd != NULL &&
+	    mbs_int_regs_only(reg_addr, reg_qty)) {
+		/* Read the whole range at once */
+		if (mbs_regs_rd(ctx, ctx->mbs_user_cb->input_regs_rd,
+				reg_addr, reg_qty) != 0) {
+			LOG_INF("Input register address not supported");
+			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		}
+
+		return true;
+	}
+
 	/* Reset the pointer to the start of the response payload */
 	presp = &ctx->tx_adu.data[1];
 	/* Loop through each register requested. */
@@ -478,7 +554,11 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 			uint16_t reg;
 
 			/* Read integer register */
-			err = ctx->mbs_user_cb->input_reg_rd(reg_addr, &reg);
+			if (ctx->mbs_user_cb->input_reg_rd == NULL) {
+				err = -ENOTSUP;
+			} else {
+				err = ctx->mbs_user_cb->input_reg_rd(reg_addr, &reg);
+			}
 			if (err == 0) {
 				sys_put_be16(reg, presp);
 				presp += sizeof(uint16_t);
@@ -596,7 +676,8 @@ static bool mbs_fc06_hreg_write(struct modbus_context *ctx)
 		return false;
 	}
 
-	if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
+	if (ctx->mbs_user_cb->holding_reg_wr == NULL &&
+	    ctx->mbs_user_cb->holding_regs_wr == NULL) {
 		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 		return true;
 	}
@@ -604,7 +685,11 @@ static bool mbs_fc06_hreg_write(struct modbus_context *ctx)
 	reg_addr = sys_get_be16(&ctx->rx_adu.data[0]);
 	reg_val = sys_get_be16(&ctx->rx_adu.data[2]);
 
-	err = ctx->mbs_user_cb->holding_reg_wr(reg_addr, reg_val);
+	if (ctx->mbs_user_cb->holding_reg_wr != NULL) {
+		err = ctx->mbs_user_cb->holding_reg_wr(reg_addr, reg_val);
+	} else {
+		err = ctx->mbs_user_cb->holding_regs_wr(reg_addr, &reg_val, 1);
+	}
 
 	if (err != 0) {
 		LOG_INF("Register address not supported");
@@ -848,7 +933,8 @@ static bool mbs_fc16_hregs_write(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Write integer register */
-		if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
+		if (ctx->mbs_user_cb->holding_reg_wr == NULL &&
+		    ctx->mbs_user_cb->holding_regs_wr == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
 		}
@@ -892,6 +978,37 @@ static bool mbs_fc16_hregs_write(struct modbus_context *ctx)
 	/* The 1st registers data byte is 6th element in payload */
 	prx_data = &ctx->rx_adu.data[5];
 
+	if (ctx->mbs_user_cb->holding_regs_wr != NULL &&
+	    ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
+	     !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS))) {
+		/*
+		 * Convert the registers to host order in place, moving them
+		 * one byte down over the byte count to have them aligned.
+		 */
+		uint16_t *regs = (uint16_t *)&ctx->rx_adu.data[4];
+
+		for (uint16_t i = 0; i < reg_qty; i++) {
+			uint16_t reg_val = sys_get_be16(prx_data);
+
+			prx_data += sizeof(uint16_t);
+			regs[i] = reg_val;
+		}
+
+		err = ctx->mbs_user_cb->holding_regs_wr(reg_addr, regs, reg_qty);
+		if (err != 0) {
+			LOG_INF("Register address not supported");
+			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+			return true;
+		}
+
+		/* Assemble response payload */
+		ctx->tx_adu.length = response_len;
+		sys_put_be16(reg_addr, &ctx->tx_adu.data[0]);
+		sys_put_be16(reg_qty, &ctx->tx_adu.data[2]);
+
+		return true;
+	}
+
 	for (uint16_t reg_cntr = 0; reg_cntr < reg_qty; reg_cntr++) {
 		uint16_t addr = reg_addr + reg_cntr;
 
@@ -13,12 +13,12 @@ LOG_MODULE_REGISTER(modem_cmux, CONFIG_MODEM_CMUX_LOG_LEVEL);
 
 #include <string.h>
 
-#define MODEM_CMUX_FCS_POLYNOMIAL		(0xE0)
-#define MODEM_CMUX_FCS_INIT_VALUE		(0xFF)
+#define MODEM_CMUX_FCS_INIT_VALUE		(CRC8_ROHC_INITIAL_VALUE)
 #define MODEM_CMUX_EA				(0x01)
 #define MODEM_CMUX_CR				(0x02)
 #define MODEM_CMUX_PF				(0x10)
 #define MODEM_CMUX_FRAME_SIZE_MAX		(0x08)
+#define MODEM_CMUX_HEADER_SIZE_MAX		(0x05)
 #define MODEM_CMUX_DATA_SIZE_MIN		(0x08)
 #define MODEM_CMUX_DATA_FRAME_SIZE_MIN		(MODEM_CMUX_FRAME_SIZE_MAX + \
 						 MODEM_CMUX_DATA_SIZE_MIN)
@@ -263,18 +263,12 @@ static void modem_cmux_bus_callback(struct modem_pipe *pipe, enum modem_pipe_eve
 	}
 }
 
-static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
-					  const struct modem_cmux_frame *frame)
+/* Encode SOF, address, control and length fields and return their size */
+static uint16_t modem_cmux_encode_header(const struct modem_cmux_frame *frame, uint16_t data_len,
+					 uint8_t *buf)
 {
-	uint8_t buf[MODEM_CMUX_FRAME_SIZE_MAX];
-	uint8_t fcs;
-	uint16_t space;
-	uint16_t data_len;
 	uint16_t buf_idx;
 
-	space = ring_buf_space_get(&cmux->transmit_rb) - MODEM_CMUX_FRAME_SIZE_MAX;
-	data_len = MIN(space, frame->data_len);
-
 	/* SOF */
 	buf[0] = 0xF9;
 
@@ -294,15 +288,31 @@ static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
 		buf_idx = 4;
 	}
 
+	return buf_idx;
+}
+
+static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
+					  const struct modem_cmux_frame *frame)
+{
+	uint8_t buf[MODEM_CMUX_FRAME_SIZE_MAX];
+	uint8_t fcs;
+	uint16_t space;
+	uint16_t data_len;
+	uint16_t buf_idx;
+
+	space = ring_buf_space_get(&cmux->transmit_rb) - MODEM_CMUX_FRAME_SIZE_MAX;
+	data_len = MIN(space, frame->data_len);
+
+	buf_idx = modem_cmux_encode_header(frame, data_len, buf);
+
 	/* Compute FCS for the header (exclude SOF) */
-	fcs = crc8(&buf[1], (buf_idx - 1), MODEM_CMUX_FCS_POLYNOMIAL, MODEM_CMUX_FCS_INIT_VALUE,
-		   true);
+	fcs = crc8_rohc(MODEM_CMUX_FCS_INIT_VALUE, &buf[1], (buf_idx - 1));
 
 	/* FCS final */
 	if (frame->type == MODEM_CMUX_FRAME_TYPE_UIH) {
 		fcs = 0xFF - fcs;
 	} else {
-		fcs = 0xFF - crc8(frame->data, data_len, MODEM_CMUX_FCS_POLYNOMIAL, fcs, true);
+		fcs = 0xFF - crc8_rohc(fcs, frame->data, data_len);
 	}
 
 	/* Frame header */
@@ -752,11 +762,9 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 	case MODEM_CMUX_RECEIVE_STATE_ADDRESS:
 		/* Initialize */
 		cmux->receive_buf_len = 0;
-		cmux->frame_header_len = 0;
 
-		/* Store header for FCS */
-		cmux->frame_header[cmux->frame_header_len] = byte;
-		cmux->frame_header_len++;
+		/* Start FCS with the header */
+		cmux->receive_fcs = crc8_rohc(MODEM_CMUX_FCS_INIT_VALUE, &byte, 1);
 
 		/* Get CR */
 		cmux->frame.cr = (byte & 0x02) ? true : false;
@@ -769,9 +777,8 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		break;
 
 	case MODEM_CMUX_RECEIVE_STATE_CONTROL:
-		/* Store header for FCS */
-		cmux->frame_header[cmux->frame_header_len] = byte;
-		cmux->frame_header_len++;
+		/* Add header to FCS */
+		cmux->receive_fcs = crc8_rohc(cmux->receive_fcs, &byte, 1);
 
 		/* Get PF */
 		cmux->frame.pf = (byte & MODEM_CMUX_PF) ? true : false;
@@ -784,9 +791,8 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		break;
 
 	case MODEM_CMUX_RECEIVE_STATE_LENGTH:
-		/* Store header for FCS */
-		cmux->frame_header[cmux->frame_header_len] = byte;
-		cmux->frame_header_len++;
+		/* Add header to FCS */
+		cmux->receive_fcs = crc8_rohc(cmux->receive_fcs, &byte, 1);
 
 		/* Get first 7 bits of data length */
 		cmux->frame.data_len = (byte >> 1);
@@ -810,30 +816,21 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		break;
 
 	case MODEM_CMUX_RECEIVE_STATE_LENGTH_CONT:
-		/* Store header for FCS */
-		cmux->frame_header[cmux->frame_header_len] = byte;
-		cmux->frame_header_len++;
+		/* Add header to FCS */
+		cmux->receive_fcs = crc8_rohc(cmux->receive_fcs, &byte, 1);
 
 		/* Get last 8 bits of data length */
 		cmux->frame.data_len |= ((uint16_t)byte) << 7;
 
-		/* Await data */
-		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_DATA;
-		break;
-
-	case MODEM_CMUX_RECEIVE_STATE_DATA:
-		/* Copy byte to data */
-		if (cmux->receive_buf_len < cmux->receive_buf_size) {
-			cmux->receive_buf[cmux->receive_buf_len] = byte;
-		}
-		cmux->receive_buf_len++;
-
-		/* Check if datalen reached */
-		if (cmux->frame.data_len == cmux->receive_buf_len) {
+		/* Check if no data field */
+		if (cmux->frame.data_len == 0) {
 			/* Await FCS */
 			cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_FCS;
+			break;
 		}
 
+		/* Await data */
+		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_DATA;
 		break;
 
 	case MODEM_CMUX_RECEIVE_STATE_FCS:
@@ -844,18 +841,8 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 			break;
 		}
 
-		/* Compute FCS */
-		if (cmux->frame.type == MODEM_CMUX_FRAME_TYPE_UIH) {
-			fcs = 0xFF - crc8(cmux->frame_header, cmux->frame_header_len,
-					  MODEM_CMUX_FCS_POLYNOMIAL, MODEM_CMUX_FCS_INIT_VALUE,
-					  true);
-		} else {
-			fcs = crc8(cmux->frame_header, cmux->frame_header_len,
-				   MODEM_CMUX_FCS_POLYNOMIAL, MODEM_CMUX_FCS_INIT_VALUE, true);
-
-			fcs = 0xFF - crc8(cmux->frame.data, cmux->frame.data_len,
-					  MODEM_CMUX_FCS_POLYNOMIAL, fcs, true);
-		}
+		/* FCS covers the header, and the data of frames other than UIH */
+		fcs = 0xFF - cmux->receive_fcs;
 
 		/* Validate FCS */
 		if (fcs != byte) {
@@ -894,6 +881,50 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 	}
 }
 
+/* Copy as much of the data field as the block holds, updating the FCS on the way */
+static size_t modem_cmux_process_received_data_field(struct modem_cmux *cmux,
+						     const uint8_t *data, size_t len)
+{
+	size_t copy_len;
+
+	len = MIN(len, cmux->frame.data_len - cmux->receive_buf_len);
+
+	if (cmux->receive_buf_len < cmux->receive_buf_size) {
+		copy_len = MIN(len, cmux->receive_buf_size - cmux->receive_buf_len);
+		memcpy(&cmux->receive_buf[cmux->receive_buf_len], data, copy_len);
+
+		if (cmux->frame.type != MODEM_CMUX_FRAME_TYPE_UIH) {
+			cmux->receive_fcs = crc8_rohc(cmux->receive_fcs, data, copy_len);
+		}
+	}
+
+	cmux->receive_buf_len += len;
+
+	/* Check if datalen reached */
+	if (cmux->frame.data_len == cmux->receive_buf_len) {
+		/* Await FCS */
+		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_FCS;
+	}
+
+	return len;
+}
+
+static void modem_cmux_process_received_data(struct modem_cmux *cmux, const uint8_t *data,
+					     size_t len)
+{
+	size_t i = 0;
+
+	while (i < len) {
+		if (cmux->receive_state == MODEM_CMUX_RECEIVE_STATE_DATA) {
+			i += modem_cmux_process_received_data_field(cmux, &data[i], len - i);
+			continue;
+		}
+
+		modem_cmux_process_received_byte(cmux, data[i]);
+		i++;
+	}
+}
+
 static void modem_cmux_receive_handler(struct k_work *item)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(item);
@@ -910,9 +941,7 @@ static void modem_cmux_receive_handler(struct k_work *item)
 	}
 
 	/* Process received data */
-	for (int i = 0; i < ret; i++) {
-		modem_cmux_process_received_byte(cmux, cmux->work_buf[i]);
-	}
+	modem_cmux_process_received_data(cmux, cmux->work_buf, ret);
 
 	/* Reschedule received work */
 	k_work_schedule(&cmux->receive_work, K_NO_WAIT);
@@ -1110,6 +1139,131 @@ static int modem_cmux_dlci_pipe_api_receive(void *data, uint8_t *buf, size_t siz
 	return ret;
 }
 
+static int modem_cmux_dlci_pipe_api_transmit_claim(void *data, uint8_t **buf, size_t size)
+{
+	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
+	struct modem_cmux *cmux = dlci->cmux;
+	uint32_t claimed_size;
+	uint32_t space;
+
+	/* Held until the frame is committed */
+	k_mutex_lock(&cmux->transmit_rb_lock, K_FOREVER);
+
+	if (cmux->flow_control_on == false) {
+		k_mutex_unlock(&cmux->transmit_rb_lock);
+		return 0;
+	}
+
+	/* Make the whole buffer contiguous again when it has been drained */
+	if (ring_buf_is_empty(&cmux->transmit_rb)) {
+		ring_buf_reset(&cmux->transmit_rb);
+	}
+
+	/* Same reservation for the command channel as modem_cmux_transmit_data_frame() */
+	space = ring_buf_space_get(&cmux->transmit_rb);
+	if (space < ((MODEM_CMUX_CMD_FRAME_SIZE_MAX * 2) + MODEM_CMUX_DATA_FRAME_SIZE_MIN)) {
+		k_mutex_unlock(&cmux->transmit_rb_lock);
+		return -ENOMEM;
+	}
+
+	space -= (MODEM_CMUX_CMD_FRAME_SIZE_MAX * 2) + MODEM_CMUX_FRAME_SIZE_MAX;
+	size = MIN(size, MIN(space, 0x7FFF));
+
+	/* The data goes behind room for the longest header */
+	claimed_size = ring_buf_put_claim(&cmux->transmit_rb, &cmux->transmit_claim,
+					  MODEM_CMUX_HEADER_SIZE_MAX + size);
+	if (claimed_size < (MODEM_CMUX_HEADER_SIZE_MAX + MODEM_CMUX_DATA_SIZE_MIN)) {
+		ring_buf_put_finish(&cmux->transmit_rb, 0);
+		cmux->transmit_claim = NULL;
+		k_mutex_unlock(&cmux->transmit_rb_lock);
+		return -ENOMEM;
+	}
+
+	cmux->transmit_claim_size = claimed_size - MODEM_CMUX_HEADER_SIZE_MAX;
+	*buf = &cmux->transmit_claim[MODEM_CMUX_HEADER_SIZE_MAX];
+	return cmux->transmit_claim_size;
+}
+
+static int modem_cmux_dlci_pipe_api_transmit_commit(void *data, size_t size)
+{
+	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
+	struct modem_cmux *cmux = dlci->cmux;
+	uint8_t *claim = cmux->transmit_claim;
+	uint8_t header[MODEM_CMUX_HEADER_SIZE_MAX];
+	uint8_t trailer[2];
+	uint16_t header_len;
+
+	struct modem_cmux_frame frame = {
+		.dlci_address = dlci->dlci_address,
+		.cr = true,
+		.pf = false,
+		.type = MODEM_CMUX_FRAME_TYPE_UIH,
+		.data_len = size,
+	};
+
+	if (claim == NULL) {
+		return -EINVAL;
+	}
+
+	__ASSERT(size <= cmux->transmit_claim_size, "Committed more than claimed");
+
+	cmux->transmit_claim = NULL;
+
+	if (size == 0) {
+		ring_buf_put_finish(&cmux->transmit_rb, 0);
+		k_mutex_unlock(&cmux->transmit_rb_lock);
+		return 0;
+	}
+
+	/* Short frames have a single length byte, close the gap it leaves */
+	header_len = modem_cmux_encode_header(&frame, size, header);
+	if (header_len < MODEM_CMUX_HEADER_SIZE_MAX) {
+		memmove(&claim[header_len], &claim[MODEM_CMUX_HEADER_SIZE_MAX], size);
+	}
+
+	memcpy(claim, header, header_len);
+	frame.data = &claim[header_len];
+	modem_cmux_log_transmit_frame(&frame);
+
+	/* The FCS of UIH frames only covers the header (exclude SOF) */
+	trailer[0] = 0xFF - crc8_rohc(MODEM_CMUX_FCS_INIT_VALUE, &header[1], header_len - 1);
+	trailer[1] = 0xF9;
+
+	ring_buf_put_finish(&cmux->transmit_rb, header_len + size);
+	ring_buf_put(&cmux->transmit_rb, trailer, sizeof(trailer));
+	k_work_schedule(&cmux->transmit_work, K_NO_WAIT);
+
+	k_mutex_unlock(&cmux->transmit_rb_lock);
+	return size;
+}
+
+static int modem_cmux_dlci_pipe_api_receive_claim(void *data, uint8_t **buf, size_t size)
+{
+	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
+	uint32_t ret;
+
+	k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
+
+#if CONFIG_MODEM_STATS
+	modem_cmux_dlci_advertise_receive_buf_stat(dlci);
+#endif
+
+	ret = ring_buf_get_claim(&dlci->receive_rb, buf, size);
+	k_mutex_unlock(&dlci->receive_rb_lock);
+	return ret;
+}
+
+static int modem_cmux_dlci_pipe_api_receive_finish(void *data, size_t size)
+{
+	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
+	int ret;
+
+	k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
+	ret = ring_buf_get_finish(&dlci->receive_rb, size);
+	k_mutex_unlock(&dlci->receive_rb_lock);
+	return ret;
+}
+
 static int modem_cmux_dlci_pipe_api_close(void *data)
 {
 	struct modem_cmux_dlci *dlci = (struct modem_cmux_dlci *)data;
@@ -1127,6 +1281,10 @@ struct modem_pipe_api modem_cmux_dlci_pipe_api = {
 	.transmit = modem_cmux_dlci_pipe_api_transmit,
 	.receive = modem_cmux_dlci_pipe_api_receive,
 	.close = modem_cmux_dlci_pipe_api_close,
+	.transmit_claim = modem_cmux_dlci_pipe_api_transmit_claim,
+	.transmit_commit = modem_cmux_dlci_pipe_api_transmit_commit,
+	.receive_claim = modem_cmux_dlci_pipe_api_receive_claim,
+	.receive_finish = modem_cmux_dlci_pipe_api_receive_finish,
 };
 
 static void modem_cmux_dlci_open_handler(struct k_work *item)
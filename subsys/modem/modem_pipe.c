@@ -124,6 +124,76 @@ int modem_pipe_receive(struct modem_pipe *pipe, uint8_t *buf, size_t size)
 	return ret;
 }
 
+int modem_pipe_transmit_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size)
+{
+	int ret;
+
+	if (pipe->api->transmit_claim == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+
+	if (pipe->state == MODEM_PIPE_STATE_CLOSED) {
+		k_mutex_unlock(&pipe->lock);
+		return -EPERM;
+	}
+
+	ret = pipe->api->transmit_claim(pipe->data, buf, size);
+	k_mutex_unlock(&pipe->lock);
+	return ret;
+}
+
+int modem_pipe_transmit_commit(struct modem_pipe *pipe, size_t size)
+{
+	int ret;
+
+	if (pipe->api->transmit_commit == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+	ret = pipe->api->transmit_commit(pipe->data, size);
+	pipe->transmit_idle_pending = false;
+	k_mutex_unlock(&pipe->lock);
+	return ret;
+}
+
+int modem_pipe_receive_claim(struct modem_pipe *pipe, uint8_t **buf, size_t size)
+{
+	int ret;
+
+	if (pipe->api->receive_claim == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+
+	if (pipe->state == MODEM_PIPE_STATE_CLOSED) {
+		k_mutex_unlock(&pipe->lock);
+		return -EPERM;
+	}
+
+	ret = pipe->api->receive_claim(pipe->data, buf, size);
+	k_mutex_unlock(&pipe->lock);
+	return ret;
+}
+
+int modem_pipe_receive_finish(struct modem_pipe *pipe, size_t size)
+{
+	int ret;
+
+	if (pipe->api->receive_finish == NULL) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&pipe->lock, K_FOREVER);
+	ret = pipe->api->receive_finish(pipe->data, size);
+	pipe->receive_ready_pending = false;
+	k_mutex_unlock(&pipe->lock);
+	return ret;
+}
+
 void modem_pipe_release(struct modem_pipe *pipe)
 {
 	k_mutex_lock(&pipe->lock, K_FOREVER);
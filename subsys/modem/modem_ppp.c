@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2022 Trackunit Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,6 +8,7 @@
 #include <zephyr/net/ppp.h>
 #include <zephyr/sys/crc.h>
 #include <zephyr/modem/ppp.h>
+#include <zephyr/toolchain.h>
 #include <string.h>
 
 #include <zephyr/logging/log.h>
@@ -19,6 +21,68 @@ LOG_MODULE_REGISTER(modem_ppp, CONFIG_MODEM_MODULES_LOG_LEVEL);
 #define MODEM_PPP_CODE_ESCAPE		(0x7D)
 #define MODEM_PPP_VALUE_ESCAPE		(0x20)
 
+/* Bytes of a word equal to zero, or less than value, set the top bit of the
+ * corresponding byte of the result.
+ */
+#define MODEM_PPP_WORD_BYTES(value)		(0x01010101U * (value))
+#define MODEM_PPP_WORD_HAS_LESS(word, value)					\
+	(((word) - MODEM_PPP_WORD_BYTES(value)) & ~(word) & MODEM_PPP_WORD_BYTES(0x80))
+#define MODEM_PPP_WORD_HAS_ZERO(word)		MODEM_PPP_WORD_HAS_LESS(word, 1)
+#define MODEM_PPP_WORD_HAS(word, value)						\
+	MODEM_PPP_WORD_HAS_ZERO((word) ^ MODEM_PPP_WORD_BYTES(value))
+
+static bool modem_ppp_byte_needs_escape(uint8_t byte)
+{
+	return (byte == MODEM_PPP_CODE_DELIMITER) || (byte == MODEM_PPP_CODE_ESCAPE) ||
+	       (byte < MODEM_PPP_VALUE_ESCAPE);
+}
+
+/* Get the number of leading bytes which need no escaping, a word at a time */
+static size_t modem_ppp_escape_span(const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t word;
+
+	for (; (len - i) >= sizeof(word); i += sizeof(word)) {
+		word = UNALIGNED_GET((const uint32_t *)&data[i]);
+
+		if (MODEM_PPP_WORD_HAS(word, MODEM_PPP_CODE_DELIMITER) ||
+		    MODEM_PPP_WORD_HAS(word, MODEM_PPP_CODE_ESCAPE) ||
+		    MODEM_PPP_WORD_HAS_LESS(word, MODEM_PPP_VALUE_ESCAPE)) {
+			break;
+		}
+	}
+
+	while ((i < len) && !modem_ppp_byte_needs_escape(data[i])) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Get the number of leading bytes which are neither delimiters nor escapes */
+static size_t modem_ppp_unescape_span(const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t word;
+
+	for (; (len - i) >= sizeof(word); i += sizeof(word)) {
+		word = UNALIGNED_GET((const uint32_t *)&data[i]);
+
+		if (MODEM_PPP_WORD_HAS(word, MODEM_PPP_CODE_DELIMITER) ||
+		    MODEM_PPP_WORD_HAS(word, MODEM_PPP_CODE_ESCAPE)) {
+			break;
+		}
+	}
+
+	while ((i < len) && (data[i] != MODEM_PPP_CODE_DELIMITER) &&
+	       (data[i] != MODEM_PPP_CODE_ESCAPE)) {
+		i++;
+	}
+
+	return i;
+}
+
 static uint16_t modem_ppp_fcs_init(uint8_t byte)
 {
 	return crc16_ccitt(0xFFFF, &byte, 1);
@@ -192,6 +256,58 @@ static uint8_t modem_ppp_wrap_net_pkt_byte(struct modem_ppp *ppp)
 	return 0;
 }
 
+/*
+ * Wrap the data of the packet being sent a block at a time, which is much faster than
+ * modem_ppp_wrap_net_pkt_byte(). Runs of bytes which need no escaping are copied to the
+ * transmit buffer at once, with the FCS updated over them in the same pass. Returns once
+ * the data is wrapped, or the transmit buffer is full.
+ */
+static void modem_ppp_wrap_net_pkt_data(struct modem_ppp *ppp)
+{
+	struct net_pkt *pkt = ppp->tx_pkt;
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	uint8_t escaped[2] = {MODEM_PPP_CODE_ESCAPE};
+	uint32_t space;
+	uint8_t *data;
+	size_t len;
+
+	/* Read the packet in place, the contiguous length is then the one of the data */
+	net_pkt_set_overwrite(pkt, true);
+
+	while (ppp->transmit_state == MODEM_PPP_TRANSMIT_STATE_DATA) {
+		space = ring_buf_space_get(&ppp->transmit_rb);
+		len = net_pkt_get_contiguous_len(pkt);
+		data = net_pkt_cursor_get_pos(pkt);
+
+		if ((space == 0) || (len == 0)) {
+			break;
+		}
+
+		len = modem_ppp_escape_span(data, MIN(len, space));
+		if (len > 0) {
+			ring_buf_put(&ppp->transmit_rb, data, len);
+		} else {
+			/* Leave escaping to the byte wise path if it does not fit */
+			if (space < sizeof(escaped)) {
+				break;
+			}
+
+			escaped[1] = data[0] ^ MODEM_PPP_VALUE_ESCAPE;
+			ring_buf_put(&ppp->transmit_rb, escaped, sizeof(escaped));
+			len = 1;
+		}
+
+		ppp->tx_pkt_fcs = crc16_ccitt(ppp->tx_pkt_fcs, data, len);
+		net_pkt_skip(pkt, len);
+
+		if (net_pkt_remaining_data(pkt) == 0) {
+			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_FCS_LOW;
+		}
+	}
+
+	net_pkt_set_overwrite(pkt, overwrite);
+}
+
 static bool modem_ppp_is_byte_expected(uint8_t byte, uint8_t expected_byte)
 {
 	if (byte == expected_byte) {
@@ -313,6 +429,39 @@ static void modem_ppp_process_received_byte(struct modem_ppp *ppp, uint8_t byte)
 	}
 }
 
+/*
+ * Write the data of the frame being received a block at a time, up to the next delimiter
+ * or escape, directly into the packet. Returns the number of bytes consumed, 0 to leave
+ * the next byte to modem_ppp_process_received_byte().
+ */
+static size_t modem_ppp_process_received_data(struct modem_ppp *ppp, const uint8_t *data,
+					      size_t len)
+{
+	size_t available = net_pkt_available_buffer(ppp->rx_pkt);
+
+	/* Allocating buffers is left to the byte wise path */
+	if (available <= 1) {
+		return 0;
+	}
+
+	len = modem_ppp_unescape_span(data, MIN(len, available - 1));
+	if (len == 0) {
+		return 0;
+	}
+
+	if (net_pkt_write(ppp->rx_pkt, data, len) < 0) {
+		LOG_WRN("Dropped PPP frame");
+		net_pkt_unref(ppp->rx_pkt);
+		ppp->rx_pkt = NULL;
+		ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+#if defined(CONFIG_NET_STATISTICS_PPP)
+		ppp->stats.drop++;
+#endif
+	}
+
+	return len;
+}
+
 #if CONFIG_MODEM_STATS
 static uint32_t get_transmit_buf_length(struct modem_ppp *ppp)
 {
@@ -373,6 +522,17 @@ static void modem_ppp_send_handler(struct k_work *item)
 
 		/* Fill transmit ring buffer */
 		while (ring_buf_space_get(&ppp->transmit_rb) > 0) {
+			if (ppp->transmit_state == MODEM_PPP_TRANSMIT_STATE_DATA) {
+				modem_ppp_wrap_net_pkt_data(ppp);
+
+				/* Stop if the transmit buffer is full */
+				if (ppp->transmit_state == MODEM_PPP_TRANSMIT_STATE_DATA) {
+					break;
+				}
+
+				continue;
+			}
+
 			byte = modem_ppp_wrap_net_pkt_byte(ppp);
 
 			ring_buf_put(&ppp->transmit_rb, &byte, 1);
@@ -420,8 +580,19 @@ static void modem_ppp_process_handler(struct k_work *item)
 	advertise_receive_buf_stats(ppp, ret);
 #endif
 
-	for (int i = 0; i < ret; i++) {
+	for (int i = 0; i < ret;) {
+		if (ppp->receive_state == MODEM_PPP_RECEIVE_STATE_WRITING) {
+			size_t len = modem_ppp_process_received_data(ppp, &ppp->receive_buf[i],
+								     ret - i);
+
+			if (len > 0) {
+				i += len;
+				continue;
+			}
+		}
+
 		modem_ppp_process_received_byte(ppp, ppp->receive_buf[i]);
+		i++;
 	}
 
 	k_work_submit(&ppp->process_work);
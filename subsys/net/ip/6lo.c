@@ -832,9 +832,14 @@ sa_end:
 
 	compressed = inline_pos - pkt->buffer->data;
 
+	/* The compressed header has been written in place right in front of
+	 * the payload, so dropping the leftover of the original headers only
+	 * requires to move the data pointer of the first fragment. The freed
+	 * bytes become headroom. This avoids moving the whole packet around,
+	 * callers that need a compact packet have to compact it themselves.
+	 */
+	net_buf_pull(pkt->buffer, compressed);
 	net_pkt_cursor_init(pkt);
-	net_pkt_pull(pkt, compressed);
-	net_pkt_compact(pkt);
 
 	return compressed;
 }
@@ -23,8 +23,10 @@
  *  @brief Compress IPv6 packet as per RFC 6282
  *
  *  @details After this IPv6 packet and next header(if UDP), headers
- *  are compressed as per RFC 6282. After header compression data
- *  will be adjusted according to remaining space in fragments.
+ *  are compressed as per RFC 6282. IPHC compression happens in place in
+ *  the first fragment: the space saved by compression becomes headroom of
+ *  that fragment and the remaining fragments are left untouched, i.e. the
+ *  packet is not compacted.
  *
  *  @param Pointer to network packet
  *  @param iphc true for IPHC compression, false for IPv6 dispatch header
@@ -116,6 +116,141 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define NET_CONN_FULLY_SPEC (NET_CONN_REMOTE_PORT_SPEC | NET_CONN_LOCAL_PORT_SPEC | \
+			     NET_CONN_REMOTE_ADDR_SPEC | NET_CONN_LOCAL_ADDR_SPEC)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NET_CONN_HASH_BUCKETS),
+	     "CONFIG_NET_CONN_HASH_BUCKETS must be a power of two");
+
+/* Index of the connections bound to a complete address/port tuple,
+ * i.e. the ones with the highest possible rank. A packet addressed to
+ * such a connection cannot match anything better, so it can be
+ * delivered without scanning the whole connection list. Protected by
+ * conn_lock.
+ */
+static sys_slist_t conn_hash_table[CONFIG_NET_CONN_HASH_BUCKETS];
+
+static uint32_t conn_hash(uint16_t proto,
+			  const uint8_t *remote_addr, const uint8_t *local_addr,
+			  size_t addr_len, uint16_t remote_port, uint16_t local_port)
+{
+	uint32_t hash = (((uint32_t)remote_port << 16) | local_port) ^ proto;
+
+	for (size_t i = 0; i < addr_len; i += sizeof(uint32_t)) {
+		hash = (hash ^ UNALIGNED_GET((const uint32_t *)&remote_addr[i])) * 0x9e3779b1U;
+		hash = (hash ^ UNALIGNED_GET((const uint32_t *)&local_addr[i])) * 0x9e3779b1U;
+	}
+
+	return (hash ^ (hash >> 16)) & (CONFIG_NET_CONN_HASH_BUCKETS - 1);
+}
+
+static const uint8_t *conn_hash_addr(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return net_sin6(addr)->sin6_addr.s6_addr;
+	}
+
+	return net_sin(addr)->sin_addr.s4_addr;
+}
+
+static bool conn_is_hashed(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_FULLY_SPEC) != NET_CONN_FULLY_SPEC) {
+		return false;
+	}
+
+	if (conn->proto != IPPROTO_TCP && conn->proto != IPPROTO_UDP) {
+		return false;
+	}
+
+	return (IS_ENABLED(CONFIG_NET_IPV4) && conn->family == AF_INET) ||
+	       (IS_ENABLED(CONFIG_NET_IPV6) && conn->family == AF_INET6);
+}
+
+static sys_slist_t *conn_hash_bucket(struct net_conn *conn)
+{
+	size_t addr_len = conn->family == AF_INET6 ? NET_IPV6_ADDR_SIZE :
+						     NET_IPV4_ADDR_SIZE;
+
+	return &conn_hash_table[conn_hash(conn->proto,
+					  conn_hash_addr(&conn->remote_addr),
+					  conn_hash_addr(&conn->local_addr),
+					  addr_len,
+					  net_sin(&conn->remote_addr)->sin_port,
+					  net_sin(&conn->local_addr)->sin_port)];
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	if (conn_is_hashed(conn)) {
+		sys_slist_prepend(conn_hash_bucket(conn), &conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held, before the flags or addresses
+ * of the connection change.
+ */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	if (conn_is_hashed(conn)) {
+		(void)sys_slist_find_and_remove(conn_hash_bucket(conn),
+						&conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto,
+				       uint16_t src_port,
+				       uint16_t dst_port)
+{
+	uint8_t family = net_pkt_family(pkt);
+	const uint8_t *src, *dst;
+	struct net_conn *conn;
+	size_t addr_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+		addr_len = NET_IPV4_ADDR_SIZE;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+		addr_len = NET_IPV6_ADDR_SIZE;
+	} else {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_hash_table[conn_hash(proto, src, dst, addr_len,
+								src_port, dst_port)],
+				     conn, hash_node) {
+		if (conn->proto != proto || conn->family != family ||
+		    net_sin(&conn->remote_addr)->sin_port != src_port ||
+		    net_sin(&conn->local_addr)->sin_port != dst_port ||
+		    memcmp(conn_hash_addr(&conn->remote_addr), src, addr_len) != 0 ||
+		    memcmp(conn_hash_addr(&conn->local_addr), dst, addr_len) != 0) {
+			continue;
+		}
+
+		if (conn->context != NULL &&
+		    net_context_is_bound_to_iface(conn->context) &&
+		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+			continue; /* wrong interface */
+		}
+
+		return conn;
+	}
+
+	return NULL;
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +276,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -452,6 +588,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -478,8 +615,14 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_remove(conn);
+
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
+
 	return ret;
 }
 
@@ -700,6 +843,19 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/* A connection bound to the complete address/port tuple of the
+	 * packet is the best possible match, so look that up first.
+	 */
+	if (IS_ENABLED(CONFIG_NET_IP) && !is_mcast_pkt && !is_bcast_pkt &&
+	    (proto == IPPROTO_TCP || proto == IPPROTO_UDP)) {
+		best_match = conn_hash_find(pkt, ip_hdr, proto, src_port, dst_port);
+		if (best_match != NULL) {
+			goto found;
+		}
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -868,6 +1024,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+#if defined(CONFIG_NET_CONN_HASH)
+found:
+#endif
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -955,6 +1114,12 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash_table[i]);
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
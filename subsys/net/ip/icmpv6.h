@@ -102,6 +102,10 @@ struct net_icmpv6_echo_req {
 	uint16_t sequence;
 } __packed;
 
+struct net_icmpv6_ptb {
+	uint32_t mtu;
+} __packed;
+
 struct net_icmpv6_mld_query {
 	uint16_t max_response_code;
 	uint16_t reserved;
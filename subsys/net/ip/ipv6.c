@@ -33,6 +33,7 @@ LOG_MODULE_REGISTER(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "nbr.h"
 #include "6lo.h"
 #include "route.h"
+#include "pmtu.h"
 #include "net_stats.h"
 
 BUILD_ASSERT(sizeof(struct in6_addr) == NET_IPV6_ADDR_SIZE);
@@ -313,6 +314,19 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	struct net_route_entry *route;
 	struct in6_addr *nexthop;
 	bool found;
+	int ret;
+
+	/* Packets of a recently forwarded flow go to the same next hop */
+	if (net_route_flow_packet(pkt, (struct in6_addr *)hdr->src,
+				  (struct in6_addr *)hdr->dst, &ret)) {
+		if (ret < 0) {
+			NET_DBG("Cannot re-route pkt %p at iface %p (%d)",
+				pkt, net_pkt_iface(pkt), ret);
+			return NET_DROP;
+		}
+
+		return NET_OK;
+	}
 
 	/* Check if the packet can be routed */
 	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
@@ -325,8 +339,6 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	}
 
 	if (found) {
-		int ret;
-
 		if (IS_ENABLED(CONFIG_NET_ROUTING) &&
 		    (net_ipv6_is_ll_addr((struct in6_addr *)hdr->src) ||
 		     net_ipv6_is_ll_addr((struct in6_addr *)hdr->dst))) {
@@ -359,6 +371,13 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 				  (struct in6_addr *)hdr->src, 128);
 		}
 
+		/* The addresses are saved first as the header is gone
+		 * once the packet is sent.
+		 */
+		net_route_flow_add(net_pkt_orig_iface(pkt),
+				   (struct in6_addr *)hdr->src,
+				   (struct in6_addr *)hdr->dst, nexthop);
+
 		ret = net_route_packet(pkt, nexthop);
 		if (ret < 0) {
 			NET_DBG("Cannot re-route pkt %p via %s "
@@ -370,7 +389,6 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 		}
 	} else {
 		struct net_if *iface = NULL;
-		int ret;
 
 		if (net_if_ipv6_addr_onlink(&iface, (struct in6_addr *)hdr->dst)) {
 			ret = net_route_packet_if(pkt, iface);
@@ -794,4 +812,6 @@ void net_ipv6_init(void)
 #if defined(CONFIG_NET_IPV6_MLD)
 	net_ipv6_mld_init();
 #endif
+
+	net_pmtu_init();
 }
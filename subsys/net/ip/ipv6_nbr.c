@@ -34,6 +34,7 @@ LOG_MODULE_REGISTER(net_ipv6_nd, CONFIG_NET_IPV6_ND_LOG_LEVEL);
 #include "nbr.h"
 #include "6lo.h"
 #include "route.h"
+#include "pmtu.h"
 #include "net_stats.h"
 
 /* Timeout value to be used when allocating net buffer during various
@@ -265,6 +266,82 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+#if defined(CONFIG_NET_IPV6_NBR_CACHE_HASH)
+/* Neighbors are chained by the hash of their address. The links hold the
+ * pool index plus one so that 0 ends a chain.
+ */
+static uint8_t nbr_hash_buckets[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+static uint8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+
+static inline uint8_t nbr_hash_index(struct net_nbr *nbr)
+{
+	return ((uint8_t *)nbr - (uint8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+static inline uint8_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	uint32_t hash = 0U;
+
+	for (int i = 0; i < sizeof(addr->s6_addr); i++) {
+		hash = hash * 31U + addr->s6_addr[i];
+	}
+
+	return &nbr_hash_buckets[hash % CONFIG_NET_IPV6_MAX_NEIGHBORS];
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	uint8_t *bucket = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	uint8_t idx = nbr_hash_index(nbr);
+
+	nbr_hash_next[idx] = *bucket;
+	*bucket = idx + 1;
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	uint8_t *link = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	uint8_t idx = nbr_hash_index(nbr);
+
+	while (*link != 0U) {
+		if (*link == idx + 1) {
+			*link = nbr_hash_next[idx];
+			break;
+		}
+
+		link = &nbr_hash_next[*link - 1];
+	}
+}
+
+static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
+				  struct net_if *iface,
+				  const struct in6_addr *addr)
+{
+	ARG_UNUSED(table);
+
+	for (uint8_t i = *nbr_hash_bucket(addr); i != 0U; i = nbr_hash_next[i - 1]) {
+		struct net_nbr *nbr = get_nbr(i - 1);
+
+		if (!nbr->ref) {
+			continue;
+		}
+
+		if (iface && nbr->iface != iface) {
+			continue;
+		}
+
+		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
+			return nbr;
+		}
+	}
+
+	return NULL;
+}
+#else
+#define nbr_hash_add(...)
+#define nbr_hash_del(...)
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
@@ -289,6 +366,7 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 
 	return NULL;
 }
+#endif /* CONFIG_NET_IPV6_NBR_CACHE_HASH */
 
 static inline void nbr_clear_ns_pending(struct net_ipv6_nbr_data *data)
 {
@@ -425,6 +503,8 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->iface = iface;
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+	nbr_hash_add(nbr);
+	net_route_flow_invalidate();
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -668,7 +748,8 @@ void net_neighbor_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	nbr_hash_del(nbr);
+	net_route_flow_invalidate();
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -811,8 +892,20 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
+		int pmtu;
 
 		mtu = MAX(NET_IPV6_MTU, mtu);
+
+		/* Fragment here already if the path towards the destination
+		 * is known to have a smaller MTU, instead of having the
+		 * packet dropped on the way.
+		 */
+		pmtu = net_pmtu_ipv6_get_mtu((struct in6_addr *)ip_hdr->dst);
+		if (pmtu > 0 && pmtu < pkt_len && pkt_len <= mtu) {
+			mtu = pmtu;
+			net_stats_update_ipv6_pmtu_fragmented(net_pkt_iface(pkt));
+		}
+
 		if (mtu < pkt_len) {
 			ret = net_ipv6_send_fragmented_pkt(net_pkt_iface(pkt),
 							   pkt, pkt_len);
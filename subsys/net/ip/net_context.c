@@ -2364,6 +2364,27 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 net_context_send_cb_t cb,
+			 void *user_data)
+{
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_ZEROCOPY_SEND) ||
+	    net_context_get_proto(context) != IPPROTO_TCP) {
+		return -EOPNOTSUPP;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = net_tcp_queue_buf(context, buf, cb, user_data);
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
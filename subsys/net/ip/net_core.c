@@ -59,6 +59,280 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #include "net_stats.h"
 
+static inline enum net_verdict process_ip(struct net_pkt *pkt,
+					  bool is_loopback)
+{
+	/* IP version and header length. */
+	uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60) {
+		return net_ipv6_input(pkt, is_loopback);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40) {
+		return net_ipv4_input(pkt, is_loopback);
+	}
+
+	NET_DBG("Unknown IP family packet (0x%x)", NET_IPV6_HDR(pkt)->vtc & 0xf0);
+	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
+	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
+	return NET_DROP;
+}
+
+#if defined(CONFIG_NET_GRO)
+/* Generic receive offload.
+ *
+ * A TCP segment is held back before IP processing, and the payload of
+ * the following in-order segments of the same connection is chained to
+ * it, until a packet that does not fit arrives or the RX queue runs
+ * empty.  Only plain data segments are merged: no IP options, extension
+ * headers or fragments, no TCP options and no flags but ACK and PSH.
+ * Each RX queue thread holds at most one packet.
+ */
+#define GRO_TCP_PSH BIT(3)
+#define GRO_TCP_ACK BIT(4)
+
+struct gro_flow {
+	struct net_pkt *pkt;
+	uint32_t next_seq;
+	uint8_t segs;
+};
+
+static struct gro_flow gro_flows[NET_TC_RX_QUEUE_COUNT];
+
+static void processing_data(struct net_pkt *pkt, bool is_loopback);
+
+/* TCP header of a segment GRO can merge, NULL for any other packet */
+static struct net_tcp_hdr *gro_tcp_hdr(struct net_pkt *pkt, size_t *data_len)
+{
+	uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
+	struct net_buf *buf = pkt->buffer;
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_len, len;
+
+	if (net_pkt_is_ip_reassembled(pkt)) {
+		return NULL;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+
+		/* Only the DF bit may be set in the fragment fields */
+		if (buf->len < sizeof(*hdr) || hdr->vhl != 0x45 ||
+		    hdr->proto != IPPROTO_TCP ||
+		    (hdr->offset[0] & ~(NET_IPV4_DF << 5)) != 0U ||
+		    hdr->offset[1] != 0U) {
+			return NULL;
+		}
+
+		net_pkt_set_family(pkt, AF_INET);
+		net_pkt_set_ipv4_opts_len(pkt, 0);
+		ip_len = sizeof(*hdr);
+		len = ntohs(hdr->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60) {
+		struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+
+		if (buf->len < sizeof(*hdr) || hdr->nexthdr != IPPROTO_TCP) {
+			return NULL;
+		}
+
+		net_pkt_set_family(pkt, AF_INET6);
+		net_pkt_set_ipv6_ext_len(pkt, 0);
+		ip_len = sizeof(*hdr);
+		len = ntohs(hdr->len) + sizeof(*hdr);
+	} else {
+		return NULL;
+	}
+
+	if (buf->len < ip_len + sizeof(*tcp_hdr) ||
+	    len <= ip_len + sizeof(*tcp_hdr) || len > net_pkt_get_len(pkt)) {
+		return NULL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)(buf->data + ip_len);
+	if ((tcp_hdr->offset >> 4) != (sizeof(*tcp_hdr) / 4U) ||
+	    (tcp_hdr->flags & ~GRO_TCP_PSH) != GRO_TCP_ACK) {
+		return NULL;
+	}
+
+	/* Drop the link layer padding, if any */
+	(void)net_pkt_update_length(pkt, len);
+	net_pkt_set_ip_hdr_len(pkt, ip_len);
+	*data_len = len - ip_len - sizeof(*tcp_hdr);
+
+	return tcp_hdr;
+}
+
+static bool gro_chksum_ok(struct net_pkt *pkt)
+{
+	if (!net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		return true;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET &&
+	    net_calc_chksum_ipv4(pkt) != 0U) {
+		return false;
+	}
+
+	return !IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) || net_calc_chksum_tcp(pkt) == 0U;
+}
+
+static bool gro_same_flow(struct net_pkt *held, struct net_tcp_hdr *held_hdr,
+			  struct net_pkt *pkt, struct net_tcp_hdr *tcp_hdr)
+{
+	if (net_pkt_iface(held) != net_pkt_iface(pkt) ||
+	    net_pkt_family(held) != net_pkt_family(pkt)) {
+		return false;
+	}
+
+	/* Source and destination ports */
+	if (memcmp(held_hdr, tcp_hdr, 2 * sizeof(uint16_t)) != 0) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *a = NET_IPV4_HDR(held);
+		struct net_ipv4_hdr *b = NET_IPV4_HDR(pkt);
+
+		return a->tos == b->tos &&
+		       memcmp(a->src, b->src, 2 * NET_IPV4_ADDR_SIZE) == 0;
+	}
+
+	return memcmp(NET_IPV6_HDR(held)->src, NET_IPV6_HDR(pkt)->src,
+		      2 * NET_IPV6_ADDR_SIZE) == 0;
+}
+
+static bool gro_merge(struct gro_flow *flow, struct net_pkt *pkt,
+		      struct net_tcp_hdr *tcp_hdr, size_t data_len)
+{
+	struct net_pkt *held = flow->pkt;
+	size_t ip_len = net_pkt_ip_hdr_len(held);
+	struct net_tcp_hdr *held_hdr = (struct net_tcp_hdr *)(held->buffer->data + ip_len);
+	size_t len = net_pkt_get_len(held) + data_len;
+	struct net_buf *buf;
+
+	if (flow->segs >= CONFIG_NET_GRO_MAX_SEGS || len > UINT16_MAX ||
+	    sys_get_be32(tcp_hdr->seq) != flow->next_seq ||
+	    !gro_same_flow(held, held_hdr, pkt, tcp_hdr)) {
+		return false;
+	}
+
+	/* The merged packet is not checked again, so check its parts */
+	if ((flow->segs == 1U && !gro_chksum_ok(held)) || !gro_chksum_ok(pkt)) {
+		return false;
+	}
+
+	/* The last segment has the latest acknowledgment and window */
+	memcpy(held_hdr->ack, tcp_hdr->ack, sizeof(held_hdr->ack));
+	memcpy(held_hdr->wnd, tcp_hdr->wnd, sizeof(held_hdr->wnd));
+	held_hdr->flags |= tcp_hdr->flags;
+
+	buf = pkt->buffer;
+	net_buf_pull(buf, ip_len + sizeof(*tcp_hdr));
+	if (buf->len == 0U) {
+		pkt->buffer = net_buf_frag_del(NULL, buf);
+	}
+
+	net_pkt_frag_add(held, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(held) == AF_INET) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(held);
+		uint16_t old_len = hdr->len;
+
+		hdr->len = htons(len);
+
+		/* The header checksum was verified on reception */
+		if (net_if_need_calc_rx_checksum(net_pkt_iface(held))) {
+			hdr->chksum = net_chksum_update_16(hdr->chksum, old_len, hdr->len);
+		} else {
+			hdr->chksum = 0U;
+		}
+	} else {
+		NET_IPV6_HDR(held)->len = htons(len - sizeof(struct net_ipv6_hdr));
+	}
+
+	net_pkt_set_chksum_done(held, true);
+	net_stats_update_tcp_gro_merged(net_pkt_iface(held));
+
+	flow->next_seq += data_len;
+	flow->segs++;
+
+	return true;
+}
+
+static void gro_flush(struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	flow->pkt = NULL;
+
+	if (flow->segs > 1U) {
+		net_stats_update_tcp_gro_flushed(net_pkt_iface(pkt));
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	switch (process_ip(pkt, false)) {
+	case NET_CONTINUE:
+		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
+			/* Tunneled packet, feed it back to the stack */
+			processing_data(pkt, false);
+		} else {
+			net_pkt_unref(pkt);
+		}
+		break;
+	case NET_OK:
+		break;
+	case NET_DROP:
+	default:
+		net_pkt_unref(pkt);
+		break;
+	}
+}
+
+void net_gro_flush(int queue)
+{
+	gro_flush(&gro_flows[queue]);
+}
+
+static enum net_verdict gro_receive(struct net_pkt *pkt)
+{
+	struct gro_flow *flow = &gro_flows[net_tc_rx_queue(pkt)];
+	struct net_tcp_hdr *tcp_hdr = NULL;
+	size_t data_len;
+
+	if (net_if_flag_is_set(net_pkt_iface(pkt), NET_IF_GRO)) {
+		tcp_hdr = gro_tcp_hdr(pkt, &data_len);
+	}
+
+	if (tcp_hdr == NULL) {
+		/* Keep the order of the packets */
+		gro_flush(flow);
+		return NET_CONTINUE;
+	}
+
+	if (flow->pkt != NULL) {
+		if (gro_merge(flow, pkt, tcp_hdr, data_len)) {
+			return NET_OK;
+		}
+
+		gro_flush(flow);
+	}
+
+	flow->pkt = pkt;
+	flow->next_seq = sys_get_be32(tcp_hdr->seq) + data_len;
+	flow->segs = 1U;
+
+	return NET_OK;
+}
+#else
+#define gro_receive(pkt) NET_CONTINUE
+#endif /* CONFIG_NET_GRO */
+
 static inline enum net_verdict process_data(struct net_pkt *pkt,
 					    bool is_loopback)
 {
@@ -129,19 +403,17 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 			return ret;
 		}
 
-		/* IP version and header length. */
-		uint8_t vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
-
-		if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60) {
-			return net_ipv6_input(pkt, is_loopback);
-		} else if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40) {
-			return net_ipv4_input(pkt, is_loopback);
+		/* Loopback packets are not necessarily handled by an RX
+		 * thread, so GRO leaves them alone.
+		 */
+		if (IS_ENABLED(CONFIG_NET_GRO) && !is_loopback) {
+			ret = gro_receive(pkt);
+			if (ret != NET_CONTINUE) {
+				return ret;
+			}
 		}
 
-		NET_DBG("Unknown IP family packet (0x%x)", NET_IPV6_HDR(pkt)->vtc & 0xf0);
-		net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
-		net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
-		return NET_DROP;
+		return process_ip(pkt, is_loopback);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN) {
 		return net_canbus_socket_input(pkt);
 	}
@@ -31,6 +31,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "route.h"
 
 #include "net_stats.h"
 
@@ -88,6 +89,39 @@ static struct {
 } ipv6_addresses[CONFIG_NET_IF_MAX_IPV6_COUNT];
 #endif /* CONFIG_NET_IPV6 */
 
+#if defined(CONFIG_NET_NATIVE_IPV6) && CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE > 0
+/* Recently selected global source addresses, keyed by destination prefix,
+ * interface and preference flags.
+ */
+static struct ipv6_src_addr_cache_entry {
+	struct in6_addr prefix;
+	struct net_if *dst_iface;
+	struct net_if *iface;
+	struct net_if_addr *ifaddr;
+	int flags;
+	uint8_t prefix_len;
+	bool valid;
+} ipv6_src_addr_cache[CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE];
+static struct k_spinlock ipv6_src_addr_cache_lock;
+
+/* To be called whenever an address or prefix is added or removed, or an
+ * address becomes preferred, i.e. when the corresponding net_mgmt event is
+ * raised.
+ */
+static void ipv6_src_addr_cache_clear(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ipv6_src_addr_cache_lock);
+
+	ARRAY_FOR_EACH(ipv6_src_addr_cache, i) {
+		ipv6_src_addr_cache[i].valid = false;
+	}
+
+	k_spin_unlock(&ipv6_src_addr_cache_lock, key);
+}
+#else
+#define ipv6_src_addr_cache_clear(...)
+#endif
+
 #if defined(CONFIG_NET_NATIVE_IPV4)
 static struct {
 	struct net_if_ipv4 ipv4;
@@ -95,14 +129,17 @@ static struct {
 } ipv4_addresses[CONFIG_NET_IF_MAX_IPV4_COUNT];
 #endif /* CONFIG_NET_IPV4 */
 
-/* We keep track of the link callbacks in this list.
+/* We keep track of the link callbacks in this list. The list has its own
+ * lock as it is walked for every sent packet when a callback is registered.
  */
 static sys_slist_t link_callbacks;
+static K_MUTEX_DEFINE(link_callbacks_lock);
 
 #if defined(CONFIG_NET_NATIVE_IPV4) || defined(CONFIG_NET_NATIVE_IPV6)
 /* Multicast join/leave tracking.
  */
 static sys_slist_t mcast_monitor_callbacks;
+static K_MUTEX_DEFINE(mcast_monitor_lock);
 #endif
 
 #if defined(CONFIG_NET_PKT_TIMESTAMP_THREAD)
@@ -118,8 +155,19 @@ static struct k_thread tx_thread_ts;
 /* We keep track of the timestamp callbacks in this list.
  */
 static sys_slist_t timestamp_callbacks;
+static K_MUTEX_DEFINE(timestamp_callbacks_lock);
 #endif /* CONFIG_NET_PKT_TIMESTAMP_THREAD */
 
+#if defined(CONFIG_NET_NAPI)
+K_KERNEL_STACK_DEFINE(napi_stack, CONFIG_NET_NAPI_STACK_SIZE);
+
+static struct k_work_q napi_work_q;
+
+enum {
+	NET_NAPI_SCHEDULED,
+};
+#endif /* CONFIG_NET_NAPI */
+
 #if CONFIG_NET_IF_LOG_LEVEL >= LOG_LEVEL_DBG
 #define debug_check_packet(pkt)						\
 	do {								\
@@ -331,6 +379,24 @@ void net_process_tx_packet(struct net_pkt *pkt)
 #endif
 }
 
+void net_process_tx_drop(struct net_pkt *pkt, int status)
+{
+	struct net_context *context = net_pkt_context(pkt);
+	struct net_if *iface = net_pkt_iface(pkt);
+
+	net_pkt_unref(pkt);
+
+	if (context) {
+		net_context_send_cb(context, status);
+	}
+
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+	iface->tx_pending--;
+#else
+	ARG_UNUSED(iface);
+#endif
+}
+
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	if (!net_pkt_filter_send_ok(pkt)) {
@@ -419,6 +485,9 @@ static inline void init_iface(struct net_if *iface)
 #if defined(CONFIG_NET_NATIVE_IPV6)
 	net_if_flag_set(iface, NET_IF_IPV6);
 #endif
+#if defined(CONFIG_NET_GRO)
+	net_if_flag_set(iface, NET_IF_GRO);
+#endif
 
 	net_virtual_init(iface);
 
@@ -802,6 +871,7 @@ static void iface_router_expired(struct k_work *work)
 		sys_slist_remove(&active_router_timers,
 				 prev_node, &router->node);
 		router->is_used = false;
+		net_route_flow_invalidate();
 	}
 
 	iface_router_update_timer(current_time);
@@ -873,6 +943,7 @@ static struct net_if_router *iface_router_add(struct net_if *iface,
 		}
 
 		router = &routers[i];
+		net_route_flow_invalidate();
 		goto out;
 	}
 
@@ -902,6 +973,8 @@ static bool iface_router_rm(struct net_if_router *router)
 	router->is_used = false;
 	ret = true;
 
+	net_route_flow_invalidate();
+
 out:
 	k_mutex_unlock(&lock);
 
@@ -913,6 +986,7 @@ void net_if_router_rm(struct net_if_router *router)
 	k_mutex_lock(&lock, K_FOREVER);
 
 	router->is_used = false;
+	net_route_flow_invalidate();
 
 	/* FIXME - remove timer */
 
@@ -965,7 +1039,7 @@ void net_if_mcast_mon_register(struct net_if_mcast_monitor *mon,
 			       struct net_if *iface,
 			       net_if_mcast_callback_t cb)
 {
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&mcast_monitor_lock, K_FOREVER);
 
 	sys_slist_find_and_remove(&mcast_monitor_callbacks, &mon->node);
 	sys_slist_prepend(&mcast_monitor_callbacks, &mon->node);
@@ -973,16 +1047,16 @@ void net_if_mcast_mon_register(struct net_if_mcast_monitor *mon,
 	mon->iface = iface;
 	mon->cb = cb;
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&mcast_monitor_lock);
 }
 
 void net_if_mcast_mon_unregister(struct net_if_mcast_monitor *mon)
 {
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&mcast_monitor_lock, K_FOREVER);
 
 	sys_slist_find_and_remove(&mcast_monitor_callbacks, &mon->node);
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&mcast_monitor_lock);
 }
 
 void net_if_mcast_monitor(struct net_if *iface,
@@ -991,7 +1065,7 @@ void net_if_mcast_monitor(struct net_if *iface,
 {
 	struct net_if_mcast_monitor *mon, *tmp;
 
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&mcast_monitor_lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&mcast_monitor_callbacks,
 					  mon, tmp, node) {
@@ -1000,7 +1074,7 @@ void net_if_mcast_monitor(struct net_if *iface,
 		}
 	}
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&mcast_monitor_lock);
 }
 #else
 #define net_if_mcast_mon_register(...)
@@ -1224,6 +1298,8 @@ static void dad_timeout(struct k_work *work)
 		ifaddr->addr_state = NET_ADDR_PREFERRED;
 		iface = net_if_get_by_index(ifaddr->ifindex);
 
+		ipv6_src_addr_cache_clear();
+
 		net_mgmt_event_notify_with_info(NET_EVENT_IPV6_DAD_SUCCEED,
 						iface,
 						&ifaddr->address.in6_addr,
@@ -1545,6 +1621,35 @@ out:
 
 #endif
 
+/* Needs to be called with the interface lock held. The address found by the
+ * previous lookup is checked first as the same local address is typically
+ * looked up for every packet of a flow.
+ */
+static struct net_if_addr *ipv6_unicast_find(struct net_if_ipv6 *ipv6,
+					     const struct in6_addr *addr)
+{
+	struct net_if_addr *ifaddr = &ipv6->unicast[ipv6->unicast_last];
+
+	if (ifaddr->is_used && ifaddr->address.family == AF_INET6 &&
+	    net_ipv6_addr_cmp(addr, &ifaddr->address.in6_addr)) {
+		return ifaddr;
+	}
+
+	ARRAY_FOR_EACH(ipv6->unicast, i) {
+		if (!ipv6->unicast[i].is_used ||
+		    ipv6->unicast[i].address.family != AF_INET6) {
+			continue;
+		}
+
+		if (net_ipv6_addr_cmp(addr, &ipv6->unicast[i].address.in6_addr)) {
+			ipv6->unicast_last = i;
+			return &ipv6->unicast[i];
+		}
+	}
+
+	return NULL;
+}
+
 struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 					    struct net_if **ret)
 {
@@ -1561,31 +1666,19 @@ struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 			continue;
 		}
 
-		ARRAY_FOR_EACH(ipv6->unicast, i) {
-			if (!ipv6->unicast[i].is_used ||
-			    ipv6->unicast[i].address.family != AF_INET6) {
-				continue;
+		ifaddr = ipv6_unicast_find(ipv6, addr);
+		if (ifaddr) {
+			if (ret) {
+				*ret = iface;
 			}
 
-			if (net_ipv6_is_prefix(
-				    addr->s6_addr,
-				    ipv6->unicast[i].address.in6_addr.s6_addr,
-				    128)) {
-
-				if (ret) {
-					*ret = iface;
-				}
-
-				ifaddr = &ipv6->unicast[i];
-				net_if_unlock(iface);
-				goto out;
-			}
+			net_if_unlock(iface);
+			break;
 		}
 
 		net_if_unlock(iface);
 	}
 
-out:
 	return ifaddr;
 }
 
@@ -1598,26 +1691,10 @@ struct net_if_addr *net_if_ipv6_addr_lookup_by_iface(struct net_if *iface,
 	net_if_lock(iface);
 
 	ipv6 = iface->config.ip.ipv6;
-	if (!ipv6) {
-		goto out;
+	if (ipv6) {
+		ifaddr = ipv6_unicast_find(ipv6, addr);
 	}
 
-	ARRAY_FOR_EACH(ipv6->unicast, i) {
-		if (!ipv6->unicast[i].is_used ||
-		    ipv6->unicast[i].address.family != AF_INET6) {
-			continue;
-		}
-
-		if (net_ipv6_is_prefix(
-			    addr->s6_addr,
-			    ipv6->unicast[i].address.in6_addr.s6_addr,
-			    128)) {
-			ifaddr = &ipv6->unicast[i];
-			goto out;
-		}
-	}
-
-out:
 	net_if_unlock(iface);
 
 	return ifaddr;
@@ -1818,6 +1895,7 @@ void net_if_ipv6_addr_update_lifetime(struct net_if_addr *ifaddr,
 		vlifetime);
 
 	ifaddr->addr_state = NET_ADDR_PREFERRED;
+	ipv6_src_addr_cache_clear();
 
 	address_start_timer(ifaddr, vlifetime);
 
@@ -1928,6 +2006,8 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 			ipv6->unicast[i].addr_state = NET_ADDR_PREFERRED;
 		}
 
+		ipv6_src_addr_cache_clear();
+
 		net_mgmt_event_notify_with_info(
 			NET_EVENT_IPV6_ADDR_ADD, iface,
 			&ipv6->unicast[i].address.in6_addr,
@@ -2305,6 +2385,8 @@ static void prefix_lifetime_expired(struct net_if_ipv6_prefix *ifprefix)
 	remove_prefix_addresses(ifprefix->iface, ipv6, &ifprefix->prefix,
 				ifprefix->len);
 
+	ipv6_src_addr_cache_clear();
+
 	if (IS_ENABLED(CONFIG_NET_MGMT_EVENT_INFO)) {
 		struct net_event_ipv6_prefix info;
 
@@ -2478,6 +2560,8 @@ struct net_if_ipv6_prefix *net_if_ipv6_prefix_add(struct net_if *iface,
 		NET_DBG("[%zu] interface %p prefix %s/%d added", i, iface,
 			net_sprint_ipv6_addr(prefix), len);
 
+		ipv6_src_addr_cache_clear();
+
 		if (IS_ENABLED(CONFIG_NET_MGMT_EVENT_INFO)) {
 			struct net_event_ipv6_prefix info;
 
@@ -2534,6 +2618,8 @@ bool net_if_ipv6_prefix_rm(struct net_if *iface, struct in6_addr *addr,
 		 */
 		remove_prefix_addresses(iface, ipv6, addr, len);
 
+		ipv6_src_addr_cache_clear();
+
 		if (IS_ENABLED(CONFIG_NET_MGMT_EVENT_INFO)) {
 			struct net_event_ipv6_prefix info;
 
@@ -3071,6 +3157,103 @@ out:
 	return src;
 }
 
+#if CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE > 0
+static void ipv6_src_addr_cache_key(struct in6_addr *prefix,
+				    const struct in6_addr *dst,
+				    uint8_t prefix_len)
+{
+	ARRAY_FOR_EACH(prefix->s6_addr, i) {
+		uint8_t bits = MIN(prefix_len, 8U);
+
+		prefix->s6_addr[i] = dst->s6_addr[i] & (uint8_t)(0xff00U >> bits);
+		prefix_len -= bits;
+	}
+}
+
+static struct ipv6_src_addr_cache_entry *
+ipv6_src_addr_cache_slot(const struct in6_addr *prefix, uint8_t prefix_len,
+			 struct net_if *dst_iface, int flags)
+{
+	uint32_t hash = prefix_len ^ (uint32_t)flags ^ (uint32_t)(uintptr_t)dst_iface;
+
+	ARRAY_FOR_EACH(prefix->s6_addr32, i) {
+		hash = (hash * 31U) ^ UNALIGNED_GET(&prefix->s6_addr32[i]);
+	}
+
+	hash ^= hash >> 16;
+
+	return &ipv6_src_addr_cache[hash % CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE];
+}
+
+static const struct in6_addr *ipv6_src_addr_cache_get(const struct in6_addr *prefix,
+						      uint8_t prefix_len,
+						      struct net_if *dst_iface,
+						      int flags)
+{
+	struct ipv6_src_addr_cache_entry *entry;
+	const struct in6_addr *src = NULL;
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ipv6_src_addr_cache_lock);
+
+	entry = ipv6_src_addr_cache_slot(prefix, prefix_len, dst_iface, flags);
+	if (!entry->valid || entry->prefix_len != prefix_len ||
+	    entry->dst_iface != dst_iface || entry->flags != flags ||
+	    !net_ipv6_addr_cmp(&entry->prefix, prefix)) {
+		k_spin_unlock(&ipv6_src_addr_cache_lock, key);
+		return NULL;
+	}
+
+	iface = entry->iface;
+	ifaddr = entry->ifaddr;
+
+	k_spin_unlock(&ipv6_src_addr_cache_lock, key);
+
+	/* The address state can change without an address being added or
+	 * removed, e.g. when it becomes deprecated, so check that it is
+	 * still usable.
+	 */
+	net_if_lock(iface);
+
+	if (is_proper_ipv6_address(ifaddr)) {
+		src = &ifaddr->address.in6_addr;
+	}
+
+	net_if_unlock(iface);
+
+	return src;
+}
+
+static void ipv6_src_addr_cache_put(const struct in6_addr *prefix,
+				    uint8_t prefix_len,
+				    struct net_if *dst_iface, int flags,
+				    const struct in6_addr *src)
+{
+	struct ipv6_src_addr_cache_entry *entry;
+	struct net_if *iface = NULL;
+	k_spinlock_key_t key;
+
+	if (net_if_ipv6_addr_lookup(src, &iface) == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&ipv6_src_addr_cache_lock);
+
+	entry = ipv6_src_addr_cache_slot(prefix, prefix_len, dst_iface, flags);
+	net_ipaddr_copy(&entry->prefix, prefix);
+	entry->prefix_len = prefix_len;
+	entry->dst_iface = dst_iface;
+	entry->flags = flags;
+	entry->iface = iface;
+	entry->ifaddr = CONTAINER_OF(src, struct net_if_addr, address.in6_addr);
+	entry->valid = true;
+
+	k_spin_unlock(&ipv6_src_addr_cache_lock, key);
+}
+#endif /* CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE > 0 */
+
 const struct in6_addr *net_if_ipv6_select_src_addr_hint(struct net_if *dst_iface,
 							const struct in6_addr *dst,
 							int flags)
@@ -3083,12 +3266,25 @@ const struct in6_addr *net_if_ipv6_select_src_addr_hint(struct net_if *dst_iface
 	if (!net_ipv6_is_ll_addr(dst) && !net_ipv6_is_addr_mcast_link(dst)) {
 		struct net_if_ipv6_prefix *prefix;
 		uint8_t prefix_len = 128;
+#if CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE > 0
+		struct in6_addr cache_key;
+#endif
 
 		prefix = net_if_ipv6_prefix_get(dst_iface, dst);
 		if (prefix) {
 			prefix_len = prefix->len;
 		}
 
+#if CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE > 0
+		ipv6_src_addr_cache_key(&cache_key, dst, prefix_len);
+
+		src = ipv6_src_addr_cache_get(&cache_key, prefix_len,
+					      dst_iface, flags);
+		if (src) {
+			goto out;
+		}
+#endif
+
 		/* If caller has supplied interface, then use that */
 		if (dst_iface) {
 			src = net_if_ipv6_get_best_match(dst_iface, dst,
@@ -3109,6 +3305,12 @@ const struct in6_addr *net_if_ipv6_select_src_addr_hint(struct net_if *dst_iface
 			}
 		}
 
+#if CONFIG_NET_IPV6_SRC_ADDR_CACHE_SIZE > 0
+		if (src) {
+			ipv6_src_addr_cache_put(&cache_key, prefix_len,
+						dst_iface, flags, src);
+		}
+#endif
 	} else {
 		if (dst_iface) {
 			src = net_if_ipv6_get_ll(dst_iface, NET_ADDR_PREFERRED);
@@ -4755,6 +4957,8 @@ static void remove_ipv6_ifaddr(struct net_if *iface,
 		net_if_ipv6_maddr_rm(iface, &maddr);
 	}
 
+	ipv6_src_addr_cache_clear();
+
 	/* Using the IPv6 address pointer here can give false
 	 * info if someone adds a new IP address into this position
 	 * in the address array. This is quite unlikely thou.
@@ -4943,23 +5147,23 @@ enum net_verdict net_if_recv_data(struct net_if *iface, struct net_pkt *pkt)
 void net_if_register_link_cb(struct net_if_link_cb *link,
 			     net_if_link_callback_t cb)
 {
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&link_callbacks_lock, K_FOREVER);
 
 	sys_slist_find_and_remove(&link_callbacks, &link->node);
 	sys_slist_prepend(&link_callbacks, &link->node);
 
 	link->cb = cb;
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&link_callbacks_lock);
 }
 
 void net_if_unregister_link_cb(struct net_if_link_cb *link)
 {
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&link_callbacks_lock, K_FOREVER);
 
 	sys_slist_find_and_remove(&link_callbacks, &link->node);
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&link_callbacks_lock);
 }
 
 void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
@@ -4967,13 +5171,13 @@ void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
 {
 	struct net_if_link_cb *link, *tmp;
 
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&link_callbacks_lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&link_callbacks, link, tmp, node) {
 		link->cb(iface, lladdr, status);
 	}
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&link_callbacks_lock);
 }
 
 static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
@@ -5499,7 +5703,7 @@ void net_if_register_timestamp_cb(struct net_if_timestamp_cb *handle,
 				  struct net_if *iface,
 				  net_if_timestamp_callback_t cb)
 {
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&timestamp_callbacks_lock, K_FOREVER);
 
 	sys_slist_find_and_remove(&timestamp_callbacks, &handle->node);
 	sys_slist_prepend(&timestamp_callbacks, &handle->node);
@@ -5508,23 +5712,23 @@ void net_if_register_timestamp_cb(struct net_if_timestamp_cb *handle,
 	handle->cb = cb;
 	handle->pkt = pkt;
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&timestamp_callbacks_lock);
 }
 
 void net_if_unregister_timestamp_cb(struct net_if_timestamp_cb *handle)
 {
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&timestamp_callbacks_lock, K_FOREVER);
 
 	sys_slist_find_and_remove(&timestamp_callbacks, &handle->node);
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&timestamp_callbacks_lock);
 }
 
 void net_if_call_timestamp_cb(struct net_pkt *pkt)
 {
 	sys_snode_t *sn, *sns;
 
-	k_mutex_lock(&lock, K_FOREVER);
+	k_mutex_lock(&timestamp_callbacks_lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_NODE_SAFE(&timestamp_callbacks, sn, sns) {
 		struct net_if_timestamp_cb *handle =
@@ -5537,7 +5741,7 @@ void net_if_call_timestamp_cb(struct net_pkt *pkt)
 		}
 	}
 
-	k_mutex_unlock(&lock);
+	k_mutex_unlock(&timestamp_callbacks_lock);
 }
 
 void net_if_add_tx_timestamp(struct net_pkt *pkt)
@@ -5546,6 +5750,70 @@ void net_if_add_tx_timestamp(struct net_pkt *pkt)
 }
 #endif /* CONFIG_NET_PKT_TIMESTAMP_THREAD */
 
+#if defined(CONFIG_NET_NAPI)
+static void napi_flush(struct net_napi *napi)
+{
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(&napi->batch)) != NULL) {
+		struct net_pkt *pkt = CONTAINER_OF((intptr_t *)node, struct net_pkt, fifo);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+static void napi_work_handler(struct k_work *work)
+{
+	struct net_napi *napi = CONTAINER_OF(work, struct net_napi, work);
+	int done;
+
+	done = napi->poll(napi, napi->budget);
+
+	napi_flush(napi);
+
+	/* A poll run that used its whole budget has more frames waiting.
+	 * Requeue instead of looping so other contexts get their turn.
+	 */
+	if (done >= napi->budget &&
+	    atomic_test_bit(&napi->flags, NET_NAPI_SCHEDULED)) {
+		k_work_submit_to_queue(&napi_work_q, &napi->work);
+	}
+}
+
+void net_napi_init(struct net_napi *napi, net_napi_poll_t poll, uint16_t budget)
+{
+	k_work_init(&napi->work, napi_work_handler);
+	sys_slist_init(&napi->batch);
+	atomic_clear(&napi->flags);
+
+	napi->poll = poll;
+	napi->budget = budget ? budget : CONFIG_NET_NAPI_BUDGET;
+}
+
+bool net_napi_schedule(struct net_napi *napi)
+{
+	if (atomic_test_and_set_bit(&napi->flags, NET_NAPI_SCHEDULED)) {
+		return false;
+	}
+
+	k_work_submit_to_queue(&napi_work_q, &napi->work);
+
+	return true;
+}
+
+void net_napi_receive(struct net_napi *napi, struct net_pkt *pkt)
+{
+	sys_slist_append(&napi->batch, (sys_snode_t *)&pkt->fifo);
+}
+
+void net_napi_complete(struct net_napi *napi)
+{
+	atomic_clear_bit(&napi->flags, NET_NAPI_SCHEDULED);
+}
+#endif /* CONFIG_NET_NAPI */
+
 bool net_if_is_wifi(struct net_if *iface)
 {
 	if (net_if_is_offloaded(iface)) {
@@ -5777,6 +6045,13 @@ void net_if_init(void)
 	k_thread_name_set(&tx_thread_ts, "tx_tstamp");
 #endif /* CONFIG_NET_PKT_TIMESTAMP_THREAD */
 
+#if defined(CONFIG_NET_NAPI)
+	k_work_queue_start(&napi_work_q, napi_stack,
+			   K_KERNEL_STACK_SIZEOF(napi_stack),
+			   K_PRIO_COOP(CONFIG_NET_NAPI_THREAD_PRIO), NULL);
+	k_thread_name_set(&napi_work_q.thread, "net_napi");
+#endif /* CONFIG_NET_NAPI */
+
 out:
 	k_mutex_unlock(&lock);
 }
@@ -48,7 +48,17 @@ static struct k_work_q mgmt_work_q_obj;
 #endif
 
 static uint32_t global_event_mask;
-static sys_slist_t event_callbacks = SYS_SLIST_STATIC_INIT(&event_callbacks);
+
+/* The callbacks are indexed by the layer and layer code of their event mask,
+ * as those must match exactly, so that an event only goes through the
+ * callbacks that are interested in its layer.
+ */
+static sys_slist_t event_callbacks[CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS];
+
+/* Callbacks run in the context of the event notifier */
+static K_MUTEX_DEFINE(net_mgmt_direct_callback_lock);
+static uint32_t direct_event_mask;
+static sys_slist_t direct_event_callbacks = SYS_SLIST_STATIC_INIT(&direct_event_callbacks);
 
 /* Forward declaration for the actual caller */
 static void mgmt_run_callbacks(const struct mgmt_event_entry * const mgmt_event);
@@ -61,6 +71,11 @@ static struct mgmt_event_entry new_event;
 K_MSGQ_DEFINE(event_msgq, sizeof(struct mgmt_event_entry),
 	      CONFIG_NET_MGMT_EVENT_QUEUE_SIZE, sizeof(uint32_t));
 
+#if defined(CONFIG_NET_MGMT_EVENT_COALESCE)
+/* Copy of the most recently queued event */
+static struct mgmt_event_entry last_event;
+#endif
+
 static struct k_work_q *mgmt_work_q = COND_CODE_1(CONFIG_NET_MGMT_EVENT_SYSTEM_WORKQUEUE,
 	(&k_sys_work_q), (&mgmt_work_q_obj));
 
@@ -97,6 +112,22 @@ static inline void mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
 	new_event.event = mgmt_event;
 	new_event.iface = iface;
 
+#if defined(CONFIG_NET_MGMT_EVENT_COALESCE)
+	/* The most recently queued event is the last one to leave the queue,
+	 * so if the queue is not empty it has not been delivered yet and a
+	 * burst of identical events can be delivered once.
+	 */
+	if (k_msgq_num_used_get(&event_msgq) > 0 &&
+	    memcmp(&new_event, &last_event, sizeof(new_event)) == 0) {
+		NET_DBG("Event (%u) coalesced", mgmt_event);
+		(void)k_mutex_unlock(&net_mgmt_event_lock);
+
+		return;
+	}
+
+	last_event = new_event;
+#endif /* CONFIG_NET_MGMT_EVENT_COALESCE */
+
 	if (k_msgq_put(&event_msgq, &new_event,
 		K_MSEC(CONFIG_NET_MGMT_EVENT_QUEUE_TIMEOUT)) != 0) {
 		NET_WARN("Failure to push event (%u), "
@@ -143,6 +174,14 @@ static inline void mgmt_push_event(uint32_t event, struct net_if *iface,
 
 #endif /* CONFIG_NET_MGMT_EVENT_QUEUE */
 
+static inline sys_slist_t *mgmt_event_callbacks(uint32_t event_mask)
+{
+	uint32_t key = NET_MGMT_GET_LAYER(event_mask) * 31U +
+		       NET_MGMT_GET_LAYER_CODE(event_mask);
+
+	return &event_callbacks[key % CONFIG_NET_MGMT_EVENT_CALLBACK_BUCKETS];
+}
+
 static inline void mgmt_add_event_mask(uint32_t event_mask)
 {
 	global_event_mask |= event_mask;
@@ -158,26 +197,55 @@ static inline void mgmt_rebuild_global_event_mask(void)
 		mgmt_add_event_mask(it->event_mask);
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		mgmt_add_event_mask(cb->event_mask);
+	ARRAY_FOR_EACH_PTR(event_callbacks, list) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, cb, tmp, node) {
+			mgmt_add_event_mask(cb->event_mask);
+		}
 	}
 }
 
-static inline bool mgmt_is_event_handled(uint32_t mgmt_event)
+static inline void mgmt_rebuild_direct_event_mask(void)
+{
+	struct net_mgmt_event_callback *cb, *tmp;
+
+	direct_event_mask = 0U;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&direct_event_callbacks, cb, tmp, node) {
+		direct_event_mask |= cb->event_mask;
+	}
+}
+
+static inline bool mgmt_is_event_in_mask(uint32_t mgmt_event, uint32_t event_mask)
 {
 	return (((NET_MGMT_GET_LAYER(mgmt_event) &
-		  NET_MGMT_GET_LAYER(global_event_mask)) ==
+		  NET_MGMT_GET_LAYER(event_mask)) ==
 		 NET_MGMT_GET_LAYER(mgmt_event)) &&
 		((NET_MGMT_GET_LAYER_CODE(mgmt_event) &
-		  NET_MGMT_GET_LAYER_CODE(global_event_mask)) ==
+		  NET_MGMT_GET_LAYER_CODE(event_mask)) ==
 		 NET_MGMT_GET_LAYER_CODE(mgmt_event)) &&
 		((NET_MGMT_GET_COMMAND(mgmt_event) &
-		  NET_MGMT_GET_COMMAND(global_event_mask)) ==
+		  NET_MGMT_GET_COMMAND(event_mask)) ==
 		 NET_MGMT_GET_COMMAND(mgmt_event)));
 }
 
+static inline bool mgmt_is_event_handled(uint32_t mgmt_event)
+{
+	return mgmt_is_event_in_mask(mgmt_event, global_event_mask);
+}
+
+static inline bool mgmt_callback_matches(uint32_t mgmt_event, uint32_t event_mask)
+{
+	return NET_MGMT_GET_LAYER(mgmt_event) == NET_MGMT_GET_LAYER(event_mask) &&
+	       NET_MGMT_GET_LAYER_CODE(mgmt_event) == NET_MGMT_GET_LAYER_CODE(event_mask) &&
+	       !(NET_MGMT_GET_COMMAND(mgmt_event) &&
+		 NET_MGMT_GET_COMMAND(event_mask) &&
+		 !(NET_MGMT_GET_COMMAND(mgmt_event) &
+		   NET_MGMT_GET_COMMAND(event_mask)));
+}
+
 static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * const mgmt_event)
 {
+	sys_slist_t *callbacks = mgmt_event_callbacks(mgmt_event->event);
 	sys_snode_t *prev = NULL;
 	struct net_mgmt_event_callback *cb, *tmp;
 
@@ -187,15 +255,9 @@ static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * cons
 		NET_MGMT_GET_LAYER_CODE(mgmt_event->event),
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
-		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER_CODE(cb->event_mask)) ||
-		    (NET_MGMT_GET_COMMAND(mgmt_event->event) &&
-		     NET_MGMT_GET_COMMAND(cb->event_mask) &&
-		     !(NET_MGMT_GET_COMMAND(mgmt_event->event) &
-		       NET_MGMT_GET_COMMAND(cb->event_mask)))) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(callbacks, cb, tmp, node) {
+		if (!mgmt_callback_matches(mgmt_event->event, cb->event_mask)) {
+			prev = &cb->node;
 			continue;
 		}
 
@@ -216,6 +278,7 @@ static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * cons
 
 			if (sync_data->iface &&
 			    sync_data->iface != mgmt_event->iface) {
+				prev = &cb->node;
 				continue;
 			}
 
@@ -224,7 +287,7 @@ static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * cons
 			cb->raised_event = mgmt_event->event;
 			sync_data->iface = mgmt_event->iface;
 
-			sys_slist_remove(&event_callbacks, prev, &cb->node);
+			sys_slist_remove(callbacks, prev, &cb->node);
 
 			k_sem_give(cb->sync_call);
 		} else {
@@ -244,14 +307,7 @@ static inline void mgmt_run_slist_callbacks(const struct mgmt_event_entry * cons
 static inline void mgmt_run_static_callbacks(const struct mgmt_event_entry * const mgmt_event)
 {
 	STRUCT_SECTION_FOREACH(net_mgmt_event_static_handler, it) {
-		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER(it->event_mask)) ||
-		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER_CODE(it->event_mask)) ||
-		    (NET_MGMT_GET_COMMAND(mgmt_event->event) &&
-		     NET_MGMT_GET_COMMAND(it->event_mask) &&
-		     !(NET_MGMT_GET_COMMAND(mgmt_event->event) &
-		       NET_MGMT_GET_COMMAND(it->event_mask)))) {
+		if (!mgmt_callback_matches(mgmt_event->event, it->event_mask)) {
 			continue;
 		}
 
@@ -276,6 +332,36 @@ static void mgmt_run_callbacks(const struct mgmt_event_entry * const mgmt_event)
 	(void)k_mutex_unlock(&net_mgmt_callback_lock);
 }
 
+static void mgmt_run_direct_callbacks(uint32_t mgmt_event, struct net_if *iface,
+				      const void *info, size_t length)
+{
+	struct net_mgmt_event_callback *cb, *tmp;
+
+#ifndef CONFIG_NET_MGMT_EVENT_INFO
+	ARG_UNUSED(info);
+	ARG_UNUSED(length);
+#endif
+
+	(void)k_mutex_lock(&net_mgmt_direct_callback_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&direct_event_callbacks, cb, tmp, node) {
+		if (!mgmt_callback_matches(mgmt_event, cb->event_mask)) {
+			continue;
+		}
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+		cb->info = length ? info : NULL;
+		cb->info_length = length;
+#endif
+
+		NET_DBG("Running direct callback %p : %p", cb, cb->handler);
+
+		cb->handler(cb, mgmt_event, iface);
+	}
+
+	(void)k_mutex_unlock(&net_mgmt_direct_callback_lock);
+}
+
 static int mgmt_event_wait_call(struct net_if *iface,
 				uint32_t mgmt_event_mask,
 				uint32_t *raised_event,
@@ -338,23 +424,57 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb)
 
 	(void)k_mutex_lock(&net_mgmt_callback_lock, K_FOREVER);
 
-	/* Remove the callback if it already exists to avoid loop */
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	/* Remove the callback if it already exists to avoid loop. Its event
+	 * mask might have been changed meanwhile, so look in all the lists.
+	 */
+	ARRAY_FOR_EACH_PTR(event_callbacks, list) {
+		if (sys_slist_find_and_remove(list, &cb->node)) {
+			break;
+		}
+	}
 
-	sys_slist_prepend(&event_callbacks, &cb->node);
+	sys_slist_prepend(mgmt_event_callbacks(cb->event_mask), &cb->node);
 
 	mgmt_add_event_mask(cb->event_mask);
 
 	(void)k_mutex_unlock(&net_mgmt_callback_lock);
 }
 
+void net_mgmt_add_event_callback_direct(struct net_mgmt_event_callback *cb)
+{
+	NET_DBG("Adding direct event callback %p", cb);
+
+	(void)k_mutex_lock(&net_mgmt_direct_callback_lock, K_FOREVER);
+
+	sys_slist_find_and_remove(&direct_event_callbacks, &cb->node);
+	sys_slist_prepend(&direct_event_callbacks, &cb->node);
+
+	direct_event_mask |= cb->event_mask;
+
+	(void)k_mutex_unlock(&net_mgmt_direct_callback_lock);
+}
+
 void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 {
 	NET_DBG("Deleting event callback %p", cb);
 
+	(void)k_mutex_lock(&net_mgmt_direct_callback_lock, K_FOREVER);
+
+	if (sys_slist_find_and_remove(&direct_event_callbacks, &cb->node)) {
+		mgmt_rebuild_direct_event_mask();
+		(void)k_mutex_unlock(&net_mgmt_direct_callback_lock);
+		return;
+	}
+
+	(void)k_mutex_unlock(&net_mgmt_direct_callback_lock);
+
 	(void)k_mutex_lock(&net_mgmt_callback_lock, K_FOREVER);
 
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	ARRAY_FOR_EACH_PTR(event_callbacks, list) {
+		if (sys_slist_find_and_remove(list, &cb->node)) {
+			break;
+		}
+	}
 
 	mgmt_rebuild_global_event_mask();
 
@@ -364,6 +484,10 @@ void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 void net_mgmt_event_notify_with_info(uint32_t mgmt_event, struct net_if *iface,
 				     const void *info, size_t length)
 {
+	if (mgmt_is_event_in_mask(mgmt_event, direct_event_mask)) {
+		mgmt_run_direct_callbacks(mgmt_event, iface, info, length);
+	}
+
 	if (mgmt_is_event_handled(mgmt_event)) {
 		/* Readable layer code is starting from 1, thus the increment */
 		NET_DBG("Notifying Event layer %u code %u type %u",
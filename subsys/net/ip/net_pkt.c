@@ -6,6 +6,7 @@
 
 /*
  * Copyright (c) 2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -120,6 +121,11 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 K_MEM_SLAB_DEFINE(rx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_RX_COUNT, 4);
 K_MEM_SLAB_DEFINE(tx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_TX_COUNT, 4);
 
+#if defined(CONFIG_NET_PKT_SLAB_CACHE)
+static K_MEM_SLAB_CACHE_DEFINE(rx_pkts_cache);
+static K_MEM_SLAB_CACHE_DEFINE(tx_pkts_cache);
+#endif
+
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 
 NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_SIZE,
@@ -127,6 +133,39 @@ NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_BUF_DATA_SIZE,
 			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
 
+#if defined(CONFIG_NET_BUF_SIZE_CLASSES)
+NET_BUF_POOL_FIXED_DEFINE(rx_bufs_small, CONFIG_NET_BUF_SMALL_RX_COUNT,
+			  CONFIG_NET_BUF_SMALL_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(tx_bufs_small, CONFIG_NET_BUF_SMALL_TX_COUNT,
+			  CONFIG_NET_BUF_SMALL_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(rx_bufs_large, CONFIG_NET_BUF_LARGE_RX_COUNT,
+			  CONFIG_NET_BUF_LARGE_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(tx_bufs_large, CONFIG_NET_BUF_LARGE_TX_COUNT,
+			  CONFIG_NET_BUF_LARGE_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+
+struct buf_size_class {
+	struct net_buf_pool *pool;
+	size_t size;
+};
+
+/* Sorted by buffer size */
+static const struct buf_size_class rx_buf_classes[] = {
+	{ &rx_bufs_small, CONFIG_NET_BUF_SMALL_DATA_SIZE },
+	{ &rx_bufs, CONFIG_NET_BUF_DATA_SIZE },
+	{ &rx_bufs_large, CONFIG_NET_BUF_LARGE_DATA_SIZE },
+};
+
+static const struct buf_size_class tx_buf_classes[] = {
+	{ &tx_bufs_small, CONFIG_NET_BUF_SMALL_DATA_SIZE },
+	{ &tx_bufs, CONFIG_NET_BUF_DATA_SIZE },
+	{ &tx_bufs_large, CONFIG_NET_BUF_LARGE_DATA_SIZE },
+};
+#endif /* CONFIG_NET_BUF_SIZE_CLASSES */
+
 #else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE,
@@ -284,6 +323,18 @@ const char *net_pkt_pool2str(struct net_buf_pool *pool)
 		return "TDATA";
 	}
 
+#if defined(CONFIG_NET_BUF_SIZE_CLASSES)
+	if (pool == &rx_bufs_small) {
+		return "RDATA-S";
+	} else if (pool == &tx_bufs_small) {
+		return "TDATA-S";
+	} else if (pool == &rx_bufs_large) {
+		return "RDATA-L";
+	} else if (pool == &tx_bufs_large) {
+		return "TDATA-L";
+	}
+#endif
+
 	return "EDATA";
 }
 
@@ -850,6 +901,12 @@ void net_pkt_print(void)
 		k_mem_slab_num_free_get(&tx_pkts),
 		k_mem_slab_num_free_get(&rx_pkts),
 		get_frees(&rx_bufs), get_frees(&tx_bufs));
+
+#if defined(CONFIG_NET_BUF_SIZE_CLASSES)
+	NET_DBG("RDATA-S %d TDATA-S %d RDATA-L %d TDATA-L %d",
+		get_frees(&rx_bufs_small), get_frees(&tx_bufs_small),
+		get_frees(&rx_bufs_large), get_frees(&tx_bufs_large));
+#endif
 }
 #endif /* CONFIG_NET_DEBUG_NET_PKT_ALLOC */
 
@@ -943,6 +1000,54 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_BUF_SIZE_CLASSES)
+/* Allocate from the smallest class holding size bytes in one buffer, or
+ * from the largest one if none does. Larger classes are tried when the
+ * best fitting one is exhausted, waiting only on the best fitting one.
+ */
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+static struct net_buf *pkt_alloc_buffer_class(const struct buf_size_class *classes,
+					      size_t size, k_timeout_t timeout,
+					      const char *caller, int line)
+#else
+static struct net_buf *pkt_alloc_buffer_class(const struct buf_size_class *classes,
+					      size_t size, k_timeout_t timeout)
+#endif
+{
+	const size_t count = ARRAY_SIZE(rx_buf_classes);
+	struct net_buf *buf;
+	size_t best = count - 1;
+
+	for (size_t i = 0; i < count; i++) {
+		if (size <= classes[i].size) {
+			best = i;
+			break;
+		}
+	}
+
+	for (size_t i = best; i < count; i++) {
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+		buf = pkt_alloc_buffer(classes[i].pool, size, K_NO_WAIT, caller, line);
+#else
+		buf = pkt_alloc_buffer(classes[i].pool, size, K_NO_WAIT);
+#endif
+		if (buf) {
+			return buf;
+		}
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return NULL;
+	}
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	return pkt_alloc_buffer(classes[best].pool, size, timeout, caller, line);
+#else
+	return pkt_alloc_buffer(classes[best].pool, size, timeout);
+#endif
+}
+#endif /* CONFIG_NET_BUF_SIZE_CLASSES */
+
 static size_t pkt_buffer_length(struct net_pkt *pkt,
 				size_t size,
 				enum net_ip_protocol proto,
@@ -1172,15 +1277,29 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 		pool = get_data_pool(pkt->context);
 	}
 
+#if defined(CONFIG_NET_BUF_SIZE_CLASSES)
 	if (!pool) {
-		pool = pkt->slab == &tx_pkts ? &tx_bufs : &rx_bufs;
-	}
+		const struct buf_size_class *classes =
+			pkt->slab == &tx_pkts ? tx_buf_classes : rx_buf_classes;
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
-	buf = pkt_alloc_buffer(pool, alloc_len, timeout, caller, line);
+		buf = pkt_alloc_buffer_class(classes, alloc_len, timeout, caller, line);
 #else
-	buf = pkt_alloc_buffer(pool, alloc_len, timeout);
+		buf = pkt_alloc_buffer_class(classes, alloc_len, timeout);
 #endif
+	} else
+#endif /* CONFIG_NET_BUF_SIZE_CLASSES */
+	{
+		if (!pool) {
+			pool = pkt->slab == &tx_pkts ? &tx_bufs : &rx_bufs;
+		}
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+		buf = pkt_alloc_buffer(pool, alloc_len, timeout, caller, line);
+#else
+		buf = pkt_alloc_buffer(pool, alloc_len, timeout);
+#endif
+	}
 
 	if (!buf) {
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -1619,6 +1738,41 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+/* Fast path of the cursor operations, for the common case of an access which
+ * ends before the end of the current fragment: the cursor neither has to be
+ * moved to another fragment before nor after it. Returns the position of the
+ * access, with the cursor moved past it, or NULL if the access has to go
+ * through net_pkt_cursor_operate().
+ */
+static inline uint8_t *pkt_cursor_fast_get(struct net_pkt *pkt,
+					   size_t length, bool write)
+{
+	struct net_pkt_cursor *cursor = &pkt->cursor;
+	uint8_t *pos = cursor->pos;
+	size_t len;
+
+	if (!cursor->buf) {
+		return NULL;
+	}
+
+	if (net_pkt_is_being_overwritten(pkt)) {
+		write = false;
+	}
+
+	len = write ? net_buf_max_len(cursor->buf) : cursor->buf->len;
+	if ((pos - cursor->buf->data) + length >= len) {
+		return NULL;
+	}
+
+	if (write) {
+		net_buf_add(cursor->buf, length);
+	}
+
+	cursor->pos += length;
+
+	return pos;
+}
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
@@ -1686,20 +1840,43 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
+	if (pkt_cursor_fast_get(pkt, skip, true)) {
+		return 0;
+	}
+
 	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
+	uint8_t *pos;
+
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
+	pos = pkt_cursor_fast_get(pkt, amount, true);
+	if (pos) {
+		memset(pos, byte, amount);
+		return 0;
+	}
+
 	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
+	uint8_t *pos;
+
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
+	pos = pkt_cursor_fast_get(pkt, length, false);
+	if (pos) {
+		if (data) {
+			memcpy(data, pos, length);
+		}
+
+		return 0;
+	}
+
 	return net_pkt_cursor_operate(pkt, data, length, true, false);
 }
 
@@ -1741,8 +1918,20 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data)
 
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 {
+	uint8_t *pos;
+
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
+	pos = pkt_cursor_fast_get(pkt, length, true);
+	if (pos) {
+		/* Data may have been set in place, see net_pkt_get_data() */
+		if (data && data != pos) {
+			memcpy(pos, data, length);
+		}
+
+		return 0;
+	}
+
 	if (data == pkt->cursor.pos && net_pkt_is_contiguous(pkt, length)) {
 		return net_pkt_skip(pkt, length);
 	}
@@ -1756,6 +1945,22 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 {
 	struct net_pkt_cursor *c_dst = &pkt_dst->cursor;
 	struct net_pkt_cursor *c_src = &pkt_src->cursor;
+	struct net_pkt_cursor backup;
+	uint8_t *src;
+
+	/* Both sides fit in their current fragment: a single copy */
+	net_pkt_cursor_backup(pkt_src, &backup);
+	src = pkt_cursor_fast_get(pkt_src, length, false);
+	if (src) {
+		uint8_t *dst = pkt_cursor_fast_get(pkt_dst, length, true);
+
+		if (dst) {
+			memcpy(dst, src, length);
+			return 0;
+		}
+
+		net_pkt_cursor_restore(pkt_src, &backup);
+	}
 
 	while (c_dst->buf && c_src->buf && length) {
 		size_t s_len, d_len, len;
@@ -1874,6 +2079,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_ptp(clone_pkt, net_pkt_is_ptp(pkt));
 	net_pkt_set_forwarding(clone_pkt, net_pkt_forwarding(pkt));
 	net_pkt_set_chksum_done(clone_pkt, net_pkt_is_chksum_done(pkt));
+	net_pkt_set_tso_mss(clone_pkt, net_pkt_tso_mss(pkt));
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
 
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
@@ -2142,6 +2348,20 @@ size_t net_pkt_get_contiguous_len(struct net_pkt *pkt)
 void *net_pkt_get_data(struct net_pkt *pkt,
 		       struct net_pkt_data_access *access)
 {
+	struct net_pkt_cursor *cursor = &pkt->cursor;
+
+	/* Fast path: the data ends before the end of the current fragment */
+	if (cursor->buf &&
+	    (cursor->pos - cursor->buf->data) + access->size <
+	    (net_pkt_is_being_overwritten(pkt) ? cursor->buf->len :
+						 net_buf_max_len(cursor->buf))) {
+#if !defined(CONFIG_NET_HEADERS_ALWAYS_CONTIGUOUS)
+		access->data = cursor->pos;
+#endif
+
+		return cursor->pos;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_HEADERS_ALWAYS_CONTIGUOUS)) {
 		if (!net_pkt_is_contiguous(pkt, access->size)) {
 			return NULL;
@@ -2188,6 +2408,11 @@ int net_pkt_set_data(struct net_pkt *pkt,
 
 void net_pkt_init(void)
 {
+#if defined(CONFIG_NET_PKT_SLAB_CACHE)
+	(void)k_mem_slab_cache_attach(&rx_pkts, &rx_pkts_cache);
+	(void)k_mem_slab_cache_attach(&tx_pkts, &tx_pkts_cache);
+#endif
+
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
 	NET_DBG("Allocating %u RX (%zu bytes), %u TX (%zu bytes), "
 		"%d RX data (%u bytes) and %d TX data (%u bytes) buffers",
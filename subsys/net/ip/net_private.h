@@ -61,6 +61,7 @@ extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
 extern void net_process_tx_packet(struct net_pkt *pkt);
+extern void net_process_tx_drop(struct net_pkt *pkt, int status);
 
 extern int net_icmp_call_ipv4_handlers(struct net_pkt *pkt,
 				       struct net_ipv4_hdr *ipv4_hdr,
@@ -146,6 +147,25 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+#if defined(CONFIG_NET_TC_RX_STEERING)
+/* Each RX traffic class has a queue per CPU */
+#define NET_TC_RX_QUEUE_COUNT (NET_TC_RX_COUNT * CONFIG_MP_MAX_NUM_CPUS)
+extern int net_tc_rx_queue(struct net_pkt *pkt);
+#else
+#define NET_TC_RX_QUEUE_COUNT NET_TC_RX_COUNT
+static inline int net_tc_rx_queue(struct net_pkt *pkt)
+{
+	return net_rx_priority2tc(net_pkt_priority(pkt));
+}
+#endif
+#if defined(CONFIG_NET_GRO)
+extern void net_gro_flush(int queue);
+#else
+static inline void net_gro_flush(int queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -231,6 +251,73 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update a checksum after a 16-bit field of the covered data changed
+ *
+ * Implements RFC 1624 eqn. 3, HC' = ~(~HC + ~m + m'), so the checksum of a
+ * rewritten header does not need to be computed over the whole packet again.
+ * All values are taken as stored in the packet, in network byte order.
+ *
+ * @param chksum Checksum stored in the packet
+ * @param old_val Old value of the field
+ * @param new_val New value of the field
+ *
+ * @return Updated checksum
+ */
+static inline uint16_t net_chksum_update_16(uint16_t chksum, uint16_t old_val,
+					    uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update a checksum after a 32-bit field of the covered data changed
+ *
+ * @param chksum Checksum stored in the packet
+ * @param old_val Old value of the field, as stored in the packet
+ * @param new_val New value of the field, as stored in the packet
+ *
+ * @return Updated checksum
+ */
+static inline uint16_t net_chksum_update_32(uint16_t chksum, uint32_t old_val,
+					    uint32_t new_val)
+{
+	chksum = net_chksum_update_16(chksum, (uint16_t)old_val, (uint16_t)new_val);
+
+	return net_chksum_update_16(chksum, (uint16_t)(old_val >> 16),
+				    (uint16_t)(new_val >> 16));
+}
+
+/**
+ * @brief Update a checksum after a block of the covered data changed
+ *
+ * Useful for rewritten addresses. The block must start at an even offset in
+ * the covered data.
+ *
+ * @param chksum Checksum stored in the packet
+ * @param old_data Old content of the block
+ * @param new_data New content of the block
+ * @param len Length of the block, even
+ *
+ * @return Updated checksum
+ */
+static inline uint16_t net_chksum_update_buf(uint16_t chksum, const uint8_t *old_data,
+					     const uint8_t *new_data, size_t len)
+{
+	/* calc_chksum() works in host byte order */
+	uint32_t sum = calc_chksum(ntohs((uint16_t)~chksum), new_data, len);
+
+	sum += (uint16_t)~calc_chksum(0, old_data, len);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~htons((uint16_t)sum);
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
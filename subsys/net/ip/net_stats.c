@@ -91,6 +91,13 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, ipv6_nd.sent),
 			 GET_STAT(iface, ipv6_nd.drop));
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU)
+		NET_INFO("IPv6 PMTU recv %d\tdrop\t%d\tmss clamped\t%d\tfragmented\t%d",
+			 GET_STAT(iface, ipv6_pmtu.recv),
+			 GET_STAT(iface, ipv6_pmtu.drop),
+			 GET_STAT(iface, ipv6_pmtu.mss_clamped),
+			 GET_STAT(iface, ipv6_pmtu.fragmented));
+#endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 		NET_INFO("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d",
 			 GET_STAT(iface, ipv6_mld.recv),
@@ -152,6 +159,11 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+#if defined(CONFIG_NET_GRO)
+		NET_INFO("TCP gro merged %d\tflushed\t%d",
+			 GET_STAT(iface, tcp.gro_merged),
+			 GET_STAT(iface, tcp.gro_flushed));
+#endif
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
@@ -279,6 +291,12 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 		src = GET_STAT_ADDR(iface, ipv6_nd);
 		break;
 #endif
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU)
+	case NET_REQUEST_STATS_CMD_GET_IPV6_PMTU:
+		len_chk = sizeof(struct net_stats_ipv6_pmtu);
+		src = GET_STAT_ADDR(iface, ipv6_pmtu);
+		break;
+#endif
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 	case NET_REQUEST_STATS_CMD_GET_ICMP:
 		len_chk = sizeof(struct net_stats_icmp);
@@ -341,6 +359,11 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_ND,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_IPV6_PMTU,
+				  net_stats_get);
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ICMP,
 				  net_stats_get);
@@ -31,33 +31,48 @@ extern struct net_stats net_stats;
 #define UPDATE_STAT(_iface, _cmd) \
 	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
 	  SET_STAT(_iface->_cmd); }
+
+/* Counters can be updated concurrently from several CPUs, use relaxed
+ * atomic adds for them so that no lock is needed.
+ */
+#if defined(CONFIG_NET_STATISTICS_ATOMIC)
+#define STAT_ADD(_var, _val) \
+	((void)__atomic_fetch_add(&(_var), (net_stats_t)(_val), __ATOMIC_RELAXED))
+#else
+#define STAT_ADD(_var, _val) ((_var) += (_val))
+#endif
+
+#define UPDATE_STAT_ADD(_iface, _s, _val) \
+	{ NET_ASSERT(_iface); STAT_ADD(net_stats._s, _val); \
+	  SET_STAT(STAT_ADD(_iface->stats._s, _val)); }
+
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.processing_error++);
+	UPDATE_STAT_ADD(iface, processing_error, 1);
 }
 
 static inline void net_stats_update_ip_errors_protoerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ip_errors.protoerr++);
+	UPDATE_STAT_ADD(iface, ip_errors.protoerr, 1);
 }
 
 static inline void net_stats_update_ip_errors_vhlerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ip_errors.vhlerr++);
+	UPDATE_STAT_ADD(iface, ip_errors.vhlerr, 1);
 }
 
 static inline void net_stats_update_bytes_recv(struct net_if *iface,
 					       uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.bytes.received += bytes);
+	UPDATE_STAT_ADD(iface, bytes.received, bytes);
 }
 
 static inline void net_stats_update_bytes_sent(struct net_if *iface,
 					       uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.bytes.sent += bytes);
+	UPDATE_STAT_ADD(iface, bytes.sent, bytes);
 }
 #else
 #define net_stats_update_processing_error(iface)
@@ -72,17 +87,17 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 
 static inline void net_stats_update_ipv6_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6.sent++);
+	UPDATE_STAT_ADD(iface, ipv6.sent, 1);
 }
 
 static inline void net_stats_update_ipv6_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6.recv++);
+	UPDATE_STAT_ADD(iface, ipv6.recv, 1);
 }
 
 static inline void net_stats_update_ipv6_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6.drop++);
+	UPDATE_STAT_ADD(iface, ipv6.drop, 1);
 }
 #else
 #define net_stats_update_ipv6_drop(iface)
@@ -95,17 +110,17 @@ static inline void net_stats_update_ipv6_drop(struct net_if *iface)
 
 static inline void net_stats_update_ipv6_nd_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_nd.sent++);
+	UPDATE_STAT_ADD(iface, ipv6_nd.sent, 1);
 }
 
 static inline void net_stats_update_ipv6_nd_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_nd.recv++);
+	UPDATE_STAT_ADD(iface, ipv6_nd.recv, 1);
 }
 
 static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_nd.drop++);
+	UPDATE_STAT_ADD(iface, ipv6_nd.drop, 1);
 }
 #else
 #define net_stats_update_ipv6_nd_sent(iface)
@@ -113,22 +128,51 @@ static inline void net_stats_update_ipv6_nd_drop(struct net_if *iface)
 #define net_stats_update_ipv6_nd_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
 
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU) && defined(CONFIG_NET_NATIVE_IPV6)
+/* IPv6 Path MTU Discovery stats */
+
+static inline void net_stats_update_ipv6_pmtu_recv(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, ipv6_pmtu.recv, 1);
+}
+
+static inline void net_stats_update_ipv6_pmtu_drop(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, ipv6_pmtu.drop, 1);
+}
+
+static inline void net_stats_update_ipv6_pmtu_mss_clamped(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, ipv6_pmtu.mss_clamped, 1);
+}
+
+static inline void net_stats_update_ipv6_pmtu_fragmented(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, ipv6_pmtu.fragmented, 1);
+}
+#else
+#define net_stats_update_ipv6_pmtu_recv(iface)
+#define net_stats_update_ipv6_pmtu_drop(iface)
+#define net_stats_update_ipv6_pmtu_mss_clamped(iface)
+#define net_stats_update_ipv6_pmtu_fragmented(iface)
+#endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
+
 #if defined(CONFIG_NET_STATISTICS_IPV4) && defined(CONFIG_NET_NATIVE_IPV4)
 /* IPv4 stats */
 
 static inline void net_stats_update_ipv4_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4.drop++);
+	UPDATE_STAT_ADD(iface, ipv4.drop, 1);
 }
 
 static inline void net_stats_update_ipv4_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4.sent++);
+	UPDATE_STAT_ADD(iface, ipv4.sent, 1);
 }
 
 static inline void net_stats_update_ipv4_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4.recv++);
+	UPDATE_STAT_ADD(iface, ipv4.recv, 1);
 }
 #else
 #define net_stats_update_ipv4_drop(iface)
@@ -140,17 +184,17 @@ static inline void net_stats_update_ipv4_recv(struct net_if *iface)
 /* Common ICMPv4/ICMPv6 stats */
 static inline void net_stats_update_icmp_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.icmp.sent++);
+	UPDATE_STAT_ADD(iface, icmp.sent, 1);
 }
 
 static inline void net_stats_update_icmp_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.icmp.recv++);
+	UPDATE_STAT_ADD(iface, icmp.recv, 1);
 }
 
 static inline void net_stats_update_icmp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.icmp.drop++);
+	UPDATE_STAT_ADD(iface, icmp.drop, 1);
 }
 #else
 #define net_stats_update_icmp_sent(iface)
@@ -162,22 +206,22 @@ static inline void net_stats_update_icmp_drop(struct net_if *iface)
 /* UDP stats */
 static inline void net_stats_update_udp_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.sent++);
+	UPDATE_STAT_ADD(iface, udp.sent, 1);
 }
 
 static inline void net_stats_update_udp_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.recv++);
+	UPDATE_STAT_ADD(iface, udp.recv, 1);
 }
 
 static inline void net_stats_update_udp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.drop++);
+	UPDATE_STAT_ADD(iface, udp.drop, 1);
 }
 
 static inline void net_stats_update_udp_chkerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.udp.chkerr++);
+	UPDATE_STAT_ADD(iface, udp.chkerr, 1);
 }
 #else
 #define net_stats_update_udp_sent(iface)
@@ -190,73 +234,83 @@ static inline void net_stats_update_udp_chkerr(struct net_if *iface)
 /* TCP stats */
 static inline void net_stats_update_tcp_sent(struct net_if *iface, uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.tcp.bytes.sent += bytes);
+	UPDATE_STAT_ADD(iface, tcp.bytes.sent, bytes);
 }
 
 static inline void net_stats_update_tcp_recv(struct net_if *iface, uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.tcp.bytes.received += bytes);
+	UPDATE_STAT_ADD(iface, tcp.bytes.received, bytes);
 }
 
 static inline void net_stats_update_tcp_resent(struct net_if *iface,
 					       uint32_t bytes)
 {
-	UPDATE_STAT(iface, stats.tcp.resent += bytes);
+	UPDATE_STAT_ADD(iface, tcp.resent, bytes);
 }
 
 static inline void net_stats_update_tcp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.drop++);
+	UPDATE_STAT_ADD(iface, tcp.drop, 1);
 }
 
 static inline void net_stats_update_tcp_seg_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.sent++);
+	UPDATE_STAT_ADD(iface, tcp.sent, 1);
 }
 
 static inline void net_stats_update_tcp_seg_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.recv++);
+	UPDATE_STAT_ADD(iface, tcp.recv, 1);
 }
 
 static inline void net_stats_update_tcp_seg_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.seg_drop++);
+	UPDATE_STAT_ADD(iface, tcp.seg_drop, 1);
 }
 
 static inline void net_stats_update_tcp_seg_rst(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.rst++);
+	UPDATE_STAT_ADD(iface, tcp.rst, 1);
 }
 
 static inline void net_stats_update_tcp_seg_conndrop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.conndrop++);
+	UPDATE_STAT_ADD(iface, tcp.conndrop, 1);
 }
 
 static inline void net_stats_update_tcp_seg_connrst(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.connrst++);
+	UPDATE_STAT_ADD(iface, tcp.connrst, 1);
 }
 
 static inline void net_stats_update_tcp_seg_chkerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.chkerr++);
+	UPDATE_STAT_ADD(iface, tcp.chkerr, 1);
 }
 
 static inline void net_stats_update_tcp_seg_ackerr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.ackerr++);
+	UPDATE_STAT_ADD(iface, tcp.ackerr, 1);
 }
 
 static inline void net_stats_update_tcp_seg_rsterr(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.rsterr++);
+	UPDATE_STAT_ADD(iface, tcp.rsterr, 1);
 }
 
 static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.tcp.rexmit++);
+	UPDATE_STAT_ADD(iface, tcp.rexmit, 1);
+}
+
+static inline void net_stats_update_tcp_gro_merged(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, tcp.gro_merged, 1);
+}
+
+static inline void net_stats_update_tcp_gro_flushed(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, tcp.gro_flushed, 1);
 }
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
@@ -273,8 +327,31 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_gro_merged(iface)
+#define net_stats_update_tcp_gro_flushed(iface)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
+#if defined(CONFIG_NET_TC_TX_FQ) && defined(CONFIG_NET_STATISTICS)
+static inline void net_stats_update_fq_new_flow(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, fq.new_flows, 1);
+}
+
+static inline void net_stats_update_fq_aqm_drop(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, fq.aqm_drop, 1);
+}
+
+static inline void net_stats_update_fq_overlimit_drop(struct net_if *iface)
+{
+	UPDATE_STAT_ADD(iface, fq.overlimit_drop, 1);
+}
+#else
+#define net_stats_update_fq_new_flow(iface)
+#define net_stats_update_fq_aqm_drop(iface)
+#define net_stats_update_fq_overlimit_drop(iface)
+#endif /* CONFIG_NET_TC_TX_FQ && CONFIG_NET_STATISTICS */
+
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
 						   enum net_ip_protocol proto)
 {
@@ -306,17 +383,17 @@ static inline void net_stats_update_per_proto_drop(struct net_if *iface,
 #if defined(CONFIG_NET_STATISTICS_MLD) && defined(CONFIG_NET_NATIVE)
 static inline void net_stats_update_ipv6_mld_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_mld.recv++);
+	UPDATE_STAT_ADD(iface, ipv6_mld.recv, 1);
 }
 
 static inline void net_stats_update_ipv6_mld_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_mld.sent++);
+	UPDATE_STAT_ADD(iface, ipv6_mld.sent, 1);
 }
 
 static inline void net_stats_update_ipv6_mld_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv6_mld.drop++);
+	UPDATE_STAT_ADD(iface, ipv6_mld.drop, 1);
 }
 #else
 #define net_stats_update_ipv6_mld_recv(iface)
@@ -327,17 +404,17 @@ static inline void net_stats_update_ipv6_mld_drop(struct net_if *iface)
 #if defined(CONFIG_NET_STATISTICS_IGMP) && defined(CONFIG_NET_NATIVE)
 static inline void net_stats_update_ipv4_igmp_recv(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4_igmp.recv++);
+	UPDATE_STAT_ADD(iface, ipv4_igmp.recv, 1);
 }
 
 static inline void net_stats_update_ipv4_igmp_sent(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4_igmp.sent++);
+	UPDATE_STAT_ADD(iface, ipv4_igmp.sent, 1);
 }
 
 static inline void net_stats_update_ipv4_igmp_drop(struct net_if *iface)
 {
-	UPDATE_STAT(iface, stats.ipv4_igmp.drop++);
+	UPDATE_STAT_ADD(iface, ipv4_igmp.drop, 1);
 }
 #else
 #define net_stats_update_ipv4_igmp_recv(iface)
@@ -354,7 +431,7 @@ static inline void net_stats_update_tx_time(struct net_if *iface,
 
 	UPDATE_STAT(iface, stats.tx_time.sum +=
 		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.tx_time.count += 1);
+	UPDATE_STAT_ADD(iface, tx_time.count, 1);
 }
 #else
 #define net_stats_update_tx_time(iface, start_time, end_time)
@@ -387,7 +464,7 @@ static inline void net_stats_update_rx_time(struct net_if *iface,
 
 	UPDATE_STAT(iface, stats.rx_time.sum +=
 		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.rx_time.count += 1);
+	UPDATE_STAT_ADD(iface, rx_time.count, 1);
 }
 #else
 #define net_stats_update_rx_time(iface, start_time, end_time)
@@ -415,13 +492,13 @@ static inline void net_stats_update_rx_time_detail(struct net_if *iface,
 	&& defined(CONFIG_NET_NATIVE)
 static inline void net_stats_update_tc_sent_pkt(struct net_if *iface, uint8_t tc)
 {
-	UPDATE_STAT(iface, stats.tc.sent[tc].pkts++);
+	UPDATE_STAT_ADD(iface, tc.sent[tc].pkts, 1);
 }
 
 static inline void net_stats_update_tc_sent_bytes(struct net_if *iface,
 						  uint8_t tc, size_t bytes)
 {
-	UPDATE_STAT(iface, stats.tc.sent[tc].bytes += bytes);
+	UPDATE_STAT_ADD(iface, tc.sent[tc].bytes, bytes);
 }
 
 static inline void net_stats_update_tc_sent_priority(struct net_if *iface,
@@ -442,7 +519,7 @@ static inline void net_stats_update_tc_tx_time(struct net_if *iface,
 
 	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.sum +=
 		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.tc.sent[tc].tx_time.count += 1);
+	UPDATE_STAT_ADD(iface, tc.sent[tc].tx_time.count, 1);
 
 	net_stats_update_tx_time(iface, start_time, end_time);
 }
@@ -484,7 +561,7 @@ static inline void net_stats_update_tc_rx_time(struct net_if *iface,
 
 	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.sum +=
 		    k_cyc_to_ns_floor64(diff) / 1000);
-	UPDATE_STAT(iface, stats.tc.recv[tc].rx_time.count += 1);
+	UPDATE_STAT_ADD(iface, tc.recv[tc].rx_time.count, 1);
 
 	net_stats_update_rx_time(iface, start_time, end_time);
 }
@@ -516,13 +593,13 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 
 static inline void net_stats_update_tc_recv_pkt(struct net_if *iface, uint8_t tc)
 {
-	UPDATE_STAT(iface, stats.tc.recv[tc].pkts++);
+	UPDATE_STAT_ADD(iface, tc.recv[tc].pkts, 1);
 }
 
 static inline void net_stats_update_tc_recv_bytes(struct net_if *iface,
 						  uint8_t tc, size_t bytes)
 {
-	UPDATE_STAT(iface, stats.tc.recv[tc].bytes += bytes);
+	UPDATE_STAT_ADD(iface, tc.recv[tc].bytes, bytes);
 }
 
 static inline void net_stats_update_tc_recv_priority(struct net_if *iface,
@@ -611,7 +688,7 @@ static inline void net_stats_add_suspend_end_time(struct net_if *iface,
 
 	UPDATE_STAT(iface, stats.pm.start_time = 0);
 	UPDATE_STAT(iface, stats.pm.last_suspend_time = diff_time);
-	UPDATE_STAT(iface, stats.pm.suspend_count++);
+	UPDATE_STAT_ADD(iface, pm.suspend_count, 1);
 	UPDATE_STAT(iface, stats.pm.overall_suspend_time += diff_time);
 }
 #else
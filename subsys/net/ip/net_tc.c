@@ -13,31 +13,50 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+#include "net_tc_fq.h"
+#endif
+
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX steering, "q[y.zz]" denotes the queue of CPU zz of the class.
  */
+#if defined(CONFIG_NET_TC_RX_STEERING)
+#define MAX_NAME_LEN sizeof("xx_q[y.zz]")
+#else
 #define MAX_NAME_LEN sizeof("xx_q[y]")
+#endif
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+/* Flow queues used instead of the fifo of each TX traffic class */
+static struct net_tc_fq tx_fq[NET_TC_TX_COUNT];
+#endif
+
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+/* The queues of a traffic class are next to each other */
+#define RX_QUEUES_PER_TC (NET_TC_RX_QUEUE_COUNT / NET_TC_RX_COUNT)
+
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -52,7 +71,11 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_TX_COUNT > 0
 	net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+	net_tc_fq_enqueue(&tx_fq[tc], pkt);
+#else
 	submit_to_queue(&tx_classes[tc].fifo, pkt);
+#endif
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -60,12 +83,135 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TC_RX_STEERING)
+static inline uint32_t hash_mix(uint32_t hash, uint32_t val)
+{
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+static uint32_t hash_addrs(uint32_t hash, const uint8_t *addrs, size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = hash_mix(hash, UNALIGNED_GET((const uint32_t *)&addrs[i]));
+	}
+
+	return hash;
+}
+
+/* Hash the addresses, protocol and ports of a packet still holding its
+ * link layer header. Packets that cannot be parsed from the first
+ * buffer, or that are not IP at all, all go to the first queue.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t offset = 0U;
+	size_t ports_offset;
+	uint32_t hash = 0U;
+	uint8_t proto;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+		uint16_t type;
+
+		if (buf->len < sizeof(struct net_eth_hdr)) {
+			return 0U;
+		}
+
+		type = ntohs(hdr->type);
+		offset = sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN) {
+			if (buf->len < sizeof(struct net_eth_vlan_hdr)) {
+				return 0U;
+			}
+
+			type = ntohs(((struct net_eth_vlan_hdr *)hdr)->type);
+			offset = sizeof(struct net_eth_vlan_hdr);
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0U;
+		}
+	}
+#endif
+
+	if (buf->len <= offset) {
+		return 0U;
+	}
+
+	switch (buf->data[offset] >> 4) {
+	case 4: {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)&buf->data[offset];
+
+		if (buf->len < offset + sizeof(struct net_ipv4_hdr)) {
+			return 0U;
+		}
+
+		hash = hash_addrs(hash, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+		proto = hdr->proto;
+		ports_offset = offset + (hdr->vhl & 0x0f) * 4U;
+
+		/* Only the first fragment has the ports, keep all of them
+		 * on the same queue.
+		 */
+		if (sys_get_be16(hdr->offset) & (BIT(13) | NET_IPV4_FRAGH_OFFSET_MASK)) {
+			proto = 0U;
+		}
+		break;
+	}
+	case 6: {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)&buf->data[offset];
+
+		if (buf->len < offset + sizeof(struct net_ipv6_hdr)) {
+			return 0U;
+		}
+
+		hash = hash_addrs(hash, hdr->src, 2 * NET_IPV6_ADDR_SIZE);
+		proto = hdr->nexthdr;
+		ports_offset = offset + sizeof(struct net_ipv6_hdr);
+		break;
+	}
+	default:
+		return 0U;
+	}
+
+	/* TCP and UDP both start with the source and destination ports */
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    buf->len >= ports_offset + sizeof(uint32_t)) {
+		hash = hash_mix(hash, UNALIGNED_GET((const uint32_t *)&buf->data[ports_offset]));
+	}
+
+	hash = hash_mix(hash, proto);
+
+	return hash ^ (hash >> 16);
+}
+
+int net_tc_rx_queue(struct net_pkt *pkt)
+{
+	uint8_t tc = net_rx_priority2tc(net_pkt_priority(pkt));
+
+	return tc * RX_QUEUES_PER_TC + net_pkt_rx_hash(pkt) % arch_num_cpus();
+}
+#endif /* CONFIG_NET_TC_RX_STEERING */
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = tc;
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+#if defined(CONFIG_NET_TC_RX_STEERING)
+	if (!net_pkt_rx_hash_set(pkt)) {
+		net_pkt_set_rx_hash(pkt, rx_flow_hash(pkt));
+	}
+
+	queue = net_tc_rx_queue(pkt);
+#endif
+
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -242,10 +388,10 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(void *p1, void *p2, void *p3)
 {
-	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
 	struct k_fifo *fifo = p1;
+	int queue = POINTER_TO_INT(p2);
 	struct net_pkt *pkt;
 
 	while (1) {
@@ -255,6 +401,11 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		}
 
 		net_process_rx_packet(pkt);
+
+		/* End of the batch, pass on what GRO is holding */
+		if (k_fifo_is_empty(fifo)) {
+			net_gro_flush(queue);
+		}
 	}
 }
 #endif
@@ -265,6 +416,16 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+	struct net_tc_fq *fq = p1;
+	struct net_pkt *pkt;
+
+	while (1) {
+		pkt = net_tc_fq_dequeue(fq);
+
+		net_process_tx_packet(pkt);
+	}
+#else
 	struct k_fifo *fifo = p1;
 	struct net_pkt *pkt;
 
@@ -276,6 +437,7 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 
 		net_process_tx_packet(pkt);
 	}
+#endif
 }
 #endif
 
@@ -298,6 +460,7 @@ void net_tc_tx_init(void)
 
 	for (i = 0; i < NET_TC_TX_COUNT; i++) {
 		uint8_t thread_priority;
+		void *queue;
 		int priority;
 		k_tid_t tid;
 
@@ -318,10 +481,17 @@ void net_tc_tx_init(void)
 
 		k_fifo_init(&tx_classes[i].fifo);
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+		net_tc_fq_init(&tx_fq[i]);
+		queue = &tx_fq[i];
+#else
+		queue = &tx_classes[i].fifo;
+#endif
+
 		tid = k_thread_create(&tx_classes[i].handler, tx_stack[i],
 				      K_KERNEL_STACK_SIZEOF(tx_stack[i]),
 				      tc_tx_handler,
-				      &tx_classes[i].fifo, NULL, NULL,
+				      queue, NULL, NULL,
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
@@ -354,12 +524,18 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_QUEUE_COUNT; i++) {
+		uint8_t tc = i / RX_QUEUES_PER_TC;
+		int cpu = i % RX_QUEUES_PER_TC;
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		if (cpu >= arch_num_cpus()) {
+			continue;
+		}
+
+		thread_priority = rx_tc2thread(tc);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -379,17 +555,28 @@ void net_tc_rx_init(void)
 		tid = k_thread_create(&rx_classes[i].handler, rx_stack[i],
 				      K_KERNEL_STACK_SIZEOF(rx_stack[i]),
 				      tc_rx_handler,
-				      &rx_classes[i].fifo, NULL, NULL,
+				      &rx_classes[i].fifo, INT_TO_POINTER(i), NULL,
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
 			continue;
 		}
 
+#if defined(CONFIG_NET_TC_RX_STEERING)
+		if (k_thread_cpu_pin(tid, cpu) < 0) {
+			NET_ERR("Cannot pin TC handler thread %d to CPU %d", i, cpu);
+		}
+#endif
+
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (IS_ENABLED(CONFIG_NET_TC_RX_STEERING)) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]", tc, cpu);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", tc);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_tc_fq, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+#include "net_tc_fq.h"
+
+/* Flow queues in the style of FQ-CoDel (RFC 8290).
+ *
+ * Packets are hashed to one of CONFIG_NET_TC_TX_FQ_FLOWS queues. Queues
+ * that become active are served first (new flows), then all active queues
+ * take turns sending up to their deficit (old flows). A queue only stays
+ * in the new flows list for one quantum, so a sparse flow gets its packets
+ * out right away while bulk flows share the remaining capacity equally.
+ *
+ * Each queue runs CoDel (RFC 8289) on the time its packets spent queued.
+ * Times are in milliseconds of uptime, wrapping arithmetic is used
+ * throughout.
+ */
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NET_TC_TX_FQ_FLOWS),
+	     "CONFIG_NET_TC_TX_FQ_FLOWS must be a power of two");
+
+#define TARGET   CONFIG_NET_TC_TX_FQ_CODEL_TARGET
+#define INTERVAL CONFIG_NET_TC_TX_FQ_CODEL_INTERVAL
+#define QUANTUM  CONFIG_NET_TC_TX_FQ_QUANTUM
+
+/* Perturbs the flow hash so that remote peers cannot predict collisions */
+static uint32_t hash_seed;
+
+static inline uint32_t hash_mix(uint32_t hash, uint32_t val)
+{
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+static uint32_t hash_bytes(uint32_t hash, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = hash_mix(hash, UNALIGNED_GET((const uint32_t *)&data[i]));
+	}
+
+	return hash;
+}
+
+static struct net_tc_fq_flow *flow_get(struct net_tc_fq *fq, struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	uint32_t hash = hash_seed;
+	size_t ports_offset = 0;
+	uint8_t proto = 0;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6 &&
+	    buf->len >= sizeof(struct net_ipv6_hdr)) {
+		struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+
+		/* Source and destination addresses are adjacent */
+		hash = hash_bytes(hash, hdr->src, 2 * NET_IPV6_ADDR_SIZE);
+
+		if (net_pkt_ipv6_ext_len(pkt) == 0U) {
+			proto = hdr->nexthdr;
+			ports_offset = net_pkt_ip_hdr_len(pkt);
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET &&
+		   buf->len >= sizeof(struct net_ipv4_hdr)) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+
+		hash = hash_bytes(hash, hdr->src, 2 * NET_IPV4_ADDR_SIZE);
+		proto = hdr->proto;
+		ports_offset = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+	} else {
+		/* Not IP, at least keep the packets of a context together */
+		hash = hash_mix(hash, POINTER_TO_UINT(net_pkt_context(pkt)));
+	}
+
+	/* TCP and UDP both start with the source and destination ports */
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    buf->len >= ports_offset + sizeof(uint32_t)) {
+		hash = hash_mix(hash, UNALIGNED_GET((const uint32_t *)&buf->data[ports_offset]));
+	}
+
+	hash = hash_mix(hash, proto);
+
+	return &fq->flows[(hash ^ (hash >> 16)) & (CONFIG_NET_TC_TX_FQ_FLOWS - 1)];
+}
+
+static inline struct net_pkt *flow_head(struct net_tc_fq_flow *flow)
+{
+	/* The fifo field is reserved for queuing the packet, as a k_fifo does. */
+	sys_snode_t *node = sys_slist_peek_head(&flow->pkts);
+
+	return node ? CONTAINER_OF((intptr_t *)node, struct net_pkt, fifo) : NULL;
+}
+
+static struct net_pkt *flow_pop(struct net_tc_fq *fq, struct net_tc_fq_flow *flow)
+{
+	struct net_pkt *pkt = flow_head(flow);
+	size_t len;
+
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	(void)sys_slist_get_not_empty(&flow->pkts);
+
+	len = net_pkt_get_len(pkt);
+	flow->backlog -= len;
+	fq->backlog -= len;
+
+	return pkt;
+}
+
+static inline void drop_list_add(sys_slist_t *drops, struct net_pkt *pkt)
+{
+	sys_slist_append(drops, (sys_snode_t *)&pkt->fifo);
+}
+
+/* Packets are dropped outside of the lock, their callbacks may take a while */
+static void drop_list_flush(sys_slist_t *drops, bool aqm)
+{
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(drops)) != NULL) {
+		struct net_pkt *pkt = CONTAINER_OF((intptr_t *)node, struct net_pkt, fifo);
+
+		if (aqm) {
+			net_stats_update_fq_aqm_drop(net_pkt_iface(pkt));
+		} else {
+			net_stats_update_fq_overlimit_drop(net_pkt_iface(pkt));
+		}
+
+		net_process_tx_drop(pkt, -ENOBUFS);
+	}
+}
+
+/* Integer square root, for the CoDel control law */
+static uint32_t isqrt(uint32_t val)
+{
+	uint32_t res = 0U;
+	uint32_t bit = 1U << 30;
+
+	while (bit > val) {
+		bit >>= 2;
+	}
+
+	while (bit != 0U) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return res;
+}
+
+static inline uint32_t control_law(uint32_t t, uint32_t count)
+{
+	/* interval / sqrt(count), scaled to keep some precision */
+	return t + (INTERVAL * 256U) / isqrt(count << 16);
+}
+
+static inline bool time_after_eq(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) >= 0;
+}
+
+static bool codel_should_drop(struct net_tc_fq_flow *flow, struct net_pkt *pkt, uint32_t now)
+{
+	uint32_t sojourn = now - net_pkt_fq_time(pkt);
+
+	/* Never drop the last packet of a flow, see RFC 8289, 4.2 */
+	if (sojourn < TARGET || flow->backlog <= QUANTUM) {
+		flow->first_above_time = 0U;
+		return false;
+	}
+
+	if (flow->first_above_time == 0U) {
+		flow->first_above_time = (now + INTERVAL) | 1U;
+		return false;
+	}
+
+	return time_after_eq(now, flow->first_above_time);
+}
+
+/* Pop the next packet to send from a flow, see RFC 8289, 5.5 */
+static struct net_pkt *codel_dequeue(struct net_tc_fq *fq, struct net_tc_fq_flow *flow,
+				     uint32_t now, sys_slist_t *drops)
+{
+	struct net_pkt *pkt = flow_head(flow);
+	bool drop;
+
+	if (pkt == NULL) {
+		flow->dropping = false;
+		return NULL;
+	}
+
+	drop = codel_should_drop(flow, pkt, now);
+	pkt = flow_pop(fq, flow);
+
+	if (flow->dropping) {
+		if (!drop) {
+			flow->dropping = false;
+			return pkt;
+		}
+
+		while (flow->dropping && time_after_eq(now, flow->drop_next)) {
+			drop_list_add(drops, pkt);
+			flow->count++;
+
+			pkt = flow_head(flow);
+			if (pkt == NULL || !codel_should_drop(flow, pkt, now)) {
+				flow->dropping = false;
+			} else {
+				flow->drop_next = control_law(flow->drop_next, flow->count);
+			}
+
+			pkt = flow_pop(fq, flow);
+		}
+	} else if (drop) {
+		uint32_t delta = flow->count - flow->lastcount;
+
+		drop_list_add(drops, pkt);
+		pkt = flow_pop(fq, flow);
+
+		flow->dropping = true;
+
+		/* Resume at the previous drop rate if dropping stopped only
+		 * recently.
+		 */
+		if (delta > 1U && !time_after_eq(now, flow->drop_next + 16U * INTERVAL)) {
+			flow->count = delta;
+		} else {
+			flow->count = 1U;
+		}
+
+		flow->lastcount = flow->count;
+		flow->drop_next = control_law(now, flow->count);
+	}
+
+	return pkt;
+}
+
+/* Drop from the head of the fattest flow, see RFC 8290, 4.1 */
+static void drop_overlimit(struct net_tc_fq *fq, sys_slist_t *drops)
+{
+	struct net_tc_fq_flow *fattest = &fq->flows[0];
+
+	for (int i = 1; i < CONFIG_NET_TC_TX_FQ_FLOWS; i++) {
+		if (fq->flows[i].backlog > fattest->backlog) {
+			fattest = &fq->flows[i];
+		}
+	}
+
+	drop_list_add(drops, flow_pop(fq, fattest));
+}
+
+void net_tc_fq_enqueue(struct net_tc_fq *fq, struct net_pkt *pkt)
+{
+	struct net_tc_fq_flow *flow = flow_get(fq, pkt);
+	size_t len = net_pkt_get_len(pkt);
+	sys_slist_t drops;
+	k_spinlock_key_t key;
+	bool new_flow = false;
+
+	sys_slist_init(&drops);
+
+	net_pkt_set_fq_time(pkt, k_uptime_get_32());
+
+	key = k_spin_lock(&fq->lock);
+
+	sys_slist_append(&flow->pkts, (sys_snode_t *)&pkt->fifo);
+	flow->backlog += len;
+	fq->backlog += len;
+
+	if (!flow->active) {
+		flow->active = true;
+		flow->deficit = QUANTUM;
+		sys_slist_append(&fq->new_flows, &flow->node);
+		new_flow = true;
+	}
+
+	/* The packet just queued is dropped as well if its flow is the
+	 * fattest one, but allowing it to exceed the limit would not help.
+	 */
+	while (fq->backlog > CONFIG_NET_TC_TX_FQ_LIMIT) {
+		drop_overlimit(fq, &drops);
+	}
+
+	k_spin_unlock(&fq->lock, key);
+
+	if (new_flow) {
+		net_stats_update_fq_new_flow(net_pkt_iface(pkt));
+	}
+
+	k_sem_give(&fq->pending);
+
+	drop_list_flush(&drops, false);
+}
+
+static struct net_pkt *fq_dequeue(struct net_tc_fq *fq, sys_slist_t *drops)
+{
+	uint32_t now = k_uptime_get_32();
+	struct net_tc_fq_flow *flow;
+	struct net_pkt *pkt;
+	sys_slist_t *list;
+	sys_snode_t *node;
+
+	while (true) {
+		list = sys_slist_is_empty(&fq->new_flows) ? &fq->old_flows : &fq->new_flows;
+
+		node = sys_slist_peek_head(list);
+		if (node == NULL) {
+			return NULL;
+		}
+
+		flow = CONTAINER_OF(node, struct net_tc_fq_flow, node);
+
+		if (flow->deficit <= 0) {
+			flow->deficit += QUANTUM;
+			(void)sys_slist_get_not_empty(list);
+			sys_slist_append(&fq->old_flows, &flow->node);
+			continue;
+		}
+
+		pkt = codel_dequeue(fq, flow, now, drops);
+		if (pkt != NULL) {
+			flow->deficit -= net_pkt_get_len(pkt);
+			return pkt;
+		}
+
+		(void)sys_slist_get_not_empty(list);
+
+		/* An emptied new flow moves to the old flows once, so that it
+		 * cannot get ahead of them by sending single packets.
+		 */
+		if (list == &fq->new_flows && !sys_slist_is_empty(&fq->old_flows)) {
+			sys_slist_append(&fq->old_flows, &flow->node);
+		} else {
+			flow->active = false;
+		}
+	}
+}
+
+struct net_pkt *net_tc_fq_dequeue(struct net_tc_fq *fq)
+{
+	struct net_pkt *pkt;
+	sys_slist_t drops;
+	k_spinlock_key_t key;
+
+	sys_slist_init(&drops);
+
+	do {
+		k_sem_take(&fq->pending, K_FOREVER);
+
+		key = k_spin_lock(&fq->lock);
+		pkt = fq_dequeue(fq, &drops);
+
+		/* More packets to go, keep the handler going */
+		if (fq->backlog > 0U) {
+			k_sem_give(&fq->pending);
+		}
+
+		k_spin_unlock(&fq->lock, key);
+
+		drop_list_flush(&drops, true);
+	} while (pkt == NULL);
+
+	return pkt;
+}
+
+void net_tc_fq_init(struct net_tc_fq *fq)
+{
+	if (hash_seed == 0U) {
+		hash_seed = sys_rand32_get();
+	}
+
+	memset(fq->flows, 0, sizeof(fq->flows));
+	sys_slist_init(&fq->new_flows);
+	sys_slist_init(&fq->old_flows);
+	fq->backlog = 0U;
+	k_sem_init(&fq->pending, 0, 1);
+}
@@ -0,0 +1,64 @@
+/** @file
+ * @brief Per-flow fair queuing for TX traffic classes
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_TC_FQ_H
+#define __NET_TC_FQ_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/slist.h>
+
+/* A flow queue, managed by CoDel, see RFC 8289. */
+struct net_tc_fq_flow {
+	/* Queued packets, linked through their fifo field */
+	sys_slist_t pkts;
+	/* Node in the new or old flows list while the flow is active */
+	sys_snode_t node;
+	/* Queued bytes */
+	uint32_t backlog;
+	/* Bytes the flow may still send in this round */
+	int32_t deficit;
+	/* CoDel state */
+	uint32_t first_above_time;
+	uint32_t drop_next;
+	uint32_t count;
+	uint32_t lastcount;
+	bool dropping : 1;
+	/* The flow is in the new or old flows list */
+	bool active : 1;
+};
+
+/* Flow queues of a TX traffic class, served in deficit round robin order,
+ * see RFC 8290.
+ */
+struct net_tc_fq {
+	struct net_tc_fq_flow flows[CONFIG_NET_TC_TX_FQ_FLOWS];
+	sys_slist_t new_flows;
+	sys_slist_t old_flows;
+	/* Queued bytes of all flows */
+	uint32_t backlog;
+	struct k_spinlock lock;
+	/* Signaled when a packet has been queued */
+	struct k_sem pending;
+};
+
+void net_tc_fq_init(struct net_tc_fq *fq);
+
+/* Queue a packet to its flow, possibly dropping others to stay within
+ * CONFIG_NET_TC_TX_FQ_LIMIT.
+ */
+void net_tc_fq_enqueue(struct net_tc_fq *fq, struct net_pkt *pkt);
+
+/* Wait for the next packet to send, dropping the packets CoDel asks for. */
+struct net_pkt *net_tc_fq_dequeue(struct net_tc_fq *fq);
+
+#endif /* __NET_TC_FQ_H */
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/net/net_timer_wheel.h>
+
+#define NUM_SLOTS CONFIG_NET_TIMER_WHEEL_SLOTS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(NUM_SLOTS),
+	     "Number of timer wheel slots must be a power of two");
+
+static inline sys_dlist_t *slot_get(struct net_timer_wheel *wheel, uint32_t tick)
+{
+	return &wheel->slots[tick & (NUM_SLOTS - 1)];
+}
+
+static inline uint32_t tick_now(struct net_timer_wheel *wheel, int64_t now_ms)
+{
+	return (uint32_t)(now_ms / wheel->tick_ms);
+}
+
+static void schedule_at(struct net_timer_wheel *wheel, uint32_t tick)
+{
+	int64_t now_ms = k_uptime_get();
+	int32_t ticks = (int32_t)(tick - tick_now(wheel, now_ms));
+	int64_t delay_ms = (int64_t)ticks * wheel->tick_ms - now_ms % wheel->tick_ms;
+
+	if (wheel->scheduled && (int32_t)(tick - wheel->next) >= 0) {
+		return;
+	}
+
+	wheel->next = tick;
+	wheel->scheduled = true;
+
+	(void)k_work_reschedule(&wheel->work,
+				delay_ms > 0 ? K_MSEC(delay_ms) : K_NO_WAIT);
+}
+
+/* Move the entries expired by tick now to the expired list, still counted */
+static void expire(struct net_timer_wheel *wheel, uint32_t now, sys_dlist_t *expired)
+{
+	struct net_timer_wheel_entry *entry, *next;
+	uint32_t ticks;
+
+	if ((int32_t)(now - wheel->tick) < 0) {
+		return;
+	}
+
+	ticks = MIN(now - wheel->tick + 1U, NUM_SLOTS);
+
+	for (uint32_t i = 0U; i < ticks; i++) {
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(slot_get(wheel, wheel->tick + i),
+						  entry, next, node) {
+			if ((int32_t)(entry->expiry - now) > 0) {
+				continue;
+			}
+
+			sys_dlist_remove(&entry->node);
+			sys_dlist_append(expired, &entry->node);
+		}
+	}
+
+	wheel->tick = now + 1U;
+}
+
+/* Earliest expiry tick, slots also hold the entries of later rotations */
+static uint32_t next_expiry(struct net_timer_wheel *wheel)
+{
+	struct net_timer_wheel_entry *entry;
+	uint32_t earliest = 0U;
+	bool found = false;
+
+	for (uint32_t i = 0U; i < NUM_SLOTS; i++) {
+		SYS_DLIST_FOR_EACH_CONTAINER(slot_get(wheel, wheel->tick + i), entry, node) {
+			if (entry->expiry == wheel->tick + i) {
+				return entry->expiry;
+			}
+
+			if (!found || (int32_t)(entry->expiry - earliest) < 0) {
+				earliest = entry->expiry;
+				found = true;
+			}
+		}
+	}
+
+	return earliest;
+}
+
+static void net_timer_wheel_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct net_timer_wheel *wheel = CONTAINER_OF(dwork, struct net_timer_wheel, work);
+	struct net_timer_wheel_entry *entry;
+	sys_dlist_t expired;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+
+	sys_dlist_init(&expired);
+
+	key = k_spin_lock(&wheel->lock);
+	wheel->scheduled = false;
+	expire(wheel, tick_now(wheel, k_uptime_get()), &expired);
+	k_spin_unlock(&wheel->lock, key);
+
+	/* The callbacks may add or remove entries, expired ones included */
+	while (true) {
+		key = k_spin_lock(&wheel->lock);
+		node = sys_dlist_get(&expired);
+		if (node != NULL) {
+			wheel->count--;
+		}
+		k_spin_unlock(&wheel->lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		entry = CONTAINER_OF(node, struct net_timer_wheel_entry, node);
+		entry->cb(entry);
+	}
+
+	key = k_spin_lock(&wheel->lock);
+
+	if (wheel->count > 0U) {
+		schedule_at(wheel, next_expiry(wheel));
+	}
+
+	k_spin_unlock(&wheel->lock, key);
+}
+
+void net_timer_wheel_init(struct net_timer_wheel *wheel, uint32_t tick_ms)
+{
+	__ASSERT_NO_MSG(tick_ms > 0U);
+
+	(void)memset(wheel, 0, sizeof(*wheel));
+
+	for (size_t i = 0; i < NUM_SLOTS; i++) {
+		sys_dlist_init(&wheel->slots[i]);
+	}
+
+	wheel->tick_ms = tick_ms;
+
+	k_work_init_delayable(&wheel->work, net_timer_wheel_timeout);
+}
+
+void net_timer_wheel_entry_init(struct net_timer_wheel_entry *entry,
+				net_timer_wheel_cb_t cb)
+{
+	sys_dnode_init(&entry->node);
+	entry->expiry = 0U;
+	entry->cb = cb;
+}
+
+void net_timer_wheel_add(struct net_timer_wheel *wheel,
+			 struct net_timer_wheel_entry *entry,
+			 uint32_t delay_ms)
+{
+	int64_t now_ms = k_uptime_get();
+	uint32_t expiry;
+	k_spinlock_key_t key;
+
+	__ASSERT_NO_MSG(delay_ms <= (uint32_t)INT32_MAX);
+
+	/* Rounded up, not to expire early */
+	expiry = (uint32_t)((now_ms + delay_ms + wheel->tick_ms - 1) / wheel->tick_ms);
+
+	key = k_spin_lock(&wheel->lock);
+
+	if (sys_dnode_is_linked(&entry->node)) {
+		sys_dlist_remove(&entry->node);
+		wheel->count--;
+	}
+
+	if (wheel->count == 0U) {
+		wheel->tick = tick_now(wheel, now_ms);
+	}
+
+	/* Ticks already handled are only looked at again after a rotation */
+	if ((int32_t)(expiry - wheel->tick) < 0) {
+		expiry = wheel->tick;
+	}
+
+	entry->expiry = expiry;
+	sys_dlist_append(slot_get(wheel, expiry), &entry->node);
+	wheel->count++;
+
+	schedule_at(wheel, expiry);
+
+	k_spin_unlock(&wheel->lock, key);
+}
+
+void net_timer_wheel_remove(struct net_timer_wheel *wheel,
+			    struct net_timer_wheel_entry *entry)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&wheel->lock);
+
+	if (sys_dnode_is_linked(&entry->node)) {
+		sys_dlist_remove(&entry->node);
+		wheel->count--;
+	}
+
+	k_spin_unlock(&wheel->lock, key);
+}
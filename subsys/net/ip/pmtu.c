@@ -0,0 +1,235 @@
+/** @file
+ * @brief IPv6 Path MTU Discovery
+ *
+ * The path MTU towards a destination is learned from the received ICMPv6
+ * Packet Too Big messages, see RFC 8201.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_pmtu, CONFIG_NET_IPV6_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/icmp.h>
+#include "net_private.h"
+#include "icmpv6.h"
+#include "ipv6.h"
+#include "pmtu.h"
+#include "net_stats.h"
+
+static struct net_pmtu_entry
+	pmtu_entries[CONFIG_NET_IPV6_PMTU_DESTINATION_CACHE_ENTRIES];
+
+static K_MUTEX_DEFINE(lock);
+
+static struct net_icmp_ctx ptb_ctx;
+
+static bool pmtu_entry_is_expired(struct net_pmtu_entry *entry, uint32_t now)
+{
+	return now - entry->last_update >= CONFIG_NET_IPV6_PMTU_AGING_TIME;
+}
+
+static struct net_pmtu_entry *pmtu_entry_get(const struct in6_addr *dst,
+					     uint32_t now)
+{
+	ARRAY_FOR_EACH_PTR(pmtu_entries, entry) {
+		if (!entry->in_use ||
+		    !net_ipv6_addr_cmp(&entry->dst, dst)) {
+			continue;
+		}
+
+		if (pmtu_entry_is_expired(entry, now)) {
+			NET_DBG("PMTU %d to %s expired", entry->mtu,
+				net_sprint_ipv6_addr(dst));
+			entry->in_use = false;
+			return NULL;
+		}
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+static struct net_pmtu_entry *pmtu_entry_alloc(uint32_t now)
+{
+	struct net_pmtu_entry *oldest = NULL;
+
+	ARRAY_FOR_EACH_PTR(pmtu_entries, entry) {
+		if (!entry->in_use || pmtu_entry_is_expired(entry, now)) {
+			return entry;
+		}
+
+		if (oldest == NULL ||
+		    (int32_t)(entry->last_update - oldest->last_update) < 0) {
+			oldest = entry;
+		}
+	}
+
+	return oldest;
+}
+
+int net_pmtu_ipv6_get_mtu(const struct in6_addr *dst)
+{
+	struct net_pmtu_entry *entry;
+	int ret = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	entry = pmtu_entry_get(dst, k_uptime_seconds());
+	if (entry) {
+		ret = entry->mtu;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int net_pmtu_ipv6_update(const struct in6_addr *dst, uint16_t mtu)
+{
+	struct net_pmtu_entry *entry;
+	uint32_t now = k_uptime_seconds();
+	int ret = 0;
+
+	if (mtu < NET_IPV6_MTU) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	entry = pmtu_entry_get(dst, now);
+	if (entry) {
+		ret = entry->mtu;
+	} else {
+		entry = pmtu_entry_alloc(now);
+		net_ipaddr_copy(&entry->dst, dst);
+		entry->in_use = true;
+	}
+
+	entry->mtu = mtu;
+	entry->last_update = now;
+
+	k_mutex_unlock(&lock);
+
+	NET_DBG("PMTU to %s is %d (was %d)", net_sprint_ipv6_addr(dst),
+		mtu, ret);
+
+	return ret;
+}
+
+void net_pmtu_clear(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(pmtu_entries, entry) {
+		entry->in_use = false;
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static int handle_ptb_input(struct net_icmp_ctx *ctx,
+			    struct net_pkt *pkt,
+			    struct net_icmp_ip_hdr *hdr,
+			    struct net_icmp_hdr *icmp_hdr,
+			    void *user_data)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ptb_access, struct net_icmpv6_ptb);
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+	struct net_ipv6_hdr *ip_hdr = hdr->ipv6;
+	struct net_ipv6_hdr *orig_hdr;
+	struct net_icmpv6_ptb *ptb_hdr;
+	struct in6_addr orig_src;
+	struct in6_addr orig_dst;
+	uint32_t mtu;
+	int ret;
+
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(user_data);
+
+	if (icmp_hdr->code != 0U) {
+		goto drop;
+	}
+
+	ptb_hdr = (struct net_icmpv6_ptb *)net_pkt_get_data(pkt, &ptb_access);
+	if (!ptb_hdr) {
+		NET_DBG("DROP: NULL PTB header");
+		goto drop;
+	}
+
+	mtu = ntohl(UNALIGNED_GET(&ptb_hdr->mtu));
+
+	net_pkt_acknowledge_data(pkt, &ptb_access);
+
+	/* The invoking packet follows, it is needed to know the destination
+	 * the path MTU applies to.
+	 */
+	orig_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+	if (!orig_hdr) {
+		NET_DBG("DROP: NULL invoking packet header");
+		goto drop;
+	}
+
+	net_ipv6_addr_copy_raw((uint8_t *)&orig_src, orig_hdr->src);
+	net_ipv6_addr_copy_raw((uint8_t *)&orig_dst, orig_hdr->dst);
+
+	NET_DBG("Received Packet Too Big from %s MTU %u for %s",
+		net_sprint_ipv6_addr(&ip_hdr->src), mtu,
+		net_sprint_ipv6_addr(&orig_dst));
+
+	/* Only accept messages about packets we have sent, and never lower
+	 * the path MTU below the IPv6 minimum MTU (RFC 8201 ch 4).
+	 */
+	if (!net_ipv6_is_my_addr(&orig_src)) {
+		NET_DBG("DROP: PTB for a packet not sent by us");
+		goto drop;
+	}
+
+	if (mtu < NET_IPV6_MTU) {
+		NET_DBG("DROP: PTB MTU %u below minimum", mtu);
+		goto drop;
+	}
+
+	/* A Packet Too Big message can only decrease the path MTU. */
+	ret = net_pmtu_ipv6_get_mtu(&orig_dst);
+	if (ret < 0) {
+		ret = net_if_get_mtu(net_pkt_iface(pkt));
+	}
+
+	if (ret > 0 && mtu >= ret) {
+		NET_DBG("Ignoring PTB MTU %u, current %d", mtu, ret);
+	} else {
+		(void)net_pmtu_ipv6_update(&orig_dst, MIN(mtu, UINT16_MAX));
+	}
+
+	net_stats_update_ipv6_pmtu_recv(net_pkt_iface(pkt));
+
+	return 0;
+
+drop:
+	net_stats_update_ipv6_pmtu_drop(net_pkt_iface(pkt));
+
+	return -EIO;
+}
+
+void net_pmtu_init(void)
+{
+	int ret;
+
+	ret = net_icmp_init_ctx(&ptb_ctx, NET_ICMPV6_PACKET_TOO_BIG, 0,
+				handle_ptb_input);
+	if (ret < 0) {
+		NET_ERR("Cannot register %s handler (%d)",
+			STRINGIFY(NET_ICMPV6_PACKET_TOO_BIG), ret);
+	}
+}
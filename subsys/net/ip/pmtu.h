@@ -0,0 +1,84 @@
+/** @file
+ * @brief IPv6 Path MTU Discovery
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PMTU_H
+#define __PMTU_H
+
+#include <errno.h>
+#include <zephyr/types.h>
+#include <zephyr/net/net_ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Path MTU destination cache entry.
+ */
+struct net_pmtu_entry {
+	/** Destination IPv6 address. */
+	struct in6_addr dst;
+
+	/** Time of the last update, in seconds since boot. */
+	uint32_t last_update;
+
+	/** Path MTU towards the destination. */
+	uint16_t mtu;
+
+	/** Is this entry in use or not. */
+	bool in_use;
+};
+
+#if defined(CONFIG_NET_IPV6_PMTU)
+/**
+ * @brief Get the path MTU learned for a destination.
+ *
+ * Entries older than CONFIG_NET_IPV6_PMTU_AGING_TIME are forgotten.
+ *
+ * @param dst Destination IPv6 address.
+ *
+ * @return Path MTU, -ENOENT if no path MTU is known for the destination.
+ */
+int net_pmtu_ipv6_get_mtu(const struct in6_addr *dst);
+
+/**
+ * @brief Update the path MTU of a destination.
+ *
+ * @param dst Destination IPv6 address.
+ * @param mtu New path MTU, must not be smaller than the IPv6 minimum MTU.
+ *
+ * @return Previous path MTU, 0 if there was none, <0 on error.
+ */
+int net_pmtu_ipv6_update(const struct in6_addr *dst, uint16_t mtu);
+
+/**
+ * @brief Forget all path MTU destination cache entries.
+ */
+void net_pmtu_clear(void);
+
+void net_pmtu_init(void);
+#else
+static inline int net_pmtu_ipv6_get_mtu(const struct in6_addr *dst)
+{
+	ARG_UNUSED(dst);
+
+	return -ENOENT;
+}
+
+#define net_pmtu_init(...)
+#endif /* CONFIG_NET_IPV6_PMTU */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PMTU_H */
@@ -267,15 +267,232 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Routes are kept in a path compressed binary trie. Every node holds a
+ * prefix masked to its length and the routes towards that prefix, the
+ * children extend the prefix by the bit following it. Nodes without routes
+ * only exist to branch, so at most two nodes are needed per route.
+ */
+struct net_route_trie_node {
+	struct net_route_trie_node *parent;
+	struct net_route_trie_node *child[2];
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+	bool in_use;
+};
+
+static struct net_route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct net_route_trie_node *route_trie_root;
+
+static inline uint8_t route_trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8] >> (7 - (pos % 8))) & 1;
+}
+
+/* Number of leading bits the addresses have in common, at most max */
+static uint8_t route_trie_common_len(const struct in6_addr *a,
+				     const struct in6_addr *b,
+				     uint8_t max)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(a->s6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - (32 - 8);
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct net_route_trie_node *route_trie_node_alloc(const struct in6_addr *prefix,
+							 uint8_t prefix_len)
+{
+	struct net_route_trie_node *node = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		if (!route_trie_nodes[i].in_use) {
+			node = &route_trie_nodes[i];
+			break;
+		}
+	}
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	memset(node, 0, sizeof(*node));
+	node->in_use = true;
+	node->prefix_len = prefix_len;
+
+	memcpy(node->prefix.s6_addr, prefix->s6_addr, prefix_len / 8U);
+	if (prefix_len % 8U) {
+		node->prefix.s6_addr[prefix_len / 8U] =
+			prefix->s6_addr[prefix_len / 8U] & (0xff << (8 - (prefix_len % 8U)));
+	}
+
+	sys_slist_init(&node->routes);
+
+	return node;
+}
+
+static int route_trie_insert(struct net_route_entry *route)
+{
+	struct net_route_trie_node **link = &route_trie_root;
+	struct net_route_trie_node *parent = NULL;
+	struct net_route_trie_node *node;
+	uint8_t len = route->prefix_len;
+
+	while (*link != NULL) {
+		struct net_route_trie_node *cur = *link;
+		struct net_route_trie_node *split;
+		uint8_t common;
+
+		common = route_trie_common_len(&cur->prefix, &route->addr,
+					       MIN(cur->prefix_len, len));
+
+		if (common == cur->prefix_len) {
+			if (cur->prefix_len == len) {
+				node = cur;
+				goto add;
+			}
+
+			parent = cur;
+			link = &cur->child[route_trie_bit(&route->addr, cur->prefix_len)];
+			continue;
+		}
+
+		/* The current node does not cover the route prefix, insert
+		 * the route node above it, or a branch node leading to both.
+		 */
+		node = route_trie_node_alloc(&route->addr, len);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+
+		if (common == len) {
+			split = node;
+		} else {
+			split = route_trie_node_alloc(&route->addr, common);
+			if (split == NULL) {
+				node->in_use = false;
+				return -ENOMEM;
+			}
+
+			split->child[route_trie_bit(&route->addr, common)] = node;
+			node->parent = split;
+		}
+
+		split->child[route_trie_bit(&cur->prefix, common)] = cur;
+		split->parent = parent;
+		cur->parent = split;
+		*link = split;
+
+		goto add;
+	}
+
+	node = route_trie_node_alloc(&route->addr, len);
+	if (node == NULL) {
+		return -ENOMEM;
+	}
+
+	node->parent = parent;
+	*link = node;
+
+add:
+	sys_slist_append(&node->routes, &route->lpm_node);
+	route->lpm = node;
+
+	return 0;
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct net_route_trie_node *node = route->lpm;
+
+	if (node == NULL) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->routes, &route->lpm_node);
+	route->lpm = NULL;
+
+	/* Drop the nodes that are neither needed for a route nor to branch */
+	while (node != NULL && sys_slist_is_empty(&node->routes) &&
+	       (node->child[0] == NULL || node->child[1] == NULL)) {
+		struct net_route_trie_node *child = node->child[0] != NULL ?
+						    node->child[0] : node->child[1];
+		struct net_route_trie_node *parent = node->parent;
+
+		if (parent == NULL) {
+			route_trie_root = child;
+		} else {
+			parent->child[parent->child[1] == node] = child;
+		}
+
+		if (child != NULL) {
+			child->parent = parent;
+		}
+
+		node->in_use = false;
+
+		/* The parent only lost a child if there was nothing to
+		 * splice in place of the removed node.
+		 */
+		node = child == NULL ? parent : NULL;
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct net_route_entry *route, *found = NULL;
+	struct net_route_trie_node *node = route_trie_root;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr, node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, lpm_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[route_trie_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#else
+static inline int route_trie_insert(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+
+	return 0;
+}
+
+static inline void route_trie_remove(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +515,103 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Results of recent lookups, including failed ones. Entries point to live
+ * routes only as the cache is cleared on every route change.
+ */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+	bool valid;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static inline struct route_cache_entry *route_cache_slot(struct net_if *iface,
+							 struct in6_addr *dst)
+{
+	uint32_t hash = POINTER_TO_UINT(iface);
+
+	for (int i = 0; i < sizeof(dst->s6_addr); i++) {
+		hash = hash * 31U + dst->s6_addr[i];
+	}
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static bool route_cache_get(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry **route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	if (!entry->valid || entry->iface != iface ||
+	    !net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return false;
+	}
+
+	*route = entry->route;
+
+	return true;
+}
+
+static void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&entry->dst, dst);
+	entry->iface = iface;
+	entry->route = route;
+	entry->valid = true;
+}
+
+static void route_cache_clear(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(route_cache); i++) {
+		route_cache[i].valid = false;
+	}
+}
+#else
+static inline bool route_cache_get(struct net_if *iface, struct in6_addr *dst,
+				   struct net_route_entry **route)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(route);
+
+	return false;
+}
+
+static inline void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+				   struct net_route_entry *route)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(route);
+}
+
+static inline void route_cache_clear(void)
+{
+}
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	if (!route_cache_get(iface, dst, &found)) {
+		found = route_find(iface, dst);
+		route_cache_put(iface, dst, found);
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -442,6 +756,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (route_trie_insert(route) < 0) {
+		NET_ERR("No route trie node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
+	route_cache_clear();
+	net_route_flow_invalidate();
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -596,6 +921,10 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+	route_trie_remove(route);
+	route_cache_clear();
+	net_route_flow_invalidate();
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -1003,28 +1332,16 @@ exit:
 	return ret;
 }
 
-int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+/* Needs to be called with the neighbor lock held */
+static int route_packet_to_nbr(struct net_pkt *pkt, struct net_nbr *nbr)
 {
 	struct net_linkaddr_storage *lladdr;
-	struct net_nbr *nbr;
-	int err;
-
-	net_ipv6_nbr_lock();
-
-	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
-	if (!nbr) {
-		NET_DBG("Cannot find %s neighbor",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ENOENT;
-		goto error;
-	}
 
 	lladdr = net_nbr_get_lladdr(nbr->idx);
 	if (!lladdr) {
 		NET_DBG("Cannot find %s neighbor link layer address.",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ESRCH;
-		goto error;
+			net_sprint_ipv6_addr(&net_ipv6_nbr_data(nbr)->addr));
+		return -ESRCH;
 	}
 
 #if defined(CONFIG_NET_L2_DUMMY)
@@ -1040,8 +1357,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 #endif
 			if (!net_pkt_lladdr_src(pkt)->addr) {
 				NET_DBG("Link layer source address not set");
-				err = -EINVAL;
-				goto error;
+				return -EINVAL;
 			}
 
 			/* Sanitycheck: If src and dst ll addresses are going
@@ -1051,8 +1367,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 			if (!memcmp(net_pkt_lladdr_src(pkt)->addr, lladdr->addr,
 				    lladdr->len)) {
 				NET_ERR("Src ll and Dst ll are same");
-				err = -EINVAL;
-				goto error;
+				return -EINVAL;
 			}
 #if defined(CONFIG_NET_L2_PPP)
 		}
@@ -1076,6 +1391,29 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_pkt_set_iface(pkt, nbr->iface);
 
+	return 0;
+}
+
+int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+{
+	struct net_nbr *nbr;
+	int err;
+
+	net_ipv6_nbr_lock();
+
+	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
+	if (!nbr) {
+		NET_DBG("Cannot find %s neighbor",
+			net_sprint_ipv6_addr(nexthop));
+		err = -ENOENT;
+		goto error;
+	}
+
+	err = route_packet_to_nbr(pkt, nbr);
+	if (err < 0) {
+		goto error;
+	}
+
 	net_ipv6_nbr_unlock();
 	return net_send_data(pkt);
 
@@ -1084,6 +1422,92 @@ error:
 	return err;
 }
 
+#if CONFIG_NET_ROUTE_FLOW_CACHE_SIZE > 0
+/* Next hops of recently forwarded flows. An entry is only valid while its
+ * generation matches the current one, which changes with every routing
+ * decision input: routes, neighbors and routers.
+ */
+struct route_flow {
+	struct in6_addr src;
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_nbr *nbr;
+	atomic_val_t gen;
+};
+
+static struct route_flow route_flows[CONFIG_NET_ROUTE_FLOW_CACHE_SIZE];
+static atomic_t route_flow_gen = ATOMIC_INIT(1);
+
+static struct route_flow *route_flow_slot(struct net_if *iface,
+					  struct in6_addr *src,
+					  struct in6_addr *dst)
+{
+	uint32_t hash = POINTER_TO_UINT(iface);
+
+	for (int i = 0; i < sizeof(dst->s6_addr); i++) {
+		hash = hash * 31U + (dst->s6_addr[i] ^ src->s6_addr[i]);
+	}
+
+	return &route_flows[hash % CONFIG_NET_ROUTE_FLOW_CACHE_SIZE];
+}
+
+void net_route_flow_add(struct net_if *iface, struct in6_addr *src,
+			struct in6_addr *dst, struct in6_addr *nexthop)
+{
+	struct route_flow *flow;
+	struct net_nbr *nbr;
+
+	net_ipv6_nbr_lock();
+
+	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
+	if (nbr) {
+		flow = route_flow_slot(iface, src, dst);
+
+		net_ipaddr_copy(&flow->src, src);
+		net_ipaddr_copy(&flow->dst, dst);
+		flow->iface = iface;
+		flow->nbr = nbr;
+		flow->gen = atomic_get(&route_flow_gen);
+	}
+
+	net_ipv6_nbr_unlock();
+}
+
+bool net_route_flow_packet(struct net_pkt *pkt, struct in6_addr *src,
+			   struct in6_addr *dst, int *status)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct route_flow *flow;
+	int err;
+
+	net_ipv6_nbr_lock();
+
+	flow = route_flow_slot(iface, src, dst);
+	if (flow->gen != atomic_get(&route_flow_gen) || flow->iface != iface ||
+	    !flow->nbr->ref || !net_ipv6_addr_cmp(&flow->dst, dst) ||
+	    !net_ipv6_addr_cmp(&flow->src, src)) {
+		net_ipv6_nbr_unlock();
+		return false;
+	}
+
+	net_pkt_set_orig_iface(pkt, iface);
+	net_pkt_set_iface(pkt, flow->nbr->iface);
+
+	err = route_packet_to_nbr(pkt, flow->nbr);
+
+	net_ipv6_nbr_unlock();
+
+	*status = err < 0 ? err : net_send_data(pkt);
+
+	return true;
+}
+
+void net_route_flow_invalidate(void)
+{
+	atomic_inc(&route_flow_gen);
+}
+#endif /* CONFIG_NET_ROUTE_FLOW_CACHE_SIZE > 0 */
+
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface)
 {
 	/* The destination is reachable via iface. But since no valid nexthop
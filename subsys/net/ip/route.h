@@ -52,6 +52,14 @@ struct net_route_entry {
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	/** Node in the list of routes sharing a prefix trie node. */
+	sys_snode_t lpm_node;
+
+	/** Prefix trie node the route is stored in. */
+	struct net_route_trie_node *lpm;
+#endif
+
 	/** Network interface for the route. */
 	struct net_if *iface;
 
@@ -328,6 +336,64 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+#if defined(CONFIG_NET_ROUTE) && CONFIG_NET_ROUTE_FLOW_CACHE_SIZE > 0
+/**
+ * @brief Remember the next hop of a forwarded flow.
+ *
+ * @param iface Network interface the packets of the flow are received from.
+ * @param src Source IPv6 address of the flow.
+ * @param dst Destination IPv6 address of the flow.
+ * @param nexthop Next hop neighbor IPv6 address the flow is routed to.
+ */
+void net_route_flow_add(struct net_if *iface, struct in6_addr *src,
+			struct in6_addr *dst, struct in6_addr *nexthop);
+
+/**
+ * @brief Forward a packet to the cached next hop of its flow.
+ *
+ * @param pkt Network packet received from the interface of the flow.
+ * @param src Source IPv6 address of the packet.
+ * @param dst Destination IPv6 address of the packet.
+ * @param status Result of sending the packet if it was forwarded.
+ *
+ * @return True if the flow was cached and the packet handled, false if the
+ * packet needs to be routed normally.
+ */
+bool net_route_flow_packet(struct net_pkt *pkt, struct in6_addr *src,
+			   struct in6_addr *dst, int *status);
+
+/**
+ * @brief Forget all cached flows.
+ *
+ * To be called whenever a route, neighbor or router changes.
+ */
+void net_route_flow_invalidate(void);
+#else
+static inline void net_route_flow_add(struct net_if *iface, struct in6_addr *src,
+				      struct in6_addr *dst, struct in6_addr *nexthop)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(src);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(nexthop);
+}
+
+static inline bool net_route_flow_packet(struct net_pkt *pkt, struct in6_addr *src,
+					 struct in6_addr *dst, int *status)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(src);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(status);
+
+	return false;
+}
+
+static inline void net_route_flow_invalidate(void)
+{
+}
+#endif /* CONFIG_NET_ROUTE_FLOW_CACHE_SIZE > 0 */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
@@ -12,16 +12,19 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/iterable_sections.h>
 
 #if defined(CONFIG_NET_TCP_ISN_RFC6528)
 #include <psa/crypto.h>
 #endif
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
+#include <zephyr/net/ethernet.h>
 #include <zephyr/net/udp.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
+#include "pmtu.h"
 #include "net_stats.h"
 #include "net_private.h"
 #include "tcp_internal.h"
@@ -34,6 +37,8 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define ACK_DELAY K_MSEC(100)
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
+/* Worst case delay of the ACK of a single segment, RFC 8985 WCDelAckT */
+#define TLP_ACK_DELAY_MS 200
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
@@ -48,6 +53,16 @@ static int tcp_rx_window =
 	CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
+#if defined(CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE)
+static int tcp_rx_window_autotune_max =
+#if (CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE_MAX != 0)
+	CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE_MAX;
+#elif defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+	MIN(UINT16_MAX, (CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) * 2 / 3);
+#else
+	MIN(UINT16_MAX, CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE * 2 / 3);
+#endif
+#endif /* CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE */
 static int tcp_tx_window =
 #if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE != 0)
 	CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
@@ -64,6 +79,12 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
+#if defined(CONFIG_NET_TCP_SACK)
+#define tcp_sack_enabled(_conn) ((_conn)->sack_ok)
+#else
+#define tcp_sack_enabled(_conn) false
+#endif
+
 /* Define the number of MSS sections the congestion window is initialized at */
 #define TCP_CONGESTION_INITIAL_WIN 1
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
@@ -82,6 +103,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
 static void tcp_out(struct tcp *conn, uint8_t flags);
 static const char *tcp_state_to_str(enum tcp_state state, bool prefix);
+static uint16_t tcp_get_supported_mss(const struct tcp *conn, bool *pmtu_clamped);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -451,14 +473,6 @@ static void tcp_new_reno_log(struct tcp *conn, char *step)
 		conn->ca.pending_fast_retransmit_bytes);
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
-{
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
-}
-
 static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 {
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
@@ -513,32 +527,114 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+TCP_CA_DEFINE(tcp_ca_ops_new_reno, "reno", NULL, tcp_new_reno_fast_retransmit,
+	      tcp_new_reno_timeout, tcp_new_reno_dup_ack,
+	      tcp_new_reno_pkts_acked);
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strlen(ops->name) == len && strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static void tcp_ca_default_set(struct tcp *conn)
+{
+	conn->ca.ops = tcp_ca_find(CONFIG_NET_TCP_CA_DEFAULT,
+				   sizeof(CONFIG_NET_TCP_CA_DEFAULT) - 1);
+	if (conn->ca.ops == NULL) {
+		conn->ca.ops = &tcp_ca_ops_new_reno;
+	}
+}
+
+static void tcp_ca_ops_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca.ops = from->ca.ops;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+
+	if (conn->ca.ops->init) {
+		conn->ca.ops->init(conn);
+	}
+
+	NET_DBG("conn: %p, ca %s init, cwnd=%d, ssthres=%d", conn,
+		conn->ca.ops->name, conn->ca.cwnd, conn->ca.ssthresh);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL) {
+		return -EINVAL;
+	}
+
+	/* Accept both NUL terminated and plain strings */
+	len = strnlen(value, len);
+
+	ops = tcp_ca_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	conn->ca.ops = ops;
+
+	/* Keep the current window, only reset the algorithm state */
+	if (ops->init) {
+		ops->init(conn);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (len == NULL || *len < name_len) {
+		return -EINVAL;
+	}
+
+	memcpy(value, conn->ca.ops->name, name_len);
+	*len = name_len;
+
+	return 0;
 }
 #else
 
+static void tcp_ca_default_set(struct tcp *conn) { }
+
+static void tcp_ca_ops_copy(struct tcp *to, struct tcp *from) { }
+
 static void tcp_ca_init(struct tcp *conn) { }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn) { }
@@ -792,7 +888,11 @@ static void tcp_conn_release(struct k_work *work)
 	tcp_send_queue_flush(conn);
 
 	(void)k_work_cancel_delayable(&conn->send_data_timer);
+#if defined(CONFIG_NET_TCP_SACK)
+	(void)k_work_cancel_delayable(&conn->rack_timer);
+#endif
 	tcp_pkt_unref(conn->send_data);
+	tcp_zc_send_complete(conn, -ECONNRESET);
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
 		tcp_pkt_unref(conn->queue_recv_data);
@@ -1094,7 +1194,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1104,8 +1204,16 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS and window scale are only sent in SYN segments, SYN-less
+	 * segments carrying other options must not reset them.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+		recv_options->sack_permitted = false;
+#endif
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1154,6 +1262,36 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_permitted = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len == 2 ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				block->start = ntohl(UNALIGNED_GET(
+						(uint32_t *)(options + i)));
+				block->end = ntohl(UNALIGNED_GET(
+						(uint32_t *)(options + i + 4)));
+			}
+
+			break;
+#endif /* CONFIG_NET_TCP_SACK */
 		default:
 			continue;
 		}
@@ -1214,11 +1352,220 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	return 0;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Insert a segment into the out-of-order queue. The queue is kept sorted and
+ * without overlaps, but unlike without SACK it may have holes: each run of
+ * contiguous segments is an island reported to the peer in a SACK block.
+ */
+static bool tcp_sack_queue_insert(struct tcp *conn, struct net_buf *buf)
+{
+	struct net_buf **link = &conn->queue_recv_data->buffer;
+	uint32_t seq = tcp_get_seq(buf);
+	struct net_buf *cur;
+
+	/* Skip the segments ending before the new one */
+	while ((cur = *link) != NULL &&
+	       net_tcp_seq_cmp(tcp_get_seq(cur) + cur->len, seq) <= 0) {
+		link = &cur->frags;
+	}
+
+	/* Remove the head of the new segment already queued */
+	if (cur != NULL && net_tcp_seq_cmp(tcp_get_seq(cur), seq) <= 0) {
+		uint32_t overlap = tcp_get_seq(cur) + cur->len - seq;
+
+		if (overlap >= buf->len) {
+			return false;
+		}
+
+		net_buf_pull(buf, overlap);
+		seq += overlap;
+		tcp_set_seq(buf, seq);
+		link = &cur->frags;
+		cur = *link;
+	}
+
+	/* Drop the queued segments the new one covers */
+	while (cur != NULL &&
+	       net_tcp_seq_cmp(tcp_get_seq(cur) + cur->len, seq + buf->len) <= 0) {
+		*link = cur->frags;
+		cur->frags = NULL;
+		net_buf_unref(cur);
+		cur = *link;
+	}
+
+	/* Remove the tail of the new segment already queued */
+	if (cur != NULL &&
+	    net_tcp_seq_cmp(tcp_get_seq(cur), seq + buf->len) < 0) {
+		if (tcp_get_seq(cur) == seq) {
+			return false;
+		}
+
+		net_buf_remove_mem(buf, seq + buf->len - tcp_get_seq(cur));
+	}
+
+	buf->frags = cur;
+	*link = buf;
+
+	return true;
+}
+
+static void tcp_sack_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
+				     size_t len, uint32_t seq)
+{
+	struct net_buf *buf = pkt->buffer;
+	bool inserted = false;
+
+	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
+
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
+	conn->rx_sack_seq = seq;
+
+	while (buf) {
+		struct net_buf *next = buf->frags;
+
+		buf->frags = NULL;
+		tcp_set_seq(buf, seq);
+		seq += buf->len;
+
+		if (buf->len > 0 && tcp_sack_queue_insert(conn, buf)) {
+			inserted = true;
+		} else {
+			net_buf_unref(buf);
+		}
+
+		buf = next;
+	}
+
+	if (inserted &&
+	    !k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
+	}
+}
+
+/* Append the queued segments that became in order to pkt. Queued data the
+ * packet already carried is dropped, islands after a hole are kept.
+ */
+static size_t tcp_sack_pending_data(struct tcp *conn, struct net_pkt *pkt,
+				    size_t len)
+{
+	struct tcphdr *th;
+	uint32_t expected_seq;
+	size_t pending_len = 0;
+	struct net_buf *buf;
+
+	if (net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	th = th_get(pkt);
+	expected_seq = th_seq(th) + len;
+
+	while ((buf = conn->queue_recv_data->buffer) != NULL) {
+		uint32_t start = tcp_get_seq(buf);
+		uint32_t end = start + buf->len;
+
+		if (net_tcp_seq_cmp(start, expected_seq) > 0) {
+			break;
+		}
+
+		conn->queue_recv_data->buffer = buf->frags;
+		buf->frags = NULL;
+
+		if (net_tcp_seq_cmp(end, expected_seq) <= 0) {
+			net_buf_unref(buf);
+			continue;
+		}
+
+		net_buf_pull(buf, expected_seq - start);
+		net_buf_frag_add(pkt->buffer, buf);
+		pending_len += buf->len;
+		expected_seq = end;
+	}
+
+	if (pending_len > 0) {
+		NET_DBG("Found pending data seq %u len %zd",
+			expected_seq, pending_len);
+	}
+
+	if (net_pkt_is_empty(conn->queue_recv_data)) {
+		k_work_cancel_delayable(&conn->recv_queue_timer);
+	}
+
+	return pending_len;
+}
+
+/* Read the next island of the out-of-order queue starting at *buf */
+static bool tcp_sack_queue_island(struct net_buf **buf,
+				  struct tcp_sack_block *block)
+{
+	struct net_buf *cur = *buf;
+
+	if (cur == NULL) {
+		return false;
+	}
+
+	block->start = tcp_get_seq(cur);
+	block->end = block->start + cur->len;
+
+	for (cur = cur->frags; cur != NULL && tcp_get_seq(cur) == block->end;
+	     cur = cur->frags) {
+		block->end += cur->len;
+	}
+
+	*buf = cur;
+
+	return true;
+}
+
+/* Describe the out-of-order queue in SACK blocks, the block holding the most
+ * recently received segment first as required by RFC 2018.
+ */
+static int tcp_sack_blocks_get(struct tcp *conn, struct tcp_sack_block *blocks,
+			       int max_blocks)
+{
+	struct net_buf *buf = conn->queue_recv_data->buffer;
+	struct tcp_sack_block block;
+	bool found = false;
+	int cnt = 1;
+
+	if (!conn->sack_ok || max_blocks == 0) {
+		return 0;
+	}
+
+	while (tcp_sack_queue_island(&buf, &block)) {
+		if (!found &&
+		    net_tcp_seq_cmp(conn->rx_sack_seq, block.start) >= 0 &&
+		    net_tcp_seq_cmp(conn->rx_sack_seq, block.end) < 0) {
+			blocks[0] = block;
+			found = true;
+		} else if (cnt < max_blocks) {
+			blocks[cnt++] = block;
+		}
+	}
+
+	if (!found) {
+		memmove(&blocks[0], &blocks[1], (cnt - 1) * sizeof(blocks[0]));
+		cnt--;
+	}
+
+	return cnt;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 				     size_t len)
 {
 	size_t pending_len = 0;
 
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok) {
+		return tcp_sack_pending_data(conn, pkt, len);
+	}
+#endif
+
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
 	    !net_pkt_is_empty(conn->queue_recv_data)) {
 		/* Some potentential cases:
@@ -1328,7 +1675,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1342,11 +1689,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -1411,6 +1754,7 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
 	struct tcp_mss_option *mss;
+	bool pmtu_clamped = false;
 	uint32_t recv_mss;
 
 	mss = net_pkt_get_data(pkt, &mss_opt_access);
@@ -1418,7 +1762,11 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 		return -ENOBUFS;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
+	recv_mss = tcp_get_supported_mss(conn, &pmtu_clamped);
+	if (pmtu_clamped) {
+		net_stats_update_ipv6_pmtu_mss_clamped(net_pkt_iface(pkt));
+	}
+
 	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
 
 	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
@@ -1426,6 +1774,39 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static int net_tcp_set_sack_opts(struct tcp *conn, struct net_pkt *pkt,
+				 const struct tcp_sack_block *blocks, int cnt)
+{
+	int ret = 0;
+
+	if (conn->send_options.sack_permitted) {
+		ret = net_pkt_write_be32(pkt, (NET_TCP_NOP_OPT << 24) |
+					      (NET_TCP_NOP_OPT << 16) |
+					      (NET_TCP_SACK_PERM_OPT << 8) |
+					      NET_TCP_SACK_PERM_SIZE);
+	}
+
+	if (ret < 0 || cnt == 0) {
+		return ret;
+	}
+
+	ret = net_pkt_write_be32(pkt, (NET_TCP_NOP_OPT << 24) |
+				      (NET_TCP_NOP_OPT << 16) |
+				      (NET_TCP_SACK_OPT << 8) |
+				      (2 + cnt * NET_TCP_SACK_BLOCK_SIZE));
+
+	for (int i = 0; ret == 0 && i < cnt; i++) {
+		ret = net_pkt_write_be32(pkt, blocks[i].start);
+		if (ret == 0) {
+			ret = net_pkt_write_be32(pkt, blocks[i].end);
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1530,21 +1911,47 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	int sack_cnt = 0;
+#endif
+	size_t opts_len = 0;
 	struct net_pkt *pkt;
 	int ret = 0;
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += NET_TCP_MSS_SIZE;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_permitted) {
+		opts_len += 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if ((flags & (SYN | ACK)) == ACK) {
+		sack_cnt = tcp_sack_blocks_get(conn, sack, ARRAY_SIZE(sack));
+		if (sack_cnt > 0) {
+			opts_len += 2 * NET_TCP_NOP_SIZE + 2 +
+				    sack_cnt * NET_TCP_SACK_BLOCK_SIZE;
+		}
 	}
+#endif
 
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
 
 	if (data) {
+		/* Data larger than one segment is only ever sent to
+		 * interfaces that segment it further down the stack.
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_TSO) &&
+		    net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_tso_mss(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1556,7 +1963,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1570,6 +1977,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	ret = net_tcp_set_sack_opts(conn, pkt, sack, sack_cnt);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+#endif
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1721,13 +2136,42 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_TSO)
+static bool tcp_tso_enabled(struct tcp *conn)
+{
+	struct net_if *iface = conn->iface;
+
+	if (iface == NULL || net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return false;
+	}
+
+	/* Without hardware support, the Ethernet L2 cuts the segments */
+	return IS_ENABLED(CONFIG_NET_TCP_GSO) ||
+	       (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO);
+}
+
+/* Largest amount of data we send in one packet */
+static int tcp_send_seg_max(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+	if (!tcp_tso_enabled(conn)) {
+		return mss;
+	}
+
+	return MAX(mss, ROUND_DOWN(CONFIG_NET_TCP_TSO_MAX_SIZE, mss));
+}
+#else
+#define tcp_send_seg_max(_conn) conn_mss(_conn)
+#endif /* CONFIG_NET_TCP_TSO */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), tcp_send_seg_max(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1759,9 +2203,20 @@ static int tcp_send_data(struct tcp *conn)
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->rtt_pending = false;
+#endif
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
+#if defined(CONFIG_NET_TCP_SACK)
+			/* Time one segment per round trip */
+			if (!conn->rtt_pending) {
+				conn->rtt_pending = true;
+				conn->rtt_seq = conn->seq + conn->unacked_len;
+				conn->rtt_start = k_uptime_get_32();
+			}
+#endif
 		}
 	}
 
@@ -1777,6 +2232,340 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Send len bytes of already sent data starting at seq again */
+static int tcp_send_range(struct tcp *conn, uint32_t seq, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, seq - conn->seq, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, seq);
+	if (ret == 0) {
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
+	tcp_pkt_unref(pkt);
+
+	/* Karn's algorithm, the next ACK could be for either transmission */
+	conn->rtt_pending = false;
+
+	return ret;
+}
+
+/* Merge the SACK blocks of the received ACK into the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	struct tcp_sack_block *sacked = conn->sacked;
+	int cnt = 0;
+
+	/* Forget what the cumulative ACK covers */
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(sacked[i].end, conn->seq) <= 0) {
+			continue;
+		}
+
+		sacked[cnt] = sacked[i];
+		if (net_tcp_seq_cmp(sacked[cnt].start, conn->seq) < 0) {
+			sacked[cnt].start = conn->seq;
+		}
+
+		cnt++;
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block block = conn->recv_options.sack[i];
+		int first, last;
+
+		/* Ignore D-SACK blocks and blocks for data never sent */
+		if (net_tcp_seq_cmp(block.start, conn->seq) < 0 ||
+		    net_tcp_seq_cmp(block.end, block.start) <= 0 ||
+		    net_tcp_seq_cmp(block.end, snd_nxt) > 0) {
+			continue;
+		}
+
+		for (first = 0; first < cnt; first++) {
+			if (net_tcp_seq_cmp(sacked[first].end, block.start) >= 0) {
+				break;
+			}
+		}
+
+		/* Absorb the blocks overlapping or adjacent to the new one */
+		for (last = first; last < cnt; last++) {
+			if (net_tcp_seq_cmp(sacked[last].start, block.end) > 0) {
+				break;
+			}
+
+			if (net_tcp_seq_cmp(sacked[last].start, block.start) < 0) {
+				block.start = sacked[last].start;
+			}
+
+			if (net_tcp_seq_cmp(sacked[last].end, block.end) > 0) {
+				block.end = sacked[last].end;
+			}
+		}
+
+		if (first == last) {
+			if (cnt == ARRAY_SIZE(conn->sacked)) {
+				/* Keep the lowest blocks, the holes between
+				 * them are retransmitted first.
+				 */
+				if (first == cnt) {
+					continue;
+				}
+
+				cnt--;
+			}
+
+			memmove(&sacked[first + 1], &sacked[first],
+				(cnt - first) * sizeof(sacked[0]));
+			cnt++;
+		} else {
+			memmove(&sacked[first + 1], &sacked[last],
+				(cnt - last) * sizeof(sacked[0]));
+			cnt -= last - first - 1;
+		}
+
+		sacked[first] = block;
+	}
+
+	conn->sacked_cnt = cnt;
+}
+
+/* Retransmit up to max_segs segments the peer is missing, see RFC 6675.
+ * The holes below the highest SACKed byte are considered lost, after a
+ * retransmission timeout everything that was in flight is.
+ */
+static void tcp_sack_retransmit(struct tcp *conn, int max_segs)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	uint32_t lost_end;
+
+	if (conn->rto_recovery) {
+		lost_end = conn->recovery_point;
+	} else if (conn->sacked_cnt > 0) {
+		lost_end = conn->sacked[conn->sacked_cnt - 1].end;
+	} else {
+		/* Partial ACK without SACK information */
+		lost_end = conn->seq + conn_mss(conn);
+	}
+
+	if (net_tcp_seq_cmp(lost_end, snd_nxt) > 0) {
+		lost_end = snd_nxt;
+	}
+
+	while (max_segs-- > 0) {
+		uint32_t start = conn->rexmit_next;
+		uint32_t end = lost_end;
+		int len;
+
+		if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+			start = conn->seq;
+		}
+
+		for (int i = 0; i < conn->sacked_cnt; i++) {
+			if (net_tcp_seq_cmp(conn->sacked[i].end, start) <= 0) {
+				continue;
+			}
+
+			if (net_tcp_seq_cmp(conn->sacked[i].start, start) <= 0) {
+				start = conn->sacked[i].end;
+				continue;
+			}
+
+			if (net_tcp_seq_cmp(conn->sacked[i].start, end) < 0) {
+				end = conn->sacked[i].start;
+			}
+
+			break;
+		}
+
+		if (net_tcp_seq_cmp(start, end) >= 0) {
+			break;
+		}
+
+		len = MIN(end - start, conn_mss(conn));
+		if (tcp_send_range(conn, start, len) < 0) {
+			break;
+		}
+
+		conn->rexmit_next = start + len;
+	}
+}
+
+static void tcp_sack_recovery_enter(struct tcp *conn, bool rto)
+{
+	NET_DBG("conn: %p entering %s recovery, sacked blocks %d", conn,
+		rto ? "timeout" : "fast", conn->sacked_cnt);
+
+	if (rto) {
+		/* The peer may have discarded the data it SACKed, RFC 2018 */
+		conn->sacked_cnt = 0;
+	} else {
+		tcp_ca_fast_retransmit(conn);
+		if (tcp_window_full(conn)) {
+			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		}
+	}
+
+	conn->in_recovery = true;
+	conn->rto_recovery = rto;
+	conn->recovery_point = conn->seq + conn->unacked_len;
+	conn->rexmit_next = conn->seq;
+	(void)k_work_cancel_delayable(&conn->rack_timer);
+
+	tcp_sack_retransmit(conn, 1);
+}
+
+/* Arm the timer either for the reordering window after which the holes below
+ * SACKed data are deemed lost, or for a tail loss probe, see RFC 8985.
+ */
+static void tcp_rack_timer_arm(struct tcp *conn)
+{
+	uint32_t timeout;
+
+	if (!conn->sack_ok || conn->in_recovery || conn->unacked_len == 0 ||
+	    conn->srtt == 0) {
+		return;
+	}
+
+	if (conn->sacked_cnt > 0) {
+		/* Do not push back an already running reordering window */
+		(void)k_work_schedule_for_queue(&tcp_work_q, &conn->rack_timer,
+						K_MSEC(MAX(conn->srtt / 4, 1)));
+		return;
+	}
+
+	if (conn->tlp_sent) {
+		return;
+	}
+
+	timeout = 2 * conn->srtt;
+	if (conn->unacked_len <= conn_mss(conn)) {
+		timeout += TLP_ACK_DELAY_MS;
+	}
+
+	/* The retransmission timer fires first anyway */
+	if (timeout >= TCP_RTO_MS) {
+		(void)k_work_cancel_delayable(&conn->rack_timer);
+		return;
+	}
+
+	(void)k_work_reschedule_for_queue(&tcp_work_q, &conn->rack_timer,
+					  K_MSEC(timeout));
+}
+
+/* Make the peer acknowledge the end of the flight, so that a tail loss is
+ * repaired through SACK instead of a retransmission timeout. New data is
+ * sent if the windows allow it, the last segment sent otherwise.
+ */
+static void tcp_tlp_send(struct tcp *conn)
+{
+	int len;
+
+	NET_DBG("conn: %p tail loss probe", conn);
+
+	conn->tlp_sent = true;
+
+	if (tcp_unsent_len(conn) > 0 && tcp_send_data(conn) == 0) {
+		return;
+	}
+
+	len = MIN(conn->unacked_len, conn_mss(conn));
+	(void)tcp_send_range(conn, conn->seq + conn->unacked_len - len, len);
+}
+
+static void tcp_rack_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, rack_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED || conn->in_recovery ||
+	    conn->unacked_len == 0) {
+		goto out;
+	}
+
+	if (conn->sacked_cnt > 0) {
+		tcp_sack_recovery_enter(conn, false);
+	} else if (!conn->tlp_sent) {
+		tcp_tlp_send(conn);
+	}
+
+ out:
+	k_mutex_unlock(&conn->lock);
+}
+
+/* Account for a cumulative ACK acknowledging new data */
+static void tcp_sack_new_ack(struct tcp *conn)
+{
+	if (conn->rtt_pending && net_tcp_seq_cmp(conn->seq, conn->rtt_seq) >= 0) {
+		uint32_t rtt = MAX(k_uptime_get_32() - conn->rtt_start, 1U);
+
+		if (conn->srtt != 0) {
+			rtt = (7U * conn->srtt + rtt) / 8U;
+		}
+
+		conn->srtt = MIN(rtt, UINT16_MAX);
+		conn->rtt_pending = false;
+	}
+
+	conn->tlp_sent = false;
+}
+
+/* Process the SACK information of a received ACK */
+static void tcp_sack_process_ack(struct tcp *conn)
+{
+	uint32_t sacked_len = 0;
+
+	tcp_sack_update(conn);
+
+	if (conn->unacked_len == 0) {
+		conn->in_recovery = false;
+		conn->rto_recovery = false;
+		conn->sacked_cnt = 0;
+		(void)k_work_cancel_delayable(&conn->rack_timer);
+		return;
+	}
+
+	if (conn->in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, conn->recovery_point) < 0) {
+			tcp_sack_retransmit(conn, 2);
+			return;
+		}
+
+		NET_DBG("conn: %p recovery done", conn);
+		conn->in_recovery = false;
+		conn->rto_recovery = false;
+	}
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		sacked_len += conn->sacked[i].end - conn->sacked[i].start;
+	}
+
+	if (sacked_len >= DUPLICATE_ACK_RETRANSMIT_TRHESHOLD * conn_mss(conn)) {
+		tcp_sack_recovery_enter(conn, false);
+		return;
+	}
+
+	tcp_rack_timer_arm(conn);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1808,6 +2597,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	tcp_rack_timer_arm(conn);
+#endif
+
 	if (conn->send_data_total) {
 		subscribe = true;
 	}
@@ -1868,6 +2661,17 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Only retransmit what the peer is missing instead of going back to
+	 * the first unacknowledged byte.
+	 */
+	if (conn->sack_ok && conn->unacked_len > 0) {
+		tcp_sack_recovery_enter(conn, true);
+		conn->send_data_retries++;
+		goto rearm;
+	}
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1902,6 +2706,9 @@ static void tcp_resend_data(struct k_work *work)
 		NET_ERR("TCP failed to allocate buffer in retransmission");
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+ rearm:
+#endif
 	exp_tcp_rto = TCP_RTO_MS;
 	/* The last retransmit does not need to wait that long */
 	if (conn->send_data_retries < tcp_retries) {
@@ -2140,8 +2947,12 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#if defined(CONFIG_NET_TCP_SACK)
+	k_work_init_delayable(&conn->rack_timer, tcp_rack_timeout);
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
+	tcp_ca_default_set(conn);
 
 	tcp_conn_ref(conn);
 
@@ -2561,6 +3372,13 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 	bool inserted = false;
 	struct net_buf *tmp;
 
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok) {
+		tcp_sack_queue_recv_data(conn, pkt, len, seq);
+		return;
+	}
+#endif
+
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
 	tmp = pkt->buffer;
@@ -2690,6 +3508,59 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE)
+static void tcp_recv_autotune_start(struct tcp *conn)
+{
+	conn->rcv_space_seq = conn->ack;
+	conn->rcv_space_time = k_uptime_get_32();
+}
+
+/* Called when the handshake completes, the measurement was started when
+ * our SYN or SYN-ACK was sent.
+ */
+static void tcp_recv_autotune_init(struct tcp *conn)
+{
+	conn->rcv_rtt = MAX(1, MIN(UINT16_MAX,
+				   k_uptime_get_32() - conn->rcv_space_time));
+	tcp_recv_autotune_start(conn);
+}
+
+/* Dynamic right-sizing of the receive window: once per round trip,
+ * compare the data received during it with the window. A sender
+ * limited by the window delivers about one window per round trip, give
+ * it twice that so that it can grow its congestion window.
+ */
+static void tcp_recv_autotune(struct tcp *conn)
+{
+	uint32_t received;
+	int32_t target;
+
+	if (conn->rcvbuf_locked ||
+	    k_uptime_get_32() - conn->rcv_space_time < conn->rcv_rtt) {
+		return;
+	}
+
+	received = conn->ack - conn->rcv_space_seq;
+	target = MIN(2 * received, tcp_rx_window_autotune_max);
+
+	if (target > conn->recv_win_max) {
+		int32_t delta = target - conn->recv_win_max;
+
+		NET_DBG("conn: %p recv_win_max %u -> %d", conn,
+			conn->recv_win_max, target);
+
+		conn->recv_win_max = target;
+		tcp_update_recv_wnd(conn, delta);
+	}
+
+	tcp_recv_autotune_start(conn);
+}
+#else
+#define tcp_recv_autotune_start(...)
+#define tcp_recv_autotune_init(...)
+#define tcp_recv_autotune(...)
+#endif /* CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE */
+
 static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 					  size_t *len)
 {
@@ -2703,6 +3574,7 @@ static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 
 	net_stats_update_tcp_seg_recv(conn->iface);
 	conn_ack(conn, *len);
+	tcp_recv_autotune(conn);
 
 	/* Delay ACK response in case of small window or missing PSH,
 	 * as described in RFC 813.
@@ -2773,6 +3645,10 @@ static void tcp_check_sock_options(struct tcp *conn)
 		diff = rcvbuf_opt - conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
+#if defined(CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE)
+		/* The application sized the window, do not tune it */
+		conn->rcvbuf_locked = true;
+#endif
 
 		k_mutex_unlock(&conn->lock);
 	}
@@ -2849,8 +3725,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->recv_options.sack_cnt = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  (fl & SYN) != 0)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2908,9 +3789,17 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = conn->recv_options.sack_permitted;
+			conn->send_options.sack_permitted = conn->sack_ok;
+#endif
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
+			tcp_recv_autotune_start(conn);
 			conn->send_options.mss_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->send_options.sack_permitted = false;
+#endif
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2922,8 +3811,15 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->send_options.sack_permitted = true;
+#endif
 			tcp_out(conn, SYN);
+			tcp_recv_autotune_start(conn);
 			conn->send_options.mss_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->send_options.sack_permitted = false;
+#endif
 			conn_seq(conn, + 1);
 			next = TCP_SYN_SENT;
 			tcp_conn_ref(conn);
@@ -2939,6 +3835,7 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_ops_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3001,6 +3898,7 @@ next_state:
 			next = TCP_ESTABLISHED;
 
 			tcp_ca_init(conn);
+			tcp_recv_autotune_init(conn);
 
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3029,6 +3927,9 @@ next_state:
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = conn->recv_options.sack_permitted;
+#endif
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
 				if (verdict == NET_OK) {
@@ -3045,6 +3946,7 @@ next_state:
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 			tcp_ca_init(conn);
+			tcp_recv_autotune_init(conn);
 			tcp_out(conn, ACK);
 			keep_alive_timer_restart(conn);
 
@@ -3128,8 +4030,11 @@ next_state:
 				conn->dup_ack_cnt = 0;
 			}
 
-			/* Only do fast retransmit when not already in a resend state */
+			/* Only do fast retransmit when not already in a resend state,
+			 * with SACK the recovery retransmits the holes instead.
+			 */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			    !tcp_sack_enabled(conn) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
 				int temp_unacked_len = conn->unacked_len;
@@ -3190,6 +4095,12 @@ next_state:
 
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
+			tcp_zc_send_complete(conn, 0);
+#if defined(CONFIG_NET_TCP_SACK)
+			if (conn->sack_ok) {
+				tcp_sack_new_ack(conn);
+			}
+#endif
 
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
@@ -3240,6 +4151,12 @@ next_state:
 			}
 		}
 
+#if defined(CONFIG_NET_TCP_SACK)
+		if (th && conn->sack_ok) {
+			tcp_sack_process_ack(conn);
+		}
+#endif
+
 		if (th) {
 			if (th_seq(th) == conn->ack) {
 				if (len > 0) {
@@ -3774,6 +4691,89 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY_SEND)
+/* Report the caller buffers the peer has acknowledged, or all of them
+ * with a negative status when the connection goes away.
+ */
+static void tcp_zc_send_complete(struct tcp *conn, int status)
+{
+	while (conn->zc_send_cnt > 0) {
+		struct tcp_zc_send *zc = &conn->zc_send[conn->zc_send_head];
+
+		if (status == 0 && net_tcp_seq_cmp(conn->seq, zc->end_seq) < 0) {
+			break;
+		}
+
+		conn->zc_send_head = (conn->zc_send_head + 1) %
+				     ARRAY_SIZE(conn->zc_send);
+		conn->zc_send_cnt--;
+
+		if (zc->cb) {
+			zc->cb(conn->context, status < 0 ? status : zc->len,
+			       zc->user_data);
+		}
+	}
+}
+
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf,
+		      net_context_send_cb_t cb, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	size_t len = net_buf_frags_len(buf);
+	struct tcp_zc_send *zc;
+	int ret = 0;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
+	}
+
+	if (len == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	/* The whole chain is queued even if it exceeds the window, the
+	 * surplus is sent once the peer has acknowledged enough data.
+	 */
+	if (tcp_window_full(conn) ||
+	    conn->zc_send_cnt == ARRAY_SIZE(conn->zc_send)) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	zc = &conn->zc_send[(conn->zc_send_head + conn->zc_send_cnt) %
+			    ARRAY_SIZE(conn->zc_send)];
+	zc->cb = cb;
+	zc->user_data = user_data;
+	zc->len = len;
+	zc->end_seq = conn->seq + conn->send_data_total + len;
+	conn->zc_send_cnt++;
+
+	net_pkt_append_buffer(conn->send_data, buf);
+	conn->send_data_total += len;
+
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		/* The buffer is owned by the send queue already, the
+		 * callback reports the failure when the connection is
+		 * released.
+		 */
+		tcp_conn_close(conn, ret);
+	} else if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	ret = 0;
+out:
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+#else
+#define tcp_zc_send_complete(...)
+#endif /* CONFIG_NET_TCP_ZEROCOPY_SEND */
+
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
@@ -4064,9 +5064,11 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 {
 	struct net_tcp_hdr *tcp_hdr;
 
+	/* Segments merged by GRO have been verified one by one already */
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
+	    !(IS_ENABLED(CONFIG_NET_GRO) && net_pkt_is_chksum_done(pkt)) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -4349,7 +5351,7 @@ void net_tcp_foreach(net_tcp_cb_t cb, void *user_data)
 	k_mutex_unlock(&tcp_lock);
 }
 
-uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
+static uint16_t tcp_get_supported_mss(const struct tcp *conn, bool *pmtu_clamped)
 {
 	sa_family_t family = net_context_get_family(conn->context);
 
@@ -4390,6 +5392,21 @@ uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
 			mss = NET_IPV6_MTU - NET_IPV6TCPH_LEN;
 		}
 
+		/* Avoid fragmentation if the path towards the peer is known
+		 * to have a smaller MTU than the interface.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV6_PMTU)) {
+			int pmtu = net_pmtu_ipv6_get_mtu(&conn->dst.sin6.sin6_addr);
+
+			if (pmtu > NET_IPV6TCPH_LEN && pmtu - NET_IPV6TCPH_LEN < mss) {
+				mss = pmtu - NET_IPV6TCPH_LEN;
+
+				if (pmtu_clamped) {
+					*pmtu_clamped = true;
+				}
+			}
+		}
+
 		return mss;
 	}
 #endif /* CONFIG_NET_IPV6 */
@@ -4397,6 +5414,11 @@ uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
 	return 0;
 }
 
+uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
+{
+	return tcp_get_supported_mss(conn, NULL);
+}
+
 int net_tcp_set_option(struct net_context *context,
 		       enum tcp_conn_option option,
 		       const void *value, size_t len)
@@ -4427,6 +5449,11 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
+#endif
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4464,6 +5491,11 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
+#endif
 	}
 
 	k_mutex_unlock(&conn->lock);
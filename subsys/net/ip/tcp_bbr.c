@@ -0,0 +1,201 @@
+/** @file
+ * @brief Lightweight BBR congestion control for TCP
+ *
+ * The window follows the bottleneck bandwidth and minimum round trip time
+ * measured once per round trip. As the stack does not pace its packets, the
+ * BBR pacing gains are applied to the congestion window instead.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#include "tcp_internal.h"
+
+enum tcp_bbr_mode {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+/* Gains in 1/256 units */
+#define BBR_UNIT 256
+#define BBR_STARTUP_GAIN 739 /* 2 / ln(2) */
+#define BBR_FULL_BW_THRESH 320 /* 1.25 */
+#define BBR_FULL_BW_ROUNDS 3
+#define BBR_MAX_BW_ROUNDS 10
+#define BBR_MIN_RTT_WIN_MS 10000
+#define BBR_MIN_CWND_SEGS 4
+
+static const uint16_t probe_bw_gains[] = {
+	320, 192, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT,
+};
+
+static void tcp_bbr_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, mode=%d, bw=%u, min_rtt=%u",
+		conn, step, conn->ca.cwnd, conn->ca.bbr.mode,
+		conn->ca.bbr.max_bw, conn->ca.bbr.min_rtt);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = BBR_STARTUP;
+	bbr->min_rtt = UINT32_MAX;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_bbr_log(conn, "init");
+}
+
+/* BBR does not take losses as a congestion signal */
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	tcp_bbr_log(conn, "fast_retransmit");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	/* Restart from one segment, the window is restored as data is
+	 * acknowledged again.
+	 */
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_bbr_log(conn, "timeout");
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static uint32_t tcp_bbr_bdp(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	if (bbr->max_bw == 0 || bbr->min_rtt == UINT32_MAX) {
+		return 0;
+	}
+
+	return ((uint64_t)bbr->max_bw * bbr->min_rtt) / MSEC_PER_SEC;
+}
+
+static void tcp_bbr_round_end(struct tcp *conn, uint32_t now, uint32_t inflight)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t rtt = now - bbr->round_start;
+	uint32_t bw;
+
+	/* While the window does not exceed the path capacity, a round lasts
+	 * one round trip time.
+	 */
+	if (bbr->round_start != 0 && rtt > 0) {
+		bw = ((uint64_t)(bbr->delivered - bbr->round_delivered) *
+		      MSEC_PER_SEC) / rtt;
+
+		if (bw >= bbr->max_bw || ++bbr->max_bw_age >= BBR_MAX_BW_ROUNDS) {
+			bbr->max_bw = bw;
+			bbr->max_bw_age = 0;
+		}
+
+		if (rtt <= bbr->min_rtt) {
+			bbr->min_rtt = rtt;
+			bbr->min_rtt_stamp = now;
+		}
+	}
+
+	bbr->round_start = now;
+	bbr->round_delivered = bbr->delivered;
+	bbr->next_round_delivered = bbr->delivered + MAX(inflight, 1U);
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		if (bbr->max_bw >= ((uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH) /
+				   BBR_UNIT) {
+			bbr->full_bw = bbr->max_bw;
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+			bbr->mode = BBR_DRAIN;
+		}
+		break;
+	case BBR_DRAIN:
+		if (inflight <= tcp_bbr_bdp(conn)) {
+			bbr->mode = BBR_PROBE_BW;
+			bbr->cycle_idx = 0;
+		}
+		break;
+	case BBR_PROBE_BW:
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(probe_bw_gains);
+		break;
+	case BBR_PROBE_RTT:
+		/* The round at a small window has refreshed min_rtt */
+		bbr->min_rtt_stamp = now;
+		bbr->mode = BBR_PROBE_BW;
+		break;
+	}
+
+	if (bbr->mode != BBR_STARTUP && bbr->mode != BBR_PROBE_RTT &&
+	    now - bbr->min_rtt_stamp > BBR_MIN_RTT_WIN_MS) {
+		bbr->mode = BBR_PROBE_RTT;
+		bbr->min_rtt = UINT32_MAX;
+	}
+
+	tcp_bbr_log(conn, "round");
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t min_cwnd = conn_mss(conn) * BBR_MIN_CWND_SEGS;
+	uint32_t inflight = conn->unacked_len > acked_len ?
+			    conn->unacked_len - acked_len : 0;
+	uint32_t now = MAX(k_uptime_get_32(), 1U);
+	uint32_t bdp, gain, target, cwnd;
+
+	bbr->delivered += acked_len;
+	if ((int32_t)(bbr->delivered - bbr->next_round_delivered) >= 0) {
+		tcp_bbr_round_end(conn, now, inflight);
+	}
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		gain = BBR_STARTUP_GAIN;
+		break;
+	case BBR_PROBE_BW:
+		gain = probe_bw_gains[bbr->cycle_idx];
+		break;
+	default:
+		gain = BBR_UNIT;
+		break;
+	}
+
+	bdp = tcp_bbr_bdp(conn);
+	target = MAX(((uint64_t)bdp * gain) / BBR_UNIT, min_cwnd);
+	cwnd = conn->ca.cwnd;
+
+	if (bbr->mode == BBR_PROBE_RTT) {
+		cwnd = min_cwnd;
+	} else if (bdp == 0 || cwnd < target) {
+		/* Grow like slow start until the estimated target */
+		cwnd += acked_len;
+		if (bdp != 0) {
+			cwnd = MIN(cwnd, target);
+		}
+	} else {
+		cwnd = target;
+	}
+
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+}
+
+TCP_CA_DEFINE(tcp_ca_ops_bbr, "bbr", tcp_bbr_init, tcp_bbr_fast_retransmit,
+	      tcp_bbr_timeout, tcp_bbr_dup_ack, tcp_bbr_pkts_acked);
@@ -0,0 +1,184 @@
+/** @file
+ * @brief CUBIC congestion control for TCP, see RFC 9438
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor, 0.7 in 1/1024 units */
+#define CUBIC_BETA 717
+/* Window reduction with fast convergence, (1 + beta) / 2 in 1/1024 units */
+#define CUBIC_BETA_FAST_CONV 870
+/* New Reno friendly additive increase, 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA 542
+/* K^3 in ms^3 per byte of window reduction is 1e9 / (C * mss), C = 0.4 */
+#define CUBIC_K_FACTOR 2500000000ULL
+/* Limit of |t - K| so that the cube does not overflow */
+#define CUBIC_MAX_DELTA_MS 100000
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, w_max=%d, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static uint32_t tcp_cubic_cbrt(uint64_t value)
+{
+	uint32_t low = 0;
+	uint32_t high = 2097152; /* cbrt(2^63) */
+
+	while (low < high) {
+		uint32_t mid = low + (high - low + 1) / 2;
+
+		if ((uint64_t)mid * mid * mid <= value) {
+			low = mid;
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	return low;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	tcp_cubic_log(conn, "init");
+}
+
+static void tcp_cubic_congestion(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+
+	cubic->epoch_start = 0;
+
+	/* Release bandwidth to new flows when the window keeps shrinking */
+	if (conn->ca.cwnd < cubic->w_last_max) {
+		cubic->w_max = (conn->ca.cwnd * CUBIC_BETA_FAST_CONV) / 1024;
+	} else {
+		cubic->w_max = conn->ca.cwnd;
+	}
+
+	cubic->w_last_max = conn->ca.cwnd;
+	conn->ca.ssthresh = MAX((conn->ca.cwnd * CUBIC_BETA) / 1024,
+				conn_mss(conn) * 2);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_congestion(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = MIN(conn_mss(conn) * 3 + conn->ca.ssthresh,
+				    UINT16_MAX);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_congestion(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), UINT16_MAX);
+}
+
+static void tcp_cubic_epoch_start(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+
+	cubic->epoch_start = now;
+
+	if (conn->ca.cwnd < cubic->w_max) {
+		cubic->k = tcp_cubic_cbrt((cubic->w_max - conn->ca.cwnd) *
+					  CUBIC_K_FACTOR / conn_mss(conn));
+	} else {
+		cubic->k = 0;
+		cubic->w_max = conn->ca.cwnd;
+	}
+
+	cubic->w_est = conn->ca.cwnd;
+	cubic->acked = 0;
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	int32_t mss = conn_mss(conn);
+	uint32_t now;
+	int64_t delta;
+	int64_t target;
+	int32_t new_win;
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= acked_len;
+		}
+
+		return;
+	}
+
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		new_win = conn->ca.cwnd + MIN(acked_len, mss);
+		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		return;
+	}
+
+	/* 0 tells there is no epoch */
+	now = MAX(k_uptime_get_32(), 1U);
+	if (cubic->epoch_start == 0) {
+		tcp_cubic_epoch_start(conn, now);
+	}
+
+	delta = (int64_t)(now - cubic->epoch_start) - cubic->k;
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	target = cubic->w_max +
+		 (delta * delta * delta * mss) / (int64_t)CUBIC_K_FACTOR;
+	target = CLAMP(target, conn->ca.cwnd,
+		       MIN(conn->ca.cwnd + conn->ca.cwnd / 2, UINT16_MAX));
+
+	/* Grow at least as fast as New Reno would */
+	cubic->acked += acked_len;
+	if (cubic->acked >= conn->ca.cwnd) {
+		cubic->acked -= conn->ca.cwnd;
+		cubic->w_est = MIN(cubic->w_est + (mss * CUBIC_ALPHA) / 1024,
+				   UINT16_MAX);
+	}
+
+	if (cubic->w_est > target) {
+		new_win = cubic->w_est;
+	} else {
+		/* Implement a div_ceil to avoid rounding to 0 */
+		new_win = conn->ca.cwnd +
+			  ((target - conn->ca.cwnd) * MIN(acked_len, mss) +
+			   conn->ca.cwnd - 1) / conn->ca.cwnd;
+	}
+
+	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+TCP_CA_DEFINE(tcp_ca_ops_cubic, "cubic", tcp_cubic_init, tcp_cubic_fast_retransmit,
+	      tcp_cubic_timeout, tcp_cubic_dup_ack, tcp_cubic_pkts_acked);
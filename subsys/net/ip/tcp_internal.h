@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -312,6 +313,33 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Enqueue network buffers for transmission without copying them
+ *
+ * @param context	Network context
+ * @param buf		Buffer chain, the reference is passed to the stack
+ * @param cb		Called once the peer has acknowledged the data
+ * @param user_data	User data passed to the callback
+ *
+ * @return 0 if ok, < 0 if error
+ */
+#if defined(CONFIG_NET_TCP_ZEROCOPY_SEND)
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf,
+		      net_context_send_cb_t cb, void *user_data);
+#else
+static inline int net_tcp_queue_buf(struct net_context *context,
+				    struct net_buf *buf,
+				    net_context_send_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
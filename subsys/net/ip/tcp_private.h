@@ -227,32 +227,120 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Number of SACK blocks fitting in the option space, RFC 2018 */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
+/* Caller buffers queued with net_tcp_queue_buf(), waiting for their ACK */
+struct tcp_zc_send {
+	net_context_send_cb_t cb;
+	void *user_data;
+	uint32_t end_seq;
+	uint32_t len;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_cnt;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_permitted : 1;
+#endif
 };
 
+struct tcp;
+typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
+/* Congestion control algorithm, registered with TCP_CA_DEFINE() */
+struct tcp_ca_ops {
+	const char *name;
+	/* Reset the algorithm state, the window is already initialized */
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#define TCP_CA_DEFINE(_name, _str, _init, _fast_retransmit, _timeout,	\
+		      _dup_ack, _pkts_acked)				\
+	const STRUCT_SECTION_ITERABLE(tcp_ca_ops, _name) = {		\
+		.name = _str,						\
+		.init = _init,						\
+		.fast_retransmit = _fast_retransmit,			\
+		.timeout = _timeout,					\
+		.dup_ack = _dup_ack,					\
+		.pkts_acked = _pkts_acked,				\
+	}
+
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+struct tcp_ca_cubic {
+	uint32_t epoch_start; /* ms, 0 outside of a congestion avoidance epoch */
+	uint32_t k;           /* ms until the window is back to w_max */
+	uint16_t w_max;
+	uint16_t w_last_max;
+	uint16_t w_est;       /* window New Reno would have */
+	uint32_t acked;       /* bytes acked not yet accounted in w_est */
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CA_BBR)
+struct tcp_ca_bbr {
+	uint32_t max_bw;      /* bytes per second */
+	uint32_t full_bw;
+	uint32_t min_rtt;     /* ms */
+	uint32_t min_rtt_stamp;
+	uint32_t round_start;
+	uint32_t delivered;
+	uint32_t round_delivered;
+	uint32_t next_round_delivered;
+	uint8_t max_bw_age;   /* rounds since max_bw was measured */
+	uint8_t full_bw_cnt;
+	uint8_t cycle_idx;
+	uint8_t mode;
+};
+#endif
+
+struct tcp_ca {
+	const struct tcp_ca_ops *ops;
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+#if defined(CONFIG_NET_TCP_CA_CUBIC) || defined(CONFIG_NET_TCP_CA_BBR)
+	union {
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CA_BBR)
+		struct tcp_ca_bbr bbr;
+#endif
+	};
+#endif
 };
 #endif
 
-struct tcp;
-typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
-
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -285,6 +373,10 @@ struct tcp { /* TCP connection */
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Reordering window and tail loss probe timer */
+	struct k_work_delayable rack_timer;
+#endif /* CONFIG_NET_TCP_SACK */
 	struct k_work conn_release;
 
 	union {
@@ -322,7 +414,28 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_ca ca;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Sent data the peer has selectively acknowledged, sorted */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+	uint32_t recovery_point; /* snd_nxt when the recovery started */
+	uint32_t rexmit_next;    /* next sequence to retransmit */
+	uint32_t rx_sack_seq;    /* last out-of-order segment received */
+	uint32_t rtt_seq;        /* end of the segment being timed */
+	uint32_t rtt_start;
+	uint16_t srtt;           /* smoothed round trip time in ms */
+	uint8_t sacked_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_ZEROCOPY_SEND)
+	struct tcp_zc_send zc_send[CONFIG_NET_TCP_ZEROCOPY_SEND_MAX];
+	uint8_t zc_send_head;
+	uint8_t zc_send_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE)
+	uint32_t rcv_space_seq;  /* conn->ack when the measurement started */
+	uint32_t rcv_space_time; /* start of the measurement in ms */
+	uint16_t rcv_rtt;        /* handshake round trip time in ms */
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -337,6 +450,16 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+	bool in_recovery : 1;
+	bool rto_recovery : 1;
+	bool rtt_pending : 1;
+	bool tlp_sent : 1;
+#endif
+#if defined(CONFIG_NET_TCP_RECV_WINDOW_AUTOTUNE)
+	bool rcvbuf_locked : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -539,7 +539,18 @@ static uint16_t offset_based_swap8(const uint8_t *data)
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ * On 64-bit targets whole 64-bit words are added, the carry out of each addition is added
+ * back in (end-around carry) and the sum is folded to 32 bits before the tail is processed.
  */
+#if defined(CONFIG_64BIT)
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t word)
+{
+	sum += word;
+
+	return sum + (sum < word);
+}
+#endif
+
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
@@ -568,6 +579,34 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+#if defined(CONFIG_64BIT)
+	if ((((uintptr_t)data & 0x04) != 0) && (pending >= sizeof(uint32_t))) {
+		pending -= sizeof(uint32_t);
+		sum = sum + *((uint32_t *)data);
+		data += sizeof(uint32_t);
+	}
+
+	if (pending >= sizeof(uint64_t) * 4) {
+		const uint64_t *q = (const uint64_t *)data;
+
+		do {
+			sum = chksum_add64(sum, q[0]);
+			sum = chksum_add64(sum, q[1]);
+			sum = chksum_add64(sum, q[2]);
+			sum = chksum_add64(sum, q[3]);
+			q += 4;
+			pending -= sizeof(uint64_t) * 4;
+		} while (pending >= sizeof(uint64_t) * 4);
+
+		data = (uint8_t *)q;
+
+		/* Leave room for the 32-bit additions below */
+		sum = (sum & 0xffffffff) + (sum >> 32);
+		sum = (sum & 0xffffffff) + (sum >> 32);
+	}
+#endif
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -4,6 +4,7 @@
 
 /*
  * Copyright (c) 2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -31,6 +32,11 @@ static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
 static sys_slist_t arp_table;
 
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+/* Entries of arp_table hashed by IPv4 address */
+static sys_slist_t arp_hash[CONFIG_NET_ARP_TABLE_HASH_BUCKETS];
+#endif
+
 static struct k_work_delayable arp_request_timer;
 
 static struct k_mutex arp_mutex;
@@ -88,6 +94,58 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+static sys_slist_t *arp_hash_bucket(struct in_addr *addr)
+{
+	uint32_t key = addr->s_addr;
+
+	/* Mix all the octets, hosts of a subnet differ in the last ones */
+	key ^= key >> 16;
+	key ^= key >> 8;
+
+	return &arp_hash[(key & 0xff) % CONFIG_NET_ARP_TABLE_HASH_BUCKETS];
+}
+#endif
+
+/* Find a resolved entry */
+static struct arp_entry *arp_entry_find_resolved(struct net_if *iface,
+						 struct in_addr *dst)
+{
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+	struct arp_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_hash_bucket(dst), entry, hash_node) {
+		if (entry->iface == iface &&
+		    net_ipv4_addr_cmp(&entry->ip, dst)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+#else
+	return arp_entry_find(&arp_table, iface, dst, NULL);
+#endif
+}
+
+static void arp_table_insert(struct arp_entry *entry)
+{
+	sys_slist_prepend(&arp_table, &entry->node);
+
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+	sys_slist_prepend(arp_hash_bucket(&entry->ip), &entry->hash_node);
+#endif
+}
+
+static void arp_table_remove(struct arp_entry *entry, sys_snode_t *prev)
+{
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+	/* Before the cleanup of the entry clears its address */
+	sys_slist_find_and_remove(arp_hash_bucket(&entry->ip), &entry->hash_node);
+#endif
+
+	sys_slist_remove(&arp_table, prev, &entry->node);
+}
+
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
@@ -96,6 +154,11 @@ static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
+	if (CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0) {
+		/* Reordering would need walking the table again */
+		return arp_entry_find_resolved(iface, dst);
+	}
+
 	entry = arp_entry_find(&arp_table, iface, dst, &prev);
 	if (entry) {
 		/* Let's assume the target is going to be accessed
@@ -159,6 +222,7 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
+	struct arp_entry *entry;
 	sys_snode_t *node;
 
 	/* We assume last entry is the oldest one,
@@ -170,9 +234,14 @@ static struct arp_entry *arp_entry_get_last_from_table(void)
 		return NULL;
 	}
 
+	entry = CONTAINER_OF(node, struct arp_entry, node);
+
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+	sys_slist_find_and_remove(arp_hash_bucket(&entry->ip), &entry->hash_node);
+#endif
 	sys_slist_find_and_remove(&arp_table, node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return entry;
 }
 
 
@@ -461,10 +530,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find_resolved(iface, src);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			net_sprint_ll_addr((const uint8_t *)&entry->eth,
@@ -632,10 +700,9 @@ void net_arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *arp_ent;
 
-			arp_ent = arp_entry_find(&arp_table, iface, src, &prev);
+			arp_ent = arp_entry_find_resolved(iface, src);
 			if (arp_ent) {
 				memcpy(&arp_ent->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -654,7 +721,7 @@ void net_arp_update(struct net_if *iface,
 					arp_ent->iface = iface;
 					net_ipaddr_copy(&arp_ent->ip, src);
 					memcpy(&arp_ent->eth, hwaddr, sizeof(arp_ent->eth));
-					sys_slist_prepend(&arp_table, &arp_ent->node);
+					arp_table_insert(arp_ent);
 				}
 			}
 		}
@@ -667,7 +734,7 @@ void net_arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_table_insert(entry);
 
 	while (!k_fifo_is_empty(&entry->pending_queue)) {
 		int ret;
@@ -900,9 +967,8 @@ void net_arp_clear_cache(struct net_if *iface)
 			continue;
 		}
 
+		arp_table_remove(entry, prev);
 		arp_entry_cleanup(entry, false);
-
-		sys_slist_remove(&arp_table, prev, &entry->node);
 		sys_slist_prepend(&arp_free_entries, &entry->node);
 	}
 
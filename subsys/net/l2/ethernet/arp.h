@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -54,6 +55,9 @@ int net_arp_clear_pending(struct net_if *iface,
 
 struct arp_entry {
 	sys_snode_t node;
+#if CONFIG_NET_ARP_TABLE_HASH_BUCKETS > 0
+	sys_snode_t hash_node;
+#endif
 	uint32_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
@@ -1,9 +1,12 @@
 /*
  * Copyright (c) 2021 BayLibre SAS
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(net_eth_bridge, CONFIG_NET_ETHERNET_BRIDGE_LOG_LEVEL);
 
@@ -34,6 +37,222 @@ static void lock_bridge(struct eth_bridge *br)
 	k_mutex_lock(&br->lock, K_FOREVER);
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+#define FDB_WAYS 4
+#define FDB_SETS (CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE / FDB_WAYS)
+#define FDB_AGING_TIME_MS (CONFIG_NET_ETHERNET_BRIDGE_FDB_AGING_TIME * MSEC_PER_SEC)
+
+BUILD_ASSERT((CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE % FDB_WAYS) == 0,
+	     "Forwarding database size must be a multiple of 4");
+
+static bool fdb_entry_is_valid(struct eth_bridge_fdb_entry *entry, uint32_t now)
+{
+	return entry->used &&
+	       (entry->is_static || (now - entry->last_seen) < FDB_AGING_TIME_MS);
+}
+
+/* Entries are hashed into a set of FDB_WAYS entries */
+static struct eth_bridge_fdb_entry *fdb_set_get(struct eth_bridge *br,
+						const uint8_t *addr,
+						uint16_t vlan_tag)
+{
+	uint32_t hash = 2166136261U;
+
+	for (int i = 0; i < sizeof(br->fdb[0].addr); i++) {
+		hash = (hash ^ addr[i]) * 16777619U;
+	}
+
+	hash = (hash ^ vlan_tag) * 16777619U;
+
+	return &br->fdb[(hash % FDB_SETS) * FDB_WAYS];
+}
+
+static struct eth_bridge_fdb_entry *fdb_lookup(struct eth_bridge *br,
+					       const uint8_t *addr,
+					       uint16_t vlan_tag, uint32_t now)
+{
+	struct eth_bridge_fdb_entry *set = fdb_set_get(br, addr, vlan_tag);
+
+	for (int i = 0; i < FDB_WAYS; i++) {
+		if (fdb_entry_is_valid(&set[i], now) && set[i].vlan_tag == vlan_tag &&
+		    memcmp(set[i].addr, addr, sizeof(set[i].addr)) == 0) {
+			return &set[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Returns a free or aged entry, or else the oldest learned one */
+static struct eth_bridge_fdb_entry *fdb_victim_get(struct eth_bridge *br,
+						   const uint8_t *addr,
+						   uint16_t vlan_tag, uint32_t now)
+{
+	struct eth_bridge_fdb_entry *set = fdb_set_get(br, addr, vlan_tag);
+	struct eth_bridge_fdb_entry *victim = NULL;
+
+	for (int i = 0; i < FDB_WAYS; i++) {
+		if (!fdb_entry_is_valid(&set[i], now)) {
+			return &set[i];
+		}
+
+		if (!set[i].is_static &&
+		    (victim == NULL || (now - set[i].last_seen) > (now - victim->last_seen))) {
+			victim = &set[i];
+		}
+	}
+
+	return victim;
+}
+
+static void fdb_entry_set(struct eth_bridge_fdb_entry *entry, const uint8_t *addr,
+			  uint16_t vlan_tag, struct net_if *iface, uint32_t now)
+{
+	memcpy(entry->addr, addr, sizeof(entry->addr));
+	entry->vlan_tag = vlan_tag;
+	entry->iface = iface;
+	entry->last_seen = now;
+	entry->used = true;
+}
+
+/* Called with the bridge locked */
+static void fdb_learn(struct eth_bridge *br, const uint8_t *addr,
+		      uint16_t vlan_tag, struct net_if *iface, uint32_t now)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	/* Group addresses are never used as source */
+	if ((addr[0] & 0x01) != 0) {
+		return;
+	}
+
+	entry = fdb_lookup(br, addr, vlan_tag, now);
+	if (entry != NULL) {
+		if (!entry->is_static) {
+			/* The station may have moved to another port */
+			entry->iface = iface;
+			entry->last_seen = now;
+		}
+
+		return;
+	}
+
+	entry = fdb_victim_get(br, addr, vlan_tag, now);
+	if (entry == NULL) {
+		return;
+	}
+
+	fdb_entry_set(entry, addr, vlan_tag, iface, now);
+	entry->is_static = false;
+	br->fdb_stats.learned++;
+}
+
+/* Called with the bridge locked */
+static void fdb_iface_flush(struct eth_bridge *br, struct net_if *iface)
+{
+	for (int i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		if (br->fdb[i].iface == iface) {
+			br->fdb[i].used = false;
+		}
+	}
+}
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
+int eth_bridge_fdb_add(struct eth_bridge *br, const uint8_t *addr,
+		       uint16_t vlan_tag, struct net_if *iface)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct eth_bridge_fdb_entry *entry;
+	uint32_t now = k_uptime_get_32();
+	int ret = 0;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return -EINVAL;
+	}
+
+	lock_bridge(br);
+
+	if (ctx->bridge.instance != br) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	entry = fdb_lookup(br, addr, vlan_tag, now);
+	if (entry == NULL) {
+		entry = fdb_victim_get(br, addr, vlan_tag, now);
+		if (entry == NULL) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	fdb_entry_set(entry, addr, vlan_tag, iface, now);
+	entry->is_static = true;
+
+out:
+	k_mutex_unlock(&br->lock);
+
+	return ret;
+#else
+	ARG_UNUSED(br);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(vlan_tag);
+	ARG_UNUSED(iface);
+
+	return -ENOTSUP;
+#endif
+}
+
+int eth_bridge_fdb_del(struct eth_bridge *br, const uint8_t *addr,
+		       uint16_t vlan_tag)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	struct eth_bridge_fdb_entry *entry;
+	int ret = -ENOENT;
+
+	lock_bridge(br);
+
+	entry = fdb_lookup(br, addr, vlan_tag, k_uptime_get_32());
+	if (entry != NULL) {
+		entry->used = false;
+		ret = 0;
+	}
+
+	k_mutex_unlock(&br->lock);
+
+	return ret;
+#else
+	ARG_UNUSED(br);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(vlan_tag);
+
+	return -ENOTSUP;
+#endif
+}
+
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	uint32_t now = k_uptime_get_32();
+
+	lock_bridge(br);
+
+	for (int i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		if (fdb_entry_is_valid(&br->fdb[i], now)) {
+			cb(br, &br->fdb[i], user_data);
+		}
+	}
+
+	k_mutex_unlock(&br->lock);
+#else
+	ARG_UNUSED(br);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+#endif
+}
+
 void net_eth_bridge_foreach(eth_bridge_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(eth_bridge, br) {
@@ -115,6 +334,9 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface)
 
 	sys_slist_find_and_remove(&br->interfaces, &ctx->bridge.node);
 	ctx->bridge.instance = NULL;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	fdb_iface_flush(br, iface);
+#endif
 
 	k_mutex_unlock(&br->lock);
 
@@ -165,61 +387,90 @@ static inline bool is_link_local_addr(struct net_eth_addr *addr)
 	return false;
 }
 
+static void bridge_forward(struct ethernet_context *ctx,
+			   struct ethernet_context *out_ctx,
+			   struct net_pkt *pkt)
+{
+	struct net_pkt *out_pkt;
+
+	/* Don't xmit on the same interface as the incoming packet's */
+	if (ctx == out_ctx) {
+		return;
+	}
+
+	/* Skip it if not allowed to transmit */
+	if (!out_ctx->bridge.allow_tx) {
+		return;
+	}
+
+	/* Skip it if not up */
+	if (!net_if_flag_is_set(out_ctx->iface, NET_IF_UP)) {
+		return;
+	}
+
+	out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
+	if (out_pkt == NULL) {
+		return;
+	}
+
+	NET_DBG("sending pkt %p as %p on iface %p", pkt, out_pkt, out_ctx->iface);
+
+	/*
+	 * Use AF_UNSPEC to avoid interference, set the output
+	 * interface and send the packet.
+	 */
+	net_pkt_set_family(out_pkt, AF_UNSPEC);
+	net_pkt_set_orig_iface(out_pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(out_pkt, out_ctx->iface);
+	net_if_queue_tx(out_ctx->iface, out_pkt);
+}
+
 enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 				      struct net_pkt *pkt)
 {
 	struct eth_bridge *br = ctx->bridge.instance;
+	struct net_eth_addr *dst = (struct net_eth_addr *)net_pkt_lladdr_dst(pkt)->addr;
+	bool flood = true;
 	sys_snode_t *node;
 
 	NET_DBG("new pkt %p", pkt);
 
 	/* Drop all link-local packets for now. */
-	if (is_link_local_addr((struct net_eth_addr *)net_pkt_lladdr_dst(pkt))) {
+	if (is_link_local_addr(dst)) {
 		return NET_DROP;
 	}
 
 	lock_bridge(br);
 
-	/*
-	 * Send packet to all registered interfaces for now.
-	 * Eventually we could get smarter with a MAC address cache.
-	 */
-	SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
-		struct ethernet_context *out_ctx;
-		struct net_pkt *out_pkt;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	uint16_t vlan_tag = net_pkt_vlan_tag(pkt);
+	uint32_t now = k_uptime_get_32();
 
-		out_ctx = CONTAINER_OF(node, struct ethernet_context, bridge.node);
+	fdb_learn(br, net_pkt_lladdr_src(pkt)->addr, vlan_tag, ctx->iface, now);
 
-		/* Don't xmit on the same interface as the incoming packet's */
-		if (ctx == out_ctx) {
-			continue;
-		}
+	if ((dst->addr[0] & 0x01) == 0) {
+		struct eth_bridge_fdb_entry *entry;
 
-		/* Skip it if not allowed to transmit */
-		if (!out_ctx->bridge.allow_tx) {
-			continue;
-		}
-
-		/* Skip it if not up */
-		if (!net_if_flag_is_set(out_ctx->iface, NET_IF_UP)) {
-			continue;
+		entry = fdb_lookup(br, dst->addr, vlan_tag, now);
+		if (entry != NULL) {
+			br->fdb_stats.hits++;
+			flood = false;
+			bridge_forward(ctx, net_if_l2_data(entry->iface), pkt);
+		} else {
+			br->fdb_stats.misses++;
 		}
+	}
+#endif
 
-		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
-		if (out_pkt == NULL) {
-			continue;
-		}
+	/* Send packets to unknown and group addresses to all interfaces */
+	if (flood) {
+		SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
+			struct ethernet_context *out_ctx;
 
-		NET_DBG("sending pkt %p as %p on iface %p", pkt, out_pkt, out_ctx->iface);
+			out_ctx = CONTAINER_OF(node, struct ethernet_context, bridge.node);
 
-		/*
-		 * Use AF_UNSPEC to avoid interference, set the output
-		 * interface and send the packet.
-		 */
-		net_pkt_set_family(out_pkt, AF_UNSPEC);
-		net_pkt_set_orig_iface(out_pkt, net_pkt_iface(pkt));
-		net_pkt_set_iface(out_pkt, out_ctx->iface);
-		net_if_queue_tx(out_ctx->iface, out_pkt);
+			bridge_forward(ctx, out_ctx, pkt);
+		}
 	}
 
 	SYS_SLIST_FOR_EACH_NODE(&br->listeners, node) {
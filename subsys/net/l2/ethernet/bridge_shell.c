@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 BayLibre SAS
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -201,6 +202,76 @@ static int cmd_bridge_show(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+static void bridge_fdb_entry_show(struct eth_bridge *br,
+				  const struct eth_bridge_fdb_entry *entry,
+				  void *data)
+{
+	const struct shell *sh = data;
+	char vlan[sizeof("65535")] = "-";
+
+	if (entry->vlan_tag != NET_VLAN_TAG_UNSPEC) {
+		snprintk(vlan, sizeof(vlan), "%u", entry->vlan_tag);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "%02x:%02x:%02x:%02x:%02x:%02x %-6s%-10d",
+		      entry->addr[0], entry->addr[1], entry->addr[2],
+		      entry->addr[3], entry->addr[4], entry->addr[5],
+		      vlan, net_if_get_by_iface(entry->iface));
+
+	if (entry->is_static) {
+		shell_fprintf(sh, SHELL_NORMAL, "static\n");
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "%u\n",
+			      (k_uptime_get_32() - entry->last_seen) / MSEC_PER_SEC);
+	}
+}
+
+static void bridge_fdb_show(struct eth_bridge *br, void *data)
+{
+	const struct shell *sh = data;
+	struct eth_bridge_fdb_stats stats;
+
+	k_mutex_lock(&br->lock, K_FOREVER);
+	stats = br->fdb_stats;
+	k_mutex_unlock(&br->lock);
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "bridge %d: %u hits, %u misses, %u learned\n",
+		      eth_bridge_get_index(br), stats.hits, stats.misses,
+		      stats.learned);
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "address           vlan  iface     age (s)\n");
+
+	eth_bridge_fdb_foreach(br, bridge_fdb_entry_show, data);
+}
+
+static int cmd_bridge_fdb(const struct shell *sh, size_t argc, char *argv[])
+{
+	int br_idx;
+	struct eth_bridge *br;
+
+	if (argc == 2) {
+		br_idx = get_idx(sh, argv[1]);
+		if (br_idx < 0) {
+			return br_idx;
+		}
+		br = eth_bridge_get_by_index(br_idx);
+		if (br == NULL) {
+			shell_warn(sh, "Bridge %d not found\n", br_idx);
+			return -ENOENT;
+		}
+
+		bridge_fdb_show(br, (void *)sh);
+	} else {
+		net_eth_bridge_foreach(bridge_fdb_show, (void *)sh);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
 SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 	SHELL_CMD_ARG(addif, NULL,
 		  "Add a network interface to a bridge.\n"
@@ -218,6 +289,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 		  "Show bridge information.\n"
 		  "'bridge show [<bridge_index>]'",
 		  cmd_bridge_show, 1, 1),
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	SHELL_CMD_ARG(fdb, NULL,
+		  "Show the forwarding database and its statistics.\n"
+		  "'bridge fdb [<bridge_index>]'",
+		  cmd_bridge_fdb, 1, 1),
+#endif
 	SHELL_SUBCMD_SET_END
 );
 
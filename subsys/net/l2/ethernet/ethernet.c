@@ -25,9 +25,11 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "arp.h"
 #include "eth_stats.h"
 #include "net_private.h"
+#include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
 #include "bridge.h"
+#include "qbv.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
@@ -599,6 +601,175 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+#if defined(CONFIG_NET_TCP_TSO)
+#define GSO_TCP_FIN BIT(0)
+#define GSO_TCP_PSH BIT(3)
+
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt);
+
+/* Build the segment carrying @p len bytes of the payload of the TCP
+ * super-segment @p pkt, starting at @p offset.  The @p ip_len bytes of
+ * IP headers and the TCP header are copied and fixed up so that the
+ * segment could have been built by TCP itself.
+ */
+static struct net_pkt *ethernet_gso_segment(struct net_if *iface,
+					    struct net_pkt *pkt,
+					    size_t ip_len, size_t hdr_len,
+					    size_t offset, size_t len)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	bool last = (hdr_len + offset + len) == net_pkt_get_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	int ret;
+
+	seg = net_pkt_alloc_on_iface(iface, NET_BUF_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(seg, hdr_len + len, NET_BUF_TIMEOUT) < 0) {
+		goto error;
+	}
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tci(seg, net_pkt_vlan_tci(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto error;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr = NET_IPV4_HDR(seg);
+
+		sys_put_be16(sys_get_be16(ipv4_hdr->id) +
+			     offset / net_pkt_tso_mss(pkt), ipv4_hdr->id);
+		ipv4_hdr->chksum = 0U;
+	}
+
+	if (net_pkt_skip(seg, ip_len)) {
+		goto error;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto error;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	if (!last) {
+		tcp_hdr->flags &= ~(GSO_TCP_FIN | GSO_TCP_PSH);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access) < 0) {
+		goto error;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (ret < 0) {
+		goto error;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+
+error:
+	net_pkt_unref(seg);
+	return NULL;
+}
+
+/* Software fallback of TCP segmentation offload: send the super-segment
+ * @p pkt as net_pkt_tso_mss() sized segments.  Segments that could not
+ * be sent are recovered by TCP retransmissions like any lost segment.
+ */
+static int ethernet_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t mss = net_pkt_tso_mss(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_len, hdr_len, data_len;
+	int ret;
+
+	ip_len = net_pkt_ip_hdr_len(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip_len += net_pkt_ipv4_opts_len(pkt);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		ip_len += net_pkt_ipv6_ext_len(pkt);
+	} else {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < data_len; offset += mss) {
+		struct net_pkt *seg;
+
+		seg = ethernet_gso_segment(iface, pkt, ip_len, hdr_len, offset,
+					   MIN(mss, data_len - offset));
+		if (!seg) {
+			return -ENOMEM;
+		}
+
+		ret = ethernet_send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			return ret;
+		}
+	}
+
+	ret = net_pkt_get_len(pkt);
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -612,10 +783,20 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		goto error;
 	}
 
+#if defined(CONFIG_NET_TCP_TSO)
+	if (net_pkt_tso_mss(pkt) > 0 &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		return ethernet_gso_send(iface, pkt);
+	}
+#endif /* CONFIG_NET_TCP_TSO */
+
 	if (IS_ENABLED(CONFIG_NET_ETHERNET_BRIDGE) &&
 	    net_pkt_is_l2_bridged(pkt)) {
 		net_pkt_cursor_init(pkt);
-		ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+		ret = net_eth_qbv_sw_gate(iface, pkt);
+		if (ret == 0) {
+			ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+		}
 		if (ret != 0) {
 			eth_stats_update_errors_tx(iface);
 			goto error;
@@ -708,7 +889,10 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	net_pkt_cursor_init(pkt);
 
 send:
-	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+	ret = net_eth_qbv_sw_gate(iface, pkt);
+	if (ret == 0) {
+		ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+	}
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
 		ethernet_remove_l2_header(pkt);
@@ -13,6 +13,8 @@ LOG_MODULE_REGISTER(net_ethernet_mgmt, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/ethernet_mgmt.h>
 
+#include "qbv.h"
+
 static inline bool is_hw_caps_supported(const struct device *dev,
 					enum ethernet_hw_caps caps)
 {
@@ -138,7 +140,8 @@ static int ethernet_set_config(uint32_t mgmt_request,
 		       sizeof(struct ethernet_qav_param));
 		type = ETHERNET_CONFIG_TYPE_QAV_PARAM;
 	} else if (mgmt_request == NET_REQUEST_ETHERNET_SET_QBV_PARAM) {
-		if (!is_hw_caps_supported(dev, ETHERNET_QBV)) {
+		if (!is_hw_caps_supported(dev, ETHERNET_QBV) &&
+		    !IS_ENABLED(CONFIG_NET_ETHERNET_QBV_SW)) {
 			return -ENOTSUP;
 		}
 
@@ -154,6 +157,10 @@ static int ethernet_set_config(uint32_t mgmt_request,
 			return -EINVAL;
 		}
 
+		if (!is_hw_caps_supported(dev, ETHERNET_QBV)) {
+			return net_eth_qbv_sw_set_param(iface, &params->qbv_param);
+		}
+
 		memcpy(&config.qbv_param, &params->qbv_param,
 		       sizeof(struct ethernet_qbv_param));
 		type = ETHERNET_CONFIG_TYPE_QBV_PARAM;
@@ -342,7 +349,7 @@ static int ethernet_get_config(uint32_t mgmt_request,
 
 	} else if (mgmt_request == NET_REQUEST_ETHERNET_GET_QBV_PARAM) {
 		if (!is_hw_caps_supported(dev, ETHERNET_QBV)) {
-			return -ENOTSUP;
+			return net_eth_qbv_sw_get_param(iface, &params->qbv_param);
 		}
 
 		config.qbv_param.port_id = params->qbv_param.port_id;
@@ -346,6 +346,47 @@ enum net_verdict net_gptp_recv(struct net_if *iface, struct net_pkt *pkt)
 	return NET_DROP;
 }
 
+#if defined(CONFIG_NET_GPTP_RX_DIRECT)
+int gptp_recv_direct(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_eth_hdr *hdr;
+
+	if (!net_if_is_up(iface)) {
+		return -ENETDOWN;
+	}
+
+	if (!pkt->frags ||
+	    pkt->frags->len < sizeof(struct net_eth_hdr) + sizeof(struct gptp_hdr)) {
+		return -EINVAL;
+	}
+
+	hdr = (struct net_eth_hdr *)pkt->frags->data;
+	if (ntohs(hdr->type) != NET_ETH_PTYPE_PTP) {
+		return -EINVAL;
+	}
+
+	/* Do what the Ethernet L2 would have done before dispatching */
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_ll_proto_type(pkt, NET_ETH_PTYPE_PTP);
+
+	net_pkt_lladdr_src(pkt)->addr = hdr->src.addr;
+	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
+	net_pkt_lladdr_src(pkt)->type = NET_LINK_ETHERNET;
+	net_pkt_lladdr_dst(pkt)->addr = hdr->dst.addr;
+	net_pkt_lladdr_dst(pkt)->len = sizeof(struct net_eth_addr);
+	net_pkt_lladdr_dst(pkt)->type = NET_LINK_ETHERNET;
+
+	net_buf_pull(pkt->frags, sizeof(struct net_eth_hdr));
+	net_pkt_cursor_init(pkt);
+
+	if (net_gptp_recv(iface, pkt) == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_GPTP_RX_DIRECT */
+
 static void gptp_init_clock_ds(void)
 {
 	struct gptp_global_ds *global_ds;
@@ -739,6 +739,109 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+static struct gptp_servo {
+	/* Integral term and the correction currently applied, in ppb */
+	double integral;
+	double applied_ppb;
+	/* Local time of the previous sample, to normalize by the interval */
+	uint64_t last_local_time;
+	/* Gains in thousandths */
+	uint32_t kp;
+	uint32_t ki;
+	struct gptp_servo_stats stats;
+} servo = {
+	.kp = CONFIG_NET_GPTP_SERVO_KP,
+	.ki = CONFIG_NET_GPTP_SERVO_KI,
+};
+
+static double servo_clamp(double ppb)
+{
+	return CLAMP(ppb, -CONFIG_NET_GPTP_SERVO_MAX_PPB,
+		     CONFIG_NET_GPTP_SERVO_MAX_PPB);
+}
+
+/* Run the servo on one offset sample and return the rate change to apply on
+ * top of the neighbor rate ratio. The PTP clock drivers compound successive
+ * rate adjustments, so only the change of the correction is passed on.
+ */
+static double servo_sample(int64_t offset, uint64_t local_time)
+{
+	double interval;
+	double ppb;
+	double delta;
+	unsigned int key;
+
+	key = irq_lock();
+
+	servo.stats.offset_ns = offset;
+	servo.stats.samples++;
+
+	if (servo.last_local_time == 0U || local_time <= servo.last_local_time) {
+		servo.last_local_time = local_time;
+		irq_unlock(key);
+		return 1.0;
+	}
+
+	interval = (double)(local_time - servo.last_local_time) / NSEC_PER_SEC;
+	servo.last_local_time = local_time;
+
+	servo.integral = servo_clamp(servo.integral +
+				     servo.ki * offset / 1000.0 / interval);
+	ppb = servo_clamp(servo.kp * offset / 1000.0 / interval + servo.integral);
+
+	delta = ppb - servo.applied_ppb;
+	servo.applied_ppb = ppb;
+
+	if (offset < 0) {
+		offset = -offset;
+	}
+
+	servo.stats.freq_ppb = (int32_t)ppb;
+	servo.stats.offset_max_ns = MAX(servo.stats.offset_max_ns, offset);
+	servo.stats.offset_avg_ns += (offset - servo.stats.offset_avg_ns) / 16;
+
+	irq_unlock(key);
+
+	return 1.0 + delta / NSEC_PER_SEC;
+}
+
+/* The clock is stepped, the next sample starts a new interval */
+static void servo_step(int64_t offset)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	servo.stats.offset_ns = offset;
+	servo.stats.steps++;
+	servo.last_local_time = 0U;
+
+	irq_unlock(key);
+}
+
+void gptp_servo_set_gains(uint32_t kp, uint32_t ki)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	servo.kp = kp;
+	servo.ki = ki;
+
+	irq_unlock(key);
+}
+
+void gptp_servo_get_stats(struct gptp_servo_stats *stats)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	*stats = servo.stats;
+	irq_unlock(key);
+}
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
@@ -786,6 +889,21 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -(int64_t)NSEC_PER_SEC + nanosecond_diff;
 	}
 
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	/* Within the step threshold the servo steers the clock frequency,
+	 * so the phase does not need to be adjusted.
+	 */
+	if (second_diff == 0 && nanosecond_diff >= -5000 &&
+	    nanosecond_diff <= 5000) {
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio *
+				      servo_sample(nanosecond_diff,
+						   global_ds->sync_receipt_local_time));
+		return;
+	}
+
+	servo_step(second_diff * NSEC_PER_SEC + nanosecond_diff);
+#endif
+
 	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
 
 	/* If time difference is too high, set the clock value.
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_eth_qbv, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/drivers/ptp_clock.h>
+
+#include "qbv.h"
+
+/* Preamble, start of frame delimiter, FCS and inter-frame gap */
+#define QBV_FRAME_OVERHEAD (8 + 4 + 12)
+
+static inline struct ethernet_qbv_sw_context *qbv_ctx(struct net_if *iface)
+{
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+
+	return &ctx->qbv;
+}
+
+int net_eth_qbv_sw_set_param(struct net_if *iface,
+			     const struct ethernet_qbv_param *param)
+{
+	struct ethernet_qbv_sw_context *qbv = qbv_ctx(iface);
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&qbv->lock);
+
+	switch (param->type) {
+	case ETHERNET_QBV_PARAM_TYPE_STATUS:
+		if (param->enabled && qbv->gcl_len == 0U) {
+			ret = -EINVAL;
+			break;
+		}
+
+		qbv->enabled = param->enabled;
+		break;
+
+	case ETHERNET_QBV_PARAM_TYPE_GATE_CONTROL_LIST:
+		if (param->gate_control.row >= ARRAY_SIZE(qbv->gcl)) {
+			ret = -EINVAL;
+			break;
+		}
+
+		/* Hold and release are MAC merge (Qbu) operations */
+		if (param->gate_control.operation != ETHERNET_SET_GATE_STATE) {
+			ret = -ENOTSUP;
+			break;
+		}
+
+		qbv->gcl[param->gate_control.row].interval =
+			param->gate_control.time_interval;
+		qbv->gcl[param->gate_control.row].gates = 0U;
+
+		for (int tc = 0; tc < NET_TC_TX_COUNT; tc++) {
+			if (param->gate_control.gate_status[tc]) {
+				qbv->gcl[param->gate_control.row].gates |= BIT(tc);
+			}
+		}
+		break;
+
+	case ETHERNET_QBV_PARAM_TYPE_GATE_CONTROL_LIST_LEN:
+		if (param->gate_control_list_len > ARRAY_SIZE(qbv->gcl) ||
+		    (param->gate_control_list_len == 0U && qbv->enabled)) {
+			ret = -EINVAL;
+			break;
+		}
+
+		qbv->gcl_len = param->gate_control_list_len;
+		break;
+
+	case ETHERNET_QBV_PARAM_TYPE_TIME:
+		qbv->base_time = param->base_time.second * NSEC_PER_SEC +
+				 param->base_time.fract_nsecond;
+		qbv->cycle_time = param->cycle_time.second * NSEC_PER_SEC +
+				  param->cycle_time.nanosecond;
+		qbv->extension_time = param->extension_time;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&qbv->lock, key);
+
+	return ret;
+}
+
+int net_eth_qbv_sw_get_param(struct net_if *iface,
+			     struct ethernet_qbv_param *param)
+{
+	struct ethernet_qbv_sw_context *qbv = qbv_ctx(iface);
+	const struct ethernet_qbv_sw_entry *entry;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&qbv->lock);
+
+	/* There is no pending admin list in software, both states read the
+	 * schedule in use.
+	 */
+	switch (param->type) {
+	case ETHERNET_QBV_PARAM_TYPE_STATUS:
+		param->enabled = qbv->enabled;
+		break;
+
+	case ETHERNET_QBV_PARAM_TYPE_GATE_CONTROL_LIST:
+		if (param->gate_control.row >= ARRAY_SIZE(qbv->gcl)) {
+			ret = -EINVAL;
+			break;
+		}
+
+		entry = &qbv->gcl[param->gate_control.row];
+
+		param->gate_control.operation = ETHERNET_SET_GATE_STATE;
+		param->gate_control.time_interval = entry->interval;
+
+		for (int tc = 0; tc < NET_TC_TX_COUNT; tc++) {
+			param->gate_control.gate_status[tc] = (entry->gates & BIT(tc)) != 0U;
+		}
+		break;
+
+	case ETHERNET_QBV_PARAM_TYPE_GATE_CONTROL_LIST_LEN:
+		param->gate_control_list_len = qbv->gcl_len;
+		break;
+
+	case ETHERNET_QBV_PARAM_TYPE_TIME:
+		param->base_time.second = qbv->base_time / NSEC_PER_SEC;
+		param->base_time.fract_nsecond = qbv->base_time % NSEC_PER_SEC;
+		param->cycle_time.second = qbv->cycle_time / NSEC_PER_SEC;
+		param->cycle_time.nanosecond = qbv->cycle_time % NSEC_PER_SEC;
+		param->extension_time = qbv->extension_time;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&qbv->lock, key);
+
+	return ret;
+}
+
+/* Time the frame occupies the wire, at the best link speed of the MAC */
+static uint64_t qbv_tx_duration(struct net_if *iface, struct net_pkt *pkt)
+{
+	enum ethernet_hw_caps caps = net_eth_get_hw_capabilities(iface);
+	uint64_t bits = (net_pkt_get_len(pkt) + QBV_FRAME_OVERHEAD) * 8U;
+
+	if (caps & ETHERNET_LINK_1000BASE_T) {
+		return bits;
+	} else if (caps & ETHERNET_LINK_100BASE_T) {
+		return bits * 10U;
+	}
+
+	return bits * 100U;
+}
+
+/* Find the earliest time from now on at which the gate of the traffic class
+ * stays open for at least duration nanoseconds. Consecutive open rows form
+ * one window, also across the cycle boundary, so two cycles are walked.
+ */
+static int qbv_find_window(const struct ethernet_qbv_sw_context *qbv, uint8_t tc,
+			   uint64_t now, uint64_t duration, uint64_t *launch)
+{
+	uint64_t cycle = qbv->cycle_time;
+	uint64_t cycle_start;
+	uint64_t open_start = 0U;
+	bool open = false;
+
+	if (cycle == 0U) {
+		for (int i = 0; i < qbv->gcl_len; i++) {
+			cycle += qbv->gcl[i].interval;
+		}
+	}
+
+	/* The schedule is not in effect before its base time */
+	if (now < qbv->base_time || cycle == 0U) {
+		*launch = now;
+		return 0;
+	}
+
+	cycle_start = now - (now - qbv->base_time) % cycle;
+
+	for (int n = 0; n < 2; n++, cycle_start += cycle) {
+		uint64_t cycle_end = cycle_start + cycle;
+		uint64_t t = cycle_start;
+
+		for (int i = 0; i < qbv->gcl_len && t < cycle_end; i++) {
+			uint64_t end;
+			uint64_t start;
+
+			/* A cycle longer than the list keeps the last state,
+			 * a shorter one truncates the list.
+			 */
+			if (i == qbv->gcl_len - 1) {
+				end = cycle_end;
+			} else {
+				end = MIN(t + qbv->gcl[i].interval, cycle_end);
+			}
+
+			if (!(qbv->gcl[i].gates & BIT(tc))) {
+				open = false;
+				t = end;
+				continue;
+			}
+
+			if (!open) {
+				open = true;
+				open_start = t;
+			}
+
+			start = MAX(open_start, now);
+			if (end > start && end - start >= duration) {
+				*launch = start;
+				return 0;
+			}
+
+			t = end;
+		}
+	}
+
+	return -EMSGSIZE;
+}
+
+int net_eth_qbv_sw_gate(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct ethernet_qbv_sw_context *qbv = qbv_ctx(iface);
+	const struct device *clk;
+	struct net_ptp_time tm;
+	uint64_t duration;
+	uint64_t launch;
+	uint64_t now;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (!qbv->enabled) {
+		return 0;
+	}
+
+	clk = net_eth_get_ptp_clock(iface);
+	if (clk == NULL || ptp_clock_get(clk, &tm) < 0) {
+		return 0;
+	}
+
+	now = tm.second * NSEC_PER_SEC + tm.nanosecond;
+	duration = qbv_tx_duration(iface, pkt);
+
+	key = k_spin_lock(&qbv->lock);
+	ret = qbv_find_window(qbv, net_tx_priority2tc(net_pkt_priority(pkt)),
+			      now, duration, &launch);
+	k_spin_unlock(&qbv->lock, key);
+
+	if (ret < 0) {
+		NET_DBG("No gate window fits %llu ns frame", duration);
+		return ret;
+	}
+
+	if (launch == now) {
+		return 0;
+	}
+
+	/* Let the MAC launch the frame when the gate opens if it can,
+	 * otherwise keep the traffic class queue back until then.
+	 */
+	if (IS_ENABLED(CONFIG_NET_PKT_TXTIME) &&
+	    (net_eth_get_hw_capabilities(iface) & ETHERNET_TXTIME)) {
+		net_pkt_set_txtime(pkt, launch);
+		return 0;
+	}
+
+	k_sleep(K_NSEC(launch - now));
+
+	return 0;
+}
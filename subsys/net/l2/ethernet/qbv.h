@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __QBV_H
+#define __QBV_H
+
+#include <zephyr/net/ethernet.h>
+
+#if defined(CONFIG_NET_ETHERNET_QBV_SW)
+int net_eth_qbv_sw_set_param(struct net_if *iface,
+			     const struct ethernet_qbv_param *param);
+int net_eth_qbv_sw_get_param(struct net_if *iface,
+			     struct ethernet_qbv_param *param);
+
+/* Hold a frame until the gate of its traffic class is open. Called from the
+ * TX thread of that traffic class, right before the frame goes to the driver.
+ */
+int net_eth_qbv_sw_gate(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_eth_qbv_sw_set_param(struct net_if *iface,
+					   const struct ethernet_qbv_param *param)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(param);
+
+	return -ENOTSUP;
+}
+
+static inline int net_eth_qbv_sw_get_param(struct net_if *iface,
+					   struct ethernet_qbv_param *param)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(param);
+
+	return -ENOTSUP;
+}
+
+static inline int net_eth_qbv_sw_gate(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_ETHERNET_QBV_SW */
+
+#endif /* __QBV_H */
@@ -35,15 +35,44 @@ LOG_MODULE_REGISTER(net_ieee802154, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 #endif /* CONFIG_NET_L2_IEEE802154_FRAGMENT */
 #endif /* CONFIG_NET_6LO */
 
+#include "ieee802154_arbiter.h"
+#include "ieee802154_csl.h"
 #include "ieee802154_frame.h"
+#include "ieee802154_indirect.h"
+#include "ieee802154_link_quality.h"
 #include "ieee802154_mgmt_priv.h"
 #include "ieee802154_priv.h"
 #include "ieee802154_security.h"
+#include "ieee802154_tsch.h"
 #include "ieee802154_utils.h"
 
 #define BUF_TIMEOUT K_MSEC(50)
 
-NET_BUF_POOL_DEFINE(tx_frame_buf_pool, 1, IEEE802154_MTU, 8, NULL);
+#ifdef CONFIG_NET_L2_IEEE802154_RADIO_TX_BATCH
+#define TX_FRAME_BUF_COUNT CONFIG_NET_L2_IEEE802154_RADIO_TX_BATCH_SIZE
+#elif defined(CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC)
+/* One frame in the air while the next one is being secured */
+#define TX_FRAME_BUF_COUNT 2
+#else
+#define TX_FRAME_BUF_COUNT 1
+#endif
+
+NET_BUF_POOL_DEFINE(tx_frame_buf_pool, TX_FRAME_BUF_COUNT, IEEE802154_MTU, 8, NULL);
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+#if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
+#define RX_SEC_THREAD_PRIORITY K_PRIO_COOP(CONFIG_NET_L2_IEEE802154_SECURITY_RX_THREAD_PRIO)
+#else
+#define RX_SEC_THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NET_L2_IEEE802154_SECURITY_RX_THREAD_PRIO)
+#endif
+
+static K_FIFO_DEFINE(rx_sec_queue);
+
+static void rx_sec_handler(void *p1, void *p2, void *p3);
+
+static K_THREAD_DEFINE(rx_sec_thread, CONFIG_NET_L2_IEEE802154_SECURITY_RX_STACK_SIZE,
+		       rx_sec_handler, NULL, NULL, NULL, RX_SEC_THREAD_PRIORITY, 0, 0);
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
 
 #define PKT_TITLE    "IEEE 802.15.4 packet content:"
 #define TX_PKT_TITLE "> " PKT_TITLE
@@ -87,6 +116,10 @@ static inline void ieee802154_acknowledge(struct net_if *iface, struct ieee80215
 	}
 
 	if (ieee802154_create_ack_frame(iface, pkt, mpdu->mhr.fs->sequence)) {
+		if (ieee802154_indirect_frame_pending(iface, mpdu)) {
+			((struct ieee802154_fcf_seq *)net_pkt_data(pkt))->fc.frame_pending = 1U;
+		}
+
 		/* ACK frames must not use the CSMA/CA procedure, see section 6.2.5.1. */
 		ieee802154_radio_tx(iface, IEEE802154_TX_MODE_DIRECT, pkt, pkt->buffer);
 	}
@@ -124,6 +157,9 @@ enum net_verdict ieee802154_handle_ack(struct net_if *iface, struct net_pkt *pkt
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 
+	/* Enhanced ACKs of CSL receivers carry their CSL phase. */
+	ieee802154_csl_handle_ack(iface, pkt);
+
 	if (ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_TX_RX_ACK) {
 		__ASSERT_NO_MSG(ctx->ack_seq == 0U);
 		/* TODO: Release packet in L2 as we're taking ownership. */
@@ -174,14 +210,14 @@ inline int ieee802154_wait_for_ack(struct net_if *iface, bool ack_required)
 	return ret;
 }
 
-int ieee802154_radio_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag)
+static int ieee802154_radio_send_attempts(struct net_if *iface, struct net_pkt *pkt,
+					  struct net_buf *frag)
 {
 	uint8_t remaining_attempts = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES + 1;
+	uint8_t attempts = 0U;
 	bool hw_csma, ack_required;
 	int ret;
 
-	NET_DBG("frag %p", frag);
-
 	if (ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_RETRANSMISSION) {
 		/* A driver that claims retransmission capability must also be able
 		 * to wait for ACK frames otherwise it could not decide whether or
@@ -221,6 +257,11 @@ int ieee802154_radio_send(struct net_if *iface, struct net_pkt *pkt, struct net_
 			pkt, frag);
 		if (ret) {
 			/* Transmission failure. */
+			if (ret == -ENOMSG && ack_required) {
+				/* Not acknowledged, after the driver's retransmissions if any. */
+				ieee802154_link_quality_tx_done(iface, pkt, attempts + 1U, false);
+			}
+
 			return ret;
 		}
 
@@ -236,17 +277,97 @@ int ieee802154_radio_send(struct net_if *iface, struct net_pkt *pkt, struct net_
 
 		/* No-op in case the driver has IEEE802154_HW_TX_RX_ACK capability. */
 		ret = ieee802154_wait_for_ack(iface, ack_required);
+		attempts++;
 		if (ret == 0) {
 			/* ACK received - transmission is successful. */
+			ieee802154_link_quality_tx_done(iface, pkt, attempts, true);
 			return 0;
 		}
 
 		remaining_attempts--;
 	}
 
+	ieee802154_link_quality_tx_done(iface, pkt, attempts, false);
+
 	return -EIO;
 }
 
+int ieee802154_radio_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag)
+{
+	int ret;
+
+	NET_DBG("frag %p", frag);
+
+#ifdef CONFIG_NET_L2_IEEE802154_RADIO_TSCH
+	/* In TSCH mode frames are sent in the timeslots of matching links. */
+	return ieee802154_tsch_send(iface, pkt, frag);
+#endif
+
+	/* Frames to sleepy children are kept until the child polls for them. */
+	ret = ieee802154_indirect_send(iface, pkt, frag);
+	if (ret != -ENOENT) {
+		return ret;
+	}
+
+	/* Unicast frames to CSL receivers are sent in their channel samples. */
+	ret = ieee802154_csl_send(iface, pkt, frag);
+	if (ret != -ENOENT) {
+		return ret;
+	}
+
+	/* The radio may be shared with other interfaces. */
+	ret = ieee802154_arbiter_acquire(iface);
+	if (ret) {
+		return ret;
+	}
+
+	ret = ieee802154_radio_send_attempts(iface, pkt, frag);
+
+	ieee802154_arbiter_release(iface);
+
+	return ret;
+}
+
+/* Batches leave channel access, ACK handling and retransmission entirely
+ * to the driver, so that the frames can go out back to back.
+ */
+static bool ieee802154_can_tx_batch(struct net_if *iface)
+{
+	const struct ieee802154_radio_api *radio = net_if_get_device(iface)->api;
+	enum ieee802154_hw_caps required =
+		IEEE802154_HW_CSMA | IEEE802154_HW_TX_RX_ACK | IEEE802154_HW_RETRANSMISSION;
+
+	if (!IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_TX_BATCH) || !radio || !radio->tx_batch) {
+		return false;
+	}
+
+	return (ieee802154_radio_get_hw_capabilities(iface) & required) == required;
+}
+
+static int ieee802154_radio_send_batch(struct net_if *iface, struct ieee802154_tx_frame *frames,
+				       size_t count)
+{
+	int ret;
+
+	NET_DBG("batch of %zu frames", count);
+
+	ret = ieee802154_arbiter_acquire(iface);
+	if (ret) {
+		return ret;
+	}
+
+	ret = ieee802154_radio_tx_batch(iface, frames, count);
+
+	ieee802154_arbiter_release(iface);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The driver stops at the first frame that failed. */
+	return (size_t)ret < count ? frames[ret].status : 0;
+}
+
 static inline void swap_and_set_pkt_ll_addr(struct net_linkaddr *addr, bool has_pan_id,
 					    enum ieee802154_addressing_mode mode,
 					    struct ieee802154_address_field *ll)
@@ -357,6 +478,9 @@ out:
 	return ret;
 }
 
+static enum net_verdict ieee802154_recv_data_frame(struct net_if *iface, struct net_pkt *pkt,
+						   struct ieee802154_mpdu *mpdu);
+
 static enum net_verdict ieee802154_recv(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ieee802154_radio_api *radio = net_if_get_device(iface)->api;
@@ -364,12 +488,24 @@ static enum net_verdict ieee802154_recv(struct net_if *iface, struct net_pkt *pk
 	struct ieee802154_fcf_seq *fs;
 	struct ieee802154_mpdu mpdu;
 	bool is_broadcast;
-	size_t ll_hdr_len;
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	if (net_pkt_ieee802154_rx_l2_done(pkt)) {
+		net_pkt_set_ieee802154_rx_l2_done(pkt, false);
+		return NET_CONTINUE;
+	}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
 
 	/* The IEEE 802.15.4 stack assumes that drivers provide a single-fragment package. */
 	__ASSERT_NO_MSG(pkt->buffer && pkt->buffer->frags == NULL);
 
-	if (!ieee802154_validate_frame(net_pkt_data(pkt), net_pkt_get_len(pkt), &mpdu)) {
+	/* TSCH Enhanced Beacons do not pass the legacy beacon validation. */
+	verdict = ieee802154_tsch_handle_eb(iface, pkt);
+	if (verdict != NET_CONTINUE) {
+		return verdict;
+	}
+
+	if (!ieee802154_parse_frame(pkt, &mpdu)) {
 		return NET_DROP;
 	}
 
@@ -381,6 +517,9 @@ static enum net_verdict ieee802154_recv(struct net_if *iface, struct net_pkt *pk
 
 	fs = mpdu.mhr.fs;
 
+	ieee802154_tsch_rx_sync(iface, pkt, &mpdu);
+	ieee802154_csl_rx_track(iface, pkt, &mpdu);
+
 	if (fs->fc.frame_type == IEEE802154_FRAME_TYPE_ACK) {
 		return NET_DROP;
 	}
@@ -427,31 +566,58 @@ static enum net_verdict ieee802154_recv(struct net_if *iface, struct net_pkt *pk
 	}
 
 	if (fs->fc.frame_type == IEEE802154_FRAME_TYPE_MAC_COMMAND) {
+		/* Data requests are answered once they have been acknowledged. */
+		ieee802154_indirect_handle_poll(iface, &mpdu);
 		net_pkt_unref(pkt);
 		return NET_OK;
 	}
 
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	if (fs->fc.security_enabled) {
+		/* Unsecured in batches by the security RX thread. */
+		k_fifo_put(&rx_sec_queue, pkt);
+		return NET_OK;
+	}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
 	if (!ieee802154_decipher_data_frame(iface, pkt, &mpdu)) {
 		return NET_DROP;
 	}
 
+	return ieee802154_recv_data_frame(iface, pkt, &mpdu);
+
+	/* At this point the call amounts to (part of) an
+	 * MCPS-DATA.indication primitive, see section 8.3.3.
+	 */
+}
+
+static enum net_verdict ieee802154_recv_data_frame(struct net_if *iface, struct net_pkt *pkt,
+						   struct ieee802154_mpdu *mpdu)
+{
+	struct ieee802154_fcf_seq *fs = mpdu->mhr.fs;
+	enum net_verdict verdict = NET_CONTINUE;
+	size_t ll_hdr_len;
+
 	/* Setting L2 addresses must be done after packet authentication and internal
 	 * packet handling as it will mangle the package header to comply with upper
 	 * network layers' (POSIX) requirement to represent network addresses in big endian.
 	 */
 	swap_and_set_pkt_ll_addr(net_pkt_lladdr_src(pkt), !fs->fc.pan_id_comp,
-				 fs->fc.src_addr_mode, mpdu.mhr.src_addr);
+				 fs->fc.src_addr_mode, mpdu->mhr.src_addr);
 
 	swap_and_set_pkt_ll_addr(net_pkt_lladdr_dst(pkt), true, fs->fc.dst_addr_mode,
-				 mpdu.mhr.dst_addr);
+				 mpdu->mhr.dst_addr);
 
 	net_pkt_set_ll_proto_type(pkt, ETH_P_IEEE802154);
 
 	pkt_hexdump(RX_PKT_TITLE " (with ll)", pkt, true);
 
-	ll_hdr_len = (uint8_t *)mpdu.payload - net_pkt_data(pkt);
+	ll_hdr_len = (uint8_t *)mpdu->payload - net_pkt_data(pkt);
 	net_buf_pull(pkt->buffer, ll_hdr_len);
 
+	/* The cached MPDU offsets do not match the packet's data anymore. */
+	net_pkt_set_ieee802154_mpdu_parsed(pkt, false);
+
 #ifdef CONFIG_NET_6LO
 	verdict = ieee802154_6lo_decode_pkt(iface, pkt);
 #endif /* CONFIG_NET_6LO */
@@ -461,11 +627,93 @@ static enum net_verdict ieee802154_recv(struct net_if *iface, struct net_pkt *pk
 	}
 
 	return verdict;
+}
 
-	/* At this point the call amounts to (part of) an
-	 * MCPS-DATA.indication primitive, see section 8.3.3.
-	 */
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+struct rx_sec_frame {
+	struct net_pkt *pkt;
+	struct ieee802154_mpdu mpdu;
+	struct ieee802154_security_op op;
+	bool submitted;
+};
+
+static void rx_sec_handler(void *p1, void *p2, void *p3)
+{
+	static struct rx_sec_frame frames[CONFIG_NET_L2_IEEE802154_SECURITY_RX_BATCH];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct net_pkt *pkt = k_fifo_get(&rx_sec_queue, K_FOREVER);
+		size_t count = 0;
+
+		/* Submit everything queued meanwhile before waiting for the first
+		 * result, so that the crypto device works on the whole batch.
+		 */
+		while (pkt) {
+			struct rx_sec_frame *frame = &frames[count++];
+
+			frame->pkt = pkt;
+
+			/* The frame has been parsed already in the RX path. */
+			frame->submitted =
+				ieee802154_get_parsed_frame(pkt, &frame->mpdu) &&
+				ieee802154_decipher_data_frame_submit(net_pkt_iface(pkt), pkt,
+								      &frame->mpdu, &frame->op);
+
+			if (count == ARRAY_SIZE(frames)) {
+				break;
+			}
+
+			pkt = k_fifo_get(&rx_sec_queue, K_NO_WAIT);
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			struct rx_sec_frame *frame = &frames[i];
+			struct net_if *iface = net_pkt_iface(frame->pkt);
+			enum net_verdict verdict = NET_DROP;
+
+			if (!frame->submitted) {
+				(void)ieee802154_security_op_wait(&frame->op);
+			} else if (ieee802154_decipher_data_frame_finish(frame->pkt, &frame->mpdu,
+									 &frame->op)) {
+				verdict = ieee802154_recv_data_frame(iface, frame->pkt,
+								     &frame->mpdu);
+			}
+
+			if (verdict == NET_CONTINUE) {
+				/* Let the L2 pass the frame through this time. */
+				net_pkt_set_ieee802154_rx_l2_done(frame->pkt, true);
+				if (net_recv_data(iface, frame->pkt) < 0) {
+					verdict = NET_DROP;
+				}
+			}
+
+			if (verdict == NET_DROP) {
+				net_pkt_unref(frame->pkt);
+			}
+		}
+	}
+}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+/* Waits for the frame to be secured and sends it unless an error occurred
+ * before. The frame buffer may be reused once this returned.
+ */
+static int ieee802154_send_secured(struct net_if *iface, struct net_pkt *pkt,
+				   struct net_buf *frame_buf, struct ieee802154_security_op *op,
+				   int ret)
+{
+	if (!ieee802154_security_op_wait(op)) {
+		return ret ? ret : -EINVAL;
+	}
+
+	return ret ? ret : ieee802154_radio_send(iface, pkt, frame_buf);
 }
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
 
 /**
  * Implements (part of) the MCPS-DATA.request/confirm primitives, see sections 8.3.2/3.
@@ -474,19 +722,25 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	uint8_t ll_hdr_len = 0, authtag_len = 0;
-	static struct net_buf *frame_buf;
+	static struct net_buf *frame_bufs[TX_FRAME_BUF_COUNT];
 	static struct net_buf *pkt_buf;
+	struct ieee802154_tx_frame frames[TX_FRAME_BUF_COUNT];
+	size_t batched = 0;
 	bool send_raw = false;
+	bool batch;
 	int len;
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	struct ieee802154_security_op sec_ops[2];
+	struct ieee802154_security_op *pending_op = NULL;
+	struct net_buf *pending = NULL;
+	bool pipeline;
+#endif
 #ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT
 	struct ieee802154_6lo_fragment_ctx frag_ctx;
 	int requires_fragmentation = 0;
+	bool in_place;
 #endif
 
-	if (frame_buf == NULL) {
-		frame_buf = net_buf_alloc(&tx_frame_buf_pool, K_FOREVER);
-	}
-
 	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && net_pkt_family(pkt) == AF_PACKET) {
 		enum net_sock_type socket_type;
 		struct net_context *context;
@@ -534,18 +788,58 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 
 	net_capture_pkt(iface, pkt);
 
+	/* Frames to sleepy children are queued one by one. */
+	batch = ieee802154_can_tx_batch(iface) &&
+		!ieee802154_indirect_is_child(iface, net_pkt_lladdr_dst(pkt));
+
+#ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT
+	/* Building a fragment in place overwrites the payload sent with the
+	 * previous fragment, so that one must have been sent already and
+	 * nobody else may look at the packet. Trailing authentication tags
+	 * would overwrite the payload of the next fragment.
+	 */
+	in_place = IS_ENABLED(CONFIG_NET_L2_IEEE802154_FRAGMENT_IN_PLACE) &&
+		   requires_fragmentation && !batch && authtag_len == 0U &&
+		   atomic_get(&pkt->atomic_ref) == 1;
+#endif
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	/* Secure each frame while the previous one is in the air. Batches are
+	 * secured completely before being submitted anyway.
+	 */
+	pipeline = !send_raw && !batch && authtag_len > 0U;
+#endif
+
 	len = 0;
 	pkt_buf = pkt->buffer;
 	while (pkt_buf) {
+		struct net_buf *frame_ref = NULL;
+		struct net_buf *frame_buf;
 		int ret;
 
+		if (frame_bufs[batched] == NULL) {
+			frame_bufs[batched] = net_buf_alloc(&tx_frame_buf_pool, K_FOREVER);
+		}
+
+		frame_buf = frame_bufs[batched];
+
 		/* Reinitializing frame_buf */
 		net_buf_reset(frame_buf);
 		net_buf_add(frame_buf, ll_hdr_len);
 
 #ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT
 		if (requires_fragmentation) {
-			pkt_buf = ieee802154_6lo_fragment(&frag_ctx, frame_buf, true);
+			if (in_place) {
+				frame_ref = ieee802154_6lo_fragment_in_place(&frag_ctx, frame_buf,
+									     true);
+			}
+
+			if (frame_ref) {
+				frame_buf = frame_ref;
+				pkt_buf = frag_ctx.buf;
+			} else {
+				pkt_buf = ieee802154_6lo_fragment(&frag_ctx, frame_buf, true);
+			}
 		} else {
 			net_buf_add_mem(frame_buf, pkt_buf->data, pkt_buf->len);
 			pkt_buf = pkt_buf->frags;
@@ -553,6 +847,11 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 #else
 		if (ll_hdr_len + pkt_buf->len + authtag_len > IEEE802154_MTU) {
 			NET_ERR("Frame too long: %d", pkt_buf->len);
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+			if (pending_op) {
+				(void)ieee802154_security_op_wait(pending_op);
+			}
+#endif
 			return -EINVAL;
 		}
 		net_buf_add_mem(frame_buf, pkt_buf->data, pkt_buf->len);
@@ -562,18 +861,78 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 		__ASSERT_NO_MSG(authtag_len <= net_buf_tailroom(frame_buf));
 		net_buf_add(frame_buf, authtag_len);
 
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+		if (pipeline) {
+			struct ieee802154_security_op *prev_op = pending_op;
+			struct net_buf *prev = pending;
+
+			pending_op = &sec_ops[batched];
+			pending = frame_buf;
+
+			/* Alternate between the two frame buffers. */
+			batched = !batched;
+
+			ret = ieee802154_create_data_frame_async(ctx, net_pkt_lladdr_dst(pkt),
+								 net_pkt_lladdr_src(pkt), frame_buf,
+								 ll_hdr_len, pending_op)
+				      ? 0
+				      : -EINVAL;
+
+			if (prev) {
+				ret = ieee802154_send_secured(iface, pkt, prev, prev_op, ret);
+			}
+
+			len += frame_buf->len;
+
+			if (ret == 0 && pkt_buf) {
+				continue;
+			}
+
+			ret = ieee802154_send_secured(iface, pkt, pending, pending_op, ret);
+			if (ret) {
+				return ret;
+			}
+
+			break;
+		}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
 		if (!(send_raw || ieee802154_create_data_frame(ctx, net_pkt_lladdr_dst(pkt),
 							       net_pkt_lladdr_src(pkt),
 							       frame_buf, ll_hdr_len))) {
+			if (frame_ref) {
+				net_buf_unref(frame_ref);
+			}
+
 			return -EINVAL;
 		}
 
-		ret = ieee802154_radio_send(iface, pkt, frame_buf);
+		len += frame_buf->len;
+
+		if (batch) {
+			frames[batched++] = (struct ieee802154_tx_frame){
+				.pkt = pkt,
+				.frag = frame_buf,
+				.mode = IEEE802154_TX_MODE_CSMA_CA,
+			};
+
+			if (pkt_buf && batched < ARRAY_SIZE(frames)) {
+				continue;
+			}
+
+			ret = ieee802154_radio_send_batch(iface, frames, batched);
+			batched = 0;
+		} else {
+			ret = ieee802154_radio_send(iface, pkt, frame_buf);
+		}
+
+		if (frame_ref) {
+			net_buf_unref(frame_ref);
+		}
+
 		if (ret) {
 			return ret;
 		}
-
-		len += frame_buf->len;
 	}
 
 	net_pkt_unref(pkt);
@@ -55,10 +55,14 @@ int ieee802154_6lo_encode_pkt(struct net_if *iface, struct net_pkt *pkt,
 		ieee802154_6lo_requires_fragmentation(pkt, ll_hdr_len, authtag_len);
 
 	if (requires_fragmentation) {
+		/* The fragmenter walks the fragment chain, no need to compact. */
 		ieee802154_6lo_fragment_ctx_init(frag_ctx, pkt, hdr_diff, true);
+		return 1;
 	}
-	return requires_fragmentation ? 1 : 0;
-#else
-	return 0;
 #endif /* CONFIG_NET_L2_IEEE802154_FRAGMENT */
+
+	/* Unfragmented packets are sent from a single buffer. */
+	net_pkt_compact(pkt);
+
+	return 0;
 }
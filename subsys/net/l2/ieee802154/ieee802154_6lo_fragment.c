@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_ieee802154_6lo_fragment, CONFIG_NET_L2_IEEE802154_LOG_LE
 #include "net_private.h"
 
 #include <errno.h>
+#include <string.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_if.h>
@@ -32,20 +33,38 @@ LOG_MODULE_REGISTER(net_ieee802154_6lo_fragment, CONFIG_NET_L2_IEEE802154_LOG_LE
 
 #define FRAG_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_L2_IEEE802154_REASSEMBLY_TIMEOUT)
 #define REASS_CACHE_SIZE	CONFIG_NET_L2_IEEE802154_FRAGMENT_REASS_CACHE_SIZE
+#define REASS_BUCKETS		CONFIG_NET_L2_IEEE802154_FRAGMENT_REASS_BUCKETS
+#define REASS_PER_SRC_MAX	CONFIG_NET_L2_IEEE802154_FRAGMENT_REASS_PER_SRC_MAX
+
+/* The datagram size field has 11 bits, offsets count 8 octet units. */
+#define REASS_UNITS (BIT(11) >> 3)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(REASS_BUCKETS), "Reassembly hash buckets must be a power of two");
 
 /**
  *  Reassemble cache : Depends on cache size it used for reassemble
- *  IPv6 packets simultaneously.
+ *  IPv6 packets simultaneously. A datagram is identified by its link
+ *  layer source address, size and tag (RFC 4944, section 5.3), entries
+ *  are looked up through a hash table on these.
  */
 struct frag_cache {
+	sys_snode_t node;	       /* Hash bucket node */
 	struct k_work_delayable timer; /* Reassemble timer */
-	struct net_pkt *pkt;	       /* Reassemble packet */
+	struct net_pkt *pkt;	       /* Reassemble packet, fragments sorted by offset */
+	int64_t started;	       /* Uptime at reception of the first fragment */
+	uint32_t units[REASS_UNITS / 32]; /* Datagram units received, one bit each */
 	uint16_t size;		       /* Datagram size */
 	uint16_t tag;		       /* Datagram tag */
+	uint16_t received;	       /* Datagram octets received */
+	uint8_t src[IEEE802154_MAX_ADDR_LENGTH]; /* Link layer source address */
+	uint8_t src_len;
 	bool used;
 };
 
 static struct frag_cache cache[REASS_CACHE_SIZE];
+static sys_slist_t reass_table[REASS_BUCKETS];
+static struct ieee802154_6lo_reass_stats reass_stats;
+static K_MUTEX_DEFINE(reass_lock);
 
 /**
  *  RFC 4944, section 5.3
@@ -211,6 +230,62 @@ struct net_buf *ieee802154_6lo_fragment(struct ieee802154_6lo_fragment_ctx *ctx,
 	return ctx->buf;
 }
 
+#ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT_IN_PLACE
+/* Frames built in place only reference packet data. */
+NET_BUF_POOL_DEFINE(frame_ref_pool, 1, 0, 0, NULL);
+
+struct net_buf *ieee802154_6lo_fragment_in_place(struct ieee802154_6lo_fragment_ctx *ctx,
+						 struct net_buf *frame_buf, bool iphc)
+{
+	bool is_first_frag = !ctx->offset;
+	uint8_t hdr_len = frame_buf->len + (is_first_frag ? NET_6LO_FRAG1_HDR_LEN
+							   : NET_6LO_FRAGN_HDR_LEN);
+	uint8_t capacity = (frame_buf->size - hdr_len) & 0xF8;
+	uint8_t remainder = ctx->buf->len - (ctx->pos - ctx->buf->data);
+	uint8_t payload = capacity;
+	struct net_buf *frame;
+
+	if (is_first_frag) {
+		/* Same accounting as in ieee802154_6lo_fragment() */
+		if (iphc) {
+			payload -= ctx->hdr_diff;
+		} else {
+			payload += 1U;
+		}
+	}
+
+	/* The payload has to be contiguous and the headers have to fit in
+	 * front of it, either into the headroom or over payload that has
+	 * already been sent. Shared buffers must not be overwritten.
+	 */
+	if ((remainder < payload && ctx->buf->frags) ||
+	    ctx->pos - ctx->buf->__buf < hdr_len || ctx->buf->ref > 1) {
+		return NULL;
+	}
+
+	payload = MIN(payload, remainder);
+
+	frame = net_buf_alloc_with_data(&frame_ref_pool, ctx->pos - hdr_len, hdr_len + payload,
+					K_NO_WAIT);
+	if (!frame) {
+		return NULL;
+	}
+
+	/* Leave room for the link layer header, then add the fragment header
+	 * right in front of the payload which is already in place.
+	 */
+	frame->len = frame_buf->len;
+	set_up_frag_hdr(frame, ctx->pkt_size, ctx->offset);
+	net_buf_add(frame, payload);
+
+	ctx->processed += capacity;
+	update_fragment_ctx(ctx, payload);
+	ctx->offset = ctx->processed >> 3;
+
+	return frame;
+}
+#endif /* CONFIG_NET_L2_IEEE802154_FRAGMENT_IN_PLACE */
+
 static inline uint8_t get_datagram_type(uint8_t *ptr)
 {
 	return ptr[0] & NET_FRAG_DISPATCH_MASK;
@@ -256,25 +331,39 @@ static void update_protocol_header_lengths(struct net_pkt *pkt, uint16_t size)
 	}
 }
 
-static inline void clear_reass_cache(uint16_t size, uint16_t tag)
+static inline bool reass_src_equal(struct frag_cache *fcache, const uint8_t *src, uint8_t src_len)
 {
-	uint8_t i;
+	return fcache->src_len == src_len && !memcmp(fcache->src, src, src_len);
+}
 
-	for (i = 0U; i < REASS_CACHE_SIZE; i++) {
-		if (!(cache[i].size == size && cache[i].tag == tag)) {
-			continue;
-		}
+static inline sys_slist_t *reass_bucket(const uint8_t *src, uint8_t src_len, uint16_t size,
+					uint16_t tag)
+{
+	uint32_t hash = ((uint32_t)size << 16) | tag;
 
-		if (cache[i].pkt) {
-			net_pkt_unref(cache[i].pkt);
-		}
+	for (uint8_t i = 0U; i < src_len; i++) {
+		hash = (hash << 5) - hash + src[i];
+	}
+
+	hash *= 0x9e3779b1U;
+
+	return &reass_table[(hash >> 16) & (REASS_BUCKETS - 1)];
+}
+
+/* Must be called with reass_lock held. */
+static void reass_free(struct frag_cache *fcache)
+{
+	sys_slist_find_and_remove(reass_bucket(fcache->src, fcache->src_len, fcache->size,
+					       fcache->tag),
+				  &fcache->node);
 
-		cache[i].pkt = NULL;
-		cache[i].size = 0U;
-		cache[i].tag = 0U;
-		cache[i].used = false;
-		k_work_cancel_delayable(&cache[i].timer);
+	if (fcache->pkt) {
+		net_pkt_unref(fcache->pkt);
 	}
+
+	fcache->pkt = NULL;
+	fcache->used = false;
+	k_work_cancel_delayable(&fcache->timer);
 }
 
 /**
@@ -286,110 +375,137 @@ static void reass_timeout(struct k_work *work)
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct frag_cache *fcache = CONTAINER_OF(dwork, struct frag_cache, timer);
 
-	if (fcache->pkt) {
-		net_pkt_unref(fcache->pkt);
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	/* The entry may have been completed, evicted or even reused while
+	 * waiting for the lock.
+	 */
+	if (fcache->used && !k_work_delayable_is_pending(dwork)) {
+		reass_free(fcache);
+		reass_stats.timeouts++;
 	}
 
-	fcache->pkt = NULL;
-	fcache->size = 0U;
-	fcache->tag = 0U;
-	fcache->used = false;
+	k_mutex_unlock(&reass_lock);
 }
 
-/**
- *  Upon reception of first fragment with respective of size and tag
- *  create a new cache. If number of unused cache are out then
- *  discard the fragments.
- */
-static inline struct frag_cache *set_reass_cache(struct net_pkt *pkt, uint16_t size, uint16_t tag)
+/* Must be called with reass_lock held. */
+static void reass_init(void)
 {
-	int i;
-
-	for (i = 0; i < REASS_CACHE_SIZE; i++) {
-		if (cache[i].used) {
-			continue;
-		}
+	static bool initialized;
 
-		cache[i].pkt = pkt;
-		cache[i].size = size;
-		cache[i].tag = tag;
-		cache[i].used = true;
+	if (initialized) {
+		return;
+	}
 
+	for (int i = 0; i < REASS_CACHE_SIZE; i++) {
 		k_work_init_delayable(&cache[i].timer, reass_timeout);
-		k_work_reschedule(&cache[i].timer, FRAG_REASSEMBLY_TIMEOUT);
-		return &cache[i];
 	}
 
-	return NULL;
+	for (int i = 0; i < REASS_BUCKETS; i++) {
+		sys_slist_init(&reass_table[i]);
+	}
+
+	initialized = true;
 }
 
 /**
- *  Return cache if it matches with size and tag of stored caches,
- *  otherwise return NULL.
+ *  Return cache if it matches with source, size and tag of stored caches,
+ *  otherwise return NULL. Must be called with reass_lock held.
  */
-static inline struct frag_cache *get_reass_cache(uint16_t size, uint16_t tag)
+static struct frag_cache *get_reass_cache(const uint8_t *src, uint8_t src_len, uint16_t size,
+					  uint16_t tag)
 {
-	uint8_t i;
+	struct frag_cache *fcache;
 
-	for (i = 0U; i < REASS_CACHE_SIZE; i++) {
-		if (cache[i].used) {
-			if (cache[i].size == size && cache[i].tag == tag) {
-				return &cache[i];
-			}
+	SYS_SLIST_FOR_EACH_CONTAINER(reass_bucket(src, src_len, size, tag), fcache, node) {
+		if (fcache->size == size && fcache->tag == tag &&
+		    reass_src_equal(fcache, src, src_len)) {
+			return fcache;
 		}
 	}
 
 	return NULL;
 }
 
-static inline void fragment_append(struct net_pkt *pkt, struct net_buf *frag)
+/**
+ *  Upon reception of the first fragment of a datagram create a new cache.
+ *  If the source already reassembles too many datagrams the fragment is
+ *  discarded, otherwise the oldest reassembly gives way if the cache is
+ *  full. Must be called with reass_lock held.
+ */
+static struct frag_cache *set_reass_cache(struct net_pkt *pkt, const uint8_t *src,
+					  uint8_t src_len, uint16_t size, uint16_t tag)
 {
-	if (get_datagram_type(frag->data) == NET_6LO_DISPATCH_FRAG1) {
-		/* Always make sure first fragment is inserted first
-		 * This will be useful for fragment_cached_pkt_len()
-		 */
-		frag->frags = pkt->buffer;
-		pkt->buffer = frag;
-	} else {
-		net_pkt_append_buffer(pkt, frag);
-	}
-}
+	struct frag_cache *fcache = NULL, *oldest = NULL;
+	int from_src = 0;
 
-static inline size_t fragment_cached_pkt_len(struct net_pkt *pkt)
-{
-	size_t len = 0U;
-	struct net_buf *frag;
-	int hdr_diff;
-	uint8_t *data;
+	for (int i = 0; i < REASS_CACHE_SIZE; i++) {
+		if (!cache[i].used) {
+			if (!fcache) {
+				fcache = &cache[i];
+			}
 
-	frag = pkt->buffer;
-	while (frag) {
-		uint16_t frag_hdr_len = NET_6LO_FRAGN_HDR_LEN;
+			continue;
+		}
 
-		if (get_datagram_type(frag->data) == NET_6LO_DISPATCH_FRAG1) {
-			frag_hdr_len = NET_6LO_FRAG1_HDR_LEN;
+		if (reass_src_equal(&cache[i], src, src_len)) {
+			from_src++;
+		}
+
+		if (!oldest || cache[i].started < oldest->started) {
+			oldest = &cache[i];
 		}
+	}
 
-		len += frag->len - frag_hdr_len;
+	if (REASS_PER_SRC_MAX && from_src >= REASS_PER_SRC_MAX) {
+		reass_stats.src_limited++;
+		return NULL;
+	}
 
-		frag = frag->frags;
+	if (!fcache) {
+		NET_DBG("Evicting reassembly of tag %u", oldest->tag);
+		reass_free(oldest);
+		reass_stats.evicted++;
+		fcache = oldest;
 	}
 
-	/* 6lo assumes that fragment header has been removed,
-	 * and in our side we assume first buffer is always the first fragment.
-	 */
-	data = pkt->buffer->data;
-	pkt->buffer->data += NET_6LO_FRAG1_HDR_LEN;
+	fcache->pkt = pkt;
+	fcache->size = size;
+	fcache->tag = tag;
+	fcache->received = 0U;
+	fcache->started = k_uptime_get();
+	fcache->src_len = src_len;
+	memcpy(fcache->src, src, src_len);
+	memset(fcache->units, 0, sizeof(fcache->units));
+	fcache->used = true;
 
-	hdr_diff = net_6lo_uncompress_hdr_diff(pkt);
+	sys_slist_prepend(reass_bucket(src, src_len, size, tag), &fcache->node);
+	k_work_reschedule(&fcache->timer, FRAG_REASSEMBLY_TIMEOUT);
 
-	pkt->buffer->data = data;
+	return fcache;
+}
 
-	if (hdr_diff == INT_MAX) {
-		return 0;
+/**
+ *  Mark the 8 octet units of the datagram covered by a fragment as
+ *  received. Returns false without marking anything if the fragment
+ *  overlaps with data that has been received already.
+ */
+static bool reass_mark_units(struct frag_cache *fcache, uint16_t offset, uint16_t len)
+{
+	uint16_t first = offset >> 3;
+	uint16_t last = (offset + len - 1U) >> 3;
+
+	for (uint16_t unit = first; unit <= last; unit++) {
+		if (fcache->units[unit / 32U] & BIT(unit % 32U)) {
+			return false;
+		}
+	}
+
+	for (uint16_t unit = first; unit <= last; unit++) {
+		fcache->units[unit / 32U] |= BIT(unit % 32U);
 	}
 
-	return len + hdr_diff;
+	return true;
 }
 
 static inline uint16_t fragment_offset(struct net_buf *frag)
@@ -401,26 +517,26 @@ static inline uint16_t fragment_offset(struct net_buf *frag)
 	return ((uint16_t)frag->data[NET_FRAG_OFFSET_POS] << 3);
 }
 
-static void fragment_move_back(struct net_pkt *pkt, struct net_buf *frag, struct net_buf *stop)
+/* Keep the fragments sorted by offset, so that no reordering is needed
+ * once the datagram is complete.
+ */
+static void fragment_insert(struct net_pkt *pkt, struct net_buf *frag)
 {
-	struct net_buf *prev, *current;
-
-	prev = NULL;
-	current = pkt->buffer;
-
-	while (current && current != stop) {
-		if (fragment_offset(frag) < fragment_offset(current)) {
-			if (prev) {
-				prev->frags = frag;
-			}
-
-			frag->frags = current;
-			break;
-		}
+	uint16_t offset = fragment_offset(frag);
+	struct net_buf *prev = NULL, *current = pkt->buffer;
 
+	while (current && fragment_offset(current) < offset) {
 		prev = current;
 		current = current->frags;
 	}
+
+	frag->frags = current;
+
+	if (prev) {
+		prev->frags = frag;
+	} else {
+		pkt->buffer = frag;
+	}
 }
 
 static inline void fragment_remove_headers(struct net_pkt *pkt)
@@ -442,32 +558,33 @@ static inline void fragment_remove_headers(struct net_pkt *pkt)
 	}
 }
 
-static inline void fragment_reconstruct_packet(struct net_pkt *pkt)
+static inline bool fragment_packet_valid(struct net_pkt *pkt)
 {
-	struct net_buf *prev, *current, *next;
+	return (get_datagram_type(pkt->buffer->data) == NET_6LO_DISPATCH_FRAG1);
+}
 
-	prev = NULL;
-	current = pkt->buffer;
+/**
+ *  Returns the number of datagram octets carried by the given fragment,
+ *  zero if the fragment is invalid.
+ */
+static uint16_t fragment_datagram_len(struct net_pkt *pkt, struct net_buf *frag)
+{
+	int hdr_diff;
 
-	while (current) {
-		next = current->frags;
+	if (get_datagram_type(frag->data) != NET_6LO_DISPATCH_FRAG1) {
+		return frag->len - NET_6LO_FRAGN_HDR_LEN;
+	}
 
-		if (!prev || (fragment_offset(prev) > fragment_offset(current))) {
-			prev = current;
-		} else {
-			fragment_move_back(pkt, current, prev);
-		}
+	/* 6lo assumes that the fragment header has been removed. */
+	net_buf_pull(frag, NET_6LO_FRAG1_HDR_LEN);
+	hdr_diff = net_6lo_uncompress_hdr_diff(pkt);
+	net_buf_push(frag, NET_6LO_FRAG1_HDR_LEN);
 
-		current = next;
+	if (hdr_diff == INT_MAX) {
+		return 0U;
 	}
 
-	/* Let's remove now useless fragmentation headers */
-	fragment_remove_headers(pkt);
-}
-
-static inline bool fragment_packet_valid(struct net_pkt *pkt)
-{
-	return (get_datagram_type(pkt->buffer->data) == NET_6LO_DISPATCH_FRAG1);
+	return frag->len - NET_6LO_FRAG1_HDR_LEN + hdr_diff;
 }
 
 /**
@@ -480,11 +597,15 @@ static inline bool fragment_packet_valid(struct net_pkt *pkt)
  */
 static inline enum net_verdict fragment_add_to_cache(struct net_pkt *pkt)
 {
+	struct net_linkaddr *lladdr = net_pkt_lladdr_src(pkt);
+	uint8_t src_len = lladdr->addr ? MIN(lladdr->len, IEEE802154_MAX_ADDR_LENGTH) : 0U;
 	bool first_frag = false;
 	struct frag_cache *fcache;
 	struct net_buf *frag;
+	uint16_t offset;
 	uint16_t size;
 	uint16_t tag;
+	uint16_t len;
 	uint8_t type;
 
 	frag = pkt->buffer;
@@ -501,68 +622,103 @@ static inline enum net_verdict fragment_add_to_cache(struct net_pkt *pkt)
 	/* Parse the datagram tag */
 	tag = get_datagram_tag(frag->data + NET_6LO_FRAG_DATAGRAM_SIZE_LEN);
 
+	offset = fragment_offset(frag);
+	len = fragment_datagram_len(pkt, frag);
+
+	/* Subsequent fragments at offset zero would overlap the first one. */
+	if (!len || offset + len > size || (type != NET_6LO_DISPATCH_FRAG1 && !offset)) {
+		NET_DBG("Invalid fragment of tag %u", tag);
+		k_mutex_lock(&reass_lock, K_FOREVER);
+		reass_stats.invalid++;
+		k_mutex_unlock(&reass_lock);
+		return NET_DROP;
+	}
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	reass_init();
+
 	/* If there are no fragments in the cache means this frag
 	 * is the first one. So cache Rx pkt otherwise not.
 	 */
-	pkt->buffer = NULL;
-
-	fcache = get_reass_cache(size, tag);
+	fcache = get_reass_cache(lladdr->addr, src_len, size, tag);
 	if (!fcache) {
-		fcache = set_reass_cache(pkt, size, tag);
+		fcache = set_reass_cache(pkt, lladdr->addr, src_len, size, tag);
 		if (!fcache) {
-			NET_ERR("Could not get a cache entry");
-			pkt->buffer = frag;
+			k_mutex_unlock(&reass_lock);
+			NET_DBG("Could not get a cache entry");
 			return NET_DROP;
 		}
 
 		first_frag = true;
 	}
 
-	fragment_append(fcache->pkt, frag);
+	if (!reass_mark_units(fcache, offset, len)) {
+		reass_stats.duplicates++;
+		k_mutex_unlock(&reass_lock);
+		NET_DBG("Duplicate fragment of tag %u at offset %u", tag, offset);
+		return NET_DROP;
+	}
 
-	if (fragment_cached_pkt_len(fcache->pkt) == fcache->size) {
-		if (!first_frag) {
-			/* Assign buffer back to input packet. */
-			pkt->buffer = fcache->pkt->buffer;
-			fcache->pkt->buffer = NULL;
-		} else {
-			/* in case pkt == fcache->pkt, we don't want
-			 * to unref it while clearing the cach.
-			 */
-			fcache->pkt = NULL;
-		}
+	pkt->buffer = NULL;
+	fragment_insert(fcache->pkt, frag);
+	fcache->received += len;
 
-		clear_reass_cache(size, tag);
+	if (fcache->received < fcache->size) {
+		k_mutex_unlock(&reass_lock);
 
-		if (!fragment_packet_valid(pkt)) {
-			NET_ERR("Invalid fragmented packet");
-			return NET_DROP;
+		/* Unref Rx part of original packet */
+		if (!first_frag) {
+			net_pkt_unref(pkt);
 		}
 
-		fragment_reconstruct_packet(pkt);
+		return NET_OK;
+	}
 
-		if (!net_6lo_uncompress(pkt)) {
-			NET_ERR("Could not uncompress. Bogus packet?");
-			return NET_DROP;
-		}
+	if (!first_frag) {
+		/* Assign buffer back to input packet. */
+		pkt->buffer = fcache->pkt->buffer;
+		fcache->pkt->buffer = NULL;
+	} else {
+		/* in case pkt == fcache->pkt, we don't want
+		 * to unref it while clearing the cache.
+		 */
+		fcache->pkt = NULL;
+	}
 
-		net_pkt_cursor_init(pkt);
+	reass_free(fcache);
+	reass_stats.reassembled++;
 
-		update_protocol_header_lengths(pkt, size);
+	k_mutex_unlock(&reass_lock);
 
-		net_pkt_cursor_init(pkt);
+	if (!fragment_packet_valid(pkt)) {
+		NET_ERR("Invalid fragmented packet");
+		return NET_DROP;
+	}
 
-		NET_DBG("All fragments received and reassembled");
+	fragment_remove_headers(pkt);
 
-		return NET_CONTINUE;
+	if (!net_6lo_uncompress(pkt)) {
+		NET_ERR("Could not uncompress. Bogus packet?");
+		return NET_DROP;
 	}
 
-	/* Unref Rx part of original packet */
-	if (!first_frag) {
-		net_pkt_unref(pkt);
-	}
+	net_pkt_cursor_init(pkt);
+
+	update_protocol_header_lengths(pkt, size);
 
-	return NET_OK;
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("All fragments received and reassembled");
+
+	return NET_CONTINUE;
+}
+
+void ieee802154_6lo_reass_stats_get(struct ieee802154_6lo_reass_stats *stats)
+{
+	k_mutex_lock(&reass_lock, K_FOREVER);
+	*stats = reass_stats;
+	k_mutex_unlock(&reass_lock);
 }
 
 enum net_verdict ieee802154_6lo_reassemble(struct net_pkt *pkt)
@@ -56,6 +56,60 @@ static inline void ieee802154_6lo_fragment_ctx_init(struct ieee802154_6lo_fragme
 struct net_buf *ieee802154_6lo_fragment(struct ieee802154_6lo_fragment_ctx *ctx,
 					struct net_buf *frame_buf, bool iphc);
 
+#ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT_IN_PLACE
+/**
+ *  @brief Set up the next fragment in place, without copying the payload
+ *
+ *  @details Writes the fragment header in front of the next payload slice
+ *  inside the packet buffer and returns a buffer referencing the frame
+ *  (link layer header space, fragment header and payload). The bytes in
+ *  front of the slice are overwritten, so the previous fragment must have
+ *  been sent already. The returned buffer must be released before the next
+ *  fragment is set up.
+ *
+ *  @param ctx Pointer to valid fragmentation context
+ *  @param frame_buf Frame buffer containing the link layer header space,
+ *         used as a template for the frame layout only
+ *  @param iphc bool true for IPHC compression, false for IPv6 dispatch header
+ *
+ *  @return referencing frame buffer, NULL if the fragment cannot be built in
+ *          place and ieee802154_6lo_fragment() has to be used instead. The
+ *          context is only updated on success.
+ */
+struct net_buf *ieee802154_6lo_fragment_in_place(struct ieee802154_6lo_fragment_ctx *ctx,
+						 struct net_buf *frame_buf, bool iphc);
+#else
+static inline struct net_buf *
+ieee802154_6lo_fragment_in_place(struct ieee802154_6lo_fragment_ctx *ctx,
+				 struct net_buf *frame_buf, bool iphc)
+{
+	return NULL;
+}
+#endif /* CONFIG_NET_L2_IEEE802154_FRAGMENT_IN_PLACE */
+
+/** Reassembly statistics */
+struct ieee802154_6lo_reass_stats {
+	/** Datagrams reassembled successfully */
+	uint32_t reassembled;
+	/** Partial datagrams discarded on reassembly timeout */
+	uint32_t timeouts;
+	/** Partial datagrams discarded to make room for a new one */
+	uint32_t evicted;
+	/** Datagrams discarded as their source exceeded its reassembly limit */
+	uint32_t src_limited;
+	/** Fragments discarded as duplicate or overlapping */
+	uint32_t duplicates;
+	/** Fragments discarded as malformed */
+	uint32_t invalid;
+};
+
+/**
+ *  @brief Get a snapshot of the reassembly statistics
+ *
+ *  @param stats Filled with the current statistics
+ */
+void ieee802154_6lo_reass_stats_get(struct ieee802154_6lo_reass_stats *stats);
+
 /**
  *  @brief Reassemble 802.15.4 fragments as per RFC 6282
  *
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 radio arbiter
+ *
+ * The radio is owned by one interface at a time. Interfaces asking for it
+ * while it is owned wait in a list sorted by deadline and the radio goes
+ * to the head of the list when its owner gives it up. While nobody owns
+ * the radio, its receiver is handed from one member to the next every
+ * CONFIG_NET_L2_IEEE802154_ARBITER_RX_SLOT milliseconds.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_arbiter, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_arbiter.h>
+#include <zephyr/net/net_if.h>
+
+#include <errno.h>
+
+#include "ieee802154_arbiter.h"
+#include "ieee802154_utils.h"
+
+struct arbiter_waiter {
+	sys_dnode_t node;
+	struct net_if *iface;
+	uint32_t deadline;
+	struct k_sem granted;
+};
+
+static inline struct ieee802154_arbiter_member *arbiter_member(struct net_if *iface)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+	return &ctx->arbiter_member;
+}
+
+/* Must be called with the arbiter's lock held. */
+static void arbiter_rx_slot_schedule(struct ieee802154_arbiter *arbiter)
+{
+	if (CONFIG_NET_L2_IEEE802154_ARBITER_RX_SLOT == 0 || arbiter->owner ||
+	    sys_slist_peek_head(&arbiter->members) == sys_slist_peek_tail(&arbiter->members)) {
+		return;
+	}
+
+	k_work_reschedule(&arbiter->rx_slot, K_MSEC(CONFIG_NET_L2_IEEE802154_ARBITER_RX_SLOT));
+}
+
+/* Restores the radio settings of an interface taking the radio over from
+ * another one. Must be called by the owner of the radio.
+ */
+static void arbiter_configure(struct ieee802154_arbiter *arbiter, struct net_if *iface)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	struct net_if *previous = arbiter->configured;
+
+	if (previous == iface) {
+		return;
+	}
+
+	NET_DBG("Radio switching from iface %p to %p", previous, iface);
+
+	if (previous) {
+		struct ieee802154_context *previous_ctx = net_if_l2_data(previous);
+		uint16_t pan_id;
+
+		k_sem_take(&previous_ctx->ctx_lock, K_FOREVER);
+		pan_id = previous_ctx->pan_id;
+		k_sem_give(&previous_ctx->ctx_lock);
+
+		ieee802154_radio_remove_pan_id(previous, pan_id);
+	}
+
+	k_sem_take(&ctx->ctx_lock, K_FOREVER);
+
+	if (ctx->channel != IEEE802154_NO_CHANNEL) {
+		ieee802154_radio_set_channel(iface, ctx->channel);
+	}
+
+	ieee802154_radio_set_tx_power(iface, ctx->tx_power);
+	ieee802154_radio_filter_pan_id(iface, ctx->pan_id);
+	ieee802154_radio_filter_short_addr(iface, ctx->short_addr);
+	ieee802154_radio_filter_ieee_addr(iface, ctx->ext_addr);
+
+	k_sem_give(&ctx->ctx_lock);
+
+	arbiter->configured = iface;
+}
+
+static void arbiter_rx_slot_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ieee802154_arbiter *arbiter =
+		CONTAINER_OF(dwork, struct ieee802154_arbiter, rx_slot);
+	struct ieee802154_arbiter_member *next = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&arbiter->lock);
+
+	if (!arbiter->owner) {
+		if (arbiter->configured) {
+			next = SYS_SLIST_PEEK_NEXT_CONTAINER(arbiter_member(arbiter->configured),
+							     node);
+		}
+
+		if (!next) {
+			next = SYS_SLIST_PEEK_HEAD_CONTAINER(&arbiter->members, next, node);
+		}
+	}
+
+	if (next) {
+		arbiter->owner = next->iface;
+		arbiter->depth = 1U;
+	}
+
+	k_spin_unlock(&arbiter->lock, key);
+
+	if (next) {
+		/* The radio is only taken while idle, the release reschedules
+		 * the next slot or hands the radio to an interface that asked
+		 * for it in the meantime.
+		 */
+		arbiter_configure(arbiter, next->iface);
+		ieee802154_arbiter_release(next->iface);
+	}
+}
+
+int ieee802154_arbiter_attach(struct ieee802154_arbiter *arbiter, struct net_if *iface,
+			      uint32_t latency_budget_ms)
+{
+	struct ieee802154_arbiter_member *member = arbiter_member(iface);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&arbiter->lock);
+
+	if (member->arbiter) {
+		k_spin_unlock(&arbiter->lock, key);
+		return -EALREADY;
+	}
+
+	if (!arbiter->initialized) {
+		sys_dlist_init(&arbiter->waiters);
+		k_work_init_delayable(&arbiter->rx_slot, arbiter_rx_slot_handler);
+		arbiter->initialized = true;
+	}
+
+	member->arbiter = arbiter;
+	member->iface = iface;
+	member->latency_budget_ms = latency_budget_ms;
+	sys_slist_append(&arbiter->members, &member->node);
+
+	arbiter_rx_slot_schedule(arbiter);
+
+	k_spin_unlock(&arbiter->lock, key);
+
+	NET_DBG("iface %p attached to arbiter %p", iface, arbiter);
+
+	return 0;
+}
+
+void ieee802154_arbiter_detach(struct net_if *iface)
+{
+	struct ieee802154_arbiter_member *member = arbiter_member(iface);
+	struct ieee802154_arbiter *arbiter = member->arbiter;
+	k_spinlock_key_t key;
+
+	if (!arbiter) {
+		return;
+	}
+
+	key = k_spin_lock(&arbiter->lock);
+
+	__ASSERT_NO_MSG(arbiter->owner != iface);
+
+	sys_slist_find_and_remove(&arbiter->members, &member->node);
+	member->arbiter = NULL;
+
+	if (arbiter->configured == iface) {
+		arbiter->configured = NULL;
+	}
+
+	k_spin_unlock(&arbiter->lock, key);
+}
+
+struct net_if *ieee802154_arbiter_rx_iface(struct ieee802154_arbiter *arbiter)
+{
+	struct ieee802154_arbiter_member *first;
+	struct net_if *iface;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&arbiter->lock);
+
+	iface = arbiter->configured;
+	if (!iface) {
+		first = SYS_SLIST_PEEK_HEAD_CONTAINER(&arbiter->members, first, node);
+		iface = first ? first->iface : NULL;
+	}
+
+	k_spin_unlock(&arbiter->lock, key);
+
+	return iface;
+}
+
+/* Must be called with the arbiter's lock held. */
+static void arbiter_wait_insert(struct ieee802154_arbiter *arbiter, struct arbiter_waiter *waiter)
+{
+	struct arbiter_waiter *pos;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&arbiter->waiters, pos, node) {
+		if ((int32_t)(waiter->deadline - pos->deadline) < 0) {
+			sys_dlist_insert(&pos->node, &waiter->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&arbiter->waiters, &waiter->node);
+}
+
+int ieee802154_arbiter_acquire(struct net_if *iface)
+{
+	struct ieee802154_arbiter_member *member = arbiter_member(iface);
+	struct ieee802154_arbiter *arbiter = member->arbiter;
+	struct arbiter_waiter waiter;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (!arbiter) {
+		return 0;
+	}
+
+	key = k_spin_lock(&arbiter->lock);
+
+	if (arbiter->owner == iface) {
+		arbiter->depth++;
+		k_spin_unlock(&arbiter->lock, key);
+		return 0;
+	}
+
+	if (!arbiter->owner) {
+		arbiter->owner = iface;
+		arbiter->depth = 1U;
+		k_spin_unlock(&arbiter->lock, key);
+		goto granted;
+	}
+
+	waiter.iface = iface;
+	waiter.deadline = k_uptime_get_32() + member->latency_budget_ms;
+	k_sem_init(&waiter.granted, 0, 1);
+	arbiter_wait_insert(arbiter, &waiter);
+
+	k_spin_unlock(&arbiter->lock, key);
+
+	ret = k_sem_take(&waiter.granted, K_MSEC(CONFIG_NET_L2_IEEE802154_ARBITER_TIMEOUT));
+
+	key = k_spin_lock(&arbiter->lock);
+
+	/* The radio may have been handed over right after the timeout. */
+	if (ret && arbiter->owner != iface) {
+		sys_dlist_remove(&waiter.node);
+		k_spin_unlock(&arbiter->lock, key);
+
+		NET_DBG("iface %p timed out waiting for the radio", iface);
+		return -EBUSY;
+	}
+
+	k_spin_unlock(&arbiter->lock, key);
+
+granted:
+	arbiter_configure(arbiter, iface);
+
+	return 0;
+}
+
+void ieee802154_arbiter_release(struct net_if *iface)
+{
+	struct ieee802154_arbiter *arbiter = arbiter_member(iface)->arbiter;
+	struct arbiter_waiter *next;
+	k_spinlock_key_t key;
+
+	if (!arbiter) {
+		return;
+	}
+
+	key = k_spin_lock(&arbiter->lock);
+
+	__ASSERT_NO_MSG(arbiter->owner == iface && arbiter->depth > 0U);
+
+	if (--arbiter->depth > 0U) {
+		k_spin_unlock(&arbiter->lock, key);
+		return;
+	}
+
+	next = SYS_DLIST_PEEK_HEAD_CONTAINER(&arbiter->waiters, next, node);
+	if (next) {
+		sys_dlist_remove(&next->node);
+		arbiter->owner = next->iface;
+		arbiter->depth = 1U;
+		k_sem_give(&next->granted);
+	} else {
+		arbiter->owner = NULL;
+		arbiter_rx_slot_schedule(arbiter);
+	}
+
+	k_spin_unlock(&arbiter->lock, key);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Private IEEE 802.15.4 radio arbiter helpers
+ *
+ * These utilities are internal to the native IEEE 802.15.4 L2
+ * stack and must not be included and used elsewhere.
+ */
+
+#ifndef __IEEE802154_ARBITER_H__
+#define __IEEE802154_ARBITER_H__
+
+#include <zephyr/net/ieee802154_arbiter.h>
+#include <zephyr/net/net_if.h>
+
+#ifdef CONFIG_NET_L2_IEEE802154_ARBITER
+
+/**
+ * @brief Obtains the radio for an interface.
+ *
+ * Blocks until the radio is granted, and restores the radio settings of
+ * the interface if another interface used the radio since. Calls nest, the
+ * radio is given up by the last matching ieee802154_arbiter_release().
+ *
+ * No-op for interfaces not attached to an arbiter.
+ *
+ * @param iface A valid pointer on a network interface
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if the radio could not be obtained within
+ *         CONFIG_NET_L2_IEEE802154_ARBITER_TIMEOUT
+ */
+int ieee802154_arbiter_acquire(struct net_if *iface);
+
+/**
+ * @brief Gives up the radio obtained by ieee802154_arbiter_acquire().
+ *
+ * @param iface A valid pointer on a network interface
+ */
+void ieee802154_arbiter_release(struct net_if *iface);
+
+#else
+
+static inline int ieee802154_arbiter_acquire(struct net_if *iface)
+{
+	return 0;
+}
+
+static inline void ieee802154_arbiter_release(struct net_if *iface)
+{
+}
+
+#endif /* CONFIG_NET_L2_IEEE802154_ARBITER */
+
+#endif /* __IEEE802154_ARBITER_H__ */
@@ -0,0 +1,613 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * All references to the spec refer to IEEE 802.15.4-2020.
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 CSL engine, see section 6.12.2.
+ *
+ * Receiver: the CSL IE of enhanced ACKs and the CSL phase injection are
+ * offloaded to the driver as described for @ref
+ * IEEE802154_CONFIG_CSL_PERIOD. A dedicated thread wakes up shortly
+ * before each channel sample and schedules it with @ref
+ * IEEE802154_CONFIG_RX_SLOT. Channel samples are centered on the
+ * expected RX times of the CSL period grid.
+ *
+ * Transmitter: the CSL phase and period of each CSL receiver are learned
+ * from the CSL IEs of its frames and enhanced ACKs. Unicast frames to a
+ * known CSL receiver are sent with @ref IEEE802154_TX_MODE_TXTIME_CCA
+ * right into its next channel sample, all other frames use the regular
+ * channel access method.
+ *
+ * All times are end of SFD timestamps in the network subsystem's local
+ * clock. CSL phases refer to the start of the MHR, the PHR duration
+ * cancels out as it is the same for all frames.
+ *
+ * Only one interface can run the CSL receiver at a time.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_csl, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_csl.h>
+#include <zephyr/net/ieee802154_ie.h>
+#include <zephyr/net/ieee802154_radio.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "ieee802154_csl.h"
+#include "ieee802154_frame.h"
+#include "ieee802154_priv.h"
+#include "ieee802154_utils.h"
+
+/* CSL phases and periods are given in units of 10 symbols, see section
+ * 8.4.3.6, table 8-104, macCslPeriod.
+ */
+#define CSL_UNIT_SYMBOLS 10U
+
+#define CSL_SAMPLE_NS ((net_time_t)CONFIG_NET_L2_IEEE802154_CSL_SAMPLE_DURATION * NSEC_PER_USEC)
+
+/* How long before a channel sample or transmission the engine has to be
+ * awake.
+ */
+#define CSL_WAKEUP_LEAD_NS (1000 * NSEC_PER_USEC)
+
+enum csl_flags {
+	CSL_RECEIVING,
+};
+
+struct csl_peer {
+	struct net_if *iface;
+	/* Link layer address, in big endian like struct net_linkaddr */
+	uint8_t addr[IEEE802154_MAX_ADDR_LENGTH];
+	uint8_t addr_len;
+	/* End of SFD of a frame arriving in the center of a channel sample */
+	net_time_t anchor;
+	net_time_t period_ns;
+	/* Time of the last update, in seconds since boot */
+	uint32_t last_update;
+	bool in_use;
+};
+
+static K_MUTEX_DEFINE(csl_lock);
+static K_SEM_DEFINE(csl_wakeup, 0, 1);
+
+/* ACKs may be handled in the driver's context, so the peer table is
+ * guarded by a spinlock.
+ */
+static struct k_spinlock csl_peer_lock;
+
+static K_KERNEL_STACK_DEFINE(csl_stack, CONFIG_NET_L2_IEEE802154_CSL_STACK_SIZE);
+static struct k_thread csl_thread_data;
+
+/* CSL IE handed over to the driver, the phase is injected by the driver. */
+static struct ieee802154_header_ie csl_ack_ie;
+
+/* The receiver state is guarded by csl_lock, the peers and the last
+ * transmission's destination by csl_peer_lock.
+ */
+static struct {
+	struct net_if *iface;
+	atomic_t flags;
+
+	net_time_t period_ns;
+	/* Expected RX time of the next channel sample */
+	net_time_t next_sample;
+	bool thread_started;
+
+	struct csl_peer peers[CONFIG_NET_L2_IEEE802154_CSL_MAX_PEERS];
+
+	/* Destination of the last transmission, in big endian */
+	uint8_t tx_dst[IEEE802154_MAX_ADDR_LENGTH];
+	uint8_t tx_dst_len;
+} csl;
+
+static net_time_t csl_unit_ns(struct net_if *iface)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+	return ieee802154_radio_get_multiple_of_symbol_period(iface, ctx->channel,
+							      CSL_UNIT_SYMBOLS);
+}
+
+static inline bool csl_peer_is_expired(struct csl_peer *peer, uint32_t now)
+{
+	return now - peer->last_update >= CONFIG_NET_L2_IEEE802154_CSL_PEER_TIMEOUT;
+}
+
+/* Must be called with csl_peer_lock held. */
+static struct csl_peer *csl_peer_get(struct net_if *iface, const uint8_t *addr, uint8_t len,
+				     uint32_t now)
+{
+	ARRAY_FOR_EACH_PTR(csl.peers, peer) {
+		if (!peer->in_use || peer->iface != iface || peer->addr_len != len ||
+		    memcmp(peer->addr, addr, len)) {
+			continue;
+		}
+
+		if (csl_peer_is_expired(peer, now)) {
+			peer->in_use = false;
+			return NULL;
+		}
+
+		return peer;
+	}
+
+	return NULL;
+}
+
+/* Must be called with csl_peer_lock held. */
+static struct csl_peer *csl_peer_alloc(uint32_t now)
+{
+	struct csl_peer *oldest = NULL;
+
+	ARRAY_FOR_EACH_PTR(csl.peers, peer) {
+		if (!peer->in_use || csl_peer_is_expired(peer, now)) {
+			return peer;
+		}
+
+		if (oldest == NULL || (int32_t)(peer->last_update - oldest->last_update) < 0) {
+			oldest = peer;
+		}
+	}
+
+	return oldest;
+}
+
+/* The header IE list has been validated already. */
+static struct ieee802154_header_ie *csl_find_ie(struct ieee802154_mhr *mhr)
+{
+	uint8_t *p_buf = (uint8_t *)mhr->header_ie;
+	uint8_t remaining = mhr->header_ie_length;
+
+	while (remaining >= IEEE802154_HEADER_IE_HEADER_LENGTH) {
+		struct ieee802154_header_ie *ie = (struct ieee802154_header_ie *)p_buf;
+		uint8_t ie_len = IEEE802154_HEADER_IE_HEADER_LENGTH + ie->length;
+
+		if (ieee802154_header_ie_get_element_id(ie) ==
+			    IEEE802154_HEADER_IE_ELEMENT_ID_CSL_IE &&
+		    ie->length >= sizeof(struct ieee802154_header_ie_csl_reduced)) {
+			return ie;
+		}
+
+		p_buf += ie_len;
+		remaining -= ie_len;
+	}
+
+	return NULL;
+}
+
+/* Copies the source address of the frame in big endian. */
+static bool csl_src_addr(struct ieee802154_mhr *mhr, uint8_t *addr, uint8_t *len)
+{
+	struct ieee802154_fcf_seq *fs = mhr->fs;
+	struct ieee802154_address *src = fs->fc.pan_id_comp ? &mhr->src_addr->comp.addr
+							    : &mhr->src_addr->plain.addr;
+
+	switch (fs->fc.src_addr_mode) {
+	case IEEE802154_ADDR_MODE_EXTENDED:
+		sys_memcpy_swap(addr, src->ext_addr, IEEE802154_EXT_ADDR_LENGTH);
+		*len = IEEE802154_EXT_ADDR_LENGTH;
+		return true;
+
+	case IEEE802154_ADDR_MODE_SHORT:
+		sys_put_be16(sys_le16_to_cpu(src->short_addr), addr);
+		*len = IEEE802154_SHORT_ADDR_LENGTH;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+static void csl_learn(struct net_if *iface, struct ieee802154_mhr *mhr,
+		      struct ieee802154_header_ie *ie, net_time_t rx_time, bool is_ack)
+{
+	uint16_t phase = sys_le16_to_cpu(ie->content.csl.reduced.csl_phase);
+	uint16_t period = sys_le16_to_cpu(ie->content.csl.reduced.csl_period);
+	net_time_t unit = csl_unit_ns(iface);
+	uint32_t now = k_uptime_seconds();
+	uint8_t addr[IEEE802154_MAX_ADDR_LENGTH];
+	struct csl_peer *peer;
+	k_spinlock_key_t key;
+	uint8_t len;
+
+	if (rx_time == 0 || unit == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&csl_peer_lock);
+
+	if (!csl_src_addr(mhr, addr, &len)) {
+		/* Enhanced ACKs usually omit the source address. */
+		if (!is_ack || csl.tx_dst_len == 0U) {
+			goto out;
+		}
+
+		len = csl.tx_dst_len;
+		memcpy(addr, csl.tx_dst, len);
+	}
+
+	peer = csl_peer_get(iface, addr, len, now);
+
+	/* A zero period announces that the peer stopped sampling. */
+	if (period == 0U) {
+		if (peer) {
+			peer->in_use = false;
+		}
+
+		goto out;
+	}
+
+	if (!peer) {
+		peer = csl_peer_alloc(now);
+		peer->iface = iface;
+		memcpy(peer->addr, addr, len);
+		peer->addr_len = len;
+		peer->in_use = true;
+	}
+
+	peer->anchor = rx_time + phase * unit;
+	peer->period_ns = period * unit;
+	peer->last_update = now;
+
+out:
+	k_spin_unlock(&csl_peer_lock, key);
+}
+
+void ieee802154_csl_rx_track(struct net_if *iface, struct net_pkt *pkt,
+			     struct ieee802154_mpdu *mpdu)
+{
+	struct ieee802154_header_ie *ie = csl_find_ie(&mpdu->mhr);
+
+	if (ie) {
+		csl_learn(iface, &mpdu->mhr, ie, net_pkt_timestamp_ns(pkt), false);
+	}
+}
+
+void ieee802154_csl_handle_ack(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct ieee802154_header_ie *ie;
+	struct ieee802154_mpdu mpdu;
+
+	if (!ieee802154_validate_frame(net_pkt_data(pkt), net_pkt_get_len(pkt), &mpdu) ||
+	    mpdu.mhr.fs->fc.frame_type != IEEE802154_FRAME_TYPE_ACK) {
+		return;
+	}
+
+	ie = csl_find_ie(&mpdu.mhr);
+	if (ie) {
+		csl_learn(iface, &mpdu.mhr, ie, net_pkt_timestamp_ns(pkt), true);
+	}
+}
+
+int ieee802154_csl_next_rendezvous(struct net_if *iface, const struct net_linkaddr *dst,
+				   net_time_t after, net_time_t *tx_time)
+{
+	struct csl_peer *peer;
+	k_spinlock_key_t key;
+	net_time_t time;
+
+	if (dst->addr == NULL || dst->len > IEEE802154_MAX_ADDR_LENGTH) {
+		return -ENOENT;
+	}
+
+	key = k_spin_lock(&csl_peer_lock);
+
+	peer = csl_peer_get(iface, dst->addr, dst->len, k_uptime_seconds());
+	if (!peer) {
+		k_spin_unlock(&csl_peer_lock, key);
+		return -ENOENT;
+	}
+
+	time = peer->anchor;
+	if (time < after) {
+		time += DIV_ROUND_UP(after - time, peer->period_ns) * peer->period_ns;
+	}
+
+	k_spin_unlock(&csl_peer_lock, key);
+
+	*tx_time = time;
+
+	return 0;
+}
+
+int ieee802154_csl_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag)
+{
+	uint8_t remaining_attempts = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES + 1;
+	struct net_linkaddr *dst = net_pkt_lladdr_dst(pkt);
+	k_spinlock_key_t key;
+	net_time_t tx_time;
+	bool ack_required;
+	int ret;
+
+	/* Remember the destination to attribute enhanced ACKs without
+	 * source address.
+	 */
+	key = k_spin_lock(&csl_peer_lock);
+	if (dst->addr != NULL && dst->len <= sizeof(csl.tx_dst)) {
+		memcpy(csl.tx_dst, dst->addr, dst->len);
+		csl.tx_dst_len = dst->len;
+	} else {
+		csl.tx_dst_len = 0U;
+	}
+	k_spin_unlock(&csl_peer_lock, key);
+
+	if (!(ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_TXTIME)) {
+		return -ENOENT;
+	}
+
+	while (remaining_attempts) {
+		ret = ieee802154_csl_next_rendezvous(
+			iface, dst, ieee802154_radio_get_time(iface) + CSL_WAKEUP_LEAD_NS,
+			&tx_time);
+		if (ret) {
+			return ret;
+		}
+
+		net_pkt_set_timestamp_ns(pkt, tx_time);
+
+		/* No-op in case the driver has IEEE802154_HW_TX_RX_ACK capability. */
+		ack_required = ieee802154_prepare_for_ack(iface, pkt, frag);
+
+		ret = ieee802154_radio_tx(iface, IEEE802154_TX_MODE_TXTIME_CCA, pkt, frag);
+		if (ret == -EBUSY || ret == -ENOMSG) {
+			/* Busy channel or missing ACK, retry in the next channel sample. */
+			remaining_attempts--;
+			continue;
+		} else if (ret) {
+			return ret;
+		}
+
+		if (!ack_required) {
+			return 0;
+		}
+
+		/* No-op in case the driver has IEEE802154_HW_TX_RX_ACK capability. */
+		ret = ieee802154_wait_for_ack(iface, ack_required);
+		if (ret == 0) {
+			return 0;
+		}
+
+		remaining_attempts--;
+	}
+
+	return -EIO;
+}
+
+/* Waits until the given time, returns false if woken up earlier. */
+static bool csl_wait_until(struct net_if *iface, net_time_t time)
+{
+	net_time_t now = ieee802154_radio_get_time(iface);
+
+	if (time <= now) {
+		return true;
+	}
+
+	return k_sem_take(&csl_wakeup, K_USEC((time - now) / NSEC_PER_USEC)) != 0;
+}
+
+static void csl_run_sample(void)
+{
+	struct ieee802154_config config = {0};
+	struct ieee802154_context *ctx;
+	net_time_t now, start;
+	struct net_if *iface;
+	int ret;
+
+	k_mutex_lock(&csl_lock, K_FOREVER);
+
+	iface = csl.iface;
+	if (iface == NULL) {
+		k_mutex_unlock(&csl_lock);
+		return;
+	}
+
+	now = ieee802154_radio_get_time(iface);
+
+	/* Skip channel samples that start too early to be scheduled. */
+	start = csl.next_sample - CSL_SAMPLE_NS / 2;
+	if (start < now + CSL_WAKEUP_LEAD_NS) {
+		csl.next_sample += ((now + CSL_WAKEUP_LEAD_NS - start) / csl.period_ns + 1) *
+				   csl.period_ns;
+		start = csl.next_sample - CSL_SAMPLE_NS / 2;
+	}
+
+	k_mutex_unlock(&csl_lock);
+
+	if (!csl_wait_until(iface, start - CSL_WAKEUP_LEAD_NS)) {
+		/* The receiver has been stopped or restarted, start over. */
+		return;
+	}
+
+	k_mutex_lock(&csl_lock, K_FOREVER);
+
+	if (!atomic_test_bit(&csl.flags, CSL_RECEIVING) || iface != csl.iface) {
+		k_mutex_unlock(&csl_lock);
+		return;
+	}
+
+	ctx = net_if_l2_data(iface);
+
+	config.rx_slot.start = start;
+	config.rx_slot.duration = CSL_SAMPLE_NS;
+	config.rx_slot.channel = ctx->channel;
+
+	csl.next_sample += csl.period_ns;
+
+	k_mutex_unlock(&csl_lock);
+
+	ret = ieee802154_radio_configure(iface, IEEE802154_CONFIG_RX_SLOT, &config);
+	if (ret) {
+		NET_DBG("Could not schedule channel sample: %d", ret);
+	}
+}
+
+static void csl_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (!atomic_test_bit(&csl.flags, CSL_RECEIVING)) {
+			(void)k_sem_take(&csl_wakeup, K_FOREVER);
+		} else {
+			csl_run_sample();
+		}
+	}
+}
+
+static void csl_set_rx_on_when_idle(struct net_if *iface, bool rx_on_when_idle)
+{
+	struct ieee802154_config config = {
+		.rx_on_when_idle = rx_on_when_idle,
+	};
+
+	if (ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_RX_ON_WHEN_IDLE) {
+		(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_RX_ON_WHEN_IDLE,
+						 &config);
+	}
+}
+
+static void csl_purge_ack_ie(struct net_if *iface)
+{
+	struct ieee802154_config config = {
+		.ack_ie.purge_ie = true,
+	};
+
+	(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_ENH_ACK_HEADER_IE, &config);
+}
+
+int ieee802154_csl_receiver_start(struct net_if *iface, uint16_t period)
+{
+	struct ieee802154_config config = {0};
+	net_time_t unit, next_sample;
+	int ret;
+
+	if (period == 0U) {
+		return -EINVAL;
+	}
+
+	if (!(ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_RXTIME)) {
+		return -ENOTSUP;
+	}
+
+	unit = csl_unit_ns(iface);
+	if (unit == 0) {
+		return -ENOTSUP;
+	}
+
+	/* The engine must be able to schedule every channel sample. */
+	if (period * unit <= CSL_SAMPLE_NS + CSL_WAKEUP_LEAD_NS) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&csl_lock, K_FOREVER);
+
+	if (atomic_test_bit(&csl.flags, CSL_RECEIVING)) {
+		ret = iface == csl.iface ? -EALREADY : -EBUSY;
+		goto out;
+	}
+
+	/* 1. CSL IE of enhanced ACKs to any device, see section 7.4.2.3. */
+	csl_ack_ie = IEEE802154_DEFINE_HEADER_IE_CSL_REDUCED(0, period);
+	config.ack_ie.header_ie = &csl_ack_ie;
+	config.ack_ie.ext_addr = NULL;
+	config.ack_ie.short_addr = IEEE802154_BROADCAST_ADDRESS;
+
+	ret = ieee802154_radio_configure(iface, IEEE802154_CONFIG_ENH_ACK_HEADER_IE, &config);
+	if (ret) {
+		goto out;
+	}
+
+	/* 2. Expected RX time of the first channel sample, then the period. */
+	next_sample = ieee802154_radio_get_time(iface) + CSL_WAKEUP_LEAD_NS + period * unit;
+
+	config = (struct ieee802154_config){
+		.expected_rx_time = next_sample,
+	};
+	ret = ieee802154_radio_configure(iface, IEEE802154_CONFIG_EXPECTED_RX_TIME, &config);
+	if (ret == 0) {
+		config = (struct ieee802154_config){
+			.csl_period = period,
+		};
+		ret = ieee802154_radio_configure(iface, IEEE802154_CONFIG_CSL_PERIOD, &config);
+	}
+
+	if (ret) {
+		csl_purge_ack_ie(iface);
+		goto out;
+	}
+
+	csl_set_rx_on_when_idle(iface, false);
+
+	csl.iface = iface;
+	csl.period_ns = period * unit;
+	csl.next_sample = next_sample;
+	atomic_set_bit(&csl.flags, CSL_RECEIVING);
+
+	/* 3. Channel samples are scheduled by the engine. */
+	if (!csl.thread_started) {
+		k_thread_create(&csl_thread_data, csl_stack, K_KERNEL_STACK_SIZEOF(csl_stack),
+				csl_thread, NULL, NULL, NULL,
+				K_PRIO_COOP(CONFIG_NET_L2_IEEE802154_CSL_THREAD_PRIO), 0, K_NO_WAIT);
+		k_thread_name_set(&csl_thread_data, "ieee802154_csl");
+		csl.thread_started = true;
+	}
+
+	NET_DBG("CSL receiver started, period %u", period);
+
+out:
+	k_mutex_unlock(&csl_lock);
+
+	k_sem_give(&csl_wakeup);
+
+	return ret;
+}
+
+int ieee802154_csl_receiver_stop(struct net_if *iface)
+{
+	struct ieee802154_config config = {
+		.csl_period = 0U,
+	};
+
+	k_mutex_lock(&csl_lock, K_FOREVER);
+
+	if (iface != csl.iface || !atomic_test_and_clear_bit(&csl.flags, CSL_RECEIVING)) {
+		k_mutex_unlock(&csl_lock);
+		return -EALREADY;
+	}
+
+	csl.iface = NULL;
+
+	k_mutex_unlock(&csl_lock);
+
+	k_sem_give(&csl_wakeup);
+
+	(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_CSL_PERIOD, &config);
+	csl_purge_ack_ie(iface);
+	csl_set_rx_on_when_idle(iface, true);
+
+	/* Return to continuous reception. */
+	config = (struct ieee802154_config){
+		.rx_slot = {
+			.start = -1,
+		},
+	};
+	(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_RX_SLOT, &config);
+
+	NET_DBG("CSL receiver stopped");
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Private IEEE 802.15.4 CSL helpers
+ *
+ * These utilities are internal to the native IEEE 802.15.4 L2
+ * stack and must not be included and used elsewhere.
+ *
+ * All references to the spec refer to IEEE 802.15.4-2020.
+ */
+
+#ifndef __IEEE802154_CSL_H__
+#define __IEEE802154_CSL_H__
+
+#include <errno.h>
+
+#include <zephyr/net/buf.h>
+#include <zephyr/net/ieee802154_csl.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_linkaddr.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_time.h>
+
+#include "ieee802154_frame.h"
+
+#ifdef CONFIG_NET_L2_IEEE802154_CSL
+
+/**
+ * @brief Learns the CSL phase and period of the sender of the given
+ *        validated frame if it carries a CSL IE.
+ *
+ * @param iface A valid pointer on the receiving network interface
+ * @param pkt A valid pointer on the received packet
+ * @param mpdu The validated MPDU of the packet
+ */
+void ieee802154_csl_rx_track(struct net_if *iface, struct net_pkt *pkt,
+			     struct ieee802154_mpdu *mpdu);
+
+/**
+ * @brief Learns the CSL phase and period of a CSL receiver from the CSL
+ *        IE of an enhanced ACK. ACKs without source address are
+ *        attributed to the destination of the last CSL transmission.
+ *
+ * @param iface A valid pointer on the receiving network interface
+ * @param pkt A valid pointer on the received ACK packet
+ */
+void ieee802154_csl_handle_ack(struct net_if *iface, struct net_pkt *pkt);
+
+/**
+ * @brief Sends the given fragment in the next channel sample of its
+ *        destination if the destination is a known CSL receiver.
+ *
+ * @param iface A valid pointer on a network interface to send from
+ * @param pkt A valid pointer on a packet to send
+ * @param frag The fragment to be sent
+ *
+ * @return 0 on success, -ENOENT if the fragment has to be sent with the
+ *         regular channel access method, other negative values on error
+ */
+int ieee802154_csl_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag);
+
+/**
+ * @brief Computes the first channel sample of a CSL receiver at or after
+ *        the given time.
+ *
+ * @param iface A valid pointer on a network interface
+ * @param dst Link layer address of the CSL receiver, in big endian
+ * @param after Earliest acceptable time in the network subsystem's local clock
+ * @param tx_time Set to the end of SFD of a frame sent right into the
+ *        channel sample
+ *
+ * @return 0 on success, -ENOENT if no CSL information is known for @p dst
+ */
+int ieee802154_csl_next_rendezvous(struct net_if *iface, const struct net_linkaddr *dst,
+				   net_time_t after, net_time_t *tx_time);
+
+#else
+
+static inline void ieee802154_csl_rx_track(struct net_if *iface, struct net_pkt *pkt,
+					   struct ieee802154_mpdu *mpdu)
+{
+}
+
+static inline void ieee802154_csl_handle_ack(struct net_if *iface, struct net_pkt *pkt)
+{
+}
+
+static inline int ieee802154_csl_send(struct net_if *iface, struct net_pkt *pkt,
+				      struct net_buf *frag)
+{
+	return -ENOENT;
+}
+
+#endif /* CONFIG_NET_L2_IEEE802154_CSL */
+
+#endif /* __IEEE802154_CSL_H__ */
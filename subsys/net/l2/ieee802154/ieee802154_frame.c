@@ -368,6 +368,59 @@ static inline bool validate_mac_command(struct ieee802154_mpdu *mpdu, uint8_t *b
 	return true;
 }
 
+/* Header IEs directly follow the auxiliary security header. Unless there is
+ * neither a payload nor payload IEs, the list ends with a Header Termination
+ * IE, see section 7.4.1.
+ */
+static inline bool validate_header_ie_list(uint8_t *buf, uint8_t **p_buf, uint8_t *length,
+					   struct ieee802154_mhr *mhr)
+{
+	uint8_t remaining = *length;
+	bool terminated = false;
+
+	*p_buf = buf;
+
+	mhr->header_ie = NULL;
+	mhr->header_ie_length = 0U;
+
+	if (!mhr->fs->fc.ie_list) {
+		return true;
+	}
+
+	if (mhr->fs->fc.frame_version < IEEE802154_VERSION_802154) {
+		return false;
+	}
+
+	while (remaining >= IEEE802154_HEADER_IE_HEADER_LENGTH && !terminated) {
+		struct ieee802154_header_ie *ie = (struct ieee802154_header_ie *)*p_buf;
+		uint8_t ie_len = IEEE802154_HEADER_IE_HEADER_LENGTH + ie->length;
+		uint8_t element_id = ieee802154_header_ie_get_element_id(ie);
+
+		if (ie->type != IEEE802154_IE_TYPE_HEADER || ie_len > remaining) {
+			return false;
+		}
+
+		terminated = element_id == IEEE802154_HEADER_IE_ELEMENT_ID_HEADER_TERMINATION_1 ||
+			     element_id == IEEE802154_HEADER_IE_ELEMENT_ID_HEADER_TERMINATION_2;
+
+		*p_buf += ie_len;
+		remaining -= ie_len;
+	}
+
+	if (!terminated && remaining) {
+		return false;
+	}
+
+	if (*p_buf != buf) {
+		mhr->header_ie = (struct ieee802154_header_ie *)buf;
+		mhr->header_ie_length = *p_buf - buf;
+	}
+
+	*length = remaining;
+
+	return true;
+}
+
 static inline bool validate_payload_and_mfr(struct ieee802154_mpdu *mpdu, uint8_t *buf,
 					    uint8_t *p_buf, uint8_t length)
 {
@@ -441,9 +494,73 @@ bool ieee802154_validate_frame(uint8_t *buf, uint8_t length, struct ieee802154_m
 	}
 #endif
 
+	if (!validate_header_ie_list(p_buf, &p_buf, &length, &mpdu->mhr)) {
+		return false;
+	}
+
 	return validate_payload_and_mfr(mpdu, buf, p_buf, length);
 }
 
+static inline uint8_t mpdu_offset(uint8_t *buf, void *field)
+{
+	return field ? (uint8_t *)field - buf : 0U;
+}
+
+static inline void *mpdu_field(uint8_t *buf, uint8_t offset)
+{
+	return offset ? buf + offset : NULL;
+}
+
+bool ieee802154_parse_frame(struct net_pkt *pkt, struct ieee802154_mpdu *mpdu)
+{
+	struct net_pkt_cb_ieee802154 *cb = net_pkt_cb_ieee802154(pkt);
+	uint8_t *buf = net_pkt_data(pkt);
+
+	net_pkt_set_ieee802154_mpdu_parsed(pkt, false);
+
+	if (!ieee802154_validate_frame(buf, net_pkt_get_len(pkt), mpdu)) {
+		return false;
+	}
+
+	cb->mpdu.dst_addr = mpdu_offset(buf, mpdu->mhr.dst_addr);
+	cb->mpdu.src_addr = mpdu_offset(buf, mpdu->mhr.src_addr);
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+	cb->mpdu.aux_sec = mpdu->mhr.fs->fc.security_enabled ?
+		mpdu_offset(buf, mpdu->mhr.aux_sec) : 0U;
+#endif
+	cb->mpdu.header_ie = mpdu_offset(buf, mpdu->mhr.header_ie);
+	cb->mpdu.header_ie_length = mpdu->mhr.header_ie_length;
+	cb->mpdu.payload = mpdu_offset(buf, mpdu->payload);
+	cb->mpdu.payload_length = mpdu->payload_length;
+
+	net_pkt_set_ieee802154_mpdu_parsed(pkt, true);
+
+	return true;
+}
+
+bool ieee802154_get_parsed_frame(struct net_pkt *pkt, struct ieee802154_mpdu *mpdu)
+{
+	struct net_pkt_cb_ieee802154 *cb = net_pkt_cb_ieee802154(pkt);
+	uint8_t *buf = net_pkt_data(pkt);
+
+	if (!net_pkt_ieee802154_mpdu_parsed(pkt)) {
+		return false;
+	}
+
+	mpdu->mhr.fs = (struct ieee802154_fcf_seq *)buf;
+	mpdu->mhr.dst_addr = mpdu_field(buf, cb->mpdu.dst_addr);
+	mpdu->mhr.src_addr = mpdu_field(buf, cb->mpdu.src_addr);
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+	mpdu->mhr.aux_sec = mpdu_field(buf, cb->mpdu.aux_sec);
+#endif
+	mpdu->mhr.header_ie = mpdu_field(buf, cb->mpdu.header_ie);
+	mpdu->mhr.header_ie_length = cb->mpdu.header_ie_length;
+	mpdu->payload = mpdu_field(buf, cb->mpdu.payload);
+	mpdu->payload_length = cb->mpdu.payload_length;
+
+	return true;
+}
+
 void ieee802154_compute_header_and_authtag_len(struct net_if *iface, struct net_linkaddr *dst,
 					       struct net_linkaddr *src, uint8_t *ll_hdr_len,
 					       uint8_t *authtag_len)
@@ -666,23 +783,133 @@ static uint8_t *generate_aux_security_hdr(struct ieee802154_security_ctx *sec_ct
 }
 #endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
 
-bool ieee802154_create_data_frame(struct ieee802154_context *ctx, struct net_linkaddr *dst,
-				  struct net_linkaddr *src, struct net_buf *buf, uint8_t ll_hdr_len)
+static uint8_t *generate_data_frame_header(struct ieee802154_context *ctx,
+					   struct net_linkaddr *dst,
+					   struct ieee802154_frame_params *params, uint8_t *p_buf)
 {
-	struct ieee802154_frame_params params = {0};
 	struct ieee802154_fcf_seq *fs;
-	uint8_t *p_buf = buf->data;
-	uint8_t *buf_start = p_buf;
-	bool ret = false;
 	bool broadcast;
 
-	k_sem_take(&ctx->ctx_lock, K_FOREVER);
-
 	fs = generate_fcf_grounds(&p_buf, ctx->ack_requested);
 
 	fs->fc.frame_type = IEEE802154_FRAME_TYPE_DATA;
 	fs->sequence = ctx->sequence++;
 
+	broadcast = data_addr_to_fs_settings(dst, fs, params);
+
+	p_buf = generate_addressing_fields(ctx, fs, params, p_buf);
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+	if (broadcast) {
+		/* TODO: This may not always be correct. */
+		NET_DBG("No security hdr needed: broadcasting");
+		return p_buf;
+	}
+
+	if (ctx->sec_ctx.level == IEEE802154_SECURITY_LEVEL_NONE) {
+		NET_WARN("IEEE 802.15.4 security is enabled but has not been configured.");
+		return p_buf;
+	}
+
+	fs->fc.security_enabled = 1U;
+
+	p_buf = generate_aux_security_hdr(&ctx->sec_ctx, p_buf);
+	if (!p_buf) {
+		NET_ERR("Unsupported key mode.");
+	}
+#else
+	ARG_UNUSED(broadcast);
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
+
+	return p_buf;
+}
+
+#if CONFIG_NET_L2_IEEE802154_HEADER_TEMPLATES > 0
+/* Requires the context lock to be held. */
+static struct ieee802154_hdr_template *hdr_template_get(struct ieee802154_context *ctx,
+							 struct net_linkaddr *dst,
+							 struct net_linkaddr *src)
+{
+	uint8_t dst_len = dst->addr ? dst->len : 0U;
+
+	ARRAY_FOR_EACH_PTR(ctx->hdr_templates, tmpl) {
+		if (tmpl->in_use && tmpl->dst_len == dst_len && tmpl->src_len == src->len &&
+		    (!dst_len || !memcmp(tmpl->dst_addr, dst->addr, dst_len))) {
+			return tmpl;
+		}
+	}
+
+	return NULL;
+}
+
+/* Requires the context lock to be held. */
+static void hdr_template_put(struct ieee802154_context *ctx, struct net_linkaddr *dst,
+			     struct net_linkaddr *src, uint8_t *hdr, uint8_t hdr_len)
+{
+	struct ieee802154_hdr_template *tmpl = &ctx->hdr_templates[ctx->hdr_template_next];
+	struct ieee802154_fcf_seq *fs = (struct ieee802154_fcf_seq *)hdr;
+
+	if (hdr_len > sizeof(tmpl->hdr) || (dst->addr && dst->len > sizeof(tmpl->dst_addr))) {
+		return;
+	}
+
+	ctx->hdr_template_next = (ctx->hdr_template_next + 1U) % ARRAY_SIZE(ctx->hdr_templates);
+
+	tmpl->dst_len = dst->addr ? dst->len : 0U;
+	if (tmpl->dst_len) {
+		memcpy(tmpl->dst_addr, dst->addr, tmpl->dst_len);
+	}
+
+	tmpl->src_len = src->len;
+	memcpy(tmpl->hdr, hdr, hdr_len);
+	tmpl->hdr_len = hdr_len;
+
+	/* Only the implicit key mode is supported, so the frame counter
+	 * always ends the header.
+	 */
+	tmpl->frame_counter = fs->fc.security_enabled ?
+		hdr_len - IEEE802154_SECURITY_FRAME_COUNTER_LENGTH : 0U;
+
+	tmpl->in_use = true;
+}
+
+/* Requires the context lock to be held. */
+static uint8_t *hdr_template_apply(struct ieee802154_context *ctx,
+				   struct ieee802154_hdr_template *tmpl, uint8_t *p_buf)
+{
+	memcpy(p_buf, tmpl->hdr, tmpl->hdr_len);
+
+	((struct ieee802154_fcf_seq *)p_buf)->sequence = ctx->sequence++;
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+	if (tmpl->frame_counter) {
+		sys_put_le32(ctx->sec_ctx.frame_counter, p_buf + tmpl->frame_counter);
+	}
+#endif
+
+	return p_buf + tmpl->hdr_len;
+}
+
+void ieee802154_hdr_templates_flush(struct ieee802154_context *ctx)
+{
+	ARRAY_FOR_EACH_PTR(ctx->hdr_templates, tmpl) {
+		tmpl->in_use = false;
+	}
+}
+#endif /* CONFIG_NET_L2_IEEE802154_HEADER_TEMPLATES > 0 */
+
+static bool create_data_frame(struct ieee802154_context *ctx, struct net_linkaddr *dst,
+			      struct net_linkaddr *src, struct net_buf *buf, uint8_t ll_hdr_len,
+			      struct ieee802154_security_op *sec_op)
+{
+	struct ieee802154_frame_params params = {0};
+	struct ieee802154_fcf_seq *fs;
+	uint8_t *buf_start = buf->data;
+	uint8_t *p_buf = NULL;
+	bool ret = false;
+
+	k_sem_take(&ctx->ctx_lock, K_FOREVER);
+
 	params.dst.pan_id = ctx->pan_id;
 	params.pan_id = ctx->pan_id;
 	if (src->addr && src->len == IEEE802154_SHORT_ADDR_LENGTH) {
@@ -703,28 +930,36 @@ bool ieee802154_create_data_frame(struct ieee802154_context *ctx, struct net_lin
 		}
 	}
 
-	broadcast = data_addr_to_fs_settings(dst, fs, &params);
+#if CONFIG_NET_L2_IEEE802154_HEADER_TEMPLATES > 0
+	struct ieee802154_hdr_template *tmpl = hdr_template_get(ctx, dst, src);
 
-	p_buf = generate_addressing_fields(ctx, fs, &params, p_buf);
+	if (tmpl) {
+		p_buf = hdr_template_apply(ctx, tmpl, buf_start);
+	} else {
+		p_buf = generate_data_frame_header(ctx, dst, &params, buf_start);
+		if (p_buf) {
+			hdr_template_put(ctx, dst, src, buf_start, p_buf - buf_start);
+		}
+	}
+#else
+	p_buf = generate_data_frame_header(ctx, dst, &params, buf_start);
+#endif
 
-#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
-	if (broadcast) {
-		/* TODO: This may not always be correct. */
-		NET_DBG("No security hdr needed: broadcasting");
-		goto no_security_hdr;
+	if (!p_buf) {
+		goto out;
 	}
 
-	if (ctx->sec_ctx.level == IEEE802154_SECURITY_LEVEL_NONE) {
-		NET_WARN("IEEE 802.15.4 security is enabled but has not been configured.");
-		goto no_security_hdr;
+	if ((p_buf - buf_start) != ll_hdr_len) {
+		/* ll_hdr_len was too small? We probably overwrote payload bytes */
+		NET_ERR("Could not generate data frame %zu vs %u", (p_buf - buf_start), ll_hdr_len);
+		goto out;
 	}
 
-	fs->fc.security_enabled = 1U;
+	fs = (struct ieee802154_fcf_seq *)buf_start;
 
-	p_buf = generate_aux_security_hdr(&ctx->sec_ctx, p_buf);
-	if (!p_buf) {
-		NET_ERR("Unsupported key mode.");
-		goto out;
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+	if (!fs->fc.security_enabled) {
+		goto no_security;
 	}
 
 	uint8_t level = ctx->sec_ctx.level;
@@ -737,19 +972,19 @@ bool ieee802154_create_data_frame(struct ieee802154_context *ctx, struct net_lin
 	uint8_t payload_len = buf->len - ll_hdr_len - authtag_len;
 
 	/* Let's encrypt/auth only in the end, if needed */
-	if (!ieee802154_encrypt_auth(&ctx->sec_ctx, buf_start, ll_hdr_len,
-				     payload_len, authtag_len, ctx->ext_addr)) {
-		goto out;
-	};
-
-no_security_hdr:
-#endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
-	if ((p_buf - buf_start) != ll_hdr_len) {
-		/* ll_hdr_len was too small? We probably overwrote payload bytes */
-		NET_ERR("Could not generate data frame %zu vs %u", (p_buf - buf_start), ll_hdr_len);
+	if (sec_op) {
+		if (!ieee802154_encrypt_auth_submit(&ctx->sec_ctx, buf_start, ll_hdr_len,
+						    payload_len, authtag_len, ctx->ext_addr,
+						    sec_op)) {
+			goto out;
+		}
+	} else if (!ieee802154_encrypt_auth(&ctx->sec_ctx, buf_start, ll_hdr_len,
+					    payload_len, authtag_len, ctx->ext_addr)) {
 		goto out;
 	}
 
+no_security:
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
 	dbg_print_fs(fs);
 
 	ret = true;
@@ -759,6 +994,24 @@ out:
 	return ret;
 }
 
+bool ieee802154_create_data_frame(struct ieee802154_context *ctx, struct net_linkaddr *dst,
+				  struct net_linkaddr *src, struct net_buf *buf, uint8_t ll_hdr_len)
+{
+	return create_data_frame(ctx, dst, src, buf, ll_hdr_len, NULL);
+}
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+bool ieee802154_create_data_frame_async(struct ieee802154_context *ctx,
+					struct net_linkaddr *dst, struct net_linkaddr *src,
+					struct net_buf *buf, uint8_t ll_hdr_len,
+					struct ieee802154_security_op *sec_op)
+{
+	ieee802154_security_op_init(sec_op);
+
+	return create_data_frame(ctx, dst, src, buf, ll_hdr_len, sec_op);
+}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
+
 #ifdef CONFIG_NET_L2_IEEE802154_RFD
 
 static inline bool cfi_to_fs_settings(enum ieee802154_cfi cfi, struct ieee802154_fcf_seq *fs,
@@ -926,12 +1179,15 @@ bool ieee802154_create_ack_frame(struct net_if *iface, struct net_pkt *pkt, uint
 }
 
 #ifdef CONFIG_NET_L2_IEEE802154_SECURITY
-bool ieee802154_decipher_data_frame(struct net_if *iface, struct net_pkt *pkt,
-				    struct ieee802154_mpdu *mpdu)
+bool ieee802154_decipher_data_frame_submit(struct net_if *iface, struct net_pkt *pkt,
+					   struct ieee802154_mpdu *mpdu,
+					   struct ieee802154_security_op *sec_op)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	bool ret = false;
 
+	ieee802154_security_op_init(sec_op);
+
 	k_sem_take(&ctx->ctx_lock, K_FOREVER);
 
 	uint8_t level = ctx->sec_ctx.level;
@@ -971,20 +1227,53 @@ bool ieee802154_decipher_data_frame(struct net_if *iface, struct net_pkt *pkt,
 	}
 
 	sys_memcpy_swap(ext_addr_le, net_pkt_lladdr_src(pkt)->addr, net_pkt_lladdr_src(pkt)->len);
-	if (!ieee802154_decrypt_auth(&ctx->sec_ctx, net_pkt_data(pkt), ll_hdr_len, payload_len,
-				     authtag_len, ext_addr_le,
-				     sys_le32_to_cpu(mpdu->mhr.aux_sec->frame_counter))) {
-		NET_ERR("Could not decipher the frame");
+	if (!ieee802154_decrypt_auth_submit(&ctx->sec_ctx, net_pkt_data(pkt), ll_hdr_len,
+					    payload_len, authtag_len, ext_addr_le,
+					    sys_le32_to_cpu(mpdu->mhr.aux_sec->frame_counter),
+					    sec_op)) {
 		goto out;
 	}
 
-	/* We remove tag size from buf's length, it is now useless. */
-	pkt->buffer->len -= authtag_len;
-
 	ret = true;
 
 out:
 	k_sem_give(&ctx->ctx_lock);
 	return ret;
 }
+
+bool ieee802154_decipher_data_frame_finish(struct net_pkt *pkt, struct ieee802154_mpdu *mpdu,
+					   struct ieee802154_security_op *sec_op)
+{
+	uint8_t level;
+
+	if (!ieee802154_security_op_wait(sec_op)) {
+		NET_ERR("Could not decipher the frame");
+		return false;
+	}
+
+	if (!mpdu->mhr.fs->fc.security_enabled) {
+		return true;
+	}
+
+	level = mpdu->mhr.aux_sec->control.security_level;
+	if (level >= IEEE802154_SECURITY_LEVEL_ENC) {
+		level -= 4U;
+	}
+
+	/* We remove tag size from buf's length, it is now useless. */
+	pkt->buffer->len -= level_2_authtag_len[level];
+
+	return true;
+}
+
+bool ieee802154_decipher_data_frame(struct net_if *iface, struct net_pkt *pkt,
+				    struct ieee802154_mpdu *mpdu)
+{
+	struct ieee802154_security_op sec_op;
+	bool ret;
+
+	ret = ieee802154_decipher_data_frame_submit(iface, pkt, mpdu, &sec_op);
+
+	return ieee802154_decipher_data_frame_finish(pkt, mpdu, &sec_op) && ret;
+}
 #endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
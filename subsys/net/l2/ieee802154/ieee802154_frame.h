@@ -216,6 +216,8 @@ struct ieee802154_mhr {
 #ifdef CONFIG_NET_L2_IEEE802154_SECURITY
 	struct ieee802154_aux_security_hdr *aux_sec;
 #endif
+	struct ieee802154_header_ie *header_ie; /* NULL if there are no header IEs */
+	uint8_t header_ie_length; /* including the header termination IE, if any */
 };
 
 /** see section 7.3.1.5, figure 7-10 */
@@ -474,14 +476,74 @@ struct ieee802154_fcf_seq *ieee802154_validate_fc_seq(uint8_t *buf, uint8_t **p_
 
 bool ieee802154_validate_frame(uint8_t *buf, uint8_t length, struct ieee802154_mpdu *mpdu);
 
+/**
+ * @brief Validate a received frame and keep the result in the packet.
+ *
+ * @details Same as @ref ieee802154_validate_frame but also stores the offsets
+ * of the MAC header fields, header IEs and payload into the packet's control
+ * block, so that later RX stages can get the MPDU back with
+ * @ref ieee802154_get_parsed_frame instead of parsing the frame again.
+ *
+ * @param pkt Single-fragment packet holding the frame.
+ * @param mpdu MPDU to fill in.
+ *
+ * @return true if the frame is valid, false otherwise.
+ */
+bool ieee802154_parse_frame(struct net_pkt *pkt, struct ieee802154_mpdu *mpdu);
+
+/**
+ * @brief Get the MPDU of a frame parsed by @ref ieee802154_parse_frame.
+ *
+ * @details The packet's data must not have been modified in between.
+ *
+ * @param pkt Packet holding the frame.
+ * @param mpdu MPDU to fill in.
+ *
+ * @return true on success, false if the packet holds no parsed frame.
+ */
+bool ieee802154_get_parsed_frame(struct net_pkt *pkt, struct ieee802154_mpdu *mpdu);
+
 void ieee802154_compute_header_and_authtag_len(struct net_if *iface, struct net_linkaddr *dst,
 					       struct net_linkaddr *src, uint8_t *ll_hdr_len,
 					       uint8_t *authtag_len);
 
+#if CONFIG_NET_L2_IEEE802154_HEADER_TEMPLATES > 0
+/**
+ * @brief Drop the cached data frame headers.
+ *
+ * @details Must be called, with the context lock held, whenever a context
+ * attribute the MAC header of data frames depends on is changed.
+ *
+ * @param ctx IEEE 802.15.4 context.
+ */
+void ieee802154_hdr_templates_flush(struct ieee802154_context *ctx);
+#else
+static inline void ieee802154_hdr_templates_flush(struct ieee802154_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif
+
 bool ieee802154_create_data_frame(struct ieee802154_context *ctx, struct net_linkaddr *dst,
 				  struct net_linkaddr *src, struct net_buf *buf,
 				  uint8_t ll_hdr_len);
 
+struct ieee802154_security_op;
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+/**
+ * @brief Same as @ref ieee802154_create_data_frame but does not wait for the
+ *        frame to be encrypted/authenticated.
+ *
+ * The frame must not be sent before @ref ieee802154_security_op_wait
+ * returned, which must be called whatever the result of this function.
+ */
+bool ieee802154_create_data_frame_async(struct ieee802154_context *ctx,
+					struct net_linkaddr *dst, struct net_linkaddr *src,
+					struct net_buf *buf, uint8_t ll_hdr_len,
+					struct ieee802154_security_op *sec_op);
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
+
 struct net_pkt *ieee802154_create_mac_cmd_frame(struct net_if *iface, enum ieee802154_cfi type,
 						struct ieee802154_frame_params *params);
 
@@ -497,6 +559,24 @@ bool ieee802154_create_ack_frame(struct net_if *iface, struct net_pkt *pkt, uint
 #ifdef CONFIG_NET_L2_IEEE802154_SECURITY
 bool ieee802154_decipher_data_frame(struct net_if *iface, struct net_pkt *pkt,
 				    struct ieee802154_mpdu *mpdu);
+
+/**
+ * @brief First half of @ref ieee802154_decipher_data_frame: checks the
+ *        security parameters and submits the decryption.
+ *
+ * @ref ieee802154_decipher_data_frame_finish must be called whatever the
+ * result of this function.
+ */
+bool ieee802154_decipher_data_frame_submit(struct net_if *iface, struct net_pkt *pkt,
+					   struct ieee802154_mpdu *mpdu,
+					   struct ieee802154_security_op *sec_op);
+
+/**
+ * @brief Second half of @ref ieee802154_decipher_data_frame: waits for the
+ *        decryption and removes the authentication tag.
+ */
+bool ieee802154_decipher_data_frame_finish(struct net_pkt *pkt, struct ieee802154_mpdu *mpdu,
+					   struct ieee802154_security_op *sec_op);
 #else
 #define ieee802154_decipher_data_frame(...) true
 #endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
@@ -0,0 +1,675 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * All references to the spec refer to IEEE 802.15.4-2020.
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 indirect transmission, see section 6.7.3.
+ *
+ * Frames to registered sleepy children are copied into a per-child queue
+ * instead of being sent. Children are looked up through a hash table on
+ * their address, both on the TX path and for every received Data Request
+ * command.
+ *
+ * The Frame Pending field of ACKs to Data Request commands is set by the
+ * driver from its frame pending address table (@ref
+ * IEEE802154_CONFIG_ACK_FPB) if the driver generates ACKs. Changes of the
+ * children's pending state are collected and synced to the driver in one
+ * run of the work queue, so that bursts of enqueued and polled frames do
+ * not reprogram the table for every frame. Drivers without ACK generation
+ * leave the ACK to the L2 whose software ACK path consults the hash table.
+ *
+ * The head frame of a child's queue is sent from the work queue once the
+ * child's Data Request command has been acknowledged. Unsecured frames
+ * have their Frame Pending field set if further frames are queued, so that
+ * the child polls again right away. Secured frames are sent unmodified as
+ * the field is covered by the MIC, the child then picks up the following
+ * frames with its next regular poll.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_indirect, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_indirect.h>
+#include <zephyr/net/ieee802154_radio.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "ieee802154_frame.h"
+#include "ieee802154_indirect.h"
+#include "ieee802154_priv.h"
+#include "ieee802154_utils.h"
+
+#define INDIRECT_BUCKETS CONFIG_NET_L2_IEEE802154_INDIRECT_BUCKETS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(INDIRECT_BUCKETS),
+	     "Sleepy children hash buckets must be a power of two");
+
+struct indirect_child {
+	/* Node in a hash bucket or in the free list */
+	sys_snode_t node;
+	/* Node in the list of children to be synced with the driver */
+	sys_snode_t sync_node;
+	/* Node in the list of children whose poll has to be served */
+	sys_snode_t poll_node;
+	struct net_if *iface;
+	/* Queued frames, oldest first */
+	sys_slist_t frames;
+	/* Link layer address, in big endian like struct net_linkaddr */
+	uint8_t addr[IEEE802154_EXT_ADDR_LENGTH];
+	uint8_t addr_len;
+	uint8_t queued;
+	/* Frame pending state as programmed into the driver */
+	bool fpb;
+	bool sync_pending;
+	bool poll_pending;
+};
+
+/* Metadata of queued frames, kept in the buffers' user data. */
+struct indirect_frame_meta {
+	/* Uptime in ms after which the frame is dropped */
+	int64_t expiry;
+};
+
+NET_BUF_POOL_FIXED_DEFINE(indirect_frame_pool, CONFIG_NET_L2_IEEE802154_INDIRECT_FRAME_COUNT,
+			  IEEE802154_MTU, sizeof(struct indirect_frame_meta), NULL);
+
+static struct indirect_child children[CONFIG_NET_L2_IEEE802154_INDIRECT_MAX_CHILDREN];
+static sys_slist_t buckets[INDIRECT_BUCKETS];
+static sys_slist_t free_children;
+static sys_slist_t sync_list;
+static sys_slist_t poll_list;
+static bool initialized;
+
+/* Serializes the registration of children and the lazy initialization. */
+static K_MUTEX_DEFINE(indirect_mgmt_lock);
+
+/* Guards all of the above except initialized. Lookups run in the RX path
+ * for every Data Request command and in the TX path for every frame, so
+ * critical sections are kept short and never call into the driver.
+ */
+static struct k_spinlock indirect_lock;
+
+static K_KERNEL_STACK_DEFINE(indirect_stack, CONFIG_NET_L2_IEEE802154_INDIRECT_STACK_SIZE);
+static struct k_work_q indirect_work_q;
+
+static void indirect_sync_handler(struct k_work *work);
+static void indirect_poll_handler(struct k_work *work);
+static void indirect_expiry_handler(struct k_work *work);
+
+static K_WORK_DEFINE(indirect_sync_work, indirect_sync_handler);
+static K_WORK_DEFINE(indirect_poll_work, indirect_poll_handler);
+static K_WORK_DELAYABLE_DEFINE(indirect_expiry_work, indirect_expiry_handler);
+
+static inline sys_slist_t *indirect_bucket(const uint8_t *addr, uint8_t addr_len)
+{
+	uint32_t hash = addr_len;
+
+	for (uint8_t i = 0U; i < addr_len; i++) {
+		hash = (hash << 5) - hash + addr[i];
+	}
+
+	hash *= 0x9e3779b1U;
+
+	return &buckets[(hash >> 16) & (INDIRECT_BUCKETS - 1)];
+}
+
+/* Requires indirect_lock to be held. */
+static struct indirect_child *indirect_lookup(struct net_if *iface, const uint8_t *addr,
+					      uint8_t addr_len)
+{
+	struct indirect_child *child;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(indirect_bucket(addr, addr_len), child, node) {
+		if (child->iface == iface && child->addr_len == addr_len &&
+		    !memcmp(child->addr, addr, addr_len)) {
+			return child;
+		}
+	}
+
+	return NULL;
+}
+
+/* Requires indirect_lock to be held. */
+static void indirect_request_sync(struct indirect_child *child)
+{
+	if (child->sync_pending || child->fpb == (child->queued > 0U)) {
+		return;
+	}
+
+	child->sync_pending = true;
+	sys_slist_append(&sync_list, &child->sync_node);
+	k_work_submit_to_queue(&indirect_work_q, &indirect_sync_work);
+}
+
+/* Requires indirect_lock to be held. Moves the frames that expired at the
+ * given uptime to the given list, or all frames if the uptime is negative.
+ */
+static void indirect_drop_frames(struct indirect_child *child, sys_slist_t *dropped,
+				 int64_t now)
+{
+	struct net_buf *buf;
+	sys_snode_t *node;
+
+	while ((node = sys_slist_peek_head(&child->frames))) {
+		buf = CONTAINER_OF(node, struct net_buf, node);
+
+		if (now >= 0 &&
+		    ((struct indirect_frame_meta *)net_buf_user_data(buf))->expiry > now) {
+			break;
+		}
+
+		(void)sys_slist_get_not_empty(&child->frames);
+		sys_slist_append(dropped, &buf->node);
+		child->queued--;
+	}
+
+	indirect_request_sync(child);
+}
+
+static void indirect_free_frames(sys_slist_t *frames)
+{
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(frames))) {
+		net_buf_unref(CONTAINER_OF(node, struct net_buf, node));
+	}
+}
+
+/* Syncs the pending state of all children that changed since the last
+ * run with the drivers' frame pending address tables.
+ */
+static void indirect_sync_handler(struct k_work *work)
+{
+	struct ieee802154_config config;
+	uint8_t addr_le[IEEE802154_EXT_ADDR_LENGTH];
+	struct indirect_child *child;
+	k_spinlock_key_t key;
+	struct net_if *iface;
+	sys_snode_t *node;
+	bool pending;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&indirect_lock);
+
+		node = sys_slist_get(&sync_list);
+		if (!node) {
+			k_spin_unlock(&indirect_lock, key);
+			return;
+		}
+
+		child = CONTAINER_OF(node, struct indirect_child, sync_node);
+		child->sync_pending = false;
+
+		iface = child->iface;
+		pending = child->queued > 0U;
+		sys_memcpy_swap(addr_le, child->addr, child->addr_len);
+
+		config = (struct ieee802154_config){
+			.ack_fpb = {
+				.addr = addr_le,
+				.extended = child->addr_len == IEEE802154_EXT_ADDR_LENGTH,
+				.enabled = pending,
+			},
+		};
+
+		/* Assume success, a failed update is retried with the next
+		 * change of the child's state.
+		 */
+		child->fpb = pending;
+
+		k_spin_unlock(&indirect_lock, key);
+
+		if (!(ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_RX_TX_ACK)) {
+			continue;
+		}
+
+		ret = ieee802154_radio_configure(iface, IEEE802154_CONFIG_ACK_FPB, &config);
+		if (ret) {
+			NET_DBG("Could not update frame pending table: %d", ret);
+		}
+	}
+}
+
+static void indirect_poll_handler(struct k_work *work)
+{
+	struct indirect_child *child;
+	struct ieee802154_fcf_seq *fs;
+	sys_slist_t dropped;
+	k_spinlock_key_t key;
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	sys_snode_t *node;
+	bool more;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		sys_slist_init(&dropped);
+
+		key = k_spin_lock(&indirect_lock);
+
+		node = sys_slist_get(&poll_list);
+		if (!node) {
+			k_spin_unlock(&indirect_lock, key);
+			return;
+		}
+
+		child = CONTAINER_OF(node, struct indirect_child, poll_node);
+		child->poll_pending = false;
+
+		/* Expired frames must not be sent anymore. */
+		indirect_drop_frames(child, &dropped, k_uptime_get());
+
+		node = sys_slist_get(&child->frames);
+		if (node) {
+			child->queued--;
+			indirect_request_sync(child);
+		}
+
+		more = child->queued > 0U;
+		iface = child->iface;
+
+		k_spin_unlock(&indirect_lock, key);
+
+		indirect_free_frames(&dropped);
+
+		if (!node) {
+			continue;
+		}
+
+		buf = CONTAINER_OF(node, struct net_buf, node);
+		buf->frags = NULL;
+
+		fs = (struct ieee802154_fcf_seq *)buf->data;
+		if (more && !fs->fc.security_enabled) {
+			fs->fc.frame_pending = 1U;
+		}
+
+		/* The packet carries no destination, so that the frame is sent
+		 * directly.
+		 */
+		pkt = net_pkt_alloc_on_iface(iface, K_NO_WAIT);
+		if (!pkt) {
+			NET_DBG("Could not allocate packet for polled frame");
+			net_buf_unref(buf);
+			continue;
+		}
+
+		ret = ieee802154_radio_send(iface, pkt, buf);
+		if (ret) {
+			NET_DBG("Could not send polled frame: %d", ret);
+		}
+
+		net_pkt_unref(pkt);
+		net_buf_unref(buf);
+	}
+}
+
+static void indirect_expiry_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	int64_t next = INT64_MAX;
+	sys_slist_t dropped;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	sys_slist_init(&dropped);
+
+	key = k_spin_lock(&indirect_lock);
+
+	ARRAY_FOR_EACH_PTR(children, child) {
+		sys_snode_t *node;
+
+		if (!child->iface || !child->queued) {
+			continue;
+		}
+
+		indirect_drop_frames(child, &dropped, now);
+
+		node = sys_slist_peek_head(&child->frames);
+		if (node) {
+			struct net_buf *buf = CONTAINER_OF(node, struct net_buf, node);
+
+			next = MIN(next,
+				   ((struct indirect_frame_meta *)net_buf_user_data(buf))->expiry);
+		}
+	}
+
+	if (next != INT64_MAX) {
+		k_work_schedule_for_queue(&indirect_work_q, &indirect_expiry_work,
+					  K_MSEC(next - now));
+	}
+
+	k_spin_unlock(&indirect_lock, key);
+
+	if (!sys_slist_is_empty(&dropped)) {
+		NET_DBG("Dropping expired indirect frames");
+	}
+
+	indirect_free_frames(&dropped);
+}
+
+/* Requires indirect_mgmt_lock to be held. */
+static void indirect_init(void)
+{
+	if (initialized) {
+		return;
+	}
+
+	ARRAY_FOR_EACH_PTR(children, child) {
+		sys_slist_append(&free_children, &child->node);
+	}
+
+	k_work_queue_start(&indirect_work_q, indirect_stack,
+			   K_KERNEL_STACK_SIZEOF(indirect_stack),
+			   K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1), NULL);
+	k_thread_name_set(&indirect_work_q.thread, "ieee802154_indirect");
+
+	initialized = true;
+}
+
+static bool indirect_addr_valid(const struct net_linkaddr *addr)
+{
+	return addr && addr->addr &&
+	       (addr->len == IEEE802154_SHORT_ADDR_LENGTH ||
+		addr->len == IEEE802154_EXT_ADDR_LENGTH);
+}
+
+int ieee802154_indirect_child_add(struct net_if *iface, const struct net_linkaddr *addr)
+{
+	struct ieee802154_config config = {
+		.auto_ack_fpb = {
+			.enabled = true,
+			.mode = IEEE802154_FPB_ADDR_MATCH_THREAD,
+		},
+	};
+	struct indirect_child *child;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	int ret = 0;
+
+	if (!indirect_addr_valid(addr)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&indirect_mgmt_lock, K_FOREVER);
+
+	indirect_init();
+
+	key = k_spin_lock(&indirect_lock);
+
+	if (indirect_lookup(iface, addr->addr, addr->len)) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	node = sys_slist_get(&free_children);
+	if (!node) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	child = CONTAINER_OF(node, struct indirect_child, node);
+	*child = (struct indirect_child){
+		.iface = iface,
+		.addr_len = addr->len,
+	};
+	memcpy(child->addr, addr->addr, addr->len);
+	sys_slist_init(&child->frames);
+	sys_slist_prepend(indirect_bucket(child->addr, child->addr_len), &child->node);
+
+	k_spin_unlock(&indirect_lock, key);
+
+	/* Have the driver set the Frame Pending field only for children in
+	 * its table. Drivers without ACK generation leave it to the L2.
+	 */
+	if (ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_RX_TX_ACK) {
+		(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_AUTO_ACK_FPB, &config);
+	}
+
+	k_mutex_unlock(&indirect_mgmt_lock);
+
+	NET_DBG("Sleepy child added");
+
+	return 0;
+
+out:
+	k_spin_unlock(&indirect_lock, key);
+	k_mutex_unlock(&indirect_mgmt_lock);
+
+	return ret;
+}
+
+int ieee802154_indirect_child_remove(struct net_if *iface, const struct net_linkaddr *addr)
+{
+	struct indirect_child *child;
+	sys_slist_t dropped;
+	k_spinlock_key_t key;
+	bool fpb;
+
+	if (!indirect_addr_valid(addr)) {
+		return -ENOENT;
+	}
+
+	sys_slist_init(&dropped);
+
+	k_mutex_lock(&indirect_mgmt_lock, K_FOREVER);
+
+	if (!initialized) {
+		k_mutex_unlock(&indirect_mgmt_lock);
+		return -ENOENT;
+	}
+
+	key = k_spin_lock(&indirect_lock);
+
+	child = indirect_lookup(iface, addr->addr, addr->len);
+	if (!child) {
+		k_spin_unlock(&indirect_lock, key);
+		k_mutex_unlock(&indirect_mgmt_lock);
+		return -ENOENT;
+	}
+
+	indirect_drop_frames(child, &dropped, -1);
+
+	/* The work queue only refers to children through these lists. */
+	if (child->sync_pending) {
+		sys_slist_find_and_remove(&sync_list, &child->sync_node);
+		child->sync_pending = false;
+	}
+
+	if (child->poll_pending) {
+		sys_slist_find_and_remove(&poll_list, &child->poll_node);
+		child->poll_pending = false;
+	}
+
+	sys_slist_find_and_remove(indirect_bucket(child->addr, child->addr_len), &child->node);
+	fpb = child->fpb;
+	child->iface = NULL;
+	sys_slist_append(&free_children, &child->node);
+
+	k_spin_unlock(&indirect_lock, key);
+
+	indirect_free_frames(&dropped);
+
+	if (fpb && ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_RX_TX_ACK) {
+		uint8_t addr_le[IEEE802154_EXT_ADDR_LENGTH];
+		struct ieee802154_config config = {
+			.ack_fpb = {
+				.addr = addr_le,
+				.extended = addr->len == IEEE802154_EXT_ADDR_LENGTH,
+				.enabled = false,
+			},
+		};
+
+		sys_memcpy_swap(addr_le, addr->addr, addr->len);
+		(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_ACK_FPB, &config);
+	}
+
+	k_mutex_unlock(&indirect_mgmt_lock);
+
+	NET_DBG("Sleepy child removed");
+
+	return 0;
+}
+
+bool ieee802154_indirect_is_child(struct net_if *iface, const struct net_linkaddr *dst)
+{
+	k_spinlock_key_t key;
+	bool ret;
+
+	if (!initialized || !indirect_addr_valid(dst)) {
+		return false;
+	}
+
+	key = k_spin_lock(&indirect_lock);
+	ret = indirect_lookup(iface, dst->addr, dst->len) != NULL;
+	k_spin_unlock(&indirect_lock, key);
+
+	return ret;
+}
+
+int ieee802154_indirect_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag)
+{
+	struct net_linkaddr *dst = net_pkt_lladdr_dst(pkt);
+	struct indirect_frame_meta *meta;
+	struct indirect_child *child;
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+
+	/* Keep the common path to awake devices cheap. */
+	if (!ieee802154_indirect_is_child(iface, dst)) {
+		return -ENOENT;
+	}
+
+	if (frag->len > IEEE802154_MTU) {
+		return -EINVAL;
+	}
+
+	buf = net_buf_alloc(&indirect_frame_pool, K_NO_WAIT);
+	if (!buf) {
+		NET_DBG("No buffer for indirect frame");
+		return -ENOBUFS;
+	}
+
+	net_buf_add_mem(buf, frag->data, frag->len);
+	meta = net_buf_user_data(buf);
+	meta->expiry = k_uptime_get() + CONFIG_NET_L2_IEEE802154_INDIRECT_PERSISTENCE_TIME;
+
+	key = k_spin_lock(&indirect_lock);
+
+	child = indirect_lookup(iface, dst->addr, dst->len);
+	if (!child || child->queued == CONFIG_NET_L2_IEEE802154_INDIRECT_QUEUE_DEPTH) {
+		k_spin_unlock(&indirect_lock, key);
+		net_buf_unref(buf);
+		return child ? -ENOBUFS : -ENOENT;
+	}
+
+	sys_slist_append(&child->frames, &buf->node);
+	child->queued++;
+	indirect_request_sync(child);
+
+	/* Does not reschedule an earlier expiry. */
+	k_work_schedule_for_queue(&indirect_work_q, &indirect_expiry_work,
+				  K_MSEC(CONFIG_NET_L2_IEEE802154_INDIRECT_PERSISTENCE_TIME));
+
+	k_spin_unlock(&indirect_lock, key);
+
+	NET_DBG("Queued indirect frame %p", buf);
+
+	return 0;
+}
+
+/* Looks up the sender of a Data Request command, requires indirect_lock
+ * to be held.
+ */
+static struct indirect_child *indirect_lookup_src(struct net_if *iface,
+						  struct ieee802154_mpdu *mpdu)
+{
+	struct ieee802154_fcf_seq *fs = mpdu->mhr.fs;
+	struct ieee802154_address *src;
+	uint8_t addr[IEEE802154_EXT_ADDR_LENGTH];
+	uint8_t addr_len;
+
+	if (fs->fc.src_addr_mode == IEEE802154_ADDR_MODE_SHORT) {
+		addr_len = IEEE802154_SHORT_ADDR_LENGTH;
+	} else if (fs->fc.src_addr_mode == IEEE802154_ADDR_MODE_EXTENDED) {
+		addr_len = IEEE802154_EXT_ADDR_LENGTH;
+	} else {
+		return NULL;
+	}
+
+	src = fs->fc.pan_id_comp ? &mpdu->mhr.src_addr->comp.addr
+				 : &mpdu->mhr.src_addr->plain.addr;
+
+	/* Frames carry addresses in little endian. */
+	sys_memcpy_swap(addr, addr_len == IEEE802154_SHORT_ADDR_LENGTH
+				      ? (uint8_t *)&src->short_addr
+				      : src->ext_addr,
+			addr_len);
+
+	return indirect_lookup(iface, addr, addr_len);
+}
+
+static bool is_data_request(struct ieee802154_mpdu *mpdu)
+{
+	return mpdu->mhr.fs->fc.frame_type == IEEE802154_FRAME_TYPE_MAC_COMMAND &&
+	       mpdu->command && mpdu->command->cfi == IEEE802154_CFI_DATA_REQUEST;
+}
+
+bool ieee802154_indirect_frame_pending(struct net_if *iface, struct ieee802154_mpdu *mpdu)
+{
+	struct indirect_child *child;
+	k_spinlock_key_t key;
+	bool ret;
+
+	if (!initialized || !is_data_request(mpdu)) {
+		return false;
+	}
+
+	key = k_spin_lock(&indirect_lock);
+	child = indirect_lookup_src(iface, mpdu);
+	ret = child && child->queued > 0U;
+	k_spin_unlock(&indirect_lock, key);
+
+	return ret;
+}
+
+void ieee802154_indirect_handle_poll(struct net_if *iface, struct ieee802154_mpdu *mpdu)
+{
+	struct indirect_child *child;
+	k_spinlock_key_t key;
+
+	if (!initialized || !is_data_request(mpdu)) {
+		return;
+	}
+
+	key = k_spin_lock(&indirect_lock);
+
+	child = indirect_lookup_src(iface, mpdu);
+	if (child && child->queued > 0U && !child->poll_pending) {
+		child->poll_pending = true;
+		sys_slist_append(&poll_list, &child->poll_node);
+		k_work_submit_to_queue(&indirect_work_q, &indirect_poll_work);
+	}
+
+	k_spin_unlock(&indirect_lock, key);
+}
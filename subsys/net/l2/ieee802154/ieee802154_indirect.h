@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Private IEEE 802.15.4 indirect transmission helpers
+ *
+ * These utilities are internal to the native IEEE 802.15.4 L2
+ * stack and must not be included and used elsewhere.
+ *
+ * All references to the spec refer to IEEE 802.15.4-2020.
+ */
+
+#ifndef __IEEE802154_INDIRECT_H__
+#define __IEEE802154_INDIRECT_H__
+
+#include <errno.h>
+
+#include <zephyr/net/buf.h>
+#include <zephyr/net/ieee802154_indirect.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_linkaddr.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ieee802154_frame.h"
+
+#ifdef CONFIG_NET_L2_IEEE802154_INDIRECT
+
+/**
+ * @brief Checks whether the given destination is a registered sleepy child.
+ *
+ * @param iface A valid pointer on a network interface
+ * @param dst Link layer destination address, in big endian
+ *
+ * @return true if frames to @p dst are sent indirectly, false otherwise
+ */
+bool ieee802154_indirect_is_child(struct net_if *iface, const struct net_linkaddr *dst);
+
+/**
+ * @brief Queues a copy of the given fragment if its destination is a
+ *        registered sleepy child.
+ *
+ * @param iface A valid pointer on a network interface to send from
+ * @param pkt A valid pointer on a packet to send
+ * @param frag The fragment to be sent
+ *
+ * @return 0 if the fragment was queued, -ENOENT if the fragment has to be
+ *         sent directly, -ENOBUFS if the child's queue is full
+ */
+int ieee802154_indirect_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag);
+
+/**
+ * @brief Checks whether frames are pending for the sender of the given
+ *        validated Data Request command, see section 6.7.3.
+ *
+ * Used by the software ACK path to set the Frame Pending field.
+ *
+ * @param iface A valid pointer on the receiving network interface
+ * @param mpdu The validated MPDU of the Data Request command
+ *
+ * @return true if at least one frame is queued for the sender
+ */
+bool ieee802154_indirect_frame_pending(struct net_if *iface, struct ieee802154_mpdu *mpdu);
+
+/**
+ * @brief Sends the next frame queued for the sender of the given
+ *        validated Data Request command. Must be called after the
+ *        command has been acknowledged.
+ *
+ * @param iface A valid pointer on the receiving network interface
+ * @param mpdu The validated MPDU of the Data Request command
+ */
+void ieee802154_indirect_handle_poll(struct net_if *iface, struct ieee802154_mpdu *mpdu);
+
+#else
+
+static inline bool ieee802154_indirect_is_child(struct net_if *iface,
+						const struct net_linkaddr *dst)
+{
+	return false;
+}
+
+static inline int ieee802154_indirect_send(struct net_if *iface, struct net_pkt *pkt,
+					   struct net_buf *frag)
+{
+	return -ENOENT;
+}
+
+static inline bool ieee802154_indirect_frame_pending(struct net_if *iface,
+						     struct ieee802154_mpdu *mpdu)
+{
+	return false;
+}
+
+static inline void ieee802154_indirect_handle_poll(struct net_if *iface,
+						   struct ieee802154_mpdu *mpdu)
+{
+}
+
+#endif /* CONFIG_NET_L2_IEEE802154_INDIRECT */
+
+#endif /* __IEEE802154_INDIRECT_H__ */
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 link quality estimation
+ *
+ * Channels: the share of busy clear channel assessments of the CSMA-CA
+ * channel access run by the L2 is averaged per channel.
+ *
+ * Neighbors: each frame requesting an ACK gives an ETX sample, the number
+ * of transmission attempts if it was acknowledged and a fixed penalty
+ * otherwise. Frames handed to drivers that retransmit by themselves count
+ * as one attempt.
+ *
+ * Both tables forget their least recently used entry when full.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_link_quality, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_link_quality.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/util.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "ieee802154_link_quality.h"
+
+/* Weights of new samples in the moving averages, as power of two
+ * divisors.
+ */
+#define LQ_BUSY_WEIGHT_SHIFT 4
+#define LQ_ETX_WEIGHT_SHIFT  3
+
+/* ETX sample of a frame that was not acknowledged, in transmissions */
+#define LQ_ETX_NOACK_PENALTY 12U
+
+#define LQ_ETX_MAX UINT16_MAX
+
+struct lq_channel {
+	struct net_if *iface;
+	struct ieee802154_channel_quality quality;
+	uint32_t last_used;
+	bool in_use;
+};
+
+struct lq_neighbor {
+	struct net_if *iface;
+	struct ieee802154_neighbor_quality quality;
+	uint32_t last_used;
+	bool in_use;
+};
+
+/* Updated from the TX path and read from any thread, so the tables are
+ * guarded by a spinlock. Entries are aged by a use counter.
+ */
+static struct k_spinlock lq_lock;
+
+static struct {
+	struct lq_channel channels[CONFIG_NET_L2_IEEE802154_LINK_QUALITY_MAX_CHANNELS];
+	struct lq_neighbor neighbors[CONFIG_NET_L2_IEEE802154_LINK_QUALITY_MAX_NEIGHBORS];
+	uint32_t clock;
+} lq;
+
+static inline int32_t lq_average(int32_t avg, int32_t sample, uint8_t shift)
+{
+	return avg + ((sample - avg) >> shift);
+}
+
+/* Must be called with lq_lock held. */
+static struct lq_channel *lq_channel_get(struct net_if *iface, bool alloc)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	struct lq_channel *oldest = NULL;
+
+	ARRAY_FOR_EACH_PTR(lq.channels, entry) {
+		if (entry->in_use && entry->iface == iface &&
+		    entry->quality.channel == ctx->channel) {
+			entry->last_used = ++lq.clock;
+			return entry;
+		}
+	}
+
+	if (!alloc) {
+		return NULL;
+	}
+
+	ARRAY_FOR_EACH_PTR(lq.channels, entry) {
+		if (!entry->in_use) {
+			oldest = entry;
+			break;
+		}
+
+		if (oldest == NULL || (int32_t)(entry->last_used - oldest->last_used) < 0) {
+			oldest = entry;
+		}
+	}
+
+	memset(oldest, 0, sizeof(*oldest));
+	oldest->iface = iface;
+	oldest->quality.channel = ctx->channel;
+	oldest->last_used = ++lq.clock;
+	oldest->in_use = true;
+
+	return oldest;
+}
+
+/* Must be called with lq_lock held. */
+static struct lq_neighbor *lq_neighbor_get(struct net_if *iface, const uint8_t *addr,
+					   uint8_t len, bool alloc)
+{
+	struct lq_neighbor *oldest = NULL;
+
+	ARRAY_FOR_EACH_PTR(lq.neighbors, entry) {
+		if (entry->in_use && entry->iface == iface && entry->quality.addr_len == len &&
+		    !memcmp(entry->quality.addr, addr, len)) {
+			if (alloc) {
+				entry->last_used = ++lq.clock;
+			}
+
+			return entry;
+		}
+	}
+
+	if (!alloc) {
+		return NULL;
+	}
+
+	ARRAY_FOR_EACH_PTR(lq.neighbors, entry) {
+		if (!entry->in_use) {
+			oldest = entry;
+			break;
+		}
+
+		if (oldest == NULL || (int32_t)(entry->last_used - oldest->last_used) < 0) {
+			oldest = entry;
+		}
+	}
+
+	memset(oldest, 0, sizeof(*oldest));
+	oldest->iface = iface;
+	memcpy(oldest->quality.addr, addr, len);
+	oldest->quality.addr_len = len;
+	oldest->last_used = ++lq.clock;
+	oldest->in_use = true;
+
+	return oldest;
+}
+
+void ieee802154_link_quality_cca(struct net_if *iface, bool busy)
+{
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+	struct lq_channel *entry = lq_channel_get(iface, true);
+
+	entry->quality.cca++;
+	if (busy) {
+		entry->quality.cca_busy++;
+	}
+
+	entry->quality.busy = lq_average(entry->quality.busy,
+					 busy ? IEEE802154_BUSY_DIVISOR : 0,
+					 LQ_BUSY_WEIGHT_SHIFT);
+
+	k_spin_unlock(&lq_lock, key);
+}
+
+void ieee802154_link_quality_access_failed(struct net_if *iface)
+{
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	lq_channel_get(iface, true)->quality.access_failed++;
+
+	k_spin_unlock(&lq_lock, key);
+}
+
+uint16_t ieee802154_link_quality_channel_busy(struct net_if *iface)
+{
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+	struct lq_channel *entry = lq_channel_get(iface, false);
+	uint16_t busy = entry ? entry->quality.busy : 0U;
+
+	k_spin_unlock(&lq_lock, key);
+
+	return busy;
+}
+
+void ieee802154_link_quality_tx_done(struct net_if *iface, struct net_pkt *pkt,
+				     uint8_t attempts, bool acked)
+{
+	struct net_linkaddr *dst = net_pkt_lladdr_dst(pkt);
+	int32_t sample = (acked ? attempts : LQ_ETX_NOACK_PENALTY) * IEEE802154_ETX_DIVISOR;
+	struct lq_neighbor *entry;
+	k_spinlock_key_t key;
+
+	if (!dst->addr ||
+	    (dst->len != IEEE802154_SHORT_ADDR_LENGTH && dst->len != IEEE802154_EXT_ADDR_LENGTH)) {
+		return;
+	}
+
+	key = k_spin_lock(&lq_lock);
+
+	entry = lq_neighbor_get(iface, dst->addr, dst->len, true);
+
+	if (entry->quality.tx == 0U) {
+		entry->quality.etx = MIN(sample, LQ_ETX_MAX);
+	} else {
+		entry->quality.etx =
+			MIN(lq_average(entry->quality.etx, sample, LQ_ETX_WEIGHT_SHIFT), LQ_ETX_MAX);
+	}
+
+	entry->quality.tx++;
+	if (!acked) {
+		entry->quality.tx_failed++;
+	}
+
+	k_spin_unlock(&lq_lock, key);
+}
+
+int ieee802154_neighbor_quality_get(struct net_if *iface, const struct net_linkaddr *addr,
+				    struct ieee802154_neighbor_quality *quality)
+{
+	struct lq_neighbor *entry;
+	k_spinlock_key_t key;
+	int ret = -ENOENT;
+
+	key = k_spin_lock(&lq_lock);
+
+	entry = lq_neighbor_get(iface, addr->addr, addr->len, false);
+	if (entry) {
+		*quality = entry->quality;
+		ret = 0;
+	}
+
+	k_spin_unlock(&lq_lock, key);
+
+	return ret;
+}
+
+void ieee802154_neighbor_quality_foreach(struct net_if *iface,
+					 ieee802154_neighbor_quality_cb_t cb, void *user_data)
+{
+	ARRAY_FOR_EACH_PTR(lq.neighbors, entry) {
+		struct ieee802154_neighbor_quality quality;
+		k_spinlock_key_t key = k_spin_lock(&lq_lock);
+		bool found = entry->in_use && entry->iface == iface;
+
+		if (found) {
+			quality = entry->quality;
+		}
+
+		k_spin_unlock(&lq_lock, key);
+
+		if (found) {
+			cb(&quality, user_data);
+		}
+	}
+}
+
+void ieee802154_channel_quality_foreach(struct net_if *iface,
+					ieee802154_channel_quality_cb_t cb, void *user_data)
+{
+	ARRAY_FOR_EACH_PTR(lq.channels, entry) {
+		struct ieee802154_channel_quality quality;
+		k_spinlock_key_t key = k_spin_lock(&lq_lock);
+		bool found = entry->in_use && entry->iface == iface;
+
+		if (found) {
+			quality = entry->quality;
+		}
+
+		k_spin_unlock(&lq_lock, key);
+
+		if (found) {
+			cb(&quality, user_data);
+		}
+	}
+}
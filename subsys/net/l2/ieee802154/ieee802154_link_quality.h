@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Private IEEE 802.15.4 link quality estimation helpers
+ *
+ * These utilities are internal to the native IEEE 802.15.4 L2
+ * stack and must not be included and used elsewhere.
+ */
+
+#ifndef __IEEE802154_LINK_QUALITY_H__
+#define __IEEE802154_LINK_QUALITY_H__
+
+#include <zephyr/net/ieee802154_link_quality.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef CONFIG_NET_L2_IEEE802154_LINK_QUALITY
+
+/**
+ * @brief Records the result of a clear channel assessment on the current
+ *        channel.
+ *
+ * @param iface A valid pointer on a network interface
+ * @param busy true if the channel was found busy
+ */
+void ieee802154_link_quality_cca(struct net_if *iface, bool busy);
+
+/**
+ * @brief Records a channel access failure on the current channel.
+ *
+ * @param iface A valid pointer on a network interface
+ */
+void ieee802154_link_quality_access_failed(struct net_if *iface);
+
+/**
+ * @brief Gets the share of busy clear channel assessments on the current
+ *        channel.
+ *
+ * @param iface A valid pointer on a network interface
+ *
+ * @return busy ratio in units of 1/IEEE802154_BUSY_DIVISOR, 0 for channels
+ *         without statistics
+ */
+uint16_t ieee802154_link_quality_channel_busy(struct net_if *iface);
+
+/**
+ * @brief Records the outcome of a frame sent with an ACK requested.
+ *
+ * @param iface A valid pointer on a network interface
+ * @param pkt A valid pointer on the sent packet, the neighbor is its link
+ *        layer destination
+ * @param attempts Number of transmission attempts
+ * @param acked true if the frame was acknowledged
+ */
+void ieee802154_link_quality_tx_done(struct net_if *iface, struct net_pkt *pkt,
+				     uint8_t attempts, bool acked);
+
+#else
+
+static inline void ieee802154_link_quality_cca(struct net_if *iface, bool busy)
+{
+}
+
+static inline void ieee802154_link_quality_access_failed(struct net_if *iface)
+{
+}
+
+static inline uint16_t ieee802154_link_quality_channel_busy(struct net_if *iface)
+{
+	return 0U;
+}
+
+static inline void ieee802154_link_quality_tx_done(struct net_if *iface, struct net_pkt *pkt,
+						   uint8_t attempts, bool acked)
+{
+}
+
+#endif /* CONFIG_NET_L2_IEEE802154_LINK_QUALITY */
+
+#endif /* __IEEE802154_LINK_QUALITY_H__ */
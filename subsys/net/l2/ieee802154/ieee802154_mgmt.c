@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(net_ieee802154_mgmt, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 #include <zephyr/net/ieee802154_mgmt.h>
 #include <zephyr/net/ieee802154.h>
 
+#include "ieee802154_arbiter.h"
 #include "ieee802154_frame.h"
 #include "ieee802154_mgmt_priv.h"
 #include "ieee802154_priv.h"
@@ -40,7 +41,7 @@ enum net_verdict ieee802154_handle_beacon(struct net_if *iface,
 
 	NET_DBG("Beacon received");
 
-	if (!ctx->scan_ctx) {
+	if (!ctx->scan_ctx || ctx->scan_ed) {
 		return NET_DROP;
 	}
 
@@ -50,6 +51,11 @@ enum net_verdict ieee802154_handle_beacon(struct net_if *iface,
 
 	k_sem_take(&ctx->scan_ctx_lock, K_FOREVER);
 
+	if (!ctx->scan_ctx) {
+		k_sem_give(&ctx->scan_ctx_lock);
+		return NET_DROP;
+	}
+
 	ctx->scan_ctx->pan_id = mpdu->mhr.src_addr->plain.pan_id;
 	ctx->scan_ctx->lqi = lqi;
 
@@ -67,6 +73,7 @@ enum net_verdict ieee802154_handle_beacon(struct net_if *iface,
 	net_mgmt_event_notify(NET_EVENT_IEEE802154_SCAN_RESULT, iface);
 
 	k_sem_give(&ctx->scan_ctx_lock);
+	k_sem_give(&ctx->scan_event);
 
 	return NET_CONTINUE;
 }
@@ -85,12 +92,95 @@ static int ieee802154_cancel_scan(uint32_t mgmt_request, struct net_if *iface,
 	ctx->scan_ctx = NULL;
 	k_sem_give(&ctx->scan_ctx_lock);
 
+	/* Cut the current channel dwell short. */
+	k_sem_give(&ctx->scan_event);
+
 	return 0;
 }
 
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_IEEE802154_CANCEL_SCAN,
 				  ieee802154_cancel_scan);
 
+/* Time granted to drivers to report an energy detection result on top of the
+ * measurement duration.
+ */
+#define SCAN_ED_SLACK_MS 10
+
+/* Waits until the channel dwell of a passive or active scan is over, see
+ * section 6.3.1.1: The dwell ends early when the scan is cancelled or, during
+ * active scans, when no more beacons were heard for a while.
+ */
+static void scan_dwell(struct ieee802154_context *ctx, bool active, uint32_t duration)
+{
+	int64_t end = k_uptime_get() + duration;
+	int64_t deadline = end;
+	int64_t remaining;
+
+	while (true) {
+		remaining = deadline - k_uptime_get();
+		if (remaining <= 0 || k_sem_take(&ctx->scan_event, K_MSEC(remaining))) {
+			return;
+		}
+
+		if (!ctx->scan_ctx) {
+			return;
+		}
+
+		if (active && CONFIG_NET_L2_IEEE802154_SCAN_QUIET_TIME > 0) {
+			deadline = MIN(end, k_uptime_get() + CONFIG_NET_L2_IEEE802154_SCAN_QUIET_TIME);
+		}
+	}
+}
+
+static void scan_ed_done(const struct device *dev, int16_t max_ed)
+{
+	struct net_if *iface = net_if_lookup_by_dev(dev);
+	struct ieee802154_context *ctx;
+
+	if (!iface) {
+		return;
+	}
+
+	ctx = net_if_l2_data(iface);
+	ctx->scan_max_ed = max_ed;
+	k_sem_give(&ctx->scan_event);
+}
+
+/* Measures the energy on the current channel, see section 6.3.1.2. The
+ * measurement runs in the driver and its result is reported as soon as it is
+ * available rather than after a fixed sleep.
+ */
+static int scan_energy(struct net_if *iface, struct ieee802154_req_params *scan)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	int ret;
+
+	ret = ieee802154_radio_ed_scan(iface, scan->duration, scan_ed_done);
+	if (ret) {
+		NET_DBG("Could not start energy detection (%d)", ret);
+		return ret;
+	}
+
+	if (k_sem_take(&ctx->scan_event, K_MSEC(scan->duration + SCAN_ED_SLACK_MS))) {
+		NET_DBG("Energy detection timed out");
+		return -EIO;
+	}
+
+	k_sem_take(&ctx->scan_ctx_lock, K_FOREVER);
+
+	if (!ctx->scan_ctx) {
+		k_sem_give(&ctx->scan_ctx_lock);
+		return -ECANCELED;
+	}
+
+	scan->energy_level = ctx->scan_max_ed;
+	net_mgmt_event_notify(NET_EVENT_IEEE802154_SCAN_RESULT, iface);
+
+	k_sem_give(&ctx->scan_ctx_lock);
+
+	return 0;
+}
+
 static int ieee802154_scan(uint32_t mgmt_request, struct net_if *iface,
 			   void *data, size_t len)
 {
@@ -108,14 +198,26 @@ static int ieee802154_scan(uint32_t mgmt_request, struct net_if *iface,
 	scan = (struct ieee802154_req_params *)data;
 
 	NET_DBG("%s scan requested",
-		mgmt_request == NET_REQUEST_IEEE802154_ACTIVE_SCAN ?
-		"Active" : "Passive");
+		mgmt_request == NET_REQUEST_IEEE802154_ACTIVE_SCAN ? "Active" :
+		mgmt_request == NET_REQUEST_IEEE802154_PASSIVE_SCAN ? "Passive" : "Energy");
+
+	if (mgmt_request == NET_REQUEST_IEEE802154_ENERGY_SCAN &&
+	    !(ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_ENERGY_SCAN)) {
+		return -ENOTSUP;
+	}
+
+	/* The radio is kept during the whole scan. */
+	ret = ieee802154_arbiter_acquire(iface);
+	if (ret) {
+		return ret;
+	}
 
 	k_sem_take(&ctx->scan_ctx_lock, K_FOREVER);
 
 	if (ctx->scan_ctx) {
-		ret = -EALREADY;
-		goto out;
+		k_sem_give(&ctx->scan_ctx_lock);
+		ieee802154_arbiter_release(iface);
+		return -EALREADY;
 	}
 
 	if (mgmt_request == NET_REQUEST_IEEE802154_ACTIVE_SCAN) {
@@ -138,6 +240,7 @@ static int ieee802154_scan(uint32_t mgmt_request, struct net_if *iface,
 	}
 
 	ctx->scan_ctx = scan;
+	ctx->scan_ed = mgmt_request == NET_REQUEST_IEEE802154_ENERGY_SCAN;
 	k_sem_give(&ctx->scan_ctx_lock);
 
 	ret = 0;
@@ -173,6 +276,9 @@ static int ieee802154_scan(uint32_t mgmt_request, struct net_if *iface,
 			NET_DBG("Scanning channel %u", channel);
 			ieee802154_radio_set_channel(iface, channel);
 
+			/* Forget late beacons of the previous channel. */
+			k_sem_reset(&ctx->scan_event);
+
 			/* Active scan sends a beacon request */
 			if (mgmt_request == NET_REQUEST_IEEE802154_ACTIVE_SCAN) {
 				net_pkt_ref(pkt);
@@ -186,8 +292,15 @@ static int ieee802154_scan(uint32_t mgmt_request, struct net_if *iface,
 				}
 			}
 
-			/* Context aware sleep */
-			k_sleep(K_MSEC(scan->duration));
+			if (mgmt_request == NET_REQUEST_IEEE802154_ENERGY_SCAN) {
+				ret = scan_energy(iface, scan);
+				if (ret) {
+					goto out;
+				}
+			} else {
+				scan_dwell(ctx, mgmt_request == NET_REQUEST_IEEE802154_ACTIVE_SCAN,
+					   scan->duration);
+			}
 
 			k_sem_take(&ctx->scan_ctx_lock, K_FOREVER);
 
@@ -219,6 +332,8 @@ out:
 		net_pkt_unref(pkt);
 	}
 
+	ieee802154_arbiter_release(iface);
+
 	return ret;
 }
 
@@ -226,6 +341,8 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_IEEE802154_PASSIVE_SCAN,
 				  ieee802154_scan);
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_IEEE802154_ACTIVE_SCAN,
 				  ieee802154_scan);
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_IEEE802154_ENERGY_SCAN,
+				  ieee802154_scan);
 
 /* Requires the context lock to be held. */
 static inline void update_net_if_link_addr(struct net_if *iface, struct ieee802154_context *ctx)
@@ -261,6 +378,7 @@ static inline void set_association(struct net_if *iface, struct ieee802154_conte
 	ieee802154_radio_remove_src_short_addr(iface, ctx->short_addr);
 
 	ctx->short_addr = short_addr;
+	ieee802154_hdr_templates_flush(ctx);
 
 	if (short_addr == IEEE802154_NO_SHORT_ADDRESS_ASSIGNED) {
 		set_linkaddr_to_ext_addr(iface, ctx);
@@ -287,6 +405,7 @@ static inline void remove_association(struct net_if *iface, struct ieee802154_co
 
 	ctx->pan_id = IEEE802154_PAN_ID_NOT_ASSOCIATED;
 	ctx->short_addr = IEEE802154_SHORT_ADDRESS_NOT_ASSOCIATED;
+	ieee802154_hdr_templates_flush(ctx);
 
 	memset(ctx->coord_ext_addr, 0, sizeof(ctx->coord_ext_addr));
 	ctx->coord_short_addr = IEEE802154_SHORT_ADDRESS_NOT_ASSOCIATED;
@@ -427,6 +546,12 @@ out:
 		return ret;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_INDIRECT) &&
+	    mpdu->command->cfi == IEEE802154_CFI_DATA_REQUEST) {
+		/* Served by the indirect transmission queues after the ACK. */
+		return NET_CONTINUE;
+	}
+
 	NET_DBG("Drop MAC command, unsupported CFI: 0x%x",
 		mpdu->command->cfi);
 
@@ -528,6 +653,7 @@ static int ieee802154_associate(uint32_t mgmt_request, struct net_if *iface,
 	/* section 6.4.1, Association: Set macPanId to the coordinator's PAN ID. */
 	ieee802154_radio_remove_pan_id(iface, ctx->pan_id);
 	ctx->pan_id = req->pan_id;
+	ieee802154_hdr_templates_flush(ctx);
 	ieee802154_radio_filter_pan_id(iface, req->pan_id);
 
 	/* section 6.4.1, Association: Set macCoordExtendedAddress or
@@ -703,6 +829,8 @@ static int ieee802154_set_ack(uint32_t mgmt_request, struct net_if *iface,
 		ctx->ack_requested = false;
 	}
 
+	ieee802154_hdr_templates_flush(ctx);
+
 	k_sem_give(&ctx->ctx_lock);
 
 	return 0;
@@ -738,6 +866,12 @@ static int ieee802154_set_parameters(uint32_t mgmt_request,
 
 	value = *((uint16_t *) data);
 
+	/* Radio settings must only be changed by the owner of the radio. */
+	ret = ieee802154_arbiter_acquire(iface);
+	if (ret) {
+		return ret;
+	}
+
 	k_sem_take(&ctx->ctx_lock, K_FOREVER);
 
 	if (is_associated(ctx) && !(mgmt_request == NET_REQUEST_IEEE802154_SET_SHORT_ADDR &&
@@ -762,6 +896,7 @@ static int ieee802154_set_parameters(uint32_t mgmt_request,
 		if (ctx->pan_id != value) {
 			ieee802154_radio_remove_pan_id(iface, ctx->pan_id);
 			ctx->pan_id = value;
+			ieee802154_hdr_templates_flush(ctx);
 			ieee802154_radio_filter_pan_id(iface, ctx->pan_id);
 		}
 	} else if (mgmt_request == NET_REQUEST_IEEE802154_SET_EXT_ADDR) {
@@ -771,6 +906,7 @@ static int ieee802154_set_parameters(uint32_t mgmt_request,
 
 		if (memcmp(ctx->ext_addr, ext_addr_le, IEEE802154_EXT_ADDR_LENGTH)) {
 			memcpy(ctx->ext_addr, ext_addr_le, IEEE802154_EXT_ADDR_LENGTH);
+			ieee802154_hdr_templates_flush(ctx);
 
 			if (net_if_get_link_addr(iface)->len == IEEE802154_EXT_ADDR_LENGTH) {
 				set_linkaddr_to_ext_addr(iface, ctx);
@@ -804,6 +940,7 @@ static int ieee802154_set_parameters(uint32_t mgmt_request,
 
 out:
 	k_sem_give(&ctx->ctx_lock);
+	ieee802154_arbiter_release(iface);
 	return ret;
 }
 
@@ -905,6 +1042,7 @@ static int ieee802154_set_security_settings(uint32_t mgmt_request,
 	}
 
 	ieee802154_security_teardown_session(&ctx->sec_ctx);
+	ieee802154_hdr_templates_flush(ctx);
 
 	if (ieee802154_security_setup_session(&ctx->sec_ctx, params->level,
 					      params->key_mode, params->key,
@@ -28,6 +28,7 @@ static inline void ieee802154_mgmt_init(struct net_if *iface)
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 
 	k_sem_init(&ctx->scan_ctx_lock, 1, 1);
+	k_sem_init(&ctx->scan_event, 0, 1);
 }
 
 /**
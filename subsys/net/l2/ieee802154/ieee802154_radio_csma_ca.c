@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_ieee802154_csma, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 #include <errno.h>
 #include <stdlib.h>
 
+#include "ieee802154_link_quality.h"
 #include "ieee802154_priv.h"
 #include "ieee802154_utils.h"
 
@@ -25,11 +26,31 @@ BUILD_ASSERT(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE <=
 		     CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MAX_BE,
 	     "The CSMA/CA min backoff exponent must be less or equal max backoff exponent.");
 
+/* The standard starts with macMinBe. In adaptive mode the initial BE is
+ * scaled between macMinBe and macMaxBe by the share of busy CCAs observed
+ * on the channel.
+ */
+static inline uint8_t csma_ca_initial_be(struct net_if *iface)
+{
+	uint16_t busy;
+
+	if (!IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_ADAPTIVE)) {
+		return CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE;
+	}
+
+	busy = ieee802154_link_quality_channel_busy(iface);
+
+	return CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE +
+	       DIV_ROUND_CLOSEST((CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MAX_BE -
+				  CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE) * busy,
+				 IEEE802154_BUSY_DIVISOR);
+}
+
 /* See section 6.2.5.1. */
 static inline int unslotted_csma_ca_channel_access(struct net_if *iface)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
-	uint8_t be = CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE;
+	uint8_t be = csma_ca_initial_be(iface);
 	uint32_t turnaround_time, unit_backoff_period_us;
 
 	turnaround_time = ieee802154_radio_get_a_turnaround_time(iface);
@@ -52,6 +73,10 @@ static inline int unslotted_csma_ca_channel_access(struct net_if *iface)
 		}
 
 		ret = ieee802154_radio_cca(iface);
+		if (ret == 0 || ret == -EBUSY) {
+			ieee802154_link_quality_cca(iface, ret == -EBUSY);
+		}
+
 		if (ret == 0) {
 			/* Channel is idle -> CSMA Success */
 			return 0;
@@ -65,6 +90,8 @@ static inline int unslotted_csma_ca_channel_access(struct net_if *iface)
 	}
 
 	/* Channel is still busy after max backoffs -> CSMA Failure */
+	ieee802154_link_quality_access_failed(iface);
+
 	return -EBUSY;
 }
 
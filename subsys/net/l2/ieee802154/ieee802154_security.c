@@ -94,6 +94,13 @@ void ieee802154_security_teardown_session(struct ieee802154_security_ctx *sec_ct
 		return;
 	}
 
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	/* No new operations can be submitted while the context lock is held. */
+	while (atomic_get(&sec_ctx->pending_ops) > 0) {
+		k_sleep(K_MSEC(1));
+	}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
 	cipher_free_session(sec_ctx->enc.device, &sec_ctx->enc);
 	cipher_free_session(sec_ctx->dec.device, &sec_ctx->dec);
 	sec_ctx->level = IEEE802154_SECURITY_LEVEL_NONE;
@@ -128,16 +135,74 @@ static void prepare_cipher_aead_pkt(uint8_t *frame, uint8_t level, uint8_t ll_hd
 	apkt->pkt = pkt;
 }
 
-bool ieee802154_decrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
-			     uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
-			     uint8_t *src_ext_addr, uint32_t frame_counter)
+void ieee802154_security_op_init(struct ieee802154_security_op *op)
+{
+	op->sec_ctx = NULL;
+	op->status = 0;
+	k_sem_init(&op->done, 1, 1);
+}
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+static void security_op_done(struct cipher_pkt *completed, int status)
+{
+	struct ieee802154_security_op *op =
+		CONTAINER_OF(completed, struct ieee802154_security_op, pkt);
+
+	op->status = status;
+	atomic_dec(&op->sec_ctx->pending_ops);
+	k_sem_give(&op->done);
+}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
+static int security_op_submit(struct ieee802154_security_ctx *sec_ctx, struct cipher_ctx *cctx,
+			      struct ieee802154_security_op *op)
+{
+	op->sec_ctx = sec_ctx;
+	k_sem_reset(&op->done);
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	if (cctx->flags & CAP_ASYNC_OPS) {
+		int ret;
+
+		/* The driver may complete the operation before returning. */
+		atomic_inc(&sec_ctx->pending_ops);
+
+		ret = cipher_ccm_op(cctx, &op->apkt, op->nonce);
+		if (ret) {
+			op->status = ret;
+			atomic_dec(&sec_ctx->pending_ops);
+			k_sem_give(&op->done);
+		}
+
+		return ret;
+	}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
+	op->status = cipher_ccm_op(cctx, &op->apkt, op->nonce);
+	k_sem_give(&op->done);
+
+	return op->status;
+}
+
+bool ieee802154_security_op_wait(struct ieee802154_security_op *op)
+{
+	/* Keep the semaphore given so that waiting again returns at once. */
+	k_sem_take(&op->done, K_FOREVER);
+	k_sem_give(&op->done);
+
+	return op->status == 0;
+}
+
+bool ieee802154_decrypt_auth_submit(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
+				    uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
+				    uint8_t *src_ext_addr, uint32_t frame_counter,
+				    struct ieee802154_security_op *op)
 {
-	struct cipher_aead_pkt apkt;
-	struct cipher_pkt pkt;
-	uint8_t nonce[13];
 	uint8_t level;
 	int ret;
 
+	ieee802154_security_op_init(op);
+
 	if (!sec_ctx || sec_ctx->level == IEEE802154_SECURITY_LEVEL_NONE) {
 		return true;
 	}
@@ -145,13 +210,14 @@ bool ieee802154_decrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *f
 	level = sec_ctx->level;
 
 	/* See section 9.3.3.1 */
-	memcpy(nonce, src_ext_addr, IEEE802154_EXT_ADDR_LENGTH);
-	sys_put_be32(frame_counter, &nonce[8]);
-	nonce[12] = level;
+	memcpy(op->nonce, src_ext_addr, IEEE802154_EXT_ADDR_LENGTH);
+	sys_put_be32(frame_counter, &op->nonce[8]);
+	op->nonce[12] = level;
 
-	prepare_cipher_aead_pkt(frame, level, ll_hdr_len, payload_len, authtag_len, &apkt, &pkt);
+	prepare_cipher_aead_pkt(frame, level, ll_hdr_len, payload_len, authtag_len, &op->apkt,
+				&op->pkt);
 
-	ret = cipher_ccm_op(&sec_ctx->dec, &apkt, nonce);
+	ret = security_op_submit(sec_ctx, &sec_ctx->dec, op);
 	if (ret) {
 		NET_ERR("Cannot decrypt/auth (%i): %p %u/%u - fc %u", ret, frame, ll_hdr_len,
 			payload_len, frame_counter);
@@ -161,16 +227,26 @@ bool ieee802154_decrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *f
 	return true;
 }
 
-bool ieee802154_encrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
+bool ieee802154_decrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
 			     uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
-			     uint8_t *src_ext_addr)
+			     uint8_t *src_ext_addr, uint32_t frame_counter)
+{
+	struct ieee802154_security_op op;
+
+	return ieee802154_decrypt_auth_submit(sec_ctx, frame, ll_hdr_len, payload_len,
+					      authtag_len, src_ext_addr, frame_counter, &op) &&
+	       ieee802154_security_op_wait(&op);
+}
+
+bool ieee802154_encrypt_auth_submit(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
+				    uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
+				    uint8_t *src_ext_addr, struct ieee802154_security_op *op)
 {
-	struct cipher_aead_pkt apkt;
-	struct cipher_pkt pkt;
-	uint8_t nonce[13];
 	uint8_t level;
 	int ret;
 
+	ieee802154_security_op_init(op);
+
 	if (!sec_ctx || sec_ctx->level == IEEE802154_SECURITY_LEVEL_NONE) {
 		return true;
 	}
@@ -188,13 +264,14 @@ bool ieee802154_encrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *f
 	}
 
 	/* See section 9.3.3.1 */
-	memcpy(nonce, src_ext_addr, IEEE802154_EXT_ADDR_LENGTH);
-	sys_put_be32(sec_ctx->frame_counter, &nonce[8]);
-	nonce[12] = level;
+	memcpy(op->nonce, src_ext_addr, IEEE802154_EXT_ADDR_LENGTH);
+	sys_put_be32(sec_ctx->frame_counter, &op->nonce[8]);
+	op->nonce[12] = level;
 
-	prepare_cipher_aead_pkt(frame, level, ll_hdr_len, payload_len, authtag_len, &apkt, &pkt);
+	prepare_cipher_aead_pkt(frame, level, ll_hdr_len, payload_len, authtag_len, &op->apkt,
+				&op->pkt);
 
-	ret = cipher_ccm_op(&sec_ctx->enc, &apkt, nonce);
+	ret = security_op_submit(sec_ctx, &sec_ctx->enc, op);
 	if (ret) {
 		NET_ERR("Cannot encrypt/auth (%i): %p %u/%u - fc %u", ret, frame, ll_hdr_len,
 			payload_len, sec_ctx->frame_counter);
@@ -206,6 +283,17 @@ bool ieee802154_encrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *f
 	return true;
 }
 
+bool ieee802154_encrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
+			     uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
+			     uint8_t *src_ext_addr)
+{
+	struct ieee802154_security_op op;
+
+	return ieee802154_encrypt_auth_submit(sec_ctx, frame, ll_hdr_len, payload_len,
+					      authtag_len, src_ext_addr, &op) &&
+	       ieee802154_security_op_wait(&op);
+}
+
 int ieee802154_security_init(struct ieee802154_security_ctx *sec_ctx)
 {
 	const struct device *dev;
@@ -221,6 +309,19 @@ int ieee802154_security_init(struct ieee802154_security_ctx *sec_ctx)
 	sec_ctx->enc.flags = crypto_query_hwcaps(dev);
 	sec_ctx->dec.flags = crypto_query_hwcaps(dev);
 
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC
+	/* Sessions are either synchronous or asynchronous, prefer the latter. */
+	if ((sec_ctx->enc.flags & CAP_ASYNC_OPS) && !cipher_callback_set(dev, security_op_done)) {
+		sec_ctx->enc.flags &= ~CAP_SYNC_OPS;
+		sec_ctx->dec.flags &= ~CAP_SYNC_OPS;
+	} else {
+		sec_ctx->enc.flags &= ~CAP_ASYNC_OPS;
+		sec_ctx->dec.flags &= ~CAP_ASYNC_OPS;
+	}
+
+	atomic_set(&sec_ctx->pending_ops, 0);
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY_ASYNC */
+
 	sec_ctx->enc.mode_params.ccm_info.nonce_len = 13U;
 	sec_ctx->dec.mode_params.ccm_info.nonce_len = 13U;
 
@@ -13,8 +13,24 @@
 
 #ifdef CONFIG_NET_L2_IEEE802154_SECURITY
 
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/kernel.h>
 #include <zephyr/net/ieee802154.h>
 
+/**
+ * @brief State of a single AES-CCM* operation.
+ *
+ * Must stay valid until @ref ieee802154_security_op_wait returned.
+ */
+struct ieee802154_security_op {
+	struct ieee802154_security_ctx *sec_ctx;
+	struct cipher_aead_pkt apkt;
+	struct cipher_pkt pkt;
+	uint8_t nonce[13];
+	struct k_sem done;
+	int status;
+};
+
 int ieee802154_security_setup_session(struct ieee802154_security_ctx *sec_ctx, uint8_t level,
 				      uint8_t key_mode, uint8_t *key, uint8_t key_len);
 
@@ -51,6 +67,60 @@ bool ieee802154_encrypt_auth(struct ieee802154_security_ctx *sec_ctx, uint8_t *f
 			     uint8_t ll_hdr_len, uint8_t payload_len,
 			     uint8_t authtag_len, uint8_t *src_ext_addr);
 
+/**
+ * @brief Start decrypting an authenticated payload.
+ *
+ * Same as @ref ieee802154_decrypt_auth but returns as soon as the operation
+ * has been submitted to a crypto device supporting asynchronous operations.
+ * The frame must not be touched before @ref ieee802154_security_op_wait
+ * returned, which must be called even if submitting failed.
+ *
+ * @param op Operation state, initialized by this function.
+ *
+ * @return true if the operation has been submitted or is not needed, false
+ *         on error.
+ */
+bool ieee802154_decrypt_auth_submit(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
+				    uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
+				    uint8_t *src_ext_addr, uint32_t frame_counter,
+				    struct ieee802154_security_op *op);
+
+/**
+ * @brief Start encrypting an authenticated payload.
+ *
+ * Same as @ref ieee802154_encrypt_auth but returns as soon as the operation
+ * has been submitted to a crypto device supporting asynchronous operations.
+ * The frame counter is consumed immediately, so frames must be sent in the
+ * order they have been submitted.
+ *
+ * @param op Operation state, initialized by this function.
+ *
+ * @return true if the operation has been submitted or is not needed, false
+ *         on error.
+ */
+bool ieee802154_encrypt_auth_submit(struct ieee802154_security_ctx *sec_ctx, uint8_t *frame,
+				    uint8_t ll_hdr_len, uint8_t payload_len, uint8_t authtag_len,
+				    uint8_t *src_ext_addr, struct ieee802154_security_op *op);
+
+/**
+ * @brief Initialize an operation as completed successfully, for frames that
+ *        turn out to need no security processing.
+ *
+ * @param op Operation state.
+ */
+void ieee802154_security_op_init(struct ieee802154_security_op *op);
+
+/**
+ * @brief Wait for a submitted operation to complete.
+ *
+ * May be called more than once.
+ *
+ * @param op Operation state.
+ *
+ * @return true if the operation succeeded, false otherwise.
+ */
+bool ieee802154_security_op_wait(struct ieee802154_security_op *op);
+
 int ieee802154_security_init(struct ieee802154_security_ctx *sec_ctx);
 
 #else
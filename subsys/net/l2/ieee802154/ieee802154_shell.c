@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_ieee802154_shell, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 #include <zephyr/sys/printk.h>
 
 #include <zephyr/net/net_if.h>
+#include <zephyr/net/ieee802154_link_quality.h>
 #include <zephyr/net/ieee802154_mgmt.h>
 
 #include "ieee802154_frame.h"
@@ -208,11 +209,19 @@ static inline char *print_coordinator_address(char *buf, int buf_len)
 	return buf;
 }
 
+static bool energy_scan;
+
 static void scan_result_cb(struct net_mgmt_event_callback *cb,
 			   uint32_t mgmt_event, struct net_if *iface)
 {
 	char buf[64];
 
+	if (energy_scan) {
+		shell_fprintf(cb_shell, SHELL_NORMAL, "\nChannel: %u\tEnergy: %d dBm\n",
+			      params.channel, params.energy_level);
+		return;
+	}
+
 	shell_fprintf(cb_shell, SHELL_NORMAL,
 		      "\nChannel: %u\tPAN ID: %u\tCoordinator Address: %s\t "
 		      "LQI: %u\n", params.channel, params.pan_id,
@@ -247,6 +256,8 @@ static int cmd_ieee802154_scan(const struct shell *sh,
 		scan_type = NET_REQUEST_IEEE802154_ACTIVE_SCAN;
 	} else if (!strcmp(argv[1], "passive")) {
 		scan_type = NET_REQUEST_IEEE802154_PASSIVE_SCAN;
+	} else if (!strcmp(argv[1], "energy")) {
+		scan_type = NET_REQUEST_IEEE802154_ENERGY_SCAN;
 	} else {
 		ret = -ENOEXEC;
 		goto release_event_cb;
@@ -267,18 +278,22 @@ static int cmd_ieee802154_scan(const struct shell *sh,
 
 	shell_fprintf(sh, SHELL_NORMAL,
 		      "%s Scanning (channel set: 0x%08x, duration %u ms)...\n",
-		      scan_type == NET_REQUEST_IEEE802154_ACTIVE_SCAN ?
-		      "Active" : "Passive", params.channel_set,
-		      params.duration);
+		      scan_type == NET_REQUEST_IEEE802154_ACTIVE_SCAN ? "Active" :
+		      scan_type == NET_REQUEST_IEEE802154_PASSIVE_SCAN ? "Passive" : "Energy",
+		      params.channel_set, params.duration);
 
 	cb_shell = sh;
+	energy_scan = scan_type == NET_REQUEST_IEEE802154_ENERGY_SCAN;
 
 	if (scan_type == NET_REQUEST_IEEE802154_ACTIVE_SCAN) {
 		ret = net_mgmt(NET_REQUEST_IEEE802154_ACTIVE_SCAN, iface,
 			       &params, sizeof(struct ieee802154_req_params));
-	} else {
+	} else if (scan_type == NET_REQUEST_IEEE802154_PASSIVE_SCAN) {
 		ret = net_mgmt(NET_REQUEST_IEEE802154_PASSIVE_SCAN, iface,
 			       &params, sizeof(struct ieee802154_req_params));
+	} else {
+		ret = net_mgmt(NET_REQUEST_IEEE802154_ENERGY_SCAN, iface,
+			       &params, sizeof(struct ieee802154_req_params));
 	}
 
 	if (ret) {
@@ -620,6 +635,62 @@ static int cmd_ieee802154_get_tx_power(const struct shell *sh,
 	return 0;
 }
 
+#ifdef CONFIG_NET_L2_IEEE802154_LINK_QUALITY
+/* Prints fixed point values with two decimals. */
+#define FRAC_100(val, div) ((uint32_t)(((val) % (div)) * 100U / (div)))
+
+static void print_channel_quality(const struct ieee802154_channel_quality *quality,
+				  void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_fprintf(sh, SHELL_NORMAL, "Channel %u: busy %u.%02u, %u CCA (%u busy), %u failures\n",
+		      quality->channel, quality->busy / IEEE802154_BUSY_DIVISOR,
+		      FRAC_100(quality->busy, IEEE802154_BUSY_DIVISOR), quality->cca,
+		      quality->cca_busy, quality->access_failed);
+}
+
+static void print_neighbor_quality(const struct ieee802154_neighbor_quality *quality,
+				   void *user_data)
+{
+	const struct shell *sh = user_data;
+	char addr[EXT_ADDR_STR_SIZE];
+	int pos = 0;
+
+	for (int i = 0; i < quality->addr_len; i++) {
+		pos += snprintk(addr + pos, sizeof(addr) - pos, "%02X%s", quality->addr[i],
+				i + 1 < quality->addr_len ? ":" : "");
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "Neighbor %s: ETX %u.%02u, %u TX (%u failed)\n", addr,
+		      quality->etx / IEEE802154_ETX_DIVISOR,
+		      FRAC_100(quality->etx, IEEE802154_ETX_DIVISOR), quality->tx,
+		      quality->tx_failed);
+}
+
+static int cmd_ieee802154_link_quality(const struct shell *sh,
+				       size_t argc, char *argv[])
+{
+	struct net_if *iface = net_if_get_ieee802154();
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (!iface) {
+		shell_fprintf(sh, SHELL_INFO,
+			      "No IEEE 802.15.4 interface found.\n");
+		return -ENOEXEC;
+	}
+
+	ieee802154_channel_quality_foreach(iface, print_channel_quality, (void *)sh);
+	ieee802154_neighbor_quality_foreach(iface, print_neighbor_quality, (void *)sh);
+
+	return 0;
+}
+#else
+#define cmd_ieee802154_link_quality NULL
+#endif /* CONFIG_NET_L2_IEEE802154_LINK_QUALITY */
+
 SHELL_STATIC_SUBCMD_SET_CREATE(ieee802154_commands,
 	SHELL_CMD(ack, NULL,
 		  "<set/1 | unset/0> Set auto-ack flag",
@@ -645,8 +716,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(ieee802154_commands,
 	SHELL_CMD(get_tx_power,	NULL,
 		  "Get currently used TX power",
 		  cmd_ieee802154_get_tx_power),
+	SHELL_COND_CMD(CONFIG_NET_L2_IEEE802154_LINK_QUALITY, link_quality, NULL,
+		       "Show channel and neighbor link quality estimates",
+		       cmd_ieee802154_link_quality),
 	SHELL_CMD(scan,	NULL,
-		  "<passive|active> <channels set n[:m:...]:x|all>"
+		  "<passive|active|energy> <channels set n[:m:...]:x|all>"
 		  " <per-channel duration in ms>",
 		  cmd_ieee802154_scan),
 	SHELL_CMD(set_chan, NULL,
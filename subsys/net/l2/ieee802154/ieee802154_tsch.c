@@ -0,0 +1,1287 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * All references to the spec refer to IEEE 802.15.4-2020.
+ */
+
+/**
+ * @file
+ * @brief IEEE 802.15.4 TSCH MAC engine, see section 6.2.6.
+ *
+ * A dedicated thread walks the schedule timeslot by timeslot. It wakes
+ * up shortly before each active timeslot and hands the frame to the
+ * driver with @ref IEEE802154_TX_MODE_TXTIME (or its CCA variant on
+ * shared links), or opens an RX window with @ref
+ * IEEE802154_CONFIG_RX_SLOT. Precise timing is therefore left to the
+ * driver, the thread only has to be on time to within its wake-up lead.
+ *
+ * Timeslot boundaries are derived from a reference timeslot (ref_asn) and
+ * its start time (ref_time) in the network subsystem's local clock. Both
+ * are reset whenever a frame from the time source is received, which
+ * compensates for the clock drift between both devices.
+ *
+ * Only one interface can operate in TSCH mode at a time.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_tsch, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_ie.h>
+#include <zephyr/net/ieee802154_radio.h>
+#include <zephyr/net/ieee802154_tsch.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/slist.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "ieee802154_frame.h"
+#include "ieee802154_priv.h"
+#include "ieee802154_tsch.h"
+#include "ieee802154_utils.h"
+
+/* Default timeslot template (macTimeslotTemplateId 0), see section
+ * 8.4.3.3.4, table 8-99.
+ */
+#define TSCH_TS_TX_OFFSET_NS (2120 * NSEC_PER_USEC)
+#define TSCH_TS_RX_OFFSET_NS (1020 * NSEC_PER_USEC)
+#define TSCH_TS_RX_WAIT_NS   (2200 * NSEC_PER_USEC)
+#define TSCH_TS_LENGTH_NS    (10000 * NSEC_PER_USEC)
+
+/* How long before the start of a timeslot the engine has to be awake */
+#define TSCH_WAKEUP_LEAD_NS (1000 * NSEC_PER_USEC)
+
+/* Clock errors beyond half the RX window cannot be corrected. */
+#define TSCH_MAX_SYNC_ERROR_NS (TSCH_TS_RX_WAIT_NS / 2)
+
+/* TSCH CSMA-CA backoff exponents, see section 8.4.3.1, table 8-94. */
+#define TSCH_MIN_BE 1
+#define TSCH_MAX_BE 7
+
+/* IE descriptors, see sections 7.4.2.1, 7.4.3.1 and 7.4.4.1. */
+#define TSCH_HEADER_IE(_id, _len)     (((_id) << 7) | (_len))
+#define TSCH_PAYLOAD_IE(_group, _len) (BIT(15) | ((_group) << 11) | (_len))
+#define TSCH_SHORT_SUB_IE(_id, _len)  (((_id) << 8) | (_len))
+#define TSCH_LONG_SUB_IE(_id, _len)   (BIT(15) | ((_id) << 11) | (_len))
+
+#define TSCH_PAYLOAD_IE_GROUP_ID_MLME 0x1
+
+/* MLME sub-IE IDs, see section 7.4.4.1, tables 7-19 and 7-20. */
+#define TSCH_SUB_IE_CHANNEL_HOPPING 0x09
+#define TSCH_SUB_IE_SYNC	    0x1a
+#define TSCH_SUB_IE_SLOTFRAME_LINK  0x1b
+#define TSCH_SUB_IE_TIMESLOT	    0x1c
+
+#define TSCH_SYNC_IE_LEN   6
+#define TSCH_SF_DESCR_LEN  4
+#define TSCH_LINK_INFO_LEN 5
+
+/* Fixed EB header: FCF, sequence number, destination PAN ID, broadcast
+ * destination address and extended source address.
+ */
+#define TSCH_EB_MHR_LEN \
+	(sizeof(struct ieee802154_fcf_seq) + 2 * sizeof(uint16_t) + IEEE802154_EXT_ADDR_LENGTH)
+
+enum tsch_flags {
+	TSCH_RUNNING,
+	TSCH_SYNCED,
+	TSCH_COORDINATOR,
+};
+
+struct tsch_slotframe {
+	uint16_t size;
+	uint8_t handle;
+};
+
+struct tsch_tx_entry {
+	sys_snode_t node;
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	struct k_sem done;
+	int result;
+	uint8_t attempts;
+	uint8_t be;
+	uint8_t backoff;
+	bool busy;
+	uint8_t dst_len;
+	uint8_t dst[IEEE802154_MAX_ADDR_LENGTH];
+};
+
+static K_MUTEX_DEFINE(tsch_lock);
+static K_SEM_DEFINE(tsch_wakeup, 0, 1);
+
+static K_KERNEL_STACK_DEFINE(tsch_stack, CONFIG_NET_L2_IEEE802154_TSCH_STACK_SIZE);
+static struct k_thread tsch_thread_data;
+
+/* Everything but the flags is guarded by tsch_lock. */
+static struct {
+	struct net_if *iface;
+	atomic_t flags;
+
+	struct tsch_slotframe slotframes[CONFIG_NET_L2_IEEE802154_TSCH_MAX_SLOTFRAMES];
+	uint8_t num_slotframes;
+
+	struct ieee802154_tsch_link links[CONFIG_NET_L2_IEEE802154_TSCH_MAX_LINKS];
+	uint8_t num_links;
+
+	uint16_t hopping_seq[CONFIG_NET_L2_IEEE802154_TSCH_MAX_HOPPING_SEQUENCE_LEN];
+	uint8_t hopping_len;
+	uint8_t scan_idx;
+
+	/* ASN of the last timeslot handled by the engine */
+	uint64_t asn;
+	/* Start of timeslot ref_asn in the local clock */
+	uint64_t ref_asn;
+	net_time_t ref_time;
+	net_time_t last_sync;
+	net_time_t next_eb;
+
+	/* Extended address of the time source, in little endian */
+	uint8_t time_source[IEEE802154_EXT_ADDR_LENGTH];
+	uint8_t join_metric;
+
+	sys_slist_t tx_queue;
+	bool thread_started;
+} tsch = {
+	/* The 16 channel sequence commonly used by 6TiSCH implementations */
+	.hopping_seq = {16, 17, 23, 18, 26, 15, 25, 22, 19, 11, 12, 13, 24, 14, 20, 21},
+	.hopping_len = 16,
+};
+
+BUILD_ASSERT(CONFIG_NET_L2_IEEE802154_TSCH_MAX_HOPPING_SEQUENCE_LEN >= 16,
+	     "The default hopping sequence needs 16 entries");
+
+static inline bool tsch_check_iface(struct net_if *iface)
+{
+	return tsch.iface == NULL || tsch.iface == iface;
+}
+
+static struct tsch_slotframe *tsch_find_slotframe(uint8_t handle)
+{
+	for (uint8_t i = 0; i < tsch.num_slotframes; i++) {
+		if (tsch.slotframes[i].handle == handle) {
+			return &tsch.slotframes[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int tsch_find_link(uint16_t handle)
+{
+	for (uint8_t i = 0; i < tsch.num_links; i++) {
+		if (tsch.links[i].handle == handle) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void tsch_remove_link_at(uint8_t i)
+{
+	tsch.links[i] = tsch.links[--tsch.num_links];
+}
+
+/* Must be called with tsch_lock held. */
+static net_time_t tsch_slot_start(uint64_t asn)
+{
+	return tsch.ref_time + (net_time_t)(asn - tsch.ref_asn) * TSCH_TS_LENGTH_NS;
+}
+
+/* ASN of the timeslot containing the given time. Must be called with
+ * tsch_lock held.
+ */
+static uint64_t tsch_asn_at(net_time_t time)
+{
+	if (time <= tsch.ref_time) {
+		return tsch.ref_asn;
+	}
+
+	return tsch.ref_asn + (time - tsch.ref_time) / TSCH_TS_LENGTH_NS;
+}
+
+/* Resynchronizes the timeslot boundaries to a frame sent by the time
+ * source at the TX offset of its timeslot. Must be called with
+ * tsch_lock held.
+ */
+static void tsch_sync(net_time_t rx_time)
+{
+	net_time_t slot_start = rx_time - TSCH_TS_TX_OFFSET_NS;
+	uint64_t asn = tsch_asn_at(slot_start + TSCH_TS_LENGTH_NS / 2);
+	net_time_t error = slot_start - tsch_slot_start(asn);
+
+	if (error > TSCH_MAX_SYNC_ERROR_NS || error < -TSCH_MAX_SYNC_ERROR_NS) {
+		NET_DBG("Ignoring sync error of %lld ns", error);
+		return;
+	}
+
+	tsch.ref_asn = asn;
+	tsch.ref_time = slot_start;
+	tsch.last_sync = rx_time;
+}
+
+bool ieee802154_tsch_next_link(uint64_t asn, uint64_t *link_asn,
+			       struct ieee802154_tsch_link *link)
+{
+	struct ieee802154_tsch_link *best = NULL;
+	uint8_t best_handle = 0;
+	uint64_t best_asn = 0;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	for (uint8_t i = 0; i < tsch.num_links; i++) {
+		struct ieee802154_tsch_link *candidate = &tsch.links[i];
+		struct tsch_slotframe *sf = tsch_find_slotframe(candidate->slotframe_handle);
+		uint16_t offset;
+		uint64_t candidate_asn;
+
+		if (sf == NULL) {
+			continue;
+		}
+
+		offset = asn % sf->size;
+		candidate_asn = asn + (candidate->timeslot + sf->size - offset) % sf->size;
+
+		if (best == NULL || candidate_asn < best_asn ||
+		    (candidate_asn == best_asn && sf->handle < best_handle)) {
+			best = candidate;
+			best_asn = candidate_asn;
+			best_handle = sf->handle;
+		}
+	}
+
+	if (best != NULL) {
+		*link_asn = best_asn;
+		*link = *best;
+	}
+
+	k_mutex_unlock(&tsch_lock);
+
+	return best != NULL;
+}
+
+uint16_t ieee802154_tsch_channel(uint64_t asn, uint16_t channel_offset)
+{
+	uint16_t channel;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+	channel = tsch.hopping_seq[(asn + channel_offset) % tsch.hopping_len];
+	k_mutex_unlock(&tsch_lock);
+
+	return channel;
+}
+
+static inline bool tsch_link_is_advertised(const struct ieee802154_tsch_link *link)
+{
+	return link->node_addr_len == 0U;
+}
+
+int ieee802154_tsch_write_eb(struct net_if *iface, struct net_buf *buf, uint64_t asn)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	uint16_t sf_link_len = 1U, mlme_len;
+	struct ieee802154_fcf_seq *fs;
+	uint8_t num_slotframes = 0U;
+	int ret = 0;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	for (uint8_t i = 0; i < tsch.num_slotframes; i++) {
+		uint8_t num_links = 0U;
+
+		for (uint8_t j = 0; j < tsch.num_links; j++) {
+			if (tsch.links[j].slotframe_handle == tsch.slotframes[i].handle &&
+			    tsch_link_is_advertised(&tsch.links[j])) {
+				num_links++;
+			}
+		}
+
+		if (num_links) {
+			sf_link_len += TSCH_SF_DESCR_LEN + num_links * TSCH_LINK_INFO_LEN;
+			num_slotframes++;
+		}
+	}
+
+	mlme_len = IEEE802154_HEADER_IE_HEADER_LENGTH * 4U + TSCH_SYNC_IE_LEN + 1U + 1U +
+		   sf_link_len;
+
+	if (sf_link_len > UINT8_MAX ||
+	    net_buf_tailroom(buf) < TSCH_EB_MHR_LEN + IEEE802154_HEADER_IE_HEADER_LENGTH * 2U +
+					    mlme_len + IEEE802154_FCS_LENGTH) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	/* Enhanced Beacon frame header, see section 7.3.1. */
+	fs = net_buf_add(buf, sizeof(struct ieee802154_fcf_seq));
+	memset(fs, 0, sizeof(*fs));
+	fs->fc.frame_type = IEEE802154_FRAME_TYPE_BEACON;
+	fs->fc.ie_list = 1U;
+	fs->fc.dst_addr_mode = IEEE802154_ADDR_MODE_SHORT;
+	fs->fc.frame_version = IEEE802154_VERSION_802154;
+	fs->fc.src_addr_mode = IEEE802154_ADDR_MODE_EXTENDED;
+
+	k_sem_take(&ctx->ctx_lock, K_FOREVER);
+	fs->sequence = ctx->sequence++;
+	net_buf_add_le16(buf, ctx->pan_id);
+	net_buf_add_le16(buf, IEEE802154_BROADCAST_ADDRESS);
+	net_buf_add_mem(buf, ctx->ext_addr, IEEE802154_EXT_ADDR_LENGTH);
+	k_sem_give(&ctx->ctx_lock);
+
+	net_buf_add_le16(buf,
+			 TSCH_HEADER_IE(IEEE802154_HEADER_IE_ELEMENT_ID_HEADER_TERMINATION_1, 0));
+	net_buf_add_le16(buf, TSCH_PAYLOAD_IE(TSCH_PAYLOAD_IE_GROUP_ID_MLME, mlme_len));
+
+	/* TSCH Synchronization IE, see section 7.4.4.2. */
+	net_buf_add_le16(buf, TSCH_SHORT_SUB_IE(TSCH_SUB_IE_SYNC, TSCH_SYNC_IE_LEN));
+	net_buf_add_le40(buf, asn);
+	net_buf_add_u8(buf, tsch.join_metric);
+
+	/* TSCH Timeslot IE with the default template, see section 7.4.4.4. */
+	net_buf_add_le16(buf, TSCH_SHORT_SUB_IE(TSCH_SUB_IE_TIMESLOT, 1));
+	net_buf_add_u8(buf, 0U);
+
+	/* Channel Hopping IE with the configured sequence, see section 7.4.4.31. */
+	net_buf_add_le16(buf, TSCH_LONG_SUB_IE(TSCH_SUB_IE_CHANNEL_HOPPING, 1));
+	net_buf_add_u8(buf, 0U);
+
+	/* TSCH Slotframe and Link IE, see section 7.4.4.3. */
+	net_buf_add_le16(buf, TSCH_SHORT_SUB_IE(TSCH_SUB_IE_SLOTFRAME_LINK, sf_link_len));
+	net_buf_add_u8(buf, num_slotframes);
+
+	for (uint8_t i = 0; i < tsch.num_slotframes; i++) {
+		struct tsch_slotframe *sf = &tsch.slotframes[i];
+		uint8_t num_links = 0U;
+		uint8_t *num_links_field;
+
+		for (uint8_t j = 0; j < tsch.num_links; j++) {
+			if (tsch.links[j].slotframe_handle == sf->handle &&
+			    tsch_link_is_advertised(&tsch.links[j])) {
+				num_links++;
+			}
+		}
+
+		if (!num_links) {
+			continue;
+		}
+
+		net_buf_add_u8(buf, sf->handle);
+		net_buf_add_le16(buf, sf->size);
+		num_links_field = net_buf_add(buf, 1);
+		*num_links_field = num_links;
+
+		for (uint8_t j = 0; j < tsch.num_links; j++) {
+			struct ieee802154_tsch_link *link = &tsch.links[j];
+
+			if (link->slotframe_handle != sf->handle ||
+			    !tsch_link_is_advertised(link)) {
+				continue;
+			}
+
+			net_buf_add_le16(buf, link->timeslot);
+			net_buf_add_le16(buf, link->channel_offset);
+			net_buf_add_u8(buf, link->options);
+		}
+	}
+
+out:
+	k_mutex_unlock(&tsch_lock);
+
+	return ret;
+}
+
+static int tsch_parse_sf_link_ie(const uint8_t *p, uint16_t len, struct ieee802154_tsch_eb *eb)
+{
+	uint8_t num_slotframes;
+
+	if (len < 1U) {
+		return -EINVAL;
+	}
+
+	num_slotframes = *p++;
+	len--;
+
+	while (num_slotframes--) {
+		uint16_t sf_size;
+		uint8_t sf_handle, num_links;
+
+		if (len < TSCH_SF_DESCR_LEN) {
+			return -EINVAL;
+		}
+
+		sf_handle = p[0];
+		sf_size = sys_get_le16(&p[1]);
+		num_links = p[3];
+		p += TSCH_SF_DESCR_LEN;
+		len -= TSCH_SF_DESCR_LEN;
+
+		if (sf_size == 0U || len < num_links * TSCH_LINK_INFO_LEN) {
+			return -EINVAL;
+		}
+
+		for (uint8_t i = 0; i < num_links; i++, p += TSCH_LINK_INFO_LEN) {
+			struct ieee802154_tsch_link *link;
+
+			if (eb->num_links == ARRAY_SIZE(eb->links)) {
+				NET_DBG("Ignoring advertised link beyond link table size");
+				continue;
+			}
+
+			link = &eb->links[eb->num_links];
+			memset(link, 0, sizeof(*link));
+			link->slotframe_handle = sf_handle;
+			link->timeslot = sys_get_le16(&p[0]);
+			link->channel_offset = sys_get_le16(&p[2]);
+			link->options = p[4];
+
+			if (link->timeslot >= sf_size) {
+				return -EINVAL;
+			}
+
+			eb->slotframe_size[eb->num_links++] = sf_size;
+		}
+
+		len -= num_links * TSCH_LINK_INFO_LEN;
+	}
+
+	return 0;
+}
+
+static int tsch_parse_mlme_ie(const uint8_t *p, uint16_t len, struct ieee802154_tsch_eb *eb)
+{
+	bool has_sync = false;
+
+	while (len >= IEEE802154_HEADER_IE_HEADER_LENGTH) {
+		uint16_t descr = sys_get_le16(p);
+		uint16_t sub_len, sub_id;
+
+		if (descr & BIT(15)) {
+			sub_len = descr & 0x7ff;
+			sub_id = (descr >> 11) & 0xf;
+		} else {
+			sub_len = descr & 0xff;
+			sub_id = (descr >> 8) & 0x7f;
+		}
+
+		p += IEEE802154_HEADER_IE_HEADER_LENGTH;
+		len -= IEEE802154_HEADER_IE_HEADER_LENGTH;
+
+		if (sub_len > len) {
+			return -EINVAL;
+		}
+
+		if (!(descr & BIT(15)) && sub_id == TSCH_SUB_IE_SYNC) {
+			if (sub_len != TSCH_SYNC_IE_LEN) {
+				return -EINVAL;
+			}
+
+			eb->asn = sys_get_le40(p);
+			eb->join_metric = p[5];
+			has_sync = true;
+		} else if (!(descr & BIT(15)) && sub_id == TSCH_SUB_IE_TIMESLOT) {
+			/* Only the default timeslot template is supported. */
+			if (sub_len < 1U || p[0] != 0U) {
+				return -EINVAL;
+			}
+		} else if (!(descr & BIT(15)) && sub_id == TSCH_SUB_IE_SLOTFRAME_LINK) {
+			if (tsch_parse_sf_link_ie(p, sub_len, eb)) {
+				return -EINVAL;
+			}
+		}
+
+		p += sub_len;
+		len -= sub_len;
+	}
+
+	return has_sync ? 0 : -EINVAL;
+}
+
+int ieee802154_tsch_parse_eb(const uint8_t *buf, size_t len, struct ieee802154_tsch_eb *eb)
+{
+	const struct ieee802154_fcf_seq *fs = (const struct ieee802154_fcf_seq *)buf;
+	const uint8_t *p = buf + TSCH_EB_MHR_LEN;
+	const uint8_t *end = buf + len;
+
+	memset(eb, 0, sizeof(*eb));
+
+	if (len < TSCH_EB_MHR_LEN || fs->fc.frame_type != IEEE802154_FRAME_TYPE_BEACON ||
+	    fs->fc.frame_version != IEEE802154_VERSION_802154 || !fs->fc.ie_list ||
+	    fs->fc.seq_num_suppr || fs->fc.security_enabled || fs->fc.pan_id_comp ||
+	    fs->fc.dst_addr_mode != IEEE802154_ADDR_MODE_SHORT ||
+	    fs->fc.src_addr_mode != IEEE802154_ADDR_MODE_EXTENDED) {
+		return -EINVAL;
+	}
+
+	eb->pan_id = sys_get_le16(buf + sizeof(*fs));
+	memcpy(eb->src_addr, buf + sizeof(*fs) + 2 * sizeof(uint16_t),
+	       IEEE802154_EXT_ADDR_LENGTH);
+
+	/* Skip header IEs up to the header termination IE. */
+	while (true) {
+		uint16_t descr;
+
+		if (end - p < IEEE802154_HEADER_IE_HEADER_LENGTH) {
+			return -EINVAL;
+		}
+
+		descr = sys_get_le16(p);
+		p += IEEE802154_HEADER_IE_HEADER_LENGTH;
+
+		if (((descr >> 7) & 0xff) ==
+		    IEEE802154_HEADER_IE_ELEMENT_ID_HEADER_TERMINATION_1) {
+			break;
+		}
+
+		if ((descr & 0x7f) > end - p) {
+			return -EINVAL;
+		}
+
+		p += descr & 0x7f;
+	}
+
+	/* Payload IEs, look for the MLME IE. */
+	while (end - p >= IEEE802154_HEADER_IE_HEADER_LENGTH) {
+		uint16_t descr = sys_get_le16(p);
+		uint16_t ie_len = descr & 0x7ff;
+
+		p += IEEE802154_HEADER_IE_HEADER_LENGTH;
+
+		if (!(descr & BIT(15)) || ie_len > end - p) {
+			return -EINVAL;
+		}
+
+		if (((descr >> 11) & 0xf) == TSCH_PAYLOAD_IE_GROUP_ID_MLME) {
+			return tsch_parse_mlme_ie(p, ie_len, eb);
+		}
+
+		p += ie_len;
+	}
+
+	return -EINVAL;
+}
+
+/* Must be called with tsch_lock held. */
+static int tsch_slotframe_add(uint8_t handle, uint16_t size)
+{
+	if (size == 0U) {
+		return -EINVAL;
+	}
+
+	if (tsch_find_slotframe(handle)) {
+		return -EEXIST;
+	}
+
+	if (tsch.num_slotframes == ARRAY_SIZE(tsch.slotframes)) {
+		return -ENOMEM;
+	}
+
+	tsch.slotframes[tsch.num_slotframes++] = (struct tsch_slotframe){
+		.handle = handle,
+		.size = size,
+	};
+
+	return 0;
+}
+
+/* Must be called with tsch_lock held. */
+static int tsch_link_add(const struct ieee802154_tsch_link *link)
+{
+	struct tsch_slotframe *sf;
+
+	if (!(link->options & (IEEE802154_TSCH_LINK_OPTION_TX | IEEE802154_TSCH_LINK_OPTION_RX)) ||
+	    (link->node_addr_len != 0U && link->node_addr_len != IEEE802154_SHORT_ADDR_LENGTH &&
+	     link->node_addr_len != IEEE802154_EXT_ADDR_LENGTH) ||
+	    link->type > IEEE802154_TSCH_LINK_ADVERTISING) {
+		return -EINVAL;
+	}
+
+	sf = tsch_find_slotframe(link->slotframe_handle);
+	if (sf == NULL) {
+		return -ENOENT;
+	}
+
+	if (link->timeslot >= sf->size) {
+		return -EINVAL;
+	}
+
+	if (tsch_find_link(link->handle) >= 0) {
+		return -EEXIST;
+	}
+
+	if (tsch.num_links == ARRAY_SIZE(tsch.links)) {
+		return -ENOMEM;
+	}
+
+	tsch.links[tsch.num_links++] = *link;
+
+	return 0;
+}
+
+/* Installs the links advertised by the time source, see section
+ * 6.3.6. Must be called with tsch_lock held.
+ */
+static void tsch_install_eb_links(struct ieee802154_tsch_eb *eb)
+{
+	uint16_t handle = 0U;
+
+	for (uint8_t i = 0; i < eb->num_links; i++) {
+		struct ieee802154_tsch_link *link = &eb->links[i];
+		int ret;
+
+		ret = tsch_slotframe_add(link->slotframe_handle, eb->slotframe_size[i]);
+		if (ret && ret != -EEXIST) {
+			NET_WARN("Could not add advertised slotframe %u: %d",
+				 link->slotframe_handle, ret);
+			continue;
+		}
+
+		while (tsch_find_link(handle) >= 0) {
+			handle++;
+		}
+
+		link->handle = handle;
+		link->type = IEEE802154_TSCH_LINK_NORMAL;
+
+		ret = tsch_link_add(link);
+		if (ret) {
+			NET_WARN("Could not add advertised link: %d", ret);
+		}
+	}
+}
+
+static void tsch_join(struct net_if *iface, struct ieee802154_tsch_eb *eb,
+		      net_time_t rx_time)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+	tsch.ref_asn = eb->asn;
+	tsch.ref_time = rx_time - TSCH_TS_TX_OFFSET_NS;
+	tsch.asn = eb->asn;
+	tsch.last_sync = rx_time;
+	tsch.join_metric = eb->join_metric < UINT8_MAX ? eb->join_metric + 1U : UINT8_MAX;
+	memcpy(tsch.time_source, eb->src_addr, sizeof(tsch.time_source));
+
+	tsch_install_eb_links(eb);
+
+	k_sem_take(&ctx->ctx_lock, K_FOREVER);
+	ctx->pan_id = eb->pan_id;
+	ieee802154_hdr_templates_flush(ctx);
+	k_sem_give(&ctx->ctx_lock);
+
+	ieee802154_radio_filter_pan_id(iface, eb->pan_id);
+
+	atomic_set_bit(&tsch.flags, TSCH_SYNCED);
+
+	NET_INFO("Joined TSCH network %04x at ASN %llu", eb->pan_id, eb->asn);
+}
+
+enum net_verdict ieee802154_tsch_handle_eb(struct net_if *iface, struct net_pkt *pkt)
+{
+	static struct ieee802154_tsch_eb eb;
+	struct ieee802154_fcf_seq *fs = (struct ieee802154_fcf_seq *)net_pkt_data(pkt);
+
+	if (net_pkt_get_len(pkt) < sizeof(*fs) ||
+	    fs->fc.frame_type != IEEE802154_FRAME_TYPE_BEACON ||
+	    fs->fc.frame_version != IEEE802154_VERSION_802154) {
+		return NET_CONTINUE;
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (ieee802154_tsch_parse_eb(net_pkt_data(pkt), net_pkt_get_len(pkt), &eb)) {
+		k_mutex_unlock(&tsch_lock);
+		return NET_DROP;
+	}
+
+	if (iface != tsch.iface || !atomic_test_bit(&tsch.flags, TSCH_RUNNING) ||
+	    atomic_test_bit(&tsch.flags, TSCH_COORDINATOR)) {
+		goto out;
+	}
+
+	if (!atomic_test_bit(&tsch.flags, TSCH_SYNCED)) {
+		tsch_join(iface, &eb, net_pkt_timestamp_ns(pkt));
+		k_sem_give(&tsch_wakeup);
+	} else if (!memcmp(eb.src_addr, tsch.time_source, sizeof(tsch.time_source))) {
+		tsch_sync(net_pkt_timestamp_ns(pkt));
+	}
+
+out:
+	k_mutex_unlock(&tsch_lock);
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+void ieee802154_tsch_rx_sync(struct net_if *iface, struct net_pkt *pkt,
+			     struct ieee802154_mpdu *mpdu)
+{
+	struct ieee802154_fcf_seq *fs = mpdu->mhr.fs;
+	uint8_t *src;
+
+	if (fs->fc.src_addr_mode != IEEE802154_ADDR_MODE_EXTENDED ||
+	    atomic_test_bit(&tsch.flags, TSCH_COORDINATOR) ||
+	    !atomic_test_bit(&tsch.flags, TSCH_SYNCED)) {
+		return;
+	}
+
+	src = fs->fc.pan_id_comp ? mpdu->mhr.src_addr->comp.addr.ext_addr
+				 : mpdu->mhr.src_addr->plain.addr.ext_addr;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (iface == tsch.iface && !memcmp(src, tsch.time_source, sizeof(tsch.time_source))) {
+		tsch_sync(net_pkt_timestamp_ns(pkt));
+	}
+
+	k_mutex_unlock(&tsch_lock);
+}
+
+static bool tsch_link_matches(const struct ieee802154_tsch_link *link,
+			      const struct tsch_tx_entry *entry)
+{
+	if (!(link->options & IEEE802154_TSCH_LINK_OPTION_TX)) {
+		return false;
+	}
+
+	/* Links shared by all neighbors carry any frame, dedicated links only
+	 * unicast frames to their neighbor.
+	 */
+	if (link->node_addr_len == 0U) {
+		return true;
+	}
+
+	return link->node_addr_len == entry->dst_len &&
+	       !memcmp(link->node_addr, entry->dst, entry->dst_len);
+}
+
+/* Picks the first queued frame that may be sent on the given link, see
+ * section 6.2.5.3 for the backoff on shared links. Must be called with
+ * tsch_lock held.
+ */
+static struct tsch_tx_entry *tsch_dequeue(const struct ieee802154_tsch_link *link)
+{
+	bool shared = link->options & IEEE802154_TSCH_LINK_OPTION_SHARED;
+	struct tsch_tx_entry *entry, *found = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tsch.tx_queue, entry, node) {
+		if (entry->busy || !tsch_link_matches(link, entry)) {
+			continue;
+		}
+
+		if (shared && entry->backoff > 0U) {
+			entry->backoff--;
+			continue;
+		}
+
+		if (found == NULL) {
+			found = entry;
+		}
+	}
+
+	if (found != NULL) {
+		found->busy = true;
+	}
+
+	return found;
+}
+
+static void tsch_tx(struct tsch_tx_entry *entry, const struct ieee802154_tsch_link *link,
+		    uint16_t channel, net_time_t slot_start)
+{
+	bool shared = link->options & IEEE802154_TSCH_LINK_OPTION_SHARED;
+	int ret;
+
+	ret = ieee802154_radio_set_channel(tsch.iface, channel);
+	if (ret == 0) {
+		net_pkt_set_timestamp_ns(entry->pkt, slot_start + TSCH_TS_TX_OFFSET_NS);
+		ret = ieee802154_radio_tx(tsch.iface,
+					  shared ? IEEE802154_TX_MODE_TXTIME_CCA
+						 : IEEE802154_TX_MODE_TXTIME,
+					  entry->pkt, entry->frag);
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	entry->busy = false;
+
+	if ((ret == -ENOMSG || ret == -EBUSY) && --entry->attempts > 0U) {
+		if (shared) {
+			entry->be = MIN(entry->be + 1U, TSCH_MAX_BE);
+			entry->backoff = sys_rand32_get() & BIT_MASK(entry->be);
+		}
+	} else {
+		sys_slist_find_and_remove(&tsch.tx_queue, &entry->node);
+		entry->result = ret;
+		k_sem_give(&entry->done);
+	}
+
+	k_mutex_unlock(&tsch_lock);
+}
+
+static void tsch_tx_eb(const struct ieee802154_tsch_link *link, uint64_t asn,
+		       uint16_t channel, net_time_t slot_start)
+{
+	bool shared = link->options & IEEE802154_TSCH_LINK_OPTION_SHARED;
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(tsch.iface, IEEE802154_MTU, AF_UNSPEC, 0, K_NO_WAIT);
+	if (!pkt) {
+		return;
+	}
+
+	ret = ieee802154_tsch_write_eb(tsch.iface, pkt->buffer, asn);
+	if (ret == 0) {
+		ret = ieee802154_radio_set_channel(tsch.iface, channel);
+	}
+
+	if (ret == 0) {
+		net_pkt_set_timestamp_ns(pkt, slot_start + TSCH_TS_TX_OFFSET_NS);
+		ret = ieee802154_radio_tx(tsch.iface,
+					  shared ? IEEE802154_TX_MODE_TXTIME_CCA
+						 : IEEE802154_TX_MODE_TXTIME,
+					  pkt, pkt->buffer);
+	}
+
+	if (ret) {
+		NET_DBG("Could not send EB: %d", ret);
+	}
+
+	net_pkt_unref(pkt);
+}
+
+static void tsch_rx(uint16_t channel, net_time_t start, net_time_t duration)
+{
+	struct ieee802154_config config = {
+		.rx_slot = {
+			.start = start,
+			.duration = duration,
+			.channel = channel,
+		},
+	};
+	int ret;
+
+	ret = ieee802154_radio_configure(tsch.iface, IEEE802154_CONFIG_RX_SLOT, &config);
+	if (ret) {
+		NET_DBG("Could not schedule RX slot: %d", ret);
+	}
+}
+
+/* Waits until the given time, returns false if woken up earlier. */
+static bool tsch_wait_until(net_time_t time)
+{
+	net_time_t now = ieee802154_radio_get_time(tsch.iface);
+
+	if (time <= now) {
+		return true;
+	}
+
+	return k_sem_take(&tsch_wakeup, K_USEC((time - now) / NSEC_PER_USEC)) != 0;
+}
+
+/* A device may send Enhanced Beacons once it is part of the network,
+ * see section 6.3.6. Must be called with tsch_lock held.
+ */
+static bool tsch_eb_due(const struct ieee802154_tsch_link *link, net_time_t now)
+{
+	if (link->type != IEEE802154_TSCH_LINK_ADVERTISING ||
+	    !(link->options & IEEE802154_TSCH_LINK_OPTION_TX) || now < tsch.next_eb) {
+		return false;
+	}
+
+	if (!atomic_test_bit(&tsch.flags, TSCH_COORDINATOR) &&
+	    IS_ENABLED(CONFIG_NET_L2_IEEE802154_RFD)) {
+		return false;
+	}
+
+	tsch.next_eb = now + CONFIG_NET_L2_IEEE802154_TSCH_EB_PERIOD * NSEC_PER_MSEC;
+
+	return true;
+}
+
+static void tsch_run_slot(void)
+{
+	struct ieee802154_tsch_link link;
+	struct tsch_tx_entry *entry = NULL;
+	net_time_t now, slot_start;
+	uint64_t asn;
+	bool send_eb;
+
+	now = ieee802154_radio_get_time(tsch.iface);
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (!atomic_test_bit(&tsch.flags, TSCH_COORDINATOR) &&
+	    now - tsch.last_sync > CONFIG_NET_L2_IEEE802154_TSCH_DESYNC_TIMEOUT * NSEC_PER_MSEC) {
+		NET_WARN("Lost synchronization at ASN %llu", tsch.asn);
+		atomic_clear_bit(&tsch.flags, TSCH_SYNCED);
+		k_mutex_unlock(&tsch_lock);
+		return;
+	}
+
+	/* Skip timeslots that start too early to be served. */
+	asn = MAX(tsch.asn + 1U, tsch_asn_at(now + TSCH_WAKEUP_LEAD_NS) + 1U);
+
+	k_mutex_unlock(&tsch_lock);
+
+	if (!ieee802154_tsch_next_link(asn, &asn, &link)) {
+		/* Empty schedule, wait for links to be added. */
+		(void)k_sem_take(&tsch_wakeup, K_FOREVER);
+		return;
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+	slot_start = tsch_slot_start(asn);
+	k_mutex_unlock(&tsch_lock);
+
+	if (!tsch_wait_until(slot_start - TSCH_WAKEUP_LEAD_NS)) {
+		/* The state or the schedule changed, start over. */
+		return;
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (!atomic_test_bit(&tsch.flags, TSCH_SYNCED)) {
+		k_mutex_unlock(&tsch_lock);
+		return;
+	}
+
+	/* Pick up any time correction received in the meantime. */
+	slot_start = tsch_slot_start(asn);
+	tsch.asn = asn;
+
+	if (link.options & IEEE802154_TSCH_LINK_OPTION_TX) {
+		entry = tsch_dequeue(&link);
+	}
+
+	send_eb = entry == NULL && tsch_eb_due(&link, now);
+
+	k_mutex_unlock(&tsch_lock);
+
+	if (entry != NULL) {
+		tsch_tx(entry, &link, ieee802154_tsch_channel(asn, link.channel_offset),
+			slot_start);
+	} else if (send_eb) {
+		tsch_tx_eb(&link, asn, ieee802154_tsch_channel(asn, link.channel_offset),
+			   slot_start);
+	} else if (link.options & IEEE802154_TSCH_LINK_OPTION_RX) {
+		tsch_rx(ieee802154_tsch_channel(asn, link.channel_offset),
+			slot_start + TSCH_TS_RX_OFFSET_NS, TSCH_TS_RX_WAIT_NS);
+	}
+}
+
+/* Listens for Enhanced Beacons on one channel of the hopping sequence
+ * after the other, see section 6.3.6.
+ */
+static void tsch_scan(void)
+{
+	uint16_t channel;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+	channel = tsch.hopping_seq[tsch.scan_idx++ % tsch.hopping_len];
+	k_mutex_unlock(&tsch_lock);
+
+	tsch_rx(channel, ieee802154_radio_get_time(tsch.iface),
+		CONFIG_NET_L2_IEEE802154_TSCH_SCAN_DWELL * NSEC_PER_MSEC);
+
+	(void)k_sem_take(&tsch_wakeup, K_MSEC(CONFIG_NET_L2_IEEE802154_TSCH_SCAN_DWELL));
+}
+
+static void tsch_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (!atomic_test_bit(&tsch.flags, TSCH_RUNNING)) {
+			(void)k_sem_take(&tsch_wakeup, K_FOREVER);
+		} else if (!atomic_test_bit(&tsch.flags, TSCH_SYNCED)) {
+			tsch_scan();
+		} else {
+			tsch_run_slot();
+		}
+	}
+}
+
+int ieee802154_tsch_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag)
+{
+	struct net_linkaddr *dst = net_pkt_lladdr_dst(pkt);
+	struct tsch_tx_entry entry = {
+		.pkt = pkt,
+		.frag = frag,
+		.attempts = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES + 1,
+		.be = TSCH_MIN_BE,
+	};
+	bool routable = false;
+
+	if (dst->addr != NULL && dst->len <= sizeof(entry.dst) &&
+	    !(dst->len == IEEE802154_SHORT_ADDR_LENGTH &&
+	      sys_get_be16(dst->addr) == IEEE802154_BROADCAST_ADDRESS)) {
+		entry.dst_len = dst->len;
+		memcpy(entry.dst, dst->addr, dst->len);
+	}
+
+	k_sem_init(&entry.done, 0, 1);
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (iface != tsch.iface || !atomic_test_bit(&tsch.flags, TSCH_SYNCED)) {
+		k_mutex_unlock(&tsch_lock);
+		return -ENETDOWN;
+	}
+
+	for (uint8_t i = 0; i < tsch.num_links; i++) {
+		if (tsch_link_matches(&tsch.links[i], &entry)) {
+			routable = true;
+			break;
+		}
+	}
+
+	if (!routable) {
+		k_mutex_unlock(&tsch_lock);
+		NET_DBG("No TX link for frame %p", frag);
+		return -ENETUNREACH;
+	}
+
+	sys_slist_append(&tsch.tx_queue, &entry.node);
+
+	k_mutex_unlock(&tsch_lock);
+
+	(void)k_sem_take(&entry.done, K_FOREVER);
+
+	return entry.result;
+}
+
+int ieee802154_tsch_slotframe_add(struct net_if *iface, uint8_t handle, uint16_t size)
+{
+	int ret;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+	ret = tsch_check_iface(iface) ? tsch_slotframe_add(handle, size) : -EBUSY;
+	k_mutex_unlock(&tsch_lock);
+
+	k_sem_give(&tsch_wakeup);
+
+	return ret;
+}
+
+int ieee802154_tsch_slotframe_remove(struct net_if *iface, uint8_t handle)
+{
+	struct tsch_slotframe *sf;
+	int ret = 0;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	sf = tsch_find_slotframe(handle);
+	if (!tsch_check_iface(iface)) {
+		ret = -EBUSY;
+	} else if (sf == NULL) {
+		ret = -ENOENT;
+	} else {
+		for (uint8_t i = tsch.num_links; i > 0; i--) {
+			if (tsch.links[i - 1].slotframe_handle == handle) {
+				tsch_remove_link_at(i - 1);
+			}
+		}
+
+		*sf = tsch.slotframes[--tsch.num_slotframes];
+	}
+
+	k_mutex_unlock(&tsch_lock);
+
+	k_sem_give(&tsch_wakeup);
+
+	return ret;
+}
+
+int ieee802154_tsch_link_add(struct net_if *iface, const struct ieee802154_tsch_link *link)
+{
+	int ret;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+	ret = tsch_check_iface(iface) ? tsch_link_add(link) : -EBUSY;
+	k_mutex_unlock(&tsch_lock);
+
+	k_sem_give(&tsch_wakeup);
+
+	return ret;
+}
+
+int ieee802154_tsch_link_remove(struct net_if *iface, uint16_t handle)
+{
+	int ret;
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (!tsch_check_iface(iface)) {
+		ret = -EBUSY;
+	} else {
+		ret = tsch_find_link(handle);
+		if (ret >= 0) {
+			tsch_remove_link_at(ret);
+			ret = 0;
+		}
+	}
+
+	k_mutex_unlock(&tsch_lock);
+
+	k_sem_give(&tsch_wakeup);
+
+	return ret;
+}
+
+int ieee802154_tsch_set_hopping_sequence(struct net_if *iface, const uint16_t *channels,
+					 uint8_t len)
+{
+	int ret = 0;
+
+	if (len == 0U || len > ARRAY_SIZE(tsch.hopping_seq)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (!tsch_check_iface(iface) || atomic_test_bit(&tsch.flags, TSCH_RUNNING)) {
+		ret = -EBUSY;
+	} else {
+		memcpy(tsch.hopping_seq, channels, len * sizeof(channels[0]));
+		tsch.hopping_len = len;
+	}
+
+	k_mutex_unlock(&tsch_lock);
+
+	return ret;
+}
+
+int ieee802154_tsch_start(struct net_if *iface, bool coordinator)
+{
+	enum ieee802154_hw_caps required = IEEE802154_HW_TXTIME | IEEE802154_HW_RXTIME |
+					   IEEE802154_HW_TX_RX_ACK | IEEE802154_HW_RX_TX_ACK;
+
+	if ((ieee802154_radio_get_hw_capabilities(iface) & required) != required) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (!tsch_check_iface(iface)) {
+		k_mutex_unlock(&tsch_lock);
+		return -EBUSY;
+	}
+
+	if (atomic_test_and_set_bit(&tsch.flags, TSCH_RUNNING)) {
+		k_mutex_unlock(&tsch_lock);
+		return -EALREADY;
+	}
+
+	tsch.iface = iface;
+	tsch.scan_idx = 0U;
+
+	if (coordinator) {
+		net_time_t now = ieee802154_radio_get_time(iface);
+
+		tsch.ref_asn = 0U;
+		tsch.ref_time = now;
+		tsch.asn = 0U;
+		tsch.last_sync = now;
+		tsch.next_eb = now;
+		tsch.join_metric = 0U;
+		atomic_set_bit(&tsch.flags, TSCH_COORDINATOR);
+		atomic_set_bit(&tsch.flags, TSCH_SYNCED);
+	}
+
+	if (!tsch.thread_started) {
+		k_thread_create(&tsch_thread_data, tsch_stack, K_KERNEL_STACK_SIZEOF(tsch_stack),
+				tsch_thread, NULL, NULL, NULL,
+				K_PRIO_COOP(CONFIG_NET_L2_IEEE802154_TSCH_THREAD_PRIO), 0, K_NO_WAIT);
+		k_thread_name_set(&tsch_thread_data, "ieee802154_tsch");
+		tsch.thread_started = true;
+	}
+
+	k_mutex_unlock(&tsch_lock);
+
+	k_sem_give(&tsch_wakeup);
+
+	return 0;
+}
+
+int ieee802154_tsch_stop(struct net_if *iface)
+{
+	struct tsch_tx_entry *entry, *next;
+	struct ieee802154_config config = {
+		.rx_slot = {
+			.start = -1,
+		},
+	};
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+
+	if (iface != tsch.iface || !atomic_test_and_clear_bit(&tsch.flags, TSCH_RUNNING)) {
+		k_mutex_unlock(&tsch_lock);
+		return -EALREADY;
+	}
+
+	atomic_clear_bit(&tsch.flags, TSCH_SYNCED);
+	atomic_clear_bit(&tsch.flags, TSCH_COORDINATOR);
+
+	/* Frames being transmitted right now are completed by the engine. */
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tsch.tx_queue, entry, next, node) {
+		if (!entry->busy) {
+			sys_slist_find_and_remove(&tsch.tx_queue, &entry->node);
+			entry->result = -ENETDOWN;
+			k_sem_give(&entry->done);
+		}
+	}
+
+	k_mutex_unlock(&tsch_lock);
+
+	k_sem_give(&tsch_wakeup);
+
+	/* Return to continuous reception. */
+	(void)ieee802154_radio_configure(iface, IEEE802154_CONFIG_RX_SLOT, &config);
+
+	return 0;
+}
+
+bool ieee802154_tsch_is_synchronized(struct net_if *iface)
+{
+	return iface == tsch.iface && atomic_test_bit(&tsch.flags, TSCH_SYNCED);
+}
+
+uint64_t ieee802154_tsch_get_asn(struct net_if *iface)
+{
+	uint64_t asn;
+
+	if (!ieee802154_tsch_is_synchronized(iface)) {
+		return 0U;
+	}
+
+	k_mutex_lock(&tsch_lock, K_FOREVER);
+	asn = tsch.asn;
+	k_mutex_unlock(&tsch_lock);
+
+	return asn;
+}
+
+/* Channel access happens inside the timeslots, the L2 hands all frames
+ * over to ieee802154_tsch_send() instead.
+ */
+static inline int tsch_channel_access(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return 0;
+}
+
+/* Declare the public channel access algorithm function used by L2. */
+FUNC_ALIAS(tsch_channel_access, ieee802154_wait_for_clear_channel, int);
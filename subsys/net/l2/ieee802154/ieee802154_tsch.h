@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Private IEEE 802.15.4 TSCH MAC helpers
+ *
+ * These utilities are internal to the native IEEE 802.15.4 L2
+ * stack and must not be included and used elsewhere.
+ *
+ * All references to the spec refer to IEEE 802.15.4-2020.
+ */
+
+#ifndef __IEEE802154_TSCH_H__
+#define __IEEE802154_TSCH_H__
+
+#include <zephyr/net/buf.h>
+#include <zephyr/net/ieee802154_tsch.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ieee802154_frame.h"
+
+#ifdef CONFIG_NET_L2_IEEE802154_RADIO_TSCH
+
+/** Content of a parsed Enhanced Beacon */
+struct ieee802154_tsch_eb {
+	/** ASN of the timeslot the beacon was sent in */
+	uint64_t asn;
+	/** Join metric of the sender */
+	uint8_t join_metric;
+	/** PAN ID of the network */
+	uint16_t pan_id;
+	/** Extended address of the sender, in little endian */
+	uint8_t src_addr[IEEE802154_EXT_ADDR_LENGTH];
+	/** Number of advertised links */
+	uint8_t num_links;
+	/** Slotframe sizes, indexed like the links */
+	uint16_t slotframe_size[CONFIG_NET_L2_IEEE802154_TSCH_MAX_LINKS];
+	/** Advertised links */
+	struct ieee802154_tsch_link links[CONFIG_NET_L2_IEEE802154_TSCH_MAX_LINKS];
+};
+
+/**
+ * @brief Queues the given fragment for transmission on the next matching
+ *        TSCH link and waits for the result. Replaces the contention
+ *        based access methods in TSCH mode.
+ *
+ * @param iface A valid pointer on a network interface to send from
+ * @param pkt A valid pointer on a packet to send
+ * @param frag The fragment to be sent
+ *
+ * @return 0 on success, negative value otherwise
+ */
+int ieee802154_tsch_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag);
+
+/**
+ * @brief Consumes Enhanced Beacons before regular frame validation.
+ *
+ * @param iface A valid pointer on the receiving network interface
+ * @param pkt A valid pointer on the received packet
+ *
+ * @return NET_OK if the packet was an Enhanced Beacon and has been consumed,
+ *         NET_CONTINUE otherwise.
+ */
+enum net_verdict ieee802154_tsch_handle_eb(struct net_if *iface, struct net_pkt *pkt);
+
+/**
+ * @brief Synchronizes to the time source if the given validated frame
+ *        has been sent by it.
+ *
+ * @param iface A valid pointer on the receiving network interface
+ * @param pkt A valid pointer on the received packet
+ * @param mpdu The validated MPDU of the packet
+ */
+void ieee802154_tsch_rx_sync(struct net_if *iface, struct net_pkt *pkt,
+			     struct ieee802154_mpdu *mpdu);
+
+/**
+ * @brief Finds the first active link at or after the given ASN.
+ *
+ * Links of slotframes with a lower handle take precedence over links in
+ * the same timeslot of slotframes with a higher handle, see section
+ * 6.2.6.4.
+ *
+ * @param asn ASN to start the search at
+ * @param link_asn Set to the ASN of the timeslot of the link found
+ * @param link Set to a copy of the link found
+ *
+ * @return true if a link was found, false if the schedule is empty
+ */
+bool ieee802154_tsch_next_link(uint64_t asn, uint64_t *link_asn,
+			       struct ieee802154_tsch_link *link);
+
+/**
+ * @brief Computes the channel of a timeslot, see section 6.2.6.3.
+ *
+ * @param asn ASN of the timeslot
+ * @param channel_offset Channel offset of the link
+ *
+ * @return the channel to be used
+ */
+uint16_t ieee802154_tsch_channel(uint64_t asn, uint16_t channel_offset);
+
+/**
+ * @brief Writes an Enhanced Beacon with TSCH Synchronization, TSCH
+ *        Timeslot, Channel Hopping and TSCH Slotframe and Link IEs.
+ *        Only links shared by all neighbors are advertised.
+ *
+ * @param iface A valid pointer on a network interface
+ * @param buf Buffer to write the frame to
+ * @param asn ASN of the timeslot the beacon will be sent in
+ *
+ * @return 0 on success, -ENOBUFS if the beacon does not fit into the buffer
+ */
+int ieee802154_tsch_write_eb(struct net_if *iface, struct net_buf *buf, uint64_t asn);
+
+/**
+ * @brief Parses an Enhanced Beacon written by @ref ieee802154_tsch_write_eb.
+ *
+ * @param buf Frame data
+ * @param len Frame length, excluding the FCS
+ * @param eb Parsed content
+ *
+ * @return 0 on success, -EINVAL if this is no valid TSCH Enhanced Beacon
+ */
+int ieee802154_tsch_parse_eb(const uint8_t *buf, size_t len, struct ieee802154_tsch_eb *eb);
+
+#else
+
+static inline enum net_verdict ieee802154_tsch_handle_eb(struct net_if *iface,
+							 struct net_pkt *pkt)
+{
+	return NET_CONTINUE;
+}
+
+static inline void ieee802154_tsch_rx_sync(struct net_if *iface, struct net_pkt *pkt,
+					   struct ieee802154_mpdu *mpdu)
+{
+}
+
+#endif /* CONFIG_NET_L2_IEEE802154_RADIO_TSCH */
+
+#endif /* __IEEE802154_TSCH_H__ */
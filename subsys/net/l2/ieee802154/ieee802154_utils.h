@@ -82,6 +82,23 @@ static inline int ieee802154_radio_tx(struct net_if *iface, enum ieee802154_tx_m
 	return radio->tx(net_if_get_device(iface), mode, pkt, buf);
 }
 
+static inline int ieee802154_radio_tx_batch(struct net_if *iface,
+					    struct ieee802154_tx_frame *frames, size_t count)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->api;
+
+	if (!radio) {
+		return -ENOENT;
+	}
+
+	if (!radio->tx_batch) {
+		return -ENOTSUP;
+	}
+
+	return radio->tx_batch(net_if_get_device(iface), frames, count);
+}
+
 static inline int ieee802154_radio_start(struct net_if *iface)
 {
 	const struct ieee802154_radio_api *radio =
@@ -106,6 +123,45 @@ static inline int ieee802154_radio_stop(struct net_if *iface)
 	return radio->stop(net_if_get_device(iface));
 }
 
+static inline int ieee802154_radio_configure(struct net_if *iface,
+					     enum ieee802154_config_type type,
+					     const struct ieee802154_config *config)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->api;
+
+	if (!radio || !radio->configure) {
+		return -ENOTSUP;
+	}
+
+	return radio->configure(net_if_get_device(iface), type, config);
+}
+
+static inline int ieee802154_radio_ed_scan(struct net_if *iface, uint16_t duration,
+					   energy_scan_done_cb_t done_cb)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->api;
+
+	if (!radio || !radio->ed_scan) {
+		return -ENOTSUP;
+	}
+
+	return radio->ed_scan(net_if_get_device(iface), duration, done_cb);
+}
+
+static inline net_time_t ieee802154_radio_get_time(struct net_if *iface)
+{
+	const struct ieee802154_radio_api *radio =
+		net_if_get_device(iface)->api;
+
+	if (!radio || !radio->get_time) {
+		return 0;
+	}
+
+	return radio->get_time(net_if_get_device(iface));
+}
+
 static inline int ieee802154_radio_attr_get(struct net_if *iface,
 					    enum ieee802154_attr attr,
 					    struct ieee802154_attr_value *value)
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_wifi_mgmt, CONFIG_NET_L2_WIFI_MGMT_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <zephyr/settings/settings.h>
+
+#include "wifi_bss_cache.h"
+
+#define BSS_CACHE_SIZE CONFIG_WIFI_MGMT_BSS_CACHE_SIZE
+#define BSS_CACHE_SETTINGS_SUBTREE "wifi_bss"
+#define BSS_CACHE_SETTINGS_KEY BSS_CACHE_SETTINGS_SUBTREE "/cache"
+/* Not to write the settings for every scan result */
+#define BSS_CACHE_SAVE_DELAY K_SECONDS(10)
+
+struct wifi_bss_cache_entry {
+	uint8_t ssid[WIFI_SSID_MAX_LEN];
+	/* 0 if the entry is not used */
+	uint8_t ssid_length;
+	uint8_t bssid[WIFI_MAC_ADDR_LEN];
+	uint8_t band;
+	uint8_t channel;
+	int8_t rssi;
+	uint8_t security;
+	/* Uptime in seconds when last seen, 0 if only known from the settings */
+	uint32_t last_seen;
+};
+
+static struct wifi_bss_cache_entry bss_cache[BSS_CACHE_SIZE];
+static struct k_spinlock bss_cache_lock;
+/* BSS last given to a connect request, dropped if the connect fails */
+static uint8_t bss_cache_tried[WIFI_MAC_ADDR_LEN];
+static bool bss_cache_tried_valid;
+static bool bg_scan_active;
+
+static struct wifi_bss_cache_entry *bss_cache_find(const uint8_t *bssid)
+{
+	for (int i = 0; i < ARRAY_SIZE(bss_cache); i++) {
+		if (bss_cache[i].ssid_length != 0U &&
+		    memcmp(bss_cache[i].bssid, bssid, WIFI_MAC_ADDR_LEN) == 0) {
+			return &bss_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Unused entry, or else the one not seen for the longest time */
+static struct wifi_bss_cache_entry *bss_cache_alloc(void)
+{
+	struct wifi_bss_cache_entry *oldest = &bss_cache[0];
+
+	for (int i = 0; i < ARRAY_SIZE(bss_cache); i++) {
+		if (bss_cache[i].ssid_length == 0U) {
+			return &bss_cache[i];
+		}
+
+		if (bss_cache[i].last_seen < oldest->last_seen) {
+			oldest = &bss_cache[i];
+		}
+	}
+
+	return oldest;
+}
+
+#if defined(CONFIG_WIFI_MGMT_BSS_CACHE_PERSIST)
+static struct wifi_bss_cache_entry bss_cache_save_buf[BSS_CACHE_SIZE];
+
+static void bss_cache_save_handler(struct k_work *work)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&bss_cache_lock);
+	memcpy(bss_cache_save_buf, bss_cache, sizeof(bss_cache_save_buf));
+	k_spin_unlock(&bss_cache_lock, key);
+
+	ret = settings_save_one(BSS_CACHE_SETTINGS_KEY, bss_cache_save_buf,
+				sizeof(bss_cache_save_buf));
+	if (ret < 0) {
+		NET_DBG("Cannot store Wi-Fi BSS cache (%d)", ret);
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(bss_cache_save_work, bss_cache_save_handler);
+
+static void bss_cache_save(void)
+{
+	(void)k_work_schedule(&bss_cache_save_work, BSS_CACHE_SAVE_DELAY);
+}
+
+static int bss_cache_settings_set(const char *name, size_t len,
+				  settings_read_cb read_cb, void *cb_arg)
+{
+	k_spinlock_key_t key;
+	ssize_t ret;
+
+	if (!settings_name_steq(name, "cache", NULL)) {
+		return -ENOENT;
+	}
+
+	/* Dropped if the cache layout changed */
+	if (len != sizeof(bss_cache_save_buf)) {
+		return -EINVAL;
+	}
+
+	ret = read_cb(cb_arg, bss_cache_save_buf, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	key = k_spin_lock(&bss_cache_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(bss_cache); i++) {
+		if (bss_cache_save_buf[i].ssid_length > WIFI_SSID_MAX_LEN) {
+			continue;
+		}
+
+		/* Entries seen since boot are more recent */
+		if (bss_cache[i].ssid_length == 0U) {
+			bss_cache[i] = bss_cache_save_buf[i];
+			bss_cache[i].last_seen = 0U;
+		}
+	}
+
+	k_spin_unlock(&bss_cache_lock, key);
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(wifi_bss_cache, BSS_CACHE_SETTINGS_SUBTREE, NULL,
+			       bss_cache_settings_set, NULL, NULL);
+#else
+static inline void bss_cache_save(void)
+{
+}
+#endif /* CONFIG_WIFI_MGMT_BSS_CACHE_PERSIST */
+
+bool wifi_bss_cache_scan_result(struct net_if *iface, const struct wifi_scan_result *entry)
+{
+	struct wifi_bss_cache_entry *bss;
+	k_spinlock_key_t key;
+	bool changed = false;
+	bool bg_scan;
+
+	ARG_UNUSED(iface);
+
+	key = k_spin_lock(&bss_cache_lock);
+
+	bg_scan = bg_scan_active;
+
+	/* Hidden networks cannot be connected to by SSID */
+	if (entry->ssid_length == 0U || entry->ssid_length > WIFI_SSID_MAX_LEN ||
+	    entry->mac_length != WIFI_MAC_ADDR_LEN) {
+		goto out;
+	}
+
+	bss = bss_cache_find(entry->mac);
+	if (bss == NULL) {
+		bss = bss_cache_alloc();
+		memcpy(bss->bssid, entry->mac, WIFI_MAC_ADDR_LEN);
+		changed = true;
+	}
+
+	if (bss->ssid_length != entry->ssid_length ||
+	    memcmp(bss->ssid, entry->ssid, entry->ssid_length) != 0 ||
+	    bss->band != entry->band || bss->channel != entry->channel ||
+	    bss->security != entry->security) {
+		changed = true;
+	}
+
+	memcpy(bss->ssid, entry->ssid, entry->ssid_length);
+	bss->ssid_length = entry->ssid_length;
+	bss->band = entry->band;
+	bss->channel = entry->channel;
+	bss->security = entry->security;
+	bss->rssi = entry->rssi;
+	bss->last_seen = k_uptime_seconds() + 1U;
+
+out:
+	k_spin_unlock(&bss_cache_lock, key);
+
+	/* The signal alone is not worth a settings write */
+	if (changed) {
+		bss_cache_save();
+	}
+
+	return bg_scan;
+}
+
+bool wifi_bss_cache_scan_done(struct net_if *iface)
+{
+	k_spinlock_key_t key;
+	bool bg_scan;
+
+	ARG_UNUSED(iface);
+
+	key = k_spin_lock(&bss_cache_lock);
+	bg_scan = bg_scan_active;
+	bg_scan_active = false;
+	k_spin_unlock(&bss_cache_lock, key);
+
+	return bg_scan;
+}
+
+bool wifi_bss_cache_connect(struct net_if *iface, struct wifi_connect_req_params *params)
+{
+	struct wifi_bss_cache_entry *best = NULL;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(iface);
+
+	if (params->channel != WIFI_CHANNEL_ANY) {
+		return false;
+	}
+
+	key = k_spin_lock(&bss_cache_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(bss_cache); i++) {
+		struct wifi_bss_cache_entry *bss = &bss_cache[i];
+
+		if (bss->ssid_length != params->ssid_length ||
+		    memcmp(bss->ssid, params->ssid, params->ssid_length) != 0) {
+			continue;
+		}
+
+		if (best == NULL || bss->rssi > best->rssi) {
+			best = bss;
+		}
+	}
+
+	if (best != NULL) {
+		params->band = best->band;
+		params->channel = best->channel;
+		memcpy(bss_cache_tried, best->bssid, WIFI_MAC_ADDR_LEN);
+		bss_cache_tried_valid = true;
+
+		NET_DBG("Cached BSS %02x:%02x:%02x:%02x:%02x:%02x on channel %u",
+			best->bssid[0], best->bssid[1], best->bssid[2],
+			best->bssid[3], best->bssid[4], best->bssid[5],
+			best->channel);
+	}
+
+	k_spin_unlock(&bss_cache_lock, key);
+
+	return best != NULL;
+}
+
+void wifi_bss_cache_connect_result(struct net_if *iface, int status)
+{
+	struct wifi_bss_cache_entry *bss = NULL;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(iface);
+
+	key = k_spin_lock(&bss_cache_lock);
+
+	if (bss_cache_tried_valid && status != 0) {
+		bss = bss_cache_find(bss_cache_tried);
+		if (bss != NULL) {
+			bss->ssid_length = 0U;
+		}
+	}
+
+	bss_cache_tried_valid = false;
+
+	k_spin_unlock(&bss_cache_lock, key);
+
+	/* The next connect falls back to the full procedure */
+	if (bss != NULL) {
+		NET_DBG("Connect failed, dropping cached BSS");
+		bss_cache_save();
+	}
+}
+
+#if CONFIG_WIFI_MGMT_BSS_CACHE_SCAN_INTERVAL > 0
+/* Next cache entry which channel to scan */
+static int bg_scan_next;
+
+/* Gather the next channels of the cached BSSs, returns how many */
+static int bg_scan_channels(struct wifi_scan_params *params)
+{
+	int count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(bss_cache) &&
+			count < CONFIG_WIFI_MGMT_BSS_CACHE_SCAN_CHANNELS; i++) {
+		struct wifi_bss_cache_entry *bss = &bss_cache[bg_scan_next];
+		bool dup = false;
+
+		bg_scan_next = (bg_scan_next + 1) % ARRAY_SIZE(bss_cache);
+
+		if (bss->ssid_length == 0U) {
+			continue;
+		}
+
+		for (int j = 0; j < count; j++) {
+			if (params->band_chan[j].band == bss->band &&
+			    params->band_chan[j].channel == bss->channel) {
+				dup = true;
+				break;
+			}
+		}
+
+		if (dup) {
+			continue;
+		}
+
+		params->band_chan[count].band = bss->band;
+		params->band_chan[count].channel = bss->channel;
+		params->bands |= BIT(bss->band);
+		count++;
+	}
+
+	return count;
+}
+
+static void bg_scan_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_scan_params params = { 0 };
+	k_spinlock_key_t key;
+	int ret;
+
+	if (iface == NULL || !net_if_is_admin_up(iface)) {
+		goto out;
+	}
+
+	key = k_spin_lock(&bss_cache_lock);
+
+	if (bg_scan_active) {
+		k_spin_unlock(&bss_cache_lock, key);
+		goto out;
+	}
+
+	/* With no cached BSS, all the channels are scanned */
+	(void)bg_scan_channels(&params);
+	bg_scan_active = true;
+
+	k_spin_unlock(&bss_cache_lock, key);
+
+	ret = net_mgmt(NET_REQUEST_WIFI_SCAN, iface, &params, sizeof(params));
+	if (ret < 0) {
+		NET_DBG("Background scan failed (%d)", ret);
+		(void)wifi_bss_cache_scan_done(iface);
+	}
+
+out:
+	(void)k_work_reschedule(dwork, K_SECONDS(CONFIG_WIFI_MGMT_BSS_CACHE_SCAN_INTERVAL));
+}
+
+static K_WORK_DELAYABLE_DEFINE(bg_scan_work, bg_scan_handler);
+
+static int wifi_bss_cache_init(void)
+{
+	(void)k_work_schedule(&bg_scan_work,
+			      K_SECONDS(CONFIG_WIFI_MGMT_BSS_CACHE_SCAN_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(wifi_bss_cache_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_WIFI_MGMT_BSS_CACHE_SCAN_INTERVAL > 0 */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_NET_L2_WIFI_WIFI_BSS_CACHE_H_
+#define ZEPHYR_SUBSYS_NET_L2_WIFI_WIFI_BSS_CACHE_H_
+
+#include <stdbool.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/wifi_mgmt.h>
+
+#if defined(CONFIG_WIFI_MGMT_BSS_CACHE)
+
+/* Record a scan result, returns true if it is due to a background scan */
+bool wifi_bss_cache_scan_result(struct net_if *iface, const struct wifi_scan_result *entry);
+
+/* Scan done, returns true if it was a background scan */
+bool wifi_bss_cache_scan_done(struct net_if *iface);
+
+/* Fill in the channel of the best cached BSS of the SSID, returns true if found */
+bool wifi_bss_cache_connect(struct net_if *iface, struct wifi_connect_req_params *params);
+
+/* Connect result, the cached BSS tried last is dropped on failure */
+void wifi_bss_cache_connect_result(struct net_if *iface, int status);
+
+#else
+
+static inline bool wifi_bss_cache_scan_result(struct net_if *iface,
+					      const struct wifi_scan_result *entry)
+{
+	return false;
+}
+
+static inline bool wifi_bss_cache_scan_done(struct net_if *iface)
+{
+	return false;
+}
+
+static inline bool wifi_bss_cache_connect(struct net_if *iface,
+					  struct wifi_connect_req_params *params)
+{
+	return false;
+}
+
+static inline void wifi_bss_cache_connect_result(struct net_if *iface, int status)
+{
+}
+
+#endif /* CONFIG_WIFI_MGMT_BSS_CACHE */
+
+#endif /* ZEPHYR_SUBSYS_NET_L2_WIFI_WIFI_BSS_CACHE_H_ */
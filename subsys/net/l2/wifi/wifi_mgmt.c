@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2016 Intel Corporation.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -17,6 +18,8 @@ LOG_MODULE_REGISTER(net_wifi_mgmt, CONFIG_NET_L2_WIFI_MGMT_LOG_LEVEL);
 #include <zephyr/net/wifi_nm.h>
 #endif /* CONFIG_WIFI_NM */
 
+#include "wifi_bss_cache.h"
+
 const char *wifi_security_txt(enum wifi_security_type security)
 {
 	switch (security) {
@@ -258,6 +261,9 @@ static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 	const struct device *dev = net_if_get_device(iface);
 
 	const struct wifi_mgmt_ops *const wifi_mgmt_api = get_wifi_api(iface);
+#ifdef CONFIG_WIFI_MGMT_BSS_CACHE
+	struct wifi_connect_req_params cached_params;
+#endif /* CONFIG_WIFI_MGMT_BSS_CACHE */
 
 	if (wifi_mgmt_api == NULL || wifi_mgmt_api->connect == NULL) {
 		return -ENOTSUP;
@@ -288,6 +294,16 @@ static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_WIFI_MGMT_BSS_CACHE
+	/* Go straight to the channel of the best known BSS, without a full
+	 * scan, keeping the caller's parameters untouched.
+	 */
+	cached_params = *params;
+	if (wifi_bss_cache_connect(iface, &cached_params)) {
+		params = &cached_params;
+	}
+#endif /* CONFIG_WIFI_MGMT_BSS_CACHE */
+
 	return wifi_mgmt_api->connect(dev, params);
 }
 
@@ -305,12 +321,21 @@ static void scan_result_cb(struct net_if *iface, int status,
 			.status = status,
 		};
 
+		/* Background scans are not reported */
+		if (wifi_bss_cache_scan_done(iface)) {
+			return;
+		}
+
 		net_mgmt_event_notify_with_info(NET_EVENT_WIFI_SCAN_DONE,
 						iface, &scan_status,
 						sizeof(struct wifi_status));
 		return;
 	}
 
+	if (wifi_bss_cache_scan_result(iface, entry)) {
+		return;
+	}
+
 #ifndef CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS_ONLY
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_SCAN_RESULT, iface,
 					entry, sizeof(struct wifi_scan_result));
@@ -363,6 +388,8 @@ void wifi_mgmt_raise_connect_result_event(struct net_if *iface, int status)
 		.status = status,
 	};
 
+	wifi_bss_cache_connect_result(iface, status);
+
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_CONNECT_RESULT,
 					iface, &cnx_status,
 					sizeof(struct wifi_status));
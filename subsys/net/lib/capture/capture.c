@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <stdlib.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_if.h>
@@ -47,6 +48,12 @@ NET_BUF_POOL_VAR_DEFINE(capture_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 			DATA_POOL_SIZE, 4, NULL);
 #endif
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+RING_BUF_DECLARE(capture_ring, CONFIG_NET_CAPTURE_RING_SIZE);
+static uint32_t capture_ring_stored;
+static uint32_t capture_ring_dropped;
+#endif
+
 static sys_slist_t net_capture_devlist;
 
 struct net_capture {
@@ -82,6 +89,23 @@ struct net_capture {
 	 */
 	struct sockaddr local;
 
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	/**
+	 * Filter telling what packets to capture and how much of them.
+	 */
+	struct net_capture_filter_insn filter[CONFIG_NET_CAPTURE_FILTER_MAX_INSNS];
+
+	/**
+	 * Number of filter instructions, 0 if all packets are captured.
+	 */
+	uint16_t filter_len;
+#endif
+
+	/**
+	 * Maximum number of bytes captured from a packet, 0 if unlimited.
+	 */
+	uint32_t snaplen;
+
 	/**
 	 * Is this context setup already
 	 */
@@ -96,6 +120,11 @@ struct net_capture {
 	 * Is this context initialized yet
 	 */
 	bool init_done : 1;
+
+	/**
+	 * Are the packets stored in the capture ring instead of the tunnel
+	 */
+	bool is_ring : 1;
 };
 
 static struct k_mem_slab *get_net_pkt(void)
@@ -442,22 +471,121 @@ fail:
 	return ret;
 }
 
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+int net_capture_filter_set(const struct device *dev,
+			   const struct net_capture_filter_insn *prog,
+			   size_t count)
+{
+	struct net_capture *ctx;
+	int ret;
+
+	if (dev == NULL) {
+		return -EINVAL;
+	}
+
+	ctx = dev->data;
+
+	if (prog != NULL) {
+		if (count > CONFIG_NET_CAPTURE_FILTER_MAX_INSNS) {
+			return -E2BIG;
+		}
+
+		ret = net_capture_filter_check(prog, count);
+		if (ret < 0) {
+			return ret;
+		}
+	} else {
+		count = 0;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (count > 0) {
+		memcpy(ctx->filter, prog, count * sizeof(*prog));
+	}
+
+	ctx->filter_len = count;
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+#endif /* CONFIG_NET_CAPTURE_FILTER */
+
+int net_capture_snaplen_set(const struct device *dev, uint32_t snaplen)
+{
+	struct net_capture *ctx;
+
+	if (dev == NULL) {
+		return -EINVAL;
+	}
+
+	ctx = dev->data;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	ctx->snaplen = snaplen;
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_setup(const struct device **dev)
+{
+	struct net_capture *ctx;
+
+	if (dev == NULL) {
+		return -EINVAL;
+	}
+
+	ctx = alloc_capture_dev();
+	if (ctx == NULL) {
+		return -ENOMEM;
+	}
+
+	memset(&ctx->peer, 0, sizeof(ctx->peer));
+	memset(&ctx->local, 0, sizeof(ctx->local));
+
+	ctx->tunnel_iface = NULL;
+	ctx->context = NULL;
+	ctx->is_ring = true;
+	*dev = ctx->dev;
+
+	return 0;
+}
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 static int capture_cleanup(const struct device *dev)
 {
 	struct net_capture *ctx = dev->data;
 
 	(void)net_capture_disable(dev);
-	(void)net_virtual_interface_attach(ctx->tunnel_iface, NULL);
+
+	if (ctx->tunnel_iface) {
+		(void)net_virtual_interface_attach(ctx->tunnel_iface, NULL);
+	}
 
 	if (ctx->context) {
 		net_context_put(ctx->context);
+		ctx->context = NULL;
 	}
 
-	(void)cleanup_iface(ctx->tunnel_iface, &ctx->local);
+	if (ctx->tunnel_iface) {
+		(void)cleanup_iface(ctx->tunnel_iface, &ctx->local);
+	}
 
+	k_mutex_lock(&lock, K_FOREVER);
+
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	ctx->filter_len = 0;
+#endif
+	ctx->snaplen = 0;
 	ctx->tunnel_iface = NULL;
+	ctx->is_ring = false;
 	ctx->in_use = false;
 
+	k_mutex_unlock(&lock);
+
 	return 0;
 }
 
@@ -488,7 +616,9 @@ static int capture_enable(const struct device *dev, struct net_if *iface)
 
 	net_mgmt_event_notify(NET_EVENT_CAPTURE_STARTED, iface);
 
-	net_if_up(ctx->tunnel_iface);
+	if (ctx->tunnel_iface) {
+		net_if_up(ctx->tunnel_iface);
+	}
 
 	return 0;
 }
@@ -501,19 +631,87 @@ static int capture_disable(const struct device *dev)
 	ctx->capture_iface = NULL;
 	ctx->is_enabled = false;
 
-	net_if_down(ctx->tunnel_iface);
+	if (ctx->tunnel_iface) {
+		net_if_down(ctx->tunnel_iface);
+	}
 
 	net_mgmt_event_notify(NET_EVENT_CAPTURE_STOPPED, iface);
 
 	return 0;
 }
 
+static uint32_t capture_len(struct net_capture *ctx, struct net_pkt *pkt)
+{
+	uint32_t len = net_pkt_get_len(pkt);
+
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	if (ctx->filter_len > 0) {
+		len = MIN(len, net_capture_filter_run(ctx->filter,
+						      ctx->filter_len, pkt));
+	}
+#endif
+
+	if (ctx->snaplen > 0) {
+		len = MIN(len, ctx->snaplen);
+	}
+
+	return len;
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+static int ring_store(struct net_if *iface, struct net_pkt *pkt, uint32_t caplen)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_capture_record_hdr hdr;
+	struct net_pkt_cursor backup;
+	uint32_t left = caplen;
+	uint32_t size;
+	uint8_t *data;
+
+	if (ring_buf_space_get(&capture_ring) < sizeof(hdr) + caplen) {
+		capture_ring_dropped++;
+		return -ENOMEM;
+	}
+
+	hdr.timestamp = k_ticks_to_us_floor64(k_uptime_ticks());
+	hdr.caplen = caplen;
+	hdr.len = net_pkt_get_len(pkt);
+	hdr.iface = net_if_get_by_iface(iface);
+
+	(void)ring_buf_put(&capture_ring, (uint8_t *)&hdr, sizeof(hdr));
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	/* Copy the data from the packet buffers straight into the ring. The
+	 * claimed area can be smaller than requested when the ring wraps.
+	 */
+	while (left > 0) {
+		size = ring_buf_put_claim(&capture_ring, &data, left);
+		(void)net_pkt_read(pkt, data, size);
+		(void)ring_buf_put_finish(&capture_ring, size);
+		left -= size;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	capture_ring_stored++;
+
+	return 0;
+}
+#else
+#define ring_store(...) (-ENOTSUP)
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct k_mem_slab *orig_slab;
 	struct net_pkt *captured;
 	sys_snode_t *sn, *sns;
 	bool skip_clone = false;
+	uint32_t caplen;
 	int ret = -ENOENT;
 
 	/* We must prevent to capture network packet that is already captured
@@ -542,6 +740,31 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 			skip_clone = true;
 		}
 
+		/* The filter is run before anything is copied so that the
+		 * packets we are not interested in cost as little as possible.
+		 */
+		caplen = capture_len(ctx, pkt);
+		if (caplen == 0U) {
+			net_pkt_set_cooked_mode(pkt, false);
+			ret = -ENOENT;
+			goto out;
+		}
+
+		if (ctx->is_ring) {
+			ret = ring_store(iface, pkt, caplen);
+			net_pkt_set_captured(pkt, true);
+			net_pkt_set_cooked_mode(pkt, false);
+
+			/* The cooked packet was given to us, and it is not
+			 * needed anymore once stored.
+			 */
+			if (ret == 0 && skip_clone) {
+				net_pkt_unref(pkt);
+			}
+
+			goto out;
+		}
+
 		if (skip_clone) {
 			captured = pkt;
 		} else {
@@ -560,6 +783,10 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
+		if (caplen < net_pkt_get_len(captured)) {
+			(void)net_pkt_update_length(captured, caplen);
+		}
+
 		net_pkt_set_orig_iface(captured, iface);
 		net_pkt_set_iface(captured, ctx->tunnel_iface);
 		net_pkt_set_captured(pkt, true);
@@ -587,6 +814,129 @@ void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 	(void)net_capture_pkt_with_status(iface, pkt);
 }
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_get(struct net_capture_record_hdr *hdr, uint8_t *data,
+			 size_t len)
+{
+	uint32_t copied;
+
+	if (hdr == NULL || (data == NULL && len > 0)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (ring_buf_get(&capture_ring, (uint8_t *)hdr, sizeof(*hdr)) < sizeof(*hdr)) {
+		k_mutex_unlock(&lock);
+		return -EAGAIN;
+	}
+
+	copied = ring_buf_get(&capture_ring, data, MIN(len, hdr->caplen));
+
+	/* Discard what did not fit */
+	(void)ring_buf_get(&capture_ring, NULL, hdr->caplen - copied);
+
+	k_mutex_unlock(&lock);
+
+	return copied;
+}
+
+static struct net_pkt *ring_record_to_pkt(struct net_capture *ctx,
+					  struct net_capture_record_hdr *hdr)
+{
+	uint32_t left = hdr->caplen;
+	struct net_pkt *pkt;
+	uint32_t size;
+	uint8_t *data;
+
+	pkt = net_pkt_alloc_from_slab(get_net_pkt(), PKT_ALLOC_TIME);
+	if (!pkt) {
+		return NULL;
+	}
+
+	/* The context makes the buffers come from the capture pool */
+	net_pkt_set_context(pkt, ctx->context);
+
+	if (net_pkt_alloc_buffer(pkt, hdr->caplen, IPPROTO_IP, PKT_ALLOC_TIME) < 0) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	(void)ring_buf_get(&capture_ring, (uint8_t *)hdr, sizeof(*hdr));
+
+	while (left > 0) {
+		size = ring_buf_get_claim(&capture_ring, &data, left);
+		(void)net_pkt_write(pkt, data, size);
+		(void)ring_buf_get_finish(&capture_ring, size);
+		left -= size;
+	}
+
+	net_pkt_set_orig_iface(pkt, net_if_get_by_index(hdr->iface));
+	net_pkt_set_iface(pkt, ctx->tunnel_iface);
+	net_pkt_set_captured(pkt, true);
+
+	return pkt;
+}
+
+int net_capture_ring_flush(const struct device *dev)
+{
+	struct net_capture_record_hdr hdr;
+	struct net_capture *ctx;
+	struct net_pkt *pkt;
+	int count = 0;
+	int ret = 0;
+
+	if (dev == NULL) {
+		return -EINVAL;
+	}
+
+	ctx = dev->data;
+
+	if (!ctx->in_use || ctx->is_ring || ctx->tunnel_iface == NULL) {
+		return -EINVAL;
+	}
+
+	if (!net_if_is_up(ctx->tunnel_iface)) {
+		return -ENETDOWN;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	while (ring_buf_peek(&capture_ring, (uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr)) {
+		/* The record stays in the ring if there are no buffers for it */
+		pkt = ring_record_to_pkt(ctx, &hdr);
+		if (pkt == NULL) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = net_capture_send(dev, ctx->tunnel_iface, pkt);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			break;
+		}
+
+		count++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return count > 0 ? count : ret;
+}
+
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	stats->stored = capture_ring_stored;
+	stats->dropped = capture_ring_dropped;
+	stats->size = ring_buf_capacity_get(&capture_ring);
+	stats->used = ring_buf_size_get(&capture_ring);
+
+	k_mutex_unlock(&lock);
+}
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 static int capture_dev_init(const struct device *dev)
 {
 	struct net_capture *ctx = dev->data;
@@ -0,0 +1,370 @@
+/** @file
+ * @brief Network packet capture filter
+ *
+ * Small interpreter for classic BPF style filter programs. The programs
+ * are evaluated directly on the network packet, before it is copied.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/capture.h>
+
+#define FILTER_MEMWORDS 16
+
+#define FILTER_CLASS(code) ((code) & 0x07)
+#define FILTER_SIZE(code)  ((code) & 0x18)
+#define FILTER_MODE(code)  ((code) & 0xe0)
+#define FILTER_OP(code)    ((code) & 0xf0)
+#define FILTER_SRC(code)   ((code) & 0x08)
+#define FILTER_RVAL(code)  ((code) & 0x18)
+#define FILTER_MISCOP(code) ((code) & 0xf8)
+
+static bool filter_code_is_valid(uint16_t code)
+{
+	switch (code) {
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_W | NET_CAPTURE_FILTER_ABS:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_H | NET_CAPTURE_FILTER_ABS:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_B | NET_CAPTURE_FILTER_ABS:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_W | NET_CAPTURE_FILTER_IND:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_H | NET_CAPTURE_FILTER_IND:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_B | NET_CAPTURE_FILTER_IND:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_W | NET_CAPTURE_FILTER_LEN:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_IMM:
+	case NET_CAPTURE_FILTER_LD | NET_CAPTURE_FILTER_MEM:
+	case NET_CAPTURE_FILTER_LDX | NET_CAPTURE_FILTER_W | NET_CAPTURE_FILTER_LEN:
+	case NET_CAPTURE_FILTER_LDX | NET_CAPTURE_FILTER_B | NET_CAPTURE_FILTER_MSH:
+	case NET_CAPTURE_FILTER_LDX | NET_CAPTURE_FILTER_IMM:
+	case NET_CAPTURE_FILTER_LDX | NET_CAPTURE_FILTER_MEM:
+	case NET_CAPTURE_FILTER_ST:
+	case NET_CAPTURE_FILTER_STX:
+	case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_NEG:
+	case NET_CAPTURE_FILTER_JMP | NET_CAPTURE_FILTER_JA:
+	case NET_CAPTURE_FILTER_RET | NET_CAPTURE_FILTER_K:
+	case NET_CAPTURE_FILTER_RET | NET_CAPTURE_FILTER_A:
+	case NET_CAPTURE_FILTER_MISC | NET_CAPTURE_FILTER_TAX:
+	case NET_CAPTURE_FILTER_MISC | NET_CAPTURE_FILTER_TXA:
+		return true;
+	}
+
+	if (FILTER_CLASS(code) == NET_CAPTURE_FILTER_ALU) {
+		switch (code & ~NET_CAPTURE_FILTER_X) {
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_ADD:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_SUB:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_MUL:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_DIV:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_MOD:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_AND:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_OR:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_XOR:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_LSH:
+		case NET_CAPTURE_FILTER_ALU | NET_CAPTURE_FILTER_RSH:
+			return true;
+		}
+	}
+
+	if (FILTER_CLASS(code) == NET_CAPTURE_FILTER_JMP) {
+		switch (code & ~NET_CAPTURE_FILTER_X) {
+		case NET_CAPTURE_FILTER_JMP | NET_CAPTURE_FILTER_JEQ:
+		case NET_CAPTURE_FILTER_JMP | NET_CAPTURE_FILTER_JGT:
+		case NET_CAPTURE_FILTER_JMP | NET_CAPTURE_FILTER_JGE:
+		case NET_CAPTURE_FILTER_JMP | NET_CAPTURE_FILTER_JSET:
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int net_capture_filter_check(const struct net_capture_filter_insn *prog,
+			     size_t count)
+{
+	if (prog == NULL || count == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t pc = 0; pc < count; pc++) {
+		const struct net_capture_filter_insn *insn = &prog[pc];
+		uint16_t code = insn->code;
+
+		if (!filter_code_is_valid(code)) {
+			NET_DBG("Invalid filter code 0x%04x at %zu", code, pc);
+			return -EINVAL;
+		}
+
+		switch (FILTER_CLASS(code)) {
+		case NET_CAPTURE_FILTER_LD:
+		case NET_CAPTURE_FILTER_LDX:
+			if (FILTER_MODE(code) == NET_CAPTURE_FILTER_MEM &&
+			    insn->k >= FILTER_MEMWORDS) {
+				return -EINVAL;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_ST:
+		case NET_CAPTURE_FILTER_STX:
+			if (insn->k >= FILTER_MEMWORDS) {
+				return -EINVAL;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_ALU:
+			if ((FILTER_OP(code) == NET_CAPTURE_FILTER_DIV ||
+			     FILTER_OP(code) == NET_CAPTURE_FILTER_MOD) &&
+			    FILTER_SRC(code) == NET_CAPTURE_FILTER_K &&
+			    insn->k == 0U) {
+				return -EINVAL;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_JMP:
+			/* Only forward jumps that stay within the program are
+			 * allowed, so every program is guaranteed to end.
+			 */
+			if (FILTER_OP(code) == NET_CAPTURE_FILTER_JA) {
+				if (insn->k >= count - pc - 1) {
+					return -EINVAL;
+				}
+			} else if (insn->jt >= count - pc - 1 ||
+				   insn->jf >= count - pc - 1) {
+				return -EINVAL;
+			}
+			break;
+		}
+	}
+
+	if (FILTER_CLASS(prog[count - 1].code) != NET_CAPTURE_FILTER_RET) {
+		NET_DBG("Filter does not end with a return");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int filter_load(struct net_pkt *pkt, uint32_t offset, uint32_t size,
+		       uint32_t *value)
+{
+	uint8_t data[sizeof(uint32_t)];
+
+	if (offset >= net_pkt_get_len(pkt) ||
+	    size > net_pkt_get_len(pkt) - offset) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, offset) < 0 || net_pkt_read(pkt, data, size) < 0) {
+		return -EINVAL;
+	}
+
+	switch (size) {
+	case sizeof(uint32_t):
+		*value = sys_get_be32(data);
+		break;
+	case sizeof(uint16_t):
+		*value = sys_get_be16(data);
+		break;
+	default:
+		*value = data[0];
+		break;
+	}
+
+	return 0;
+}
+
+static uint32_t filter_load_size(uint16_t code)
+{
+	switch (FILTER_SIZE(code)) {
+	case NET_CAPTURE_FILTER_W:
+		return sizeof(uint32_t);
+	case NET_CAPTURE_FILTER_H:
+		return sizeof(uint16_t);
+	default:
+		return sizeof(uint8_t);
+	}
+}
+
+static uint32_t filter_exec(const struct net_capture_filter_insn *prog,
+			    size_t count, struct net_pkt *pkt)
+{
+	uint32_t mem[FILTER_MEMWORDS] = { 0 };
+	uint32_t len = net_pkt_get_len(pkt);
+	uint32_t a = 0U;
+	uint32_t x = 0U;
+	uint32_t val;
+
+	for (size_t pc = 0; pc < count; pc++) {
+		const struct net_capture_filter_insn *insn = &prog[pc];
+		uint16_t code = insn->code;
+
+		switch (FILTER_CLASS(code)) {
+		case NET_CAPTURE_FILTER_LD:
+			switch (FILTER_MODE(code)) {
+			case NET_CAPTURE_FILTER_IMM:
+				a = insn->k;
+				break;
+			case NET_CAPTURE_FILTER_MEM:
+				a = mem[insn->k];
+				break;
+			case NET_CAPTURE_FILTER_LEN:
+				a = len;
+				break;
+			case NET_CAPTURE_FILTER_ABS:
+				if (filter_load(pkt, insn->k, filter_load_size(code), &a) < 0) {
+					return 0;
+				}
+				break;
+			case NET_CAPTURE_FILTER_IND:
+				if (insn->k > UINT32_MAX - x ||
+				    filter_load(pkt, x + insn->k, filter_load_size(code), &a) < 0) {
+					return 0;
+				}
+				break;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_LDX:
+			switch (FILTER_MODE(code)) {
+			case NET_CAPTURE_FILTER_IMM:
+				x = insn->k;
+				break;
+			case NET_CAPTURE_FILTER_MEM:
+				x = mem[insn->k];
+				break;
+			case NET_CAPTURE_FILTER_LEN:
+				x = len;
+				break;
+			case NET_CAPTURE_FILTER_MSH:
+				/* Length of the IPv4 header at k */
+				if (filter_load(pkt, insn->k, sizeof(uint8_t), &val) < 0) {
+					return 0;
+				}
+
+				x = (val & 0x0f) << 2;
+				break;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_ST:
+			mem[insn->k] = a;
+			break;
+
+		case NET_CAPTURE_FILTER_STX:
+			mem[insn->k] = x;
+			break;
+
+		case NET_CAPTURE_FILTER_ALU:
+			val = FILTER_SRC(code) == NET_CAPTURE_FILTER_X ? x : insn->k;
+
+			switch (FILTER_OP(code)) {
+			case NET_CAPTURE_FILTER_ADD:
+				a += val;
+				break;
+			case NET_CAPTURE_FILTER_SUB:
+				a -= val;
+				break;
+			case NET_CAPTURE_FILTER_MUL:
+				a *= val;
+				break;
+			case NET_CAPTURE_FILTER_DIV:
+				if (val == 0U) {
+					return 0;
+				}
+
+				a /= val;
+				break;
+			case NET_CAPTURE_FILTER_MOD:
+				if (val == 0U) {
+					return 0;
+				}
+
+				a %= val;
+				break;
+			case NET_CAPTURE_FILTER_AND:
+				a &= val;
+				break;
+			case NET_CAPTURE_FILTER_OR:
+				a |= val;
+				break;
+			case NET_CAPTURE_FILTER_XOR:
+				a ^= val;
+				break;
+			case NET_CAPTURE_FILTER_LSH:
+				a = val < 32U ? a << val : 0U;
+				break;
+			case NET_CAPTURE_FILTER_RSH:
+				a = val < 32U ? a >> val : 0U;
+				break;
+			case NET_CAPTURE_FILTER_NEG:
+				a = -a;
+				break;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_JMP:
+			val = FILTER_SRC(code) == NET_CAPTURE_FILTER_X ? x : insn->k;
+
+			switch (FILTER_OP(code)) {
+			case NET_CAPTURE_FILTER_JA:
+				pc += insn->k;
+				break;
+			case NET_CAPTURE_FILTER_JEQ:
+				pc += (a == val) ? insn->jt : insn->jf;
+				break;
+			case NET_CAPTURE_FILTER_JGT:
+				pc += (a > val) ? insn->jt : insn->jf;
+				break;
+			case NET_CAPTURE_FILTER_JGE:
+				pc += (a >= val) ? insn->jt : insn->jf;
+				break;
+			case NET_CAPTURE_FILTER_JSET:
+				pc += (a & val) ? insn->jt : insn->jf;
+				break;
+			}
+			break;
+
+		case NET_CAPTURE_FILTER_RET:
+			return FILTER_RVAL(code) == NET_CAPTURE_FILTER_A ? a : insn->k;
+
+		case NET_CAPTURE_FILTER_MISC:
+			if (FILTER_MISCOP(code) == NET_CAPTURE_FILTER_TXA) {
+				a = x;
+			} else {
+				x = a;
+			}
+			break;
+		}
+	}
+
+	/* Not reached for a checked program */
+	return 0;
+}
+
+uint32_t net_capture_filter_run(const struct net_capture_filter_insn *prog,
+				size_t count, struct net_pkt *pkt)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	uint32_t ret;
+
+	/* The packet is only read, so its cursor must be left as it was */
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_backup(pkt, &backup);
+
+	ret = filter_exec(prog, count, pkt);
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	return ret;
+}
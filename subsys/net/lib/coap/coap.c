@@ -1369,6 +1369,18 @@ int coap_get_block2_option(const struct coap_packet *cpkt, uint8_t *block_number
 	return ret;
 }
 
+int coap_append_q_block2_option(struct coap_packet *cpkt, uint32_t block_number, bool more,
+				enum coap_block_size block_size)
+{
+	int val = 0;
+
+	SET_BLOCK_SIZE(val, block_size);
+	SET_MORE(val, more);
+	SET_NUM(val, block_number);
+
+	return coap_append_option_int(cpkt, COAP_OPTION_Q_BLOCK2, val);
+}
+
 int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value, uint16_t len)
 {
 	uint16_t offset = cpkt->hdr_len;
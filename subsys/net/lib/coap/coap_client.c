@@ -68,6 +68,12 @@ static void reset_internal_request(struct coap_client_internal_request *request)
 	request->last_id = 0;
 	request->last_response_id = -1;
 	reset_block_contexts(request);
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+	request->q_block_base = 0;
+	request->q_block_received = 0;
+	request->q_block_last = -1;
+	request->q_block_retries = 0;
+#endif
 }
 
 static int coap_client_schedule_poll(struct coap_client *client, int sock,
@@ -141,6 +147,74 @@ static enum coap_block_size coap_client_default_block_size(void)
 	return COAP_BLOCK_256;
 }
 
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+static bool use_q_block2(const struct coap_client_request *req)
+{
+	return req->q_block2 && req->method == COAP_METHOD_GET;
+}
+
+static bool q_block2_started(const struct coap_client_internal_request *internal_req)
+{
+	return internal_req->q_block_received != 0 || internal_req->q_block_base != 0;
+}
+
+/* Bits of the first count blocks of a payload set */
+static uint32_t q_block2_mask(uint32_t count)
+{
+	return count >= 32 ? UINT32_MAX : BIT(count) - 1;
+}
+
+/* Number of blocks of the current payload set the server is known to send */
+static uint32_t q_block2_set_end(const struct coap_client_internal_request *internal_req)
+{
+	if (internal_req->q_block_last >= 0) {
+		return internal_req->q_block_last + 1 - internal_req->q_block_base;
+	}
+
+	return find_msb_set(internal_req->q_block_received);
+}
+
+static int append_q_block2_options(struct coap_client_internal_request *internal_req)
+{
+	enum coap_block_size block_size = coap_client_default_block_size();
+	uint32_t base = internal_req->q_block_base;
+	uint32_t end;
+	int ret;
+
+	if (internal_req->q_block_received == 0) {
+		if (q_block2_started(internal_req)) {
+			block_size = internal_req->recv_blk_ctx.block_size;
+		}
+
+		/* Ask for the whole payload set */
+		return coap_append_q_block2_option(&internal_req->request, base, true, block_size);
+	}
+
+	block_size = internal_req->recv_blk_ctx.block_size;
+	end = q_block2_set_end(internal_req);
+
+	for (uint32_t i = 0; i < end; i++) {
+		if (internal_req->q_block_received & BIT(i)) {
+			continue;
+		}
+
+		ret = coap_append_q_block2_option(&internal_req->request, base + i, false,
+						  block_size);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	/* The tail of the set was lost too, ask for the rest of it */
+	if (internal_req->q_block_last < 0 && end < CONFIG_COAP_CLIENT_Q_BLOCK_MAX_PAYLOADS) {
+		return coap_append_q_block2_option(&internal_req->request, base + end, true,
+						   block_size);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_COAP_CLIENT_Q_BLOCK */
+
 static int coap_client_init_request(struct coap_client *client,
 				    struct coap_client_request *req,
 				    struct coap_client_internal_request *internal_req,
@@ -187,6 +261,16 @@ static int coap_client_init_request(struct coap_client *client,
 		}
 	}
 
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+	if (use_q_block2(req)) {
+		ret = append_q_block2_options(internal_req);
+
+		if (ret < 0) {
+			LOG_ERR("Failed to append Q-Block2 option");
+			goto out;
+		}
+	} else
+#endif
 	/* Blockwise receive ongoing, request next block. */
 	if (internal_req->recv_blk_ctx.current > 0) {
 		ret = coap_append_block2_option(&internal_req->request,
@@ -411,11 +495,146 @@ static bool timeout_expired(struct coap_client_internal_request *internal_req)
 		internal_req->pending.timeout <= (k_uptime_get() - internal_req->pending.t0));
 }
 
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+/* Send the request for the payload set following the received blocks, keeping the token so
+ * that blocks still on their way are matched.
+ */
+static int q_block2_request(struct coap_client *client,
+			    struct coap_client_internal_request *internal_req)
+{
+	int ret;
+
+	k_mutex_lock(&client->send_mutex, K_FOREVER);
+
+	internal_req->last_id = coap_next_id();
+	ret = coap_client_init_request(client, &internal_req->coap_request, internal_req, true);
+	if (ret < 0) {
+		LOG_ERR("Error creating a CoAP request");
+		k_mutex_unlock(&client->send_mutex);
+		return ret;
+	}
+
+	ret = send_request(client->fd, internal_req->request.data, internal_req->request.offset,
+			   0, &client->address, client->socklen);
+	k_mutex_unlock(&client->send_mutex);
+
+	if (ret < 0) {
+		LOG_ERR("Error sending a CoAP request");
+		return ret;
+	}
+
+	internal_req->pending.t0 = k_uptime_get();
+	internal_req->pending.timeout = CONFIG_COAP_CLIENT_Q_BLOCK_TIMEOUT;
+
+	return 0;
+}
+
+static int q_block2_recover(struct coap_client *client,
+			    struct coap_client_internal_request *internal_req)
+{
+	int ret;
+
+	if (++internal_req->q_block_retries > CONFIG_COAP_MAX_RETRANSMIT) {
+		LOG_ERR("Q-Block2 blocks missing, no more retries left");
+		ret = -ETIMEDOUT;
+	} else {
+		LOG_WRN("Q-Block2 blocks missing, requesting them again");
+		ret = q_block2_request(client, internal_req);
+		if (ret == 0) {
+			return 0;
+		}
+	}
+
+	report_callback_error(internal_req, ret);
+	internal_req->request_ongoing = false;
+
+	return ret;
+}
+
+static int handle_q_block2_response(struct coap_client *client,
+				    struct coap_client_internal_request *internal_req,
+				    int block_option, uint8_t response_code,
+				    const uint8_t *payload, uint16_t payload_len)
+{
+	uint32_t block_num = GET_BLOCK_NUM(block_option);
+	uint32_t index = block_num - internal_req->q_block_base;
+	uint32_t set_mask;
+	bool complete = false;
+	int ret;
+
+	if (block_num < internal_req->q_block_base ||
+	    index >= CONFIG_COAP_CLIENT_Q_BLOCK_MAX_PAYLOADS ||
+	    (internal_req->q_block_received & BIT(index))) {
+		LOG_DBG("Dropping Q-Block2 block %u", block_num);
+		return 1;
+	}
+
+	internal_req->recv_blk_ctx.block_size = GET_BLOCK_SIZE(block_option);
+	internal_req->q_block_received |= BIT(index);
+	internal_req->q_block_retries = 0;
+	if (!GET_MORE(block_option)) {
+		internal_req->q_block_last = block_num;
+	}
+
+	if (internal_req->q_block_last >= 0) {
+		set_mask = q_block2_mask(q_block2_set_end(internal_req));
+		complete = (internal_req->q_block_received & set_mask) == set_mask;
+	}
+
+	if (internal_req->coap_request.cb) {
+		if (!atomic_set(&internal_req->in_callback, 1)) {
+			internal_req->coap_request.cb(response_code,
+				block_num * coap_block_size_to_bytes(GET_BLOCK_SIZE(block_option)),
+				payload, payload_len, complete,
+				internal_req->coap_request.user_data);
+			atomic_clear(&internal_req->in_callback);
+		}
+		if (!internal_req->request_ongoing) {
+			/* User callback must have called coap_client_cancel_requests(). */
+			return 0;
+		}
+	}
+
+	if (complete) {
+		coap_pending_clear(&internal_req->pending);
+		internal_req->request_ongoing = false;
+		return 0;
+	}
+
+	set_mask = q_block2_mask(CONFIG_COAP_CLIENT_Q_BLOCK_MAX_PAYLOADS);
+	if (internal_req->q_block_received == set_mask) {
+		internal_req->q_block_base += CONFIG_COAP_CLIENT_Q_BLOCK_MAX_PAYLOADS;
+		internal_req->q_block_received = 0;
+
+		ret = q_block2_request(client, internal_req);
+		if (ret < 0) {
+			internal_req->request_ongoing = false;
+			return ret;
+		}
+
+		return 1;
+	}
+
+	/* Wait for the rest of the payload set */
+	internal_req->pending.t0 = k_uptime_get();
+	internal_req->pending.timeout = CONFIG_COAP_CLIENT_Q_BLOCK_TIMEOUT;
+
+	return 1;
+}
+#endif /* CONFIG_COAP_CLIENT_Q_BLOCK */
+
 static int resend_request(struct coap_client *client,
 			  struct coap_client_internal_request *internal_req)
 {
 	int ret = 0;
 
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+	if (internal_req->request_ongoing && use_q_block2(&internal_req->coap_request) &&
+	    q_block2_started(internal_req)) {
+		return q_block2_recover(client, internal_req);
+	}
+#endif
+
 	if (internal_req->request_ongoing &&
 	    internal_req->pending.timeout != 0 &&
 	    coap_pending_cycle(&internal_req->pending)) {
@@ -755,6 +974,16 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 		coap_pending_clear(&internal_req->pending);
 	}
 
+#if defined(CONFIG_COAP_CLIENT_Q_BLOCK)
+	block_option = coap_get_option_int(response, COAP_OPTION_Q_BLOCK2);
+	if (block_option >= 0 && use_q_block2(&internal_req->coap_request)) {
+		ret = handle_q_block2_response(client, internal_req, block_option, response_code,
+					       payload, payload_len);
+		client->response_ready = false;
+		return ret;
+	}
+#endif
+
 	/* Check if block2 exists */
 	block_option = coap_get_option_int(response, COAP_OPTION_BLOCK2);
 	if (block_option > 0) {
@@ -45,6 +45,25 @@ K_MEM_SLAB_DEFINE_STATIC(pending_data, CONFIG_COAP_SERVER_MESSAGE_SIZE,
 			 CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC_BLOCKS, 4);
 #endif
 
+#if CONFIG_COAP_SERVER_WORKERS > 0
+/* Received datagram waiting for a worker */
+struct coap_server_request {
+	void *fifo_reserved;
+	struct sockaddr addr;
+	socklen_t addr_len;
+	int sock_fd;
+	uint16_t len;
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+};
+
+K_MEM_SLAB_DEFINE_STATIC(request_slab, sizeof(struct coap_server_request),
+			 CONFIG_COAP_SERVER_REQUEST_CONTEXTS, 4);
+static K_FIFO_DEFINE(request_fifo);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_COAP_SERVER_WORKERS,
+				   CONFIG_COAP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread worker_threads[CONFIG_COAP_SERVER_WORKERS];
+#endif
+
 static inline void *coap_server_alloc(size_t len)
 {
 #if defined(CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC)
@@ -121,35 +140,19 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	return 0;
 }
 
-static int coap_server_process(int sock_fd)
+static int coap_server_handle(int sock_fd, uint8_t *buf, size_t received,
+			      struct sockaddr *client_addr, socklen_t client_addr_len)
 {
-	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
-
-	struct sockaddr client_addr;
-	socklen_t client_addr_len = sizeof(client_addr);
 	struct coap_service *service = NULL;
 	struct coap_packet request;
 	struct coap_pending *pending;
-	struct coap_option options[MAX_OPTIONS] = { 0 };
-	uint8_t opt_num = MAX_OPTIONS;
+	struct coap_option options[MAX_OPTIONS];
+	int opt_num;
 	uint8_t type;
-	ssize_t received;
 	int ret;
 
-	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
-				  &client_addr_len);
-	__ASSERT_NO_MSG(received <= sizeof(buf));
-
-	if (received < 0) {
-		if (errno == EWOULDBLOCK) {
-			return 0;
-		}
-
-		LOG_ERR("Failed to process client request (%d)", -errno);
-		return -errno;
-	}
-
-	ret = coap_packet_parse(&request, buf, received, options, opt_num);
+	/* Only validate the options here, handlers look up the ones they need */
+	ret = coap_packet_parse(&request, buf, received, NULL, 0);
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
 		return ret;
@@ -178,7 +181,7 @@ static int coap_server_process(int sock_fd)
 		switch (type) {
 		case COAP_TYPE_RESET:
 			tkl = coap_header_get_token(&request, token);
-			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
+			coap_service_remove_observer(service, NULL, client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
 			coap_server_free(pending->data);
@@ -197,6 +200,17 @@ static int coap_server_process(int sock_fd)
 		goto unlock;
 	}
 
+	/* Resource handlers run without the lock so workers can serve requests
+	 * concurrently, services and resources are statically allocated.
+	 */
+	(void)k_mutex_unlock(&lock);
+
+	/* Resources are matched on the path options only */
+	opt_num = coap_find_options(&request, COAP_OPTION_URI_PATH, options, MAX_OPTIONS);
+	if (opt_num < 0) {
+		return opt_num;
+	}
+
 	if (IS_ENABLED(CONFIG_COAP_SERVER_WELL_KNOWN_CORE) &&
 	    coap_header_get_code(&request) == COAP_METHOD_GET &&
 	    coap_uri_path_match(COAP_WELL_KNOWN_CORE_PATH, options, opt_num)) {
@@ -209,14 +223,14 @@ static int coap_server_process(int sock_fd)
 						   well_known_buf, sizeof(well_known_buf));
 		if (ret < 0) {
 			LOG_ERR("Failed to build well known core for %s (%d)", service->name, ret);
-			goto unlock;
+			return ret;
 		}
 
-		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
+		ret = coap_service_send(service, &response, client_addr, client_addr_len, NULL);
 	} else {
 		ret = coap_handle_request_len(&request, service->res_begin,
 					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
+					      options, opt_num, client_addr, client_addr_len);
 
 		/* Translate errors to response codes */
 		switch (ret) {
@@ -240,19 +254,111 @@ static int coap_server_process(int sock_fd)
 			ret = coap_ack_init(&ack, &request, ack_buf, sizeof(ack_buf), (uint8_t)ret);
 			if (ret < 0) {
 				LOG_ERR("Failed to init ACK (%d)", ret);
-				goto unlock;
+				return ret;
 			}
 
-			ret = coap_service_send(service, &ack, &client_addr, client_addr_len, NULL);
+			ret = coap_service_send(service, &ack, client_addr, client_addr_len, NULL);
 		}
 	}
 
+	return ret;
+
 unlock:
 	(void)k_mutex_unlock(&lock);
 
 	return ret;
 }
 
+#if CONFIG_COAP_SERVER_WORKERS > 0
+static int coap_server_process(int sock_fd)
+{
+	struct coap_server_request *req;
+	ssize_t received;
+
+	/* Blocking here leaves further datagrams queued in the sockets until
+	 * a worker is done with its request.
+	 */
+	(void)k_mem_slab_alloc(&request_slab, (void **)&req, K_FOREVER);
+
+	req->addr_len = sizeof(req->addr);
+	received = zsock_recvfrom(sock_fd, req->buf, sizeof(req->buf), ZSOCK_MSG_DONTWAIT,
+				  &req->addr, &req->addr_len);
+	__ASSERT_NO_MSG(received <= sizeof(req->buf));
+
+	if (received < 0) {
+		k_mem_slab_free(&request_slab, req);
+
+		if (errno == EWOULDBLOCK) {
+			return 0;
+		}
+
+		LOG_ERR("Failed to process client request (%d)", -errno);
+		return -errno;
+	}
+
+	req->sock_fd = sock_fd;
+	req->len = received;
+	k_fifo_put(&request_fifo, req);
+
+	return 0;
+}
+
+static void coap_server_worker(void *p1, void *p2, void *p3)
+{
+	struct coap_server_request *req;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		req = k_fifo_get(&request_fifo, K_FOREVER);
+
+		(void)coap_server_handle(req->sock_fd, req->buf, req->len, &req->addr,
+					 req->addr_len);
+
+		k_mem_slab_free(&request_slab, req);
+	}
+}
+
+static void coap_server_start_workers(void)
+{
+	for (int i = 0; i < CONFIG_COAP_SERVER_WORKERS; i++) {
+		k_tid_t tid;
+
+		tid = k_thread_create(&worker_threads[i], worker_stacks[i],
+				      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				      coap_server_worker, NULL, NULL, NULL,
+				      THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(tid, "coap_worker");
+	}
+}
+#else
+static int coap_server_process(int sock_fd)
+{
+	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+
+	struct sockaddr client_addr;
+	socklen_t client_addr_len = sizeof(client_addr);
+	ssize_t received;
+
+	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
+				  &client_addr_len);
+	__ASSERT_NO_MSG(received <= sizeof(buf));
+
+	if (received < 0) {
+		if (errno == EWOULDBLOCK) {
+			return 0;
+		}
+
+		LOG_ERR("Failed to process client request (%d)", -errno);
+		return -errno;
+	}
+
+	return coap_server_handle(sock_fd, buf, received, &client_addr, client_addr_len);
+}
+#endif /* CONFIG_COAP_SERVER_WORKERS > 0 */
+
 static void coap_server_retransmit(void)
 {
 	struct coap_pending *pending;
@@ -743,6 +849,10 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 		}
 	}
 
+#if CONFIG_COAP_SERVER_WORKERS > 0
+	coap_server_start_workers();
+#endif
+
 	COAP_SERVICE_FOREACH(svc) {
 		if (svc->flags & COAP_SERVICE_AUTOSTART) {
 			ret = coap_service_start(svc);
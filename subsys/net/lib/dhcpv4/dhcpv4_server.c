@@ -4,6 +4,7 @@
 
 /*
  * Copyright (c) 2024 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -18,6 +19,7 @@
 #include <zephyr/net/socket.h>
 #include <zephyr/net/socket_service.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/math_extras.h>
 
 LOG_MODULE_REGISTER(net_dhcpv4_server, CONFIG_NET_DHCPV4_SERVER_LOG_LEVEL);
 
@@ -57,11 +59,32 @@ struct dhcpv4_server_probe_ctx {
 	struct dhcpv4_addr_slot *slot;
 };
 
+#define ADDR_COUNT CONFIG_NET_DHCPV4_SERVER_ADDR_COUNT
+#define SLOT_NONE UINT16_MAX
+#define CLIENT_HASH_SIZE ADDR_COUNT
+#define FREE_MAP_WORDS DIV_ROUND_UP(ADDR_COUNT, 32)
+
+BUILD_ASSERT(ADDR_COUNT < SLOT_NONE, "Too many addresses in the DHCPv4 address pool");
+
+/* Address pool indexes, not to scan the pool for every message. */
+struct dhcpv4_server_lease_index {
+	/* Slots with a client ID by its hash, chained through client_next. */
+	uint16_t client_hash[CLIENT_HASH_SIZE];
+	uint16_t client_next[ADDR_COUNT];
+	/* Min-heap of the slots which are not free, by expiry. */
+	uint16_t heap[ADDR_COUNT];
+	uint16_t heap_pos[ADDR_COUNT];
+	uint16_t heap_len;
+	/* Bitmap of the free slots. */
+	uint32_t free_map[FREE_MAP_WORDS];
+};
+
 struct dhcpv4_server_ctx {
 	struct net_if *iface;
 	int sock;
 	struct k_work_delayable timeout_work;
-	struct dhcpv4_addr_slot addr_pool[CONFIG_NET_DHCPV4_SERVER_ADDR_COUNT];
+	struct dhcpv4_addr_slot addr_pool[ADDR_COUNT];
+	struct dhcpv4_server_lease_index index;
 	struct in_addr server_addr;
 	struct in_addr netmask;
 #if defined(DHCPV4_SERVER_ICMP_PROBE)
@@ -73,24 +96,253 @@ static struct dhcpv4_server_ctx server_ctx[CONFIG_NET_DHCPV4_SERVER_INSTANCES];
 static struct zsock_pollfd fds[CONFIG_NET_DHCPV4_SERVER_INSTANCES];
 static K_MUTEX_DEFINE(server_lock);
 
-static void dhcpv4_server_timeout_recalc(struct dhcpv4_server_ctx *ctx)
+static inline uint16_t dhcpv4_server_slot_idx(struct dhcpv4_server_ctx *ctx,
+					      struct dhcpv4_addr_slot *slot)
 {
-	k_timepoint_t next = sys_timepoint_calc(K_FOREVER);
-	k_timeout_t timeout;
+	return (uint16_t)(slot - ctx->addr_pool);
+}
 
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
+/* Address pool lookup. */
 
-		if (slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-		    slot->state == DHCPV4_SERVER_ADDR_ALLOCATED ||
-		    slot->state == DHCPV4_SERVER_ADDR_DECLINED) {
-			if (sys_timepoint_cmp(slot->expiry, next) < 0) {
-				next = slot->expiry;
-			}
+static struct dhcpv4_addr_slot *dhcpv4_server_slot_by_addr(struct dhcpv4_server_ctx *ctx,
+							   const struct in_addr *addr)
+{
+	uint32_t offset = ntohl(addr->s_addr) - ntohl(ctx->addr_pool[0].addr.s_addr);
+
+	if (offset >= ARRAY_SIZE(ctx->addr_pool)) {
+		return NULL;
+	}
+
+	return &ctx->addr_pool[offset];
+}
+
+static bool dhcpv4_server_slot_is_bound(struct dhcpv4_addr_slot *slot,
+					const struct dhcpv4_client_id *client_id)
+{
+	return (slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
+		slot->state == DHCPV4_SERVER_ADDR_ALLOCATED) &&
+	       slot->client_id.len == client_id->len &&
+	       memcmp(slot->client_id.buf, client_id->buf, client_id->len) == 0;
+}
+
+static uint16_t dhcpv4_server_client_hash(const struct dhcpv4_client_id *client_id)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	for (int i = 0; i < client_id->len; i++) {
+		hash = (hash ^ client_id->buf[i]) * 16777619U;
+	}
+
+	return hash % CLIENT_HASH_SIZE;
+}
+
+static void dhcpv4_server_client_unlink(struct dhcpv4_server_ctx *ctx,
+					struct dhcpv4_addr_slot *slot)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+	uint16_t idx = dhcpv4_server_slot_idx(ctx, slot);
+	uint16_t *link;
+
+	if (slot->client_id.len == 0) {
+		return;
+	}
+
+	link = &index->client_hash[dhcpv4_server_client_hash(&slot->client_id)];
+	while (*link != SLOT_NONE) {
+		if (*link == idx) {
+			*link = index->client_next[idx];
+			break;
+		}
+
+		link = &index->client_next[*link];
+	}
+
+	slot->client_id.len = 0;
+}
+
+static void dhcpv4_server_slot_bind(struct dhcpv4_server_ctx *ctx,
+				    struct dhcpv4_addr_slot *slot,
+				    const struct dhcpv4_client_id *client_id)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+	uint16_t idx = dhcpv4_server_slot_idx(ctx, slot);
+	uint16_t hash = dhcpv4_server_client_hash(client_id);
+
+	if (slot->client_id.len == client_id->len &&
+	    memcmp(slot->client_id.buf, client_id->buf, client_id->len) == 0) {
+		return;
+	}
+
+	dhcpv4_server_client_unlink(ctx, slot);
+
+	slot->client_id.len = client_id->len;
+	memcpy(slot->client_id.buf, client_id->buf, client_id->len);
+
+	index->client_next[idx] = index->client_hash[hash];
+	index->client_hash[hash] = idx;
+}
+
+static struct dhcpv4_addr_slot *dhcpv4_server_find_client(
+				struct dhcpv4_server_ctx *ctx,
+				const struct dhcpv4_client_id *client_id)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+	uint16_t idx = index->client_hash[dhcpv4_server_client_hash(client_id)];
+
+	while (idx != SLOT_NONE) {
+		if (dhcpv4_server_slot_is_bound(&ctx->addr_pool[idx], client_id)) {
+			return &ctx->addr_pool[idx];
+		}
+
+		idx = index->client_next[idx];
+	}
+
+	return NULL;
+}
+
+static struct dhcpv4_addr_slot *dhcpv4_server_find_free(struct dhcpv4_server_ctx *ctx)
+{
+	for (int i = 0; i < FREE_MAP_WORDS; i++) {
+		uint32_t word = ctx->index.free_map[i];
+
+		if (word != 0U) {
+			return &ctx->addr_pool[i * 32 + u32_count_trailing_zeros(word)];
+		}
+	}
+
+	return NULL;
+}
+
+/* Expiry min-heap. */
+
+static bool dhcpv4_server_heap_less(struct dhcpv4_server_ctx *ctx, uint16_t a, uint16_t b)
+{
+	return sys_timepoint_cmp(ctx->addr_pool[ctx->index.heap[a]].expiry,
+				 ctx->addr_pool[ctx->index.heap[b]].expiry) < 0;
+}
+
+static void dhcpv4_server_heap_swap(struct dhcpv4_server_ctx *ctx, uint16_t a, uint16_t b)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+	uint16_t tmp = index->heap[a];
+
+	index->heap[a] = index->heap[b];
+	index->heap[b] = tmp;
+	index->heap_pos[index->heap[a]] = a;
+	index->heap_pos[index->heap[b]] = b;
+}
+
+static void dhcpv4_server_heap_sift(struct dhcpv4_server_ctx *ctx, uint16_t pos)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+
+	while (pos > 0 && dhcpv4_server_heap_less(ctx, pos, (pos - 1) / 2)) {
+		dhcpv4_server_heap_swap(ctx, pos, (pos - 1) / 2);
+		pos = (pos - 1) / 2;
+	}
+
+	while (true) {
+		uint16_t min = pos;
+		uint16_t child = 2 * pos + 1;
+
+		if (child < index->heap_len && dhcpv4_server_heap_less(ctx, child, min)) {
+			min = child;
+		}
+
+		if (child + 1 < index->heap_len && dhcpv4_server_heap_less(ctx, child + 1, min)) {
+			min = child + 1;
 		}
+
+		if (min == pos) {
+			break;
+		}
+
+		dhcpv4_server_heap_swap(ctx, pos, min);
+		pos = min;
+	}
+}
+
+static void dhcpv4_server_heap_update(struct dhcpv4_server_ctx *ctx, uint16_t idx)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+	uint16_t pos = index->heap_pos[idx];
+
+	if (pos == SLOT_NONE) {
+		pos = index->heap_len++;
+		index->heap[pos] = idx;
+		index->heap_pos[idx] = pos;
+	}
+
+	dhcpv4_server_heap_sift(ctx, pos);
+}
+
+static void dhcpv4_server_heap_remove(struct dhcpv4_server_ctx *ctx, uint16_t idx)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+	uint16_t pos = index->heap_pos[idx];
+	uint16_t last;
+
+	if (pos == SLOT_NONE) {
+		return;
+	}
+
+	last = --index->heap_len;
+	if (pos != last) {
+		dhcpv4_server_heap_swap(ctx, pos, last);
+	}
+
+	index->heap_pos[idx] = SLOT_NONE;
+
+	if (pos != last) {
+		dhcpv4_server_heap_sift(ctx, pos);
+	}
+}
+
+static void dhcpv4_server_index_init(struct dhcpv4_server_ctx *ctx)
+{
+	struct dhcpv4_server_lease_index *index = &ctx->index;
+
+	memset(index, 0, sizeof(*index));
+
+	for (int i = 0; i < ARRAY_SIZE(index->client_hash); i++) {
+		index->client_hash[i] = SLOT_NONE;
 	}
 
-	timeout = sys_timepoint_timeout(next);
+	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
+		index->client_next[i] = SLOT_NONE;
+		index->heap_pos[i] = SLOT_NONE;
+		index->free_map[i / 32] |= BIT(i % 32);
+	}
+}
+
+/* Update the state and expiry of a slot, along with the indexes. */
+static void dhcpv4_server_slot_set(struct dhcpv4_server_ctx *ctx,
+				   struct dhcpv4_addr_slot *slot,
+				   enum dhcpv4_server_addr_state state,
+				   k_timepoint_t expiry)
+{
+	uint16_t idx = dhcpv4_server_slot_idx(ctx, slot);
+
+	slot->state = state;
+	slot->expiry = expiry;
+
+	if (state == DHCPV4_SERVER_ADDR_FREE) {
+		ctx->index.free_map[idx / 32] |= BIT(idx % 32);
+		dhcpv4_server_heap_remove(ctx, idx);
+	} else {
+		ctx->index.free_map[idx / 32] &= ~BIT(idx % 32);
+		dhcpv4_server_heap_update(ctx, idx);
+	}
+}
+
+static void dhcpv4_server_timeout_recalc(struct dhcpv4_server_ctx *ctx)
+{
+	k_timeout_t timeout = K_FOREVER;
+
+	if (ctx->index.heap_len > 0) {
+		timeout = sys_timepoint_timeout(ctx->addr_pool[ctx->index.heap[0]].expiry);
+	}
 
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		LOG_DBG("No more addresses, canceling timer");
@@ -764,18 +1016,11 @@ static int echo_reply_handler(struct net_icmp_ctx *icmp_ctx,
 	LOG_DBG("Got ICMP probe response, blocking address %s",
 		net_sprint_ipv4_addr(&probe_ctx->slot->addr));
 
-	probe_ctx->slot->state = DHCPV4_SERVER_ADDR_DECLINED;
-	probe_ctx->slot->expiry = sys_timepoint_calc(ADDRESS_DECLINED_TIMEOUT);
+	dhcpv4_server_slot_set(ctx, probe_ctx->slot, DHCPV4_SERVER_ADDR_DECLINED,
+			       sys_timepoint_calc(ADDRESS_DECLINED_TIMEOUT));
 
 	/* Try to find next free address */
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-		if (slot->state == DHCPV4_SERVER_ADDR_FREE) {
-			new_slot = slot;
-			break;
-		}
-	}
+	new_slot = dhcpv4_server_find_free(ctx);
 
 	if (new_slot == NULL) {
 		LOG_DBG("No more free addresses to assign, ICMP probing stopped");
@@ -790,11 +1035,9 @@ static int echo_reply_handler(struct net_icmp_ctx *icmp_ctx,
 		goto out;
 	}
 
-	new_slot->state = DHCPV4_SERVER_ADDR_RESERVED;
-	new_slot->expiry = sys_timepoint_calc(ADDRESS_PROBE_TIMEOUT);
-	new_slot->client_id.len = probe_ctx->slot->client_id.len;
-	memcpy(new_slot->client_id.buf, probe_ctx->slot->client_id.buf,
-	       new_slot->client_id.len);
+	dhcpv4_server_slot_set(ctx, new_slot, DHCPV4_SERVER_ADDR_RESERVED,
+			       sys_timepoint_calc(ADDRESS_PROBE_TIMEOUT));
+	dhcpv4_server_slot_bind(ctx, new_slot, &probe_ctx->slot->client_id);
 	new_slot->lease_time = probe_ctx->slot->lease_time;
 
 	probe_ctx->slot = new_slot;
@@ -855,11 +1098,13 @@ static void dhcpv4_server_probe_timeout(struct dhcpv4_server_ctx *ctx,
 	if (dhcpv4_send_offer(ctx, &ctx->probe_ctx.discovery, &slot->addr,
 			      slot->lease_time, &ctx->probe_ctx.params,
 			      &ctx->probe_ctx.client_id) < 0) {
-		slot->state = DHCPV4_SERVER_ADDR_FREE;
+		dhcpv4_server_slot_set(ctx, slot, DHCPV4_SERVER_ADDR_FREE,
+				       sys_timepoint_calc(K_FOREVER));
 		return;
 	}
 
-	slot->expiry = sys_timepoint_calc(ADDRESS_RESERVED_TIMEOUT);
+	dhcpv4_server_slot_set(ctx, slot, slot->state,
+			       sys_timepoint_calc(ADDRESS_RESERVED_TIMEOUT));
 }
 
 static bool dhcpv4_server_is_slot_probed(struct dhcpv4_server_ctx *ctx,
@@ -897,24 +1142,12 @@ static void dhcpv4_handle_discover(struct dhcpv4_server_ctx *ctx,
 	 */
 
 	/* 1. Check for current bindings */
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-		if ((slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-		     slot->state == DHCPV4_SERVER_ADDR_ALLOCATED) &&
-		    slot->client_id.len == client_id.len &&
-		    memcmp(slot->client_id.buf, client_id.buf,
-			    client_id.len) == 0) {
-			if (slot->state == DHCPV4_SERVER_ADDR_RESERVED &&
-			    dhcpv4_server_is_slot_probed(ctx, slot)) {
-				LOG_DBG("ICMP probing in progress, ignore Discovery");
-				return;
-			}
-
-			/* Got match in current bindings. */
-			selected = slot;
-			break;
-		}
+	selected = dhcpv4_server_find_client(ctx, &client_id);
+	if (selected != NULL &&
+	    selected->state == DHCPV4_SERVER_ADDR_RESERVED &&
+	    dhcpv4_server_is_slot_probed(ctx, selected)) {
+		LOG_DBG("ICMP probing in progress, ignore Discovery");
+		return;
 	}
 
 	/* 2. Skipped, for now expired/released entries are forgotten. */
@@ -926,18 +1159,14 @@ static void dhcpv4_handle_discover(struct dhcpv4_server_ctx *ctx,
 		ret = dhcpv4_find_requested_ip_option(options, optlen,
 						      &requested_ip);
 		if (ret == 0) {
-			for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-				struct dhcpv4_addr_slot *slot =
-							&ctx->addr_pool[i];
-
-				if (net_ipv4_addr_cmp(&slot->addr,
-						      &requested_ip) &&
-				    slot->state == DHCPV4_SERVER_ADDR_FREE) {
-					/* Requested address is free. */
-					selected = slot;
-					probe = true;
-					break;
-				}
+			struct dhcpv4_addr_slot *slot =
+				dhcpv4_server_slot_by_addr(ctx, &requested_ip);
+
+			if (slot != NULL &&
+			    slot->state == DHCPV4_SERVER_ADDR_FREE) {
+				/* Requested address is free. */
+				selected = slot;
+				probe = true;
 			}
 		}
 	}
@@ -952,20 +1181,15 @@ static void dhcpv4_handle_discover(struct dhcpv4_server_ctx *ctx,
 			return;
 		}
 
-		for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-			struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-			if (slot->state == DHCPV4_SERVER_ADDR_FREE) {
-				/* Requested address is free. */
-				selected = slot;
-				probe = true;
-				break;
-			}
+		selected = dhcpv4_server_find_free(ctx);
+		if (selected != NULL) {
+			probe = true;
 		}
 	}
 
 	/* In case no free address slot was found, as a last resort, try to
-	 * reuse the oldest declined entry, if present.
+	 * reuse the oldest declined entry, if present. Only done with the
+	 * whole pool in use, so scanning it is fine.
 	 */
 	if (selected == NULL) {
 		for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
@@ -989,6 +1213,7 @@ static void dhcpv4_handle_discover(struct dhcpv4_server_ctx *ctx,
 		LOG_ERR("No free address found in address pool");
 	} else {
 		uint32_t lease_time = dhcpv4_get_lease_time(options, optlen);
+		k_timepoint_t expiry;
 
 		if (IS_ENABLED(DHCPV4_SERVER_ICMP_PROBE) && probe) {
 			if (dhcpv4_server_probe_setup(ctx, selected, msg,
@@ -1000,24 +1225,22 @@ static void dhcpv4_handle_discover(struct dhcpv4_server_ctx *ctx,
 				return;
 			}
 
-			selected->expiry =
-				sys_timepoint_calc(ADDRESS_PROBE_TIMEOUT);
+			expiry = sys_timepoint_calc(ADDRESS_PROBE_TIMEOUT);
 		} else {
 			if (dhcpv4_send_offer(ctx, msg, &selected->addr,
 					      lease_time, &params, &client_id) < 0) {
 				return;
 			}
 
-			selected->expiry =
-				sys_timepoint_calc(ADDRESS_RESERVED_TIMEOUT);
+			expiry = sys_timepoint_calc(ADDRESS_RESERVED_TIMEOUT);
 		}
 
 		LOG_DBG("DHCPv4 processing Discover - reserved %s",
 			net_sprint_ipv4_addr(&selected->addr));
 
-		selected->state = DHCPV4_SERVER_ADDR_RESERVED;
-		selected->client_id.len = client_id.len;
-		memcpy(selected->client_id.buf, client_id.buf, client_id.len);
+		dhcpv4_server_slot_set(ctx, selected, DHCPV4_SERVER_ADDR_RESERVED,
+				       expiry);
+		dhcpv4_server_slot_bind(ctx, selected, &client_id);
 		selected->lease_time = lease_time;
 		dhcpv4_server_timeout_recalc(ctx);
 	}
@@ -1069,18 +1292,10 @@ static void dhcpv4_handle_request(struct dhcpv4_server_ctx *ctx,
 			return;
 		}
 
-		for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-			struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-			if (net_ipv4_addr_cmp(&slot->addr, &requested_ip) &&
-			    slot->client_id.len == client_id.len &&
-			    memcmp(slot->client_id.buf, client_id.buf,
-				   client_id.len) == 0 &&
-			    (slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-			     slot->state == DHCPV4_SERVER_ADDR_ALLOCATED)) {
-				selected = slot;
-				break;
-			}
+		selected = dhcpv4_server_slot_by_addr(ctx, &requested_ip);
+		if (selected != NULL &&
+		    !dhcpv4_server_slot_is_bound(selected, &client_id)) {
+			selected = NULL;
 		}
 
 		if (selected == NULL) {
@@ -1097,9 +1312,9 @@ static void dhcpv4_handle_request(struct dhcpv4_server_ctx *ctx,
 				net_sprint_ipv4_addr(&selected->addr));
 
 			selected->lease_time = lease_time;
-			selected->expiry = sys_timepoint_calc(
-							K_SECONDS(lease_time));
-			selected->state = DHCPV4_SERVER_ADDR_ALLOCATED;
+			dhcpv4_server_slot_set(ctx, selected,
+					       DHCPV4_SERVER_ADDR_ALLOCATED,
+					       sys_timepoint_calc(K_SECONDS(lease_time)));
 			dhcpv4_server_timeout_recalc(ctx);
 		}
 
@@ -1120,19 +1335,7 @@ static void dhcpv4_handle_request(struct dhcpv4_server_ctx *ctx,
 			dhcpv4_send_nak(ctx, msg, &client_id);
 		}
 
-		for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-			struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-			if (slot->client_id.len == client_id.len &&
-			    memcmp(slot->client_id.buf, client_id.buf,
-				   client_id.len) == 0 &&
-			    (slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-			     slot->state == DHCPV4_SERVER_ADDR_ALLOCATED)) {
-				selected = slot;
-				break;
-			}
-		}
-
+		selected = dhcpv4_server_find_client(ctx, &client_id);
 		if (selected != NULL) {
 			if (net_ipv4_addr_cmp(&selected->addr, &requested_ip)) {
 				uint32_t lease_time = dhcpv4_get_lease_time(
@@ -1145,8 +1348,8 @@ static void dhcpv4_handle_request(struct dhcpv4_server_ctx *ctx,
 				}
 
 				selected->lease_time = lease_time;
-				selected->expiry = sys_timepoint_calc(
-							K_SECONDS(lease_time));
+				dhcpv4_server_slot_set(ctx, selected, selected->state,
+						       sys_timepoint_calc(K_SECONDS(lease_time)));
 				dhcpv4_server_timeout_recalc(ctx);
 			} else {
 				dhcpv4_send_nak(ctx, msg, &client_id);
@@ -1168,15 +1371,7 @@ static void dhcpv4_handle_request(struct dhcpv4_server_ctx *ctx,
 		dhcpv4_send_nak(ctx, msg, &client_id);
 	}
 
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-		if (net_ipv4_addr_cmp(&slot->addr, &ciaddr)) {
-			selected = slot;
-			break;
-		}
-	}
-
+	selected = dhcpv4_server_slot_by_addr(ctx, &ciaddr);
 	if (selected != NULL) {
 		if (selected->state == DHCPV4_SERVER_ADDR_ALLOCATED &&
 		    selected->client_id.len == client_id.len &&
@@ -1191,8 +1386,8 @@ static void dhcpv4_handle_request(struct dhcpv4_server_ctx *ctx,
 			}
 
 			selected->lease_time = lease_time;
-			selected->expiry = sys_timepoint_calc(
-							K_SECONDS(lease_time));
+			dhcpv4_server_slot_set(ctx, selected, selected->state,
+					       sys_timepoint_calc(K_SECONDS(lease_time)));
 			dhcpv4_server_timeout_recalc(ctx);
 		} else {
 			dhcpv4_send_nak(ctx, msg, &client_id);
@@ -1204,6 +1399,7 @@ static void dhcpv4_handle_decline(struct dhcpv4_server_ctx *ctx,
 				  struct dhcp_msg *msg, uint8_t *options,
 				  uint8_t optlen)
 {
+	struct dhcpv4_addr_slot *slot;
 	struct dhcpv4_client_id client_id;
 	struct in_addr requested_ip, server_id;
 	int ret;
@@ -1235,21 +1431,11 @@ static void dhcpv4_handle_decline(struct dhcpv4_server_ctx *ctx,
 	LOG_ERR("Received DHCPv4 Decline for %s (address already in use)",
 		net_sprint_ipv4_addr(&requested_ip));
 
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-		if (net_ipv4_addr_cmp(&slot->addr, &requested_ip) &&
-		    slot->client_id.len == client_id.len &&
-		    memcmp(slot->client_id.buf, client_id.buf,
-				client_id.len) == 0 &&
-		    (slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-		     slot->state == DHCPV4_SERVER_ADDR_ALLOCATED)) {
-			slot->state = DHCPV4_SERVER_ADDR_DECLINED;
-			slot->expiry =
-				sys_timepoint_calc(ADDRESS_DECLINED_TIMEOUT);
-			dhcpv4_server_timeout_recalc(ctx);
-			break;
-		}
+	slot = dhcpv4_server_slot_by_addr(ctx, &requested_ip);
+	if (slot != NULL && dhcpv4_server_slot_is_bound(slot, &client_id)) {
+		dhcpv4_server_slot_set(ctx, slot, DHCPV4_SERVER_ADDR_DECLINED,
+				       sys_timepoint_calc(ADDRESS_DECLINED_TIMEOUT));
+		dhcpv4_server_timeout_recalc(ctx);
 	}
 }
 
@@ -1257,6 +1443,7 @@ static void dhcpv4_handle_release(struct dhcpv4_server_ctx *ctx,
 				  struct dhcp_msg *msg, uint8_t *options,
 				  uint8_t optlen)
 {
+	struct dhcpv4_addr_slot *slot;
 	struct dhcpv4_client_id client_id;
 	struct in_addr ciaddr, server_id;
 	int ret;
@@ -1280,23 +1467,14 @@ static void dhcpv4_handle_release(struct dhcpv4_server_ctx *ctx,
 
 	memcpy(&ciaddr, msg->ciaddr, sizeof(ciaddr));
 
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-		if (net_ipv4_addr_cmp(&slot->addr, &ciaddr) &&
-		    slot->client_id.len == client_id.len &&
-		    memcmp(slot->client_id.buf, client_id.buf,
-				client_id.len) == 0 &&
-		    (slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-		     slot->state == DHCPV4_SERVER_ADDR_ALLOCATED)) {
-			LOG_DBG("DHCPv4 processing Release - %s",
-				net_sprint_ipv4_addr(&slot->addr));
+	slot = dhcpv4_server_slot_by_addr(ctx, &ciaddr);
+	if (slot != NULL && dhcpv4_server_slot_is_bound(slot, &client_id)) {
+		LOG_DBG("DHCPv4 processing Release - %s",
+			net_sprint_ipv4_addr(&slot->addr));
 
-			slot->state = DHCPV4_SERVER_ADDR_FREE;
-			slot->expiry = sys_timepoint_calc(K_FOREVER);
-			dhcpv4_server_timeout_recalc(ctx);
-			break;
-		}
+		dhcpv4_server_slot_set(ctx, slot, DHCPV4_SERVER_ADDR_FREE,
+				       sys_timepoint_calc(K_FOREVER));
+		dhcpv4_server_timeout_recalc(ctx);
 	}
 }
 
@@ -1321,26 +1499,27 @@ static void dhcpv4_server_timeout(struct k_work *work)
 
 	k_mutex_lock(&server_lock, K_FOREVER);
 
-	for (int i = 0; i < ARRAY_SIZE(ctx->addr_pool); i++) {
-		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[i];
-
-		if ((slot->state == DHCPV4_SERVER_ADDR_RESERVED ||
-		     slot->state == DHCPV4_SERVER_ADDR_ALLOCATED) &&
-		     sys_timepoint_expired(slot->expiry)) {
-			if (slot->state == DHCPV4_SERVER_ADDR_RESERVED &&
-			    dhcpv4_server_is_slot_probed(ctx, slot)) {
-				dhcpv4_server_probe_timeout(ctx, slot);
-			} else {
-				LOG_DBG("Address %s expired",
-					net_sprint_ipv4_addr(&slot->addr));
-				slot->state = DHCPV4_SERVER_ADDR_FREE;
-			}
+	/* Only the expired slots are looked at, from the top of the heap. */
+	while (ctx->index.heap_len > 0) {
+		struct dhcpv4_addr_slot *slot = &ctx->addr_pool[ctx->index.heap[0]];
+
+		if (!sys_timepoint_expired(slot->expiry)) {
+			break;
 		}
 
-		if (slot->state == DHCPV4_SERVER_ADDR_DECLINED &&
-		    sys_timepoint_expired(slot->expiry)) {
-			slot->state = DHCPV4_SERVER_ADDR_FREE;
+		if (slot->state == DHCPV4_SERVER_ADDR_RESERVED &&
+		    dhcpv4_server_is_slot_probed(ctx, slot)) {
+			dhcpv4_server_probe_timeout(ctx, slot);
+			continue;
 		}
+
+		if (slot->state != DHCPV4_SERVER_ADDR_DECLINED) {
+			LOG_DBG("Address %s expired",
+				net_sprint_ipv4_addr(&slot->addr));
+		}
+
+		dhcpv4_server_slot_set(ctx, slot, DHCPV4_SERVER_ADDR_FREE,
+				       sys_timepoint_calc(K_FOREVER));
 	}
 
 	dhcpv4_server_timeout_recalc(ctx);
@@ -1565,6 +1744,8 @@ int net_dhcpv4_server_start(struct net_if *iface, struct in_addr *base_addr)
 	k_work_init_delayable(&server_ctx[slot].timeout_work,
 			      dhcpv4_server_timeout);
 
+	dhcpv4_server_index_init(&server_ctx[slot]);
+
 	LOG_DBG("Started DHCPv4 server, address pool:");
 	for (int i = 0; i < ARRAY_SIZE(server_ctx[slot].addr_pool); i++) {
 		server_ctx[slot].addr_pool[i].state = DHCPV4_SERVER_ADDR_FREE;
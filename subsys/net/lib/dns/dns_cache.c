@@ -5,18 +5,61 @@
  */
 
 #include <zephyr/net/dns_resolve.h>
+#include <zephyr/sys/crc.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static void dns_cache_clean(struct dns_cache *cache);
+
+static inline uint16_t dns_cache_hash(const char *query)
+{
+	return crc16_ansi(query, strlen(query));
+}
+
+static inline uint16_t *dns_cache_bucket(struct dns_cache const *cache, uint16_t hash)
+{
+	return &cache->buckets[hash % cache->size];
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_unlink(struct dns_cache *cache, size_t index)
+{
+	uint16_t *link = dns_cache_bucket(cache, cache->entries[index].hash);
+
+	while (*link != index + 1) {
+		link = &cache->entries[*link - 1].next;
+	}
+
+	*link = cache->entries[index].next;
+	cache->entries[index].in_use = false;
+}
+
+/* Needs to be called when lock is already acquired. The entry is appended to
+ * its bucket so that the addresses of a query are found in the order they
+ * were added.
+ */
+static void dns_cache_link(struct dns_cache *cache, size_t index)
+{
+	uint16_t *link = dns_cache_bucket(cache, cache->entries[index].hash);
+
+	while (*link != 0) {
+		link = &cache->entries[*link - 1].next;
+	}
+
+	*link = index + 1;
+	cache->entries[index].next = 0;
+	cache->entries[index].in_use = true;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		cache->buckets[i] = 0;
 	}
+	cache->next_expiry = sys_timepoint_calc(K_FOREVER);
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -59,13 +102,19 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 	if (!found_empty) {
 		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+		dns_cache_unlink(cache, index_to_replace);
 	}
 
 	strncpy(cache->entries[index_to_replace].query, query,
 		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
 	cache->entries[index_to_replace].data = *addrinfo;
 	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	cache->entries[index_to_replace].hash = dns_cache_hash(query);
+	dns_cache_link(cache, index_to_replace);
+
+	if (sys_timepoint_cmp(cache->next_expiry, cache->entries[index_to_replace].expiry) > 0) {
+		cache->next_expiry = cache->entries[index_to_replace].expiry;
+	}
 
 	k_mutex_unlock(cache->lock);
 
@@ -74,6 +123,9 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	uint16_t hash;
+	uint16_t next;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
 		NET_WARN("Query string to big to be processed %u >= "
@@ -82,13 +134,19 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	for (uint16_t i = *dns_cache_bucket(cache, hash); i != 0; i = next) {
+		struct dns_cache_entry *entry = &cache->entries[i - 1];
+
+		next = entry->next;
+
+		if (entry->hash == hash && strcmp(entry->query, query) == 0) {
+			dns_cache_unlink(cache, i - 1);
 		}
 	}
 
@@ -101,6 +159,7 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		   size_t addrinfo_array_len)
 {
 	size_t found = 0;
+	uint16_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -113,22 +172,23 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	dns_cache_clean((struct dns_cache *)cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+	for (uint16_t i = *dns_cache_bucket(cache, hash); i != 0; i = cache->entries[i - 1].next) {
+		const struct dns_cache_entry *entry = &cache->entries[i - 1];
+
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -146,9 +206,17 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+/* Needs to be called when lock is already acquired. The entries are only
+ * scanned once the earliest expiry has passed.
+ */
+static void dns_cache_clean(struct dns_cache *cache)
 {
+	if (!sys_timepoint_expired(cache->next_expiry)) {
+		return;
+	}
+
+	cache->next_expiry = sys_timepoint_calc(K_FOREVER);
+
 	for (size_t i = 0; i < cache->size; i++) {
 		if (!cache->entries[i].in_use) {
 			continue;
@@ -156,7 +224,83 @@ static void dns_cache_clean(struct dns_cache const *cache)
 
 		if (sys_timepoint_expired(cache->entries[i].expiry)) {
 			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+			dns_cache_unlink(cache, i);
+		} else if (sys_timepoint_cmp(cache->next_expiry, cache->entries[i].expiry) > 0) {
+			cache->next_expiry = cache->entries[i].expiry;
+		}
+	}
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PERSIST)
+/* Stored layout of an entry, the query is saved up to its terminating 0 */
+struct dns_cache_record {
+	uint32_t ttl;
+	struct dns_addrinfo data;
+	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+};
+
+int dns_cache_save(struct dns_cache *cache, const char *subtree)
+{
+	struct dns_cache_record record;
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+	int ret = 0;
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	dns_cache_clean(cache);
+
+	for (size_t i = 0; i < cache->size && ret == 0; i++) {
+		const struct dns_cache_entry *entry = &cache->entries[i];
+		uint64_t ttl;
+
+		snprintk(name, sizeof(name), "%s/%zu", subtree, i);
+
+		if (!entry->in_use) {
+			ret = settings_delete(name);
+			continue;
+		}
+
+		ttl = k_ticks_to_sec_floor64(sys_timepoint_timeout(entry->expiry).ticks);
+		if (ttl == 0) {
+			ret = settings_delete(name);
+			continue;
 		}
+
+		record.ttl = (uint32_t)ttl;
+		record.data = entry->data;
+		strcpy(record.query, entry->query);
+
+		ret = settings_save_one(name, &record,
+					offsetof(struct dns_cache_record, query) +
+					strlen(record.query) + 1);
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	return ret;
+}
+
+int dns_cache_load(struct dns_cache *cache, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	struct dns_cache_record record;
+	ssize_t ret;
+
+	if (len <= offsetof(struct dns_cache_record, query) || len > sizeof(record)) {
+		return -EINVAL;
+	}
+
+	ret = read_cb(cb_arg, &record, len);
+	if (ret != len) {
+		return ret < 0 ? ret : -EINVAL;
 	}
+
+	if (record.query[len - offsetof(struct dns_cache_record, query) - 1] != '\0') {
+		return -EINVAL;
+	}
+
+	/* The time spent powered off is not known, the entry lives for the
+	 * remaining time to live it had when stored.
+	 */
+	return dns_cache_add(cache, record.query, &record.data, record.ttl);
 }
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PERSIST */
@@ -18,16 +18,28 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PERSIST)
+#include <zephyr/settings/settings.h>
+#endif
+
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Hash of the query */
+	uint16_t hash;
+	/* Index + 1 of the next entry in the same bucket, 0 ends the chain */
+	uint16_t next;
 	bool in_use;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Index + 1 of the first entry of each of the size buckets */
+	uint16_t *buckets;
+	/* Earliest expiry of the cached entries */
+	k_timepoint_t next_expiry;
 	struct k_mutex *lock;
 };
 
@@ -43,8 +55,11 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
-	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+	static uint16_t name##_buckets[cache_size];                                                \
+	static struct dns_cache name = {.entries = name##_entries,                                 \
+					.buckets = name##_buckets,                                 \
+					.size = cache_size,                                        \
+					.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -97,4 +112,31 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
 int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PERSIST)
+/**
+ * @brief Stores the entries of the dns cache with their remaining time to
+ * live in the settings.
+ *
+ * @param cache Cache to be stored.
+ * @param subtree Settings subtree the entries are stored under.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_save(struct dns_cache *cache, const char *subtree);
+
+/**
+ * @brief Adds an entry stored by dns_cache_save() back to the dns cache.
+ *
+ * To be called from the settings set handler of the subtree.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param len Length of the settings value.
+ * @param read_cb Settings read callback.
+ * @param cb_arg Settings read callback argument.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_load(struct dns_cache *cache, size_t len, settings_read_cb read_cb, void *cb_arg);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PERSIST */
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
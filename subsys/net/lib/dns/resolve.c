@@ -79,6 +79,35 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR, CONFIG_DNS_RESOLVER_MA
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PERSIST
+#define DNS_CACHE_SETTINGS_SUBTREE "dns_cache"
+
+static void dns_cache_save_handler(struct k_work *work)
+{
+	int ret;
+
+	ARG_UNUSED(work);
+
+	ret = dns_cache_save(&dns_cache, DNS_CACHE_SETTINGS_SUBTREE);
+	if (ret < 0) {
+		NET_DBG("Cannot store DNS cache (%d)", ret);
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(dns_cache_save_work, dns_cache_save_handler);
+
+static int dns_cache_settings_set(const char *name, size_t len,
+				  settings_read_cb read_cb, void *cb_arg)
+{
+	ARG_UNUSED(name);
+
+	return dns_cache_load(&dns_cache, len, read_cb, cb_arg);
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(dns_cache, DNS_CACHE_SETTINGS_SUBTREE, NULL,
+			       dns_cache_settings_set, NULL, NULL);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PERSIST */
+
 static struct dns_resolve_context dns_default_ctx;
 
 /* Must be invoked with context lock held */
@@ -659,6 +688,10 @@ query_known:
 			dns_cache_add(&dns_cache,
 				ctx->queries[*query_idx].query, &info, ttl);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PERSIST
+			k_work_schedule(&dns_cache_save_work,
+					K_SECONDS(CONFIG_DNS_RESOLVER_CACHE_PERSIST_DELAY));
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PERSIST */
 			items++;
 			break;
 
@@ -842,6 +875,7 @@ static int recv_data(struct net_socket_service_event *pev)
 	/* Query again if we got CNAME */
 	if (ret == DNS_EAI_AGAIN) {
 		int failure = 0;
+		int sent = 0;
 		int j;
 
 		i = get_slot_by_id(ctx, dns_id, query_hash);
@@ -859,9 +893,17 @@ static int recv_data(struct net_socket_service_event *pev)
 					dns_cname, 0);
 			if (ret < 0) {
 				failure++;
+			} else {
+				sent++;
 			}
 		}
 
+#if defined(CONFIG_DNS_RESOLVER_QUERY_ALL_SERVERS)
+		ctx->queries[i].pending_servers = sent;
+#else
+		ARG_UNUSED(sent);
+#endif
+
 		if (failure) {
 			NET_DBG("DNS cname query failed %d times", failure);
 
@@ -880,6 +922,14 @@ quit:
 		goto free_buf;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_QUERY_ALL_SERVERS)
+	/* Another server may still answer with the addresses. */
+	if (ctx->queries[i].pending_servers > 1) {
+		ctx->queries[i].pending_servers--;
+		goto free_buf;
+	}
+#endif
+
 	invoke_query_callback(ret, NULL, &ctx->queries[i]);
 
 	/* Marks the end of the results */
@@ -1200,6 +1250,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	struct sockaddr addr;
 	int ret, i = -1, j = 0;
 	int failure = 0;
+	int sent = 0;
 	bool mdns_query = false;
 	uint8_t hop_limit;
 #ifdef CONFIG_DNS_RESOLVER_CACHE
@@ -1267,7 +1318,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, sizeof(cached_info));
+	ret = dns_cache_find(&dns_cache, query, cached_info, ARRAY_SIZE(cached_info));
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
@@ -1301,6 +1352,9 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+#if defined(CONFIG_DNS_RESOLVER_QUERY_ALL_SERVERS)
+	ctx->queries[i].pending_servers = 0;
+#endif
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
@@ -1383,17 +1437,24 @@ try_resolve:
 			continue;
 		}
 
+		sent++;
+
+#if defined(CONFIG_DNS_RESOLVER_QUERY_ALL_SERVERS)
+		/* The first address answer completes the query. */
+		ctx->queries[i].pending_servers++;
+#else
 		/* Do one concurrent query only for each name resolve.
 		 * TODO: Change the i (query index) to do multiple concurrent
 		 *       to each server.
 		 */
 		break;
+#endif
 	}
 
 	if (failure) {
 		NET_DBG("DNS query failed %d times", failure);
 
-		if (failure == j) {
+		if (failure == j || sent == 0) {
 			ret = -ENOENT;
 			goto quit;
 		}
@@ -40,7 +40,12 @@ struct http_resource_detail *get_resource_detail(const char *path, int *len, boo
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
 void http_client_timer_restart(struct http_client_ctx *client);
 
+/* HTTP2 stream scheduler */
+bool http2_has_scheduled_data(const struct http_client_ctx *client);
+int http2_send_scheduled_data(struct http_client_ctx *client);
+
 /* TODO Could be static, but currently used in tests. */
+struct http_stream_ctx *http2_next_scheduled_stream(struct http_client_ctx *client);
 int parse_http_frame_header(struct http_client_ctx *client);
 const char *get_frame_type_name(enum http_frame_type type);
 
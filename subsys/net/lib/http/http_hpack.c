@@ -101,40 +101,239 @@ const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
 	return &http_hpack_table_static[key];
 }
 
+#define HPACK_STATIC_HASH_SIZE 64
+
+/* FNV-1a hash of a header field name. */
+static uint32_t hpack_name_hash(const char *name, size_t name_len)
+{
+	uint32_t hash = 0x811c9dc5;
+
+	for (size_t i = 0; i < name_len; i++) {
+		hash ^= (uint8_t)name[i];
+		hash *= 0x01000193;
+	}
+
+	return hash;
+}
+
+/* First static table index of every distinct name, hashed with
+ * hpack_name_hash(), and the next index in the same bucket.
+ */
+static const uint8_t http_hpack_static_hash[HPACK_STATIC_HASH_SIZE] = {
+	34,  0, 61, 36,  0, 59,  0,  0,  2,  0, 30,  0,
+	57, 24,  0,  0,  0,  0, 50, 27,  0, 31, 17,  8,
+	35, 16,  0,  0, 21, 28,  1,  0,  0, 56,  0,  0,
+	 0,  0, 18,  0, 15, 19,  6, 44, 20,  0,  4, 38,
+	 0,  0, 22,  0, 52, 37, 53, 41, 55,  0,  0, 49,
+	 0,  0, 23, 32,
+};
+
+static const uint8_t http_hpack_static_hash_next[] = {
+	 0,  0, 26,  0, 29,  0, 39,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0, 33, 47, 46, 40,  0, 25,  0, 42,
+	 0,  0,  0, 60,  0, 58, 43,  0,  0,  0,  0,  0,
+	 0,  0, 48,  0, 45,  0,  0,  0,  0,  0, 51,  0,
+	 0,  0, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,
+};
+
+BUILD_ASSERT(ARRAY_SIZE(http_hpack_static_hash_next) == ARRAY_SIZE(http_hpack_table_static));
+
 static int http_hpack_find_index(struct http_hpack_header_buf *header,
 				 bool *name_only)
 {
 	const struct hpack_table_entry *entry;
-	int candidate = -1;
+	uint32_t hash = hpack_name_hash(header->name, header->name_len);
+	int i = http_hpack_static_hash[hash & (HPACK_STATIC_HASH_SIZE - 1)];
 
-	for (int i = HTTP_SERVER_HPACK_AUTHORITY;
-	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
+	for (; i != 0; i = http_hpack_static_hash_next[i]) {
 		entry = &http_hpack_table_static[i];
 
-		if (entry->name != NULL &&
-		    strlen(entry->name) == header->name_len &&
+		if (strlen(entry->name) == header->name_len &&
 		    memcmp(entry->name, header->name, header->name_len) == 0) {
-			if (entry->value != NULL &&
-			    strlen(entry->value) == header->value_len &&
-			    memcmp(entry->value, header->value, header->value_len) == 0) {
-				/* Got exact match. */
-				*name_only = false;
-				return i;
-			}
-
-			if (candidate < 0) {
-				candidate = i;
-			}
+			break;
+		}
+	}
+
+	if (i == 0) {
+		return -ENOENT;
+	}
+
+	/* Entries with the same name are adjacent in the static table. */
+	for (int j = i; j <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; j++) {
+		entry = &http_hpack_table_static[j];
+
+		if (strcmp(entry->name, http_hpack_table_static[i].name) != 0) {
+			break;
+		}
+
+		if (entry->value != NULL &&
+		    strlen(entry->value) == header->value_len &&
+		    memcmp(entry->value, header->value, header->value_len) == 0) {
+			/* Got exact match. */
+			*name_only = false;
+			return j;
 		}
 	}
 
-	if (candidate > 0) {
-		/* Matched name only. */
-		*name_only = true;
-		return candidate;
+	/* Matched name only. */
+	*name_only = true;
+
+	return i;
+}
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+/* Evict the oldest entries until the table size fits in max_size. */
+static void hpack_dynamic_evict(struct http_hpack_dynamic_table *table,
+				uint32_t max_size)
+{
+	struct http_hpack_dynamic_entry *entry;
+	uint16_t data_len = 0;
+	uint16_t count = 0;
+
+	while (table->size > max_size) {
+		entry = &table->entries[count++];
+		data_len += entry->name_len + entry->value_len;
+		table->size -= entry->name_len + entry->value_len +
+			       HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD;
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	table->count -= count;
+	table->data_len -= data_len;
+
+	memmove(table->data, table->data + data_len, table->data_len);
+	memmove(table->entries, table->entries + count,
+		table->count * sizeof(table->entries[0]));
+
+	for (int i = 0; i < table->count; i++) {
+		table->entries[i].offset -= data_len;
 	}
+}
 
-	return -ENOENT;
+static void hpack_dynamic_set_max_size(struct http_hpack_dynamic_table *table,
+				       uint32_t max_size)
+{
+	table->max_size = max_size;
+	hpack_dynamic_evict(table, max_size);
+}
+
+static void hpack_dynamic_add(struct http_hpack_dynamic_table *table,
+			      const char *name, size_t name_len,
+			      const char *value, size_t value_len)
+{
+	struct http_hpack_dynamic_entry *entry;
+	uint32_t size = name_len + value_len + HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD;
+
+	/* An entry larger than the table empties it, RFC7541 ch 4.4. */
+	if (size > table->max_size) {
+		hpack_dynamic_evict(table, 0);
+		return;
+	}
+
+	hpack_dynamic_evict(table, table->max_size - size);
+
+	entry = &table->entries[table->count++];
+	entry->offset = table->data_len;
+	entry->name_len = name_len;
+	entry->value_len = value_len;
+	entry->hash = (uint16_t)hpack_name_hash(name, name_len);
+
+	memcpy(table->data + table->data_len, name, name_len);
+	memcpy(table->data + table->data_len + name_len, value, value_len);
+
+	table->data_len += name_len + value_len;
+	table->size += size;
+}
+
+/* Get the entry at the given index, counted from the newest entry on. */
+static struct http_hpack_dynamic_entry *hpack_dynamic_get(
+	struct http_hpack_dynamic_table *table, uint32_t index)
+{
+	if (index == 0 || index > table->count) {
+		return NULL;
+	}
+
+	return &table->entries[table->count - index];
+}
+
+static int hpack_dynamic_find_index(struct http_hpack_dynamic_table *table,
+				    struct http_hpack_header_buf *header,
+				    bool *name_only)
+{
+	uint16_t hash = (uint16_t)hpack_name_hash(header->name, header->name_len);
+	int candidate = -ENOENT;
+
+	/* Start with the newest entries, they have the smallest indexes. */
+	for (int i = table->count - 1; i >= 0; i--) {
+		struct http_hpack_dynamic_entry *entry = &table->entries[i];
+		const uint8_t *data = table->data + entry->offset;
+		int index = HTTP_SERVER_HPACK_WWW_AUTHENTICATE + table->count - i;
+
+		if (entry->hash != hash || entry->name_len != header->name_len ||
+		    memcmp(data, header->name, header->name_len) != 0) {
+			continue;
+		}
+
+		if (entry->value_len == header->value_len &&
+		    memcmp(data + entry->name_len, header->value,
+			   header->value_len) == 0) {
+			*name_only = false;
+			return index;
+		}
+
+		if (candidate < 0) {
+			candidate = index;
+		}
+	}
+
+	*name_only = true;
+
+	return candidate;
+}
+#endif /* HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0 */
+
+void http_hpack_init_dynamic_tables(struct http_hpack_header_buf *header)
+{
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	memset(&header->decoder_table, 0, sizeof(header->decoder_table));
+	memset(&header->encoder_table, 0, sizeof(header->encoder_table));
+
+	/* The peer is told the table size in the SETTINGS frame. */
+	header->decoder_table.limit = HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE;
+	header->decoder_table.max_size = HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE;
+
+	/* The peer decoder starts with the default size, a smaller table is
+	 * signaled at the beginning of the first header block.
+	 */
+	http_hpack_set_peer_table_size(header, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	header->encoder_table.size_update =
+		header->encoder_table.max_size != HTTP_HPACK_DEFAULT_TABLE_SIZE;
+#else
+	ARG_UNUSED(header);
+#endif
+}
+
+void http_hpack_set_peer_table_size(struct http_hpack_header_buf *header,
+				    uint32_t size)
+{
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	struct http_hpack_dynamic_table *table = &header->encoder_table;
+	uint32_t max_size = MIN(size, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+
+	table->limit = size;
+
+	if (table->max_size != max_size) {
+		hpack_dynamic_set_max_size(table, max_size);
+		table->size_update = true;
+	}
+#else
+	ARG_UNUSED(header);
+	ARG_UNUSED(size);
+#endif
 }
 
 #define HPACK_INTEGER_CONTINUATION_FLAG            0x80
@@ -303,6 +502,26 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	if (http_hpack_key_is_dynamic(index)) {
+		struct http_hpack_dynamic_table *table = &header->decoder_table;
+		struct http_hpack_dynamic_entry *dentry;
+
+		dentry = hpack_dynamic_get(table,
+					   index - HTTP_SERVER_HPACK_WWW_AUTHENTICATE);
+		if (dentry == NULL) {
+			return -EBADMSG;
+		}
+
+		header->name = (const char *)table->data + dentry->offset;
+		header->name_len = dentry->name_len;
+		header->value = header->name + dentry->name_len;
+		header->value_len = dentry->value_len;
+
+		return ret;
+	}
+#endif
+
 	entry = http_hpack_table_get(index);
 	if (entry == NULL) {
 		return -EBADMSG;
@@ -349,6 +568,21 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		len += ret;
 		buf += ret;
 		datalen -= ret;
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	} else if (http_hpack_key_is_dynamic(index)) {
+		/* Indexed name from the dynamic table. */
+		struct http_hpack_dynamic_table *table = &header->decoder_table;
+		struct http_hpack_dynamic_entry *entry;
+
+		entry = hpack_dynamic_get(table,
+					  index - HTTP_SERVER_HPACK_WWW_AUTHENTICATE);
+		if (entry == NULL) {
+			return -EBADMSG;
+		}
+
+		header->name = (const char *)table->data + entry->offset;
+		header->name_len = entry->name_len;
+#endif
 	} else {
 		/* Indexed name. */
 		const struct hpack_table_entry *entry;
@@ -379,10 +613,39 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
 			       struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	struct http_hpack_dynamic_table *table = &header->decoder_table;
+	const uint8_t *name;
+#endif
+	int ret;
 
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	ret = hpack_handle_literal(buf, datalen, header,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	if (ret < 0) {
+		return ret;
+	}
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	name = (const uint8_t *)header->name;
+
+	/* The entry the name is taken from may be evicted by the insertion,
+	 * move the name out of the table first.
+	 */
+	if (name >= table->data && name < table->data + sizeof(table->data)) {
+		if (header->name_len > sizeof(header->buf) - header->datalen) {
+			return -ENOBUFS;
+		}
+
+		memcpy(header->buf + header->datalen, name, header->name_len);
+		header->name = (const char *)header->buf + header->datalen;
+		header->datalen += header->name_len;
+	}
+
+	hpack_dynamic_add(table, header->name, header->name_len,
+			  header->value, header->value_len);
+#endif
+
+	return ret;
 }
 
 static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
@@ -392,7 +655,8 @@ static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
 				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen,
+					    struct http_hpack_header_buf *header)
 {
 	uint32_t max_size;
 	int ret;
@@ -403,7 +667,17 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	if (max_size > header->decoder_table.limit) {
+		return -EBADMSG;
+	}
+
+	hpack_dynamic_set_max_size(&header->decoder_table, max_size);
+#else
+	if (max_size > 0) {
+		return -EBADMSG;
+	}
+#endif
 
 	return ret;
 }
@@ -434,7 +708,7 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 		ret = hpack_handle_literal_no_index(buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(buf, datalen, header);
 	} else {
 		ret = -EINVAL;
 	}
@@ -468,7 +742,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -532,23 +806,13 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				uint8_t prefix, uint8_t prefix_len,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
-	}
-
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -557,32 +821,18 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
-	if (ret < 0) {
-		return ret;
-	}
-
-	len += ret;
-
-	return len;
-}
-
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
-{
-	int ret, len = 0;
+	if (index == 0) {
+		/* Literal name. */
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
 		return ret;
@@ -602,6 +852,11 @@ static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header)
 {
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	struct http_hpack_dynamic_table *table = &header->encoder_table;
+	bool dynamic_name_only;
+	int dynamic;
+#endif
 	int ret, len = 0;
 	bool name_only;
 
@@ -615,17 +870,69 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	/* Header fields are encoded in sequence, the pending update lands at
+	 * the beginning of the next header block.
+	 */
+	if (table->size_update) {
+		ret = hpack_integer_encode(buf, buflen, table->max_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		table->size_update = false;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+#endif
+
 	ret = http_hpack_find_index(header, &name_only);
-	if (ret < 0) {
-		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
-	} else if (name_only) {
-		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
-	} else {
+	if (ret > 0 && !name_only) {
 		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		ret = hpack_encode_indexed(buf, buflen, ret);
+		return ret < 0 ? ret : len + ret;
+	}
+
+#if HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0
+	dynamic = hpack_dynamic_find_index(table, header, &dynamic_name_only);
+	if (dynamic > 0 && !dynamic_name_only) {
+		/* Indexed from the dynamic table */
+		ret = hpack_encode_indexed(buf, buflen, dynamic);
+		return ret < 0 ? ret : len + ret;
+	}
+
+	if (header->name_len + header->value_len +
+	    HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD <= table->max_size) {
+		/* Literal with incremental indexing, prefer the static name. */
+		ret = hpack_encode_literal(buf, buflen,
+					   ret > 0 ? ret : MAX(dynamic, 0),
+					   HPACK_PREFIX_LITERAL_INDEXING,
+					   HPACK_PREFIX_LEN_LITERAL_INDEXING,
+					   header);
+		if (ret < 0) {
+			return ret;
+		}
+
+		hpack_dynamic_add(table, header->name, header->name_len,
+				  header->value, header->value_len);
+
+		return len + ret;
 	}
+#endif
+
+	/* Literal, with indexed name if found */
+	ret = hpack_encode_literal(buf, buflen, MAX(ret, 0),
+				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+				   header);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
 
 	return len;
 }
@@ -353,9 +353,14 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	client->has_upgrade_header = false;
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	client->tx_window = HTTP_SERVER_PEER_INITIAL_WINDOW_SIZE;
+	client->tx_initial_window = HTTP_SERVER_PEER_INITIAL_WINDOW_SIZE;
+#endif
 
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
+	http_hpack_init_dynamic_tables(&client->header_field);
 	k_work_init_delayable(&client->inactivity_timer, client_timeout);
 	http_client_timer_restart(client);
 
@@ -461,6 +466,22 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+/* Poll for writability while scheduled HTTP/2 data can be sent. */
+static void update_client_events(struct zsock_pollfd *fd,
+				 struct http_client_ctx *client)
+{
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	if (fd->fd == INVALID_SOCK || fd->fd != client->fd) {
+		return;
+	}
+
+	fd->events = ZSOCK_POLLIN;
+	if (http2_has_scheduled_data(client)) {
+		fd->events |= ZSOCK_POLLOUT;
+	}
+#endif
+}
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
@@ -526,6 +547,24 @@ static int http_server_run(struct http_server_ctx *ctx)
 
 			}
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+			if (i >= ctx->listen_fds && (ctx->fds[i].revents & ZSOCK_POLLOUT)) {
+				/* One DATA frame per round, so that requests
+				 * arriving meanwhile are not delayed.
+				 */
+				client = &ctx->clients[i - ctx->listen_fds];
+
+				ret = http2_send_scheduled_data(client);
+				if (ret < 0) {
+					LOG_DBG("Cannot send scheduled data (%d)", ret);
+					close_client_connection(client);
+					continue;
+				}
+
+				update_client_events(&ctx->fds[i], client);
+			}
+#endif
+
 			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
 				continue;
 			}
@@ -605,6 +644,8 @@ static int http_server_run(struct http_server_ctx *ctx)
 				 */
 				LOG_ERR("RX buffer too small to handle request");
 				close_client_connection(client);
+			} else {
+				update_client_events(&ctx->fds[i], client);
 			}
 		}
 	}
@@ -97,6 +97,13 @@ static struct http_stream_ctx *allocate_http_stream_context(
 			client->streams[i].stream_state = HTTP_SERVER_STREAM_OPEN;
 			client->streams[i].window_size =
 				HTTP_SERVER_INITIAL_WINDOW_SIZE;
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+			client->streams[i].tx_data = NULL;
+			client->streams[i].tx_len = 0;
+			client->streams[i].tx_window = client->tx_initial_window;
+			client->streams[i].tx_credit = 0;
+			client->streams[i].weight = HTTP_SERVER_DEFAULT_STREAM_WEIGHT;
+#endif
 			return &client->streams[i];
 		}
 	}
@@ -111,11 +118,25 @@ static void release_http_stream_context(struct http_client_ctx *client,
 		if (client->streams[i].stream_id == stream_id) {
 			client->streams[i].stream_id = 0;
 			client->streams[i].stream_state = HTTP_SERVER_STREAM_IDLE;
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+			client->streams[i].tx_data = NULL;
+#endif
 			break;
 		}
 	}
 }
 
+static bool stream_tx_pending(struct http_client_ctx *client, uint32_t stream_id)
+{
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	struct http_stream_ctx *stream = find_http_stream_context(client, stream_id);
+
+	return stream != NULL && stream->tx_data != NULL;
+#else
+	return false;
+#endif
+}
+
 static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 			    size_t *buflen, const char *name, const char *value)
 {
@@ -227,6 +248,110 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 	return ret;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+static bool stream_can_send(const struct http_client_ctx *client,
+			    const struct http_stream_ctx *stream)
+{
+	if (stream->stream_state == HTTP_SERVER_STREAM_IDLE ||
+	    stream->tx_data == NULL) {
+		return false;
+	}
+
+	/* An empty DATA frame is not subject to flow control. */
+	return stream->tx_len == 0 ||
+	       (stream->tx_window > 0 && client->tx_window > 0);
+}
+
+bool http2_has_scheduled_data(const struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH(client->streams, i) {
+		if (stream_can_send(client, &client->streams[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Smooth weighted round robin: every ready stream earns its weight, the
+ * richest one sends and pays the weights of all ready streams.
+ */
+struct http_stream_ctx *http2_next_scheduled_stream(struct http_client_ctx *client)
+{
+	struct http_stream_ctx *next = NULL;
+	int total = 0;
+
+	ARRAY_FOR_EACH(client->streams, i) {
+		struct http_stream_ctx *stream = &client->streams[i];
+
+		if (!stream_can_send(client, stream)) {
+			continue;
+		}
+
+		stream->tx_credit += stream->weight + 1;
+		total += stream->weight + 1;
+
+		if (next == NULL || stream->tx_credit > next->tx_credit) {
+			next = stream;
+		}
+	}
+
+	if (next != NULL) {
+		next->tx_credit -= total;
+	}
+
+	return next;
+}
+
+int http2_send_scheduled_data(struct http_client_ctx *client)
+{
+	struct http_stream_ctx *stream;
+	uint8_t flags = 0;
+	size_t len;
+	int ret;
+
+	stream = http2_next_scheduled_stream(client);
+	if (stream == NULL) {
+		return 0;
+	}
+
+	len = MIN(stream->tx_len, CONFIG_HTTP_SERVER_STREAM_SCHEDULER_FRAME_SIZE);
+	len = MIN(len, MIN(stream->tx_window, client->tx_window));
+	if (len == stream->tx_len) {
+		flags = HTTP_SERVER_FLAG_END_STREAM;
+	}
+
+	/* The body is sent in place from the resource, e.g. from flash. */
+	ret = send_data_frame(client, stream->tx_data, len, stream->stream_id,
+			      flags);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stream->tx_data += len;
+	stream->tx_len -= len;
+	stream->tx_window -= len;
+	client->tx_window -= len;
+
+	if (end_stream_flag(flags)) {
+		release_http_stream_context(client, stream->stream_id);
+	}
+
+	return 0;
+}
+
+static int flush_scheduled_data(struct http_client_ctx *client)
+{
+	int ret = 0;
+
+	while (ret == 0 && http2_has_scheduled_data(client)) {
+		ret = http2_send_scheduled_data(client);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_STREAM_SCHEDULER */
+
 int send_settings_frame(struct http_client_ctx *client, bool ack)
 {
 	uint8_t settings_frame[HTTP_SERVER_FRAME_HEADER_SIZE +
@@ -249,7 +374,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP_SERVER_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP_SETTINGS_HEADER_TABLE_SIZE),
 			      &setting->id);
-		UNALIGNED_PUT(0, &setting->value);
+		UNALIGNED_PUT(htonl(HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE),
+			      &setting->value);
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -364,6 +490,20 @@ static int handle_http2_static_resource(
 		goto out;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	struct http_stream_ctx *stream =
+		find_http_stream_context(client, frame->stream_identifier);
+
+	/* Leave the body to the scheduler, unless there's no stream context
+	 * as for the request preceding an HTTP/1.1 upgrade.
+	 */
+	if (stream != NULL) {
+		stream->tx_data = content_200;
+		stream->tx_len = content_len;
+		goto out;
+	}
+#endif
+
 	ret = send_data_frame(client, content_200, content_len,
 			      frame->stream_identifier,
 			      HTTP_SERVER_FLAG_END_STREAM);
@@ -1053,7 +1193,8 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		}
 	}
 
-	if (end_stream_flag(frame->flags)) {
+	if (end_stream_flag(frame->flags) &&
+	    !stream_tx_pending(client, frame->stream_identifier)) {
 		release_http_stream_context(client, frame->stream_identifier);
 	}
 
@@ -1075,6 +1216,16 @@ int handle_http_frame_priority(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	struct http_stream_ctx *stream =
+		find_http_stream_context(client, frame->stream_identifier);
+
+	/* Stream dependency is not tracked, only the weight is used. */
+	if (stream != NULL && frame->length == HTTP_SERVER_PRIORITY_PAYLOAD_SIZE) {
+		stream->weight = client->cursor[HTTP_SERVER_PRIORITY_WEIGHT_OFFSET];
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1097,6 +1248,11 @@ int handle_http_frame_rst_frame(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)) {
+		/* Drop the response queued on the stream. */
+		release_http_stream_context(client, frame->stream_identifier);
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1123,6 +1279,37 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
+	if (!settings_ack_flag(frame->flags)) {
+		const uint8_t *field = client->cursor - bytes_consumed;
+
+		for (int i = 0; i + sizeof(struct http_settings_field) <= frame->length;
+		     i += sizeof(struct http_settings_field)) {
+			uint32_t value = sys_get_be32(&field[i + sizeof(uint16_t)]);
+
+			switch (sys_get_be16(&field[i])) {
+			case HTTP_SETTINGS_HEADER_TABLE_SIZE:
+				http_hpack_set_peer_table_size(&client->header_field,
+							       value);
+				break;
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+			case HTTP_SETTINGS_INITIAL_WINDOW_SIZE: {
+				int delta = (int)value - client->tx_initial_window;
+
+				/* Applies to the windows of all open streams. */
+				client->tx_initial_window += delta;
+
+				ARRAY_FOR_EACH(client->streams, j) {
+					client->streams[j].tx_window += delta;
+				}
+				break;
+			}
+#endif
+			default:
+				break;
+			}
+		}
+	}
+
 	if (!settings_ack_flag(frame->flags)) {
 		int ret;
 
@@ -1155,6 +1342,11 @@ int handle_http_frame_goaway(struct http_client_ctx *client)
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	/* Complete the responses already started before closing. */
+	(void)flush_scheduled_data(client);
+#endif
+
 	enter_http_done_state(client);
 
 	return 0;
@@ -1169,12 +1361,27 @@ int handle_http_frame_window_update(struct http_client_ctx *client)
 
 	print_http_frames(client);
 
-	/* TODO Implement flow control, for now just ignore. */
-
 	if (client->data_len < frame->length) {
 		return -EAGAIN;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STREAM_SCHEDULER)
+	if (frame->length == sizeof(uint32_t)) {
+		int increment = sys_get_be32(client->cursor) & 0x7FFFFFFF;
+		struct http_stream_ctx *stream;
+
+		if (frame->stream_identifier == 0) {
+			client->tx_window += increment;
+		} else {
+			stream = find_http_stream_context(client,
+							  frame->stream_identifier);
+			if (stream != NULL) {
+				stream->tx_window += increment;
+			}
+		}
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
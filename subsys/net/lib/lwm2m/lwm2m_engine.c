@@ -591,38 +591,21 @@ static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestam
 	int64_t next = INT64_MAX;
 
 	lwm2m_registry_lock();
-	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
-		if (!obs->event_timestamp) {
-			continue;
-		}
-
-		if (obs->event_timestamp < next) {
-			next = obs->event_timestamp;
-		}
-
-		if (timestamp < obs->event_timestamp) {
-			continue;
-		}
-		/* Check That There is not pending process*/
-		if (obs->active_notify != NULL) {
-			continue;
-		}
-
+	while ((obs = engine_observe_next_due(ctx, timestamp, &next)) != NULL) {
 		rc = generate_notify_message(ctx, obs, NULL);
 		if (rc == -ENOMEM) {
 			/* no memory/messages available, retry later */
-			goto cleanup;
+			break;
 		}
-		obs->event_timestamp =
-			engine_observe_shedule_next_event(obs, ctx->srv_obj_inst, timestamp);
+		engine_observe_set_event_timestamp(
+			ctx, obs, engine_observe_shedule_next_event(obs, ctx->srv_obj_inst, timestamp));
 		obs->last_timestamp = timestamp;
 
 		if (!rc) {
 			/* create at most one notification */
-			goto cleanup;
+			break;
 		}
 	}
-cleanup:
 	lwm2m_registry_unlock();
 	return next;
 }
@@ -186,6 +186,152 @@ static bool lwm2m_notify_observer_list(sys_slist_t *path_list, const struct lwm2
 	return false;
 }
 
+static inline uint32_t observer_obj_filter_bit(uint16_t obj_id)
+{
+	return BIT(obj_id % 32U);
+}
+
+/* Notify event heap, keeps the observer with the earliest event time at
+ * index 0 so that the engine does not need to go through all observers.
+ */
+static void notify_heap_place(struct lwm2m_ctx *ctx, uint16_t index, struct observe_node *obs)
+{
+	ctx->notify_heap[index] = obs;
+	obs->heap_index = index;
+}
+
+static void notify_heap_sift_up(struct lwm2m_ctx *ctx, uint16_t index)
+{
+	struct observe_node *obs = ctx->notify_heap[index];
+
+	while (index > 0) {
+		uint16_t parent = (index - 1U) / 2U;
+
+		if (ctx->notify_heap[parent]->event_timestamp <= obs->event_timestamp) {
+			break;
+		}
+
+		notify_heap_place(ctx, index, ctx->notify_heap[parent]);
+		index = parent;
+	}
+
+	notify_heap_place(ctx, index, obs);
+}
+
+static void notify_heap_sift_down(struct lwm2m_ctx *ctx, uint16_t index)
+{
+	struct observe_node *obs = ctx->notify_heap[index];
+
+	while (true) {
+		uint16_t child = 2U * index + 1U;
+
+		if (child >= ctx->notify_heap_len) {
+			break;
+		}
+
+		if (child + 1U < ctx->notify_heap_len &&
+		    ctx->notify_heap[child + 1U]->event_timestamp <
+			    ctx->notify_heap[child]->event_timestamp) {
+			child++;
+		}
+
+		if (obs->event_timestamp <= ctx->notify_heap[child]->event_timestamp) {
+			break;
+		}
+
+		notify_heap_place(ctx, index, ctx->notify_heap[child]);
+		index = child;
+	}
+
+	notify_heap_place(ctx, index, obs);
+}
+
+static void notify_heap_remove(struct lwm2m_ctx *ctx, struct observe_node *obs)
+{
+	uint16_t index = obs->heap_index;
+	struct observe_node *last;
+
+	__ASSERT_NO_MSG(index < ctx->notify_heap_len && ctx->notify_heap[index] == obs);
+
+	last = ctx->notify_heap[--ctx->notify_heap_len];
+	if (last == obs) {
+		return;
+	}
+
+	notify_heap_place(ctx, index, last);
+	notify_heap_sift_up(ctx, index);
+	notify_heap_sift_down(ctx, last->heap_index);
+}
+
+void engine_observe_set_event_timestamp(struct lwm2m_ctx *ctx, struct observe_node *obs,
+					int64_t timestamp)
+{
+	/* An observer is in the heap as long as it has an event time */
+	if (obs->event_timestamp == 0) {
+		if (timestamp == 0) {
+			return;
+		}
+
+		__ASSERT_NO_MSG(ctx->notify_heap_len < ARRAY_SIZE(ctx->notify_heap));
+		obs->event_timestamp = timestamp;
+		notify_heap_place(ctx, ctx->notify_heap_len++, obs);
+		notify_heap_sift_up(ctx, obs->heap_index);
+		return;
+	}
+
+	if (timestamp == 0) {
+		notify_heap_remove(ctx, obs);
+		obs->event_timestamp = 0;
+		return;
+	}
+
+	obs->event_timestamp = timestamp;
+	notify_heap_sift_up(ctx, obs->heap_index);
+	notify_heap_sift_down(ctx, obs->heap_index);
+}
+
+struct observe_node *engine_observe_next_due(struct lwm2m_ctx *ctx, int64_t timestamp,
+					     int64_t *next)
+{
+	uint16_t stack[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
+	uint16_t depth = 0;
+
+	if (ctx->notify_heap_len == 0) {
+		*next = INT64_MAX;
+		return NULL;
+	}
+
+	*next = ctx->notify_heap[0]->event_timestamp;
+
+	/* Due observers form a subtree at the top of the heap. Walk it to
+	 * skip the ones that are still waiting for a notification to finish.
+	 */
+	stack[depth++] = 0;
+	while (depth > 0) {
+		uint16_t index = stack[--depth];
+		struct observe_node *obs = ctx->notify_heap[index];
+		uint16_t child = 2U * index + 1U;
+
+		if (timestamp < obs->event_timestamp) {
+			continue;
+		}
+
+		if (obs->active_notify == NULL) {
+			return obs;
+		}
+
+		if (child + 1U < ctx->notify_heap_len) {
+			stack[depth++] = child + 1U;
+		}
+
+		if (child < ctx->notify_heap_len) {
+			stack[depth++] = child;
+		}
+	}
+
+	return NULL;
+}
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct lwm2m_obj_path path;
@@ -350,6 +496,10 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 	/* look for observers which match our resource */
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
+			if (!(obs->obj_filter & observer_obj_filter_bit(path->obj_id))) {
+				continue;
+			}
+
 			if (lwm2m_notify_observer_list(&obs->path_list, path)) {
 				/* update the event time for this observer */
 				ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs,
@@ -368,7 +518,7 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 
 				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
 					obs->resource_update = true;
-					obs->event_timestamp = timestamp;
+					engine_observe_set_event_timestamp(sock_ctx[i], obs, timestamp);
 				}
 
 				LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id,
@@ -434,17 +584,19 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 
 	obs->last_timestamp = k_uptime_get();
 	if (att_pmax) {
-		obs->event_timestamp = obs->last_timestamp + MSEC_PER_SEC * att_pmax;
-	} else {
-		obs->event_timestamp = 0;
+		engine_observe_set_event_timestamp(ctx, obs,
+						   obs->last_timestamp + MSEC_PER_SEC * att_pmax);
 	}
 	obs->resource_update = false;
 	obs->active_notify = NULL;
 	obs->format = format;
 	obs->counter = OBSERVE_COUNTER_START;
+	obs->obj_filter = 0;
 	sys_slist_append(&ctx->observer, &obs->node);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&obs->path_list, tmp, node) {
+		obs->obj_filter |= observer_obj_filter_bit(tmp->path.obj_id);
+
 		LOG_DBG("OBSERVER ADDED %u/%u/%u/%u(%u)", tmp->path.obj_id, tmp->path.obj_inst_id,
 			tmp->path.res_id, tmp->path.res_inst_id, tmp->path.level);
 
@@ -720,6 +872,7 @@ void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 		remove_observer_path_from_list(ctx, obs, o_p, NULL);
 	}
 	sys_slist_remove(&ctx->observer, prev_node, &obs->node);
+	engine_observe_set_event_timestamp(ctx, obs, 0);
 	(void)memset(obs, 0, sizeof(*obs));
 }
 
@@ -916,9 +1069,8 @@ const char *lwm2m_engine_get_attr_name(const struct lwm2m_attr *attr)
 	return LWM2M_ATTR_STR[attr->type];
 }
 
-static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
-						  const struct lwm2m_obj_path *path,
-						  uint16_t srv_obj_inst)
+static int lwm2m_engine_observer_timestamp_update(struct lwm2m_ctx *ctx,
+						  const struct lwm2m_obj_path *path)
 {
 	struct observe_node *obs;
 	struct notification_attrs nattrs = {0};
@@ -926,7 +1078,7 @@ static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
 	int64_t timestamp;
 
 	/* update observe_node accordingly */
-	SYS_SLIST_FOR_EACH_CONTAINER(observer, obs, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
 		if (obs->resource_update) {
 			/* Resource Update on going skip this*/
 			continue;
@@ -937,7 +1089,7 @@ static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
 		}
 
 		/* Read Attributes after validation Path */
-		ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs, srv_obj_inst);
+		ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs, ctx->srv_obj_inst);
 		if (ret < 0) {
 			return ret;
 		}
@@ -950,7 +1102,7 @@ static int lwm2m_engine_observer_timestamp_update(sys_slist_t *observer,
 			/* Disable Automatic Notify */
 			timestamp = 0;
 		}
-		obs->event_timestamp = timestamp;
+		engine_observe_set_event_timestamp(ctx, obs, timestamp);
 
 		(void)memset(&nattrs, 0, sizeof(nattrs));
 	}
@@ -1103,8 +1255,7 @@ int lwm2m_update_observer_max_period(struct lwm2m_ctx *client_ctx,
 	}
 
 	/* Update Observer timestamp */
-	return lwm2m_engine_observer_timestamp_update(&client_ctx->observer, path,
-						      client_ctx->srv_obj_inst);
+	return lwm2m_engine_observer_timestamp_update(client_ctx, path);
 }
 
 int lwm2m_engine_update_observer_max_period(struct lwm2m_ctx *client_ctx, const char *pathstr,
@@ -1370,8 +1521,7 @@ int lwm2m_write_attr_handler(struct lwm2m_engine_obj *obj, struct lwm2m_message
 		return 0;
 	}
 
-	lwm2m_engine_observer_timestamp_update(&msg->ctx->observer, &msg->path,
-					       msg->ctx->srv_obj_inst);
+	lwm2m_engine_observer_timestamp_update(msg->ctx, &msg->path);
 
 	return 0;
 }
@@ -20,6 +20,8 @@ struct observe_node {
 	int64_t last_timestamp;	             /* Timestamp from last Notify */
 	struct lwm2m_message *active_notify; /* Currently active notification */
 	uint32_t counter;
+	uint32_t obj_filter;                 /* Bit (obj_id % 32) set for each path */
+	uint16_t heap_index;                 /* Position in the notify heap */
 	uint16_t format;
 	uint8_t tkl;
 	bool resource_update : 1;            /* Resource is updated */
@@ -35,6 +37,30 @@ void clear_attrs(void *ref);
 int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv_obj_inst,
 					  const int64_t timestamp);
 
+/**
+ * @brief Set the time of the next notify event of an observer.
+ *
+ * @param ctx LwM2M context the observer belongs to.
+ * @param obs Observer.
+ * @param timestamp Event time, 0 to disable automatic notifications.
+ */
+void engine_observe_set_event_timestamp(struct lwm2m_ctx *ctx, struct observe_node *obs,
+					int64_t timestamp);
+
+/**
+ * @brief Find an observer due for a notification.
+ *
+ * Observers with a notification in progress are skipped.
+ *
+ * @param ctx LwM2M context.
+ * @param timestamp Current time.
+ * @param next Set to the earliest event time of all observers, INT64_MAX if none.
+ *
+ * @return Observer to notify, NULL if none.
+ */
+struct observe_node *engine_observe_next_due(struct lwm2m_ctx *ctx, int64_t timestamp,
+					     int64_t *next);
+
 void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 			       struct observe_node *obs);
 
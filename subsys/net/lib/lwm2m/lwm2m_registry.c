@@ -94,6 +94,21 @@ sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
 sys_slist_t *lwm2m_engine_obj_inst_list(void) { return &engine_obj_inst_list; }
 
+/* Lookup tables, the lists above keep the registration order for iteration */
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE),
+	     "CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE must be a power of two");
+
+static sys_slist_t engine_obj_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+
+static inline sys_slist_t *registry_bucket(sys_slist_t *table, uint16_t obj_id,
+					   uint16_t obj_inst_id)
+{
+	uint32_t hash = (((uint32_t)obj_id << 16) | obj_inst_id) * 0x9E3779B1U;
+
+	return &table[(hash >> 16) & (CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE - 1)];
+}
+
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
 static void lwm2m_engine_cache_write(const struct lwm2m_engine_obj_field *obj_field,
 				     const struct lwm2m_obj_path *path, const void *value,
@@ -113,6 +128,7 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_append(registry_bucket(engine_obj_hash, obj->obj_id, 0), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +140,8 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(registry_bucket(engine_obj_hash, obj->obj_id, 0),
+				  &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,7 +149,7 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(registry_bucket(engine_obj_hash, obj_id, 0), obj, hash_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -145,6 +163,12 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Fields are mostly listed in order of their contiguous IDs */
+		if (res_id >= 0 && res_id < obj->field_count &&
+		    obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -176,6 +200,9 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(registry_bucket(engine_obj_inst_hash, obj_inst->obj->obj_id,
+					 obj_inst->obj_inst_id),
+			 &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,13 +212,17 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(registry_bucket(engine_obj_inst_hash, obj_inst->obj->obj_id,
+						  obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(registry_bucket(engine_obj_inst_hash, obj_id, obj_inst_id),
+				     obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
@@ -427,10 +458,14 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
+	/* Resources are mostly created in order of their contiguous IDs */
+	if (path->res_id < oi->resource_count && oi->resources[path->res_id].res_id == path->res_id) {
+		r = &oi->resources[path->res_id];
+	}
+
+	for (i = 0; r == NULL && i < oi->resource_count; i++) {
 		if (oi->resources[i].res_id == path->res_id) {
 			r = &oi->resources[i];
-			break;
 		}
 	}
 
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <inttypes.h>
 #include <ctype.h>
 #include <time.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
 
@@ -35,6 +36,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define SENML_MAX_NAME_SIZE sizeof("/65535/65535/")
 
+/* Largest array header of a payload, array(65535) */
+#define SENML_CBOR_ARRAY_HDR_MAX_SIZE 3
+
 struct cbor_out_fmt_data {
 	/* Data */
 	struct lwm2m_senml input;
@@ -55,6 +59,12 @@ struct cbor_out_fmt_data {
 		size_t objlnk_sz; /* Object link buff size */
 		uint8_t objlnk_cnt;
 	};
+
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+	/* Records already written to the packet, after room for the array header */
+	uint16_t array_offset;
+	uint16_t record_cnt;
+#endif
 };
 
 struct cbor_in_fmt_data {
@@ -139,6 +149,80 @@ static int fmt_range_check(struct cbor_out_fmt_data *fd)
 	return 0;
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+static int flush_record(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	struct record *record = &fd->input.lwm2m_senml_record_m[0];
+	size_t len;
+	int ret;
+
+	if (fd->record_cnt == 0) {
+		/* The header is written when the number of records is known */
+		if (CPKT_BUF_W_SIZE(out->out_cpkt) < SENML_CBOR_ARRAY_HDR_MAX_SIZE) {
+			return -ENOMEM;
+		}
+
+		fd->array_offset = out->out_cpkt->offset;
+		out->out_cpkt->offset += SENML_CBOR_ARRAY_HDR_MAX_SIZE;
+	}
+
+	ret = cbor_encode_lwm2m_senml_record(CPKT_BUF_W_REGION(out->out_cpkt), record, &len);
+	if (ret != ZCBOR_SUCCESS) {
+		LOG_ERR("unable to encode senml cbor record");
+
+		if (fd->record_cnt == 0) {
+			out->out_cpkt->offset = fd->array_offset;
+		}
+
+		return -ENOMEM;
+	}
+
+	out->out_cpkt->offset += len;
+	fd->record_cnt++;
+
+	/* Nothing refers to the names and object links of the record anymore */
+	(void)memset(record, 0, sizeof(*record));
+	fd->input.lwm2m_senml_record_m_count = 0;
+	fd->name_cnt = 0;
+	fd->objlnk_cnt = 0;
+
+	return 0;
+}
+
+static int put_end_stream(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t *hdr = out->out_cpkt->data + fd->array_offset;
+	size_t hdr_len;
+
+	/* Same canonical header zcbor writes for the whole array */
+	if (fd->record_cnt < 24) {
+		hdr[0] = 0x80 | fd->record_cnt;
+		hdr_len = 1;
+	} else if (fd->record_cnt <= UINT8_MAX) {
+		hdr[0] = 0x98;
+		hdr[1] = fd->record_cnt;
+		hdr_len = 2;
+	} else {
+		hdr[0] = 0x99;
+		sys_put_be16(fd->record_cnt, &hdr[1]);
+		hdr_len = 3;
+	}
+
+	memmove(hdr + hdr_len, hdr + SENML_CBOR_ARRAY_HDR_MAX_SIZE,
+		out->out_cpkt->offset - fd->array_offset - SENML_CBOR_ARRAY_HDR_MAX_SIZE);
+	out->out_cpkt->offset -= SENML_CBOR_ARRAY_HDR_MAX_SIZE - hdr_len;
+
+	return out->out_cpkt->offset - fd->array_offset;
+}
+#else
+static inline int flush_record(struct lwm2m_output_context *out)
+{
+	return 0;
+}
+#endif /* CONFIG_LWM2M_RW_SENML_CBOR_STREAMING */
+
 static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
@@ -190,6 +274,12 @@ static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path
 	size_t len;
 	struct lwm2m_senml *input = &(LWM2M_OFD_CBOR(out)->input);
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING)
+	if (LWM2M_OFD_CBOR(out)->record_cnt > 0) {
+		return put_end_stream(out);
+	}
+#endif
+
 	if (!input->lwm2m_senml_record_m_count) {
 		len = put_empty_array(out);
 
@@ -376,7 +466,7 @@ static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vi = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
@@ -414,7 +504,7 @@ static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vi = (int64_t)value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
@@ -432,7 +522,7 @@ static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 	record->record_union.union_vf = *value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -452,7 +542,7 @@ static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vs.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
@@ -470,7 +560,7 @@ static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 	record->record_union.union_vb = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -490,7 +580,7 @@ static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vd.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
@@ -529,7 +619,7 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 
 	fd->objlnk_cnt++;
 
-	return 0;
+	return flush_record(out);
 }
 
 static int get_opaque(struct lwm2m_input_context *in,
@@ -24,6 +24,9 @@ extern "C" {
 int cbor_encode_lwm2m_senml(uint8_t *payload, size_t payload_len, const struct lwm2m_senml *input,
 			    size_t *payload_len_out);
 
+int cbor_encode_lwm2m_senml_record(uint8_t *payload, size_t payload_len,
+				   const struct record *input, size_t *payload_len_out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,9 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	client->internal.tx_batch_len = 0U;
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -125,11 +128,29 @@ static int client_read(struct mqtt_client *client)
 	return err_code;
 }
 
+static int client_write_msg(struct mqtt_client *client,
+			    const struct msghdr *message);
+
 static int client_write(struct mqtt_client *client, const uint8_t *data,
 			uint32_t datalen)
 {
 	int err_code;
 
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	if (client->internal.tx_batch_len > 0U) {
+		struct iovec io_vector = {
+			.iov_base = (void *)data,
+			.iov_len = datalen,
+		};
+		struct msghdr msg = {
+			.msg_iov = &io_vector,
+			.msg_iovlen = 1,
+		};
+
+		return client_write_msg(client, &msg);
+	}
+#endif
+
 	NET_DBG("[%p]: Transport writing %d bytes.", client, datalen);
 
 	err_code = mqtt_transport_write(client, data, datalen);
@@ -150,6 +171,28 @@ static int client_write_msg(struct mqtt_client *client,
 			    const struct msghdr *message)
 {
 	int err_code;
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	struct iovec io_vector[3];
+	struct msghdr batch_msg;
+
+	/* Batched packets go first, in the same transport write. */
+	if (client->internal.tx_batch_len > 0U) {
+		__ASSERT_NO_MSG(message->msg_iovlen < ARRAY_SIZE(io_vector));
+
+		io_vector[0].iov_base = client->tx_batch_buf;
+		io_vector[0].iov_len = client->internal.tx_batch_len;
+		memcpy(&io_vector[1], message->msg_iov,
+		       message->msg_iovlen * sizeof(struct iovec));
+
+		memset(&batch_msg, 0, sizeof(batch_msg));
+
+		batch_msg.msg_iov = io_vector;
+		batch_msg.msg_iovlen = message->msg_iovlen + 1;
+
+		message = &batch_msg;
+		client->internal.tx_batch_len = 0U;
+	}
+#endif
 
 	NET_DBG("[%p]: Transport writing message.", client);
 
@@ -236,6 +279,61 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+static int tx_batch_flush(struct mqtt_client *client)
+{
+	uint32_t len = client->internal.tx_batch_len;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	client->internal.tx_batch_len = 0U;
+
+	return client_write(client, client->tx_batch_buf, len);
+}
+
+static bool tx_batch_accepts(const struct mqtt_client *client,
+			     const struct mqtt_publish_param *param,
+			     const struct buf_ctx *packet)
+{
+	return (client->tx_batch_buf != NULL) &&
+	       (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) &&
+	       ((packet->end - packet->cur) + param->message.payload.len <=
+		client->tx_batch_buf_size);
+}
+
+/** @brief Copy an encoded publish packet and its payload into the batch. */
+static int tx_batch_queue(struct mqtt_client *client,
+			  const struct buf_ctx *packet,
+			  const struct mqtt_binstr *payload)
+{
+	uint32_t header_len = packet->end - packet->cur;
+	uint8_t *pos;
+	int err_code;
+
+	if (client->internal.tx_batch_len + header_len + payload->len >
+	    client->tx_batch_buf_size) {
+		err_code = tx_batch_flush(client);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	if (client->internal.tx_batch_len == 0U) {
+		client->internal.tx_batch_start = mqtt_sys_tick_in_ms_get();
+	}
+
+	pos = client->tx_batch_buf + client->internal.tx_batch_len;
+	memcpy(pos, packet->cur, header_len);
+	memcpy(pos + header_len, payload->data, payload->len);
+
+	client->internal.tx_batch_len += header_len + payload->len;
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_LIB_TX_BATCH */
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
@@ -266,6 +364,13 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	if (tx_batch_accepts(client, param, &packet)) {
+		err_code = tx_batch_queue(client, &packet, &param->message.payload);
+		goto error;
+	}
+#endif
+
 	io_vector[0].iov_base = packet.cur;
 	io_vector[0].iov_len = packet.end - packet.cur;
 	io_vector[1].iov_base = param->message.payload.data;
@@ -601,6 +706,18 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	if ((client->internal.tx_batch_len > 0U) &&
+	    (mqtt_elapsed_time_in_ms_get(client->internal.tx_batch_start) >=
+	     CONFIG_MQTT_LIB_TX_BATCH_LATENCY)) {
+		err_code = tx_batch_flush(client);
+		if (err_code < 0) {
+			mqtt_mutex_unlock(client);
+			return err_code;
+		}
+	}
+#endif
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
@@ -618,22 +735,58 @@ int mqtt_live(struct mqtt_client *client)
 	}
 }
 
+int mqtt_flush(struct mqtt_client *client)
+{
+	int err_code = 0;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	err_code = verify_tx_state(client);
+	if (err_code == 0) {
+		err_code = tx_batch_flush(client);
+	}
+#endif
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
 int mqtt_keepalive_time_left(const struct mqtt_client *client)
 {
 	uint32_t elapsed_time = mqtt_elapsed_time_in_ms_get(
 					client->internal.last_activity);
 	uint32_t keepalive_ms = 1000U * client->keepalive;
+	int time_left = -1;
 
 	if (client->keepalive == 0) {
 		/* Keep alive not enabled. */
-		return -1;
+	} else if (keepalive_ms <= elapsed_time) {
+		time_left = 0;
+	} else {
+		time_left = keepalive_ms - elapsed_time;
 	}
 
-	if (keepalive_ms <= elapsed_time) {
-		return 0;
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	if (client->internal.tx_batch_len > 0U) {
+		uint32_t batch_elapsed = mqtt_elapsed_time_in_ms_get(
+						client->internal.tx_batch_start);
+		int batch_left = 0;
+
+		if (batch_elapsed < CONFIG_MQTT_LIB_TX_BATCH_LATENCY) {
+			batch_left = CONFIG_MQTT_LIB_TX_BATCH_LATENCY - batch_elapsed;
+		}
+
+		if ((time_left < 0) || (batch_left < time_left)) {
+			time_left = batch_left;
+		}
 	}
+#endif
 
-	return keepalive_ms - elapsed_time;
+	return time_left;
 }
 
 int mqtt_input(struct mqtt_client *client)
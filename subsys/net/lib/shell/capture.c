@@ -16,6 +16,10 @@ LOG_MODULE_DECLARE(net_shell);
 
 #if defined(CONFIG_NET_CAPTURE)
 #define DEFAULT_DEV_NAME "NET_CAPTURE0"
+
+/* Longer captured packets are truncated when dumped */
+#define RING_DUMP_MAX_LEN 256
+
 static const struct device *capture_dev;
 
 static void get_address_str(const struct sockaddr *addr,
@@ -57,6 +61,16 @@ static void capture_cb(struct net_capture_info *info, void *user_data)
 		PR("Device\t\tiface    iface   Local\t\t\tPeer\n");
 	}
 
+	if (info->tunnel_iface == NULL) {
+		PR("%s\t%c        -       %s\n", info->capture_dev->name,
+		   info->is_enabled ?
+		   (net_if_get_by_iface(info->capture_iface) + '0') : '-',
+		   "capture ring");
+
+		(*count)++;
+		return;
+	}
+
 	get_address_str(info->local, addr_local, sizeof(addr_local));
 	get_address_str(info->peer, addr_peer, sizeof(addr_peer));
 
@@ -116,6 +130,24 @@ static int cmd_net_capture_setup(const struct shell *sh, size_t argc, char *argv
 		return -ENOEXEC;
 	}
 
+	if (strcmp(remote, "ring") == 0) {
+		if (capture_dev != NULL) {
+			PR_INFO("Capture already setup, cleaning up settings.\n");
+			net_capture_cleanup(capture_dev);
+			capture_dev = NULL;
+		}
+
+		ret = net_capture_ring_setup(&capture_dev);
+		if (ret < 0) {
+			PR_WARNING("Capture cannot be setup (%d)\n", ret);
+			return -ENOEXEC;
+		}
+
+		PR_INFO("Capture setup done, next enable it by "
+			"\"net capture enable <idx>\"\n");
+		return 0;
+	}
+
 	local = argv[arg++];
 	if (!local) {
 		PR_WARNING("Local IP address not specified.\n");
@@ -249,6 +281,157 @@ static int cmd_net_capture_disable(const struct shell *sh, size_t argc, char *ar
 	return 0;
 }
 
+static int cmd_net_capture_snaplen(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE)
+	unsigned long snaplen;
+	char *endptr;
+	int ret;
+
+	if (capture_dev == NULL) {
+		PR_WARNING("Capture is not setup.\n");
+		return -ENOEXEC;
+	}
+
+	if (argc < 2) {
+		PR_WARNING("Snap length is missing.\n");
+		return -ENOEXEC;
+	}
+
+	snaplen = strtoul(argv[1], &endptr, 10);
+	if (*endptr != '\0') {
+		PR_WARNING("Snap length %s is invalid.\n", argv[1]);
+		return -ENOEXEC;
+	}
+
+	ret = net_capture_snaplen_set(capture_dev, snaplen);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "snaplen", ret);
+		return -ENOEXEC;
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE", "network packet capture");
+#endif
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+static int parse_filter_insn(const char *str, struct net_capture_filter_insn *insn)
+{
+	unsigned long val[4];
+	char *endptr;
+
+	for (int i = 0; i < ARRAY_SIZE(val); i++) {
+		val[i] = strtoul(str, &endptr, 0);
+		if (endptr == str ||
+		    *endptr != ((i < ARRAY_SIZE(val) - 1) ? ',' : '\0')) {
+			return -EINVAL;
+		}
+
+		str = endptr + 1;
+	}
+
+	if (val[0] > UINT16_MAX || val[1] > UINT8_MAX || val[2] > UINT8_MAX) {
+		return -EINVAL;
+	}
+
+	insn->code = val[0];
+	insn->jt = val[1];
+	insn->jf = val[2];
+	insn->k = val[3];
+
+	return 0;
+}
+#endif
+
+static int cmd_net_capture_filter(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE_FILTER)
+	struct net_capture_filter_insn prog[CONFIG_NET_CAPTURE_FILTER_MAX_INSNS];
+	size_t count = argc - 1;
+	int ret;
+
+	if (capture_dev == NULL) {
+		PR_WARNING("Capture is not setup.\n");
+		return -ENOEXEC;
+	}
+
+	if (count > ARRAY_SIZE(prog)) {
+		PR_WARNING("Too many filter instructions, max %d\n",
+			   CONFIG_NET_CAPTURE_FILTER_MAX_INSNS);
+		return -ENOEXEC;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (parse_filter_insn(argv[i + 1], &prog[i]) < 0) {
+			PR_WARNING("Filter instruction %s is invalid.\n",
+				   argv[i + 1]);
+			return -ENOEXEC;
+		}
+	}
+
+	ret = net_capture_filter_set(capture_dev, count > 0 ? prog : NULL, count);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "filter", ret);
+		return -ENOEXEC;
+	}
+
+	PR_INFO("Capture filter %s\n", count > 0 ? "set" : "removed");
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_FILTER", "network packet capture filter");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE_RING)
+	static uint8_t data[RING_DUMP_MAX_LEN];
+	struct net_capture_ring_stats stats;
+	struct net_capture_record_hdr hdr;
+	int ret;
+
+	if (argc < 2) {
+		net_capture_ring_stats_get(&stats);
+
+		PR("Capture ring: %zu/%zu bytes used, %u packets stored, "
+		   "%u dropped\n", stats.used, stats.size, stats.stored,
+		   stats.dropped);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "dump") != 0) {
+		PR_WARNING("Unknown option %s\n", argv[1]);
+		return -ENOEXEC;
+	}
+
+	while ((ret = net_capture_ring_get(&hdr, data, sizeof(data))) >= 0) {
+		PR("%llu.%06llu iface %d length %u captured %u\n",
+		   hdr.timestamp / USEC_PER_SEC, hdr.timestamp % USEC_PER_SEC,
+		   hdr.iface, hdr.len, hdr.caplen);
+		shell_hexdump(sh, data, ret);
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 	SHELL_CMD(setup, NULL, "Setup network packet capture.\n"
 		  "'net capture setup <remote-ip-addr> <local-addr> <peer-addr>'\n"
@@ -256,7 +439,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 		  "<local> is the (inner) local IP address,\n"
 		  "<peer> is the (inner) peer IP address\n"
 		  "Local and Peer addresses can have UDP port number in them (optional)\n"
-		  "like 198.0.51.2:9000 or [2001:db8:100::2]:4242",
+		  "like 198.0.51.2:9000 or [2001:db8:100::2]:4242\n"
+		  "'net capture setup ring' stores the captured packets into\n"
+		  "the capture ring instead.",
 		  cmd_net_capture_setup),
 	SHELL_CMD(cleanup, NULL, "Cleanup network packet capture.",
 		  cmd_net_capture_cleanup),
@@ -266,6 +451,19 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 		  cmd_net_capture_enable),
 	SHELL_CMD(disable, NULL, "Disable network packet capture.",
 		  cmd_net_capture_disable),
+	SHELL_CMD(snaplen, NULL, "Set how many bytes are captured per packet.\n"
+		  "'net capture snaplen <bytes>', 0 captures whole packets.",
+		  cmd_net_capture_snaplen),
+	SHELL_CMD(filter, NULL, "Set the capture filter.\n"
+		  "'net capture filter [<code>,<jt>,<jf>,<k> ...]'\n"
+		  "The instructions are in classic BPF encoding, as printed by\n"
+		  "'tcpdump -ddd <expression>'. Without instructions the\n"
+		  "filter is removed.",
+		  cmd_net_capture_filter),
+	SHELL_CMD(ring, NULL, "Show the capture ring usage.\n"
+		  "'net capture ring dump' prints and removes the packets\n"
+		  "stored in the ring.",
+		  cmd_net_capture_ring),
 	SHELL_SUBCMD_SET_END
 );
 
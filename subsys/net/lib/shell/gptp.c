@@ -628,6 +628,21 @@ static int cmd_net_gptp(const struct shell *sh, size_t argc, char *argv[])
 		PR("\tThe local clock has expired    : %s\n",
 		   domain->state.clk_master_sync_receive.rcvd_local_clock_tick
 							       ? "yes" : "no");
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		struct gptp_servo_stats servo;
+
+		gptp_servo_get_stats(&servo);
+
+		PR("Local clock servo:\n");
+		PR("\tLast offset (ns)               : %lld\n",
+		   (long long)servo.offset_ns);
+		PR("\tMax / avg locked offset (ns)   : %lld / %lld\n",
+		   (long long)servo.offset_max_ns, (long long)servo.offset_avg_ns);
+		PR("\tFrequency correction (ppb)     : %d\n", servo.freq_ppb);
+		PR("\tSamples / steps                : %u / %u\n",
+		   servo.samples, servo.steps);
+#endif
 	}
 #else
 	ARG_UNUSED(argc);
@@ -467,6 +467,13 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv6_nd.sent),
 	   GET_STAT(iface, ipv6_nd.drop));
 #endif /* CONFIG_NET_STATISTICS_IPV6_ND */
+#if defined(CONFIG_NET_STATISTICS_IPV6_PMTU)
+	PR("IPv6 PMTU recv %d\tdrop\t%d\tmss clamped\t%d\tfragmented\t%d\n",
+	   GET_STAT(iface, ipv6_pmtu.recv),
+	   GET_STAT(iface, ipv6_pmtu.drop),
+	   GET_STAT(iface, ipv6_pmtu.mss_clamped),
+	   GET_STAT(iface, ipv6_pmtu.fragmented));
+#endif /* CONFIG_NET_STATISTICS_IPV6_PMTU */
 #if defined(CONFIG_NET_STATISTICS_MLD)
 	PR("IPv6 MLD recv  %d\tsent\t%d\tdrop\t%d\n",
 	   GET_STAT(iface, ipv6_mld.recv),
@@ -535,6 +542,11 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("TCP conn drop  %d\tconnrst\t%d\n",
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
+#if defined(CONFIG_NET_GRO)
+	PR("TCP gro merged %d\tflushed\t%d\n",
+	   GET_STAT(iface, tcp.gro_merged),
+	   GET_STAT(iface, tcp.gro_flushed));
+#endif
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
 #endif
 
@@ -542,6 +554,13 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("Bytes sent     %u\n", GET_STAT(iface, bytes.sent));
 	PR("Processing err %d\n", GET_STAT(iface, processing_error));
 
+#if defined(CONFIG_NET_TC_TX_FQ)
+	PR("TX FQ flows    %d\taqmdrop\t%d\tlimdrop\t%d\n",
+	   GET_STAT(iface, fq.new_flows),
+	   GET_STAT(iface, fq.aqm_drop),
+	   GET_STAT(iface, fq.overlimit_drop));
+#endif
+
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
 
@@ -47,17 +47,30 @@ LOG_MODULE_REGISTER(net_sock_addr, CONFIG_NET_SOCKETS_LOG_LEVEL);
 struct getaddrinfo_state {
 	const struct zsock_addrinfo *hints;
 	struct k_sem sem;
-	int status;
 	uint16_t idx;
 	uint16_t port;
-	uint16_t dns_id;
 	struct zsock_addrinfo *ai_arr;
 };
 
+/* One address family lookup, the A and AAAA queries can run in parallel */
+struct getaddrinfo_query {
+	struct getaddrinfo_state *state;
+	enum dns_query_type qtype;
+	int status;
+	uint16_t dns_id;
+	/* To be started, or restarted after a timeout */
+	bool start;
+	/* Started and the resolver has not called back yet */
+	bool pending;
+	/* Started and the result has not been handled yet */
+	bool active;
+};
+
 static void dns_resolve_cb(enum dns_resolve_status status,
 			   struct dns_addrinfo *info, void *user_data)
 {
-	struct getaddrinfo_state *state = user_data;
+	struct getaddrinfo_query *query = user_data;
+	struct getaddrinfo_state *state = query->state;
 	struct zsock_addrinfo *ai;
 	int socktype = SOCK_STREAM;
 
@@ -67,7 +80,8 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 		if (status == DNS_EAI_ALLDONE) {
 			status = 0;
 		}
-		state->status = status;
+		query->status = status;
+		query->pending = false;
 		k_sem_give(&state->sem);
 		return;
 	}
@@ -118,65 +132,155 @@ static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
 	return timeout;
 }
 
-static int exec_query(const char *host, int family,
-		      struct getaddrinfo_state *ai_state)
+static int start_query(const char *host, struct getaddrinfo_query *query,
+		       int timeout_ms)
+{
+	int ret;
+
+	ret = dns_get_addr_info(host, query->qtype, &query->dns_id,
+				dns_resolve_cb, query, timeout_ms);
+	if (ret == 0) {
+		query->pending = true;
+		query->active = true;
+	} else if (ret == -EPFNOSUPPORT) {
+		/* If we are returned -EPFNOSUPPORT then that will indicate
+		 * wrong address family type queried. Check that and return
+		 * DNS_EAI_ADDRFAMILY.
+		 */
+		query->status = DNS_EAI_ADDRFAMILY;
+	} else {
+		errno = -ret;
+		query->status = DNS_EAI_SYSTEM;
+	}
+
+	return ret;
+}
+
+static bool queries_pending(struct getaddrinfo_query *queries, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (queries[i].pending) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Run the queries in parallel. A query for which the resolver has no free
+ * slot is started once another one completes.
+ */
+static void exec_queries(const char *host, struct getaddrinfo_query *queries,
+			 size_t count, struct getaddrinfo_state *ai_state)
 {
-	enum dns_query_type qtype = DNS_QUERY_TYPE_A;
 	k_timepoint_t end = sys_timepoint_calc(K_MSEC(CONFIG_NET_SOCKETS_DNS_TIMEOUT));
 	k_timeout_t timeout = K_MSEC(MIN(CONFIG_NET_SOCKETS_DNS_TIMEOUT,
 					 CONFIG_NET_SOCKETS_DNS_BACKOFF_INTERVAL));
+	bool timed_out;
+	bool backoff;
 	int timeout_ms;
-	int st, ret;
+	int ret;
 
-	if (family == AF_INET6) {
-		qtype = DNS_QUERY_TYPE_AAAA;
+	for (size_t i = 0; i < count; i++) {
+		queries[i].state = ai_state;
+		queries[i].start = true;
+		queries[i].pending = false;
+		queries[i].active = false;
 	}
 
-again:
 	timeout_ms = k_ticks_to_ms_ceil32(timeout.ticks);
 
-	NET_DBG("Timeout %d", timeout_ms);
+	do {
+		NET_DBG("Timeout %d", timeout_ms);
+
+		for (size_t i = 0; i < count; i++) {
+			if (!queries[i].start) {
+				continue;
+			}
+
+			ret = start_query(host, &queries[i], timeout_ms);
+			if (ret == -EAGAIN && queries_pending(queries, count)) {
+				continue;
+			}
+
+			queries[i].start = false;
+		}
+
+		if (!queries_pending(queries, count)) {
+			break;
+		}
 
-	ret = dns_get_addr_info(host, qtype, &ai_state->dns_id,
-				dns_resolve_cb, ai_state, timeout_ms);
-	if (ret == 0) {
 		/* If the DNS query for reason fails so that the
 		 * dns_resolve_cb() would not be called, then we want the
 		 * semaphore to timeout so that we will not hang forever.
 		 * So make the sem timeout longer than the DNS timeout so that
 		 * we do not need to start to cancel any pending DNS queries.
 		 */
-		ret = k_sem_take(&ai_state->sem, K_MSEC(timeout_ms + 100));
-		if (ret == -EAGAIN) {
-			if (!sys_timepoint_expired(end)) {
-				timeout = recalc_timeout(end, timeout);
-				goto again;
-			}
+		timed_out = k_sem_take(&ai_state->sem, K_MSEC(timeout_ms + 100)) == -EAGAIN;
+		if (timed_out) {
+			for (size_t i = 0; i < count; i++) {
+				if (!queries[i].pending) {
+					continue;
+				}
 
-			(void)dns_cancel_addr_info(ai_state->dns_id);
-			st = DNS_EAI_AGAIN;
-		} else {
-			if (ai_state->status == DNS_EAI_CANCELED) {
-				if (!sys_timepoint_expired(end)) {
-					timeout = recalc_timeout(end, timeout);
-					goto again;
+				(void)dns_cancel_addr_info(queries[i].dns_id);
+				if (queries[i].pending) {
+					queries[i].pending = false;
+					queries[i].status = DNS_EAI_CANCELED;
+				} else {
+					/* Called back by the cancel */
+					(void)k_sem_take(&ai_state->sem, K_NO_WAIT);
 				}
 			}
+		}
+
+		backoff = false;
+
+		for (size_t i = 0; i < count; i++) {
+			if (!queries[i].active || queries[i].pending) {
+				continue;
+			}
 
-			st = ai_state->status;
+			queries[i].active = false;
+
+			if (queries[i].status != DNS_EAI_CANCELED) {
+				continue;
+			}
+
+			if (!sys_timepoint_expired(end)) {
+				queries[i].start = true;
+				backoff = true;
+			} else if (timed_out) {
+				queries[i].status = DNS_EAI_AGAIN;
+			}
+		}
+
+		if (backoff) {
+			timeout = recalc_timeout(end, timeout);
+			timeout_ms = k_ticks_to_ms_ceil32(timeout.ticks);
+		}
+	} while (true);
+}
+
+static void sort_addrinfo(struct zsock_addrinfo *ai_arr, uint16_t count)
+{
+	struct zsock_addrinfo tmp;
+
+	for (uint16_t i = 1; i < count; i++) {
+		for (uint16_t j = i; j > 0 && ai_arr[j].ai_family == AF_INET &&
+				     ai_arr[j - 1].ai_family != AF_INET; j--) {
+			tmp = ai_arr[j];
+			ai_arr[j] = ai_arr[j - 1];
+			ai_arr[j - 1] = tmp;
 		}
-	} else if (ret == -EPFNOSUPPORT) {
-		/* If we are returned -EPFNOSUPPORT then that will indicate
-		 * wrong address family type queried. Check that and return
-		 * DNS_EAI_ADDRFAMILY.
-		 */
-		st = DNS_EAI_ADDRFAMILY;
-	} else {
-		errno = -ret;
-		st = DNS_EAI_SYSTEM;
 	}
 
-	return st;
+	/* The pointers refer to the entries themselves */
+	for (uint16_t i = 0; i < count; i++) {
+		ai_arr[i].ai_addr = &ai_arr[i]._ai_addr;
+		ai_arr[i].ai_canonname = ai_arr[i]._ai_canonname;
+		ai_arr[i].ai_next = (i + 1 < count) ? &ai_arr[i + 1] : NULL;
+	}
 }
 
 static int getaddrinfo_null_host(int port, const struct zsock_addrinfo *hints,
@@ -225,6 +329,8 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	int st1 = DNS_EAI_ADDRFAMILY, st2 = DNS_EAI_ADDRFAMILY;
 	struct sockaddr *ai_addr;
 	struct getaddrinfo_state ai_state;
+	struct getaddrinfo_query queries[2];
+	size_t count = 0;
 
 	if (hints) {
 		family = hints->ai_family;
@@ -263,29 +369,36 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	ai_state.idx = 0U;
 	ai_state.port = htons(port);
 	ai_state.ai_arr = res;
-	ai_state.dns_id = 0;
 	k_sem_init(&ai_state.sem, 0, K_SEM_MAX_LIMIT);
 
-	/* If family is AF_UNSPEC, then we query IPv4 address first
-	 * if IPv4 is enabled in the config.
+	/* If family is AF_UNSPEC, then we query both IPv4 and IPv6
+	 * addresses if enabled in the config.
 	 */
 	if ((family != AF_INET6) && IS_ENABLED(CONFIG_NET_IPV4)) {
-		st1 = exec_query(host, AF_INET, &ai_state);
-		if (st1 == DNS_EAI_AGAIN) {
-			return st1;
-		}
+		queries[count++].qtype = DNS_QUERY_TYPE_A;
 	}
 
-	/* If family is AF_UNSPEC, the IPv4 query has been already done
-	 * so we can do IPv6 query next if IPv6 is enabled in the config.
-	 */
 	if ((family != AF_INET) && IS_ENABLED(CONFIG_NET_IPV6)) {
-		st2 = exec_query(host, AF_INET6, &ai_state);
-		if (st2 == DNS_EAI_AGAIN) {
-			return st2;
+		queries[count++].qtype = DNS_QUERY_TYPE_AAAA;
+	}
+
+	exec_queries(host, queries, count, &ai_state);
+
+	for (size_t i = 0; i < count; i++) {
+		if (queries[i].status == DNS_EAI_AGAIN) {
+			return DNS_EAI_AGAIN;
+		}
+
+		if (queries[i].qtype == DNS_QUERY_TYPE_A) {
+			st1 = queries[i].status;
+		} else {
+			st2 = queries[i].status;
 		}
 	}
 
+	/* The answers arrive in any order, keep the IPv4 addresses first */
+	sort_addrinfo(ai_state.ai_arr, ai_state.idx);
+
 	for (uint16_t idx = 0; idx < ai_state.idx; idx++) {
 		ai_addr = &ai_state.ai_arr[idx]._ai_addr;
 		net_sin(ai_addr)->sin_port = htons(port);
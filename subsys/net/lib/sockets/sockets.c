@@ -2,6 +2,7 @@
  * Copyright (c) 2017 Linaro Limited
  * Copyright (c) 2021 Nordic Semiconductor
  * Copyright (c) 2023 Arm Limited (or its affiliates). All rights reserved.
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -120,6 +121,10 @@ static void zsock_received_cb(struct net_context *ctx,
 			      int status,
 			      void *user_data);
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+static void zsock_release_lent(struct net_context *ctx);
+#endif
+
 static int fifo_wait_non_empty(struct k_fifo *fifo, k_timeout_t timeout)
 {
 	struct k_poll_event events[] = {
@@ -130,6 +135,19 @@ static int fifo_wait_non_empty(struct k_fifo *fifo, k_timeout_t timeout)
 	return k_poll(events, ARRAY_SIZE(events), timeout);
 }
 
+static void zsock_epoll_notify_ctx(struct net_context *ctx)
+{
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	void *item = ctx->epoll_item;
+
+	if (item != NULL) {
+		zsock_epoll_notify(item);
+	}
+#else
+	ARG_UNUSED(ctx);
+#endif
+}
+
 static void zsock_flush_queue(struct net_context *ctx)
 {
 	bool is_listen = net_context_get_state(ctx) == NET_CONTEXT_LISTENING;
@@ -151,6 +169,8 @@ static void zsock_flush_queue(struct net_context *ctx)
 
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+
+	zsock_epoll_notify_ctx(ctx);
 }
 
 #if defined(CONFIG_NET_NATIVE)
@@ -187,6 +207,10 @@ static int zsock_socket_internal(int family, int type, int proto)
 	/* The socket flags are stored here */
 	ctx->socket_data = NULL;
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	ctx->epoll_item = NULL;
+#endif
+
 	/* recv_q and accept_q are in union */
 	k_fifo_init(&ctx->recv_q);
 
@@ -268,8 +292,20 @@ int zsock_close_ctx(struct net_context *ctx)
 	ctx->user_data = INT_TO_POINTER(EINTR);
 	sock_set_error(ctx);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/* Closing the socket removes its epoll registration */
+	if (ctx->epoll_item != NULL) {
+		zsock_epoll_release(ctx->epoll_item);
+		ctx->epoll_item = NULL;
+	}
+#endif
+
 	zsock_flush_queue(ctx);
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+	zsock_release_lent(ctx);
+#endif
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -362,6 +398,10 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		k_fifo_init(&new_ctx->recv_q);
 		k_condvar_init(&new_ctx->cond.recv);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+		new_ctx->epoll_item = NULL;
+#endif
+
 		k_fifo_put(&parent->accept_q, new_ctx);
 
 		/* TCP context is effectively owned by both application
@@ -374,6 +414,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_epoll_notify_ctx(parent);
 	}
 
 }
@@ -428,6 +470,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_epoll_notify_ctx(ctx);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -1347,6 +1391,60 @@ out:
 	return ret;
 }
 
+/* Fills in the source address of a received datagram, addrlen is a
+ * value-result argument set to the actual size of the address.
+ */
+static int sock_get_dgram_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+				   struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static void sock_set_dgram_control(struct net_context *ctx, struct net_pkt *pkt,
+				   struct msghdr *msg)
+{
+	if (msg->msg_control != NULL) {
+		if (msg->msg_controllen > 0) {
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO) &&
+			    net_context_is_recv_pktinfo_set(ctx)) {
+				if (add_pktinfo(ctx, pkt, msg) < 0) {
+					msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+				}
+			} else {
+				msg->msg_controllen = 0U;
+			}
+		}
+	} else {
+		msg->msg_controllen = 0U;
+	}
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       struct msghdr *msg,
 				       void *buf,
@@ -1398,38 +1496,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_get_dgram_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -1489,20 +1560,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	}
 
 	if (msg != NULL) {
-		if (msg->msg_control != NULL) {
-			if (msg->msg_controllen > 0) {
-				if (IS_ENABLED(CONFIG_NET_CONTEXT_RECV_PKTINFO) &&
-				    net_context_is_recv_pktinfo_set(ctx)) {
-					if (add_pktinfo(ctx, pkt, msg) < 0) {
-						msg->msg_flags |= ZSOCK_MSG_CTRUNC;
-					}
-				} else {
-					msg->msg_controllen = 0U;
-				}
-			}
-		} else {
-			msg->msg_controllen = 0U;
-		}
+		sock_set_dgram_control(ctx, pkt, msg);
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
@@ -1805,6 +1863,241 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <zephyr/syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+static bool pkt_holds(struct net_pkt *pkt, const void *ptr)
+{
+	for (struct net_buf *frag = pkt->frags; frag != NULL; frag = frag->frags) {
+		if (((const uint8_t *)ptr >= frag->__buf) &&
+		    ((const uint8_t *)ptr < (frag->__buf + frag->size))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Points the iovecs of msg at the data of pkt from its cursor on,
+ * one fragment per iovec, returns the number of bytes covered.
+ */
+static size_t lend_pkt_data(struct net_pkt *pkt, struct msghdr *msg)
+{
+	struct net_buf *frag = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	size_t lent_len = 0;
+	size_t iovec = 0;
+
+	while (frag != NULL && iovec < msg->msg_iovlen) {
+		size_t len = frag->len - (pos - frag->data);
+
+		if (len > 0) {
+			msg->msg_iov[iovec].iov_base = pos;
+			msg->msg_iov[iovec].iov_len = len;
+			lent_len += len;
+			iovec++;
+		}
+
+		frag = frag->frags;
+		pos = (frag != NULL) ? frag->data : NULL;
+	}
+
+	msg->msg_iovlen = iovec;
+
+	return lent_len;
+}
+
+static ssize_t zsock_recv_zerocopy(struct net_context *ctx, struct msghdr *msg,
+				   int flags)
+{
+	const bool stream = net_context_get_type(ctx) == SOCK_STREAM;
+	k_timeout_t timeout = K_FOREVER;
+	size_t recv_len, lent_len;
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	int slot;
+
+	if ((flags & ZSOCK_MSG_PEEK) || msg->msg_iovlen < 1) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (slot = 0; slot < ARRAY_SIZE(ctx->lent); slot++) {
+		if (ctx->lent[slot] == NULL) {
+			break;
+		}
+	}
+
+	if (slot == ARRAY_SIZE(ctx->lent)) {
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	if (stream && net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (stream && sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (stream && sock_is_eof(ctx)) {
+			msg->msg_iovlen = 0;
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			int ret = zsock_wait_data(ctx, &timeout);
+
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				errno = EAGAIN;
+				return -1;
+			}
+
+			continue;
+		}
+
+		recv_len = net_pkt_remaining_data(pkt);
+		if (!stream || recv_len > 0) {
+			break;
+		}
+
+		/* Empty TCP packet, e.g. the FIN */
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	if (!stream && msg->msg_name != NULL && msg->msg_namelen > 0) {
+		int ret = sock_get_dgram_src_addr(ctx, pkt, msg->msg_name,
+						  &msg->msg_namelen);
+
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	lent_len = lend_pkt_data(pkt, msg);
+
+	if (!stream) {
+		sock_set_dgram_control(ctx, pkt, msg);
+
+		if (lent_len < recv_len) {
+			msg->msg_flags |= ZSOCK_MSG_TRUNC;
+		}
+	}
+
+	if (stream && lent_len < recv_len) {
+		/* Out of iovecs: keep the rest of the packet queued and
+		 * lend it another reference.
+		 */
+		net_pkt_ref(pkt);
+		net_pkt_set_overwrite(pkt, true);
+		(void)net_pkt_skip(pkt, lent_len);
+	} else {
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+
+		if (stream && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+	}
+
+	if (lent_len == 0) {
+		/* Empty datagram, nothing to lend */
+		net_pkt_unref(pkt);
+	} else {
+		ctx->lent[slot] = pkt;
+	}
+
+	if (stream) {
+		net_context_update_recv_wnd(ctx, lent_len);
+	}
+
+	return (!stream && (flags & ZSOCK_MSG_TRUNC)) ? recv_len : lent_len;
+}
+
+static void zsock_release_lent(struct net_context *ctx)
+{
+	for (int slot = 0; slot < ARRAY_SIZE(ctx->lent); slot++) {
+		if (ctx->lent[slot] != NULL) {
+			net_pkt_unref(ctx->lent[slot]);
+			ctx->lent[slot] = NULL;
+		}
+	}
+}
+
+int zsock_recv_release(int sock, const struct msghdr *msg)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	int ret = -EINVAL;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (msg == NULL || (msg->msg_iovlen > 0 && msg->msg_iov == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (msg->msg_iovlen == 0) {
+		/* Nothing was lent */
+		return 0;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (int slot = 0; slot < ARRAY_SIZE(ctx->lent); slot++) {
+		struct net_pkt *pkt = ctx->lent[slot];
+
+		if (pkt != NULL && pkt_holds(pkt, msg->msg_iov[0].iov_base)) {
+			ctx->lent[slot] = NULL;
+			net_pkt_unref(pkt);
+			ret = 0;
+			break;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	SET_ERRNO(ret);
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_RX */
+
 ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 			  int flags)
 {
@@ -1821,6 +2114,13 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 		return -1;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+	if ((flags & ZSOCK_MSG_ZEROCOPY) &&
+	    (sock_type == SOCK_DGRAM || sock_type == SOCK_STREAM)) {
+		return zsock_recv_zerocopy(ctx, msg, flags);
+	}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_RX */
+
 	for (i = 0; i < msg->msg_iovlen; i++) {
 		max_len += msg->msg_iov[i].iov_len;
 	}
@@ -1868,6 +2168,12 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 		return -1;
 	}
 
+	if (flags & ZSOCK_MSG_ZEROCOPY) {
+		/* Network buffers can't be lent to user mode */
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
 	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
 
 	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
@@ -2020,6 +2326,155 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret = 0;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	/* Look up and lock the socket once for the whole batch. */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	/* As with Linux, an error is only reported if no datagram was sent,
+	 * otherwise it is reported by the next call.
+	 */
+	if (i == 0 && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int len;
+	unsigned int i;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			return i == 0 ? -1 : i;
+		}
+
+		len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+	}
+
+	return i;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret = 0;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr,
+				      flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		/* Only wait for the first datagram if requested. */
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	if (i == 0 && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int len;
+	unsigned int i;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr,
+					   flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			return i == 0 ? -1 : i;
+		}
+
+		len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return i;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2611,6 +3066,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -3164,6 +3633,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -3383,6 +3866,12 @@ int z_vrfy_zsock_setsockopt(int sock, int level, int optname,
 	void *kernel_optval;
 	int ret;
 
+	if (level == SOL_PACKET && optname == PACKET_RX_RING) {
+		/* The ring memory would be written by the stack at any time */
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
 	kernel_optval = k_usermode_alloc_from_copy((const void *)optval, optlen);
 	K_OOPS(!kernel_optval);
 
@@ -3638,6 +4127,24 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return 0;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	case ZFD_IOCTL_EPOLL_ATTACH: {
+		struct net_context *ctx = obj;
+		void *item;
+
+		item = va_arg(args, void *);
+
+		/* Only one epoll instance can be notified */
+		if (item != NULL && ctx->epoll_item != NULL && ctx->epoll_item != item) {
+			errno = EBUSY;
+			return -1;
+		}
+
+		ctx->epoll_item = item;
+		return 0;
+	}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
 	case ZFD_IOCTL_FIONBIO:
 		sock_set_flag(obj, SOCK_NONBLOCK, SOCK_NONBLOCK);
 		return 0;
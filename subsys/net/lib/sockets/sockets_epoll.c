@@ -0,0 +1,807 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_epoll, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#include "sockets_internal.h"
+
+/* Events that are passed on to poll() when checking a registration */
+#define EPOLL_POLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT)
+
+/* Events that are always reported */
+#define EPOLL_ALWAYS_EVENTS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+
+/* At most this many registrations are polled, one poll() entry is taken
+ * by the epoll instance itself to be woken up from the ready list.
+ */
+#define EPOLL_POLLED_MAX (CONFIG_NET_SOCKETS_POLL_MAX - 1)
+
+struct epoll_item {
+	/** Node in the ready list of the instance */
+	sys_snode_t node;
+
+	/** Instance the registration belongs to */
+	struct epoll *ep;
+
+	/** Object of the registered file descriptor, to detect reuse */
+	void *obj;
+
+	/** User data */
+	zsock_epoll_data_t data;
+
+	/** Registered file descriptor */
+	int fd;
+
+	/** Registered events */
+	uint32_t events;
+
+	/** Registration is in use */
+	bool in_use : 1;
+
+	/** Item is queued in the ready list */
+	bool ready : 1;
+
+	/** Socket notifies the item of incoming data */
+	bool attached : 1;
+
+	/** Registration is checked with poll() on every wait */
+	bool polled : 1;
+
+	/** One-shot registration that has been reported */
+	bool disabled : 1;
+};
+
+struct epoll {
+	struct k_spinlock lock;
+
+	/** Raised when an item is added to the ready list */
+	struct k_poll_signal signal;
+
+	/** Items that may be ready */
+	sys_slist_t ready;
+
+	struct epoll_item items[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+
+	bool in_use;
+};
+
+static struct epoll epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static K_MUTEX_DEFINE(epolls_lock);
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static bool epoll_has_ready(struct epoll *ep)
+{
+	k_spinlock_key_t key;
+	bool ready;
+
+	key = k_spin_lock(&ep->lock);
+	ready = !sys_slist_is_empty(&ep->ready);
+	k_spin_unlock(&ep->lock, key);
+
+	return ready;
+}
+
+static struct epoll *epoll_get(int epfd)
+{
+	return z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+}
+
+/* Called with the instance lock held */
+static void epoll_queue_locked(struct epoll *ep, struct epoll_item *item)
+{
+	if (item->ready || item->polled || item->disabled) {
+		return;
+	}
+
+	item->ready = true;
+	sys_slist_append(&ep->ready, &item->node);
+}
+
+/* Called with the instance lock held */
+static void epoll_free_locked(struct epoll *ep, struct epoll_item *item)
+{
+	if (item->ready) {
+		(void)sys_slist_find_and_remove(&ep->ready, &item->node);
+	}
+
+	item->in_use = false;
+	item->ready = false;
+	item->attached = false;
+	item->polled = false;
+}
+
+/* Called with the instance lock held */
+static struct epoll_item *epoll_find_locked(struct epoll *ep, int fd)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].in_use && ep->items[i].fd == fd) {
+			return &ep->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with the instance lock held */
+static int epoll_polled_count_locked(struct epoll *ep)
+{
+	int count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].in_use && ep->items[i].polled) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void zsock_epoll_notify(void *ptr)
+{
+	struct epoll_item *item = ptr;
+	struct epoll *ep = item->ep;
+	k_spinlock_key_t key;
+	bool raise = false;
+
+	key = k_spin_lock(&ep->lock);
+
+	if (item->in_use && !item->ready) {
+		epoll_queue_locked(ep, item);
+		raise = item->ready;
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	if (raise) {
+		k_poll_signal_raise(&ep->signal, 0);
+	}
+}
+
+void zsock_epoll_release(void *ptr)
+{
+	struct epoll_item *item = ptr;
+	struct epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->lock);
+
+	if (item->in_use) {
+		epoll_free_locked(ep, item);
+	}
+
+	k_spin_unlock(&ep->lock, key);
+}
+
+/* Install or remove the item in the socket so that it is notified when data
+ * arrives. Fails for file descriptors that do not support it.
+ */
+static int epoll_attach(int fd, void *obj, struct epoll_item *item)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *fd_obj;
+	int ret;
+
+	fd_obj = z_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (fd_obj == NULL || fd_obj != obj) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = z_fdtable_call_ioctl(vtable, fd_obj, ZFD_IOCTL_EPOLL_ATTACH, item);
+	k_mutex_unlock(lock);
+
+	return ret < 0 ? -errno : 0;
+}
+
+static uint32_t epoll_check(int fd, void *obj, uint32_t events)
+{
+	struct zsock_pollfd pfd = {
+		.fd = fd,
+		.events = events & EPOLL_POLL_EVENTS,
+	};
+
+	if (z_get_fd_obj(fd, NULL, 0) != obj) {
+		return ZSOCK_POLLNVAL;
+	}
+
+	if (zsock_poll_internal(&pfd, 1, K_NO_WAIT) < 0) {
+		return ZSOCK_EPOLLERR;
+	}
+
+	return pfd.revents;
+}
+
+/* Record the result of checking an item and return whether it is reported */
+static bool epoll_report(struct epoll *ep, struct epoll_item *item, int fd,
+			 uint32_t revents, struct zsock_epoll_event *event)
+{
+	k_spinlock_key_t key;
+	bool report = false;
+
+	key = k_spin_lock(&ep->lock);
+
+	/* The registration was removed or changed while being checked */
+	if (!item->in_use || item->fd != fd || item->disabled) {
+		goto out;
+	}
+
+	/* The file descriptor was closed, drop its registration */
+	if (revents & ZSOCK_POLLNVAL) {
+		epoll_free_locked(ep, item);
+		goto out;
+	}
+
+	revents &= item->events | EPOLL_ALWAYS_EVENTS;
+	if (revents == 0) {
+		goto out;
+	}
+
+	event->events = revents;
+	event->data = item->data;
+	report = true;
+
+	if (item->events & ZSOCK_EPOLLONESHOT) {
+		item->disabled = true;
+	} else if (!item->polled && !(item->events & ZSOCK_EPOLLET)) {
+		/* Level-triggered, check again on the next wait */
+		epoll_queue_locked(ep, item);
+	}
+
+out:
+	k_spin_unlock(&ep->lock, key);
+
+	return report;
+}
+
+static int epoll_collect_ready(struct epoll *ep, struct zsock_epoll_event *events,
+			       int maxevents)
+{
+	k_spinlock_key_t key;
+	int count = 0;
+	int pending;
+
+	key = k_spin_lock(&ep->lock);
+	pending = sys_slist_len(&ep->ready);
+	k_spin_unlock(&ep->lock, key);
+
+	/* Items queued again while collecting are left for the next wait */
+	while (pending-- > 0 && count < maxevents) {
+		struct epoll_item *item;
+		sys_snode_t *node;
+		uint32_t revents;
+		uint32_t mask;
+		void *obj;
+		int fd;
+
+		key = k_spin_lock(&ep->lock);
+
+		node = sys_slist_get(&ep->ready);
+		if (node == NULL) {
+			k_spin_unlock(&ep->lock, key);
+			break;
+		}
+
+		item = CONTAINER_OF(node, struct epoll_item, node);
+		item->ready = false;
+		fd = item->fd;
+		obj = item->obj;
+		mask = item->events;
+
+		k_spin_unlock(&ep->lock, key);
+
+		revents = epoll_check(fd, obj, mask);
+
+		if (epoll_report(ep, item, fd, revents, &events[count])) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static int epoll_prepare_polled(struct epoll *ep, int epfd, struct zsock_pollfd *pfds,
+				struct epoll_item **items)
+{
+	k_spinlock_key_t key;
+	int count = 1;
+
+	/* The instance itself wakes up the poll when the ready list fills */
+	pfds[0].fd = epfd;
+	pfds[0].events = ZSOCK_POLLIN;
+	items[0] = NULL;
+
+	key = k_spin_lock(&ep->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		struct epoll_item *item = &ep->items[i];
+
+		if (!item->in_use || !item->polled || item->disabled) {
+			continue;
+		}
+
+		pfds[count].fd = item->fd;
+		pfds[count].events = item->events & EPOLL_POLL_EVENTS;
+		items[count] = item;
+		count++;
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	return count;
+}
+
+static int epoll_wait_internal(struct epoll *ep, int epfd, struct zsock_epoll_event *events,
+			       int maxevents, k_timeout_t timeout)
+{
+	struct zsock_pollfd pfds[EPOLL_POLLED_MAX + 1];
+	struct epoll_item *items[EPOLL_POLLED_MAX + 1];
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int count;
+	int ret;
+
+	do {
+		int npfds;
+
+		k_poll_signal_reset(&ep->signal);
+
+		count = epoll_collect_ready(ep, events, maxevents);
+		if (count == maxevents) {
+			break;
+		}
+
+		npfds = epoll_prepare_polled(ep, epfd, pfds, items);
+		if (npfds > 1) {
+			ret = zsock_poll_internal(pfds, npfds,
+						  count > 0 ? K_NO_WAIT : sys_timepoint_timeout(end));
+			if (ret < 0) {
+				return -1;
+			}
+
+			for (int i = 1; i < npfds && count < maxevents; i++) {
+				if (pfds[i].revents == 0) {
+					continue;
+				}
+
+				if (epoll_report(ep, items[i], pfds[i].fd, pfds[i].revents,
+						 &events[count])) {
+					count++;
+				}
+			}
+
+			continue;
+		}
+
+		if (count > 0) {
+			break;
+		}
+
+		if (!epoll_has_ready(ep)) {
+			struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+				K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+
+			ret = k_poll(&event, 1, sys_timepoint_timeout(end));
+			if (ret == -EAGAIN) {
+				break;
+			}
+		}
+	} while (count == 0 && !sys_timepoint_expired(end));
+
+	return count;
+}
+
+static int epoll_ctl_add(struct epoll *ep, int fd, void *obj, struct zsock_epoll_event *event)
+{
+	struct epoll_item *item = NULL;
+	k_spinlock_key_t key;
+	int ret;
+
+	key = k_spin_lock(&ep->lock);
+
+	if (epoll_find_locked(ep, fd) != NULL) {
+		k_spin_unlock(&ep->lock, key);
+		return -EEXIST;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (!ep->items[i].in_use) {
+			item = &ep->items[i];
+			break;
+		}
+	}
+
+	if (item == NULL) {
+		k_spin_unlock(&ep->lock, key);
+		return -ENOSPC;
+	}
+
+	item->in_use = true;
+	item->ready = false;
+	item->attached = false;
+	item->polled = false;
+	item->disabled = false;
+	item->ep = ep;
+	item->obj = obj;
+	item->fd = fd;
+	item->events = event->events;
+	item->data = event->data;
+
+	k_spin_unlock(&ep->lock, key);
+
+	ret = epoll_attach(fd, obj, item);
+
+	key = k_spin_lock(&ep->lock);
+
+	item->attached = (ret == 0);
+
+	if (!item->attached || (item->events & ZSOCK_EPOLLOUT)) {
+		if (epoll_polled_count_locked(ep) >= EPOLL_POLLED_MAX) {
+			bool attached = item->attached;
+
+			k_spin_unlock(&ep->lock, key);
+
+			/* Detach before freeing so that the item cannot be
+			 * released by the socket once reused.
+			 */
+			if (attached) {
+				(void)epoll_attach(fd, obj, NULL);
+			}
+
+			key = k_spin_lock(&ep->lock);
+			epoll_free_locked(ep, item);
+			k_spin_unlock(&ep->lock, key);
+
+			return -ENOMEM;
+		}
+
+		item->polled = true;
+	}
+
+	/* Check the current state on the next wait */
+	epoll_queue_locked(ep, item);
+
+	k_spin_unlock(&ep->lock, key);
+
+	k_poll_signal_raise(&ep->signal, 0);
+
+	return 0;
+}
+
+static int epoll_ctl_mod(struct epoll *ep, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	bool polled;
+	int ret = 0;
+
+	key = k_spin_lock(&ep->lock);
+
+	item = epoll_find_locked(ep, fd);
+	if (item == NULL) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	polled = !item->attached || (event->events & ZSOCK_EPOLLOUT);
+	if (polled && !item->polled && epoll_polled_count_locked(ep) >= EPOLL_POLLED_MAX) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	if (polled && item->ready) {
+		(void)sys_slist_find_and_remove(&ep->ready, &item->node);
+		item->ready = false;
+	}
+
+	item->polled = polled;
+	item->events = event->events;
+	item->data = event->data;
+	item->disabled = false;
+
+	/* Check the current state on the next wait */
+	epoll_queue_locked(ep, item);
+
+out:
+	k_spin_unlock(&ep->lock, key);
+
+	if (ret == 0) {
+		k_poll_signal_raise(&ep->signal, 0);
+	}
+
+	return ret;
+}
+
+static int epoll_ctl_del(struct epoll *ep, int fd)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	bool attached;
+	void *obj;
+
+	key = k_spin_lock(&ep->lock);
+
+	item = epoll_find_locked(ep, fd);
+	if (item == NULL) {
+		k_spin_unlock(&ep->lock, key);
+		return -ENOENT;
+	}
+
+	attached = item->attached;
+	obj = item->obj;
+
+	k_spin_unlock(&ep->lock, key);
+
+	/* Detach before freeing so that the item cannot be released by the
+	 * socket once reused.
+	 */
+	if (attached) {
+		(void)epoll_attach(fd, obj, NULL);
+	}
+
+	key = k_spin_lock(&ep->lock);
+
+	if (item->in_use && item->fd == fd) {
+		epoll_free_locked(ep, item);
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	return 0;
+}
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct epoll *ep = NULL;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	k_mutex_lock(&epolls_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			break;
+		}
+	}
+
+	if (ep == NULL) {
+		k_mutex_unlock(&epolls_lock);
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	memset(ep->items, 0, sizeof(ep->items));
+	sys_slist_init(&ep->ready);
+	k_poll_signal_init(&ep->signal);
+	ep->in_use = true;
+
+	k_mutex_unlock(&epolls_lock);
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <zephyr/syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll *ep;
+	void *obj;
+	int ret;
+
+	ep = epoll_get(epfd);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	obj = z_get_fd_obj(fd, NULL, EBADF);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	if (obj == ep || (op != ZSOCK_EPOLL_CTL_DEL && event == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_ctl_add(ep, fd, obj, event);
+		break;
+	case ZSOCK_EPOLL_CTL_MOD:
+		ret = epoll_ctl_mod(ep, fd, event);
+		break;
+	case ZSOCK_EPOLL_CTL_DEL:
+		ret = epoll_ctl_del(ep, fd);
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (op == ZSOCK_EPOLL_CTL_DEL || event == NULL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, NULL);
+	}
+
+	K_OOPS(k_usermode_from_copy(&event_copy, event, sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <zephyr/syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events, int maxevents,
+			    int timeout)
+{
+	struct epoll *ep;
+
+	ep = epoll_get(epfd);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return epoll_wait_internal(ep, epfd, events, maxevents,
+				   timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (maxevents > 0) {
+		K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents, sizeof(*events)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <zephyr/syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll *ep = obj;
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		struct epoll_item *item = &ep->items[i];
+
+		if (item->in_use) {
+			(void)epoll_ctl_del(ep, item->fd);
+		}
+	}
+
+	k_mutex_lock(&epolls_lock, K_FOREVER);
+	ep->in_use = false;
+	k_mutex_unlock(&epolls_lock);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	struct epoll *ep = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		(*pev)->obj = &ep->signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		return epoll_has_ready(ep) ? -EALREADY : 0;
+	}
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (pfd->events & ZSOCK_POLLIN) {
+			if (epoll_has_ready(ep)) {
+				pfd->revents |= ZSOCK_POLLIN;
+			}
+			(*pev)++;
+		}
+
+		return 0;
+	}
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
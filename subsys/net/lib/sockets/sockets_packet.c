@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2019 Intel Corporation
  * Copyright (c) 2021 Nordic Semiconductor
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -14,6 +15,7 @@ LOG_MODULE_REGISTER(net_sock_packet, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/entropy.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/socket.h>
@@ -77,12 +79,211 @@ static int zpacket_socket(int family, int type, int proto)
 
 	/* recv_q and accept_q are in union */
 	k_fifo_init(&ctx->recv_q);
+
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	k_mutex_init(&ctx->rx_ring.lock);
+	k_poll_signal_init(&ctx->rx_ring.signal);
+	ctx->rx_ring.frames = NULL;
+#endif
+
 	z_finalize_fd(fd, ctx,
 		      (const struct fd_op_vtable *)&packet_sock_fd_op_vtable);
 
 	return fd;
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+static inline struct packet_rx_frame *zpacket_ring_frame(struct net_context *ctx,
+							 uint32_t idx)
+{
+	return (struct packet_rx_frame *)(ctx->rx_ring.frames +
+					  idx * ctx->rx_ring.frame_size);
+}
+
+/* Copies the packet into the next slot, which the application must have
+ * given back. Returns false if the ring is unset, so the packet is queued.
+ */
+static bool zpacket_ring_put(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct packet_rx_frame *frame;
+	uint32_t status = TP_STATUS_USER;
+	uint32_t len;
+	uint32_t snaplen;
+
+	k_mutex_lock(&ctx->rx_ring.lock, K_FOREVER);
+
+	if (ctx->rx_ring.frames == NULL) {
+		k_mutex_unlock(&ctx->rx_ring.lock);
+		return false;
+	}
+
+	frame = zpacket_ring_frame(ctx, ctx->rx_ring.head);
+	if (frame->status != TP_STATUS_KERNEL) {
+		NET_DBG("ctx=%p ring full, dropping pkt=%p", ctx, pkt);
+		ctx->rx_ring.losing = true;
+		goto out;
+	}
+
+	/* Do not write the slot before seeing it was given back */
+	barrier_dmem_fence_full();
+
+	len = net_pkt_get_len(pkt);
+	snaplen = MIN(len, ctx->rx_ring.frame_size - sizeof(struct packet_rx_frame));
+	if (net_pkt_read(pkt, PACKET_RX_FRAME_DATA(frame), snaplen)) {
+		goto out;
+	}
+
+	if (snaplen < len) {
+		status |= TP_STATUS_COPY;
+	}
+
+	if (ctx->rx_ring.losing) {
+		status |= TP_STATUS_LOSING;
+		ctx->rx_ring.losing = false;
+	}
+
+	frame->len = len;
+	frame->snaplen = snaplen;
+	frame->ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	/* The application may read the slot as soon as it sees the status */
+	barrier_dmem_fence_full();
+	frame->status = status;
+
+	ctx->rx_ring.head = (ctx->rx_ring.head + 1) % ctx->rx_ring.frame_nr;
+	k_poll_signal_raise(&ctx->rx_ring.signal, 0);
+
+out:
+	k_mutex_unlock(&ctx->rx_ring.lock);
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+/* Must be called with the ring lock held */
+static bool zpacket_ring_ready(struct net_context *ctx)
+{
+	if (ctx->rx_ring.frames == NULL) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < ctx->rx_ring.frame_nr; i++) {
+		if (zpacket_ring_frame(ctx, i)->status & TP_STATUS_USER) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int zpacket_ring_set(struct net_context *ctx, const void *optval,
+			    socklen_t optlen)
+{
+	const struct packet_rx_ring *ring = optval;
+
+	if (optval == NULL || optlen != sizeof(struct packet_rx_ring)) {
+		return -EINVAL;
+	}
+
+	if (ring->frames != NULL && ring->frame_nr > 0U &&
+	    (!IS_ALIGNED(ring->frames, sizeof(uint32_t)) ||
+	     !IS_ALIGNED(ring->frame_size, sizeof(uint32_t)) ||
+	     ring->frame_size <= sizeof(struct packet_rx_frame) ||
+	     ring->frame_nr > UINT32_MAX / ring->frame_size)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ctx->rx_ring.lock, K_FOREVER);
+
+	if (ring->frames == NULL || ring->frame_nr == 0U) {
+		ctx->rx_ring.frames = NULL;
+	} else {
+		ctx->rx_ring.frames = ring->frames;
+		ctx->rx_ring.frame_size = ring->frame_size;
+		ctx->rx_ring.frame_nr = ring->frame_nr;
+		ctx->rx_ring.head = 0U;
+		ctx->rx_ring.losing = false;
+
+		for (uint32_t i = 0; i < ring->frame_nr; i++) {
+			zpacket_ring_frame(ctx, i)->status = TP_STATUS_KERNEL;
+		}
+	}
+
+	k_mutex_unlock(&ctx->rx_ring.lock);
+
+	return 0;
+}
+
+static int zpacket_ring_poll_prepare(struct net_context *ctx,
+				     struct zsock_pollfd *pfd,
+				     struct k_poll_event **pev,
+				     struct k_poll_event *pev_end)
+{
+	bool ready;
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		/* Reset before checking the slots, so no frame is missed */
+		k_poll_signal_reset(&ctx->rx_ring.signal);
+
+		(*pev)->obj = &ctx->rx_ring.signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		return -EALREADY;
+	}
+
+	k_mutex_lock(&ctx->rx_ring.lock, K_FOREVER);
+	ready = zpacket_ring_ready(ctx);
+	k_mutex_unlock(&ctx->rx_ring.lock);
+
+	if (ready || sock_is_error(ctx)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int zpacket_ring_poll_update(struct net_context *ctx,
+				    struct zsock_pollfd *pfd,
+				    struct k_poll_event **pev)
+{
+	if (pfd->events & ZSOCK_POLLIN) {
+		bool ready;
+
+		k_mutex_lock(&ctx->rx_ring.lock, K_FOREVER);
+		ready = zpacket_ring_ready(ctx);
+		k_mutex_unlock(&ctx->rx_ring.lock);
+
+		if (ready) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (sock_is_error(ctx)) {
+		pfd->revents |= ZSOCK_POLLERR;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
+
 static void zpacket_received_cb(struct net_context *ctx,
 				struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
@@ -116,6 +317,12 @@ static void zpacket_received_cb(struct net_context *ctx,
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (zpacket_ring_put(ctx, pkt)) {
+		return;
+	}
+#endif
+
 	k_fifo_put(&ctx->recv_q, pkt);
 }
 
@@ -374,6 +581,19 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (level == SOL_PACKET && optname == PACKET_RX_RING) {
+		int ret = zpacket_ring_set(ctx, optval, optlen);
+
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -392,6 +612,35 @@ static ssize_t packet_sock_write_vmeth(void *obj, const void *buffer,
 static int packet_sock_ioctl_vmeth(void *obj, unsigned int request,
 				   va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	struct net_context *ctx = obj;
+
+	/* Frames delivered to the ring are not in recv_q, poll the ring */
+	if (ctx->rx_ring.frames != NULL) {
+		if (request == ZFD_IOCTL_POLL_PREPARE) {
+			struct zsock_pollfd *pfd;
+			struct k_poll_event **pev;
+			struct k_poll_event *pev_end;
+
+			pfd = va_arg(args, struct zsock_pollfd *);
+			pev = va_arg(args, struct k_poll_event **);
+			pev_end = va_arg(args, struct k_poll_event *);
+
+			return zpacket_ring_poll_prepare(ctx, pfd, pev, pev_end);
+		}
+
+		if (request == ZFD_IOCTL_POLL_UPDATE) {
+			struct zsock_pollfd *pfd;
+			struct k_poll_event **pev;
+
+			pfd = va_arg(args, struct zsock_pollfd *);
+			pev = va_arg(args, struct k_poll_event **);
+
+			return zpacket_ring_poll_update(ctx, pfd, pev);
+		}
+	}
+#endif
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
@@ -463,6 +712,15 @@ static int packet_sock_setsockopt_vmeth(void *obj, int level, int optname,
 
 static int packet_sock_close_vmeth(void *obj)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	struct net_context *ctx = obj;
+
+	/* The application may free the ring memory once closed */
+	k_mutex_lock(&ctx->rx_ring.lock, K_FOREVER);
+	ctx->rx_ring.frames = NULL;
+	k_mutex_unlock(&ctx->rx_ring.lock);
+#endif
+
 	return zsock_close_ctx(obj);
 }
 
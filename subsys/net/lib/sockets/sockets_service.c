@@ -10,18 +10,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
-#include <zephyr/posix/sys/eventfd.h>
-
-/* Next checks makes sure that we are not trying to use this library
- * with eventfd if CONFIG_POSIX_API is not set and if using native_sim
- * based board. The reason is that we should always use zephyr libc based
- * eventfd implementation instead of host libc one.
- */
-#if defined(CONFIG_NATIVE_LIBC) && defined(CONFIG_EVENTFD)
-#error "The eventfd support CONFIG_EVENTFD will not work with host libc "
-	"so you need to enable CONFIG_POSIX_API in this case which will turn "
-	"off the host libc usage."
-#endif
+#include <zephyr/net/socket_epoll.h>
 
 static int init_socket_service(void);
 static bool init_done;
@@ -32,12 +21,10 @@ static K_CONDVAR_DEFINE(wait_start);
 STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
-static struct service {
-	struct zsock_pollfd events[CONFIG_NET_SOCKETS_POLL_MAX];
-	int count;
-} ctx;
+/* Epoll instance monitoring the sockets of all the services */
+static int epfd = -1;
 
-#define get_idx(svc) (*(svc->idx))
+#define SERVICE_EVENTS_MAX 4
 
 void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 {
@@ -46,10 +33,32 @@ void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 	}
 }
 
+/* The registration is disabled once it has been reported and armed again
+ * when the callback returns, so that the callback is not called a second
+ * time while we are servicing it.
+ */
+static int arm_event(struct net_socket_service_event *pev, int op)
+{
+	struct zsock_epoll_event event = {
+		.events = pev->event.events | ZSOCK_EPOLLONESHOT,
+		.data.ptr = pev,
+	};
+
+	if (zsock_epoll_ctl(epfd, op, pev->event.fd, &event) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
 static void cleanup_svc_events(const struct net_socket_service_desc *svc)
 {
 	for (int i = 0; i < svc->pev_len; i++) {
-		ctx.events[get_idx(svc) + i].fd = -1;
+		if (svc->pev[i].event.fd >= 0) {
+			(void)zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL,
+					      svc->pev[i].event.fd, NULL);
+		}
+
 		svc->pev[i].event.fd = -1;
 		svc->pev[i].event.events = 0;
 	}
@@ -72,29 +81,35 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		goto out;
 	}
 
-	if (fds == NULL) {
-		cleanup_svc_events(svc);
-	} else {
-		if (len > svc->pev_len) {
-			NET_DBG("Too many file descriptors, "
-				"max is %d for service %p",
-				svc->pev_len, svc);
-			ret = -ENOMEM;
-			goto out;
-		}
+	if (fds != NULL && len > svc->pev_len) {
+		NET_DBG("Too many file descriptors, "
+			"max is %d for service %p",
+			svc->pev_len, svc);
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	cleanup_svc_events(svc);
+
+	for (i = 0; fds != NULL && i < len; i++) {
+		svc->pev[i].event = fds[i];
+		svc->pev[i].user_data = user_data;
+		svc->pev[i].svc = (struct net_socket_service_desc *)svc;
 
-		for (i = 0; i < len; i++) {
-			svc->pev[i].event = fds[i];
-			svc->pev[i].user_data = user_data;
+		if (fds[i].fd < 0) {
+			continue;
 		}
 
-		for (i = 0; i < svc->pev_len; i++) {
-			ctx.events[get_idx(svc) + i] = svc->pev[i].event;
+		ret = arm_event(&svc->pev[i], ZSOCK_EPOLL_CTL_ADD);
+		if (ret == -EEXIST) {
+			NET_WARN("Socket %d is already monitored", fds[i].fd);
+		} else if (ret < 0) {
+			NET_DBG("Cannot monitor socket %d (%d)", fds[i].fd, ret);
+			cleanup_svc_events(svc);
+			goto out;
 		}
 	}
 
-	/* Tell the thread to re-read the variables */
-	eventfd_write(ctx.events[0].fd, 1);
 	ret = 0;
 
 out:
@@ -103,27 +118,6 @@ out:
 	return ret;
 }
 
-static struct net_socket_service_desc *find_svc_and_event(
-	struct zsock_pollfd *pev,
-	struct net_socket_service_event **event)
-{
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int i = 0; i < svc->pev_len; i++) {
-			if (svc->pev[i].event.fd == pev->fd) {
-				*event = &svc->pev[i];
-				return svc;
-			}
-		}
-	}
-
-	return NULL;
-}
-
-/* We do not set the user callback to our work struct because we need to
- * hook into the flow and restore the global poll array so that the next poll
- * round will not notice it and call the callback again while we are
- * servicing the callback.
- */
 void net_socket_service_callback(struct k_work *work)
 {
 	struct net_socket_service_event *pev =
@@ -133,24 +127,24 @@ void net_socket_service_callback(struct k_work *work)
 
 	ev.callback(&ev.work);
 
-	/* Copy back the socket fd to the global array because we marked
-	 * it as -1 when triggering the work.
+	/* Arm the events of the service again. The callback may also have
+	 * registered a new set of sockets meanwhile.
 	 */
+	k_mutex_lock(&lock, K_FOREVER);
+
 	for (int i = 0; i < svc->pev_len; i++) {
-		ctx.events[get_idx(svc) + i] = svc->pev[i].event;
+		if (svc->pev[i].event.fd >= 0) {
+			(void)arm_event(&svc->pev[i], ZSOCK_EPOLL_CTL_MOD);
+		}
 	}
+
+	k_mutex_unlock(&lock);
 }
 
-static int call_work(struct zsock_pollfd *pev, struct k_work_q *work_q,
-		     struct k_work *work)
+static int call_work(struct k_work_q *work_q, struct k_work *work)
 {
 	int ret = 0;
 
-	/* Mark the global fd non pollable so that we do not
-	 * call the callback second time.
-	 */
-	pev->fd = -1;
-
 	if (work->handler == NULL) {
 		/* Synchronous call */
 		net_socket_service_callback(work);
@@ -168,30 +162,22 @@ static int call_work(struct zsock_pollfd *pev, struct k_work_q *work_q,
 
 }
 
-static int trigger_work(struct zsock_pollfd *pev)
+static int trigger_work(struct net_socket_service_event *event, uint32_t revents)
 {
-	struct net_socket_service_event *event;
-	struct net_socket_service_desc *svc;
+	struct net_socket_service_desc *svc = event->svc;
 
-	svc = find_svc_and_event(pev, &event);
-	if (svc == NULL) {
-		return -ENOENT;
-	}
-
-	event->svc = svc;
-
-	/* Copy the triggered event to our event so that we know what
-	 * was actually causing the event.
+	/* Store the triggered events so that we know what was actually
+	 * causing the event.
 	 */
-	event->event = *pev;
+	event->event.revents = revents;
 
-	return call_work(pev, svc->work_q, &event->work);
+	return call_work(svc->work_q, &event->work);
 }
 
 static void socket_service_thread(void)
 {
-	int ret, i, fd, count = 0;
-	eventfd_t value;
+	struct zsock_epoll_event events[SERVICE_EVENTS_MAX];
+	int ret, i, count = 0;
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
 	if (ret == 0) {
@@ -199,86 +185,50 @@ static void socket_service_thread(void)
 		goto fail;
 	}
 
-	/* Create contiguous poll event array to enable socket polling */
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
 		NET_DBG("Service %s has %d pollable sockets",
 			COND_CODE_1(CONFIG_NET_SOCKETS_LOG_LEVEL_DBG,
 				    (svc->owner), ("")),
 			svc->pev_len);
-		get_idx(svc) = count + 1;
 		count += svc->pev_len;
 	}
 
-	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
+	if (count > CONFIG_NET_SOCKETS_EPOLL_MAX_FDS) {
 		NET_ERR("You have %d services to monitor but "
-			"%zd poll entries configured.",
-			count + 1, ARRAY_SIZE(ctx.events));
+			"%d epoll entries configured.",
+			count, CONFIG_NET_SOCKETS_EPOLL_MAX_FDS);
 		NET_ERR("Please increase value of %s to at least %d",
-			"CONFIG_NET_SOCKETS_POLL_MAX", count + 1);
+			"CONFIG_NET_SOCKETS_EPOLL_MAX_FDS", count);
 		goto fail;
 	}
 
 	NET_DBG("Monitoring %d socket entries", count);
 
-	ctx.count = count + 1;
-
-	/* Create an eventfd that can be used to trigger events during polling */
-	fd = eventfd(0, 0);
-	if (fd < 0) {
-		fd = -errno;
-		NET_ERR("eventfd failed (%d)", fd);
-		goto out;
+	/* Create the epoll instance the sockets are registered to */
+	epfd = zsock_epoll_create(0);
+	if (epfd < 0) {
+		NET_ERR("epoll create failed (%d)", -errno);
+		goto fail;
 	}
 
+	k_mutex_lock(&lock, K_FOREVER);
 	init_done = true;
 	k_condvar_broadcast(&wait_start);
-
-	ctx.events[0].fd = fd;
-	ctx.events[0].events = ZSOCK_POLLIN;
-
-restart:
-	i = 1;
-
-	k_mutex_lock(&lock, K_FOREVER);
-
-	/* Copy individual events to the big array */
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int j = 0; j < svc->pev_len; j++) {
-			ctx.events[get_idx(svc) + j] = svc->pev[j].event;
-		}
-	}
-
 	k_mutex_unlock(&lock);
 
 	while (true) {
-		ret = zsock_poll(ctx.events, count + 1, -1);
+		ret = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
 		if (ret < 0) {
 			ret = -errno;
-			NET_ERR("poll failed (%d)", ret);
+			NET_ERR("epoll wait failed (%d)", ret);
 			goto out;
 		}
 
-		if (ret == 0) {
-			/* should not happen because timeout is -1 */
-			break;
-		}
-
-		if (ret > 0 && ctx.events[0].revents) {
-			eventfd_read(ctx.events[0].fd, &value);
-			NET_DBG("Received restart event.");
-			goto restart;
-		}
-
-		for (i = 1; i < (count + 1); i++) {
-			if (ctx.events[i].fd < 0) {
-				continue;
-			}
+		for (i = 0; i < ret; i++) {
+			int err = trigger_work(events[i].data.ptr, events[i].events);
 
-			if (ctx.events[i].revents > 0) {
-				ret = trigger_work(&ctx.events[i]);
-				if (ret < 0) {
-					NET_DBG("Triggering work failed (%d)", ret);
-				}
+			if (err < 0) {
+				NET_DBG("Triggering work failed (%d)", err);
 			}
 		}
 	}
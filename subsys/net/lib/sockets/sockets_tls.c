@@ -68,6 +68,12 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define DTLS_SENDMSG_BUF_SIZE 0
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE)
+#define TLS_SENDMSG_BUF_SIZE (CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE)
+#else
+#define TLS_SENDMSG_BUF_SIZE 0
+#endif /* CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE */
+
 static const struct socket_op_vtable tls_sock_fd_op_vtable;
 
 #ifndef MBEDTLS_ERR_SSL_PEER_VERIFY_FAILED
@@ -223,6 +229,11 @@ __net_socket struct tls_context {
 	socklen_t dtls_peer_addrlen;
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if TLS_SENDMSG_BUF_SIZE > 0
+	/** Buffer to coalesce the sendmsg() data into full TLS records. */
+	uint8_t sendmsg_buf[TLS_SENDMSG_BUF_SIZE];
+#endif
+
 #if defined(CONFIG_MBEDTLS)
 	/** mbedTLS context. */
 	mbedtls_ssl_context ssl;
@@ -2511,6 +2522,65 @@ static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 	return len;
 }
 
+#if TLS_SENDMSG_BUF_SIZE > 0
+static ssize_t tls_sendmsg_merge_and_send(struct tls_context *ctx,
+					  const struct msghdr *msg,
+					  int flags)
+{
+	size_t total = 0;
+	size_t iov_idx = 0;
+	size_t iov_off = 0;
+
+	do {
+		size_t len = 0;
+		size_t sent = 0;
+		ssize_t ret;
+
+		/* Linearize as much data as fits, so that mbedTLS can encrypt
+		 * it into full-size records instead of one per buffer.
+		 */
+		while (iov_idx < msg->msg_iovlen && len < sizeof(ctx->sendmsg_buf)) {
+			struct iovec *vec = msg->msg_iov + iov_idx;
+			size_t chunk = MIN(vec->iov_len - iov_off,
+					   sizeof(ctx->sendmsg_buf) - len);
+
+			memcpy(ctx->sendmsg_buf + len,
+			       (uint8_t *)vec->iov_base + iov_off, chunk);
+			len += chunk;
+			iov_off += chunk;
+
+			if (iov_off == vec->iov_len) {
+				iov_idx++;
+				iov_off = 0;
+			}
+		}
+
+		if (len == 0) {
+			break;
+		}
+
+		while (sent < len) {
+			ret = send_tls(ctx, ctx->sendmsg_buf + sent, len - sent,
+				       flags);
+			if (ret < 0) {
+				/* Report the data already passed to mbedTLS */
+				if (total + sent > 0) {
+					return total + sent;
+				}
+
+				return ret;
+			}
+
+			sent += ret;
+		}
+
+		total += sent;
+	} while (true);
+
+	return total;
+}
+#endif /* TLS_SENDMSG_BUF_SIZE > 0 */
+
 ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
 			 int flags)
 {
@@ -2543,6 +2613,12 @@ ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
 		}
 	}
 
+#if TLS_SENDMSG_BUF_SIZE > 0
+	if (ctx->type == SOCK_STREAM && msghdr_non_empty_iov_count(msg) > 1) {
+		return tls_sendmsg_merge_and_send(ctx, msg, flags);
+	}
+#endif
+
 send_loop:
 	return tls_sendmsg_loop_and_send(ctx, msg, flags);
 }
@@ -3671,7 +3747,9 @@ static int tls_sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	switch (request) {
 	/* fcntl() commands */
 	case F_GETFL:
-	case F_SETFL: {
+	case F_SETFL:
+	/* Epoll notifications come from the underlying socket */
+	case ZFD_IOCTL_EPOLL_ATTACH: {
 		const struct fd_op_vtable *vtable;
 		struct k_mutex *lock;
 		void *fd_obj;
@@ -6,6 +6,7 @@
 
 /*
  * Copyright (c) 2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -16,13 +17,39 @@ LOG_MODULE_REGISTER(net_trickle, CONFIG_NET_TRICKLE_LOG_LEVEL);
 #include <errno.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/random/random.h>
+#include <zephyr/init.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/trickle.h>
 
 #define TICK_MAX ~0
 
-static void trickle_timeout(struct k_work *work);
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+/* Shared by all the Trickle timers */
+static struct net_timer_wheel trickle_wheel;
+
+static void trickle_wheel_timeout(struct net_timer_wheel_entry *entry);
+#else
+static void trickle_work_timeout(struct k_work *work);
+#endif
+
+static inline void trickle_schedule(struct net_trickle *trickle, uint32_t ms)
+{
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+	net_timer_wheel_add(&trickle_wheel, &trickle->timer, ms);
+#else
+	k_work_reschedule(&trickle->timer, K_MSEC(ms));
+#endif
+}
+
+static inline void trickle_cancel(struct net_trickle *trickle)
+{
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+	net_timer_wheel_remove(&trickle_wheel, &trickle->timer);
+#else
+	trickle_cancel(trickle);
+#endif
+}
 
 static inline bool is_suppression_disabled(struct net_trickle *trickle)
 {
@@ -79,7 +106,7 @@ static void double_interval_timeout(struct net_trickle *trickle)
 	trickle->Istart = k_uptime_get_32() + rand_time;
 	trickle->double_to = false;
 
-	k_work_reschedule(&trickle->timer, K_MSEC(rand_time));
+	trickle_schedule(trickle, rand_time);
 
 	NET_DBG("last end %u new end %u for %u I %u",
 		last_end, get_end(trickle), trickle->Istart, trickle->I);
@@ -100,7 +127,7 @@ static inline void reschedule(struct net_trickle *trickle)
 
 	trickle->double_to = true;
 
-	k_work_reschedule(&trickle->timer, K_MSEC(diff));
+	trickle_schedule(trickle, diff);
 }
 
 static void interval_timeout(struct net_trickle *trickle)
@@ -120,13 +147,8 @@ static void interval_timeout(struct net_trickle *trickle)
 	}
 }
 
-static void trickle_timeout(struct k_work *work)
+static void trickle_timeout(struct net_trickle *trickle)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-	struct net_trickle *trickle = CONTAINER_OF(dwork,
-						   struct net_trickle,
-						   timer);
-
 	if (trickle->double_to) {
 		double_interval_timeout(trickle);
 	} else {
@@ -134,6 +156,32 @@ static void trickle_timeout(struct k_work *work)
 	}
 }
 
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+static void trickle_wheel_timeout(struct net_timer_wheel_entry *entry)
+{
+	trickle_timeout(CONTAINER_OF(entry, struct net_trickle, timer));
+}
+
+static int trickle_wheel_init(void)
+{
+	net_timer_wheel_init(&trickle_wheel, CONFIG_NET_TRICKLE_TIMER_WHEEL_TICK);
+
+	return 0;
+}
+
+SYS_INIT(trickle_wheel_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#else
+static void trickle_work_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct net_trickle *trickle = CONTAINER_OF(dwork,
+						   struct net_trickle,
+						   timer);
+
+	trickle_timeout(trickle);
+}
+#endif
+
 static void setup_new_interval(struct net_trickle *trickle)
 {
 	uint32_t t;
@@ -144,7 +192,7 @@ static void setup_new_interval(struct net_trickle *trickle)
 
 	trickle->Istart = k_uptime_get_32();
 
-	k_work_reschedule(&trickle->timer, K_MSEC(t));
+	trickle_schedule(trickle, t);
 
 	NET_DBG("new interval at %d ends %d t %d I %d",
 		trickle->Istart,
@@ -176,7 +224,11 @@ int net_trickle_create(struct net_trickle *trickle,
 		trickle->Imin, trickle->Imax, trickle->k,
 		trickle->Imax_abs);
 
-	k_work_init_delayable(&trickle->timer, trickle_timeout);
+#if defined(CONFIG_NET_TRICKLE_TIMER_WHEEL)
+	net_timer_wheel_entry_init(&trickle->timer, trickle_wheel_timeout);
+#else
+	k_work_init_delayable(&trickle->timer, trickle_work_timeout);
+#endif
 
 	return 0;
 }
@@ -208,7 +260,7 @@ int net_trickle_stop(struct net_trickle *trickle)
 {
 	NET_ASSERT(trickle);
 
-	k_work_cancel_delayable(&trickle->timer);
+	trickle_cancel(trickle);
 
 	trickle->I = 0U;
 
@@ -6,6 +6,7 @@
 
 /*
  * Copyright (c) 2019 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -543,6 +544,41 @@ static int websocket_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	return 0;
 }
 
+/* Apply the masking value to len bytes of src into dst, which can be
+ * equal to src. The offset is the one of src in the message payload.
+ */
+static void websocket_mask(uint8_t *dst, const uint8_t *src, size_t len,
+			   uint32_t masking_value, size_t offset)
+{
+	uint8_t key[sizeof(uint32_t)];
+	uint32_t key_word;
+	size_t i = 0;
+
+	for (int j = 0; j < sizeof(key); j++) {
+		key[j] = masking_value >> (8 * (3 - (offset + j) % 4));
+	}
+
+	while (i < len && !IS_ALIGNED(&dst[i], sizeof(uint32_t))) {
+		dst[i] = src[i] ^ key[i % 4];
+		i++;
+	}
+
+	/* The key is then applied a word at a time, with its bytes rotated
+	 * to line up with the aligned part of dst.
+	 */
+	for (int j = 0; j < sizeof(key); j++) {
+		((uint8_t *)&key_word)[j] = key[(i + j) % 4];
+	}
+
+	for (; len - i >= sizeof(uint32_t); i += sizeof(uint32_t)) {
+		*(uint32_t *)&dst[i] = UNALIGNED_GET((const uint32_t *)&src[i]) ^ key_word;
+	}
+
+	for (; i < len; i++) {
+		dst[i] = src[i] ^ key[i % 4];
+	}
+}
+
 #if !defined(CONFIG_NET_TEST)
 static int sendmsg_all(int sock, const struct msghdr *message, int flags)
 {
@@ -696,8 +732,6 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
 		ctx->masking_value = sys_rand32_get();
 
 		header[hdr_len++] |= ctx->masking_value >> 24;
@@ -711,11 +745,9 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 				return -ENOMEM;
 			}
 
-			memcpy(data_to_send, payload, payload_len);
-
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
-			}
+			/* The payload is masked while copying it */
+			websocket_mask(data_to_send, payload, payload_len,
+				       ctx->masking_value, 0);
 		}
 	}
 
@@ -1028,15 +1060,10 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
 		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
 
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
-
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
-		}
+		websocket_mask(payload.buf, payload.buf, payload.count,
+			       ctx->masking_value, data_buf_offset);
 	}
 
 	return payload.count;
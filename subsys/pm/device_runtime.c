@@ -163,7 +163,35 @@ static int get_sync_locked(const struct device *dev)
 	return ret;
 }
 
-int pm_device_runtime_get(const struct device *dev)
+/*
+ * Wait until an asynchronous resume completes, called with the lock held.
+ * Drops the usage taken by the caller if the device failed to resume.
+ */
+static int resume_wait_locked(struct pm_device *pm)
+{
+	while (atomic_test_bit(&pm->base.flags, PM_DEVICE_FLAG_RESUMING)) {
+		k_sem_give(&pm->lock);
+
+		/* The event is cleared when the resume is started */
+		k_event_wait(&pm->event, EVENT_MASK, false, K_FOREVER);
+
+		(void)k_sem_take(&pm->lock, K_FOREVER);
+	}
+
+	if (pm->base.state != PM_DEVICE_STATE_ACTIVE) {
+		pm->base.usage--;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * Take a usage reference on the device and resume it if needed. Unless
+ * @p wait is set, an asynchronous resume may still be in progress on
+ * return, the caller then has to use runtime_get_wait().
+ */
+static int runtime_get(const struct device *dev, bool wait)
 {
 	int ret = 0;
 	struct pm_device *pm = dev->pm;
@@ -197,7 +225,9 @@ int pm_device_runtime_get(const struct device *dev)
 		}
 	}
 
-	if (k_is_in_isr() && (pm->base.state == PM_DEVICE_STATE_SUSPENDING)) {
+	if (k_is_in_isr() &&
+	    ((pm->base.state == PM_DEVICE_STATE_SUSPENDING) ||
+	     atomic_test_bit(&pm->base.flags, PM_DEVICE_FLAG_RESUMING))) {
 		ret = -EWOULDBLOCK;
 		goto unlock;
 	}
@@ -252,10 +282,28 @@ int pm_device_runtime_get(const struct device *dev)
 	}
 
 	if (pm->base.usage > 1U) {
+		/* Another user may have started an asynchronous resume */
+		if (wait && !k_is_pre_kernel()) {
+			ret = resume_wait_locked(pm);
+		}
 		goto unlock;
 	}
 
+	/* Set before the callback, which may complete the resume right away */
+	if (!k_is_pre_kernel()) {
+		k_event_clear(&pm->event, EVENT_MASK);
+		atomic_set_bit(&pm->base.flags, PM_DEVICE_FLAG_RESUMING);
+	}
+
 	ret = pm->base.action_cb(pm->dev, PM_DEVICE_ACTION_RESUME);
+	if (ret == -EINPROGRESS) {
+		__ASSERT(!k_is_pre_kernel() && !k_is_in_isr(),
+			 "Asynchronous resume not supported in this context");
+		ret = wait ? resume_wait_locked(pm) : 0;
+		goto unlock;
+	}
+
+	atomic_clear_bit(&pm->base.flags, PM_DEVICE_FLAG_RESUMING);
 	if (ret < 0) {
 		pm->base.usage--;
 		goto unlock;
@@ -274,6 +322,100 @@ end:
 	return ret;
 }
 
+/* Wait for a resume started with runtime_get() without waiting */
+static int runtime_get_wait(const struct device *dev)
+{
+	struct pm_device *pm = dev->pm;
+	int ret;
+
+	if ((pm == NULL) ||
+	    !atomic_test_bit(&dev->pm_base->flags, PM_DEVICE_FLAG_RUNTIME_ENABLED) ||
+	    atomic_test_bit(&dev->pm_base->flags, PM_DEVICE_FLAG_ISR_SAFE)) {
+		return 0;
+	}
+
+	(void)k_sem_take(&pm->lock, K_FOREVER);
+	ret = resume_wait_locked(pm);
+	k_sem_give(&pm->lock);
+
+	return ret;
+}
+
+int pm_device_runtime_get(const struct device *dev)
+{
+	return runtime_get(dev, true);
+}
+
+int pm_device_runtime_get_many(const struct device *const *devs, size_t count)
+{
+	uint32_t domains = 0U;
+	uint32_t resumed = 0U;
+	size_t started;
+	int ret = 0;
+
+	if (count > 32U) {
+		return -EINVAL;
+	}
+
+	/* Bring up the power domains first, concurrently */
+	for (size_t i = 0; i < count; i++) {
+		const struct device *domain = (devs[i]->pm_base != NULL) ?
+			PM_DOMAIN(devs[i]->pm_base) : NULL;
+
+		if ((domain != NULL) && (runtime_get(domain, false) == 0)) {
+			domains |= BIT(i);
+		}
+	}
+
+	/* Start resuming the devices, each only waits for its own domain */
+	for (started = 0; started < count; started++) {
+		ret = runtime_get(devs[started], false);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < started; i++) {
+		int err = runtime_get_wait(devs[i]);
+
+		if (err == 0) {
+			resumed |= BIT(i);
+		} else if (ret == 0) {
+			ret = err;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if ((ret < 0) && ((resumed & BIT(i)) != 0U)) {
+			(void)pm_device_runtime_put(devs[i]);
+		}
+
+		/* The devices hold their own reference on the domain now */
+		if (((domains & BIT(i)) != 0U) &&
+		    (runtime_get_wait(PM_DOMAIN(devs[i]->pm_base)) == 0)) {
+			(void)pm_device_runtime_put(PM_DOMAIN(devs[i]->pm_base));
+		}
+	}
+
+	return ret;
+}
+
+void pm_device_runtime_resume_complete(const struct device *dev, int status)
+{
+	struct pm_device *pm = dev->pm;
+
+	__ASSERT(atomic_test_bit(&pm->base.flags, PM_DEVICE_FLAG_RESUMING),
+		 "No resume in progress");
+
+	/*
+	 * Waiters hold a usage reference, nothing else changes the state
+	 * until the flag is cleared. The event is set last to wake them.
+	 */
+	pm->base.state = (status == 0) ? PM_DEVICE_STATE_ACTIVE : PM_DEVICE_STATE_SUSPENDED;
+	atomic_clear_bit(&pm->base.flags, PM_DEVICE_FLAG_RESUMING);
+	k_event_set(&pm->event, BIT(pm->base.state));
+}
+
 
 static int put_sync_locked(const struct device *dev)
 {
@@ -69,4 +69,8 @@ void pm_stats_update(enum pm_state state)
 	STATS_INC(stats[cpu][state], state_count);
 	STATS_INCN(stats[cpu][state], state_total_cycles, time_total);
 	STATS_SET(stats[cpu][state], state_last_cycles, time_total);
+
+#ifdef CONFIG_PM_POLICY_RESIDENCY_PREDICTOR
+	pm_policy_residency_update(cpu, time_total);
+#endif /* CONFIG_PM_POLICY_RESIDENCY_PREDICTOR */
 }
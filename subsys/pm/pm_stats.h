@@ -20,4 +20,9 @@ static inline void pm_stats_stop(void) {}
 static inline void pm_stats_update(enum pm_state state) {}
 #endif /* CONFIG_PM_STATS */
 
+#ifdef CONFIG_PM_POLICY_RESIDENCY_PREDICTOR
+/* Feeds the residency measured by the stats back to the default policy */
+void pm_policy_residency_update(uint8_t cpu, uint32_t residency_cyc);
+#endif /* CONFIG_PM_POLICY_RESIDENCY_PREDICTOR */
+
 #endif /* ZEPHYR_SUBSYS_PM_PM_STATS_H_ */
@@ -16,6 +16,8 @@
 #include <zephyr/toolchain.h>
 #include <zephyr/pm/device.h>
 
+#include "pm_stats.h"
+
 #if DT_HAS_COMPAT_STATUS_OKAY(zephyr_power_state)
 
 #define DT_SUB_LOCK_INIT(node_id)				\
@@ -130,6 +132,56 @@ static void update_next_event(uint32_t cyc)
 	next_event_cyc = new_next_event_cyc;
 }
 
+#ifdef CONFIG_PM_POLICY_RESIDENCY_PREDICTOR
+/** Ratio of measured to expected residency in 1/256 units */
+#define PREDICT_ONE BIT(8)
+/** Lowest ratio, keeps deeper states reachable once idle periods lengthen */
+#define PREDICT_MIN (PREDICT_ONE / 4U)
+
+static uint16_t predict_ratio[CONFIG_MP_MAX_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_MAX_NUM_CPUS - 1)] = PREDICT_ONE,
+};
+/** Residency expected by the last state selection, 0 if unknown */
+static uint32_t predict_expected_cyc[CONFIG_MP_MAX_NUM_CPUS];
+
+void pm_policy_residency_update(uint8_t cpu, uint32_t residency_cyc)
+{
+	uint32_t expected_cyc = predict_expected_cyc[cpu];
+	uint32_t ratio;
+
+	if (expected_cyc == 0U) {
+		return;
+	}
+
+	predict_expected_cyc[cpu] = 0U;
+	ratio = (uint32_t)MIN((uint64_t)residency_cyc * PREDICT_ONE / expected_cyc,
+			      PREDICT_ONE);
+
+	/* Exponential moving average with a weight of 1/8 */
+	ratio = predict_ratio[cpu] - (predict_ratio[cpu] >> 3) + (ratio >> 3);
+	predict_ratio[cpu] = MAX(ratio, PREDICT_MIN);
+}
+
+static int64_t predict_residency(uint8_t cpu, int64_t cyc)
+{
+	if (cyc < 0) {
+		predict_expected_cyc[cpu] = 0U;
+		return cyc;
+	}
+
+	predict_expected_cyc[cpu] = (uint32_t)MIN(cyc, UINT32_MAX);
+
+	return cyc * predict_ratio[cpu] / PREDICT_ONE;
+}
+#else
+static inline int64_t predict_residency(uint8_t cpu, int64_t cyc)
+{
+	ARG_UNUSED(cpu);
+
+	return cyc;
+}
+#endif /* CONFIG_PM_POLICY_RESIDENCY_PREDICTOR */
+
 #ifdef CONFIG_PM_POLICY_DEFAULT
 const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
 {
@@ -170,6 +222,8 @@ const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
 		}
 	}
 
+	cyc = predict_residency(cpu, cyc);
+
 	for (int16_t i = (int16_t)num_cpu_states - 1; i >= 0; i--) {
 		const struct pm_state_info *state = &cpu_states[i];
 		uint32_t min_residency_cyc, exit_latency_cyc;
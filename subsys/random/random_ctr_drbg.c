@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2019, NXP
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -50,6 +51,29 @@ static TCCtrPrng_t ctr_ctx;
 
 #endif /* CONFIG_MBEDTLS */
 
+#if CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0
+/*
+ * Each CPU serves small requests from a buffer of bytes generated ahead,
+ * refilled in a single batch when it runs out. Bytes are wiped from the
+ * buffer as soon as they are handed out.
+ */
+struct ctr_drbg_cpu_buf {
+	struct k_spinlock lock;
+	/* Bytes left, at the end of data */
+	uint32_t avail;
+	uint8_t data[CONFIG_CS_CTR_DRBG_BUFFER_SIZE];
+};
+
+static struct ctr_drbg_cpu_buf ctr_cpu_bufs[CONFIG_MP_MAX_NUM_CPUS];
+/* Batch being generated, protected by ctr_lock */
+static uint8_t ctr_batch[CONFIG_CS_CTR_DRBG_BUFFER_SIZE];
+#endif /* CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0 */
+
+#if CONFIG_CS_CTR_DRBG_RESEED_PERIOD > 0
+static void ctr_drbg_reseed_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(ctr_reseed_work, ctr_drbg_reseed_handler);
+#endif /* CONFIG_CS_CTR_DRBG_RESEED_PERIOD > 0 */
 
 static int ctr_drbg_initialize(void)
 {
@@ -99,21 +123,51 @@ static int ctr_drbg_initialize(void)
 
 #endif
 	ctr_initialised = true;
+
+#if CONFIG_CS_CTR_DRBG_RESEED_PERIOD > 0
+	k_work_schedule(&ctr_reseed_work, K_SECONDS(CONFIG_CS_CTR_DRBG_RESEED_PERIOD));
+#endif /* CONFIG_CS_CTR_DRBG_RESEED_PERIOD > 0 */
+
 	return 0;
 }
 
-
-int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+/* Must be called with ctr_lock held */
+static int ctr_drbg_reseed(void)
 {
+#if defined(CONFIG_MBEDTLS)
+
+	return mbedtls_ctr_drbg_reseed(&ctr_ctx, NULL, 0) == 0 ? 0 : -EIO;
+
+#elif defined(CONFIG_TINYCRYPT)
+
+	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
 	int ret;
 
-	k_mutex_lock(&ctr_lock, K_FOREVER);
+	ret = entropy_get_entropy(entropy_dev,
+			    (void *)&entropy, sizeof(entropy));
+	if (ret != 0) {
+		return -EIO;
+	}
+
+	ret = tc_ctr_prng_reseed(&ctr_ctx,
+				entropy,
+				sizeof(entropy),
+				drbg_seed,
+				sizeof(drbg_seed));
+
+	return (ret == TC_CRYPTO_SUCCESS) ? 0 : -EIO;
+#endif
+}
+
+/* Must be called with ctr_lock held */
+static int ctr_drbg_generate(uint8_t *dst, uint32_t outlen)
+{
+	int ret;
 
 	if (unlikely(!ctr_initialised)) {
 		ret = ctr_drbg_initialize();
 		if (ret != 0) {
-			ret = -EIO;
-			goto end;
+			return -EIO;
 		}
 	}
 
@@ -123,36 +177,138 @@ int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
 
 #elif defined(CONFIG_TINYCRYPT)
 
-	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
-
-	ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0, (uint8_t *)dst, outlen);
+	ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0, dst, outlen);
 
 	if (ret == TC_CRYPTO_SUCCESS) {
 		ret = 0;
 	} else if (ret == TC_CTR_PRNG_RESEED_REQ) {
-
-		ret = entropy_get_entropy(entropy_dev,
-				    (void *)&entropy, sizeof(entropy));
+		ret = ctr_drbg_reseed();
 		if (ret != 0) {
-			ret = -EIO;
-			goto end;
+			return ret;
 		}
 
-		ret = tc_ctr_prng_reseed(&ctr_ctx,
-					entropy,
-					sizeof(entropy),
-					drbg_seed,
-					sizeof(drbg_seed));
-
-		ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0,
-					   (uint8_t *)dst, outlen);
+		ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0, dst, outlen);
 
 		ret = (ret == TC_CRYPTO_SUCCESS) ? 0 : -EIO;
 	} else {
 		ret = -EIO;
 	}
 #endif
-end:
+
+	return ret;
+}
+
+#if CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0
+static struct ctr_drbg_cpu_buf *ctr_drbg_cpu_buf_lock(unsigned int *irq_key,
+						      k_spinlock_key_t *key)
+{
+	struct ctr_drbg_cpu_buf *buf;
+
+	/* Not to move to another CPU in between */
+	*irq_key = arch_irq_lock();
+	buf = &ctr_cpu_bufs[arch_curr_cpu()->id];
+	*key = k_spin_lock(&buf->lock);
+
+	return buf;
+}
+
+static void ctr_drbg_cpu_buf_unlock(struct ctr_drbg_cpu_buf *buf, unsigned int irq_key,
+				    k_spinlock_key_t key)
+{
+	k_spin_unlock(&buf->lock, key);
+	arch_irq_unlock(irq_key);
+}
+
+static bool ctr_drbg_cpu_buf_get(uint8_t *dst, uint32_t outlen)
+{
+	struct ctr_drbg_cpu_buf *buf;
+	unsigned int irq_key;
+	k_spinlock_key_t key;
+	bool got = false;
+
+	buf = ctr_drbg_cpu_buf_lock(&irq_key, &key);
+
+	if (buf->avail >= outlen) {
+		uint8_t *src = &buf->data[sizeof(buf->data) - buf->avail];
+
+		memcpy(dst, src, outlen);
+		memset(src, 0, outlen);
+		buf->avail -= outlen;
+		got = true;
+	}
+
+	ctr_drbg_cpu_buf_unlock(buf, irq_key, key);
+
+	return got;
+}
+
+/* Must be called with ctr_lock held */
+static void ctr_drbg_cpu_buf_fill(void)
+{
+	struct ctr_drbg_cpu_buf *buf;
+	unsigned int irq_key;
+	k_spinlock_key_t key;
+
+	if (ctr_drbg_generate(ctr_batch, sizeof(ctr_batch)) != 0) {
+		return;
+	}
+
+	/* The buffer of the CPU running the caller now */
+	buf = ctr_drbg_cpu_buf_lock(&irq_key, &key);
+	memcpy(buf->data, ctr_batch, sizeof(buf->data));
+	buf->avail = sizeof(buf->data);
+	ctr_drbg_cpu_buf_unlock(buf, irq_key, key);
+
+	memset(ctr_batch, 0, sizeof(ctr_batch));
+}
+#endif /* CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0 */
+
+#if CONFIG_CS_CTR_DRBG_RESEED_PERIOD > 0
+static void ctr_drbg_reseed_handler(struct k_work *work)
+{
+	/* On failure the DRBG keeps its state, and the next period retries */
+	k_mutex_lock(&ctr_lock, K_FOREVER);
+	(void)ctr_drbg_reseed();
+	k_mutex_unlock(&ctr_lock);
+
+#if CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0
+	/* Drop the bytes generated before the reseed */
+	for (size_t i = 0; i < ARRAY_SIZE(ctr_cpu_bufs); i++) {
+		K_SPINLOCK(&ctr_cpu_bufs[i].lock) {
+			memset(ctr_cpu_bufs[i].data, 0, sizeof(ctr_cpu_bufs[i].data));
+			ctr_cpu_bufs[i].avail = 0;
+		}
+	}
+#endif /* CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0 */
+
+	k_work_schedule(k_work_delayable_from_work(work),
+			K_SECONDS(CONFIG_CS_CTR_DRBG_RESEED_PERIOD));
+}
+#endif /* CONFIG_CS_CTR_DRBG_RESEED_PERIOD > 0 */
+
+int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+{
+	int ret;
+
+#if CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0
+	/* Small requests are served without taking ctr_lock */
+	bool buffered = outlen <= (CONFIG_CS_CTR_DRBG_BUFFER_SIZE / 4);
+
+	if (buffered && ctr_drbg_cpu_buf_get(dst, outlen)) {
+		return 0;
+	}
+#endif /* CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0 */
+
+	k_mutex_lock(&ctr_lock, K_FOREVER);
+
+	ret = ctr_drbg_generate((uint8_t *)dst, outlen);
+
+#if CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0
+	if (ret == 0 && buffered) {
+		ctr_drbg_cpu_buf_fill();
+	}
+#endif /* CONFIG_CS_CTR_DRBG_BUFFER_SIZE > 0 */
+
 	k_mutex_unlock(&ctr_lock);
 
 	return ret;
@@ -122,6 +122,22 @@ static inline int z_vrfy_rtio_cqe_copy_out(struct rtio *r,
 }
 #include <zephyr/syscalls/rtio_cqe_copy_out_mrsh.c>
 
+static inline int z_vrfy_rtio_cqe_copy_out_batch(struct rtio *r,
+						 struct rtio_cqe *cqes,
+						 size_t min_count,
+						 size_t max_count,
+						 k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(r, K_OBJ_RTIO));
+
+	K_OOPS(K_SYSCALL_VERIFY_MSG(min_count <= max_count,
+				    "min_count must not exceed max_count"));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(cqes, max_count, sizeof(struct rtio_cqe)));
+
+	return z_impl_rtio_cqe_copy_out_batch(r, cqes, min_count, max_count, timeout);
+}
+#include <zephyr/syscalls/rtio_cqe_copy_out_batch_mrsh.c>
+
 static inline int z_vrfy_rtio_submit(struct rtio *r, uint32_t wait_count)
 {
 	K_OOPS(K_SYSCALL_OBJ(r, K_OBJ_RTIO));
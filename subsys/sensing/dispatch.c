@@ -11,32 +11,125 @@
 
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
 
-/* check whether it is right time for client to consume this sample */
-static inline bool sensor_test_consume_time(struct sensing_sensor *sensor,
-				     struct sensing_connection *conn,
-				     uint64_t cur_time)
+/* check whether the client consumes this sample, based on its pre-computed decimation */
+static inline bool sensor_test_consume_sample(struct sensing_sensor *sensor,
+					      struct sensing_connection *conn)
 {
-	LOG_DBG("sensor:%s next_consume_time:%lld cur_time:%lld",
-			sensor->dev->name, conn->next_consume_time, cur_time);
+	LOG_DBG("sensor:%s decimation:%u count:%u", sensor->dev->name, conn->decimation,
+		conn->decimation_count);
 
-	return conn->next_consume_time <= cur_time;
+	/* decimation is not known before the sensor is configured, report every sample */
+	if (++conn->decimation_count < MAX(conn->decimation, 1)) {
+		return false;
+	}
+
+	conn->decimation_count = 0;
+
+	return true;
 }
 
-static void update_client_consume_time(struct sensing_sensor *sensor,
-				       struct sensing_connection *conn)
+struct sensing_sample;
+
+#if CONFIG_SENSING_DISPATCH_POOL_THREADS > 0
+
+/* sample buffer shared read-only by the clients it is dispatched to */
+struct sensing_sample {
+	atomic_t refs;
+	uint8_t *data;
+	uint32_t data_len;
+};
+
+struct sensing_dispatch_work {
+	struct sensing_connection *conn;
+	struct sensing_sample *sample;
+};
+
+/* a mempool buffer takes at least one block, so there can't be more samples in flight */
+K_MEM_SLAB_DEFINE_STATIC(sensing_sample_slab, sizeof(struct sensing_sample),
+			 CONFIG_SENSING_RTIO_BLOCK_COUNT, 4);
+
+#define SENSING_POOL_QUEUE_DEFINE(n, _)							\
+	K_MSGQ_DEFINE(sensing_pool_queue_##n, sizeof(struct sensing_dispatch_work),	\
+		      CONFIG_SENSING_DISPATCH_POOL_QUEUE_SIZE, 4)
+
+#define SENSING_POOL_QUEUE_PTR(n, _) &sensing_pool_queue_##n
+
+LISTIFY(CONFIG_SENSING_DISPATCH_POOL_THREADS, SENSING_POOL_QUEUE_DEFINE, (;));
+
+static struct k_msgq *const sensing_pool_queues[] = {
+	LISTIFY(CONFIG_SENSING_DISPATCH_POOL_THREADS, SENSING_POOL_QUEUE_PTR, (,))
+};
+
+static void sensing_sample_unref(struct sensing_sample *sample)
+{
+	if (atomic_dec(&sample->refs) == 1) {
+		rtio_release_buffer(&sensing_rtio_ctx, sample->data, sample->data_len);
+		k_mem_slab_free(&sensing_sample_slab, sample);
+	}
+}
+
+static void pool_task(void *a, void *b, void *c)
 {
-	uint32_t interval = conn->interval;
+	struct k_msgq *queue = a;
+	struct sensing_dispatch_work work;
 
-	if (conn->next_consume_time == 0) {
-		conn->next_consume_time = get_us();
+	ARG_UNUSED(b);
+	ARG_UNUSED(c);
+
+	while (true) {
+		k_msgq_get(queue, &work, K_FOREVER);
+
+		work.conn->callback_list->on_data_event(work.conn, work.sample->data,
+							work.conn->callback_list->context);
+		sensing_sample_unref(work.sample);
+	}
+}
+
+#define SENSING_POOL_THREAD_DEFINE(n, _)						\
+	K_THREAD_DEFINE(sensing_pool_##n, CONFIG_SENSING_DISPATCH_POOL_STACK_SIZE,	\
+			pool_task, &sensing_pool_queue_##n, NULL, NULL,			\
+			CONFIG_SENSING_DISPATCH_POOL_PRIORITY, 0, 0)
+
+LISTIFY(CONFIG_SENSING_DISPATCH_POOL_THREADS, SENSING_POOL_THREAD_DEFINE, (;));
+
+/* samples of a client always go to the same thread so they stay in order */
+static inline struct k_msgq *pool_queue_of(struct sensing_connection *conn)
+{
+	return sensing_pool_queues[((uintptr_t)conn / sizeof(*conn)) %
+				   ARRAY_SIZE(sensing_pool_queues)];
+}
+
+#endif /* CONFIG_SENSING_DISPATCH_POOL_THREADS > 0 */
+
+/* hand the data to a client, returns false if it had to be dropped */
+static bool deliver_to_client(struct sensing_connection *conn, void *data,
+			      struct sensing_sample *sample)
+{
+#if CONFIG_SENSING_DISPATCH_POOL_THREADS > 0
+	struct sensing_dispatch_work work = {
+		.conn = conn,
+		.sample = sample,
+	};
+
+	ARG_UNUSED(data);
+
+	atomic_inc(&sample->refs);
+	if (k_msgq_put(pool_queue_of(conn), &work, K_NO_WAIT) != 0) {
+		atomic_dec(&sample->refs);
+		return false;
 	}
+#else
+	ARG_UNUSED(sample);
+
+	conn->callback_list->on_data_event(conn, data, conn->callback_list->context);
+#endif
 
-	conn->next_consume_time += interval;
+	return true;
 }
 
 /* send data to clients based on interval and sensitivity */
 static int send_data_to_clients(struct sensing_sensor *sensor,
-				void *data)
+				void *data, struct sensing_sample *sample)
 {
 	struct sensing_sensor *client;
 	struct sensing_connection *conn;
@@ -49,23 +142,20 @@ static int send_data_to_clients(struct sensing_sensor *sensor,
 			continue;
 		}
 
-		/* sensor_test_consume_time(), check whether time is ready or not:
-		 * true: it's time for client consuming the data
-		 * false: client time not arrived yet, not consume the data
-		 */
-		if (!sensor_test_consume_time(sensor, conn, get_us())) {
+		if (!sensor_test_consume_sample(sensor, conn)) {
 			continue;
 		}
 
-		update_client_consume_time(sensor, conn);
-
 		if (!conn->callback_list->on_data_event) {
 			LOG_WRN("sensor:%s event callback not registered",
 					conn->source->dev->name);
 			continue;
 		}
-		conn->callback_list->on_data_event(conn, data,
-				conn->callback_list->context);
+
+		if (!deliver_to_client(conn, data, sample)) {
+			LOG_WRN("sensor:%s client:%p too slow, sample dropped",
+				conn->source->dev->name, conn);
+		}
 	}
 
 	return 0;
@@ -108,15 +198,33 @@ static void dispatch_task(void *a, void *b, void *c)
 			continue;
 		}
 
-		if ((uintptr_t)cqe.userdata >=
-			    (uintptr_t)STRUCT_SECTION_START(sensing_sensor) &&
-		    (uintptr_t)cqe.userdata < (uintptr_t)STRUCT_SECTION_END(sensing_sensor)) {
-			struct sensing_sensor *sensor = cqe.userdata;
+		if ((uintptr_t)cqe.userdata <
+			    (uintptr_t)STRUCT_SECTION_START(sensing_sensor) ||
+		    (uintptr_t)cqe.userdata >= (uintptr_t)STRUCT_SECTION_END(sensing_sensor)) {
+			rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
+			continue;
+		}
+
+#if CONFIG_SENSING_DISPATCH_POOL_THREADS > 0
+		struct sensing_sample *sample;
 
-			send_data_to_clients(sensor, data);
+		if (k_mem_slab_alloc(&sensing_sample_slab, (void **)&sample, K_NO_WAIT) != 0) {
+			LOG_WRN("no sample descriptor, sample dropped");
+			rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
+			continue;
 		}
 
+		/* the dispatcher holds a reference while fanning out */
+		atomic_set(&sample->refs, 1);
+		sample->data = data;
+		sample->data_len = data_len;
+
+		send_data_to_clients(cqe.userdata, data, sample);
+		sensing_sample_unref(sample);
+#else
+		send_data_to_clients(cqe.userdata, data, NULL);
 		rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
+#endif
 	}
 }
 
@@ -73,6 +73,24 @@ static uint32_t arbitrate_interval(struct sensing_sensor *sensor)
 	return interval;
 }
 
+/* pre-compute how many samples each client skips, so dispatching is a counter check */
+static void update_decimation(struct sensing_sensor *sensor)
+{
+	struct sensing_connection *conn;
+
+	for_each_client_conn(sensor, conn) {
+		if (!is_client_request_data(conn) || sensor->interval == 0) {
+			conn->decimation = 0;
+			continue;
+		}
+
+		conn->decimation = MAX(1, (conn->interval + sensor->interval / 2) /
+					  sensor->interval);
+		LOG_DBG("sensor:%s conn:%p decimation:%u", sensor->dev->name, conn,
+			conn->decimation);
+	}
+}
+
 static int set_arbitrate_interval(struct sensing_sensor *sensor, uint32_t interval)
 {
 	struct sensing_submit_config *config = sensor->iodev->data;
@@ -115,6 +133,7 @@ static int set_arbitrate_interval(struct sensing_sensor *sensor, uint32_t interv
 	}
 
 	sensor->interval = interval;
+	update_decimation(sensor);
 
 	return ret;
 }
@@ -274,6 +293,8 @@ static void init_connection(struct sensing_connection *conn,
 	}
 
 	conn->interval = 0;
+	conn->decimation = 0;
+	conn->decimation_count = 0;
 	memset(conn->sensitivity, 0x00, sizeof(conn->sensitivity));
 	/* link connection to its reporter's client_list */
 	sys_slist_append(&conn->source->client_list, &conn->snode);
@@ -420,7 +441,7 @@ int set_interval(struct sensing_connection *conn, uint32_t interval)
 	}
 
 	conn->interval = interval;
-	conn->next_consume_time = EXEC_TIME_INIT;
+	conn->decimation_count = 0;
 
 	LOG_INF("set interval, sensor:%s, conn:%p, interval:%d",
 		conn->source->dev->name, conn, interval);
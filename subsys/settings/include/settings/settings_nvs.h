@@ -48,6 +48,11 @@ struct settings_nvs {
 	uint16_t cache_total;
 	bool loaded;
 #endif
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+	/* Hash of the top-level subtree of each name ID in use */
+	uint16_t index[CONFIG_SETTINGS_NVS_SUBTREE_INDEX_SIZE];
+	bool indexed;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -31,11 +31,19 @@ static int settings_fcb_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_fcb_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
+#ifdef CONFIG_SETTINGS_BATCH
+static int settings_fcb_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries,
+				   size_t count);
+#endif
 static void *settings_fcb_storage_get(struct settings_store *cs);
 
 static const struct settings_store_itf settings_fcb_itf = {
 	.csi_load = settings_fcb_load,
 	.csi_save = settings_fcb_save,
+#ifdef CONFIG_SETTINGS_BATCH
+	.csi_save_batch = settings_fcb_save_batch,
+#endif
 	.csi_storage_get = settings_fcb_storage_get
 };
 
@@ -387,6 +395,41 @@ static int settings_fcb_save(struct settings_store *cs, const char *name,
 	return settings_fcb_save_priv(cs, name, value, val_len);
 }
 
+#ifdef CONFIG_SETTINGS_BATCH
+/* ::csi_save_batch implementation, checks all values in one pass */
+static int settings_fcb_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries,
+				   size_t count)
+{
+	bool is_dup[CONFIG_SETTINGS_BATCH_MAX_ENTRIES] = { false };
+	struct settings_line_batch_dup_check_arg bdca = {
+		.entries = entries,
+		.count = count,
+		.is_dup = is_dup,
+	};
+	int rc = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i].val_len > 0 && entries[i].value == NULL) {
+			return -EINVAL;
+		}
+	}
+
+	settings_fcb_load_priv(cs, settings_line_batch_dup_check_cb, &bdca,
+			       false);
+
+	for (size_t i = 0; i < count && !rc; i++) {
+		if (!is_dup[i]) {
+			rc = settings_fcb_save_priv(cs, entries[i].name,
+						    entries[i].value,
+						    entries[i].val_len);
+		}
+	}
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 void settings_mount_fcb_backend(struct settings_fcb *cf)
 {
 	uint8_t rbs;
@@ -33,11 +33,19 @@ static int settings_file_load(struct settings_store *cs,
 			      const struct settings_load_arg *arg);
 static int settings_file_save(struct settings_store *cs, const char *name,
 			      const char *value, size_t val_len);
+#ifdef CONFIG_SETTINGS_BATCH
+static int settings_file_save_batch(struct settings_store *cs,
+				    const struct settings_batch_entry *entries,
+				    size_t count);
+#endif
 static void *settings_file_storage_get(struct settings_store *cs);
 
 static const struct settings_store_itf settings_file_itf = {
 	.csi_load = settings_file_load,
 	.csi_save = settings_file_save,
+#ifdef CONFIG_SETTINGS_BATCH
+	.csi_save_batch = settings_file_save_batch,
+#endif
 	.csi_storage_get = settings_file_storage_get
 };
 
@@ -448,6 +456,96 @@ static int settings_file_save(struct settings_store *cs, const char *name,
 	return settings_file_save_priv(cs, name, value, val_len);
 }
 
+#ifdef CONFIG_SETTINGS_BATCH
+/*
+ * Called to save a batch of values, appended with a single open and close
+ * of the file unless it has to be compressed on the way.
+ */
+static int settings_file_save_batch(struct settings_store *cs,
+				    const struct settings_batch_entry *entries,
+				    size_t count)
+{
+	struct settings_file *cf = CONTAINER_OF(cs, struct settings_file, cf_store);
+	bool is_dup[CONFIG_SETTINGS_BATCH_MAX_ENTRIES] = { false };
+	struct settings_line_batch_dup_check_arg bdca = {
+		.entries = entries,
+		.count = count,
+		.is_dup = is_dup,
+	};
+	struct line_entry_ctx entry_ctx;
+	struct fs_file_t file;
+	size_t lines = 0;
+	int rc2;
+	int rc;
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i].val_len > 0 && entries[i].value == NULL) {
+			return -EINVAL;
+		}
+	}
+
+	/*
+	 * Check which values are written again, all in one pass.
+	 */
+	settings_file_load_priv(cs, settings_line_batch_dup_check_cb, &bdca,
+				false);
+	for (size_t i = 0; i < count; i++) {
+		if (!is_dup[i]) {
+			lines++;
+		}
+	}
+
+	if (lines == 0) {
+		return 0;
+	}
+
+	if (cf->cf_maxlines && (cf->cf_lines + lines >= cf->cf_maxlines)) {
+		/*
+		 * Leave it to the single value path to compress the file
+		 * when it runs full.
+		 */
+		rc = 0;
+		for (size_t i = 0; i < count && !rc; i++) {
+			if (!is_dup[i]) {
+				rc = settings_file_save_priv(cs, entries[i].name,
+							     entries[i].value,
+							     entries[i].val_len);
+			}
+		}
+		return rc;
+	}
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, cf->cf_name, FS_O_CREATE | FS_O_RDWR);
+	if (rc) {
+		return rc;
+	}
+
+	rc = fs_seek(&file, 0, FS_SEEK_END);
+	entry_ctx.stor_ctx = &file;
+	for (size_t i = 0; i < count && !rc; i++) {
+		if (is_dup[i]) {
+			continue;
+		}
+
+		rc = settings_line_write(entries[i].name, entries[i].value,
+					 entries[i].val_len, 0,
+					 (void *)&entry_ctx);
+		if (rc == 0) {
+			cf->cf_lines++;
+		}
+	}
+
+	rc2 = fs_close(&file);
+	if (rc == 0) {
+		rc = rc2;
+	}
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 static int read_handler(void *ctx, off_t off, char *buf, size_t *len)
 {
 	struct line_entry_ctx *entry_ctx = ctx;
@@ -387,6 +387,33 @@ int settings_line_dup_check_cb(const char *name, void *val_read_cb_ctx,
 	return 0;
 }
 
+#ifdef CONFIG_SETTINGS_BATCH
+int settings_line_batch_dup_check_cb(const char *name, void *val_read_cb_ctx,
+				     off_t off, void *cb_arg)
+{
+	struct settings_line_batch_dup_check_arg *bdca = cb_arg;
+	struct settings_line_dup_check_arg cdca;
+
+	for (size_t i = 0; i < bdca->count; i++) {
+		if (strcmp(name, bdca->entries[i].name)) {
+			continue;
+		}
+
+		cdca.name = bdca->entries[i].name;
+		cdca.val = bdca->entries[i].value;
+		cdca.val_len = bdca->entries[i].val_len;
+		cdca.is_dup = bdca->is_dup[i];
+		settings_line_dup_check_cb(name, val_read_cb_ctx, off, &cdca);
+		bdca->is_dup[i] = cdca.is_dup;
+
+		/* Keys are unique within a batch */
+		break;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 static ssize_t settings_line_read_cb(void *cb_arg, void *data, size_t len)
 {
 	struct settings_line_read_value_cb_ctx *value_context = cb_arg;
@@ -32,11 +32,19 @@ static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
+#if defined(CONFIG_SETTINGS_BATCH)
+static int settings_nvs_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries,
+				   size_t count);
+#endif
 static void *settings_nvs_storage_get(struct settings_store *cs);
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
 	.csi_save = settings_nvs_save,
+#if defined(CONFIG_SETTINGS_BATCH)
+	.csi_save_batch = settings_nvs_save_batch,
+#endif
 	.csi_storage_get = settings_nvs_storage_get
 };
 
@@ -120,6 +128,38 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+/* Index value of the name IDs not in use, no subtree hashes to it */
+#define SETTINGS_NVS_INDEX_FREE 0
+
+static uint16_t settings_nvs_subtree_hash(const char *name)
+{
+	uint16_t hash = crc16_ccitt(0xffff, name, settings_name_next(name, NULL));
+
+	return (hash == SETTINGS_NVS_INDEX_FREE) ? 1 : hash;
+}
+
+static void settings_nvs_index_set(struct settings_nvs *cf, uint16_t name_id,
+				   uint16_t hash)
+{
+	uint16_t slot = name_id - NVS_NAMECNT_ID - 1;
+
+	if (slot < ARRAY_SIZE(cf->index)) {
+		cf->index[slot] = hash;
+	}
+}
+
+/* Settings under other subtrees are skipped once all of them were indexed */
+static bool settings_nvs_index_skip(struct settings_nvs *cf, uint16_t name_id,
+				    uint16_t hash)
+{
+	uint16_t slot = name_id - NVS_NAMECNT_ID - 1;
+
+	return cf->indexed && (hash != SETTINGS_NVS_INDEX_FREE) &&
+	       (slot < ARRAY_SIZE(cf->index)) && (cf->index[slot] != hash);
+}
+#endif /* CONFIG_SETTINGS_NVS_SUBTREE_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -137,6 +177,18 @@ static int settings_nvs_load(struct settings_store *cs,
 	cf->loaded = false;
 #endif
 
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+	uint16_t subtree_hash = SETTINGS_NVS_INDEX_FREE;
+
+	if (!arg->subtree) {
+		/* Rebuilt from scratch by loading everything */
+		cf->indexed = false;
+		memset(cf->index, SETTINGS_NVS_INDEX_FREE, sizeof(cf->index));
+	} else if (settings_name_next(arg->subtree, NULL) > 0) {
+		subtree_hash = settings_nvs_subtree_hash(arg->subtree);
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -146,10 +198,21 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 			cf->loaded = true;
 			cf->cache_total = cached;
+#endif
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+			if (!arg->subtree) {
+				cf->indexed = true;
+			}
 #endif
 			break;
 		}
 
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+		if (settings_nvs_index_skip(cf, name_id, subtree_hash)) {
+			continue;
+		}
+#endif
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -181,6 +244,10 @@ static int settings_nvs_load(struct settings_store *cs,
 			 */
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+			settings_nvs_index_set(cf, name_id,
+					       SETTINGS_NVS_INDEX_FREE);
+#endif
 
 			if (name_id == cf->last_name_id) {
 				cf->last_name_id--;
@@ -200,6 +267,10 @@ static int settings_nvs_load(struct settings_store *cs,
 		settings_nvs_cache_add(cf, name, name_id);
 		cached++;
 #endif
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+		settings_nvs_index_set(cf, name_id,
+				       settings_nvs_subtree_hash(name));
+#endif
 
 		ret = settings_call_set_handler(
 			name, rc2,
@@ -212,10 +283,14 @@ static int settings_nvs_load(struct settings_store *cs,
 	return ret;
 }
 
-static int settings_nvs_save(struct settings_store *cs, const char *name,
-			     const char *value, size_t val_len)
+/*
+ * Write a single value. If namecnt_dirty is given, the largest name ID in
+ * use is not written but flagged, for the caller to write once.
+ */
+static int settings_nvs_save_priv(struct settings_nvs *cf, const char *name,
+				  const char *value, size_t val_len,
+				  bool *namecnt_dirty)
 {
-	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
 	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	uint16_t name_id, write_name_id;
 	bool delete, write_name;
@@ -297,8 +372,16 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+		settings_nvs_index_set(cf, name_id, SETTINGS_NVS_INDEX_FREE);
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
+			if (namecnt_dirty) {
+				*namecnt_dirty = true;
+				return 0;
+			}
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
 				       &cf->last_name_id, sizeof(uint16_t));
 			if (rc < 0) {
@@ -320,10 +403,14 @@ found:
 	/* update the last_name_id and write to flash if required*/
 	if (write_name_id > cf->last_name_id) {
 		cf->last_name_id = write_name_id;
-		rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
-			       sizeof(uint16_t));
-		if (rc < 0) {
-			return rc;
+		if (namecnt_dirty) {
+			*namecnt_dirty = true;
+		} else {
+			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
+				       &cf->last_name_id, sizeof(uint16_t));
+			if (rc < 0) {
+				return rc;
+			}
 		}
 	}
 
@@ -340,6 +427,10 @@ found:
 		if (rc < 0) {
 			return rc;
 		}
+#if CONFIG_SETTINGS_NVS_SUBTREE_INDEX
+		settings_nvs_index_set(cf, write_name_id,
+				       settings_nvs_subtree_hash(name));
+#endif
 	}
 
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
@@ -354,6 +445,46 @@ found:
 	return 0;
 }
 
+static int settings_nvs_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+
+	return settings_nvs_save_priv(cf, name, value, val_len, NULL);
+}
+
+#if defined(CONFIG_SETTINGS_BATCH)
+/*
+ * The largest name ID in use is written once the values are, so names the
+ * batch adds are not loaded if it is interrupted. Their IDs are reused by
+ * later writes.
+ */
+static int settings_nvs_save_batch(struct settings_store *cs,
+				   const struct settings_batch_entry *entries,
+				   size_t count)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+	bool namecnt_dirty = false;
+	int rc = 0;
+	int rc2;
+
+	for (size_t i = 0; i < count && !rc; i++) {
+		rc = settings_nvs_save_priv(cf, entries[i].name, entries[i].value,
+					    entries[i].val_len, &namecnt_dirty);
+	}
+
+	if (namecnt_dirty) {
+		rc2 = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
+				sizeof(uint16_t));
+		if (!rc && rc2 < 0) {
+			rc = rc2;
+		}
+	}
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 /* Initialize the nvs backend. */
 int settings_nvs_backend_init(struct settings_nvs *cf)
 {
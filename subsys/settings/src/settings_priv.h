@@ -44,6 +44,18 @@ struct settings_line_dup_check_arg {
 	int is_dup;
 };
 
+#ifdef CONFIG_SETTINGS_BATCH
+/* Duplicate check of all the values of a batch in one pass over the lines */
+struct settings_line_batch_dup_check_arg {
+	const struct settings_batch_entry *entries;
+	size_t count;
+	bool *is_dup;
+};
+
+int settings_line_batch_dup_check_cb(const char *name, void *val_read_cb_ctx,
+				     off_t off, void *cb_arg);
+#endif
+
 #ifdef CONFIG_SETTINGS_ENCODE_LEN
 /* in storage line contex */
 struct line_entry_ctx {
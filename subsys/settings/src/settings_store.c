@@ -88,6 +88,134 @@ int settings_load_subtree_direct(
 	return 0;
 }
 
+#if defined(CONFIG_SETTINGS_BATCH)
+/*
+ * Values saved by the thread owning the batch, which holds settings_lock
+ * until the batch is committed or aborted. Names and values are packed into
+ * the buffer in staging order.
+ */
+static struct settings_batch_entry settings_batch[CONFIG_SETTINGS_BATCH_MAX_ENTRIES];
+static char settings_batch_buf[CONFIG_SETTINGS_BATCH_BUFFER_SIZE];
+static size_t settings_batch_cnt;
+static size_t settings_batch_used;
+static k_tid_t settings_batch_owner;
+
+int settings_batch_begin(void)
+{
+	if (!settings_save_dst) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (settings_batch_owner == k_current_get()) {
+		k_mutex_unlock(&settings_lock);
+		return -EALREADY;
+	}
+
+	settings_batch_owner = k_current_get();
+	settings_batch_cnt = 0;
+	settings_batch_used = 0;
+
+	return 0;
+}
+
+int settings_batch_stage(const char *name, const void *value, size_t val_len)
+{
+	struct settings_batch_entry *entry = NULL;
+	size_t name_len = strlen(name) + 1;
+	size_t need = val_len;
+
+	if (settings_batch_owner != k_current_get()) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < settings_batch_cnt; i++) {
+		if (!strcmp(settings_batch[i].name, name)) {
+			entry = &settings_batch[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		if (settings_batch_cnt == ARRAY_SIZE(settings_batch)) {
+			return -ENOMEM;
+		}
+		need += name_len;
+	} else if (val_len <= entry->val_len) {
+		/* Replaced values that fit are rewritten in place */
+		need = 0;
+	}
+
+	if (need > sizeof(settings_batch_buf) - settings_batch_used) {
+		return -ENOMEM;
+	}
+
+	if (!entry) {
+		entry = &settings_batch[settings_batch_cnt++];
+		memcpy(&settings_batch_buf[settings_batch_used], name, name_len);
+		entry->name = &settings_batch_buf[settings_batch_used];
+		settings_batch_used += name_len;
+		entry->value = NULL;
+	}
+
+	if (val_len == 0) {
+		entry->value = NULL;
+	} else if (need == 0) {
+		memcpy((char *)entry->value, value, val_len);
+	} else {
+		memcpy(&settings_batch_buf[settings_batch_used], value, val_len);
+		entry->value = &settings_batch_buf[settings_batch_used];
+		settings_batch_used += val_len;
+	}
+	entry->val_len = val_len;
+
+	return 0;
+}
+
+static void settings_batch_close(void)
+{
+	settings_batch_owner = NULL;
+	settings_batch_cnt = 0;
+	settings_batch_used = 0;
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_batch_commit(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc = 0;
+
+	if (settings_batch_owner != k_current_get()) {
+		return -EINVAL;
+	}
+
+	if (settings_batch_cnt == 0) {
+		/* Nothing to write */
+	} else if (cs->cs_itf->csi_save_batch) {
+		rc = cs->cs_itf->csi_save_batch(cs, settings_batch,
+						settings_batch_cnt);
+	} else {
+		for (size_t i = 0; i < settings_batch_cnt && !rc; i++) {
+			rc = cs->cs_itf->csi_save(cs, settings_batch[i].name,
+						  settings_batch[i].value,
+						  settings_batch[i].val_len);
+		}
+	}
+
+	settings_batch_close();
+
+	return rc;
+}
+
+void settings_batch_abort(void)
+{
+	if (settings_batch_owner == k_current_get()) {
+		settings_batch_close();
+	}
+}
+#endif /* CONFIG_SETTINGS_BATCH */
+
 /*
  * Append a single value to persisted config. Don't store duplicate value.
  */
@@ -103,6 +231,14 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#if defined(CONFIG_SETTINGS_BATCH)
+	if (settings_batch_owner == k_current_get()) {
+		rc = settings_batch_stage(name, value, val_len);
+		k_mutex_unlock(&settings_lock);
+		return rc;
+	}
+#endif
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2017 Intel Corporation
  * Copyright (c) 2019 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -697,9 +698,10 @@ static int telnet_write(const struct shell_transport *transport,
 		lb->len += copy_len;
 
 		/* Send the data immediately if the buffer is full or line feed
-		 * is recognized.
+		 * is recognized, unless line feeds are coalesced.
 		 */
-		if (lb->buf[lb->len - 1] == '\n' ||
+		if ((IS_ENABLED(CONFIG_SHELL_TELNET_SEND_ON_LINE_FEED) &&
+		     lb->buf[lb->len - 1] == '\n') ||
 		    lb->len == TELNET_LINE_SIZE) {
 			err = telnet_send(true);
 			if (err != 0) {
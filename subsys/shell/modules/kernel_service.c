@@ -158,6 +158,17 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 			    (uint32_t)rt_stats_thread.peak_cycles);
 		shell_print(sh, "\tAverage execution cycles: %u",
 			    (uint32_t)rt_stats_thread.average_cycles);
+#endif
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+		shell_print(sh, "\tPreemptions: %u, peak ready latency: %u cycles",
+			    rt_stats_thread.preemptions,
+			    rt_stats_thread.latency_max);
+		shell_fprintf(sh, SHELL_NORMAL, "\tReady latency histogram:");
+		for (int i = 0; i < CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS; i++) {
+			shell_fprintf(sh, SHELL_NORMAL, " %u",
+				      rt_stats_thread.latency[i]);
+		}
+		shell_fprintf(sh, SHELL_NORMAL, "\n");
 #endif
 	} else {
 		shell_print(sh, "\tTotal execution cycles: ? (? %%)");
@@ -165,6 +176,9 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		shell_print(sh, "\tCurrent execution cycles: ?");
 		shell_print(sh, "\tPeak execution cycles: ?");
 		shell_print(sh, "\tAverage execution cycles: ?");
+#endif
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+		shell_print(sh, "\tPreemptions: ?, peak ready latency: ? cycles");
 #endif
 	}
 #endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/ring_buffer_lockfree.h>
+#include <tracing_buffer.h>
+
+/*
+ * Each CPU puts the packets it traces into its own lock-free ring buffer,
+ * with local interrupts locked only. Packets are preceded by a header with
+ * their timestamp and size, and padded to the header size so that headers
+ * never wrap. The tracing thread, the only consumer, merges the buffers by
+ * always getting the oldest packet first.
+ */
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_TRACING_BUFFER_SIZE),
+	     "Per-CPU tracing buffer size must be a power of two");
+
+struct tracing_packet_hdr {
+	uint32_t timestamp;
+	uint32_t size;
+};
+
+#define PACKET_HDR_SIZE		sizeof(struct tracing_packet_hdr)
+#define PACKET_PAD(size)	(ROUND_UP(size, PACKET_HDR_SIZE) - (size))
+
+struct tracing_cpu_buffer {
+	struct ring_buf_spsc rb;
+	/* Packet being put, NULL if none */
+	struct tracing_packet_hdr *hdr;
+	uint32_t claimed;
+};
+
+static struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_MAX_NUM_CPUS];
+static uint8_t tracing_buffers[CONFIG_MP_MAX_NUM_CPUS][CONFIG_TRACING_BUFFER_SIZE]
+	__aligned(PACKET_HDR_SIZE);
+static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
+
+/* Buffer of the packet being got, its size left and its padding */
+static struct tracing_cpu_buffer *get_buf;
+static uint32_t get_size;
+static uint32_t get_pad;
+
+static inline struct tracing_cpu_buffer *put_buf_get(void)
+{
+	/* Callers lock interrupts, so the thread cannot move in between */
+	return &tracing_cpu_buffers[arch_curr_cpu()->id];
+}
+
+/* Space left for the payload of the packet being put */
+static uint32_t put_space_get(struct tracing_cpu_buffer *buf)
+{
+	uint32_t used = PACKET_HDR_SIZE + buf->claimed + PACKET_HDR_SIZE - 1;
+	uint32_t space = ring_buf_spsc_space_get(&buf->rb);
+
+	return space > used ? space - used : 0;
+}
+
+uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+{
+	*data = &tracing_cmd_buffer[0];
+
+	return sizeof(tracing_cmd_buffer);
+}
+
+uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
+{
+	struct tracing_cpu_buffer *buf = put_buf_get();
+	uint8_t *hdr;
+
+	if (buf->hdr == NULL) {
+		if (put_space_get(buf) == 0 ||
+		    ring_buf_spsc_put_claim(&buf->rb, &hdr, PACKET_HDR_SIZE) != PACKET_HDR_SIZE) {
+			return 0;
+		}
+
+		buf->hdr = (struct tracing_packet_hdr *)hdr;
+		buf->hdr->timestamp = k_cycle_get_32();
+		buf->claimed = 0U;
+	}
+
+	size = ring_buf_spsc_put_claim(&buf->rb, data, MIN(size, put_space_get(buf)));
+	buf->claimed += size;
+
+	return size;
+}
+
+int tracing_buffer_put_finish(uint32_t size)
+{
+	struct tracing_cpu_buffer *buf = put_buf_get();
+	uint32_t total = PACKET_HDR_SIZE + size + PACKET_PAD(size);
+	uint8_t *pad;
+
+	if (buf->hdr == NULL) {
+		return size == 0U ? 0 : -EINVAL;
+	}
+
+	if (size > buf->claimed) {
+		return -EINVAL;
+	}
+
+	if (size == 0U) {
+		buf->hdr = NULL;
+		return ring_buf_spsc_put_finish(&buf->rb, 0);
+	}
+
+	/* Room for the padding was kept by put_space_get(), and it never wraps */
+	if (total > PACKET_HDR_SIZE + buf->claimed) {
+		(void)ring_buf_spsc_put_claim(&buf->rb, &pad,
+					      total - PACKET_HDR_SIZE - buf->claimed);
+	}
+
+	buf->hdr->size = size;
+	buf->hdr = NULL;
+
+	return ring_buf_spsc_put_finish(&buf->rb, total);
+}
+
+uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+
+	do {
+		partial_size = tracing_buffer_put_claim(&dst, size);
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	(void)tracing_buffer_put_finish(total_size);
+
+	return total_size;
+}
+
+/* Picks the buffer holding the oldest packet and skips its header */
+static struct tracing_cpu_buffer *get_buf_next(void)
+{
+	struct tracing_cpu_buffer *oldest = NULL;
+	struct tracing_packet_hdr oldest_hdr = {0};
+	uint8_t *hdr;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct tracing_cpu_buffer *buf = &tracing_cpu_buffers[i];
+
+		if (ring_buf_spsc_get_claim(&buf->rb, &hdr, PACKET_HDR_SIZE) == 0U) {
+			continue;
+		}
+
+		if (oldest == NULL ||
+		    (int32_t)(((struct tracing_packet_hdr *)hdr)->timestamp -
+			      oldest_hdr.timestamp) < 0) {
+			oldest = buf;
+			oldest_hdr = *(struct tracing_packet_hdr *)hdr;
+		}
+
+		(void)ring_buf_spsc_get_finish(&buf->rb, 0);
+	}
+
+	if (oldest != NULL) {
+		(void)ring_buf_spsc_get_claim(&oldest->rb, &hdr, PACKET_HDR_SIZE);
+		(void)ring_buf_spsc_get_finish(&oldest->rb, PACKET_HDR_SIZE);
+		get_size = oldest_hdr.size;
+		get_pad = PACKET_PAD(oldest_hdr.size);
+	}
+
+	return oldest;
+}
+
+uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
+{
+	if (get_buf == NULL) {
+		get_buf = get_buf_next();
+		if (get_buf == NULL) {
+			return 0;
+		}
+	}
+
+	return ring_buf_spsc_get_claim(&get_buf->rb, data, MIN(size, get_size));
+}
+
+int tracing_buffer_get_finish(uint32_t size)
+{
+	uint8_t *pad;
+	int err;
+
+	if (get_buf == NULL) {
+		return size == 0U ? 0 : -EINVAL;
+	}
+
+	if (size > get_size) {
+		return -EINVAL;
+	}
+
+	err = ring_buf_spsc_get_finish(&get_buf->rb, size);
+	if (err != 0) {
+		return err;
+	}
+
+	get_size -= size;
+	if (get_size == 0U) {
+		/* The padding of the packet never wraps either */
+		(void)ring_buf_spsc_get_claim(&get_buf->rb, &pad, get_pad);
+		(void)ring_buf_spsc_get_finish(&get_buf->rb, get_pad);
+		get_buf = NULL;
+	}
+
+	return 0;
+}
+
+uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+
+	do {
+		partial_size = tracing_buffer_get_claim(&src, size);
+		memcpy(data, src, partial_size);
+		(void)tracing_buffer_get_finish(partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	return total_size;
+}
+
+void tracing_buffer_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		ring_buf_spsc_init(&tracing_cpu_buffers[i].rb, sizeof(tracing_buffers[i]),
+				   tracing_buffers[i]);
+		tracing_cpu_buffers[i].hdr = NULL;
+	}
+}
+
+bool tracing_buffer_is_empty(void)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (!ring_buf_spsc_is_empty(&tracing_cpu_buffers[i].rb)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t tracing_buffer_capacity_get(void)
+{
+	return CONFIG_TRACING_BUFFER_SIZE;
+}
+
+uint32_t tracing_buffer_space_get(void)
+{
+	return put_space_get(put_buf_get());
+}
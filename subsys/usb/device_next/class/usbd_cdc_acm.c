@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2022 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -31,8 +32,11 @@
 #endif
 LOG_MODULE_REGISTER(usbd_cdc_acm, CONFIG_USBD_CDC_ACM_LOG_LEVEL);
 
+#define CDC_ACM_TRANSFER_COUNT		CONFIG_USBD_CDC_ACM_TRANSFER_COUNT
+
 NET_BUF_POOL_FIXED_DEFINE(cdc_acm_ep_pool,
-			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2 *
+			  CDC_ACM_TRANSFER_COUNT,
 			  512, sizeof(struct udc_buf_info), NULL);
 
 #define CDC_ACM_DEFAULT_LINECODING	{sys_cpu_to_le32(115200), 0, 0, 8}
@@ -45,8 +49,7 @@ NET_BUF_POOL_FIXED_DEFINE(cdc_acm_ep_pool,
 #define CDC_ACM_CLASS_SUSPENDED		1
 #define CDC_ACM_IRQ_RX_ENABLED		2
 #define CDC_ACM_IRQ_TX_ENABLED		3
-#define CDC_ACM_RX_FIFO_BUSY		4
-#define CDC_ACM_LOCK			5
+#define CDC_ACM_LOCK			4
 
 static struct k_work_q cdc_acm_work_q;
 static K_KERNEL_STACK_DEFINE(cdc_acm_stack,
@@ -108,6 +111,9 @@ struct cdc_acm_uart_data {
 	struct k_work tx_fifo_work;
 	/* USBD CDC ACM RX fifo work */
 	struct k_work rx_fifo_work;
+	/* Number of transfers queued on bulk OUT and IN endpoints */
+	atomic_t rx_queued;
+	atomic_t tx_queued;
 	atomic_t state;
 	struct k_sem notif_sem;
 };
@@ -213,7 +219,11 @@ static int usbd_cdc_acm_request(struct usbd_class_data *const c_data,
 		}
 
 		if (bi->ep == cdc_acm_get_bulk_out(c_data)) {
-			atomic_clear_bit(&data->state, CDC_ACM_RX_FIFO_BUSY);
+			atomic_dec(&data->rx_queued);
+		}
+
+		if (bi->ep == cdc_acm_get_bulk_in(c_data)) {
+			atomic_dec(&data->tx_queued);
 		}
 
 		goto ep_request_error;
@@ -229,12 +239,17 @@ static int usbd_cdc_acm_request(struct usbd_class_data *const c_data,
 			cdc_acm_work_submit(&data->irq_cb_work);
 		}
 
-		atomic_clear_bit(&data->state, CDC_ACM_RX_FIFO_BUSY);
+		atomic_dec(&data->rx_queued);
 		cdc_acm_work_submit(&data->rx_fifo_work);
 	}
 
 	if (bi->ep == cdc_acm_get_bulk_in(c_data)) {
 		/* TX transfer completion */
+		atomic_dec(&data->tx_queued);
+		if (!ring_buf_is_empty(data->tx_fifo.rb)) {
+			cdc_acm_work_submit(&data->tx_fifo_work);
+		}
+
 		if (data->cb) {
 			cdc_acm_work_submit(&data->irq_cb_work);
 		}
@@ -539,22 +554,34 @@ static void cdc_acm_tx_fifo_handler(struct k_work *work)
 		return;
 	}
 
-	buf = cdc_acm_buf_alloc(cdc_acm_get_bulk_in(c_data));
-	if (buf == NULL) {
-		cdc_acm_work_submit(&data->tx_fifo_work);
-		goto tx_fifo_handler_exit;
-	}
+	/* Queue transfers until the fifo is empty, completions resume it */
+	while (atomic_get(&data->tx_queued) < CDC_ACM_TRANSFER_COUNT) {
+		buf = cdc_acm_buf_alloc(cdc_acm_get_bulk_in(c_data));
+		if (buf == NULL) {
+			if (atomic_get(&data->tx_queued) == 0) {
+				cdc_acm_work_submit(&data->tx_fifo_work);
+			}
 
-	len = ring_buf_get(data->tx_fifo.rb, buf->data, buf->size);
-	net_buf_add(buf, len);
+			break;
+		}
 
-	ret = usbd_ep_enqueue(c_data, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue");
-		net_buf_unref(buf);
+		len = ring_buf_get(data->tx_fifo.rb, buf->data, buf->size);
+		net_buf_add(buf, len);
+
+		atomic_inc(&data->tx_queued);
+		ret = usbd_ep_enqueue(c_data, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue");
+			atomic_dec(&data->tx_queued);
+			net_buf_unref(buf);
+			break;
+		}
+
+		if (ring_buf_is_empty(data->tx_fifo.rb)) {
+			break;
+		}
 	}
 
-tx_fifo_handler_exit:
 	atomic_clear_bit(&data->state, CDC_ACM_LOCK);
 }
 
@@ -583,26 +610,29 @@ static void cdc_acm_rx_fifo_handler(struct k_work *work)
 		return;
 	}
 
-	if (ring_buf_space_get(data->rx_fifo.rb) < cdc_acm_get_bulk_mps(c_data)) {
-		LOG_INF("RX buffer to small, throttle");
-		return;
-	}
+	ep = cdc_acm_get_bulk_out(c_data);
 
-	if (atomic_test_and_set_bit(&data->state, CDC_ACM_RX_FIFO_BUSY)) {
-		LOG_WRN("RX transfer already in progress");
-		return;
-	}
+	while (atomic_get(&data->rx_queued) < CDC_ACM_TRANSFER_COUNT) {
+		/* Keep room for the transfers already in flight too */
+		if (ring_buf_space_get(data->rx_fifo.rb) <
+		    (atomic_get(&data->rx_queued) + 1) * cdc_acm_get_bulk_mps(c_data)) {
+			LOG_INF("RX buffer to small, throttle");
+			return;
+		}
 
-	ep = cdc_acm_get_bulk_out(c_data);
-	buf = cdc_acm_buf_alloc(ep);
-	if (buf == NULL) {
-		return;
-	}
+		buf = cdc_acm_buf_alloc(ep);
+		if (buf == NULL) {
+			return;
+		}
 
-	ret = usbd_ep_enqueue(c_data, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
+		atomic_inc(&data->rx_queued);
+		ret = usbd_ep_enqueue(c_data, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			atomic_dec(&data->rx_queued);
+			net_buf_unref(buf);
+			return;
+		}
 	}
 }
 
@@ -637,7 +667,7 @@ static void cdc_acm_irq_rx_enable(const struct device *dev)
 		cdc_acm_work_submit(&data->irq_cb_work);
 	}
 
-	if (!atomic_test_bit(&data->state, CDC_ACM_RX_FIFO_BUSY)) {
+	if (atomic_get(&data->rx_queued) < CDC_ACM_TRANSFER_COUNT) {
 		LOG_INF("rx_en: trigger rx_fifo_work");
 		cdc_acm_work_submit(&data->rx_fifo_work);
 	}
@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2017 Intel Corporation
  * Copyright (c) 2023 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -29,17 +30,22 @@ enum {
 	CDC_ECM_IFACE_UP,
 	CDC_ECM_CLASS_ENABLED,
 	CDC_ECM_CLASS_SUSPENDED,
-	CDC_ECM_OUT_ENGAGED,
+	CDC_ECM_OUT_STARVED,
 };
 
+#define CDC_ECM_TRANSFER_COUNT		CONFIG_USBD_CDC_ECM_TRANSFER_COUNT
+
+static void cdc_ecm_buf_destroy(struct net_buf *buf);
+
 /*
- * Transfers through two endpoints proceed in a synchronous manner,
- * with maximum block of NET_ETH_MAX_FRAME_SIZE.
+ * Up to CDC_ECM_TRANSFER_COUNT transfers are queued on each of the two bulk
+ * endpoints, with maximum block of NET_ETH_MAX_FRAME_SIZE.
  */
 NET_BUF_POOL_FIXED_DEFINE(cdc_ecm_ep_pool,
-			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2 *
+			  CDC_ECM_TRANSFER_COUNT,
 			  NET_ETH_MAX_FRAME_SIZE,
-			  sizeof(struct udc_buf_info), NULL);
+			  sizeof(struct udc_buf_info), cdc_ecm_buf_destroy);
 
 struct cdc_ecm_notification {
 	union {
@@ -88,8 +94,13 @@ struct cdc_ecm_eth_data {
 	struct net_if *iface;
 	uint8_t mac_addr[6];
 
+	/* Free IN transfer slots */
 	struct k_sem sync_sem;
 	struct k_sem notif_sem;
+	/* Restarts OUT transfers once buffers are freed */
+	struct k_work out_work;
+	/* Number of OUT transfers queued */
+	atomic_t out_queued;
 	atomic_t state;
 };
 
@@ -205,29 +216,62 @@ static int cdc_ecm_out_start(struct usbd_class_data *const c_data)
 	struct cdc_ecm_eth_data *data = dev->data;
 	struct net_buf *buf;
 	uint8_t ep;
-	int ret;
+	int ret = 0;
 
 	if (!atomic_test_bit(&data->state, CDC_ECM_CLASS_ENABLED)) {
 		return -EACCES;
 	}
 
-	if (atomic_test_and_set_bit(&data->state, CDC_ECM_OUT_ENGAGED)) {
-		return -EBUSY;
-	}
-
 	ep = cdc_ecm_get_bulk_out(c_data);
-	buf = cdc_ecm_buf_alloc(ep);
-	if (buf == NULL) {
-		return -ENOMEM;
+
+	while (atomic_inc(&data->out_queued) < CDC_ECM_TRANSFER_COUNT) {
+		buf = cdc_ecm_buf_alloc(ep);
+		if (buf == NULL) {
+			/* Restarted once the network stack frees a buffer */
+			atomic_set_bit(&data->state, CDC_ECM_OUT_STARVED);
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = usbd_ep_enqueue(c_data, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			net_buf_unref(buf);
+			break;
+		}
 	}
 
-	ret = usbd_ep_enqueue(c_data, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
+	/* Undo the increment which did not queue a transfer */
+	atomic_dec(&data->out_queued);
+
+	return atomic_get(&data->out_queued) ? 0 : ret;
+}
+
+static void cdc_ecm_out_work_handler(struct k_work *work)
+{
+	struct cdc_ecm_eth_data *data;
+
+	data = CONTAINER_OF(work, struct cdc_ecm_eth_data, out_work);
+	(void)cdc_ecm_out_start(data->c_data);
+}
+
+static void cdc_ecm_buf_destroy(struct net_buf *buf)
+{
+	struct udc_buf_info *bi = udc_get_buf_info(buf);
+	struct usbd_class_data *c_data = bi->owner;
+	const uint8_t ep = bi->ep;
+	struct cdc_ecm_eth_data *data;
+
+	net_buf_destroy(buf);
+
+	if (c_data == NULL || !USB_EP_DIR_IS_OUT(ep)) {
+		return;
 	}
 
-	return  ret;
+	data = ((const struct device *)usbd_class_get_private(c_data))->data;
+	if (atomic_test_and_clear_bit(&data->state, CDC_ECM_OUT_STARVED)) {
+		k_work_submit(&data->out_work);
+	}
 }
 
 static int cdc_ecm_acl_out_cb(struct usbd_class_data *const c_data,
@@ -254,17 +298,29 @@ static int cdc_ecm_acl_out_cb(struct usbd_class_data *const c_data,
 		}
 	}
 
-	pkt = net_pkt_rx_alloc_with_buffer(data->iface, buf->len,
-					   AF_UNSPEC, 0, K_FOREVER);
-	if (!pkt) {
-		LOG_ERR("No memory for net_pkt");
-		goto restart_out_transfer;
-	}
+	if (IS_ENABLED(CONFIG_USBD_CDC_ECM_RX_ZERO_COPY)) {
+		pkt = net_pkt_rx_alloc_on_iface(data->iface, K_FOREVER);
+		if (!pkt) {
+			LOG_ERR("No memory for net_pkt");
+			goto restart_out_transfer;
+		}
 
-	if (net_pkt_write(pkt, buf->data, buf->len)) {
-		LOG_ERR("Unable to write into pkt");
-		net_pkt_unref(pkt);
-		goto restart_out_transfer;
+		/* The packet takes over the transfer buffer */
+		net_pkt_append_buffer(pkt, buf);
+		buf = NULL;
+	} else {
+		pkt = net_pkt_rx_alloc_with_buffer(data->iface, buf->len,
+						   AF_UNSPEC, 0, K_FOREVER);
+		if (!pkt) {
+			LOG_ERR("No memory for net_pkt");
+			goto restart_out_transfer;
+		}
+
+		if (net_pkt_write(pkt, buf->data, buf->len)) {
+			LOG_ERR("Unable to write into pkt");
+			net_pkt_unref(pkt);
+			goto restart_out_transfer;
+		}
 	}
 
 	LOG_DBG("Received packet len %zu", net_pkt_get_len(pkt));
@@ -274,8 +330,11 @@ static int cdc_ecm_acl_out_cb(struct usbd_class_data *const c_data,
 	}
 
 restart_out_transfer:
-	net_buf_unref(buf);
-	atomic_clear_bit(&data->state, CDC_ECM_OUT_ENGAGED);
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+
+	atomic_dec(&data->out_queued);
 
 	return cdc_ecm_out_start(c_data);
 }
@@ -295,6 +354,7 @@ static int usbd_cdc_ecm_request(struct usbd_class_data *const c_data,
 	}
 
 	if (bi->ep == cdc_ecm_get_bulk_in(c_data)) {
+		net_buf_unref(buf);
 		k_sem_give(&data->sync_sem);
 
 		return 0;
@@ -504,15 +564,20 @@ static int cdc_ecm_send(const struct device *dev, struct net_pkt *const pkt)
 		return -EACCES;
 	}
 
+	/* Wait for one of the transfers in flight to complete */
+	k_sem_take(&data->sync_sem, K_FOREVER);
+
 	buf = cdc_ecm_buf_alloc(cdc_ecm_get_bulk_in(c_data));
 	if (buf == NULL) {
 		LOG_ERR("Failed to allocate buffer");
+		k_sem_give(&data->sync_sem);
 		return -ENOMEM;
 	}
 
 	if (net_pkt_read(pkt, buf->data, len)) {
 		LOG_ERR("Failed copy net_pkt");
 		net_buf_unref(buf);
+		k_sem_give(&data->sync_sem);
 
 		return -ENOBUFS;
 	}
@@ -523,9 +588,14 @@ static int cdc_ecm_send(const struct device *dev, struct net_pkt *const pkt)
 		udc_ep_buf_set_zlp(buf);
 	}
 
-	usbd_ep_enqueue(c_data, buf);
-	k_sem_take(&data->sync_sem, K_FOREVER);
-	net_buf_unref(buf);
+	/* The buffer is released on completion, pkt can be freed meanwhile */
+	if (usbd_ep_enqueue(c_data, buf)) {
+		LOG_ERR("Failed to enqueue net_buf");
+		net_buf_unref(buf);
+		k_sem_give(&data->sync_sem);
+
+		return -EIO;
+	}
 
 	return 0;
 }
@@ -612,6 +682,8 @@ static int usbd_cdc_ecm_preinit(const struct device *dev)
 		gen_random_mac(data->mac_addr, 0, 0, 0);
 	}
 
+	k_work_init(&data->out_work, cdc_ecm_out_work_handler);
+
 	LOG_DBG("CDC ECM device initialized");
 
 	return 0;
@@ -816,7 +888,9 @@ static struct usbd_cdc_ecm_desc cdc_ecm_desc_##n = {				\
 	static struct cdc_ecm_eth_data eth_data_##n = {				\
 		.c_data = &cdc_ecm_##n,						\
 		.mac_addr = DT_INST_PROP_OR(n, local_mac_address, {0}),		\
-		.sync_sem = Z_SEM_INITIALIZER(eth_data_##n.sync_sem, 0, 1),	\
+		.sync_sem = Z_SEM_INITIALIZER(eth_data_##n.sync_sem,		\
+					      CDC_ECM_TRANSFER_COUNT,		\
+					      CDC_ECM_TRANSFER_COUNT),		\
 		.notif_sem = Z_SEM_INITIALIZER(eth_data_##n.notif_sem, 0, 1),	\
 		.mac_desc_data = &mac_desc_data_##n,				\
 		.desc = &cdc_ecm_desc_##n,					\
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2023 Nordic Semiconductor ASA
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -200,9 +201,17 @@ static void msc_queue_bulk_out_ep(struct usbd_class_data *const c_data)
 
 static void msc_stall_bulk_out_ep(struct usbd_class_data *const c_data)
 {
+	struct msc_bot_ctx *ctx = usbd_class_get_private(c_data);
 	uint8_t ep;
 
 	ep = msc_get_bulk_out(c_data);
+
+	if (IS_ENABLED(CONFIG_USBD_MSC_DOUBLE_BUFFERING) &&
+	    atomic_test_bit(&ctx->bits, MSC_BULK_OUT_QUEUED)) {
+		/* Do not let the transfer queued ahead pick up the next CBW */
+		usbd_ep_dequeue(usbd_class_get_ctx(c_data), ep);
+	}
+
 	usbd_ep_set_halt(usbd_class_get_ctx(c_data), ep);
 }
 
@@ -253,6 +262,7 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 {
 	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
 	int bytes_queued = 0;
+	bool refill = false;
 	struct net_buf *buf;
 	uint8_t ep;
 	size_t len;
@@ -292,6 +302,13 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 		ctx->scsi_offset += len;
 
 		if (ctx->scsi_bytes == ctx->scsi_offset) {
+			if (IS_ENABLED(CONFIG_USBD_MSC_DOUBLE_BUFFERING) &&
+			    bytes_queued == MSC_BUF_SIZE) {
+				/* Read from the disk while the net buf is sent */
+				refill = true;
+				break;
+			}
+
 			/* SCSI buffer can be reused now */
 			ctx->scsi_bytes = scsi_read_data(lun, ctx->scsi_buf);
 			ctx->scsi_offset = 0;
@@ -306,6 +323,11 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 		net_buf_unref(buf);
 		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
 	}
+
+	if (refill) {
+		ctx->scsi_bytes = scsi_read_data(lun, ctx->scsi_buf);
+		ctx->scsi_offset = 0;
+	}
 }
 
 static void msc_process_cbw(struct msc_bot_ctx *ctx)
@@ -460,6 +482,24 @@ static void msc_process_write(struct msc_bot_ctx *ctx,
 	}
 }
 
+/*
+ * Queue the next OUT transfer before the received data is written to the
+ * disk, if the host still has data to send for the current command.
+ */
+static void msc_queue_next_write(struct msc_bot_ctx *ctx, size_t len)
+{
+	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
+
+	if ((ctx->state != MSC_BBB_PROCESS_WRITE) ||
+	    (ctx->transferred_data + len >= ctx->cbw.dCBWDataTransferLength) ||
+	    (ctx->scsi_bytes + len >= scsi_cmd_remaining_data_len(lun))) {
+		/* Last data of the command, next OUT transfer is a CBW */
+		return;
+	}
+
+	msc_queue_bulk_out_ep(ctx->class_node);
+}
+
 static void msc_handle_bulk_out(struct msc_bot_ctx *ctx,
 				uint8_t *buf, size_t len)
 {
@@ -571,6 +611,12 @@ static void usbd_msc_handle_request(struct usbd_class_data *c_data,
 	struct udc_buf_info *bi;
 
 	bi = udc_get_buf_info(buf);
+	if (bi->ep == msc_get_bulk_out(c_data)) {
+		atomic_clear_bit(&ctx->bits, MSC_BULK_OUT_QUEUED);
+	} else if (bi->ep == msc_get_bulk_in(c_data)) {
+		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
+	}
+
 	if (err) {
 		if (err == -ECONNABORTED) {
 			LOG_WRN("request ep 0x%02x, len %u cancelled",
@@ -584,17 +630,16 @@ static void usbd_msc_handle_request(struct usbd_class_data *c_data,
 	}
 
 	if (bi->ep == msc_get_bulk_out(c_data)) {
+		if (IS_ENABLED(CONFIG_USBD_MSC_DOUBLE_BUFFERING)) {
+			msc_queue_next_write(ctx, buf->len);
+		}
+
 		msc_handle_bulk_out(ctx, buf->data, buf->len);
 	} else if (bi->ep == msc_get_bulk_in(c_data)) {
 		msc_handle_bulk_in(ctx, buf->data, buf->len);
 	}
 
 ep_request_error:
-	if (bi->ep == msc_get_bulk_out(c_data)) {
-		atomic_clear_bit(&ctx->bits, MSC_BULK_OUT_QUEUED);
-	} else if (bi->ep == msc_get_bulk_in(c_data)) {
-		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
-	}
 	usbd_ep_buf_free(uds_ctx, buf);
 }
 
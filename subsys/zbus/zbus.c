@@ -8,6 +8,7 @@
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/net/buf.h>
 #include <zephyr/zbus/zbus.h>
 LOG_MODULE_REGISTER(zbus, CONFIG_ZBUS_LOG_LEVEL);
@@ -53,6 +54,57 @@ static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, si
 
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
+#if defined(CONFIG_ZBUS_ZERO_COPY)
+
+/* Zero-copy message data is shared by the buffers handed to different threads, so its reference
+ * count lives in an atomic in front of the data.
+ */
+#define ZC_DATA_HDR_SIZE WB_UP(sizeof(atomic_t))
+
+static uint8_t *zc_data_alloc(struct net_buf *buf, size_t *size, k_timeout_t timeout)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	uint8_t *hdr = k_heap_alloc(pool->alloc->alloc_data, ZC_DATA_HDR_SIZE + *size, timeout);
+
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	atomic_set((atomic_t *)hdr, 1);
+
+	return hdr + ZC_DATA_HDR_SIZE;
+}
+
+static uint8_t *zc_data_ref(struct net_buf *buf, uint8_t *data)
+{
+	atomic_inc((atomic_t *)(data - ZC_DATA_HDR_SIZE));
+
+	return data;
+}
+
+static void zc_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	uint8_t *hdr = data - ZC_DATA_HDR_SIZE;
+
+	if (atomic_dec((atomic_t *)hdr) == 1) {
+		k_heap_free(pool->alloc->alloc_data, hdr);
+	}
+}
+
+const struct net_buf_data_cb _zbus_zc_data_cb = {
+	.alloc = zc_data_alloc,
+	.ref = zc_data_ref,
+	.unref = zc_data_unref,
+};
+
+static inline struct net_buf **zc_chan_buf(const struct zbus_channel *chan)
+{
+	return (struct net_buf **)chan->message;
+}
+
+#endif /* CONFIG_ZBUS_ZERO_COPY */
+
 int _zbus_init(void)
 {
 
@@ -130,13 +182,18 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 	struct zbus_channel_observation_mask *observation_mask;
 
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
-	buf = _zbus_create_net_buf(&_zbus_msg_subscribers_pool, zbus_chan_msg_size(chan),
-				   sys_timepoint_timeout(end_time));
+	if (zbus_chan_is_zero_copy(chan)) {
+		/* Message subscribers get clones sharing the published data */
+		IF_ENABLED(CONFIG_ZBUS_ZERO_COPY, (buf = net_buf_ref(*zc_chan_buf(chan));))
+	} else {
+		buf = _zbus_create_net_buf(&_zbus_msg_subscribers_pool, zbus_chan_msg_size(chan),
+					   sys_timepoint_timeout(end_time));
 
-	_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
-				  "unavailable or heap is full");
+		_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
+					  "unavailable or heap is full");
 
-	net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+		net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+	}
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 	LOG_DBG("Notifing %s's observers. Starting VDED:", _ZBUS_CHAN_NAME(chan));
@@ -294,7 +351,8 @@ static inline int chan_lock(const struct zbus_channel *chan, k_timeout_t timeout
 	bool boosting = false;
 
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
-	if (!k_is_in_isr()) {
+	/* Sequence locked channels are not read under the lock, no need to hurry */
+	if (!k_is_in_isr() && !zbus_chan_is_seqlock(chan)) {
 		*prio = k_thread_priority_get(k_current_get());
 
 		K_SPINLOCK(&_zbus_chan_slock) {
@@ -343,12 +401,58 @@ static inline void chan_unlock(const struct zbus_channel *chan, int prio)
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 }
 
+#if defined(CONFIG_ZBUS_SEQLOCK)
+
+/* The two message copies work like a latch: the publisher updates the copy readers do not use
+ * while the sequence count is odd, and readers only retry when the copy they read got updated,
+ * which takes two publications. Readers preempting the publisher thus never wait for it.
+ */
+static inline uint8_t *seqlock_msg(const struct zbus_channel *chan, atomic_val_t seq)
+{
+	return (uint8_t *)chan->message + ((seq >> 1) & 1) * chan->message_size;
+}
+
+/* The channel must be locked */
+static void seqlock_write(const struct zbus_channel *chan, const void *msg)
+{
+	atomic_val_t seq = atomic_inc(&chan->data->seq);
+
+	barrier_dmem_fence_full();
+
+	memcpy(seqlock_msg(chan, seq + 2), msg, chan->message_size);
+
+	barrier_dmem_fence_full();
+
+	atomic_inc(&chan->data->seq);
+}
+
+static void seqlock_read(const struct zbus_channel *chan, void *msg)
+{
+	atomic_val_t start;
+	atomic_val_t end;
+
+	do {
+		start = atomic_get(&chan->data->seq);
+
+		barrier_dmem_fence_full();
+
+		memcpy(msg, seqlock_msg(chan, start), chan->message_size);
+
+		barrier_dmem_fence_full();
+
+		end = atomic_get(&chan->data->seq);
+	} while (((unsigned long)end - (unsigned long)(start & ~1)) >= 3);
+}
+
+#endif /* CONFIG_ZBUS_SEQLOCK */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
 
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
+	_ZBUS_ASSERT(!zbus_chan_is_zero_copy(chan), "use zbus_chan_pub_buf for zero-copy channels");
 
 	if (k_is_in_isr()) {
 		timeout = K_NO_WAIT;
@@ -367,7 +471,11 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 		return err;
 	}
 
-	memcpy(chan->message, msg, chan->message_size);
+	if (zbus_chan_is_seqlock(chan)) {
+		IF_ENABLED(CONFIG_ZBUS_SEQLOCK, (seqlock_write(chan, msg);))
+	} else {
+		memcpy(chan->message, msg, chan->message_size);
+	}
 
 	err = _zbus_vded_exec(chan, end_time);
 
@@ -380,11 +488,20 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
+	_ZBUS_ASSERT(!zbus_chan_is_zero_copy(chan), "use zbus_chan_read_buf for zero-copy channels");
 
 	if (k_is_in_isr()) {
 		timeout = K_NO_WAIT;
 	}
 
+#if defined(CONFIG_ZBUS_SEQLOCK)
+	if (zbus_chan_is_seqlock(chan)) {
+		seqlock_read(chan, msg);
+
+		return 0;
+	}
+#endif /* CONFIG_ZBUS_SEQLOCK */
+
 	int err = k_sem_take(&chan->data->sem, timeout);
 	if (err) {
 		return err;
@@ -416,6 +533,14 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+#if defined(CONFIG_ZBUS_ZERO_COPY)
+	if (zbus_chan_is_zero_copy(chan) && *zc_chan_buf(chan) == NULL) {
+		chan_unlock(chan, context_priority);
+
+		return -ENODATA;
+	}
+#endif /* CONFIG_ZBUS_ZERO_COPY */
+
 	err = _zbus_vded_exec(chan, end_time);
 
 	chan_unlock(chan, context_priority);
@@ -423,6 +548,110 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 	return err;
 }
 
+#if defined(CONFIG_ZBUS_ZERO_COPY)
+
+int zbus_chan_buf_alloc(const struct zbus_channel *chan, size_t size, struct net_buf **buf,
+			k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+	_ZBUS_ASSERT(zbus_chan_is_zero_copy(chan), "chan must be a zero-copy channel");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	*buf = net_buf_alloc_len(chan->buf_pool, size, timeout);
+	if (*buf == NULL) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+int zbus_chan_pub_buf(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout)
+{
+	int err;
+	struct net_buf *prev;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+	_ZBUS_ASSERT(zbus_chan_is_zero_copy(chan), "chan must be a zero-copy channel");
+	_ZBUS_ASSERT(net_buf_pool_get(buf->pool_id) == chan->buf_pool,
+		     "buf must be allocated from the channel's pool");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+
+	if (chan->validator != NULL && !chan->validator(buf->data, buf->len)) {
+		net_buf_unref(buf);
+
+		return -ENOMSG;
+	}
+
+	int context_priority = ZBUS_MIN_THREAD_PRIORITY;
+
+	err = chan_lock(chan, timeout, &context_priority);
+	if (err) {
+		net_buf_unref(buf);
+
+		return err;
+	}
+
+	memcpy(net_buf_user_data(buf), &chan, sizeof(struct zbus_channel *));
+
+	prev = *zc_chan_buf(chan);
+	*zc_chan_buf(chan) = buf;
+
+	err = _zbus_vded_exec(chan, end_time);
+
+	chan_unlock(chan, context_priority);
+
+	if (prev != NULL) {
+		net_buf_unref(prev);
+	}
+
+	return err;
+}
+
+int zbus_chan_read_buf(const struct zbus_channel *chan, struct net_buf **buf,
+		       k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+	_ZBUS_ASSERT(zbus_chan_is_zero_copy(chan), "chan must be a zero-copy channel");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+
+	int err = k_sem_take(&chan->data->sem, timeout);
+	if (err) {
+		return err;
+	}
+
+	if (*zc_chan_buf(chan) == NULL) {
+		err = -ENODATA;
+	} else {
+		/* A clone, so that the caller owns its buffer and only the data is shared */
+		*buf = net_buf_clone(*zc_chan_buf(chan), sys_timepoint_timeout(end_time));
+		if (*buf == NULL) {
+			err = -ENOMEM;
+		}
+	}
+
+	k_sem_give(&chan->data->sem);
+
+	return err;
+}
+
+#endif /* CONFIG_ZBUS_ZERO_COPY */
+
 int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
@@ -482,6 +711,13 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 
 	*chan = *((struct zbus_channel **)net_buf_user_data(buf));
 
+	if (zbus_chan_is_zero_copy(*chan)) {
+		LOG_ERR("use zbus_sub_wait_buf for zero-copy channel %s", _ZBUS_CHAN_NAME(*chan));
+		net_buf_unref(buf);
+
+		return -ENOTSUP;
+	}
+
 	memcpy(msg, net_buf_remove_mem(buf, zbus_chan_msg_size(*chan)), zbus_chan_msg_size(*chan));
 
 	net_buf_unref(buf);
@@ -489,6 +725,28 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 	return 0;
 }
 
+int zbus_sub_wait_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+		      struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_buf cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	*buf = net_buf_get(sub->message_fifo, timeout);
+
+	if (*buf == NULL) {
+		return -ENOMSG;
+	}
+
+	*chan = *((struct zbus_channel **)net_buf_user_data(*buf));
+
+	return 0;
+}
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 int zbus_obs_set_chan_notification_mask(const struct zbus_observer *obs,
@@ -121,6 +121,7 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	PRINT_STRING(dashline);
 
 	message_queue_test();
+	message_queue_mp_test();
 	sema_test();
 	mutex_test();
 
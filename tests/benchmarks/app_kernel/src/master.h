@@ -77,6 +77,7 @@ extern void recvtask(void *p1, void *p2, void *p3);
 extern void mailbox_test(void);
 extern void sema_test(void);
 extern void message_queue_test(void);
+extern void message_queue_mp_test(void);
 extern void mutex_test(void);
 extern void memorymap_test(void);
 extern void pipe_test(void);
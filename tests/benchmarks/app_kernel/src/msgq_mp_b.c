@@ -0,0 +1,79 @@
+/* msgq_mp_b.c */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#define MP_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MP_MAX_PRODUCERS 4
+#define NR_OF_MSGQ_MP_RUNS (NR_OF_MSGQ_RUNS * MP_MAX_PRODUCERS * 4)
+
+static struct k_thread producer_threads[MP_MAX_PRODUCERS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, MP_MAX_PRODUCERS, MP_STACK_SIZE);
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	int count = (int)(uintptr_t)p1;
+	uint32_t value = 0U;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < count; i++) {
+		k_msgq_put(&DEMOQX4, &value, K_FOREVER);
+		value++;
+	}
+}
+
+static uint32_t run_producers(int n)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	int per_producer = NR_OF_MSGQ_MP_RUNS / n;
+	uint32_t value;
+	timing_t start;
+	timing_t end;
+	uint64_t ns;
+
+	start = timing_timestamp_get();
+	for (int i = 0; i < n; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				MP_STACK_SIZE, producer,
+				(void *)(uintptr_t)per_producer, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < per_producer * n; i++) {
+		k_msgq_get(&DEMOQX4, &value, K_FOREVER);
+	}
+	end = timing_timestamp_get();
+
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	return (uint32_t)(((uint64_t)per_producer * n * NSEC_PER_SEC) / SAFE_DIVISOR(ns));
+}
+
+/**
+ * @brief Message queue throughput with several concurrent producers
+ *
+ * Only runs with kernel threads, as it needs to spawn the producers.
+ */
+void message_queue_mp_test(void)
+{
+	if (k_is_user_context()) {
+		return;
+	}
+
+	PRINT_STRING(dashline);
+	for (int n = 1; n <= MP_MAX_PRODUCERS; n *= 2) {
+		snprintf(msg, MAX_MSG, "4 bytes msgs/s through MSGQ, %d producer(s)", n);
+		PRINT_F(FORMAT, msg, run_producers(n));
+	}
+}
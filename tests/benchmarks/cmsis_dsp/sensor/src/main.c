@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor_convert.h>
+#include <zephyr/sys/byteorder.h>
+#include "../../common/benchmark_common.h"
+
+/* 64 frames of 3-axis samples, a typical FIFO watermark */
+#define PATTERN_LENGTH	(3 * 64)
+
+/* +/-16 g full scale reported with a shift of 5 */
+#define ACCEL_SHIFT	(5)
+#define ACCEL_SCALE	((q31_t)(INT32_MAX / 2))
+
+static int16_t input_i16[PATTERN_LENGTH];
+static uint8_t input_i24[PATTERN_LENGTH * 3];
+static q31_t output_q31[PATTERN_LENGTH];
+static q31_t reference_q31[PATTERN_LENGTH];
+static float output_f32[PATTERN_LENGTH];
+
+static void *sensor_benchmark_setup(void)
+{
+	uint32_t state = 0x12345678;
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		state = state * 1664525 + 1013904223;
+		input_i16[i] = (int16_t)(state >> 16);
+		sys_put_le24(state >> 8, &input_i24[i * 3]);
+	}
+
+	return NULL;
+}
+
+/* Per sample conversion of the kind decoders do in their scalar loops */
+static q31_t scalar_convert(int32_t value, int bits)
+{
+	return (q31_t)(((int64_t)value << (32 - bits)) * ACCEL_SCALE >> 31);
+}
+
+static void check_q31(void)
+{
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		zassert_within(output_q31[i], reference_q31[i], 2, "sample %d: %d != %d", i,
+			       output_q31[i], reference_q31[i]);
+	}
+}
+
+ZTEST(sensor_convert_benchmark, test_benchmark_i16_to_q31_scalar)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	benchmark_begin(&irq_key, &timestamp);
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		reference_q31[i] = scalar_convert(input_i16[i], 16);
+	}
+
+	timespan = benchmark_end(irq_key, timestamp);
+
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+}
+
+ZTEST(sensor_convert_benchmark, test_benchmark_i16_to_q31)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		reference_q31[i] = scalar_convert(input_i16[i], 16);
+	}
+
+	benchmark_begin(&irq_key, &timestamp);
+
+	sensor_convert_i16_to_q31(input_i16, ACCEL_SCALE, 0, output_q31, PATTERN_LENGTH);
+
+	timespan = benchmark_end(irq_key, timestamp);
+
+	check_q31();
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+}
+
+ZTEST(sensor_convert_benchmark, test_benchmark_i24le_to_q31_scalar)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	benchmark_begin(&irq_key, &timestamp);
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		int32_t value = (int32_t)(sys_get_le24(&input_i24[i * 3]) << 8) >> 8;
+
+		reference_q31[i] = scalar_convert(value, 24);
+	}
+
+	timespan = benchmark_end(irq_key, timestamp);
+
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+}
+
+ZTEST(sensor_convert_benchmark, test_benchmark_i24le_to_q31)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		int32_t value = (int32_t)(sys_get_le24(&input_i24[i * 3]) << 8) >> 8;
+
+		reference_q31[i] = scalar_convert(value, 24);
+	}
+
+	benchmark_begin(&irq_key, &timestamp);
+
+	sensor_convert_i24le_to_q31(input_i24, ACCEL_SCALE, 0, output_q31, PATTERN_LENGTH);
+
+	timespan = benchmark_end(irq_key, timestamp);
+
+	check_q31();
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+}
+
+ZTEST(sensor_convert_benchmark, test_benchmark_q31_to_float_scalar)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	sensor_convert_i16_to_q31(input_i16, ACCEL_SCALE, 0, output_q31, PATTERN_LENGTH);
+
+	benchmark_begin(&irq_key, &timestamp);
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		output_f32[i] = (float)output_q31[i] / (float)(INT64_C(1) << (31 - ACCEL_SHIFT));
+	}
+
+	timespan = benchmark_end(irq_key, timestamp);
+
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+}
+
+ZTEST(sensor_convert_benchmark, test_benchmark_q31_to_float)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	sensor_convert_i16_to_q31(input_i16, ACCEL_SCALE, 0, output_q31, PATTERN_LENGTH);
+
+	benchmark_begin(&irq_key, &timestamp);
+
+	sensor_convert_q31_to_float(output_q31, ACCEL_SHIFT, output_f32, PATTERN_LENGTH);
+
+	timespan = benchmark_end(irq_key, timestamp);
+
+	for (int i = 0; i < PATTERN_LENGTH; ++i) {
+		float expected = (float)output_q31[i] / (float)(INT64_C(1) << (31 - ACCEL_SHIFT));
+
+		zassert_within(output_f32[i], expected, 1e-5f, "sample %d", i);
+	}
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+}
+
+ZTEST_SUITE(sensor_convert_benchmark, NULL, sensor_benchmark_setup, NULL, NULL, NULL);
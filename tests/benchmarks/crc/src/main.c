@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/crc.h>
+
+/* CRC benchmark. Measures the average cost of computing each CRC over
+ * one KiB of data, the result is kept so the calls are not optimized out.
+ */
+
+#define ROUNDS 64
+
+static uint8_t data[1024];
+static volatile uint32_t sink;
+
+static uint32_t bench_crc8_ccitt(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		sink = crc8_ccitt(0xFF, data, sizeof(data));
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static uint32_t bench_crc16_ccitt(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		sink = crc16_ccitt(0xFFFF, data, sizeof(data));
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static uint32_t bench_crc32_ieee(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		sink = crc32_ieee(data, sizeof(data));
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static uint32_t bench_crc32_c(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		sink = crc32_c(0, data, sizeof(data), true, true);
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	printk("crc8_ccitt %u cycles/KiB\n", bench_crc8_ccitt());
+	printk("crc16_ccitt %u cycles/KiB\n", bench_crc16_ccitt());
+	printk("crc32_ieee %u cycles/KiB\n", bench_crc32_ieee());
+	printk("crc32_c %u cycles/KiB\n", bench_crc32_c());
+	printk("fin\n");
+
+	return 0;
+}
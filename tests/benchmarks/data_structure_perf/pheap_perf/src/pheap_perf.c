@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/pheap.h>
+#include <zephyr/sys/rb.h>
+
+#define QUEUE_SIZE 2048
+#define ROUNDS	   4096
+
+/* Both nodes on the same entry, as a thread with either ready queue */
+struct entry {
+	union {
+		struct rbnode rb;
+		struct pheap_node ph;
+	};
+	uint32_t key;
+	/* Tie-breaker, like the scheduler's order key */
+	uint32_t order;
+};
+
+static struct entry entries[QUEUE_SIZE];
+static struct entry saved[QUEUE_SIZE];
+static uint32_t next_order;
+
+static bool entry_lessthan(const struct entry *a, const struct entry *b)
+{
+	return a->key != b->key ? a->key < b->key : a->order < b->order;
+}
+
+static bool rb_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return entry_lessthan(CONTAINER_OF(a, struct entry, rb), CONTAINER_OF(b, struct entry, rb));
+}
+
+static bool ph_lessthan(struct pheap_node *a, struct pheap_node *b)
+{
+	return entry_lessthan(CONTAINER_OF(a, struct entry, ph), CONTAINER_OF(b, struct entry, ph));
+}
+
+static void fill(void)
+{
+	uint32_t seed = 1;
+
+	next_order = 0;
+
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		/* Any sequence will do, as long as it is the same for both */
+		seed = seed * 1103515245U + 12345U;
+		entries[i].key = (seed >> 16) % 128;
+		entries[i].order = next_order++;
+	}
+}
+
+/* A ready queue workload: the best entry is looked up and requeued
+ * with a new key, and every so often an arbitrary entry is taken out
+ * and put back, as when a thread gets pended or resumed.
+ */
+static uint32_t run_rb(struct rbtree *tree, uint32_t *checksum)
+{
+	uint32_t start = k_cycle_get_32();
+	struct entry *e;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		e = CONTAINER_OF(rb_get_min(tree), struct entry, rb);
+		*checksum = *checksum * 31 + (e - entries);
+
+		rb_remove(tree, &e->rb);
+		e->key = (e->key + i) % 128;
+		e->order = next_order++;
+		rb_insert(tree, &e->rb);
+
+		if (i % 4 == 0) {
+			e = &entries[(i * 7) % QUEUE_SIZE];
+			rb_remove(tree, &e->rb);
+			e->order = next_order++;
+			rb_insert(tree, &e->rb);
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static uint32_t run_pheap(struct pheap *heap, uint32_t *checksum)
+{
+	uint32_t start = k_cycle_get_32();
+	struct entry *e;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		e = CONTAINER_OF(pheap_get_min(heap), struct entry, ph);
+		*checksum = *checksum * 31 + (e - entries);
+
+		pheap_remove(heap, &e->ph);
+		e->key = (e->key + i) % 128;
+		e->order = next_order++;
+		pheap_insert(heap, &e->ph);
+
+		if (i % 4 == 0) {
+			e = &entries[(i * 7) % QUEUE_SIZE];
+			pheap_remove(heap, &e->ph);
+			e->order = next_order++;
+			pheap_insert(heap, &e->ph);
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+/**
+ * @brief Test that a pairing heap returns its nodes in order
+ *
+ * @ingroup lib_pheap_tests
+ *
+ * @see pheap_insert(), pheap_remove(), pheap_get_min()
+ */
+ZTEST(pheap_perf, test_pheap_order)
+{
+	struct pheap heap = {.lessthan_fn = ph_lessthan};
+	struct entry *prev = NULL, *e;
+
+	fill();
+
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		pheap_insert(&heap, &entries[i].ph);
+	}
+
+	/* Remove from the middle of the heap too */
+	for (int i = 0; i < QUEUE_SIZE; i += 3) {
+		pheap_remove(&heap, &entries[i].ph);
+	}
+
+	while (!pheap_is_empty(&heap)) {
+		e = CONTAINER_OF(pheap_get_min(&heap), struct entry, ph);
+		zassert_true((e - entries) % 3 != 0, "removed node still in heap");
+		zassert_true(prev == NULL || entry_lessthan(prev, e), "nodes out of order");
+		pheap_remove(&heap, &e->ph);
+		prev = e;
+	}
+}
+
+/**
+ * @brief Compare the pairing heap with the red/black tree as ready queue
+ *
+ * @details Run the same ready queue workload on both, check that they
+ * pick the same entries and report the cycles taken by either.
+ *
+ * @ingroup lib_pheap_tests
+ */
+ZTEST(pheap_perf, test_pheap_vs_rbtree)
+{
+	struct rbtree tree = {.lessthan_fn = rb_lessthan};
+	struct pheap heap = {.lessthan_fn = ph_lessthan};
+	uint32_t rb_checksum = 0, ph_checksum = 0;
+	uint32_t rb_cycles, ph_cycles;
+
+	fill();
+	memcpy(saved, entries, sizeof(saved));
+
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		rb_insert(&tree, &entries[i].rb);
+	}
+	rb_cycles = run_rb(&tree, &rb_checksum);
+
+	memcpy(entries, saved, sizeof(entries));
+	next_order = QUEUE_SIZE;
+
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		pheap_insert(&heap, &entries[i].ph);
+	}
+	ph_cycles = run_pheap(&heap, &ph_checksum);
+
+	TC_PRINT("%d entries, %d rounds: rbtree %u cycles, pheap %u cycles\n", QUEUE_SIZE,
+		 ROUNDS, rb_cycles, ph_cycles);
+
+	zassert_equal(rb_checksum, ph_checksum, "pheap and rbtree disagree on the minimum");
+}
+
+ZTEST_SUITE(pheap_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(bench_radio, LOG_LEVEL_WRN);
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/net/ieee802154_radio.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include <ieee802154_frame.h>
+
+/* Loopback radio for the benchmark. The channel is always clear, frames
+ * are counted and dropped, and frames requesting an ACK are acknowledged
+ * at once, so only the cost of the L2 shows up in the measurements.
+ */
+
+uint32_t bench_radio_tx_count;
+
+static uint8_t bench_ext_addr_be[8] = {0x00, 0x12, 0x4b, 0x00, 0x00, 0x9e, 0xa3, 0xc2};
+
+static struct net_pkt *ack_pkt;
+
+static enum ieee802154_hw_caps bench_get_capabilities(const struct device *dev)
+{
+	return IEEE802154_HW_FCS;
+}
+
+static int bench_cca(const struct device *dev)
+{
+	return 0;
+}
+
+static int bench_set_channel(const struct device *dev, uint16_t channel)
+{
+	return 0;
+}
+
+static int bench_set_txpower(const struct device *dev, int16_t dbm)
+{
+	return 0;
+}
+
+static int bench_tx(const struct device *dev, enum ieee802154_tx_mode mode,
+		    struct net_pkt *pkt, struct net_buf *frag)
+{
+	bench_radio_tx_count++;
+
+	if (ieee802154_is_ar_flag_set(frag)) {
+		struct net_if *iface = net_if_lookup_by_dev(dev);
+		struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+		/* The ACK packet is reused, ieee802154_handle_ack() keeps no
+		 * reference to it.
+		 */
+		if (!ack_pkt) {
+			ack_pkt = net_pkt_rx_alloc_with_buffer(iface, IEEE802154_ACK_PKT_LENGTH,
+							       AF_UNSPEC, 0, K_FOREVER);
+			if (!ack_pkt) {
+				return -ENOMEM;
+			}
+		}
+
+		net_buf_reset(ack_pkt->buffer);
+
+		if (!ieee802154_create_ack_frame(iface, ack_pkt, ctx->ack_seq)) {
+			return -EFAULT;
+		}
+
+		ieee802154_handle_ack(iface, ack_pkt);
+	}
+
+	return 0;
+}
+
+static int bench_start(const struct device *dev)
+{
+	return 0;
+}
+
+static int bench_stop(const struct device *dev)
+{
+	return 0;
+}
+
+IEEE802154_DEFINE_PHY_SUPPORTED_CHANNELS(drv_attr, 11, 26);
+
+static int bench_attr_get(const struct device *dev, enum ieee802154_attr attr,
+			  struct ieee802154_attr_value *value)
+{
+	ARG_UNUSED(dev);
+
+	return ieee802154_attr_get_channel_page_and_range(
+		attr, IEEE802154_ATTR_PHY_CHANNEL_PAGE_ZERO_OQPSK_2450_BPSK_868_915,
+		&drv_attr.phy_supported_channels, value);
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+
+	net_if_set_link_addr(iface, bench_ext_addr_be, sizeof(bench_ext_addr_be),
+			     NET_LINK_IEEE802154);
+
+	ieee802154_init(iface);
+
+	ctx->pan_id = 0xabcd;
+	ctx->short_addr = 0x0001;
+	ctx->channel = 26U;
+}
+
+static int bench_init(const struct device *dev)
+{
+	return 0;
+}
+
+static struct ieee802154_radio_api bench_radio_api = {
+	.iface_api.init = bench_iface_init,
+
+	.get_capabilities = bench_get_capabilities,
+	.cca = bench_cca,
+	.set_channel = bench_set_channel,
+	.set_txpower = bench_set_txpower,
+	.start = bench_start,
+	.stop = bench_stop,
+	.tx = bench_tx,
+	.attr_get = bench_attr_get,
+};
+
+NET_DEVICE_INIT(bench_radio, "bench_ieee802154", bench_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_radio_api, IEEE802154_L2,
+		NET_L2_GET_CTX_TYPE(IEEE802154_L2), IEEE802154_MTU);
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "6lo.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+
+#include "ieee802154_6lo_fragment.h"
+#include "ieee802154_frame.h"
+#include "ieee802154_priv.h"
+#include "ieee802154_security.h"
+
+/* IEEE 802.15.4 L2 benchmark. Measures the average cost of each stage a
+ * frame goes through, against the loopback radio of bench_radio.c. The
+ * set up of each round (allocating and filling packets) is not measured,
+ * only the calls into the stage under test are.
+ */
+
+#define ROUNDS 64
+
+/* UDP payload of the datagrams that fit into one frame, and of the
+ * 1280 bytes datagrams that have to be fragmented.
+ */
+#define SMALL_PAYLOAD 64
+#define LARGE_PAYLOAD (NET_IPV6_MTU - NET_IPV6UDPH_LEN)
+
+#define MAX_FRAGS 24
+
+extern uint32_t bench_radio_tx_count;
+
+static struct net_if *iface;
+
+/* 2006 data frame from 0x0001 to 0x0002 in PAN 0xabcd, no ACK requested */
+static uint8_t data_frame[IEEE802154_MTU] = {
+	0x41, 0x98, 0x01, 0xcd, 0xab, 0x02, 0x00, 0x01, 0x00,
+};
+
+#define DATA_HDR_LEN 9
+#define DATA_AR_BIT 0x20
+
+static uint8_t payload[LARGE_PAYLOAD];
+
+static uint8_t frags[MAX_FRAGS][IEEE802154_MTU];
+static uint8_t frag_lens[MAX_FRAGS];
+static int frag_count;
+
+static uint8_t frame_buffer_data[IEEE802154_MTU];
+
+static struct net_buf frame_buf = {
+	.data = frame_buffer_data,
+	.size = IEEE802154_MTU,
+	.__buf = frame_buffer_data,
+};
+
+static uint16_t dst_short_addr = 0x0002;
+
+static const struct in6_addr src_addr = {{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x01}}};
+static const struct in6_addr dst_addr = {{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x02}}};
+
+static void report(const char *name, uint64_t cycles, uint32_t frames)
+{
+	uint32_t per_frame = frames ? (uint32_t)(cycles / frames) : 0U;
+	uint64_t per_sec = per_frame ? sys_clock_hw_cycles_per_sec() / per_frame : 0U;
+
+	printk("%s %u frames/s %u cycles/frame\n", name, (uint32_t)per_sec, per_frame);
+}
+
+static struct net_pkt *create_datagram(size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, NET_UDPH_LEN + len, AF_INET6, IPPROTO_UDP,
+					K_FOREVER);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv6_create(pkt, &src_addr, &dst_addr) ||
+	    net_udp_create(pkt, htons(4242), htons(4242)) ||
+	    net_pkt_write(pkt, payload, len)) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv6_finalize(pkt, IPPROTO_UDP);
+
+	memcpy(net_pkt_lladdr_src(pkt), net_if_get_link_addr(iface), sizeof(struct net_linkaddr));
+	net_pkt_lladdr_dst(pkt)->addr = (uint8_t *)&dst_short_addr;
+	net_pkt_lladdr_dst(pkt)->len = sizeof(dst_short_addr);
+	net_pkt_lladdr_dst(pkt)->type = NET_LINK_IEEE802154;
+
+	return pkt;
+}
+
+/* Channel access (CSMA-CA or ALOHA), the radio and, for frames requesting
+ * one, the ACK exchange.
+ */
+static void bench_tx(const char *name, bool ack)
+{
+	struct net_pkt *pkt;
+	uint32_t start, sent;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(data_frame), AF_UNSPEC, 0, K_FOREVER);
+	if (!pkt) {
+		return;
+	}
+
+	if (ack) {
+		data_frame[0] |= DATA_AR_BIT;
+	}
+
+	net_buf_add_mem(pkt->buffer, data_frame, DATA_HDR_LEN + SMALL_PAYLOAD);
+	data_frame[0] &= ~DATA_AR_BIT;
+
+	sent = bench_radio_tx_count;
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		(void)ieee802154_radio_send(iface, pkt, pkt->buffer);
+	}
+
+	report(name, k_cycle_get_32() - start, bench_radio_tx_count - sent);
+
+	net_pkt_unref(pkt);
+}
+
+static void bench_rx_parse(void)
+{
+	struct ieee802154_mpdu mpdu;
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		(void)ieee802154_validate_frame(data_frame, DATA_HDR_LEN + SMALL_PAYLOAD, &mpdu);
+	}
+
+	report("rx parse", k_cycle_get_32() - start, ROUNDS);
+}
+
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+/* AES-CCM* with a 32 bit MIC over a frame filled up to the MTU */
+#define SEC_AUTHTAG_LEN 4
+#define SEC_PAYLOAD_LEN (sizeof(data_frame) - DATA_HDR_LEN - SEC_AUTHTAG_LEN)
+
+static void bench_security(void)
+{
+	static uint8_t key[16] = {0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+				  0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf};
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	struct ieee802154_security_ctx *sec_ctx = &ctx->sec_ctx;
+	static uint8_t secured[sizeof(data_frame)];
+	static uint8_t frame[sizeof(data_frame)];
+	uint8_t ext_addr_le[8];
+	uint32_t frame_counter;
+	uint64_t cycles = 0U;
+	uint32_t start;
+
+	if (ieee802154_security_setup_session(sec_ctx, IEEE802154_SECURITY_LEVEL_ENC_MIC_32,
+					      IEEE802154_KEY_ID_MODE_IMPLICIT, key,
+					      sizeof(key))) {
+		printk("security session set up failed\n");
+		return;
+	}
+
+	sys_memcpy_swap(ext_addr_le, net_if_get_link_addr(iface)->addr, sizeof(ext_addr_le));
+
+	/* Frames are ciphered in place, the rounds cipher the output of the
+	 * previous round.
+	 */
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		(void)ieee802154_encrypt_auth(sec_ctx, data_frame, DATA_HDR_LEN, SEC_PAYLOAD_LEN,
+					      SEC_AUTHTAG_LEN, ext_addr_le);
+	}
+
+	report("encrypt", k_cycle_get_32() - start, ROUNDS);
+
+	/* Each round deciphers a copy of the same secured frame. */
+	frame_counter = sec_ctx->frame_counter;
+	memcpy(secured, data_frame, sizeof(secured));
+	(void)ieee802154_encrypt_auth(sec_ctx, secured, DATA_HDR_LEN, SEC_PAYLOAD_LEN,
+				      SEC_AUTHTAG_LEN, ext_addr_le);
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy(frame, secured, sizeof(frame));
+
+		start = k_cycle_get_32();
+		if (!ieee802154_decrypt_auth(sec_ctx, frame, DATA_HDR_LEN, SEC_PAYLOAD_LEN,
+					     SEC_AUTHTAG_LEN, ext_addr_le, frame_counter)) {
+			printk("decryption failed\n");
+			break;
+		}
+		cycles += k_cycle_get_32() - start;
+	}
+
+	report("decrypt", cycles, ROUNDS);
+
+	ieee802154_security_teardown_session(sec_ctx);
+}
+#endif /* CONFIG_NET_L2_IEEE802154_SECURITY */
+
+static void bench_6lo_compress(void)
+{
+	uint64_t cycles = 0U;
+	struct net_pkt *pkt;
+	uint32_t start;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		pkt = create_datagram(SMALL_PAYLOAD);
+		if (!pkt) {
+			return;
+		}
+
+		start = k_cycle_get_32();
+		(void)net_6lo_compress(pkt, true);
+		cycles += k_cycle_get_32() - start;
+
+		net_pkt_unref(pkt);
+	}
+
+	report("6lo compress", cycles, ROUNDS);
+}
+
+/* Fragments a compressed 1280 bytes datagram. The fragments of the first
+ * round are kept for the reassembly benchmark.
+ */
+static void bench_6lo_fragment(void)
+{
+	struct ieee802154_6lo_fragment_ctx ctx;
+	uint32_t frames = 0U;
+	uint64_t cycles = 0U;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	uint32_t start;
+	int hdr_diff;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		pkt = create_datagram(LARGE_PAYLOAD);
+		if (!pkt) {
+			return;
+		}
+
+		hdr_diff = net_6lo_compress(pkt, true);
+
+		start = k_cycle_get_32();
+
+		ieee802154_6lo_fragment_ctx_init(&ctx, pkt, hdr_diff, true);
+
+		buf = pkt->buffer;
+		while (buf) {
+			frame_buf.len = 0U;
+			buf = ieee802154_6lo_fragment(&ctx, &frame_buf, true);
+			frames++;
+
+			if (r == 0 && frag_count < MAX_FRAGS) {
+				memcpy(frags[frag_count], frame_buf.data, frame_buf.len);
+				frag_lens[frag_count++] = frame_buf.len;
+			}
+		}
+
+		cycles += k_cycle_get_32() - start;
+
+		net_pkt_unref(pkt);
+	}
+
+	report("6lo fragment", cycles, frames);
+}
+
+static void bench_6lo_reassemble(void)
+{
+	uint32_t frames = 0U;
+	uint64_t cycles = 0U;
+	struct net_pkt *pkt;
+	enum net_verdict verdict;
+	uint32_t start;
+
+	if (frag_count == 0 || frag_count == MAX_FRAGS) {
+		printk("no fragments to reassemble\n");
+		return;
+	}
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < frag_count; i++) {
+			pkt = net_pkt_rx_alloc_with_buffer(iface, frag_lens[i], AF_UNSPEC, 0,
+							   K_FOREVER);
+			if (!pkt) {
+				return;
+			}
+
+			net_buf_add_mem(pkt->buffer, frags[i], frag_lens[i]);
+			net_pkt_set_overwrite(pkt, true);
+
+			start = k_cycle_get_32();
+			verdict = ieee802154_6lo_reassemble(pkt);
+			cycles += k_cycle_get_32() - start;
+			frames++;
+
+			if (verdict != NET_OK) {
+				net_pkt_unref(pkt);
+			}
+		}
+	}
+
+	report("6lo reassemble", cycles, frames);
+}
+
+int main(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(IEEE802154));
+	if (!iface) {
+		printk("no IEEE 802.15.4 interface\n");
+		return 0;
+	}
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	memcpy(data_frame + DATA_HDR_LEN, payload, sizeof(data_frame) - DATA_HDR_LEN);
+
+	bench_tx(IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_ALOHA) ? "tx aloha" : "tx csma",
+		 false);
+	bench_tx("tx ack", true);
+	bench_rx_parse();
+#ifdef CONFIG_NET_L2_IEEE802154_SECURITY
+	bench_security();
+#endif
+	bench_6lo_compress();
+	bench_6lo_fragment();
+	bench_6lo_reassemble();
+	printk("fin\n");
+
+	return 0;
+}
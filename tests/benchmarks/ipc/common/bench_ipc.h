@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IPC_BENCHMARK_BENCH_IPC_H
+#define IPC_BENCHMARK_BENCH_IPC_H
+
+#include <stdint.h>
+#include <zephyr/devicetree.h>
+
+/* Protocol spoken between the two cores, shared by both images */
+
+#define BENCH_EPT_NAME "bench"
+
+enum bench_msg_type {
+	/* Reply with a message of the same size */
+	BENCH_MSG_ECHO,
+	/* Reply with the header only */
+	BENCH_MSG_ECHO_SHORT,
+	/* Count the message, without replying */
+	BENCH_MSG_STREAM,
+	/* Reply with the number of messages counted since the last one */
+	BENCH_MSG_STREAM_END,
+};
+
+struct bench_msg_hdr {
+	uint32_t type;
+	uint32_t seq;
+};
+
+/* Largest message, small enough for the RPMsg buffers of 512 bytes */
+#define BENCH_MSG_SIZE_MAX 480
+
+#define BENCH_NODE DT_NODELABEL(ipc0)
+
+#if DT_NODE_HAS_COMPAT(BENCH_NODE, zephyr_ipc_icmsg)
+#define BENCH_BACKEND_NAME "icmsg"
+#elif DT_NODE_HAS_COMPAT(BENCH_NODE, zephyr_ipc_icmsg_me_initiator) ||                            \
+	DT_NODE_HAS_COMPAT(BENCH_NODE, zephyr_ipc_icmsg_me_follower)
+#define BENCH_BACKEND_NAME "icmsg_me"
+#elif DT_NODE_HAS_COMPAT(BENCH_NODE, zephyr_ipc_icbmsg)
+#define BENCH_BACKEND_NAME "icbmsg"
+#elif DT_NODE_HAS_COMPAT(BENCH_NODE, zephyr_ipc_openamp_static_vrings)
+#define BENCH_BACKEND_NAME "rpmsg"
+#else
+#define BENCH_BACKEND_NAME "unknown"
+#endif
+
+#endif /* IPC_BENCHMARK_BENCH_IPC_H */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Remote side of the IPC benchmark, answering the messages of the host.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/ipc/ipc_service.h>
+
+#include "bench_ipc.h"
+
+static struct ipc_ept ep;
+static uint32_t stream_count;
+static uint8_t reply[BENCH_MSG_SIZE_MAX] __aligned(4);
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	struct bench_msg_hdr hdr;
+	size_t reply_len = sizeof(hdr);
+	int ret;
+
+	ARG_UNUSED(priv);
+
+	if (len < sizeof(hdr) || len > sizeof(reply)) {
+		printk("Unexpected message of %zu bytes\n", len);
+		return;
+	}
+
+	memcpy(&hdr, data, sizeof(hdr));
+
+	switch (hdr.type) {
+	case BENCH_MSG_STREAM:
+		stream_count++;
+		return;
+	case BENCH_MSG_STREAM_END:
+		hdr.seq = stream_count;
+		stream_count = 0U;
+		memcpy(reply, &hdr, sizeof(hdr));
+		break;
+	case BENCH_MSG_ECHO:
+		memcpy(reply, data, len);
+		reply_len = len;
+		break;
+	case BENCH_MSG_ECHO_SHORT:
+		memcpy(reply, &hdr, sizeof(hdr));
+		break;
+	default:
+		printk("Unexpected message type %u\n", hdr.type);
+		return;
+	}
+
+	/*
+	 * Reply from the callback itself, so that no context switch is
+	 * added to the round trips timed by the host.
+	 */
+	do {
+		ret = ipc_service_send(&ep, reply, reply_len);
+	} while (ret == -ENOMEM);
+
+	if (ret < 0) {
+		printk("Failed to reply: %d\n", ret);
+	}
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.name = BENCH_EPT_NAME,
+	.cb = {
+		.received = ep_recv,
+	},
+};
+
+int main(void)
+{
+	const struct device *ipc0_instance = DEVICE_DT_GET(BENCH_NODE);
+	int ret;
+
+	ret = ipc_service_open_instance(ipc0_instance);
+	if (ret < 0 && ret != -EALREADY) {
+		printk("Failed to open the IPC instance: %d\n", ret);
+		return ret;
+	}
+
+	ret = ipc_service_register_endpoint(ipc0_instance, &ep, &ep_cfg);
+	if (ret < 0) {
+		printk("Failed to register the endpoint: %d\n", ret);
+		return ret;
+	}
+
+	printk("IPC benchmark remote ready, backend %s\n", BENCH_BACKEND_NAME);
+
+	return 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * IPC service benchmark, timing the messages exchanged with the remote core.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/ipc/ipc_service.h>
+
+#include "bench_ipc.h"
+
+#define FORMAT_STR "%-24s - %-60s:%10u %-6s,%10u %s\n"
+
+#define PRINT_RESULT(metric, description, value1, unit1, value2, unit2)      \
+	printk(FORMAT_STR, metric, description, (uint32_t)(value1), unit1,   \
+	       (uint32_t)(value2), unit2)
+
+#define PRINT_FAILED(metric, description)                                    \
+	printk("%-24s - %-60s:%10s\n", metric, description, "FAILED")
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define REPLY_TIMEOUT  K_MSEC(1000)
+
+static const size_t msg_sizes[] = {16, 64, 256, BENCH_MSG_SIZE_MAX};
+
+/** Latency of a repeated round trip */
+struct bench_latency {
+	uint64_t sum;
+	uint64_t min;
+	uint64_t max;
+	uint32_t count;
+};
+
+static struct ipc_ept ep;
+static K_SEM_DEFINE(bound_sem, 0, 1);
+static K_SEM_DEFINE(reply_sem, 0, 1);
+
+/* Last reply received, and when it was */
+static struct bench_msg_hdr reply_hdr;
+static size_t reply_len;
+static timing_t reply_time;
+
+static uint8_t tx_buf[BENCH_MSG_SIZE_MAX] __aligned(4);
+static char description[64];
+static int error_count;
+
+static void ep_bound(void *priv)
+{
+	ARG_UNUSED(priv);
+
+	k_sem_give(&bound_sem);
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	ARG_UNUSED(priv);
+
+	/* Timestamped first, not to count the copy in */
+	reply_time = timing_counter_get();
+	reply_len = len;
+	memcpy(&reply_hdr, data, MIN(len, sizeof(reply_hdr)));
+
+	k_sem_give(&reply_sem);
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.name = BENCH_EPT_NAME,
+	.cb = {
+		.bound = ep_bound,
+		.received = ep_recv,
+	},
+};
+
+static int msg_send(uint32_t type, uint32_t seq, size_t len)
+{
+	struct bench_msg_hdr hdr = {.type = type, .seq = seq};
+	int ret;
+
+	memcpy(tx_buf, &hdr, sizeof(hdr));
+
+	/* The backend runs out of buffers when the remote lags behind */
+	while ((ret = ipc_service_send(&ep, tx_buf, len)) == -ENOMEM) {
+		k_yield();
+	}
+
+	return ret < 0 ? ret : 0;
+}
+
+static int reply_wait(uint32_t seq, size_t len)
+{
+	if (k_sem_take(&reply_sem, REPLY_TIMEOUT) != 0) {
+		return -ETIMEDOUT;
+	}
+
+	if (reply_len != len || reply_hdr.seq != seq) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+/* Times round trips of messages of len bytes, answered with rsp_len bytes */
+static int bench_rtt(struct bench_latency *lat, uint32_t type, size_t len, size_t rsp_len)
+{
+	timing_t start;
+	int ret;
+
+	*lat = (struct bench_latency){.min = UINT64_MAX};
+
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+
+		ret = msg_send(type, i, len);
+		if (ret == 0) {
+			ret = reply_wait(i, rsp_len);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		uint64_t ns = timing_cycles_to_ns(timing_cycles_get(&start, &reply_time));
+
+		lat->sum += ns;
+		lat->min = MIN(lat->min, ns);
+		lat->max = MAX(lat->max, ns);
+		lat->count++;
+	}
+
+	return 0;
+}
+
+/* Streams messages of len bytes, returning the time taken in ns */
+static int bench_stream(size_t len, uint64_t *ns)
+{
+	timing_t start;
+	int ret;
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+		ret = msg_send(BENCH_MSG_STREAM, i, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	/* Answered once the remote got all of them */
+	ret = msg_send(BENCH_MSG_STREAM_END, 0, sizeof(struct bench_msg_hdr));
+	if (ret == 0) {
+		ret = reply_wait(NUM_ITERATIONS, sizeof(struct bench_msg_hdr));
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &reply_time));
+
+	return 0;
+}
+
+static void bench_size(size_t len, const struct bench_latency *base)
+{
+	struct bench_latency rtt;
+	struct bench_latency rtt_short;
+	uint64_t ns = 0;
+
+	snprintk(description, sizeof(description), "Round trip, %zu bytes each way (%s)", len,
+		 BENCH_BACKEND_NAME);
+	if (bench_rtt(&rtt, BENCH_MSG_ECHO, len, len) == 0) {
+		PRINT_RESULT("ipc.rtt", description, rtt.sum / rtt.count, "ns avg", rtt.max,
+			     "ns max");
+	} else {
+		PRINT_FAILED("ipc.rtt", description);
+		error_count++;
+	}
+
+	/*
+	 * The cores share no clock to timestamp a message on both ends, so
+	 * the one-way latency of a message is estimated as the round trip of
+	 * that message answered with a header only, minus half the round trip
+	 * of a header only each way.
+	 */
+	snprintk(description, sizeof(description), "One way estimate, %zu bytes (%s)", len,
+		 BENCH_BACKEND_NAME);
+	if (bench_rtt(&rtt_short, BENCH_MSG_ECHO_SHORT, len, sizeof(struct bench_msg_hdr)) == 0) {
+		uint64_t avg = rtt_short.sum / rtt_short.count;
+		uint64_t base_avg = base->sum / base->count;
+
+		PRINT_RESULT("ipc.one_way", description, avg - MIN(avg, base_avg / 2U), "ns avg",
+			     rtt_short.min - MIN(rtt_short.min, base->min / 2U), "ns min");
+	} else {
+		PRINT_FAILED("ipc.one_way", description);
+		error_count++;
+	}
+
+	snprintk(description, sizeof(description), "Stream of %u messages, %zu bytes (%s)",
+		 NUM_ITERATIONS, len, BENCH_BACKEND_NAME);
+	if (bench_stream(len, &ns) == 0) {
+		ns = MAX(ns, 1U);
+		PRINT_RESULT("ipc.throughput", description,
+			     (uint64_t)NUM_ITERATIONS * NSEC_PER_SEC / ns, "msgs/s",
+			     (uint64_t)NUM_ITERATIONS * len * NSEC_PER_SEC / 1024U / ns, "KiB/s");
+	} else {
+		PRINT_FAILED("ipc.throughput", description);
+		error_count++;
+	}
+}
+
+int main(void)
+{
+	const struct device *ipc0_instance = DEVICE_DT_GET(BENCH_NODE);
+	struct bench_latency base;
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	TC_START("IPC service benchmark");
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	memset(tx_buf, 0xa5, sizeof(tx_buf));
+
+	ret = ipc_service_open_instance(ipc0_instance);
+	if (ret < 0 && ret != -EALREADY) {
+		TC_ERROR("Failed to open the IPC instance: %d\n", ret);
+		error_count++;
+		goto end;
+	}
+
+	ret = ipc_service_register_endpoint(ipc0_instance, &ep, &ep_cfg);
+	if (ret < 0) {
+		TC_ERROR("Failed to register the endpoint: %d\n", ret);
+		error_count++;
+		goto end;
+	}
+
+	if (k_sem_take(&bound_sem, K_SECONDS(5)) != 0) {
+		TC_ERROR("Endpoint not bound, is the remote core running?\n");
+		error_count++;
+		goto end;
+	}
+
+	snprintk(description, sizeof(description), "Round trip, header only each way (%s)",
+		 BENCH_BACKEND_NAME);
+	ret = bench_rtt(&base, BENCH_MSG_ECHO_SHORT, sizeof(struct bench_msg_hdr),
+			sizeof(struct bench_msg_hdr));
+	if (ret < 0) {
+		PRINT_FAILED("ipc.rtt", description);
+		error_count++;
+		goto end;
+	}
+
+	PRINT_RESULT("ipc.rtt", description, base.sum / base.count, "ns avg", base.max, "ns max");
+
+	for (size_t i = 0; i < ARRAY_SIZE(msg_sizes); i++) {
+		bench_size(msg_sizes[i], &base);
+	}
+
+end:
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* C library string benchmark. Measures the average cost of the memory
+ * functions on 1 KiB buffers. The calls go through volatile function
+ * pointers so the compiler cannot replace them with inline code.
+ */
+
+#define SIZE 1024
+#define ROUNDS 64
+
+static uint8_t src[SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+static uint8_t dst[SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+static volatile int sink;
+
+static void *(*volatile memcpy_fn)(void *, const void *, size_t) = memcpy;
+static void *(*volatile memset_fn)(void *, int, size_t) = memset;
+static int (*volatile memcmp_fn)(const void *, const void *, size_t) = memcmp;
+
+static uint32_t bench_memcpy(size_t offset)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memcpy_fn(dst, src + offset, SIZE);
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static uint32_t bench_memset(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		memset_fn(dst, r, SIZE);
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static uint32_t bench_memcmp(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		sink = memcmp_fn(dst, src, SIZE);
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	printk("memcpy aligned %u cycles\n", bench_memcpy(0));
+	printk("memcpy unaligned %u cycles\n", bench_memcpy(1));
+	printk("memset %u cycles\n", bench_memset());
+
+	/* Equal buffers, so the whole length is compared */
+	memcpy(dst, src, SIZE);
+	printk("memcmp %u cycles\n", bench_memcmp());
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+/* Log packaging benchmark.  Measures the average cost of a LOG_INF()
+ * call, the messages are processed by a backend which drops them
+ * between two measured batches so that the buffer never fills up.
+ */
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define BATCH 16
+#define ROUNDS 64
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static char name[] = "benchmark";
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+static uint32_t bench_ints(void)
+{
+	uint32_t cycles = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		uint32_t start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH; i++) {
+			LOG_INF("value %d of %d, flags %x", i, r, i ^ r);
+		}
+
+		cycles += k_cycle_get_32() - start;
+		flush();
+	}
+
+	return cycles / (ROUNDS * BATCH);
+}
+
+static uint32_t bench_string(void)
+{
+	uint32_t cycles = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		uint32_t start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH; i++) {
+			LOG_INF("%s: round %d", name, r);
+		}
+
+		cycles += k_cycle_get_32() - start;
+		flush();
+	}
+
+	return cycles / (ROUNDS * BATCH);
+}
+
+int main(void)
+{
+	uint32_t ints;
+	uint32_t string;
+
+	flush();
+
+	ints = bench_ints();
+	string = bench_string();
+
+	printk("LOG_INF ints %u cycles\n", ints);
+	printk("LOG_INF string %u cycles\n", string);
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/lwm2m.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+
+/* LwM2M registry benchmark. Measures the average cost of reading and
+ * writing one resource by path, over all resources of a test object.
+ */
+
+#define BENCH_OBJ_ID   32769
+#define INSTANCE_COUNT 100
+#define RESOURCE_COUNT 10
+#define ROUNDS         8
+
+static struct lwm2m_engine_obj bench_obj;
+static struct lwm2m_engine_obj_field fields[RESOURCE_COUNT];
+
+static struct lwm2m_engine_obj_inst inst[INSTANCE_COUNT];
+static struct lwm2m_engine_res res[INSTANCE_COUNT][RESOURCE_COUNT];
+static struct lwm2m_engine_res_inst res_inst[INSTANCE_COUNT][RESOURCE_COUNT];
+static uint32_t values[INSTANCE_COUNT][RESOURCE_COUNT];
+
+static volatile uint32_t sink;
+
+static struct lwm2m_engine_obj_inst *obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= INSTANCE_COUNT) {
+		return NULL;
+	}
+
+	init_res_instance(res_inst[obj_inst_id], RESOURCE_COUNT);
+
+	for (int r = 0; r < RESOURCE_COUNT; r++) {
+		INIT_OBJ_RES_DATA(r, res[obj_inst_id], i, res_inst[obj_inst_id], j,
+				  &values[obj_inst_id][r], sizeof(uint32_t));
+	}
+
+	inst[obj_inst_id].resources = res[obj_inst_id];
+	inst[obj_inst_id].resource_count = i;
+
+	return &inst[obj_inst_id];
+}
+
+static int bench_init(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	int ret;
+
+	for (int r = 0; r < RESOURCE_COUNT; r++) {
+		fields[r] = (struct lwm2m_engine_obj_field)OBJ_FIELD(r, RW, U32);
+	}
+
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.fields = fields;
+	bench_obj.field_count = RESOURCE_COUNT;
+	bench_obj.max_instance_count = INSTANCE_COUNT;
+	bench_obj.create_cb = obj_create;
+	lwm2m_register_obj(&bench_obj);
+
+	for (int n = 0; n < INSTANCE_COUNT; n++) {
+		ret = lwm2m_create_obj_inst(BENCH_OBJ_ID, n, &obj_inst);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static uint32_t bench_get(void)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t value;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int n = 0; n < INSTANCE_COUNT; n++) {
+			for (int id = 0; id < RESOURCE_COUNT; id++) {
+				(void)lwm2m_get_u32(&LWM2M_OBJ(BENCH_OBJ_ID, n, id), &value);
+				sink = value;
+			}
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (ROUNDS * INSTANCE_COUNT * RESOURCE_COUNT);
+}
+
+static uint32_t bench_set(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int n = 0; n < INSTANCE_COUNT; n++) {
+			for (int id = 0; id < RESOURCE_COUNT; id++) {
+				(void)lwm2m_set_u32(&LWM2M_OBJ(BENCH_OBJ_ID, n, id), r);
+			}
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (ROUNDS * INSTANCE_COUNT * RESOURCE_COUNT);
+}
+
+int main(void)
+{
+	if (bench_init() < 0) {
+		printk("failed to create the test object instances\n");
+		return 0;
+	}
+
+	printk("lwm2m_get_u32 %u cycles/op\n", bench_get());
+	printk("lwm2m_set_u32 %u cycles/op\n", bench_set());
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Fake Ethernet driver reflecting the UDP datagrams sent to the peer back
+ * to the interface, so that the whole L2 path is run in both directions
+ * without any hardware.
+ */
+
+#include <string.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt.h>
+#include <ipv6.h>
+#include "utils.h"
+
+struct eth_fake_context {
+	struct net_if *iface;
+	uint8_t mac_address[6];
+	uint8_t frame[_NET_ETH_MAX_FRAME_SIZE];
+};
+
+static struct eth_fake_context eth_fake_data = {
+	.mac_address = { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static uint8_t peer_mac_address[] = { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x02 };
+
+static struct net_linkaddr peer_link_addr = {
+	.addr = peer_mac_address,
+	.len = sizeof(peer_mac_address),
+};
+
+struct net_if *bench_eth_iface;
+
+struct in6_addr bench_my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+				      0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+struct in6_addr bench_peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static void eth_fake_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_fake_context *ctx = dev->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_address,
+			     sizeof(ctx->mac_address),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static void swap(uint8_t *a, uint8_t *b, size_t len)
+{
+	uint8_t tmp;
+
+	for (size_t i = 0; i < len; i++) {
+		tmp = a[i];
+		a[i] = b[i];
+		b[i] = tmp;
+	}
+}
+
+static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_fake_context *ctx = dev->data;
+	struct net_eth_hdr *eth = (struct net_eth_hdr *)ctx->frame;
+	struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)(eth + 1);
+	struct net_udp_hdr *udp = (struct net_udp_hdr *)(ip + 1);
+	size_t len = net_pkt_get_len(pkt);
+	struct net_pkt *rx;
+
+	bench_stamp(STAMP_DRV_TX);
+
+	if (len > sizeof(ctx->frame) ||
+	    len < sizeof(*eth) + sizeof(*ip) + sizeof(*udp)) {
+		return 0;
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_read(pkt, ctx->frame, len)) {
+		return -EIO;
+	}
+
+	/* Only the datagrams are reflected, the rest of the traffic is
+	 * swallowed as if the peer did not answer.
+	 */
+	if (eth->type != htons(NET_ETH_PTYPE_IPV6) ||
+	    ip->nexthdr != IPPROTO_UDP) {
+		return 0;
+	}
+
+	/* Swapping the addresses and ports leaves the checksum valid */
+	swap(eth->src.addr, eth->dst.addr, sizeof(eth->src.addr));
+	swap(ip->src, ip->dst, sizeof(ip->src));
+	swap((uint8_t *)&udp->src_port, (uint8_t *)&udp->dst_port,
+	     sizeof(udp->src_port));
+
+	rx = net_pkt_rx_alloc_with_buffer(ctx->iface, len, AF_UNSPEC, 0,
+					  K_NO_WAIT);
+	if (rx == NULL) {
+		return -ENOMEM;
+	}
+
+	if (net_pkt_write(rx, ctx->frame, len)) {
+		net_pkt_unref(rx);
+		return -ENOBUFS;
+	}
+
+	bench_stamp(STAMP_DRV_RX);
+
+	if (net_recv_data(ctx->iface, rx) < 0) {
+		net_pkt_unref(rx);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static struct ethernet_api eth_fake_api_funcs = {
+	.iface_api.init = eth_fake_iface_init,
+	.send = eth_fake_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_fake, "eth_fake", NULL, NULL, &eth_fake_data, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_fake_api_funcs, NET_ETH_MTU);
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	struct net_if **my_iface = user_data;
+
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    PART_OF_ARRAY(NET_IF_GET_NAME(eth_fake, 0), iface)) {
+		*my_iface = iface;
+	}
+}
+
+void bench_eth_setup(void)
+{
+	net_if_foreach(iface_cb, &bench_eth_iface);
+	if (bench_eth_iface == NULL) {
+		printk("No fake Ethernet interface found\n");
+		error_count++;
+		return;
+	}
+
+	if (net_if_ipv6_addr_add(bench_eth_iface, &bench_my_addr,
+				 NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot add IPv6 address\n");
+		error_count++;
+		return;
+	}
+
+	net_if_up(bench_eth_iface);
+
+	/* In order to avoid neighbor discovery, populate neighbor cache */
+	net_ipv6_nbr_add(bench_eth_iface, &bench_peer_addr, &peer_link_addr,
+			 true, NET_IPV6_NBR_STATE_REACHABLE);
+}
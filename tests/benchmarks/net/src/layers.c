@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Time a packet through the layers of the stack. The packet filter hooks
+ * timestamp it between the layers, so one packet at a time is timed and
+ * only the first packet seen at each point after arming counts.
+ */
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/net_pkt_filter.h>
+#include "utils.h"
+
+struct bench_stamp_test {
+	struct npf_test test;
+	enum bench_stamp stamp;
+};
+
+static const char *const stamp_names[STAMP_COUNT] = {
+	[STAMP_SEND] = "send()",
+	[STAMP_L2_TX] = "L2 output",
+	[STAMP_DRV_TX] = "driver TX",
+	[STAMP_DRV_RX] = "driver RX",
+	[STAMP_IPV6_RX] = "IPv6 input",
+	[STAMP_L4_RX] = "UDP/TCP input",
+	[STAMP_RECV] = "recv() return",
+};
+
+static const char *const stamp_metrics[STAMP_COUNT] = {
+	[STAMP_L2_TX] = "l4_ipv6_tx",
+	[STAMP_DRV_TX] = "l2_tx",
+	[STAMP_DRV_RX] = "drv",
+	[STAMP_IPV6_RX] = "l2_rx",
+	[STAMP_L4_RX] = "ipv6_rx",
+	[STAMP_RECV] = "l4_socket_rx",
+};
+
+static timing_t stamps[STAMP_COUNT];
+static atomic_t stamps_taken;
+static atomic_t stamps_armed;
+
+static bool stamp_test(struct npf_test *test, struct net_pkt *pkt)
+{
+	struct bench_stamp_test *t = CONTAINER_OF(test, struct bench_stamp_test, test);
+
+	ARG_UNUSED(pkt);
+
+	bench_stamp(t->stamp);
+
+	/* Matching lets every packet through */
+	return true;
+}
+
+#define STAMP_TEST(_name, _stamp)                                            \
+	static struct bench_stamp_test _name = {                             \
+		.test.fn = stamp_test,                                       \
+		.stamp = (_stamp),                                           \
+	}
+
+STAMP_TEST(l2_tx_test, STAMP_L2_TX);
+STAMP_TEST(drv_rx_test, STAMP_DRV_RX);
+STAMP_TEST(ipv6_rx_test, STAMP_IPV6_RX);
+STAMP_TEST(l4_rx_test, STAMP_L4_RX);
+
+static NPF_RULE(l2_tx_rule, NET_OK, l2_tx_test);
+static NPF_RULE(drv_rx_rule, NET_OK, drv_rx_test);
+static NPF_RULE(ipv6_rx_rule, NET_OK, ipv6_rx_test);
+static NPF_RULE(l4_rx_rule, NET_OK, l4_rx_test);
+
+void bench_stamps_init(void)
+{
+	npf_append_send_rule(&l2_tx_rule);
+	npf_append_recv_rule(&drv_rx_rule);
+	npf_append_ipv6_recv_rule(&ipv6_rx_rule);
+	npf_append_local_in_recv_rule(&l4_rx_rule);
+}
+
+void bench_stamps_arm(void)
+{
+	atomic_clear(&stamps_taken);
+	atomic_set(&stamps_armed, 1);
+}
+
+void bench_stamp(enum bench_stamp stamp)
+{
+	timing_t now;
+
+	if (!atomic_get(&stamps_armed)) {
+		return;
+	}
+
+	now = timing_counter_get();
+
+	if (!atomic_test_and_set_bit(&stamps_taken, stamp)) {
+		stamps[stamp] = now;
+	}
+}
+
+bool bench_stamps_get(timing_t out[STAMP_COUNT])
+{
+	atomic_set(&stamps_armed, 0);
+
+	for (int i = 0; i < STAMP_COUNT; i++) {
+		out[i] = stamps[i];
+	}
+
+	return atomic_test_bit(&stamps_taken, STAMP_SEND) &&
+	       atomic_test_bit(&stamps_taken, STAMP_RECV);
+}
+
+void bench_layers(const char *proto, int tx_sock, int rx_sock,
+		  uint8_t *buf, size_t size)
+{
+	uint64_t sums[STAMP_COUNT] = { 0 };
+	timing_t sample[STAMP_COUNT];
+	char metric[32];
+	char description[80];
+	atomic_val_t taken = 0;
+	uint32_t done = 0;
+	ssize_t len;
+	int from;
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		bench_stamps_arm();
+		bench_stamp(STAMP_SEND);
+
+		if (zsock_send(tx_sock, buf, size, 0) != (ssize_t)size) {
+			break;
+		}
+
+		for (size_t got = 0; got < size; got += len) {
+			len = zsock_recv(rx_sock, buf + got, size - got, 0);
+			if (len <= 0) {
+				break;
+			}
+
+			/* A TCP segment may be read in several chunks */
+			bench_stamp(STAMP_RECV);
+		}
+
+		if (!bench_stamps_get(sample)) {
+			continue;
+		}
+
+		/* Only average the packets going through the same points */
+		if (done == 0U) {
+			taken = atomic_get(&stamps_taken);
+		} else if (atomic_get(&stamps_taken) != taken) {
+			continue;
+		}
+
+		/* Time from each point reached to the next one */
+		from = STAMP_SEND;
+		for (int to = STAMP_SEND + 1; to < STAMP_COUNT; to++) {
+			if (taken & BIT(to)) {
+				sums[to] += timing_cycles_get(&sample[from], &sample[to]);
+				from = to;
+			}
+		}
+
+		done++;
+	}
+
+	if (done == 0U) {
+		snprintk(metric, sizeof(metric), "layer.%s", proto);
+		snprintk(description, sizeof(description),
+			 "%s packet through the stack (%zu bytes)", proto, size);
+		PRINT_FAILED(metric, description);
+		error_count++;
+		return;
+	}
+
+	from = STAMP_SEND;
+	for (int to = STAMP_SEND + 1; to < STAMP_COUNT; to++) {
+		if (!(taken & BIT(to))) {
+			continue;
+		}
+
+		snprintk(metric, sizeof(metric), "layer.%s.%s", proto, stamp_metrics[to]);
+		snprintk(description, sizeof(description), "%s %s to %s (%zu bytes)",
+			 proto, stamp_names[from], stamp_names[to], size);
+		PRINT_CYCLES(metric, description, sums[to] / done);
+		from = to;
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main module that invokes all the benchmarks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include "utils.h"
+
+int error_count; /* track number of errors */
+
+static uint8_t bench_buf[1500];
+
+int main(void)
+{
+	static const size_t sizes[] = BENCH_SIZES;
+	uint32_t freq;
+
+	timing_init();
+	timing_start();
+
+	bench_eth_setup();
+	bench_stamps_init();
+
+	freq = timing_freq_get_mhz();
+
+	TC_START("Network stack benchmark");
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", freq);
+
+	for (size_t i = 0; i < sizeof(bench_buf); i++) {
+		bench_buf[i] = (uint8_t)i;
+	}
+
+	if (bench_eth_iface != NULL) {
+		for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+			bench_udp(bench_buf, sizes[i]);
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		bench_tcp(bench_buf, sizes[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		bench_pkt_parse(bench_buf, sizes[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Parsing of an IPv6/UDP packet held in net_pkt fragments, the way the
+ * input path does it: headers accessed in place, the payload read out.
+ */
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include "utils.h"
+
+static struct net_pkt *pkt_build(const uint8_t *buf, size_t size)
+{
+	struct net_ipv6_hdr ipv6 = {
+		.vtc = 0x60,
+		.nexthdr = IPPROTO_UDP,
+		.hop_limit = 64,
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(BENCH_PORT),
+		.dst_port = htons(BENCH_PORT),
+	};
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, sizeof(ipv6) + sizeof(udp) + size,
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	ipv6.len = htons(sizeof(udp) + size);
+	udp.len = ipv6.len;
+
+	if (net_pkt_write(pkt, &ipv6, sizeof(ipv6)) < 0 ||
+	    net_pkt_write(pkt, &udp, sizeof(udp)) < 0 ||
+	    net_pkt_write(pkt, buf, size) < 0) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+
+static int pkt_parse(struct net_pkt *pkt, uint8_t *buf)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(udp_access, struct net_udp_hdr);
+	struct net_ipv6_hdr *ipv6;
+	struct net_udp_hdr *udp;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ipv6 = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+	if (ipv6 == NULL || net_pkt_acknowledge_data(pkt, &ipv6_access) < 0) {
+		return -ENOBUFS;
+	}
+
+	udp = (struct net_udp_hdr *)net_pkt_get_data(pkt, &udp_access);
+	if (udp == NULL || net_pkt_acknowledge_data(pkt, &udp_access) < 0) {
+		return -ENOBUFS;
+	}
+
+	return net_pkt_read(pkt, buf, ntohs(udp->len) - sizeof(*udp));
+}
+
+void bench_pkt_parse(uint8_t *buf, size_t size)
+{
+	char description[80];
+	timing_t start, end;
+	uint64_t cycles;
+	struct net_pkt *pkt;
+	int ret = 0;
+
+	snprintk(description, sizeof(description),
+		 "Parse of an IPv6/UDP packet in net_pkt (%zu bytes)", size);
+
+	pkt = pkt_build(buf, size);
+	if (pkt == NULL) {
+		PRINT_FAILED("pkt.parse", description);
+		error_count++;
+		return;
+	}
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS && ret == 0; i++) {
+		ret = pkt_parse(pkt, buf);
+	}
+
+	end = timing_counter_get();
+	cycles = timing_cycles_get(&start, &end);
+
+	net_pkt_unref(pkt);
+
+	if (ret < 0) {
+		PRINT_FAILED("pkt.parse", description);
+		error_count++;
+		return;
+	}
+
+	PRINT_CYCLES("pkt.parse", description, cycles / CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * TCP connection over the loopback interface, with a receiver thread
+ * draining the server side.
+ */
+
+#include <zephyr/net/socket.h>
+#include "utils.h"
+
+#define RECEIVER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(receiver_stack, RECEIVER_STACK_SIZE);
+static struct k_thread receiver_thread;
+
+/* Each size gets its own port, so that the previous connection closing
+ * does not get in the way.
+ */
+static uint16_t tcp_port = BENCH_PORT;
+
+static uint8_t receiver_buf[1500];
+static uint32_t receiver_bytes;
+
+static void receiver(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	ssize_t len;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	receiver_bytes = 0;
+
+	while (receiver_bytes < CONFIG_BENCHMARK_TCP_BYTES) {
+		len = zsock_recv(sock, receiver_buf, sizeof(receiver_buf), 0);
+		if (len <= 0) {
+			break;
+		}
+
+		receiver_bytes += len;
+	}
+}
+
+static int tcp_connect(int *client, int *server)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+		.sin6_port = htons(++tcp_port),
+	};
+	int optval = 1;
+	int listener;
+	int ret = 0;
+
+	listener = zsock_socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	*client = zsock_socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+	*server = -1;
+
+	if (listener < 0 || *client < 0 ||
+	    zsock_bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_listen(listener, 1) < 0 ||
+	    zsock_setsockopt(*client, IPPROTO_TCP, TCP_NODELAY, &optval,
+			     sizeof(optval)) < 0 ||
+	    zsock_connect(*client, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		ret = -errno;
+	} else {
+		*server = zsock_accept(listener, NULL, NULL);
+		if (*server < 0) {
+			ret = -errno;
+		}
+	}
+
+	if (listener >= 0) {
+		(void)zsock_close(listener);
+	}
+
+	if (ret < 0 && *client >= 0) {
+		(void)zsock_close(*client);
+	}
+
+	return ret;
+}
+
+void bench_tcp(uint8_t *buf, size_t size)
+{
+	char description[80];
+	timing_t start, end;
+	uint32_t sent = 0;
+	int client, server;
+	uint64_t ns;
+	ssize_t len;
+	int ret;
+
+	ret = tcp_connect(&client, &server);
+	if (ret < 0) {
+		printk("Cannot connect over TCP (%d)\n", ret);
+		error_count++;
+		return;
+	}
+
+	snprintk(description, sizeof(description),
+		 "TCP stream through loopback (%zu bytes writes)", size);
+
+	k_thread_create(&receiver_thread, receiver_stack,
+			K_THREAD_STACK_SIZEOF(receiver_stack), receiver,
+			INT_TO_POINTER(server), NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	start = timing_counter_get();
+
+	while (sent < CONFIG_BENCHMARK_TCP_BYTES) {
+		len = zsock_send(client, buf,
+				 MIN(size, CONFIG_BENCHMARK_TCP_BYTES - sent), 0);
+		if (len <= 0) {
+			break;
+		}
+
+		sent += len;
+	}
+
+	if (sent != CONFIG_BENCHMARK_TCP_BYTES) {
+		/* Closing the connection unblocks the receiver */
+		(void)zsock_close(client);
+		k_thread_join(&receiver_thread, K_FOREVER);
+		(void)zsock_close(server);
+
+		PRINT_FAILED("tcp.throughput", description);
+		error_count++;
+		return;
+	}
+
+	/* The receiver is done once it got all the bytes */
+	k_thread_join(&receiver_thread, K_FOREVER);
+
+	end = timing_counter_get();
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	if (receiver_bytes != CONFIG_BENCHMARK_TCP_BYTES || ns == 0U) {
+		PRINT_FAILED("tcp.throughput", description);
+		error_count++;
+	} else {
+		PRINT_RESULT("tcp.throughput", description,
+			     (uint64_t)receiver_bytes * 8U * USEC_PER_SEC / ns, "kbps",
+			     ns / NSEC_PER_USEC, "us");
+		bench_layers("tcp", client, server, buf, size);
+	}
+
+	(void)zsock_close(client);
+	(void)zsock_close(server);
+}
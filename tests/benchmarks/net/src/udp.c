@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * UDP datagrams sent to the peer on the fake Ethernet interface, which
+ * reflects them back to the same socket.
+ */
+
+#include <zephyr/net/socket.h>
+#include "utils.h"
+
+#define RECV_TIMEOUT_MS 100
+
+static int udp_socket_get(void)
+{
+	struct timeval tv = { .tv_usec = RECV_TIMEOUT_MS * USEC_PER_MSEC };
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(BENCH_PORT),
+	};
+	int sock, err;
+
+	sock = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	net_ipv6_addr_copy_raw((uint8_t *)&addr.sin6_addr, (uint8_t *)&bench_my_addr);
+	if (zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		goto fail;
+	}
+
+	/* The reflected datagrams come from the peer, on the same port */
+	net_ipv6_addr_copy_raw((uint8_t *)&addr.sin6_addr, (uint8_t *)&bench_peer_addr);
+	if (zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		goto fail;
+	}
+
+	if (zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
+		goto fail;
+	}
+
+	return sock;
+
+fail:
+	err = -errno;
+	(void)zsock_close(sock);
+
+	return err;
+}
+
+void bench_udp(uint8_t *buf, size_t size)
+{
+	char description[80];
+	timing_t start, end;
+	uint32_t received = 0;
+	uint32_t lost = 0;
+	uint64_t ns;
+	int sock;
+
+	sock = udp_socket_get();
+	if (sock < 0) {
+		printk("Cannot create UDP socket (%d)\n", sock);
+		error_count++;
+		return;
+	}
+
+	snprintk(description, sizeof(description),
+		 "UDP datagrams through fake Ethernet (%zu bytes)", size);
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS;
+	     i += CONFIG_BENCHMARK_UDP_BURST) {
+		uint32_t burst = MIN(CONFIG_BENCHMARK_UDP_BURST,
+				     CONFIG_BENCHMARK_NUM_ITERATIONS - i);
+		uint32_t sent = 0;
+
+		for (; sent < burst; sent++) {
+			if (zsock_send(sock, buf, size, 0) != (ssize_t)size) {
+				break;
+			}
+		}
+
+		for (uint32_t j = 0; j < sent; j++) {
+			if (zsock_recv(sock, buf, size, 0) != (ssize_t)size) {
+				lost += sent - j;
+				break;
+			}
+
+			received++;
+		}
+
+		lost += burst - sent;
+	}
+
+	end = timing_counter_get();
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	if (received == 0U || ns == 0U) {
+		PRINT_FAILED("udp.pps", description);
+		error_count++;
+	} else {
+		PRINT_RESULT("udp.pps", description,
+			     (uint64_t)received * NSEC_PER_SEC / ns, "pps",
+			     (uint64_t)received * size * 8U * USEC_PER_SEC / ns, "kbps");
+	}
+
+	if (lost != 0U) {
+		printk("%u of %u datagrams lost\n", lost, CONFIG_BENCHMARK_NUM_ITERATIONS);
+	}
+
+	bench_layers("udp", sock, sock, buf, size);
+
+	(void)zsock_close(sock);
+}
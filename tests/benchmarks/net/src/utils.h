@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef NET_BENCHMARK_UTILS_H
+#define NET_BENCHMARK_UTILS_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/printk.h>
+
+/* UDP payload sizes, up to what fits a 1500 bytes Ethernet frame */
+#define BENCH_SIZES { 16, 64, 256, 1024, 1452 }
+
+#define BENCH_PORT 4242
+
+/*
+ * Each result line holds a metric, its description and two values with
+ * their units, e.g. cycles and nanoseconds, so that it can be parsed the
+ * same way whatever is measured.
+ */
+#define FORMAT_STR "%-24s - %-67s:%10u %-6s,%10u %s\n"
+
+#define PRINT_RESULT(metric, description, value1, unit1, value2, unit2)      \
+	printk(FORMAT_STR, metric, description, (uint32_t)(value1), unit1,   \
+	       (uint32_t)(value2), unit2)
+
+#define PRINT_CYCLES(metric, description, cycles)                            \
+	PRINT_RESULT(metric, description, cycles, "cycles",                  \
+		     timing_cycles_to_ns(cycles), "ns")
+
+#define PRINT_FAILED(metric, description)                                    \
+	printk("%-24s - %-67s:%10s\n", metric, description, "FAILED")
+
+/** Points in the stack a packet is timestamped at */
+enum bench_stamp {
+	/* send() called */
+	STAMP_SEND,
+	/* Packet passed to L2, after UDP/TCP and IPv6 output */
+	STAMP_L2_TX,
+	/* Packet handed to the driver */
+	STAMP_DRV_TX,
+	/* Packet received by the driver */
+	STAMP_DRV_RX,
+	/* IPv6 input, after the RX queue and L2 input */
+	STAMP_IPV6_RX,
+	/* UDP/TCP input, after IPv6 input */
+	STAMP_L4_RX,
+	/* recv() returned */
+	STAMP_RECV,
+	STAMP_COUNT,
+};
+
+extern struct net_if *bench_eth_iface;
+extern struct in6_addr bench_my_addr;
+extern struct in6_addr bench_peer_addr;
+
+extern int error_count;
+
+void bench_eth_setup(void);
+
+void bench_stamps_init(void);
+void bench_stamps_arm(void);
+void bench_stamp(enum bench_stamp stamp);
+bool bench_stamps_get(timing_t stamps[STAMP_COUNT]);
+
+void bench_layers(const char *proto, int tx_sock, int rx_sock,
+		  uint8_t *buf, size_t size);
+
+void bench_udp(uint8_t *buf, size_t size);
+void bench_tcp(uint8_t *buf, size_t size);
+void bench_pkt_parse(uint8_t *buf, size_t size);
+
+#endif /* NET_BENCHMARK_UTILS_H */
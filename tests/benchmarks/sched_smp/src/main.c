@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* SMP scheduler throughput benchmark.  For n = 1 .. number of CPUs,
+ * start n pairs of threads, each pair ping-ponging over two
+ * semaphores, and count round trips over a fixed window.  A pair
+ * never has more than one runnable thread, so n pairs keep at most n
+ * CPUs busy and the result shows how context switch throughput
+ * scales as CPUs are added.
+ */
+
+#define MAX_PAIRS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WINDOW_MS 1000
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	struct k_thread pinger;
+	struct k_thread ponger;
+	uint32_t round_trips;
+};
+
+static struct pair pairs[MAX_PAIRS];
+static K_THREAD_STACK_ARRAY_DEFINE(pinger_stacks, MAX_PAIRS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(ponger_stacks, MAX_PAIRS, STACK_SIZE);
+
+static volatile bool running;
+
+static void pinger_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (running) {
+		k_sem_give(&p->ping);
+		k_sem_take(&p->pong, K_FOREVER);
+		p->round_trips++;
+	}
+
+	/* Release the partner so it can observe !running */
+	k_sem_give(&p->ping);
+}
+
+static void ponger_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&p->ping, K_FOREVER);
+		if (!running) {
+			break;
+		}
+		k_sem_give(&p->pong);
+	}
+}
+
+static uint64_t run_pairs(unsigned int n)
+{
+	uint64_t total = 0U;
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	running = true;
+
+	for (unsigned int i = 0; i < n; i++) {
+		struct pair *p = &pairs[i];
+
+		k_sem_init(&p->ping, 0, 1);
+		k_sem_init(&p->pong, 0, 1);
+		p->round_trips = 0U;
+
+		k_thread_create(&p->ponger, ponger_stacks[i], STACK_SIZE,
+				ponger_fn, p, NULL, NULL, prio, 0, K_NO_WAIT);
+		k_thread_create(&p->pinger, pinger_stacks[i], STACK_SIZE,
+				pinger_fn, p, NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	k_msleep(WINDOW_MS);
+	running = false;
+
+	for (unsigned int i = 0; i < n; i++) {
+		k_thread_join(&pairs[i].pinger, K_FOREVER);
+		k_thread_join(&pairs[i].ponger, K_FOREVER);
+		total += pairs[i].round_trips;
+	}
+
+	/* Two context switches per round trip */
+	return (total * 2U * MSEC_PER_SEC) / WINDOW_MS;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	/* Let the secondary CPUs settle into their idle loops */
+	k_msleep(100);
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		uint64_t rate = run_pairs(n);
+
+		printk("cpus %u pairs %u switches/s %llu\n", num_cpus, n, rate);
+	}
+
+	printk("fin\n");
+	return 0;
+}
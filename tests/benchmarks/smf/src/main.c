@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/smf.h>
+
+/* State machine framework benchmark. Measures the average cost of a
+ * transition, including the run action requesting it and the exit and
+ * entry actions, in a hierarchy of two branches DEPTH states deep:
+ *
+ *   A0 - A1 - ... - A(DEPTH-1) - LA0, LA1
+ *   B0 - B1 - ... - B(DEPTH-1) - LB0
+ *
+ * Sibling transitions go back and forth between LA0 and LA1, cousin
+ * transitions between LA0 and LB0, exiting and entering every state of
+ * both branches.
+ */
+
+#define DEPTH  8
+#define ROUNDS 1000
+
+struct bench_ctx {
+	struct smf_ctx ctx;
+	const struct smf_state *next[2];
+	uint32_t transitions;
+};
+
+static struct bench_ctx bench;
+static volatile uint32_t sink;
+
+static void action(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	sink++;
+}
+
+static void leaf_run(void *obj)
+{
+	struct bench_ctx *b = obj;
+
+	smf_set_state(SMF_CTX(b), b->next[b->transitions++ & 1U]);
+}
+
+static const struct smf_state states_a[DEPTH];
+static const struct smf_state states_b[DEPTH];
+
+#define STATE_A(i, _) \
+	SMF_CREATE_STATE(action, NULL, action, (i) > 0 ? &states_a[(i) - 1] : NULL, NULL)
+#define STATE_B(i, _) \
+	SMF_CREATE_STATE(action, NULL, action, (i) > 0 ? &states_b[(i) - 1] : NULL, NULL)
+
+static const struct smf_state states_a[DEPTH] = {LISTIFY(DEPTH, STATE_A, (,))};
+static const struct smf_state states_b[DEPTH] = {LISTIFY(DEPTH, STATE_B, (,))};
+
+enum leaf {
+	LA0,
+	LA1,
+	LB0,
+};
+
+static const struct smf_state leaves[] = {
+	[LA0] = SMF_CREATE_STATE(action, leaf_run, action, &states_a[DEPTH - 1], NULL),
+	[LA1] = SMF_CREATE_STATE(action, leaf_run, action, &states_a[DEPTH - 1], NULL),
+	[LB0] = SMF_CREATE_STATE(action, leaf_run, action, &states_b[DEPTH - 1], NULL),
+};
+
+static uint32_t bench_transitions(enum leaf from, enum leaf to)
+{
+	uint32_t start;
+
+	bench.next[0] = &leaves[to];
+	bench.next[1] = &leaves[from];
+	bench.transitions = 0;
+	smf_set_initial(SMF_CTX(&bench), &leaves[from]);
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		(void)smf_run_state(SMF_CTX(&bench));
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+int main(void)
+{
+	printk("sibling %u cycles/transition\n", bench_transitions(LA0, LA1));
+	printk("cousin %u cycles/transition\n", bench_transitions(LA0, LB0));
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * File system throughput and latency, through the file system API, for
+ * whichever of littlefs, FAT and ext2 is enabled.
+ */
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/storage/flash_map.h>
+#include "utils.h"
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+#include <zephyr/fs/littlefs.h>
+
+#define FS_NAME "littlefs"
+#define MNT_POINT "/lfs"
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)FIXED_PARTITION_ID(storage_partition),
+	.mnt_point = MNT_POINT,
+};
+#elif defined(CONFIG_FAT_FILESYSTEM_ELM)
+#include <ff.h>
+
+#define FS_NAME "fat"
+#define MNT_POINT "/RAM:"
+
+static FATFS fat_fs;
+static struct fs_mount_t mnt = {
+	.type = FS_FATFS,
+	.fs_data = &fat_fs,
+	.mnt_point = MNT_POINT,
+};
+#elif defined(CONFIG_FILE_SYSTEM_EXT2)
+#define FS_NAME "ext2"
+#define MNT_POINT "/ext"
+
+static struct fs_mount_t mnt = {
+	.type = FS_EXT2,
+	.storage_dev = "RAM",
+	.mnt_point = MNT_POINT,
+};
+#endif
+
+#define FILE_SIZE CONFIG_BENCHMARK_STORAGE_FILE_SIZE
+#define DATA_PATH MNT_POINT "/data"
+#define DIR_PATH MNT_POINT "/dir"
+
+static const size_t block_sizes[] = { 256, 1024, 4096 };
+
+static uint8_t buf[4096];
+
+static int fs_bench_mount(void)
+{
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+	const struct flash_area *fa;
+	int rc;
+
+	/* Start from a blank partition, littlefs formats it on mount */
+	rc = flash_area_open((uintptr_t)mnt.storage_dev, &fa);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	flash_area_close(fa);
+	if (rc < 0) {
+		return rc;
+	}
+#elif defined(CONFIG_FILE_SYSTEM_EXT2)
+	int rc = fs_mkfs(FS_EXT2, (uintptr_t)mnt.storage_dev, NULL, 0);
+
+	if (rc < 0) {
+		return rc;
+	}
+#endif
+
+	return fs_mount(&mnt);
+}
+
+static int seq_write(size_t bs, uint64_t *ns)
+{
+	struct fs_file_t file;
+	timing_t start, end;
+	int rc;
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, DATA_PATH, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+	if (rc < 0) {
+		return rc;
+	}
+
+	start = timing_counter_get();
+
+	for (size_t off = 0; off < FILE_SIZE && rc >= 0; off += bs) {
+		rc = fs_write(&file, buf, MIN(bs, FILE_SIZE - off));
+	}
+
+	if (rc >= 0) {
+		rc = fs_sync(&file);
+	}
+
+	end = timing_counter_get();
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	(void)fs_close(&file);
+
+	return rc;
+}
+
+static int seq_read(size_t bs, uint64_t *ns)
+{
+	struct fs_file_t file;
+	timing_t start, end;
+	size_t total = 0;
+	int rc;
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, DATA_PATH, FS_O_READ);
+	if (rc < 0) {
+		return rc;
+	}
+
+	start = timing_counter_get();
+
+	while (total < FILE_SIZE) {
+		rc = fs_read(&file, buf, bs);
+		if (rc <= 0) {
+			break;
+		}
+
+		total += rc;
+	}
+
+	end = timing_counter_get();
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	(void)fs_close(&file);
+
+	return total == FILE_SIZE ? 0 : -EIO;
+}
+
+static int rand_rw(size_t bs, bool write, uint64_t *ns)
+{
+	uint32_t seed = 1;
+	struct fs_file_t file;
+	timing_t start, end;
+	off_t off;
+	int rc;
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, DATA_PATH, FS_O_RDWR);
+	if (rc < 0) {
+		return rc;
+	}
+
+	start = timing_counter_get();
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS && rc >= 0; i++) {
+		off = (bench_rand(&seed) % (FILE_SIZE / bs)) * bs;
+
+		rc = fs_seek(&file, off, FS_SEEK_SET);
+		if (rc < 0) {
+			break;
+		}
+
+		rc = write ? fs_write(&file, buf, bs) : fs_read(&file, buf, bs);
+		if (rc >= 0 && rc != (int)bs) {
+			rc = -EIO;
+		}
+	}
+
+	if (rc >= 0 && write) {
+		rc = fs_sync(&file);
+	}
+
+	end = timing_counter_get();
+	*ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	(void)fs_close(&file);
+
+	return rc;
+}
+
+static void bench_throughput(void)
+{
+	char description[64];
+	uint64_t ns;
+
+	for (size_t i = 0; i < ARRAY_SIZE(block_sizes); i++) {
+		size_t bs = block_sizes[i];
+
+		snprintk(description, sizeof(description),
+			 FS_NAME " sequential write (%zu bytes blocks)", bs);
+		if (seq_write(bs, &ns) < 0) {
+			PRINT_FAILED("fs.seq_write", description);
+			error_count++;
+			continue;
+		}
+		PRINT_THROUGHPUT("fs.seq_write", description, FILE_SIZE, ns);
+
+		snprintk(description, sizeof(description),
+			 FS_NAME " sequential read (%zu bytes blocks)", bs);
+		if (seq_read(bs, &ns) < 0) {
+			PRINT_FAILED("fs.seq_read", description);
+			error_count++;
+		} else {
+			PRINT_THROUGHPUT("fs.seq_read", description, FILE_SIZE, ns);
+		}
+
+		snprintk(description, sizeof(description),
+			 FS_NAME " random write (%zu bytes blocks)", bs);
+		if (rand_rw(bs, true, &ns) < 0) {
+			PRINT_FAILED("fs.rand_write", description);
+			error_count++;
+		} else {
+			PRINT_THROUGHPUT("fs.rand_write", description,
+					 CONFIG_BENCHMARK_NUM_ITERATIONS * bs, ns);
+		}
+
+		snprintk(description, sizeof(description),
+			 FS_NAME " random read (%zu bytes blocks)", bs);
+		if (rand_rw(bs, false, &ns) < 0) {
+			PRINT_FAILED("fs.rand_read", description);
+			error_count++;
+		} else {
+			PRINT_THROUGHPUT("fs.rand_read", description,
+					 CONFIG_BENCHMARK_NUM_ITERATIONS * bs, ns);
+		}
+	}
+
+	(void)fs_unlink(DATA_PATH);
+}
+
+static void bench_metadata(void)
+{
+	struct bench_latency create = { 0 }, open = { 0 }, stat = { 0 }, unlink = { 0 };
+	char path[sizeof(DIR_PATH) + 8];
+	struct fs_file_t file;
+	struct fs_dirent entry;
+	timing_t start, end;
+	int rc;
+
+	if (fs_mkdir(DIR_PATH) < 0) {
+		PRINT_FAILED("fs.create", FS_NAME " file create");
+		error_count++;
+		return;
+	}
+
+	fs_file_t_init(&file);
+
+	for (int i = 0; i < CONFIG_BENCHMARK_STORAGE_NUM_FILES; i++) {
+		snprintk(path, sizeof(path), DIR_PATH "/f%d", i);
+
+		start = timing_counter_get();
+		rc = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+		if (rc == 0) {
+			rc = fs_close(&file);
+		}
+		end = timing_counter_get();
+
+		if (rc < 0) {
+			continue;
+		}
+		bench_latency_add(&create, &start, &end);
+
+		start = timing_counter_get();
+		rc = fs_open(&file, path, FS_O_READ);
+		if (rc == 0) {
+			rc = fs_close(&file);
+		}
+		end = timing_counter_get();
+
+		if (rc == 0) {
+			bench_latency_add(&open, &start, &end);
+		}
+
+		start = timing_counter_get();
+		rc = fs_stat(path, &entry);
+		end = timing_counter_get();
+
+		if (rc == 0) {
+			bench_latency_add(&stat, &start, &end);
+		}
+	}
+
+	for (int i = 0; i < CONFIG_BENCHMARK_STORAGE_NUM_FILES; i++) {
+		snprintk(path, sizeof(path), DIR_PATH "/f%d", i);
+
+		start = timing_counter_get();
+		rc = fs_unlink(path);
+		end = timing_counter_get();
+
+		if (rc == 0) {
+			bench_latency_add(&unlink, &start, &end);
+		}
+	}
+
+	(void)fs_unlink(DIR_PATH);
+
+	if (create.count != CONFIG_BENCHMARK_STORAGE_NUM_FILES ||
+	    open.count != create.count || stat.count != create.count ||
+	    unlink.count != create.count) {
+		PRINT_FAILED("fs.create", FS_NAME " file create, open, stat and unlink");
+		error_count++;
+		return;
+	}
+
+	PRINT_LATENCY("fs.create", FS_NAME " file create and close", &create);
+	PRINT_LATENCY("fs.open", FS_NAME " file open and close", &open);
+	PRINT_LATENCY("fs.stat", FS_NAME " file stat", &stat);
+	PRINT_LATENCY("fs.unlink", FS_NAME " file unlink", &unlink);
+}
+
+void bench_fs(void)
+{
+	int rc;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)i;
+	}
+
+	rc = fs_bench_mount();
+	if (rc < 0) {
+		printk("Cannot mount %s (%d)\n", MNT_POINT, rc);
+		error_count++;
+		return;
+	}
+
+	bench_throughput();
+	bench_metadata();
+
+	(void)fs_unmount(&mnt);
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main module that invokes all the benchmarks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+#include "utils.h"
+
+int error_count; /* track number of errors */
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Storage benchmark");
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	if (IS_ENABLED(CONFIG_FILE_SYSTEM)) {
+		bench_fs();
+	}
+
+	if (IS_ENABLED(CONFIG_NVS)) {
+		bench_nvs();
+	}
+
+	/* Last, as it erases the storage partition NVS benchmarked on */
+	if (IS_ENABLED(CONFIG_SETTINGS)) {
+		bench_settings();
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * NVS write, read and mount latencies. The writes closing a sector, and
+ * so running the garbage collection, are timed apart.
+ */
+
+#include <string.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/storage/flash_map.h>
+#include "utils.h"
+
+#define NVS_PARTITION		storage_partition
+#define NVS_PARTITION_DEVICE	FIXED_PARTITION_DEVICE(NVS_PARTITION)
+#define NVS_PARTITION_OFFSET	FIXED_PARTITION_OFFSET(NVS_PARTITION)
+
+/* Number of ids written, the older entries of each become garbage */
+#define NVS_IDS 8
+#define NVS_DATA_SIZE 32
+
+/* The sector is in the high half of the ATE write address */
+#define ATE_SECTOR(fs) ((fs)->ate_wra >> 16)
+
+static struct nvs_fs fs;
+
+static int nvs_bench_mount(void)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	fs.flash_device = NVS_PARTITION_DEVICE;
+	if (!device_is_ready(fs.flash_device)) {
+		return -ENODEV;
+	}
+
+	fs.offset = NVS_PARTITION_OFFSET;
+	rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (rc < 0) {
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = CONFIG_BENCHMARK_STORAGE_NVS_SECTORS;
+
+	return nvs_mount(&fs);
+}
+
+void bench_nvs(void)
+{
+	struct bench_latency write = { 0 }, write_gc = { 0 }, read = { 0 }, mount = { 0 };
+	uint8_t data[NVS_DATA_SIZE];
+	timing_t start, end;
+	uint16_t sector;
+	ssize_t rc;
+
+	rc = nvs_bench_mount();
+	if (rc == 0) {
+		rc = nvs_clear(&fs);
+	}
+
+	if (rc == 0) {
+		rc = nvs_bench_mount();
+	}
+
+	if (rc < 0) {
+		printk("Cannot mount NVS (%d)\n", (int)rc);
+		error_count++;
+		return;
+	}
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		/* Change the data, writing the same data again is skipped */
+		memset(data, i, sizeof(data));
+		sector = ATE_SECTOR(&fs);
+
+		start = timing_counter_get();
+		rc = nvs_write(&fs, i % NVS_IDS, data, sizeof(data));
+		end = timing_counter_get();
+
+		if (rc != (ssize_t)sizeof(data)) {
+			break;
+		}
+
+		bench_latency_add(ATE_SECTOR(&fs) != sector ? &write_gc : &write,
+				  &start, &end);
+	}
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		rc = nvs_read(&fs, i % NVS_IDS, data, sizeof(data));
+		end = timing_counter_get();
+
+		if (rc != (ssize_t)sizeof(data)) {
+			break;
+		}
+
+		bench_latency_add(&read, &start, &end);
+	}
+
+	/* Mounting walks the allocation table to find where it ends */
+	start = timing_counter_get();
+	rc = nvs_bench_mount();
+	end = timing_counter_get();
+
+	if (rc == 0) {
+		bench_latency_add(&mount, &start, &end);
+	}
+
+	if (write.count + write_gc.count != CONFIG_BENCHMARK_NUM_ITERATIONS ||
+	    read.count != CONFIG_BENCHMARK_NUM_ITERATIONS || mount.count == 0U) {
+		PRINT_FAILED("nvs.write", "NVS write, read and mount");
+		error_count++;
+	} else {
+		PRINT_LATENCY("nvs.write", "NVS write (" STRINGIFY(NVS_DATA_SIZE) " bytes)",
+			      &write);
+		PRINT_LATENCY("nvs.write_gc", "NVS write closing a sector, with garbage collection",
+			      &write_gc);
+		PRINT_LATENCY("nvs.read", "NVS read (" STRINGIFY(NVS_DATA_SIZE) " bytes)", &read);
+		PRINT_LATENCY("nvs.mount", "NVS mount", &mount);
+	}
+
+	(void)nvs_clear(&fs);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Settings save and load times, for whichever settings backend is
+ * enabled.
+ */
+
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include "utils.h"
+
+#define SETTINGS_VALUE_SIZE 16
+
+static uint32_t keys_loaded;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint8_t value[SETTINGS_VALUE_SIZE];
+
+	ARG_UNUSED(name);
+
+	if (len != sizeof(value) || read_cb(cb_arg, value, len) != (ssize_t)len) {
+		return -EINVAL;
+	}
+
+	keys_loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+void bench_settings(void)
+{
+	struct bench_latency save = { 0 }, load = { 0 };
+	uint8_t value[SETTINGS_VALUE_SIZE];
+	char name[16];
+	timing_t start, end;
+	int rc;
+
+#if FIXED_PARTITION_EXISTS(storage_partition)
+	const struct flash_area *fa;
+
+	/* Start from a blank storage, whatever ran before */
+	rc = flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa);
+	if (rc == 0) {
+		rc = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+
+	if (rc < 0) {
+		printk("Cannot erase settings storage (%d)\n", rc);
+		error_count++;
+		return;
+	}
+#endif
+
+	rc = settings_subsys_init();
+	if (rc < 0) {
+		printk("Cannot initialize settings (%d)\n", rc);
+		error_count++;
+		return;
+	}
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_STORAGE_SETTINGS_KEYS; i++) {
+		snprintk(name, sizeof(name), "bench/k%u", i);
+		memset(value, i, sizeof(value));
+
+		start = timing_counter_get();
+		rc = settings_save_one(name, value, sizeof(value));
+		end = timing_counter_get();
+
+		if (rc < 0) {
+			break;
+		}
+
+		bench_latency_add(&save, &start, &end);
+	}
+
+	keys_loaded = 0;
+
+	start = timing_counter_get();
+	rc = settings_load();
+	end = timing_counter_get();
+
+	if (rc == 0) {
+		bench_latency_add(&load, &start, &end);
+	}
+
+	if (save.count != CONFIG_BENCHMARK_STORAGE_SETTINGS_KEYS || load.count == 0U ||
+	    keys_loaded != CONFIG_BENCHMARK_STORAGE_SETTINGS_KEYS) {
+		PRINT_FAILED("settings.save", "Settings save and load");
+		error_count++;
+		return;
+	}
+
+	PRINT_LATENCY("settings.save", "Settings save (" STRINGIFY(SETTINGS_VALUE_SIZE) " bytes)",
+		      &save);
+	PRINT_LATENCY("settings.load", "Settings load ("
+		      STRINGIFY(CONFIG_BENCHMARK_STORAGE_SETTINGS_KEYS) " keys)", &load);
+}
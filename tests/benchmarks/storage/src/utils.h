@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STORAGE_BENCHMARK_UTILS_H
+#define STORAGE_BENCHMARK_UTILS_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/printk.h>
+
+/*
+ * Each result line holds a metric, its description and two values with
+ * their units, so that it can be parsed the same way whatever is measured.
+ */
+#define FORMAT_STR "%-24s - %-60s:%10u %-6s,%10u %s\n"
+
+#define PRINT_RESULT(metric, description, value1, unit1, value2, unit2)      \
+	printk(FORMAT_STR, metric, description, (uint32_t)(value1), unit1,   \
+	       (uint32_t)(value2), unit2)
+
+#define PRINT_FAILED(metric, description)                                    \
+	printk("%-24s - %-60s:%10s\n", metric, description, "FAILED")
+
+/** Latency of a repeated operation */
+struct bench_latency {
+	uint64_t sum;
+	uint64_t max;
+	uint32_t count;
+};
+
+static inline void bench_latency_add(struct bench_latency *lat,
+				     timing_t *start, timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	lat->sum += ns;
+	lat->max = MAX(lat->max, ns);
+	lat->count++;
+}
+
+/* Prints the average and worst latencies, in microseconds */
+#define PRINT_LATENCY(metric, description, lat)                              \
+	PRINT_RESULT(metric, description,                                    \
+		     (lat)->count ? (lat)->sum / (lat)->count / NSEC_PER_USEC : 0, \
+		     "us avg", (lat)->max / NSEC_PER_USEC, "us max")
+
+/* Prints a throughput in KiB/s, and the time taken in microseconds */
+#define PRINT_THROUGHPUT(metric, description, bytes, ns)                     \
+	PRINT_RESULT(metric, description,                                    \
+		     (uint64_t)(bytes) * NSEC_PER_SEC / 1024U / MAX(ns, 1U), \
+		     "KiB/s", (ns) / NSEC_PER_USEC, "us")
+
+/* Pseudo random sequence, the same on every run */
+static inline uint32_t bench_rand(uint32_t *state)
+{
+	*state = *state * 1103515245U + 12345U;
+
+	return *state >> 8;
+}
+
+extern int error_count;
+
+void bench_fs(void);
+void bench_nvs(void);
+void bench_settings(void);
+
+#endif /* STORAGE_BENCHMARK_UTILS_H */
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <timeout_q.h>
+
+/* Timeout queue benchmark.  Keeps NUM_TIMEOUTS raw kernel timeouts
+ * pending at once and measures the average cost of adding, querying
+ * and aborting one, then lets them all expire and checks that none
+ * fired before its deadline.
+ */
+
+#define NUM_TIMEOUTS CONFIG_BENCHMARK_NUM_TIMEOUTS
+
+/* Far enough out that nothing expires while measuring */
+#define FAR_TICKS 100000
+#define FAR_SPAN 1000000
+
+/* Expiry window, in ticks, for the second part */
+#define EXPIRE_SPAN 200
+
+struct bench_timeout {
+	struct _timeout timeout;
+	int64_t deadline;
+};
+
+static struct bench_timeout timeouts[NUM_TIMEOUTS];
+static atomic_t expired;
+static atomic_t early;
+static uint32_t seed = 12345;
+
+static uint32_t next_rand(void)
+{
+	seed = seed * 1103515245U + 12345U;
+	return seed >> 8;
+}
+
+static void timeout_fn(struct _timeout *t)
+{
+	struct bench_timeout *bt = CONTAINER_OF(t, struct bench_timeout, timeout);
+
+	if (sys_clock_tick_get() < bt->deadline) {
+		atomic_inc(&early);
+	}
+	atomic_inc(&expired);
+}
+
+static void add_all(uint32_t base, uint32_t span)
+{
+	for (int i = 0; i < NUM_TIMEOUTS; i++) {
+		uint32_t ticks = base + (next_rand() % span);
+
+		timeouts[i].deadline = sys_clock_tick_get() + ticks;
+		z_add_timeout(&timeouts[i].timeout, timeout_fn, K_TICKS(ticks));
+	}
+}
+
+int main(void)
+{
+	uint32_t start, add_cycles, rem_cycles, abort_cycles;
+	volatile k_ticks_t sink = 0;
+
+	start = k_cycle_get_32();
+	add_all(FAR_TICKS, FAR_SPAN);
+	add_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_TIMEOUTS; i++) {
+		sink += z_timeout_remaining(&timeouts[i].timeout);
+	}
+	rem_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_TIMEOUTS; i++) {
+		(void)z_abort_timeout(&timeouts[i].timeout);
+	}
+	abort_cycles = k_cycle_get_32() - start;
+
+	printk("timeouts %u add %u remaining %u abort %u cycles\n", NUM_TIMEOUTS,
+	       add_cycles / NUM_TIMEOUTS, rem_cycles / NUM_TIMEOUTS,
+	       abort_cycles / NUM_TIMEOUTS);
+
+	add_all(1, EXPIRE_SPAN);
+	while (atomic_get(&expired) < NUM_TIMEOUTS) {
+		k_sleep(K_TICKS(EXPIRE_SPAN));
+	}
+
+	printk("expired %ld early %ld\n", (long)atomic_get(&expired),
+	       (long)atomic_get(&early));
+	printk("fin\n");
+
+	return 0;
+}
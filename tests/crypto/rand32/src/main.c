@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2016 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -108,6 +109,22 @@ ZTEST(rand32_common, test_rand32)
 		"random numbers returned same value with high probability");
 	}
 
+	printk("Generating cryptographically secure random numbers one by one\n");
+
+	equal_count = 0;
+	for (rnd_cnt = 0; rnd_cnt < N_VALUES; rnd_cnt++) {
+		err = sys_csrand_get(&gen, sizeof(gen));
+		zassert_true(err == 0, "sys_csrand_get returned an error");
+
+		if (gen == last_gen) {
+			equal_count++;
+		}
+		last_gen = gen;
+	}
+
+	zassert_false((equal_count > N_VALUES / 2),
+		      "random numbers returned same value with high probability");
+
 #else
 
 	printk("Cryptographically secure random number APIs not enabled\n");
@@ -885,6 +885,119 @@ ZTEST_USER(can_classic, test_send_receive_msgq)
 	can_remove_rx_filter(can_dev, filter_id);
 }
 
+#ifdef CONFIG_CAN_RX_RING
+static struct can_frame rx_ring_frames[8];
+static struct can_rx_ring rx_ring;
+static K_SEM_DEFINE(rx_ring_sem, 0, 1);
+static size_t rx_ring_received;
+static size_t rx_ring_batches;
+
+static void rx_ring_callback(const struct device *dev, struct can_frame *frames, size_t count,
+			     void *user_data)
+{
+	size_t expected = POINTER_TO_UINT(user_data);
+
+	zassert_equal(dev, can_dev, "CAN device does not match");
+	zassert_true(count > 0 && count <= ARRAY_SIZE(rx_ring_frames), "invalid batch size");
+
+	for (size_t i = 0; i < count; i++) {
+		assert_frame_equal(&frames[i], &test_std_frame_1, 0);
+	}
+
+	rx_ring_batches++;
+	rx_ring_received += count;
+
+	if (rx_ring_received == expected) {
+		k_sem_give(&rx_ring_sem);
+	}
+}
+#endif /* CONFIG_CAN_RX_RING */
+
+/**
+ * @brief Test send/receive with frames delivered in batches from a CAN RX ring.
+ */
+ZTEST(can_classic, test_send_receive_ring)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_CAN_RX_RING);
+
+#ifdef CONFIG_CAN_RX_RING
+	const size_t nframes = 5;
+	int filter_id;
+	int err;
+
+	rx_ring_received = 0;
+	rx_ring_batches = 0;
+	can_rx_ring_init(&rx_ring, rx_ring_frames, ARRAY_SIZE(rx_ring_frames),
+			 rx_ring_callback, UINT_TO_POINTER(nframes));
+
+	filter_id = can_add_rx_filter_ring(can_dev, &rx_ring, &test_std_filter_1);
+	zassert_not_equal(filter_id, -ENOSPC, "no filters available");
+	zassert_true(filter_id >= 0, "negative filter number");
+
+	for (size_t i = 0; i < nframes; i++) {
+		send_test_frame(can_dev, &test_std_frame_1);
+	}
+
+	err = k_sem_take(&rx_ring_sem, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(err, 0, "receive timeout");
+	zassert_equal(rx_ring_received, nframes, "wrong number of frames received");
+	zassert_true(rx_ring_batches <= nframes, "more batches than frames");
+	zassert_equal(can_rx_ring_get_dropped(&rx_ring), 0, "frames dropped");
+
+	can_remove_rx_filter(can_dev, filter_id);
+#endif /* CONFIG_CAN_RX_RING */
+}
+
+#ifdef CONFIG_CAN_RX_FILTER_SET
+static void rx_filter_set_callback(const struct device *dev, struct can_frame *frame,
+				   void *user_data)
+{
+	struct k_msgq *msgq = user_data;
+
+	zassert_equal(dev, can_dev, "CAN device does not match");
+
+	(void)k_msgq_put(msgq, frame, K_NO_WAIT);
+}
+#endif /* CONFIG_CAN_RX_FILTER_SET */
+
+/**
+ * @brief Test send/receive with a CAN RX filter set.
+ */
+ZTEST(can_classic, test_send_receive_filter_set)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_CAN_RX_FILTER_SET);
+
+#ifdef CONFIG_CAN_RX_FILTER_SET
+	const struct can_filter filters[] = { test_std_filter_1, test_ext_filter_1 };
+	struct can_rx_filter_set set = {
+		.filters = filters,
+		.count = ARRAY_SIZE(filters),
+	};
+	struct can_frame frame;
+	int err;
+
+	err = can_add_rx_filter_set(can_dev, rx_filter_set_callback, &can_msgq, &set);
+	zassert_not_equal(err, -ENOSPC, "no filters available");
+	zassert_true(err > 0 && err <= ARRAY_SIZE(filters), "invalid number of hardware filters");
+
+	send_test_frame(can_dev, &test_std_frame_1);
+	err = k_msgq_get(&can_msgq, &frame, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(err, 0, "receive timeout");
+	assert_frame_equal(&frame, &test_std_frame_1, 0);
+
+	send_test_frame(can_dev, &test_ext_frame_1);
+	err = k_msgq_get(&can_msgq, &frame, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(err, 0, "receive timeout");
+	assert_frame_equal(&frame, &test_ext_frame_1, 0);
+
+	send_test_frame(can_dev, &test_std_frame_2);
+	err = k_msgq_get(&can_msgq, &frame, TEST_RECEIVE_TIMEOUT);
+	zassert_equal(err, -EAGAIN, "received a frame not matching the set");
+
+	can_remove_rx_filter_set(can_dev, &set);
+#endif /* CONFIG_CAN_RX_FILTER_SET */
+}
+
 /**
  * @brief Test send/receive with standard (11-bit) CAN IDs and remote transmission request (RTR).
  */
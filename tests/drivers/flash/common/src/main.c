@@ -7,6 +7,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/drivers/flash/flash_async.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/storage/flash_map.h>
 
@@ -149,4 +150,49 @@ ZTEST(flash_driver, test_read_unaligned_address)
 	}
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+static K_SEM_DEFINE(async_done, 0, 3);
+static int async_results[3];
+static int async_completed;
+
+static void async_cb(struct flash_async_req *req, int result)
+{
+	async_results[async_completed++] = result;
+	k_sem_give(&async_done);
+}
+
+ZTEST(flash_driver, test_async_erase_write_read)
+{
+	struct flash_async_req reqs[3] = { 0 };
+	uint8_t __aligned(4) buf[EXPECTED_SIZE];
+	int rc;
+
+	async_completed = 0;
+	memset(buf, 0, sizeof(buf));
+
+	/* Queued back to back, carried out in order */
+	rc = flash_async_erase(flash_dev, &reqs[0], page_info.start_offset,
+			       page_info.size, async_cb);
+	zassert_equal(rc, 0, "Cannot queue erase");
+	rc = flash_async_write(flash_dev, &reqs[1], page_info.start_offset,
+			       expected, EXPECTED_SIZE, async_cb);
+	zassert_equal(rc, 0, "Cannot queue write");
+	rc = flash_async_read(flash_dev, &reqs[2], page_info.start_offset,
+			      buf, EXPECTED_SIZE, async_cb);
+	zassert_equal(rc, 0, "Cannot queue read");
+	zassert_equal(flash_async_read(flash_dev, &reqs[2], page_info.start_offset,
+				       buf, EXPECTED_SIZE, async_cb),
+		      -EBUSY, "Request in use queued again");
+
+	for (int i = 0; i < ARRAY_SIZE(reqs); i++) {
+		zassert_equal(k_sem_take(&async_done, K_SECONDS(10)), 0,
+			      "Request not completed");
+		zassert_equal(async_results[i], 0, "Request %d failed", i);
+	}
+
+	zassert_equal(memcmp(buf, expected, EXPECTED_SIZE), 0,
+		      "Flash read does not match the write");
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 ZTEST_SUITE(flash_driver, NULL, flash_driver_setup, NULL, NULL, NULL);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/serial/uart_async_rx_net.h>
+#include <zephyr/ztest.h>
+
+#define BUF_SIZE 32
+
+static struct net_buf *chunks[8];
+static size_t chunk_cnt;
+
+static void rx_cb(struct uart_async_rx_net *async_rx, struct net_buf *buf, void *user_data)
+{
+	zassert_true(chunk_cnt < ARRAY_SIZE(chunks));
+	chunks[chunk_cnt++] = buf;
+}
+
+UART_ASYNC_RX_NET_DEFINE(async_rx_net, 2, BUF_SIZE, 3, rx_cb, NULL);
+
+static void chunks_release(void)
+{
+	for (size_t i = 0; i < chunk_cnt; i++) {
+		net_buf_unref(chunks[i]);
+	}
+
+	chunk_cnt = 0;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	chunks_release();
+	uart_async_rx_net_reset(&async_rx_net);
+}
+
+ZTEST(uart_async_rx_net, test_rx_chunks)
+{
+	uint8_t *buf;
+	size_t len;
+
+	buf = uart_async_rx_net_buf_req(&async_rx_net, &len);
+	zassert_not_null(buf);
+	zassert_equal(len, BUF_SIZE);
+
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = i;
+	}
+
+	uart_async_rx_net_on_rdy(&async_rx_net, buf, 0, 10);
+	uart_async_rx_net_on_rdy(&async_rx_net, buf, 10, 5);
+	zassert_equal(chunk_cnt, 2);
+
+	/* Chunks point into the reception buffer */
+	zassert_equal_ptr(chunks[0]->data, buf);
+	zassert_equal(chunks[0]->len, 10);
+	zassert_equal_ptr(chunks[1]->data, buf + 10);
+	zassert_equal(chunks[1]->len, 5);
+	zassert_equal(chunks[1]->data[0], 10);
+}
+
+ZTEST(uart_async_rx_net, test_rx_rotation)
+{
+	uint8_t *buf0, *buf1, *buf;
+	size_t len;
+
+	buf0 = uart_async_rx_net_buf_req(&async_rx_net, &len);
+	buf1 = uart_async_rx_net_buf_req(&async_rx_net, &len);
+	zassert_not_null(buf0);
+	zassert_not_null(buf1);
+
+	/* The driver holds both buffers */
+	zassert_is_null(uart_async_rx_net_buf_req(&async_rx_net, &len));
+
+	uart_async_rx_net_on_rdy(&async_rx_net, buf0, 0, BUF_SIZE);
+	uart_async_rx_net_on_buf_rel(&async_rx_net, buf0);
+
+	/* The first buffer is still referenced by its chunk */
+	zassert_is_null(uart_async_rx_net_buf_req(&async_rx_net, &len));
+
+	chunks_release();
+
+	buf = uart_async_rx_net_buf_req(&async_rx_net, &len);
+	zassert_equal_ptr(buf, buf0);
+}
+
+ZTEST(uart_async_rx_net, test_rx_dropped)
+{
+	uint8_t *buf;
+	size_t len;
+
+	buf = uart_async_rx_net_buf_req(&async_rx_net, &len);
+	zassert_not_null(buf);
+
+	for (int i = 0; i < 4; i++) {
+		uart_async_rx_net_on_rdy(&async_rx_net, buf, i * 4, 4);
+	}
+
+	/* The chunk pool holds 3 chunks */
+	zassert_equal(chunk_cnt, 3);
+	zassert_equal(uart_async_rx_net_get_dropped(&async_rx_net), 4);
+}
+
+ZTEST_SUITE(uart_async_rx_net, NULL, NULL, before, NULL, NULL);
@@ -506,6 +506,60 @@ ZTEST_USER(condvar_tests, test_condvar_wait_null)
 #endif
 
 
+void condvar_broadcast_wait_task(void *p1, void *p2, void *p3)
+{
+	int32_t ret_value;
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	ret_value = k_condvar_wait(&simple_condvar, &test_mutex, K_FOREVER);
+	zassert_equal(ret_value, 0, "k_condvar_wait failed: %d", ret_value);
+	zassert_equal(test_mutex.owner, k_current_get(),
+		      "mutex not held after k_condvar_wait");
+	zassert_equal(test_mutex.lock_count, 1, "mutex lock count %d",
+		      test_mutex.lock_count);
+
+	count++;
+	k_mutex_unlock(&test_mutex);
+}
+
+/**
+ * @brief Test k_condvar_broadcast() with the mutex locked
+ *
+ * @details All waiters return from k_condvar_wait() holding the mutex,
+ * one after the other, once the broadcasting thread unlocks it.
+ */
+ZTEST(condvar_tests, test_condvar_broadcast_mutex_locked)
+{
+	int32_t ret_value;
+
+	count = 0;
+	k_mutex_init(&test_mutex);
+	k_condvar_init(&simple_condvar);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_create(&multiple_tid[i], multiple_stack[i],
+				STACK_SIZE, condvar_broadcast_wait_task,
+				NULL, NULL, NULL, PRIO_WAIT, 0, K_NO_WAIT);
+	}
+
+	/* giving time for the other threads to wait */
+	k_sleep(K_MSEC(10));
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	ret_value = k_condvar_broadcast(&simple_condvar);
+	zassert_equal(ret_value, TOTAL_THREADS_WAITING,
+		      "k_condvar_broadcast failed. (%d!=%d)", ret_value,
+		      TOTAL_THREADS_WAITING);
+	zassert_equal(count, 0, "waiters ran with the mutex locked");
+	k_mutex_unlock(&test_mutex);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_join(&multiple_tid[i], K_FOREVER);
+	}
+
+	zassert_equal(count, TOTAL_THREADS_WAITING, "not all waiters ran");
+}
+
 void inc_count(void *p1, void *p2, void *p3)
 {
 	int i;
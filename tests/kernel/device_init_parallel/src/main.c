@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/ztest.h>
+
+#define INIT_SLEEP_MS 100
+
+static int64_t init_start;
+static int64_t init_end;
+static bool barrier_saw_ready;
+
+static int slow_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_msleep(INIT_SLEEP_MS);
+
+	return 0;
+}
+
+static int failing_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return -EIO;
+}
+
+static int start_init(void)
+{
+	init_start = k_uptime_get();
+
+	return 0;
+}
+
+/* Devices have no dependencies here, so they may all run at once */
+SYS_INIT(start_init, POST_KERNEL, 0);
+DEVICE_DEFINE(slow_a, "slow_a", slow_init, NULL, NULL, NULL, POST_KERNEL, 1, NULL);
+DEVICE_DEFINE(slow_b, "slow_b", slow_init, NULL, NULL, NULL, POST_KERNEL, 2, NULL);
+DEVICE_DEFINE(failing, "failing", failing_init, NULL, NULL, NULL, POST_KERNEL, 3, NULL);
+
+static int barrier_init(void)
+{
+	init_end = k_uptime_get();
+
+	/* Other init functions only run once all devices before them are done */
+	barrier_saw_ready = device_is_ready(DEVICE_GET(slow_a)) &&
+			    device_is_ready(DEVICE_GET(slow_b)) &&
+			    DEVICE_GET(failing)->state->initialized;
+
+	return 0;
+}
+
+SYS_INIT(barrier_init, POST_KERNEL, 4);
+
+ZTEST(device_init_parallel, test_overlap)
+{
+	int64_t elapsed = init_end - init_start;
+
+	zassert_true(barrier_saw_ready);
+	zassert_true(elapsed >= INIT_SLEEP_MS, "initialized in %lld ms", elapsed);
+	zassert_true(elapsed < 2 * INIT_SLEEP_MS, "initialized in %lld ms", elapsed);
+}
+
+ZTEST(device_init_parallel, test_result)
+{
+	zassert_false(device_is_ready(DEVICE_GET(failing)));
+	zassert_equal(DEVICE_GET(failing)->state->init_res, EIO);
+}
+
+ZTEST_SUITE(device_init_parallel, NULL, NULL, NULL, NULL, NULL);
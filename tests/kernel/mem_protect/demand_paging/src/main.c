@@ -63,6 +63,11 @@ char *arena;
 __pinned_bss
 static bool expect_fault;
 
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+__pinned_bss
+static struct k_mem_paging_region arena_region;
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
+
 __pinned_func
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *pEsf)
 {
@@ -94,6 +99,10 @@ ZTEST(demand_paging, test_map_anon_pages)
 			 arena_size);
 	printk("Anonymous memory arena %p size %zu\n", arena, arena_size);
 	z_page_frames_dump();
+
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+	k_mem_paging_region_stats_register(&arena_region, arena, arena_size);
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
 }
 
 static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *scope)
@@ -113,6 +122,11 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	printk("* Prefetch (%s):\n", scope);
+	printk("    - Pages prefetched: %lu\n", stats->prefetch.pages);
+#endif
 }
 
 ZTEST(demand_paging, test_touch_anon_pages)
@@ -186,6 +200,26 @@ ZTEST(demand_paging, test_touch_anon_pages)
 	zassert_not_equal(stats.eviction.clean, 0UL,
 			  "test thread should have clean pages evicted.");
 
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	zassert_not_equal(stats.prefetch.pages, 0UL,
+			  "sequential accesses should have prefetched pages.");
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
+#ifdef CONFIG_DEMAND_PAGING_REGION_STATS
+	/* per-region statistics, the arena takes all of the thread's faults */
+	struct k_mem_paging_stats_t region_stats;
+
+	printk("\nPaging stats for arena:\n");
+	k_mem_paging_region_stats_get(&arena_region, &region_stats);
+	print_paging_stats(&region_stats, "arena");
+	zassert_not_equal(region_stats.pagefaults.cnt, 0UL,
+			  "no page faults accounted to the arena?");
+	zassert_true(region_stats.pagefaults.cnt <= stats.pagefaults.cnt,
+		     "more arena page faults than thread page faults");
+	zassert_not_equal(region_stats.eviction.dirty, 0UL,
+			  "arena should have dirty pages evicted.");
+#endif /* CONFIG_DEMAND_PAGING_REGION_STATS */
+
 	/* Reset arena to zero */
 	for (size_t i = 0; i < arena_size; i++) {
 		arena[i] = 0;
@@ -16,10 +16,25 @@ K_SEM_DEFINE(SEM_REGRESSDONE, 0, 1);
 static K_THREAD_STACK_DEFINE(stack, STACKSIZE);
 static struct k_thread HELPER;
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+#define CACHE_BLK_NUM (4 * CONFIG_MEM_SLAB_CACHE_SIZE)
+
+K_MEM_SLAB_DEFINE_STATIC(cmslab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+static K_MEM_SLAB_CACHE_DEFINE(cmslab_cache);
+static K_MEM_SLAB_CACHE_DEFINE(kmslab_cache);
+static K_MEM_SLAB_CACHE_DEFINE(mslab_cache);
+#endif
+
 void *mslab_setup(void)
 {
 	k_mem_slab_init(&mslab, tslab, BLK_SIZE, BLK_NUM);
 
+#ifdef CONFIG_MEM_SLAB_CACHE
+	/* Run all tests through the per-CPU caches */
+	zassert_ok(k_mem_slab_cache_attach(&kmslab, &kmslab_cache));
+	zassert_ok(k_mem_slab_cache_attach(&mslab, &mslab_cache));
+#endif
+
 	return NULL;
 }
 
@@ -338,3 +353,51 @@ ZTEST(mslab_api, test_mslab_pending)
 	/* Free memory block */
 	k_mem_slab_free(&kmslab, b);
 }
+
+/**
+ * @brief Verify memory slab accounting with a per-CPU cache
+ *
+ * @details Attach a cache to a memory slab, allocate all blocks and
+ * free them again. Blocks held by the cache must be reported as free
+ * and must still be available to allocations.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_api, test_mslab_cache)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_MEM_SLAB_CACHE);
+
+#ifdef CONFIG_MEM_SLAB_CACHE
+	static void *block[CACHE_BLK_NUM];
+	struct sys_memory_stats stats;
+	void *b;
+
+	zassert_ok(k_mem_slab_cache_attach(&cmslab, &cmslab_cache));
+	zassert_equal(k_mem_slab_cache_attach(&cmslab, &cmslab_cache), -EBUSY);
+
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&cmslab, &block[i], K_NO_WAIT));
+		zassert_equal(k_mem_slab_num_used_get(&cmslab), i + 1);
+	}
+	zassert_equal(k_mem_slab_num_free_get(&cmslab), 0);
+	zassert_equal(k_mem_slab_alloc(&cmslab, &b, K_NO_WAIT), -ENOMEM);
+
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cmslab, block[i]);
+		zassert_equal(k_mem_slab_num_free_get(&cmslab), i + 1);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&cmslab), 0);
+
+	zassert_ok(k_mem_slab_runtime_stats_get(&cmslab, &stats));
+	zassert_equal(stats.allocated_bytes, 0);
+	zassert_equal(stats.free_bytes, CACHE_BLK_NUM * BLK_SIZE);
+
+	/* The freed blocks are all allocatable again */
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&cmslab, &block[i], K_NO_WAIT));
+	}
+	for (int i = 0; i < CACHE_BLK_NUM; i++) {
+		k_mem_slab_free(&cmslab, block[i]);
+	}
+#endif
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CLAIM_PIPE_LEN	16
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_LEN, 4);
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static unsigned char claim_rx[CLAIM_PIPE_LEN];
+
+/**
+ * @brief Test in place writing and reading across the end of the buffer
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+ZTEST(pipe_api, test_pipe_claim_wrap)
+{
+	size_t written;
+	size_t len;
+	uint8_t *ptr;
+
+	k_pipe_buffer_flush(&claim_pipe);
+
+	/* Move the indexes close to the end of the buffer */
+	zassert_equal(k_pipe_put(&claim_pipe, "0123456789ab", 12, &written,
+				 12, K_NO_WAIT), 0);
+	len = k_pipe_get_claim(&claim_pipe, &ptr, 12);
+	zassert_equal(len, 12);
+	zassert_mem_equal(ptr, "0123456789ab", 12);
+	zassert_equal(k_pipe_get_commit(&claim_pipe, len), 0);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+
+	/* The free space wraps, so it takes two claims */
+	len = k_pipe_put_claim(&claim_pipe, &ptr, 8);
+	zassert_equal(len, 4);
+	memcpy(ptr, "ABCD", len);
+	len = k_pipe_put_claim(&claim_pipe, &ptr, 4);
+	zassert_equal(len, 4);
+	memcpy(ptr, "EFGH", len);
+
+	/* Nothing is visible before the commit */
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 9), -EINVAL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 8), 0);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 8);
+
+	len = k_pipe_get_claim(&claim_pipe, &ptr, 8);
+	zassert_equal(len, 4);
+	zassert_mem_equal(ptr, "ABCD", 4);
+	len = k_pipe_get_claim(&claim_pipe, &ptr, 4);
+	zassert_equal(len, 4);
+	zassert_mem_equal(ptr, "EFGH", 4);
+
+	/* Release only part of it, the rest stays in the pipe */
+	zassert_equal(k_pipe_get_commit(&claim_pipe, 6), 0);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2);
+	zassert_equal(k_pipe_get(&claim_pipe, claim_rx, 2, &written, 2,
+				 K_NO_WAIT), 0);
+	zassert_mem_equal(claim_rx, "GH", 2);
+}
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	size_t bytes_read;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_get(&claim_pipe, claim_rx, 4, &bytes_read, 4,
+				 K_FOREVER), 0);
+	zassert_equal(bytes_read, 4);
+}
+
+/**
+ * @brief Test that committed data is handed to a waiting reader
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_reader_wait)
+{
+	k_tid_t tid;
+	uint8_t *ptr;
+
+	k_pipe_buffer_flush(&claim_pipe);
+	memset(claim_rx, 0, sizeof(claim_rx));
+
+	tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+			      claim_reader, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the reader pend on the empty pipe */
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &ptr, 4), 4);
+	memcpy(ptr, "wxyz", 4);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 4), 0);
+
+	k_thread_join(tid, K_FOREVER);
+	zassert_mem_equal(claim_rx, "wxyz", 4);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+}
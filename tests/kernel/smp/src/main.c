@@ -757,6 +757,45 @@ ZTEST(smp, test_smp_ipi)
 }
 #endif
 
+/**
+ * @brief Test directed interprocessor interrupts
+ *
+ * @ingroup kernel_smp_integration_tests
+ *
+ * @details Send an IPI to each other CPU in turn, and check it is taken.
+ *
+ * @see arch_sched_directed_ipi()
+ */
+#if defined(CONFIG_SCHED_IPI_SUPPORTED) && defined(CONFIG_ARCH_HAS_DIRECTED_IPIS)
+ZTEST(smp, test_smp_directed_ipi)
+{
+#ifndef CONFIG_TRACE_SCHED_IPI
+	ztest_test_skip();
+#else
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		/* Stay on this CPU while sending */
+		unsigned int key = arch_irq_lock();
+
+		if (cpu == _current_cpu->id) {
+			arch_irq_unlock(key);
+			continue;
+		}
+
+		sched_ipi_has_called = 0;
+		arch_sched_directed_ipi(BIT(cpu));
+		arch_irq_unlock(key);
+
+		k_msleep(100);
+
+		zassert_true(sched_ipi_has_called != 0,
+			     "CPU %u did not receive IPI", cpu);
+	}
+#endif
+}
+#endif
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *esf)
 {
 	static int trigger;
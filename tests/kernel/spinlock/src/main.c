@@ -238,4 +238,41 @@ static void before(void *ctx)
 	trylock_successes = 0;
 }
 
+/**
+ * @brief Test spinlock usage statistics
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_stats_get(), k_spin_stats_reset()
+ */
+ZTEST(spinlock, test_spinlock_stats)
+{
+#ifndef CONFIG_SPIN_LOCK_STATS
+	ztest_test_skip();
+#else
+	static struct k_spinlock l;
+	struct k_spinlock_stats stats;
+	k_spinlock_key_t key;
+
+	k_spin_stats_reset(&l);
+
+	for (int i = 0; i < 3; i++) {
+		key = k_spin_lock(&l);
+		k_busy_wait(100);
+		k_spin_unlock(&l, key);
+	}
+
+	zassert_ok(k_spin_trylock(&l, &key));
+	k_spin_unlock(&l, key);
+
+	k_spin_stats_get(&l, &stats);
+
+	/* Reading the statistics takes the lock as well */
+	zassert_equal(stats.acquired, 5, "acquired %u times", stats.acquired);
+	zassert_equal(stats.contended, 0, "contended %u times", stats.contended);
+	zassert_true(stats.max_hold_cycles > 0);
+	zassert_true(stats.total_hold_cycles >= 3ULL * stats.max_hold_cycles / 2);
+#endif
+}
+
 ZTEST_SUITE(spinlock, NULL, NULL, before, NULL, NULL);
@@ -122,6 +122,60 @@ ZTEST(dynamic_thread_stack, test_dynamic_thread_stack_pool)
 	}
 }
 
+static void deep_func(void *arg1, void *arg2, void *arg3)
+{
+	volatile uint8_t buf[CONFIG_DYNAMIC_THREAD_STACK_SIZE / 2];
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)i;
+	}
+
+	*(bool *)arg1 = true;
+}
+
+static size_t pool_thread_unused(k_thread_entry_t entry, k_thread_stack_t *stack)
+{
+	static struct k_thread th;
+	size_t unused = 0;
+	k_tid_t tid;
+
+	tflag[0] = false;
+	tid = k_thread_create(&th, stack, CONFIG_DYNAMIC_THREAD_STACK_SIZE, entry,
+			      &tflag[0], NULL, NULL, 0, 0, K_FOREVER);
+	zassert_ok(k_thread_stack_space_get(tid, &unused));
+	k_thread_start(tid);
+	zassert_ok(k_thread_join(tid, K_MSEC(TIMEOUT_MS)));
+	zassert_true(tflag[0]);
+
+	return unused;
+}
+
+/** @brief Check that reusing a pool stack repaints all of it */
+ZTEST(dynamic_thread_stack, test_dynamic_thread_stack_pool_repaint)
+{
+	k_thread_stack_t *stack;
+	size_t unused;
+
+	if (!IS_ENABLED(CONFIG_DYNAMIC_THREAD_PREFER_POOL) ||
+	    CONFIG_DYNAMIC_THREAD_POOL_SIZE == 0 || IS_ENABLED(CONFIG_USERSPACE)) {
+		ztest_test_skip();
+	}
+
+	stack = k_thread_stack_alloc(CONFIG_DYNAMIC_THREAD_STACK_SIZE, 0);
+	zassert_not_null(stack);
+
+	/* A fresh thread sees all of its stack unused, past a deep user */
+	unused = pool_thread_unused(func, stack);
+	zassert_true(unused > CONFIG_DYNAMIC_THREAD_STACK_SIZE / 2);
+	zassert_equal(pool_thread_unused(deep_func, stack), unused);
+	zassert_equal(pool_thread_unused(func, stack), unused);
+
+	zassert_ok(k_thread_stack_free(stack));
+}
+
 /** @brief Exercise the heap-based thread stack allocator */
 ZTEST(dynamic_thread_stack, test_dynamic_thread_stack_alloc)
 {
@@ -829,6 +829,46 @@ ZTEST_USER(timer_api, test_sleep_abs)
 
 }
 
+/**
+ * @brief Test that timers with slack expiring close together are coalesced
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+ZTEST_USER(timer_api, test_timer_slack)
+{
+#ifndef CONFIG_TIMEOUT_SLACK
+	ztest_test_skip();
+#else
+	const k_timeout_t slack = K_TICKS(16);
+	k_ticks_t exp0, exp1, now, boundary;
+
+	k_timer_slack_set(&timer0, slack);
+	k_timer_slack_set(&timer1, slack);
+
+	/* Two expiries within the same 16 tick block share its end */
+	do {
+		now = k_uptime_ticks();
+		boundary = ROUND_UP(now + 32, 16);
+		k_timer_start(&timer0, K_TICKS(boundary - 12 - now), K_NO_WAIT);
+		k_timer_start(&timer1, K_TICKS(boundary - 2 - now), K_NO_WAIT);
+		exp0 = k_timer_expires_ticks(&timer0);
+		exp1 = k_timer_expires_ticks(&timer1);
+	} while (now != k_uptime_ticks());
+
+	zassert_equal(exp0, exp1, "expiries %lld and %lld not coalesced",
+		      (int64_t)exp0, (int64_t)exp1);
+	zassert_equal(exp0, boundary, "expiry %lld, expected %lld",
+		      (int64_t)exp0, (int64_t)boundary);
+
+	k_timer_stop(&timer0);
+	k_timer_stop(&timer1);
+	k_timer_slack_set(&timer0, K_NO_WAIT);
+	k_timer_slack_set(&timer1, K_NO_WAIT);
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -541,5 +541,82 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+#define LATENCY_WAKEUPS 5
+
+/**
+ * @brief Helper thread to test_thread_stats_latency()
+ */
+void helper_sleeper(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sleep(K_TICKS(1));
+	}
+}
+
+static uint32_t latency_samples(const k_thread_runtime_stats_t *stats)
+{
+	uint32_t samples = 0;
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS; i++) {
+		samples += stats->latency[i];
+	}
+
+	return samples;
+}
+
+/**
+ * @brief Test the scheduling latency statistics
+ *
+ * A higher priority helper thread repeatedly wakes up while the main
+ * thread busy loops. Every wakeup of the helper must be accounted in its
+ * latency histogram and preempt the main thread.
+ */
+ZTEST(usage_api, test_thread_stats_latency)
+{
+	k_tid_t  tid;
+	int  priority;
+	k_thread_runtime_stats_t  stats1;
+	k_thread_runtime_stats_t  stats2;
+	k_thread_runtime_stats_t  helper_stats;
+
+	/* The main thread must be preemptible for the helper to preempt it */
+
+	priority = k_thread_priority_get(_current);
+	k_thread_priority_set(_current, K_PRIO_PREEMPT(5));
+
+	k_thread_runtime_stats_get(_current, &stats1);
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_sleeper, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(4), 0, K_NO_WAIT);
+
+	busy_loop(LATENCY_WAKEUPS + 2);
+
+	k_thread_runtime_stats_get(_current, &stats2);
+	k_thread_runtime_stats_get(tid, &helper_stats);
+
+	k_thread_priority_set(_current, priority);
+	k_thread_join(tid, K_FOREVER);
+
+	/* The first start and every wakeup of the helper were recorded */
+
+	zassert_true(latency_samples(&helper_stats) >= LATENCY_WAKEUPS + 1);
+	zassert_true(helper_stats.latency_max > 0);
+
+	/* Each of them preempted the busy looping main thread */
+
+	zassert_true(stats2.preemptions - stats1.preemptions >= LATENCY_WAKEUPS + 1);
+	zassert_true(latency_samples(&stats2) > latency_samples(&stats1));
+
+	/* Per CPU statistics do not carry latency data */
+
+	k_thread_runtime_stats_all_get(&stats1);
+	zassert_equal(stats1.preemptions, 0);
+	zassert_equal(latency_samples(&stats1), 0);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_LATENCY */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -1442,6 +1442,113 @@ ZTEST(work_1cpu, test_1cpu_system_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+/* A preemptible queue served by its own thread and one extra worker. */
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(pool_worker_stack, STACK_SIZE);
+static struct k_work_q pool_queue;
+static struct k_work_q_worker pool_worker;
+static bool pool_started;
+
+/* Given by pool handlers when they start, and to release them. */
+static struct k_sem pool_start_sem;
+static struct k_sem pool_rel_sem;
+static atomic_t pool_active;
+static atomic_t pool_reentered;
+
+static void pool_handler(struct k_work *work)
+{
+	if (atomic_inc(&pool_active) != 0) {
+		atomic_inc(&pool_reentered);
+	}
+
+	k_sem_give(&pool_start_sem);
+	k_sem_take(&pool_rel_sem, K_FOREVER);
+
+	atomic_dec(&pool_active);
+}
+
+static void pool_start(void)
+{
+	k_sem_init(&pool_start_sem, 0, 2);
+	k_sem_init(&pool_rel_sem, 0, 2);
+	atomic_clear(&pool_reentered);
+
+	if (pool_started) {
+		return;
+	}
+
+	k_work_queue_start(&pool_queue, pool_stack, STACK_SIZE,
+			   PREEMPT_PRIORITY, NULL);
+	k_work_queue_worker_start(&pool_queue, &pool_worker,
+				  pool_worker_stack, STACK_SIZE,
+				  PREEMPT_PRIORITY, NULL);
+	pool_started = true;
+}
+
+/* Check that independent items run in parallel on the workers. */
+ZTEST(work_1cpu, test_1cpu_workers_parallel)
+{
+	int rc;
+
+	pool_start();
+	k_work_init(&common_work, pool_handler);
+	k_work_init(&common_work1, pool_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &common_work);
+	zassert_equal(rc, 1);
+	rc = k_work_submit_to_queue(&pool_queue, &common_work1);
+	zassert_equal(rc, 1);
+
+	/* Both handlers are blocked, so both workers must be busy. */
+	zassert_equal(k_sem_take(&pool_start_sem, DELAY_TIMEOUT), 0);
+	zassert_equal(k_sem_take(&pool_start_sem, DELAY_TIMEOUT), 0);
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_RUNNING);
+
+	k_sem_give(&pool_rel_sem);
+	k_sem_give(&pool_rel_sem);
+
+	rc = k_work_queue_drain(&pool_queue, false);
+	zassert_equal(rc, 1);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+	zassert_equal(atomic_get(&pool_reentered), 0);
+}
+
+/* Check that an item resubmitted while running isn't picked up by the idle
+ * worker until the running instance completes.
+ */
+ZTEST(work_1cpu, test_1cpu_workers_resubmit_running)
+{
+	int rc;
+
+	pool_start();
+	k_work_init(&common_work, pool_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &common_work);
+	zassert_equal(rc, 1);
+	zassert_equal(k_sem_take(&pool_start_sem, DELAY_TIMEOUT), 0);
+
+	rc = k_work_submit_to_queue(&pool_queue, &common_work);
+	zassert_equal(rc, 2);
+	zassert_equal(k_work_busy_get(&common_work),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* The other worker is idle, but must leave the item alone. */
+	zassert_equal(k_sem_take(&pool_start_sem, DELAY_TIMEOUT), -EAGAIN);
+
+	k_sem_give(&pool_rel_sem);
+	zassert_equal(k_sem_take(&pool_start_sem, DELAY_TIMEOUT), 0);
+	k_sem_give(&pool_rel_sem);
+
+	rc = k_work_queue_drain(&pool_queue, false);
+	zassert_equal(rc, 1);
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(atomic_get(&pool_reentered), 0);
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 ZTEST(work, test_nop)
 {
 	ztest_test_skip();
@@ -602,6 +602,46 @@ ZTEST(libc_common, test_memcpy)
 		0, "memcpy failed");
 }
 
+/**
+ * @brief Test memcpy and memcmp on long buffers at every alignment
+ *
+ * @see memcpy(), memcmp().
+ */
+ZTEST(libc_common, test_memcpy_alignment)
+{
+	uintptr_t mem_dest[16];
+	uintptr_t mem_src[16];
+	unsigned char *mem_dest_byte = (unsigned char *)mem_dest;
+	unsigned char *mem_src_byte = (unsigned char *)mem_src;
+	size_t len = sizeof(mem_src) - 2 * sizeof(uintptr_t);
+
+	for (int i = 0; i < sizeof(mem_src); i++) {
+		mem_src_byte[i] = i * 7;
+	}
+
+	for (int s = 0; s < sizeof(uintptr_t); s++) {
+		for (int d = 0; d < sizeof(uintptr_t); d++) {
+			memset(mem_dest, 0xA5, sizeof(mem_dest));
+
+			zassert_equal(memcpy(mem_dest_byte + d, mem_src_byte + s, len),
+				      mem_dest_byte + d, "memcpy error");
+			zassert_equal(memcmp(mem_dest_byte + d, mem_src_byte + s, len), 0,
+				      "memcpy failed");
+
+			/* bytes around the copy are untouched */
+			for (int i = 0; i < d; i++) {
+				zassert_equal(mem_dest_byte[i], 0xA5, "memcpy overrun");
+			}
+			zassert_equal(mem_dest_byte[d + len], 0xA5, "memcpy overrun");
+
+			/* a difference in the last byte is found */
+			mem_dest_byte[d + len - 1]++;
+			zassert_not_equal(memcmp(mem_dest_byte + d, mem_src_byte + s, len), 0,
+					  "memcmp failed");
+		}
+	}
+}
+
 /**
  * @brief Test memmove operation
  *
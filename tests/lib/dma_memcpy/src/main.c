@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/dma_memcpy.h>
+
+/* More blocks than CONFIG_DMA_MEMCPY_BLOCKS allows for the largest copy */
+#define BUF_SIZE (CONFIG_DMA_MEMCPY_BLOCK_SIZE * (CONFIG_DMA_MEMCPY_BLOCKS + 1))
+#define NUM_COPIES (CONFIG_DMA_MEMCPY_CHANNELS + 2)
+#define COPY_SIZE (BUF_SIZE / NUM_COPIES)
+
+static uint8_t src[BUF_SIZE] __aligned(4);
+static uint8_t dst[BUF_SIZE] __aligned(4);
+
+static K_SEM_DEFINE(done_sem, 0, NUM_COPIES);
+static int done_result;
+
+static void copy_done(int result, void *user_data)
+{
+	atomic_t *count = user_data;
+
+	if (result < 0) {
+		done_result = result;
+	}
+
+	(void)atomic_inc(count);
+	k_sem_give(&done_sem);
+}
+
+static void check_copy(size_t offset, size_t len)
+{
+	zassert_mem_equal(&dst[offset], &src[offset], len, "copy of %zu bytes at %zu differs",
+			  len, offset);
+}
+
+ZTEST(dma_memcpy, test_small_copy)
+{
+	atomic_t count = ATOMIC_INIT(0);
+
+	zassert_ok(dma_memcpy_async(dst, src, CONFIG_DMA_MEMCPY_THRESHOLD - 1, copy_done,
+				    &count));
+
+	/* Done with memcpy(), so completed already */
+	zassert_equal(atomic_get(&count), 1);
+	zassert_ok(k_sem_take(&done_sem, K_NO_WAIT));
+	check_copy(0, CONFIG_DMA_MEMCPY_THRESHOLD - 1);
+}
+
+ZTEST(dma_memcpy, test_async_copy)
+{
+	atomic_t count = ATOMIC_INIT(0);
+	size_t len = CONFIG_DMA_MEMCPY_BLOCK_SIZE * 2 + 3;
+
+	zassert_ok(dma_memcpy_async(dst, src, len, copy_done, &count));
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)));
+
+	zassert_equal(atomic_get(&count), 1);
+	zassert_ok(done_result);
+	check_copy(0, len);
+	zassert_equal(dst[len], 0, "copied past the end");
+}
+
+ZTEST(dma_memcpy, test_sync_copy)
+{
+	/* Unaligned, so copied a byte at a time */
+	zassert_ok(dma_memcpy(&dst[1], &src[1], CONFIG_DMA_MEMCPY_BLOCK_SIZE));
+	check_copy(1, CONFIG_DMA_MEMCPY_BLOCK_SIZE);
+
+	/* One block too many, so done with memcpy() */
+	zassert_ok(dma_memcpy(dst, src, BUF_SIZE));
+	check_copy(0, BUF_SIZE);
+}
+
+ZTEST(dma_memcpy, test_all_channels_busy)
+{
+	atomic_t count = ATOMIC_INIT(0);
+
+	/* The copies after the channels are all busy are done with memcpy() */
+	for (size_t i = 0; i < NUM_COPIES; i++) {
+		zassert_ok(dma_memcpy_async(&dst[i * COPY_SIZE], &src[i * COPY_SIZE], COPY_SIZE,
+					    copy_done, &count));
+	}
+
+	for (size_t i = 0; i < NUM_COPIES; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)));
+	}
+
+	zassert_equal(atomic_get(&count), NUM_COPIES);
+	zassert_ok(done_result);
+	check_copy(0, COPY_SIZE * NUM_COPIES);
+}
+
+ZTEST(dma_memcpy, test_no_callback)
+{
+	zassert_equal(dma_memcpy_async(dst, src, BUF_SIZE, NULL, NULL), -EINVAL);
+}
+
+static void dma_memcpy_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = (uint8_t)(i * 7U + 1U);
+	}
+
+	memset(dst, 0, sizeof(dst));
+	k_sem_reset(&done_sem);
+	done_result = 0;
+}
+
+ZTEST_SUITE(dma_memcpy, NULL, NULL, dma_memcpy_before, NULL, NULL);
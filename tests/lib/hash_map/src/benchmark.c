@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "_main.h"
+
+/* Keys are spread out so that they do not end up in consecutive buckets */
+#define KEY(i) ((uint64_t)(i) * 0x9e3779b97f4a7c15ULL)
+
+static void report(const char *op, uint32_t cycles)
+{
+	TC_PRINT("%s: %u cycles for %u entries (%u ns per entry)\n", op, cycles, MANY,
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / MANY));
+}
+
+ZTEST(hash_map, test_benchmark)
+{
+	uint64_t value;
+	uint32_t start;
+
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&map, KEY(i), i, NULL));
+	}
+	report("insert", k_cycle_get_32() - start);
+
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_true(sys_hashmap_get(&map, KEY(i), &value));
+	}
+	report("get (hit)", k_cycle_get_32() - start);
+
+	start = k_cycle_get_32();
+	for (size_t i = MANY; i < 2 * MANY; ++i) {
+		zassert_false(sys_hashmap_get(&map, KEY(i), &value));
+	}
+	report("get (miss)", k_cycle_get_32() - start);
+
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_true(sys_hashmap_remove(&map, KEY(i), NULL));
+	}
+	report("remove", k_cycle_get_32() - start);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "_main.h"
+
+#ifdef CONFIG_SYS_HASH_MAP_SWISS
+
+static size_t n_allocs;
+
+static void *counting_realloc(void *ptr, size_t new_size)
+{
+	if (new_size != 0) {
+		++n_allocs;
+	}
+
+	return realloc(ptr, new_size);
+}
+
+SYS_HASHMAP_SWISS_DEFINE_STATIC_ADVANCED(reserved_map, sys_hash32, counting_realloc,
+					 SYS_HASHMAP_CONFIG(MANY, SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+ZTEST(hash_map, test_swiss_reserve)
+{
+	size_t allocs;
+
+	zassert_equal(-ENOSPC, sys_hashmap_swiss_reserve(&reserved_map, MANY + 1));
+	zassert_ok(sys_hashmap_swiss_reserve(&reserved_map, MANY));
+	zassert_true(sys_hashmap_load_factor(&reserved_map) == 0);
+
+	allocs = n_allocs;
+
+	for (int round = 0; round < 4; ++round) {
+		for (size_t i = 0; i < MANY; ++i) {
+			zassert_equal(1, sys_hashmap_insert(&reserved_map, round * MANY + i, i,
+							    NULL));
+		}
+
+		zassert_equal(-ENOSPC, sys_hashmap_insert(&reserved_map, UINT64_MAX, 0, NULL));
+
+		for (size_t i = 0; i < MANY; ++i) {
+			zassert_true(sys_hashmap_remove(&reserved_map, round * MANY + i, NULL));
+		}
+	}
+
+	zassert_equal(allocs, n_allocs, "memory allocated after reserve");
+	zassert_not_null(reserved_map.data->buckets, "reserved table was freed");
+
+	sys_hashmap_clear(&reserved_map, NULL, NULL);
+	zassert_is_null(reserved_map.data->buckets);
+}
+
+#endif /* CONFIG_SYS_HASH_MAP_SWISS */
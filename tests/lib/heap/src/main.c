@@ -160,6 +160,15 @@ static void log_result(size_t sz, struct z_heap_stress_result *r)
 		 r->total_frees, avg, (int) sz, avg_pct);
 }
 
+static void log_latency(struct z_heap_stress_result *r)
+{
+	TC_PRINT("alloc cycles: avg %u max %u, free cycles: avg %u max %u\n",
+		 (uint32_t)(r->accumulated_alloc_cycles / MAX(r->total_allocs, 1)),
+		 r->max_alloc_cycles,
+		 (uint32_t)(r->accumulated_free_cycles / MAX(r->total_frees, 1)),
+		 r->max_free_cycles);
+}
+
 /* Do a heavy test over a small heap, with many iterations that need
  * to reuse memory repeatedly.  Target 50% fill, as that setting tends
  * to prevent runaway fragmentation and most allocations continue to
@@ -268,6 +277,152 @@ ZTEST(lib_heap, test_solo_free_header)
 	}
 }
 
+/* Runs the stress rig from several threads at once over one k_heap,
+ * so allocation and free latency includes contention for the heap.
+ */
+#define CONTENTION_THREADS 4
+#define CONTENTION_HEAP_SZ MIN(BIG_HEAP_SZ, 8192)
+#define CONTENTION_STACK_SZ (2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CONTENTION_SCRATCH_SZ (sizeof(scratchmem) / CONTENTION_THREADS)
+
+static struct k_heap contention_heap;
+static struct k_thread contention_threads[CONTENTION_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(contention_stacks, CONTENTION_THREADS,
+				   CONTENTION_STACK_SZ);
+static struct z_heap_stress_result contention_results[CONTENTION_THREADS];
+
+static void *k_heap_testalloc(void *arg, size_t bytes)
+{
+	void *ret = k_heap_alloc(arg, bytes, K_NO_WAIT);
+
+	fill_block(ret, bytes);
+	return ret;
+}
+
+static void k_heap_testfree(void *arg, void *p)
+{
+	check_fill(p);
+	k_heap_free(arg, p);
+}
+
+static void contention_fn(void *arg1, void *arg2, void *arg3)
+{
+	uintptr_t id = (uintptr_t)arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	sys_heap_stress(k_heap_testalloc, k_heap_testfree, &contention_heap,
+			CONTENTION_HEAP_SZ, ITERATION_COUNT,
+			(uint8_t *)scratchmem + id * CONTENTION_SCRATCH_SZ,
+			CONTENTION_SCRATCH_SZ, 50, &contention_results[id]);
+}
+
+ZTEST(lib_heap, test_contention)
+{
+	TC_PRINT("Testing %d threads on a %d byte k_heap\n",
+		 CONTENTION_THREADS, (int) CONTENTION_HEAP_SZ);
+
+	k_heap_init(&contention_heap, heapmem, CONTENTION_HEAP_SZ);
+
+#ifdef CONFIG_TIMESLICING
+	/* Make the threads interleave on a single CPU too */
+	k_sched_time_slice_set(1, K_PRIO_PREEMPT(1));
+#endif
+
+	for (uintptr_t i = 0; i < CONTENTION_THREADS; i++) {
+		k_thread_create(&contention_threads[i], contention_stacks[i],
+				K_THREAD_STACK_SIZEOF(contention_stacks[i]),
+				contention_fn, (void *)i, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < CONTENTION_THREADS; i++) {
+		k_thread_join(&contention_threads[i], K_FOREVER);
+		log_result(CONTENTION_HEAP_SZ, &contention_results[i]);
+		log_latency(&contention_results[i]);
+	}
+
+#ifdef CONFIG_TIMESLICING
+	k_sched_time_slice_set(0, 0);
+#endif
+
+	zassert_true(sys_heap_validate(&contention_heap.heap), "");
+
+#if defined(CONFIG_SYS_HEAP_CACHE) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	struct sys_heap_cache_stats stats;
+
+	zassert_ok(sys_heap_cache_stats_get(&contention_heap.heap, &stats));
+	TC_PRINT("cache hits: %u, misses: %u, cached bytes: %u\n",
+		 stats.hits, stats.misses, (uint32_t)stats.cached_bytes);
+#endif
+}
+
+ZTEST(lib_heap, test_cache)
+{
+#if defined(CONFIG_SYS_HEAP_CACHE) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	struct sys_heap heap;
+	struct sys_heap_cache_stats stats;
+	void *p1, *p2, *p3;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_equal(sys_heap_cache_bytes(1), 16);
+	zassert_equal(sys_heap_cache_bytes(17), 32);
+	zassert_equal(sys_heap_cache_bytes(128), 128);
+	zassert_equal(sys_heap_cache_bytes(129), 129);
+
+	/* Empty cache misses, too big requests are not counted at all */
+	zassert_is_null(sys_heap_cache_alloc(&heap, 24));
+	zassert_is_null(sys_heap_cache_alloc(&heap, 256));
+
+	/* A class sized block is cached and handed out again */
+	p1 = sys_heap_alloc(&heap, sys_heap_cache_bytes(24));
+	zassert_not_null(p1);
+	zassert_true(sys_heap_cache_free(&heap, p1), "block not cached");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	p2 = sys_heap_cache_alloc(&heap, 20);
+	zassert_equal(p1, p2, "cached block not reused %p -> %p", p1, p2);
+	zassert_true(sys_heap_usable_size(&heap, p2) >= 32, "");
+
+	/* Odd sizes are left to the heap */
+	p3 = sys_heap_alloc(&heap, 24);
+	zassert_false(sys_heap_cache_free(&heap, p3), "odd block cached");
+	sys_heap_free(&heap, p3);
+
+	/* Each class holds a bounded number of blocks */
+	void *blocks[CONFIG_SYS_HEAP_CACHE_BLOCKS + 1];
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = sys_heap_alloc(&heap, 64);
+		zassert_not_null(blocks[i]);
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks) - 1; i++) {
+		zassert_true(sys_heap_cache_free(&heap, blocks[i]), "");
+	}
+	zassert_false(sys_heap_cache_free(&heap, blocks[ARRAY_SIZE(blocks) - 1]), "");
+	sys_heap_free(&heap, blocks[ARRAY_SIZE(blocks) - 1]);
+
+	zassert_ok(sys_heap_cache_stats_get(&heap, &stats));
+	zassert_equal(stats.hits, 1);
+	zassert_equal(stats.misses, 1);
+	zassert_true(stats.cached_bytes >= CONFIG_SYS_HEAP_CACHE_BLOCKS * 64, "");
+
+	/* Flushing returns everything to the heap */
+	zassert_true(sys_heap_cache_flush(&heap), "");
+	zassert_false(sys_heap_cache_flush(&heap), "");
+	zassert_ok(sys_heap_cache_stats_get(&heap, &stats));
+	zassert_equal(stats.cached_bytes, 0);
+	zassert_is_null(sys_heap_cache_alloc(&heap, 64));
+
+	sys_heap_free(&heap, p2);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+#else
+	ztest_test_skip();
+#endif
+}
+
 /* Simple clobber detection */
 void realloc_fill_block(uint8_t *p, size_t sz)
 {
@@ -320,6 +320,26 @@ ZTEST(lib_json_test, test_json_limits)
 		     "Integer limits not decoded correctly");
 }
 
+ZTEST(lib_json_test, test_json_field_order)
+{
+	char encoded[] = "{\"int_min\":-3,"
+			 "\"int_cero\":2,"
+			 "\"int_min\":7,"
+			 "\"int_max\":1"
+			 "}";
+	struct test_int_limits limits = {0};
+	int64_t ret;
+
+	/* Fields out of descriptor order and repeated fields */
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, obj_limits_descr,
+			     ARRAY_SIZE(obj_limits_descr), &limits);
+
+	zassert_equal(ret, 0x7, "Not all fields decoded");
+	zassert_equal(limits.int_max, 1, "Field int_max not decoded correctly");
+	zassert_equal(limits.int_cero, 2, "Field int_cero not decoded correctly");
+	zassert_equal(limits.int_min, -3, "Repeated field int_min not skipped");
+}
+
 ZTEST(lib_json_test, test_json_encoding_array_array)
 {
 	struct obj_array_array obj_array_array_ts = {
@@ -452,6 +472,70 @@ ZTEST(lib_json_test, test_json_arr_obj_decoding)
 		      "Usain Bolt height not decoded correctly");
 }
 
+struct arr_stream_test {
+	int count;
+	const char *names[3];
+	int heights[3];
+};
+
+static int arr_stream_cb(void *val, int64_t decoded_fields, void *user_data)
+{
+	struct arr_stream_test *test = user_data;
+	struct elt *elt = val;
+
+	zassert_true(test->count < ARRAY_SIZE(test->names), "Too many objects");
+	zassert_equal(decoded_fields, 0x3, "Not all fields decoded");
+	zassert_true(!strcmp(elt->name, test->names[test->count]),
+		     "String not decoded correctly");
+	zassert_equal(elt->height, test->heights[test->count],
+		      "Height not decoded correctly");
+
+	test->count++;
+
+	return 0;
+}
+
+ZTEST(lib_json_test, test_json_arr_stream)
+{
+	const char encoded[] = " [{\"name\":\"Sim\303\263n \\\"}\\\"\",\"height\":168},\n"
+			       "{\"height\":173,\"extra\":{\"nested\":[1,2]},\"name\":\"Pel\303\251\"},"
+			       "{\"name\":\"Usain Bolt\",\"height\":195}] ";
+	struct arr_stream_test test = {
+		.names = {"Sim\303\263n \\\"}\\\"", "Pel\303\251", "Usain Bolt"},
+		.heights = {168, 173, 195},
+	};
+	struct json_arr_stream stream;
+	struct elt elt;
+	char buf[64];
+
+	json_arr_stream_init(&stream, buf, sizeof(buf), elt_descr, ARRAY_SIZE(elt_descr),
+			     &elt, arr_stream_cb, &test);
+
+	/* Feed one byte at a time, the worst case for the parser's state */
+	for (size_t i = 0; i < sizeof(encoded) - 1; i++) {
+		zassert_ok(json_arr_stream_feed(&stream, &encoded[i], 1),
+			   "Parsing failed at offset %zu", i);
+
+		if (i < sizeof(encoded) - 3) {
+			zassert_equal(json_arr_stream_finish(&stream), -EINVAL,
+				      "Array complete too early");
+		}
+	}
+
+	zassert_ok(json_arr_stream_finish(&stream), "Array not complete");
+	zassert_equal(test.count, 3, "Not all objects decoded");
+
+	/* An object larger than the buffer */
+	json_arr_stream_init(&stream, buf, 8, elt_descr, ARRAY_SIZE(elt_descr),
+			     &elt, arr_stream_cb, &test);
+	zassert_equal(json_arr_stream_feed(&stream, encoded, sizeof(encoded) - 1), -ENOMEM);
+
+	/* Not an array of objects */
+	json_arr_stream_init(&stream, buf, sizeof(buf), elt_descr, ARRAY_SIZE(elt_descr),
+			     &elt, arr_stream_cb, &test);
+	zassert_equal(json_arr_stream_feed(&stream, "[1]", 3), -EINVAL);
+}
+
 ZTEST(lib_json_test, test_json_arr_obj_encoding)
 {
 	struct obj_array oa = {
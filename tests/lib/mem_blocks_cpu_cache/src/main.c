@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/sys/mem_blocks.h>
+#include <zephyr/sys/util.h>
+
+#define BLK_SZ     64
+#define NUM_BLOCKS 16
+
+SYS_MEM_BLOCKS_DEFINE(mem_block_01, BLK_SZ, NUM_BLOCKS, 4);
+
+static uint32_t used_blocks_get(void)
+{
+	struct sys_memory_stats stats;
+
+	zassert_ok(sys_mem_blocks_runtime_stats_get(&mem_block_01, &stats));
+
+	return stats.allocated_bytes / BLK_SZ;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start each test from an empty allocator and empty caches */
+	zassert_true(sys_mem_blocks_is_region_free(&mem_block_01, mem_block_01.buffer,
+						   NUM_BLOCKS));
+}
+
+ZTEST(lib_mem_blocks_cpu_cache, test_reuse)
+{
+	void *blocks[3];
+	void *blk;
+	int val;
+
+	zassert_ok(sys_mem_blocks_alloc(&mem_block_01, ARRAY_SIZE(blocks), blocks));
+	zassert_equal(used_blocks_get(), 3);
+
+	zassert_ok(sys_mem_blocks_free(&mem_block_01, 1, &blocks[2]));
+	zassert_equal(used_blocks_get(), 2);
+
+	/* Cached blocks stay set in the bitmap */
+	zassert_ok(sys_bitarray_test_bit(mem_block_01.bitmap,
+					 ((uint8_t *)blocks[2] - mem_block_01.buffer) / BLK_SZ,
+					 &val));
+	zassert_equal(val, 1);
+
+	/* Freeing a cached block again is caught */
+	zassert_equal(sys_mem_blocks_free(&mem_block_01, 1, &blocks[2]), -EFAULT);
+	zassert_equal(used_blocks_get(), 2);
+
+	/* The last freed block comes back first */
+	zassert_ok(sys_mem_blocks_alloc(&mem_block_01, 1, &blk));
+	zassert_equal_ptr(blk, blocks[2]);
+	zassert_equal(used_blocks_get(), 3);
+
+	zassert_ok(sys_mem_blocks_free(&mem_block_01, ARRAY_SIZE(blocks), blocks));
+	zassert_equal(used_blocks_get(), 0);
+}
+
+ZTEST(lib_mem_blocks_cpu_cache, test_drain)
+{
+	void *blocks[NUM_BLOCKS];
+	void *blk;
+
+	/* Fill the cache, then ask for all blocks at once */
+	zassert_ok(sys_mem_blocks_alloc(&mem_block_01, NUM_BLOCKS, blocks));
+	zassert_ok(sys_mem_blocks_free(&mem_block_01, NUM_BLOCKS, blocks));
+	zassert_equal(used_blocks_get(), 0);
+
+	zassert_ok(sys_mem_blocks_alloc_contiguous(&mem_block_01, NUM_BLOCKS, &blk));
+	zassert_equal_ptr(blk, mem_block_01.buffer);
+	zassert_ok(sys_mem_blocks_free_contiguous(&mem_block_01, blk, NUM_BLOCKS));
+
+	/* Getting a cached block takes it out of the cache */
+	zassert_ok(sys_mem_blocks_alloc(&mem_block_01, 1, &blk));
+	zassert_ok(sys_mem_blocks_free(&mem_block_01, 1, &blk));
+	zassert_ok(sys_mem_blocks_get(&mem_block_01, blk, 1));
+	zassert_equal(used_blocks_get(), 1);
+
+	/* All other blocks remain available */
+	zassert_ok(sys_mem_blocks_alloc(&mem_block_01, NUM_BLOCKS - 1, blocks));
+	zassert_equal(sys_mem_blocks_alloc(&mem_block_01, 1, &blocks[NUM_BLOCKS - 1]), -ENOMEM);
+	zassert_equal(used_blocks_get(), NUM_BLOCKS);
+
+	zassert_ok(sys_mem_blocks_free(&mem_block_01, NUM_BLOCKS - 1, blocks));
+	zassert_ok(sys_mem_blocks_free_contiguous(&mem_block_01, blk, 1));
+}
+
+ZTEST_SUITE(lib_mem_blocks_cpu_cache, NULL, NULL, before, NULL, NULL);
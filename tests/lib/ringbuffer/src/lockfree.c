@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/sys/ring_buffer_lockfree.h>
+
+#define SPSC_SIZE 64
+#define MPSC_SIZE 128
+
+RING_BUF_SPSC_DECLARE(spsc, SPSC_SIZE);
+RING_BUF_MPSC_DECLARE(mpsc, MPSC_SIZE);
+
+static uint8_t spsc_count;
+
+static void spsc_isr_put(const void *arg)
+{
+	uint8_t data[7];
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = spsc_count++;
+	}
+
+	zassert_equal(ring_buf_spsc_put(&spsc, data, sizeof(data)), sizeof(data));
+}
+
+ZTEST(ringbuffer_api, test_ringbuffer_spsc)
+{
+	uint8_t data[7];
+	uint8_t expected = 0;
+	uint8_t *ptr;
+
+	ring_buf_spsc_init(&spsc, SPSC_SIZE, spsc.buffer);
+	spsc_count = 0;
+
+	zassert_true(ring_buf_spsc_is_empty(&spsc));
+	zassert_equal(ring_buf_spsc_capacity_get(&spsc), SPSC_SIZE);
+
+	/* ISR producer, thread consumer, going round the buffer a few times */
+	for (int i = 0; i < 100; i++) {
+		irq_offload(spsc_isr_put, NULL);
+
+		zassert_equal(ring_buf_spsc_size_get(&spsc), sizeof(data));
+		zassert_equal(ring_buf_spsc_get(&spsc, data, sizeof(data)), sizeof(data));
+
+		for (int j = 0; j < sizeof(data); j++) {
+			zassert_equal(data[j], expected++);
+		}
+	}
+
+	/* Surplus claimed bytes are given back */
+	zassert_equal(ring_buf_spsc_put_claim(&spsc, &ptr, 10), 10);
+	zassert_equal(ring_buf_spsc_put_finish(&spsc, 11), -EINVAL);
+	zassert_ok(ring_buf_spsc_put_finish(&spsc, 4));
+	zassert_equal(ring_buf_spsc_size_get(&spsc), 4);
+
+	/* Claimed bytes are not freed until finished */
+	zassert_equal(ring_buf_spsc_get_claim(&spsc, &ptr, 10), 4);
+	zassert_equal(ring_buf_spsc_space_get(&spsc), SPSC_SIZE - 4);
+	zassert_ok(ring_buf_spsc_get_finish(&spsc, 4));
+	zassert_true(ring_buf_spsc_is_empty(&spsc));
+
+	/* A full buffer takes no more data */
+	for (int i = 0; i < SPSC_SIZE / sizeof(data); i++) {
+		zassert_equal(ring_buf_spsc_put(&spsc, data, sizeof(data)), sizeof(data));
+	}
+	zassert_equal(ring_buf_spsc_put(&spsc, data, sizeof(data)), SPSC_SIZE % sizeof(data));
+	zassert_equal(ring_buf_spsc_space_get(&spsc), 0);
+}
+
+static void mpsc_isr_put(const void *arg)
+{
+	uint32_t value = POINTER_TO_UINT(arg);
+
+	zassert_ok(ring_buf_mpsc_put(&mpsc, (uint8_t *)&value, sizeof(value)));
+}
+
+ZTEST(ringbuffer_api, test_ringbuffer_mpsc)
+{
+	uint8_t data[48];
+	uint32_t value;
+	uint8_t *ptr, *isr_data = NULL;
+	int ret;
+
+	ring_buf_mpsc_init(&mpsc, MPSC_SIZE, mpsc.buffer);
+
+	zassert_equal(ring_buf_mpsc_get(&mpsc, data, sizeof(data)), -EAGAIN);
+	zassert_equal(ring_buf_mpsc_put_claim(&mpsc, &ptr, MPSC_SIZE), -EMSGSIZE);
+
+	/* A record claimed by a thread holds back records claimed after it,
+	 * e.g. by an ISR preempting the thread.
+	 */
+	zassert_ok(ring_buf_mpsc_put_claim(&mpsc, &ptr, sizeof(value)));
+	irq_offload(mpsc_isr_put, UINT_TO_POINTER(2));
+	zassert_equal(ring_buf_mpsc_get_claim(&mpsc, &isr_data), 0);
+
+	value = 1;
+	memcpy(ptr, &value, sizeof(value));
+	ring_buf_mpsc_put_finish(&mpsc, ptr, sizeof(value));
+
+	for (uint32_t i = 1; i <= 2; i++) {
+		zassert_equal(ring_buf_mpsc_get(&mpsc, (uint8_t *)&value, sizeof(value)),
+			      sizeof(value));
+		zassert_equal(value, i);
+	}
+
+	/* Records are dropped or shrunk when finished */
+	zassert_ok(ring_buf_mpsc_put_claim(&mpsc, &ptr, sizeof(data)));
+	ring_buf_mpsc_put_finish(&mpsc, ptr, 0);
+	zassert_ok(ring_buf_mpsc_put_claim(&mpsc, &ptr, sizeof(data)));
+	memset(ptr, 0xaa, 5);
+	ring_buf_mpsc_put_finish(&mpsc, ptr, 5);
+
+	zassert_equal(ring_buf_mpsc_get(&mpsc, data, 4), -EMSGSIZE);
+	zassert_equal(ring_buf_mpsc_get(&mpsc, data, sizeof(data)), 5);
+	zassert_equal(ring_buf_mpsc_get(&mpsc, data, sizeof(data)), -EAGAIN);
+
+	/* Records are never split when the buffer wraps */
+	for (int i = 0; i < 20; i++) {
+		memset(data, i, sizeof(data));
+		zassert_ok(ring_buf_mpsc_put(&mpsc, data, sizeof(data)));
+		ret = ring_buf_mpsc_get_claim(&mpsc, &ptr);
+		zassert_equal(ret, sizeof(data));
+		zassert_mem_equal(ptr, data, sizeof(data));
+		zassert_ok(ring_buf_mpsc_get_finish(&mpsc));
+	}
+
+	zassert_equal(ring_buf_mpsc_get_finish(&mpsc), -EINVAL);
+}
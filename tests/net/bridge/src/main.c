@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2021 BayLibre SAS
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -217,10 +218,23 @@ static void test_iface_setup(void)
 	get_free_packet_count();
 }
 
+/*
+ * The source MAC address used for packets received on an interface
+ */
+static void src_addr_get(struct net_if *iface, struct net_eth_addr *addr)
+{
+	addr->addr[0] = 0xa2;
+	addr->addr[1] = 0x11;
+	addr->addr[2] = 0x22;
+	addr->addr[3] = net_if_get_by_iface(iface);
+	addr->addr[4] = 0x77;
+	addr->addr[5] = 0x88;
+}
+
 /*
  * Simulate a packet reception from the outside world
  */
-static void _recv_data(struct net_if *iface)
+static void _recv_data_to(struct net_if *iface, const struct net_eth_addr *dst)
 {
 	struct net_pkt *pkt;
 	struct net_eth_hdr eth_hdr;
@@ -231,26 +245,8 @@ static void _recv_data(struct net_if *iface)
 					   AF_UNSPEC, 0, K_FOREVER);
 	zassert_not_null(pkt, "");
 
-	/*
-	 * The source and destination MAC addresses are completely arbitrary
-	 * except for the U/L and I/G bits. However, the index of the faked
-	 * incoming interface is mixed in as well to create some variation,
-	 * and to help with validation on the transmit side.
-	 */
-
-	eth_hdr.dst.addr[0] = 0xb2;
-	eth_hdr.dst.addr[1] = 0x11;
-	eth_hdr.dst.addr[2] = 0x22;
-	eth_hdr.dst.addr[3] = 0x33;
-	eth_hdr.dst.addr[4] = net_if_get_by_iface(iface);
-	eth_hdr.dst.addr[5] = 0x55;
-
-	eth_hdr.src.addr[0] = 0xa2;
-	eth_hdr.src.addr[1] = 0x11;
-	eth_hdr.src.addr[2] = 0x22;
-	eth_hdr.src.addr[3] = net_if_get_by_iface(iface);
-	eth_hdr.src.addr[4] = 0x77;
-	eth_hdr.src.addr[5] = 0x88;
+	eth_hdr.dst = *dst;
+	src_addr_get(iface, &eth_hdr.src);
 
 	eth_hdr.type = htons(NET_ETH_PTYPE_ALL);
 
@@ -265,6 +261,21 @@ static void _recv_data(struct net_if *iface)
 	zassert_equal(ret, 0, "");
 }
 
+static void _recv_data(struct net_if *iface)
+{
+	/*
+	 * The source and destination MAC addresses are completely arbitrary
+	 * except for the U/L and I/G bits. However, the index of the faked
+	 * incoming interface is mixed in as well to create some variation,
+	 * and to help with validation on the transmit side.
+	 */
+	struct net_eth_addr dst = {
+		.addr = { 0xb2, 0x11, 0x22, 0x33, net_if_get_by_iface(iface), 0x55 },
+	};
+
+	_recv_data_to(iface, &dst);
+}
+
 static void test_recv_before_bridging(void)
 {
 	/* fake some packet reception */
@@ -352,6 +363,71 @@ static void test_recv_with_bridge(void)
 	check_free_packet_count();
 }
 
+static void check_sent_only_on(struct net_if *iface, const struct net_eth_addr *dst)
+{
+	/* give time to the processing threads to run */
+	k_sleep(K_MSEC(100));
+
+	for (int i = 0; i < 3; i++) {
+		struct net_pkt *pkt = eth_fake_data[i].sent_pkt;
+
+		if (eth_fake_data[i].iface != iface) {
+			zassert_is_null(pkt, "");
+			continue;
+		}
+
+		eth_fake_data[i].sent_pkt = NULL;
+		zassert_not_null(pkt, "");
+		zassert_mem_equal(NET_ETH_HDR(pkt)->dst.addr, dst->addr,
+				  sizeof(dst->addr), "");
+		net_pkt_unref(pkt);
+	}
+}
+
+static void test_recv_with_fdb(void)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	struct net_eth_addr static_addr = {
+		.addr = { 0xb2, 0x11, 0x22, 0x33, 0x44, 0x66 },
+	};
+	struct net_eth_addr dst;
+	uint32_t hits;
+	int ret;
+
+	/* All source addresses were learned by test_recv_with_bridge() */
+	zassert_equal(test_bridge.fdb_stats.learned, 3, "");
+	hits = test_bridge.fdb_stats.hits;
+
+	/* A learned destination is only sent on its port, not flooded */
+	src_addr_get(fake_iface[2], &dst);
+	_recv_data_to(fake_iface[1], &dst);
+	check_sent_only_on(fake_iface[2], &dst);
+
+	/* Nothing is sent back on the port the destination was learned on */
+	_recv_data_to(fake_iface[2], &dst);
+	check_sent_only_on(NULL, &dst);
+
+	/* The same goes for static entries */
+	ret = eth_bridge_fdb_add(&test_bridge, static_addr.addr,
+				 NET_VLAN_TAG_UNSPEC, fake_iface[0]);
+	zassert_equal(ret, 0, "");
+
+	_recv_data_to(fake_iface[1], &static_addr);
+	check_sent_only_on(fake_iface[0], &static_addr);
+
+	zassert_equal(test_bridge.fdb_stats.hits, hits + 3, "");
+
+	ret = eth_bridge_fdb_del(&test_bridge, static_addr.addr,
+				 NET_VLAN_TAG_UNSPEC);
+	zassert_equal(ret, 0, "");
+	ret = eth_bridge_fdb_del(&test_bridge, static_addr.addr,
+				 NET_VLAN_TAG_UNSPEC);
+	zassert_equal(ret, -ENOENT, "");
+
+	check_free_packet_count();
+#endif
+}
+
 static void test_recv_after_bridging(void)
 {
 	int ret;
@@ -374,6 +450,7 @@ ZTEST(net_eth_bridge, test_net_eth_bridge)
 	test_recv_before_bridging();
 	test_setup_bridge();
 	test_recv_with_bridge();
+	test_recv_with_fdb();
 	test_recv_after_bridging();
 }
 
@@ -465,8 +465,40 @@ static struct net_buf frame_buf = {
 	.__buf = frame_buffer_data,
 };
 
-static bool test_fragment(struct net_fragment_data *data)
+static struct net_pkt *rx_frame(struct net_buf *buf)
+{
+	struct net_pkt *rxpkt;
+	struct net_buf *dfrag;
+
+	rxpkt = net_pkt_rx_alloc(K_FOREVER);
+	if (!rxpkt) {
+		return NULL;
+	}
+
+	dfrag = net_pkt_get_frag(rxpkt, buf->len, K_FOREVER);
+	if (!dfrag) {
+		net_pkt_unref(rxpkt);
+		return NULL;
+	}
+
+	memcpy(dfrag->data, buf->data, buf->len);
+	dfrag->len = buf->len;
+
+	net_pkt_frag_add(rxpkt, dfrag);
+
+	net_pkt_set_overwrite(rxpkt, true);
+
+	return rxpkt;
+}
+
+/* With reverse set, fragments are received in reverse order and the first
+ * one received is received twice.
+ */
+static bool test_fragment_order(struct net_fragment_data *data, bool reverse)
 {
+	struct ieee802154_6lo_reass_stats stats_before, stats_after;
+	bool fragmented = false;
+	bool duplicated = false;
 	struct net_pkt *rxpkt = NULL;
 	struct net_pkt *f_pkt = NULL;
 	int result = false;
@@ -493,6 +525,9 @@ static bool test_fragment(struct net_fragment_data *data)
 	}
 
 	if (!ieee802154_6lo_requires_fragmentation(pkt, 0, 0)) {
+		/* As done by the L2 for unfragmented packets */
+		net_pkt_compact(pkt);
+
 		f_pkt = pkt;
 		pkt = NULL;
 
@@ -504,23 +539,37 @@ static bool test_fragment(struct net_fragment_data *data)
 		goto end;
 	}
 
+	fragmented = true;
+
 	ieee802154_6lo_fragment_ctx_init(&ctx, pkt, hdr_diff, data->iphc);
 	frame_buf.len = 0U;
 
 	buf = pkt->buffer;
 	while (buf) {
-		buf = ieee802154_6lo_fragment(&ctx, &frame_buf, data->iphc);
+		struct net_buf *frame = ieee802154_6lo_fragment_in_place(&ctx, &frame_buf,
+									 data->iphc);
+
+		if (frame) {
+			buf = ctx.buf;
+		} else {
+			buf = ieee802154_6lo_fragment(&ctx, &frame_buf, data->iphc);
+			frame = &frame_buf;
+		}
 
-		dfrag = net_pkt_get_frag(f_pkt, frame_buf.len, K_FOREVER);
+		dfrag = net_pkt_get_frag(f_pkt, frame->len, K_FOREVER);
 		if (!dfrag) {
 			goto end;
 		}
 
-		memcpy(dfrag->data, frame_buf.data, frame_buf.len);
-		dfrag->len = frame_buf.len;
+		memcpy(dfrag->data, frame->data, frame->len);
+		dfrag->len = frame->len;
 
 		net_pkt_frag_add(f_pkt, dfrag);
 
+		if (frame != &frame_buf) {
+			net_buf_unref(frame);
+		}
+
 		frame_buf.len = 0U;
 	}
 
@@ -535,38 +584,65 @@ reassemble:
 	net_pkt_hexdump(f_pkt, "after-compression");
 #endif
 
-	buf = f_pkt->buffer;
-	while (buf) {
-		rxpkt = net_pkt_rx_alloc(K_FOREVER);
-		if (!rxpkt) {
-			goto end;
-		}
+	if (reverse) {
+		struct net_buf *prev = NULL, *next;
 
-		dfrag = net_pkt_get_frag(rxpkt, buf->len, K_FOREVER);
-		if (!dfrag) {
-			goto end;
+		for (buf = f_pkt->buffer; buf; buf = next) {
+			next = buf->frags;
+			buf->frags = prev;
+			prev = buf;
 		}
 
-		memcpy(dfrag->data, buf->data, buf->len);
-		dfrag->len = buf->len;
+		f_pkt->buffer = prev;
+	}
 
-		net_pkt_frag_add(rxpkt, dfrag);
+	ieee802154_6lo_reass_stats_get(&stats_before);
 
-		net_pkt_set_overwrite(rxpkt, true);
+	buf = f_pkt->buffer;
+	while (buf) {
+		rxpkt = rx_frame(buf);
+		if (!rxpkt) {
+			goto end;
+		}
 
 		switch (ieee802154_6lo_reassemble(rxpkt)) {
 		case NET_OK:
+			rxpkt = NULL;
+
+			if (reverse && !duplicated) {
+				/* Receive the same fragment again */
+				duplicated = true;
+				break;
+			}
+
 			buf = buf->frags;
 			break;
 		case NET_CONTINUE:
 			goto compare;
 		case NET_DROP:
 			net_pkt_unref(rxpkt);
+			rxpkt = NULL;
+
+			if (duplicated && buf == f_pkt->buffer) {
+				/* The duplicate has been discarded as expected */
+				buf = buf->frags;
+				break;
+			}
+
 			goto end;
 		}
 	}
 
 compare:
+	ieee802154_6lo_reass_stats_get(&stats_after);
+
+	if (fragmented &&
+	    (stats_after.reassembled != stats_before.reassembled + 1U ||
+	     stats_after.duplicates != stats_before.duplicates + (duplicated ? 1U : 0U))) {
+		TC_PRINT("unexpected reassembly statistics\n");
+		goto end;
+	}
+
 #if DEBUG > 0
 	printk("length after reassembly and uncompression %zd\n",
 	       net_pkt_get_len(rxpkt));
@@ -593,6 +669,11 @@ end:
 	return result;
 }
 
+static bool test_fragment(struct net_fragment_data *data)
+{
+	return test_fragment_order(data, false);
+}
+
 ZTEST(ieee802154_6lo_fragment, test_fragment_sam00_dam00)
 {
 	bool ret = test_fragment(&test_data_1);
@@ -656,4 +737,11 @@ ZTEST(ieee802154_6lo_fragment, test_fragment_ipv6_no_fragmentation_after_iphc)
 	zassert_true(ret);
 }
 
+ZTEST(ieee802154_6lo_fragment, test_fragment_out_of_order)
+{
+	bool ret = test_fragment_order(&test_data_3, true);
+
+	zassert_true(ret);
+}
+
 ZTEST_SUITE(ieee802154_6lo_fragment, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_arbiter_test, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_arbiter.h>
+#include <zephyr/net/ieee802154_radio.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include <ieee802154_arbiter.h>
+#include <ieee802154_priv.h>
+
+/* Three devices backed by one fake transceiver, see struct fake_radio. */
+#define IFACE_COUNT 3
+
+struct fake_iface_config {
+	uint16_t channel;
+	uint16_t pan_id;
+	uint32_t latency_budget_ms;
+};
+
+static const struct fake_iface_config configs[IFACE_COUNT] = {
+	{.channel = 11U, .pan_id = 0x1111, .latency_budget_ms = 1000U},
+	{.channel = 15U, .pan_id = 0x2222, .latency_budget_ms = 500U},
+	{.channel = 20U, .pan_id = 0x3333, .latency_budget_ms = 10U},
+};
+
+/* State of the shared transceiver */
+static struct {
+	uint16_t channel;
+	uint16_t pan_id;
+	uint32_t channel_changes;
+	const struct device *tx_dev;
+} fake_radio;
+
+static struct ieee802154_arbiter arbiter;
+
+static struct net_if *ifaces[IFACE_COUNT];
+
+/* 2006 data frame, no ACK requested. */
+static uint8_t data_frame[] = {
+	0x41, 0x88, 0x01, 0xff, 0xff, 0xff, 0xff, 0xaa, 0xbb,
+};
+
+static enum ieee802154_hw_caps fake_get_capabilities(const struct device *dev)
+{
+	return IEEE802154_HW_FCS | IEEE802154_HW_FILTER;
+}
+
+static int fake_cca(const struct device *dev)
+{
+	return 0;
+}
+
+static int fake_set_channel(const struct device *dev, uint16_t channel)
+{
+	if (fake_radio.channel != channel) {
+		fake_radio.channel = channel;
+		fake_radio.channel_changes++;
+	}
+
+	return 0;
+}
+
+static int fake_filter(const struct device *dev, bool set, enum ieee802154_filter_type type,
+		       const struct ieee802154_filter *filter)
+{
+	if (type == IEEE802154_FILTER_TYPE_PAN_ID) {
+		if (set) {
+			fake_radio.pan_id = filter->pan_id;
+		} else if (fake_radio.pan_id == filter->pan_id) {
+			fake_radio.pan_id = IEEE802154_BROADCAST_PAN_ID;
+		}
+	}
+
+	return 0;
+}
+
+static int fake_set_txpower(const struct device *dev, int16_t dbm)
+{
+	return 0;
+}
+
+static int fake_tx(const struct device *dev, enum ieee802154_tx_mode mode, struct net_pkt *pkt,
+		   struct net_buf *frag)
+{
+	fake_radio.tx_dev = dev;
+
+	return 0;
+}
+
+static int fake_start(const struct device *dev)
+{
+	return 0;
+}
+
+static int fake_stop(const struct device *dev)
+{
+	return 0;
+}
+
+IEEE802154_DEFINE_PHY_SUPPORTED_CHANNELS(drv_attr, 11, 26);
+
+static int fake_attr_get(const struct device *dev, enum ieee802154_attr attr,
+			 struct ieee802154_attr_value *value)
+{
+	ARG_UNUSED(dev);
+
+	return ieee802154_attr_get_channel_page_and_range(
+		attr, IEEE802154_ATTR_PHY_CHANNEL_PAGE_ZERO_OQPSK_2450_BPSK_868_915,
+		&drv_attr.phy_supported_channels, value);
+}
+
+static void fake_iface_init(struct net_if *iface)
+{
+	const struct fake_iface_config *config = net_if_get_device(iface)->config;
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	static uint8_t mac[IFACE_COUNT][8];
+	uint8_t idx = config - configs;
+
+	mac[idx][0] = 0x00;
+	mac[idx][7] = idx + 1U;
+	net_if_set_link_addr(iface, mac[idx], sizeof(mac[idx]), NET_LINK_IEEE802154);
+
+	ieee802154_init(iface);
+
+	ctx->channel = config->channel;
+	ctx->pan_id = config->pan_id;
+
+	ifaces[idx] = iface;
+
+	(void)ieee802154_arbiter_attach(&arbiter, iface, config->latency_budget_ms);
+}
+
+static int fake_init(const struct device *dev)
+{
+	return 0;
+}
+
+static struct ieee802154_radio_api fake_radio_api = {
+	.iface_api.init = fake_iface_init,
+
+	.get_capabilities = fake_get_capabilities,
+	.cca = fake_cca,
+	.set_channel = fake_set_channel,
+	.filter = fake_filter,
+	.set_txpower = fake_set_txpower,
+	.start = fake_start,
+	.stop = fake_stop,
+	.tx = fake_tx,
+	.attr_get = fake_attr_get,
+};
+
+#define FAKE_RADIO_INIT(n)                                                                        \
+	NET_DEVICE_INIT(fake_arbiter_##n, "fake_arbiter_" #n, fake_init, NULL, NULL,              \
+			&configs[n], CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fake_radio_api,        \
+			IEEE802154_L2, NET_L2_GET_CTX_TYPE(IEEE802154_L2), IEEE802154_MTU)
+
+FAKE_RADIO_INIT(0);
+FAKE_RADIO_INIT(1);
+FAKE_RADIO_INIT(2);
+
+static int send_frame(struct net_if *iface)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(data_frame), AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Could not allocate packet");
+
+	net_buf_add_mem(pkt->buffer, data_frame, sizeof(data_frame));
+
+	ret = ieee802154_radio_send(iface, pkt, pkt->buffer);
+
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+
+ZTEST(ieee802154_arbiter, test_attach)
+{
+	zassert_equal(ieee802154_arbiter_attach(&arbiter, ifaces[0], 0U), -EALREADY);
+}
+
+ZTEST(ieee802154_arbiter, test_settings_follow_owner)
+{
+	uint32_t changes;
+
+	if (CONFIG_NET_L2_IEEE802154_ARBITER_RX_SLOT > 0) {
+		ztest_test_skip();
+	}
+
+	zassert_ok(send_frame(ifaces[0]));
+	zassert_equal(fake_radio.tx_dev, net_if_get_device(ifaces[0]));
+	zassert_equal(fake_radio.channel, configs[0].channel);
+	zassert_equal(fake_radio.pan_id, configs[0].pan_id);
+	zassert_equal(ieee802154_arbiter_rx_iface(&arbiter), ifaces[0]);
+
+	/* The radio is only reconfigured when it changes hands. */
+	changes = fake_radio.channel_changes;
+	zassert_ok(send_frame(ifaces[0]));
+	zassert_equal(fake_radio.channel_changes, changes);
+
+	zassert_ok(send_frame(ifaces[1]));
+	zassert_equal(fake_radio.channel, configs[1].channel);
+	zassert_equal(fake_radio.pan_id, configs[1].pan_id);
+	zassert_equal(fake_radio.channel_changes, changes + 1U);
+	zassert_equal(ieee802154_arbiter_rx_iface(&arbiter), ifaces[1]);
+}
+
+ZTEST(ieee802154_arbiter, test_timeout)
+{
+	zassert_ok(ieee802154_arbiter_acquire(ifaces[0]));
+
+	/* Nested calls of the owner do not block. */
+	zassert_ok(ieee802154_arbiter_acquire(ifaces[0]));
+	ieee802154_arbiter_release(ifaces[0]);
+
+	zassert_equal(ieee802154_arbiter_acquire(ifaces[1]), -EBUSY);
+	zassert_equal(send_frame(ifaces[1]), -EBUSY);
+
+	ieee802154_arbiter_release(ifaces[0]);
+
+	zassert_ok(send_frame(ifaces[1]));
+}
+
+#define WAITER_STACK_SIZE 1024
+
+K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, 2, WAITER_STACK_SIZE);
+static struct k_thread waiter_threads[2];
+
+static struct net_if *grant_order[2];
+static atomic_t grants;
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	struct net_if *iface = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(ieee802154_arbiter_acquire(iface));
+	grant_order[atomic_inc(&grants)] = iface;
+	ieee802154_arbiter_release(iface);
+}
+
+ZTEST(ieee802154_arbiter, test_earliest_deadline_first)
+{
+	atomic_set(&grants, 0);
+
+	zassert_ok(ieee802154_arbiter_acquire(ifaces[0]));
+
+	/* The interface with the longer latency budget asks first. */
+	for (int i = 0; i < 2; i++) {
+		k_thread_create(&waiter_threads[i], waiter_stacks[i], WAITER_STACK_SIZE, waiter,
+				ifaces[i + 1], NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+		k_sleep(K_MSEC(5));
+	}
+
+	ieee802154_arbiter_release(ifaces[0]);
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(k_thread_join(&waiter_threads[i], K_SECONDS(1)));
+	}
+
+	zassert_equal(atomic_get(&grants), 2);
+	zassert_equal(grant_order[0], ifaces[2], "Earliest deadline not served first");
+	zassert_equal(grant_order[1], ifaces[1]);
+}
+
+ZTEST(ieee802154_arbiter, test_rx_slots)
+{
+	if (CONFIG_NET_L2_IEEE802154_ARBITER_RX_SLOT == 0) {
+		ztest_test_skip();
+	}
+
+	zassert_ok(send_frame(ifaces[0]));
+	zassert_equal(ieee802154_arbiter_rx_iface(&arbiter), ifaces[0]);
+
+	/* The idle receiver visits the other interfaces in turn. */
+	for (int i = 1; i <= IFACE_COUNT; i++) {
+		int idx = i % IFACE_COUNT;
+
+		k_sleep(K_MSEC(CONFIG_NET_L2_IEEE802154_ARBITER_RX_SLOT + 5));
+
+		zassert_equal(ieee802154_arbiter_rx_iface(&arbiter), ifaces[idx]);
+		zassert_equal(fake_radio.channel, configs[idx].channel);
+	}
+}
+
+ZTEST_SUITE(ieee802154_arbiter, NULL, NULL, NULL, NULL, NULL);
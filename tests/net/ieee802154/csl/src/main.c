@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_csl_test, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_csl.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+
+#include <ieee802154_csl.h>
+#include <ieee802154_frame.h>
+#include <ieee802154_utils.h>
+
+#define RX_TIME (10 * NSEC_PER_SEC)
+
+static struct net_if *iface;
+static net_time_t unit;
+
+/* 2015 data frame from 0x0807060504030201 to 0xffff with a CSL IE
+ * (phase 10, period 100) and a Header Termination 1 IE.
+ */
+static uint8_t csl_data_frame[] = {
+	0x41, 0xea, 0x01, 0xcd, 0xab, 0xff, 0xff,
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x04, 0x0d, 0x0a, 0x00, 0x64, 0x00,
+	0x00, 0x3f,
+	0xaa, 0xbb, 0xcc,
+};
+
+/* Enhanced ACK without addresses and a CSL IE (phase 3, period 50). */
+static uint8_t csl_enh_ack[] = {
+	0x02, 0x22, 0x01,
+	0x04, 0x0d, 0x03, 0x00, 0x32, 0x00,
+};
+
+static uint8_t csl_peer_addr[] = {0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01};
+static uint8_t csl_short_addr[] = {0x12, 0x34};
+
+static struct net_pkt *rx_pkt(uint8_t *frame, size_t len, net_time_t timestamp)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Could not allocate packet");
+
+	zassert_ok(net_pkt_write(pkt, frame, len));
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_timestamp_ns(pkt, timestamp);
+
+	return pkt;
+}
+
+static void rx_track(uint8_t *frame, size_t len)
+{
+	struct ieee802154_mpdu mpdu;
+	struct net_pkt *pkt;
+
+	pkt = rx_pkt(frame, len, RX_TIME);
+
+	zassert_true(ieee802154_validate_frame(net_pkt_data(pkt), len, &mpdu),
+		     "Invalid frame");
+	ieee802154_csl_rx_track(iface, pkt, &mpdu);
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(ieee802154_csl, test_receiver_requires_timed_radio)
+{
+	zassert_equal(ieee802154_csl_receiver_start(iface, 0), -EINVAL);
+	zassert_equal(ieee802154_csl_receiver_start(iface, 3125), -ENOTSUP);
+	zassert_equal(ieee802154_csl_receiver_stop(iface), -EALREADY);
+}
+
+ZTEST(ieee802154_csl, test_phase_tracking)
+{
+	struct net_linkaddr dst = {
+		.addr = csl_peer_addr,
+		.len = sizeof(csl_peer_addr),
+	};
+	net_time_t tx_time;
+
+	zassert_equal(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME, &tx_time), -ENOENT);
+
+	rx_track(csl_data_frame, sizeof(csl_data_frame));
+
+	zassert_ok(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME, &tx_time));
+	zassert_equal(tx_time, RX_TIME + 10 * unit);
+
+	zassert_ok(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME + 10 * unit, &tx_time));
+	zassert_equal(tx_time, RX_TIME + 10 * unit, "Rendezvous time is acceptable");
+
+	zassert_ok(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME + 10 * unit + 1,
+						  &tx_time));
+	zassert_equal(tx_time, RX_TIME + 110 * unit, "Next CSL period expected");
+
+	zassert_ok(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME + 1000 * unit, &tx_time));
+	zassert_equal(tx_time, RX_TIME + 1010 * unit);
+
+	/* A zero CSL period stops the tracking. */
+	csl_data_frame[19] = 0x00;
+	rx_track(csl_data_frame, sizeof(csl_data_frame));
+	csl_data_frame[19] = 0x64;
+
+	zassert_equal(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME, &tx_time), -ENOENT);
+}
+
+ZTEST(ieee802154_csl, test_enh_ack_tracking)
+{
+	struct net_linkaddr dst = {
+		.addr = csl_short_addr,
+		.len = sizeof(csl_short_addr),
+	};
+	struct net_pkt *pkt, *ack;
+	net_time_t tx_time;
+
+	pkt = net_pkt_alloc_with_buffer(iface, 1, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Could not allocate packet");
+	*net_pkt_lladdr_dst(pkt) = dst;
+
+	/* Unknown CSL receivers are left to the regular channel access. */
+	zassert_equal(ieee802154_csl_send(iface, pkt, pkt->buffer), -ENOENT);
+
+	/* The ACK is attributed to the destination of the last frame. */
+	ack = rx_pkt(csl_enh_ack, sizeof(csl_enh_ack), RX_TIME);
+	ieee802154_csl_handle_ack(iface, ack);
+	net_pkt_unref(ack);
+
+	zassert_ok(ieee802154_csl_next_rendezvous(iface, &dst, RX_TIME + 4 * unit, &tx_time));
+	zassert_equal(tx_time, RX_TIME + 53 * unit);
+
+	net_pkt_unref(pkt);
+}
+
+static void *test_setup(void)
+{
+	struct ieee802154_context *ctx;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(IEEE802154));
+	zassert_not_null(iface, "IEEE 802.15.4 interface not found");
+
+	ctx = net_if_l2_data(iface);
+	unit = ieee802154_radio_get_multiple_of_symbol_period(iface, ctx->channel, 10);
+	zassert_true(unit > 0, "Unknown symbol period");
+
+	return NULL;
+}
+
+ZTEST_SUITE(ieee802154_csl, NULL, test_setup, NULL, NULL, NULL);
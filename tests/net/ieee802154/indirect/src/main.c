@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_indirect_test, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_indirect.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+
+#include <ieee802154_frame.h>
+#include <ieee802154_priv.h>
+
+#define COORD_PAN_ID     0xabcd
+#define COORD_SHORT_ADDR 0x0001
+
+extern struct net_pkt *current_pkt;
+extern struct k_sem driver_lock;
+
+static struct net_if *iface;
+
+static uint8_t child_addr_be[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+/* 2006 data frame from the coordinator to the child, no ACK requested. */
+static uint8_t data_frame[] = {
+	0x41, 0x9c, 0x05, 0xcd, 0xab,
+	0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+	0x01, 0x00,
+	0xaa, 0xbb, 0xcc,
+};
+
+/* 2006 Data Request command from the child to the coordinator. */
+static uint8_t data_request[] = {
+	0x63, 0xd8, 0x21, 0xcd, 0xab, 0x01, 0x00,
+	0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+	0x04,
+};
+
+static const struct net_linkaddr child = {
+	.addr = child_addr_be,
+	.len = sizeof(child_addr_be),
+};
+
+static int queue_frame(void)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(data_frame), AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Could not allocate packet");
+
+	net_buf_add_mem(pkt->buffer, data_frame, sizeof(data_frame));
+	*net_pkt_lladdr_dst(pkt) = child;
+
+	ret = ieee802154_radio_send(iface, pkt, pkt->buffer);
+
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+
+static void rx_data_request(void)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(data_request), AF_UNSPEC, 0, K_FOREVER);
+	zassert_not_null(pkt, "Could not allocate packet");
+
+	net_buf_add_mem(pkt->buffer, data_request, sizeof(data_request));
+	zassert_ok(net_recv_data(iface, pkt));
+}
+
+static struct ieee802154_fcf_seq *sent_frame(int index)
+{
+	struct net_buf *frag = current_pkt->frags;
+
+	while (frag && index--) {
+		frag = frag->frags;
+	}
+
+	zassert_not_null(frag, "Frame was not sent");
+
+	return (struct ieee802154_fcf_seq *)frag->data;
+}
+
+/* Polls and checks the Frame Pending fields of the ACK and, if a frame is
+ * expected, of the frame sent in response.
+ */
+static void poll(bool ack_pending, bool expect_frame, bool frame_pending)
+{
+	struct ieee802154_fcf_seq *fs;
+
+	rx_data_request();
+
+	zassert_ok(k_sem_take(&driver_lock, K_SECONDS(1)), "Data request not acknowledged");
+
+	if (expect_frame) {
+		zassert_ok(k_sem_take(&driver_lock, K_SECONDS(1)), "Queued frame not sent");
+	} else {
+		zassert_not_equal(k_sem_take(&driver_lock, K_MSEC(100)), 0, "Unexpected frame");
+	}
+
+	fs = sent_frame(0);
+	zassert_equal(fs->fc.frame_type, IEEE802154_FRAME_TYPE_ACK);
+	zassert_equal(fs->fc.frame_pending, ack_pending, "Unexpected ACK frame pending field");
+
+	if (expect_frame) {
+		fs = sent_frame(1);
+		zassert_equal(fs->fc.frame_type, IEEE802154_FRAME_TYPE_DATA);
+		zassert_equal(fs->fc.frame_pending, frame_pending,
+			      "Unexpected frame pending field");
+	}
+
+	net_pkt_frag_unref(current_pkt->frags);
+	current_pkt->frags = NULL;
+}
+
+ZTEST(ieee802154_indirect, test_child_table)
+{
+	struct net_linkaddr invalid = {
+		.addr = child_addr_be,
+		.len = 3,
+	};
+
+	zassert_equal(ieee802154_indirect_child_add(iface, &invalid), -EINVAL);
+	zassert_equal(ieee802154_indirect_child_remove(iface, &child), -ENOENT);
+
+	zassert_ok(ieee802154_indirect_child_add(iface, &child));
+	zassert_equal(ieee802154_indirect_child_add(iface, &child), -EALREADY);
+	zassert_ok(ieee802154_indirect_child_remove(iface, &child));
+	zassert_equal(ieee802154_indirect_child_remove(iface, &child), -ENOENT);
+}
+
+ZTEST(ieee802154_indirect, test_poll)
+{
+	zassert_ok(ieee802154_indirect_child_add(iface, &child));
+
+	zassert_ok(queue_frame());
+	zassert_ok(queue_frame());
+	zassert_equal(queue_frame(), -ENOBUFS, "Queue depth exceeded");
+	zassert_not_equal(k_sem_take(&driver_lock, K_NO_WAIT), 0, "Frame sent directly");
+
+	poll(true, true, true);
+	poll(true, true, false);
+	poll(false, false, false);
+
+	zassert_ok(ieee802154_indirect_child_remove(iface, &child));
+}
+
+ZTEST(ieee802154_indirect, test_transaction_persistence)
+{
+	zassert_ok(ieee802154_indirect_child_add(iface, &child));
+
+	zassert_ok(queue_frame());
+	k_sleep(K_MSEC(2 * CONFIG_NET_L2_IEEE802154_INDIRECT_PERSISTENCE_TIME));
+
+	poll(false, false, false);
+
+	zassert_ok(ieee802154_indirect_child_remove(iface, &child));
+}
+
+static void *test_setup(void)
+{
+	struct ieee802154_context *ctx;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(IEEE802154));
+	zassert_not_null(iface, "IEEE 802.15.4 interface not found");
+
+	ctx = net_if_l2_data(iface);
+	ctx->pan_id = COORD_PAN_ID;
+	ctx->short_addr = COORD_SHORT_ADDR;
+
+	current_pkt = net_pkt_rx_alloc(K_FOREVER);
+	zassert_not_null(current_pkt, "Could not allocate packet");
+
+	k_sem_reset(&driver_lock);
+
+	return NULL;
+}
+
+ZTEST_SUITE(ieee802154_indirect, NULL, test_setup, NULL, NULL, NULL);
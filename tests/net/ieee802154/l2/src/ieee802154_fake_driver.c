@@ -26,7 +26,7 @@ uint8_t mock_ext_addr_be[8] = {0x00, 0x12, 0x4b, 0x00, 0x00, 0x9e, 0xa3, 0xc2};
 
 static enum ieee802154_hw_caps fake_get_capabilities(const struct device *dev)
 {
-	return IEEE802154_HW_FCS;
+	return IEEE802154_HW_FCS | IEEE802154_HW_ENERGY_SCAN;
 }
 
 static int fake_cca(const struct device *dev)
@@ -34,6 +34,14 @@ static int fake_cca(const struct device *dev)
 	return 0;
 }
 
+static int fake_ed_scan(const struct device *dev, uint16_t duration,
+			energy_scan_done_cb_t done_cb)
+{
+	done_cb(dev, -60);
+
+	return 0;
+}
+
 static int fake_set_channel(const struct device *dev, uint16_t channel)
 {
 	NET_INFO("Channel %u", channel);
@@ -161,6 +169,7 @@ static struct ieee802154_radio_api fake_radio_api = {
 
 	.get_capabilities	= fake_get_capabilities,
 	.cca			= fake_cca,
+	.ed_scan		= fake_ed_scan,
 	.set_channel		= fake_set_channel,
 	.set_txpower		= fake_set_txpower,
 	.start			= fake_start,
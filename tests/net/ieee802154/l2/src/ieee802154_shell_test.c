@@ -66,6 +66,22 @@ static void scan_result_cb(struct net_mgmt_event_callback *cb, uint32_t mgmt_eve
 	k_sem_give(&scan_lock);
 }
 
+static int energy_scan_results;
+
+static void energy_scan_result_cb(struct net_mgmt_event_callback *cb, uint32_t mgmt_event,
+				  struct net_if *iface)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	struct ieee802154_req_params *scan_ctx = ctx->scan_ctx;
+
+	zassert_not_null(scan_ctx);
+	zassert_equal(scan_ctx->channel, energy_scan_results == 0 ? 11U : 12U,
+		      "Energy scan: unexpected channel.");
+	zassert_equal(scan_ctx->energy_level, -60, "Energy scan: unexpected energy level.");
+
+	energy_scan_results++;
+}
+
 static void test_beacon_request(struct ieee802154_mpdu *mpdu)
 {
 	struct ieee802154_command *cmd = mpdu->command;
@@ -122,6 +138,7 @@ static void test_disassociation_notification(struct ieee802154_mpdu *mpdu)
 static void test_scan_shell_cmd(void)
 {
 	struct ieee802154_mpdu mpdu = {0};
+	int64_t start = k_uptime_get();
 	int ret;
 
 	/* The beacon placed into the RX queue will be received and handled as
@@ -132,6 +149,11 @@ static void test_scan_shell_cmd(void)
 
 	zassert_equal(0, k_sem_take(&scan_lock, K_NO_WAIT), "Active scan: did not receive beacon.");
 
+	if (CONFIG_NET_L2_IEEE802154_SCAN_QUIET_TIME > 0) {
+		zassert_true(k_uptime_get() - start < 500,
+			     "Active scan: dwell not shortened after the beacon.");
+	}
+
 	zassert_not_null(current_pkt);
 
 	if (!ieee802154_validate_frame(net_pkt_data(current_pkt), net_pkt_get_len(current_pkt),
@@ -233,6 +255,23 @@ fail:
 	ztest_test_fail();
 }
 
+ZTEST(ieee802154_l2_shell, test_energy_scan)
+{
+	int ret;
+
+	energy_scan_results = 0;
+
+	net_mgmt_init_event_callback(&scan_cb, energy_scan_result_cb,
+				     NET_EVENT_IEEE802154_SCAN_RESULT);
+	net_mgmt_add_event_callback(&scan_cb);
+
+	ret = shell_execute_cmd(NULL, "ieee802154 scan energy 11:12 10");
+	zassert_equal(0, ret, "Energy scan failed: %d", ret);
+	zassert_equal(energy_scan_results, 2, "Energy scan: expected one result per channel.");
+
+	net_mgmt_del_event_callback(&scan_cb);
+}
+
 ZTEST(ieee802154_l2_shell, test_associate)
 {
 	uint8_t coord_addr_le[] = {EXPECTED_COORDINATOR_ADDR_LE};
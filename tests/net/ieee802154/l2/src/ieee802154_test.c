@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_ieee802154_test, LOG_LEVEL_DBG);
 #include <zephyr/crypto/crypto.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_link_quality.h>
 #include <zephyr/net/ieee802154_mgmt.h>
 #include <zephyr/net/ieee802154_radio.h>
 #include <zephyr/net/net_core.h>
@@ -38,6 +39,7 @@ struct ieee802154_pkt_test {
 		struct ieee802154_fcf_seq *fc_seq;
 		struct ieee802154_address_field *dst_addr;
 		struct ieee802154_address_field *src_addr;
+		struct ieee802154_header_ie *header_ie;
 	} mhr_check;
 };
 
@@ -146,6 +148,33 @@ struct ieee802154_pkt_test test_sec_data_pkt = {
 		.src_addr = (struct ieee802154_address_field *)(sec_data_pkt + 7),
 	}};
 
+uint8_t ie_data_pkt[] = {
+	0x41, 0xea, /* FCF (2015 frame version, IE present) */
+	0x45, /* Sequence Number */
+	0xcd, 0xab, /* Destination PAN */
+	0xff, 0xff, /* Destination Address */
+	0xc2, 0xa3, 0x9e, 0x00, 0x00, 0x4b, 0x12, 0x00, /* Source Address */
+	0x04, 0x0d, /* CSL IE */
+	0x10, 0x00, 0x20, 0x00, /* CSL Phase and Period */
+	0x80, 0x3f, /* Header Termination 2 IE */
+	0x7b, 0x09, 0x3a, /* Payload */
+};
+
+struct ieee802154_pkt_test test_ie_data_pkt = {
+	.name = "Data frame with header IEs",
+	.sequence = 69U,
+	.pkt = ie_data_pkt,
+	.length = sizeof(ie_data_pkt),
+	.payload_length = 3U,
+	.mhr_check = {
+		.fc_seq = (struct ieee802154_fcf_seq *)ie_data_pkt,
+		.dst_addr = (struct ieee802154_address_field *)(ie_data_pkt + 3),
+		.src_addr = (struct ieee802154_address_field *)(ie_data_pkt + 7),
+		.header_ie = (struct ieee802154_header_ie *)(ie_data_pkt + 15),
+	}};
+
+#define PARSING_BENCHMARK_ROUNDS 1000
+
 /* Construct raw packet payload, length and FCS gets added in the radio driver,
  * see https://github.com/linux-wpan/wpan-tools/blob/master/examples/af_packet_tx.c
  */
@@ -442,7 +471,8 @@ static bool test_packet_parsing(struct ieee802154_pkt_test *t)
 
 	if (mpdu.mhr.fs != t->mhr_check.fc_seq ||
 	    mpdu.mhr.dst_addr != t->mhr_check.dst_addr ||
-	    mpdu.mhr.src_addr != t->mhr_check.src_addr) {
+	    mpdu.mhr.src_addr != t->mhr_check.src_addr ||
+	    mpdu.mhr.header_ie != t->mhr_check.header_ie) {
 		NET_INFO("d: %p vs %p -- s: %p vs %p",
 			 mpdu.mhr.dst_addr, t->mhr_check.dst_addr,
 			 mpdu.mhr.src_addr, t->mhr_check.src_addr);
@@ -464,6 +494,64 @@ static bool test_packet_parsing(struct ieee802154_pkt_test *t)
 	return true;
 }
 
+static bool test_packet_parsing_benchmark(void)
+{
+	struct ieee802154_pkt_test *tests[] = {
+		&test_ns_pkt, &test_ack_pkt, &test_beacon_pkt, &test_sec_data_pkt,
+		&test_ie_data_pkt,
+	};
+	struct ieee802154_mpdu cached_mpdu;
+	struct ieee802154_mpdu mpdu;
+	struct net_pkt *pkt;
+	uint32_t cycles;
+
+	ARRAY_FOR_EACH_PTR(tests, t) {
+		pkt = net_pkt_rx_alloc_with_buffer(net_iface, (*t)->length, AF_UNSPEC, 0,
+						   K_NO_WAIT);
+		if (!pkt) {
+			NET_ERR("*** No buffer to allocate");
+			return false;
+		}
+
+		net_buf_add_mem(pkt->buffer, (*t)->pkt, (*t)->length);
+
+		cycles = k_cycle_get_32();
+
+		for (int i = 0; i < PARSING_BENCHMARK_ROUNDS; i++) {
+			if (!ieee802154_parse_frame(pkt, &mpdu)) {
+				NET_ERR("*** Could not parse frame %s", (*t)->name);
+				goto release_pkt;
+			}
+		}
+
+		cycles = k_cycle_get_32() - cycles;
+
+		NET_INFO("- Parsing frame %s: %u cycles", (*t)->name,
+			 cycles / PARSING_BENCHMARK_ROUNDS);
+
+		/* Later RX stages must see the same MPDU without parsing again. */
+		if (!ieee802154_get_parsed_frame(pkt, &cached_mpdu) ||
+		    cached_mpdu.mhr.fs != mpdu.mhr.fs ||
+		    cached_mpdu.mhr.dst_addr != mpdu.mhr.dst_addr ||
+		    cached_mpdu.mhr.src_addr != mpdu.mhr.src_addr ||
+		    cached_mpdu.mhr.header_ie != mpdu.mhr.header_ie ||
+		    cached_mpdu.mhr.header_ie_length != mpdu.mhr.header_ie_length ||
+		    cached_mpdu.payload != mpdu.payload ||
+		    cached_mpdu.payload_length != mpdu.payload_length) {
+			NET_ERR("*** Wrong cached MPDU information on frame %s", (*t)->name);
+			goto release_pkt;
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	return true;
+
+release_pkt:
+	net_pkt_unref(pkt);
+	return false;
+}
+
 static bool test_ns_sending(struct ieee802154_pkt_test *t, bool with_short_addr)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(net_iface);
@@ -1332,6 +1420,24 @@ ZTEST(ieee802154_l2, test_parsing_sec_data_pkt)
 	zassert_true(ret, "Secured data frame parsed");
 }
 
+ZTEST(ieee802154_l2, test_parsing_ie_data_pkt)
+{
+	bool ret;
+
+	ret = test_packet_parsing(&test_ie_data_pkt);
+
+	zassert_true(ret, "Data frame with header IEs parsed");
+}
+
+ZTEST(ieee802154_l2, test_parsing_benchmark)
+{
+	bool ret;
+
+	ret = test_packet_parsing_benchmark();
+
+	zassert_true(ret, "Frames parsed and MPDU cached in the packet");
+}
+
 ZTEST(ieee802154_l2, test_clone_cb)
 {
 	bool ret;
@@ -1351,6 +1457,52 @@ ZTEST(ieee802154_l2, test_convert_rssi)
 			  "normalized value.");
 }
 
+#ifdef CONFIG_NET_L2_IEEE802154_LINK_QUALITY
+static void copy_channel(const struct ieee802154_channel_quality *quality, void *user_data)
+{
+	struct ieee802154_channel_quality *channel = user_data;
+
+	*channel = *quality;
+}
+
+ZTEST(ieee802154_l2, test_link_quality)
+{
+	uint8_t dst_short_addr[] = {0x56, 0x78}; /* in big endian */
+	struct net_linkaddr dst = {
+		.addr = dst_short_addr,
+		.len = sizeof(dst_short_addr),
+	};
+	struct ieee802154_channel_quality channel = {0};
+	struct ieee802154_neighbor_quality quality;
+	struct net_pkt *pkt;
+
+	zassert_equal(ieee802154_neighbor_quality_get(net_iface, &dst, &quality), -ENOENT);
+
+	pkt = get_data_pkt_with_ar();
+	zassert_not_null(pkt, "Could not allocate packet");
+	*net_pkt_lladdr_dst(pkt) = dst;
+
+	zassert_ok(ieee802154_radio_send(net_iface, pkt, pkt->buffer));
+	zassert_ok(k_sem_take(&driver_lock, K_SECONDS(1)));
+
+	net_pkt_frag_unref(current_pkt->frags);
+	current_pkt->frags = NULL;
+	net_pkt_unref(pkt);
+
+	/* The fake driver acknowledges every frame at the first attempt. */
+	zassert_ok(ieee802154_neighbor_quality_get(net_iface, &dst, &quality));
+	zassert_equal(quality.etx, IEEE802154_ETX_DIVISOR, "Unexpected ETX");
+	zassert_equal(quality.tx, 1U);
+	zassert_equal(quality.tx_failed, 0U);
+
+	/* The fake driver always finds the channel clear. */
+	ieee802154_channel_quality_foreach(net_iface, copy_channel, &channel);
+	zassert_true(channel.cca > 0U, "No CCA recorded");
+	zassert_equal(channel.cca_busy, 0U);
+	zassert_equal(channel.busy, 0U);
+}
+#endif /* CONFIG_NET_L2_IEEE802154_LINK_QUALITY */
+
 ZTEST_SUITE(ieee802154_l2, NULL, test_setup, NULL, NULL, test_teardown);
 
 #ifdef CONFIG_NET_SOCKETS
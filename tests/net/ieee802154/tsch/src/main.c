@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_ieee802154_tsch_test, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ieee802154.h>
+#include <zephyr/net/ieee802154_tsch.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+
+#include <ieee802154_tsch.h>
+
+static struct net_if *iface;
+
+static void add_link(uint16_t handle, uint8_t sf_handle, uint16_t timeslot,
+		     uint16_t channel_offset, uint8_t options)
+{
+	struct ieee802154_tsch_link link = {
+		.handle = handle,
+		.slotframe_handle = sf_handle,
+		.timeslot = timeslot,
+		.channel_offset = channel_offset,
+		.options = options,
+	};
+
+	zassert_ok(ieee802154_tsch_link_add(iface, &link), "Could not add link %u", handle);
+}
+
+ZTEST(ieee802154_tsch, test_schedule_tables)
+{
+	struct ieee802154_tsch_link link = {
+		.slotframe_handle = 0,
+		.options = IEEE802154_TSCH_LINK_OPTION_TX,
+	};
+
+	zassert_equal(ieee802154_tsch_slotframe_add(iface, 0, 0), -EINVAL);
+	zassert_ok(ieee802154_tsch_slotframe_add(iface, 0, 7));
+	zassert_equal(ieee802154_tsch_slotframe_add(iface, 0, 7), -EEXIST);
+	zassert_ok(ieee802154_tsch_slotframe_add(iface, 1, 3));
+	zassert_equal(ieee802154_tsch_slotframe_add(iface, 2, 3), -ENOMEM);
+
+	link.timeslot = 7;
+	zassert_equal(ieee802154_tsch_link_add(iface, &link), -EINVAL, "Timeslot out of range");
+
+	link.timeslot = 1;
+	link.slotframe_handle = 5;
+	zassert_equal(ieee802154_tsch_link_add(iface, &link), -ENOENT);
+
+	link.slotframe_handle = 0;
+	link.options = 0;
+	zassert_equal(ieee802154_tsch_link_add(iface, &link), -EINVAL, "Link without options");
+
+	link.options = IEEE802154_TSCH_LINK_OPTION_TX;
+	zassert_ok(ieee802154_tsch_link_add(iface, &link));
+	zassert_equal(ieee802154_tsch_link_add(iface, &link), -EEXIST);
+
+	zassert_ok(ieee802154_tsch_link_remove(iface, link.handle));
+	zassert_equal(ieee802154_tsch_link_remove(iface, link.handle), -ENOENT);
+
+	zassert_ok(ieee802154_tsch_slotframe_remove(iface, 1));
+	zassert_equal(ieee802154_tsch_slotframe_remove(iface, 1), -ENOENT);
+}
+
+ZTEST(ieee802154_tsch, test_next_link)
+{
+	struct ieee802154_tsch_link link;
+	uint64_t asn;
+
+	zassert_false(ieee802154_tsch_next_link(0, &asn, &link), "Empty schedule");
+
+	zassert_ok(ieee802154_tsch_slotframe_add(iface, 0, 7));
+	zassert_ok(ieee802154_tsch_slotframe_add(iface, 1, 3));
+	add_link(10, 0, 2, 0, IEEE802154_TSCH_LINK_OPTION_TX);
+	add_link(11, 1, 2, 1, IEEE802154_TSCH_LINK_OPTION_RX);
+
+	zassert_true(ieee802154_tsch_next_link(0, &asn, &link));
+	zassert_equal(asn, 2);
+	zassert_equal(link.handle, 10, "Lower slotframe handle takes precedence");
+
+	zassert_true(ieee802154_tsch_next_link(3, &asn, &link));
+	zassert_equal(asn, 5);
+	zassert_equal(link.handle, 11);
+
+	zassert_true(ieee802154_tsch_next_link(6, &asn, &link));
+	zassert_equal(asn, 8);
+	zassert_equal(link.handle, 11);
+
+	zassert_true(ieee802154_tsch_next_link(9, &asn, &link));
+	zassert_equal(asn, 9);
+	zassert_equal(link.handle, 10);
+}
+
+ZTEST(ieee802154_tsch, test_channel_hopping)
+{
+	static const uint16_t channels[] = {11, 15, 20, 25};
+
+	zassert_equal(ieee802154_tsch_set_hopping_sequence(iface, channels, 0), -EINVAL);
+	zassert_ok(ieee802154_tsch_set_hopping_sequence(iface, channels, ARRAY_SIZE(channels)));
+
+	zassert_equal(ieee802154_tsch_channel(0, 0), 11);
+	zassert_equal(ieee802154_tsch_channel(1, 0), 15);
+	zassert_equal(ieee802154_tsch_channel(1, 2), 25);
+	zassert_equal(ieee802154_tsch_channel(1001, 1), 20);
+}
+
+ZTEST(ieee802154_tsch, test_eb_round_trip)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	static struct ieee802154_tsch_eb eb;
+	struct net_pkt *pkt;
+	int ret;
+
+	zassert_ok(ieee802154_tsch_slotframe_add(iface, 0, 101));
+	add_link(0, 0, 0, 0,
+		 IEEE802154_TSCH_LINK_OPTION_TX | IEEE802154_TSCH_LINK_OPTION_RX |
+			 IEEE802154_TSCH_LINK_OPTION_SHARED);
+	add_link(1, 0, 50, 3, IEEE802154_TSCH_LINK_OPTION_RX);
+
+	/* Dedicated links are not advertised. */
+	{
+		struct ieee802154_tsch_link link = {
+			.handle = 2,
+			.timeslot = 60,
+			.options = IEEE802154_TSCH_LINK_OPTION_TX,
+			.node_addr_len = IEEE802154_SHORT_ADDR_LENGTH,
+		};
+
+		zassert_ok(ieee802154_tsch_link_add(iface, &link));
+	}
+
+	pkt = net_pkt_alloc_with_buffer(iface, IEEE802154_MTU, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Could not allocate packet");
+
+	ctx->pan_id = 0xabcd;
+	ret = ieee802154_tsch_write_eb(iface, pkt->buffer, 0x123456789aULL);
+	zassert_ok(ret, "Could not write EB");
+
+	ret = ieee802154_tsch_parse_eb(pkt->buffer->data, pkt->buffer->len, &eb);
+	zassert_ok(ret, "Could not parse EB");
+
+	zassert_equal(eb.asn, 0x123456789aULL);
+	zassert_equal(eb.join_metric, 0);
+	zassert_equal(eb.pan_id, 0xabcd);
+	zassert_mem_equal(eb.src_addr, ctx->ext_addr, IEEE802154_EXT_ADDR_LENGTH);
+	zassert_equal(eb.num_links, 2);
+
+	for (uint8_t i = 0; i < eb.num_links; i++) {
+		zassert_equal(eb.slotframe_size[i], 101);
+		zassert_equal(eb.links[i].slotframe_handle, 0);
+	}
+
+	zassert_equal(eb.links[0].timeslot, 0);
+	zassert_equal(eb.links[0].options,
+		      IEEE802154_TSCH_LINK_OPTION_TX | IEEE802154_TSCH_LINK_OPTION_RX |
+			      IEEE802154_TSCH_LINK_OPTION_SHARED);
+	zassert_equal(eb.links[1].timeslot, 50);
+	zassert_equal(eb.links[1].channel_offset, 3);
+
+	/* Truncated frames must be rejected. */
+	ret = ieee802154_tsch_parse_eb(pkt->buffer->data, pkt->buffer->len - 1, &eb);
+	zassert_equal(ret, -EINVAL);
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(ieee802154_tsch, test_start_requires_timed_radio)
+{
+	zassert_equal(ieee802154_tsch_start(iface, true), -ENOTSUP);
+	zassert_false(ieee802154_tsch_is_synchronized(iface));
+	zassert_equal(ieee802154_tsch_stop(iface), -EALREADY);
+}
+
+static void *test_setup(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(IEEE802154));
+	zassert_not_null(iface, "IEEE 802.15.4 interface not found");
+
+	return NULL;
+}
+
+static void test_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Removing a slotframe removes its links as well. */
+	(void)ieee802154_tsch_slotframe_remove(iface, 0);
+	(void)ieee802154_tsch_slotframe_remove(iface, 1);
+}
+
+ZTEST_SUITE(ieee802154_tsch, NULL, test_setup, NULL, test_after, NULL);
@@ -1332,4 +1332,72 @@ ZTEST(net_iface, test_interface_name)
 #endif
 }
 
+#if defined(CONFIG_NET_NAPI)
+#define NAPI_TEST_BUDGET 4
+#define NAPI_TEST_FRAMES 10
+
+static struct net_napi test_napi;
+static int napi_pending;
+static int napi_polls;
+static K_SEM_DEFINE(napi_done, 0, 1);
+
+static int napi_test_poll(struct net_napi *napi, int budget)
+{
+	static uint8_t data[] = { 'n', 'a', 'p', 'i' };
+	struct net_pkt *pkt;
+	int done = 0;
+
+	napi_polls++;
+
+	while (done < budget && napi_pending > 0) {
+		pkt = net_pkt_rx_alloc_with_buffer(iface1, sizeof(data), AF_UNSPEC,
+						   0, K_MSEC(WAIT_TIME));
+		if (!pkt) {
+			break;
+		}
+
+		net_pkt_write(pkt, data, sizeof(data));
+		net_pkt_cursor_init(pkt);
+
+		net_napi_receive(napi, pkt);
+
+		napi_pending--;
+		done++;
+	}
+
+	if (done < budget) {
+		net_napi_complete(napi);
+		k_sem_give(&napi_done);
+	}
+
+	return done;
+}
+#endif /* CONFIG_NET_NAPI */
+
+ZTEST(net_iface, test_napi_poll)
+{
+#if defined(CONFIG_NET_NAPI)
+	net_napi_init(&test_napi, napi_test_poll, NAPI_TEST_BUDGET);
+
+	napi_pending = NAPI_TEST_FRAMES;
+	napi_polls = 0;
+
+	zassert_true(net_napi_schedule(&test_napi), "First schedule should succeed");
+	zassert_false(net_napi_schedule(&test_napi), "Already scheduled");
+
+	zassert_ok(k_sem_take(&napi_done, K_MSEC(WAIT_TIME * 10)),
+		   "Poll did not complete");
+	zassert_equal(napi_pending, 0, "Frames left (%d)", napi_pending);
+
+	/* 4 + 4 + 2 frames, the last run is under budget and completes */
+	zassert_equal(napi_polls, 3, "Unexpected poll count (%d)", napi_polls);
+
+	zassert_true(net_napi_schedule(&test_napi), "Completed context should reschedule");
+	zassert_ok(k_sem_take(&napi_done, K_MSEC(WAIT_TIME * 10)),
+		   "Empty poll did not complete");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_iface, NULL, iface_setup, NULL, NULL, iface_teardown);
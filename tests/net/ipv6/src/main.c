@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "icmpv6.h"
 #include "ipv6.h"
 #include "route.h"
+#include "pmtu.h"
 
 #include "udp_internal.h"
 
@@ -287,6 +288,53 @@ static void inject_na_message(struct net_if *iface, struct in6_addr *src,
 	zassert_ok((net_recv_data(iface, pkt)), "Data receive for NA failed.");
 }
 
+static void inject_ptb_message(struct net_if *iface, uint32_t mtu,
+			       struct in6_addr *orig_src,
+			       struct in6_addr *orig_dst)
+{
+	struct net_ipv6_hdr orig_hdr = {
+		.vtc = 0x60,
+		.nexthdr = IPPROTO_UDP,
+		.hop_limit = 64,
+		.len = htons(1400),
+	};
+	struct net_eth_hdr hdr;
+	struct net_pkt *pkt;
+
+	net_ipv6_addr_copy_raw(orig_hdr.src, (uint8_t *)orig_src);
+	net_ipv6_addr_copy_raw(orig_hdr.dst, (uint8_t *)orig_dst);
+
+	pkt = net_pkt_alloc_with_buffer(iface, TEST_MSG_SIZE, AF_INET6,
+					IPPROTO_ICMPV6, K_NO_WAIT);
+	zassert_not_null(pkt, "Failed to allocate packet");
+
+	hdr.type = htons(NET_ETH_PTYPE_IPV6);
+	memset(&hdr.src, 0xaa, sizeof(struct net_eth_addr));
+	memcpy(&hdr.dst, net_pkt_iface(pkt)->if_dev->link_addr.addr,
+	       sizeof(struct net_eth_addr));
+
+	/* Reserve space for the L2 header. */
+	net_buf_reserve(pkt->frags, sizeof(struct net_eth_hdr));
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, false);
+
+	zassert_ok(net_ipv6_create(pkt, &peer_addr, &my_addr));
+	zassert_ok(net_icmpv6_create(pkt, NET_ICMPV6_PACKET_TOO_BIG, 0));
+	zassert_ok(net_pkt_write_be32(pkt, mtu));
+	zassert_ok(net_pkt_write(pkt, &orig_hdr, sizeof(orig_hdr)));
+
+	net_pkt_cursor_init(pkt);
+	net_ipv6_finalize(pkt, IPPROTO_ICMPV6);
+
+	/* Fill L2 header. */
+	net_buf_push_mem(pkt->frags, &hdr, sizeof(struct net_eth_hdr));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok((net_recv_data(iface, pkt)), "Data receive for PTB failed.");
+
+	k_sleep(K_MSEC(10));
+}
+
 static void skip_headers(struct net_pkt *pkt)
 {
 	net_pkt_cursor_init(pkt);
@@ -1393,6 +1441,82 @@ ZTEST(net_ipv6, test_address_lifetime)
 	zassert_true(ret, "Address with lifetime cannot be removed");
 }
 
+ZTEST(net_ipv6, test_src_addr_selection_cache)
+{
+	struct in6_addr addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0x30, 0x1 } } };
+	struct in6_addr dst = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				    0, 0, 0, 0, 0, 0, 0x30, 0x2 } } };
+	struct net_if *iface = TEST_NET_IF;
+	const struct in6_addr *src;
+	struct net_if_addr *ifaddr;
+	bool ret;
+
+	src = net_if_ipv6_select_src_addr(iface, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &my_addr), "Wrong source address");
+
+	/* Selected again, possibly from the cache */
+	src = net_if_ipv6_select_src_addr(iface, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &my_addr), "Wrong source address");
+
+	/* A better matching address must be selected once it is usable */
+	ifaddr = net_if_ipv6_addr_add(iface, &addr, NET_ADDR_AUTOCONF, FIFTY_DAYS);
+	zassert_not_null(ifaddr, "Cannot add address");
+
+	net_if_ipv6_addr_update_lifetime(ifaddr, FIFTY_DAYS);
+
+	src = net_if_ipv6_select_src_addr(iface, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &addr), "Better match not selected");
+
+	/* A deprecated address must not be returned from the cache */
+	ifaddr->addr_state = NET_ADDR_DEPRECATED;
+
+	src = net_if_ipv6_select_src_addr(iface, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &my_addr), "Deprecated address selected");
+
+	net_if_ipv6_addr_update_lifetime(ifaddr, FIFTY_DAYS);
+
+	src = net_if_ipv6_select_src_addr(iface, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &addr), "Renewed address not selected");
+
+	ret = net_if_ipv6_addr_rm(iface, &addr);
+	zassert_true(ret, "Cannot remove address");
+
+	src = net_if_ipv6_select_src_addr(iface, &dst);
+	zassert_true(net_ipv6_addr_cmp(src, &my_addr), "Removed address selected");
+}
+
+ZTEST(net_ipv6, test_pmtu_packet_too_big)
+{
+	struct in6_addr dst = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 1, 0, 0,
+				    0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+	struct net_if *iface = TEST_NET_IF;
+
+	net_pmtu_clear();
+
+	zassert_equal(net_pmtu_ipv6_get_mtu(&dst), -ENOENT, "Unexpected PMTU");
+
+	/* Below the IPv6 minimum MTU */
+	inject_ptb_message(iface, 1000, &my_addr, &dst);
+	zassert_equal(net_pmtu_ipv6_get_mtu(&dst), -ENOENT, "Too small PMTU used");
+
+	/* Not sent by us */
+	inject_ptb_message(iface, 1400, &peer_addr, &dst);
+	zassert_equal(net_pmtu_ipv6_get_mtu(&dst), -ENOENT, "Foreign PTB used");
+
+	inject_ptb_message(iface, 1400, &my_addr, &dst);
+	zassert_equal(net_pmtu_ipv6_get_mtu(&dst), 1400, "PMTU not learned");
+
+	/* The path MTU is only ever lowered by Packet Too Big messages */
+	inject_ptb_message(iface, 1450, &my_addr, &dst);
+	zassert_equal(net_pmtu_ipv6_get_mtu(&dst), 1400, "PMTU increased");
+
+	inject_ptb_message(iface, 1300, &my_addr, &dst);
+	zassert_equal(net_pmtu_ipv6_get_mtu(&dst), 1300, "PMTU not lowered");
+
+	net_pmtu_clear();
+}
+
 /**
  * @brief IPv6 change ll address
  */
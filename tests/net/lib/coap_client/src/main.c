@@ -329,6 +329,52 @@ static ssize_t z_impl_zsock_recvfrom_custom_fake_echo_next_req(int sock, void *b
 	return sizeof(ack_data);
 }
 
+static ssize_t z_impl_zsock_sendto_custom_fake_q_block2(int sock, void *buf, size_t len,
+							int flags, const struct sockaddr *dest_addr,
+							socklen_t addrlen)
+{
+	struct coap_packet request = {0};
+	int block_option;
+	int ret;
+
+	ret = coap_packet_parse(&request, buf, len, NULL, 0);
+	zassert_equal(ret, 0, "Invalid data sent");
+
+	block_option = coap_get_option_int(&request, COAP_OPTION_Q_BLOCK2);
+	zassert_true(block_option >= 0, "Q-Block2 option not found");
+	zassert_equal(GET_BLOCK_NUM(block_option), 0, "Unexpected block number");
+	zassert_true(GET_MORE(block_option), "Whole payload set not requested");
+
+	return z_impl_zsock_sendto_custom_fake(sock, buf, len, flags, dest_addr, addrlen);
+}
+
+static ssize_t z_impl_zsock_recvfrom_custom_fake_q_block2(int sock, void *buf, size_t max_len,
+							  int flags, struct sockaddr *src_addr,
+							  socklen_t *addrlen)
+{
+	uint16_t last_message_id = 0;
+
+	/* 2.05 with Q-Block2 block 0, M=0, SZX=2 */
+	uint8_t ack_data[] = {0x68, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			      0x00, 0x00, 0x00, 0x00, 0xd1, 0x12, 0x02, 0xff,
+			      't',  'e',  's',  't'};
+
+	if (messages_needing_response[0] != 0) {
+		last_message_id = messages_needing_response[0];
+		messages_needing_response[0] = 0;
+	} else {
+		last_message_id = messages_needing_response[1];
+		messages_needing_response[1] = 0;
+	}
+
+	ack_data[2] = (uint8_t) (last_message_id >> 8);
+	ack_data[3] = (uint8_t) last_message_id;
+
+	memcpy(buf, ack_data, sizeof(ack_data));
+
+	return sizeof(ack_data);
+}
+
 static void *suite_setup(void)
 {
 	coap_client_init(&client, NULL);
@@ -356,6 +402,15 @@ void coap_callback(int16_t code, size_t offset, const uint8_t *payload, size_t l
 	last_response_code = code;
 }
 
+static bool last_block_seen;
+
+static void coap_callback_last_block(int16_t code, size_t offset, const uint8_t *payload,
+				     size_t len, bool last_block, void *user_data)
+{
+	coap_callback(code, offset, payload, len, last_block, user_data);
+	last_block_seen = last_block;
+}
+
 ZTEST_SUITE(coap_client, NULL, suite_setup, test_setup, NULL, NULL);
 
 ZTEST(coap_client, test_get_request)
@@ -687,3 +742,35 @@ ZTEST(coap_client, test_unmatching_tokens)
 	k_sleep(K_MSEC(500));
 	zassert_equal(last_response_code, -ETIMEDOUT, "Unexpected response");
 }
+
+ZTEST(coap_client, test_q_block2_request)
+{
+	int ret = 0;
+	struct sockaddr address = {0};
+	struct coap_client_request client_request = {
+		.method = COAP_METHOD_GET,
+		.confirmable = true,
+		.path = test_path,
+		.fmt = COAP_CONTENT_FORMAT_TEXT_PLAIN,
+		.cb = coap_callback_last_block,
+		.payload = NULL,
+		.len = 0,
+		.q_block2 = true
+	};
+
+	last_block_seen = false;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_custom_fake_q_block2;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_custom_fake_q_block2;
+
+	k_sleep(K_MSEC(1));
+
+	LOG_INF("Send request");
+	ret = coap_client_req(&client, 0, &address, &client_request, NULL);
+	zassert_true(ret >= 0, "Sending request failed, %d", ret);
+	set_socket_events(ZSOCK_POLLIN);
+
+	k_sleep(K_MSEC(5));
+	k_sleep(K_MSEC(100));
+	zassert_equal(last_response_code, COAP_RESPONSE_CODE_CONTENT, "Unexpected response");
+	zassert_true(last_block_seen, "Transfer not completed");
+}
@@ -133,3 +133,60 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_multiple_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+	char query[sizeof("host-00.example.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host-%02zu.example.com", i);
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "host-%02zu.example.com", i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 2));
+		zassert_equal(i, info_read[0].ai_addrlen);
+	}
+}
+
+ZTEST(net_dns_cache_test, test_find_in_added_order)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[3] = {0};
+	const char *query = "example.com";
+
+	for (size_t i = 0; i < ARRAY_SIZE(info_read); i++) {
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	zassert_equal(3, dns_cache_find(&test_dns_cache, query, info_read, 3));
+	for (size_t i = 0; i < ARRAY_SIZE(info_read); i++) {
+		zassert_equal(i, info_read[i].ai_addrlen);
+	}
+}
+
+ZTEST(net_dns_cache_test, test_remove)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example2.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL));
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "example.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example.com", info_read, 2));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example2.com", info_read, 2));
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/net/http/hpack.h>
+#include <zephyr/ztest.h>
+
+struct test_header {
+	const char *name;
+	const char *value;
+};
+
+static struct http_hpack_header_buf encoder;
+static struct http_hpack_header_buf decoder;
+
+static void decode_block(const uint8_t *buf, size_t len,
+			 const struct test_header *expected, size_t count)
+{
+	size_t offset = 0;
+	size_t i = 0;
+	int ret;
+
+	while (offset < len) {
+		/* Dynamic table size updates do not produce a header field. */
+		bool size_update = (buf[offset] & 0xE0) == 0x20;
+
+		ret = http_hpack_decode_header(buf + offset, len - offset, &decoder);
+		zassert_true(ret > 0, "Decoding failed (%d)", ret);
+		offset += ret;
+
+		if (size_update) {
+			continue;
+		}
+
+		zassert_true(i < count, "Too many header fields");
+		zassert_equal(decoder.name_len, strlen(expected[i].name));
+		zassert_mem_equal(decoder.name, expected[i].name, decoder.name_len);
+		zassert_equal(decoder.value_len, strlen(expected[i].value));
+		zassert_mem_equal(decoder.value, expected[i].value, decoder.value_len);
+		i++;
+	}
+
+	zassert_equal(i, count, "Missing header fields");
+}
+
+static size_t encode_block(uint8_t *buf, size_t buflen,
+			   const struct test_header *headers, size_t count)
+{
+	size_t len = 0;
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		encoder.name = headers[i].name;
+		encoder.name_len = strlen(headers[i].name);
+		encoder.value = headers[i].value;
+		encoder.value_len = strlen(headers[i].value);
+
+		ret = http_hpack_encode_header(buf + len, buflen - len, &encoder);
+		zassert_true(ret > 0, "Encoding failed (%d)", ret);
+		len += ret;
+	}
+
+	return len;
+}
+
+ZTEST(hpack, test_huffman_round_trip)
+{
+	static const char *const strings[] = {
+		"www.example.com", "no-cache", "custom-key", "text/html",
+		"Mon, 21 Oct 2013 20:13:21 GMT", "\x01\x7f\xfe\xff~|{}",
+	};
+	uint8_t encoded[64];
+	uint8_t decoded[64];
+	int enc_len, dec_len;
+
+	ARRAY_FOR_EACH(strings, i) {
+		size_t len = strlen(strings[i]);
+
+		enc_len = http_hpack_huffman_encode((const uint8_t *)strings[i], len, encoded,
+						    sizeof(encoded));
+		zassert_true(enc_len > 0, "Encoding failed (%d)", enc_len);
+
+		dec_len = http_hpack_huffman_decode(encoded, enc_len, decoded,
+						    sizeof(decoded));
+		zassert_equal(dec_len, len, "Decoding failed (%d)", dec_len);
+		zassert_mem_equal(decoded, strings[i], len);
+	}
+}
+
+ZTEST(hpack, test_huffman_decode_invalid)
+{
+	/* EOS symbol in the string */
+	static const uint8_t eos[] = { 0xff, 0xff, 0xff, 0xff };
+	/* Padding longer than 7 bits */
+	static const uint8_t padding[] = { 0xf1, 0xe3, 0xff };
+	uint8_t decoded[16];
+
+	zassert_true(http_hpack_huffman_decode(eos, sizeof(eos), decoded,
+					       sizeof(decoded)) < 0);
+	zassert_true(http_hpack_huffman_decode(padding, sizeof(padding), decoded,
+					       sizeof(decoded)) < 0);
+}
+
+ZTEST(hpack, test_static_table_encode)
+{
+	static const struct test_header status = { ":status", "200" };
+	static const struct test_header gzip = { "accept-encoding", "gzip, deflate" };
+	static const struct test_header vary = { "vary", "accept-encoding" };
+	uint8_t buf[64];
+	size_t len;
+
+	len = encode_block(buf, sizeof(buf), &status, 1);
+	zassert_equal(len, 1);
+	zassert_equal(buf[0], 0x80 | 8, "Status not indexed");
+
+	len = encode_block(buf, sizeof(buf), &gzip, 1);
+	zassert_equal(len, 1);
+	zassert_equal(buf[0], 0x80 | 16, "Accept-encoding not indexed");
+
+	/* Name of the last static table entry */
+	len = encode_block(buf, sizeof(buf), &vary, 1);
+	zassert_true(len > 1);
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0) {
+		/* Literal with incremental indexing */
+		zassert_equal(buf[0], 0x40 | 59, "Vary name not indexed");
+	} else {
+		/* Literal never indexed */
+		zassert_equal(buf[0], 0x1f, "Vary name not indexed");
+		zassert_equal(buf[1], 59 - 15, "Vary name not indexed");
+	}
+}
+
+ZTEST(hpack, test_encode_decode)
+{
+	static const struct test_header response[] = {
+		{ ":status", "404" },
+		{ "content-type", "text/html" },
+		{ "content-encoding", "gzip" },
+		{ "x-custom", "value" },
+	};
+	uint8_t buf[128];
+	size_t len;
+
+	for (int i = 0; i < 3; i++) {
+		len = encode_block(buf, sizeof(buf), response, ARRAY_SIZE(response));
+		decode_block(buf, len, response, ARRAY_SIZE(response));
+
+		if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE > 0 && i > 0) {
+			/* Repeated fields come from the dynamic table. */
+			zassert_equal(len, ARRAY_SIZE(response));
+		}
+	}
+}
+
+/* RFC 7541, Appendix C.3 and C.4 */
+static const struct test_header rfc_request_1[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "http" },
+	{ ":path", "/" },
+	{ ":authority", "www.example.com" },
+};
+
+static const struct test_header rfc_request_2[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "http" },
+	{ ":path", "/" },
+	{ ":authority", "www.example.com" },
+	{ "cache-control", "no-cache" },
+};
+
+static const struct test_header rfc_request_3[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":path", "/index.html" },
+	{ ":authority", "www.example.com" },
+	{ "custom-key", "custom-value" },
+};
+
+ZTEST(hpack, test_decode_rfc_requests)
+{
+	static const uint8_t block_1[] = {
+		0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77,
+		0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65,
+		0x2e, 0x63, 0x6f, 0x6d,
+	};
+	static const uint8_t block_2[] = {
+		0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f,
+		0x2d, 0x63, 0x61, 0x63, 0x68, 0x65,
+	};
+	static const uint8_t block_3[] = {
+		0x82, 0x87, 0x85, 0xbf, 0x40, 0x0a, 0x63, 0x75,
+		0x73, 0x74, 0x6f, 0x6d, 0x2d, 0x6b, 0x65, 0x79,
+		0x0c, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x2d,
+		0x76, 0x61, 0x6c, 0x75, 0x65,
+	};
+
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 0) {
+		ztest_test_skip();
+	}
+
+	decode_block(block_1, sizeof(block_1), rfc_request_1,
+		     ARRAY_SIZE(rfc_request_1));
+	decode_block(block_2, sizeof(block_2), rfc_request_2,
+		     ARRAY_SIZE(rfc_request_2));
+	decode_block(block_3, sizeof(block_3), rfc_request_3,
+		     ARRAY_SIZE(rfc_request_3));
+}
+
+ZTEST(hpack, test_decode_rfc_requests_huffman)
+{
+	static const uint8_t block_1[] = {
+		0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2,
+		0xe5, 0xf2, 0x3a, 0x6b, 0xa0, 0xab, 0x90, 0xf4,
+		0xff,
+	};
+	static const uint8_t block_2[] = {
+		0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb,
+		0x10, 0x64, 0x9c, 0xbf,
+	};
+	static const uint8_t block_3[] = {
+		0x82, 0x87, 0x85, 0xbf, 0x40, 0x88, 0x25, 0xa8,
+		0x49, 0xe9, 0x5b, 0xa9, 0x7d, 0x7f, 0x89, 0x25,
+		0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf,
+	};
+
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 0) {
+		ztest_test_skip();
+	}
+
+	decode_block(block_1, sizeof(block_1), rfc_request_1,
+		     ARRAY_SIZE(rfc_request_1));
+	decode_block(block_2, sizeof(block_2), rfc_request_2,
+		     ARRAY_SIZE(rfc_request_2));
+	decode_block(block_3, sizeof(block_3), rfc_request_3,
+		     ARRAY_SIZE(rfc_request_3));
+}
+
+/* RFC 7541, Appendix C.5, the entries get evicted from a 256 bytes table. */
+ZTEST(hpack, test_decode_rfc_responses_eviction)
+{
+	static const struct test_header response_1[] = {
+		{ ":status", "302" },
+		{ "cache-control", "private" },
+		{ "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+		{ "location", "https://www.example.com" },
+	};
+	static const struct test_header response_2[] = {
+		{ ":status", "307" },
+		{ "cache-control", "private" },
+		{ "date", "Mon, 21 Oct 2013 20:13:21 GMT" },
+		{ "location", "https://www.example.com" },
+	};
+	static const struct test_header response_3[] = {
+		{ ":status", "200" },
+		{ "cache-control", "private" },
+		{ "date", "Mon, 21 Oct 2013 20:13:22 GMT" },
+		{ "location", "https://www.example.com" },
+		{ "content-encoding", "gzip" },
+		{ "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" },
+	};
+	static const uint8_t block_1[] = {
+		/* Dynamic table size update to 256 */
+		0x3f, 0xe1, 0x01,
+		0x48, 0x03, 0x33, 0x30, 0x32, 0x58, 0x07, 0x70,
+		0x72, 0x69, 0x76, 0x61, 0x74, 0x65, 0x61, 0x1d,
+		0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32, 0x31, 0x20,
+		0x4f, 0x63, 0x74, 0x20, 0x32, 0x30, 0x31, 0x33,
+		0x20, 0x32, 0x30, 0x3a, 0x31, 0x33, 0x3a, 0x32,
+		0x31, 0x20, 0x47, 0x4d, 0x54, 0x6e, 0x17, 0x68,
+		0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f, 0x77,
+		0x77, 0x77, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70,
+		0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d,
+	};
+	static const uint8_t block_2[] = {
+		0x48, 0x03, 0x33, 0x30, 0x37, 0xc1, 0xc0, 0xbf,
+	};
+	static const uint8_t block_3[] = {
+		0x88, 0xc1, 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c,
+		0x20, 0x32, 0x31, 0x20, 0x4f, 0x63, 0x74, 0x20,
+		0x32, 0x30, 0x31, 0x33, 0x20, 0x32, 0x30, 0x3a,
+		0x31, 0x33, 0x3a, 0x32, 0x32, 0x20, 0x47, 0x4d,
+		0x54, 0xc0, 0x5a, 0x04, 0x67, 0x7a, 0x69, 0x70,
+		0x77, 0x38, 0x66, 0x6f, 0x6f, 0x3d, 0x41, 0x53,
+		0x44, 0x4a, 0x4b, 0x48, 0x51, 0x4b, 0x42, 0x5a,
+		0x58, 0x4f, 0x51, 0x57, 0x45, 0x4f, 0x50, 0x49,
+		0x55, 0x41, 0x58, 0x51, 0x57, 0x45, 0x4f, 0x49,
+		0x55, 0x3b, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61,
+		0x67, 0x65, 0x3d, 0x33, 0x36, 0x30, 0x30, 0x3b,
+		0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
+		0x3d, 0x31,
+	};
+
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 0) {
+		ztest_test_skip();
+	}
+
+	decode_block(block_1, sizeof(block_1), response_1, ARRAY_SIZE(response_1));
+	decode_block(block_2, sizeof(block_2), response_2, ARRAY_SIZE(response_2));
+	decode_block(block_3, sizeof(block_3), response_3, ARRAY_SIZE(response_3));
+}
+
+ZTEST(hpack, test_decode_size_update_too_large)
+{
+	/* Dynamic table size update to 8192 */
+	static const uint8_t block[] = { 0x3f, 0xe1, 0x3f };
+
+	zassert_equal(http_hpack_decode_header(block, sizeof(block), &decoder),
+		      -EBADMSG);
+}
+
+static void hpack_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	http_hpack_init_dynamic_tables(&encoder);
+	http_hpack_init_dynamic_tables(&decoder);
+}
+
+ZTEST_SUITE(hpack, NULL, NULL, hpack_before, NULL, NULL);
@@ -1524,6 +1524,21 @@ ZTEST(net_content_senml_cbor_nodata, test_get_time_nodata)
 	zassert_equal(ret, -EBADMSG, "Invalid error code returned");
 }
 
+ZTEST(net_content_senml_cbor, test_put_obj_inst_streaming)
+{
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_LWM2M_RW_SENML_CBOR_STREAMING);
+
+	/* More records than CONFIG_LWM2M_RW_SENML_CBOR_RECORDS */
+	test_msg.path.level = LWM2M_PATH_LEVEL_OBJECT_INST;
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	zassert_true(ret >= 0, "Error reported");
+	zassert_equal(test_msg.msg_data[TEST_PAYLOAD_OFFSET], (0x04 << 5) | TEST_OBJ_RES_MAX_ID,
+		      "Invalid number of records");
+}
+
 ZTEST_SUITE(net_content_senml_cbor, NULL, test_obj_init, test_prepare, NULL, NULL);
 ZTEST_SUITE(net_content_senml_cbor_nomem, NULL, test_obj_init, test_prepare_nomem, NULL, NULL);
 ZTEST_SUITE(net_content_senml_cbor_nodata, NULL, test_obj_init, test_prepare_nodata, NULL, NULL);
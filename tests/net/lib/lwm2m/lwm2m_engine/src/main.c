@@ -223,6 +223,24 @@ ZTEST(lwm2m_engine, test_socket_suspend_resume_connection)
 	lwm2m_engine_stop(&ctx);
 }
 
+static struct observe_node *due_obs;
+
+static struct observe_node *engine_observe_next_due_custom_fake(struct lwm2m_ctx *ctx,
+								 int64_t timestamp, int64_t *next)
+{
+	struct observe_node *obs = due_obs;
+
+	if (obs != NULL && timestamp < obs->event_timestamp) {
+		*next = obs->event_timestamp;
+		return NULL;
+	}
+
+	due_obs = NULL;
+	*next = INT64_MAX;
+
+	return obs;
+}
+
 ZTEST(lwm2m_engine, test_check_notifications)
 {
 	int ret;
@@ -242,6 +260,8 @@ ZTEST(lwm2m_engine, test_check_notifications)
 	obs.active_notify = NULL;
 
 	sys_slist_append(&ctx.observer, &obs.node);
+	due_obs = &obs;
+	engine_observe_next_due_fake.custom_fake = engine_observe_next_due_custom_fake;
 
 	lwm2m_rd_client_is_registred_fake.return_val = true;
 	ret = lwm2m_engine_start(&ctx);
@@ -24,6 +24,10 @@ DEFINE_FAKE_VALUE_FUNC(int, generate_notify_message, struct lwm2m_ctx *, struct
 		       void *);
 DEFINE_FAKE_VALUE_FUNC(int64_t, engine_observe_shedule_next_event, struct observe_node *, uint16_t,
 		       const int64_t);
+DEFINE_FAKE_VOID_FUNC(engine_observe_set_event_timestamp, struct lwm2m_ctx *,
+		      struct observe_node *, int64_t);
+DEFINE_FAKE_VALUE_FUNC(struct observe_node *, engine_observe_next_due, struct lwm2m_ctx *, int64_t,
+		       int64_t *);
 DEFINE_FAKE_VALUE_FUNC(int, handle_request, struct coap_packet *, struct lwm2m_message *);
 DEFINE_FAKE_VOID_FUNC(lwm2m_udp_receive, struct lwm2m_ctx *, uint8_t *, uint16_t,
 		      struct sockaddr *);
@@ -38,6 +38,10 @@ DECLARE_FAKE_VALUE_FUNC(int, generate_notify_message, struct lwm2m_ctx *, struct
 			void *);
 DECLARE_FAKE_VALUE_FUNC(int64_t, engine_observe_shedule_next_event, struct observe_node *, uint16_t,
 			const int64_t);
+DECLARE_FAKE_VOID_FUNC(engine_observe_set_event_timestamp, struct lwm2m_ctx *,
+		       struct observe_node *, int64_t);
+DECLARE_FAKE_VALUE_FUNC(struct observe_node *, engine_observe_next_due, struct lwm2m_ctx *,
+			int64_t, int64_t *);
 DECLARE_FAKE_VALUE_FUNC(int, handle_request, struct coap_packet *, struct lwm2m_message *);
 DECLARE_FAKE_VOID_FUNC(lwm2m_udp_receive, struct lwm2m_ctx *, uint8_t *, uint16_t,
 		       struct sockaddr *);
@@ -74,6 +78,8 @@ DECLARE_FAKE_VALUE_FUNC(bool, coap_block_has_more, struct coap_packet *);
 		FUNC(coap_pending_cycle)                                                           \
 		FUNC(generate_notify_message)                                                      \
 		FUNC(engine_observe_shedule_next_event)                                            \
+		FUNC(engine_observe_set_event_timestamp)                                           \
+		FUNC(engine_observe_next_due)                                                      \
 		FUNC(handle_request)                                                               \
 		FUNC(lwm2m_udp_receive)                                                            \
 		FUNC(lwm2m_rd_client_is_registred)                                                 \
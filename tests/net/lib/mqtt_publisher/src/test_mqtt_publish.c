@@ -25,6 +25,9 @@ char payload[] = "DOORS:OPEN_QoSx";
 
 static uint8_t rx_buffer[BUFFER_SIZE];
 static uint8_t tx_buffer[BUFFER_SIZE];
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+static uint8_t tx_batch_buffer[BUFFER_SIZE];
+#endif
 static struct mqtt_client client_ctx;
 static struct sockaddr broker;
 static struct zsock_pollfd fds[1];
@@ -180,6 +183,10 @@ static void client_init(struct mqtt_client *client)
 	client->rx_buf_size = sizeof(rx_buffer);
 	client->tx_buf = tx_buffer;
 	client->tx_buf_size = sizeof(tx_buffer);
+#if defined(CONFIG_MQTT_LIB_TX_BATCH)
+	client->tx_batch_buf = tx_batch_buffer;
+	client->tx_batch_buf_size = sizeof(tx_batch_buffer);
+#endif
 }
 
 static int publish(enum mqtt_qos qos)
@@ -268,6 +275,14 @@ static int test_publish(enum mqtt_qos qos)
 		return TC_FAIL;
 	}
 
+	/* QoS 0 messages wait in the batch, send it before the next packet */
+	if (IS_ENABLED(CONFIG_MQTT_LIB_TX_BATCH) && qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		rc = mqtt_flush(&client_ctx);
+		if (rc != 0) {
+			return TC_FAIL;
+		}
+	}
+
 	wait(APP_SLEEP_MSECS);
 	mqtt_input(&client_ctx);
 
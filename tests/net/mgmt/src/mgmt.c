@@ -456,4 +456,39 @@ ZTEST(mgmt_fn_test_suite, test_mgmt_duplicate_handler)
 	net_mgmt_del_event_callback(&cb);
 }
 
+static uint32_t direct_calls;
+static k_tid_t direct_caller;
+
+static void net_mgmt_direct_event_handler(struct net_mgmt_event_callback *cb,
+					   uint32_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	zassert_equal(mgmt_event, TEST_MGMT_EVENT, "Wrong event");
+	zassert_equal(cb->info_length, sizeof(TEST_INFO_STRING), "Wrong info length");
+
+	direct_caller = k_current_get();
+	direct_calls++;
+}
+
+ZTEST(mgmt_fn_test_suite, test_mgmt_direct_handler)
+{
+	struct net_mgmt_event_callback cb;
+
+	net_mgmt_init_event_callback(&cb, net_mgmt_direct_event_handler, TEST_MGMT_EVENT);
+	net_mgmt_add_event_callback_direct(&cb);
+
+	/* The handler has run when the notification returns */
+	net_mgmt_event_notify_with_info(TEST_MGMT_EVENT, NULL, TEST_INFO_STRING,
+					sizeof(TEST_INFO_STRING));
+	zassert_equal(direct_calls, 1, "Direct handler not called");
+	zassert_equal(direct_caller, k_current_get(), "Handler called from another thread");
+
+	net_mgmt_del_event_callback(&cb);
+
+	net_mgmt_event_notify_with_info(TEST_MGMT_EVENT, NULL, TEST_INFO_STRING,
+					sizeof(TEST_INFO_STRING));
+	zassert_equal(direct_calls, 1, "Deleted direct handler called");
+}
+
 ZTEST_SUITE(mgmt_fn_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -1067,6 +1068,73 @@ ZTEST(net_pkt_test_suite, test_net_pkt_get_contiguous_len)
 	net_pkt_unref(pkt);
 }
 
+ZTEST(net_pkt_test_suite, test_net_pkt_fragment_boundaries)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(access, uint32_t);
+	const size_t frag_len = CONFIG_NET_BUF_DATA_SIZE;
+	uint8_t data[8];
+	uint32_t *value;
+	struct net_pkt *pkt;
+	struct net_pkt *copy;
+
+	/* Allocate pkt with 3 fragments */
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, frag_len * 3,
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	for (size_t i = 0; i < sizeof(small_buffer); i++) {
+		small_buffer[i] = (uint8_t)i;
+	}
+
+	/* Writes ending inside, at the end of and across fragments */
+	zassert_ok(net_pkt_write(pkt, small_buffer, frag_len - 4), "Write failed");
+	zassert_ok(net_pkt_write(pkt, small_buffer, 4), "Write failed");
+	zassert_ok(net_pkt_write(pkt, small_buffer, frag_len - 2), "Write failed");
+	zassert_ok(net_pkt_write(pkt, small_buffer, 4), "Write failed");
+	zassert_ok(net_pkt_memset(pkt, 0x55, 2), "Memset failed");
+	zassert_equal(net_pkt_get_len(pkt), frag_len * 2 + 4, "Wrong length");
+	zassert_equal(pkt->buffer->len, frag_len, "Wrong fragment length");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	/* Reads ending at the end of and across fragments */
+	zassert_ok(net_pkt_skip(pkt, frag_len - 4), "Skip failed");
+	zassert_ok(net_pkt_read(pkt, data, 4), "Read failed");
+	zassert_mem_equal(data, small_buffer, 4, "Data mismatch");
+	zassert_equal_ptr(pkt->cursor.buf, pkt->buffer->frags, "Cursor not moved");
+
+	zassert_ok(net_pkt_skip(pkt, frag_len - 4), "Skip failed");
+	value = net_pkt_get_data(pkt, &access);
+	zassert_not_null(value, "No data");
+	zassert_mem_equal(value, &small_buffer[frag_len - 4], 2, "Data mismatch");
+	zassert_ok(net_pkt_read(pkt, data, 8), "Read failed");
+	zassert_mem_equal(data, &small_buffer[frag_len - 4], 2, "Data mismatch");
+	zassert_mem_equal(&data[2], small_buffer, 4, "Data mismatch");
+	zassert_equal(data[6], 0x55, "Data mismatch");
+	zassert_equal(net_pkt_read(pkt, data, 1), -ENOBUFS, "Read past the end");
+
+	/* Copy inside a fragment, then across fragments */
+	copy = net_pkt_rx_alloc_with_buffer(NULL, frag_len * 3,
+					    AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(copy, "Pkt not allocated");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_copy(copy, pkt, 8), "Copy failed");
+	zassert_ok(net_pkt_copy(copy, pkt, net_pkt_get_len(pkt) - 8), "Copy failed");
+	zassert_equal(net_pkt_get_len(copy), net_pkt_get_len(pkt), "Wrong length");
+
+	net_pkt_cursor_init(copy);
+	net_pkt_set_overwrite(copy, true);
+	zassert_ok(net_pkt_skip(copy, frag_len * 2 - 2), "Skip failed");
+	zassert_ok(net_pkt_read(copy, data, 6), "Read failed");
+	zassert_mem_equal(data, small_buffer, 4, "Data mismatch");
+	zassert_equal(data[4], 0x55, "Data mismatch");
+
+	net_pkt_unref(copy);
+	net_pkt_unref(pkt);
+}
+
 ZTEST(net_pkt_test_suite, test_net_pkt_remove_tail)
 {
 	struct net_pkt *pkt;
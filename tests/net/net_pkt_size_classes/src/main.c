@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_ip.h>
+
+static const char *buffer_pool_name(struct net_buf *buf)
+{
+	return net_buf_pool_get(buf->pool_id)->name;
+}
+
+static struct net_pkt *alloc_pkt(size_t size)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(NULL, size, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	return pkt;
+}
+
+ZTEST(net_pkt_size_classes, test_best_fit)
+{
+	struct net_pkt *pkt;
+
+	pkt = alloc_pkt(CONFIG_NET_BUF_SMALL_DATA_SIZE);
+	zassert_str_equal(buffer_pool_name(pkt->buffer), "tx_bufs_small");
+	zassert_is_null(pkt->buffer->frags, "Small packet is chained");
+	net_pkt_unref(pkt);
+
+	pkt = alloc_pkt(CONFIG_NET_BUF_SMALL_DATA_SIZE + 1);
+	zassert_str_equal(buffer_pool_name(pkt->buffer), "tx_bufs");
+	zassert_is_null(pkt->buffer->frags, "Medium packet is chained");
+	net_pkt_unref(pkt);
+
+	pkt = alloc_pkt(1000);
+	zassert_str_equal(buffer_pool_name(pkt->buffer), "tx_bufs_large");
+	zassert_is_null(pkt->buffer->frags, "Large packet is chained");
+	zassert_equal(net_pkt_available_buffer(pkt), 1000, "Wrong size");
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_pkt_size_classes, test_oversized_chains_largest)
+{
+	size_t size = CONFIG_NET_BUF_LARGE_DATA_SIZE + 10;
+	struct net_pkt *pkt;
+
+	pkt = alloc_pkt(size);
+	zassert_str_equal(buffer_pool_name(pkt->buffer), "tx_bufs_large");
+	zassert_not_null(pkt->buffer->frags, "Packet is not chained");
+	zassert_str_equal(buffer_pool_name(pkt->buffer->frags), "tx_bufs_large");
+	zassert_equal(net_pkt_available_buffer(pkt), size, "Wrong size");
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_pkt_size_classes, test_fallback_to_larger_class)
+{
+	struct net_pkt *pkts[CONFIG_NET_BUF_SMALL_TX_COUNT];
+	struct net_pkt *pkt;
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = alloc_pkt(16);
+		zassert_str_equal(buffer_pool_name(pkts[i]->buffer), "tx_bufs_small");
+	}
+
+	/* The small buffers are exhausted */
+	pkt = alloc_pkt(16);
+	zassert_str_equal(buffer_pool_name(pkt->buffer), "tx_bufs");
+	net_pkt_unref(pkt);
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		net_pkt_unref(pkts[i]);
+	}
+
+	pkt = alloc_pkt(16);
+	zassert_str_equal(buffer_pool_name(pkt->buffer), "tx_bufs_small");
+	net_pkt_unref(pkt);
+}
+
+ZTEST_SUITE(net_pkt_size_classes, NULL, NULL, NULL, NULL, NULL);
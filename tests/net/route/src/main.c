@@ -544,6 +544,51 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *host_entry, *prefix_entry, *entry;
+	struct in6_addr prefix = dest_addr;
+	struct in6_addr other_addr = dest_addr;
+
+	prefix.s6_addr[14] = 0U;
+	prefix.s6_addr[15] = 0U;
+	other_addr.s6_addr[15] = 0x1;
+
+	host_entry = net_route_add(my_iface,
+				   &dest_addr, 128,
+				   &peer_addr,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(host_entry, "Host route add failed");
+
+	prefix_entry = net_route_add(my_iface,
+				     &prefix, 112,
+				     &peer_addr,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(prefix_entry, "Prefix route add failed");
+	zassert_not_equal(prefix_entry, host_entry, "Host route replaced");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, host_entry, "Longest prefix not matched");
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(entry, prefix_entry, "Prefix route not matched");
+
+	entry = net_route_lookup(my_iface, &peer_addr);
+	zassert_is_null(entry, "Route found outside of the prefixes");
+
+	/* Lookups must not return deleted routes */
+	net_route_del(host_entry);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, prefix_entry, "Prefix route not matched");
+
+	net_route_del(prefix_entry);
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_is_null(entry, "Deleted route found");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +611,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
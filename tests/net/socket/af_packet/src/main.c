@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2020 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -286,6 +287,83 @@ ZTEST(socket_packet, test_raw_packet_sockets)
 	zsock_close(sock4);
 }
 
+#define RX_RING_FRAME_SIZE 64
+#define RX_RING_FRAME_NR 4
+static uint8_t rx_ring_frames[RX_RING_FRAME_NR][RX_RING_FRAME_SIZE] __aligned(4);
+
+ZTEST(socket_packet, test_raw_packet_sockets_rx_ring)
+{
+	uint8_t data_to_send[] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+	struct packet_rx_ring ring = {
+		.frames = rx_ring_frames,
+		.frame_size = RX_RING_FRAME_SIZE,
+		.frame_nr = RX_RING_FRAME_NR,
+	};
+	struct packet_rx_frame *frame = (struct packet_rx_frame *)rx_ring_frames[0];
+	uint8_t data_to_receive[sizeof(data_to_send) + HDR_SIZE];
+	struct zsock_pollfd pfd;
+	struct sockaddr_in sockaddr;
+	int ret, sock1, sock2, sock3, sock4;
+	ssize_t sent = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_SOCKETS_PACKET_RX_RING);
+
+	__test_packet_sockets(&sock1, &sock2);
+
+	ring.frame_size = sizeof(struct packet_rx_frame);
+	ret = zsock_setsockopt(sock1, SOL_PACKET, PACKET_RX_RING, &ring, sizeof(ring));
+	zassert_equal(ret, -1, "Ring without room for data accepted");
+	zassert_equal(errno, EINVAL, "Unexpected errno (%d)", errno);
+
+	ring.frame_size = RX_RING_FRAME_SIZE;
+	ret = zsock_setsockopt(sock1, SOL_PACKET, PACKET_RX_RING, &ring, sizeof(ring));
+	zassert_equal(ret, 0, "Cannot set receive ring (%d)", -errno);
+
+	pfd.fd = sock1;
+	pfd.events = ZSOCK_POLLIN;
+	ret = zsock_poll(&pfd, 1, 0);
+	zassert_equal(ret, 0, "Empty ring reported readable");
+
+	sock3 = prepare_udp_socket(&sockaddr, DST_PORT);
+	sock4 = prepare_udp_socket(&sockaddr, SRC_PORT);
+	sockaddr.sin_port = htons(DST_PORT);
+
+	sent = zsock_sendto(sock4, data_to_send, sizeof(data_to_send),
+			    0, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
+	zassert_equal(sent, sizeof(data_to_send), "sendto failed");
+
+	pfd.revents = 0;
+	ret = zsock_poll(&pfd, 1, 100);
+	zassert_equal(ret, 1, "Ring not reported readable");
+	zassert_equal(pfd.revents, ZSOCK_POLLIN, "Unexpected revents 0x%x",
+		      pfd.revents);
+
+	/* The whole packet fits into the first slot, headers included */
+	zassert_equal(frame->status, TP_STATUS_USER, "Unexpected status 0x%x",
+		      frame->status);
+	zassert_equal(frame->len, sizeof(data_to_send) + HDR_SIZE,
+		      "Unexpected length %u", frame->len);
+	zassert_equal(frame->snaplen, frame->len, "Frame truncated");
+	zassert_mem_equal(PACKET_RX_FRAME_DATA(frame) + HDR_SIZE, data_to_send,
+			  sizeof(data_to_send),
+			  "Sent and received buffers do not match");
+
+	/* Frames delivered to the ring are not queued for recv() */
+	setblocking(sock1, false);
+	ret = zsock_recv(sock1, data_to_receive, sizeof(data_to_receive), 0);
+	zassert_equal(ret, -1, "Packet also queued for recv()");
+	zassert_equal(errno, EAGAIN, "Unexpected errno (%d)", errno);
+
+	frame->status = TP_STATUS_KERNEL;
+	ret = zsock_poll(&pfd, 1, 0);
+	zassert_equal(ret, 0, "Released ring reported readable");
+
+	zsock_close(sock1);
+	zsock_close(sock2);
+	zsock_close(sock3);
+	zsock_close(sock4);
+}
+
 ZTEST(socket_packet, test_packet_sockets)
 {
 	int sock1, sock2;
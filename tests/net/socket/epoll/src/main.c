@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define TEST_DATA 0x5a5a
+
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
+
+static int epfd;
+static int c_sock;
+static int s_sock;
+static struct sockaddr_in6 c_addr;
+static struct sockaddr_in6 s_addr;
+
+static void epoll_add(int fd, uint32_t events)
+{
+	struct zsock_epoll_event event = {
+		.events = events,
+		.data.u32 = TEST_DATA,
+	};
+	int res;
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fd, &event);
+	zassert_equal(res, 0, "epoll_ctl ADD failed (%d)", errno);
+}
+
+static void send_small(void)
+{
+	ssize_t len;
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(void)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+static void expect_events(int timeout, int count, uint32_t events)
+{
+	struct zsock_epoll_event ev[2];
+	int res;
+
+	memset(ev, 0, sizeof(ev));
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), timeout);
+	zassert_equal(res, count, "unexpected number of events (%d)", res);
+
+	if (count > 0) {
+		zassert_equal(ev[0].events, events, "unexpected events %x", ev[0].events);
+		zassert_equal(ev[0].data.u32, TEST_DATA, "unexpected user data");
+	}
+}
+
+ZTEST(net_socket_epoll, test_epoll_level_triggered)
+{
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	expect_events(0, 0, 0);
+
+	send_small();
+	expect_events(100, 1, ZSOCK_EPOLLIN);
+
+	/* Reported again as long as data is pending */
+	expect_events(0, 1, ZSOCK_EPOLLIN);
+
+	recv_small();
+	expect_events(0, 0, 0);
+}
+
+ZTEST(net_socket_epoll, test_epoll_edge_triggered)
+{
+	epoll_add(s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	send_small();
+	expect_events(100, 1, ZSOCK_EPOLLIN);
+
+	/* Not reported again until more data arrives */
+	expect_events(0, 0, 0);
+
+	send_small();
+	expect_events(100, 1, ZSOCK_EPOLLIN);
+
+	recv_small();
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_epoll_oneshot)
+{
+	struct zsock_epoll_event event = {
+		.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT,
+		.data.u32 = TEST_DATA,
+	};
+	int res;
+
+	epoll_add(s_sock, event.events);
+
+	send_small();
+	expect_events(100, 1, ZSOCK_EPOLLIN);
+
+	/* Disabled until rearmed */
+	send_small();
+	expect_events(50, 0, 0);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &event);
+	zassert_equal(res, 0, "epoll_ctl MOD failed (%d)", errno);
+
+	expect_events(0, 1, ZSOCK_EPOLLIN);
+
+	recv_small();
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_epoll_timeout)
+{
+	uint32_t tstamp;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	tstamp = k_uptime_get_32();
+	expect_events(30, 0, 0);
+	zassert_true(k_uptime_get_32() - tstamp >= 30, "returned before timeout");
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl_errors)
+{
+	struct zsock_epoll_event event = {
+		.events = ZSOCK_EPOLLIN,
+	};
+	int res;
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &event);
+	zassert_equal(res, -1, "MOD of unregistered fd succeeded");
+	zassert_equal(errno, ENOENT, "unexpected errno %d", errno);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "DEL of unregistered fd succeeded");
+	zassert_equal(errno, ENOENT, "unexpected errno %d", errno);
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &event);
+	zassert_equal(res, -1, "duplicate ADD succeeded");
+	zassert_equal(errno, EEXIST, "unexpected errno %d", errno);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &event);
+	zassert_equal(res, -1, "ADD of epoll fd to itself succeeded");
+	zassert_equal(errno, EINVAL, "unexpected errno %d", errno);
+
+	res = zsock_epoll_ctl(s_sock, ZSOCK_EPOLL_CTL_ADD, c_sock, &event);
+	zassert_equal(res, -1, "ADD to a non-epoll fd succeeded");
+	zassert_equal(errno, EINVAL, "unexpected errno %d", errno);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl DEL failed (%d)", errno);
+
+	send_small();
+	expect_events(50, 0, 0);
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_epoll_close_removes)
+{
+	int res;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	expect_events(0, 0, 0);
+
+	/* The descriptor is likely reused, registering it again must work */
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	send_small();
+	expect_events(100, 1, ZSOCK_EPOLLIN);
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_epoll_poll_epfd)
+{
+	struct zsock_pollfd pollfd = {
+		.fd = epfd,
+		.events = ZSOCK_POLLIN,
+	};
+	int res;
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	/* Drain the initial state check */
+	expect_events(0, 0, 0);
+
+	res = zsock_poll(&pollfd, 1, 0);
+	zassert_equal(res, 0, "epoll fd readable without events");
+
+	send_small();
+
+	res = zsock_poll(&pollfd, 1, 100);
+	zassert_equal(res, 1, "epoll fd not readable");
+	zassert_equal(pollfd.revents, ZSOCK_POLLIN, "unexpected revents");
+
+	expect_events(0, 1, ZSOCK_EPOLLIN);
+	recv_small();
+}
+
+ZTEST(net_socket_epoll, test_epoll_tcp)
+{
+	struct sockaddr_in6 c_addr_tcp;
+	struct sockaddr_in6 s_addr_tcp;
+	struct sockaddr_in6 addr;
+	socklen_t addrlen = sizeof(addr);
+	int c_sock_tcp;
+	int s_sock_tcp;
+	int new_sock;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock_tcp, &c_addr_tcp);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock_tcp, &s_addr_tcp);
+
+	res = zsock_bind(s_sock_tcp, (struct sockaddr *)&s_addr_tcp, sizeof(s_addr_tcp));
+	zassert_equal(res, 0, "bind failed");
+	res = zsock_listen(s_sock_tcp, 0);
+	zassert_equal(res, 0, "listen failed");
+
+	epoll_add(s_sock_tcp, ZSOCK_EPOLLIN);
+	expect_events(0, 0, 0);
+
+	res = zsock_connect(c_sock_tcp, (struct sockaddr *)&s_addr_tcp, sizeof(s_addr_tcp));
+	zassert_equal(res, 0, "connect failed");
+
+	/* Pending connection */
+	expect_events(100, 1, ZSOCK_EPOLLIN);
+
+	new_sock = zsock_accept(s_sock_tcp, (struct sockaddr *)&addr, &addrlen);
+	zassert_true(new_sock >= 0, "accept failed");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock_tcp, NULL);
+	zassert_equal(res, 0, "epoll_ctl DEL failed (%d)", errno);
+
+	/* Writable connection, served by polling */
+	epoll_add(c_sock_tcp, ZSOCK_EPOLLOUT);
+	expect_events(100, 1, ZSOCK_EPOLLOUT);
+
+	res = zsock_close(c_sock_tcp);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock_tcp);
+	zassert_equal(res, 0, "close failed");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+static void epoll_before(void *fixture)
+{
+	int res;
+
+	ARG_UNUSED(fixture);
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+}
+
+static void epoll_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)zsock_close(epfd);
+	(void)zsock_close(c_sock);
+	(void)zsock_close(s_sock);
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, epoll_before, epoll_after, NULL);
@@ -262,6 +262,66 @@ ZTEST_USER(net_socket_tcp, test_v4_send_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+/* Zero-copy receive is only available to supervisor threads */
+ZTEST(net_socket_tcp, test_v4_recvmsg_zerocopy)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct iovec io_vector[2];
+	struct msghdr msg;
+	size_t len = strlen(TEST_STR_SMALL);
+	ssize_t ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	memset(&msg, 0, sizeof(msg));
+	memset(io_vector, 0, sizeof(io_vector));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	ret = zsock_recvmsg(new_sock, &msg, ZSOCK_MSG_ZEROCOPY);
+	zassert_equal(ret, len, "unexpected lent length %d", (int)ret);
+	zassert_true(msg.msg_iovlen >= 1 && msg.msg_iovlen <= ARRAY_SIZE(io_vector),
+		     "wrong iovec count %d", (int)msg.msg_iovlen);
+
+	for (size_t i = 0, off = 0; i < msg.msg_iovlen; i++) {
+		zassert_mem_equal(io_vector[i].iov_base, TEST_STR_SMALL + off,
+				  io_vector[i].iov_len, "wrong data");
+		off += io_vector[i].iov_len;
+	}
+
+	zassert_ok(zsock_recv_release(new_sock, &msg), "release failed");
+	zassert_equal(zsock_recv_release(new_sock, &msg), -1,
+		      "double release succeeded");
+	zassert_equal(errno, EINVAL, "unexpected errno %d", errno);
+
+	test_close(c_sock);
+	test_eof(new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_USER(net_socket_tcp, test_v6_send_recv)
 {
 	/* Test if send() and recv() work on a ipv6 stream socket. */
@@ -2415,6 +2475,51 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, CONFIG_NET_TCP_CA_DEFAULT), 0,
+		      "getsockopt got invalid value");
+	zassert_equal(optlen, sizeof(CONFIG_NET_TCP_CA_DEFAULT),
+		      "getsockopt got invalid size");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+			       "unknown", strlen("unknown"));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "invalid errno (%d)", errno);
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+			       "reno", strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_CUBIC)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+				       "cubic", sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION,
+				       name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(strcmp(name, "cubic"), 0,
+			      "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+#endif
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -801,6 +801,67 @@ ZTEST(net_socket_tls, test_v6_dtls_sendmsg)
 	test_dtls_sendmsg(AF_INET6);
 }
 
+static void test_tls_sendmsg(sa_family_t family)
+{
+	int rv;
+	uint8_t tx_large[200];
+	uint8_t rx_buf[2 * (sizeof(TEST_STR_SMALL) - 1) + sizeof(tx_large)];
+	struct iovec iov[4] = {
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+		{},
+		{
+			.iov_base = tx_large,
+			.iov_len = sizeof(tx_large),
+		},
+		{
+			.iov_base = TEST_STR_SMALL,
+			.iov_len = sizeof(TEST_STR_SMALL) - 1,
+		},
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+
+	test_prepare_tls_connection(family);
+
+	/* sendmsg() with multiple fragments exceeding the intermediate buffer
+	 * size, and an empty fragment inbetween.
+	 */
+	memset(tx_large, 'a', sizeof(tx_large));
+
+	rv = zsock_sendmsg(c_sock, &msg, 0);
+	zassert_equal(rv, sizeof(rx_buf), "sendmsg failed");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	rv = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_WAITALL);
+	zassert_equal(rv, sizeof(rx_buf), "recv failed");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1,
+			  "invalid rx data");
+	zassert_mem_equal(rx_buf + sizeof(TEST_STR_SMALL) - 1, tx_large,
+			  sizeof(tx_large), "invalid rx data");
+	zassert_mem_equal(rx_buf + sizeof(TEST_STR_SMALL) - 1 + sizeof(tx_large),
+			  TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, "invalid rx data");
+
+	test_sockets_close();
+
+	/* Small delay for the final alert exchange */
+	k_msleep(10);
+}
+
+ZTEST(net_socket_tls, test_v4_tls_sendmsg)
+{
+	test_tls_sendmsg(AF_INET);
+}
+
+ZTEST(net_socket_tls, test_v6_tls_sendmsg)
+{
+	test_tls_sendmsg(AF_INET6);
+}
+
 struct close_data {
 	struct k_work_delayable work;
 	int *fd;
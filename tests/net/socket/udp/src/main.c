@@ -2528,6 +2528,171 @@ ZTEST(net_socket_udp, test_37_ipv6_src_addr_select)
 				       &my_addr3, &dest);
 }
 
+ZTEST(net_socket_udp, test_38_v4_recvmsg_zerocopy)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in peer_addr;
+	struct zsock_pollfd pollfd;
+	struct iovec io_vector[8];
+	struct msghdr msg, msg2;
+	size_t copied = 0;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	pollfd.fd = server_sock;
+	pollfd.events = ZSOCK_POLLIN;
+	rv = zsock_poll(&pollfd, 1, 1000);
+	zassert_equal(rv, 1, "poll failed");
+	zassert_true(pollfd.revents & ZSOCK_POLLIN, "no POLLIN");
+
+	/* The whole datagram is lent, possibly in several fragments */
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_name = &peer_addr;
+	msg.msg_namelen = sizeof(peer_addr);
+
+	rv = zsock_recvmsg(server_sock, &msg, ZSOCK_MSG_ZEROCOPY);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvmsg failed (%d)", errno);
+	zassert_true(msg.msg_iovlen >= 1, "no iovec filled");
+	zassert_equal(msg.msg_namelen, sizeof(struct sockaddr_in), "wrong addrlen");
+	zassert_equal(peer_addr.sin_port, client_addr.sin_port, "wrong port");
+	zassert_false(msg.msg_flags & ZSOCK_MSG_TRUNC, "truncated");
+
+	for (size_t i = 0; i < msg.msg_iovlen; i++) {
+		memcpy(rx_buf + copied, io_vector[i].iov_base, io_vector[i].iov_len);
+		copied += io_vector[i].iov_len;
+	}
+	zassert_equal(copied, STRLEN(TEST_STR2), "wrong length");
+	zassert_mem_equal(rx_buf, TEST_STR2, STRLEN(TEST_STR2), "wrong data");
+
+	/* Lend a second datagram into a single iovec */
+	rv = zsock_sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	memset(&msg2, 0, sizeof(msg2));
+	msg2.msg_iov = &io_vector[ARRAY_SIZE(io_vector) - 1];
+	msg2.msg_iovlen = 1;
+
+	rv = zsock_recvmsg(server_sock, &msg2, ZSOCK_MSG_ZEROCOPY);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed (%d)", errno);
+	zassert_equal(msg2.msg_iovlen, 1, "wrong iovec count");
+	zassert_mem_equal(msg2.msg_iov[0].iov_base, TEST_STR_SMALL,
+			  STRLEN(TEST_STR_SMALL), "wrong data");
+
+	/* Peeking can't be combined with lending */
+	rv = zsock_recvmsg(server_sock, &msg2, ZSOCK_MSG_ZEROCOPY | ZSOCK_MSG_PEEK);
+	zassert_equal(rv, -1, "recvmsg succeeded");
+	zassert_equal(errno, EINVAL, "wrong errno %d", errno);
+
+	rv = zsock_recv_release(server_sock, &msg2);
+	zassert_equal(rv, 0, "release failed");
+	rv = zsock_recv_release(server_sock, &msg);
+	zassert_equal(rv, 0, "release failed");
+
+	/* Each lend is released once */
+	rv = zsock_recv_release(server_sock, &msg);
+	zassert_equal(rv, -1, "double release succeeded");
+	zassert_equal(errno, EINVAL, "wrong errno %d", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(net_socket_udp, test_39_v6_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[] = { "one", "second", "third datagram" };
+	struct iovec tx_io[ARRAY_SIZE(payloads)];
+	struct mmsghdr tx_msgs[ARRAY_SIZE(payloads)];
+	struct iovec rx_io[ARRAY_SIZE(payloads) + 1];
+	struct mmsghdr rx_msgs[ARRAY_SIZE(payloads) + 1];
+	char rx_bufs[ARRAY_SIZE(payloads) + 1][32];
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(tx_msgs, 0, sizeof(tx_msgs));
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		tx_io[i].iov_base = (void *)payloads[i];
+		tx_io[i].iov_len = strlen(payloads[i]);
+		tx_msgs[i].msg_hdr.msg_name = &server_addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		tx_msgs[i].msg_hdr.msg_iov = &tx_io[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, tx_msgs, ARRAY_SIZE(tx_msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(tx_msgs), "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(tx_msgs[i].msg_len, strlen(payloads[i]),
+			      "wrong sent length for message %d", i);
+	}
+
+	/* Let the loopback deliver all the datagrams */
+	k_msleep(100);
+
+	memset(rx_msgs, 0, sizeof(rx_msgs));
+	for (int i = 0; i < ARRAY_SIZE(rx_msgs); i++) {
+		rx_io[i].iov_base = rx_bufs[i];
+		rx_io[i].iov_len = sizeof(rx_bufs[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_io[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Only the first datagram is waited for, the batch then ends as soon
+	 * as no more datagrams are queued.
+	 */
+	rv = zsock_recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs),
+			    ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, ARRAY_SIZE(payloads), "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(rx_msgs[i].msg_len, strlen(payloads[i]),
+			      "wrong received length for message %d", i);
+		zassert_mem_equal(rx_bufs[i], payloads[i], strlen(payloads[i]),
+				  "wrong data in message %d", i);
+	}
+
+	/* Nothing is queued anymore */
+	rv = zsock_recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs),
+			    ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg succeeded");
+	zassert_equal(errno, EAGAIN, "wrong errno %d", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -725,6 +725,76 @@ ZTEST(net_tcp, test_client_ipv6)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY_SEND)
+NET_BUF_POOL_DEFINE(send_buf_pool, 1, 16, 0, NULL);
+static K_SEM_DEFINE(send_buf_done, 0, 1);
+static int send_buf_status;
+
+static void send_buf_cb(struct net_context *context, int status,
+			void *user_data)
+{
+	send_buf_status = status;
+	k_sem_give(&send_buf_done);
+}
+
+/* Same scenario as test_client_ipv4, the data is sent from a network
+ * buffer which is released once the peer has acknowledged it.
+ */
+ZTEST(net_tcp, test_client_send_buf_ipv4)
+{
+	struct net_context *ctx;
+	struct net_buf *buf;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_IPV4;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	buf = net_buf_alloc(&send_buf_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to allocate buffer");
+	net_buf_add_u8(buf, 0x41); /* "A" */
+
+	ret = net_context_send_buf(ctx, buf, send_buf_cb, NULL);
+	zassert_equal(ret, 0, "Failed to send buffer to peer (%d)", ret);
+
+	/* Peer will release the semaphore after it sends ACK for data */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(k_sem_take(&send_buf_done, K_MSEC(100)), 0,
+		      "Send completion not reported");
+	zassert_equal(send_buf_status, 1, "Invalid send status %d",
+		      send_buf_status);
+
+	/* The only buffer of the pool is available again */
+	buf = net_buf_alloc(&send_buf_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Buffer not released after ACK");
+	net_buf_unref(buf);
+
+	net_context_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#endif /* CONFIG_NET_TCP_ZEROCOPY_SEND */
+
 static void handle_server_test(sa_family_t af, struct tcphdr *th)
 {
 	struct net_pkt *reply;
@@ -738,6 +808,12 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+			/* MSS, and SACK permitted if the peer offered it */
+			zassert_equal(th->th_off,
+				      test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ?
+				      7U : 6U, "Invalid options in SYN ACK");
+		}
 		seq++;
 		ack = ntohl(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -2,6 +2,7 @@
 
 /*
  * Copyright (c) 2015 Intel Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -215,4 +216,56 @@ ZTEST(net_trickle, test_trickle)
 	test_trickle_1_stopped();
 }
 
+#define MANY_TRICKLES 32
+#define MANY_IMIN 20
+#define MANY_IMAX 2
+#define MANY_K 1
+
+static struct net_trickle many[MANY_TRICKLES];
+static bool many_called[MANY_TRICKLES];
+static struct k_sem many_wait;
+
+static void cb_many(struct net_trickle *trickle, bool do_suppress,
+		    void *user_data)
+{
+	bool *called = user_data;
+
+	if (!*called) {
+		*called = true;
+		k_sem_give(&many_wait);
+	}
+}
+
+ZTEST(net_trickle, test_trickle_many)
+{
+	int i;
+
+	k_sem_init(&many_wait, 0, MANY_TRICKLES);
+
+	for (i = 0; i < MANY_TRICKLES; i++) {
+		zassert_false(net_trickle_create(&many[i], MANY_IMIN, MANY_IMAX,
+						 MANY_K),
+			      "Trickle %d create failed", i);
+		zassert_false(net_trickle_start(&many[i], cb_many,
+						&many_called[i]),
+			      "Trickle %d start failed", i);
+	}
+
+	/* Every timer fires within its first Imax_abs interval */
+	for (i = 0; i < MANY_TRICKLES; i++) {
+		zassert_ok(k_sem_take(&many_wait, WAIT_TIME),
+			   "Only %d trickle timeouts", i);
+	}
+
+	for (i = 0; i < MANY_TRICKLES; i++) {
+		zassert_true(many_called[i], "Trickle %d no timeout", i);
+		zassert_true(net_trickle_is_running(&many[i]),
+			     "Trickle %d not running", i);
+		zassert_false(net_trickle_stop(&many[i]),
+			      "Trickle %d stop failed", i);
+		zassert_false(net_trickle_is_running(&many[i]),
+			      "Trickle %d running", i);
+	}
+}
+
 ZTEST_SUITE(net_trickle, NULL, NULL, NULL, NULL, NULL);
@@ -923,4 +923,54 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+/* Checksum as stored in a header, see net_calc_chksum_ipv4() */
+static uint16_t stored_chksum(const uint8_t *data, size_t len)
+{
+	return ~htons(calc_chksum(0, data, len));
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	uint8_t hdr[40];
+	uint8_t old_addr[16];
+	uint16_t old_val;
+	uint16_t new_val;
+	uint32_t old_val32;
+	uint32_t new_val32;
+	uint16_t chksum;
+
+	for (int i = 0; i < sizeof(hdr); i++) {
+		hdr[i] = (uint8_t)(i * 37 + 5);
+	}
+
+	for (int offset = 0; offset < sizeof(hdr); offset += 2) {
+		chksum = stored_chksum(hdr, sizeof(hdr));
+
+		memcpy(&old_val, &hdr[offset], sizeof(old_val));
+		new_val = old_val ^ (0x5a5a + offset);
+		memcpy(&hdr[offset], &new_val, sizeof(new_val));
+
+		zassert_equal(net_chksum_update_16(chksum, old_val, new_val),
+			      stored_chksum(hdr, sizeof(hdr)),
+			      "Incremental 16-bit update mismatch at %d", offset);
+	}
+
+	chksum = stored_chksum(hdr, sizeof(hdr));
+	memcpy(&old_val32, &hdr[12], sizeof(old_val32));
+	new_val32 = old_val32 + 0x01020304;
+	memcpy(&hdr[12], &new_val32, sizeof(new_val32));
+
+	zassert_equal(net_chksum_update_32(chksum, old_val32, new_val32),
+		      stored_chksum(hdr, sizeof(hdr)), "Incremental 32-bit update mismatch");
+
+	chksum = stored_chksum(hdr, sizeof(hdr));
+	memcpy(old_addr, &hdr[8], sizeof(old_addr));
+	for (int i = 0; i < sizeof(old_addr); i++) {
+		hdr[8 + i] = (uint8_t)(i * 11);
+	}
+
+	zassert_equal(net_chksum_update_buf(chksum, old_addr, &hdr[8], sizeof(old_addr)),
+		      stored_chksum(hdr, sizeof(hdr)), "Incremental block update mismatch");
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
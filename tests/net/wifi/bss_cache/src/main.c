@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/wifi_mgmt.h>
+
+#define TEST_SSID "bss-cache"
+#define TEST_CHAN_WEAK 1
+#define TEST_CHAN_STRONG 11
+
+struct wifi_drv_context {
+	uint8_t mac_addr[6];
+};
+
+static struct wifi_drv_context wifi_context;
+static struct wifi_connect_req_params last_connect;
+static int connect_count;
+
+static const struct wifi_scan_result test_results[] = {
+	{
+		.ssid = TEST_SSID,
+		.ssid_length = sizeof(TEST_SSID) - 1,
+		.band = WIFI_FREQ_BAND_2_4_GHZ,
+		.channel = TEST_CHAN_WEAK,
+		.security = WIFI_SECURITY_TYPE_NONE,
+		.rssi = -80,
+		.mac = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 },
+		.mac_length = WIFI_MAC_ADDR_LEN,
+	},
+	{
+		.ssid = TEST_SSID,
+		.ssid_length = sizeof(TEST_SSID) - 1,
+		.band = WIFI_FREQ_BAND_2_4_GHZ,
+		.channel = TEST_CHAN_STRONG,
+		.security = WIFI_SECURITY_TYPE_NONE,
+		.rssi = -40,
+		.mac = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 },
+		.mac_length = WIFI_MAC_ADDR_LEN,
+	},
+};
+
+static void wifi_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct wifi_drv_context *context = dev->data;
+	struct ethernet_context *eth_ctx = net_if_l2_data(iface);
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	eth_ctx->eth_if_type = L2_ETH_IF_TYPE_WIFI;
+
+	ethernet_init(iface);
+}
+
+static int wifi_scan(const struct device *dev, struct wifi_scan_params *params,
+		     scan_result_cb_t cb)
+{
+	struct net_if *iface = net_if_lookup_by_dev(dev);
+
+	ARG_UNUSED(params);
+
+	for (int i = 0; i < ARRAY_SIZE(test_results); i++) {
+		struct wifi_scan_result result = test_results[i];
+
+		cb(iface, 0, &result);
+	}
+
+	cb(iface, 0, NULL);
+
+	return 0;
+}
+
+static int wifi_connect(const struct device *dev,
+			struct wifi_connect_req_params *params)
+{
+	ARG_UNUSED(dev);
+
+	last_connect = *params;
+	connect_count++;
+
+	return 0;
+}
+
+static struct wifi_mgmt_ops wifi_mgmt_api = {
+	.scan		= wifi_scan,
+	.connect	= wifi_connect,
+};
+
+static struct net_wifi_mgmt_offload api_funcs = {
+	.wifi_iface.iface_api.init = wifi_iface_init,
+	.wifi_mgmt_api = &wifi_mgmt_api,
+};
+
+static int wifi_init(const struct device *dev)
+{
+	struct wifi_drv_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x10;
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(wlan0, "wifi_test",
+		    wifi_init, NULL,
+		    &wifi_context, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &api_funcs, NET_ETH_MTU);
+
+static int request_connect(const char *ssid)
+{
+	struct wifi_connect_req_params params = {
+		.ssid = (const uint8_t *)ssid,
+		.ssid_length = strlen(ssid),
+		.security = WIFI_SECURITY_TYPE_NONE,
+		.channel = WIFI_CHANNEL_ANY,
+		.timeout = SYS_FOREVER_MS,
+	};
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_WIFI_CONNECT, net_if_get_first_wifi(),
+		       &params, sizeof(params));
+
+	/* The caller's parameters are left as they are */
+	zassert_equal(params.channel, WIFI_CHANNEL_ANY);
+
+	return ret;
+}
+
+ZTEST(net_wifi_bss_cache, test_connect_uncached)
+{
+	zassert_ok(request_connect("unknown"));
+	zassert_equal(connect_count, 1);
+	zassert_equal(last_connect.channel, WIFI_CHANNEL_ANY,
+		      "Channel set for an unknown SSID");
+}
+
+ZTEST(net_wifi_bss_cache, test_connect_cached)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+
+	zassert_ok(net_mgmt(NET_REQUEST_WIFI_SCAN, iface, NULL, 0));
+
+	zassert_ok(request_connect(TEST_SSID));
+	zassert_equal(connect_count, 1);
+	zassert_equal(last_connect.channel, TEST_CHAN_STRONG,
+		      "Not the channel of the strongest BSS");
+
+	/* Dropped on failure, the next connect tries the other BSS */
+	wifi_mgmt_raise_connect_result_event(iface, WIFI_STATUS_CONN_FAIL);
+
+	zassert_ok(request_connect(TEST_SSID));
+	zassert_equal(last_connect.channel, TEST_CHAN_WEAK,
+		      "Failed BSS not dropped");
+
+	wifi_mgmt_raise_connect_result_event(iface, WIFI_STATUS_CONN_FAIL);
+
+	zassert_ok(request_connect(TEST_SSID));
+	zassert_equal(last_connect.channel, WIFI_CHANNEL_ANY,
+		      "No cached BSS left, expected a full scan");
+}
+
+static void bss_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	connect_count = 0;
+	memset(&last_connect, 0, sizeof(last_connect));
+}
+
+ZTEST_SUITE(net_wifi_bss_cache, NULL, NULL, bss_cache_before, NULL, NULL);
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <zephyr/posix/aio.h>
+#include <zephyr/posix/unistd.h>
+#include "test_fs.h"
+
+static int file = -1;
+static K_SEM_DEFINE(notified, 0, 1);
+
+static void notify_fn(union sigval val)
+{
+	zassert_equal(val.sival_int, 42);
+	k_sem_give(&notified);
+}
+
+static void aio_init(struct aiocb *aiocbp, void *buf, size_t nbytes, off_t offset)
+{
+	*aiocbp = (struct aiocb){
+		.aio_fildes = file,
+		.aio_buf = buf,
+		.aio_nbytes = nbytes,
+		.aio_offset = offset,
+		.aio_sigevent.sigev_notify = SIGEV_NONE,
+	};
+}
+
+static void aio_wait(struct aiocb *aiocbp)
+{
+	const struct aiocb *const list[] = {aiocbp};
+
+	zassert_ok(aio_suspend(list, 1, NULL));
+	zassert_not_equal(aio_error(aiocbp), EINPROGRESS);
+}
+
+static void before_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	file = open(TEST_FILE, O_CREAT | O_RDWR);
+	zassert_true(file >= 0, "Failed opening file, errno=%d", errno);
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	if (file >= 0) {
+		close(file);
+		file = -1;
+	}
+
+	unlink(TEST_FILE);
+}
+
+ZTEST_SUITE(posix_fs_aio_test, NULL, test_mount, before_fn, after_fn, test_unmount);
+
+/**
+ * @brief Test aio_write(), then aio_read() at an offset with SIGEV_THREAD
+ */
+ZTEST(posix_fs_aio_test, test_fs_aio_read_write)
+{
+	size_t len = strlen(test_str);
+	char buf[16] = {0};
+	struct aiocb aiocb;
+
+	aio_init(&aiocb, (void *)test_str, len, 0);
+	zassert_ok(aio_write(&aiocb));
+	aio_wait(&aiocb);
+	zassert_ok(aio_error(&aiocb));
+	zassert_equal(aio_return(&aiocb), len);
+
+	aio_init(&aiocb, buf, len - 6, 6);
+	aiocb.aio_sigevent.sigev_notify = SIGEV_THREAD;
+	aiocb.aio_sigevent.sigev_notify_function = notify_fn;
+	aiocb.aio_sigevent.sigev_value.sival_int = 42;
+	zassert_ok(aio_read(&aiocb));
+	zassert_ok(k_sem_take(&notified, K_SECONDS(1)));
+	zassert_ok(aio_error(&aiocb));
+	zassert_equal(aio_return(&aiocb), len - 6);
+	zassert_mem_equal(buf, test_str + 6, len - 6);
+
+	aio_init(&aiocb, NULL, 0, 0);
+	/* Not all C libraries define O_SYNC, the operation is not checked anyway */
+	zassert_ok(aio_fsync(0, &aiocb));
+	aio_wait(&aiocb);
+	zassert_ok(aio_return(&aiocb));
+}
+
+/**
+ * @brief Test lio_listio() in both LIO_WAIT and LIO_NOWAIT modes
+ */
+ZTEST(posix_fs_aio_test, test_fs_aio_lio_listio)
+{
+	struct sigevent sig = {
+		.sigev_notify = SIGEV_THREAD,
+		.sigev_notify_function = notify_fn,
+		.sigev_value.sival_int = 42,
+	};
+	size_t len = strlen(test_str);
+	char buf[16] = {0};
+	struct aiocb aiocbs[2];
+	struct aiocb *const list[] = {&aiocbs[0], &aiocbs[1]};
+
+	aio_init(&aiocbs[0], (void *)test_str, len, 0);
+	aiocbs[0].aio_lio_opcode = LIO_WRITE;
+	aio_init(&aiocbs[1], buf, 5, 0);
+	aiocbs[1].aio_lio_opcode = LIO_READ;
+
+	/* Requests are carried out in order */
+	zassert_ok(lio_listio(LIO_WAIT, list, ARRAY_SIZE(list), NULL));
+	zassert_equal(aio_return(&aiocbs[0]), len);
+	zassert_equal(aio_return(&aiocbs[1]), 5);
+	zassert_mem_equal(buf, test_str, 5);
+
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(lio_listio(LIO_NOWAIT, list, ARRAY_SIZE(list), &sig));
+	zassert_ok(k_sem_take(&notified, K_SECONDS(1)));
+	zassert_equal(aio_return(&aiocbs[1]), 5);
+	zassert_mem_equal(buf, test_str, 5);
+}
+
+/**
+ * @brief Test the argument checks and the timeout of aio_suspend()
+ */
+ZTEST(posix_fs_aio_test, test_fs_aio_invalid)
+{
+	struct timespec timeout = {.tv_nsec = 1000000};
+	struct aiocb aiocb;
+	const struct aiocb *const list[] = {&aiocb};
+
+	aio_init(&aiocb, NULL, 0, 0);
+	aiocb.aio_sigevent.sigev_notify = SIGEV_SIGNAL;
+	zassert_equal(aio_read(&aiocb), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(lio_listio(LIO_WAIT + LIO_NOWAIT + 1, NULL, 0, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	/* Never submitted, so it stays in progress */
+	aiocb._aio_error = EINPROGRESS;
+	zassert_equal(aio_suspend(list, 1, &timeout), -1);
+	zassert_equal(errno, EAGAIN);
+	zassert_equal(aio_cancel(file, NULL), AIO_ALLDONE);
+}
@@ -43,6 +43,10 @@ const struct isotp_msg_id tx_addr = {
 	.std_id = 0x11,
 };
 
+#define FRAG_DATA_SIZE 24
+
+NET_BUF_POOL_DEFINE(frag_pool, 8, FRAG_DATA_SIZE, 0, NULL);
+
 struct isotp_recv_ctx recv_ctx;
 struct isotp_send_ctx send_ctx;
 uint8_t data_buf[128];
@@ -299,6 +303,44 @@ ZTEST(isotp_implementation, test_send_receive_net_single_blocks)
 	isotp_unbind(&recv_ctx);
 }
 
+ZTEST(isotp_implementation, test_send_receive_net_frags)
+{
+	/* Fragment boundaries do not line up with CF payloads */
+	const size_t data_size = FRAG_DATA_SIZE * 4 + 4;
+	struct net_buf *buf, *frag;
+	size_t offset, len;
+	int ret, i;
+
+	ret = isotp_bind(&recv_ctx, can_dev, &rx_addr, &tx_addr, &fc_opts,
+			 K_NO_WAIT);
+	zassert_equal(ret, 0, "Binding failed (%d)", ret);
+
+	for (i = 0; i < NUMBER_OF_REPETITIONS; i++) {
+		buf = NULL;
+
+		for (offset = 0; offset < data_size; offset += len) {
+			len = MIN(FRAG_DATA_SIZE, data_size - offset);
+			frag = net_buf_alloc(&frag_pool, K_NO_WAIT);
+			zassert_not_null(frag, "Out of fragments");
+			net_buf_add_mem(frag, &random_data[offset], len);
+
+			if (buf == NULL) {
+				buf = frag;
+			} else {
+				net_buf_frag_add(buf, frag);
+			}
+		}
+
+		ret = isotp_send_net_ctx_buf(can_dev, buf, &rx_addr, &tx_addr,
+					     send_complete_cb, NULL, K_NO_WAIT);
+		zassert_equal(ret, 0, "Send returned %d", ret);
+		receive_test_data(&recv_ctx, random_data, data_size, 0);
+		k_msleep(10);
+	}
+
+	isotp_unbind(&recv_ctx);
+}
+
 ZTEST(isotp_implementation, test_send_receive_single_block)
 {
 	const size_t send_len = CONFIG_ISOTP_RX_BUF_COUNT *
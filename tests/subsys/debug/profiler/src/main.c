@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/debug/profiler.h>
+#include <zephyr/debug/symtab.h>
+
+#define BUSY_MS 200
+
+static volatile uint32_t busy_counter;
+
+/* Spins in its own frame most of the time, so most samples land here */
+static __noinline void busy_loop(void)
+{
+	for (int i = 0; i < 1000; i++) {
+		busy_counter++;
+	}
+}
+
+static __noinline void busy_run(void)
+{
+	int64_t end = k_uptime_get() + BUSY_MS;
+
+	while (k_uptime_get() < end) {
+		busy_loop();
+	}
+}
+
+struct hist_max {
+	uintptr_t addr;
+	uint32_t count;
+};
+
+static void hist_max_cb(uintptr_t addr, uint32_t count, void *user_data)
+{
+	struct hist_max *max = user_data;
+
+	if (count > max->count) {
+		max->addr = addr;
+		max->count = count;
+	}
+}
+
+static void stack_cb(const uintptr_t *frames, size_t depth, void *user_data)
+{
+	uint32_t offset;
+	int *checked = user_data;
+
+	zassert_true(depth >= 1 && depth <= CONFIG_PROFILER_STACK_DEPTH);
+
+	if (strcmp(symtab_find_symbol_name(frames[0], &offset), "busy_loop") == 0 &&
+	    depth > 1) {
+		zassert_equal(strcmp(symtab_find_symbol_name(frames[1], &offset), "busy_run"), 0);
+	}
+
+	(*checked)++;
+}
+
+static void profiler_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	profiler_reset();
+}
+
+ZTEST(profiler, test_hist)
+{
+	struct hist_max max = {0};
+	uint32_t offset, dropped, samples;
+
+	zassert_ok(profiler_start(K_MSEC(1)));
+	zassert_equal(profiler_start(K_MSEC(1)), -EALREADY);
+	busy_run();
+	profiler_stop();
+
+	samples = profiler_samples_get(&dropped);
+	zassert_true(samples > BUSY_MS / 4, "Got %u samples only", samples);
+	zassert_equal(dropped, 0);
+
+	profiler_hist_foreach(hist_max_cb, &max);
+	zassert_equal(strcmp(symtab_find_symbol_name(max.addr, &offset), "busy_loop"), 0);
+	zassert_equal(offset, 0, "Samples are not counted per function");
+	zassert_true(max.count > samples / 2);
+
+	/* Nothing is sampled once stopped */
+	busy_run();
+	zassert_equal(profiler_samples_get(NULL), samples);
+}
+
+ZTEST(profiler, test_stacks)
+{
+	int checked = 0;
+
+	zassert_ok(profiler_start(K_MSEC(1)));
+	busy_run();
+	profiler_stop();
+
+	profiler_stacks_foreach(stack_cb, &checked);
+	zassert_equal(checked, CONFIG_PROFILER_STACK_SAMPLES);
+
+	profiler_reset();
+	zassert_equal(profiler_samples_get(NULL), 0);
+
+	checked = 0;
+	profiler_stacks_foreach(stack_cb, &checked);
+	zassert_equal(checked, 0);
+}
+
+ZTEST_SUITE(profiler, NULL, NULL, profiler_before, NULL, NULL);
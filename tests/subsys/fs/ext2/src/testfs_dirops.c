@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2023 Antmicro
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -81,3 +82,54 @@ ZTEST(ext2tests, test_dirops_basic)
 
 	zassert_equal(fs_unmount(mp), 0, "Unmount failed");
 }
+
+/* Paths resolved once must not resolve to stale entries after rename or unlink */
+ZTEST(ext2tests, test_dirops_rename_unlink)
+{
+	struct fs_mount_t *mp = &testfs_mnt;
+
+	zassert_equal(fs_mount(mp), 0, "Mount failed");
+
+	struct fs_file_t file;
+	struct fs_dirent stat;
+
+	fs_file_t_init(&file);
+
+	zassert_equal(fs_mkdir("/sml/dir1"), 0, "Create dir1 failed");
+	zassert_equal(fs_mkdir("/sml/dir2"), 0, "Create dir2 failed");
+	zassert_equal(fs_open(&file, "/sml/dir1/file1", FS_O_CREATE), 0, "Create file1 failed");
+	zassert_equal(fs_close(&file), 0, "Close file error");
+	zassert_equal(fs_open(&file, "/sml/dir1/file2", FS_O_CREATE), 0, "Create file2 failed");
+	zassert_equal(fs_close(&file), 0, "Close file error");
+
+	/* Rename in the same directory */
+	zassert_equal(fs_rename("/sml/dir1/file1", "/sml/dir1/file3"), 0, "Rename failed");
+	zassert_equal(fs_stat("/sml/dir1/file1", &stat), -ENOENT, "Should not exist");
+	zassert_equal(fs_stat("/sml/dir1/file3", &stat), 0, "Stat file3 failed");
+	zassert_equal(fs_stat("/sml/dir1/file2", &stat), 0, "Stat file2 failed");
+
+	/* Move to another directory */
+	zassert_equal(fs_rename("/sml/dir1/file2", "/sml/dir2/file2"), 0, "Rename failed");
+	zassert_equal(fs_stat("/sml/dir1/file2", &stat), -ENOENT, "Should not exist");
+	zassert_equal(fs_open(&file, "/sml/dir2/file2", 0), 0, "Open file2 should succeed");
+	zassert_equal(fs_close(&file), 0, "Close file error");
+
+	/* Replace an existing file */
+	zassert_equal(fs_rename("/sml/dir1/file3", "/sml/dir2/file2"), 0, "Rename failed");
+	zassert_equal(fs_stat("/sml/dir1/file3", &stat), -ENOENT, "Should not exist");
+	zassert_equal(fs_stat("/sml/dir2/file2", &stat), 0, "Stat file2 failed");
+
+	/* Unlink files and directory, then create it again */
+	zassert_equal(fs_unlink("/sml/dir2/file2"), 0, "Unlink file2 failed");
+	zassert_equal(fs_open(&file, "/sml/dir2/file2", 0), -ENOENT, "Should not exist");
+	zassert_equal(fs_unlink("/sml/dir1"), 0, "Unlink dir1 failed");
+	zassert_equal(fs_stat("/sml/dir1", &stat), -ENOENT, "Should not exist");
+	zassert_equal(fs_open(&file, "/sml/dir1/file3", 0), -ENOENT, "Should not exist");
+
+	zassert_equal(fs_mkdir("/sml/dir1"), 0, "Create dir1 failed");
+	zassert_equal(fs_stat("/sml/dir1", &stat), 0, "Stat dir1 failed");
+	zassert_equal(stat.type, FS_DIR_ENTRY_DIR, "Wrong type");
+	zassert_equal(fs_open(&file, "/sml/dir1/file3", 0), -ENOENT, "Should not exist");
+
+	zassert_equal(fs_unmount(mp), 0, "Unmount failed");
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+static void fcb_test_fill(struct fcb *fcb)
+{
+	int rc;
+	struct fcb_entry loc;
+	uint8_t test_data[128] = {0};
+
+	while (1) {
+		rc = fcb_append(fcb, sizeof(test_data), &loc);
+		if (rc == -ENOSPC) {
+			break;
+		}
+		zassert_true(rc == 0, "fcb_append call failure");
+
+		rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc),
+				      test_data, sizeof(test_data));
+		zassert_true(rc == 0, "flash_area_write call failure");
+
+		rc = fcb_append_finish(fcb, &loc);
+		zassert_true(rc == 0, "fcb_append_finish call failure");
+	}
+}
+#endif
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_background_erase)
+{
+#ifdef CONFIG_FCB_BACKGROUND_ERASE
+	struct fcb *fcb;
+	int rc;
+	int i;
+
+	fcb = &test_fcb;
+	fcb->f_scratch_cnt = 0U;
+
+	/*
+	 * Keep appending and rotating over all the sectors twice, giving the
+	 * background erase a chance to run after every rotation.
+	 */
+	for (i = 0; i < 2 * fcb->f_sector_cnt; i++) {
+		fcb_test_fill(fcb);
+
+		rc = fcb_rotate(fcb);
+		zassert_true(rc == 0, "fcb_rotate call failure");
+		zassert_true(fcb->f_erase_pending == 1U, "rotated sector should be pending");
+
+		k_sleep(K_MSEC(100));
+		zassert_true(fcb->f_erase_pending == 0U, "rotated sector not erased");
+	}
+
+	zassert_equal(fcb_erase_stall_count(fcb), 0, "appends waited for an erase");
+
+	/*
+	 * Without a chance to erase in the background, the append needing the
+	 * rotated sector has to erase it.
+	 */
+	rc = fcb_rotate(fcb);
+	zassert_true(rc == 0, "fcb_rotate call failure");
+
+	fcb_test_fill(fcb);
+	zassert_true(fcb->f_erase_pending == 0U, "rotated sector not erased");
+	zassert_equal(fcb_erase_stall_count(fcb), 1, "stall not counted");
+#else
+	ztest_test_skip();
+#endif
+}
@@ -934,3 +934,205 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_NVS_INDEX
+static size_t num_index_entries_in_sector(uint32_t sector, struct nvs_fs *fs)
+{
+	size_t i, num = 0;
+
+	for (i = 0; i < CONFIG_NVS_INDEX_SIZE; i++) {
+		if (fs->index_addr[i] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->index_addr[i] >> ADDR_SECT_SHIFT) == sector) {
+			num++;
+		}
+	}
+
+	return num;
+}
+
+static size_t num_occupied_index_entries(struct nvs_fs *fs)
+{
+	size_t i, num = 0;
+
+	for (i = 0; i < CONFIG_NVS_INDEX_SIZE; i++) {
+		if (fs->index_addr[i] != NVS_LOOKUP_CACHE_NO_ADDR) {
+			num++;
+		}
+	}
+
+	return num;
+}
+#endif
+
+/*
+ * Test that the NVS index holds the most recent ATE of every ID, both when
+ * updated by writes and when rebuilt on nvs_mount().
+ */
+ZTEST_F(nvs, test_nvs_index_init)
+{
+#ifdef CONFIG_NVS_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(num_occupied_index_entries(&fixture->fs), 0, "uninitialized index");
+
+	for (id = 0; id < CONFIG_NVS_INDEX_SIZE / 2; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Overwrite and delete some of them */
+	data = 0xAA55;
+	err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	err = nvs_delete(&fixture->fs, 2);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+
+	zassert_equal(num_occupied_index_entries(&fixture->fs), CONFIG_NVS_INDEX_SIZE / 2,
+		      "index not updated after write");
+
+	memset(fixture->fs.index_addr, 0xAA, sizeof(fixture->fs.index_addr));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(num_occupied_index_entries(&fixture->fs), CONFIG_NVS_INDEX_SIZE / 2,
+		      "index not rebuilt after restart");
+	zassert_false(fixture->fs.index_overflow, "unexpected index overflow");
+
+	for (id = 0; id < CONFIG_NVS_INDEX_SIZE / 2; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		if (id == 2) {
+			zassert_equal(err, -ENOENT, "deleted entry found");
+			continue;
+		}
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id == 1 ? 0xAA55 : id, "incorrect data read");
+	}
+
+	err = nvs_read_hist(&fixture->fs, 1, &data, sizeof(data), 1);
+	zassert_equal(err, sizeof(data), "nvs_read_hist call failure: %d", err);
+	zassert_equal(data, 1, "incorrect history read");
+
+	err = nvs_read(&fixture->fs, CONFIG_NVS_INDEX_SIZE, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "non-existing entry found");
+#endif
+}
+
+/*
+ * Test that IDs which do not fit in the NVS index are still found.
+ */
+ZTEST_F(nvs, test_nvs_index_overflow)
+{
+#ifdef CONFIG_NVS_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < CONFIG_NVS_INDEX_SIZE + 8; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.index_overflow, "index overflow not detected");
+
+	for (id = 0; id < CONFIG_NVS_INDEX_SIZE + 8; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
+
+/*
+ * Test that the NVS index does not contain any address from gc-ed sector
+ */
+ZTEST_F(nvs, test_nvs_index_gc)
+{
+#ifdef CONFIG_NVS_INDEX
+	int err;
+	uint16_t data = 0;
+	ssize_t free_space;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) + sizeof(struct nvs_ate)
+	       <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 1,
+		      "invalid index content after filling sector 0");
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 0,
+		      "not invalidated index entries after gc");
+	zassert_equal(num_index_entries_in_sector(2, &fixture->fs), 2,
+		      "invalid index content after gc");
+
+	/* Free space accounting uses the index, it must match a plain scan */
+	free_space = nvs_calc_free_space(&fixture->fs);
+	fixture->fs.index_overflow = true;
+	zassert_equal(nvs_calc_free_space(&fixture->fs), free_space,
+		      "free space differs from the one found by scanning");
+	fixture->fs.index_overflow = false;
+#endif
+}
+
+/*
+ * Test that writes do not stall when the background gc gets a chance to run.
+ */
+ZTEST_F(nvs, test_nvs_background_gc)
+{
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	int err;
+	uint16_t data;
+	uint16_t written = 0;
+	uint32_t first_sector;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	first_sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+
+	/* Write more than the whole file system can take */
+	while (written < 3 * fixture->fs.sector_size / (sizeof(data) + sizeof(struct nvs_ate))) {
+		data = written++;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+		k_sleep(K_MSEC(1));
+	}
+
+	zassert_not_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, first_sector,
+			  "write sector did not change");
+	zassert_equal(nvs_gc_stall_count(&fixture->fs), 0, "writes stalled");
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, written - 1, "incorrect data read");
+#endif
+}
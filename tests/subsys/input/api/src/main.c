@@ -1,5 +1,6 @@
 /*
  * Copyright 2023 Google LLC
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -83,6 +84,109 @@ ZTEST(input_api, test_sequence_thread)
 	zassert_equal(message_count_unfiltered, CONFIG_INPUT_QUEUE_MAX_MSGS + 1);
 }
 
+#if CONFIG_INPUT_EVENT_GROUPS
+
+#define MAX_GROUPS 8
+
+static K_SEM_DEFINE(group_done, 0, MAX_GROUPS);
+static struct input_event groups[MAX_GROUPS][2];
+static size_t group_counts[MAX_GROUPS];
+static int group_count;
+
+static void input_cb_group(const struct input_event *evts, size_t count)
+{
+	TC_PRINT("%s: %d, %zu events\n", __func__, group_count, count);
+
+	if (group_count < MAX_GROUPS && count <= ARRAY_SIZE(groups[0])) {
+		memcpy(groups[group_count], evts, count * sizeof(*evts));
+		group_counts[group_count] = count;
+	}
+
+	group_count++;
+	k_sem_give(&group_done);
+}
+INPUT_GROUP_CALLBACK_DEFINE(&fake_dev, input_cb_group);
+
+static void check_group(int idx, int32_t x, int32_t y)
+{
+	zassert_equal(group_counts[idx], 2);
+	zassert_equal(groups[idx][0].code, INPUT_ABS_X);
+	zassert_equal(groups[idx][0].value, x);
+	zassert_equal(groups[idx][0].sync, 0);
+	zassert_equal(groups[idx][1].code, INPUT_ABS_Y);
+	zassert_equal(groups[idx][1].value, y);
+	zassert_equal(groups[idx][1].sync, 1);
+}
+
+static void groups_reset(void)
+{
+	group_count = 0;
+	memset(group_counts, 0, sizeof(group_counts));
+	k_sem_reset(&group_done);
+}
+
+ZTEST(input_api, test_group)
+{
+	int ret;
+
+	groups_reset();
+
+	ret = input_report_abs(&fake_dev, INPUT_ABS_X, 10, false, K_FOREVER);
+	zassert_equal(ret, 0, "ret: %d", ret);
+	ret = input_report_abs(&fake_dev, INPUT_ABS_Y, 20, true, K_FOREVER);
+	zassert_equal(ret, 0, "ret: %d", ret);
+
+	zassert_ok(k_sem_take(&group_done, K_SECONDS(1)));
+	zassert_equal(group_count, 1);
+	check_group(0, 10, 20);
+}
+
+#if CONFIG_INPUT_EVENT_GROUP_COALESCE
+
+/* Queued 12 events, the first two syncs find the queue at least half used */
+#define COALESCE_SYNCS 6
+#define COALESCE_GROUPS (COALESCE_SYNCS - 1)
+
+BUILD_ASSERT(CONFIG_INPUT_QUEUE_MAX_MSGS == 16);
+BUILD_ASSERT(COALESCE_GROUPS <= MAX_GROUPS);
+
+ZTEST(input_api, test_group_coalesce)
+{
+	int i;
+	int ret;
+
+	groups_reset();
+
+	/* hold the thread until all the events are queued */
+	k_sem_take(&cb_start, K_FOREVER);
+
+	for (i = 0; i < COALESCE_SYNCS; i++) {
+		ret = input_report_abs(&fake_dev, INPUT_ABS_X, i, false, K_FOREVER);
+		zassert_equal(ret, 0, "ret: %d", ret);
+		ret = input_report_abs(&fake_dev, INPUT_ABS_Y, i, true, K_FOREVER);
+		zassert_equal(ret, 0, "ret: %d", ret);
+	}
+
+	k_sem_give(&cb_start);
+
+	for (i = 0; i < COALESCE_GROUPS; i++) {
+		zassert_ok(k_sem_take(&group_done, K_SECONDS(1)));
+	}
+	zassert_true(input_queue_empty());
+	zassert_equal(k_sem_take(&group_done, K_MSEC(100)), -EAGAIN);
+
+	/* first two syncs merged, with the latest values */
+	zassert_equal(group_count, COALESCE_GROUPS);
+	check_group(0, 1, 1);
+	for (i = 1; i < COALESCE_GROUPS; i++) {
+		check_group(i, i + 1, i + 1);
+	}
+}
+
+#endif /* CONFIG_INPUT_EVENT_GROUP_COALESCE */
+
+#endif /* CONFIG_INPUT_EVENT_GROUPS */
+
 #else /* CONFIG_INPUT_MODE_THREAD */
 
 static void input_cb_filtered(struct input_event *evt)
@@ -104,6 +104,12 @@ ZTEST(test_pbuf, test_rw)
 	zassert_equal(ret, MPS);
 	/* Check data corectness. */
 	zassert_mem_equal(write_buf, read_buf, MPS);
+
+	/* Reader caught up with the writer. */
+	zassert_equal(pbuf_rd_idx_get(&pb), pb.data.wr_idx);
+	ret = pbuf_write(&pb, write_buf, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_not_equal(pbuf_rd_idx_get(&pb), pb.data.wr_idx);
 }
 
 /* API ret codes tests. */
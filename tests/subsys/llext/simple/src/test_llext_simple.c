@@ -237,6 +237,49 @@ static LLEXT_CONST uint8_t multi_file_ext[] __aligned(4) = {
 LLEXT_LOAD_UNLOAD(multi_file, true, NULL)
 #endif
 
+#ifdef CONFIG_LLEXT_IMAGE
+static uint8_t hello_world_image[4096] __aligned(4);
+
+/*
+ * Write a pre-linked image while loading an extension from its ELF file,
+ * then load and run it again from that image.
+ */
+ZTEST(llext, test_load_image)
+{
+	struct llext_buf_loader buf_loader =
+		LLEXT_BUF_LOADER(hello_world_ext, ARRAY_SIZE(hello_world_ext));
+	struct llext_load_param ldr_parm = LLEXT_LOAD_PARAM_DEFAULT;
+	struct llext *ext = NULL;
+	int res;
+
+	ldr_parm.image = hello_world_image;
+	ldr_parm.image_size = sizeof(hello_world_image);
+
+	res = llext_load(&buf_loader.loader, "hello_world", &ext, &ldr_parm);
+	zassert_ok(res, "load should succeed");
+	zassert_not_equal(ldr_parm.image_size, 0, "image should be written");
+	llext_unload(&ext);
+
+	struct llext_buf_loader image_loader =
+		LLEXT_BUF_LOADER(hello_world_image, ldr_parm.image_size);
+
+	res = llext_load_image(&image_loader.loader, "hello_world", &ext);
+	zassert_ok(res, "image load should succeed");
+
+	res = llext_call_fn(ext, "test_entry");
+	zassert_ok(res, "test_entry call should succeed");
+
+	llext_unload(&ext);
+
+	/* A truncated buffer yields no image, but the load still succeeds */
+	ldr_parm.image_size = 16;
+	res = llext_load(&buf_loader.loader, "hello_world", &ext, &ldr_parm);
+	zassert_ok(res, "load should succeed");
+	zassert_equal(ldr_parm.image_size, 0, "image should not be written");
+	llext_unload(&ext);
+}
+#endif /* CONFIG_LLEXT_IMAGE */
+
 
 /*
  * Ensure that EXPORT_SYMBOL does indeed provide a symbol and a valid address
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2020 PHYTEC Messtechnik GmbH
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -171,6 +172,58 @@ static struct modbus_user_callbacks mbs_cbs = {
 	.holding_reg_wr_fp = holding_reg_wr_fp,
 };
 
+static int input_regs_rd(uint16_t addr, uint16_t *regs, uint16_t num)
+{
+	if (addr + num > ARRAY_SIZE(holding_reg)) {
+		return -ENOTSUP;
+	}
+
+	memcpy(regs, &holding_reg[addr], num * sizeof(uint16_t));
+
+	LOG_DBG("Input registers read, addr %u, num %u", addr, num);
+
+	return 0;
+}
+
+static int holding_regs_rd(uint16_t addr, uint16_t *regs, uint16_t num)
+{
+	if (addr + num > ARRAY_SIZE(holding_reg)) {
+		return -ENOTSUP;
+	}
+
+	memcpy(regs, &holding_reg[addr], num * sizeof(uint16_t));
+
+	LOG_DBG("Holding registers read, addr %u, num %u", addr, num);
+
+	return 0;
+}
+
+static int holding_regs_wr(uint16_t addr, const uint16_t *regs, uint16_t num)
+{
+	if (addr + num > ARRAY_SIZE(holding_reg)) {
+		return -ENOTSUP;
+	}
+
+	memcpy(&holding_reg[addr], regs, num * sizeof(uint16_t));
+
+	LOG_DBG("Holding registers write, addr %u, num %u", addr, num);
+
+	return 0;
+}
+
+/* Same as above, with integer registers handled by range callbacks */
+static struct modbus_user_callbacks mbs_range_cbs = {
+	.coil_rd = coil_rd,
+	.coil_wr = coil_wr,
+	.discrete_input_rd = discrete_input_rd,
+	.input_regs_rd = input_regs_rd,
+	.input_reg_rd_fp = input_reg_rd_fp,
+	.holding_regs_rd = holding_regs_rd,
+	.holding_regs_wr = holding_regs_wr,
+	.holding_reg_rd_fp = holding_reg_rd_fp,
+	.holding_reg_wr_fp = holding_reg_wr_fp,
+};
+
 static struct modbus_iface_param server_param = {
 	.mode = MODBUS_MODE_RTU,
 	.server = {
@@ -202,6 +255,7 @@ void test_server_setup_low_odd(void)
 
 	server_iface = modbus_iface_get_by_name(rtu_iface_name);
 	server_param.mode = MODBUS_MODE_RTU;
+	server_param.server.user_cb = &mbs_cbs;
 	server_param.serial.baud = MB_TEST_BAUDRATE_LOW;
 	server_param.serial.parity = UART_CFG_PARITY_ODD;
 
@@ -219,6 +273,7 @@ void test_server_setup_low_none(void)
 
 	server_iface = modbus_iface_get_by_name(rtu_iface_name);
 	server_param.mode = MODBUS_MODE_RTU;
+	server_param.server.user_cb = &mbs_cbs;
 	server_param.serial.baud = MB_TEST_BAUDRATE_LOW;
 	server_param.serial.parity = UART_CFG_PARITY_NONE;
 
@@ -236,6 +291,7 @@ void test_server_setup_high_even(void)
 
 	server_iface = modbus_iface_get_by_name(rtu_iface_name);
 	server_param.mode = MODBUS_MODE_RTU;
+	server_param.server.user_cb = &mbs_cbs;
 	server_param.serial.baud = MB_TEST_BAUDRATE_HIGH;
 	server_param.serial.parity = UART_CFG_PARITY_EVEN;
 
@@ -253,6 +309,7 @@ void test_server_setup_ascii(void)
 
 	server_iface = modbus_iface_get_by_name(rtu_iface_name);
 	server_param.mode = MODBUS_MODE_ASCII;
+	server_param.server.user_cb = &mbs_cbs;
 	server_param.serial.baud = MB_TEST_BAUDRATE_HIGH;
 	server_param.serial.parity = UART_CFG_PARITY_EVEN;
 
@@ -271,6 +328,7 @@ void test_server_setup_raw(void)
 
 	server_iface = modbus_iface_get_by_name(iface_name);
 	server_param.mode = MODBUS_MODE_RAW;
+	server_param.server.user_cb = &mbs_range_cbs;
 	server_param.rawcb.raw_tx_cb = server_raw_cb;
 
 	if (IS_ENABLED(CONFIG_MODBUS_SERVER)) {
@@ -436,6 +436,58 @@ ZTEST(modem_cmux, test_modem_cmux_transmit_dlci2_ppp)
 		     "Incorrect number of bytes transmitted");
 }
 
+ZTEST(modem_cmux, test_modem_cmux_transmit_dlci2_ppp_claim)
+{
+	int ret;
+	uint32_t events;
+	uint8_t *buf;
+
+	ret = modem_pipe_transmit_claim(dlci2_pipe, &buf, sizeof(cmux_frame_data_dlci2_ppp_52));
+	zassert_true(ret == sizeof(cmux_frame_data_dlci2_ppp_52), "Failed to claim DLCI2 buffer");
+
+	memcpy(buf, cmux_frame_data_dlci2_ppp_52, sizeof(cmux_frame_data_dlci2_ppp_52));
+
+	ret = modem_pipe_transmit_commit(dlci2_pipe, sizeof(cmux_frame_data_dlci2_ppp_52));
+	zassert_true(ret == sizeof(cmux_frame_data_dlci2_ppp_52), "Failed to commit DLCI2 PPP 52");
+
+	events = k_event_wait(&cmux_event, EVENT_CMUX_DLCI2_TRANSMIT_IDLE, false, K_MSEC(200));
+	zassert_equal(events, EVENT_CMUX_DLCI2_TRANSMIT_IDLE,
+		      "Transmit idle event not received for DLCI2 pipe");
+
+	ret = modem_backend_mock_get(&bus_mock, buffer2, sizeof(buffer2));
+	zassert_true(ret == sizeof(cmux_frame_dlci2_ppp_52),
+		     "Incorrect number of bytes transmitted");
+	zassert_true(memcmp(buffer2, cmux_frame_dlci2_ppp_52,
+			    sizeof(cmux_frame_dlci2_ppp_52)) == 0,
+		     "Incorrect data transmitted");
+}
+
+ZTEST(modem_cmux, test_modem_cmux_receive_dlci2_ppp_claim)
+{
+	int ret;
+	uint32_t events;
+	uint8_t *buf;
+
+	modem_backend_mock_put(&bus_mock, cmux_frame_dlci2_ppp_52,
+			       sizeof(cmux_frame_dlci2_ppp_52));
+
+	events = k_event_wait(&cmux_event, EVENT_CMUX_DLCI2_RECEIVE_READY, false, K_MSEC(100));
+	zassert_true((events & EVENT_CMUX_DLCI2_RECEIVE_READY),
+		     "DLCI2 did not produce receive ready event");
+
+	ret = modem_pipe_receive_claim(dlci2_pipe, &buf, sizeof(buffer2));
+	zassert_true(ret == sizeof(cmux_frame_data_dlci2_ppp_52), "Incorrect number of bytes claimed");
+	zassert_true(memcmp(buf, cmux_frame_data_dlci2_ppp_52,
+			    sizeof(cmux_frame_data_dlci2_ppp_52)) == 0,
+		     "Incorrect data received");
+
+	ret = modem_pipe_receive_finish(dlci2_pipe, ret);
+	zassert_ok(ret, "Failed to finish DLCI2 receive claim");
+
+	ret = modem_pipe_receive(dlci2_pipe, buffer2, sizeof(buffer2));
+	zassert_true(ret == 0, "Claimed data was not released");
+}
+
 ZTEST(modem_cmux, test_modem_cmux_resync)
 {
 	int ret;
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2022 Trackunit Corporation
+ * Copyright (c) 2024 The Zephyr Project Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -27,6 +28,9 @@
 #define TEST_MODEM_PPP_IP_FRAME_SEND_MULT_N	(5)
 #define TEST_MODEM_PPP_IP_FRAME_SEND_LARGE_N	(2048)
 #define TEST_MODEM_PPP_IP_FRAME_RECEIVE_LARGE_N (2048)
+#define TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE	(1024)
+#define TEST_MODEM_PPP_THROUGHPUT_FRAME_N	(8)
+#define TEST_MODEM_PPP_THROUGHPUT_TIMEOUT_MS	(5000)
 
 /*************************************************************************************************/
 /*                                          Mock pipe                                            */
@@ -519,4 +523,85 @@ ZTEST(modem_ppp, test_ip_frame_receive_large)
 		     "Incorrect length of net packet received");
 }
 
+ZTEST(modem_ppp, test_ip_frame_throughput)
+{
+	struct net_pkt *pkt;
+	int64_t start;
+	int64_t elapsed;
+	size_t size;
+	size_t wrapped;
+	int ret;
+
+	/* Send frames over the mock pipe, each one is read back entirely before the next */
+	start = k_uptime_get();
+
+	for (size_t i = 0; i < TEST_MODEM_PPP_THROUGHPUT_FRAME_N; i++) {
+		pkt = net_pkt_alloc_with_buffer(&test_iface, TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE,
+						AF_UNSPEC, 0, K_NO_WAIT);
+		zassert_true(pkt != NULL, "Failed to allocate network packet");
+
+		net_pkt_cursor_init(pkt);
+		net_pkt_set_family(pkt, AF_INET);
+		size = test_modem_ppp_fill_net_pkt(pkt, TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE);
+		zassert_true(size == TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE, "Failed to fill net pkt");
+		test_net_send(pkt);
+
+		/* The frame ends with its second delimiter */
+		wrapped = 0;
+		while ((wrapped < 2) || (buffer[wrapped - 1] != 0x7E)) {
+			zassert_true(k_uptime_get() - start < TEST_MODEM_PPP_THROUGHPUT_TIMEOUT_MS,
+				     "Timed out waiting for frame");
+
+			ret = modem_backend_mock_get(&mock, &buffer[wrapped],
+						     sizeof(buffer) - wrapped);
+			if (ret > 0) {
+				wrapped += ret;
+			} else {
+				k_msleep(1);
+			}
+		}
+
+		size = test_modem_ppp_unwrap(unwrapped_buffer, buffer, wrapped);
+		zassert_true(size == (TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE + 2),
+			     "Incorrect data amount received");
+		zassert_true(test_modem_ppp_validate_fill(&unwrapped_buffer[2], (size - 2)) == true,
+			     "Incorrect data received");
+	}
+
+	elapsed = MAX(k_uptime_delta(&start), 1);
+	TC_PRINT("Sent %u bytes in %lld ms (%lld B/ms)\n",
+		 TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE * TEST_MODEM_PPP_THROUGHPUT_FRAME_N,
+		 (long long)elapsed,
+		 (long long)(TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE *
+			     TEST_MODEM_PPP_THROUGHPUT_FRAME_N / elapsed));
+
+	/* Then receive them */
+	test_modem_ppp_generate_ppp_frame(buffer, TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE);
+	size = test_modem_ppp_wrap_ppp_frame(wrapped_buffer, buffer,
+					     TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE);
+	start = k_uptime_get();
+
+	for (size_t i = 0; i < TEST_MODEM_PPP_THROUGHPUT_FRAME_N; i++) {
+		modem_backend_mock_put(&mock, wrapped_buffer, size);
+
+		while (received_packets_len == i) {
+			zassert_true(k_uptime_get() - start < TEST_MODEM_PPP_THROUGHPUT_TIMEOUT_MS,
+				     "Timed out waiting for frame");
+			k_msleep(1);
+		}
+
+		/* FCS is removed from packet data */
+		zassert_true(net_pkt_get_len(received_packets[i]) ==
+			     (TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE - 2),
+			     "Incorrect length of net packet received");
+	}
+
+	elapsed = MAX(k_uptime_delta(&start), 1);
+	TC_PRINT("Received %u bytes in %lld ms (%lld B/ms)\n",
+		 TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE * TEST_MODEM_PPP_THROUGHPUT_FRAME_N,
+		 (long long)elapsed,
+		 (long long)(TEST_MODEM_PPP_THROUGHPUT_FRAME_SIZE *
+			     TEST_MODEM_PPP_THROUGHPUT_FRAME_N / elapsed));
+}
+
 ZTEST_SUITE(modem_ppp, NULL, test_modem_ppp_setup, test_modem_ppp_before, NULL, NULL);
@@ -261,6 +261,63 @@ ZTEST(device_runtime_api, test_api)
 	zassert_equal(pm_device_runtime_usage(test_dev), -ENOTSUP);
 }
 
+static void resume_complete_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	pm_device_runtime_resume_complete(test_dev, 0);
+}
+
+static K_TIMER_DEFINE(resume_complete_timer, resume_complete_expiry, NULL);
+
+/**
+ * @brief Test resuming devices whose resume completes asynchronously.
+ */
+ZTEST(device_runtime_api, test_async_resume)
+{
+	const struct device *devs[] = {
+		test_dev,
+		DEVICE_DT_GET(DT_NODELABEL(test_dev)),
+	};
+	enum pm_device_state state;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_TEST_PM_DEVICE_ISR_SAFE)) {
+		ztest_test_skip();
+	}
+
+	/* get blocks until the driver completes the resume from an ISR */
+	test_driver_pm_async_resume(test_dev);
+	k_timer_start(&resume_complete_timer, K_MSEC(10), K_NO_WAIT);
+
+	ret = pm_device_runtime_get(test_dev);
+	zassert_equal(ret, 0);
+	zassert_equal(k_timer_status_get(&resume_complete_timer), 1);
+	(void)pm_device_state_get(test_dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_ACTIVE);
+
+	ret = pm_device_runtime_put(test_dev);
+	zassert_equal(ret, 0);
+
+	/* get_many waits for the asynchronous resume along with the others */
+	test_driver_pm_async_resume(test_dev);
+	k_timer_start(&resume_complete_timer, K_MSEC(10), K_NO_WAIT);
+
+	ret = pm_device_runtime_get_many(devs, ARRAY_SIZE(devs));
+	zassert_equal(ret, 0);
+	zassert_equal(k_timer_status_get(&resume_complete_timer), 1);
+	zassert_equal(pm_device_runtime_usage(test_dev), 1);
+	zassert_equal(pm_device_runtime_usage(devs[1]), 1);
+
+	for (size_t i = 0; i < ARRAY_SIZE(devs); i++) {
+		ret = pm_device_runtime_put(devs[i]);
+		zassert_equal(ret, 0);
+	}
+
+	(void)pm_device_state_get(test_dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDED);
+}
+
 DEVICE_DEFINE(pm_unsupported_device, "PM Unsupported", NULL, NULL, NULL, NULL,
 	      POST_KERNEL, 0, NULL);
 
@@ -13,6 +13,7 @@ struct test_driver_data {
 	size_t count;
 	bool ongoing;
 	bool async;
+	bool async_resume;
 	struct k_sem sync;
 };
 
@@ -21,6 +22,12 @@ static int test_driver_action(const struct device *dev,
 {
 	struct test_driver_data *data = dev->data;
 
+	if (data->async_resume && (action == PM_DEVICE_ACTION_RESUME)) {
+		data->async_resume = false;
+		data->count++;
+		return -EINPROGRESS;
+	}
+
 	if (!IS_ENABLED(CONFIG_TEST_PM_DEVICE_ISR_SAFE)) {
 		data->ongoing = true;
 
@@ -51,6 +58,13 @@ void test_driver_pm_done(const struct device *dev)
 	k_sem_give(&data->sync);
 }
 
+void test_driver_pm_async_resume(const struct device *dev)
+{
+	struct test_driver_data *data = dev->data;
+
+	data->async_resume = true;
+}
+
 bool test_driver_pm_ongoing(const struct device *dev)
 {
 	struct test_driver_data *data = dev->data;
@@ -26,6 +26,16 @@ void test_driver_pm_async(const struct device *dev);
  */
 void test_driver_pm_done(const struct device *dev);
 
+/**
+ * @brief Make the next resume of the test driver complete asynchronously.
+ *
+ * The resume action returns -EINPROGRESS, the test has to complete it with
+ * pm_device_runtime_resume_complete().
+ *
+ * @param dev Device instance.
+ */
+void test_driver_pm_async_resume(const struct device *dev);
+
 /**
  * @brief Check if PM actions is ongoing.
  *
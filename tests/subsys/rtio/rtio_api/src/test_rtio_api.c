@@ -615,6 +615,67 @@ ZTEST(rtio_api, test_rtio_transaction)
 	}
 }
 
+RTIO_DEFINE(r_batch, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_batch);
+
+/**
+ * @brief Test batched consumption of completions
+ *
+ * Ensures that rtio_cqe_copy_out_batch() waits for the requested number
+ * of completions, gives up on timeout and drains ready completions in bulk.
+ */
+void test_rtio_batch_(struct rtio *r)
+{
+	int res;
+	uintptr_t userdata[CQE_POOL_SIZE] = {0, 1, 2, 3};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe cqes[CQE_POOL_SIZE];
+	bool seen[CQE_POOL_SIZE] = { 0 };
+	int copied;
+
+	zassert_equal(rtio_cqe_consumable(r), 0, "Expected no ready completions");
+
+	for (int i = 0; i < CQE_POOL_SIZE; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_batch, &userdata[i]);
+	}
+
+	res = rtio_submit(r, 0);
+	zassert_ok(res, "Should return ok from rtio_submit");
+
+	/* The test iodev completes one request every 10 ms */
+	copied = rtio_cqe_copy_out_batch(r, cqes, CQE_POOL_SIZE, CQE_POOL_SIZE, K_MSEC(15));
+	zassert_true(copied < CQE_POOL_SIZE, "Expected the batch to time out");
+
+	copied += rtio_cqe_copy_out_batch(r, &cqes[copied], CQE_POOL_SIZE - copied,
+					  CQE_POOL_SIZE - copied, K_FOREVER);
+	zassert_equal(copied, CQE_POOL_SIZE, "Expected all completions");
+	zassert_equal(rtio_cqe_consumable(r), 0, "Expected no ready completions");
+
+	for (int i = 0; i < CQE_POOL_SIZE; i++) {
+		zassert_ok(cqes[i].result, "Result should be ok");
+		seen[*(uintptr_t *)cqes[i].userdata] = true;
+	}
+
+	for (int i = 0; i < CQE_POOL_SIZE; i++) {
+		zassert_true(seen[i], "Should have seen completion %d", i);
+	}
+
+	zassert_equal(rtio_cqe_copy_out_batch(r, cqes, 0, CQE_POOL_SIZE, K_NO_WAIT), 0,
+		      "Expected no completions");
+}
+
+ZTEST(rtio_api, test_rtio_batch)
+{
+	rtio_iodev_test_init(&iodev_test_batch);
+
+	for (int i = 0; i < TEST_REPEATS; i++) {
+		test_rtio_batch_(&r_batch);
+	}
+}
+
 #define THROUGHPUT_ITERS 100000
 RTIO_DEFINE(r_throughput, SQE_POOL_SIZE, CQE_POOL_SIZE);
 
@@ -619,3 +619,59 @@ ZTEST(settings_functional, test_direct_loading_filter)
 	}
 	settings_deregister(&filtered_loader_settings);
 }
+
+#if defined(CONFIG_SETTINGS_BATCH)
+ZTEST(settings_functional, test_batch_saving)
+{
+	int rc;
+	uint8_t val;
+
+	settings_subsys_init();
+	rc = settings_register(&val123_settings);
+	zassert_true(rc == 0);
+
+	val = 35;
+	settings_save_one("val/3", &val, sizeof(uint8_t));
+
+	rc = settings_batch_begin();
+	zassert_equal(0, rc);
+	zassert_equal(-EALREADY, settings_batch_begin());
+
+	val = 1;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_equal(0, rc);
+	val = 2;
+	rc = settings_batch_stage("val/2", &val, sizeof(uint8_t));
+	zassert_equal(0, rc);
+	val = 5;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_equal(0, rc);
+	rc = settings_delete("val/3");
+	zassert_equal(0, rc);
+
+	rc = settings_batch_commit();
+	zassert_equal(0, rc);
+	zassert_equal(-EINVAL, settings_batch_commit());
+
+	memset(&data, 0, sizeof(data));
+	rc = settings_load_subtree("val");
+	zassert_true(rc == 0);
+	zassert_equal(5, data.val1);
+	zassert_equal(2, data.val2);
+	zassert_false(data.en3, "Deleted value loaded");
+
+	/* Nothing of an aborted batch is written */
+	rc = settings_batch_begin();
+	zassert_equal(0, rc);
+	val = 99;
+	settings_save_one("val/2", &val, sizeof(uint8_t));
+	settings_batch_abort();
+
+	memset(&data, 0, sizeof(data));
+	rc = settings_load_subtree("val");
+	zassert_true(rc == 0);
+	zassert_equal(2, data.val2);
+
+	settings_deregister(&val123_settings);
+}
+#endif /* CONFIG_SETTINGS_BATCH */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/irq_offload.h>
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+struct sample_msg {
+	uint32_t seq;
+	uint8_t payload[60];
+};
+
+ZBUS_SEQLOCK_CHAN_DEFINE(sample_chan,	    /* Name */
+			 struct sample_msg, /* Message type */
+
+			 NULL,				    /* Validator */
+			 NULL,				    /* User data */
+			 ZBUS_OBSERVERS(sample_listener), /* observers */
+			 ZBUS_MSG_INIT(.seq = 7)	    /* Initial value */
+);
+
+static uint32_t listener_seq;
+static uint32_t listener_read_seq;
+static int listener_prio;
+
+static void sample_callback(const struct zbus_channel *chan)
+{
+	const struct sample_msg *msg = zbus_chan_const_msg(chan);
+	struct sample_msg copy;
+
+	listener_seq = msg->seq;
+	listener_prio = k_thread_priority_get(k_current_get());
+
+	/* Reading does not need the channel lock held by the publisher */
+	zassert_ok(zbus_chan_read(chan, &copy, K_NO_WAIT));
+	listener_read_seq = copy.seq;
+}
+
+ZBUS_LISTENER_DEFINE(sample_listener, sample_callback);
+
+static void isr_read(const void *param)
+{
+	struct sample_msg *msg = (struct sample_msg *)param;
+
+	zassert_ok(zbus_chan_read(&sample_chan, msg, K_NO_WAIT));
+}
+
+ZTEST(seqlock, test_pub_read)
+{
+	struct sample_msg msg;
+
+	zassert_true(zbus_chan_is_seqlock(&sample_chan));
+
+	zassert_ok(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT));
+	zassert_equal(msg.seq, 7);
+
+	for (uint32_t i = 0; i < 5; i++) {
+		msg.seq = i;
+		memset(msg.payload, i, sizeof(msg.payload));
+		zassert_ok(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT));
+
+		zassert_equal(listener_seq, i);
+		zassert_equal(listener_read_seq, i);
+
+		memset(&msg, 0xff, sizeof(msg));
+		irq_offload(isr_read, &msg);
+		zassert_equal(msg.seq, i);
+		zassert_equal(msg.payload[sizeof(msg.payload) - 1], i);
+	}
+}
+
+ZTEST(seqlock, test_read_while_claimed)
+{
+	struct sample_msg msg = {.seq = 42};
+
+	zassert_ok(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT));
+	zassert_ok(zbus_chan_claim(&sample_chan, K_NO_WAIT));
+
+	/* Claiming blocks publishers, but not readers */
+	msg.seq = 43;
+	zassert_equal(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT), -EBUSY);
+
+	memset(&msg, 0, sizeof(msg));
+	zassert_ok(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT));
+	zassert_equal(msg.seq, 42);
+
+	zassert_ok(zbus_chan_finish(&sample_chan));
+}
+
+ZTEST(seqlock, test_no_priority_boost)
+{
+	struct sample_msg msg = {.seq = 1};
+	int prio = k_thread_priority_get(k_current_get());
+
+	zassert_ok(zbus_obs_attach_to_thread(&sample_listener));
+	k_thread_priority_set(k_current_get(), prio + 1);
+
+	zassert_ok(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT));
+	zassert_equal(listener_prio, prio + 1, "publisher priority changed");
+
+	k_thread_priority_set(k_current_get(), prio);
+	zassert_ok(zbus_obs_detach_from_thread(&sample_listener));
+}
+
+ZTEST_SUITE(seqlock, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+#define FRAME_SIZE 256
+
+static bool frame_validator(const void *msg, size_t msg_size)
+{
+	return msg_size > 0;
+}
+
+ZBUS_ZC_CHAN_DEFINE(frame_chan,	     /* Name */
+		    4,		     /* Buffer count */
+		    4 * FRAME_SIZE,  /* Data size */
+		    frame_validator, /* Validator */
+		    NULL,	     /* User data */
+		    ZBUS_OBSERVERS(frame_listener, frame_msg_sub) /* observers */
+);
+
+static const uint8_t *listener_data;
+static size_t listener_len;
+
+static void frame_callback(const struct zbus_channel *chan)
+{
+	const struct net_buf *buf = *(struct net_buf *const *)zbus_chan_const_msg(chan);
+
+	listener_data = buf->data;
+	listener_len = buf->len;
+}
+
+ZBUS_LISTENER_DEFINE(frame_listener, frame_callback);
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(frame_msg_sub);
+
+static struct net_buf *publish_frame(uint8_t fill)
+{
+	struct net_buf *buf;
+
+	zassert_ok(zbus_chan_buf_alloc(&frame_chan, FRAME_SIZE, &buf, K_NO_WAIT));
+	memset(net_buf_add(buf, FRAME_SIZE), fill, FRAME_SIZE);
+	zassert_ok(zbus_chan_pub_buf(&frame_chan, buf, K_NO_WAIT));
+
+	return buf;
+}
+
+ZTEST(zero_copy, test_pub_no_copy)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *published;
+	struct net_buf *buf;
+
+	zassert_true(zbus_chan_is_zero_copy(&frame_chan));
+
+	published = publish_frame(0xa5);
+
+	/* The listener sees the published buffer itself */
+	zassert_equal_ptr(listener_data, published->data);
+	zassert_equal(listener_len, FRAME_SIZE);
+
+	/* The message subscriber gets its own buffer sharing the published data */
+	zassert_ok(zbus_sub_wait_buf(&frame_msg_sub, &chan, &buf, K_NO_WAIT));
+	zassert_equal_ptr(chan, &frame_chan);
+	zassert_not_equal_ptr(buf, published);
+	zassert_equal_ptr(buf->data, published->data);
+	zassert_equal(buf->len, FRAME_SIZE);
+	net_buf_unref(buf);
+
+	/* Readers get references too */
+	zassert_ok(zbus_chan_read_buf(&frame_chan, &buf, K_NO_WAIT));
+	zassert_equal_ptr(buf->data, published->data);
+	zassert_equal(buf->data[FRAME_SIZE - 1], 0xa5);
+
+	/* Data referenced by a reader stays valid after a newer publication */
+	published = publish_frame(0x5a);
+	zassert_not_equal_ptr(buf->data, published->data);
+	zassert_equal(buf->data[0], 0xa5);
+	net_buf_unref(buf);
+
+	zassert_ok(zbus_sub_wait_buf(&frame_msg_sub, &chan, &buf, K_NO_WAIT));
+	zassert_equal(buf->data[0], 0x5a);
+	net_buf_unref(buf);
+}
+
+ZTEST(zero_copy, test_buffers_recycled)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+
+	/* Every publication releases the previous message, so the pool never runs dry */
+	for (int i = 0; i < 16; i++) {
+		publish_frame(i);
+
+		zassert_ok(zbus_sub_wait_buf(&frame_msg_sub, &chan, &buf, K_NO_WAIT));
+		zassert_equal(buf->data[0], i);
+		net_buf_unref(buf);
+	}
+}
+
+ZTEST(zero_copy, test_invalid_msg)
+{
+	struct net_buf *buf;
+
+	zassert_ok(zbus_chan_buf_alloc(&frame_chan, FRAME_SIZE, &buf, K_NO_WAIT));
+
+	/* Empty frames are rejected by the validator, which consumes the buffer */
+	zassert_equal(zbus_chan_pub_buf(&frame_chan, buf, K_NO_WAIT), -ENOMSG);
+}
+
+ZTEST_SUITE(zero_copy, NULL, NULL, NULL, NULL, NULL);
@@ -10,6 +10,9 @@
 #include "../../../lib/crc/crc16_sw.c"
 #include "../../../lib/crc/crc32_sw.c"
 #include "../../../lib/crc/crc32c_sw.c"
+#ifdef CONFIG_CRC32_SLICE_BY_8
+#include "../../../lib/crc/crc32_slice8.c"
+#endif
 #include "../../../lib/crc/crc7_sw.c"
 #include "../../../lib/crc/crc24_sw.c"
 
@@ -51,6 +54,31 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc32_long)
+{
+	static uint8_t buf[1000];
+	uint32_t crc;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	/* Long enough for the word and slice oriented loops */
+	zassert_equal(crc32_ieee(buf, sizeof(buf)), 0x17BC2A46);
+	zassert_equal(crc32_c(0, buf, sizeof(buf), true, true), 0xDD2EDFF7);
+
+	/* Unaligned chunks */
+	crc = crc32_ieee_update(0, buf, 3);
+	crc = crc32_ieee_update(crc, buf + 3, 13);
+	crc = crc32_ieee_update(crc, buf + 16, sizeof(buf) - 16);
+	zassert_equal(crc, 0x17BC2A46);
+
+	crc = crc32_c(0, buf, 5, true, false);
+	crc = crc32_c(crc, buf + 5, 21, false, false);
+	crc = crc32_c(crc, buf + 26, sizeof(buf) - 26, false, true);
+	zassert_equal(crc, 0xDD2EDFF7);
+}
+
 ZTEST(crc, test_crc24_pgp)
 {
 	uint8_t test1[] = { 'A' };
@@ -187,6 +215,21 @@ ZTEST(crc, test_crc8_ccitt)
 			   sizeof(test2)) == 0xFB, "pass", "fail");
 }
 
+ZTEST(crc, test_crc8_rohc)
+{
+	uint8_t test0[] = { 0 };
+	uint8_t test1[] = { 'A' };
+	uint8_t test2[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+	zassert_equal(crc8_rohc(CRC8_ROHC_INITIAL_VALUE, test0, sizeof(test0)), 0xCF);
+	zassert_equal(crc8_rohc(CRC8_ROHC_INITIAL_VALUE, test1, sizeof(test1)), 0x2E);
+	zassert_equal(crc8_rohc(CRC8_ROHC_INITIAL_VALUE, test2, sizeof(test2)), 0xD0);
+
+	/* Same as the bitwise reflected computation */
+	zassert_equal(crc8_rohc(CRC8_ROHC_INITIAL_VALUE, test2, sizeof(test2)),
+		      crc8(test2, sizeof(test2), 0xE0, 0xFF, true));
+}
+
 ZTEST(crc, test_crc7_be)
 {
 	uint8_t test0[] = { 0 };